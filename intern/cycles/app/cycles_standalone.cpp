@@ -425,6 +425,14 @@ static void options_parse(const int argc, const char **argv)
   ap.arg("--samples %d:SAMPLES").help("Number of samples to render").action([&](auto argv) {
     parse_int(argv, &options.session_params.samples);
   });
+  ap.arg("--sample-subset %d:OFFSET %d:LENGTH")
+      .help("Render only a subset of the samples, to split the render of an image over multiple "
+            "processes or machines")
+      .action([&](auto argv) {
+        options.session_params.use_sample_subset = true;
+        options.session_params.sample_subset_offset = atoi(argv[1]);
+        options.session_params.sample_subset_length = atoi(argv[2]);
+      });
   ap.arg("--output %s:OUTPUT").help("File path to write output image").action([&](auto argv) {
     parse_string(argv, &options.output_filepath);
   });
@@ -532,6 +540,16 @@ static void options_parse(const int argc, const char **argv)
     fprintf(stderr, "Invalid number of samples: %d\n", options.session_params.samples);
     exit(EXIT_FAILURE);
   }
+  else if (options.session_params.use_sample_subset &&
+           (options.session_params.sample_subset_offset < 0 ||
+            options.session_params.sample_subset_length < 1))
+  {
+    fprintf(stderr,
+            "Invalid sample subset: %d:%d\n",
+            options.session_params.sample_subset_offset,
+            options.session_params.sample_subset_length);
+    exit(EXIT_FAILURE);
+  }
   else if (options.filepath.empty()) {
     fprintf(stderr, "No file path specified\n");
     exit(EXIT_FAILURE);
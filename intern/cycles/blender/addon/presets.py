@@ -108,6 +108,7 @@ class AddPresetPerformance(AddPresetBase, Operator):
         "cycles.debug_bvh_time_steps",
         "cycles.use_auto_tile",
         "cycles.tile_size",
+        "cycles.use_tile_denoising",
     ]
 
     preset_subdir = "cycles/performance"
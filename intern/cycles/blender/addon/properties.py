@@ -938,6 +938,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         default=0,
         min=0, max=16,
     )
+    bvh_cache_directory: StringProperty(
+        name="BVH Cache",
+        description="Directory to store built mesh BVHs in, so that later renders of the same geometry load them "
+        "instead of building them again. Only used by devices without hardware ray-tracing",
+        subtype='DIR_PATH',
+        default="",
+    )
 
     bake_type: EnumProperty(
         name="Bake Type",
@@ -1059,6 +1066,13 @@ class CyclesRenderSettings(bpy.types.PropertyGroup):
         description="",
         min=8, max=8192,
     )
+    use_tile_denoising: BoolProperty(
+        name="Denoise Tiles",
+        description="Denoise every tile after it is rendered, instead of the full image at the end. "
+        "Reduces memory usage of denoising high resolution images, at the cost of rendering "
+        "overlapping borders of tiles",
+        default=False,
+    )
 
     # Various fine-tuning debug flags
 
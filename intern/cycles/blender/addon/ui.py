@@ -863,6 +863,7 @@ class CYCLES_RENDER_PT_performance_memory(CyclesButtonsPanel, Panel):
         sub = col.column()
         sub.active = cscene.use_auto_tile
         sub.prop(cscene, "tile_size")
+        sub.prop(cscene, "use_tile_denoising")
 
 
 class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Panel):
@@ -897,6 +898,7 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
                 sub.prop(cscene, "debug_bvh_time_steps")
 
                 col.prop(cscene, "debug_use_hair_bvh")
+                col.prop(cscene, "bvh_cache_directory")
 
                 sub = col.column(align=True)
                 sub.label(text="Cycles built without Embree support")
@@ -908,6 +910,7 @@ class CYCLES_RENDER_PT_performance_acceleration_structure(CyclesButtonsPanel, Pa
             sub.prop(cscene, "debug_bvh_time_steps")
 
             col.prop(cscene, "debug_use_hair_bvh")
+            col.prop(cscene, "bvh_cache_directory")
 
             # CPU is used in addition to a GPU
             if use_multi_device(context) and use_embree:
@@ -929,6 +932,9 @@ class CYCLES_RENDER_PT_performance_final_render(CyclesButtonsPanel, Panel):
         col = layout.column()
 
         col.prop(rd, "use_persistent_data", text="Persistent Data")
+        sub = col.column()
+        sub.active = not rd.use_persistent_data
+        sub.prop(rd, "use_persistent_data_animation", text="Animation Only")
 
 
 class CYCLES_RENDER_PT_performance_viewport(CyclesButtonsPanel, Panel):
@@ -219,9 +219,12 @@ Object *BlenderSync::sync_object(BL::ViewLayer &b_view_layer,
     return nullptr;
   }
 
-  /* Use task pool only for non-instances, since sync_dupli_particle accesses
-   * geometry. This restriction should be removed for better performance. */
-  TaskPool *object_geom_task_pool = (is_instance) ? nullptr : geom_task_pool;
+  /* Use task pool for everything except particle instances, since sync_dupli_particle accesses
+   * the geometry right after syncing it. Other instances don't read the geometry on the main
+   * thread, and objects and geometry are still created here in order, so only filling in their
+   * data runs in parallel. */
+  const bool is_particle_instance = is_instance && b_instance.particle_system();
+  TaskPool *object_geom_task_pool = (is_particle_instance) ? nullptr : geom_task_pool;
 
   /* key to lookup object */
   const ObjectKey key(b_parent, persistent_id, b_ob_info.real_object, use_particle_hair);
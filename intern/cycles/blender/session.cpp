@@ -111,7 +111,7 @@ void BlenderSession::create_session()
   const SessionParams session_params = BlenderSync::get_session_params(
       b_engine, b_userpref, b_scene, background);
   const SceneParams scene_params = BlenderSync::get_scene_params(
-      b_scene, background, use_developer_ui);
+      b_data, b_scene, background, use_developer_ui);
   const bool session_pause = BlenderSync::get_session_pause(b_scene, background);
 
   /* reset status/progress */
@@ -198,10 +198,10 @@ void BlenderSession::reset_session(BL::BlendData &b_data, BL::Depsgraph &b_depsg
   const SessionParams session_params = BlenderSync::get_session_params(
       b_engine, b_userpref, b_scene, background);
   const SceneParams scene_params = BlenderSync::get_scene_params(
-      b_scene, background, use_developer_ui);
+      b_data, b_scene, background, use_developer_ui);
 
   if (scene->params.modified(scene_params) || session->params.modified(session_params) ||
-      !this->b_render.use_persistent_data())
+      !render_use_persistent_data(b_engine))
   {
     /* if scene or session parameters changed, it's easier to simply re-create
      * them rather than trying to distinguish which settings need to be updated
@@ -484,7 +484,7 @@ void BlenderSession::render_frame_finish()
   b_rlay_name = "";
   b_rview_name = "";
 
-  if (!b_render.use_persistent_data()) {
+  if (!render_use_persistent_data(b_engine)) {
     /* Free the sync object so that it can properly dereference nodes from the scene graph before
      * the graph is freed. */
     sync.reset();
@@ -681,8 +681,10 @@ void BlenderSession::bake(BL::Depsgraph &b_depsgraph_,
   const SessionParams session_params = BlenderSync::get_session_params(
       b_engine, b_userpref, b_scene, background);
 
-  /* Initialize bake manager, before we load the baking kernels. */
+  /* Initialize bake manager, before we load the baking kernels. The bake target may be different
+   * from the previous bake with this session. */
   scene->bake_manager->set_baking(scene, true);
+  scene->bake_manager->tag_update();
 
   session->set_display_driver(nullptr);
   session->set_output_driver(make_unique<BlenderOutputDriver>(b_engine));
@@ -781,7 +783,7 @@ void BlenderSession::synchronize(BL::Depsgraph &b_depsgraph_)
   const SessionParams session_params = BlenderSync::get_session_params(
       b_engine, b_userpref, b_scene, background);
   const SceneParams scene_params = BlenderSync::get_scene_params(
-      b_scene, background, use_developer_ui);
+      b_data, b_scene, background, use_developer_ui);
   const bool session_pause = BlenderSync::get_session_pause(b_scene, background);
 
   if (session->params.modified(session_params) || scene->params.modified(scene_params)) {
@@ -89,6 +89,14 @@ void BlenderSync::tag_update()
 
 void BlenderSync::set_bake_target(BL::Object &b_object)
 {
+  if (b_bake_target.ptr.data != b_object.ptr.data) {
+    /* When baking multiple objects with the same session, switch the target on the objects which
+     * are already synced, without syncing them again. */
+    for (const auto &[key, object] : object_map.key_to_scene_data()) {
+      object->set_is_bake_target(key.ob == b_object.ptr.data);
+    }
+  }
+
   b_bake_target = b_object;
 }
 
@@ -813,7 +821,7 @@ void BlenderSync::free_data_after_sync(BL::Depsgraph &b_depsgraph)
    */
 
   const bool is_interface_locked = b_engine.render() && b_engine.render().use_lock_interface();
-  const bool is_persistent_data = b_engine.render() && b_engine.render().use_persistent_data();
+  const bool is_persistent_data = render_use_persistent_data(b_engine);
   const bool can_free_caches =
       (BlenderSession::headless || is_interface_locked) &&
       /* Baking re-uses the depsgraph multiple times, clearing crashes
@@ -841,7 +849,8 @@ void BlenderSync::free_data_after_sync(BL::Depsgraph &b_depsgraph)
 
 /* Scene Parameters */
 
-SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
+SceneParams BlenderSync::get_scene_params(BL::BlendData &b_data,
+                                          BL::Scene &b_scene,
                                           const bool background,
                                           const bool use_developer_ui)
 {
@@ -889,6 +898,11 @@ SceneParams BlenderSync::get_scene_params(BL::Scene &b_scene,
 
   params.bvh_layout = DebugFlags().cpu.bvh_layout;
 
+  const string bvh_cache_path = get_string(cscene, "bvh_cache_directory");
+  if (!bvh_cache_path.empty()) {
+    params.bvh_cache_path = blender_absolute_path(b_data, b_scene, bvh_cache_path);
+  }
+
   params.background = background;
 
   return params;
@@ -990,6 +1004,7 @@ SessionParams BlenderSync::get_session_params(BL::RenderEngine &b_engine,
   if (background) {
     params.use_auto_tile = RNA_boolean_get(&cscene, "use_auto_tile");
     params.tile_size = max(get_int(cscene, "tile_size"), 8);
+    params.use_tile_denoising = RNA_boolean_get(&cscene, "use_tile_denoising");
   }
   else {
     params.use_auto_tile = false;
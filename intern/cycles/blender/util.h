@@ -287,6 +287,18 @@ static inline bool BKE_object_is_deform_modified(BObjectInfo &self, BL::Scene &s
                                                                                        false;
 }
 
+/* Keep the session and its device data after rendering, for faster re-renders or only for the
+ * next frame of an animation render. */
+static inline bool render_use_persistent_data(BL::RenderEngine &b_engine)
+{
+  BL::RenderSettings b_render = b_engine.render();
+  if (!b_render) {
+    return false;
+  }
+  return b_render.use_persistent_data() ||
+         (b_render.use_persistent_data_animation() && b_engine.is_animation());
+}
+
 static inline int render_resolution_x(BL::RenderSettings &b_render)
 {
   return b_render.resolution_x() * b_render.resolution_percentage() / 100;
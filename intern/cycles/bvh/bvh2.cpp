@@ -6,6 +6,8 @@
  * Adapted code from NVIDIA Corporation. */
 
 #include <algorithm>
+#include <cstdio>
+#include <cstring>
 
 #include "bvh/bvh2.h"
 
@@ -18,10 +20,21 @@
 #include "bvh/node.h"
 #include "bvh/unaligned.h"
 
+#include "util/path.h"
 #include "util/progress.h"
+#include "util/time.h"
 
 CCL_NAMESPACE_BEGIN
 
+/* Rebuild the BVH once refitting made traversal this much more expensive than right after the
+ * build, estimated from the node surface areas. */
+#define BVH2_REFIT_MAX_NODE_AREA_RATIO 1.5f
+
+/* Identifies BVH cache files, the version must be incremented when the packed layout or the way
+ * the BVH is built changes. */
+#define BVH2_CACHE_MAGIC "CYCLES_BVH2"
+#define BVH2_CACHE_VERSION 1
+
 BVHStackEntry::BVHStackEntry(const BVHNode *n, const int i) : node(n), idx(i) {}
 
 int BVHStackEntry::encodeIdx() const
@@ -36,6 +49,16 @@ BVH2::BVH2(const BVHParams &params_,
 {
 }
 
+static float node_area_sum(const BVHNode *node)
+{
+  float area = 0.0f;
+  for (int i = 0; i < node->num_children(); i++) {
+    const BVHNode *child = node->get_child(i);
+    area += child->bounds.safe_area() + node_area_sum(child);
+  }
+  return area;
+}
+
 void BVH2::build(Progress &progress, Stats * /*unused*/)
 {
   progress.set_substatus("Building BVH");
@@ -73,6 +96,10 @@ void BVH2::build(Progress &progress, Stats * /*unused*/)
   /* pack nodes */
   progress.set_substatus("Packing BVH nodes");
   pack_nodes(root.get());
+
+  const float root_area = root->bounds.safe_area();
+  build_node_area_ratio = (root_area > 0.0f) ? node_area_sum(root.get()) / root_area : 0.0f;
+  node_area_ratio = build_node_area_ratio;
 }
 
 void BVH2::refit(Progress &progress)
@@ -88,6 +115,117 @@ void BVH2::refit(Progress &progress)
   refit_nodes();
 }
 
+bool BVH2::need_rebuild_after_refit() const
+{
+  return node_area_ratio > build_node_area_ratio * BVH2_REFIT_MAX_NODE_AREA_RATIO;
+}
+
+/* Cache */
+
+template<typename T> static void cache_write_array(vector<uint8_t> &binary, const array<T> &data)
+{
+  const uint64_t size = data.size();
+  const uint8_t *size_bytes = reinterpret_cast<const uint8_t *>(&size);
+  binary.insert(binary.end(), size_bytes, size_bytes + sizeof(size));
+  if (size) {
+    const uint8_t *bytes = reinterpret_cast<const uint8_t *>(data.data());
+    binary.insert(binary.end(), bytes, bytes + size * sizeof(T));
+  }
+}
+
+template<typename T>
+static bool cache_read_array(const vector<uint8_t> &binary, size_t &offset, array<T> &data)
+{
+  uint64_t size;
+  if (binary.size() - offset < sizeof(size)) {
+    return false;
+  }
+  memcpy(&size, binary.data() + offset, sizeof(size));
+  offset += sizeof(size);
+
+  if ((binary.size() - offset) / sizeof(T) < size) {
+    return false;
+  }
+  data.resize(size);
+  if (size) {
+    memcpy(data.data(), binary.data() + offset, size * sizeof(T));
+    offset += size * sizeof(T);
+  }
+  return true;
+}
+
+bool BVH2::read_cache(const string &filepath)
+{
+  vector<uint8_t> binary;
+  if (!path_read_binary(filepath, binary)) {
+    return false;
+  }
+
+  const size_t magic_size = sizeof(BVH2_CACHE_MAGIC);
+  int header[2];
+  if (binary.size() < magic_size + sizeof(header) + sizeof(build_node_area_ratio) ||
+      memcmp(binary.data(), BVH2_CACHE_MAGIC, magic_size) != 0)
+  {
+    return false;
+  }
+  memcpy(header, binary.data() + magic_size, sizeof(header));
+  if (header[0] != BVH2_CACHE_VERSION) {
+    return false;
+  }
+  size_t offset = magic_size + sizeof(header);
+  memcpy(&build_node_area_ratio, binary.data() + offset, sizeof(build_node_area_ratio));
+  offset += sizeof(build_node_area_ratio);
+
+  PackedBVH cached;
+  cached.root_index = header[1];
+  if (!(cache_read_array(binary, offset, cached.nodes) &&
+        cache_read_array(binary, offset, cached.leaf_nodes) &&
+        cache_read_array(binary, offset, cached.prim_type) &&
+        cache_read_array(binary, offset, cached.prim_visibility) &&
+        cache_read_array(binary, offset, cached.prim_index) &&
+        cache_read_array(binary, offset, cached.prim_object) &&
+        cache_read_array(binary, offset, cached.prim_time)) ||
+      offset != binary.size())
+  {
+    return false;
+  }
+
+  pack = std::move(cached);
+  node_area_ratio = build_node_area_ratio;
+  return true;
+}
+
+bool BVH2::write_cache(const string &filepath) const
+{
+  vector<uint8_t> binary(BVH2_CACHE_MAGIC, BVH2_CACHE_MAGIC + sizeof(BVH2_CACHE_MAGIC));
+  const int header[2] = {BVH2_CACHE_VERSION, pack.root_index};
+  const uint8_t *header_bytes = reinterpret_cast<const uint8_t *>(header);
+  binary.insert(binary.end(), header_bytes, header_bytes + sizeof(header));
+  const uint8_t *ratio_bytes = reinterpret_cast<const uint8_t *>(&build_node_area_ratio);
+  binary.insert(binary.end(), ratio_bytes, ratio_bytes + sizeof(build_node_area_ratio));
+
+  cache_write_array(binary, pack.nodes);
+  cache_write_array(binary, pack.leaf_nodes);
+  cache_write_array(binary, pack.prim_type);
+  cache_write_array(binary, pack.prim_visibility);
+  cache_write_array(binary, pack.prim_index);
+  cache_write_array(binary, pack.prim_object);
+  cache_write_array(binary, pack.prim_time);
+
+  /* The cache directory may be shared by multiple processes, write to a temporary file first so
+   * readers never see a partially written file. */
+  const string temp_filepath = string_printf(
+      "%s.%llx.tmp", filepath.c_str(), (unsigned long long)(time_dt() * 1e6) ^ uintptr_t(this));
+  if (!path_write_binary(temp_filepath, binary)) {
+    return false;
+  }
+  if (rename(temp_filepath.c_str(), filepath.c_str()) != 0) {
+    path_remove(temp_filepath);
+    return false;
+  }
+  return true;
+}
+
 unique_ptr<BVHNode> BVH2::widen_children_nodes(unique_ptr<BVHNode> &&root)
 {
   return std::move(root);
@@ -296,7 +434,11 @@ void BVH2::refit_nodes()
 
   BoundBox bbox = BoundBox::empty;
   uint visibility = 0;
+  refit_node_area_sum = 0.0f;
   refit_node(0, (pack.root_index == -1) ? true : false, bbox, visibility);
+
+  const float root_area = bbox.safe_area();
+  node_area_ratio = (root_area > 0.0f) ? refit_node_area_sum / root_area : 0.0f;
 }
 
 void BVH2::refit_node(const int idx, bool leaf, BoundBox &bbox, uint &visibility)
@@ -346,6 +488,7 @@ void BVH2::refit_node(const int idx, bool leaf, BoundBox &bbox, uint &visibility
     bbox.grow(bbox0);
     bbox.grow(bbox1);
     visibility = visibility0 | visibility1;
+    refit_node_area_sum += bbox0.safe_area() + bbox1.safe_area();
   }
 }
 
@@ -10,6 +10,7 @@
 #include "bvh/bvh.h"
 #include "bvh/params.h"
 
+#include "util/string.h"
 #include "util/types.h"
 #include "util/unique_ptr.h"
 #include "util/vector.h"
@@ -44,6 +45,17 @@ class BVH2 : public BVH {
   void build(Progress &progress, Stats *stats);
   void refit(Progress &progress);
 
+  /* Refitting keeps the topology of the tree, which becomes less efficient to traverse as the
+   * primitives move away from where they were when it was built. Returns true when the tree
+   * degraded enough that building it again is worth the cost. */
+  bool need_rebuild_after_refit() const;
+
+  /* Store the built BVH in a file or read it back, to avoid building it again for geometry that
+   * is the same between renders. Reading fails when the file does not exist, is incomplete or
+   * was written by a different version. */
+  bool read_cache(const string &filepath);
+  bool write_cache(const string &filepath) const;
+
   PackedBVH pack;
 
  protected:
@@ -93,6 +105,12 @@ class BVH2 : public BVH {
 
   /* merge instance BVH's */
   void pack_instances(const size_t nodes_size, const size_t leaf_nodes_size);
+
+  /* Sum of the surface area of all nodes relative to the root node, proportional to the expected
+   * number of nodes visited by a ray. Computed when building and after every refit. */
+  float build_node_area_ratio = 0.0f;
+  float node_area_ratio = 0.0f;
+  float refit_node_area_sum = 0.0f;
 };
 
 CCL_NAMESPACE_END
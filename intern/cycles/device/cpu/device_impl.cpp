@@ -7,6 +7,11 @@
 #include <cstdlib>
 #include <cstring>
 
+#ifndef _WIN32
+#  include <sys/mman.h>
+#  include <unistd.h>
+#endif
+
 /* So ImathMath is included before our kernel_cpu_compat. */
 #ifdef WITH_OSL
 /* So no context pollution happens from indirectly included windows.h */
@@ -32,8 +37,10 @@
 
 #include "session/buffers.h"
 
+#include "util/debug.h"
 #include "util/guiding.h"
 #include "util/log.h"
+#include "util/path.h"
 #include "util/progress.h"
 #include "util/task.h"
 
@@ -53,6 +60,9 @@ CPUDevice::CPUDevice(const DeviceInfo &info_, Stats &stats_, Profiler &profiler_
 
 #ifdef WITH_EMBREE
   embree_device = rtcNewDevice("verbose=0");
+  kernel_globals.use_ray_packets = DebugFlags().cpu.ray_packets &&
+                                   rtcGetDeviceProperty(embree_device,
+                                                        RTC_DEVICE_PROPERTY_NATIVE_RAY4_SUPPORTED);
 #endif
   need_texture_info = false;
 }
@@ -87,6 +97,72 @@ bool CPUDevice::load_texture_info()
   return true;
 }
 
+/* Scene data arrays smaller than this are always kept in regular memory. */
+#define CPU_MAPPED_MEMORY_MIN_SIZE (64 * 1024 * 1024)
+
+#ifndef _WIN32
+/* Map an unlinked file in the scratch directory, so its pages are written to the file instead of
+ * swap when memory runs low. The file is removed by the system once the memory is unmapped. */
+static void *scratch_file_map(const string &scratch_dir, const size_t size)
+{
+  string filepath = path_join(scratch_dir, "cycles_scene_XXXXXX");
+  const int fd = mkstemp(filepath.data());
+  if (fd == -1) {
+    LOG(WARNING) << "Failed to create scratch file in " << scratch_dir;
+    return nullptr;
+  }
+  unlink(filepath.c_str());
+
+  void *data = nullptr;
+  if (ftruncate(fd, size) == 0) {
+    data = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    if (data == MAP_FAILED) {
+      data = nullptr;
+    }
+  }
+  close(fd);
+
+  if (data == nullptr) {
+    LOG(WARNING) << "Failed to map " << string_human_readable_size(size) << " scratch file in "
+                 << scratch_dir;
+  }
+  return data;
+}
+#endif
+
+void *CPUDevice::host_alloc(const MemoryType type, const size_t size)
+{
+#ifndef _WIN32
+  /* Only scene data is mapped, render buffers and other working memory is accessed too often. */
+  const string &scratch_dir = DebugFlags().cpu.scratch_dir;
+  if (type == MEM_GLOBAL && size >= CPU_MAPPED_MEMORY_MIN_SIZE && !scratch_dir.empty()) {
+    void *data = scratch_file_map(scratch_dir, size);
+    if (data) {
+      const thread_scoped_lock lock(mapped_memory_mutex);
+      mapped_memory.insert(data);
+      return data;
+    }
+  }
+#endif
+
+  return Device::host_alloc(type, size);
+}
+
+void CPUDevice::host_free(const MemoryType type, void *host_pointer, const size_t size)
+{
+#ifndef _WIN32
+  {
+    const thread_scoped_lock lock(mapped_memory_mutex);
+    if (mapped_memory.erase(host_pointer)) {
+      munmap(host_pointer, size);
+      return;
+    }
+  }
+#endif
+
+  Device::host_free(type, host_pointer, size);
+}
+
 void CPUDevice::mem_alloc(device_memory &mem)
 {
   if (mem.type == MEM_TEXTURE) {
@@ -30,6 +30,8 @@
 // clang-format on
 
 #include "util/guiding.h"  // IWYU pragma: keep
+#include "util/set.h"
+#include "util/thread.h"
 #include "util/unique_ptr.h"
 
 CCL_NAMESPACE_BEGIN
@@ -52,6 +54,10 @@ class CPUDevice : public Device {
   mutable unique_ptr<openpgl::cpp::Device> guiding_device;
 #endif
 
+  /* Host memory backed by files in the scratch directory, see #DebugFlags::CPU::scratch_dir. */
+  unordered_set<void *> mapped_memory;
+  thread_mutex mapped_memory_mutex;
+
   CPUDevice(const DeviceInfo &info_, Stats &stats_, Profiler &profiler_, bool headless_);
   ~CPUDevice() override;
 
@@ -61,6 +67,9 @@ class CPUDevice : public Device {
    * re-initialization might be needed). */
   bool load_texture_info();
 
+  void *host_alloc(const MemoryType type, const size_t size) override;
+  void host_free(const MemoryType type, void *host_pointer, const size_t size) override;
+
   void mem_alloc(device_memory &mem) override;
   void mem_copy_to(device_memory &mem) override;
   void mem_move_to_host(device_memory &mem) override;
@@ -20,6 +20,8 @@ CPUKernels::CPUKernels()
       REGISTER_KERNEL(integrator_init_from_camera),
       REGISTER_KERNEL(integrator_init_from_bake),
       REGISTER_KERNEL(integrator_megakernel),
+      REGISTER_KERNEL(integrator_megakernel_simple),
+      REGISTER_KERNEL(integrator_intersect_closest_packet),
       /* Shader evaluation. */
       REGISTER_KERNEL(shader_eval_displace),
       REGISTER_KERNEL(shader_eval_background),
@@ -27,10 +27,16 @@ class CPUKernels {
                                                             IntegratorStateCPU *state,
                                                             KernelWorkTile *tile,
                                                             ccl_global float *render_buffer)>;
+  using IntegratorPacketFunction = CPUKernelFunction<void (*)(
+      const ThreadKernelGlobalsCPU *kg, IntegratorStateCPU *states, const int num_states)>;
 
   IntegratorInitFunction integrator_init_from_camera;
   IntegratorInitFunction integrator_init_from_bake;
   IntegratorShadeFunction integrator_megakernel;
+  /* Megakernel without the features in #KERNEL_FEATURE_CPU_SIMPLE_EXCLUDED. */
+  IntegratorShadeFunction integrator_megakernel_simple;
+  /* Trace the camera rays of the given paths as ray packets, ahead of the megakernel. */
+  IntegratorPacketFunction integrator_intersect_closest_packet;
 
   /* Shader evaluation. */
 
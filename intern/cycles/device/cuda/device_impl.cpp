@@ -43,8 +43,17 @@ BVHLayoutMask CUDADevice::get_bvh_layout_mask(uint /*kernel_features*/) const
   return BVH_LAYOUT_BVH2;
 }
 
+/* Set in the thread compiling kernels in the background. */
+static thread_local bool is_kernel_precompile_thread = false;
+
 void CUDADevice::set_error(const string &error)
 {
+  /* Errors are reported once the kernels are loaded, when compiling again. */
+  if (is_kernel_precompile_thread) {
+    VLOG_WARNING << "Background kernel compilation failed: " << error;
+    return;
+  }
+
   Device::set_error(error);
 
   if (first_error) {
@@ -133,6 +142,7 @@ CUDADevice::CUDADevice(const DeviceInfo &info, Stats &stats, Profiler &profiler,
 
 CUDADevice::~CUDADevice()
 {
+  kernel_precompile_thread.reset();
   texture_info.free();
   if (cuModule) {
     cuda_assert(cuModuleUnload(cuModule));
@@ -301,6 +311,11 @@ string CUDADevice::compile_kernel(const string &common_cflags,
   const string cubin_file = string_printf(
       "cycles_%s_%s_%d%d_%s.%s", name, kernel_arch, major, minor, kernel_md5.c_str(), kernel_ext);
   const string cubin = path_cache_get(path_join("kernels", cubin_file));
+
+  /* Multiple devices and the background compilation may need the same kernel. */
+  static thread_mutex compile_mutex;
+  const thread_scoped_lock compile_lock(compile_mutex);
+
   VLOG_INFO << "Testing for locally compiled kernel " << cubin << ".";
   if (path_exists(cubin)) {
     VLOG_INFO << "Using locally compiled kernel.";
@@ -403,8 +418,26 @@ string CUDADevice::compile_kernel(const string &common_cflags,
   return cubin;
 }
 
+void CUDADevice::precompile_kernels()
+{
+  /* OptiX has its own kernels, and adaptive compilation depends on the kernel features. */
+  if (info.type != DEVICE_CUDA || use_adaptive_compilation() || cuContext == nullptr) {
+    return;
+  }
+
+  kernel_precompile_thread = make_unique<thread>([this]() {
+    is_kernel_precompile_thread = true;
+    compile_kernel(compile_kernel_get_common_cflags(0), "kernel");
+  });
+}
+
 bool CUDADevice::load_kernels(const uint kernel_features)
 {
+  if (kernel_precompile_thread) {
+    kernel_precompile_thread->join();
+    kernel_precompile_thread.reset();
+  }
+
   /* TODO(sergey): Support kernels re-load for CUDA devices adaptive compile.
    *
    * Currently re-loading kernel will invalidate memory pointers,
@@ -59,6 +59,7 @@ class CUDADevice : public GPUDevice {
                         bool force_ptx = false);
 
   bool load_kernels(const uint kernel_features) override;
+  void precompile_kernels() override;
   void reserve_local_memory(const uint kernel_features);
 
   /* All memory types. */
@@ -105,6 +106,9 @@ class CUDADevice : public GPUDevice {
   int get_max_num_threads_per_multiprocessor();
 
  protected:
+  /* Compiles the kernel in the background, see #precompile_kernels(). */
+  unique_ptr<thread> kernel_precompile_thread;
+
   bool get_device_attribute(CUdevice_attribute attribute, int *value);
   int get_device_default_attribute(CUdevice_attribute attribute, const int default_value);
 };
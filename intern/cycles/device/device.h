@@ -184,6 +184,10 @@ class Device {
     return true;
   }
 
+  /* Start compiling kernels that don't depend on the kernel features in the background, so that
+   * it happens while the scene is being synchronized. load_kernels() waits for it to finish. */
+  virtual void precompile_kernels() {}
+
   /* Request cancellation of any long-running work. */
   virtual void cancel() {}
 
@@ -42,8 +42,17 @@ BVHLayoutMask HIPDevice::get_bvh_layout_mask(uint /*kernel_features*/) const
   return BVH_LAYOUT_BVH2;
 }
 
+/* Set in the thread compiling kernels in the background. */
+static thread_local bool is_kernel_precompile_thread = false;
+
 void HIPDevice::set_error(const string &error)
 {
+  /* Errors are reported once the kernels are loaded, when compiling again. */
+  if (is_kernel_precompile_thread) {
+    VLOG_WARNING << "Background kernel compilation failed: " << error;
+    return;
+  }
+
   Device::set_error(error);
 
   if (first_error) {
@@ -126,6 +135,7 @@ HIPDevice::HIPDevice(const DeviceInfo &info, Stats &stats, Profiler &profiler, b
 
 HIPDevice::~HIPDevice()
 {
+  kernel_precompile_thread.reset();
   texture_info.free();
   if (hipModule) {
     hip_assert(hipModuleUnload(hipModule));
@@ -282,6 +292,11 @@ string HIPDevice::compile_kernel(const uint kernel_features, const char *name, c
   const string fatbin_file = string_printf(
       "cycles_%s_%s_%s", name, arch.c_str(), kernel_md5.c_str());
   const string fatbin = path_cache_get(path_join("kernels", fatbin_file));
+
+  /* Multiple devices and the background compilation may need the same kernel. */
+  static thread_mutex compile_mutex;
+  const thread_scoped_lock compile_lock(compile_mutex);
+
   VLOG_INFO << "Testing for locally compiled kernel " << fatbin << ".";
   if (path_exists(fatbin)) {
     VLOG_INFO << "Using locally compiled kernel.";
@@ -372,8 +387,26 @@ string HIPDevice::compile_kernel(const uint kernel_features, const char *name, c
   return fatbin;
 }
 
+void HIPDevice::precompile_kernels()
+{
+  /* HIP-RT has its own kernels, and adaptive compilation depends on the kernel features. */
+  if (info.use_hardware_raytracing || use_adaptive_compilation() || hipContext == nullptr) {
+    return;
+  }
+
+  kernel_precompile_thread = make_unique<thread>([this]() {
+    is_kernel_precompile_thread = true;
+    compile_kernel(0, "kernel");
+  });
+}
+
 bool HIPDevice::load_kernels(const uint kernel_features)
 {
+  if (kernel_precompile_thread) {
+    kernel_precompile_thread->join();
+    kernel_precompile_thread.reset();
+  }
+
   /* TODO(sergey): Support kernels re-load for HIP devices adaptive compile.
    *
    * Currently re-loading kernels will invalidate memory pointers.
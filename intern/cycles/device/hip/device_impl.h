@@ -58,6 +58,7 @@ class HIPDevice : public GPUDevice {
                                 const char *base = "hip");
 
   bool load_kernels(const uint kernel_features) override;
+  void precompile_kernels() override;
   void reserve_local_memory(const uint kernel_features);
 
   /* All memory types. */
@@ -105,6 +106,9 @@ class HIPDevice : public GPUDevice {
   int get_max_num_threads_per_multiprocessor();
 
  protected:
+  /* Compiles the kernel in the background, see #precompile_kernels(). */
+  unique_ptr<thread> kernel_precompile_thread;
+
   bool get_device_attribute(hipDeviceAttribute_t attribute, int *value);
   int get_device_default_attribute(hipDeviceAttribute_t attribute, const int default_value);
 };
@@ -182,6 +182,13 @@ class MultiDevice : public Device {
     return true;
   }
 
+  void precompile_kernels() override
+  {
+    for (SubDevice &sub : devices) {
+      sub.device->precompile_kernels();
+    }
+  }
+
   bool load_osl_kernels() override
   {
     for (SubDevice &sub : devices) {
@@ -60,17 +60,21 @@ PathTrace::PathTrace(Device *device,
 
   work_balance_infos_.resize(path_trace_works_.size());
   work_balance_do_initial(work_balance_infos_);
+  work_statistics_.resize(path_trace_works_.size());
 
   render_scheduler.set_need_schedule_rebalance(path_trace_works_.size() > 1);
 }
 
 PathTrace::~PathTrace()
 {
+  denoise_async_cancel();
   destroy_gpu_resources();
 }
 
 void PathTrace::load_kernels()
 {
+  denoise_async_cancel();
+
   if (denoiser_) {
     /* Activate graphics interop while denoiser device is created, so that it can choose a device
      * that supports interop for faster display updates. */
@@ -135,6 +139,8 @@ void PathTrace::reset(const BufferParams &full_params,
     display_->reset(big_tile_params, reset_rendering);
   }
 
+  denoise_async_cancel();
+
   render_state_.has_denoised_result = false;
   render_state_.tile_written = false;
 
@@ -143,6 +149,8 @@ void PathTrace::reset(const BufferParams &full_params,
 
 void PathTrace::device_free()
 {
+  denoise_async_cancel();
+
   /* Free render buffers used by the path trace work to reduce memory peak. */
   BufferParams empty_params;
   empty_params.pass_stride = 0;
@@ -415,6 +423,11 @@ void PathTrace::path_trace(RenderWork &render_work)
     work_balance_infos_[i].time_spent += work_time;
     work_balance_infos_[i].occupancy = statistics.occupancy;
 
+    const BufferParams &buffer_params = path_trace_work->get_render_buffers()->params;
+    work_statistics_[i].time_spent += work_time;
+    work_statistics_[i].num_pixel_samples += double(buffer_params.width) * buffer_params.height *
+                                             num_samples;
+
     VLOG_INFO << "Rendered " << num_samples << " samples in " << work_time << " seconds ("
               << work_time / num_samples
               << " seconds per sample), occupancy: " << statistics.occupancy;
@@ -492,6 +505,8 @@ void PathTrace::adaptive_sample(RenderWork &render_work)
 
 void PathTrace::set_denoiser_params(const DenoiseParams &params)
 {
+  denoise_async_cancel();
+
   if (!params.use) {
     denoiser_.reset();
     return;
@@ -593,10 +608,24 @@ void PathTrace::denoise(const RenderWork &render_work)
     return;
   }
 
-  VLOG_WORK << "Perform denoising work.";
-
   const double start_time = time_dt();
 
+  if (denoise_use_async(render_work)) {
+    /* Pick up the previous result first, ignoring this work if the denoiser is still busy. The
+     * next denoising work will include the samples rendered meanwhile. */
+    denoise_async_update(false);
+    if (!denoise_async_.denoise_thread) {
+      denoise_async_start();
+    }
+    render_scheduler_.report_denoise_time(render_work, time_dt() - start_time);
+    return;
+  }
+
+  /* The denoiser can not be used from two threads at once. */
+  denoise_async_update(true);
+
+  VLOG_WORK << "Perform denoising work.";
+
   RenderBuffers *buffer_to_denoise = nullptr;
   bool allow_inplace_modification = false;
 
@@ -615,7 +644,9 @@ void PathTrace::denoise(const RenderWork &render_work)
 
     copy_to_render_buffers(buffer_to_denoise);
 
-    allow_inplace_modification = true;
+    /* Tiles are written to disk from this buffer, and the guiding passes are to be kept intact in
+     * the file. */
+    allow_inplace_modification = !tile_manager_.is_tile_denoising_used();
   }
   else {
     DCHECK_EQ(path_trace_works_.size(), 1);
@@ -634,6 +665,101 @@ void PathTrace::denoise(const RenderWork &render_work)
   render_scheduler_.report_denoise_time(render_work, time_dt() - start_time);
 }
 
+bool PathTrace::denoise_use_async(const RenderWork &render_work) const
+{
+  if (render_work.tile.write || render_scheduler_.done()) {
+    /* The final result is to be denoised. */
+    return false;
+  }
+
+  const Device *denoiser_device = denoiser_->get_denoiser_device();
+  if (!denoiser_device) {
+    return false;
+  }
+
+  /* Denoising on a device which renders would compete with the path tracing, and CPU denoising
+   * would compete with the CPU path tracing for the threads. */
+  for (const unique_ptr<PathTraceWork> &path_trace_work : path_trace_works_) {
+    const Device *path_trace_device = path_trace_work->get_device();
+    if (path_trace_device == denoiser_device ||
+        (path_trace_device->info.type == DEVICE_CPU && denoiser_device->info.type == DEVICE_CPU))
+    {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+void PathTrace::denoise_async_start()
+{
+  VLOG_WORK << "Perform asynchronous denoising work.";
+
+  if (!denoise_async_.work) {
+    denoise_async_.work = PathTraceWork::create(
+        denoiser_->get_denoiser_device(), film_, device_scene_, nullptr);
+  }
+
+  const BufferParams &buffer_params = render_state_.effective_big_tile_params;
+  denoise_async_.work->set_effective_buffer_params(buffer_params, buffer_params, buffer_params);
+  denoise_async_.buffer_params = buffer_params;
+
+  RenderBuffers *buffer_to_denoise = denoise_async_.work->get_render_buffers();
+  buffer_to_denoise->reset(buffer_params);
+  copy_to_render_buffers(buffer_to_denoise);
+
+  denoise_async_.finished = false;
+  denoise_async_.success = false;
+
+  const int num_samples = get_num_samples_in_buffer();
+  denoise_async_.denoise_thread = make_unique<thread>([this, buffer_to_denoise, num_samples]() {
+    const bool success = denoiser_->denoise_buffer(
+        denoise_async_.buffer_params, buffer_to_denoise, num_samples, true);
+
+    const thread_scoped_lock lock(denoise_async_.mutex);
+    denoise_async_.finished = true;
+    denoise_async_.success = success;
+  });
+}
+
+void PathTrace::denoise_async_update(const bool wait)
+{
+  if (!denoise_async_.denoise_thread) {
+    return;
+  }
+
+  if (!wait) {
+    const thread_scoped_lock lock(denoise_async_.mutex);
+    if (!denoise_async_.finished) {
+      return;
+    }
+  }
+
+  denoise_async_.denoise_thread->join();
+  denoise_async_.denoise_thread.reset();
+
+  if (!denoise_async_.success ||
+      denoise_async_.buffer_params.modified(render_state_.effective_big_tile_params))
+  {
+    VLOG_WORK << "Ignoring result of asynchronous denoising.";
+    return;
+  }
+
+  /* Display the new result, the previous one will be overwritten by the next denoising work. */
+  std::swap(big_tile_denoise_work_, denoise_async_.work);
+  render_state_.has_denoised_result = true;
+}
+
+void PathTrace::denoise_async_cancel()
+{
+  if (!denoise_async_.denoise_thread) {
+    return;
+  }
+
+  denoise_async_.denoise_thread->join();
+  denoise_async_.denoise_thread.reset();
+}
+
 void PathTrace::set_output_driver(unique_ptr<OutputDriver> driver)
 {
   output_driver_ = std::move(driver);
@@ -690,6 +816,9 @@ void PathTrace::update_display(const RenderWork &render_work)
     return;
   }
 
+  /* Display the latest denoised result as soon as it is available. */
+  denoise_async_update(false);
+
   if (full_params_.width == 0 || full_params_.height == 0) {
     VLOG_WORK << "Skipping PathTraceDisplay update due to 0 size of the render buffer.";
     return;
@@ -927,7 +1056,13 @@ void PathTrace::tile_buffer_write_to_disk()
   RenderBuffers *buffers;
   RenderBuffers big_tile_cpu_buffers(cpu_device_.get());
 
-  if (path_trace_works_.size() == 1) {
+  if (big_tile_denoise_work_ && render_state_.has_denoised_result) {
+    /* The tile was denoised on a separate device, which holds both the noisy and denoised passes.
+     */
+    big_tile_denoise_work_->copy_render_buffers_from_device();
+    buffers = big_tile_denoise_work_->get_render_buffers();
+  }
+  else if (path_trace_works_.size() == 1) {
     path_trace_works_[0]->copy_render_buffers_from_device();
     buffers = path_trace_works_[0]->get_render_buffers();
   }
@@ -1037,7 +1172,10 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
   RenderBuffers full_frame_buffers(cpu_device_.get());
 
   DenoiseParams denoise_params;
-  if (!tile_manager_.read_full_buffer_from_disk(filename, &full_frame_buffers, &denoise_params)) {
+  bool is_denoised = false;
+  if (!tile_manager_.read_full_buffer_from_disk(
+          filename, &full_frame_buffers, &denoise_params, &is_denoised))
+  {
     const string error_message = "Error reading tiles from file";
     if (progress_) {
       progress_->set_error(error_message);
@@ -1051,9 +1189,13 @@ void PathTrace::process_full_buffer_from_disk(string_view filename)
 
   const string layer_view_name = get_layer_view_name(full_frame_buffers);
 
-  render_state_.has_denoised_result = false;
+  denoise_async_cancel();
+  render_state_.has_denoised_result = is_denoised;
 
-  if (denoise_params.use && denoiser_ && !progress_->get_cancel()) {
+  if (is_denoised) {
+    VLOG_WORK << "Tiles were denoised while rendering.";
+  }
+  else if (denoise_params.use && denoiser_ && !progress_->get_cancel()) {
     progress_set_status(layer_view_name, "Denoising");
 
     /* If GPU should be used is not based on file metadata. */
@@ -1193,6 +1335,9 @@ void PathTrace::destroy_gpu_resources()
     if (big_tile_denoise_work_) {
       big_tile_denoise_work_->destroy_gpu_resources(display_.get());
     }
+    if (denoise_async_.work) {
+      denoise_async_.work->destroy_gpu_resources(display_.get());
+    }
   }
 }
 
@@ -1299,6 +1444,32 @@ static string path_trace_devices_report(const vector<unique_ptr<PathTraceWork>>
   return device_info_list_report("Path tracing on", device_info);
 }
 
+static string path_trace_works_statistics_report(
+    const vector<unique_ptr<PathTraceWork>> &path_trace_works,
+    const vector<WorkBalanceInfo> &work_balance_infos,
+    const vector<PathTrace::WorkStatistics> &work_statistics)
+{
+  if (path_trace_works.size() < 2) {
+    return "";
+  }
+
+  string result = "\nPer-device path tracing:\n";
+  result += string_printf("  %-40s %10s %12s %16s\n", "", "Weight", "Time", "Samples/second");
+  for (size_t i = 0; i < path_trace_works.size(); i++) {
+    const PathTrace::WorkStatistics &statistics = work_statistics[i];
+    const double throughput = (statistics.time_spent > 0.0) ?
+                                  statistics.num_pixel_samples / statistics.time_spent :
+                                  0.0;
+    result += string_printf("  %-40s %10f %12f %16s\n",
+                            path_trace_works[i]->get_device()->info.description.c_str(),
+                            work_balance_infos[i].weight,
+                            statistics.time_spent,
+                            string_human_readable_number(size_t(throughput)).c_str());
+  }
+
+  return result;
+}
+
 static string denoiser_device_report(const Denoiser *denoiser)
 {
   if (!denoiser) {
@@ -1322,6 +1493,8 @@ string PathTrace::full_report() const
   string result = "\nFull path tracing report\n";
 
   result += path_trace_devices_report(path_trace_works_);
+  result += path_trace_works_statistics_report(
+      path_trace_works_, work_balance_infos_, work_statistics_);
   result += denoiser_device_report(denoiser_.get());
 
   /* Report from the render scheduler, which includes:
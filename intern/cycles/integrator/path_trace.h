@@ -43,6 +43,13 @@ class TileManager;
  *  - Adaptive stopping. */
 class PathTrace {
  public:
+  /* Path tracing statistics of a single device, accumulated over all rendered samples. */
+  struct WorkStatistics {
+    double time_spent = 0.0;
+    /* Number of rendered samples summed over all pixels. */
+    double num_pixel_samples = 0.0;
+  };
+
   /* Render scheduler is used to report timing information and access things like start/finish
    * sample. */
   PathTrace(Device *device,
@@ -249,6 +256,19 @@ class PathTrace {
   /* Destroy GPU resources (such as graphics interop) used by work. */
   void destroy_gpu_resources();
 
+  /* Denoising on a device which is not used for path tracing, in a separate thread. The path
+   * tracer continues rendering samples while the denoiser works on a copy of the render buffers,
+   * and the result is displayed once it is ready.
+   *
+   * Only used for intermediate results: the final result of a tile is denoised synchronously. */
+  bool denoise_use_async(const RenderWork &render_work) const;
+  void denoise_async_start();
+  /* Make the result of the asynchronous denoiser available when it is finished, or wait for it
+   * when `wait` is true. */
+  void denoise_async_update(bool wait);
+  /* Wait for the asynchronous denoiser to finish, and ignore its result. */
+  void denoise_async_cancel();
+
   /* Pointer to a device which is configured to be used for path tracing. If multiple devices
    * are configured this is a `MultiDevice`. */
   Device *device_ = nullptr;
@@ -279,6 +299,9 @@ class PathTrace {
   /* Per-path trace work information needed for multi-device balancing. */
   vector<WorkBalanceInfo> work_balance_infos_;
 
+  /* Per-path trace work statistics, for the full report. */
+  vector<WorkStatistics> work_statistics_;
+
   /* Render buffer parameters of the full frame and current big tile. */
   BufferParams full_params_;
   BufferParams big_tile_params_;
@@ -289,6 +312,23 @@ class PathTrace {
   /* Denoiser device descriptor which holds the denoised big tile for multi-device workloads. */
   unique_ptr<PathTraceWork> big_tile_denoise_work_;
 
+  /* State of the denoiser running asynchronously to the path tracing. */
+  struct {
+    unique_ptr<thread> denoise_thread;
+
+    /* Work which holds the buffers being denoised. It is swapped with the #big_tile_denoise_work_
+     * once the denoiser finished, so that the previous result can be displayed meanwhile. */
+    unique_ptr<PathTraceWork> work;
+
+    /* Parameters of the buffers being denoised, the result is ignored if the effective big tile
+     * parameters changed meanwhile. */
+    BufferParams buffer_params;
+
+    thread_mutex mutex;
+    bool finished = false;
+    bool success = false;
+  } denoise_async_;
+
 #ifdef WITH_PATH_GUIDING
   /* Guiding related attributes */
   GuidingParams guiding_params_;
@@ -43,6 +43,15 @@ static inline ThreadKernelGlobalsCPU *kernel_thread_globals_get(
   return &kernel_thread_globals[thread_index];
 }
 
+/* Use the megakernel without code for features the scene does not use, when possible. */
+static inline const CPUKernels::IntegratorShadeFunction &megakernel_get(const CPUKernels &kernels,
+                                                                        const KernelData &data)
+{
+  return (data.kernel_features & KERNEL_FEATURE_CPU_SIMPLE_EXCLUDED) ?
+             kernels.integrator_megakernel :
+             kernels.integrator_megakernel_simple;
+}
+
 PathTraceWorkCPU::PathTraceWorkCPU(Device *device,
                                    Film *film,
                                    DeviceScene *device_scene,
@@ -97,7 +106,12 @@ void PathTraceWorkCPU::render_samples(RenderStatistics &statistics,
 
       ThreadKernelGlobalsCPU *kernel_globals = kernel_thread_globals_get(kernel_thread_globals_);
 
-      render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      if (use_ray_packets(kernel_globals)) {
+        render_samples_ray_packets(kernel_globals, work_tile, samples_num);
+      }
+      else {
+        render_samples_full_pipeline(kernel_globals, work_tile, samples_num);
+      }
     });
   });
   if (device_->profiler.active()) {
@@ -114,6 +128,8 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
                                                     const int samples_num)
 {
   const bool has_bake = device_scene_->data.bake.use;
+  const CPUKernels::IntegratorShadeFunction &megakernel = megakernel_get(
+      kernels_, device_scene_->data);
 
   IntegratorStateCPU integrator_states[2];
 
@@ -153,7 +169,7 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
       assert(kernel_globals->opgl_path_segment_storage);
       assert(kernel_globals->opgl_path_segment_storage->GetNumSegments() == 0);
 
-      kernels_.integrator_megakernel(kernel_globals, state, render_buffer);
+      megakernel(kernel_globals, state, render_buffer);
 
       /* Push the generated sample data to the global sample data storage. */
       guiding_push_sample_data_to_global_storage(kernel_globals, state, render_buffer);
@@ -161,22 +177,78 @@ void PathTraceWorkCPU::render_samples_full_pipeline(ThreadKernelGlobalsCPU *kern
       /* No training for shadow catcher paths. */
       if (shadow_catcher_state) {
         kernel_globals->data.integrator.train_guiding = false;
-        kernels_.integrator_megakernel(kernel_globals, shadow_catcher_state, render_buffer);
+        megakernel(kernel_globals, shadow_catcher_state, render_buffer);
         kernel_globals->data.integrator.train_guiding = true;
       }
     }
     else
 #endif
     {
-      kernels_.integrator_megakernel(kernel_globals, state, render_buffer);
+      megakernel(kernel_globals, state, render_buffer);
       if (shadow_catcher_state) {
-        kernels_.integrator_megakernel(kernel_globals, shadow_catcher_state, render_buffer);
+        megakernel(kernel_globals, shadow_catcher_state, render_buffer);
       }
     }
     ++sample_work_tile.start_sample;
   }
 }
 
+bool PathTraceWorkCPU::use_ray_packets(const ThreadKernelGlobalsCPU *kernel_globals) const
+{
+  if (!kernel_globals->use_ray_packets || !kernel_globals->data.device_bvh) {
+    return false;
+  }
+
+  /* The shadow catcher splits a path into two states, that are not laid out for packets.
+   * Baking does not use camera rays, and guiding needs to push the data of every path. */
+  const KernelData &data = device_scene_->data;
+  return !data.integrator.has_shadow_catcher && !data.bake.use &&
+         !data.integrator.train_guiding;
+}
+
+void PathTraceWorkCPU::render_samples_ray_packets(ThreadKernelGlobalsCPU *kernel_globals,
+                                                  const KernelWorkTile &work_tile,
+                                                  const int samples_num)
+{
+  const CPUKernels::IntegratorShadeFunction &megakernel = megakernel_get(
+      kernels_, device_scene_->data);
+
+  /* Paths of consecutive samples of the pixel, their camera rays are traced together. */
+  constexpr int num_packet_states = 4;
+  IntegratorStateCPU integrator_states[num_packet_states];
+
+  KernelWorkTile sample_work_tile = work_tile;
+  float *render_buffer = buffers_->buffer.data();
+
+  bool finished = false;
+  for (int sample = 0; sample < samples_num && !finished;) {
+    if (is_cancel_requested()) {
+      break;
+    }
+
+    const int num_samples = min(num_packet_states, samples_num - sample);
+    int num_states = 0;
+    while (num_states < num_samples) {
+      if (!kernels_.integrator_init_from_camera(
+              kernel_globals, &integrator_states[num_states], &sample_work_tile, render_buffer))
+      {
+        finished = true;
+        break;
+      }
+      ++sample_work_tile.start_sample;
+      ++num_states;
+    }
+
+    kernels_.integrator_intersect_closest_packet(kernel_globals, integrator_states, num_states);
+
+    for (int i = 0; i < num_states; i++) {
+      megakernel(kernel_globals, &integrator_states[i], render_buffer);
+    }
+
+    sample += num_states;
+  }
+}
+
 void PathTraceWorkCPU::copy_to_display(PathTraceDisplay *display,
                                        PassMode pass_mode,
                                        const int num_samples)
@@ -74,6 +74,12 @@ class PathTraceWorkCPU : public PathTraceWork {
                                     const KernelWorkTile &work_tile,
                                     const int samples_num);
 
+  /* Same as above, but tracing the camera rays of consecutive samples as ray packets. */
+  bool use_ray_packets(const ThreadKernelGlobalsCPU *kernel_globals) const;
+  void render_samples_ray_packets(ThreadKernelGlobalsCPU *kernel_globals,
+                                  const KernelWorkTile &work_tile,
+                                  const int samples_num);
+
   /* CPU kernels. */
   const CPUKernels &kernels_;
 
@@ -14,6 +14,7 @@
 
 #include "util/log.h"
 #include "util/string.h"
+#include "util/time.h"
 
 #include "kernel/types.h"
 
@@ -105,6 +106,32 @@ PathTraceWorkGPU::PathTraceWorkGPU(Device *device,
   memset(&integrator_state_gpu_, 0, sizeof(integrator_state_gpu_));
 }
 
+PathTraceWorkGPU::~PathTraceWorkGPU()
+{
+  if (!VLOG_DEVICE_STATS_IS_ON || max_num_paths_ == 0) {
+    return;
+  }
+
+  VLOG_DEVICE_STATS << "GPU path iteration stats:";
+  for (int i = 0; i < DEVICE_KERNEL_INTEGRATOR_NUM; i++) {
+    const KernelLaunchStatistics &statistics = kernel_launch_statistics_[i];
+    if (statistics.num_launches == 0) {
+      continue;
+    }
+    const double average_num_paths = double(statistics.num_paths) / statistics.num_launches;
+    string message = string_printf("  %s: %lld launches, %.0f paths on average, %.1f%% occupancy",
+                                   device_kernel_as_string(DeviceKernel(i)),
+                                   (long long)statistics.num_launches,
+                                   average_num_paths,
+                                   100.0 * average_num_paths / max_num_paths_);
+    if (kernel_uses_sorting(DeviceKernel(i))) {
+      message += string_printf(", shader sorting %s",
+                               shader_sort_policy_[i].use_sorting ? "enabled" : "disabled");
+    }
+    VLOG_DEVICE_STATS << message;
+  }
+}
+
 void PathTraceWorkGPU::alloc_integrator_soa()
 {
   /* IntegrateState allocated as structure of arrays. */
@@ -383,6 +410,8 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
     }
 
     /* Enqueue on of the path iteration kernels. */
+    const double iteration_start_time = time_dt();
+    last_sorting_kernel_ = DEVICE_KERNEL_NUM;
     if (enqueue_path_iteration()) {
       /* Copy stats from the device. */
       queue_->copy_from_device(integrator_queue_counter_);
@@ -390,6 +419,12 @@ void PathTraceWorkGPU::render_samples(RenderStatistics &statistics,
       if (!queue_->synchronize()) {
         break; /* Stop on error. */
       }
+
+      if (last_sorting_kernel_ != DEVICE_KERNEL_NUM) {
+        shader_sort_policy_report(last_sorting_kernel_,
+                                  last_sorting_kernel_num_paths_,
+                                  time_dt() - iteration_start_time);
+      }
     }
 
     if (is_cancel_requested()) {
@@ -518,7 +553,14 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
   IntegratorQueueCounter *queue_counter = integrator_queue_counter_.data();
   const int num_queued = queue_counter->num_queued[kernel];
 
+  const bool use_sorting = kernel_uses_sorting(kernel) &&
+                           shader_sort_policy_use_sorting(kernel);
   if (kernel_uses_sorting(kernel)) {
+    last_sorting_kernel_ = kernel;
+    last_sorting_kernel_num_paths_ = min(num_queued, num_paths_limit);
+  }
+
+  if (use_sorting) {
     /* Compute array of active paths, sorted by shader. */
     work_size = num_queued;
     d_path_index = queued_paths_.device_pointer;
@@ -543,6 +585,24 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
 
   DCHECK_LE(work_size, max_num_paths_);
 
+  if (kernel_uses_sorting(kernel) && !use_sorting) {
+    /* Shading keys were still counted when the paths were queued, clear them as the prefix sum
+     * would have done. */
+    device_vector<int> *sort_counter = &integrator_shader_sort_counter_;
+    if (kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_RAYTRACE) {
+      sort_counter = &integrator_shader_raytrace_sort_counter_;
+    }
+    else if (kernel == DEVICE_KERNEL_INTEGRATOR_SHADE_SURFACE_MNEE) {
+      sort_counter = &integrator_shader_mnee_sort_counter_;
+    }
+    if (sort_counter->size() != 0) {
+      queue_->zero_to_device(*sort_counter);
+    }
+  }
+
+  kernel_launch_statistics_[kernel].num_launches++;
+  kernel_launch_statistics_[kernel].num_paths += work_size;
+
   switch (kernel) {
     case DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST: {
       /* Closest ray intersection kernels with integrator state and render buffer. */
@@ -586,6 +646,61 @@ void PathTraceWorkGPU::enqueue_path_iteration(DeviceKernel kernel, const int num
   }
 }
 
+/* Number of launches of a kernel with and without shader sorting to measure its cost, at the
+ * start of every period. */
+#define SHADER_SORT_POLICY_MEASURE_LAUNCHES 8
+/* Number of launches after which the measurements are done again. */
+#define SHADER_SORT_POLICY_PERIOD_LAUNCHES 512
+
+bool PathTraceWorkGPU::shader_sort_policy_use_sorting(DeviceKernel kernel) const
+{
+  const ShaderSortPolicy &policy = shader_sort_policy_[kernel];
+  if (policy.num_launches < SHADER_SORT_POLICY_MEASURE_LAUNCHES) {
+    return true;
+  }
+  if (policy.num_launches < 2 * SHADER_SORT_POLICY_MEASURE_LAUNCHES) {
+    return false;
+  }
+  return policy.use_sorting;
+}
+
+void PathTraceWorkGPU::shader_sort_policy_report(DeviceKernel kernel,
+                                                 const int num_paths,
+                                                 const double time)
+{
+  ShaderSortPolicy &policy = shader_sort_policy_[kernel];
+  const bool use_sorting = shader_sort_policy_use_sorting(kernel);
+
+  if (policy.num_launches < 2 * SHADER_SORT_POLICY_MEASURE_LAUNCHES) {
+    policy.time[use_sorting] += time;
+    policy.num_paths[use_sorting] += num_paths;
+  }
+
+  policy.num_launches++;
+
+  if (policy.num_launches == 2 * SHADER_SORT_POLICY_MEASURE_LAUNCHES) {
+    /* Prefer sorting unless skipping it is measurably faster, sorting also improves the memory
+     * access coherence of the kernels that follow. */
+    if (policy.num_paths[0] && policy.num_paths[1]) {
+      const double time_per_path_unsorted = policy.time[0] / policy.num_paths[0];
+      const double time_per_path_sorted = policy.time[1] / policy.num_paths[1];
+      const bool use_sorting_new = time_per_path_sorted < time_per_path_unsorted * 1.05;
+      if (use_sorting_new != policy.use_sorting) {
+        VLOG_WORK << (use_sorting_new ? "Enabling" : "Disabling") << " shader sorting for "
+                  << device_kernel_as_string(kernel) << ", " << time_per_path_sorted * 1e9
+                  << " ns per path sorted, " << time_per_path_unsorted * 1e9
+                  << " ns per path unsorted.";
+      }
+      policy.use_sorting = use_sorting_new;
+    }
+  }
+  else if (policy.num_launches >= SHADER_SORT_POLICY_PERIOD_LAUNCHES) {
+    const bool use_sorting_prev = policy.use_sorting;
+    policy = ShaderSortPolicy();
+    policy.use_sorting = use_sorting_prev;
+  }
+}
+
 void PathTraceWorkGPU::compute_sorted_queued_paths(DeviceKernel queued_kernel,
                                                    const int num_paths_limit)
 {
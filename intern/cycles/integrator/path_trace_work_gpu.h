@@ -28,6 +28,7 @@ class PathTraceWorkGPU : public PathTraceWork {
                    Film *film,
                    DeviceScene *device_scene,
                    const bool *cancel_requested_flag);
+  ~PathTraceWorkGPU() override;
 
   void alloc_work_memory() override;
   void init_execution() override;
@@ -83,6 +84,13 @@ class PathTraceWorkGPU : public PathTraceWork {
 
   int num_active_main_paths_paths();
 
+  /* Decide whether to sort paths by shader before launching the kernel, or to only compact them.
+   * Sorting reduces divergence in the shading kernel, but when it is not reducing the kernel time
+   * by more than it costs it is skipped. The decision is based on the time per path measured in
+   * both modes, which is periodically measured again to follow changes in the scene. */
+  bool shader_sort_policy_use_sorting(DeviceKernel kernel) const;
+  void shader_sort_policy_report(DeviceKernel kernel, const int num_paths, const double time);
+
   /* Check whether graphics interop can be used for the PathTraceDisplay update. */
   bool should_use_graphics_interop(PathTraceDisplay *display);
 
@@ -161,6 +169,30 @@ class PathTraceWorkGPU : public PathTraceWork {
   /* Number of partitions to sort state indices into prior to material sort. */
   int num_sort_partitions_;
 
+  /* Measurements for the shader sorting policy of the kernels which use sorting. */
+  struct ShaderSortPolicy {
+    /* Time and number of paths of the launches of the current measurement period, without and
+     * with sorting. */
+    double time[2] = {0.0, 0.0};
+    int64_t num_paths[2] = {0, 0};
+    /* Number of launches since the start of the measurement period. */
+    int num_launches = 0;
+    bool use_sorting = true;
+  };
+  ShaderSortPolicy shader_sort_policy_[DEVICE_KERNEL_INTEGRATOR_NUM];
+
+  /* Sorting kernel launched by the last path iteration and whether it sorted paths, so its time
+   * can be reported to the policy. DEVICE_KERNEL_NUM if no such kernel was launched. */
+  DeviceKernel last_sorting_kernel_ = DEVICE_KERNEL_NUM;
+  int last_sorting_kernel_num_paths_ = 0;
+
+  /* Number of launches and launched paths for every path iteration kernel, for the log. */
+  struct KernelLaunchStatistics {
+    int64_t num_launches = 0;
+    int64_t num_paths = 0;
+  };
+  KernelLaunchStatistics kernel_launch_statistics_[DEVICE_KERNEL_INTEGRATOR_NUM];
+
   /* Maximum number of concurrent integrator states. */
   int max_num_paths_;
 
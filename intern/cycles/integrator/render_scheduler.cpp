@@ -96,6 +96,10 @@ int RenderScheduler::get_sample_offset() const
 void RenderScheduler::set_time_limit(const double time_limit)
 {
   time_limit_ = time_limit;
+
+  /* With a time limit the render is not guaranteed to reach the final threshold, so spend the
+   * available time on the pixels with the highest error first, as is done in the viewport. */
+  use_progressive_noise_floor_ = !background_ || time_limit_ != 0.0;
 }
 
 double RenderScheduler::get_time_limit() const
@@ -169,11 +173,26 @@ void RenderScheduler::reset(const BufferParams &buffer_params)
   adaptive_filter_time_.reset();
   display_update_time_.reset();
   rebalance_time_.reset();
+
+  time_limit_unused_ = 0.0;
+  num_finished_tiles_ = 0;
 }
 
 void RenderScheduler::reset_for_next_tile()
 {
+  double time_limit_unused = time_limit_unused_;
+  if (time_limit_ != 0.0 && state_.start_render_time != 0.0 && state_.end_render_time != 0.0) {
+    const double tile_time = state_.end_render_time - state_.start_render_time;
+    time_limit_unused = max(time_limit_unused + time_limit_ - tile_time, 0.0);
+    VLOG_WORK << "Tile rendered in " << tile_time << " seconds, "
+              << time_limit_unused << " seconds of time limit left over for next tiles.";
+  }
+  const int num_finished_tiles = num_finished_tiles_ + 1;
+
   reset(buffer_params_);
+
+  time_limit_unused_ = time_limit_unused;
+  num_finished_tiles_ = num_finished_tiles;
 }
 
 bool RenderScheduler::render_work_reschedule_on_converge(RenderWork &render_work)
@@ -258,6 +277,11 @@ void RenderScheduler::render_work_reschedule_on_cancel(RenderWork &render_work)
     render_work.full.write = true;
   }
 
+  /* Tiles in the file are all expected to have denoised passes when denoising them separately. */
+  if (render_work.tile.write && has_rendered_samples && tile_manager_.is_tile_denoising_used()) {
+    render_work.tile.denoise = true;
+  }
+
   /* Update current tile, but only if any sample was rendered.
    * Allows to have latest state of tile visible while full buffer is being processed.
    *
@@ -403,7 +427,8 @@ bool RenderScheduler::set_postprocess_render_work(RenderWork *render_work)
   }
 
   if (denoiser_params_.use && !state_.last_work_tile_was_denoised) {
-    render_work->tile.denoise = !tile_manager_.has_multiple_tiles();
+    render_work->tile.denoise = !tile_manager_.has_multiple_tiles() ||
+                                tile_manager_.is_tile_denoising_used();
     any_scheduled = true;
   }
 
@@ -709,9 +734,10 @@ double RenderScheduler::guess_display_update_interval_in_seconds_for_num_samples
   double update_interval = guess_display_update_interval_in_seconds_for_num_samples_no_limit(
       num_rendered_samples);
 
-  if (time_limit_ != 0.0 && state_.start_render_time != 0.0) {
+  const double time_limit = get_tile_time_limit();
+  if (time_limit != 0.0 && state_.start_render_time != 0.0) {
     const double remaining_render_time = max(0.0,
-                                             time_limit_ - (time_dt() - state_.start_render_time));
+                                             time_limit - (time_dt() - state_.start_render_time));
 
     update_interval = min(update_interval, remaining_render_time);
   }
@@ -883,9 +909,10 @@ int RenderScheduler::get_num_samples_to_path_trace() const
        * compensation even in viewport (currently parent scope checks for non-viewport render). */
       path_tracing_time_limit = guess_display_update_interval_in_seconds();
     }
-    if (time_limit_ != 0.0 && state_.start_render_time != 0.0) {
+    const double time_limit = get_tile_time_limit();
+    if (time_limit != 0.0 && state_.start_render_time != 0.0) {
       const double remaining_render_time = max(
-          0.0, time_limit_ - (time_dt() - state_.start_render_time));
+          0.0, time_limit - (time_dt() - state_.start_render_time));
       if (path_tracing_time_limit == 0) {
         path_tracing_time_limit = remaining_render_time;
       }
@@ -974,10 +1001,10 @@ bool RenderScheduler::work_need_denoise(bool &delayed, bool &ready_to_display)
     return false;
   }
 
-  /* When multiple tiles are used the full frame will be denoised.
-   * Avoid per-tile denoising to save up render time. */
+  /* When multiple tiles are used the full frame will be denoised, unless tiles are denoised
+   * separately. Avoid intermediate per-tile denoising to save up render time. */
   if (tile_manager_.has_multiple_tiles()) {
-    return false;
+    return tile_manager_.is_tile_denoising_used() && done();
   }
 
   if (done()) {
@@ -1212,7 +1239,7 @@ void RenderScheduler::check_time_limit_reached()
 
   const double current_time = time_dt();
 
-  if (current_time - state_.start_render_time < time_limit_) {
+  if (current_time - state_.start_render_time < get_tile_time_limit()) {
     /* Time limit is not reached yet. */
     return;
   }
@@ -1221,6 +1248,16 @@ void RenderScheduler::check_time_limit_reached()
   state_.end_render_time = current_time;
 }
 
+double RenderScheduler::get_tile_time_limit() const
+{
+  if (time_limit_ == 0.0) {
+    return 0.0;
+  }
+
+  const int num_remaining_tiles = max(tile_manager_.get_num_tiles() - num_finished_tiles_, 1);
+  return time_limit_ + time_limit_unused_ / num_remaining_tiles;
+}
+
 /* --------------------------------------------------------------------
  * Utility functions.
  */
@@ -138,7 +138,12 @@ class RenderScheduler {
   int get_sample_offset() const;
 
   /* Time limit for the path tracing tasks, in minutes.
-   * Zero disables the limit. */
+   * Zero disables the limit.
+   *
+   * When rendering with tiles the limit applies to every tile, and time which a tile does not use
+   * because all its pixels converged earlier is spread over the remaining tiles. With adaptive
+   * sampling the noise threshold is lowered progressively, so that the samples which fit into the
+   * time limit go to the noisiest pixels first. */
   void set_time_limit(const double time_limit);
   double get_time_limit() const;
 
@@ -303,6 +308,10 @@ class RenderScheduler {
    * average render time information. */
   void check_time_limit_reached();
 
+  /* Time limit of the current tile: the time limit plus its share of the time which previous
+   * tiles did not use. Zero when there is no limit. */
+  double get_tile_time_limit() const;
+
   /* Helper class to keep track of task timing.
    *
    * Contains two parts: wall time and average. The wall time is an actual wall time of how long it
@@ -475,6 +484,11 @@ class RenderScheduler {
    * level. */
   bool use_progressive_noise_floor_ = false;
 
+  /* Time which finished tiles did not use from their time limit. Kept across tiles, unlike the
+   * state above. */
+  double time_limit_unused_ = 0.0;
+  int num_finished_tiles_ = 0;
+
   /* Default value for the resolution divider which will be used when there is no render time
    * information available yet.
    * It is also what defines the upper limit of the automatically calculated resolution divider. */
@@ -4,7 +4,7 @@
 
 #include "integrator/work_balancer.h"
 
-#include "util/math_base.h"
+#include <cmath>
 
 CCL_NAMESPACE_BEGIN
 
@@ -27,46 +27,35 @@ void work_balance_do_initial(vector<WorkBalanceInfo> &work_balance_infos)
   }
 }
 
-static double calculate_total_time(const vector<WorkBalanceInfo> &work_balance_infos)
-{
-  double total_time = 0;
-  for (const WorkBalanceInfo &info : work_balance_infos) {
-    total_time += info.time_spent;
-  }
-  return total_time;
-}
-
-/* The balance is based on equalizing time which devices spent performing a task. Assume that
- * average of the observed times is usable for estimating whether more or less work is to be
- * scheduled, and how difference in the work scheduling is needed. */
+/* The balance is based on the throughput of every device: the fraction of the work it performed
+ * per second. Distributing the work proportionally to the throughput makes all devices finish at
+ * the same time, in a single step. This matters for a mix of devices with very different
+ * performance, like a CPU together with a GPU, where gradually moving towards equal times leaves
+ * the slow device with a too large part of the work for a long time. */
 
 bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
 {
   const int num_infos = work_balance_infos.size();
 
-  const double total_time = calculate_total_time(work_balance_infos);
-  const double time_average = total_time / num_infos;
-
-  double total_weight = 0;
-  vector<double> new_weights;
-  new_weights.reserve(num_infos);
-
-  /* Equalize the overall average time. This means that we don't make it so every work will perform
-   * amount of work based on the current average, but that after the weights changes the time will
-   * equalize.
-   * Can think of it that if one of the devices is 10% faster than another, then one device needs
-   * to do 5% less of the current work, and another needs to do 5% more. */
-  const double lerp_weight = 1.0 / num_infos;
-
-  bool has_big_difference = false;
+  double total_throughput = 0;
+  vector<double> throughputs;
+  throughputs.reserve(num_infos);
 
   for (const WorkBalanceInfo &info : work_balance_infos) {
-    const double time_target = mix(info.time_spent, time_average, lerp_weight);
-    const double new_weight = info.weight * time_target / info.time_spent;
-    new_weights.push_back(new_weight);
-    total_weight += new_weight;
+    if (info.time_spent <= 0) {
+      /* No statistics to base the balance on. */
+      return false;
+    }
+    const double throughput = info.weight / info.time_spent;
+    throughputs.push_back(throughput);
+    total_throughput += throughput;
+  }
 
-    if (std::fabs(1.0 - time_target / time_average) > 0.02) {
+  /* Avoid moving buffers between devices for changes within the timing noise. */
+  bool has_big_difference = false;
+  for (int i = 0; i < num_infos; ++i) {
+    const double new_weight = throughputs[i] / total_throughput;
+    if (std::fabs(1.0 - new_weight / work_balance_infos[i].weight) > 0.02) {
       has_big_difference = true;
     }
   }
@@ -75,10 +64,9 @@ bool work_balance_do_rebalance(vector<WorkBalanceInfo> &work_balance_infos)
     return false;
   }
 
-  const double total_weight_inv = 1.0 / total_weight;
   for (int i = 0; i < num_infos; ++i) {
     WorkBalanceInfo &info = work_balance_infos[i];
-    info.weight = new_weights[i] * total_weight_inv;
+    info.weight = throughputs[i] / total_throughput;
     info.time_spent = 0;
   }
 
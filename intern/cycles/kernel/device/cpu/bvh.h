@@ -40,6 +40,7 @@ using numhit_t = uint32_t;
 #  define RTCTraversable RTCScene
 #  define rtcGetGeometryUserDataFromTraversable rtcGetGeometryUserDataFromScene
 #  define rtcTraversableIntersect1 rtcIntersect1
+#  define rtcTraversableIntersect4 rtcIntersect4
 #  define rtcTraversableOccluded1 rtcOccluded1
 #endif
 
@@ -616,6 +617,70 @@ ccl_device_intersect bool kernel_embree_intersect(KernelGlobals kg,
   return true;
 }
 
+#ifndef __KERNEL_ONEAPI__
+/* Intersect a packet of up to 4 rays with the scene, for the lanes where `valid` is -1.
+ *
+ * No filter function is used, so this is only correct for rays without primitives to skip for
+ * self intersection and without shadow linking. Missed rays get #PRIM_NONE. */
+ccl_device_intersect void kernel_embree_intersect_packet4(KernelGlobals kg,
+                                                         const Ray rays[4],
+                                                         const uint visibility[4],
+                                                         const int valid[4],
+                                                         Intersection isect[4])
+{
+  RTCRayHit4 ray_hit;
+  for (int i = 0; i < 4; i++) {
+    ray_hit.hit.geomID[i] = RTC_INVALID_GEOMETRY_ID;
+    ray_hit.hit.instID[0][i] = RTC_INVALID_GEOMETRY_ID;
+    if (!valid[i]) {
+      continue;
+    }
+    ray_hit.ray.org_x[i] = rays[i].P.x;
+    ray_hit.ray.org_y[i] = rays[i].P.y;
+    ray_hit.ray.org_z[i] = rays[i].P.z;
+    ray_hit.ray.dir_x[i] = rays[i].D.x;
+    ray_hit.ray.dir_y[i] = rays[i].D.y;
+    ray_hit.ray.dir_z[i] = rays[i].D.z;
+    ray_hit.ray.tnear[i] = rays[i].tmin;
+    ray_hit.ray.tfar[i] = rays[i].tmax;
+    ray_hit.ray.time[i] = rays[i].time;
+    ray_hit.ray.mask[i] = visibility[i];
+    ray_hit.ray.id[i] = i;
+    ray_hit.ray.flags[i] = 0;
+  }
+
+  RTCIntersectArguments args;
+  rtcInitIntersectArguments(&args);
+  args.flags = RTC_RAY_QUERY_FLAG_COHERENT;
+  args.feature_mask = CYCLES_EMBREE_USED_FEATURES;
+  rtcTraversableIntersect4(valid, kernel_data.device_bvh, &ray_hit, &args);
+
+  for (int i = 0; i < 4; i++) {
+    if (!valid[i]) {
+      continue;
+    }
+    if (ray_hit.hit.geomID[i] == RTC_INVALID_GEOMETRY_ID ||
+        ray_hit.hit.primID[i] == RTC_INVALID_GEOMETRY_ID)
+    {
+      isect[i].t = rays[i].tmax;
+      isect[i].object = OBJECT_NONE;
+      isect[i].prim = PRIM_NONE;
+      continue;
+    }
+
+    RTCRay ray;
+    ray.tfar = ray_hit.ray.tfar[i];
+    RTCHit hit;
+    hit.u = ray_hit.hit.u[i];
+    hit.v = ray_hit.hit.v[i];
+    hit.primID = ray_hit.hit.primID[i];
+    hit.geomID = ray_hit.hit.geomID[i];
+    hit.instID[0] = ray_hit.hit.instID[0][i];
+    kernel_embree_convert_hit(kg, &ray, &hit, &isect[i]);
+  }
+}
+#endif
+
 #ifdef __BVH_LOCAL__
 ccl_device_intersect bool kernel_embree_intersect_local(KernelGlobals kg,
                                                         const ccl_private Ray *ray,
@@ -46,6 +46,9 @@ struct KernelGlobalsCPU {
   KernelData data = {};
 
   ProfilingState profiler;
+
+  /* Embree supports ray packets, see #integrator_intersect_closest_packet. */
+  bool use_ray_packets = false;
 };
 
 /* Per-thread global state.
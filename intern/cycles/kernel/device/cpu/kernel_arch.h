@@ -28,6 +28,12 @@
 KERNEL_INTEGRATOR_INIT_FUNCTION(init_from_camera);
 KERNEL_INTEGRATOR_INIT_FUNCTION(init_from_bake);
 KERNEL_INTEGRATOR_SHADE_FUNCTION(megakernel);
+KERNEL_INTEGRATOR_SHADE_FUNCTION(megakernel_simple);
+
+void KERNEL_FUNCTION_FULL_NAME(integrator_intersect_closest_packet)(
+    const ThreadKernelGlobalsCPU *ccl_restrict kg,
+    IntegratorStateCPU *states,
+    const int num_states);
 
 #undef KERNEL_INTEGRATOR_FUNCTION
 #undef KERNEL_INTEGRATOR_INIT_FUNCTION
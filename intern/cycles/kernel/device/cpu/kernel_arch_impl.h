@@ -96,6 +96,20 @@ DEFINE_INTEGRATOR_INIT_KERNEL(init_from_camera)
 DEFINE_INTEGRATOR_INIT_KERNEL(init_from_bake)
 DEFINE_INTEGRATOR_SHADE_KERNEL(megakernel)
 
+void KERNEL_FUNCTION_FULL_NAME(integrator_intersect_closest_packet)(
+    const ThreadKernelGlobalsCPU *kg, IntegratorStateCPU *states, const int num_states)
+{
+#ifdef KERNEL_STUB
+  STUB_ASSERT(KERNEL_ARCH, integrator_intersect_closest_packet);
+#elif defined(__EMBREE__)
+  integrator_intersect_closest_packet(kg, states, num_states);
+#else
+  (void)kg;
+  (void)states;
+  (void)num_states;
+#endif
+}
+
 /* --------------------------------------------------------------------
  * Shader evaluation.
  */
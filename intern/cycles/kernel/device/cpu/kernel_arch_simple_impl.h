@@ -0,0 +1,48 @@
+/* SPDX-FileCopyrightText: 2025 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+/* Implementation of the megakernel specialized for scenes that don't use any of the features in
+ * #KERNEL_FEATURE_CPU_SIMPLE_EXCLUDED. The including `.cpp` file defines `__KERNEL_FEATURES__`
+ * so the code for those features is left out, which reduces branching and register pressure.
+ * Everything else is shared with the generic kernels in kernel_arch_impl.h. */
+
+#pragma once
+
+// clang-format off
+#include "kernel/device/cpu/compat.h"
+
+#ifndef KERNEL_STUB
+#    include "kernel/globals.h"
+
+#    include "kernel/device/cpu/image.h"
+
+#    include "kernel/integrator/state.h"
+#    include "kernel/integrator/state_flow.h"
+#    include "kernel/integrator/state_util.h"
+
+#    include "kernel/integrator/megakernel.h"
+#else
+#  define STUB_ASSERT(arch, name) \
+    assert(!(#name " kernel stub for architecture " #arch " was called!"))
+#endif   /* KERNEL_STUB */
+// clang-format on
+
+CCL_NAMESPACE_BEGIN
+
+void KERNEL_FUNCTION_FULL_NAME(integrator_megakernel_simple)(const ThreadKernelGlobalsCPU *kg,
+                                                             IntegratorStateCPU *state,
+                                                             ccl_global float *render_buffer)
+{
+#ifdef KERNEL_STUB
+  STUB_ASSERT(KERNEL_ARCH, integrator_megakernel_simple);
+#else
+  integrator_megakernel(kg, state, render_buffer);
+#endif
+}
+
+#undef KERNEL_STUB
+#undef STUB_ASSERT
+#undef KERNEL_ARCH
+
+CCL_NAMESPACE_END
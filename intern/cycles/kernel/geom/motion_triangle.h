@@ -61,9 +61,9 @@ ccl_device_inline void motion_triangle_normals_for_step(KernelGlobals kg,
 {
   if (step == numsteps) {
     /* center step: regular vertex location */
-    normals[0] = kernel_data_fetch(tri_vnormal, tri_vindex.x);
-    normals[1] = kernel_data_fetch(tri_vnormal, tri_vindex.y);
-    normals[2] = kernel_data_fetch(tri_vnormal, tri_vindex.z);
+    normals[0] = oct_decode_normal(kernel_data_fetch(tri_vnormal, tri_vindex.x));
+    normals[1] = oct_decode_normal(kernel_data_fetch(tri_vnormal, tri_vindex.y));
+    normals[2] = oct_decode_normal(kernel_data_fetch(tri_vnormal, tri_vindex.z));
   }
   else {
     /* center step is not stored in this array */
@@ -381,7 +381,19 @@ ccl_device void integrator_intersect_closest(KernelGlobals kg,
   ray.self.prim = last_isect_prim;
   ray.self.light_object = OBJECT_NONE;
   ray.self.light_prim = PRIM_NONE;
-  bool hit = scene_intersect(kg, &ray, visibility, &isect);
+  bool hit;
+#ifndef __KERNEL_GPU__
+  if (state->has_packet_isect) {
+    /* The ray was already traced as part of a ray packet. */
+    state->has_packet_isect = false;
+    isect = state->packet_isect;
+    hit = (isect.prim != PRIM_NONE);
+  }
+  else
+#endif
+  {
+    hit = scene_intersect(kg, &ray, visibility, &isect);
+  }
 
   /* TODO: remove this and do it in the various intersection functions instead. */
   if (!hit) {
@@ -435,4 +447,71 @@ ccl_device void integrator_intersect_closest(KernelGlobals kg,
       kg, state, &isect, render_buffer, hit);
 }
 
+#if defined(__EMBREE__) && !defined(__KERNEL_GPU__)
+/* Find the closest intersection of the camera rays of multiple paths, tracing them as ray packets.
+ * Camera rays of consecutive samples of a pixel are coherent, which makes this faster than
+ * tracing them one at a time. The result is used by #integrator_intersect_closest, paths which
+ * can not use a packet are traced as usual there. */
+ccl_device void integrator_intersect_closest_packet(KernelGlobals kg,
+                                                    IntegratorStateCPU *states,
+                                                    const int num_states)
+{
+  if (!kernel_data.device_bvh) {
+    return;
+  }
+
+#  ifdef __SHADOW_LINKING__
+  /* Shadow linking requires the filter function, which only supports single rays. */
+  if (kernel_data.kernel_features & KERNEL_FEATURE_SHADOW_LINKING) {
+    return;
+  }
+#  endif
+
+  for (int offset = 0; offset < num_states; offset += 4) {
+    Ray rays[4];
+    uint visibility[4];
+    int valid[4] = {0, 0, 0, 0};
+    int num_valid = 0;
+
+    for (int i = 0; i < 4 && offset + i < num_states; i++) {
+      IntegratorState state = &states[offset + i];
+      state->has_packet_isect = false;
+
+      /* Only camera rays which do not need to skip any primitive. */
+      if (INTEGRATOR_STATE(state, path, queued_kernel) !=
+              DEVICE_KERNEL_INTEGRATOR_INTERSECT_CLOSEST ||
+          !(INTEGRATOR_STATE(state, path, flag) & PATH_RAY_CAMERA) ||
+          INTEGRATOR_STATE(state, isect, object) != OBJECT_NONE ||
+          INTEGRATOR_STATE(state, isect, prim) != PRIM_NONE || path_state_ao_bounce(kg, state))
+      {
+        continue;
+      }
+
+      integrator_state_read_ray(state, &rays[i]);
+      if (!intersection_ray_valid(&rays[i])) {
+        continue;
+      }
+
+      visibility[i] = path_state_ray_visibility(state);
+      valid[i] = -1;
+      num_valid++;
+    }
+
+    if (num_valid < 2) {
+      continue;
+    }
+
+    Intersection isect[4];
+    kernel_embree_intersect_packet4(kg, rays, visibility, valid, isect);
+
+    for (int i = 0; i < 4; i++) {
+      if (valid[i]) {
+        states[offset + i].packet_isect = isect[i];
+        states[offset + i].has_packet_isect = true;
+      }
+    }
+  }
+}
+#endif
+
 CCL_NAMESPACE_END
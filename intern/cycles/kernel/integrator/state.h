@@ -93,6 +93,11 @@ struct IntegratorStateCPU {
 
   IntegratorShadowStateCPU shadow;
   IntegratorShadowStateCPU ao;
+
+  /* Closest intersection of the current ray, when it was already found as part of a ray packet.
+   * Used once by #integrator_intersect_closest. */
+  Intersection packet_isect;
+  bool has_packet_isect = false;
 };
 
 /* Path Queue
@@ -153,6 +153,12 @@ CCL_NAMESPACE_BEGIN
   (KERNEL_FEATURE_NODE_VORONOI_EXTRA | KERNEL_FEATURE_NODE_BUMP | KERNEL_FEATURE_NODE_BUMP_STATE)
 #define KERNEL_FEATURE_NODE_MASK_BUMP KERNEL_FEATURE_NODE_MASK_DISPLACEMENT
 
+/* Features left out of the CPU megakernel specialized for simple scenes. */
+#define KERNEL_FEATURE_CPU_SIMPLE_EXCLUDED \
+  (KERNEL_FEATURE_VOLUME | KERNEL_FEATURE_SUBSURFACE | KERNEL_FEATURE_HAIR | \
+   KERNEL_FEATURE_HAIR_THICK | KERNEL_FEATURE_POINTCLOUD | KERNEL_FEATURE_NODE_PRINCIPLED_HAIR | \
+   KERNEL_FEATURE_MNEE)
+
 /* Must be constexpr on the CPU to avoid compile errors because the state types
  * are different depending on the main, shadow or null path. For GPU we don't have
  * C++17 everywhere so need to check it. */
@@ -26,7 +26,7 @@ class DeviceScene {
   /* mesh */
   device_vector<packed_float3> tri_verts;
   device_vector<uint> tri_shader;
-  device_vector<packed_float3> tri_vnormal;
+  device_vector<uint> tri_vnormal;
   device_vector<packed_uint3> tri_vindex;
 
   device_vector<KernelCurve> curves;
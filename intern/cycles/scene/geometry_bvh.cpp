@@ -2,6 +2,9 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <algorithm>
+#include <climits>
+
 #include "bvh/bvh.h"
 #include "bvh/bvh2.h"
 
@@ -18,10 +21,56 @@
 #include "scene/shader_nodes.h"
 
 #include "util/log.h"
+#include "util/md5.h"
+#include "util/path.h"
 #include "util/progress.h"
 
 CCL_NAMESPACE_BEGIN
 
+template<typename T> static void bvh_cache_hash(MD5Hash &md5, const T &value)
+{
+  md5.append(reinterpret_cast<const uint8_t *>(&value), sizeof(value));
+}
+
+static void bvh_cache_hash_data(MD5Hash &md5, const void *data, const size_t size)
+{
+  bvh_cache_hash(md5, size);
+  /* The hash only takes sizes that fit in an int, large meshes are appended in chunks. */
+  const uint8_t *bytes = static_cast<const uint8_t *>(data);
+  for (size_t offset = 0; offset < size; offset += INT_MAX) {
+    md5.append(bytes + offset, int(std::min(size - offset, size_t(INT_MAX))));
+  }
+}
+
+/* Path of the file caching the BVH of this geometry, named after everything the build depends
+ * on. Empty when caching is disabled or not supported for this geometry. */
+static string bvh_cache_filepath(const string &cache_dir, Geometry *geom, const BVHParams &params)
+{
+  if (cache_dir.empty() || params.bvh_layout != BVH_LAYOUT_BVH2 || !geom->is_mesh()) {
+    return "";
+  }
+
+  Mesh *mesh = static_cast<Mesh *>(geom);
+  MD5Hash md5;
+  bvh_cache_hash(md5, params.use_spatial_split);
+  bvh_cache_hash(md5, params.use_compact_structure);
+  bvh_cache_hash(md5, params.use_unaligned_nodes);
+  bvh_cache_hash(md5, params.num_motion_triangle_steps);
+  bvh_cache_hash_data(md5, mesh->get_verts().data(), mesh->get_verts().size() * sizeof(float3));
+  bvh_cache_hash_data(
+      md5, mesh->get_triangles().data(), mesh->get_triangles().size() * sizeof(int));
+
+  const bool use_motion_blur = mesh->has_motion_blur();
+  bvh_cache_hash(md5, use_motion_blur);
+  if (use_motion_blur) {
+    const Attribute *attr = mesh->attributes.find(ATTR_STD_MOTION_VERTEX_POSITION);
+    bvh_cache_hash(md5, mesh->get_motion_steps());
+    bvh_cache_hash_data(md5, attr->buffer.data(), attr->buffer.size());
+  }
+
+  return path_join(cache_dir, "bvh2_" + md5.get_hex());
+}
+
 void Geometry::compute_bvh(Device *device,
                            DeviceScene *dscene,
                            SceneParams *params,
@@ -66,8 +115,16 @@ void Geometry::compute_bvh(Device *device,
       bvh->replace_geometry(geometry, objects);
 
       device->build_bvh(bvh.get(), *progress, true);
+
+      if (bvh->params.bvh_layout == BVH_LAYOUT_BVH2 &&
+          static_cast<BVH2 *>(bvh.get())->need_rebuild_after_refit())
+      {
+        VLOG_INFO << "Rebuilding BVH of " << name << ", refitting degraded it too much.";
+        need_update_rebuild = true;
+      }
     }
-    else {
+
+    if (!bvh || need_update_rebuild) {
       progress->set_status(msg, "Building BVH");
 
       BVHParams bparams;
@@ -83,7 +140,20 @@ void Geometry::compute_bvh(Device *device,
       bparams.curve_subdivisions = params->curve_subdivisions();
 
       bvh = BVH::create(bparams, geometry, objects, device);
-      MEM_GUARDED_CALL(progress, device->build_bvh, bvh.get(), *progress, false);
+
+      const string cache_filepath = bvh_cache_filepath(params->bvh_cache_path, this, bparams);
+      if (!cache_filepath.empty() && static_cast<BVH2 *>(bvh.get())->read_cache(cache_filepath)) {
+        VLOG_INFO << "Loaded BVH of " << name << " from " << cache_filepath;
+      }
+      else {
+        MEM_GUARDED_CALL(progress, device->build_bvh, bvh.get(), *progress, false);
+
+        if (!cache_filepath.empty() && !progress->get_cancel() &&
+            !static_cast<BVH2 *>(bvh.get())->write_cache(cache_filepath))
+        {
+          VLOG_WARNING << "Failed to write BVH cache " << cache_filepath;
+        }
+      }
     }
   }
 
@@ -65,7 +65,7 @@ void GeometryManager::device_update_mesh(Device * /*unused*/,
 
     packed_float3 *tri_verts = dscene->tri_verts.alloc(vert_size);
     uint *tri_shader = dscene->tri_shader.alloc(tri_size);
-    packed_float3 *vnormal = dscene->tri_vnormal.alloc(vert_size);
+    uint *vnormal = dscene->tri_vnormal.alloc(vert_size);
     packed_uint3 *tri_vindex = dscene->tri_vindex.alloc(tri_size);
 
     const bool copy_all_data = dscene->tri_shader.need_realloc() ||
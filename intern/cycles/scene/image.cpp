@@ -305,7 +305,7 @@ bool ImageLoader::is_vdb_loader() const
 
 /* Image Manager */
 
-ImageManager::ImageManager(const DeviceInfo &info)
+ImageManager::ImageManager(const DeviceInfo &info, const SceneParams &params)
 {
   need_update_ = true;
   osl_texture_system = nullptr;
@@ -313,6 +313,7 @@ ImageManager::ImageManager(const DeviceInfo &info)
 
   /* Set image limits */
   features.has_nanovdb = info.has_nanovdb;
+  features.texture_limit = params.texture_limit;
 }
 
 ImageManager::~ImageManager()
@@ -25,6 +25,7 @@ class ImageManager;
 class Progress;
 class RenderStats;
 class Scene;
+class SceneParams;
 class ColorSpaceProcessor;
 class VDBImageLoader;
 
@@ -81,6 +82,9 @@ class ImageMetaData {
 class ImageDeviceFeatures {
  public:
   bool has_nanovdb;
+  /* Images larger than this are scaled down after loading, so loaders that can read a lower
+   * resolution version directly should do so. Zero when there is no limit. */
+  int texture_limit;
 };
 
 /* Image loader base class, that can be subclassed to load image data
@@ -162,7 +166,7 @@ class ImageHandle {
  * texture images and 3D volume images. */
 class ImageManager {
  public:
-  explicit ImageManager(const DeviceInfo &info);
+  ImageManager(const DeviceInfo &info, const SceneParams &params);
   ~ImageManager();
 
   ImageHandle add_image(const string &filename, const ImageParams &params);
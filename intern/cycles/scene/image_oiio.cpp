@@ -15,7 +15,7 @@ OIIOImageLoader::OIIOImageLoader(const string &filepath) : filepath(filepath) {}
 
 OIIOImageLoader::~OIIOImageLoader() = default;
 
-bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
+bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures &features,
                                     ImageMetaData &metadata)
 {
   /* Perform preliminary checks, with meaningful logging. */
@@ -39,6 +39,21 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
     return false;
   }
 
+  /* Files like tiled EXR and TX can contain mipmaps. When the image would be scaled down to the
+   * texture limit anyway, read the largest level that fits instead of the full resolution. */
+  miplevel = 0;
+  if (features.texture_limit > 0 && spec.depth <= 1) {
+    while (max(spec.width, spec.height) > features.texture_limit &&
+           in->seek_subimage(0, miplevel + 1))
+    {
+      miplevel++;
+      spec = in->spec();
+    }
+    if (miplevel > 0) {
+      VLOG_WORK << "Using mipmap level " << miplevel << " of " << filepath.string() << ".";
+    }
+  }
+
   metadata.width = spec.width;
   metadata.height = spec.height;
   metadata.depth = spec.depth;
@@ -93,6 +108,7 @@ bool OIIOImageLoader::load_metadata(const ImageDeviceFeatures & /*features*/,
 template<TypeDesc::BASETYPE FileFormat, typename StorageType>
 static void oiio_load_pixels(const ImageMetaData &metadata,
                              const unique_ptr<ImageInput> &in,
+                             const int miplevel,
                              const bool associate_alpha,
                              StorageType *pixels)
 {
@@ -112,7 +128,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
   if (depth <= 1) {
     const size_t scanlinesize = width * components * sizeof(StorageType);
     in->read_image(0,
-                   0,
+                   miplevel,
                    0,
                    components,
                    FileFormat,
@@ -122,7 +138,7 @@ static void oiio_load_pixels(const ImageMetaData &metadata,
                    AutoStride);
   }
   else {
-    in->read_image(0, 0, 0, components, FileFormat, (uchar *)readpixels);
+    in->read_image(0, miplevel, 0, components, FileFormat, (uchar *)readpixels);
   }
 
   if (components > 4) {
@@ -220,20 +236,23 @@ bool OIIOImageLoader::load_pixels(const ImageMetaData &metadata,
   switch (metadata.type) {
     case IMAGE_DATA_TYPE_BYTE:
     case IMAGE_DATA_TYPE_BYTE4:
-      oiio_load_pixels<TypeDesc::UINT8, uchar>(metadata, in, do_associate_alpha, (uchar *)pixels);
+      oiio_load_pixels<TypeDesc::UINT8, uchar>(
+          metadata, in, miplevel, do_associate_alpha, (uchar *)pixels);
       break;
     case IMAGE_DATA_TYPE_USHORT:
     case IMAGE_DATA_TYPE_USHORT4:
       oiio_load_pixels<TypeDesc::USHORT, uint16_t>(
-          metadata, in, do_associate_alpha, (uint16_t *)pixels);
+          metadata, in, miplevel, do_associate_alpha, (uint16_t *)pixels);
       break;
     case IMAGE_DATA_TYPE_HALF:
     case IMAGE_DATA_TYPE_HALF4:
-      oiio_load_pixels<TypeDesc::HALF, half>(metadata, in, do_associate_alpha, (half *)pixels);
+      oiio_load_pixels<TypeDesc::HALF, half>(
+          metadata, in, miplevel, do_associate_alpha, (half *)pixels);
       break;
     case IMAGE_DATA_TYPE_FLOAT:
     case IMAGE_DATA_TYPE_FLOAT4:
-      oiio_load_pixels<TypeDesc::FLOAT, float>(metadata, in, do_associate_alpha, (float *)pixels);
+      oiio_load_pixels<TypeDesc::FLOAT, float>(
+          metadata, in, miplevel, do_associate_alpha, (float *)pixels);
       break;
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT:
     case IMAGE_DATA_TYPE_NANOVDB_FLOAT3:
@@ -28,6 +28,8 @@ class OIIOImageLoader : public ImageLoader {
 
  protected:
   ustring filepath;
+  /* Mipmap level stored in the file that is loaded, see #ImageDeviceFeatures::texture_limit. */
+  int miplevel = 0;
 };
 
 CCL_NAMESPACE_END
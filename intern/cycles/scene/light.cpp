@@ -808,11 +808,25 @@ void LightManager::device_update_tree(Device * /*unused*/,
   /* TODO: For now, we'll start with a smaller number of max lights in a node.
    * More benchmarking is needed to determine what number works best. */
   LightTree light_tree(scene, dscene, progress, 8);
-  LightTreeNode *root = light_tree.build(scene, dscene);
+  LightTreeNode *root;
+  {
+    const scoped_callback_timer timer([scene](double time) {
+      if (scene->update_stats) {
+        scene->update_stats->light.times.add_entry({"device_update (build light tree)", time});
+      }
+    });
+    root = light_tree.build(scene, dscene);
+  }
   if (progress.get_cancel()) {
     return;
   }
 
+  const scoped_callback_timer timer([scene](double time) {
+    if (scene->update_stats) {
+      scene->update_stats->light.times.add_entry({"device_update (flatten light tree)", time});
+    }
+  });
+
   /* Create arguments for recursive tree flatten. */
   LightTreeFlatten flatten;
   flatten.scene = scene;
@@ -269,12 +269,24 @@ bool LightTree::triangle_usable_as_light(Mesh *mesh, const int prim_id)
 
 void LightTree::add_mesh(Scene *scene, Mesh *mesh, const int object_id)
 {
+  /* Find the emissive triangles first, so the emitters can be created in parallel while keeping
+   * them in the same order as the triangles. */
+  vector<int> triangles;
   const size_t mesh_num_triangles = mesh->num_triangles();
   for (size_t i = 0; i < mesh_num_triangles; i++) {
     if (triangle_usable_as_light(mesh, i)) {
-      emitters_.emplace_back(scene, i, object_id);
+      triangles.push_back(i);
     }
   }
+
+  const size_t start = emitters_.size();
+  emitters_.resize(start + triangles.size());
+  parallel_for(blocked_range<size_t>(0, triangles.size(), MIN_EMITTERS_PER_THREAD),
+               [&](const blocked_range<size_t> &r) {
+                 for (size_t i = r.begin(); i != r.end(); i++) {
+                   emitters_[start + i] = LightTreeEmitter(scene, triangles[i], object_id);
+                 }
+               });
 }
 
 LightTree::LightTree(Scene *scene,
@@ -196,6 +196,8 @@ struct LightTreeEmitter {
 
   LightTreeMeasure measure;
 
+  /* Uninitialized, to be assigned when creating emitters in parallel. */
+  LightTreeEmitter() = default;
   LightTreeEmitter(Object *object, const int object_id); /* Mesh emitter. */
   LightTreeEmitter(Scene *scene,
                    const int prim_id,
@@ -451,12 +451,77 @@ void OSLManager::shading_system_free()
   loaded_shaders.clear();
 }
 
+/* Maximum number of compiled shaders kept in the persistent bytecode cache. */
+#  define OSL_BYTECODE_CACHE_MAX_FILES 1024
+
+/* Compute the key of the shader in the bytecode cache, from the shader source, the headers it
+ * includes and the compiler version. The install location of the headers is left out, so the
+ * cache also works with other installs of the same version.
+ *
+ * Returns an empty string when the shader can't be cached, for example because it includes files
+ * next to it that may be modified independently. */
+static string osl_bytecode_cache_key(const string &inputfile, const string &shader_path)
+{
+  if (getenv("CYCLES_OSL_NO_BYTECODE_CACHE") != nullptr) {
+    return "";
+  }
+
+  string source;
+  if (!path_read_text(inputfile, source)) {
+    return "";
+  }
+
+  /* Only standard headers shipped with Cycles may be included. */
+  const string source_dir = path_dirname(inputfile);
+  size_t pos = 0;
+  while ((pos = source.find("#include", pos)) != string::npos) {
+    pos += strlen("#include");
+    const size_t begin = source.find_first_of("\"<\n", pos);
+    const size_t end = (begin == string::npos || source[begin] == '\n') ?
+                           string::npos :
+                           source.find_first_of("\">\n", begin + 1);
+    if (end == string::npos || source[end] == '\n') {
+      return "";
+    }
+    const string include = source.substr(begin + 1, end - begin - 1);
+    if (path_filename(include) != include || !path_exists(path_join(shader_path, include)) ||
+        (!source_dir.empty() && path_exists(path_join(source_dir, include))))
+    {
+      return "";
+    }
+  }
+
+  /* The headers shipped with Cycles only change along with the build, hash them once. */
+  static const string shader_path_hash = path_files_md5_hash(shader_path);
+
+  MD5Hash md5;
+  md5.append(source);
+  md5.append(shader_path_hash);
+  md5.append(string_printf("%d", OSL_LIBRARY_VERSION_CODE));
+
+  return md5.get_hex();
+}
+
 bool OSLManager::osl_compile(const string &inputfile, const string &outputfile)
 {
   vector<string> options;
   string stdosl_path;
   const string shader_path = path_get("shader");
 
+  /* Compiled shaders are cached across sessions, so the same shaders don't get compiled for every
+   * render. */
+  const string cache_key = osl_bytecode_cache_key(inputfile, shader_path);
+  const string cache_filepath = cache_key.empty() ?
+                                    "" :
+                                    path_cache_get(path_join("osl", cache_key + ".oso"));
+  if (!cache_filepath.empty() && path_cache_kernel_exists_and_mark_used(cache_filepath)) {
+    string bytecode;
+    if (path_read_text(cache_filepath, bytecode) && path_write_text(outputfile, bytecode)) {
+      VLOG_INFO << "Using cached OSL bytecode " << cache_filepath << " for " << inputfile;
+      return true;
+    }
+  }
+
   /* Specify output file name. */
   options.push_back("-o");
   options.push_back(outputfile);
@@ -476,6 +541,13 @@ bool OSLManager::osl_compile(const string &inputfile, const string &outputfile)
   OSL::OSLCompiler compiler = OSL::OSLCompiler(&OSL::ErrorHandler::default_handler());
   const bool ok = compiler.compile(string_view(inputfile), options, string_view(stdosl_path));
 
+  if (ok && !cache_filepath.empty()) {
+    string bytecode;
+    if (path_read_text(outputfile, bytecode) && path_write_text(cache_filepath, bytecode)) {
+      path_cache_kernel_mark_added_and_clear_old(cache_filepath, OSL_BYTECODE_CACHE_MAX_FILES);
+    }
+  }
+
   return ok;
 }
 
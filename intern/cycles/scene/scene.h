@@ -73,6 +73,10 @@ class SceneParams {
   CurveShapeType hair_shape;
   int texture_limit;
 
+  /* Directory to store built geometry BVHs in, so they can be reused by later renders of the
+   * same geometry instead of being built again. Disabled when empty. */
+  string bvh_cache_path;
+
   bool background;
 
   SceneParams()
@@ -99,7 +103,8 @@ class SceneParams {
              use_bvh_unaligned_nodes == params.use_bvh_unaligned_nodes &&
              num_bvh_time_steps == params.num_bvh_time_steps &&
              hair_subdivisions == params.hair_subdivisions && hair_shape == params.hair_shape &&
-             texture_limit == params.texture_limit);
+             texture_limit == params.texture_limit &&
+             bvh_cache_path == params.bvh_cache_path);
   }
 
   int curve_subdivisions()
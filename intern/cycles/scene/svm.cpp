@@ -30,6 +30,7 @@ SVMShaderManager::~SVMShaderManager() = default;
 
 void SVMShaderManager::device_update_shader(Scene *scene,
                                             Shader *shader,
+                                            const bool background,
                                             Progress &progress,
                                             array<int4> *svm_nodes)
 {
@@ -40,7 +41,7 @@ void SVMShaderManager::device_update_shader(Scene *scene,
 
   SVMCompiler::Summary summary;
   SVMCompiler compiler(scene);
-  compiler.background = (shader == scene->background->get_shader(scene));
+  compiler.background = background;
   compiler.compile(shader, *svm_nodes, 0, &summary);
 
   VLOG_WORK << "Compilation summary:\n"
@@ -72,20 +73,39 @@ void SVMShaderManager::device_update_specific(Device *device,
   /* test if we need to update */
   device_free(device, dscene, scene);
 
-  /* Build all shaders. */
+  /* Build all modified shaders, and reuse the nodes of the others. Nodes used by the reused
+   * shaders are still marked in the SVM usage, since that is never cleared. */
   TaskPool task_pool;
   vector<array<int4>> shader_svm_nodes(num_shaders);
+  vector<char> shader_background(num_shaders);
+  int num_compiled_shaders = 0;
   for (int i = 0; i < num_shaders; i++) {
-    task_pool.push([this, scene, &progress, &shader_svm_nodes, i] {
-      device_update_shader(scene, scene->shaders[i], progress, &shader_svm_nodes[i]);
+    Shader *shader = scene->shaders[i];
+    const bool background = (shader == scene->background->get_shader(scene));
+    shader_background[i] = background;
+
+    const auto it = compiled_shaders.find(shader);
+    if (it != compiled_shaders.end() && !shader->is_modified() &&
+        it->second.graph == shader->graph.get() && it->second.background == background)
+    {
+      shader_svm_nodes[i].steal_data(it->second.svm_nodes);
+      continue;
+    }
+
+    num_compiled_shaders++;
+    task_pool.push([this, scene, shader, background, &progress, &shader_svm_nodes, i] {
+      device_update_shader(scene, shader, background, progress, &shader_svm_nodes[i]);
     });
   }
   task_pool.wait_work();
+  compiled_shaders.clear();
 
   if (progress.get_cancel()) {
     return;
   }
 
+  VLOG_INFO << "Compiled " << num_compiled_shaders << " modified shaders.";
+
   /* The global node list contains a jump table (one node per shader)
    * followed by the nodes of all shaders. */
   int svm_nodes_size = num_shaders;
@@ -128,6 +148,14 @@ void SVMShaderManager::device_update_specific(Device *device,
     svm_nodes += shader_size;
   }
 
+  for (int i = 0; i < num_shaders; i++) {
+    Shader *shader = scene->shaders[i];
+    CompiledShader &compiled = compiled_shaders[shader];
+    compiled.graph = shader->graph.get();
+    compiled.background = shader_background[i];
+    compiled.svm_nodes.steal_data(shader_svm_nodes[i]);
+  }
+
   if (progress.get_cancel()) {
     return;
   }
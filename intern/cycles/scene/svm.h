@@ -10,6 +10,7 @@
 #include "scene/shader_graph.h"
 
 #include "util/array.h"
+#include "util/map.h"
 #include "util/string.h"
 
 CCL_NAMESPACE_BEGIN
@@ -39,8 +40,18 @@ class SVMShaderManager : public ShaderManager {
  protected:
   void device_update_shader(Scene *scene,
                             Shader *shader,
+                            const bool background,
                             Progress &progress,
                             array<int4> *svm_nodes);
+
+  /* Nodes of a shader from the previous update, reused as long as neither the shader nor its
+   * graph changed. */
+  struct CompiledShader {
+    const ShaderGraph *graph = nullptr;
+    bool background = false;
+    array<int4> svm_nodes;
+  };
+  unordered_map<const Shader *, CompiledShader> compiled_shaders;
 };
 
 /* Graph Compiler */
@@ -42,6 +42,9 @@ Session::Session(const SessionParams &params_, const SceneParams &scene_params)
   if (device->have_error()) {
     progress.set_error(device->error_message());
   }
+  else {
+    device->precompile_kernels();
+  }
 
   scene = make_unique<Scene>(scene_params, device.get());
 
@@ -533,6 +536,7 @@ void Session::update_buffers_for_params()
 
   /* Update for new state of scene and passes. */
   buffer_params_.update_passes(scene->passes);
+  tile_manager_.set_use_tile_denoising(params.use_tile_denoising);
   tile_manager_.update(buffer_params_, scene.get());
 
   /* Update temp directory on reset.
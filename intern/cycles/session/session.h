@@ -61,6 +61,10 @@ class SessionParams {
   bool use_auto_tile;
   int tile_size;
 
+  /* Denoise every tile on its own when rendering with tiles, with an overlap between tiles to
+   * avoid seams. Avoids keeping all passes of the full frame in memory for denoising. */
+  bool use_tile_denoising;
+
   bool use_resolution_divider;
 
   ShadingSystem shadingsystem;
@@ -86,6 +90,7 @@ class SessionParams {
 
     use_auto_tile = true;
     tile_size = 2048;
+    use_tile_denoising = false;
 
     use_resolution_divider = true;
 
@@ -31,6 +31,11 @@ static const char *ATTR_PASSES_COUNT = "cycles.passes.count";
 static const char *ATTR_PASS_SOCKET_PREFIX_FORMAT = "cycles.passes.%d.";
 static const char *ATTR_BUFFER_SOCKET_PREFIX = "cycles.buffer.";
 static const char *ATTR_DENOISE_SOCKET_PREFIX = "cycles.denoise.";
+static const char *ATTR_TILES_DENOISED = "cycles.tiles_denoised";
+
+/* Overscan used when denoising tiles separately. The denoiser sees this many pixels of the
+ * neighbor tiles, which makes the result match at the tile borders. */
+static const int TILE_DENOISE_OVERSCAN = 64;
 
 /* Global counter of ToleManager object instances. */
 static std::atomic<uint64_t> g_instance_index = 0;
@@ -368,19 +373,32 @@ void TileManager::update(const BufferParams &params, const Scene *scene)
 
     /* Not adaptive sampling overscan yet for baking, would need overscan also
      * for buffers read from the output driver. */
-    if (adaptive_sampling.use && !scene->bake_manager->get_baking()) {
+    const bool is_baking = scene->bake_manager->get_baking();
+    if (adaptive_sampling.use && !is_baking) {
       overscan_ = 4;
     }
     else {
       overscan_ = 0;
     }
+
+    tile_denoising_ = use_tile_denoising_ && denoise_params.use && !is_baking;
+    if (tile_denoising_) {
+      overscan_ = max(overscan_, TILE_DENOISE_OVERSCAN);
+    }
+    write_state_.image_spec.attribute(ATTR_TILES_DENOISED, int(tile_denoising_));
   }
   else {
     write_state_.image_spec = ImageSpec();
     overscan_ = 0;
+    tile_denoising_ = false;
   }
 }
 
+void TileManager::set_use_tile_denoising(const bool use_tile_denoising)
+{
+  use_tile_denoising_ = use_tile_denoising;
+}
+
 void TileManager::set_temp_dir(const string &temp_dir)
 {
   temp_dir_ = temp_dir;
@@ -627,7 +645,8 @@ void TileManager::finish_write_tiles()
 
 bool TileManager::read_full_buffer_from_disk(const string_view filename,
                                              RenderBuffers *buffers,
-                                             DenoiseParams *denoise_params)
+                                             DenoiseParams *denoise_params,
+                                             bool *is_denoised)
 {
   unique_ptr<ImageInput> in(ImageInput::open(filename));
   if (!in) {
@@ -646,6 +665,7 @@ bool TileManager::read_full_buffer_from_disk(const string_view filename,
   if (!node_from_image_spec_atttributes(denoise_params, image_spec, ATTR_DENOISE_SOCKET_PREFIX)) {
     return false;
   }
+  *is_denoised = image_spec.get_int_attribute(ATTR_TILES_DENOISED, 0) != 0;
 
   const int num_channels = in->spec().nchannels;
   if (!in->read_image(0, 0, 0, num_channels, TypeDesc::FLOAT, buffers->buffer.data())) {
@@ -77,6 +77,16 @@ class TileManager {
     return overscan_;
   }
 
+  /* Request every tile to be denoised separately, instead of denoising the full frame once all
+   * tiles are rendered. Takes effect on the next #update. */
+  void set_use_tile_denoising(bool use_tile_denoising);
+
+  /* Check whether tiles are to be denoised before they are written to disk. */
+  bool is_tile_denoising_used() const
+  {
+    return tile_denoising_;
+  }
+
   bool next();
   bool done();
 
@@ -101,11 +111,13 @@ class TileManager {
   }
 
   /* Read full frame render buffer from tiles file on disk.
+   * `is_denoised` is set to true when the tiles were denoised before they were written.
    *
    * Returns true on success. */
   bool read_full_buffer_from_disk(string_view filename,
                                   RenderBuffers *buffers,
-                                  DenoiseParams *denoise_params);
+                                  DenoiseParams *denoise_params,
+                                  bool *is_denoised);
 
   /* Compute valid tile size compatible with image saving. */
   int compute_render_tile_size(const int suggested_tile_size) const;
@@ -138,6 +150,9 @@ class TileManager {
   /* Number of extra pixels around the actual tile to render. */
   int overscan_ = 0;
 
+  bool use_tile_denoising_ = false;
+  bool tile_denoising_ = false;
+
   BufferParams buffer_params_;
 
   /* Tile scheduling state. */
@@ -0,0 +1,64 @@
+/* SPDX-FileCopyrightText: 2025 Blender Foundation
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "integrator/work_balancer.h"
+
+CCL_NAMESPACE_BEGIN
+
+TEST(WorkBalancer, initial)
+{
+  vector<WorkBalanceInfo> infos(4);
+  work_balance_do_initial(infos);
+
+  for (const WorkBalanceInfo &info : infos) {
+    EXPECT_NEAR(info.weight, 0.25, 1e-6);
+  }
+}
+
+TEST(WorkBalancer, rebalance_by_throughput)
+{
+  /* Second device renders ten times faster, so it is to get ten times more work. */
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 10.0;
+  infos[1].time_spent = 1.0;
+
+  EXPECT_TRUE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 1.0 / 11.0, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 10.0 / 11.0, 1e-6);
+  EXPECT_EQ(infos[0].time_spent, 0.0);
+  EXPECT_EQ(infos[1].time_spent, 0.0);
+
+  /* Once balanced, both devices take the same time and nothing changes. */
+  infos[0].time_spent = 2.0;
+  infos[1].time_spent = 2.0;
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 1.0 / 11.0, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 10.0 / 11.0, 1e-6);
+}
+
+TEST(WorkBalancer, rebalance_small_difference)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+  infos[0].time_spent = 1.0;
+  infos[1].time_spent = 1.01;
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5, 1e-6);
+  EXPECT_NEAR(infos[1].weight, 0.5, 1e-6);
+}
+
+TEST(WorkBalancer, rebalance_without_statistics)
+{
+  vector<WorkBalanceInfo> infos(2);
+  work_balance_do_initial(infos);
+
+  EXPECT_FALSE(work_balance_do_rebalance(infos));
+  EXPECT_NEAR(infos[0].weight, 0.5, 1e-6);
+}
+
+CCL_NAMESPACE_END
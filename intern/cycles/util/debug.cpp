@@ -31,7 +31,18 @@ void DebugFlags::CPU::reset()
 #undef STRINGIFY
 #undef CHECK_CPU_FLAGS
 
+  ray_packets = (getenv("CYCLES_CPU_NO_RAY_PACKETS") == nullptr);
+  if (!ray_packets) {
+    VLOG_INFO << "Disabling ray packets.";
+  }
+
   bvh_layout = BVH_LAYOUT_AUTO;
+
+  const char *scratch_dir_str = getenv("CYCLES_CPU_SCRATCH_DIR");
+  scratch_dir = (scratch_dir_str) ? scratch_dir_str : "";
+  if (!scratch_dir.empty()) {
+    VLOG_INFO << "Using scratch directory " << scratch_dir << " for scene data.";
+  }
 }
 
 DebugFlags::CUDA::CUDA()
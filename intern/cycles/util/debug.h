@@ -6,6 +6,8 @@
 
 #include <cassert>
 
+#include "util/string.h"
+
 #include "bvh/params.h"
 
 CCL_NAMESPACE_BEGIN
@@ -39,12 +41,21 @@ class DebugFlags {
       return sse42;
     }
 
+    /* Trace camera rays of consecutive samples of a pixel together as a ray packet, when
+     * supported by Embree. */
+    bool ray_packets = true;
+
     /* Requested BVH layout.
      *
      * By default the fastest will be used. For debugging the BVH used by other
      * CPUs and GPUs can be selected here instead.
      */
     BVHLayout bvh_layout = BVH_LAYOUT_AUTO;
+
+    /* Directory for files backing large scene data arrays, like packed BVH nodes and triangle
+     * data. When set, these are memory-mapped so the operating system can page them out instead
+     * of keeping everything in RAM. Should be on fast local storage. */
+    string scratch_dir;
   };
 
   /* Descriptor of CUDA feature-set to be used. */
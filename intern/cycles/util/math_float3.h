@@ -634,6 +634,44 @@ ccl_device_inline float tan_angle(const float3 a, const float3 b)
   return len(cross(a, b)) / dot(a, b);
 }
 
+/* Octahedral encoding of a unit vector into two 16 bit components, to store normals compactly.
+ * Zero is reserved for the zero vector, which is not a valid direction. */
+ccl_device_inline uint oct_encode_normal(const float3 n)
+{
+  const float sum = fabsf(n.x) + fabsf(n.y) + fabsf(n.z);
+  if (!(sum > 0.0f)) {
+    return 0;
+  }
+  float x = n.x / sum;
+  float y = n.y / sum;
+  if (n.z < 0.0f) {
+    /* Fold the lower hemisphere over the diagonals. */
+    const float x_folded = (1.0f - fabsf(y)) * ((x >= 0.0f) ? 1.0f : -1.0f);
+    y = (1.0f - fabsf(x)) * ((y >= 0.0f) ? 1.0f : -1.0f);
+    x = x_folded;
+  }
+  /* Map to [0..65534], so that zero is represented exactly. */
+  const uint ux = uint(clamp(x, -1.0f, 1.0f) * 32767.0f + 32767.5f);
+  const uint uy = uint(clamp(y, -1.0f, 1.0f) * 32767.0f + 32767.5f);
+  const uint packed = ux | (uy << 16);
+  /* The (-1, -1) corner is the same direction as (1, 1), keep zero for the zero vector. */
+  return (packed != 0) ? packed : 0xFFFEFFFEu;
+}
+
+ccl_device_inline float3 oct_decode_normal(const uint packed)
+{
+  if (packed == 0) {
+    return zero_float3();
+  }
+  const float x = float(int(packed & 0xFFFF) - 32767) * (1.0f / 32767.0f);
+  const float y = float(int(packed >> 16) - 32767) * (1.0f / 32767.0f);
+  float3 n = make_float3(x, y, 1.0f - fabsf(x) - fabsf(y));
+  const float t = max(-n.z, 0.0f);
+  n.x += (n.x >= 0.0f) ? -t : t;
+  n.y += (n.y >= 0.0f) ? -t : t;
+  return normalize(n);
+}
+
 /* projections */
 ccl_device_inline float2 map_to_tube(const float3 co)
 {
@@ -359,6 +359,12 @@ string path_user_get(const string &sub)
 
 string path_cache_get(const string &sub)
 {
+  /* Allow a cache directory shared by multiple users, for example for compiled kernels. */
+  const char *cache_dir = getenv("CYCLES_CACHE_DIR");
+  if (cache_dir != nullptr && cache_dir[0] != '\0') {
+    return path_join(cache_dir, sub);
+  }
+
 #if defined(__linux__) || defined(__APPLE__)
   if (cached_xdg_cache_path.empty()) {
     cached_xdg_cache_path = path_xdg_cache_get();
@@ -264,13 +264,8 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 /* Solve */
 
-bool EIG_linear_solver_solve(LinearSolver *solver)
+static bool linear_solver_factorize(LinearSolver *solver)
 {
-  /* nothing to solve, perhaps all variables were locked */
-  if (solver->m == 0 || solver->n == 0) {
-    return true;
-  }
-
   bool result = true;
 
   assert(solver->state != LinearSolver::STATE_VARIABLES_CONSTRUCT);
@@ -300,6 +295,18 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
     solver->state = LinearSolver::STATE_MATRIX_SOLVED;
   }
 
+  return result;
+}
+
+bool EIG_linear_solver_solve(LinearSolver *solver)
+{
+  /* nothing to solve, perhaps all variables were locked */
+  if (solver->m == 0 || solver->n == 0) {
+    return true;
+  }
+
+  bool result = linear_solver_factorize(solver);
+
   if (result) {
     /* solve for each right hand side */
     for (int rhs = 0; rhs < solver->num_rhs; rhs++) {
@@ -346,6 +353,47 @@ bool EIG_linear_solver_solve(LinearSolver *solver)
   return result;
 }
 
+bool EIG_linear_solver_factorize(LinearSolver *solver)
+{
+  linear_solver_ensure_matrix_construct(solver);
+
+  if (solver->m == 0 || solver->n == 0) {
+    return true;
+  }
+
+  return linear_solver_factorize(solver);
+}
+
+bool EIG_linear_solver_solve_vector(const LinearSolver *solver, const double *b, double *r_x)
+{
+  assert(!solver->least_squares);
+
+  if (solver->m == 0 || solver->n == 0) {
+    return true;
+  }
+
+  assert(solver->state == LinearSolver::STATE_MATRIX_SOLVED);
+
+  EigenVectorX b_vector(solver->m);
+  for (int i = 0; i < solver->num_variables; i++) {
+    const LinearSolver::Variable &variable = solver->variable[i];
+    assert(!variable.locked);
+    b_vector[variable.index] = b[i];
+  }
+
+  /* The factorization is only read, so this can run from multiple threads at once. */
+  const EigenVectorX x_vector = solver->sparseLU->solve(b_vector);
+  if (solver->sparseLU->info() != Eigen::Success) {
+    return false;
+  }
+
+  for (int i = 0; i < solver->num_variables; i++) {
+    r_x[i] = x_vector[solver->variable[i].index];
+  }
+
+  return true;
+}
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver)
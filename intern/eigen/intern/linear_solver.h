@@ -42,6 +42,13 @@ void EIG_linear_solver_right_hand_side_add(LinearSolver *solver, int rhs, int in
 
 bool EIG_linear_solver_solve(LinearSolver *solver);
 
+/* Factorize A once, then solve for many b at the same time. Solving doesn't modify the solver
+ * and may be called from multiple threads. Both b and x are indexed by variable. Not supported
+ * for least squares solvers or with locked variables. */
+
+bool EIG_linear_solver_factorize(LinearSolver *solver);
+bool EIG_linear_solver_solve_vector(const LinearSolver *solver, const double *b, double *r_x);
+
 /* Debugging */
 
 void EIG_linear_solver_print_matrix(LinearSolver *solver);
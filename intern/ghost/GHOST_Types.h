@@ -731,6 +731,11 @@ typedef struct {
   uint vendor_id;
   /** Device ID of the GPU provided by the vendor. */
   uint device_id;
+  /**
+   * Select the device by #index only, ignoring the vendor and device IDs. Used when the device
+   * is given on the command line, where the IDs aren't known.
+   */
+  bool use_index_only;
 } GHOST_GPUDevice;
 
 typedef struct {
@@ -459,8 +459,13 @@ static GHOST_TSuccess ensure_vulkan_device(VkInstance vk_instance,
     }
     /* User has configured a preferred device. Add bonus score when vendor and device match. Driver
      * id isn't considered as drivers update more frequently and can break the device selection. */
-    if (device_vk.properties.deviceID == preferred_device.device_id &&
-        device_vk.properties.vendorID == preferred_device.vendor_id)
+    if (preferred_device.use_index_only) {
+      if (preferred_device.index == device_index) {
+        device_score += 510;
+      }
+    }
+    else if (device_vk.properties.deviceID == preferred_device.device_id &&
+             device_vk.properties.vendorID == preferred_device.vendor_id)
     {
       device_score += 500;
       if (preferred_device.index == device_index) {
@@ -246,6 +246,45 @@ extern void (*MEM_reset_peak_memory)(void);
 /** Get the peak memory usage in bytes, including `mmap` allocations. */
 extern size_t (*MEM_get_peak_memory)(void) ATTR_WARN_UNUSED_RESULT;
 
+/**
+ * Allocation statistics of the calling thread, used to measure the memory allocated by the code
+ * running in a scope. Only the lock-free allocator tracks these, they are zero otherwise.
+ */
+typedef struct MEM_ThreadAllocStats {
+  /** Total number of bytes and blocks allocated by the thread since it started. */
+  size_t allocated_bytes;
+  size_t allocated_blocks;
+  /**
+   * Bytes allocated minus bytes freed by the thread. This can be negative when the thread frees
+   * memory allocated elsewhere.
+   */
+  int64_t mem_in_use;
+  /** Largest #mem_in_use since the last call to #MEM_set_thread_peak_memory. */
+  int64_t mem_in_use_peak;
+} MEM_ThreadAllocStats;
+
+extern void (*MEM_get_thread_alloc_stats)(MEM_ThreadAllocStats *r_stats);
+/** Set the peak memory usage of the calling thread, see #MEM_ThreadAllocStats.mem_in_use_peak. */
+extern void (*MEM_set_thread_peak_memory)(int64_t peak);
+
+/**
+ * Start the sampling allocation profiler, clearing previously recorded data. Only allocations of
+ * the lock-free allocator are profiled.
+ *
+ * One allocation is recorded with its name and a short stack trace whenever a thread allocated
+ * another \a sample_interval bytes, which keeps the overhead low enough for production use.
+ */
+void MEM_profiler_enable(size_t sample_interval);
+/** Stop recording allocations, the recorded data is kept for #MEM_profiler_report. */
+void MEM_profiler_disable(void);
+bool MEM_profiler_is_enabled(void);
+/**
+ * Get a text report of the \a sites_num allocation sites using the most memory, currently and
+ * at the highest memory usage seen while profiling, and of the memory usage over time.
+ * The result must be freed with #MEM_freeN.
+ */
+char *MEM_profiler_report(int sites_num) ATTR_WARN_UNUSED_RESULT;
+
 /** Overhead for lockfree allocator (use to avoid slop-space). */
 #define MEM_SIZE_OVERHEAD sizeof(size_t)
 #define MEM_SIZE_OPTIMAL(size) ((size)-MEM_SIZE_OVERHEAD)
@@ -293,6 +332,17 @@ void MEM_enable_fail_on_memleak(void);
  */
 void MEM_use_lockfree_allocator(void);
 
+/**
+ * Switch allocator to the lock-free mode with per-thread caches of small blocks.
+ *
+ * This is the lock-free allocator, except that small blocks are taken from thread-local free
+ * lists of fixed size classes instead of the system allocator. This is faster for many small
+ * allocations from many threads, at the cost of never returning freed small blocks to the system.
+ *
+ * \note The switch between allocator types can only happen before any allocation did happen.
+ */
+void MEM_use_thread_cache_allocator(void);
+
 /**
  * Switch allocator to slow fully guarded mode.
  *
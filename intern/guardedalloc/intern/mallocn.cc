@@ -71,6 +71,9 @@ size_t (*MEM_get_memory_in_use)(void) = MEM_lockfree_get_memory_in_use;
 uint (*MEM_get_memory_blocks_in_use)(void) = MEM_lockfree_get_memory_blocks_in_use;
 void (*MEM_reset_peak_memory)(void) = MEM_lockfree_reset_peak_memory;
 size_t (*MEM_get_peak_memory)(void) = MEM_lockfree_get_peak_memory;
+void (*MEM_get_thread_alloc_stats)(MEM_ThreadAllocStats *r_stats) =
+    MEM_lockfree_get_thread_alloc_stats;
+void (*MEM_set_thread_peak_memory)(int64_t peak) = MEM_lockfree_set_thread_peak_memory;
 
 void (*mem_clearmemlist)(void) = mem_lockfree_clearmemlist;
 
@@ -169,6 +172,7 @@ void MEM_use_lockfree_allocator()
 
   assert_for_allocator_change();
 
+  mem_thread_cache_enabled = false;
   MEM_allocN_len = MEM_lockfree_allocN_len;
   mem_freeN_ex = MEM_lockfree_freeN;
   mem_dupallocN = MEM_lockfree_dupallocN;
@@ -192,6 +196,8 @@ void MEM_use_lockfree_allocator()
   MEM_get_memory_blocks_in_use = MEM_lockfree_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_lockfree_reset_peak_memory;
   MEM_get_peak_memory = MEM_lockfree_get_peak_memory;
+  MEM_get_thread_alloc_stats = MEM_lockfree_get_thread_alloc_stats;
+  MEM_set_thread_peak_memory = MEM_lockfree_set_thread_peak_memory;
 
   mem_clearmemlist = mem_lockfree_clearmemlist;
 
@@ -201,10 +207,19 @@ void MEM_use_lockfree_allocator()
 #endif
 }
 
+void MEM_use_thread_cache_allocator()
+{
+  MEM_use_lockfree_allocator();
+
+  mem_thread_cache_init();
+  mem_thread_cache_enabled = true;
+}
+
 void MEM_use_guarded_allocator()
 {
   assert_for_allocator_change();
 
+  mem_thread_cache_enabled = false;
   MEM_allocN_len = MEM_guarded_allocN_len;
   mem_freeN_ex = MEM_guarded_freeN;
   mem_dupallocN = MEM_guarded_dupallocN;
@@ -228,6 +243,8 @@ void MEM_use_guarded_allocator()
   MEM_get_memory_blocks_in_use = MEM_guarded_get_memory_blocks_in_use;
   MEM_reset_peak_memory = MEM_guarded_reset_peak_memory;
   MEM_get_peak_memory = MEM_guarded_get_peak_memory;
+  MEM_get_thread_alloc_stats = MEM_guarded_get_thread_alloc_stats;
+  MEM_set_thread_peak_memory = MEM_guarded_set_thread_peak_memory;
 
   mem_clearmemlist = mem_guarded_clearmemlist;
 
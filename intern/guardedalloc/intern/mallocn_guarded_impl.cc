@@ -1364,6 +1364,14 @@ void MEM_guarded_reset_peak_memory()
   mem_unlock_thread();
 }
 
+void MEM_guarded_get_thread_alloc_stats(MEM_ThreadAllocStats *r_stats)
+{
+  /* Not tracked per thread. */
+  memset(r_stats, 0, sizeof(*r_stats));
+}
+
+void MEM_guarded_set_thread_peak_memory(const int64_t /*peak*/) {}
+
 size_t MEM_guarded_get_memory_in_use()
 {
   size_t _mem_in_use;
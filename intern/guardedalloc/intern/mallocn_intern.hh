@@ -7,6 +7,8 @@
  * \ingroup intern_mem
  */
 
+#include <atomic>
+
 #ifdef __GNUC__
 #  define UNUSED(x) UNUSED_##x __attribute__((__unused__))
 #elif defined(_MSC_VER)
@@ -104,6 +106,27 @@ size_t memory_usage_current(void);
  */
 size_t memory_usage_peak(void);
 void memory_usage_peak_reset(void);
+void memory_usage_local_stats(MEM_ThreadAllocStats *r_stats);
+void memory_usage_local_peak_set(int64_t peak);
+
+/**
+ * Small block allocation with per-thread size-class caches, used by the lock-free allocator for
+ * blocks without alignment requirements when #mem_thread_cache_enabled is set. Sizes include the
+ * block header. Blocks larger than the biggest size class use the system allocator.
+ */
+extern bool mem_thread_cache_enabled;
+void mem_thread_cache_init(void);
+void *mem_thread_cache_malloc(size_t size);
+void *mem_thread_cache_calloc(size_t size);
+void mem_thread_cache_free(void *ptr, size_t size);
+
+/**
+ * Sampling allocation profiler, see #MEM_profiler_enable. The lock-free allocator calls these
+ * for every allocated and freed block while #mem_profiler_enabled is set.
+ */
+extern std::atomic<bool> mem_profiler_enabled;
+void mem_profiler_alloc(const void *ptr, size_t len, const char *name);
+void mem_profiler_free(const void *ptr);
 
 /**
  * Clear the listbase of allocated memory blocks.
@@ -165,6 +188,8 @@ size_t MEM_lockfree_get_memory_in_use(void);
 unsigned int MEM_lockfree_get_memory_blocks_in_use(void);
 void MEM_lockfree_reset_peak_memory(void);
 size_t MEM_lockfree_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_lockfree_get_thread_alloc_stats(MEM_ThreadAllocStats *r_stats);
+void MEM_lockfree_set_thread_peak_memory(int64_t peak);
 
 void mem_lockfree_clearmemlist(void);
 
@@ -217,6 +242,8 @@ size_t MEM_guarded_get_memory_in_use(void);
 unsigned int MEM_guarded_get_memory_blocks_in_use(void);
 void MEM_guarded_reset_peak_memory(void);
 size_t MEM_guarded_get_peak_memory(void) ATTR_WARN_UNUSED_RESULT;
+void MEM_guarded_get_thread_alloc_stats(MEM_ThreadAllocStats *r_stats);
+void MEM_guarded_set_thread_peak_memory(int64_t peak);
 
 void mem_guarded_clearmemlist(void);
 
@@ -78,6 +78,33 @@ enum {
 #define MEMHEAD_IS_FROM_CPP_NEW(memhead) ((memhead)->len & size_t(MEMHEAD_FLAG_FROM_CPP_NEW))
 #define MEMHEAD_LEN(memhead) ((memhead)->len & ~size_t(MEMHEAD_FLAG_MASK))
 
+/* Memory for blocks without alignment requirements, including their #MemHead. */
+
+static void *mem_block_malloc(const size_t size)
+{
+  if (mem_thread_cache_enabled) {
+    return mem_thread_cache_malloc(size);
+  }
+  return malloc(size);
+}
+
+static void *mem_block_calloc(const size_t size)
+{
+  if (mem_thread_cache_enabled) {
+    return mem_thread_cache_calloc(size);
+  }
+  return calloc(1, size);
+}
+
+static void mem_block_free(void *ptr, const size_t size)
+{
+  if (mem_thread_cache_enabled) {
+    mem_thread_cache_free(ptr, size);
+    return;
+  }
+  free(ptr);
+}
+
 #ifdef __GNUC__
 __attribute__((format(printf, 1, 0)))
 #endif
@@ -165,6 +192,9 @@ void MEM_lockfree_freeN(void *vmemh, AllocationType allocation_type)
   }
 
   memory_usage_block_free(len);
+  if (UNLIKELY(mem_profiler_enabled.load(std::memory_order_relaxed))) {
+    mem_profiler_free(vmemh);
+  }
 
   if (UNLIKELY(malloc_debug_memset && len)) {
     memset(memh + 1, 255, len);
@@ -174,7 +204,7 @@ void MEM_lockfree_freeN(void *vmemh, AllocationType allocation_type)
     aligned_free(MEMHEAD_REAL_PTR(memh_aligned));
   }
   else {
-    free(memh);
+    mem_block_free(memh, len + sizeof(MemHead));
   }
 }
 
@@ -301,11 +331,14 @@ void *MEM_lockfree_callocN(size_t len, const char *str)
 
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)calloc(1, len + sizeof(MemHead));
+  memh = (MemHead *)mem_block_calloc(len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
     memh->len = len;
     memory_usage_block_alloc(len);
+    if (UNLIKELY(mem_profiler_enabled.load(std::memory_order_relaxed))) {
+      mem_profiler_alloc(PTR_FROM_MEMHEAD(memh), len, str);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -343,7 +376,7 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 #endif
   len = SIZET_ALIGN_4(len);
 
-  memh = (MemHead *)malloc(len + sizeof(MemHead));
+  memh = (MemHead *)mem_block_malloc(len + sizeof(MemHead));
 
   if (LIKELY(memh)) {
 
@@ -363,6 +396,9 @@ void *MEM_lockfree_mallocN(size_t len, const char *str)
 
     memh->len = len;
     memory_usage_block_alloc(len);
+    if (UNLIKELY(mem_profiler_enabled.load(std::memory_order_relaxed))) {
+      mem_profiler_alloc(PTR_FROM_MEMHEAD(memh), len, str);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -450,6 +486,9 @@ void *MEM_lockfree_mallocN_aligned(size_t len,
                                                                        0);
     memh->alignment = short(alignment);
     memory_usage_block_alloc(len);
+    if (UNLIKELY(mem_profiler_enabled.load(std::memory_order_relaxed))) {
+      mem_profiler_alloc(PTR_FROM_MEMHEAD(memh), len, str);
+    }
 
     return PTR_FROM_MEMHEAD(memh);
   }
@@ -573,6 +612,16 @@ size_t MEM_lockfree_get_peak_memory()
   return memory_usage_peak();
 }
 
+void MEM_lockfree_get_thread_alloc_stats(MEM_ThreadAllocStats *r_stats)
+{
+  memory_usage_local_stats(r_stats);
+}
+
+void MEM_lockfree_set_thread_peak_memory(const int64_t peak)
+{
+  memory_usage_local_peak_set(peak);
+}
+
 #ifndef NDEBUG
 const char *MEM_lockfree_name_ptr(void *vmemh)
 {
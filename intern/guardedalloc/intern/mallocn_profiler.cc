@@ -0,0 +1,383 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Sampling allocation profiler for the lock-free allocator.
+ *
+ * Every thread counts down the number of bytes it allocates, and records an allocation each time
+ * about #sample_interval bytes have been allocated. The distance between samples is randomized to
+ * avoid bias with allocation patterns that repeat. A recorded block stands for approximately
+ * `max(size, sample_interval)` bytes. Recorded blocks are grouped by allocation site, which is the
+ * name passed to the allocation function and a short stack trace, so that the memory used by
+ * each site can be estimated without tracking every block.
+ *
+ * Frees only have to take a lock when the freed block might have been recorded, which is checked
+ * with a table of counters indexed by a hash of the block address.
+ */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if defined(__GLIBC__) || defined(__APPLE__)
+#  include <execinfo.h>
+#  define WITH_MEM_PROFILER_BACKTRACE
+#endif
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.hh"
+
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+namespace {
+
+/** Number of stack frames stored per allocation site. */
+constexpr int stack_frames_num = 10;
+/** Frames of the profiler itself that are not stored. */
+constexpr int stack_frames_skip = 2;
+/** Number of counters used to quickly check if a freed block was sampled. */
+constexpr int sampled_counts_bits = 20;
+/** The timeline is thinned out when it reaches this number of points. */
+constexpr size_t max_timeline_points = 4096;
+
+using Clock = std::chrono::steady_clock;
+
+struct Site {
+  const char *name;
+  void *stack[stack_frames_num];
+  int stack_len;
+  /** Estimated bytes and number of sampled blocks that are currently allocated. */
+  int64_t mem_in_use = 0;
+  int64_t samples_in_use = 0;
+  /** Estimated bytes allocated since the profiler was enabled. */
+  int64_t mem_allocated = 0;
+};
+
+struct SiteKey {
+  const char *name;
+  uint64_t stack_hash;
+
+  bool operator==(const SiteKey &other) const
+  {
+    return name == other.name && stack_hash == other.stack_hash;
+  }
+};
+
+struct SiteKeyHash {
+  size_t operator()(const SiteKey &key) const
+  {
+    return size_t(uint64_t(uintptr_t(key.name)) * 0x9e3779b97f4a7c15ull ^ key.stack_hash);
+  }
+};
+
+struct SampledBlock {
+  size_t site_index;
+  int64_t weight;
+};
+
+struct TimelinePoint {
+  double time;
+  size_t mem_in_use;
+};
+
+struct Profiler {
+  std::mutex mutex;
+  size_t sample_interval = 0;
+  Clock::time_point start_time;
+
+  std::vector<Site> sites;
+  std::unordered_map<SiteKey, size_t, SiteKeyHash> site_indices;
+  std::unordered_map<const void *, SampledBlock> sampled_blocks;
+
+  std::vector<TimelinePoint> timeline;
+  /** Minimum time between timeline points, doubled whenever the timeline is thinned out. */
+  double timeline_resolution = 0.05;
+
+  /** Memory used by every site when the highest memory usage was recorded. */
+  size_t peak_mem_in_use = 0;
+  double peak_time = 0.0;
+  std::vector<int64_t> peak_site_mem_in_use;
+};
+
+}  // namespace
+
+std::atomic<bool> mem_profiler_enabled = false;
+
+/**
+ * Number of sampled blocks per hash of the block address, allocated when the profiler is enabled
+ * for the first time. Only used to avoid locking when freeing blocks that were not sampled.
+ */
+static std::unique_ptr<std::atomic<uint16_t>[]> sampled_counts;
+
+static Profiler &get_profiler()
+{
+  /* Intentionally leaked, blocks may still be freed during static destruction. */
+  static Profiler *profiler = new Profiler();
+  return *profiler;
+}
+
+static size_t sampled_count_index(const void *ptr)
+{
+  return size_t((uint64_t(uintptr_t(ptr)) * 0x9e3779b97f4a7c15ull) >> (64 - sampled_counts_bits));
+}
+
+static void timeline_add_point(Profiler &profiler, const double time)
+{
+  if (!profiler.timeline.empty() &&
+      time - profiler.timeline.back().time < profiler.timeline_resolution)
+  {
+    return;
+  }
+  if (profiler.timeline.size() == max_timeline_points) {
+    /* Keep every other point, the timeline always covers the whole profiling session. */
+    for (size_t i = 0; i < max_timeline_points / 2; i++) {
+      profiler.timeline[i] = profiler.timeline[i * 2];
+    }
+    profiler.timeline.resize(max_timeline_points / 2);
+    profiler.timeline_resolution *= 2.0;
+  }
+  const size_t mem_in_use = memory_usage_current();
+  profiler.timeline.push_back({time, mem_in_use});
+
+  if (mem_in_use > profiler.peak_mem_in_use) {
+    profiler.peak_mem_in_use = mem_in_use;
+    profiler.peak_time = time;
+    profiler.peak_site_mem_in_use.resize(profiler.sites.size());
+    for (size_t i = 0; i < profiler.sites.size(); i++) {
+      profiler.peak_site_mem_in_use[i] = profiler.sites[i].mem_in_use;
+    }
+  }
+}
+
+static void mem_profiler_record(const void *ptr, const size_t len, const char *name)
+{
+  Site site{};
+  site.name = name;
+#ifdef WITH_MEM_PROFILER_BACKTRACE
+  void *stack[stack_frames_num + stack_frames_skip];
+  const int stack_len = backtrace(stack, stack_frames_num + stack_frames_skip);
+  site.stack_len = std::max(stack_len - stack_frames_skip, 0);
+  memcpy(site.stack, stack + stack_frames_skip, sizeof(void *) * size_t(site.stack_len));
+#endif
+  uint64_t stack_hash = 0;
+  for (int i = 0; i < site.stack_len; i++) {
+    stack_hash = (stack_hash ^ uint64_t(uintptr_t(site.stack[i]))) * 0x100000001b3ull;
+  }
+
+  Profiler &profiler = get_profiler();
+  std::lock_guard lock{profiler.mutex};
+  if (!mem_profiler_enabled.load(std::memory_order_relaxed)) {
+    return;
+  }
+  const int64_t weight = int64_t(std::max(len, profiler.sample_interval));
+
+  const auto [item, inserted] = profiler.site_indices.try_emplace({name, stack_hash},
+                                                                  profiler.sites.size());
+  if (inserted) {
+    profiler.sites.push_back(site);
+  }
+  Site &recorded_site = profiler.sites[item->second];
+  recorded_site.mem_in_use += weight;
+  recorded_site.samples_in_use++;
+  recorded_site.mem_allocated += weight;
+
+  profiler.sampled_blocks[ptr] = {item->second, weight};
+  sampled_counts[sampled_count_index(ptr)].fetch_add(1, std::memory_order_relaxed);
+
+  const std::chrono::duration<double> time = Clock::now() - profiler.start_time;
+  timeline_add_point(profiler, time.count());
+}
+
+/** Exponentially distributed distance to the next sample, with a mean of the sample interval. */
+static int64_t next_sample_distance(uint64_t &rng_state, const size_t sample_interval)
+{
+  /* Xorshift, the quality is good enough for this. */
+  rng_state ^= rng_state << 13;
+  rng_state ^= rng_state >> 7;
+  rng_state ^= rng_state << 17;
+  const double random = (double(rng_state >> 11) + 0.5) / double(uint64_t(1) << 53);
+  return int64_t(-std::log(random) * double(sample_interval)) + 1;
+}
+
+void mem_profiler_alloc(const void *ptr, const size_t len, const char *name)
+{
+  /* Bytes this thread can allocate until the next allocation is sampled. */
+  static thread_local int64_t bytes_until_sample = 0;
+  static thread_local uint64_t rng_state = 0;
+
+  bytes_until_sample -= int64_t(len);
+  if (LIKELY(bytes_until_sample > 0)) {
+    return;
+  }
+  Profiler &profiler = get_profiler();
+  if (UNLIKELY(rng_state == 0)) {
+    /* First sample of this thread, only start counting unless the block is large. */
+    rng_state = uint64_t(uintptr_t(&rng_state)) | 1;
+    bytes_until_sample = next_sample_distance(rng_state, profiler.sample_interval) -
+                         int64_t(len);
+    if (bytes_until_sample > 0) {
+      return;
+    }
+  }
+  bytes_until_sample = next_sample_distance(rng_state, profiler.sample_interval);
+  mem_profiler_record(ptr, len, name);
+}
+
+void mem_profiler_free(const void *ptr)
+{
+  std::atomic<uint16_t> &count = sampled_counts[sampled_count_index(ptr)];
+  if (LIKELY(count.load(std::memory_order_relaxed) == 0)) {
+    return;
+  }
+  Profiler &profiler = get_profiler();
+  std::lock_guard lock{profiler.mutex};
+  const auto item = profiler.sampled_blocks.find(ptr);
+  if (item == profiler.sampled_blocks.end()) {
+    return;
+  }
+  Site &site = profiler.sites[item->second.site_index];
+  site.mem_in_use -= item->second.weight;
+  site.samples_in_use--;
+  profiler.sampled_blocks.erase(item);
+  count.fetch_sub(1, std::memory_order_relaxed);
+}
+
+void MEM_profiler_enable(const size_t sample_interval)
+{
+  Profiler &profiler = get_profiler();
+  std::lock_guard lock{profiler.mutex};
+  if (!sampled_counts) {
+    sampled_counts = std::make_unique<std::atomic<uint16_t>[]>(size_t(1) << sampled_counts_bits);
+  }
+  for (size_t i = 0; i < (size_t(1) << sampled_counts_bits); i++) {
+    sampled_counts[i].store(0, std::memory_order_relaxed);
+  }
+  profiler.sample_interval = std::max<size_t>(sample_interval, 1);
+  profiler.start_time = Clock::now();
+  profiler.sites.clear();
+  profiler.site_indices.clear();
+  profiler.sampled_blocks.clear();
+  profiler.timeline.clear();
+  profiler.timeline_resolution = 0.05;
+  profiler.peak_mem_in_use = 0;
+  profiler.peak_time = 0.0;
+  profiler.peak_site_mem_in_use.clear();
+  timeline_add_point(profiler, 0.0);
+
+  mem_profiler_enabled.store(true, std::memory_order_relaxed);
+}
+
+void MEM_profiler_disable()
+{
+  /* Keep the recorded data, so that it can still be reported. */
+  mem_profiler_enabled.store(false, std::memory_order_relaxed);
+}
+
+bool MEM_profiler_is_enabled()
+{
+  return mem_profiler_enabled.load(std::memory_order_relaxed);
+}
+
+#ifdef __GNUC__
+__attribute__((format(printf, 2, 3)))
+#endif
+static void
+report_append(std::string &report, const char *format, ...)
+{
+  char buf[512];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  report += buf;
+}
+
+static double to_mb(const int64_t bytes)
+{
+  return double(bytes) / double(1024 * 1024);
+}
+
+static void report_sites(std::string &report,
+                         const Profiler &profiler,
+                         const std::vector<int64_t> &site_mem_in_use,
+                         const int sites_num)
+{
+  std::vector<size_t> order;
+  for (size_t i = 0; i < site_mem_in_use.size(); i++) {
+    if (site_mem_in_use[i] > 0) {
+      order.push_back(i);
+    }
+  }
+  std::sort(order.begin(), order.end(), [&](const size_t a, const size_t b) {
+    return site_mem_in_use[a] > site_mem_in_use[b];
+  });
+  order.resize(std::min(order.size(), size_t(std::max(sites_num, 0))));
+
+  for (const size_t site_index : order) {
+    const Site &site = profiler.sites[site_index];
+    report_append(report,
+                  "  %10.2f MB  (%.2f MB allocated in total)  %s\n",
+                  to_mb(site_mem_in_use[site_index]),
+                  to_mb(site.mem_allocated),
+                  site.name ? site.name : "unknown");
+#ifdef WITH_MEM_PROFILER_BACKTRACE
+    char **symbols = backtrace_symbols(const_cast<void **>(site.stack), site.stack_len);
+    for (int i = 0; i < site.stack_len; i++) {
+      report_append(report, "        %s\n", symbols ? symbols[i] : "?");
+    }
+    free(symbols);
+#endif
+  }
+}
+
+char *MEM_profiler_report(const int sites_num)
+{
+  std::string report;
+  {
+    Profiler &profiler = get_profiler();
+    std::lock_guard lock{profiler.mutex};
+
+    report_append(report,
+                  "Memory profiler: %s, one sample per " SIZET_FORMAT " bytes, " SIZET_FORMAT
+                  " sampled blocks in use\n",
+                  mem_profiler_enabled ? "enabled" : "disabled",
+                  SIZET_ARG(profiler.sample_interval),
+                  SIZET_ARG(profiler.sampled_blocks.size()));
+
+    std::vector<int64_t> site_mem_in_use(profiler.sites.size());
+    for (size_t i = 0; i < profiler.sites.size(); i++) {
+      site_mem_in_use[i] = profiler.sites[i].mem_in_use;
+    }
+    report_append(report, "\nEstimated memory in use by allocation site:\n");
+    report_sites(report, profiler, site_mem_in_use, sites_num);
+
+    report_append(report,
+                  "\nEstimated memory in use by allocation site at the peak of %.2f MB at "
+                  "%.2f s:\n",
+                  to_mb(int64_t(profiler.peak_mem_in_use)),
+                  profiler.peak_time);
+    report_sites(report, profiler, profiler.peak_site_mem_in_use, sites_num);
+
+    report_append(report, "\nMemory in use over time:\n");
+    for (const TimelinePoint &point : profiler.timeline) {
+      report_append(
+          report, "  %10.2f s  %10.2f MB\n", point.time, to_mb(int64_t(point.mem_in_use)));
+    }
+  }
+
+  char *result = static_cast<char *>(MEM_mallocN(report.size() + 1, __func__));
+  memcpy(result, report.c_str(), report.size() + 1);
+  return result;
+}
@@ -0,0 +1,267 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup intern_mem
+ *
+ * Size-class based small block allocation with per-thread caches, used by the lock-free
+ * allocator when #MEM_use_thread_cache_allocator is called at startup.
+ *
+ * Small blocks are carved out of larger chunks and kept in per-thread free lists, one per size
+ * class. Allocating and freeing a small block only touches the free list of the current thread.
+ * Blocks are moved between threads in batches through a central free list protected by a mutex,
+ * which happens when a thread runs out of blocks of a size class or caches too many of them.
+ * Chunks are never returned to the system.
+ */
+
+#include <atomic>
+#include <cassert>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
+
+#include "MEM_guardedalloc.h"
+#include "mallocn_intern.hh"
+
+#include "../../source/blender/blenlib/BLI_strict_flags.h"
+
+namespace {
+
+/** Sizes of the size classes are multiples of this, it's also the alignment of all blocks. */
+constexpr size_t size_class_step = 16;
+constexpr size_t size_classes_num = 32;
+/** Larger blocks are allocated with the system allocator directly. */
+constexpr size_t max_cached_size = size_class_step * size_classes_num;
+/** Size of the memory chunks small blocks are carved from. */
+constexpr size_t chunk_size = 64 * 1024;
+/** Number of blocks moved between a thread cache and the central free list at once. */
+constexpr int64_t transfer_batch_size = 64;
+/** A thread moves blocks to the central free list when it caches more than this. */
+constexpr int64_t max_local_blocks = 4 * transfer_batch_size;
+
+struct FreeBlock {
+  FreeBlock *next;
+};
+
+struct FreeList {
+  FreeBlock *head = nullptr;
+  int64_t len = 0;
+
+  void push(FreeBlock *block)
+  {
+    block->next = this->head;
+    this->head = block;
+    this->len++;
+  }
+
+  FreeBlock *pop()
+  {
+    FreeBlock *block = this->head;
+    this->head = block->next;
+    this->len--;
+    return block;
+  }
+
+  /** Move up to \a max_num blocks from the front of this list to the front of \a other. */
+  void move_to(FreeList &other, const int64_t max_num)
+  {
+    if (this->head == nullptr) {
+      return;
+    }
+    FreeBlock *last = this->head;
+    int64_t num = 1;
+    while (num < max_num && last->next) {
+      last = last->next;
+      num++;
+    }
+    FreeBlock *first = this->head;
+    this->head = last->next;
+    this->len -= num;
+    last->next = other.head;
+    other.head = first;
+    other.len += num;
+  }
+};
+
+/**
+ * Free blocks shared between all threads, and blocks of threads that exited.
+ * Intentionally never destructed, blocks may still be freed during static destruction.
+ */
+struct Central {
+  std::mutex mutex;
+  FreeList lists[size_classes_num];
+  /** Keeps all chunks reachable so leak checkers don't report them. */
+  std::vector<void *> chunks;
+};
+
+/**
+ * This is stored per thread. Align to cache line size to avoid false sharing.
+ */
+struct alignas(128) Local {
+  FreeList lists[size_classes_num];
+  /** The cache of the main thread, see #Local::~Local. */
+  bool is_main = false;
+  /** Blocks freed by a thread after its cache was destructed go to the central lists. */
+  bool destructed = false;
+
+  Local();
+  ~Local();
+};
+
+}  // namespace
+
+bool mem_thread_cache_enabled = false;
+
+/**
+ * Thread caches are used for most of the lifetime of the program. Only when it starts exiting
+ * this becomes false, because thread-locals may be destructed already.
+ */
+static std::atomic<bool> use_local_caches = true;
+static std::atomic<bool> has_main_local = false;
+
+static Central &get_central()
+{
+  static Central *central = new Central();
+  return *central;
+}
+
+static Local &get_local()
+{
+  static thread_local Local local;
+  return local;
+}
+
+Local::Local()
+{
+  /* The first cache is created by #mem_thread_cache_init on the main thread. */
+  this->is_main = !has_main_local.exchange(true);
+}
+
+Local::~Local()
+{
+  Central &central = get_central();
+  {
+    std::lock_guard lock{central.mutex};
+    for (size_t i = 0; i < size_classes_num; i++) {
+      this->lists[i].move_to(central.lists[i], this->lists[i].len);
+    }
+  }
+  if (this->is_main) {
+    /* The main thread started shutting down, don't rely on thread-locals from now on. */
+    use_local_caches.store(false, std::memory_order_relaxed);
+  }
+  this->destructed = true;
+}
+
+static size_t size_class_index(const size_t size)
+{
+  return (size - 1) / size_class_step;
+}
+
+/** Carve a new chunk into blocks of the given size class and add them to \a list. */
+static bool add_chunk_blocks(Central &central, FreeList &list, const size_t class_index)
+{
+  const size_t block_size = (class_index + 1) * size_class_step;
+  char *chunk = static_cast<char *>(malloc(chunk_size));
+  if (UNLIKELY(chunk == nullptr)) {
+    return false;
+  }
+  central.chunks.push_back(chunk);
+  for (size_t offset = 0; offset + block_size <= chunk_size; offset += block_size) {
+    list.push(reinterpret_cast<FreeBlock *>(chunk + offset));
+  }
+  return true;
+}
+
+static void *central_malloc(const size_t class_index)
+{
+  Central &central = get_central();
+  std::lock_guard lock{central.mutex};
+  FreeList &list = central.lists[class_index];
+  if (list.head == nullptr && !add_chunk_blocks(central, list, class_index)) {
+    return nullptr;
+  }
+  return list.pop();
+}
+
+static void central_free(void *ptr, const size_t class_index)
+{
+  Central &central = get_central();
+  std::lock_guard lock{central.mutex};
+  central.lists[class_index].push(static_cast<FreeBlock *>(ptr));
+}
+
+void mem_thread_cache_init()
+{
+  /* Makes sure that the cache of the main thread is created first. */
+  get_local();
+}
+
+void *mem_thread_cache_malloc(const size_t size)
+{
+  if (size > max_cached_size) {
+    return malloc(size);
+  }
+  const size_t class_index = size_class_index(size);
+  if (UNLIKELY(!use_local_caches.load(std::memory_order_relaxed))) {
+    return central_malloc(class_index);
+  }
+  Local &local = get_local();
+  if (UNLIKELY(local.destructed)) {
+    return central_malloc(class_index);
+  }
+
+  FreeList &list = local.lists[class_index];
+  if (UNLIKELY(list.head == nullptr)) {
+    /* Refill from the blocks freed by other threads first, only then allocate a new chunk. */
+    Central &central = get_central();
+    std::lock_guard lock{central.mutex};
+    central.lists[class_index].move_to(list, transfer_batch_size);
+    if (list.head == nullptr && !add_chunk_blocks(central, list, class_index)) {
+      return nullptr;
+    }
+  }
+  return list.pop();
+}
+
+void *mem_thread_cache_calloc(const size_t size)
+{
+  if (size > max_cached_size) {
+    return calloc(1, size);
+  }
+  void *ptr = mem_thread_cache_malloc(size);
+  if (LIKELY(ptr)) {
+    memset(ptr, 0, size);
+  }
+  return ptr;
+}
+
+void mem_thread_cache_free(void *ptr, const size_t size)
+{
+  if (size > max_cached_size) {
+    free(ptr);
+    return;
+  }
+  const size_t class_index = size_class_index(size);
+  if (UNLIKELY(!use_local_caches.load(std::memory_order_relaxed))) {
+    central_free(ptr, class_index);
+    return;
+  }
+  Local &local = get_local();
+  if (UNLIKELY(local.destructed)) {
+    central_free(ptr, class_index);
+    return;
+  }
+
+  FreeList &list = local.lists[class_index];
+  list.push(static_cast<FreeBlock *>(ptr));
+  if (UNLIKELY(list.len > max_local_blocks)) {
+    /* Give blocks back so that threads which mostly free memory allocated elsewhere don't keep
+     * growing their cache. */
+    Central &central = get_central();
+    std::lock_guard lock{central.mutex};
+    list.move_to(central.lists[class_index], transfer_batch_size);
+  }
+}
@@ -54,6 +54,13 @@ struct alignas(128) Local {
    * accurate, but it's still good enough for practical purposes.
    */
   std::atomic<int64_t> mem_in_use_during_peak_update = 0;
+  /**
+   * Statistics that are only accessed by the owning thread, see #MEM_ThreadAllocStats. They don't
+   * have to be atomic.
+   */
+  int64_t allocated_bytes = 0;
+  int64_t allocated_blocks = 0;
+  int64_t mem_in_use_peak = 0;
 
   Local();
   ~Local();
@@ -195,6 +202,10 @@ void memory_usage_block_alloc(const size_t size)
      * time, which is very rare compared to doing allocations. */
     local.blocks_num.fetch_add(1, std::memory_order_relaxed);
     local.mem_in_use.fetch_add(int64_t(size), std::memory_order_relaxed);
+    local.allocated_blocks++;
+    local.allocated_bytes += int64_t(size);
+    local.mem_in_use_peak = std::max(local.mem_in_use_peak,
+                                     local.mem_in_use.load(std::memory_order_relaxed));
 
     /* If a certain amount of new memory has been allocated, update the peak. */
     if (local.mem_in_use - local.mem_in_use_during_peak_update > peak_update_threshold) {
@@ -264,3 +275,24 @@ void memory_usage_peak_reset()
   Global &global = get_global();
   global.peak = memory_usage_current();
 }
+
+void memory_usage_local_stats(MEM_ThreadAllocStats *r_stats)
+{
+  if (!use_local_counters.load(std::memory_order_relaxed)) {
+    *r_stats = {};
+    return;
+  }
+  const Local &local = get_local_data();
+  r_stats->allocated_bytes = size_t(local.allocated_bytes);
+  r_stats->allocated_blocks = size_t(local.allocated_blocks);
+  r_stats->mem_in_use = local.mem_in_use.load(std::memory_order_relaxed);
+  r_stats->mem_in_use_peak = local.mem_in_use_peak;
+}
+
+void memory_usage_local_peak_set(const int64_t peak)
+{
+  if (!use_local_counters.load(std::memory_order_relaxed)) {
+    return;
+  }
+  get_local_data().mem_in_use_peak = peak;
+}
@@ -0,0 +1,31 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <cstring>
+
+#include "MEM_guardedalloc.h"
+#include "guardedalloc_test_base.h"
+
+TEST_F(LockFreeAllocatorTest, MEM_profiler_report)
+{
+  MEM_profiler_enable(1024);
+  EXPECT_TRUE(MEM_profiler_is_enabled());
+
+  /* Blocks larger than the sample interval are always recorded. */
+  void *block = MEM_mallocN(1024 * 1024, "profiler test block");
+  char *report = MEM_profiler_report(10);
+  EXPECT_NE(strstr(report, "profiler test block"), nullptr);
+  MEM_freeN(report);
+
+  MEM_freeN(block);
+  MEM_profiler_disable();
+  EXPECT_FALSE(MEM_profiler_is_enabled());
+
+  /* Freed blocks are not reported as in use anymore. */
+  report = MEM_profiler_report(10);
+  EXPECT_NE(strstr(report, " bytes, 0 sampled blocks in use"), nullptr);
+  MEM_freeN(report);
+}
@@ -17,6 +17,14 @@ class LockFreeAllocatorTest : public ::testing::Test {
   }
 };
 
+class ThreadCacheAllocatorTest : public ::testing::Test {
+ protected:
+  virtual void SetUp()
+  {
+    MEM_use_thread_cache_allocator();
+  }
+};
+
 class GuardedAllocatorTest : public ::testing::Test {
  protected:
   virtual void SetUp()
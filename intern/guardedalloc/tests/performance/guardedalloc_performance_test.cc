@@ -0,0 +1,99 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <thread>
+#include <vector>
+
+#include "testing/testing.h"
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_index_range.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+
+namespace blender::tests {
+
+static constexpr int BLOCKS_PER_ROUND = 10000;
+static constexpr int ROUNDS_NUM = 100;
+
+static int threads_num()
+{
+  return std::max<int>(std::thread::hardware_concurrency(), 1);
+}
+
+static void run_on_threads(const FunctionRef<void(int thread)> fn)
+{
+  std::vector<std::thread> threads;
+  for (const int thread : IndexRange(threads_num())) {
+    threads.emplace_back([&, thread]() { fn(thread); });
+  }
+  for (std::thread &thread : threads) {
+    thread.join();
+  }
+}
+
+/** Every thread allocates and frees its own small blocks of random sizes. */
+static void local_small_allocations_benchmark(const char *name)
+{
+  SCOPED_TIMER(name);
+  run_on_threads([](const int thread) {
+    RandomNumberGenerator rng(thread);
+    Array<void *> blocks(BLOCKS_PER_ROUND);
+    for ([[maybe_unused]] const int round : IndexRange(ROUNDS_NUM)) {
+      for (void *&block : blocks) {
+        block = MEM_mallocN(rng.get_int32(256) + 1, __func__);
+      }
+      for (void *block : blocks) {
+        MEM_freeN(block);
+      }
+    }
+  });
+}
+
+/** Blocks are allocated by one thread and freed by another. */
+static void cross_thread_small_allocations_benchmark(const char *name)
+{
+  const int threads = threads_num();
+  Array<Array<void *>> blocks(threads, Array<void *>(BLOCKS_PER_ROUND));
+  SCOPED_TIMER(name);
+  for ([[maybe_unused]] const int round : IndexRange(ROUNDS_NUM / 10)) {
+    run_on_threads([&](const int thread) {
+      RandomNumberGenerator rng(thread);
+      for (void *&block : blocks[thread]) {
+        block = MEM_callocN(rng.get_int32(256) + 1, __func__);
+      }
+    });
+    run_on_threads([&](const int thread) {
+      for (void *block : blocks[(thread + 1) % threads]) {
+        MEM_freeN(block);
+      }
+    });
+  }
+}
+
+static void run_benchmarks()
+{
+  for ([[maybe_unused]] const int i : IndexRange(3)) {
+    local_small_allocations_benchmark("local small allocations");
+    cross_thread_small_allocations_benchmark("cross thread small allocations");
+  }
+}
+
+TEST(guardedalloc, lockfree_performance)
+{
+  MEM_use_lockfree_allocator();
+  run_benchmarks();
+}
+
+TEST(guardedalloc, thread_cache_performance)
+{
+  MEM_use_thread_cache_allocator();
+  run_benchmarks();
+  MEM_use_lockfree_allocator();
+}
+
+}  // namespace blender::tests
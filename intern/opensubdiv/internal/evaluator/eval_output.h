@@ -638,7 +638,7 @@ class VolatileEvalOutput : public EvalOutputAPI::EvalOutput {
     return face_varying_evaluators_[face_varying_channel]->getPatchTable();
   }
 
- private:
+ protected:
   SRC_VERTEX_BUFFER *src_data_;
   SRC_VERTEX_BUFFER *src_varying_data_;
   SRC_VERTEX_BUFFER *src_vertex_data_;
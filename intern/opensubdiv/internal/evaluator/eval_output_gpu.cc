@@ -6,12 +6,17 @@
 
 #include "internal/evaluator/eval_output_gpu.h"
 
+#include <cstring>
+
 #include "opensubdiv_evaluator.hh"
 
+#include "GPU_state.hh"
+
 #include "gpu_patch_table.hh"
 
 using OpenSubdiv::Osd::PatchArray;
 using OpenSubdiv::Osd::PatchArrayVector;
+using OpenSubdiv::Osd::PatchCoord;
 
 namespace blender::opensubdiv {
 
@@ -43,6 +48,152 @@ GpuEvalOutput::GpuEvalOutput(const StencilTable *vertex_stencils,
 {
 }
 
+/* The layout of the vertex format has to match #OsdPatchCoord used by the compute shader. */
+static gpu::VertBuf *create_patch_coords_buffer(const PatchCoord *patch_coords,
+                                                const int num_patch_coords)
+{
+  static_assert(sizeof(PatchCoord) == sizeof(int) * 3 + sizeof(float) * 2);
+  GPUVertFormat format{};
+  GPU_vertformat_attr_add(&format, "handle", GPU_COMP_I32, 3, GPU_FETCH_INT);
+  GPU_vertformat_attr_add(&format, "uv", GPU_COMP_F32, 2, GPU_FETCH_FLOAT);
+  gpu::VertBuf *buffer = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_STATIC);
+  GPU_vertbuf_data_alloc(*buffer, num_patch_coords);
+  memcpy(buffer->data<PatchCoord>().data(), patch_coords, sizeof(PatchCoord) * num_patch_coords);
+  return buffer;
+}
+
+static gpu::VertBuf *create_result_buffer(const int element_count, const int num_patch_coords)
+{
+  GPUVertFormat format{};
+  GPU_vertformat_attr_add(&format, "elements", GPU_COMP_F32, element_count, GPU_FETCH_FLOAT);
+  gpu::VertBuf *buffer = GPU_vertbuf_create_with_format_ex(format, GPU_USAGE_DEVICE_ONLY);
+  GPU_vertbuf_data_alloc(*buffer, num_patch_coords);
+  return buffer;
+}
+
+static void read_result_buffer(gpu::VertBuf *buffer, float *r_data)
+{
+  if (buffer == nullptr) {
+    return;
+  }
+  GPU_vertbuf_read(buffer, r_data);
+  GPU_vertbuf_discard(buffer);
+}
+
+/**
+ * Evaluate the patches at the given coordinates with the compute shader, and read the results
+ * back. The derivatives are only evaluated when their output arrays are given.
+ */
+static void eval_patches_and_read_back(GpuEvalOutput::EvaluatorCache *evaluator_cache,
+                                       gpu::VertBuf *src_buffer,
+                                       const BufferDescriptor &src_desc,
+                                       const PatchArrayVector &patch_arrays,
+                                       GPUStorageBuf *patch_index_buffer,
+                                       GPUStorageBuf *patch_param_buffer,
+                                       const PatchCoord *patch_coords,
+                                       const int num_patch_coords,
+                                       float *P,
+                                       float *dPdu,
+                                       float *dPdv)
+{
+  if (num_patch_coords == 0) {
+    return;
+  }
+  const int element_count = src_desc.length;
+  const BufferDescriptor dst_desc(0, element_count, element_count);
+  const BufferDescriptor du_desc = dPdu ? dst_desc : BufferDescriptor();
+  const BufferDescriptor dv_desc = dPdv ? dst_desc : BufferDescriptor();
+
+  GPUComputeEvaluator *eval_instance = OpenSubdiv::Osd::GetEvaluator<GPUComputeEvaluator>(
+      evaluator_cache, src_desc, dst_desc, du_desc, dv_desc, static_cast<void *>(nullptr));
+  const bool own_instance = eval_instance == nullptr;
+  if (own_instance) {
+    eval_instance = GPUComputeEvaluator::Create(src_desc, dst_desc, du_desc, dv_desc);
+    if (eval_instance == nullptr) {
+      return;
+    }
+  }
+
+  gpu::VertBuf *patch_coords_buffer = create_patch_coords_buffer(patch_coords, num_patch_coords);
+  gpu::VertBuf *P_buffer = create_result_buffer(element_count, num_patch_coords);
+  gpu::VertBuf *dPdu_buffer = dPdu ? create_result_buffer(element_count, num_patch_coords) :
+                                     nullptr;
+  gpu::VertBuf *dPdv_buffer = dPdv ? create_result_buffer(element_count, num_patch_coords) :
+                                     nullptr;
+
+  eval_instance->EvalPatches(src_buffer,
+                             src_desc,
+                             P_buffer,
+                             dst_desc,
+                             dPdu_buffer,
+                             du_desc,
+                             dPdv_buffer,
+                             dv_desc,
+                             num_patch_coords,
+                             patch_coords_buffer,
+                             patch_arrays,
+                             patch_index_buffer,
+                             patch_param_buffer);
+
+  GPU_memory_barrier(GPU_BARRIER_BUFFER_UPDATE);
+  read_result_buffer(P_buffer, P);
+  read_result_buffer(dPdu_buffer, dPdu);
+  read_result_buffer(dPdv_buffer, dPdv);
+  GPU_vertbuf_discard(patch_coords_buffer);
+  if (own_instance) {
+    delete eval_instance;
+  }
+}
+
+void GpuEvalOutput::evalPatches(const PatchCoord *patch_coord,
+                                const int num_patch_coords,
+                                float *P)
+{
+  evalPatchesWithDerivatives(patch_coord, num_patch_coords, P, nullptr, nullptr);
+}
+
+void GpuEvalOutput::evalPatchesWithDerivatives(const PatchCoord *patch_coord,
+                                               const int num_patch_coords,
+                                               float *P,
+                                               float *dPdu,
+                                               float *dPdv)
+{
+  GPUPatchTable *patch_table = getPatchTable();
+  eval_patches_and_read_back(evaluator_cache_,
+                             get_source_buf(),
+                             src_desc_,
+                             patch_table->GetPatchArrays(),
+                             patch_table->GetPatchIndexBuffer(),
+                             patch_table->GetPatchParamBuffer(),
+                             patch_coord,
+                             num_patch_coords,
+                             P,
+                             dPdu,
+                             dPdv);
+}
+
+void GpuEvalOutput::evalPatchesFaceVarying(const int face_varying_channel,
+                                           const PatchCoord *patch_coord,
+                                           const int num_patch_coords,
+                                           float face_varying[2])
+{
+  GPUPatchTable *patch_table = getFVarPatchTable(face_varying_channel);
+  const BufferDescriptor src_desc(get_face_varying_source_offset(face_varying_channel),
+                                  face_varying_width_,
+                                  face_varying_width_);
+  eval_patches_and_read_back(evaluator_cache_,
+                             get_face_varying_source_buf(face_varying_channel),
+                             src_desc,
+                             patch_table->GetFVarPatchArrays(face_varying_channel),
+                             patch_table->GetFVarPatchIndexBuffer(face_varying_channel),
+                             patch_table->GetFVarPatchParamBuffer(face_varying_channel),
+                             patch_coord,
+                             num_patch_coords,
+                             face_varying,
+                             nullptr,
+                             nullptr);
+}
+
 GPUStorageBuf *GpuEvalOutput::create_patch_arrays_buf()
 {
   GPUPatchTable *patch_table = getPatchTable();
@@ -31,6 +31,19 @@ class GpuEvalOutput : public VolatileEvalOutput<GPUVertexBuffer,
                 const PatchTable *patch_table,
                 EvaluatorCache *evaluator_cache = nullptr);
 
+  // Batched evaluation on the GPU, with the results read back to the given host memory. These
+  // require an active GPU context, the base class versions can't be used with GPU buffers.
+  void evalPatches(const PatchCoord *patch_coord, const int num_patch_coords, float *P) override;
+  void evalPatchesWithDerivatives(const PatchCoord *patch_coord,
+                                  const int num_patch_coords,
+                                  float *P,
+                                  float *dPdu,
+                                  float *dPdv) override;
+  void evalPatchesFaceVarying(const int face_varying_channel,
+                              const PatchCoord *patch_coord,
+                              const int num_patch_coords,
+                              float face_varying[2]) override;
+
   GPUStorageBuf *create_patch_arrays_buf() override;
 
   GPUStorageBuf *get_patch_index_buf() override
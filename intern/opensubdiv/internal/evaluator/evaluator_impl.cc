@@ -12,7 +12,6 @@
 
 #include <opensubdiv/far/patchMap.h>
 #include <opensubdiv/far/patchTable.h>
-#include <opensubdiv/far/patchTableFactory.h>
 #include <opensubdiv/osd/mesh.h>
 #include <opensubdiv/osd/types.h>
 #include <opensubdiv/version.h>
@@ -26,10 +25,7 @@
 #include "opensubdiv_topology_refiner.hh"
 
 using OpenSubdiv::Far::PatchTable;
-using OpenSubdiv::Far::PatchTableFactory;
 using OpenSubdiv::Far::StencilTable;
-using OpenSubdiv::Far::StencilTableFactory;
-using OpenSubdiv::Far::StencilTableReal;
 using OpenSubdiv::Far::TopologyRefiner;
 using OpenSubdiv::Osd::PatchArray;
 using OpenSubdiv::Osd::PatchCoord;
@@ -327,6 +323,17 @@ void EvalOutputAPI::evaluatePatchesLimit(const OpenSubdiv_PatchCoord *patch_coor
   }
 }
 
+void EvalOutputAPI::evaluatePatchesFaceVarying(const int face_varying_channel,
+                                               const OpenSubdiv_PatchCoord *patch_coords,
+                                               const int num_patch_coords,
+                                               float *face_varying)
+{
+  StackOrHeapPatchCoordArray patch_coords_array;
+  convertPatchCoordsToArray(patch_coords, num_patch_coords, patch_map_, &patch_coords_array);
+  implementation_->evalPatchesFaceVarying(
+      face_varying_channel, patch_coords_array.data(), num_patch_coords, face_varying);
+}
+
 void EvalOutputAPI::getPatchMap(blender::gpu::VertBuf *patch_map_handles,
                                 blender::gpu::VertBuf *patch_map_quadtree,
                                 int *min_patch_face,
@@ -418,7 +425,6 @@ OpenSubdiv_Evaluator::~OpenSubdiv_Evaluator()
 {
   delete eval_output;
   delete patch_map;
-  delete patch_table;
 }
 
 OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
@@ -431,111 +437,14 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
     // Happens on bad topology.
     return nullptr;
   }
-  // TODO(sergey): Base this on actual topology.
-  const bool has_varying_data = false;
-  const int num_face_varying_channels = refiner->GetNumFVarChannels();
-  const bool has_face_varying_data = (num_face_varying_channels != 0);
-  const int level = topology_refiner->settings.level;
-  const bool is_adaptive = topology_refiner->settings.is_adaptive;
-  // Common settings for stencils and patches.
-  const bool stencil_generate_intermediate_levels = is_adaptive;
-  const bool stencil_generate_offsets = true;
-  const bool use_inf_sharp_patch = true;
-  // Refine the topology with given settings.
-  // TODO(sergey): What if topology is already refined?
-  if (is_adaptive) {
-    TopologyRefiner::AdaptiveOptions options(level);
-    options.considerFVarChannels = has_face_varying_data;
-    options.useInfSharpPatch = use_inf_sharp_patch;
-    refiner->RefineAdaptive(options);
-  }
-  else {
-    TopologyRefiner::UniformOptions options(level);
-    refiner->RefineUniform(options);
-  }
-
-  // Work around ASAN warnings, due to OpenSubdiv pretending to have an actual StencilTable
-  // instance while it's really its base class.
-  auto delete_stencil_table = [](const StencilTable *table) {
-    static_assert(std::is_base_of_v<StencilTableReal<float>, StencilTable>);
-    delete reinterpret_cast<const StencilTableReal<float> *>(table);
-  };
-
-  // Generate stencil table to update the bi-cubic patches control vertices
-  // after they have been re-posed (both for vertex & varying interpolation).
-  //
-  // Vertex stencils.
-  StencilTableFactory::Options vertex_stencil_options;
-  vertex_stencil_options.generateOffsets = stencil_generate_offsets;
-  vertex_stencil_options.generateIntermediateLevels = stencil_generate_intermediate_levels;
-  const StencilTable *vertex_stencils = StencilTableFactory::Create(*refiner,
-                                                                    vertex_stencil_options);
-  // Varying stencils.
-  //
-  // TODO(sergey): Seems currently varying stencils are always required in
-  // OpenSubdiv itself.
-  const StencilTable *varying_stencils = nullptr;
-  if (has_varying_data) {
-    StencilTableFactory::Options varying_stencil_options;
-    varying_stencil_options.generateOffsets = stencil_generate_offsets;
-    varying_stencil_options.generateIntermediateLevels = stencil_generate_intermediate_levels;
-    varying_stencil_options.interpolationMode = StencilTableFactory::INTERPOLATE_VARYING;
-    varying_stencils = StencilTableFactory::Create(*refiner, varying_stencil_options);
-  }
-  // Face warying stencil.
-  std::vector<const StencilTable *> all_face_varying_stencils;
-  all_face_varying_stencils.reserve(num_face_varying_channels);
-  for (int face_varying_channel = 0; face_varying_channel < num_face_varying_channels;
-       ++face_varying_channel)
-  {
-    StencilTableFactory::Options face_varying_stencil_options;
-    face_varying_stencil_options.generateOffsets = stencil_generate_offsets;
-    face_varying_stencil_options.generateIntermediateLevels = stencil_generate_intermediate_levels;
-    face_varying_stencil_options.interpolationMode = StencilTableFactory::INTERPOLATE_FACE_VARYING;
-    face_varying_stencil_options.fvarChannel = face_varying_channel;
-    all_face_varying_stencils.push_back(
-        StencilTableFactory::Create(*refiner, face_varying_stencil_options));
-  }
-  // Generate bi-cubic patch table for the limit surface.
-  PatchTableFactory::Options patch_options(level);
-  patch_options.SetEndCapType(PatchTableFactory::Options::ENDCAP_GREGORY_BASIS);
-  patch_options.useInfSharpPatch = use_inf_sharp_patch;
-  patch_options.generateFVarTables = has_face_varying_data;
-  patch_options.generateFVarLegacyLinearPatches = false;
-  const PatchTable *patch_table = PatchTableFactory::Create(*refiner, patch_options);
-  // Append local points stencils.
-  // Point stencils.
-  const StencilTable *local_point_stencil_table = patch_table->GetLocalPointStencilTable();
-  if (local_point_stencil_table != nullptr) {
-    const StencilTable *table = StencilTableFactory::AppendLocalPointStencilTable(
-        *refiner, vertex_stencils, local_point_stencil_table);
-    delete_stencil_table(vertex_stencils);
-    vertex_stencils = table;
-  }
-  // Varying stencils.
-  if (has_varying_data) {
-    const StencilTable *local_point_varying_stencil_table =
-        patch_table->GetLocalPointVaryingStencilTable();
-    if (local_point_varying_stencil_table != nullptr) {
-      const StencilTable *table = StencilTableFactory::AppendLocalPointStencilTable(
-          *refiner, varying_stencils, local_point_varying_stencil_table);
-      delete_stencil_table(varying_stencils);
-      varying_stencils = table;
-    }
-  }
-  for (int face_varying_channel = 0; face_varying_channel < num_face_varying_channels;
-       ++face_varying_channel)
-  {
-    const StencilTable *table = StencilTableFactory::AppendLocalPointStencilTableFaceVarying(
-        *refiner,
-        all_face_varying_stencils[face_varying_channel],
-        patch_table->GetLocalPointFaceVaryingStencilTable(face_varying_channel),
-        face_varying_channel);
-    if (table != nullptr) {
-      delete_stencil_table(all_face_varying_stencils[face_varying_channel]);
-      all_face_varying_stencils[face_varying_channel] = table;
-    }
-  }
+  // The tables are shared with other evaluators created from the same topology refiner.
+  const blender::opensubdiv::TopologyRefinerImpl::EvaluatorTables &tables =
+      topology_refiner->evaluator_tables();
+  const StencilTable *vertex_stencils = tables.vertex_stencils;
+  const StencilTable *varying_stencils = tables.varying_stencils;
+  const std::vector<const StencilTable *> &all_face_varying_stencils =
+      tables.face_varying_stencils;
+  const PatchTable *patch_table = tables.patch_table;
   // Create OpenSubdiv's CPU side evaluator.
   blender::opensubdiv::EvalOutputAPI::EvalOutput *eval_output = nullptr;
 
@@ -567,12 +476,6 @@ OpenSubdiv_Evaluator *openSubdiv_createEvaluatorFromTopologyRefiner(
   evaluator->eval_output = new blender::opensubdiv::EvalOutputAPI(eval_output, patch_map);
   evaluator->patch_map = patch_map;
   evaluator->patch_table = patch_table;
-  // TODO(sergey): Look into whether we've got duplicated stencils arrays.
-  delete_stencil_table(vertex_stencils);
-  delete_stencil_table(varying_stencils);
-  for (const StencilTable *table : all_face_varying_stencils) {
-    delete_stencil_table(table);
-  }
 
   return evaluator;
 }
@@ -6,13 +6,153 @@
 
 #include "opensubdiv_topology_refiner.hh"
 
+#include <type_traits>
+
+#include <opensubdiv/far/patchTableFactory.h>
+#include <opensubdiv/far/stencilTableFactory.h>
+
+using OpenSubdiv::Far::PatchTable;
+using OpenSubdiv::Far::PatchTableFactory;
+using OpenSubdiv::Far::StencilTable;
+using OpenSubdiv::Far::StencilTableFactory;
+using OpenSubdiv::Far::StencilTableReal;
+using OpenSubdiv::Far::TopologyRefiner;
+
 namespace blender::opensubdiv {
 
+// Work around ASAN warnings, due to OpenSubdiv pretending to have an actual StencilTable
+// instance while it's really its base class.
+static void delete_stencil_table(const StencilTable *table)
+{
+  static_assert(std::is_base_of_v<StencilTableReal<float>, StencilTable>);
+  delete reinterpret_cast<const StencilTableReal<float> *>(table);
+}
+
 TopologyRefinerImpl::TopologyRefinerImpl() : topology_refiner(nullptr) {}
 
 TopologyRefinerImpl::~TopologyRefinerImpl()
 {
+  delete_stencil_table(evaluator_tables_.vertex_stencils);
+  delete_stencil_table(evaluator_tables_.varying_stencils);
+  for (const StencilTable *table : evaluator_tables_.face_varying_stencils) {
+    delete_stencil_table(table);
+  }
+  delete evaluator_tables_.patch_table;
   delete topology_refiner;
 }
 
+const TopologyRefinerImpl::EvaluatorTables &TopologyRefinerImpl::evaluator_tables()
+{
+  std::call_once(evaluator_tables_once_, [this]() { createEvaluatorTables(); });
+  return evaluator_tables_;
+}
+
+void TopologyRefinerImpl::createEvaluatorTables()
+{
+  TopologyRefiner *refiner = topology_refiner;
+  // TODO(sergey): Base this on actual topology.
+  const bool has_varying_data = false;
+  const int num_face_varying_channels = refiner->GetNumFVarChannels();
+  const bool has_face_varying_data = (num_face_varying_channels != 0);
+  const int level = settings.level;
+  const bool is_adaptive = settings.is_adaptive;
+  // Common settings for stencils and patches.
+  const bool stencil_generate_intermediate_levels = is_adaptive;
+  const bool stencil_generate_offsets = true;
+  const bool use_inf_sharp_patch = true;
+  // Refine the topology with given settings. This only happens once, since the tables are
+  // created only once.
+  if (is_adaptive) {
+    TopologyRefiner::AdaptiveOptions options(level);
+    options.considerFVarChannels = has_face_varying_data;
+    options.useInfSharpPatch = use_inf_sharp_patch;
+    refiner->RefineAdaptive(options);
+  }
+  else {
+    TopologyRefiner::UniformOptions options(level);
+    refiner->RefineUniform(options);
+  }
+
+  // Generate stencil table to update the bi-cubic patches control vertices
+  // after they have been re-posed (both for vertex & varying interpolation).
+  //
+  // Vertex stencils.
+  StencilTableFactory::Options vertex_stencil_options;
+  vertex_stencil_options.generateOffsets = stencil_generate_offsets;
+  vertex_stencil_options.generateIntermediateLevels = stencil_generate_intermediate_levels;
+  const StencilTable *vertex_stencils = StencilTableFactory::Create(*refiner,
+                                                                    vertex_stencil_options);
+  // Varying stencils.
+  //
+  // TODO(sergey): Seems currently varying stencils are always required in
+  // OpenSubdiv itself.
+  const StencilTable *varying_stencils = nullptr;
+  if (has_varying_data) {
+    StencilTableFactory::Options varying_stencil_options;
+    varying_stencil_options.generateOffsets = stencil_generate_offsets;
+    varying_stencil_options.generateIntermediateLevels = stencil_generate_intermediate_levels;
+    varying_stencil_options.interpolationMode = StencilTableFactory::INTERPOLATE_VARYING;
+    varying_stencils = StencilTableFactory::Create(*refiner, varying_stencil_options);
+  }
+  // Face warying stencil.
+  std::vector<const StencilTable *> all_face_varying_stencils;
+  all_face_varying_stencils.reserve(num_face_varying_channels);
+  for (int face_varying_channel = 0; face_varying_channel < num_face_varying_channels;
+       ++face_varying_channel)
+  {
+    StencilTableFactory::Options face_varying_stencil_options;
+    face_varying_stencil_options.generateOffsets = stencil_generate_offsets;
+    face_varying_stencil_options.generateIntermediateLevels = stencil_generate_intermediate_levels;
+    face_varying_stencil_options.interpolationMode = StencilTableFactory::INTERPOLATE_FACE_VARYING;
+    face_varying_stencil_options.fvarChannel = face_varying_channel;
+    all_face_varying_stencils.push_back(
+        StencilTableFactory::Create(*refiner, face_varying_stencil_options));
+  }
+  // Generate bi-cubic patch table for the limit surface.
+  PatchTableFactory::Options patch_options(level);
+  patch_options.SetEndCapType(PatchTableFactory::Options::ENDCAP_GREGORY_BASIS);
+  patch_options.useInfSharpPatch = use_inf_sharp_patch;
+  patch_options.generateFVarTables = has_face_varying_data;
+  patch_options.generateFVarLegacyLinearPatches = false;
+  const PatchTable *patch_table = PatchTableFactory::Create(*refiner, patch_options);
+  // Append local points stencils.
+  // Point stencils.
+  const StencilTable *local_point_stencil_table = patch_table->GetLocalPointStencilTable();
+  if (local_point_stencil_table != nullptr) {
+    const StencilTable *table = StencilTableFactory::AppendLocalPointStencilTable(
+        *refiner, vertex_stencils, local_point_stencil_table);
+    delete_stencil_table(vertex_stencils);
+    vertex_stencils = table;
+  }
+  // Varying stencils.
+  if (has_varying_data) {
+    const StencilTable *local_point_varying_stencil_table =
+        patch_table->GetLocalPointVaryingStencilTable();
+    if (local_point_varying_stencil_table != nullptr) {
+      const StencilTable *table = StencilTableFactory::AppendLocalPointStencilTable(
+          *refiner, varying_stencils, local_point_varying_stencil_table);
+      delete_stencil_table(varying_stencils);
+      varying_stencils = table;
+    }
+  }
+  for (int face_varying_channel = 0; face_varying_channel < num_face_varying_channels;
+       ++face_varying_channel)
+  {
+    const StencilTable *table = StencilTableFactory::AppendLocalPointStencilTableFaceVarying(
+        *refiner,
+        all_face_varying_stencils[face_varying_channel],
+        patch_table->GetLocalPointFaceVaryingStencilTable(face_varying_channel),
+        face_varying_channel);
+    if (table != nullptr) {
+      delete_stencil_table(all_face_varying_stencils[face_varying_channel]);
+      all_face_varying_stencils[face_varying_channel] = table;
+    }
+  }
+
+  evaluator_tables_.vertex_stencils = vertex_stencils;
+  evaluator_tables_.varying_stencils = varying_stencils;
+  evaluator_tables_.face_varying_stencils = std::move(all_face_varying_stencils);
+  evaluator_tables_.patch_table = patch_table;
+}
+
 }  // namespace blender::opensubdiv
@@ -130,6 +130,14 @@ class EvalOutputAPI {
                             float *dPdu,
                             float *dPdv);
 
+  // Evaluate face-varying data at the given coordinates.
+  //
+  // NOTE: Output array must point to a memory of size float[2]*num_patch_coords.
+  void evaluatePatchesFaceVarying(const int face_varying_channel,
+                                  const OpenSubdiv_PatchCoord *patch_coords,
+                                  const int num_patch_coords,
+                                  float *face_varying);
+
   // Fill the output buffers and variables with data from the PatchMap.
   void getPatchMap(blender::gpu::VertBuf *patch_map_handles,
                    blender::gpu::VertBuf *patch_map_quadtree,
@@ -183,6 +191,8 @@ class EvalOutputAPI {
 struct OpenSubdiv_Evaluator {
   blender::opensubdiv::EvalOutputAPI *eval_output;
   const blender::opensubdiv::PatchMap *patch_map;
+  // NOTE: Owned by the topology refiner the evaluator is created from, which must outlive the
+  // evaluator.
   const OpenSubdiv::Far::PatchTable *patch_table;
 
   eOpenSubdivEvaluator type;
@@ -11,6 +11,11 @@
 #  include <iso646.h>
 #endif
 
+#include <mutex>
+#include <vector>
+
+#include <opensubdiv/far/patchTable.h>
+#include <opensubdiv/far/stencilTable.h>
 #include <opensubdiv/far/topologyRefiner.h>
 
 #include "internal/topology/mesh_topology.h"
@@ -49,6 +54,21 @@ class TopologyRefinerImpl {
   // Covers options, geometry, and geometry tags.
   bool isEqualToConverter(const OpenSubdiv_Converter *converter) const;
 
+  // Stencil and patch tables needed to create an evaluator for this topology.
+  struct EvaluatorTables {
+    const OpenSubdiv::Far::StencilTable *vertex_stencils = nullptr;
+    const OpenSubdiv::Far::StencilTable *varying_stencils = nullptr;
+    std::vector<const OpenSubdiv::Far::StencilTable *> face_varying_stencils;
+    const OpenSubdiv::Far::PatchTable *patch_table = nullptr;
+  };
+
+  // Refine the topology and create the evaluator tables on first call, they are shared by all
+  // evaluators created from this refiner afterwards. The refiner is not modified anymore once
+  // the tables exist, so the refiner can be used from multiple threads then.
+  //
+  // Safe to call from multiple threads.
+  const EvaluatorTables &evaluator_tables();
+
   OpenSubdiv::Far::TopologyRefiner *topology_refiner;
 
   // Subdivision settingsa this refiner is created for.
@@ -70,6 +90,12 @@ class TopologyRefinerImpl {
   //    corner vertices.
   MeshTopology base_mesh_topology;
 
+ private:
+  void createEvaluatorTables();
+
+  EvaluatorTables evaluator_tables_;
+  std::once_flag evaluator_tables_once_;
+
   MEM_CXX_CLASS_ALLOC_FUNCS("TopologyRefinerImpl");
 };
 
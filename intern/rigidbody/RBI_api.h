@@ -231,6 +231,15 @@ rbCollisionShape *RB_shape_new_trimesh(rbMeshData *mesh);
 /* 2b - GImpact Meshes */
 rbCollisionShape *RB_shape_new_gimpact_mesh(rbMeshData *mesh);
 
+/* Shape Instances ---------------- */
+
+/**
+ * Create a new shape with the same geometry as \a shape that can be scaled independently.
+ * Convex hulls reuse the computed hull points and triangle meshes share their BVH and triangle
+ * data. Returns null for shape types that can't be instanced.
+ */
+rbCollisionShape *RB_shape_new_instance(rbCollisionShape *shape);
+
 /* Compound Shape ---------------- */
 
 rbCollisionShape *RB_shape_new_compound(void);
@@ -78,6 +78,8 @@ struct rbMeshData {
   rbTri *triangles;
   int num_vertices;
   int num_triangles;
+  /* Number of shapes referencing this data, see #RB_shape_new_instance(). */
+  int users;
 };
 
 struct rbCollisionShape {
@@ -741,6 +743,7 @@ rbMeshData *RB_trimesh_data_new(int num_tris, int num_verts)
   mesh->triangles = new rbTri[num_tris];
   mesh->num_vertices = num_verts;
   mesh->num_triangles = num_tris;
+  mesh->users = 1;
 
   return mesh;
 }
@@ -838,6 +841,42 @@ rbCollisionShape *RB_shape_new_gimpact_mesh(rbMeshData *mesh)
   return shape;
 }
 
+/* Shape Instances ---------------- */
+
+rbCollisionShape *RB_shape_new_instance(rbCollisionShape *shape)
+{
+  rbCollisionShape *instance = nullptr;
+
+  switch (shape->cshape->getShapeType()) {
+    case CONVEX_HULL_SHAPE_PROXYTYPE: {
+      /* Copy the already computed hull points, the hull itself is not computed again. */
+      btConvexHullShape *hull_shape = (btConvexHullShape *)shape->cshape;
+      instance = new rbCollisionShape;
+      instance->cshape = new btConvexHullShape(&(hull_shape->getUnscaledPoints()[0].getX()),
+                                               hull_shape->getNumPoints());
+      instance->mesh = nullptr;
+      break;
+    }
+    case SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE: {
+      /* Share the BVH and triangle data, only the scaling wrapper is owned by the instance. */
+      btScaledBvhTriangleMeshShape *scaled_shape = (btScaledBvhTriangleMeshShape *)shape->cshape;
+      instance = new rbCollisionShape;
+      instance->cshape = new btScaledBvhTriangleMeshShape(scaled_shape->getChildShape(),
+                                                          btVector3(1.0f, 1.0f, 1.0f));
+      instance->mesh = shape->mesh;
+      instance->mesh->users++;
+      break;
+    }
+    default:
+      return nullptr;
+  }
+
+  instance->cshape->setMargin(shape->cshape->getMargin());
+  instance->compoundChilds = 0;
+  instance->compoundChildShapes = nullptr;
+  return instance;
+}
+
 /* Compound Shape ---------------- */
 
 rbCollisionShape *RB_shape_new_compound()
@@ -877,13 +916,16 @@ void RB_compound_add_child_shape(rbCollisionShape *parentShape,
 
 void RB_shape_delete(rbCollisionShape *shape)
 {
-  if (shape->cshape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
+  /* Mesh data (and the BVH built from it) may be shared with instances of this shape. */
+  const bool is_last_user = (shape->mesh == nullptr) || (--shape->mesh->users == 0);
+
+  if (is_last_user && shape->cshape->getShapeType() == SCALED_TRIANGLE_MESH_SHAPE_PROXYTYPE) {
     btBvhTriangleMeshShape *child_shape =
         ((btScaledBvhTriangleMeshShape *)shape->cshape)->getChildShape();
 
     delete child_shape;
   }
-  if (shape->mesh) {
+  if (shape->mesh && is_last_user) {
     RB_trimesh_data_delete(shape->mesh);
   }
   delete shape->cshape;
@@ -45,12 +45,16 @@ def _initialize_once():
 
     _initialize_extensions_repos_once()
 
+    from time import perf_counter
     for addon in _preferences.addons:
+        t = perf_counter()
         enable(
             addon.module,
             # Ensured by `_initialize_extensions_repos_once`.
             refresh_handled=True,
         )
+        # Import and register aren't measured separately for add-ons.
+        _bpy.utils._startup_timing_add(addon.module, perf_counter() - t, 0.0)
 
     _initialize_ensure_extensions_addon()
 
@@ -22,6 +22,7 @@ __all__ = (
     "app_template_paths",
     "register_class",
     "register_cli_command",
+    "register_deferred_ui_classes",
     "time_from_frame",
     "unregister_cli_command",
     "register_manual_map",
@@ -57,6 +58,8 @@ from _bpy import (
     unescape_identifier,
     register_class,
     register_cli_command,
+    register_deferred_ui_classes,
+    _register_class_ui_defer_set,
     resource_path,
     script_paths as _bpy_script_paths,
     unregister_class,
@@ -125,6 +128,25 @@ def execfile(filepath, *, mod=None):
     return mod
 
 
+# Time spent loading each module while Blender starts, reported with `--debug-python`.
+# `[(module_name, import_time, register_time), ...]`, where add-ons are imported and registered at once.
+_startup_timing = []
+
+
+def _startup_timing_add(module_name, time_import, time_register):
+    _startup_timing.append((module_name, time_import, time_register))
+
+
+def _startup_timing_report():
+    print("Python startup time per module (import, register, total):")
+    for module_name, time_import, time_register in sorted(
+            _startup_timing, key=lambda item: item[1] + item[2], reverse=True,
+    ):
+        print("  {:<40s} {:.4f} {:.4f} {:.4f}".format(
+            module_name, time_import, time_register, time_import + time_register,
+        ))
+
+
 def _test_import(module_name, loaded_modules):
     use_time = _bpy.app.debug_python
 
@@ -134,9 +156,8 @@ def _test_import(module_name, loaded_modules):
         print("Ignoring '{:s}', can't import files containing multiple periods".format(module_name))
         return None
 
-    if use_time:
-        import time
-        t = time.time()
+    import time
+    t = time.perf_counter()
 
     try:
         mod = __import__(module_name)
@@ -145,8 +166,9 @@ def _test_import(module_name, loaded_modules):
         traceback.print_exc()
         return None
 
+    mod.__time_import__ = time.perf_counter() - t
     if use_time:
-        print("time {:s} {:.4f}".format(module_name, time.time() - t))
+        print("time {:s} {:.4f}".format(module_name, mod.__time_import__))
 
     loaded_modules.add(mod.__name__)  # should match mod.__name__ too
     return mod
@@ -243,10 +265,13 @@ def load_scripts(*, reload_scripts=False, refresh_scripts=False, extensions=True
     """
     use_time = use_class_register_check = _bpy.app.debug_python
     use_user = not _is_factory_startup
+    # Panels, menus etc. are only needed in the background when scripts access them,
+    # defer their registration until they're looked up in `bpy.types`.
+    use_ui_defer = _bpy.app.background and not reload_scripts
 
-    if use_time:
-        import time
-        t_main = time.time()
+    import time
+    t_main = time.perf_counter()
+    _startup_timing.clear()
 
     loaded_modules = set()
 
@@ -285,8 +310,10 @@ def load_scripts(*, reload_scripts=False, refresh_scripts=False, extensions=True
             mod = test_reload(mod)
 
         if mod:
+            t = time.perf_counter()
             _register_module_call(mod)
             _registered_module_names.append(mod.__name__)
+            _startup_timing_add(mod.__name__, getattr(mod, "__time_import__", 0.0), time.perf_counter() - t)
 
     if reload_scripts:
         # Module names -> modules.
@@ -323,6 +350,9 @@ def load_scripts(*, reload_scripts=False, refresh_scripts=False, extensions=True
 
     from bpy_restrict_state import RestrictBlend
 
+    if use_ui_defer:
+        _register_class_ui_defer_set(True)
+
     with RestrictBlend():
         for base_path in script_paths(use_user=use_user):
             for path_subdir in _script_module_dirs:
@@ -343,6 +373,9 @@ def load_scripts(*, reload_scripts=False, refresh_scripts=False, extensions=True
     if extensions:
         load_scripts_extensions(reload_scripts=reload_scripts)
 
+    if use_ui_defer:
+        _register_class_ui_defer_set(False)
+
     if reload_scripts:
         _bpy.context.window_manager.tag_script_reload()
 
@@ -350,9 +383,12 @@ def load_scripts(*, reload_scripts=False, refresh_scripts=False, extensions=True
         print("gc.collect() -> {:d}".format(gc.collect()))
 
     if use_time:
-        print("Python Script Load Time {:.4f}".format(time.time() - t_main))
+        _startup_timing_report()
+        print("Python Script Load Time {:.4f}".format(time.perf_counter() - t_main))
 
     if use_class_register_check:
+        # Deferred classes would be reported as unregistered.
+        register_deferred_ui_classes()
         for cls in _bpy.types.bpy_struct.__subclasses__():
             if getattr(cls, "is_registered", False):
                 for subcls in cls.__subclasses__():
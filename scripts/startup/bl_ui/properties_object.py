@@ -221,6 +221,8 @@ class OBJECT_PT_display(ObjectButtonsPanel, Panel):
         if is_geometry:
             col.prop(obj, "show_texture_space", text="Texture Space")
             col.prop(obj.display, "show_shadows", text="Shadow")
+        if obj_type == 'MESH' or is_dupli:
+            col.prop(obj.display, "use_level_of_detail", text="Level of Detail")
         col.prop(obj, "show_in_front", text="In Front")
         # if obj_type == 'MESH' or is_empty_image:
         #    col.prop(obj, "show_transparent", text="Transparency")
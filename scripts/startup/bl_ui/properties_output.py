@@ -318,6 +318,11 @@ class RENDER_PT_output(RenderOutputButtonsPanel, Panel):
             col = layout.column(heading="Image Sequence")
             col.prop(rd, "use_overwrite")
             col.prop(rd, "use_placeholder")
+            col.prop(rd, "use_background_write")
+            sub = col.column()
+            sub.active = rd.use_background_write
+            sub.prop(rd, "background_write_frames")
+            sub.prop(rd, "background_write_memory")
 
 
 class RENDER_PT_output_views(RenderOutputButtonsPanel, Panel):
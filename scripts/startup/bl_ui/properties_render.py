@@ -620,6 +620,7 @@ class RENDER_PT_eevee_next_sampling_viewport(RenderButtonsPanel, Panel):
         col.prop(props, "taa_samples", text="Samples")
         col.prop(props, "use_taa_reprojection", text="Temporal Reprojection")
         col.prop(props, "use_shadow_jitter_viewport", text="Jittered Shadows")
+        col.prop(props, "use_adaptive_resolution")
 
         # Add SSS sample count here.
 
@@ -1034,6 +1035,9 @@ class RENDER_PT_simplify_viewport(RenderButtonsPanel, Panel):
         col = flow.column()
         col.prop(rd, "use_simplify_normals", text="Normals")
 
+        col = flow.column()
+        col.prop(rd, "use_simplify_hidden_objects", text="Hidden Objects")
+
 
 class RENDER_PT_simplify_render(RenderButtonsPanel, Panel):
     bl_label = "Render"
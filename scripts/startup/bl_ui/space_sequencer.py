@@ -2542,6 +2542,9 @@ class SEQUENCER_PT_cache_settings(SequencerButtonsPanel, Panel):
 
         col.prop(ed, "use_cache_raw", text="Raw")
         col.prop(ed, "use_cache_final", text="Final")
+        sub = col.column()
+        sub.active = ed.use_cache_final
+        sub.prop(ed, "use_cache_final_compression", text="Compress Final")
 
 
 class SEQUENCER_PT_cache_view_settings(SequencerButtonsPanel, Panel):
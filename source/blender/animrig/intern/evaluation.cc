@@ -7,7 +7,9 @@
 #include "BKE_animsys.h"
 #include "BKE_fcurve.hh"
 
+#include "BLI_array.hh"
 #include "BLI_map.hh"
+#include "BLI_task.hh"
 
 #include "CLG_log.h"
 
@@ -150,31 +152,45 @@ static EvaluationResult evaluate_keyframe_data(PointerRNA &animated_id_ptr,
     return {};
   }
 
-  EvaluationResult evaluation_result;
-  for (FCurve *fcu : channelbag_for_slot->fcurves()) {
-    /* Blatant copy of animsys_evaluate_fcurves(). */
-
-    if (!is_fcurve_evaluatable(fcu)) {
-      continue;
+  /* Resolve and evaluate the F-Curves in parallel, as rigs can have many thousands of them. Every
+   * F-Curve is evaluated independently, only storing the results has to happen in order. */
+  const Span<FCurve *> fcurves = channelbag_for_slot->fcurves();
+  Array<std::optional<AnimatedProperty>> fcurve_results(fcurves.size());
+  threading::parallel_for(fcurves.index_range(), 256, [&](const IndexRange range) {
+    for (const int i : range) {
+      FCurve *fcu = fcurves[i];
+      /* Blatant copy of animsys_evaluate_fcurves(). */
+
+      if (!is_fcurve_evaluatable(fcu)) {
+        continue;
+      }
+
+      PathResolvedRNA anim_rna;
+      if (!BKE_animsys_rna_path_resolve(
+              &animated_id_ptr, fcu->rna_path, fcu->array_index, &anim_rna))
+      {
+        /* Log this at quite a high level, because it can get _very_ noisy when playing back
+         * animation. */
+        CLOG_INFO(&LOG,
+                  4,
+                  "Cannot resolve RNA path %s[%d] on ID %s\n",
+                  fcu->rna_path,
+                  fcu->array_index,
+                  animated_id_ptr.owner_id->name);
+        continue;
+      }
+
+      const float curval = calculate_fcurve(&anim_rna, fcu, &offset_eval_context);
+      fcurve_results[i].emplace(curval, anim_rna);
     }
+  });
 
-    PathResolvedRNA anim_rna;
-    if (!BKE_animsys_rna_path_resolve(
-            &animated_id_ptr, fcu->rna_path, fcu->array_index, &anim_rna))
-    {
-      /* Log this at quite a high level, because it can get _very_ noisy when playing back
-       * animation. */
-      CLOG_INFO(&LOG,
-                4,
-                "Cannot resolve RNA path %s[%d] on ID %s\n",
-                fcu->rna_path,
-                fcu->array_index,
-                animated_id_ptr.owner_id->name);
-      continue;
+  EvaluationResult evaluation_result;
+  for (const int i : fcurves.index_range()) {
+    if (const std::optional<AnimatedProperty> &result = fcurve_results[i]) {
+      evaluation_result.store(
+          fcurves[i]->rna_path, fcurves[i]->array_index, result->value, result->prop_rna);
     }
-
-    const float curval = calculate_fcurve(&anim_rna, fcu, &offset_eval_context);
-    evaluation_result.store(fcu->rna_path, fcu->array_index, curval, anim_rna);
   }
 
   return evaluation_result;
@@ -67,8 +67,8 @@ struct NodeBakeCache {
 
   /** Loads blob data from memory when the bake is packed. */
   std::unique_ptr<MemoryBlobReader> memory_blob_reader;
-  /** Where to load blobs from disk when loading the baked data lazily from disk. */
-  std::optional<std::string> blobs_dir;
+  /** Loads blobs from disk when loading the baked data lazily from disk. */
+  std::unique_ptr<DiskBlobReader> disk_blob_reader;
 
   /** Used to avoid reading blobs multiple times for different frames. */
   std::unique_ptr<BlobReadSharing> blob_sharing;
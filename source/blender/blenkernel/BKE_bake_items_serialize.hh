@@ -10,6 +10,7 @@
 
 #include "BLI_fileops.hh"
 #include "BLI_function_ref.hh"
+#include "BLI_implicit_sharing_ptr.hh"
 #include "BLI_mutex.hh"
 #include "BLI_serialize.hh"
 
@@ -48,6 +49,15 @@ class BlobReader {
    */
   [[nodiscard]] virtual bool read_as_stream(const BlobSlice &slice,
                                             FunctionRef<bool(std::istream &)> fn) const;
+
+  /**
+   * Get shared access to the data of the slice without copying it, which is possible when the
+   * reader has the data in memory already (e.g. in a memory-mapped file). The data can be modified
+   * when the returned sharing info is mutable.
+   * \return Nothing if the data has to be copied with #read instead.
+   */
+  [[nodiscard]] virtual std::optional<ImplicitSharingInfoAndData> read_mapped(
+      const BlobSlice &slice, int64_t alignment) const;
 };
 
 /**
@@ -161,18 +171,36 @@ class BlobReadSharing : NonCopyable, NonMovable {
       FunctionRef<std::optional<ImplicitSharingInfoAndData>()> read_fn) const;
 };
 
+class MappedBlobFile;
+
 /**
- * A specific #BlobReader that reads from disk.
+ * A specific #BlobReader that reads from disk. Blob files are memory-mapped when possible, so that
+ * arrays can be used without copying them, and are only read from disk when they are accessed.
  */
 class DiskBlobReader : public BlobReader {
  private:
   const std::string blobs_dir_;
   mutable Mutex mutex_;
   mutable Map<std::string, std::unique_ptr<fstream>> open_input_streams_;
+  /** Null when mapping the file failed, it's read with #open_input_streams_ then. */
+  mutable Map<std::string, ImplicitSharingPtr<MappedBlobFile>> mapped_files_;
 
  public:
   DiskBlobReader(std::string blobs_dir);
+  ~DiskBlobReader();
+
   [[nodiscard]] bool read(const BlobSlice &slice, void *r_data) const override;
+  [[nodiscard]] std::optional<ImplicitSharingInfoAndData> read_mapped(
+      const BlobSlice &slice, int64_t alignment) const override;
+
+  /**
+   * Tell the OS that the given blob file is going to be read soon, so that it's loaded in the
+   * background. Used to load the next frames during playback.
+   */
+  void prefetch(StringRef blob_name) const;
+
+ private:
+  const MappedBlobFile *get_mapped_file(StringRef blob_name) const;
 };
 
 /**
@@ -27,6 +27,7 @@
 
 struct BlendDataReader;
 struct BlendWriter;
+struct KDTree_3d;
 struct MDeformVert;
 namespace blender::bke {
 class AttributeAccessor;
@@ -132,6 +133,13 @@ class CurvesGeometryRuntime {
    */
   mutable SharedCache<Vector<int>> custom_knot_offsets_cache;
 
+  /**
+   * KD-tree of the first point of every curve, used by curves sculpt mode brushes. Stored as a
+   * shared pointer so that a brush can keep using the tree of the curves at the start of its
+   * stroke while it adds new curves.
+   */
+  mutable SharedCache<std::shared_ptr<KDTree_3d>> root_positions_kdtree_cache;
+
   /** Stores weak references to material data blocks. */
   std::unique_ptr<bake::BakeMaterialsList> bake_materials;
 
@@ -438,7 +446,11 @@ class CurvesGeometry : public ::CurvesGeometry {
    */
   void resize(int points_num, int curves_num);
 
-  /** Call after deforming the position attribute. */
+  /**
+   * Call after deforming the position attribute. Caches that only depend on the topology, like
+   * the evaluated offsets and the NURBS basis, are kept (and stay shared with copies), only the
+   * evaluated positions, tangents, normals, lengths and bounds are recomputed.
+   */
   void tag_positions_changed();
   /**
    * Call after any operation that changes the topology
@@ -13,6 +13,7 @@
 
 #include "BLI_implicit_sharing.h"
 #include "BLI_memory_counter_fwd.hh"
+#include "BLI_offset_indices.hh"
 #include "BLI_span.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_sys_types.h"
@@ -433,6 +434,22 @@ void CustomData_interp(const CustomData *source,
                        const float *sub_weights,
                        int count,
                        int dest_index);
+/**
+ * Interpolate many destination items at once, which is faster than calling #CustomData_interp
+ * for each of them. Common attribute types are interpolated without going through the generic
+ * per-item callbacks.
+ *
+ * \param src_offsets: For every destination item, the range of its sources in \a src_indices
+ * and \a weights.
+ * \param weights: The weight of each source, or empty to use the average of the sources.
+ * \param dest_indices: Index of every destination item.
+ */
+void CustomData_interp_grouped(const CustomData *source,
+                               CustomData *dest,
+                               blender::OffsetIndices<int> src_offsets,
+                               blender::Span<int> src_indices,
+                               blender::Span<float> weights,
+                               blender::Span<int> dest_indices);
 /**
  * \note src_blocks_ofs & dst_block_ofs
  * must be pointers to the data, offset by layer->offset already.
@@ -223,6 +223,13 @@ void BKE_fcurve_free(FCurve *fcu);
  * Duplicate a F-Curve.
  */
 FCurve *BKE_fcurve_copy(const FCurve *fcu);
+/**
+ * Make the keyframes of an evaluated copy of an F-Curve shared with the other evaluated copies of
+ * the same original F-Curve, as long as the keyframes of the original didn't change. This avoids
+ * keeping a copy of all keyframes for every depsgraph. The keyframes of the evaluated F-Curve
+ * must not be modified afterwards.
+ */
+void BKE_fcurve_share_keyframes_for_eval(FCurve &fcu_eval, FCurve &fcu_orig);
 /**
  * Frees a list of F-Curves.
  */
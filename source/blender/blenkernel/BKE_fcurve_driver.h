@@ -82,6 +82,25 @@ bool driver_get_target_property(const DriverTargetContext *driver_target_context
                                 struct DriverTarget *dtar,
                                 struct PointerRNA *r_prop);
 
+/**
+ * Resolve an attribute access on a driver variable, like `var.location[0]` in a simple expression,
+ * relative to the target property of the variable (see #driver_get_target_property).
+ *
+ * As in Python, attributes can only be accessed on Single Property and Context Property variables
+ * which resolve to a data-block or a struct. Vector components accessed by name (like `.x`) are
+ * resolved to array indices. Only attributes that resolve to a single number are supported.
+ *
+ * \param r_rna_path: Optionally receives the resolved path relative to `target_ptr`,
+ * to be freed with #MEM_freeN.
+ */
+bool driver_resolve_variable_attribute(struct PointerRNA *target_ptr,
+                                       const struct DriverVar *dvar,
+                                       const char *attribute_path,
+                                       struct PointerRNA *r_ptr,
+                                       struct PropertyRNA **r_prop,
+                                       int *r_index,
+                                       char **r_rna_path);
+
 /**
  * Copy driver variables from src_vars list to dst_vars list.
  */
@@ -164,6 +183,14 @@ bool BKE_driver_has_simple_expression(struct ChannelDriver *driver);
  * Check if the expression in the driver may depend on the current frame.
  */
 bool BKE_driver_expression_depends_on_time(struct ChannelDriver *driver);
+/**
+ * Call the function for every attribute access on a variable in the simple expression of the
+ * driver, like `var.location[0]`. Does nothing when the expression is not simple.
+ */
+void BKE_driver_simple_expression_foreach_attribute(
+    struct ChannelDriver *driver,
+    void (*callback)(struct DriverVar *dvar, const char *attribute_path, void *user_data),
+    void *user_data);
 /**
  * Reset cached compiled expression data.
  */
@@ -186,6 +186,19 @@ struct Global {
    */
   char gpu_debug_scope_name[200];
 
+  /**
+   * When set, a JSON report of where time and memory is spent when reading blend files is
+   * written to this file path. Set using `--profile-blend-read <filepath>`.
+   */
+  char blend_read_profile_filepath[/*FILE_MAX*/ 1024];
+
+  /**
+   * When set, a JSON report of the evaluation time and memory usage of every compositor node is
+   * written to this file path after each compositor evaluation that is profiled. Set using
+   * `--profile-compositor <filepath>`.
+   */
+  char compositor_profile_filepath[/*FILE_MAX*/ 1024];
+
   bool profile_gpu;
 };
 
@@ -339,6 +352,15 @@ enum {
    * #BKE_asset_edit.hh). Stored with a .asset.blend prefix.
    */
   G_FILE_ASSET_EDIT_FILE = (1 << 29),
+  /**
+   * Implicitly shared data (see #BLO_write_shared) is only written once per file instead of once
+   * per ID, data-blocks of other IDs then reference it. Blender versions that don't handle this
+   * lose that data on read, so this is only used for files read back by the same Blender build,
+   * like auto-save files.
+   *
+   * Passed as write flag and stored in the file, but never set in #G.fileflags.
+   */
+  G_FILE_CROSS_ID_SHARED_DATA = (1 << 30),
 };
 
 /**
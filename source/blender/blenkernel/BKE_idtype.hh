@@ -67,6 +67,12 @@ enum {
    * IDs have at least an 'extra user' (#ID_TAG_EXTRAUSER).
    */
   IDTYPE_FLAGS_NEVER_UNUSED = 1 << 6,
+  /**
+   * Indicates that #IDTypeInfo.blend_write of the given IDType only reads and modifies data owned
+   * by the ID itself, so that several IDs of this type can be serialized on different threads
+   * when writing a blend file.
+   */
+  IDTYPE_FLAGS_THREADSAFE_BLEND_WRITE = 1 << 7,
 };
 
 struct IDCacheKey {
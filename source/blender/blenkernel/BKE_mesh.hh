@@ -47,6 +47,17 @@ void corner_tris_calc_with_normals(Span<float3> vert_positions,
                                    Span<float3> face_normals,
                                    MutableSpan<int3> corner_tris);
 
+/**
+ * Only recalculate the triangles of the selected faces, e.g. after they have been deformed.
+ * The face normals are optional.
+ */
+void corner_tris_calc(Span<float3> vert_positions,
+                      OffsetIndices<int> faces,
+                      Span<int> corner_verts,
+                      Span<float3> face_normals,
+                      const IndexMask &face_mask,
+                      MutableSpan<int3> corner_tris);
+
 void corner_tris_calc_face_indices(OffsetIndices<int> faces, MutableSpan<int> tri_faces);
 
 /**
@@ -106,6 +117,23 @@ void normals_calc_verts(Span<float3> vert_positions,
                         Span<float3> face_normals,
                         MutableSpan<float3> vert_normals);
 
+/**
+ * Versions of #normals_calc_faces and #normals_calc_verts that only write the normals of the
+ * selected elements, used to update existing normals after a partial deformation.
+ */
+void normals_calc_faces(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        const IndexMask &face_mask,
+                        MutableSpan<float3> face_normals);
+void normals_calc_verts(Span<float3> vert_positions,
+                        OffsetIndices<int> faces,
+                        Span<int> corner_verts,
+                        GroupedSpan<int> vert_to_face_map,
+                        Span<float3> face_normals,
+                        const IndexMask &vert_mask,
+                        MutableSpan<float3> vert_normals);
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -97,6 +97,15 @@ struct LooseEdgeCache : public LooseGeomCache {};
  */
 struct LooseVertCache : public LooseGeomCache {};
 
+/**
+ * Offsets and indices of a topology map that groups elements of one domain by the elements of
+ * another domain they are connected to, see #GroupedSpan.
+ */
+struct GroupedIndicesCache {
+  Array<int> offsets;
+  Array<int> indices;
+};
+
 /** Similar to #VArraySpan but with the ability to be resized and updated. */
 class NormalsCache {
  public:
@@ -242,6 +251,10 @@ struct MeshRuntime {
   SharedCache<Array<int>> vert_to_corner_map_cache;
   /** Cache of face indices for each face corner. */
   SharedCache<Array<int>> corner_to_face_map_cache;
+  /** Cache of the edges using each vertex. See #Mesh::vert_to_edge_map(). */
+  SharedCache<GroupedIndicesCache> vert_to_edge_map_cache;
+  /** Cache of the faces using each edge. See #Mesh::edge_to_face_map(). */
+  SharedCache<GroupedIndicesCache> edge_to_face_map_cache;
   /** Cache of data about edges not used by faces. See #Mesh::loose_edges(). */
   SharedCache<LooseEdgeCache> loose_edges_cache;
   /** Cache of data about vertices not used by edges. See #Mesh::loose_verts(). */
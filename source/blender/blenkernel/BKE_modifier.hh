@@ -127,8 +127,16 @@ enum ModifierTypeFlag {
 
   /** Accepts #GreasePencil data input. */
   eModifierTypeFlag_AcceptsGreasePencil = (1 << 12),
+
+  /**
+   * The result only depends on the input mesh, the modifier settings and the evaluated objects
+   * the modifier references, so it can be reused as long as none of those change. Only modifiers
+   * without runtime data in their DNA struct and without texture or collection references may
+   * set this flag. See #ModifierStackCache.
+   */
+  eModifierTypeFlag_CacheableResult = (1 << 13),
 };
-ENUM_OPERATORS(ModifierTypeFlag, eModifierTypeFlag_AcceptsGreasePencil)
+ENUM_OPERATORS(ModifierTypeFlag, eModifierTypeFlag_CacheableResult)
 
 using IDWalkFunc = void (*)(void *user_data,
                             Object *ob,
@@ -122,6 +122,12 @@ class bNodeTreeRuntime : NonCopyable, NonMovable {
    * #eNodeTreeChangedFlag.
    */
   uint32_t changed_flag = 0;
+  /**
+   * Incremented whenever a change is tagged, unlike #changed_flag it is not reset by the update.
+   * Used to invalidate data that is cached across redraws, like the node layouts in the node
+   * editor.
+   */
+  uint64_t tagged_changes_num = 0;
   /**
    * A hash of the topology of the node tree leading up to the outputs. This is used to determine
    * of the node tree changed in a way that requires updating geometry nodes or shaders.
@@ -352,6 +358,13 @@ class bNodeRuntime : NonCopyable, NonMovable {
   /** Calculated bounding box of node in the view space of the node editor (including UI scale). */
   rctf draw_bounds{};
 
+  /**
+   * Hash of the state that #draw_bounds and the socket locations were computed from. Nodes far
+   * outside of the view reuse them while the hash doesn't change, instead of computing the layout
+   * again on every redraw.
+   */
+  uint64_t draw_layout_hash = 0;
+
   /** Used at runtime when going through the tree. Initialize before use. */
   short tmp_flag = 0;
 
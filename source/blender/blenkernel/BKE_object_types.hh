@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include <memory>
 #include <optional>
 
 #include "BLI_array.hh"
@@ -26,6 +27,7 @@ struct PoseBackup;
 namespace blender::bke {
 
 struct GeometrySet;
+struct ModifierStackCache;
 
 struct ObjectRuntime {
   /** Final transformation matrices with constraints & animsys applied. */
@@ -126,6 +128,12 @@ struct ObjectRuntime {
   /** Runtime evaluated curve-specific data, not stored in the file. */
   CurveCache *curve_cache = nullptr;
 
+  /**
+   * Results of the leading constructive modifiers of a mesh object, reused by the next evaluation
+   * of the modifier stack when their inputs did not change. Only set on evaluated objects.
+   */
+  std::shared_ptr<ModifierStackCache> modifier_stack_cache;
+
   unsigned short local_collections_bits = 0;
 
   Array<float3x3, 0> crazyspace_deform_imats;
@@ -163,6 +163,9 @@ typedef struct ParticleThreadContext {
   struct CurveMapping *clumpcurve;
   struct CurveMapping *roughcurve;
   struct CurveMapping *twistcurve;
+
+  /** Children whose paths are recomputed, all children when null. */
+  const bool *child_needs_update;
 } ParticleThreadContext;
 
 typedef struct ParticleTask {
@@ -330,6 +333,10 @@ void BKE_particlesettings_fluid_default_settings(struct ParticleSettings *part);
  * Free cache path.
  */
 void psys_free_path_cache(struct ParticleSystem *psys, struct PTCacheEdit *edit);
+/**
+ * Free the child path cache only, keeping the parent paths.
+ */
+void psys_free_child_path_cache(struct ParticleSystem *psys);
 /**
  * Free everything.
  */
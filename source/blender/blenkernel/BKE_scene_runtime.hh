@@ -25,6 +25,10 @@ class CompositorRuntime {
    * evaluation. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> per_node_execution_time;
 
+  /* Per-node instance size in bytes of the results computed by the corresponding node, during the
+   * last tree evaluation. */
+  Map<bNodeInstanceKey, int64_t> per_node_memory_usage;
+
   /* A dependency graph used for interactive compositing. This is initialized the first time it is
    * needed, and then kept persistent for the lifetime of the scene. This is done to allow the
    * compositor to track changes to resources its uses as well as reduce the overhead of creating
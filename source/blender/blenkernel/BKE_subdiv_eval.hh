@@ -14,6 +14,7 @@
 struct Mesh;
 struct OpenSubdiv_EvaluatorCache;
 struct OpenSubdiv_EvaluatorSettings;
+struct OpenSubdiv_PatchCoord;
 
 namespace blender::bke::subdiv {
 
@@ -92,4 +93,20 @@ void eval_displacement(Subdiv *subdiv,
 /* Evaluate point on a limit surface with displacement applied to it. */
 void eval_final_point(Subdiv *subdiv, int ptex_face_index, float u, float v, float r_P[3]);
 
+/* Batched queries.
+ *
+ * Evaluate many points with a single call, which is required by GPU evaluators: they don't
+ * support the single point queries above. */
+
+/* Evaluate points at a limit surface. */
+void eval_limit_points(Subdiv *subdiv,
+                       Span<OpenSubdiv_PatchCoord> patch_coords,
+                       MutableSpan<float3> r_P);
+
+/* Evaluate face-varying layer (such as UV) at the given points. */
+void eval_face_varying_points(Subdiv *subdiv,
+                              int face_varying_channel,
+                              Span<OpenSubdiv_PatchCoord> patch_coords,
+                              MutableSpan<float2> r_face_varying);
+
 }  // namespace blender::bke::subdiv
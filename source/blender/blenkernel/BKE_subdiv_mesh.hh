@@ -12,6 +12,7 @@
 #include "BLI_offset_indices.hh"
 
 struct Mesh;
+struct OpenSubdiv_EvaluatorCache;
 
 namespace blender::bke::subdiv {
 
@@ -28,6 +29,15 @@ struct ToMeshSettings {
   int resolution;
   /** When true, only edges emitted from coarse ones will be displayed. */
   bool use_optimal_display;
+  /**
+   * Evaluate the limit surface on the GPU, with a single batch for all vertex positions and UV
+   * maps. This requires an active GPU context, and the subdivision descriptor must only be used
+   * for GPU evaluation. Displacement and original coordinates are not supported, and
+   * #subdiv_to_mesh returns null when they are needed, so that the CPU can be used instead.
+   */
+  bool use_gpu_evaluation = false;
+  /** Optional cache of GPU evaluator shaders, used with #use_gpu_evaluation. */
+  OpenSubdiv_EvaluatorCache *evaluator_cache = nullptr;
 };
 
 /** Create real hi-res mesh from subdivision, all geometry is "real". */
@@ -22,6 +22,7 @@ struct SubsurfModifierData;
 namespace blender::bke::subdiv {
 struct Subdiv;
 struct Settings;
+struct ToMeshSettings;
 }  // namespace blender::bke::subdiv
 
 /* Runtime subsurf modifier data, cached in modifier on evaluated meshes. */
@@ -32,6 +33,9 @@ struct SubsurfRuntimeData {
   /* Cached subdivision surface descriptor, with topology and settings. */
   blender::bke::subdiv::Subdiv *subdiv_cpu;
   blender::bke::subdiv::Subdiv *subdiv_gpu;
+  /* Descriptor used to create meshes with the limit surface evaluated on the GPU. It is separate
+   * from #subdiv_gpu which is only used by the draw code, to avoid concurrent use. */
+  blender::bke::subdiv::Subdiv *subdiv_gpu_mesh;
 
   /* Recent usage markers for UI diagnostics. To avoid UI flicker due to races
    * between evaluation and UI redraw, they are set to 2 when an evaluator is used,
@@ -77,6 +81,23 @@ bool BKE_subsurf_modifier_can_do_gpu_subdiv(const SubsurfModifierData *smd, cons
 bool BKE_subsurf_modifier_has_gpu_subdiv(const Mesh *mesh);
 
 extern void (*BKE_subsurf_modifier_free_gpu_cache_cb)(blender::bke::subdiv::Subdiv *subdiv);
+extern Mesh *(*BKE_subsurf_modifier_subdiv_to_mesh_gpu_cb)(
+    blender::bke::subdiv::Subdiv *subdiv,
+    const blender::bke::subdiv::ToMeshSettings *settings,
+    const Mesh *coarse_mesh);
+
+/**
+ * Create the subdivided mesh with the limit surface evaluated on the GPU. This is only possible
+ * when a GPU context is active on the calling thread (for example when the mesh is requested by
+ * the draw code or a render engine), the context is not acquired here since the thread holding
+ * it might be waiting for this evaluation.
+ *
+ * \return Null when GPU evaluation isn't possible, the CPU descriptor should be used then.
+ */
+Mesh *BKE_subsurf_modifier_subdiv_to_mesh_gpu(
+    SubsurfRuntimeData *runtime_data,
+    const Mesh *mesh,
+    const blender::bke::subdiv::ToMeshSettings &settings);
 
 /**
  * Main goal of this function is to give usable subdivision surface descriptor
@@ -82,6 +82,16 @@ void BKE_texture_get_value(struct Tex *texture,
                            struct TexResult *texres,
                            bool use_color_management);
 
+/**
+ * Evaluate the texture at many coordinates at once, like #BKE_texture_get_value_ex for each of
+ * them. Images are loaded into a pool up front and the coordinates are evaluated in parallel.
+ */
+void BKE_texture_get_values(struct Tex *texture,
+                            const float (*tex_co)[3],
+                            int tex_co_num,
+                            struct TexResult *r_texres,
+                            bool use_color_management);
+
 /**
  * Make sure all images used by texture are loaded into pool.
  */
@@ -88,6 +88,14 @@ struct UndoStep {
   bool use_old_bmain_data;
   /** For use by undo systems that accumulate changes (mesh-sculpt & image-painting). */
   bool is_applied;
+  /** The compressed data of this step is in a temporary file, see #UndoType.step_compress. */
+  bool is_spilled;
+  /**
+   * Size in bytes of the part of #data_size which is compressed to save memory, and the size of
+   * that data once compressed.
+   */
+  size_t compressed_data_size;
+  size_t compressed_size;
   /* Over alloc 'type->struct_size'. */
 };
 
@@ -141,6 +149,16 @@ struct UndoType {
                               UndoTypeForEachIDRefFn foreach_ID_ref_fn,
                               void *user_data);
 
+  /**
+   * Optional, reduce the memory used by a step which is not expected to be loaded soon by
+   * compressing its data, or when \a spill_filepath is set, by moving the compressed data to
+   * that file. Sets #UndoStep.compressed_data_size and #UndoStep.compressed_size.
+   *
+   * The data is restored with #step_restore before the step is decoded, or used by another step.
+   */
+  void (*step_compress)(UndoStep *us, const char *spill_filepath);
+  void (*step_restore)(UndoStep *us);
+
   /** Information for the generic undo system to refine handling of this specific undo type. */
   uint flags;
 
@@ -202,6 +220,23 @@ void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size
 #define BKE_undosys_stack_limit_steps_and_memory_defaults(ustack) \
   BKE_undosys_stack_limit_steps_and_memory(ustack, U.undosteps, (size_t)U.undomemory * 1024 * 1024)
 
+/**
+ * Compress the steps which are not going to be loaded soon, starting with the oldest ones, and
+ * then move the compressed data of these steps to temporary files until the memory used by the
+ * undo stack is below the given limit.
+ */
+void BKE_undosys_stack_limit_resident_memory(UndoStack *ustack, size_t memory_limit);
+
+struct UndoStackMemoryStats {
+  /** Size in bytes of the undo data in memory, including compressed data. */
+  size_t resident_size;
+  /** Size in bytes of the compressed data kept in memory. */
+  size_t compressed_size;
+  /** Size in bytes of the compressed data moved to temporary files. */
+  size_t spilled_size;
+};
+void BKE_undosys_stack_memory_stats(const UndoStack *ustack, UndoStackMemoryStats *r_stats);
+
 void BKE_undosys_stack_group_begin(UndoStack *ustack);
 void BKE_undosys_stack_group_end(UndoStack *ustack);
 
@@ -227,6 +262,11 @@ UndoStep *BKE_undosys_step_find_by_name_with_type(UndoStack *ustack,
                                                   const char *name,
                                                   const UndoType *ut);
 UndoStep *BKE_undosys_step_find_by_type(UndoStack *ustack, const UndoType *ut);
+
+/**
+ * Make the data of a step compressed by #BKE_undosys_stack_limit_resident_memory available again.
+ */
+void BKE_undosys_step_restore(UndoStep *us);
 UndoStep *BKE_undosys_step_find_by_name(UndoStack *ustack, const char *name);
 
 /**
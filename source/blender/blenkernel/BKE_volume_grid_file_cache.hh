@@ -18,7 +18,9 @@
  * The global volume grid file cache makes it easy to load volumes only once from disk and to then
  * reuse the loaded volume across Blender. Additionally, this also supports caching simplify
  * levels which are used when the "volume resolution" simplify scene setting is reduced. Working
- * with reduced resolution can improve performance and uses less memory.
+ * with reduced resolution can improve performance and uses less memory. Simplified grids are
+ * built by streaming the leaves of the full resolution grid from the file, so the full resolution
+ * voxel data does not have to fit into memory.
  */
 namespace blender::bke::volume_grid::file_cache {
 
@@ -117,6 +117,38 @@ static void action_init_data(ID *action_id)
  *
  * \param flag: Copying options (see BKE_lib_id.hh's LIB_ID_COPY_... flags for more).
  */
+/**
+ * Share the keyframes of all F-Curves of an evaluated copy with the other evaluated copies of the
+ * same action. Both actions are expected to have the same layout, as right after copying.
+ */
+static void action_share_keyframes_for_eval(animrig::Action &action_eval,
+                                            const animrig::Action &action_orig)
+{
+  /* The keyframes snapshot is runtime data of the original, it is fine to modify it here. */
+  animrig::Action &action_orig_mutable = const_cast<animrig::Action &>(action_orig);
+
+  FCurve *fcurve_orig = static_cast<FCurve *>(action_orig_mutable.curves.first);
+  LISTBASE_FOREACH (FCurve *, fcurve_eval, &action_eval.curves) {
+    BKE_fcurve_share_keyframes_for_eval(*fcurve_eval, *fcurve_orig);
+    fcurve_orig = fcurve_orig->next;
+  }
+
+  const Span<animrig::StripKeyframeData *> keyframe_data_orig =
+      action_orig_mutable.strip_keyframe_data();
+  const Span<animrig::StripKeyframeData *> keyframe_data_eval = action_eval.strip_keyframe_data();
+  for (const int i : keyframe_data_eval.index_range()) {
+    const Span<animrig::Channelbag *> channelbags_orig = keyframe_data_orig[i]->channelbags();
+    const Span<animrig::Channelbag *> channelbags_eval = keyframe_data_eval[i]->channelbags();
+    for (const int j : channelbags_eval.index_range()) {
+      const Span<FCurve *> fcurves_orig = channelbags_orig[j]->fcurves();
+      const Span<FCurve *> fcurves_eval = channelbags_eval[j]->fcurves();
+      for (const int k : fcurves_eval.index_range()) {
+        BKE_fcurve_share_keyframes_for_eval(*fcurves_eval[k], *fcurves_orig[k]);
+      }
+    }
+  }
+}
+
 static void action_copy_data(Main * /*bmain*/,
                              std::optional<Library *> /*owner_library*/,
                              ID *id_dst,
@@ -196,6 +228,10 @@ static void action_copy_data(Main * /*bmain*/,
     action_dst.slot_array[i] = MEM_new<animrig::Slot>(__func__, *action_src.slot(i));
   }
 
+  if (flag & LIB_ID_COPY_SET_COPIED_ON_WRITE) {
+    action_share_keyframes_for_eval(action_dst, action_src);
+  }
+
   if (flag & LIB_ID_COPY_NO_PREVIEW) {
     action_dst.preview = nullptr;
   }
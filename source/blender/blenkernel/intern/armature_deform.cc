@@ -18,6 +18,7 @@
 
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
+#include "BLI_math_matrix.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_task.h"
@@ -195,6 +196,19 @@ static float dist_bone_deform(const bPoseChannel *pchan,
   return contrib;
 }
 
+/**
+ * Whether the bone deforms vertices by its matrix alone, so that the linear blending of several
+ * such bones can be done by blending their matrices.
+ */
+static bool pchan_deforms_by_matrix(const bPoseChannel *pchan)
+{
+  const Bone *bone = pchan->bone;
+  if (bone->flag & BONE_MULT_VG_ENV) {
+    return false;
+  }
+  return !(bone->segments > 1 && pchan->runtime.bbone_segments == bone->segments);
+}
+
 static void pchan_bone_deform(const bPoseChannel *pchan,
                               const float weight,
                               float vec[3],
@@ -247,6 +261,8 @@ struct ArmatureUserdata {
   int dverts_len;
 
   bPoseChannel **pchan_from_defbase;
+  /** Whether the bone of each vertex group is deformed by #pchan_deforms_by_matrix. */
+  bool *deforms_by_matrix_from_defbase;
   int defbase_len;
 
   float premat[4][4];
@@ -332,9 +348,14 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
   mul_m4_v3(data->premat, co);
 
   if (use_dverts && dvert && dvert->totweight) { /* use weight groups ? */
+    using namespace blender;
     const MDeformWeight *dw = dvert->dw;
     int deformed = 0;
     uint j;
+    /* For linear blending, the matrices of plain bones are blended first and applied once.
+     * This replaces a matrix-vector product per influence with a few vectorized additions. */
+    float4x4 blend_mat = float4x4::zero();
+    float blend_weight = 0.0f;
     for (j = dvert->totweight; j != 0; j--, dw++) {
       const uint index = dw->def_nr;
       if (index >= data->defbase_len) {
@@ -350,6 +371,14 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
       deformed = 1;
 
+      if (!use_quaternion && data->deforms_by_matrix_from_defbase[index]) {
+        if (weight != 0.0f) {
+          blend_mat += float4x4(pchan->chan_mat) * weight;
+          blend_weight += weight;
+        }
+        continue;
+      }
+
       if (bone && bone->flag & BONE_MULT_VG_ENV) {
         weight *= distfactor_to_bone(
             co, bone->arm_head, bone->arm_tail, bone->rad_head, bone->rad_tail, bone->dist);
@@ -357,6 +386,16 @@ static void armature_vert_task_with_dvert(const ArmatureUserdata *data,
 
       pchan_bone_deform(pchan, weight, vec, dq, smat, co, full_deform, &contrib);
     }
+    if (blend_weight != 0.0f) {
+      const float3 position(co);
+      const float3 offset = math::transform_point(blend_mat, position) - position * blend_weight;
+      add_v3_v3(vec, offset);
+      if (full_deform) {
+        const float3x3 blend_mat3(blend_mat);
+        add_m3_m3m3(smat, smat, blend_mat3.ptr());
+      }
+      contrib += blend_weight;
+    }
     /* If there are vertex-groups but not groups with bones (like for soft-body groups). */
     if (deformed == 0 && use_envelope) {
       for (pchan = static_cast<const bPoseChannel *>(data->ob_arm->pose->chanbase.first); pchan;
@@ -493,6 +532,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
 {
   const bArmature *arm = static_cast<const bArmature *>(ob_arm->data);
   bPoseChannel **pchan_from_defbase = nullptr;
+  bool *deforms_by_matrix_from_defbase = nullptr;
   const bool use_envelope = (deformflag & ARM_DEF_ENVELOPE) != 0;
   const bool use_quaternion = (deformflag & ARM_DEF_QUATERNION) != 0;
   const bool invert_vgroup = (deformflag & ARM_DEF_INVERT_VGROUP) != 0;
@@ -534,6 +574,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
 
       if (use_dverts) {
         pchan_from_defbase = MEM_calloc_arrayN<bPoseChannel *>(defbase_len, "defnrToBone");
+        deforms_by_matrix_from_defbase = MEM_calloc_arrayN<bool>(defbase_len, __func__);
         /* TODO(sergey): Some considerations here:
          *
          * - Check whether keeping this consistent across frames gives speedup.
@@ -546,6 +587,9 @@ static void armature_deform_coords_impl(const Object *ob_arm,
             if (pchan_from_defbase[i]->bone->flag & BONE_NO_DEFORM) {
               pchan_from_defbase[i] = nullptr;
             }
+            else {
+              deforms_by_matrix_from_defbase[i] = pchan_deforms_by_matrix(pchan_from_defbase[i]);
+            }
           }
         }
       }
@@ -566,6 +610,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   data.dverts = dverts.data();
   data.dverts_len = dverts.size();
   data.pchan_from_defbase = pchan_from_defbase;
+  data.deforms_by_matrix_from_defbase = deforms_by_matrix_from_defbase;
   data.defbase_len = defbase_len;
   data.bmesh.cd_dvert_offset = cd_dvert_offset;
 
@@ -602,6 +647,7 @@ static void armature_deform_coords_impl(const Object *ob_arm,
   if (pchan_from_defbase) {
     MEM_freeN(pchan_from_defbase);
   }
+  MEM_SAFE_FREE(deforms_by_matrix_from_defbase);
 }
 
 void BKE_armature_deform_coords_with_curves(
@@ -18,6 +18,7 @@
 #include "BLI_endian_switch.h"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix_types.hh"
+#include "BLI_mmap.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
 
@@ -27,10 +28,19 @@
 #include "RNA_access.hh"
 #include "RNA_enum_types.hh"
 
+#include <array>
+#include <fcntl.h>
 #include <fmt/format.h>
 #include <sstream>
 #include <xxhash.h>
 
+#ifndef WIN32
+#  include <unistd.h> /* For close. */
+#else
+#  include "BLI_winstuff.h"
+#  include <io.h> /* For close. */
+#endif
+
 #ifdef WITH_OPENVDB
 #  include <openvdb/io/Stream.h>
 #  include <openvdb/openvdb.h>
@@ -88,8 +98,126 @@ bool BlobReader::read_as_stream(const BlobSlice &slice, FunctionRef<bool(std::is
   return true;
 }
 
+std::optional<ImplicitSharingInfoAndData> BlobReader::read_mapped(const BlobSlice & /*slice*/,
+                                                                  const int64_t /*alignment*/) const
+{
+  return std::nullopt;
+}
+
+/**
+ * A blob file that is mapped to memory. It's owned by the reader and all data that references it.
+ */
+class MappedBlobFile : public ImplicitSharingMixin {
+ public:
+  int file_descriptor;
+  BLI_mmap_file *mmap_file;
+
+  MappedBlobFile(const int file_descriptor, BLI_mmap_file *mmap_file)
+      : file_descriptor(file_descriptor), mmap_file(mmap_file)
+  {
+  }
+
+  ~MappedBlobFile()
+  {
+    BLI_mmap_free(mmap_file);
+    close(file_descriptor);
+  }
+
+ private:
+  void delete_self() override
+  {
+    MEM_delete(this);
+  }
+};
+
+/**
+ * Sharing info for a single array in a mapped blob file. Every array has its own sharing info, so
+ * that they can be modified independently. The mapping is a private copy, so the array is modified
+ * in place when there are no other users.
+ */
+class MappedBlobSliceSharingInfo : public ImplicitSharingInfo {
+ private:
+  ImplicitSharingPtr<MappedBlobFile> file_;
+
+ public:
+  MappedBlobSliceSharingInfo(ImplicitSharingPtr<MappedBlobFile> file) : file_(std::move(file)) {}
+
+ private:
+  void delete_self_with_data() override
+  {
+    MEM_delete(this);
+  }
+};
+
 DiskBlobReader::DiskBlobReader(std::string blobs_dir) : blobs_dir_(std::move(blobs_dir)) {}
 
+DiskBlobReader::~DiskBlobReader() = default;
+
+const MappedBlobFile *DiskBlobReader::get_mapped_file(const StringRef blob_name) const
+{
+#ifdef WIN32
+  /* Mapped files can't be deleted on Windows, which would make it impossible to bake again while
+   * the data is still used. */
+  UNUSED_VARS(blob_name);
+  return nullptr;
+#else
+  std::lock_guard lock{mutex_};
+  const ImplicitSharingPtr<MappedBlobFile> &mapped_file = mapped_files_.lookup_or_add_cb_as(
+      blob_name, [&]() -> ImplicitSharingPtr<MappedBlobFile> {
+        char blob_path[FILE_MAX];
+        BLI_path_join(
+            blob_path, sizeof(blob_path), blobs_dir_.c_str(), std::string(blob_name).c_str());
+        const int file_descriptor = BLI_open(blob_path, O_BINARY | O_RDONLY, 0);
+        if (file_descriptor == -1) {
+          return {};
+        }
+        BLI_mmap_file *mmap_file = BLI_mmap_open_writable_copy(file_descriptor);
+        if (mmap_file == nullptr) {
+          close(file_descriptor);
+          return {};
+        }
+        return ImplicitSharingPtr<MappedBlobFile>(
+            MEM_new<MappedBlobFile>(__func__, file_descriptor, mmap_file));
+      });
+  return mapped_file.get();
+#endif
+}
+
+std::optional<ImplicitSharingInfoAndData> DiskBlobReader::read_mapped(const BlobSlice &slice,
+                                                                      const int64_t alignment) const
+{
+  if (slice.range.is_empty()) {
+    return std::nullopt;
+  }
+  const MappedBlobFile *mapped_file = this->get_mapped_file(slice.name);
+  if (mapped_file == nullptr) {
+    return std::nullopt;
+  }
+  BLI_mmap_file *mmap_file = mapped_file->mmap_file;
+  if (BLI_mmap_get_range(mmap_file, slice.range.start(), slice.range.size()) == nullptr) {
+    return std::nullopt;
+  }
+  void *data = POINTER_OFFSET(BLI_mmap_get_pointer(mmap_file), slice.range.start());
+  if (uintptr_t(data) % uintptr_t(alignment) != 0) {
+    /* Blobs written by older versions may not be aligned. */
+    return std::nullopt;
+  }
+  /* Start reading the whole array from disk, it's likely going to be used entirely. */
+  BLI_mmap_prefetch_range(mmap_file, slice.range.start(), slice.range.size());
+  mapped_file->add_user();
+  const ImplicitSharingInfo *sharing_info = MEM_new<MappedBlobSliceSharingInfo>(
+      __func__, ImplicitSharingPtr<MappedBlobFile>(mapped_file));
+  return ImplicitSharingInfoAndData{sharing_info, data};
+}
+
+void DiskBlobReader::prefetch(const StringRef blob_name) const
+{
+  if (const MappedBlobFile *mapped_file = this->get_mapped_file(blob_name)) {
+    BLI_mmap_prefetch_range(
+        mapped_file->mmap_file, 0, BLI_mmap_get_length(mapped_file->mmap_file));
+  }
+}
+
 [[nodiscard]] bool DiskBlobReader::read(const BlobSlice &slice, void *r_data) const
 {
   if (slice.range.is_empty()) {
@@ -117,6 +245,15 @@ DiskBlobWriter::DiskBlobWriter(std::string blob_dir, std::string base_name)
   blob_name_ = base_name_ + ".blob";
 }
 
+/**
+ * Blobs are aligned so that arrays can be used directly from memory-mapped files. Large arrays are
+ * page-aligned, so that reading them from disk doesn't touch pages of neighboring data.
+ */
+static int64_t get_blob_alignment(const int64_t size)
+{
+  return size >= 64 * 1024 ? 4096 : 64;
+}
+
 BlobSlice DiskBlobWriter::write(const void *data, const int64_t size)
 {
   if (!blob_stream_.is_open()) {
@@ -126,6 +263,15 @@ BlobSlice DiskBlobWriter::write(const void *data, const int64_t size)
     blob_stream_.open(blob_path, std::ios::out | std::ios::binary);
   }
 
+  const int64_t alignment = get_blob_alignment(size);
+  const int64_t padding = (alignment - current_offset_ % alignment) % alignment;
+  if (padding > 0) {
+    const std::array<char, 4096> zeros{};
+    blob_stream_.write(zeros.data(), padding);
+    current_offset_ += padding;
+    total_written_size_ += padding;
+  }
+
   const int64_t old_offset = current_offset_;
   blob_stream_.write(static_cast<const char *>(data), size);
   current_offset_ += size;
@@ -464,6 +610,29 @@ static std::shared_ptr<DictionaryValue> write_blob_simple_gspan(BlobWriter &blob
   return false;
 }
 
+/**
+ * Use the data without copying it, when the reader supports that and the data is stored in the
+ * format that's used at run-time.
+ */
+static std::optional<ImplicitSharingInfoAndData> read_blob_mapped(const BlobReader &blob_reader,
+                                                                  const DictionaryValue &io_data,
+                                                                  const CPPType &cpp_type,
+                                                                  const int64_t size)
+{
+  const std::optional<BlobSlice> slice = BlobSlice::deserialize(io_data);
+  if (!slice) {
+    return std::nullopt;
+  }
+  if (slice->range.size() != cpp_type.size * size) {
+    return std::nullopt;
+  }
+  const StringRefNull stored_endian = io_data.lookup_str("endian").value_or("little");
+  if (stored_endian != get_endian_io_name(ENDIAN_ORDER)) {
+    return std::nullopt;
+  }
+  return blob_reader.read_mapped(*slice, cpp_type.alignment);
+}
+
 static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
     BlobWriter &blob_writer,
     BlobWriteSharing &blob_sharing,
@@ -485,6 +654,11 @@ static std::shared_ptr<DictionaryValue> write_blob_shared_simple_gspan(
   const char *func = __func__;
   const std::optional<ImplicitSharingInfoAndData> sharing_info_and_data = blob_sharing.read_shared(
       io_data, [&]() -> std::optional<ImplicitSharingInfoAndData> {
+        if (std::optional<ImplicitSharingInfoAndData> mapped_data = read_blob_mapped(
+                blob_reader, io_data, cpp_type, size))
+        {
+          return mapped_data;
+        }
         void *data_mem = MEM_mallocN_aligned(size * cpp_type.size, cpp_type.alignment, func);
         if (!read_blob_simple_gspan(blob_reader, io_data, {cpp_type, data_mem, size})) {
           MEM_freeN(data_mem);
@@ -22,6 +22,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_base.hh"
 #include "BLI_rand.h"
+#include "BLI_simd.hh"
 
 #include "BLT_translation.hh"
 
@@ -1292,12 +1293,96 @@ void BKE_brush_randomize_texture_coords(UnifiedPaintSettings *ups, bool mask)
   }
 }
 
+/* Arithmetic used by the falloff curves, so that each curve is written once for both single values
+ * and SIMD registers with four values. */
+namespace curve_math {
+static float set(float /*type*/, const float value)
+{
+  return value;
+}
+static float add(const float a, const float b)
+{
+  return a + b;
+}
+static float sub(const float a, const float b)
+{
+  return a - b;
+}
+static float mul(const float a, const float b)
+{
+  return a * b;
+}
+static float sqrt(const float a)
+{
+  return sqrtf(a);
+}
+#if BLI_HAVE_SSE2
+static __m128 set(__m128 /*type*/, const float value)
+{
+  return _mm_set1_ps(value);
+}
+static __m128 add(const __m128 a, const __m128 b)
+{
+  return _mm_add_ps(a, b);
+}
+static __m128 sub(const __m128 a, const __m128 b)
+{
+  return _mm_sub_ps(a, b);
+}
+static __m128 mul(const __m128 a, const __m128 b)
+{
+  return _mm_mul_ps(a, b);
+}
+static __m128 sqrt(const __m128 a)
+{
+  return _mm_sqrt_ps(a);
+}
+#endif
+}  // namespace curve_math
+
+/**
+ * Multiply the factors by a falloff curve of the linear falloff factor, evaluating four distances
+ * at a time when SIMD instructions are available. Factors outside of the radius are cleared.
+ */
+template<typename CurveFn>
+static void apply_curve_factors(const blender::Span<float> distances,
+                                const float brush_radius,
+                                const blender::MutableSpan<float> factors,
+                                const CurveFn curve_fn)
+{
+  const float radius_rcp = blender::math::rcp(brush_radius);
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 radius_v = _mm_set1_ps(brush_radius);
+  const __m128 radius_rcp_v = _mm_set1_ps(radius_rcp);
+  const __m128 one = _mm_set1_ps(1.0f);
+  for (; i + 4 <= distances.size(); i += 4) {
+    const __m128 distance = _mm_loadu_ps(&distances[i]);
+    const __m128 factor = _mm_sub_ps(one, _mm_mul_ps(distance, radius_rcp_v));
+    const __m128 result = _mm_mul_ps(_mm_loadu_ps(&factors[i]), curve_fn(factor));
+    /* The curve values of distances outside of the radius are meaningless, mask them out. */
+    const __m128 outside = _mm_cmpge_ps(distance, radius_v);
+    _mm_storeu_ps(&factors[i], _mm_andnot_ps(outside, result));
+  }
+#endif
+  for (; i < distances.size(); i++) {
+    const float distance = distances[i];
+    if (distance >= brush_radius) {
+      factors[i] = 0.0f;
+      continue;
+    }
+    const float factor = 1.0f - distance * radius_rcp;
+    factors[i] *= curve_fn(factor);
+  }
+}
+
 void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
                                   const CurveMapping *cumap,
                                   const blender::Span<float> distances,
                                   const float brush_radius,
                                   const blender::MutableSpan<float> factors)
 {
+  using namespace curve_math;
   BLI_assert(factors.size() == distances.size());
 
   const float radius_rcp = blender::math::rcp(brush_radius);
@@ -1314,102 +1399,55 @@ void BKE_brush_calc_curve_factors(const eBrushCurvePreset preset,
       break;
     }
     case BRUSH_CURVE_SHARP: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor;
-      }
+      apply_curve_factors(
+          distances, brush_radius, factors, [](const auto f) { return mul(f, f); });
       break;
     }
     case BRUSH_CURVE_SMOOTH: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= 3.0f * factor * factor - 2.0f * factor * factor * factor;
-      }
+      apply_curve_factors(distances, brush_radius, factors, [](const auto f) {
+        /* `3 * f^2 - 2 * f^3`. */
+        return sub(mul(mul(set(f, 3.0f), f), f), mul(mul(mul(set(f, 2.0f), f), f), f));
+      });
       break;
     }
     case BRUSH_CURVE_SMOOTHER: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= pow3f(factor) * (factor * (factor * 6.0f - 15.0f) + 10.0f);
-      }
+      apply_curve_factors(distances, brush_radius, factors, [](const auto f) {
+        /* `f^3 * (f * (f * 6 - 15) + 10)`. */
+        return mul(mul(mul(f, f), f),
+                   add(mul(f, sub(mul(f, set(f, 6.0f)), set(f, 15.0f))), set(f, 10.0f)));
+      });
       break;
     }
     case BRUSH_CURVE_ROOT: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(factor);
-      }
+      apply_curve_factors(
+          distances, brush_radius, factors, [](const auto f) { return curve_math::sqrt(f); });
       break;
     }
     case BRUSH_CURVE_LIN: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor;
-      }
+      apply_curve_factors(distances, brush_radius, factors, [](const auto f) { return f; });
       break;
     }
     case BRUSH_CURVE_CONSTANT: {
       break;
     }
     case BRUSH_CURVE_SPHERE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= sqrtf(2 * factor - factor * factor);
-      }
+      apply_curve_factors(distances, brush_radius, factors, [](const auto f) {
+        /* `sqrt(2 * f - f^2)`. */
+        return curve_math::sqrt(sub(mul(set(f, 2.0f), f), mul(f, f)));
+      });
       break;
     }
     case BRUSH_CURVE_POW4: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * factor * factor * factor;
-      }
+      apply_curve_factors(distances, brush_radius, factors, [](const auto f) {
+        return mul(mul(mul(f, f), f), f);
+      });
       break;
     }
     case BRUSH_CURVE_INVSQUARE: {
-      for (const int i : distances.index_range()) {
-        const float distance = distances[i];
-        if (distance >= brush_radius) {
-          factors[i] = 0.0f;
-          continue;
-        }
-        const float factor = 1.0f - distance * radius_rcp;
-        factors[i] *= factor * (2.0f - factor);
-      }
+      apply_curve_factors(distances, brush_radius, factors, [](const auto f) {
+        /* `f * (2 - f)`. */
+        return mul(f, sub(set(f, 2.0f), f));
+      });
       break;
     }
   }
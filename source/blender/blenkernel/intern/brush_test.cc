@@ -8,6 +8,7 @@
 #include "BKE_lib_id.hh"
 #include "BKE_main.hh"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 
 #include "DNA_brush_types.h"
@@ -120,3 +121,32 @@ TEST_F(BrushTest, deep_copy_grease_pencil_brush)
 
   EXPECT_TRUE(BLI_listbase_is_empty(&bmain->nodetrees));
 }
+
+TEST(brush, calc_curve_factors)
+{
+  /* The batched evaluation handles several values at once, use a size that isn't a multiple of
+   * that to test the remaining values too. */
+  const int size = 31;
+  const float radius = 2.5f;
+  blender::Array<float> distances(size);
+  for (const int i : distances.index_range()) {
+    distances[i] = float(i) / float(size - 4) * radius;
+  }
+  for (const eBrushCurvePreset preset : {BRUSH_CURVE_SMOOTH,
+                                         BRUSH_CURVE_SPHERE,
+                                         BRUSH_CURVE_ROOT,
+                                         BRUSH_CURVE_SHARP,
+                                         BRUSH_CURVE_LIN,
+                                         BRUSH_CURVE_POW4,
+                                         BRUSH_CURVE_INVSQUARE,
+                                         BRUSH_CURVE_SMOOTHER})
+  {
+    blender::Array<float> factors(size, 0.5f);
+    BKE_brush_calc_curve_factors(preset, nullptr, distances, radius, factors);
+    for (const int i : distances.index_range()) {
+      const float strength = BKE_brush_curve_strength(preset, nullptr, distances[i], radius);
+      const float expected = 0.5f * strength;
+      EXPECT_NEAR(factors[i], expected, 1e-6f) << "Preset " << preset << ", index " << i;
+    }
+  }
+}
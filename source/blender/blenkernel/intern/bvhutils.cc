@@ -509,13 +509,12 @@ static std::unique_ptr<BVHTree, BVHTreeDeleter> create_tree_from_tris(const Span
   if (!tree) {
     return {};
   }
-  for (const int tri : corner_tris.index_range()) {
-    float co[3][3];
-    copy_v3_v3(co[0], positions[corner_verts[corner_tris[tri][0]]]);
-    copy_v3_v3(co[1], positions[corner_verts[corner_tris[tri][1]]]);
-    copy_v3_v3(co[2], positions[corner_verts[corner_tris[tri][2]]]);
-    BLI_bvhtree_insert(tree.get(), tri, co[0], 3);
-  }
+  BLI_bvhtree_insert_parallel(tree.get(), corner_tris.size(), 3, [&](const int tri, float3 *r_co) {
+    r_co[0] = positions[corner_verts[corner_tris[tri][0]]];
+    r_co[1] = positions[corner_verts[corner_tris[tri][1]]];
+    r_co[2] = positions[corner_verts[corner_tris[tri][2]]];
+    return tri;
+  });
   BLI_bvhtree_balance(tree.get());
   return tree;
 }
@@ -18,7 +18,9 @@
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
+#include "BLI_mutex.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 #include "BKE_cloth.hh"
 #include "BKE_collection.hh"
@@ -56,34 +58,55 @@ struct SelfColDetectData {
  * Collision modifier code start
  ***********************************/
 
+/* Colliders can be shared by simulations that are evaluated in parallel. */
+static blender::Mutex collision_move_mutex;
+
 void collision_move_object(CollisionModifierData *collmd,
                            const float step,
                            const float prevstep,
                            const bool moving_bvh)
 {
-  uint i = 0;
-
-  /* the collider doesn't move this frame */
-  if (collmd->is_static) {
-    for (i = 0; i < collmd->mvert_num; i++) {
-      zero_v3(collmd->current_v[i]);
-    }
+  using namespace blender;
+  std::scoped_lock lock(collision_move_mutex);
 
+  /* Every cloth colliding with this object moves it to the same steps, only do that once. */
+  if (collmd->is_moved && collmd->moved_step == step && collmd->moved_prevstep == prevstep &&
+      bool(collmd->is_moved_bvh_moving) == moving_bvh)
+  {
     return;
   }
 
-  for (i = 0; i < collmd->mvert_num; i++) {
-    interp_v3_v3v3(collmd->current_x[i], collmd->x[i], collmd->xnew[i], prevstep);
-    interp_v3_v3v3(collmd->current_xnew[i], collmd->x[i], collmd->xnew[i], step);
-    sub_v3_v3v3(collmd->current_v[i], collmd->current_xnew[i], collmd->current_x[i]);
-  }
+  threading::isolate_task([&]() {
+    /* the collider doesn't move this frame */
+    if (collmd->is_static) {
+      threading::parallel_for(IndexRange(collmd->mvert_num), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          zero_v3(collmd->current_v[i]);
+        }
+      });
+      return;
+    }
 
-  bvhtree_update_from_mvert(collmd->bvhtree,
-                            collmd->current_xnew,
-                            collmd->current_x,
-                            reinterpret_cast<const blender::int3 *>(collmd->vert_tris),
-                            collmd->tri_num,
-                            moving_bvh);
+    threading::parallel_for(IndexRange(collmd->mvert_num), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        interp_v3_v3v3(collmd->current_x[i], collmd->x[i], collmd->xnew[i], prevstep);
+        interp_v3_v3v3(collmd->current_xnew[i], collmd->x[i], collmd->xnew[i], step);
+        sub_v3_v3v3(collmd->current_v[i], collmd->current_xnew[i], collmd->current_x[i]);
+      }
+    });
+
+    bvhtree_update_from_mvert(collmd->bvhtree,
+                              collmd->current_xnew,
+                              collmd->current_x,
+                              reinterpret_cast<const int3 *>(collmd->vert_tris),
+                              collmd->tri_num,
+                              moving_bvh);
+  });
+
+  collmd->is_moved = true;
+  collmd->is_moved_bvh_moving = moving_bvh;
+  collmd->moved_step = step;
+  collmd->moved_prevstep = prevstep;
 }
 
 BVHTree *bvhtree_build_from_mvert(const float (*positions)[3],
@@ -126,33 +149,34 @@ void bvhtree_update_from_mvert(BVHTree *bvhtree,
     moving = false;
   }
 
-  for (int i = 0; i < tri_num; i++) {
-    float co[3][3];
-    bool ret;
+  /* Don't update more nodes than the tree has leaves. */
+  tri_num = std::min(tri_num, BLI_bvhtree_get_len(bvhtree));
 
-    copy_v3_v3(co[0], positions[vert_tris[i][0]]);
-    copy_v3_v3(co[1], positions[vert_tris[i][1]]);
-    copy_v3_v3(co[2], positions[vert_tris[i][2]]);
+  /* Leaf nodes are independent, so they are updated in parallel. */
+  blender::threading::parallel_for(
+      blender::IndexRange(tri_num), 1024, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          float co[3][3];
 
-    /* copy new locations into array */
-    if (moving) {
-      float co_moving[3][3];
-      /* update moving positions */
-      copy_v3_v3(co_moving[0], positions_moving[vert_tris[i][0]]);
-      copy_v3_v3(co_moving[1], positions_moving[vert_tris[i][1]]);
-      copy_v3_v3(co_moving[2], positions_moving[vert_tris[i][2]]);
+          copy_v3_v3(co[0], positions[vert_tris[i][0]]);
+          copy_v3_v3(co[1], positions[vert_tris[i][1]]);
+          copy_v3_v3(co[2], positions[vert_tris[i][2]]);
 
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], &co_moving[0][0], 3);
-    }
-    else {
-      ret = BLI_bvhtree_update_node(bvhtree, i, &co[0][0], nullptr, 3);
-    }
+          /* copy new locations into array */
+          if (moving) {
+            float co_moving[3][3];
+            /* update moving positions */
+            copy_v3_v3(co_moving[0], positions_moving[vert_tris[i][0]]);
+            copy_v3_v3(co_moving[1], positions_moving[vert_tris[i][1]]);
+            copy_v3_v3(co_moving[2], positions_moving[vert_tris[i][2]]);
 
-    /* check if tree is already full */
-    if (ret == false) {
-      break;
-    }
-  }
+            BLI_bvhtree_update_node(bvhtree, i, &co[0][0], &co_moving[0][0], 3);
+          }
+          else {
+            BLI_bvhtree_update_node(bvhtree, i, &co[0][0], nullptr, 3);
+          }
+        }
+      });
 
   BLI_bvhtree_update_tree(bvhtree);
 }
@@ -16,6 +16,7 @@
 #include "BLI_length_parameterize.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.hh"
+#include "BLI_math_matrix_batch.hh"
 #include "BLI_math_rotation_legacy.hh"
 #include "BLI_memory_counter.hh"
 #include "BLI_task.hh"
@@ -137,6 +138,7 @@ CurvesGeometry::CurvesGeometry(const CurvesGeometry &other)
                             other.runtime->evaluated_normal_cache,
                             other.runtime->max_material_index_cache,
                             other.runtime->custom_knot_offsets_cache,
+                            other.runtime->root_positions_kdtree_cache,
                             {},
                             true});
 
@@ -1196,6 +1198,7 @@ void CurvesGeometry::tag_positions_changed()
   this->runtime->evaluated_length_cache.tag_dirty();
   this->runtime->bounds_cache.tag_dirty();
   this->runtime->bounds_with_radius_cache.tag_dirty();
+  this->runtime->root_positions_kdtree_cache.tag_dirty();
 }
 void CurvesGeometry::tag_topology_changed()
 {
@@ -1231,9 +1234,7 @@ static void translate_positions(MutableSpan<float3> positions, const float3 &tra
 static void transform_positions(MutableSpan<float3> positions, const float4x4 &matrix)
 {
   threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
-    for (float3 &position : positions.slice(range)) {
-      position = math::transform_point(matrix, position);
-    }
+    math::transform_points(matrix, positions.slice(range));
   });
 }
 
@@ -1241,9 +1242,7 @@ static void transform_normals(MutableSpan<float3> normals, const float4x4 &matri
 {
   const float3x3 normal_transform = math::transpose(math::invert(float3x3(matrix)));
   threading::parallel_for(normals.index_range(), 1024, [&](const IndexRange range) {
-    for (float3 &normal : normals.slice(range)) {
-      normal = normal_transform * normal;
-    }
+    math::transform_directions(normal_transform, normals.slice(range));
   });
 }
 
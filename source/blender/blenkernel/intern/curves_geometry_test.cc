@@ -404,6 +404,36 @@ TEST(curves_geometry, NURBSEvaluation)
   }
 }
 
+TEST(curves_geometry, DeformationKeepsTopologyCaches)
+{
+  CurvesGeometry curves = create_basic_curves(40, 4);
+  curves.fill_curve_types(CURVE_TYPE_NURBS);
+  curves.resolution_for_write().fill(4);
+  curves.evaluated_positions();
+  EXPECT_TRUE(curves.runtime->evaluated_offsets_cache.is_cached());
+  EXPECT_TRUE(curves.runtime->nurbs_basis_cache.is_cached());
+
+  /* Deform a copy, like a modifier evaluating an original geometry. */
+  CurvesGeometry deformed = curves;
+  deformed.translate(float3(1.0f, 0.0f, 0.0f));
+  EXPECT_TRUE(deformed.runtime->evaluated_offsets_cache.is_cached());
+  EXPECT_TRUE(deformed.runtime->nurbs_basis_cache.is_cached());
+  EXPECT_TRUE(deformed.runtime->evaluated_position_cache.is_dirty());
+  EXPECT_TRUE(curves.runtime->evaluated_position_cache.is_cached());
+
+  const Span<float3> positions = curves.evaluated_positions();
+  const Span<float3> deformed_positions = deformed.evaluated_positions();
+  ASSERT_EQ(positions.size(), deformed_positions.size());
+  for (const int i : positions.index_range()) {
+    const float3 expected = positions[i] + float3(1.0f, 0.0f, 0.0f);
+    EXPECT_V3_NEAR(deformed_positions[i], expected, 1e-5f);
+  }
+
+  deformed.tag_topology_changed();
+  EXPECT_TRUE(deformed.runtime->evaluated_offsets_cache.is_dirty());
+  EXPECT_TRUE(curves.runtime->evaluated_offsets_cache.is_cached());
+}
+
 TEST(curves_geometry, BezierGenericEvaluation)
 {
   CurvesGeometry curves(3, 1);
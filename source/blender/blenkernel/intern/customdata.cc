@@ -37,6 +37,7 @@
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #ifndef NDEBUG
@@ -2567,6 +2568,7 @@ static void ensure_layer_data_is_mutable(CustomDataLayer &layer, const int totel
     /* Copy the layer before removing the user because otherwise the data might be freed while
      * we're still copying from it here. */
     layer.data = copy_layer_data(type, old_data, totelem);
+    blender::implicit_sharing::count_copy_on_write(int64_t(CustomData_sizeof(type)) * totelem);
     layer.sharing_info->remove_user_and_delete_if_last();
     layer.sharing_info = make_implicit_sharing_info_for_layer(type, layer.data, totelem);
   }
@@ -3569,6 +3571,142 @@ void CustomData_interp(const CustomData *source,
   }
 }
 
+/**
+ * Weighted sum of the sources of every destination item, for types that are interpolated
+ * linearly. Avoids the per-item callback and the source pointer arrays, so the compiler can
+ * vectorize the inner loop.
+ */
+template<typename T>
+static void interp_grouped_linear(const T *src,
+                                  T *dst,
+                                  const blender::OffsetIndices<int> src_offsets,
+                                  const Span<int> src_indices,
+                                  const Span<float> weights,
+                                  const Span<int> dest_indices)
+{
+  blender::threading::parallel_for(dest_indices.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange group = src_offsets[i];
+      T result(0);
+      if (weights.is_empty()) {
+        const float weight = 1.0f / group.size();
+        for (const int j : group) {
+          result += src[src_indices[j]] * weight;
+        }
+      }
+      else {
+        for (const int j : group) {
+          result += src[src_indices[j]] * weights[j];
+        }
+      }
+      dst[dest_indices[i]] = result;
+    }
+  });
+}
+
+/** Interpolate a layer through the generic per-item callback of its type. */
+static void interp_grouped_callback(const LayerTypeInfo &type_info,
+                                    const void *src_data,
+                                    void *dst_data,
+                                    const blender::OffsetIndices<int> src_offsets,
+                                    const Span<int> src_indices,
+                                    const Span<float> weights,
+                                    const Span<int> dest_indices)
+{
+  blender::threading::parallel_for(dest_indices.index_range(), 256, [&](const IndexRange range) {
+    Vector<const void *, SOURCE_BUF_SIZE> sources;
+    Vector<float, SOURCE_BUF_SIZE> default_weights;
+    for (const int i : range) {
+      const IndexRange group = src_offsets[i];
+      if (group.is_empty()) {
+        continue;
+      }
+      sources.clear();
+      for (const int j : group) {
+        sources.append(POINTER_OFFSET(src_data, size_t(src_indices[j]) * type_info.size));
+      }
+      const float *group_weights = nullptr;
+      if (weights.is_empty()) {
+        default_weights.resize(group.size());
+        default_weights.fill(1.0f / group.size());
+        group_weights = default_weights.data();
+      }
+      else {
+        group_weights = &weights[group.start()];
+      }
+      type_info.interp(sources.data(),
+                       group_weights,
+                       nullptr,
+                       group.size(),
+                       POINTER_OFFSET(dst_data, size_t(dest_indices[i]) * type_info.size));
+    }
+  });
+}
+
+void CustomData_interp_grouped(const CustomData *source,
+                               CustomData *dest,
+                               const blender::OffsetIndices<int> src_offsets,
+                               const Span<int> src_indices,
+                               const Span<float> weights,
+                               const Span<int> dest_indices)
+{
+  BLI_assert(src_offsets.size() == dest_indices.size());
+  BLI_assert(weights.is_empty() || weights.size() == src_indices.size());
+  if (dest_indices.is_empty()) {
+    return;
+  }
+
+  /* Same layer matching as #CustomData_interp. */
+  int dest_i = 0;
+  for (int src_i = 0; src_i < source->totlayer; src_i++) {
+    const eCustomDataType type = eCustomDataType(source->layers[src_i].type);
+    const LayerTypeInfo *typeInfo = layerType_getInfo(type);
+    if (!typeInfo->interp) {
+      continue;
+    }
+    while (dest_i < dest->totlayer && dest->layers[dest_i].type < type) {
+      dest_i++;
+    }
+    if (dest_i >= dest->totlayer) {
+      break;
+    }
+    if (dest->layers[dest_i].type != type) {
+      continue;
+    }
+
+    const void *src_data = source->layers[src_i].data;
+    void *dst_data = dest->layers[dest_i].data;
+    const auto interp_linear = [&](auto dummy) {
+      using T = decltype(dummy);
+      interp_grouped_linear<T>(static_cast<const T *>(src_data),
+                               static_cast<T *>(dst_data),
+                               src_offsets,
+                               src_indices,
+                               weights,
+                               dest_indices);
+    };
+    switch (type) {
+      case CD_PROP_FLOAT:
+        interp_linear(float());
+        break;
+      case CD_PROP_FLOAT2:
+        interp_linear(blender::float2());
+        break;
+      case CD_PROP_FLOAT3:
+        interp_linear(blender::float3());
+        break;
+      case CD_PROP_COLOR:
+        interp_linear(blender::float4());
+        break;
+      default:
+        interp_grouped_callback(
+            *typeInfo, src_data, dst_data, src_offsets, src_indices, weights, dest_indices);
+        break;
+    }
+    dest_i++;
+  }
+}
+
 void CustomData_swap_corners(CustomData *data, const int index, const int *corner_indices)
 {
   for (int i = 0; i < data->totlayer; i++) {
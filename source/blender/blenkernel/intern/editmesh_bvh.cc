@@ -11,6 +11,7 @@
 #include "BLI_kdopbvh.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
+#include "BLI_vector.hh"
 
 #include "BKE_editmesh.hh"
 
@@ -51,12 +52,12 @@ BMBVHTree *BKE_bmbvh_new_ex(BMesh *bm,
   const float epsilon = FLT_EPSILON * 2.0f;
 
   BMBVHTree *bmtree = MEM_new<BMBVHTree>("BMBVHTree");
-  float cos[3][3];
-  int tottri;
 
   /* avoid testing every tri */
   BMFace *f_test, *f_test_prev;
   bool test_fn_ret;
+  /* Triangles to insert in the tree, when only some of them pass the test. */
+  blender::Vector<int> tri_indices;
 
   /* BKE_editmesh_looptris_calc() must be called already */
   BLI_assert(looptris.size() != 0 || bm->totface == 0);
@@ -78,7 +79,6 @@ BMBVHTree *BKE_bmbvh_new_ex(BMesh *bm,
     f_test_prev = nullptr;
     test_fn_ret = false;
 
-    tottri = 0;
     for (const int i : looptris.index_range()) {
       f_test = looptris[i][0]->f;
       if (f_test != f_test_prev) {
@@ -87,46 +87,24 @@ BMBVHTree *BKE_bmbvh_new_ex(BMesh *bm,
       }
 
       if (test_fn_ret) {
-        tottri++;
+        /* NOTE: the arrays won't align now! Take care. */
+        tri_indices.append(i);
       }
     }
   }
-  else {
-    tottri = looptris.size();
-  }
+  const int tottri = test_fn ? int(tri_indices.size()) : int(looptris.size());
 
   bmtree->tree = BLI_bvhtree_new(tottri, epsilon, 8, 8);
 
-  f_test_prev = nullptr;
-  test_fn_ret = false;
-
-  for (const int i : looptris.index_range()) {
-    if (test_fn) {
-      /* NOTE: the arrays won't align now! Take care. */
-      f_test = looptris[i][0]->f;
-      if (f_test != f_test_prev) {
-        test_fn_ret = test_fn(f_test, user_data);
-        f_test_prev = f_test;
-      }
-
-      if (!test_fn_ret) {
-        continue;
-      }
-    }
-
-    if (cos_cage) {
-      copy_v3_v3(cos[0], cos_cage[BM_elem_index_get(looptris[i][0]->v)]);
-      copy_v3_v3(cos[1], cos_cage[BM_elem_index_get(looptris[i][1]->v)]);
-      copy_v3_v3(cos[2], cos_cage[BM_elem_index_get(looptris[i][2]->v)]);
-    }
-    else {
-      copy_v3_v3(cos[0], looptris[i][0]->v->co);
-      copy_v3_v3(cos[1], looptris[i][1]->v->co);
-      copy_v3_v3(cos[2], looptris[i][2]->v->co);
-    }
-
-    BLI_bvhtree_insert(bmtree->tree, i, (float *)cos, 3);
-  }
+  BLI_bvhtree_insert_parallel(
+      bmtree->tree, tottri, 3, [&](const int tri, blender::float3 *r_co) {
+        const int i = test_fn ? tri_indices[tri] : tri;
+        for (const int j : blender::IndexRange(3)) {
+          r_co[j] = cos_cage ? cos_cage[BM_elem_index_get(looptris[i][j]->v)] :
+                               blender::float3(looptris[i][j]->v->co);
+        }
+        return i;
+      });
 
   BLI_bvhtree_balance(bmtree->tree);
 
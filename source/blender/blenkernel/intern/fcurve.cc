@@ -21,9 +21,11 @@
 
 #include "BLI_easing.h"
 #include "BLI_ghash.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_mutex.hh"
 #include "BLI_rect.h"
 #include "BLI_sort_utils.h"
 #include "BLI_string.h"
@@ -78,7 +80,11 @@ void BKE_fcurve_free(FCurve *fcu)
   }
 
   /* Free curve data. */
-  MEM_SAFE_FREE(fcu->bezt);
+  if (fcu->bezt != fcu->bezt_shared) {
+    MEM_SAFE_FREE(fcu->bezt);
+  }
+  fcu->bezt = nullptr;
+  blender::implicit_sharing::free_shared_data(&fcu->bezt_shared, &fcu->bezt_sharing_info);
   MEM_SAFE_FREE(fcu->fpt);
 
   /* Free RNA-path, as this were allocated when getting the path string. */
@@ -133,6 +139,8 @@ FCurve *BKE_fcurve_copy(const FCurve *fcu)
   /* Copy curve data. */
   fcu_d->bezt = static_cast<BezTriple *>(MEM_dupallocN(fcu_d->bezt));
   fcu_d->fpt = static_cast<FPoint *>(MEM_dupallocN(fcu_d->fpt));
+  fcu_d->bezt_shared = nullptr;
+  fcu_d->bezt_sharing_info = nullptr;
 
   /* Copy rna-path. */
   fcu_d->rna_path = static_cast<char *>(MEM_dupallocN(fcu_d->rna_path));
@@ -147,6 +155,48 @@ FCurve *BKE_fcurve_copy(const FCurve *fcu)
   return fcu_d;
 }
 
+/** Protects the keyframe snapshots of original F-Curves, depsgraphs can be evaluated in parallel.
+ */
+static blender::Mutex fcurve_shared_keyframes_mutex;
+
+void BKE_fcurve_share_keyframes_for_eval(FCurve &fcu_eval, FCurve &fcu_orig)
+{
+  using namespace blender;
+  BLI_assert(fcu_eval.bezt_sharing_info == nullptr);
+  if (fcu_orig.bezt == nullptr || fcu_eval.bezt == nullptr) {
+    return;
+  }
+
+  std::lock_guard lock(fcurve_shared_keyframes_mutex);
+
+  /* The snapshot is compared with the keyframes, which are modified in place by many operators
+   * without any way to detect it. Comparing is still much cheaper than keeping a copy per
+   * depsgraph. */
+  const size_t size = MEM_allocN_len(fcu_orig.bezt);
+  if (fcu_orig.bezt_sharing_info != nullptr) {
+    if (MEM_allocN_len(fcu_orig.bezt_shared) != size ||
+        memcmp(fcu_orig.bezt_shared, fcu_orig.bezt, size) != 0)
+    {
+      implicit_sharing::free_shared_data(&fcu_orig.bezt_shared, &fcu_orig.bezt_sharing_info);
+    }
+  }
+
+  if (fcu_orig.bezt_sharing_info == nullptr) {
+    /* The keyframes were just copied, use that copy as the new snapshot. */
+    fcu_orig.bezt_shared = fcu_eval.bezt;
+    fcu_orig.bezt_sharing_info = implicit_sharing::info_for_mem_free(fcu_eval.bezt);
+  }
+  else {
+    MEM_freeN(fcu_eval.bezt);
+  }
+
+  implicit_sharing::copy_shared_pointer(fcu_orig.bezt_shared,
+                                        fcu_orig.bezt_sharing_info,
+                                        &fcu_eval.bezt_shared,
+                                        &fcu_eval.bezt_sharing_info);
+  fcu_eval.bezt = fcu_eval.bezt_shared;
+}
+
 void BKE_fcurves_copy(ListBase *dst, ListBase *src)
 {
   /* Sanity checks. */
@@ -2584,6 +2634,8 @@ void BKE_fcurve_blend_read_data(BlendDataReader *reader, FCurve *fcu)
   /* curve data */
   BLO_read_struct_array(reader, BezTriple, fcu->totvert, &fcu->bezt);
   BLO_read_struct_array(reader, FPoint, fcu->totvert, &fcu->fpt);
+  fcu->bezt_shared = nullptr;
+  fcu->bezt_sharing_info = nullptr;
 
   /* rna path */
   BLO_read_string(reader, &fcu->rna_path);
@@ -21,6 +21,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_mutex.hh"
+#include "BLI_string.h"
 #include "BLI_string_utf8.h"
 #include "BLI_string_utils.hh"
 #include "BLI_utildefines.h"
@@ -51,6 +52,7 @@
 
 #include <algorithm>
 #include <cstring>
+#include <string>
 
 #ifdef WITH_PYTHON
 static blender::Mutex python_driver_lock;
@@ -144,6 +146,65 @@ bool driver_get_target_property(const DriverTargetContext *driver_target_context
   return true;
 }
 
+bool driver_resolve_variable_attribute(PointerRNA *target_ptr,
+                                       const DriverVar *dvar,
+                                       const char *attribute_path,
+                                       PointerRNA *r_ptr,
+                                       PropertyRNA **r_prop,
+                                       int *r_index,
+                                       char **r_rna_path)
+{
+  if (!ELEM(dvar->type, DVAR_TYPE_SINGLE_PROP, DVAR_TYPE_CONTEXT_PROP)) {
+    return false;
+  }
+
+  const DriverTarget *dtar = &dvar->targets[0];
+  std::string rna_path = dtar->rna_path ? dtar->rna_path : "";
+  if (!rna_path.empty() && attribute_path[0] != '[') {
+    rna_path += '.';
+  }
+  rna_path += attribute_path;
+
+  if (!RNA_path_resolve_property_full(target_ptr, rna_path.c_str(), r_ptr, r_prop, r_index)) {
+    /* Python exposes vector properties as math types, which name their components. */
+    const char component = rna_path.back();
+    if (rna_path.size() < 3 || rna_path[rna_path.size() - 2] != '.' ||
+        !ELEM(component, 'x', 'y', 'z', 'w'))
+    {
+      return false;
+    }
+    rna_path.resize(rna_path.size() - 2);
+
+    if (!RNA_path_resolve_property_full(target_ptr, rna_path.c_str(), r_ptr, r_prop, r_index) ||
+        *r_index != -1 || !RNA_property_array_check(*r_prop))
+    {
+      return false;
+    }
+
+    int index = (component == 'w') ? 3 : component - 'x';
+    /* Quaternions are stored in `(w, x, y, z)` order. */
+    if (RNA_property_subtype(*r_prop) == PROP_QUATERNION) {
+      index = (component == 'w') ? 0 : component - 'x' + 1;
+    }
+    *r_index = index;
+    rna_path += "[" + std::to_string(index) + "]";
+  }
+
+  if (!ELEM(RNA_property_type(*r_prop), PROP_BOOLEAN, PROP_INT, PROP_FLOAT, PROP_ENUM)) {
+    return false;
+  }
+  if (RNA_property_array_check(*r_prop) &&
+      (*r_index < 0 || *r_index >= RNA_property_array_length(r_ptr, *r_prop)))
+  {
+    return false;
+  }
+
+  if (r_rna_path) {
+    *r_rna_path = BLI_strdupn(rna_path.c_str(), rna_path.size());
+  }
+  return true;
+}
+
 /**
  * Checks if the fallback value can be used, and if so, sets dtar flags to signal its usage.
  * The caller is expected to immediately return the fallback value if this returns true.
@@ -1132,27 +1193,103 @@ static bool driver_check_simple_expr_depends_on_time(const ExprPyLike_Parsed *ex
   return BLI_expr_pylike_is_using_param(expr, VAR_INDEX_FRAME);
 }
 
+static DriverVar *driver_find_variable_by_param_index(ChannelDriver *driver, int param_index)
+{
+  if (param_index < VAR_INDEX_CUSTOM) {
+    return nullptr;
+  }
+  return static_cast<DriverVar *>(
+      BLI_findlink(&driver->variables, param_index - VAR_INDEX_CUSTOM));
+}
+
+/* Get the value of an attribute access on a variable, like `var.location[0]`.
+ * Returns false when it can't be evaluated here, leaving it to Python. */
+static bool driver_get_variable_attribute_value(const AnimationEvalContext *anim_eval_context,
+                                                DriverVar *dvar,
+                                                const char *attribute_path,
+                                                double *r_value)
+{
+  const DriverTargetContext driver_target_context = driver_target_context_from_animation_context(
+      anim_eval_context);
+  PointerRNA target_ptr;
+  if (!driver_get_target_property(&driver_target_context, dvar, &dvar->targets[0], &target_ptr))
+  {
+    return false;
+  }
+
+  PointerRNA ptr;
+  PropertyRNA *prop;
+  int index;
+  if (!driver_resolve_variable_attribute(
+          &target_ptr, dvar, attribute_path, &ptr, &prop, &index, nullptr))
+  {
+    return false;
+  }
+
+  const bool is_array = RNA_property_array_check(prop);
+  switch (RNA_property_type(prop)) {
+    case PROP_BOOLEAN:
+      *r_value = is_array ? RNA_property_boolean_get_index(&ptr, prop, index) :
+                            RNA_property_boolean_get(&ptr, prop);
+      return true;
+    case PROP_INT:
+      *r_value = is_array ? RNA_property_int_get_index(&ptr, prop, index) :
+                            RNA_property_int_get(&ptr, prop);
+      return true;
+    case PROP_FLOAT:
+      *r_value = is_array ? RNA_property_float_get_index(&ptr, prop, index) :
+                            RNA_property_float_get(&ptr, prop);
+      return true;
+    case PROP_ENUM:
+      *r_value = RNA_property_enum_get(&ptr, prop);
+      return true;
+    default:
+      return false;
+  }
+}
+
 static bool driver_evaluate_simple_expr(const AnimationEvalContext *anim_eval_context,
                                         ChannelDriver *driver,
                                         ExprPyLike_Parsed *expr,
                                         float *result,
                                         float time)
 {
-  /* Prepare parameter values. */
+  /* Prepare parameter values, followed by the values of attribute accesses on them. */
   int vars_len = BLI_listbase_count(&driver->variables);
-  double *vars = static_cast<double *>(BLI_array_alloca(vars, vars_len + VAR_INDEX_CUSTOM));
+  const int attributes_len = BLI_expr_pylike_attributes_len(expr);
+  const int values_len = vars_len + VAR_INDEX_CUSTOM + attributes_len;
+  double *vars = static_cast<double *>(BLI_array_alloca(vars, values_len));
   int i = VAR_INDEX_CUSTOM;
 
   vars[VAR_INDEX_FRAME] = time;
 
   LISTBASE_FOREACH (DriverVar *, dvar, &driver->variables) {
+    /* Variables only used to access attributes don't need to resolve to a number. */
+    if (!BLI_expr_pylike_is_using_param(expr, i) &&
+        BLI_expr_pylike_is_using_attribute_of_param(expr, i))
+    {
+      vars[i++] = 0.0;
+      continue;
+    }
     vars[i++] = driver_get_variable_value(anim_eval_context, driver, dvar);
   }
 
+  for (int attribute_index = 0; attribute_index < attributes_len; attribute_index++) {
+    int param_index;
+    const char *attribute_path = BLI_expr_pylike_attribute_get(
+        expr, attribute_index, &param_index);
+    DriverVar *dvar = driver_find_variable_by_param_index(driver, param_index);
+    if (dvar == nullptr ||
+        !driver_get_variable_attribute_value(anim_eval_context, dvar, attribute_path, &vars[i++]))
+    {
+      /* Let Python evaluate the expression, or report the error. */
+      return false;
+    }
+  }
+
   /* Evaluate expression. */
   double result_val;
-  eExprPyLike_EvalStatus status = BLI_expr_pylike_eval(
-      expr, vars, vars_len + VAR_INDEX_CUSTOM, &result_val);
+  eExprPyLike_EvalStatus status = BLI_expr_pylike_eval(expr, vars, values_len, &result_val);
   const char *message;
 
   switch (status) {
@@ -1222,6 +1359,26 @@ bool BKE_driver_has_simple_expression(ChannelDriver *driver)
   return driver_compile_simple_expr(driver) && BLI_expr_pylike_is_valid(driver->expr_simple);
 }
 
+void BKE_driver_simple_expression_foreach_attribute(
+    ChannelDriver *driver,
+    void (*callback)(DriverVar *dvar, const char *attribute_path, void *user_data),
+    void *user_data)
+{
+  if (!BKE_driver_has_simple_expression(driver)) {
+    return;
+  }
+
+  const ExprPyLike_Parsed *expr = driver->expr_simple;
+  const int attributes_len = BLI_expr_pylike_attributes_len(expr);
+  for (int i = 0; i < attributes_len; i++) {
+    int param_index;
+    const char *attribute_path = BLI_expr_pylike_attribute_get(expr, i, &param_index);
+    if (DriverVar *dvar = driver_find_variable_by_param_index(driver, param_index)) {
+      callback(dvar, attribute_path, user_data);
+    }
+  }
+}
+
 /* TODO(sergey): This is somewhat weak, but we don't want neither false-positive
  * time dependencies nor special exceptions in the depsgraph evaluation. */
 static bool python_driver_exression_depends_on_time(const char *expression)
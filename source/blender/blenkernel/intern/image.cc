@@ -2681,6 +2681,14 @@ bool BKE_imbuf_write_stamp(const Scene *scene,
   return BKE_imbuf_write(ibuf, filepath, imf);
 }
 
+static int openanim_flags(int flags)
+{
+  if (U.sequencer_editor_flag & USER_SEQ_ED_HARDWARE_DECODE) {
+    flags |= IB_anim_hw_decode;
+  }
+  return flags;
+}
+
 MovieReader *openanim_noload(const char *filepath,
                              int flags,
                              int streamindex,
@@ -2688,7 +2696,7 @@ MovieReader *openanim_noload(const char *filepath,
 {
   MovieReader *anim;
 
-  anim = MOV_open_file(filepath, flags, streamindex, colorspace);
+  anim = MOV_open_file(filepath, openanim_flags(flags), streamindex, colorspace);
   return anim;
 }
 
@@ -2700,7 +2708,7 @@ MovieReader *openanim(const char *filepath,
   MovieReader *anim;
   ImBuf *ibuf;
 
-  anim = MOV_open_file(filepath, flags, streamindex, colorspace);
+  anim = MOV_open_file(filepath, openanim_flags(flags), streamindex, colorspace);
   if (anim == nullptr) {
     return nullptr;
   }
@@ -4012,14 +4020,23 @@ static void image_add_view(Image *ima, const char *viewname, const char *filepat
 /* After imbuf load, OpenEXR type can return with a EXR-handle open
  * in that case we have to build a render-result. */
 #ifdef WITH_IMAGE_OPENEXR
-static void image_create_multilayer(Image *ima, ImBuf *ibuf, int framenr)
+static void image_create_multilayer(Image *ima,
+                                    ImBuf *ibuf,
+                                    int framenr,
+                                    const char *lazy_read_filepath)
 {
   const char *colorspace = ima->colorspace_settings.name;
   bool predivide = (ima->alpha_mode == IMA_ALPHA_PREMUL);
 
   /* only load rr once for multiview */
   if (!ima->rr) {
-    ima->rr = RE_MultilayerConvert(ibuf->userdata, colorspace, predivide, ibuf->x, ibuf->y);
+    if (lazy_read_filepath) {
+      ima->rr = RE_MultilayerConvertLazy(
+          ibuf->userdata, lazy_read_filepath, colorspace, predivide, ibuf->x, ibuf->y);
+    }
+    else {
+      ima->rr = RE_MultilayerConvert(ibuf->userdata, colorspace, predivide, ibuf->x, ibuf->y);
+    }
   }
 
   IMB_exr_close(ibuf->userdata);
@@ -4115,6 +4132,9 @@ static ImBuf *image_load_sequence_multilayer(Image *ima, ImageUser *iuser, int e
   }
   if (ima->rr) {
     RenderPass *rpass = BKE_image_multilayer_index(ima->rr, iuser);
+    if (rpass) {
+      RE_pass_ensure_loaded(ima->rr, rpass);
+    }
 
     if (rpass && rpass->ibuf) {
       ibuf = rpass->ibuf;
@@ -4243,6 +4263,9 @@ static ImBuf *load_image_single(Image *ima,
   char filepath[FILE_MAX];
   ImBuf *ibuf = nullptr;
   int flag = IB_byte_data | IB_multilayer | IB_metadata | imbuf_alpha_flags_for_image(ima);
+  /* Passes of multi-layer files are read from the file once they are used, which is much faster
+   * when only a few of many passes are viewed. */
+  bool is_multilayer_lazy = false;
 
   *r_cache_ibuf = true;
   const int tile_number = image_get_tile_number_from_iuser(ima, iuser);
@@ -4287,7 +4310,9 @@ static ImBuf *load_image_single(Image *ima,
     BKE_image_user_file_path(&iuser_t, ima, filepath);
 
     /* read ibuf */
-    ibuf = IMB_load_image_from_filepath(filepath, flag, ima->colorspace_settings.name);
+    is_multilayer_lazy = true;
+    ibuf = IMB_load_image_from_filepath(
+        filepath, flag | IB_multilayer_lazy, ima->colorspace_settings.name);
   }
 
   if (ibuf) {
@@ -4296,7 +4321,7 @@ static ImBuf *load_image_single(Image *ima,
       /* Handle multilayer and multiview cases, don't assign ibuf here.
        * will be set layer in BKE_image_acquire_ibuf from ima->rr. */
       if (IMB_exr_has_multilayer(ibuf->userdata)) {
-        image_create_multilayer(ima, ibuf, cfra);
+        image_create_multilayer(ima, ibuf, cfra, is_multilayer_lazy ? filepath : nullptr);
         ima->type = IMA_TYPE_MULTILAYER;
         IMB_freeImBuf(ibuf);
         ibuf = nullptr;
@@ -4414,6 +4439,9 @@ static ImBuf *image_get_ibuf_multilayer(Image *ima, ImageUser *iuser)
   }
   if (ima->rr) {
     RenderPass *rpass = BKE_image_multilayer_index(ima->rr, iuser);
+    if (rpass) {
+      RE_pass_ensure_loaded(ima->rr, rpass);
+    }
 
     if (rpass && rpass->ibuf) {
       ibuf = rpass->ibuf;
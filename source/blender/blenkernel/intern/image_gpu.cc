@@ -8,6 +8,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include <algorithm>
+
 #include "BLI_boxpack_2d.h"
 #include "BLI_linklist.h"
 #include "BLI_listbase.h"
@@ -15,6 +17,7 @@
 #include "BLI_rect.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "DNA_image_types.h"
 #include "DNA_userdef_types.h"
@@ -578,6 +581,77 @@ void BKE_image_free_anim_gputextures(Main *bmain)
   }
 }
 
+/**
+ * When the free GPU memory drops below this fraction of the total, textures of the least recently
+ * used images are freed, regardless of the texture time-out.
+ */
+#define IMAGE_GPU_MEMORY_FREE_FRACTION_MIN 0.1
+
+/** Approximate GPU memory used by the textures of the image, in kilobytes. */
+static int64_t image_gpu_textures_memory_kb_estimate(const Image *ima)
+{
+  int64_t size = 0;
+  for (int eye = 0; eye < 2; eye++) {
+    for (int i = 0; i < TEXTARGET_COUNT; i++) {
+      const GPUTexture *tex = ima->gputexture[i][eye];
+      if (tex == nullptr) {
+        continue;
+      }
+      const int64_t component_size = GPU_texture_has_float_format(tex) ? 4 : 1;
+      int64_t tex_size = int64_t(GPU_texture_width(tex)) * int64_t(GPU_texture_height(tex)) *
+                         std::max(GPU_texture_layer_count(tex), 1) *
+                         int64_t(GPU_texture_component_len(GPU_texture_format(tex))) *
+                         component_size;
+      if (GPU_texture_mip_count(tex) > 1) {
+        /* The mipmap chain adds a third of the size of the first level. */
+        tex_size += tex_size / 3;
+      }
+      size += tex_size;
+    }
+  }
+  return size / 1024;
+}
+
+/**
+ * Free the GPU textures of the least recently used images until the estimated amount of memory
+ * that is needed to get back above #IMAGE_GPU_MEMORY_FREE_FRACTION_MIN is freed. Images that were
+ * used during the last second are kept, as they are likely still drawn.
+ */
+static void image_free_gputextures_over_budget(Main *bmain, const int ctime)
+{
+  if (!GPU_mem_stats_supported()) {
+    return;
+  }
+  int total_mem_kb = 0;
+  int free_mem_kb = 0;
+  GPU_mem_stats_get(&total_mem_kb, &free_mem_kb);
+  const int64_t free_mem_min_kb = int64_t(total_mem_kb * IMAGE_GPU_MEMORY_FREE_FRACTION_MIN);
+  if (total_mem_kb <= 0 || free_mem_kb >= free_mem_min_kb) {
+    return;
+  }
+
+  blender::Vector<Image *> images;
+  LISTBASE_FOREACH (Image *, ima, &bmain->images) {
+    if ((ima->flag & IMA_NOCOLLECT) == 0 && ctime - ima->lastused > 1 &&
+        BKE_image_has_opengl_texture(ima))
+    {
+      images.append(ima);
+    }
+  }
+  std::sort(images.begin(), images.end(), [](const Image *a, const Image *b) {
+    return a->lastused < b->lastused;
+  });
+
+  int64_t mem_to_free_kb = free_mem_min_kb - free_mem_kb;
+  for (Image *ima : images) {
+    if (mem_to_free_kb <= 0) {
+      break;
+    }
+    mem_to_free_kb -= image_gpu_textures_memory_kb_estimate(ima);
+    BKE_image_free_gputextures(ima);
+  }
+}
+
 void BKE_image_free_old_gputextures(Main *bmain)
 {
   static int lasttime = 0;
@@ -587,12 +661,19 @@ void BKE_image_free_old_gputextures(Main *bmain)
    * Run garbage collector once for every collecting period of time
    * if textimeout is 0, that's the option to NOT run the collector
    */
-  if (U.textimeout == 0 || ctime % U.texcollectrate || ctime == lasttime) {
+  /* of course not! */
+  if (G.is_rendering) {
     return;
   }
 
-  /* of course not! */
-  if (G.is_rendering) {
+  /* Check the memory budget once a second, independent of the collector settings. */
+  static int lasttime_budget = 0;
+  if (ctime != lasttime_budget) {
+    lasttime_budget = ctime;
+    image_free_gputextures_over_budget(bmain, ctime);
+  }
+
+  if (U.textimeout == 0 || ctime % U.texcollectrate || ctime == lasttime) {
     return;
   }
 
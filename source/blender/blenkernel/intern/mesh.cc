@@ -27,6 +27,7 @@
 #include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.hh"
+#include "BLI_math_matrix_batch.hh"
 #include "BLI_math_vector.hh"
 #include "BLI_memory_counter.hh"
 #include "BLI_resource_scope.hh"
@@ -159,6 +160,8 @@ static void mesh_copy_data(Main *bmain,
   mesh_dst->runtime->vert_to_face_map_cache = mesh_src->runtime->vert_to_face_map_cache;
   mesh_dst->runtime->vert_to_corner_map_cache = mesh_src->runtime->vert_to_corner_map_cache;
   mesh_dst->runtime->corner_to_face_map_cache = mesh_src->runtime->corner_to_face_map_cache;
+  mesh_dst->runtime->vert_to_edge_map_cache = mesh_src->runtime->vert_to_edge_map_cache;
+  mesh_dst->runtime->edge_to_face_map_cache = mesh_src->runtime->edge_to_face_map_cache;
   mesh_dst->runtime->bvh_cache_verts = mesh_src->runtime->bvh_cache_verts;
   mesh_dst->runtime->bvh_cache_edges = mesh_src->runtime->bvh_cache_edges;
   mesh_dst->runtime->bvh_cache_faces = mesh_src->runtime->bvh_cache_faces;
@@ -501,7 +504,7 @@ IDTypeInfo IDType_ID_ME = {
     /*name*/ "Mesh",
     /*name_plural*/ N_("meshes"),
     /*translation_context*/ BLT_I18NCONTEXT_ID_MESH,
-    /*flags*/ IDTYPE_FLAGS_APPEND_IS_REUSABLE,
+    /*flags*/ IDTYPE_FLAGS_APPEND_IS_REUSABLE | IDTYPE_FLAGS_THREADSAFE_BLEND_WRITE,
     /*asset_type_info*/ nullptr,
 
     /*init_data*/ mesh_init_data,
@@ -1440,9 +1443,7 @@ namespace blender::bke {
 static void transform_positions(MutableSpan<float3> positions, const float4x4 &matrix)
 {
   threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
-    for (float3 &position : positions.slice(range)) {
-      position = math::transform_point(matrix, position);
-    }
+    math::transform_points(matrix, positions.slice(range));
   });
 }
 
@@ -1459,9 +1460,7 @@ static void transform_normals(MutableSpan<float3> normals, const float4x4 &matri
 {
   const float3x3 normal_transform = math::transpose(math::invert(float3x3(matrix)));
   threading::parallel_for(normals.index_range(), 1024, [&](const IndexRange range) {
-    for (float3 &normal : normals.slice(range)) {
-      normal = normal_transform * normal;
-    }
+    math::transform_directions(normal_transform, normals.slice(range));
   });
 }
 
@@ -47,22 +47,81 @@ static void reserve_hash_maps(const Mesh &mesh,
       edge_maps, [&](EdgeMap &edge_map) { edge_map.reserve(totedge_guess / edge_maps.size()); });
 }
 
+/**
+ * Add edges to the hash maps they belong to, without having every map look at every edge. The
+ * edges are first distributed into buckets for each map in parallel, then every map adds the edges
+ * from its buckets. This is done in blocks to limit the memory used by the buckets.
+ *
+ * The buckets are filled for fixed chunks of the input and processed in order, so the edges are
+ * added to every map in the same order as when adding them sequentially. That keeps the resulting
+ * edge order deterministic.
+ *
+ * \param gather_edges: Called with a range of the input and a function to pass each edge to.
+ */
+template<typename GatherFn>
+static void add_edges_to_hash_maps(const int64_t items_num,
+                                   const int64_t chunk_size,
+                                   const uint32_t parallel_mask,
+                                   MutableSpan<EdgeMap> edge_maps,
+                                   const GatherFn &gather_edges)
+{
+  if (edge_maps.size() == 1) {
+    EdgeMap &edge_map = edge_maps.first();
+    gather_edges(IndexRange(items_num), [&](const OrderedEdge &edge) { edge_map.add(edge); });
+    return;
+  }
+
+  const int64_t maps_num = edge_maps.size();
+  constexpr int64_t chunks_per_block = 64;
+  const int64_t block_size = chunk_size * chunks_per_block;
+  /* Edges of every chunk in the current block for every map, indexed by
+   * `chunk * maps_num + map`. The vectors are reused to avoid reallocating them for each block. */
+  Array<Vector<OrderedEdge>> buckets(chunks_per_block * maps_num);
+
+  for (int64_t block_start = 0; block_start < items_num; block_start += block_size) {
+    const IndexRange block = IndexRange::from_begin_end(
+        block_start, std::min(block_start + block_size, items_num));
+    const int64_t chunks_num = (block.size() + chunk_size - 1) / chunk_size;
+
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        MutableSpan<Vector<OrderedEdge>> chunk_buckets = buckets.as_mutable_span().slice(
+            chunk * maps_num, maps_num);
+        const IndexRange chunk_range = block.slice(
+            chunk * chunk_size, std::min(chunk_size, block.size() - chunk * chunk_size));
+        gather_edges(chunk_range, [&](const OrderedEdge &edge) {
+          chunk_buckets[parallel_mask & edge_hash_2(edge)].append(edge);
+        });
+      }
+    });
+
+    threading::parallel_for(edge_maps.index_range(), 1, [&](const IndexRange maps) {
+      for (const int64_t map_index : maps) {
+        EdgeMap &edge_map = edge_maps[map_index];
+        for (const int64_t chunk : IndexRange(chunks_num)) {
+          Vector<OrderedEdge> &bucket = buckets[chunk * maps_num + map_index];
+          for (const OrderedEdge &edge : bucket) {
+            edge_map.add(edge);
+          }
+          bucket.clear();
+        }
+      }
+    });
+  }
+}
+
 static void add_existing_edges_to_hash_maps(const Mesh &mesh,
                                             const uint32_t parallel_mask,
                                             MutableSpan<EdgeMap> edge_maps)
 {
   /* Assume existing edges are valid. */
   const Span<int2> edges = mesh.edges();
-  threading::parallel_for_each(edge_maps, [&](EdgeMap &edge_map) {
-    const int task_index = &edge_map - edge_maps.data();
-    for (const int2 edge : edges) {
-      const OrderedEdge ordered_edge(edge);
-      /* Only add the edge when it belongs into this map. */
-      if (task_index == (parallel_mask & edge_hash_2(ordered_edge))) {
-        edge_map.add(ordered_edge);
-      }
-    }
-  });
+  add_edges_to_hash_maps(
+      edges.size(), 8192, parallel_mask, edge_maps, [&](const IndexRange range, const auto &add) {
+        for (const int2 edge : edges.slice(range)) {
+          add(OrderedEdge(edge));
+        }
+      });
 }
 
 static void add_face_edges_to_hash_maps(const Mesh &mesh,
@@ -71,24 +130,20 @@ static void add_face_edges_to_hash_maps(const Mesh &mesh,
 {
   const OffsetIndices<int> faces = mesh.faces();
   const Span<int> corner_verts = mesh.corner_verts();
-  threading::parallel_for_each(edge_maps, [&](EdgeMap &edge_map) {
-    const int task_index = &edge_map - edge_maps.data();
-    for (const int face_i : faces.index_range()) {
-      const IndexRange face = faces[face_i];
-      for (const int corner : face) {
-        const int vert = corner_verts[corner];
-        const int vert_prev = corner_verts[bke::mesh::face_corner_prev(face, corner)];
-        /* Can only be the same when the mesh data is invalid. */
-        if (LIKELY(vert_prev != vert)) {
-          const OrderedEdge ordered_edge(vert_prev, vert);
-          /* Only add the edge when it belongs into this map. */
-          if (task_index == (parallel_mask & edge_hash_2(ordered_edge))) {
-            edge_map.add(ordered_edge);
+  add_edges_to_hash_maps(
+      faces.size(), 2048, parallel_mask, edge_maps, [&](const IndexRange range, const auto &add) {
+        for (const int face_i : range) {
+          const IndexRange face = faces[face_i];
+          for (const int corner : face) {
+            const int vert = corner_verts[corner];
+            const int vert_prev = corner_verts[bke::mesh::face_corner_prev(face, corner)];
+            /* Can only be the same when the mesh data is invalid. */
+            if (LIKELY(vert_prev != vert)) {
+              add(OrderedEdge(vert_prev, vert));
+            }
           }
         }
-      }
-    }
-  });
+      });
 }
 
 static void serialize_and_initialize_deduplicated_edges(MutableSpan<EdgeMap> edge_maps,
@@ -144,10 +199,11 @@ static int get_parallel_maps_count(const Mesh &mesh)
   if (mesh.faces_num < 1000) {
     return 1;
   }
-  /* Use at most 8 separate hash tables. Using more threads has diminishing returns. These threads
-   * are better off doing something more useful instead. */
+  /* Every map only processes its own edges, so more maps allow using more threads. Beyond that,
+   * the number of maps has diminishing returns because the face corners have to be read again to
+   * find the edge indices. */
   const int system_thread_count = BLI_system_thread_count();
-  return power_of_2_min_i(std::min(8, system_thread_count));
+  return power_of_2_min_i(std::min(32, system_thread_count));
 }
 
 static void clear_hash_tables(MutableSpan<EdgeMap> edge_maps)
@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "BLI_ordered_edge.hh"
+#include "BLI_set.hh"
+
+#include "DNA_mesh_types.h"
+
+namespace blender::bke::tests {
+
+class MeshCalcEdgesTest : public testing::Test {
+ public:
+  static void SetUpTestSuite()
+  {
+    BKE_idtype_init();
+  }
+};
+
+/** A strip of quads, large enough to use multiple hash maps. */
+static Mesh *create_quad_strip(const int faces_num)
+{
+  Mesh *mesh = BKE_mesh_new_nomain((faces_num + 1) * 2, 0, faces_num, faces_num * 4);
+  offset_indices::fill_constant_group_size(4, 0, mesh->face_offsets_for_write());
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  for (const int face : IndexRange(faces_num)) {
+    const int vert = face * 2;
+    corner_verts.slice(face * 4, 4).copy_from({vert, vert + 2, vert + 3, vert + 1});
+  }
+  return mesh;
+}
+
+static void expect_valid_edges(const Mesh &mesh)
+{
+  const Span<int2> edges = mesh.edges();
+  const OffsetIndices<int> faces = mesh.faces();
+  const Span<int> corner_verts = mesh.corner_verts();
+  const Span<int> corner_edges = mesh.corner_edges();
+
+  Set<OrderedEdge> unique_edges;
+  for (const int2 edge : edges) {
+    EXPECT_TRUE(unique_edges.add(edge));
+  }
+  for (const int face : faces.index_range()) {
+    for (const int corner : faces[face]) {
+      const int2 edge = edges[corner_edges[corner]];
+      const OrderedEdge expected(corner_verts[corner],
+                                 corner_verts[mesh::face_corner_next(faces[face], corner)]);
+      EXPECT_EQ(OrderedEdge(edge), expected);
+    }
+  }
+}
+
+TEST_F(MeshCalcEdgesTest, QuadStrip)
+{
+  for (const int faces_num : {1, 10, 5000}) {
+    Mesh *mesh = create_quad_strip(faces_num);
+    mesh_calc_edges(*mesh, false, false);
+    EXPECT_EQ(mesh->edges_num, faces_num * 3 + 1);
+    expect_valid_edges(*mesh);
+    BKE_id_free(nullptr, mesh);
+  }
+}
+
+TEST_F(MeshCalcEdgesTest, KeepExistingEdges)
+{
+  Mesh *mesh = create_quad_strip(3000);
+  mesh_calc_edges(*mesh, false, false);
+  const Array<int2> edges_before(mesh->edges());
+  /* Recalculating with the existing edges should give the same result. */
+  mesh_calc_edges(*mesh, true, false);
+  EXPECT_EQ(mesh->edges(), edges_before.as_span());
+  expect_valid_edges(*mesh);
+  BKE_id_free(nullptr, mesh);
+}
+
+}  // namespace blender::bke::tests
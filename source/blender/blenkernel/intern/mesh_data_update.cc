@@ -7,6 +7,9 @@
  */
 
 #include <cstring>
+#include <string>
+
+#include <xxhash.h>
 
 #include "MEM_guardedalloc.h"
 
@@ -19,7 +22,9 @@
 #include "DNA_scene_types.h"
 
 #include "BLI_bitmap.h"
+#include "BLI_hash.hh"
 #include "BLI_linklist.h"
+#include "BLI_listbase.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector_types.hh"
@@ -287,6 +292,247 @@ static void set_rest_position(Mesh &mesh)
   }
 }
 
+/**
+ * Constructive modifiers like remesh or boolean are often placed at the start of the stack and
+ * are much more expensive than what comes after them. When only later modifiers or the object
+ * transform are animated, their results are the same on every frame. The cache keeps a shallow
+ * copy of the mesh after each of those leading #eModifierTypeFlag_CacheableResult modifiers,
+ * keyed by everything the result depends on, and the next evaluation resumes from the deepest
+ * checkpoint whose key still matches.
+ */
+struct ModifierStackCache {
+  struct Checkpoint {
+    /** Hash of the input and of all modifiers up to and including this one. */
+    uint64_t key;
+    Mesh *mesh;
+    Mesh *mesh_orco;
+    Mesh *mesh_orco_cloth;
+    /** Error reported by the modifier, set again when the result is reused. */
+    std::string error;
+  };
+
+  /** Shallow copy of the input mesh, which keeps its shared arrays alive for comparison. */
+  Mesh *input = nullptr;
+  Vector<Checkpoint> checkpoints;
+
+  ModifierStackCache() = default;
+  ModifierStackCache(const ModifierStackCache &other) = delete;
+  ModifierStackCache &operator=(const ModifierStackCache &other) = delete;
+
+  ~ModifierStackCache()
+  {
+    this->clear_from(0);
+    if (this->input) {
+      BKE_id_free(nullptr, this->input);
+    }
+  }
+
+  void clear_from(const int index)
+  {
+    for (Checkpoint &checkpoint : this->checkpoints.as_mutable_span().drop_front(index)) {
+      BKE_id_free(nullptr, checkpoint.mesh);
+      if (checkpoint.mesh_orco) {
+        BKE_id_free(nullptr, checkpoint.mesh_orco);
+      }
+      if (checkpoint.mesh_orco_cloth) {
+        BKE_id_free(nullptr, checkpoint.mesh_orco_cloth);
+      }
+    }
+    this->checkpoints.resize(index);
+  }
+};
+
+static Mesh *mesh_copy_for_eval_or_null(const Mesh *mesh)
+{
+  return mesh ? BKE_mesh_copy_for_eval(*mesh) : nullptr;
+}
+
+static bool str_equal_or_null(const char *a, const char *b)
+{
+  if (a == nullptr || b == nullptr) {
+    return a == b;
+  }
+  return STREQ(a, b);
+}
+
+/**
+ * Layers are only considered unchanged when they share the same array. The sharing info keeps
+ * the array alive while it is referenced by the cache, so its address can't be reused, and
+ * writing to it through the attribute API makes a copy first.
+ */
+static bool custom_data_is_shared(const CustomData &a, const CustomData &b)
+{
+  if (a.totlayer != b.totlayer) {
+    return false;
+  }
+  for (const int i : IndexRange(a.totlayer)) {
+    const CustomDataLayer &layer = a.layers[i];
+    if (layer.data != nullptr && layer.sharing_info == nullptr) {
+      return false;
+    }
+    if (memcmp(&layer, &b.layers[i], sizeof(CustomDataLayer)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool mesh_is_unchanged(const Mesh &a, const Mesh &b)
+{
+  if (a.verts_num != b.verts_num || a.edges_num != b.edges_num || a.faces_num != b.faces_num ||
+      a.corners_num != b.corners_num)
+  {
+    return false;
+  }
+  if (a.face_offset_indices != b.face_offset_indices ||
+      (a.face_offset_indices && a.runtime->face_offsets_sharing_info == nullptr))
+  {
+    return false;
+  }
+  if (!custom_data_is_shared(a.vert_data, b.vert_data) ||
+      !custom_data_is_shared(a.edge_data, b.edge_data) ||
+      !custom_data_is_shared(a.face_data, b.face_data) ||
+      !custom_data_is_shared(a.corner_data, b.corner_data))
+  {
+    return false;
+  }
+
+  /* Parameters copied to the results of modifiers, see #BKE_mesh_copy_parameters_for_eval. */
+  if (a.flag != b.flag || a.editflag != b.editflag || a.symmetry != b.symmetry ||
+      a.remesh_mode != b.remesh_mode || a.remesh_voxel_size != b.remesh_voxel_size ||
+      a.remesh_voxel_adaptivity != b.remesh_voxel_adaptivity ||
+      a.face_sets_color_seed != b.face_sets_color_seed ||
+      a.face_sets_color_default != b.face_sets_color_default ||
+      a.texspace_flag != b.texspace_flag ||
+      memcmp(a.texspace_location, b.texspace_location, sizeof(a.texspace_location)) != 0 ||
+      memcmp(a.texspace_size, b.texspace_size, sizeof(a.texspace_size)) != 0 ||
+      a.vertex_group_active_index != b.vertex_group_active_index ||
+      a.attributes_active_index != b.attributes_active_index ||
+      !str_equal_or_null(a.active_color_attribute, b.active_color_attribute) ||
+      !str_equal_or_null(a.default_color_attribute, b.default_color_attribute))
+  {
+    return false;
+  }
+  if (a.totcol != b.totcol ||
+      (a.totcol > 0 && memcmp(a.mat, b.mat, sizeof(*a.mat) * a.totcol) != 0))
+  {
+    return false;
+  }
+  if (BLI_listbase_count(&a.vertex_group_names) != BLI_listbase_count(&b.vertex_group_names)) {
+    return false;
+  }
+  const bDeformGroup *group_b = static_cast<const bDeformGroup *>(b.vertex_group_names.first);
+  LISTBASE_FOREACH (const bDeformGroup *, group_a, &a.vertex_group_names) {
+    if (!STREQ(group_a->name, group_b->name)) {
+      return false;
+    }
+    group_b = group_b->next;
+  }
+  return true;
+}
+
+/**
+ * Get the cache of the evaluated object, dropping its checkpoints when the input mesh changed.
+ * \return The hash that starts the key chain of the checkpoints.
+ */
+static uint64_t modifier_stack_cache_ensure(Object &ob,
+                                            const Mesh &mesh_input,
+                                            ModifierStackCache **r_cache)
+{
+  std::shared_ptr<ModifierStackCache> &cache = ob.runtime->modifier_stack_cache;
+  if (!cache) {
+    cache = std::make_shared<ModifierStackCache>();
+  }
+  if (cache->input == nullptr || !mesh_is_unchanged(*cache->input, mesh_input)) {
+    cache->clear_from(0);
+    if (cache->input) {
+      BKE_id_free(nullptr, cache->input);
+    }
+    cache->input = BKE_mesh_copy_for_eval(mesh_input);
+  }
+  *r_cache = cache.get();
+
+  /* Object materials are transferred to the result by some modifiers. */
+  uint64_t hash = get_default_hash(ob.totcol);
+  if (ob.totcol > 0) {
+    hash = get_default_hash(hash,
+                            XXH3_64bits(ob.mat, sizeof(*ob.mat) * ob.totcol),
+                            XXH3_64bits(ob.matbits, sizeof(*ob.matbits) * ob.totcol));
+  }
+  return hash;
+}
+
+struct ModifierCacheKeyData {
+  uint64_t hash;
+  bool has_object;
+  bool is_cacheable;
+};
+
+static void modifier_cache_key_walk(void *user_data,
+                                    Object * /*ob*/,
+                                    ID **idpoin,
+                                    LibraryForeachIDCallbackFlag /*cb_flag*/)
+{
+  ModifierCacheKeyData &data = *static_cast<ModifierCacheKeyData *>(user_data);
+  const ID *id = *idpoin;
+  if (id == nullptr) {
+    return;
+  }
+  if (GS(id->name) != ID_OB) {
+    /* Collections and other data-blocks don't have an update counter to compare. */
+    data.is_cacheable = false;
+    return;
+  }
+  const Object &ob = *reinterpret_cast<const Object *>(id);
+  data.hash = get_default_hash(data.hash,
+                               id->session_uid,
+                               get_default_hash(ob.runtime->last_update_geometry,
+                                                ob.runtime->last_update_shading),
+                               XXH3_64bits(ob.object_to_world().ptr(), sizeof(float4x4)));
+  data.has_object = true;
+}
+
+/**
+ * Compute the key of the result of \a md from the key of its input.
+ * \return False when the result of the modifier can't be cached.
+ */
+static bool modifier_result_cache_key(Object &ob,
+                                      ModifierData &md,
+                                      const CustomData_MeshMasks &mask,
+                                      const CustomData_MeshMasks &nextmask,
+                                      const uint64_t input_key,
+                                      uint64_t &r_key)
+{
+  const ModifierTypeInfo *mti = BKE_modifier_get_info(ModifierType(md.type));
+  if (!(mti->flags & eModifierTypeFlag_CacheableResult) ||
+      mti->type == ModifierTypeType::OnlyDeform)
+  {
+    return false;
+  }
+
+  /* Only the settings, the modifier header contains the name and runtime data. */
+  const uint64_t settings_hash = XXH3_64bits(POINTER_OFFSET(&md, sizeof(ModifierData)),
+                                             mti->struct_size - sizeof(ModifierData));
+  ModifierCacheKeyData data{get_default_hash(input_key, md.type, md.persistent_uid, settings_hash),
+                            false,
+                            true};
+  if (mti->foreach_ID_link) {
+    mti->foreach_ID_link(&md, &ob, modifier_cache_key_walk, &data);
+  }
+  if (!data.is_cacheable) {
+    return false;
+  }
+  if (data.has_object) {
+    /* Referenced objects are used relative to the modified object. */
+    data.hash = get_default_hash(data.hash,
+                                 XXH3_64bits(ob.object_to_world().ptr(), sizeof(float4x4)));
+  }
+  r_key = get_default_hash(data.hash,
+                           XXH3_64bits(&mask, sizeof(mask)),
+                           XXH3_64bits(&nextmask, sizeof(nextmask)));
+  return true;
+}
+
 static void mesh_calc_modifiers(Depsgraph &depsgraph,
                                 const Scene &scene,
                                 Object &ob,
@@ -401,6 +647,16 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
     }
   }
 
+  /* Reuse the results of leading constructive modifiers whose inputs didn't change since the
+   * last evaluation of the stack. Only done for the regular evaluation of the object, and only
+   * when the stack starts from the unchanged input mesh. */
+  ModifierStackCache *stack_cache = nullptr;
+  uint64_t stack_cache_key = 0;
+  int stack_cache_index = 0;
+  if (use_cache && mesh == nullptr && !need_mapping && !sculpt_mode) {
+    stack_cache_key = modifier_stack_cache_ensure(ob, mesh_input, &stack_cache);
+  }
+
   /* Apply all remaining constructive and deforming modifiers. */
   bool have_non_onlydeform_modifiers_applied = false;
   for (; md; md = md->next, md_datamask = md_datamask->next) {
@@ -458,6 +714,42 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
 
     ScopedModifierTimer modifier_timer{*md};
 
+    if (stack_cache) {
+      const CustomData_MeshMasks &nextmask = md_datamask->next ? md_datamask->next->mask :
+                                                                  final_datamask;
+      if (!modifier_result_cache_key(
+              ob, *md, md_datamask->mask, nextmask, stack_cache_key, stack_cache_key))
+      {
+        /* End of the cached part of the stack. */
+        stack_cache->clear_from(stack_cache_index);
+        stack_cache = nullptr;
+      }
+      else if (stack_cache_index < stack_cache->checkpoints.size() &&
+               stack_cache->checkpoints[stack_cache_index].key == stack_cache_key)
+      {
+        const ModifierStackCache::Checkpoint &checkpoint =
+            stack_cache->checkpoints[stack_cache_index];
+        if (mesh) {
+          BKE_id_free(nullptr, mesh);
+        }
+        mesh = BKE_mesh_copy_for_eval(*checkpoint.mesh);
+        if (mesh_orco) {
+          BKE_id_free(nullptr, mesh_orco);
+        }
+        mesh_orco = mesh_copy_for_eval_or_null(checkpoint.mesh_orco);
+        if (mesh_orco_cloth) {
+          BKE_id_free(nullptr, mesh_orco_cloth);
+        }
+        mesh_orco_cloth = mesh_copy_for_eval_or_null(checkpoint.mesh_orco_cloth);
+        if (!checkpoint.error.empty()) {
+          BKE_modifier_set_error(&ob, md, "%s", checkpoint.error.c_str());
+        }
+        have_non_onlydeform_modifiers_applied = true;
+        stack_cache_index++;
+        continue;
+      }
+    }
+
     /* Add orco mesh as layer if needed by this modifier. */
     if (mesh && mesh_orco && mti->required_data_mask) {
       CustomData_MeshMasks mask = {0};
@@ -630,6 +922,16 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
       }
 
       mesh->runtime->deformed_only = false;
+
+      if (stack_cache) {
+        stack_cache->clear_from(stack_cache_index);
+        stack_cache->checkpoints.append({stack_cache_key,
+                                         BKE_mesh_copy_for_eval(*mesh),
+                                         mesh_copy_for_eval_or_null(mesh_orco),
+                                         mesh_copy_for_eval_or_null(mesh_orco_cloth),
+                                         md->error ? md->error : ""});
+        stack_cache_index++;
+      }
     }
 
     if (sculpt_mode && md->type == eModifierType_Multires) {
@@ -637,6 +939,10 @@ static void mesh_calc_modifiers(Depsgraph &depsgraph,
     }
   }
 
+  if (stack_cache) {
+    stack_cache->clear_from(stack_cache_index);
+  }
+
   BLI_linklist_free((LinkNode *)datamasks, nullptr);
 
   for (md = firstmd; md; md = md->next) {
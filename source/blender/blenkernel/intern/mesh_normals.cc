@@ -17,6 +17,7 @@
 
 #include "BLI_array_utils.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist.h"
 #include "BLI_math_base.hh"
 #include "BLI_math_vector.hh"
@@ -177,47 +178,69 @@ float3 face_normal_calc(const Span<float3> vert_positions, const Span<int> face_
 void normals_calc_faces(const Span<float3> positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
+                        const IndexMask &face_mask,
                         MutableSpan<float3> face_normals)
 {
   BLI_assert(faces.size() == face_normals.size());
-  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
-    for (const int i : range) {
-      face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
-    }
+  face_mask.foreach_index(GrainSize(1024), [&](const int i) {
+    face_normals[i] = normal_calc_ngon(positions, corner_verts.slice(faces[i]));
   });
 }
 
+void normals_calc_faces(const Span<float3> positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        MutableSpan<float3> face_normals)
+{
+  normals_calc_faces(positions, faces, corner_verts, faces.index_range(), face_normals);
+}
+
 void normals_calc_verts(const Span<float3> vert_positions,
                         const OffsetIndices<int> faces,
                         const Span<int> corner_verts,
                         const GroupedSpan<int> vert_to_face_map,
                         const Span<float3> face_normals,
+                        const IndexMask &vert_mask,
                         MutableSpan<float3> vert_normals)
 {
   const Span<float3> positions = vert_positions;
-  threading::parallel_for(positions.index_range(), 1024, [&](const IndexRange range) {
-    for (const int vert : range) {
-      const Span<int> vert_faces = vert_to_face_map[vert];
-      if (vert_faces.is_empty()) {
-        vert_normals[vert] = math::normalize(positions[vert]);
-        continue;
-      }
-
-      float3 vert_normal(0);
-      for (const int face : vert_faces) {
-        const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
-        const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
-        const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
-        const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
+  vert_mask.foreach_index(GrainSize(1024), [&](const int vert) {
+    const Span<int> vert_faces = vert_to_face_map[vert];
+    if (vert_faces.is_empty()) {
+      vert_normals[vert] = math::normalize(positions[vert]);
+      return;
+    }
 
-        vert_normal += face_normals[face] * factor;
-      }
+    float3 vert_normal(0);
+    for (const int face : vert_faces) {
+      const int2 adjacent_verts = face_find_adjacent_verts(faces[face], corner_verts, vert);
+      const float3 dir_prev = math::normalize(positions[adjacent_verts[0]] - positions[vert]);
+      const float3 dir_next = math::normalize(positions[adjacent_verts[1]] - positions[vert]);
+      const float factor = math::safe_acos_approx(math::dot(dir_prev, dir_next));
 
-      vert_normals[vert] = math::normalize(vert_normal);
+      vert_normal += face_normals[face] * factor;
     }
+
+    vert_normals[vert] = math::normalize(vert_normal);
   });
 }
 
+void normals_calc_verts(const Span<float3> vert_positions,
+                        const OffsetIndices<int> faces,
+                        const Span<int> corner_verts,
+                        const GroupedSpan<int> vert_to_face_map,
+                        const Span<float3> face_normals,
+                        MutableSpan<float3> vert_normals)
+{
+  normals_calc_verts(vert_positions,
+                     faces,
+                     corner_verts,
+                     vert_to_face_map,
+                     face_normals,
+                     vert_positions.index_range(),
+                     vert_normals);
+}
+
 /** \} */
 
 static void mix_normals_corner_to_vert(const Span<float3> vert_positions,
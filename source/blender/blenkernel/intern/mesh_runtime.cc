@@ -7,6 +7,7 @@
  */
 
 #include "BLI_array_utils.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_geom.h"
 
 #include "BKE_bake_data_block_id.hh"
@@ -163,6 +164,28 @@ blender::GroupedSpan<int> Mesh::vert_to_corner_map() const
   return {offsets, this->runtime->vert_to_corner_map_cache.data()};
 }
 
+blender::GroupedSpan<int> Mesh::vert_to_edge_map() const
+{
+  using namespace blender;
+  this->runtime->vert_to_edge_map_cache.ensure([&](bke::GroupedIndicesCache &r_data) {
+    bke::mesh::build_vert_to_edge_map(
+        this->edges(), this->verts_num, r_data.offsets, r_data.indices);
+  });
+  const bke::GroupedIndicesCache &cache = this->runtime->vert_to_edge_map_cache.data();
+  return {OffsetIndices<int>(cache.offsets), cache.indices};
+}
+
+blender::GroupedSpan<int> Mesh::edge_to_face_map() const
+{
+  using namespace blender;
+  this->runtime->edge_to_face_map_cache.ensure([&](bke::GroupedIndicesCache &r_data) {
+    bke::mesh::build_edge_to_face_map(
+        this->faces(), this->corner_edges(), this->edges_num, r_data.offsets, r_data.indices);
+  });
+  const bke::GroupedIndicesCache &cache = this->runtime->edge_to_face_map_cache.data();
+  return {OffsetIndices<int>(cache.offsets), cache.indices};
+}
+
 const blender::bke::LooseVertCache &Mesh::loose_verts() const
 {
   using namespace blender::bke;
@@ -320,6 +343,8 @@ void BKE_mesh_runtime_clear_geometry(Mesh *mesh)
   mesh->runtime->vert_to_face_map_cache.tag_dirty();
   mesh->runtime->vert_to_corner_map_cache.tag_dirty();
   mesh->runtime->corner_to_face_map_cache.tag_dirty();
+  mesh->runtime->vert_to_edge_map_cache.tag_dirty();
+  mesh->runtime->edge_to_face_map_cache.tag_dirty();
   mesh->runtime->vert_normals_cache.tag_dirty();
   mesh->runtime->vert_normals_true_cache.tag_dirty();
   mesh->runtime->face_normals_cache.tag_dirty();
@@ -347,6 +372,8 @@ void Mesh::tag_edges_split()
   this->runtime->vert_to_face_offset_cache.tag_dirty();
   this->runtime->vert_to_face_map_cache.tag_dirty();
   this->runtime->vert_to_corner_map_cache.tag_dirty();
+  this->runtime->vert_to_edge_map_cache.tag_dirty();
+  this->runtime->edge_to_face_map_cache.tag_dirty();
   if (this->runtime->loose_edges_cache.is_cached() &&
       this->runtime->loose_edges_cache.data().count != 0)
   {
@@ -411,6 +438,156 @@ void Mesh::tag_positions_changed_no_normals()
   this->runtime->shrinkwrap_boundary_cache.tag_dirty();
 }
 
+namespace blender::bke {
+
+/** Normals that are computed from the "true" normals don't need any update themselves. */
+static void tag_normals_dirty_unless_true(SharedCache<NormalsCache> &cache)
+{
+  if (cache.is_cached() && std::holds_alternative<NormalsCache::UseTrueCache>(cache.data().data)) {
+    return;
+  }
+  cache.tag_dirty();
+}
+
+/** Sorted indices of the faces that use any of the given vertices. */
+static IndexMask faces_around_verts(const GroupedSpan<int> vert_to_face_map,
+                                    const IndexMask &verts,
+                                    IndexMaskMemory &memory)
+{
+  Vector<int> faces;
+  verts.foreach_index([&](const int vert) { faces.extend(vert_to_face_map[vert]); });
+  std::sort(faces.begin(), faces.end());
+  faces.resize(std::unique(faces.begin(), faces.end()) - faces.begin());
+  return IndexMask::from_indices(faces.as_span(), memory);
+}
+
+/** Sorted indices of the given vertices and all vertices of the given faces. */
+static IndexMask verts_of_faces(const OffsetIndices<int> faces,
+                                const Span<int> corner_verts,
+                                const IndexMask &face_mask,
+                                const IndexMask &verts,
+                                IndexMaskMemory &memory)
+{
+  Vector<int> result;
+  verts.foreach_index([&](const int vert) { result.append(vert); });
+  face_mask.foreach_index([&](const int face) { result.extend(corner_verts.slice(faces[face])); });
+  std::sort(result.begin(), result.end());
+  result.resize(std::unique(result.begin(), result.end()) - result.begin());
+  return IndexMask::from_indices(result.as_span(), memory);
+}
+
+static void update_corner_normals_partial(const Mesh &mesh,
+                                          const IndexMask &changed_verts,
+                                          const IndexMask &changed_faces)
+{
+  SharedCache<NormalsCache> &cache = mesh.runtime->corner_normals_cache;
+  if (!cache.is_cached()) {
+    return;
+  }
+  if (!std::holds_alternative<Vector<float3>>(cache.data().data)) {
+    cache.tag_dirty();
+    return;
+  }
+  switch (mesh.normals_domain()) {
+    case MeshNormalDomain::Point: {
+      const Span<float3> vert_normals = mesh.vert_normals();
+      const GroupedSpan<int> vert_to_corner_map = mesh.vert_to_corner_map();
+      cache.update([&](NormalsCache &r_data) {
+        MutableSpan<float3> data = r_data.ensure_vector_size(mesh.corners_num);
+        changed_verts.foreach_index(GrainSize(1024), [&](const int vert) {
+          for (const int corner : vert_to_corner_map[vert]) {
+            data[corner] = vert_normals[vert];
+          }
+        });
+      });
+      break;
+    }
+    case MeshNormalDomain::Face: {
+      const OffsetIndices<int> faces = mesh.faces();
+      const Span<float3> face_normals = mesh.face_normals();
+      cache.update([&](NormalsCache &r_data) {
+        MutableSpan<float3> data = r_data.ensure_vector_size(mesh.corners_num);
+        changed_faces.foreach_index(GrainSize(1024), [&](const int face) {
+          data.slice(faces[face]).fill(face_normals[face]);
+        });
+      });
+      break;
+    }
+    case MeshNormalDomain::Corner: {
+      /* Sharp edges and custom normals depend on whole corner fans, which isn't worth handling
+       * separately here. */
+      cache.tag_dirty();
+      break;
+    }
+  }
+}
+
+}  // namespace blender::bke
+
+void Mesh::tag_positions_changed_partial(const blender::IndexMask &changed_verts)
+{
+  using namespace blender;
+  using namespace blender::bke;
+  if (changed_verts.is_empty()) {
+    return;
+  }
+  MeshRuntime &runtime = *this->runtime;
+  const bool face_normals_cached = runtime.face_normals_true_cache.is_cached();
+  const bool vert_normals_cached = runtime.vert_normals_true_cache.is_cached();
+  const bool tris_cached = runtime.corner_tris_cache.data.is_cached() &&
+                           !runtime.corner_tris_cache.frozen;
+  if (changed_verts.size() == this->verts_num ||
+      (!face_normals_cached && !vert_normals_cached && !tris_cached))
+  {
+    this->tag_positions_changed();
+    return;
+  }
+
+  const Span<float3> positions = this->vert_positions();
+  const OffsetIndices<int> faces = this->faces();
+  const Span<int> corner_verts = this->corner_verts();
+  const GroupedSpan<int> vert_to_face_map = this->vert_to_face_map();
+
+  /* The normal and triangulation of a face change when any of its vertices moved. The normal of a
+   * vertex depends on the normals of its faces and the positions of their vertices. */
+  IndexMaskMemory memory;
+  const IndexMask changed_faces = faces_around_verts(vert_to_face_map, changed_verts, memory);
+  const IndexMask affected_verts = verts_of_faces(
+      faces, corner_verts, changed_faces, changed_verts, memory);
+
+  if (face_normals_cached) {
+    runtime.face_normals_true_cache.update([&](Vector<float3> &r_data) {
+      mesh::normals_calc_faces(positions, faces, corner_verts, changed_faces, r_data);
+    });
+  }
+  if (vert_normals_cached) {
+    const Span<float3> face_normals = this->face_normals_true();
+    runtime.vert_normals_true_cache.update([&](Vector<float3> &r_data) {
+      mesh::normals_calc_verts(
+          positions, faces, corner_verts, vert_to_face_map, face_normals, affected_verts, r_data);
+    });
+  }
+  tag_normals_dirty_unless_true(runtime.vert_normals_cache);
+  tag_normals_dirty_unless_true(runtime.face_normals_cache);
+  update_corner_normals_partial(*this, affected_verts, changed_faces);
+
+  if (tris_cached) {
+    const Span<float3> face_normals = runtime.face_normals_true_cache.is_cached() ?
+                                          this->face_normals_true() :
+                                          Span<float3>();
+    runtime.corner_tris_cache.data.update([&](Array<int3> &r_data) {
+      mesh::corner_tris_calc(positions, faces, corner_verts, face_normals, changed_faces, r_data);
+    });
+  }
+  else {
+    runtime.corner_tris_cache.tag_dirty();
+  }
+
+  free_bvh_caches(runtime);
+  runtime.bounds_cache.tag_dirty();
+  runtime.shrinkwrap_boundary_cache.tag_dirty();
+}
+
 void Mesh::tag_positions_changed_uniformly()
 {
   /* The normals and triangulation didn't change, since all verts moved by the same amount. */
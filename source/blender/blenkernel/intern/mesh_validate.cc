@@ -15,12 +15,14 @@
 #include "DNA_mesh_types.h"
 #include "DNA_meshdata_types.h"
 
+#include "BLI_hash.hh"
 #include "BLI_map.hh"
 #include "BLI_math_base.h"
 #include "BLI_math_vector.h"
 #include "BLI_ordered_edge.hh"
 #include "BLI_sort.hh"
 #include "BLI_sys_types.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_attribute.hh"
@@ -34,6 +36,7 @@
 #include "MEM_guardedalloc.h"
 
 using blender::float3;
+using blender::IndexRange;
 using blender::MutableSpan;
 using blender::Span;
 
@@ -141,6 +144,235 @@ static bool search_face_corner_cmp(const SortFace &sp1, const SortFace &sp2)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Fast Validity Check
+ *
+ * Most meshes passed to validation are valid. Checking the invariants that the full validation
+ * tests in parallel and without building the edge hash is much faster, then the full validation
+ * only has to run when something is wrong, to report and fix the issues.
+ * \{ */
+
+/** Run the check on every item in parallel, stopping early when any of them fails. */
+template<typename Fn>
+static bool all_items_valid(const int64_t size, const int64_t grain_size, const Fn &fn)
+{
+  std::atomic<bool> is_valid = true;
+  blender::threading::parallel_for(
+      blender::IndexRange(size), grain_size, [&](const blender::IndexRange range) {
+        if (!is_valid.load(std::memory_order_relaxed)) {
+          return;
+        }
+        for (const int64_t i : range) {
+          if (!fn(i)) {
+            is_valid.store(false, std::memory_order_relaxed);
+            return;
+          }
+        }
+      });
+  return is_valid;
+}
+
+static uint64_t edge_sort_key(const blender::int2 &edge)
+{
+  const blender::OrderedEdge ordered(edge);
+  return (uint64_t(uint32_t(ordered.v_low)) << 32) | uint64_t(uint32_t(ordered.v_high));
+}
+
+static bool edges_have_duplicates(const Span<blender::int2> edges)
+{
+  blender::Array<uint64_t> keys(edges.size(), blender::NoInitialization());
+  blender::threading::parallel_for(edges.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      keys[i] = edge_sort_key(edges[i]);
+    }
+  });
+  blender::parallel_sort(keys.begin(), keys.end());
+  return !all_items_valid(keys.size() - 1, 4096, [&](const int64_t i) {
+    return keys[i] != keys[i + 1];
+  });
+}
+
+/** Copy the sorted vertices of a face, to find duplicate vertices and faces. */
+static void face_sorted_verts(const Span<int> corner_verts, blender::Vector<int, 16> &r_verts)
+{
+  r_verts.clear();
+  r_verts.extend(corner_verts);
+  std::sort(r_verts.begin(), r_verts.end());
+}
+
+static bool faces_have_duplicates(const blender::OffsetIndices<int> faces,
+                                  const Span<int> corner_verts)
+{
+  /* Sort faces by a hash of their sorted vertices, only faces with the same hash have to be
+   * compared. */
+  blender::Array<std::pair<uint64_t, int>> keys(faces.size(), blender::NoInitialization());
+  blender::threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    blender::Vector<int, 16> verts;
+    for (const int face : range) {
+      face_sorted_verts(corner_verts.slice(faces[face]), verts);
+      uint64_t hash = verts.size();
+      for (const int vert : verts) {
+        hash = blender::get_default_hash(hash, vert);
+      }
+      new (&keys[face]) std::pair<uint64_t, int>(hash, face);
+    }
+  });
+  blender::parallel_sort(keys.begin(), keys.end());
+  return !all_items_valid(keys.size() - 1, 1024, [&](const int64_t i) {
+    if (keys[i].first != keys[i + 1].first || (i > 0 && keys[i - 1].first == keys[i].first)) {
+      return true;
+    }
+    /* Compare all faces in the group of faces with the same hash. */
+    int64_t group_end = i + 1;
+    while (group_end < keys.size() && keys[group_end].first == keys[i].first) {
+      group_end++;
+    }
+    blender::Vector<int, 16> verts_a;
+    blender::Vector<int, 16> verts_b;
+    for (const int64_t a : blender::IndexRange::from_begin_end(i, group_end)) {
+      face_sorted_verts(corner_verts.slice(faces[keys[a].second]), verts_a);
+      for (const int64_t b : blender::IndexRange::from_begin_end(a + 1, group_end)) {
+        face_sorted_verts(corner_verts.slice(faces[keys[b].second]), verts_b);
+        if (verts_a.as_span() == verts_b.as_span()) {
+          return false;
+        }
+      }
+    }
+    return true;
+  });
+}
+
+/**
+ * \return True when the mesh passes all the tests of #BKE_mesh_validate_arrays, meaning that it
+ * would not report or change anything. False does not mean that the mesh is invalid, some rarely
+ * used data is not tested here.
+ */
+static bool mesh_arrays_are_valid_fast(const Mesh *mesh,
+                                       const Span<float3> vert_positions,
+                                       const Span<blender::int2> edges,
+                                       const bool has_legacy_faces,
+                                       const Span<int> corner_verts,
+                                       const Span<int> corner_edges,
+                                       const int *face_offsets,
+                                       const int faces_num,
+                                       const MDeformVert *dverts)
+{
+  using namespace blender;
+  const int verts_num = vert_positions.size();
+  const int edges_num = edges.size();
+  const int corners_num = corner_verts.size();
+
+  if (mesh == nullptr || (has_legacy_faces && !face_offsets)) {
+    return false;
+  }
+  if (edges_num == 0 && faces_num != 0) {
+    return false;
+  }
+
+  /* Face offsets have to cover all corners, each face has at least 3 corners. */
+  if (faces_num == 0) {
+    if (corners_num != 0) {
+      return false;
+    }
+  }
+  else if (face_offsets[0] != 0 || face_offsets[faces_num] != corners_num) {
+    return false;
+  }
+  if (!all_items_valid(faces_num, 4096, [&](const int64_t i) {
+        return face_offsets[i + 1] - face_offsets[i] >= 3;
+      }))
+  {
+    return false;
+  }
+  const OffsetIndices<int> faces(Span(face_offsets, faces_num + 1));
+
+  if (!all_items_valid(verts_num, 4096, [&](const int64_t i) {
+        return std::isfinite(vert_positions[i].x) && std::isfinite(vert_positions[i].y) &&
+               std::isfinite(vert_positions[i].z);
+      }))
+  {
+    return false;
+  }
+
+  if (!all_items_valid(edges_num, 4096, [&](const int64_t i) {
+        const int2 edge = edges[i];
+        return edge[0] != edge[1] && uint(edge[0]) < uint(verts_num) &&
+               uint(edge[1]) < uint(verts_num);
+      }))
+  {
+    return false;
+  }
+  if (edges_num > 1 && edges_have_duplicates(edges)) {
+    return false;
+  }
+
+  /* Corner vertices in range, corner edges connecting the vertices of consecutive corners, and no
+   * vertex used twice in the same face. */
+  if (!all_items_valid(faces_num, 1024, [&](const int64_t i) {
+        const IndexRange face = faces[i];
+        for (const int corner : face) {
+          const int vert = corner_verts[corner];
+          if (uint(vert) >= uint(verts_num)) {
+            return false;
+          }
+          const int edge_i = corner_edges[corner];
+          if (uint(edge_i) >= uint(edges_num)) {
+            return false;
+          }
+          const int vert_next = corner_verts[corner == face.last() ? face.first() : corner + 1];
+          if (OrderedEdge(edges[edge_i]) != OrderedEdge(vert, vert_next)) {
+            return false;
+          }
+        }
+        Vector<int, 16> verts;
+        face_sorted_verts(corner_verts.slice(face), verts);
+        return std::adjacent_find(verts.begin(), verts.end()) == verts.end();
+      }))
+  {
+    return false;
+  }
+  if (faces_num > 1 && faces_have_duplicates(faces, corner_verts)) {
+    return false;
+  }
+
+  const bke::AttributeAccessor attributes = mesh->attributes();
+  const VArraySpan material_indices = *attributes.lookup<int>("material_index",
+                                                              bke::AttrDomain::Face);
+  if (!material_indices.is_empty() &&
+      !all_items_valid(faces_num, 4096, [&](const int64_t i) { return material_indices[i] >= 0; }))
+  {
+    return false;
+  }
+
+  if (dverts) {
+    if (!all_items_valid(verts_num, 1024, [&](const int64_t i) {
+          for (const MDeformWeight &dw : Span(dverts[i].dw, dverts[i].totweight)) {
+            if (!(dw.weight >= 0.0f && dw.weight <= 1.0f) || dw.def_nr >= INT_MAX) {
+              return false;
+            }
+          }
+          return true;
+        }))
+    {
+      return false;
+    }
+  }
+
+  for (const MSelect &msel : Span(mesh->mselect, mesh->mselect ? mesh->totselect : 0)) {
+    const int elems_num = msel.type == ME_VSEL ? mesh->verts_num :
+                          msel.type == ME_ESEL ? mesh->edges_num :
+                          msel.type == ME_FSEL ? mesh->faces_num :
+                                                 0;
+    if (msel.index < 0 || msel.index > elems_num) {
+      return false;
+    }
+  }
+
+  return true;
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Mesh Validation
  * \{ */
@@ -236,16 +468,31 @@ bool BKE_mesh_validate_arrays(Mesh *mesh,
 
   BLI_assert(!(do_fixes && mesh == nullptr));
 
-  fix_flag.as_flag = 0;
-  free_flag.as_flag = 0;
-  recalc_flag.as_flag = 0;
-
   PRINT_MSG("verts(%u), edges(%u), corners(%u), faces(%u)",
             verts_num,
             edges_num,
             corners_num,
             faces_num);
 
+  if (mesh_arrays_are_valid_fast(mesh,
+                                 Span(reinterpret_cast<const float3 *>(vert_positions), verts_num),
+                                 Span(edges, edges_num),
+                                 legacy_faces != nullptr,
+                                 Span(corner_verts, corners_num),
+                                 Span(corner_edges, corners_num),
+                                 face_offsets,
+                                 faces_num,
+                                 dverts))
+  {
+    PRINT_MSG("%s: finished\n\n", __func__);
+    *r_changed = false;
+    return true;
+  }
+
+  fix_flag.as_flag = 0;
+  free_flag.as_flag = 0;
+  recalc_flag.as_flag = 0;
+
   if (edges_num == 0 && faces_num != 0) {
     PRINT_ERR("\tLogical error, %u faces and 0 edges", faces_num);
     recalc_flag.edges = do_fixes;
@@ -345,7 +345,10 @@ static Mesh *mesh_wrapper_ensure_subdivision(Mesh *mesh)
     memcpy(data, mesh->corner_normals().data(), mesh->corner_normals().size_in_bytes());
   }
 
-  Mesh *subdiv_mesh = subdiv::subdiv_to_mesh(subdiv, &mesh_settings, mesh);
+  Mesh *subdiv_mesh = BKE_subsurf_modifier_subdiv_to_mesh_gpu(runtime_data, mesh, mesh_settings);
+  if (subdiv_mesh == nullptr) {
+    subdiv_mesh = subdiv::subdiv_to_mesh(subdiv, &mesh_settings, mesh);
+  }
 
   if (use_clnors) {
     mesh_set_custom_normals_normalized(
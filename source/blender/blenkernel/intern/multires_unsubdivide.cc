@@ -18,6 +18,7 @@
 
 #include "BLI_gsqueue.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "BKE_customdata.hh"
 #include "BKE_mesh.hh"
@@ -963,6 +964,86 @@ static bool multires_unsubdivide_flip_grid_x_axis(const blender::OffsetIndices<i
   return false;
 }
 
+/**
+ * Extracts the grids of all loops of the base mesh vertex \a v. The meshes are only read and the
+ * extracted grids belong to loops of \a v, so this can run for different vertices in parallel.
+ */
+static void multires_unsubdivide_extract_vert_grids(MultiresUnsubdivideContext *context,
+                                                    BMesh *bm_base_mesh,
+                                                    BMVert *v,
+                                                    const int *orig_to_base_vmap,
+                                                    const int *base_to_orig_vmap,
+                                                    const int base_l_offset)
+{
+  BMesh *bm_original_mesh = context->bm_original_mesh;
+  const blender::OffsetIndices faces = context->base_mesh->faces();
+  const blender::Span<int> corner_verts = context->base_mesh->corner_verts();
+  BMIter iter_a, iter_b;
+  BMLoop *l, *lb;
+
+  /* For each base mesh vertex, get the corresponding #BMVert of the original mesh using the
+   * vertex map. */
+  const int orig_vertex_index = base_to_orig_vmap[BM_elem_index_get(v)];
+  BMVert *vert_original = BM_vert_at_index(bm_original_mesh, orig_vertex_index);
+
+  /* Iterate over the loops of that vertex in the original mesh. */
+  BM_ITER_ELEM (l, &iter_a, vert_original, BM_LOOPS_OF_VERT) {
+    /* For each loop, get the two vertices that should map to the l+1 and l-1 vertices in the
+     * base mesh of the face of grid that is going to be extracted. */
+    BMVert *corner_x, *corner_y;
+    multires_unsubdivide_get_grid_corners_on_base_mesh(l->f, l->e, &corner_x, &corner_y);
+
+    /* Map the two obtained vertices to the base mesh. */
+    const int corner_x_index = orig_to_base_vmap[BM_elem_index_get(corner_x)];
+    const int corner_y_index = orig_to_base_vmap[BM_elem_index_get(corner_y)];
+    if (corner_x_index < 0 || corner_y_index < 0) {
+      continue;
+    }
+
+    /* Iterate over the loops of the same vertex in the base mesh. With the previously obtained
+     * vertices and the current vertex it is possible to get the index of the loop in the base
+     * mesh the grid that is going to be extracted belongs to. */
+    BM_ITER_ELEM (lb, &iter_b, v, BM_LOOPS_OF_VERT) {
+      BMFace *base_face = lb->f;
+      BMVert *base_corner_x = BM_vert_at_index(bm_base_mesh, corner_x_index);
+      BMVert *base_corner_y = BM_vert_at_index(bm_base_mesh, corner_y_index);
+      /* If this is the correct loop in the base mesh, the original vertex and the two corners
+       * should be in the loop's face. */
+      if (BM_vert_in_face(base_corner_x, base_face) && BM_vert_in_face(base_corner_y, base_face))
+      {
+        /* Get the index of the loop. */
+        const int base_mesh_loop_index = BM_ELEM_CD_GET_INT(lb, base_l_offset);
+        const int base_mesh_face_index = BM_elem_index_get(base_face);
+
+        /* Check the orientation of the loops in case that is needed to flip the x and y axis
+         * when extracting the grid. */
+        const bool flip_grid = multires_unsubdivide_flip_grid_x_axis(
+            faces, corner_verts, base_mesh_face_index, base_mesh_loop_index, corner_x_index);
+
+        /* Extract the grid for that loop. */
+        MultiresUnsubdivideGrid *grid = &context->base_mesh_grids[base_mesh_loop_index];
+        if (UNLIKELY(grid->grid_co != nullptr)) {
+          /* It's possible this grid has already been initialized which occurs when quads
+           * share two edge, while not so common it happens with "Suzanne's" nose,
+           * see: #126633 & run un-subdivide.
+           *
+           * Continue here instead of breaking as logically: quads sharing 2 edges
+           * will share 3 vertices and those 3 vertices may be attached to any number of quads.
+           * So in this case, continue scanning instead of breaking out of the loop
+           * because the `lb` to extract a grid from has not yet been encountered. */
+          continue;
+        }
+
+        grid->grid_index = base_mesh_loop_index;
+        multires_unsubdivide_extract_single_grid_from_face_edge(
+            context, l->f, l->e, !flip_grid, grid);
+
+        break;
+      }
+    }
+  }
+}
+
 static void multires_unsubdivide_extract_grids(MultiresUnsubdivideContext *context)
 {
   Mesh *original_mesh = context->original_mesh;
@@ -1002,9 +1083,6 @@ static void multires_unsubdivide_extract_grids(MultiresUnsubdivideContext *conte
   multires_unsubdivide_add_original_index_datalayers(base_mesh);
 
   BMesh *bm_base_mesh = get_bmesh_from_mesh(base_mesh);
-  BMIter iter, iter_a, iter_b;
-  BMVert *v;
-  BMLoop *l, *lb;
 
   BM_mesh_elem_table_ensure(bm_base_mesh, BM_VERT | BM_FACE);
 
@@ -1012,74 +1090,18 @@ static void multires_unsubdivide_extract_grids(MultiresUnsubdivideContext *conte
   const int base_l_offset = CustomData_get_offset_named(
       &bm_base_mesh->ldata, CD_PROP_INT32, lname);
 
-  const blender::OffsetIndices faces = base_mesh->faces();
-  const blender::Span<int> corner_verts = base_mesh->corner_verts();
-
   /* Main loop for extracting the grids. Iterates over the base mesh vertices. */
-  BM_ITER_MESH (v, &iter, bm_base_mesh, BM_VERTS_OF_MESH) {
-
-    /* For each base mesh vertex, get the corresponding #BMVert of the original mesh using the
-     * vertex map. */
-    const int orig_vertex_index = base_to_orig_vmap[BM_elem_index_get(v)];
-    BMVert *vert_original = BM_vert_at_index(bm_original_mesh, orig_vertex_index);
-
-    /* Iterate over the loops of that vertex in the original mesh. */
-    BM_ITER_ELEM (l, &iter_a, vert_original, BM_LOOPS_OF_VERT) {
-      /* For each loop, get the two vertices that should map to the l+1 and l-1 vertices in the
-       * base mesh of the face of grid that is going to be extracted. */
-      BMVert *corner_x, *corner_y;
-      multires_unsubdivide_get_grid_corners_on_base_mesh(l->f, l->e, &corner_x, &corner_y);
-
-      /* Map the two obtained vertices to the base mesh. */
-      const int corner_x_index = orig_to_base_vmap[BM_elem_index_get(corner_x)];
-      const int corner_y_index = orig_to_base_vmap[BM_elem_index_get(corner_y)];
-      if (corner_x_index < 0 || corner_y_index < 0) {
-        continue;
-      }
-
-      /* Iterate over the loops of the same vertex in the base mesh. With the previously obtained
-       * vertices and the current vertex it is possible to get the index of the loop in the base
-       * mesh the grid that is going to be extracted belongs to. */
-      BM_ITER_ELEM (lb, &iter_b, v, BM_LOOPS_OF_VERT) {
-        BMFace *base_face = lb->f;
-        BMVert *base_corner_x = BM_vert_at_index(bm_base_mesh, corner_x_index);
-        BMVert *base_corner_y = BM_vert_at_index(bm_base_mesh, corner_y_index);
-        /* If this is the correct loop in the base mesh, the original vertex and the two corners
-         * should be in the loop's face. */
-        if (BM_vert_in_face(base_corner_x, base_face) && BM_vert_in_face(base_corner_y, base_face))
-        {
-          /* Get the index of the loop. */
-          const int base_mesh_loop_index = BM_ELEM_CD_GET_INT(lb, base_l_offset);
-          const int base_mesh_face_index = BM_elem_index_get(base_face);
-
-          /* Check the orientation of the loops in case that is needed to flip the x and y axis
-           * when extracting the grid. */
-          const bool flip_grid = multires_unsubdivide_flip_grid_x_axis(
-              faces, corner_verts, base_mesh_face_index, base_mesh_loop_index, corner_x_index);
-
-          /* Extract the grid for that loop. */
-          MultiresUnsubdivideGrid *grid = &context->base_mesh_grids[base_mesh_loop_index];
-          if (UNLIKELY(grid->grid_co != nullptr)) {
-            /* It's possible this grid has already been initialized which occurs when quads
-             * share two edge, while not so common it happens with "Suzanne's" nose,
-             * see: #126633 & run un-subdivide.
-             *
-             * Continue here instead of breaking as logically: quads sharing 2 edges
-             * will share 3 vertices and those 3 vertices may be attached to any number of quads.
-             * So in this case, continue scanning instead of breaking out of the loop
-             * because the `lb` to extract a grid from has not yet been encountered. */
-            continue;
-          }
-
-          grid->grid_index = base_mesh_loop_index;
-          multires_unsubdivide_extract_single_grid_from_face_edge(
-              context, l->f, l->e, !flip_grid, grid);
-
-          break;
+  blender::threading::parallel_for(
+      blender::IndexRange(bm_base_mesh->totvert), 64, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          multires_unsubdivide_extract_vert_grids(context,
+                                                  bm_base_mesh,
+                                                  BM_vert_at_index(bm_base_mesh, i),
+                                                  orig_to_base_vmap,
+                                                  base_to_orig_vmap,
+                                                  base_l_offset);
         }
-      }
-    }
-  }
+      });
 
   MEM_freeN(orig_to_base_vmap);
   MEM_freeN(base_to_orig_vmap);
@@ -1184,23 +1206,24 @@ static void multires_create_grids_in_unsubdivided_base_mesh(MultiresUnsubdivideC
   BLI_assert(base_mesh->corners_num == context->num_grids);
 
   /* Allocate the MDISPS grids and copy the extracted data from context. */
-  for (int i = 0; i < totloop; i++) {
-    float(*disps)[3] = MEM_calloc_arrayN<float[3]>(totdisp, __func__);
+  blender::threading::parallel_for(
+      blender::IndexRange(totloop), 256, [&](const blender::IndexRange range) {
+        for (const int i : range) {
+          float(*disps)[3] = MEM_calloc_arrayN<float[3]>(totdisp, __func__);
 
-    if (mdisps[i].disps) {
-      MEM_freeN(mdisps[i].disps);
-    }
+          if (mdisps[i].disps) {
+            MEM_freeN(mdisps[i].disps);
+          }
 
-    for (int j = 0; j < totdisp; j++) {
-      if (context->base_mesh_grids[i].grid_co) {
-        copy_v3_v3(disps[j], context->base_mesh_grids[i].grid_co[j]);
-      }
-    }
+          if (context->base_mesh_grids[i].grid_co) {
+            memcpy(disps, context->base_mesh_grids[i].grid_co, sizeof(float[3]) * totdisp);
+          }
 
-    mdisps[i].disps = disps;
-    mdisps[i].totdisp = totdisp;
-    mdisps[i].level = context->num_total_levels;
-  }
+          mdisps[i].disps = disps;
+          mdisps[i].totdisp = totdisp;
+          mdisps[i].level = context->num_total_levels;
+        }
+      });
 }
 
 int multiresModifier_rebuild_subdiv(Depsgraph *depsgraph,
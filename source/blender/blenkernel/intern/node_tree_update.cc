@@ -68,6 +68,7 @@ enum eNodeTreeChangedFlag {
 static void add_tree_tag(bNodeTree *ntree, const eNodeTreeChangedFlag flag)
 {
   ntree->runtime->changed_flag |= flag;
+  ntree->runtime->tagged_changes_num++;
   ntree->runtime->topology_cache_mutex.tag_dirty();
   ntree->runtime->tree_zones_cache_mutex.tag_dirty();
   ntree->runtime->inferenced_input_socket_usage_mutex.tag_dirty();
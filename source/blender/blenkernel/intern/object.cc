@@ -1707,6 +1707,7 @@ void BKE_object_free_caches(Object *object)
    */
   if ((object->base_flag & BASE_FROM_DUPLI) == 0) {
     BKE_object_free_derived_caches(object);
+    object->runtime->modifier_stack_cache.reset();
     update_flag |= ID_RECALC_GEOMETRY;
   }
 
@@ -2245,6 +2246,8 @@ ParticleSystem *BKE_object_copy_particlesystem(ParticleSystem *psys, const int f
 
   psysn->pathcache = nullptr;
   psysn->childcache = nullptr;
+  psysn->childcache_parent_hash = nullptr;
+  psysn->childcache_hash = 0;
   psysn->edit = nullptr;
   psysn->pdd = nullptr;
   psysn->effectors = nullptr;
@@ -4913,6 +4916,7 @@ void BKE_object_runtime_reset_on_copy(Object *object, const int /*flag*/)
   runtime->pose_backup = nullptr;
   runtime->object_as_temp_curve = nullptr;
   runtime->geometry_set_eval = nullptr;
+  runtime->modifier_stack_cache.reset();
 
   runtime->crazyspace_deform_imats = {};
   runtime->crazyspace_deform_cos = {};
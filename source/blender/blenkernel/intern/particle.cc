@@ -15,6 +15,8 @@
 #include <cstring>
 #include <optional>
 
+#include <xxhash.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_defaults.h"
@@ -33,6 +35,8 @@
 #include "DNA_scene_types.h"
 #include "DNA_texture_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_hash.hh"
 #include "BLI_kdopbvh.hh"
 #include "BLI_kdtree.h"
 #include "BLI_linklist.h"
@@ -45,6 +49,7 @@
 #include "BLI_rand.h"
 #include "BLI_string.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
 #include "BLI_utildefines.h"
 
@@ -897,11 +902,14 @@ void free_keyed_keys(ParticleSystem *psys)
     }
   }
 }
-static void free_child_path_cache(ParticleSystem *psys)
+void psys_free_child_path_cache(ParticleSystem *psys)
 {
   psys_free_path_cache_buffers(psys->childcache, &psys->childcachebufs);
   psys->childcache = nullptr;
   psys->totchildcache = 0;
+
+  MEM_SAFE_FREE(psys->childcache_parent_hash);
+  psys->childcache_hash = 0;
 }
 void psys_free_path_cache(ParticleSystem *psys, PTCacheEdit *edit)
 {
@@ -915,7 +923,7 @@ void psys_free_path_cache(ParticleSystem *psys, PTCacheEdit *edit)
     psys->pathcache = nullptr;
     psys->totcached = 0;
 
-    free_child_path_cache(psys);
+    psys_free_child_path_cache(psys);
   }
 }
 void psys_free_children(ParticleSystem *psys)
@@ -926,7 +934,7 @@ void psys_free_children(ParticleSystem *psys)
     psys->totchild = 0;
   }
 
-  free_child_path_cache(psys);
+  psys_free_child_path_cache(psys);
 }
 void psys_free_particles(ParticleSystem *psys)
 {
@@ -1200,7 +1208,7 @@ static void get_pointcache_keys_for_time(Object * /*ob*/,
                                          ParticleKey *key1,
                                          ParticleKey *key2)
 {
-  static PTCacheMem *pm = nullptr;
+  PTCacheMem *pm = nullptr;
   int index1, index2;
 
   if (index < 0) { /* initialize */
@@ -3141,41 +3149,208 @@ static void exec_child_path_cache(TaskPool *__restrict /*pool*/, void *taskdata)
   cpa = psys->child + task->begin;
   for (i = task->begin; i < task->end; i++, cpa++) {
     BLI_assert(i < psys->totchildcache);
+    if (ctx->child_needs_update) {
+      if (!ctx->child_needs_update[i]) {
+        continue;
+      }
+      memset(cache[i], 0, sizeof(*cache[i]) * (ctx->segments + ctx->extra_segments + 1));
+    }
     psys_thread_create_path(task, cpa, cache[i], i);
   }
 }
 
+/**
+ * Hash of everything besides the parent paths that the child paths depend on. Returns zero when
+ * the child paths can't be reused, e.g. because they depend on textures or effectors which may
+ * change without any of this changing.
+ */
+static uint64_t child_path_cache_hash(const ParticleThreadContext *ctx)
+{
+  using namespace blender;
+  const ParticleSystem *psys = ctx->sim.psys;
+  const ParticleSettings *part = psys->part;
+
+  if (ctx->editupdate || psys_in_edit_mode(ctx->sim.depsgraph, psys)) {
+    /* Edit mode tracks the changed parents with #PEP_EDIT_RECALC. */
+    return 0;
+  }
+  if ((psys->recalc & ID_RECALC_PSYS_ALL) || (part->flag & PART_CHILD_EFFECT)) {
+    return 0;
+  }
+  for (const MTex *mtex : part->mtex) {
+    if (mtex && mtex->tex && (mtex->mapto & PAMAP_CHILD)) {
+      return 0;
+    }
+  }
+
+  const Mesh *mesh = ctx->mesh;
+  const Span<float3> positions = mesh->vert_positions();
+  /* Animated settings are evaluated in place, so compare their values. */
+  const uint64_t settings_hash = XXH3_64bits(reinterpret_cast<const char *>(part) + sizeof(ID),
+                                             sizeof(ParticleSettings) - sizeof(ID));
+  const uint64_t emitter_hash = get_default_hash(
+      XXH3_64bits(positions.data(), positions.size_in_bytes()),
+      XXH3_64bits(ctx->sim.ob->object_to_world().ptr(), sizeof(float4x4)),
+      mesh->totface_legacy);
+  uint64_t hash = get_default_hash(
+      settings_hash,
+      emitter_hash,
+      get_default_hash(psys->seed, psys->child_seed, ctx->totchild, ctx->totparent),
+      get_default_hash(ctx->between, ctx->segments, ctx->extra_segments));
+
+  for (const float *vg : {ctx->vg_length,
+                          ctx->vg_clump,
+                          ctx->vg_kink,
+                          ctx->vg_rough1,
+                          ctx->vg_rough2,
+                          ctx->vg_roughe,
+                          ctx->vg_twist})
+  {
+    if (vg) {
+      hash = get_default_hash(hash, XXH3_64bits(vg, sizeof(float) * mesh->verts_num));
+    }
+  }
+  if (ctx->ma && part->draw_col == PART_DRAW_COL_MAT) {
+    hash = get_default_hash(hash, ctx->ma->r, ctx->ma->g, ctx->ma->b);
+  }
+
+  /* Zero is reserved for "no reusable cache". */
+  return std::max<uint64_t>(hash, 1);
+}
+
+static uint64_t parent_path_hash(const ParticleSystem *psys, const int totkeys, const int p)
+{
+  using namespace blender;
+  const ParticleData *pa = &psys->particles[p];
+  return get_default_hash(XXH3_64bits(psys->pathcache[p], sizeof(ParticleCacheKey) * totkeys),
+                          pa->num,
+                          pa->num_dmcache,
+                          pa->flag & PARS_UNEXIST);
+}
+
+/**
+ * Find the children that depend on a parent path that changed since the child paths were cached.
+ * Virtual parents are children themselves, so the remaining children also depend on those.
+ */
+static void find_children_to_update(const ParticleThreadContext *ctx,
+                                    const blender::Span<bool> parent_changed,
+                                    blender::MutableSpan<bool> r_child_needs_update)
+{
+  using namespace blender;
+  const ParticleSystem *psys = ctx->sim.psys;
+  const int totparent = ctx->totparent;
+  const int totpart = int(parent_changed.size());
+
+  auto find_in_range = [&](const IndexRange children) {
+    threading::parallel_for(children, 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        const ChildParticle &cpa = psys->child[i];
+        bool changed = false;
+        for (int w = 0; w < 4; w++) {
+          if (cpa.pa[w] >= 0 && cpa.pa[w] < totpart && parent_changed[cpa.pa[w]]) {
+            changed = true;
+          }
+        }
+        if (cpa.parent >= 0) {
+          if (totparent) {
+            if (i >= totparent && cpa.parent < totparent && r_child_needs_update[cpa.parent]) {
+              changed = true;
+            }
+          }
+          else if (cpa.parent < totpart && parent_changed[cpa.parent]) {
+            changed = true;
+          }
+        }
+        r_child_needs_update[i] = changed;
+      }
+    });
+  };
+
+  /* Virtual parents first, the other children read their flags. */
+  find_in_range(IndexRange(totparent));
+  find_in_range(IndexRange::from_begin_end(totparent, ctx->totchild));
+}
+
 void psys_cache_child_paths(ParticleSimulationData *sim,
                             float cfra,
                             const bool editupdate,
                             const bool use_render_params)
 {
-  if (sim->psys->flag & PSYS_GLOBAL_HAIR) {
+  using namespace blender;
+  ParticleSystem *psys = sim->psys;
+
+  if (psys->flag & PSYS_GLOBAL_HAIR) {
+    if (!editupdate) {
+      psys_free_child_path_cache(psys);
+    }
     return;
   }
 
   /* create a task pool for child path tasks */
   ParticleThreadContext ctx;
   if (!psys_thread_context_init_path(&ctx, sim, sim->scene, cfra, editupdate, use_render_params)) {
+    if (!editupdate) {
+      psys_free_child_path_cache(psys);
+    }
     return;
   }
 
-  TaskPool *task_pool = BLI_task_pool_create(&ctx, TASK_PRIORITY_HIGH);
   const int totchild = ctx.totchild;
   const int totparent = ctx.totparent;
 
-  if (editupdate && sim->psys->childcache && totchild == sim->psys->totchildcache) {
+  /* Hash the parent paths, to find the children whose parents changed since the last update. */
+  const uint64_t cache_hash = psys->pathcache ? child_path_cache_hash(&ctx) : 0;
+  const int totpart = psys->totcached;
+  Array<uint64_t> parent_hashes;
+  if (cache_hash != 0) {
+    parent_hashes.reinitialize(totpart);
+    threading::parallel_for(IndexRange(totpart), 1024, [&](const IndexRange range) {
+      for (const int p : range) {
+        parent_hashes[p] = parent_path_hash(psys, ctx.segments + 1, p);
+      }
+    });
+  }
+
+  const bool reuse_cache = cache_hash != 0 && cache_hash == psys->childcache_hash &&
+                           psys->childcache && totchild == psys->totchildcache &&
+                           psys->childcache_parent_hash &&
+                           MEM_allocN_len(psys->childcache_parent_hash) ==
+                               sizeof(uint64_t) * size_t(totpart);
+  Array<bool> child_needs_update;
+
+  if (reuse_cache) {
+    Array<bool> parent_changed(totpart);
+    threading::parallel_for(IndexRange(totpart), 4096, [&](const IndexRange range) {
+      for (const int p : range) {
+        parent_changed[p] = parent_hashes[p] != psys->childcache_parent_hash[p];
+      }
+    });
+    child_needs_update.reinitialize(totchild);
+    find_children_to_update(&ctx, parent_changed, child_needs_update);
+    ctx.child_needs_update = child_needs_update.data();
+  }
+  else if (editupdate && psys->childcache && totchild == psys->totchildcache) {
     /* just overwrite the existing cache */
   }
   else {
     /* clear out old and create new empty path cache */
-    free_child_path_cache(sim->psys);
+    psys_free_child_path_cache(psys);
+
+    psys->childcache = psys_alloc_path_cache_buffers(
+        &psys->childcachebufs, totchild, ctx.segments + ctx.extra_segments + 1);
+    psys->totchildcache = totchild;
+  }
 
-    sim->psys->childcache = psys_alloc_path_cache_buffers(
-        &sim->psys->childcachebufs, totchild, ctx.segments + ctx.extra_segments + 1);
-    sim->psys->totchildcache = totchild;
+  /* Remember what the cache is created from, or that it can't be reused. */
+  MEM_SAFE_FREE(psys->childcache_parent_hash);
+  psys->childcache_hash = cache_hash;
+  if (cache_hash != 0) {
+    psys->childcache_parent_hash = MEM_malloc_arrayN<uint64_t>(size_t(totpart), __func__);
+    std::copy_n(parent_hashes.data(), totpart, psys->childcache_parent_hash);
   }
 
+  TaskPool *task_pool = BLI_task_pool_create(&ctx, TASK_PRIORITY_HIGH);
+
   /* cache parent paths */
   ctx.parent_pass = 1;
   blender::Vector<ParticleTask> tasks_parent = psys_tasks_create(&ctx, 0, totparent);
@@ -3246,35 +3421,25 @@ static void cache_key_incremental_rotation(ParticleCacheKey *key0,
 
 void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_render_params)
 {
+  using namespace blender;
   PARTICLE_PSMD;
   ParticleEditSettings *pset = &sim->scene->toolsettings->particle;
   ParticleSystem *psys = sim->psys;
   ParticleSettings *part = psys->part;
-  ParticleCacheKey *ca, **cache;
+  ParticleCacheKey **cache;
 
   Mesh *hair_mesh = (psys->part->type == PART_HAIR && psys->flag & PSYS_HAIR_DYNAMICS) ?
                         psys->hair_out_mesh :
                         nullptr;
 
-  ParticleKey result;
-
   Material *ma;
-  ParticleInterpolationData pind;
-  ParticleTexture ptex;
-
-  PARTICLE_P;
 
-  float birthtime = 0.0, dietime = 0.0;
-  float t, time = 0.0, dfra = 1.0;
+  float dfra = 1.0;
   float col[4] = {0.5f, 0.5f, 0.5f, 1.0f};
-  float prev_tangent[3] = {0.0f, 0.0f, 0.0f}, hairmat[4][4];
-  float rotmat[3][3];
-  int k;
   int segments = int(pow(2.0, double((use_render_params) ? part->ren_step : part->draw_step)));
   int totpart = psys->totpart;
-  float length, vec[3];
   float *vg_effector = nullptr;
-  float *vg_length = nullptr, pa_length = 1.0f;
+  float *vg_length = nullptr;
   int keyed, baked;
 
   /* we don't have anything valid to create paths from so let's quit here */
@@ -3291,8 +3456,10 @@ void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_re
   keyed = psys->flag & PSYS_KEYED;
   baked = psys->pointcache->mem_cache.first && psys->part->type != PART_HAIR;
 
-  /* clear out old and create new empty path cache */
-  psys_free_path_cache(psys, psys->edit);
+  /* Clear out old and create new empty path cache. The child paths are kept so that
+   * #psys_cache_child_paths can reuse the paths of children whose parents didn't change. */
+  psys_free_path_cache(nullptr, psys->edit);
+  psys_free_path_cache_buffers(psys->pathcache, &psys->pathcachebufs);
   cache = psys->pathcache = psys_alloc_path_cache_buffers(
       &psys->pathcachebufs, totpart, segments + 1);
 
@@ -3318,149 +3485,163 @@ void psys_cache_paths(ParticleSimulationData *sim, float cfra, const bool use_re
   }
 
   /*---first main loop: create all actual particles' paths---*/
-  LOOP_PARTICLES
-  {
-    if (!psys->totchild) {
-      psys_get_texture(sim, pa, &ptex, PAMAP_LENGTH, 0.0f);
-      pa_length = ptex.length * (1.0f - part->randlength * psys_frand(psys, psys->seed + p));
-      if (vg_length) {
-        pa_length *= psys_particle_value_from_verts(psmd->mesh_final, part->from, pa, vg_length);
+  threading::parallel_for(IndexRange(totpart), 64, [&](const IndexRange range) {
+    for (const int p : range) {
+      ParticleData *pa = psys->particles + p;
+      ParticleCacheKey *ca;
+      ParticleKey result;
+      ParticleInterpolationData pind;
+      ParticleTexture ptex;
+      float birthtime = 0.0, dietime = 0.0;
+      float t, time = 0.0;
+      float prev_tangent[3] = {0.0f, 0.0f, 0.0f}, hairmat[4][4];
+      float rotmat[3][3];
+      float length, vec[3];
+      float pa_length = 1.0f;
+      int k;
+
+      if (!psys->totchild) {
+        psys_get_texture(sim, pa, &ptex, PAMAP_LENGTH, 0.0f);
+        pa_length = ptex.length * (1.0f - part->randlength * psys_frand(psys, psys->seed + p));
+        if (vg_length) {
+          pa_length *= psys_particle_value_from_verts(psmd->mesh_final, part->from, pa, vg_length);
+        }
       }
-    }
 
-    pind.keyed = keyed;
-    pind.cache = baked ? psys->pointcache : nullptr;
-    pind.epoint = nullptr;
-    pind.bspline = (psys->part->flag & PART_HAIR_BSPLINE);
-    pind.mesh = hair_mesh;
+      pind.keyed = keyed;
+      pind.cache = baked ? psys->pointcache : nullptr;
+      pind.epoint = nullptr;
+      pind.bspline = (psys->part->flag & PART_HAIR_BSPLINE);
+      pind.mesh = hair_mesh;
 
-    memset(cache[p], 0, sizeof(*cache[p]) * (segments + 1));
+      memset(cache[p], 0, sizeof(*cache[p]) * (segments + 1));
 
-    cache[p]->segments = segments;
+      cache[p]->segments = segments;
 
-    /*--get the first data points--*/
-    init_particle_interpolation(sim->ob, sim->psys, pa, &pind);
+      /*--get the first data points--*/
+      init_particle_interpolation(sim->ob, sim->psys, pa, &pind);
 
-    /* 'hairmat' is needed for non-hair particle too so we get proper rotations. */
-    psys_mat_hair_to_global(sim->ob, psmd->mesh_final, psys->part->from, pa, hairmat);
-    copy_v3_v3(rotmat[0], hairmat[2]);
-    copy_v3_v3(rotmat[1], hairmat[1]);
-    copy_v3_v3(rotmat[2], hairmat[0]);
+      /* 'hairmat' is needed for non-hair particle too so we get proper rotations. */
+      psys_mat_hair_to_global(sim->ob, psmd->mesh_final, psys->part->from, pa, hairmat);
+      copy_v3_v3(rotmat[0], hairmat[2]);
+      copy_v3_v3(rotmat[1], hairmat[1]);
+      copy_v3_v3(rotmat[2], hairmat[0]);
 
-    if (part->draw & PART_ABS_PATH_TIME) {
-      birthtime = std::max(pind.birthtime, part->path_start);
-      dietime = std::min(pind.dietime, part->path_end);
-    }
-    else {
-      float tb = pind.birthtime;
-      birthtime = tb + part->path_start * (pind.dietime - tb);
-      dietime = tb + part->path_end * (pind.dietime - tb);
-    }
+      if (part->draw & PART_ABS_PATH_TIME) {
+        birthtime = std::max(pind.birthtime, part->path_start);
+        dietime = std::min(pind.dietime, part->path_end);
+      }
+      else {
+        float tb = pind.birthtime;
+        birthtime = tb + part->path_start * (pind.dietime - tb);
+        dietime = tb + part->path_end * (pind.dietime - tb);
+      }
 
-    if (birthtime >= dietime) {
-      cache[p]->segments = -1;
-      continue;
-    }
+      if (birthtime >= dietime) {
+        cache[p]->segments = -1;
+        continue;
+      }
 
-    dietime = birthtime + pa_length * (dietime - birthtime);
+      dietime = birthtime + pa_length * (dietime - birthtime);
 
-    /*--interpolate actual path from data points--*/
-    for (k = 0, ca = cache[p]; k <= segments; k++, ca++) {
-      time = float(k) / float(segments);
-      t = birthtime + time * (dietime - birthtime);
-      result.time = -t;
-      do_particle_interpolation(psys, p, pa, t, &pind, &result);
-      copy_v3_v3(ca->co, result.co);
+      /*--interpolate actual path from data points--*/
+      for (k = 0, ca = cache[p]; k <= segments; k++, ca++) {
+        time = float(k) / float(segments);
+        t = birthtime + time * (dietime - birthtime);
+        result.time = -t;
+        do_particle_interpolation(psys, p, pa, t, &pind, &result);
+        copy_v3_v3(ca->co, result.co);
 
-      /* dynamic hair is in object space */
-      /* keyed and baked are already in global space */
-      if (hair_mesh) {
-        mul_m4_v3(sim->ob->object_to_world().ptr(), ca->co);
-      }
-      else if (!keyed && !baked && !(psys->flag & PSYS_GLOBAL_HAIR)) {
-        mul_m4_v3(hairmat, ca->co);
-      }
+        /* dynamic hair is in object space */
+        /* keyed and baked are already in global space */
+        if (hair_mesh) {
+          mul_m4_v3(sim->ob->object_to_world().ptr(), ca->co);
+        }
+        else if (!keyed && !baked && !(psys->flag & PSYS_GLOBAL_HAIR)) {
+          mul_m4_v3(hairmat, ca->co);
+        }
 
-      copy_v3_v3(ca->col, col);
-    }
+        copy_v3_v3(ca->col, col);
+      }
 
-    if (part->type == PART_HAIR) {
-      HairKey *hkey;
+      if (part->type == PART_HAIR) {
+        HairKey *hkey;
 
-      for (k = 0, hkey = pa->hair; k < pa->totkey; k++, hkey++) {
-        mul_v3_m4v3(hkey->world_co, hairmat, hkey->co);
+        for (k = 0, hkey = pa->hair; k < pa->totkey; k++, hkey++) {
+          mul_v3_m4v3(hkey->world_co, hairmat, hkey->co);
+        }
       }
-    }
 
-    /*--modify paths and calculate rotation & velocity--*/
+      /*--modify paths and calculate rotation & velocity--*/
 
-    if (!(psys->flag & PSYS_GLOBAL_HAIR)) {
-      /* apply effectors */
-      if ((psys->part->flag & PART_CHILD_EFFECT) == 0) {
-        float effector = 1.0f;
-        if (vg_effector) {
-          effector *= psys_particle_value_from_verts(
-              psmd->mesh_final, psys->part->from, pa, vg_effector);
-        }
+      if (!(psys->flag & PSYS_GLOBAL_HAIR)) {
+        /* apply effectors */
+        if ((psys->part->flag & PART_CHILD_EFFECT) == 0) {
+          float effector = 1.0f;
+          if (vg_effector) {
+            effector *= psys_particle_value_from_verts(
+                psmd->mesh_final, psys->part->from, pa, vg_effector);
+          }
 
-        sub_v3_v3v3(vec, (cache[p] + 1)->co, cache[p]->co);
-        length = len_v3(vec);
+          sub_v3_v3v3(vec, (cache[p] + 1)->co, cache[p]->co);
+          length = len_v3(vec);
 
-        for (k = 1, ca = cache[p] + 1; k <= segments; k++, ca++) {
-          do_path_effectors(
-              sim, p, ca, k, segments, cache[p]->co, effector, dfra, cfra, &length, vec);
+          for (k = 1, ca = cache[p] + 1; k <= segments; k++, ca++) {
+            do_path_effectors(
+                sim, p, ca, k, segments, cache[p]->co, effector, dfra, cfra, &length, vec);
+          }
         }
-      }
 
-      /* apply guide curves to path data */
-      if (sim->psys->effectors && (psys->part->flag & PART_CHILD_EFFECT) == 0) {
-        for (k = 0, ca = cache[p]; k <= segments; k++, ca++) {
-          /* ca is safe to cast, since only co and vel are used */
-          do_guides(sim->depsgraph,
-                    sim->psys->part,
-                    sim->psys->effectors,
-                    (ParticleKey *)ca,
-                    p,
-                    float(k) / float(segments));
+        /* apply guide curves to path data */
+        if (sim->psys->effectors && (psys->part->flag & PART_CHILD_EFFECT) == 0) {
+          for (k = 0, ca = cache[p]; k <= segments; k++, ca++) {
+            /* ca is safe to cast, since only co and vel are used */
+            do_guides(sim->depsgraph,
+                      sim->psys->part,
+                      sim->psys->effectors,
+                      (ParticleKey *)ca,
+                      p,
+                      float(k) / float(segments));
+          }
         }
-      }
 
-      /* Lattices have to be calculated separately to avoid mix-ups between effector calculations.
-       */
-      if (psys->lattice_deform_data) {
-        for (k = 0, ca = cache[p]; k <= segments; k++, ca++) {
-          BKE_lattice_deform_data_eval_co(
-              psys->lattice_deform_data, ca->co, psys->lattice_strength);
+        /* Lattices have to be calculated separately to avoid mix-ups between effector
+         * calculations. */
+        if (psys->lattice_deform_data) {
+          for (k = 0, ca = cache[p]; k <= segments; k++, ca++) {
+            BKE_lattice_deform_data_eval_co(
+                psys->lattice_deform_data, ca->co, psys->lattice_strength);
+          }
         }
       }
-    }
 
-    /* finally do rotation & velocity */
-    for (k = 1, ca = cache[p] + 1; k <= segments; k++, ca++) {
-      cache_key_incremental_rotation(ca, ca - 1, ca - 2, prev_tangent, k);
+      /* finally do rotation & velocity */
+      for (k = 1, ca = cache[p] + 1; k <= segments; k++, ca++) {
+        cache_key_incremental_rotation(ca, ca - 1, ca - 2, prev_tangent, k);
 
-      if (k == segments) {
-        copy_qt_qt(ca->rot, (ca - 1)->rot);
-      }
+        if (k == segments) {
+          copy_qt_qt(ca->rot, (ca - 1)->rot);
+        }
 
-      /* set velocity */
-      sub_v3_v3v3(ca->vel, ca->co, (ca - 1)->co);
+        /* set velocity */
+        sub_v3_v3v3(ca->vel, ca->co, (ca - 1)->co);
 
-      if (k == 1) {
-        copy_v3_v3((ca - 1)->vel, ca->vel);
-      }
+        if (k == 1) {
+          copy_v3_v3((ca - 1)->vel, ca->vel);
+        }
 
-      ca->time = float(k) / float(segments);
+        ca->time = float(k) / float(segments);
+      }
+      /* First rotation is based on emitting face orientation.
+       * This is way better than having flipping rotations resulting
+       * from using a global axis as a rotation pole (vec_to_quat()).
+       * It's not an ideal solution though since it disregards the
+       * initial tangent, but taking that in to account will allow
+       * the possibility of flipping again. -jahka
+       */
+      mat3_to_quat_legacy(cache[p]->rot, rotmat);
     }
-    /* First rotation is based on emitting face orientation.
-     * This is way better than having flipping rotations resulting
-     * from using a global axis as a rotation pole (vec_to_quat()).
-     * It's not an ideal solution though since it disregards the
-     * initial tangent, but taking that in to account will allow
-     * the possibility of flipping again. -jahka
-     */
-    mat3_to_quat_legacy(cache[p]->rot, rotmat);
-  }
+  });
 
   psys->totcached = totpart;
 
@@ -5393,6 +5574,8 @@ void BKE_particle_system_blend_read_data(BlendDataReader *reader, ListBase *part
     psys->free_edit = nullptr;
     psys->pathcache = nullptr;
     psys->childcache = nullptr;
+    psys->childcache_parent_hash = nullptr;
+    psys->childcache_hash = 0;
     BLI_listbase_clear(&psys->pathcachebufs);
     BLI_listbase_clear(&psys->childcachebufs);
     psys->pdd = nullptr;
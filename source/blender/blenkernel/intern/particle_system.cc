@@ -3209,6 +3209,9 @@ static void psys_update_path_cache(ParticleSimulationData *sim,
           psys_find_parents(sim, use_render_params);
         }
       }
+
+      /* Children moved, none of their paths can be reused. */
+      psys_free_child_path_cache(psys);
     }
     else {
       psys_free_children(psys);
@@ -3255,10 +3258,17 @@ static void psys_update_path_cache(ParticleSimulationData *sim,
       else if (psys->part->type == PART_HAIR && (psys->flag & PSYS_HAIR_DONE) == 0) {
         skip = 1;
       }
+    }
+    else {
+      skip = 1;
+    }
 
-      if (!skip) {
-        psys_cache_child_paths(sim, cfra, false, use_render_params);
-      }
+    if (!skip) {
+      psys_cache_child_paths(sim, cfra, false, use_render_params);
+    }
+    else {
+      /* The parent paths changed, the child paths are no longer valid. */
+      psys_free_child_path_cache(psys);
     }
   }
   else if (psys->pathcache) {
@@ -6,6 +6,7 @@
  * \ingroup bke
  */
 
+#include <atomic>
 #include <cfloat>
 
 #include "BLI_array_utils.hh"
@@ -106,28 +107,51 @@ BLI_NOINLINE static void build_mesh_leaf_nodes(const int verts_num,
     }
   });
 
-  Vector<int> owned_verts;
-  Vector<int> shared_verts;
-  BitVector<> vert_used(verts_num);
-  for (const int i : nodes.index_range()) {
-    MeshNode &node = nodes[i];
-
-    owned_verts.clear();
-    shared_verts.clear();
-    for (const int vert : verts_per_node[i]) {
-      if (vert_used[vert]) {
-        shared_verts.append(vert);
+  /* Each vertex is owned by the first node that uses it. Finding the owners with an atomic
+   * minimum allows processing the nodes in parallel, which matters when the tree is rebuilt after
+   * topology changes on large meshes, while giving the same result as visiting them in order. */
+  Array<std::atomic<int>> vert_owners(verts_num);
+  threading::parallel_for(vert_owners.index_range(), 4096, [&](const IndexRange range) {
+    for (std::atomic<int> &owner : vert_owners.as_mutable_span().slice(range)) {
+      owner.store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+    }
+  });
+  threading::parallel_for(nodes.index_range(), 8, [&](const IndexRange range) {
+    for (const int i : range) {
+      for (const int vert : verts_per_node[i]) {
+        std::atomic<int> &owner = vert_owners[vert];
+        int current = owner.load(std::memory_order_relaxed);
+        while (i < current) {
+          if (owner.compare_exchange_weak(current, i, std::memory_order_relaxed)) {
+            break;
+          }
+        }
       }
-      else {
-        vert_used[vert].set();
-        owned_verts.append(vert);
+    }
+  });
+
+  threading::parallel_for(nodes.index_range(), 8, [&](const IndexRange range) {
+    Vector<int> owned_verts;
+    Vector<int> shared_verts;
+    for (const int i : range) {
+      MeshNode &node = nodes[i];
+
+      owned_verts.clear();
+      shared_verts.clear();
+      for (const int vert : verts_per_node[i]) {
+        if (vert_owners[vert].load(std::memory_order_relaxed) == i) {
+          owned_verts.append(vert);
+        }
+        else {
+          shared_verts.append(vert);
+        }
       }
+      node.unique_verts_num_ = owned_verts.size();
+      node.vert_indices_.reserve(owned_verts.size() + shared_verts.size());
+      node.vert_indices_.add_multiple(owned_verts);
+      node.vert_indices_.add_multiple(shared_verts);
     }
-    node.unique_verts_num_ = owned_verts.size();
-    node.vert_indices_.reserve(owned_verts.size() + shared_verts.size());
-    node.vert_indices_.add_multiple(owned_verts);
-    node.vert_indices_.add_multiple(shared_verts);
-  }
+  });
 }
 
 static bool leaf_needs_material_split(const Span<int> faces, const Span<int> material_indices)
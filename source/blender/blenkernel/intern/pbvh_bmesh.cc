@@ -14,8 +14,10 @@
 #include "BLI_math_vector.hh"
 #include "BLI_memarena.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 #include "BKE_paint_bvh.hh"
@@ -925,55 +927,121 @@ static void long_edge_queue_edge_add_recursive(const EdgeQueueContext *eq_ctx,
   }
 }
 
-static void short_edge_queue_edge_add(const EdgeQueueContext *eq_ctx, BMEdge *e)
-{
-  if (!EDGE_QUEUE_TEST(e)) {
-    if (BM_edge_calc_length_squared(e) < eq_ctx->queue->limit_len_squared) {
-      edge_queue_insert(eq_ctx, e, short_edge_queue_priority(*e));
-    }
-  }
-}
+/**
+ * An edge to add to the queue, found before the queue is filled. Finding the candidates only reads
+ * the mesh, so it can be done for many nodes in parallel, while adding them to the queue is done
+ * in order to give the same result as adding them directly.
+ */
+struct EdgeQueueCandidate {
+  const BMLoop *loop;
+  /** The squared edge length for the long edge queue, the priority for the short edge queue. */
+  float value;
+};
 
-static void long_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+static bool edge_queue_face_in_range(const EdgeQueueContext *eq_ctx, BMFace *f)
 {
   if (eq_ctx->queue->use_front_face) {
     if (dot_v3v3(f->no, *eq_ctx->queue->view_normal) < 0.0f) {
-      return;
+      return false;
     }
   }
+  return eq_ctx->queue->edge_queue_tri_in_range(eq_ctx->queue, f);
+}
 
-  if (eq_ctx->queue->edge_queue_tri_in_range(eq_ctx->queue, f)) {
+template<typename VectorT>
+static void long_edge_queue_face_candidates_find(const EdgeQueueContext *eq_ctx,
+                                                 BMFace *f,
+                                                 VectorT &r_candidates)
+{
+  if (edge_queue_face_in_range(eq_ctx, f)) {
     /* Check each edge of the face. */
     const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     const BMLoop *l_iter = l_first;
     do {
       const float len_sq = BM_edge_calc_length_squared(l_iter->e);
       if (len_sq > eq_ctx->queue->limit_len_squared) {
-        long_edge_queue_edge_add_recursive(
-            eq_ctx, l_iter->radial_next, l_iter, len_sq, eq_ctx->queue->limit_len);
+        r_candidates.append({l_iter, len_sq});
       }
     } while ((l_iter = l_iter->next) != l_first);
   }
 }
 
-static void short_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+static void long_edge_queue_candidate_add(const EdgeQueueContext *eq_ctx,
+                                          const EdgeQueueCandidate &candidate)
 {
-  if (eq_ctx->queue->use_front_face) {
-    if (dot_v3v3(f->no, *eq_ctx->queue->view_normal) < 0.0f) {
-      return;
-    }
+  long_edge_queue_edge_add_recursive(eq_ctx,
+                                     candidate.loop->radial_next,
+                                     candidate.loop,
+                                     candidate.value,
+                                     eq_ctx->queue->limit_len);
+}
+
+static void long_edge_queue_face_add(const EdgeQueueContext *eq_ctx, BMFace *f)
+{
+  Vector<EdgeQueueCandidate, 3> candidates;
+  long_edge_queue_face_candidates_find(eq_ctx, f, candidates);
+  for (const EdgeQueueCandidate &candidate : candidates) {
+    long_edge_queue_candidate_add(eq_ctx, candidate);
   }
+}
 
-  if (eq_ctx->queue->edge_queue_tri_in_range(eq_ctx->queue, f)) {
+static void short_edge_queue_face_candidates_find(const EdgeQueueContext *eq_ctx,
+                                                  BMFace *f,
+                                                  Vector<EdgeQueueCandidate> &r_candidates)
+{
+  if (edge_queue_face_in_range(eq_ctx, f)) {
     /* Check each edge of the face. */
     const BMLoop *l_first = BM_FACE_FIRST_LOOP(f);
     const BMLoop *l_iter = l_first;
     do {
-      short_edge_queue_edge_add(eq_ctx, l_iter->e);
+      if (BM_edge_calc_length_squared(l_iter->e) < eq_ctx->queue->limit_len_squared) {
+        r_candidates.append({l_iter, short_edge_queue_priority(*l_iter->e)});
+      }
     } while ((l_iter = l_iter->next) != l_first);
   }
 }
 
+static void short_edge_queue_candidate_add(const EdgeQueueContext *eq_ctx,
+                                           const EdgeQueueCandidate &candidate)
+{
+  BMEdge *e = candidate.loop->e;
+  if (!EDGE_QUEUE_TEST(e)) {
+    edge_queue_insert(eq_ctx, e, candidate.value);
+  }
+}
+
+/**
+ * Find the queue candidates of the faces of all leaf nodes marked for topology update in parallel,
+ * then add them to the queue in the order of the nodes.
+ */
+template<typename FindFn, typename AddFn>
+static void edge_queue_candidates_add(const EdgeQueueContext *eq_ctx,
+                                      MutableSpan<BMeshNode> nodes,
+                                      const FindFn find_fn,
+                                      const AddFn add_fn)
+{
+  IndexMaskMemory memory;
+  const IndexMask nodes_to_update = IndexMask::from_predicate(
+      nodes.index_range(), GrainSize(1024), memory, [&](const int i) {
+        const BMeshNode &node = nodes[i];
+        return (node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
+               !(node.flag_ & Node::FullyHidden);
+      });
+
+  Array<Vector<EdgeQueueCandidate>> node_candidates(nodes_to_update.size());
+  nodes_to_update.foreach_index(GrainSize(1), [&](const int i, const int pos) {
+    for (BMFace *f : nodes[i].bm_faces_) {
+      find_fn(eq_ctx, f, node_candidates[pos]);
+    }
+  });
+
+  for (const Span<EdgeQueueCandidate> candidates : node_candidates) {
+    for (const EdgeQueueCandidate &candidate : candidates) {
+      add_fn(eq_ctx, candidate);
+    }
+  }
+}
+
 /**
  * Create a priority queue containing vertex pairs connected by a long
  * edge as defined by Tree.bm_max_edge_len.
@@ -1019,16 +1087,10 @@ static void long_edge_queue_create(const EdgeQueueContext *eq_ctx,
   pbvh_bmesh_edge_tag_verify(pbvh);
 #endif
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update. */
-    if ((node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
-        !(node.flag_ & Node::FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        long_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_candidates_add(eq_ctx,
+                            nodes,
+                            long_edge_queue_face_candidates_find<Vector<EdgeQueueCandidate>>,
+                            long_edge_queue_candidate_add);
 }
 
 /**
@@ -1072,16 +1134,8 @@ static void short_edge_queue_create(const EdgeQueueContext *eq_ctx,
     eq_ctx->queue->edge_queue_tri_in_range = edge_queue_tri_in_sphere;
   }
 
-  for (BMeshNode &node : nodes) {
-    /* Check leaf nodes marked for topology update */
-    if ((node.flag_ & Node::Leaf) && (node.flag_ & Node::UpdateTopology) &&
-        !(node.flag_ & Node::FullyHidden))
-    {
-      for (BMFace *f : node.bm_faces_) {
-        short_edge_queue_face_add(eq_ctx, f);
-      }
-    }
-  }
+  edge_queue_candidates_add(
+      eq_ctx, nodes, short_edge_queue_face_candidates_find, short_edge_queue_candidate_add);
 }
 
 /*************************** Topology update **************************/
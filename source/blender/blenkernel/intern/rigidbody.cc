@@ -17,11 +17,14 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_hash.hh"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
 #include "BLI_mutex.hh"
+#include "BLI_struct_equality_utils.hh"
 
 #ifdef WITH_BULLET
 #  include "RBI_api.h"
@@ -385,10 +388,95 @@ static rbCollisionShape *rigidbody_get_shape_trimesh_from_mesh(Object *ob)
   return shape;
 }
 
+/**
+ * Mesh based collision shapes built during one update of the simulation. Objects using the same
+ * mesh get an instance of the same prototype shape, so the convex hull or the triangle BVH is
+ * only computed once instead of once per object.
+ */
+struct RigidBodyShapeCache {
+  struct Key {
+    const Mesh *mesh;
+    short shape;
+    float hull_margin;
+
+    uint64_t hash() const
+    {
+      return blender::get_default_hash(mesh, shape, hull_margin);
+    }
+
+    BLI_STRUCT_EQUALITY_OPERATORS_3(Key, mesh, shape, hull_margin)
+  };
+
+  struct Prototype {
+    rbCollisionShape *shape = nullptr;
+    bool can_embed = true;
+  };
+
+  blender::Map<Key, Prototype> prototypes;
+
+  ~RigidBodyShapeCache()
+  {
+    for (const Prototype &prototype : prototypes.values()) {
+      if (prototype.shape) {
+        RB_shape_delete(prototype.shape);
+      }
+    }
+  }
+};
+
+static bool rigidbody_shape_cache_supported(const Object *ob)
+{
+  const RigidBodyOb *rbo = ob->rigidbody_object;
+  if (ob->type != OB_MESH || ob->data == nullptr) {
+    return false;
+  }
+  if (rbo->shape == RB_SHAPE_CONVEXH) {
+    return true;
+  }
+  /* GImpact meshes of active objects can't be instanced and deforming meshes are updated in
+   * place, only static BVH triangle meshes can be shared. */
+  return rbo->shape == RB_SHAPE_TRIMESH && rbo->type == RBO_TYPE_PASSIVE &&
+         !(rbo->flag & RBO_FLAG_USE_DEFORM);
+}
+
+/* Get a new instance of the cached shape for the object's mesh, building it on first use. */
+static rbCollisionShape *rigidbody_get_shape_from_cache(RigidBodyShapeCache &shape_cache,
+                                                        Object *ob,
+                                                        float hull_margin,
+                                                        bool *can_embed)
+{
+  const Mesh *mesh = rigidbody_get_mesh(ob);
+  if (mesh == nullptr) {
+    return nullptr;
+  }
+
+  const short shape = ob->rigidbody_object->shape;
+  const RigidBodyShapeCache::Key key{mesh, shape, hull_margin};
+  const RigidBodyShapeCache::Prototype &prototype = shape_cache.prototypes.lookup_or_add_cb(
+      key, [&]() {
+        RigidBodyShapeCache::Prototype new_prototype;
+        new_prototype.shape = (shape == RB_SHAPE_CONVEXH) ?
+                                  rigidbody_get_shape_convexhull_from_mesh(
+                                      ob, hull_margin, &new_prototype.can_embed) :
+                                  rigidbody_get_shape_trimesh_from_mesh(ob);
+        return new_prototype;
+      });
+
+  if (prototype.shape == nullptr) {
+    return nullptr;
+  }
+  *can_embed = prototype.can_embed;
+  return RB_shape_new_instance(prototype.shape);
+}
+
 /* Helper function to create physics collision shape for object.
  * Returns a new collision shape.
+ *
+ * \param shape_cache: Optional, shares mesh based shapes between objects using the same mesh.
  */
-static rbCollisionShape *rigidbody_validate_sim_shape_helper(RigidBodyWorld *rbw, Object *ob)
+static rbCollisionShape *rigidbody_validate_sim_shape_helper(RigidBodyWorld *rbw,
+                                                             Object *ob,
+                                                             RigidBodyShapeCache *shape_cache)
 {
   RigidBodyOb *rbo = ob->rigidbody_object;
   rbCollisionShape *new_shape = nullptr;
@@ -455,7 +543,12 @@ static rbCollisionShape *rigidbody_validate_sim_shape_helper(RigidBodyWorld *rbw
       if (!(rbo->flag & RBO_FLAG_USE_MARGIN) && has_volume) {
         hull_margin = 0.04f;
       }
-      new_shape = rigidbody_get_shape_convexhull_from_mesh(ob, hull_margin, &can_embed);
+      if (shape_cache && rigidbody_shape_cache_supported(ob)) {
+        new_shape = rigidbody_get_shape_from_cache(*shape_cache, ob, hull_margin, &can_embed);
+      }
+      else {
+        new_shape = rigidbody_get_shape_convexhull_from_mesh(ob, hull_margin, &can_embed);
+      }
       if (!(rbo->flag & RBO_FLAG_USE_MARGIN)) {
         rbo->margin = (can_embed && has_volume) ?
                           0.04f :
@@ -463,7 +556,12 @@ static rbCollisionShape *rigidbody_validate_sim_shape_helper(RigidBodyWorld *rbw
       }
       break;
     case RB_SHAPE_TRIMESH:
-      new_shape = rigidbody_get_shape_trimesh_from_mesh(ob);
+      if (shape_cache && rigidbody_shape_cache_supported(ob)) {
+        new_shape = rigidbody_get_shape_from_cache(*shape_cache, ob, 0.0f, &can_embed);
+      }
+      else {
+        new_shape = rigidbody_get_shape_trimesh_from_mesh(ob);
+      }
       break;
     case RB_SHAPE_COMPOUND:
       new_shape = RB_shape_new_compound();
@@ -473,7 +571,7 @@ static rbCollisionShape *rigidbody_validate_sim_shape_helper(RigidBodyWorld *rbw
       /* Add children to the compound shape */
       FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, childObject) {
         if (childObject->parent == ob) {
-          childShape = rigidbody_validate_sim_shape_helper(rbw, childObject);
+          childShape = rigidbody_validate_sim_shape_helper(rbw, childObject, shape_cache);
           if (childShape) {
             BKE_object_matrix_local_get(childObject, mat);
             mat4_to_loc_quat(loc, rot, mat);
@@ -499,7 +597,10 @@ static rbCollisionShape *rigidbody_validate_sim_shape_helper(RigidBodyWorld *rbw
 /* Create new physics sim collision shape for object and store it,
  * or remove the existing one first and replace...
  */
-static void rigidbody_validate_sim_shape(RigidBodyWorld *rbw, Object *ob, bool rebuild)
+static void rigidbody_validate_sim_shape(RigidBodyWorld *rbw,
+                                         Object *ob,
+                                         bool rebuild,
+                                         RigidBodyShapeCache *shape_cache)
 {
   RigidBodyOb *rbo = ob->rigidbody_object;
   rbCollisionShape *new_shape = nullptr;
@@ -521,7 +622,7 @@ static void rigidbody_validate_sim_shape(RigidBodyWorld *rbw, Object *ob, bool r
     return;
   }
 
-  new_shape = rigidbody_validate_sim_shape_helper(rbw, ob);
+  new_shape = rigidbody_validate_sim_shape_helper(rbw, ob, shape_cache);
 
   /* assign new collision shape if creation was successful */
   if (new_shape) {
@@ -694,7 +795,10 @@ void BKE_rigidbody_calc_center_of_mass(Object *ob, float r_center[3])
  *
  * \param rebuild: Even if an instance already exists, replace it
  */
-static void rigidbody_validate_sim_object(RigidBodyWorld *rbw, Object *ob, bool rebuild)
+static void rigidbody_validate_sim_object(RigidBodyWorld *rbw,
+                                          Object *ob,
+                                          bool rebuild,
+                                          RigidBodyShapeCache *shape_cache)
 {
   RigidBodyOb *rbo = (ob) ? ob->rigidbody_object : nullptr;
   float loc[3];
@@ -711,7 +815,7 @@ static void rigidbody_validate_sim_object(RigidBodyWorld *rbw, Object *ob, bool
   /* FIXME we shouldn't always have to rebuild collision shapes when rebuilding objects,
    * but it's needed for constraints to update correctly. */
   if (rbo->shared->physics_shape == nullptr || rebuild) {
-    rigidbody_validate_sim_shape(rbw, ob, true);
+    rigidbody_validate_sim_shape(rbw, ob, true, shape_cache);
   }
 
   if (rbo->shared->physics_object && !rebuild) {
@@ -1759,6 +1863,10 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
     FOREACH_COLLECTION_OBJECT_RECURSIVE_END;
   }
 
+  /* Shapes are only shared between objects validated in this update, the cache does not outlive
+   * the meshes it is keyed on. */
+  RigidBodyShapeCache shape_cache;
+
   /* update objects */
   FOREACH_COLLECTION_OBJECT_RECURSIVE_BEGIN (rbw->group, ob) {
     if (ob->type == OB_MESH) {
@@ -1776,7 +1884,7 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
          * - assume object to be active? That is the default for newly added settings...
          */
         ob->rigidbody_object = BKE_rigidbody_create_object(scene, ob, RBO_TYPE_ACTIVE);
-        rigidbody_validate_sim_object(rbw, ob, true);
+        rigidbody_validate_sim_object(rbw, ob, true, &shape_cache);
 
         rbo = ob->rigidbody_object;
       }
@@ -1789,15 +1897,15 @@ static void rigidbody_update_simulation(Depsgraph *depsgraph,
            * but neither resets the RBO_FLAG_NEEDS_RESHAPE flag nor
            * calls RB_body_set_collision_shape().
            * This results in the collision shape being created twice, which is unnecessary. */
-          rigidbody_validate_sim_object(rbw, ob, true);
+          rigidbody_validate_sim_object(rbw, ob, true, &shape_cache);
         }
         else if (rbo->flag & RBO_FLAG_NEEDS_VALIDATE) {
-          rigidbody_validate_sim_object(rbw, ob, false);
+          rigidbody_validate_sim_object(rbw, ob, false, &shape_cache);
         }
         /* refresh shape... */
         if (rbo->flag & RBO_FLAG_NEEDS_RESHAPE) {
           /* mesh/shape data changed, so force shape refresh */
-          rigidbody_validate_sim_shape(rbw, ob, true);
+          rigidbody_validate_sim_shape(rbw, ob, true, &shape_cache);
           /* now tell RB sim about it */
           /* XXX: we assume that this can only get applied for active/passive shapes
            * that will be included as rigid-bodies. */
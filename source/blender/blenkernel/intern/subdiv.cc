@@ -11,6 +11,13 @@
 #include "DNA_mesh_types.h"
 #include "DNA_modifier_types.h"
 
+#include "BLI_hash_mm2a.hh"
+#include "BLI_map.hh"
+#include "BLI_mutex.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_attribute.hh"
+#include "BKE_mesh.hh"
 #include "BKE_subdiv_modifier.hh"
 
 #include "MEM_guardedalloc.h"
@@ -90,44 +97,237 @@ bool settings_equal(const Settings *settings_a, const Settings *settings_b)
 }
 
 /* --------------------------------------------------------------------
- * Construction.
+ * Topology refiner cache.
+ *
+ * Topology refiners created for meshes are shared between all subdivision descriptors with the
+ * same base topology and settings, for example duplicates of the same character, or the same
+ * mesh after its descriptor had to be created again. Besides the refinement itself this shares
+ * the stencil and patch tables, so creating an evaluator only needs to convert them and to
+ * evaluate the coarse positions.
  */
 
-/* Creation from scratch. */
+#ifdef WITH_OPENSUBDIV
 
-Subdiv *new_from_converter(const Settings *settings, OpenSubdiv_Converter *converter)
+namespace {
+
+struct SharedTopologyRefiner {
+  uint32_t hash;
+  Settings settings;
+  int users;
+};
+
+struct TopologyRefinerCache {
+  Mutex mutex;
+  Map<const opensubdiv::TopologyRefinerImpl *, SharedTopologyRefiner> refiners;
+  /** Refiners with an equal topology hash, the hash is not unique. */
+  Map<uint32_t, Vector<opensubdiv::TopologyRefinerImpl *>> refiners_by_hash;
+};
+
+}  // namespace
+
+static TopologyRefinerCache &topology_refiner_cache()
 {
-#ifdef WITH_OPENSUBDIV
-  SubdivStats stats;
-  stats_init(&stats);
-  stats_begin(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
-  OpenSubdiv_TopologyRefinerSettings topology_refiner_settings;
-  topology_refiner_settings.level = settings->level;
-  topology_refiner_settings.is_adaptive = settings->is_adaptive;
-  blender::opensubdiv::TopologyRefinerImpl *osd_topology_refiner = nullptr;
-  if (converter->getNumVertices(converter) != 0) {
-    osd_topology_refiner = blender::opensubdiv::TopologyRefinerImpl::createFromConverter(
-        converter, topology_refiner_settings);
+  static TopologyRefinerCache cache;
+  return cache;
+}
+
+/**
+ * Hash the data the mesh converter feeds into the topology refiner. UV maps are not included,
+ * they are only compared when looking up a refiner.
+ */
+static uint32_t topology_hash_from_mesh(const Settings &settings, const Mesh &mesh)
+{
+  BLI_HashMurmur2A mm2;
+  BLI_hash_mm2a_init(&mm2, 0);
+  const auto add_span = [&](const auto span) {
+    BLI_hash_mm2a_add(
+        &mm2, reinterpret_cast<const unsigned char *>(span.data()), span.size_in_bytes());
+  };
+  BLI_hash_mm2a_add_int(&mm2, mesh.verts_num);
+  add_span(mesh.edges());
+  add_span(mesh.face_offsets());
+  add_span(mesh.corner_verts());
+  if (settings.use_creases) {
+    const bke::AttributeAccessor attributes = mesh.attributes();
+    const VArraySpan<float> vert_creases = *attributes.lookup<float>("crease_vert",
+                                                                     bke::AttrDomain::Point);
+    const VArraySpan<float> edge_creases = *attributes.lookup<float>("crease_edge",
+                                                                     bke::AttrDomain::Edge);
+    add_span(Span<float>(vert_creases));
+    add_span(Span<float>(edge_creases));
   }
-  else {
+  return BLI_hash_mm2a_end(&mm2);
+}
+
+static opensubdiv::TopologyRefinerImpl *topology_refiner_create(const Settings *settings,
+                                                                OpenSubdiv_Converter *converter)
+{
+  if (converter->getNumVertices(converter) == 0) {
     /* TODO(sergey): Check whether original geometry had any vertices.
      * The thing here is: OpenSubdiv can only deal with faces, but our
      * side of subdiv also deals with loose vertices and edges. */
+    return nullptr;
+  }
+  OpenSubdiv_TopologyRefinerSettings topology_refiner_settings;
+  topology_refiner_settings.level = settings->level;
+  topology_refiner_settings.is_adaptive = settings->is_adaptive;
+  return opensubdiv::TopologyRefinerImpl::createFromConverter(converter,
+                                                              topology_refiner_settings);
+}
+
+/**
+ * Find a refiner for the topology in the cache and add a user to it. The cache has to be locked.
+ */
+static opensubdiv::TopologyRefinerImpl *topology_refiner_cache_lookup(
+    TopologyRefinerCache &cache,
+    const Settings &settings,
+    const OpenSubdiv_Converter *converter,
+    const uint32_t hash)
+{
+  const Vector<opensubdiv::TopologyRefinerImpl *> *candidates = cache.refiners_by_hash.lookup_ptr(
+      hash);
+  if (candidates == nullptr) {
+    return nullptr;
+  }
+  for (opensubdiv::TopologyRefinerImpl *topology_refiner : *candidates) {
+    SharedTopologyRefiner &shared = cache.refiners.lookup(topology_refiner);
+    if (settings_equal(&shared.settings, &settings) &&
+        topology_refiner->isEqualToConverter(converter))
+    {
+      shared.users++;
+      return topology_refiner;
+    }
+  }
+  return nullptr;
+}
+
+/**
+ * Get a refiner for the topology from the cache, or create it. The result has to be released
+ * with #topology_refiner_release.
+ */
+static opensubdiv::TopologyRefinerImpl *topology_refiner_cache_acquire(
+    const Settings &settings, OpenSubdiv_Converter *converter, const uint32_t hash)
+{
+  TopologyRefinerCache &cache = topology_refiner_cache();
+  {
+    std::scoped_lock lock(cache.mutex);
+    if (opensubdiv::TopologyRefinerImpl *topology_refiner = topology_refiner_cache_lookup(
+            cache, settings, converter, hash))
+    {
+      return topology_refiner;
+    }
+  }
+
+  /* Create the refiner without holding the lock, so different topologies are not created one
+   * after the other. */
+  opensubdiv::TopologyRefinerImpl *new_topology_refiner = topology_refiner_create(&settings,
+                                                                                 converter);
+  if (new_topology_refiner == nullptr) {
+    return nullptr;
+  }
+  /* Refine before the refiner is shared, it is not modified anymore afterwards, so it can be
+   * used by multiple threads. */
+  new_topology_refiner->evaluator_tables();
+
+  std::scoped_lock lock(cache.mutex);
+  /* Another thread may have created a refiner for the same topology in the meantime. */
+  if (opensubdiv::TopologyRefinerImpl *topology_refiner = topology_refiner_cache_lookup(
+          cache, settings, converter, hash))
+  {
+    delete new_topology_refiner;
+    return topology_refiner;
+  }
+  cache.refiners.add_new(new_topology_refiner, {hash, settings, 1});
+  cache.refiners_by_hash.lookup_or_add_default(hash).append(new_topology_refiner);
+  return new_topology_refiner;
+}
+
+/** Remove a user of a refiner from the cache, and free it when it is not used anymore. */
+static void topology_refiner_release(opensubdiv::TopologyRefinerImpl *topology_refiner)
+{
+  if (topology_refiner == nullptr) {
+    return;
+  }
+  {
+    TopologyRefinerCache &cache = topology_refiner_cache();
+    std::scoped_lock lock(cache.mutex);
+    SharedTopologyRefiner *shared = cache.refiners.lookup_ptr(topology_refiner);
+    if (shared != nullptr) {
+      shared->users--;
+      if (shared->users > 0) {
+        return;
+      }
+      Vector<opensubdiv::TopologyRefinerImpl *> &candidates = cache.refiners_by_hash.lookup(
+          shared->hash);
+      candidates.remove_first_occurrence_and_reorder(topology_refiner);
+      if (candidates.is_empty()) {
+        cache.refiners_by_hash.remove(shared->hash);
+      }
+      cache.refiners.remove(topology_refiner);
+    }
   }
+  /* Refiners that are not shared are owned by the descriptor. */
+  delete topology_refiner;
+}
+
+#endif
+
+/* --------------------------------------------------------------------
+ * Construction.
+ */
+
+#ifdef WITH_OPENSUBDIV
+static Subdiv *subdiv_new(const Settings *settings,
+                          opensubdiv::TopologyRefinerImpl *topology_refiner,
+                          const SubdivStats &stats)
+{
   Subdiv *subdiv = MEM_callocN<Subdiv>(__func__);
   subdiv->settings = *settings;
-  subdiv->topology_refiner = osd_topology_refiner;
+  subdiv->topology_refiner = topology_refiner;
   subdiv->evaluator = nullptr;
   subdiv->displacement_evaluator = nullptr;
-  stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
   subdiv->stats = stats;
   return subdiv;
+}
+#endif
+
+/* Creation from scratch. */
+
+Subdiv *new_from_converter(const Settings *settings, OpenSubdiv_Converter *converter)
+{
+#ifdef WITH_OPENSUBDIV
+  SubdivStats stats;
+  stats_init(&stats);
+  stats_begin(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
+  opensubdiv::TopologyRefinerImpl *osd_topology_refiner = topology_refiner_create(settings,
+                                                                                 converter);
+  stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
+  return subdiv_new(settings, osd_topology_refiner, stats);
 #else
   UNUSED_VARS(settings, converter);
   return nullptr;
 #endif
 }
 
+/** Like #new_from_converter, but shares the topology refiner with other meshes. */
+static Subdiv *new_from_mesh_converter(const Settings *settings,
+                                       const Mesh *mesh,
+                                       OpenSubdiv_Converter *converter)
+{
+#ifdef WITH_OPENSUBDIV
+  SubdivStats stats;
+  stats_init(&stats);
+  stats_begin(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
+  opensubdiv::TopologyRefinerImpl *osd_topology_refiner = topology_refiner_cache_acquire(
+      *settings, converter, topology_hash_from_mesh(*settings, *mesh));
+  stats_end(&stats, SUBDIV_STATS_TOPOLOGY_REFINER_CREATION_TIME);
+  return subdiv_new(settings, osd_topology_refiner, stats);
+#else
+  UNUSED_VARS(settings, mesh, converter);
+  return nullptr;
+#endif
+}
+
 Subdiv *new_from_mesh(const Settings *settings, const Mesh *mesh)
 {
   if (mesh->verts_num == 0) {
@@ -135,34 +335,41 @@ Subdiv *new_from_mesh(const Settings *settings, const Mesh *mesh)
   }
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
-  Subdiv *subdiv = new_from_converter(settings, &converter);
+  Subdiv *subdiv = new_from_mesh_converter(settings, mesh, &converter);
   converter_free(&converter);
   return subdiv;
 }
 
 /* Creation with cached-aware semantic. */
 
+/** Check if the existing descriptor can be re-used. */
+static bool can_reuse_subdiv(Subdiv *subdiv,
+                             const Settings *settings,
+                             const OpenSubdiv_Converter *converter)
+{
+#ifdef WITH_OPENSUBDIV
+  if (subdiv == nullptr || subdiv->topology_refiner == nullptr) {
+    return false;
+  }
+  if (!settings_equal(&subdiv->settings, settings)) {
+    return false;
+  }
+  stats_begin(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+  const bool is_equal = subdiv->topology_refiner->isEqualToConverter(converter);
+  stats_end(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
+  return is_equal;
+#else
+  UNUSED_VARS(subdiv, settings, converter);
+  return false;
+#endif
+}
+
 Subdiv *update_from_converter(Subdiv *subdiv,
                               const Settings *settings,
                               OpenSubdiv_Converter *converter)
 {
 #ifdef WITH_OPENSUBDIV
-  /* Check if the existing descriptor can be re-used. */
-  bool can_reuse_subdiv = true;
-  if (subdiv != nullptr && subdiv->topology_refiner != nullptr) {
-    if (!settings_equal(&subdiv->settings, settings)) {
-      can_reuse_subdiv = false;
-    }
-    else {
-      stats_begin(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
-      can_reuse_subdiv = subdiv->topology_refiner->isEqualToConverter(converter);
-      stats_end(&subdiv->stats, SUBDIV_STATS_TOPOLOGY_COMPARE);
-    }
-  }
-  else {
-    can_reuse_subdiv = false;
-  }
-  if (can_reuse_subdiv) {
+  if (can_reuse_subdiv(subdiv, settings, converter)) {
     return subdiv;
   }
   /* Create new subdiv. */
@@ -180,7 +387,12 @@ Subdiv *update_from_mesh(Subdiv *subdiv, const Settings *settings, const Mesh *m
 {
   OpenSubdiv_Converter converter;
   converter_init_for_mesh(&converter, settings, mesh);
-  subdiv = update_from_converter(subdiv, settings, &converter);
+  if (!can_reuse_subdiv(subdiv, settings, &converter)) {
+    if (subdiv != nullptr) {
+      free(subdiv);
+    }
+    subdiv = new_from_mesh_converter(settings, mesh, &converter);
+  }
   converter_free(&converter);
   return subdiv;
 }
@@ -199,7 +411,7 @@ void free(Subdiv *subdiv)
     }
     delete subdiv->evaluator;
   }
-  delete subdiv->topology_refiner;
+  topology_refiner_release(subdiv->topology_refiner);
   displacement_detach(subdiv);
   if (subdiv->cache_.face_ptex_offset != nullptr) {
     MEM_freeN(subdiv->cache_.face_ptex_offset);
@@ -394,4 +394,37 @@ void eval_final_point(
   }
 }
 
+void eval_limit_points(Subdiv *subdiv,
+                       const Span<OpenSubdiv_PatchCoord> patch_coords,
+                       MutableSpan<float3> r_P)
+{
+  BLI_assert(patch_coords.size() == r_P.size());
+#ifdef WITH_OPENSUBDIV
+  subdiv->evaluator->eval_output->evaluatePatchesLimit(patch_coords.data(),
+                                                        patch_coords.size(),
+                                                        reinterpret_cast<float *>(r_P.data()),
+                                                        nullptr,
+                                                        nullptr);
+#else
+  UNUSED_VARS(subdiv, patch_coords, r_P);
+#endif
+}
+
+void eval_face_varying_points(Subdiv *subdiv,
+                              const int face_varying_channel,
+                              const Span<OpenSubdiv_PatchCoord> patch_coords,
+                              MutableSpan<float2> r_face_varying)
+{
+  BLI_assert(patch_coords.size() == r_face_varying.size());
+#ifdef WITH_OPENSUBDIV
+  subdiv->evaluator->eval_output->evaluatePatchesFaceVarying(
+      face_varying_channel,
+      patch_coords.data(),
+      patch_coords.size(),
+      reinterpret_cast<float *>(r_face_varying.data()));
+#else
+  UNUSED_VARS(subdiv, face_varying_channel, patch_coords, r_face_varying);
+#endif
+}
+
 }  // namespace blender::bke::subdiv
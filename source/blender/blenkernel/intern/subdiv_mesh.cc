@@ -10,6 +10,8 @@
 #include "DNA_mesh_types.h"
 
 #include "BLI_array.hh"
+#include "BLI_array_utils.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
@@ -26,6 +28,8 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "opensubdiv_capi_type.hh"
+
 namespace blender::bke::subdiv {
 
 /* -------------------------------------------------------------------- */
@@ -84,6 +88,15 @@ struct SubdivMeshContext {
   Array<int> vert_to_edge_offsets;
   Array<int> vert_to_edge_indices;
   GroupedSpan<int> vert_to_edge_map;
+
+  /**
+   * When evaluating in a single batch, the coordinates of the limit surface points for the
+   * vertices and face corners are gathered during the traversal instead of being evaluated
+   * directly. Vertices not on the limit surface have a negative PTEX face index.
+   */
+  bool use_batched_evaluation;
+  OpenSubdiv_PatchCoord *vert_patch_coords;
+  OpenSubdiv_PatchCoord *corner_patch_coords;
 };
 
 static void subdiv_mesh_ctx_cache_uv_layers(SubdivMeshContext *ctx)
@@ -134,6 +147,8 @@ static void subdiv_mesh_context_free(SubdivMeshContext *ctx)
   MEM_SAFE_FREE(ctx->accumulated_counters);
   MEM_SAFE_FREE(ctx->subdiv_corner_verts);
   MEM_SAFE_FREE(ctx->subdiv_corner_edges);
+  MEM_SAFE_FREE(ctx->vert_patch_coords);
+  MEM_SAFE_FREE(ctx->corner_patch_coords);
   CustomData_free(&ctx->coarse_corner_data_interp);
 }
 
@@ -491,6 +506,20 @@ static void subdiv_vertex_orco_evaluate(const SubdivMeshContext *ctx,
   }
 }
 
+/* Evaluate the position on the limit surface, or store its coordinates for batched evaluation. */
+static void subdiv_vertex_limit_point_evaluate(const SubdivMeshContext *ctx,
+                                               const int ptex_face_index,
+                                               const float u,
+                                               const float v,
+                                               const int subdiv_vertex_index)
+{
+  if (ctx->use_batched_evaluation) {
+    ctx->vert_patch_coords[subdiv_vertex_index] = {ptex_face_index, u, v};
+    return;
+  }
+  eval_limit_point(ctx->subdiv, ptex_face_index, u, v, ctx->subdiv_positions[subdiv_vertex_index]);
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -582,6 +611,15 @@ static bool subdiv_mesh_topology_info(const ForeachContext *foreach_context,
   if (subdiv_context->settings->use_optimal_display) {
     subdiv_context->subdiv_display_edges = Array<bool>(num_edges, false);
   }
+  if (subdiv_context->use_batched_evaluation) {
+    subdiv_context->vert_patch_coords = MEM_malloc_arrayN<OpenSubdiv_PatchCoord>(
+        size_t(num_vertices), __func__);
+    MutableSpan(subdiv_context->vert_patch_coords, num_vertices).fill({-1, 0.0f, 0.0f});
+    if (subdiv_context->num_uv_layers > 0) {
+      subdiv_context->corner_patch_coords = MEM_malloc_arrayN<OpenSubdiv_PatchCoord>(
+          size_t(num_loops), __func__);
+    }
+  }
   return true;
 }
 
@@ -640,7 +678,7 @@ static void evaluate_vertex_and_apply_displacement_copy(const SubdivMeshContext
   }
   /* Copy custom data and evaluate position. */
   subdiv_vertex_data_copy(ctx, coarse_vertex_index, subdiv_vertex_index);
-  eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_position);
+  subdiv_vertex_limit_point_evaluate(ctx, ptex_face_index, u, v, subdiv_vertex_index);
   /* Apply displacement. */
   subdiv_position += D;
   /* Evaluate undeformed texture coordinate. */
@@ -668,7 +706,7 @@ static void evaluate_vertex_and_apply_displacement_interpolate(
   }
   /* Interpolate custom data and evaluate position. */
   subdiv_vertex_data_interpolate(ctx, subdiv_vertex_index, vertex_interpolation, u, v);
-  eval_limit_point(ctx->subdiv, ptex_face_index, u, v, subdiv_position);
+  subdiv_vertex_limit_point_evaluate(ctx, ptex_face_index, u, v, subdiv_vertex_index);
   /* Apply displacement. */
   add_v3_v3(subdiv_position, D);
   /* Evaluate undeformed texture coordinate. */
@@ -818,13 +856,18 @@ static void subdiv_mesh_vertex_inner(const ForeachContext *foreach_context,
 {
   SubdivMeshContext *ctx = static_cast<SubdivMeshContext *>(foreach_context->user_data);
   SubdivMeshTLS *tls = static_cast<SubdivMeshTLS *>(tls_v);
-  Subdiv *subdiv = ctx->subdiv;
   const IndexRange coarse_face = ctx->coarse_faces[coarse_face_index];
   Mesh *subdiv_mesh = ctx->subdiv_mesh;
-  float3 &subdiv_position = ctx->subdiv_positions[subdiv_vertex_index];
   subdiv_mesh_ensure_vertex_interpolation(ctx, tls, coarse_face_index, coarse_corner);
   subdiv_vertex_data_interpolate(ctx, subdiv_vertex_index, &tls->vertex_interpolation, u, v);
-  eval_final_point(subdiv, ptex_face_index, u, v, subdiv_position);
+  if (ctx->use_batched_evaluation) {
+    /* Batched evaluation is not used with displacement. */
+    subdiv_vertex_limit_point_evaluate(ctx, ptex_face_index, u, v, subdiv_vertex_index);
+  }
+  else {
+    eval_final_point(
+        ctx->subdiv, ptex_face_index, u, v, ctx->subdiv_positions[subdiv_vertex_index]);
+  }
   subdiv_mesh_tag_center_vertex(coarse_face, subdiv_vertex_index, u, v, subdiv_mesh);
   subdiv_vertex_orco_evaluate(ctx, ptex_face_index, u, v, subdiv_vertex_index);
 }
@@ -901,6 +944,10 @@ static void subdiv_eval_uv_layer(SubdivMeshContext *ctx,
   if (ctx->num_uv_layers == 0) {
     return;
   }
+  if (ctx->use_batched_evaluation) {
+    ctx->corner_patch_coords[corner_index] = {ptex_face_index, u, v};
+    return;
+  }
   Subdiv *subdiv = ctx->subdiv;
   for (int layer_index = 0; layer_index < ctx->num_uv_layers; layer_index++) {
     eval_face_varying(
@@ -1116,6 +1163,56 @@ static void subdiv_mesh_vertex_of_loose_edge(const ForeachContext *foreach_conte
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Batched evaluation
+ * \{ */
+
+static bool subdiv_mesh_can_use_batched_evaluation(const Subdiv *subdiv, const Mesh *coarse_mesh)
+{
+  if (subdiv->displacement_evaluator != nullptr) {
+    return false;
+  }
+  /* Smoothly interpolated vertex data is only evaluated for single points. */
+  return !CustomData_has_layer(&coarse_mesh->vert_data, CD_ORCO) &&
+         !CustomData_has_layer(&coarse_mesh->vert_data, CD_CLOTH_ORCO);
+}
+
+/**
+ * Evaluate the limit surface positions and UV maps of all vertices and face corners gathered
+ * during the traversal at once.
+ */
+static void subdiv_mesh_evaluate_batched(SubdivMeshContext *ctx)
+{
+  const Span<OpenSubdiv_PatchCoord> vert_patch_coords(ctx->vert_patch_coords,
+                                                      ctx->subdiv_positions.size());
+  /* Loose vertices are not on the limit surface, their positions are already set. */
+  IndexMaskMemory memory;
+  const IndexMask limit_verts = IndexMask::from_predicate(
+      vert_patch_coords.index_range(), GrainSize(4096), memory, [&](const int vert) {
+        return vert_patch_coords[vert].ptex_face >= 0;
+      });
+  if (limit_verts.size() == vert_patch_coords.size()) {
+    eval_limit_points(ctx->subdiv, vert_patch_coords, ctx->subdiv_positions);
+  }
+  else {
+    Array<OpenSubdiv_PatchCoord> patch_coords(limit_verts.size());
+    array_utils::gather(vert_patch_coords, limit_verts, patch_coords.as_mutable_span());
+    Array<float3> positions(limit_verts.size());
+    eval_limit_points(ctx->subdiv, patch_coords, positions);
+    array_utils::scatter(positions.as_span(), limit_verts, ctx->subdiv_positions);
+  }
+
+  const int corners_num = ctx->subdiv_mesh->corners_num;
+  for (const int layer_index : IndexRange(ctx->num_uv_layers)) {
+    eval_face_varying_points(ctx->subdiv,
+                             layer_index,
+                             Span(ctx->corner_patch_coords, corners_num),
+                             MutableSpan(ctx->uv_layers[layer_index], corners_num));
+  }
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Initialization
  * \{ */
@@ -1151,10 +1248,21 @@ static void setup_foreach_callbacks(const SubdivMeshContext *subdiv_context,
 Mesh *subdiv_to_mesh(Subdiv *subdiv, const ToMeshSettings *settings, const Mesh *coarse_mesh)
 {
 
+  const bool use_gpu_evaluation = settings->use_gpu_evaluation;
+  if (use_gpu_evaluation && !subdiv_mesh_can_use_batched_evaluation(subdiv, coarse_mesh)) {
+    return nullptr;
+  }
+
   stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH);
   /* Make sure evaluator is up to date with possible new topology, and that
    * it is refined for the new positions of coarse vertices. */
-  if (!eval_begin_from_mesh(subdiv, coarse_mesh, {}, SUBDIV_EVALUATOR_TYPE_CPU, nullptr)) {
+  if (!eval_begin_from_mesh(subdiv,
+                            coarse_mesh,
+                            {},
+                            use_gpu_evaluation ? SUBDIV_EVALUATOR_TYPE_GPU :
+                                                 SUBDIV_EVALUATOR_TYPE_CPU,
+                            settings->evaluator_cache))
+  {
     /* This could happen in two situations:
      * - OpenSubdiv is disabled.
      * - Something totally bad happened, and OpenSubdiv rejected our
@@ -1184,6 +1292,8 @@ Mesh *subdiv_to_mesh(Subdiv *subdiv, const ToMeshSettings *settings, const Mesh
 
   subdiv_context.subdiv = subdiv;
   subdiv_context.have_displacement = (subdiv->displacement_evaluator != nullptr);
+  /* Without faces there is no evaluator, and nothing to evaluate. */
+  subdiv_context.use_batched_evaluation = use_gpu_evaluation && coarse_mesh->faces_num > 0;
   /* Multi-threaded traversal/evaluation. */
   stats_begin(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   ForeachContext foreach_context;
@@ -1193,6 +1303,9 @@ Mesh *subdiv_to_mesh(Subdiv *subdiv, const ToMeshSettings *settings, const Mesh
   foreach_context.user_data_tls_size = sizeof(SubdivMeshTLS);
   foreach_context.user_data_tls = &tls;
   foreach_subdiv_geometry(subdiv, &foreach_context, settings, coarse_mesh);
+  if (subdiv_context.use_batched_evaluation) {
+    subdiv_mesh_evaluate_batched(&subdiv_context);
+  }
   stats_end(&subdiv->stats, SUBDIV_STATS_SUBDIV_TO_MESH_GEOMETRY);
   Mesh *result = subdiv_context.subdiv_mesh;
 
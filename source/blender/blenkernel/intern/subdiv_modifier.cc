@@ -15,6 +15,7 @@
 #include "BKE_mesh.hh"
 #include "BKE_modifier.hh"
 #include "BKE_subdiv.hh"
+#include "BKE_subdiv_mesh.hh"
 
 #include "GPU_capabilities.hh"
 #include "GPU_context.hh"
@@ -127,6 +128,32 @@ bool BKE_subsurf_modifier_has_gpu_subdiv(const Mesh *mesh)
 }
 
 void (*BKE_subsurf_modifier_free_gpu_cache_cb)(subdiv::Subdiv *subdiv) = nullptr;
+Mesh *(*BKE_subsurf_modifier_subdiv_to_mesh_gpu_cb)(subdiv::Subdiv *subdiv,
+                                                   const subdiv::ToMeshSettings *settings,
+                                                   const Mesh *coarse_mesh) = nullptr;
+
+Mesh *BKE_subsurf_modifier_subdiv_to_mesh_gpu(SubsurfRuntimeData *runtime_data,
+                                              const Mesh *mesh,
+                                              const subdiv::ToMeshSettings &settings)
+{
+  if (BKE_subsurf_modifier_subdiv_to_mesh_gpu_cb == nullptr) {
+    return nullptr;
+  }
+  if ((U.gpu_flag & USER_GPU_FLAG_SUBDIVISION_EVALUATION) == 0) {
+    return nullptr;
+  }
+  if (GPU_context_active_get() == nullptr || !is_subdivision_evaluation_possible_on_gpu()) {
+    return nullptr;
+  }
+  runtime_data->subdiv_gpu_mesh = subdiv::update_from_mesh(
+      runtime_data->subdiv_gpu_mesh, &runtime_data->settings, mesh);
+  if (runtime_data->subdiv_gpu_mesh == nullptr) {
+    return nullptr;
+  }
+  runtime_data->used_gpu = 2;
+  return BKE_subsurf_modifier_subdiv_to_mesh_gpu_cb(
+      runtime_data->subdiv_gpu_mesh, &settings, mesh);
+}
 
 subdiv::Subdiv *BKE_subsurf_modifier_subdiv_descriptor_ensure(SubsurfRuntimeData *runtime_data,
                                                               const Mesh *mesh,
@@ -19,6 +19,7 @@
 #include "BLI_math_matrix.h"
 #include "BLI_math_rotation.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BLT_translation.hh"
@@ -597,6 +598,7 @@ void BKE_texture_pointdensity_init_data(PointDensity *pd)
   pd->source = TEX_PD_PSYS;
   pd->point_tree = nullptr;
   pd->point_data = nullptr;
+  pd->point_tree_hash = 0;
   pd->noise_size = 0.5f;
   pd->noise_depth = 1;
   pd->noise_fac = 1.0f;
@@ -632,6 +634,7 @@ PointDensity *BKE_texture_pointdensity_copy(const PointDensity *pd, const int /*
   pdn = static_cast<PointDensity *>(MEM_dupallocN(pd));
   pdn->point_tree = nullptr;
   pdn->point_data = nullptr;
+  pdn->point_tree_hash = 0;
   if (pdn->coba) {
     pdn->coba = static_cast<ColorBand *>(MEM_dupallocN(pdn->coba));
   }
@@ -717,6 +720,25 @@ void BKE_texture_get_value(Tex *texture,
   BKE_texture_get_value_ex(texture, tex_co, texres, nullptr, use_color_management);
 }
 
+void BKE_texture_get_values(Tex *texture,
+                            const float (*tex_co)[3],
+                            const int tex_co_num,
+                            TexResult *r_texres,
+                            bool use_color_management)
+{
+  using namespace blender;
+  ImagePool *pool = BKE_image_pool_new();
+  BKE_texture_fetch_images_for_pool(texture, pool);
+
+  threading::parallel_for(IndexRange(tex_co_num), 512, [&](const IndexRange range) {
+    for (const int i : range) {
+      BKE_texture_get_value_ex(texture, tex_co[i], &r_texres[i], pool, use_color_management);
+    }
+  });
+
+  BKE_image_pool_free(pool);
+}
+
 static void texture_nodes_fetch_images_for_pool(Tex *texture, bNodeTree *ntree, ImagePool *pool)
 {
   for (bNode *node : ntree->all_nodes()) {
@@ -8,6 +8,7 @@
  * Used by ED_undo.hh, internal implementation.
  */
 
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 
@@ -23,6 +24,7 @@
 #include "DNA_listBase.h"
 #include "DNA_windowmanager_types.h"
 
+#include "BKE_appdir.hh"
 #include "BKE_context.hh"
 #include "BKE_global.hh"
 #include "BKE_lib_id.hh"
@@ -193,6 +195,8 @@ static void undosys_step_decode(bContext *C,
 {
   CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
 
+  BKE_undosys_step_restore(us);
+
   if (us->type->step_foreach_ID_ref) {
 #ifdef WITH_GLOBAL_UNDO_CORRECT_ORDER
     if (us->type != BKE_UNDOSYS_TYPE_MEMFILE) {
@@ -465,12 +469,117 @@ void BKE_undosys_stack_limit_steps_and_memory(UndoStack *ustack, int steps, size
   }
 }
 
+static size_t undosys_step_resident_size(const UndoStep *us)
+{
+  const size_t size = us->data_size - std::min(us->data_size, us->compressed_data_size);
+  return us->is_spilled ? size : size + us->compressed_size;
+}
+
+/**
+ * Steps that are needed for the next undo push or undo, which should not be compressed.
+ */
+static bool undosys_step_is_hot(const UndoStack *ustack, const UndoStep *us)
+{
+  if (ELEM(us, ustack->step_active, ustack->step_active_memfile, ustack->step_init)) {
+    return true;
+  }
+  /* The last memfile step before the active one is used as reference by the next memfile step. */
+  if (us->type == BKE_UNDOSYS_TYPE_MEMFILE) {
+    for (const UndoStep *us_iter = ustack->step_active; us_iter; us_iter = us_iter->prev) {
+      if (us_iter->type == BKE_UNDOSYS_TYPE_MEMFILE) {
+        return us_iter == us;
+      }
+    }
+  }
+  return false;
+}
+
+void BKE_undosys_stack_limit_resident_memory(UndoStack *ustack, const size_t memory_limit)
+{
+  UNDO_NESTED_ASSERT(false);
+  size_t resident_size = 0;
+  LISTBASE_FOREACH (const UndoStep *, us, &ustack->steps) {
+    resident_size += undosys_step_resident_size(us);
+  }
+  if (resident_size <= memory_limit) {
+    return;
+  }
+
+  CLOG_INFO(&LOG, 1, "resident_size=%zu, memory_limit=%zu", resident_size, memory_limit);
+
+  /* First compress steps in memory, oldest first. */
+  LISTBASE_FOREACH (UndoStep *, us, &ustack->steps) {
+    if (resident_size <= memory_limit) {
+      return;
+    }
+    if (us->type->step_compress == nullptr || us->compressed_data_size != 0 ||
+        undosys_step_is_hot(ustack, us))
+    {
+      continue;
+    }
+    resident_size -= undosys_step_resident_size(us);
+    UNDO_NESTED_CHECK_BEGIN;
+    us->type->step_compress(us, nullptr);
+    UNDO_NESTED_CHECK_END;
+    resident_size += undosys_step_resident_size(us);
+  }
+
+  /* Then move the compressed data to temporary files. */
+  static int spill_counter = 0;
+  LISTBASE_FOREACH (UndoStep *, us, &ustack->steps) {
+    if (resident_size <= memory_limit) {
+      return;
+    }
+    if (us->compressed_data_size == 0 || us->is_spilled) {
+      continue;
+    }
+    char filename[64];
+    char filepath[FILE_MAX];
+    SNPRINTF(filename, "undo_%d.zst", spill_counter++);
+    BLI_path_join(filepath, sizeof(filepath), BKE_tempdir_session(), filename);
+
+    resident_size -= undosys_step_resident_size(us);
+    UNDO_NESTED_CHECK_BEGIN;
+    us->type->step_compress(us, filepath);
+    UNDO_NESTED_CHECK_END;
+    resident_size += undosys_step_resident_size(us);
+  }
+}
+
+void BKE_undosys_stack_memory_stats(const UndoStack *ustack, UndoStackMemoryStats *r_stats)
+{
+  *r_stats = {};
+  LISTBASE_FOREACH (const UndoStep *, us, &ustack->steps) {
+    r_stats->resident_size += undosys_step_resident_size(us);
+    if (us->is_spilled) {
+      r_stats->spilled_size += us->compressed_size;
+    }
+    else {
+      r_stats->compressed_size += us->compressed_size;
+    }
+  }
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
 /** \name Undo Step
  * \{ */
 
+void BKE_undosys_step_restore(UndoStep *us)
+{
+  if (us->compressed_data_size == 0) {
+    return;
+  }
+  CLOG_INFO(&LOG, 2, "addr=%p, name='%s', type='%s'", us, us->name, us->type->name);
+  UNDO_NESTED_CHECK_BEGIN;
+  us->type->step_restore(us);
+  UNDO_NESTED_CHECK_END;
+  us->compressed_data_size = 0;
+  us->compressed_size = 0;
+  us->is_spilled = false;
+}
+
 UndoStep *BKE_undosys_step_push_init_with_type(UndoStack *ustack,
                                                bContext *C,
                                                const char *name,
@@ -990,15 +1099,16 @@ static void UNUSED_FUNCTION(BKE_undosys_foreach_ID_ref(UndoStack *ustack,
 
 void BKE_undosys_print(UndoStack *ustack)
 {
-  printf("Undo %d Steps (*: active, #=applied, M=memfile-active, S=skip)\n",
+  printf("Undo %d Steps (*: active, #=applied, M=memfile-active, S=skip, C=compressed, D=disk)\n",
          BLI_listbase_count(&ustack->steps));
   int index = 0;
   LISTBASE_FOREACH (UndoStep *, us, &ustack->steps) {
-    printf("[%c%c%c%c] %3d {%p} type='%s', name='%s'\n",
+    printf("[%c%c%c%c%c] %3d {%p} type='%s', name='%s'\n",
            (us == ustack->step_active) ? '*' : ' ',
            us->is_applied ? '#' : ' ',
            (us == ustack->step_active_memfile) ? 'M' : ' ',
            us->skip ? 'S' : ' ',
+           us->is_spilled ? 'D' : (us->compressed_data_size ? 'C' : ' '),
            index,
            (void *)us,
            us->type->name,
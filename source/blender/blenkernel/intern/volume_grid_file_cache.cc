@@ -7,9 +7,13 @@
 #  include "BKE_volume_grid_file_cache.hh"
 #  include "BKE_volume_openvdb.hh"
 
+#  include "BLI_array.hh"
+#  include "BLI_enumerable_thread_specific.hh"
 #  include "BLI_map.hh"
+#  include "BLI_math_vector_types.hh"
 #  include "BLI_memory_cache.hh"
 #  include "BLI_memory_counter.hh"
+#  include "BLI_task.hh"
 
 #  include <openvdb/openvdb.h>
 
@@ -173,27 +177,228 @@ class GridReadValue : public memory_cache::CachedValue {
     }
     memory.add(bytes_);
   }
+
+  StringRefNull category() const override
+  {
+    return "Volume Grids";
+  }
 };
 
 /**
  * Load a single grid by name from a file. This loads the full grid including meta-data, transforms
  * and the tree.
+ *
+ * With \a delay_load, the voxel data of leaf nodes is only read from the file when it is
+ * accessed. Delay loading is disabled by default because it has poor performance on network
+ * drives when the leaves are accessed in random order.
  */
 static openvdb::GridBase::Ptr load_single_grid_from_disk(const StringRef file_path,
-                                                         const StringRef grid_name)
+                                                         const StringRef grid_name,
+                                                         const bool delay_load = false)
 {
-  /* Disable delay loading and file copying, this has poor performance
-   * on network drivers. */
-  const bool delay_load = false;
-
   openvdb::io::File file(file_path);
 #  ifdef OPENVDB_USE_DELAYED_LOADING
+  /* Disable file copying, this has poor performance on network drives. */
   file.setCopyMaxBytes(0);
 #  endif
   file.open(delay_load);
   return file.readGrid(grid_name);
 }
 
+static int floor_div(const int a, const int b)
+{
+  return a >= 0 ? a / b : -((-a - 1) / b) - 1;
+}
+
+static int ceil_div(const int a, const int b)
+{
+  return -floor_div(-a, b);
+}
+
+/**
+ * Create a grid with the resolution reduced by `2^simplify_level` on each axis, by averaging the
+ * active voxels in each block of the input grid. The leaves are taken out of the input grid and
+ * freed one after the other, so when the input grid is delay loaded, the full resolution voxel
+ * data is never in memory at once.
+ */
+template<typename GridType>
+static typename GridType::Ptr create_simplified_grid_from_leaves(GridType &grid,
+                                                                 const int simplify_level)
+{
+  using TreeType = typename GridType::TreeType;
+  using LeafNodeType = typename TreeType::LeafNodeType;
+  using ValueType = typename GridType::ValueType;
+  /* Boolean and mask grids can't be averaged, blocks with an active voxel are active. */
+  constexpr bool is_boolean = std::is_same_v<ValueType, bool>;
+
+  struct Block {
+    ValueType sum = openvdb::zeroVal<ValueType>();
+    int count = 0;
+
+    void add(const ValueType &value)
+    {
+      if constexpr (is_boolean) {
+        this->sum = this->sum || value;
+      }
+      else {
+        this->sum = this->sum + value;
+      }
+      this->count += 1;
+    }
+
+    void add(const Block &other)
+    {
+      if constexpr (is_boolean) {
+        this->sum = this->sum || other.sum;
+      }
+      else {
+        this->sum = this->sum + other.sum;
+      }
+      this->count += other.count;
+    }
+
+    ValueType value() const
+    {
+      if constexpr (is_boolean) {
+        return this->sum;
+      }
+      else {
+        return ValueType(this->sum / this->count);
+      }
+    }
+  };
+
+  const int factor = 1 << simplify_level;
+  /* Blocks are aligned to leaves, so a leaf contains whole blocks when they are smaller than
+   * leaves, or part of a single block otherwise. */
+  const int block_size = std::min<int>(factor, LeafNodeType::DIM);
+  const int blocks_per_axis = LeafNodeType::DIM / block_size;
+  const bool blocks_span_leaves = factor > int(LeafNodeType::DIM);
+
+  typename GridType::Ptr new_grid = grid.copyWithNewTree();
+  /* Center the new voxels in the blocks they are computed from. */
+  new_grid->setTransform(grid.transform().copy());
+  new_grid->transform().preTranslate(openvdb::Vec3d((factor - 1) / 2.0));
+  new_grid->transform().preScale(double(factor));
+  TreeType &new_tree = new_grid->tree();
+
+  std::vector<LeafNodeType *> leaves;
+  grid.tree().stealNodes(leaves);
+
+  struct LocalData {
+    std::unique_ptr<TreeType> tree;
+    /** Blocks that span multiple leaves, their voxels are combined afterwards. */
+    Vector<std::pair<int3, Block>> partial_blocks;
+  };
+  threading::EnumerableThreadSpecific<LocalData> local_data;
+
+  threading::parallel_for(IndexRange(leaves.size()), 16, [&](const IndexRange range) {
+    LocalData &local = local_data.local();
+    if (!local.tree) {
+      local.tree = std::make_unique<TreeType>(new_tree.background());
+    }
+    openvdb::tree::ValueAccessor<TreeType> accessor(*local.tree);
+    Array<Block> blocks(blocks_per_axis * blocks_per_axis * blocks_per_axis);
+    for (const int64_t i : range) {
+      LeafNodeType *leaf = leaves[i];
+      blocks.fill({});
+      const openvdb::Coord origin = leaf->origin();
+      /* This reads the voxel data of the leaf from the file when it is delay loaded. */
+      for (auto iter = leaf->cbeginValueOn(); iter; ++iter) {
+        const openvdb::Coord local_coord = iter.getCoord() - origin;
+        const int x = local_coord.x() / block_size;
+        const int y = local_coord.y() / block_size;
+        const int z = local_coord.z() / block_size;
+        blocks[(x * blocks_per_axis + y) * blocks_per_axis + z].add(iter.getValue());
+      }
+      delete leaf;
+
+      const int3 first_block(floor_div(origin.x(), factor),
+                             floor_div(origin.y(), factor),
+                             floor_div(origin.z(), factor));
+      if (blocks_span_leaves) {
+        if (blocks[0].count > 0) {
+          local.partial_blocks.append({first_block, blocks[0]});
+        }
+        continue;
+      }
+      for (const int x : IndexRange(blocks_per_axis)) {
+        for (const int y : IndexRange(blocks_per_axis)) {
+          for (const int z : IndexRange(blocks_per_axis)) {
+            const Block &block = blocks[(x * blocks_per_axis + y) * blocks_per_axis + z];
+            if (block.count > 0) {
+              accessor.setValueOn(
+                  openvdb::Coord(first_block.x + x, first_block.y + y, first_block.z + z),
+                  block.value());
+            }
+          }
+        }
+      }
+    }
+  });
+
+  Map<int3, Block> partial_blocks;
+  for (LocalData &local : local_data) {
+    if (local.tree) {
+      new_tree.merge(*local.tree);
+    }
+    for (const std::pair<int3, Block> &item : local.partial_blocks) {
+      partial_blocks.lookup_or_add_default(item.first).add(item.second);
+    }
+  }
+  openvdb::tree::ValueAccessor<TreeType> accessor(new_tree);
+  for (const auto item : partial_blocks.items()) {
+    accessor.setValueOn(openvdb::Coord(item.key.x, item.key.y, item.key.z), item.value.value());
+  }
+
+  /* Only active tiles are left in the input tree. Fill the blocks that are entirely inside of
+   * them, tiles are rarely used in files so partially covered blocks are ignored. */
+  for (auto iter = grid.tree().cbeginValueOn(); iter; ++iter) {
+    openvdb::CoordBBox bbox;
+    iter.getBoundingBox(bbox);
+    const openvdb::Coord min(ceil_div(bbox.min().x(), factor),
+                             ceil_div(bbox.min().y(), factor),
+                             ceil_div(bbox.min().z(), factor));
+    const openvdb::Coord max(floor_div(bbox.max().x() + 1, factor) - 1,
+                             floor_div(bbox.max().y() + 1, factor) - 1,
+                             floor_div(bbox.max().z() + 1, factor) - 1);
+    const openvdb::CoordBBox new_bbox(min, max);
+    if (!new_bbox.empty()) {
+      new_tree.sparseFill(new_bbox, iter.getValue(), true);
+    }
+  }
+
+  return new_grid;
+}
+
+/**
+ * Build a simplified grid by streaming the leaves of the full resolution grid from the file,
+ * without loading and caching the full resolution grid. Returns null when the grid type is not
+ * supported.
+ */
+static openvdb::GridBase::Ptr load_simplified_grid_from_disk(const StringRef file_path,
+                                                             const StringRef grid_name,
+                                                             const int simplify_level)
+{
+  const openvdb::GridBase::Ptr grid = load_single_grid_from_disk(file_path, grid_name, true);
+  if (!grid) {
+    return nullptr;
+  }
+  const VolumeGridType grid_type = get_type(*grid);
+  if (ELEM(grid_type, VOLUME_GRID_POINTS, VOLUME_GRID_UNKNOWN)) {
+    return nullptr;
+  }
+  openvdb::GridBase::Ptr new_grid;
+  BKE_volume_grid_type_to_static_type(grid_type, [&](auto type_tag) {
+    using GridType = typename decltype(type_tag)::type;
+    if constexpr (!std::is_same_v<GridType, openvdb::points::PointDataGrid>) {
+      new_grid = create_simplified_grid_from_leaves(static_cast<GridType &>(*grid),
+                                                    simplify_level);
+    }
+  });
+  return new_grid;
+}
+
 /**
  * Load a single grid by name from a file. This loads the full grid including meta-data, transforms
  * and the tree.
@@ -213,13 +418,16 @@ static LazyLoadedGrid load_single_grid_from_disk_cached(const StringRef file_pat
       grid = load_single_grid_from_disk(key.file_path, key.grid_name);
     }
     else {
-      /* Build the simplified grid from the main grid. */
-      const GVolumeGrid main_grid = get_grid_from_file(key.file_path, key.grid_name, 0);
-      const VolumeGridType grid_type = main_grid->grid_type();
-      const float resolution_factor = 1.0f / (1 << key.simplify_level);
-      VolumeTreeAccessToken tree_token;
-      grid = BKE_volume_grid_create_with_changed_resolution(
-          grid_type, main_grid->grid(tree_token), resolution_factor);
+      grid = load_simplified_grid_from_disk(key.file_path, key.grid_name, key.simplify_level);
+      if (!grid) {
+        /* Build the simplified grid from the main grid. */
+        const GVolumeGrid main_grid = get_grid_from_file(key.file_path, key.grid_name, 0);
+        const VolumeGridType grid_type = main_grid->grid_type();
+        const float resolution_factor = 1.0f / (1 << key.simplify_level);
+        VolumeTreeAccessToken tree_token;
+        grid = BKE_volume_grid_create_with_changed_resolution(
+            grid_type, main_grid->grid(tree_token), resolution_factor);
+      }
     }
     auto value = std::make_unique<GridReadValue>();
     value->grid = std::move(grid);
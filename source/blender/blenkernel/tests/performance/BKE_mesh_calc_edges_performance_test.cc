@@ -0,0 +1,76 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include "testing/testing.h"
+
+#include "BKE_idtype.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
+
+#include "BLI_task.hh"
+#include "BLI_timeit.hh"
+
+#include "DNA_mesh_types.h"
+
+namespace blender::bke::tests {
+
+/* Number of quads in each mesh. */
+static constexpr int GRID_SIZE = 4000;
+
+/** A grid of quads, where most edges are shared by two faces. */
+static Mesh *create_dense_mesh()
+{
+  const int verts_x = GRID_SIZE + 1;
+  Mesh *mesh = BKE_mesh_new_nomain(
+      verts_x * verts_x, 0, GRID_SIZE * GRID_SIZE, GRID_SIZE * GRID_SIZE * 4);
+  offset_indices::fill_constant_group_size(4, 0, mesh->face_offsets_for_write());
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  threading::parallel_for(IndexRange(GRID_SIZE), 64, [&](const IndexRange range) {
+    for (const int y : range) {
+      for (const int x : IndexRange(GRID_SIZE)) {
+        const int face = y * GRID_SIZE + x;
+        const int vert = y * verts_x + x;
+        corner_verts.slice(face * 4, 4).copy_from(
+            {vert, vert + 1, vert + verts_x + 1, vert + verts_x});
+      }
+    }
+  });
+  return mesh;
+}
+
+/** Separate quads that don't share any edges. */
+static Mesh *create_sparse_mesh()
+{
+  const int faces_num = GRID_SIZE * GRID_SIZE;
+  Mesh *mesh = BKE_mesh_new_nomain(faces_num * 4, 0, faces_num, faces_num * 4);
+  offset_indices::fill_constant_group_size(4, 0, mesh->face_offsets_for_write());
+  MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+  threading::parallel_for(corner_verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      corner_verts[i] = i;
+    }
+  });
+  return mesh;
+}
+
+static void calc_edges_benchmark(const char *name, Mesh *(*create_mesh)())
+{
+  for ([[maybe_unused]] const int i : IndexRange(5)) {
+    Mesh *mesh = create_mesh();
+    {
+      SCOPED_TIMER(name);
+      mesh_calc_edges(*mesh, false, false);
+    }
+    BKE_id_free(nullptr, mesh);
+  }
+}
+
+TEST(mesh_calc_edges, performance)
+{
+  BKE_idtype_init();
+  calc_edges_benchmark("dense", create_dense_mesh);
+  calc_edges_benchmark("sparse", create_sparse_mesh);
+}
+
+}  // namespace blender::bke::tests
@@ -26,4 +26,14 @@ namespace blender::bits {
  */
 bool or_bools_into_bits(Span<bool> bools, MutableBitSpan r_bits, int64_t allowed_overshoot = 0);
 
+/**
+ * Same as #or_bools_into_bits, but the bits are set for bools that are false.
+ *
+ * \return True if any of the checked bools were false (this also includes the bools in the
+ * overshoot).
+ */
+bool or_bools_inverse_into_bits(Span<bool> bools,
+                                MutableBitSpan r_bits,
+                                int64_t allowed_overshoot = 0);
+
 }  // namespace blender::bits
@@ -0,0 +1,40 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Runtime selection of kernels that are compiled for multiple instruction sets. Blender is built
+ * for a baseline CPU, so hot loops that benefit from newer instructions are compiled a second time
+ * in separate files with additional compiler flags (similar to the CPU kernels of Cycles). Which
+ * variant is used is decided once, based on the CPU Blender runs on.
+ *
+ * Files that are compiled for a specific instruction set must not use inline functions or
+ * templates that are also used in other files. The linker keeps only one copy of those, which
+ * could then contain instructions that the CPU doesn't support. Kernels are therefore written
+ * against raw pointers and are in an instruction set specific namespace.
+ */
+
+#include <cstdint>
+
+namespace blender::cpu_dispatch {
+
+enum class ISA : int8_t {
+  Baseline,
+  /** AVX2 with FMA, as in Intel Haswell and AMD Excavator CPUs and newer. */
+  AVX2,
+};
+
+/**
+ * The best instruction set that is supported by the CPU and for which kernels are compiled. Set
+ * the `BLENDER_CPU_DISPATCH=baseline` environment variable to always use the baseline kernels,
+ * e.g. for debugging or comparing performance.
+ */
+ISA best_isa();
+
+const char *isa_name(ISA isa);
+
+}  // namespace blender::cpu_dispatch
@@ -98,6 +98,23 @@ std::optional<Vector<Any<>>> parse_csv_in_chunks(
     FunctionRef<void(const CsvRecord &record)> process_header,
     FunctionRef<Any<>(const CsvRecords &records)> process_records);
 
+/**
+ * Same as above, but the index of the chunk is passed to `process_records` as well. The buffer is
+ * always split into the same chunks for the same buffer and options, so the chunk index can be
+ * used to parse a file multiple times. E.g. the first pass can count the records in every chunk,
+ * and the second pass can write the parsed values directly to the correct position in arrays
+ * that are allocated in between.
+ *
+ * The chunks may be processed again with a single chunk if the file contains multi-line fields
+ * which were split incorrectly at first. In that case, the chunk index is zero and all results of
+ * the previous calls are discarded.
+ */
+std::optional<Vector<Any<>>> parse_csv_in_indexed_chunks(
+    const Span<char> buffer,
+    const CsvParseOptions &options,
+    FunctionRef<void(const CsvRecord &record)> process_header,
+    FunctionRef<Any<>(int64_t chunk_index, const CsvRecords &records)> process_records);
+
 /**
  * Same as above, but uses a templated chunk type instead of using #Any which can be more
  * convenient to use.
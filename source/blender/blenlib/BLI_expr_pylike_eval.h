@@ -38,6 +38,24 @@ bool BLI_expr_pylike_is_constant(const struct ExprPyLike_Parsed *expr);
  * Check if the parsed expression uses the parameter with the given index.
  */
 bool BLI_expr_pylike_is_using_param(const struct ExprPyLike_Parsed *expr, int index);
+/**
+ * Check if the parsed expression accesses attributes of the parameter with the given index.
+ */
+bool BLI_expr_pylike_is_using_attribute_of_param(const struct ExprPyLike_Parsed *expr,
+                                                 int index);
+/**
+ * Number of distinct attribute accesses on parameters in the expression, like `x.location[0]`.
+ * Their values are not computed by the evaluator, they have to be passed to
+ * #BLI_expr_pylike_eval after the values of the parameters, in this order.
+ */
+int BLI_expr_pylike_attributes_len(const struct ExprPyLike_Parsed *expr);
+/**
+ * Get the path of an attribute access relative to its parameter, using the RNA path syntax
+ * (e.g. `location[0]`), and the index of the parameter it is accessed on.
+ */
+const char *BLI_expr_pylike_attribute_get(const struct ExprPyLike_Parsed *expr,
+                                          int index,
+                                          int *r_param_index);
 /**
  * Compile the expression and return the result.
  *
@@ -49,7 +67,8 @@ ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
                                          int param_names_len);
 /**
  * Evaluate the expression with the given parameters.
- * The order and number of parameters must match the names given to parse.
+ * The order and number of parameters must match the names given to parse,
+ * followed by the values of the attribute accesses if any.
  */
 eExprPyLike_EvalStatus BLI_expr_pylike_eval(struct ExprPyLike_Parsed *expr,
                                             const double *param_values,
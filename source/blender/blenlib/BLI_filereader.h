@@ -50,6 +50,13 @@ typedef struct FileReader {
 FileReader *BLI_filereader_new_file(int filedes) ATTR_WARN_UNUSED_RESULT;
 /** Create #FileReader from raw file descriptor using memory-mapped IO. */
 FileReader *BLI_filereader_new_mmap(int filedes) ATTR_WARN_UNUSED_RESULT;
+/**
+ * Get the memory-mapped file of a #FileReader created with #BLI_filereader_new_mmap.
+ * This allows reading directly from the mapped memory without copying.
+ * Returns NULL for all other kinds of readers.
+ */
+struct BLI_mmap_file *BLI_filereader_get_mmap(FileReader *reader) ATTR_WARN_UNUSED_RESULT
+    ATTR_NONNULL();
 /** Create #FileReader from a region of memory. */
 FileReader *BLI_filereader_new_memory(const void *data, size_t len) ATTR_WARN_UNUSED_RESULT
     ATTR_NONNULL();
@@ -310,6 +310,21 @@ void resize_trivial_array(T **data,
       *data, sizeof(T) * old_size, sizeof(T) * new_size, alignof(T), sharing_info));
 }
 
+/**
+ * Copies of shared data made by a thread because the data had to become mutable while it still
+ * had other users. Used to find out where copy-on-write copies happen when profiling.
+ */
+struct CopyOnWriteStats {
+  int64_t copies_num = 0;
+  int64_t copied_bytes = 0;
+};
+
+/** \return The statistics of the calling thread, they are never reset. */
+const CopyOnWriteStats &thread_copy_on_write_stats();
+
+/** Account for a copy of shared data made because it had to become mutable. */
+void count_copy_on_write(int64_t bytes);
+
 }  // namespace implicit_sharing
 
 }  // namespace blender
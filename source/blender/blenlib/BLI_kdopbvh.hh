@@ -144,6 +144,14 @@ BVHTree *BLI_bvhtree_new(int maxsize, float epsilon, char tree_type, char axis);
  * Construct: first insert points, then call balance.
  */
 void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoints);
+/**
+ * Insert \a leafs_num leafs at once, computing their bounds on multiple threads. \a fn is called
+ * for every new leaf, it fills the \a numpoints coordinates of the leaf and returns its index.
+ */
+void BLI_bvhtree_insert_parallel(BVHTree *tree,
+                                 int leafs_num,
+                                 int numpoints,
+                                 blender::FunctionRef<int(int leaf, blender::float3 *r_co)> fn);
 void BLI_bvhtree_balance(BVHTree *tree);
 
 /**
@@ -45,6 +45,31 @@ int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
                                    KDTreeNearest *r_nearest,
                                    uint nearest_len_capacity) ATTR_NONNULL(1, 2, 3);
 
+/**
+ * Find the nearest point for every coordinate in \a co, like #BLI_kdtree_3d_find_nearest.
+ * The queries are processed in parallel, and large batches in an order that keeps nearby
+ * queries together.
+ *
+ * \param r_nearest: One result per query, the index is -1 if the tree is empty.
+ */
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        uint co_len,
+                                        KDTreeNearest *r_nearest) ATTR_NONNULL(1);
+/**
+ * Find up to \a nearest_len_capacity nearest points for every coordinate in \a co, like
+ * #BLI_kdtree_3d_find_nearest_n, in parallel.
+ *
+ * \param r_nearest: `co_len * nearest_len_capacity` results, grouped by query.
+ * \param r_nearest_len: The number of points found for each query.
+ */
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          uint nearest_len_capacity,
+                                          int *r_nearest_len) ATTR_NONNULL(1);
+
 int BLI_kdtree_nd_(range_search)(const KDTree *tree,
                                  const float co[KD_DIMS],
                                  KDTreeNearest **r_nearest,
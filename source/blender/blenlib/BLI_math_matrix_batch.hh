@@ -0,0 +1,30 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * Transform many vectors with the same matrix. The result is the same as calling
+ * #math::transform_point or multiplying every vector with the matrix, but the loops are compiled
+ * for multiple instruction sets, see #BLI_cpu_dispatch.hh. The functions are single threaded,
+ * callers are expected to split large arrays with #threading::parallel_for.
+ */
+
+#include "BLI_math_matrix_types.hh"
+#include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
+
+namespace blender::math {
+
+/** Transform points with the rotation, scale and translation of the matrix. */
+void transform_points(const float4x4 &transform, MutableSpan<float3> points);
+/** \a src and \a dst must either be the same array or not overlap. */
+void transform_points(Span<float3> src, const float4x4 &transform, MutableSpan<float3> dst);
+
+/** Multiply all vectors with the matrix, e.g. to transform normals with the normal matrix. */
+void transform_directions(const float3x3 &transform, MutableSpan<float3> directions);
+
+}  // namespace blender::math
@@ -4,13 +4,27 @@
 
 /** \file
  * \ingroup bli
+ *
+ * A global cache with a memory budget. Values are grouped into categories (e.g. volume grids or
+ * imported files), which can have their own limit in addition to the limit of the whole cache.
+ * Caches that manage their own values, like image buffer caches, can report their memory usage
+ * with #set_external_usage so that it counts against the same budget.
+ *
+ * When the cache is full, the values that are cheapest to recompute relative to their size are
+ * freed first, with an aging term so that values that have not been used in a while are freed
+ * eventually (the GreedyDual-Size algorithm).
  */
 
 #pragma once
 
+#include <optional>
+#include <string>
+
 #include "BLI_function_ref.hh"
 #include "BLI_generic_key.hh"
 #include "BLI_memory_counter_fwd.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_vector.hh"
 
 namespace blender::memory_cache {
 
@@ -27,6 +41,40 @@ class CachedValue {
    * full.
    */
   virtual void count_memory(MemoryCounter &memory) const = 0;
+
+  /**
+   * Name of the category this value belongs to. Values of the same category share statistics
+   * and the limit set with #set_category_size_limit.
+   */
+  virtual StringRefNull category() const
+  {
+    return "Other";
+  }
+};
+
+struct CategoryStatistics {
+  std::string name;
+  /** Memory used by the values of this category, or the memory reported for external caches. */
+  int64_t size_in_bytes = 0;
+  std::optional<int64_t> size_limit;
+  int64_t values_num = 0;
+  /** Number of lookups that found a cached value. */
+  int64_t hits = 0;
+  /** Number of lookups that had to compute the value. */
+  int64_t misses = 0;
+  /** Number of values that were freed to stay within the limits. */
+  int64_t evictions = 0;
+  /** True if the memory is managed by another cache and only reported with #set_external_usage. */
+  bool is_external = false;
+};
+
+struct Statistics {
+  /** Memory used by all cached values, excluding external caches. */
+  int64_t size_in_bytes = 0;
+  /** Memory used by external caches. */
+  int64_t external_size_in_bytes = 0;
+  int64_t size_limit = 0;
+  Vector<CategoryStatistics> categories;
 };
 
 /**
@@ -50,6 +98,24 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
  */
 void set_approximate_size_limit(int64_t limit_in_bytes);
 
+/**
+ * Set how much memory the values of a category are allowed to use at most. This is in addition
+ * to the limit of the entire cache. No value removes the limit of the category.
+ */
+void set_category_size_limit(StringRef category, std::optional<int64_t> limit_in_bytes);
+
+/**
+ * Report how much memory a cache that manages its own values currently uses. This memory counts
+ * against the limit of the entire cache, so values in this cache are freed when other caches
+ * grow. The external cache is still responsible for staying within the limit itself.
+ */
+void set_external_usage(StringRef category, int64_t size_in_bytes);
+
+/**
+ * Get the current memory usage and access statistics of the cache and its categories.
+ */
+Statistics get_statistics();
+
 /**
  * Remove all elements from the cache. Note that this does not guarantee that no elements are in
  * the cache after the function returned. This is because another thread may have added a new
@@ -21,6 +21,9 @@ typedef struct BLI_mmap_file BLI_mmap_file;
  * May return NULL if the operation fails.
  * Note that this seeks to the end of the file to determine its length. */
 BLI_mmap_file *BLI_mmap_open(int fd) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
+/* Same as #BLI_mmap_open, but the mapped memory may be written to. Written pages are private
+ * copies of the process (copy-on-write), the file itself is never modified. */
+BLI_mmap_file *BLI_mmap_open_writable_copy(int fd) ATTR_MALLOC ATTR_WARN_UNUSED_RESULT;
 
 /* Reads length bytes from file at the given offset into dest.
  * Returns whether the operation was successful (may fail when reading beyond the file
@@ -29,6 +32,20 @@ bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length
     ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
 
 void *BLI_mmap_get_pointer(BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
+/* Returns a pointer to length bytes at the given offset of the mapped file, without copying.
+ * Returns NULL when the range is beyond the file end or a previous read failed.
+ * Since IO errors only show up when the memory is actually accessed, callers have to check
+ * #BLI_mmap_has_io_error after they are done reading from the returned memory. */
+const void *BLI_mmap_get_range(BLI_mmap_file *file, size_t offset, size_t length)
+    ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+bool BLI_mmap_has_io_error(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT ATTR_NONNULL(1);
+/* Hints that the given range is not going to be accessed again soon, so that the pages backing
+ * it can be dropped from the resident memory of the process. Reading the range again afterwards
+ * is still valid, the data is then paged in from the file again. */
+void BLI_mmap_release_range(BLI_mmap_file *file, size_t offset, size_t length) ATTR_NONNULL(1);
+/* Hints that the given range is going to be accessed soon, so that the OS can start reading it
+ * from the file in the background. */
+void BLI_mmap_prefetch_range(BLI_mmap_file *file, size_t offset, size_t length) ATTR_NONNULL(1);
 size_t BLI_mmap_get_length(const BLI_mmap_file *file) ATTR_WARN_UNUSED_RESULT;
 
 void BLI_mmap_free(BLI_mmap_file *file) ATTR_NONNULL(1);
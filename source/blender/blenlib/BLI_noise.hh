@@ -10,6 +10,7 @@
 
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_span.hh"
 
 namespace blender::noise {
 
@@ -85,6 +86,18 @@ float perlin(float4 position);
 template<typename T>
 float perlin_fbm(T p, float detail, float roughness, float lacunarity, bool normalize);
 
+/**
+ * Perlin fractal Brownian motion for many positions with the same parameters. The results are the
+ * same as calling #perlin_fbm for every position, but multiple positions are evaluated at once
+ * with vectorized code.
+ */
+void perlin_fbm(Span<float3> positions,
+                float detail,
+                float roughness,
+                float lacunarity,
+                bool normalize,
+                MutableSpan<float> r_values);
+
 /* Distorted fractal perlin noise. */
 
 template<typename T>
@@ -203,6 +216,16 @@ VoronoiOutput voronoi_f2(const VoronoiParams &params, const float3 coord);
 float voronoi_distance_to_edge(const VoronoiParams &params, const float3 coord);
 float voronoi_n_sphere_radius(const VoronoiParams &params, const float3 coord);
 
+/**
+ * #voronoi_f1 for many coordinates with the same parameters, evaluated with vectorized code for
+ * all metrics except Minkowski. Outputs that are empty are not computed.
+ */
+void voronoi_f1(const VoronoiParams &params,
+                Span<float3> coords,
+                MutableSpan<float> r_distances,
+                MutableSpan<float3> r_colors,
+                MutableSpan<float3> r_positions);
+
 /* **** 4D Voronoi **** */
 
 float4 voronoi_position(const float4 coord);
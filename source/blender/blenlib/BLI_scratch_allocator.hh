@@ -0,0 +1,94 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A thread-local stack arena for temporary buffers of algorithms, for example index maps that
+ * are only needed while copying a mesh. Memory is handed out linearly and released all at once
+ * when the #ScratchScope that allocated it ends. The arena keeps its memory for the next scope,
+ * so algorithms that run for every evaluation don't have to go through the system allocator for
+ * their temporary buffers every time.
+ *
+ * \code{.cc}
+ * ScratchScope scratch;
+ * Array<int, 0, ScratchAllocator> map(verts_num, scratch.allocator());
+ * \endcode
+ *
+ * Scratch memory must not outlive the scope that allocated it, and buffers can only be allocated
+ * on the thread that created the scope. They can be read and written from other threads though,
+ * e.g. in a #threading::parallel_for. Scopes on the same thread have to be nested, which is also
+ * the case when a thread executes other tasks while waiting for a parallel loop to finish.
+ */
+
+#include <cstdint>
+
+#include "BLI_utility_mixins.hh"
+
+namespace blender {
+
+class ScratchAllocator;
+struct ScratchArena;
+
+/**
+ * Allocation counters to measure how much allocator traffic is moved to scratch arenas. The
+ * counts of a thread are added to the totals when its outermost #ScratchScope ends.
+ */
+struct ScratchAllocatorStats {
+  /** Number of buffers and bytes allocated in scratch scopes. */
+  int64_t allocations_num = 0;
+  int64_t allocated_bytes = 0;
+  /** Number of memory chunks the arenas had to allocate from the system allocator. */
+  int64_t chunk_allocations_num = 0;
+};
+
+class ScratchScope : NonCopyable, NonMovable {
+ private:
+  ScratchArena &arena_;
+  int64_t begin_chunk_;
+  uintptr_t begin_;
+
+ public:
+  ScratchScope();
+  ~ScratchScope();
+
+  /** Get a buffer that is valid until the end of the scope. The alignment must be a power of 2. */
+  void *allocate(int64_t size, int64_t alignment);
+
+  /** Allocator for containers, whose memory is then valid until the end of the scope. */
+  ScratchAllocator allocator();
+
+  /** Release the last allocation of this scope if \a ptr is that allocation. */
+  void deallocate(const void *ptr);
+};
+
+/**
+ * Allocator for containers like #Array and #Vector that uses a #ScratchScope. Freeing memory
+ * does nothing except for the most recent allocation, so it's meant for buffers with a known
+ * size. A default constructed allocator uses #GuardedAllocator instead.
+ */
+class ScratchAllocator {
+ private:
+  ScratchScope *scope_ = nullptr;
+
+ public:
+  ScratchAllocator() = default;
+  ScratchAllocator(ScratchScope &scope) : scope_(&scope) {}
+
+  void *allocate(size_t size, size_t alignment, const char *name);
+  void deallocate(void *ptr);
+};
+
+inline ScratchAllocator ScratchScope::allocator()
+{
+  return ScratchAllocator(*this);
+}
+
+/** Totals of all threads since the last #scratch_allocator_stats_reset. */
+ScratchAllocatorStats scratch_allocator_stats();
+void scratch_allocator_stats_reset();
+
+}  // namespace blender
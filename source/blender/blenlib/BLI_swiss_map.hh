@@ -0,0 +1,1433 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A `blender::SwissMap<Key, Value>` is a hash map with the same interface as #blender::Map, but
+ * a different memory layout that is optimized for lookups in large maps.
+ *
+ * The state of every slot is stored in a separate array of control bytes. A full slot stores 7
+ * bits of the hash of its key in the control byte, empty and removed slots use special values.
+ * Probing does not check individual slots, but groups of 16 control bytes, which are compared to
+ * the hash bits of the searched key with a few SIMD instructions (SSE2 on x86, sse2neon on ARM).
+ * Keys are only compared for the few slots whose control byte matches. Most lookups therefore
+ * only touch one cache line of control bytes and one slot, even when there were collisions. This
+ * is the design of the "Swiss table" from the Abseil library.
+ *
+ * Compared to #Map:
+ * - The max load factor is 7/8 instead of 1/2, so the map needs fewer slots for the same size.
+ * - There is no inline buffer, a map always allocates at least 16 slots when an element is added.
+ *   Prefer #Map for many small maps.
+ * - The hash is mixed before it is used, so there is no customizable probing strategy. This also
+ *   means that consecutive integer keys don't end up in consecutive slots, so #Map is still faster
+ *   for dense integer keys that are looked up in order.
+ * - Lookups compare fewer keys in maps with many collisions, which also makes it a good choice for
+ *   keys that are expensive to compare, like strings.
+ *
+ * Benchmarks comparing it to #Map are in `tests/performance/BLI_map_performance_test.cc`.
+ */
+
+#include <optional>
+
+#include "BLI_allocator.hh"
+#include "BLI_hash.hh"
+#include "BLI_hash_tables.hh"
+#include "BLI_map.hh"
+#include "BLI_math_bits.h"
+#include "BLI_memory_utils.hh"
+#include "BLI_simd.hh"
+
+namespace blender {
+
+namespace swiss_map_detail {
+
+/** Control byte of a slot that was never used. Probing stops at a group with such a slot. */
+inline constexpr int8_t ctrl_empty = -128;
+/** Control byte of a slot whose element was removed. Probing continues past such a slot. */
+inline constexpr int8_t ctrl_removed = -2;
+/** Control bytes of full slots are in the range [0, 127]. */
+
+/** Number of control bytes that are checked at once. */
+inline constexpr int64_t group_size = 16;
+
+/** Control bytes used by empty maps, so that lookups don't have to check for that case. */
+alignas(group_size) inline constexpr int8_t empty_group[group_size] = {
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty,
+    ctrl_empty};
+
+/** A bit for every slot of a group. Iterating over it gives the indices of the set bits. */
+class GroupMask {
+ private:
+  uint32_t bits_;
+
+ public:
+  explicit GroupMask(const uint32_t bits) : bits_(bits) {}
+
+  bool any() const
+  {
+    return bits_ != 0;
+  }
+
+  int first() const
+  {
+    BLI_assert(bits_ != 0);
+    return int(bitscan_forward_uint(bits_));
+  }
+
+  int operator*() const
+  {
+    return this->first();
+  }
+
+  GroupMask &operator++()
+  {
+    bits_ &= bits_ - 1;
+    return *this;
+  }
+
+  GroupMask begin() const
+  {
+    return *this;
+  }
+
+  GroupMask end() const
+  {
+    return GroupMask(0);
+  }
+
+  friend bool operator!=(const GroupMask &a, const GroupMask &b)
+  {
+    return a.bits_ != b.bits_;
+  }
+};
+
+/** The control bytes of #group_size consecutive slots. */
+class Group {
+ private:
+#if BLI_HAVE_SSE2
+  __m128i ctrl_;
+#else
+  const int8_t *ctrl_;
+#endif
+
+ public:
+  /** The pointer does not have to be aligned. */
+  explicit Group(const int8_t *ctrl)
+  {
+#if BLI_HAVE_SSE2
+    ctrl_ = _mm_loadu_si128(reinterpret_cast<const __m128i *>(ctrl));
+#else
+    ctrl_ = ctrl;
+#endif
+  }
+
+  /** Slots whose control byte is equal to \a h2. */
+  GroupMask match(const int8_t h2) const
+  {
+#if BLI_HAVE_SSE2
+    return GroupMask(uint32_t(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_set1_epi8(h2), ctrl_))));
+#else
+    uint32_t bits = 0;
+    for (int i = 0; i < group_size; i++) {
+      bits |= uint32_t(ctrl_[i] == h2) << i;
+    }
+    return GroupMask(bits);
+#endif
+  }
+
+  GroupMask match_empty() const
+  {
+    return this->match(ctrl_empty);
+  }
+
+  /** Slots that can be used for a new element. */
+  GroupMask match_empty_or_removed() const
+  {
+#if BLI_HAVE_SSE2
+    /* Both special values are smaller than -1, control bytes of full slots are not. */
+    return GroupMask(
+        uint32_t(_mm_movemask_epi8(_mm_cmpgt_epi8(_mm_set1_epi8(int8_t(-1)), ctrl_))));
+#else
+    uint32_t bits = 0;
+    for (int i = 0; i < group_size; i++) {
+      bits |= uint32_t(ctrl_[i] < -1) << i;
+    }
+    return GroupMask(bits);
+#endif
+  }
+};
+
+/**
+ * Spread the entropy of the hash over all bits, so that hash functions that only have entropy in
+ * the lower bits (like the identity hash of integers) still result in few collisions.
+ */
+inline uint64_t mix_hash(const uint64_t hash)
+{
+  const uint64_t product = hash * uint64_t(0x9E3779B97F4A7C15);
+  return product ^ (product >> 32);
+}
+
+/** Position of the first group that is probed. */
+inline uint64_t hash_h1(const uint64_t mixed_hash)
+{
+  return mixed_hash >> 7;
+}
+
+/** The bits stored in the control byte of a full slot. */
+inline int8_t hash_h2(const uint64_t mixed_hash)
+{
+  return int8_t(mixed_hash & 0x7F);
+}
+
+/**
+ * Visits the start positions of groups until the key is found. The step size grows by one group
+ * every time, so that every group is visited once when the number of slots is a power of two.
+ */
+class ProbeSequence {
+ private:
+  uint64_t mask_;
+  uint64_t offset_;
+  uint64_t index_ = 0;
+
+ public:
+  ProbeSequence(const uint64_t h1, const uint64_t mask) : mask_(mask), offset_(h1 & mask) {}
+
+  uint64_t offset() const
+  {
+    return offset_;
+  }
+
+  uint64_t offset(const int i) const
+  {
+    return (offset_ + uint64_t(i)) & mask_;
+  }
+
+  void next()
+  {
+    index_ += group_size;
+    offset_ = (offset_ + index_) & mask_;
+  }
+
+  /** Number of groups visited before the current one. */
+  int64_t collisions() const
+  {
+    return int64_t(index_ / group_size);
+  }
+};
+
+}  // namespace swiss_map_detail
+
+template<
+    /** Type of the keys stored in the map. See #Map. */
+    typename Key,
+    /** Type of the value that is stored per key. See #Map. */
+    typename Value,
+    /** The hash function used to hash the keys. */
+    typename Hash = DefaultHash<Key>,
+    /** The equality operator used to compare keys. */
+    typename IsEqual = DefaultEquality<Key>,
+    /** The allocator used for the control bytes and slots. */
+    typename Allocator = GuardedAllocator>
+class SwissMap {
+ public:
+  using size_type = int64_t;
+  using Item = MapItem<Key, Value>;
+  using MutableItem = MutableMapItem<Key, Value>;
+
+ private:
+  /** Key and value are only constructed when the control byte of the slot marks it as full. */
+  struct Slot {
+    TypedBuffer<Key> key;
+    TypedBuffer<Value> value;
+  };
+
+  static constexpr int64_t group_size = swiss_map_detail::group_size;
+
+  /**
+   * There are `capacity_ + group_size` control bytes. The last group mirrors the first one, so
+   * that a group can be loaded at any slot index without wrapping around. Points to
+   * #swiss_map_detail::empty_group when nothing has been allocated.
+   */
+  int8_t *ctrl_;
+  /** Allocated in the same buffer as the control bytes. */
+  Slot *slots_;
+  /** Zero or a power of two that is at least #group_size. */
+  int64_t capacity_;
+  int64_t size_;
+  int64_t removed_slots_;
+  /** Number of elements that can still be added before the map has to grow. */
+  int64_t growth_left_;
+
+  BLI_NO_UNIQUE_ADDRESS Hash hash_;
+  BLI_NO_UNIQUE_ADDRESS IsEqual is_equal_;
+  BLI_NO_UNIQUE_ADDRESS Allocator allocator_;
+
+ public:
+  SwissMap(Allocator allocator = {}) noexcept
+      : ctrl_(const_cast<int8_t *>(swiss_map_detail::empty_group)),
+        slots_(nullptr),
+        capacity_(0),
+        size_(0),
+        removed_slots_(0),
+        growth_left_(0),
+        hash_(),
+        is_equal_(),
+        allocator_(allocator)
+  {
+  }
+
+  SwissMap(NoExceptConstructor, Allocator allocator = {}) noexcept : SwissMap(allocator) {}
+
+  SwissMap(const Span<std::pair<Key, Value>> items, Allocator allocator = {})
+      : SwissMap(allocator)
+  {
+    for (const std::pair<Key, Value> &item : items) {
+      this->add(item.first, item.second);
+    }
+  }
+
+  SwissMap(const std::initializer_list<std::pair<Key, Value>> items, Allocator allocator = {})
+      : SwissMap(Span(items), allocator)
+  {
+  }
+
+  SwissMap(const SwissMap &other) : SwissMap(other.allocator_)
+  {
+    hash_ = other.hash_;
+    is_equal_ = other.is_equal_;
+    if (other.size_ == 0) {
+      return;
+    }
+    this->reserve(other.size_);
+    other.foreach_item(
+        [&](const Key &key, const Value &value) { this->add_new__impl(key, hash_(key), value); });
+  }
+
+  SwissMap(SwissMap &&other) noexcept
+      : ctrl_(other.ctrl_),
+        slots_(other.slots_),
+        capacity_(other.capacity_),
+        size_(other.size_),
+        removed_slots_(other.removed_slots_),
+        growth_left_(other.growth_left_),
+        hash_(std::move(other.hash_)),
+        is_equal_(std::move(other.is_equal_)),
+        allocator_(other.allocator_)
+  {
+    other.noexcept_reset();
+  }
+
+  ~SwissMap()
+  {
+    this->destruct_elements();
+    this->free_buffer();
+  }
+
+  SwissMap &operator=(const SwissMap &other)
+  {
+    return copy_assign_container(*this, other);
+  }
+
+  SwissMap &operator=(SwissMap &&other)
+  {
+    return move_assign_container(*this, std::move(other));
+  }
+
+  /**
+   * Insert a new key-value-pair into the map. This invokes undefined behavior when the key is in
+   * the map already.
+   */
+  void add_new(const Key &key, const Value &value)
+  {
+    this->add_new_as(key, value);
+  }
+  void add_new(const Key &key, Value &&value)
+  {
+    this->add_new_as(key, std::move(value));
+  }
+  void add_new(Key &&key, const Value &value)
+  {
+    this->add_new_as(std::move(key), value);
+  }
+  void add_new(Key &&key, Value &&value)
+  {
+    this->add_new_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  void add_new_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    this->add_new__impl(
+        std::forward<ForwardKey>(key), hash_(key), std::forward<ForwardValue>(value)...);
+  }
+
+  /**
+   * Add a key-value-pair to the map. If the map contains the key already, nothing is changed.
+   * Returns true when the key has been newly added.
+   */
+  bool add(const Key &key, const Value &value)
+  {
+    return this->add_as(key, value);
+  }
+  bool add(const Key &key, Value &&value)
+  {
+    return this->add_as(key, std::move(value));
+  }
+  bool add(Key &&key, const Value &value)
+  {
+    return this->add_as(std::move(key), value);
+  }
+  bool add(Key &&key, Value &&value)
+  {
+    return this->add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    bool added = false;
+    this->lookup_or_add_slot__impl(key, hash_(key), [&](Slot &new_slot) {
+      this->construct_slot(
+          new_slot, std::forward<ForwardKey>(key), std::forward<ForwardValue>(value)...);
+      added = true;
+    });
+    return added;
+  }
+
+  /**
+   * Adds a key-value-pair to the map. If the map contained the key already, the corresponding
+   * value will be replaced.
+   * Returns true when the key has been newly added.
+   */
+  bool add_overwrite(const Key &key, const Value &value)
+  {
+    return this->add_overwrite_as(key, value);
+  }
+  bool add_overwrite(const Key &key, Value &&value)
+  {
+    return this->add_overwrite_as(key, std::move(value));
+  }
+  bool add_overwrite(Key &&key, const Value &value)
+  {
+    return this->add_overwrite_as(std::move(key), value);
+  }
+  bool add_overwrite(Key &&key, Value &&value)
+  {
+    return this->add_overwrite_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  bool add_overwrite_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    bool added = false;
+    Slot &slot = this->lookup_or_add_slot__impl(key, hash_(key), [&](Slot &new_slot) {
+      this->construct_slot(
+          new_slot, std::forward<ForwardKey>(key), std::forward<ForwardValue>(value)...);
+      added = true;
+    });
+    if (!added) {
+      *slot.value = Value(std::forward<ForwardValue>(value)...);
+    }
+    return added;
+  }
+
+  /**
+   * Returns true if there is a key in the map that compares equal to the given key.
+   */
+  bool contains(const Key &key) const
+  {
+    return this->contains_as(key);
+  }
+  template<typename ForwardKey> bool contains_as(const ForwardKey &key) const
+  {
+    return this->find_index(key, hash_(key)) != -1;
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. Returns true when the key was contained and is
+   * now removed, otherwise false.
+   */
+  bool remove(const Key &key)
+  {
+    return this->remove_as(key);
+  }
+  template<typename ForwardKey> bool remove_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    if (index == -1) {
+      return false;
+    }
+    this->remove_index(index);
+    return true;
+  }
+
+  /**
+   * Deletes the key-value-pair with the given key. This invokes undefined behavior when the key is
+   * not in the map.
+   */
+  void remove_contained(const Key &key)
+  {
+    this->remove_contained_as(key);
+  }
+  template<typename ForwardKey> void remove_contained_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    BLI_assert(index != -1);
+    this->remove_index(index);
+  }
+
+  /**
+   * Get the value that is stored for the given key and remove it from the map. This invokes
+   * undefined behavior when the key is not in the map.
+   */
+  Value pop(const Key &key)
+  {
+    return this->pop_as(key);
+  }
+  template<typename ForwardKey> Value pop_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    BLI_assert(index != -1);
+    Value value = std::move(*slots_[index].value);
+    this->remove_index(index);
+    return value;
+  }
+
+  /**
+   * Get the value that is stored for the given key and remove it from the map. If the key is not
+   * in the map, a value-less optional is returned.
+   */
+  std::optional<Value> pop_try(const Key &key)
+  {
+    return this->pop_try_as(key);
+  }
+  template<typename ForwardKey> std::optional<Value> pop_try_as(const ForwardKey &key)
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    if (index == -1) {
+      return {};
+    }
+    std::optional<Value> value = std::move(*slots_[index].value);
+    this->remove_index(index);
+    return value;
+  }
+
+  /**
+   * Get the value that corresponds to the given key and remove it from the map. If the key is
+   * not in the map, return the given default value instead.
+   */
+  Value pop_default(const Key &key, const Value &default_value)
+  {
+    return this->pop_default_as(key, default_value);
+  }
+  Value pop_default(const Key &key, Value &&default_value)
+  {
+    return this->pop_default_as(key, std::move(default_value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value pop_default_as(const ForwardKey &key, ForwardValue &&...default_value)
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    if (index == -1) {
+      return Value(std::forward<ForwardValue>(default_value)...);
+    }
+    Value value = std::move(*slots_[index].value);
+    this->remove_index(index);
+    return value;
+  }
+
+  /**
+   * Returns a pointer to the value that corresponds to the given key. If the key is not in the
+   * map, nullptr is returned.
+   */
+  const Value *lookup_ptr(const Key &key) const
+  {
+    return this->lookup_ptr_as(key);
+  }
+  Value *lookup_ptr(const Key &key)
+  {
+    return this->lookup_ptr_as(key);
+  }
+  template<typename ForwardKey> const Value *lookup_ptr_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    return (index == -1) ? nullptr : &*slots_[index].value;
+  }
+  template<typename ForwardKey> Value *lookup_ptr_as(const ForwardKey &key)
+  {
+    const SwissMap &const_this = *this;
+    return const_cast<Value *>(const_this.lookup_ptr_as(key));
+  }
+
+  /**
+   * Returns the key that is stored in the map for the given key. If the key is not in the map,
+   * a value-less optional is returned.
+   */
+  std::optional<Value> lookup_try(const Key &key) const
+  {
+    return this->lookup_try_as(key);
+  }
+  template<typename ForwardKey> std::optional<Value> lookup_try_as(const ForwardKey &key) const
+  {
+    const Value *ptr = this->lookup_ptr_as(key);
+    if (ptr == nullptr) {
+      return {};
+    }
+    return *ptr;
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. This invokes undefined
+   * behavior when the key is not in the map.
+   */
+  const Value &lookup(const Key &key) const
+  {
+    return this->lookup_as(key);
+  }
+  Value &lookup(const Key &key)
+  {
+    return this->lookup_as(key);
+  }
+  template<typename ForwardKey> const Value &lookup_as(const ForwardKey &key) const
+  {
+    const Value *ptr = this->lookup_ptr_as(key);
+    BLI_assert(ptr != nullptr);
+    return *ptr;
+  }
+  template<typename ForwardKey> Value &lookup_as(const ForwardKey &key)
+  {
+    Value *ptr = this->lookup_ptr_as(key);
+    BLI_assert(ptr != nullptr);
+    return *ptr;
+  }
+
+  /**
+   * Returns a copy of the value that corresponds to the given key. If the key is not in the
+   * map, the provided default_value is returned.
+   */
+  Value lookup_default(const Key &key, const Value &default_value) const
+  {
+    return this->lookup_default_as(key, default_value);
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value lookup_default_as(const ForwardKey &key, ForwardValue &&...default_value) const
+  {
+    const Value *ptr = this->lookup_ptr_as(key);
+    if (ptr != nullptr) {
+      return *ptr;
+    }
+    return Value(std::forward<ForwardValue>(default_value)...);
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added.
+   */
+  Value &lookup_or_add(const Key &key, const Value &value)
+  {
+    return this->lookup_or_add_as(key, value);
+  }
+  Value &lookup_or_add(const Key &key, Value &&value)
+  {
+    return this->lookup_or_add_as(key, std::move(value));
+  }
+  Value &lookup_or_add(Key &&key, const Value &value)
+  {
+    return this->lookup_or_add_as(std::move(key), value);
+  }
+  Value &lookup_or_add(Key &&key, Value &&value)
+  {
+    return this->lookup_or_add_as(std::move(key), std::move(value));
+  }
+  template<typename ForwardKey, typename... ForwardValue>
+  Value &lookup_or_add_as(ForwardKey &&key, ForwardValue &&...value)
+  {
+    Slot &slot = this->lookup_or_add_slot__impl(key, hash_(key), [&](Slot &new_slot) {
+      this->construct_slot(
+          new_slot, std::forward<ForwardKey>(key), std::forward<ForwardValue>(value)...);
+    });
+    return *slot.value;
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added. The value is only created when the key is not in the map.
+   */
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(const Key &key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(key, create_value);
+  }
+  template<typename CreateValueF>
+  Value &lookup_or_add_cb(Key &&key, const CreateValueF &create_value)
+  {
+    return this->lookup_or_add_cb_as(std::move(key), create_value);
+  }
+  template<typename ForwardKey, typename CreateValueF>
+  Value &lookup_or_add_cb_as(ForwardKey &&key, const CreateValueF &create_value)
+  {
+    Slot &slot = this->lookup_or_add_slot__impl(key, hash_(key), [&](Slot &new_slot) {
+      this->construct_slot(new_slot, std::forward<ForwardKey>(key), create_value());
+    });
+    return *slot.value;
+  }
+
+  /**
+   * Returns a reference to the value that corresponds to the given key. If the key is not yet in
+   * the map, it will be newly added with a default constructed value.
+   */
+  Value &lookup_or_add_default(const Key &key)
+  {
+    return this->lookup_or_add_default_as(key);
+  }
+  Value &lookup_or_add_default(Key &&key)
+  {
+    return this->lookup_or_add_default_as(std::move(key));
+  }
+  template<typename ForwardKey> Value &lookup_or_add_default_as(ForwardKey &&key)
+  {
+    return this->lookup_or_add_cb_as(std::forward<ForwardKey>(key), []() { return Value(); });
+  }
+
+  /**
+   * Returns the key that is stored in the map that compares equal to the given key. This invokes
+   * undefined behavior when the key is not in the map.
+   */
+  const Key &lookup_key(const Key &key) const
+  {
+    return this->lookup_key_as(key);
+  }
+  template<typename ForwardKey> const Key &lookup_key_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    BLI_assert(index != -1);
+    return *slots_[index].key;
+  }
+
+  /**
+   * Returns a pointer to the key that is stored in the map that compares equal to the given key.
+   * If the key is not in the map, null is returned.
+   */
+  const Key *lookup_key_ptr(const Key &key) const
+  {
+    return this->lookup_key_ptr_as(key);
+  }
+  template<typename ForwardKey> const Key *lookup_key_ptr_as(const ForwardKey &key) const
+  {
+    const int64_t index = this->find_index(key, hash_(key));
+    return (index == -1) ? nullptr : &*slots_[index].key;
+  }
+
+  /**
+   * Calls the provided callback for every key-value-pair in the map. The callback is expected
+   * to take a `const Key &` as first and a `const Value &` as second parameter.
+   */
+  template<typename FuncT> void foreach_item(const FuncT &func) const
+  {
+    for (int64_t i = 0; i < capacity_; i++) {
+      if (ctrl_[i] >= 0) {
+        func(*slots_[i].key, *slots_[i].value);
+      }
+    }
+  }
+
+  /* Common base class for all iterators below. */
+  struct BaseIterator {
+   public:
+    using iterator_category = std::forward_iterator_tag;
+    using difference_type = std::ptrdiff_t;
+
+   protected:
+    const int8_t *ctrl_;
+    Slot *slots_;
+    int64_t total_slots_;
+    int64_t current_slot_;
+
+    friend SwissMap;
+
+   public:
+    BaseIterator(const int8_t *ctrl,
+                 const Slot *slots,
+                 const int64_t total_slots,
+                 const int64_t current_slot)
+        : ctrl_(ctrl),
+          slots_(const_cast<Slot *>(slots)),
+          total_slots_(total_slots),
+          current_slot_(current_slot)
+    {
+    }
+
+    BaseIterator &operator++()
+    {
+      while (++current_slot_ < total_slots_) {
+        if (ctrl_[current_slot_] >= 0) {
+          break;
+        }
+      }
+      return *this;
+    }
+
+    BaseIterator operator++(int)
+    {
+      BaseIterator copied_iterator = *this;
+      ++(*this);
+      return copied_iterator;
+    }
+
+    friend bool operator!=(const BaseIterator &a, const BaseIterator &b)
+    {
+      BLI_assert(a.slots_ == b.slots_);
+      BLI_assert(a.total_slots_ == b.total_slots_);
+      return a.current_slot_ != b.current_slot_;
+    }
+
+    friend bool operator==(const BaseIterator &a, const BaseIterator &b)
+    {
+      return !(a != b);
+    }
+
+   protected:
+    Slot &current_slot() const
+    {
+      return slots_[current_slot_];
+    }
+  };
+
+  template<typename SubIterator> class BaseIteratorRange : public BaseIterator {
+   public:
+    BaseIteratorRange(const int8_t *ctrl,
+                      const Slot *slots,
+                      int64_t total_slots,
+                      int64_t current_slot)
+        : BaseIterator(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    SubIterator begin() const
+    {
+      for (int64_t i = 0; i < this->total_slots_; i++) {
+        if (this->ctrl_[i] >= 0) {
+          return SubIterator(this->ctrl_, this->slots_, this->total_slots_, i);
+        }
+      }
+      return this->end();
+    }
+
+    SubIterator end() const
+    {
+      return SubIterator(this->ctrl_, this->slots_, this->total_slots_, this->total_slots_);
+    }
+  };
+
+  class KeyIterator final : public BaseIteratorRange<KeyIterator> {
+   public:
+    using value_type = Key;
+    using pointer = const Key *;
+    using reference = const Key &;
+
+    KeyIterator(const int8_t *ctrl, const Slot *slots, int64_t total_slots, int64_t current_slot)
+        : BaseIteratorRange<KeyIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    const Key &operator*() const
+    {
+      return *this->current_slot().key;
+    }
+  };
+
+  class ValueIterator final : public BaseIteratorRange<ValueIterator> {
+   public:
+    using value_type = Value;
+    using pointer = const Value *;
+    using reference = const Value &;
+
+    ValueIterator(const int8_t *ctrl, const Slot *slots, int64_t total_slots, int64_t current_slot)
+        : BaseIteratorRange<ValueIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    const Value &operator*() const
+    {
+      return *this->current_slot().value;
+    }
+  };
+
+  class MutableValueIterator final : public BaseIteratorRange<MutableValueIterator> {
+   public:
+    using value_type = Value;
+    using pointer = Value *;
+    using reference = Value &;
+
+    MutableValueIterator(const int8_t *ctrl,
+                         Slot *slots,
+                         int64_t total_slots,
+                         int64_t current_slot)
+        : BaseIteratorRange<MutableValueIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    Value &operator*()
+    {
+      return *this->current_slot().value;
+    }
+  };
+
+  class ItemIterator final : public BaseIteratorRange<ItemIterator> {
+   public:
+    using value_type = Item;
+    using pointer = Item *;
+    using reference = Item &;
+
+    ItemIterator(const int8_t *ctrl, const Slot *slots, int64_t total_slots, int64_t current_slot)
+        : BaseIteratorRange<ItemIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    Item operator*() const
+    {
+      const Slot &slot = this->current_slot();
+      return {*slot.key, *slot.value};
+    }
+  };
+
+  class MutableItemIterator final : public BaseIteratorRange<MutableItemIterator> {
+   public:
+    using value_type = MutableItem;
+    using pointer = MutableItem *;
+    using reference = MutableItem &;
+
+    MutableItemIterator(const int8_t *ctrl,
+                        Slot *slots,
+                        int64_t total_slots,
+                        int64_t current_slot)
+        : BaseIteratorRange<MutableItemIterator>(ctrl, slots, total_slots, current_slot)
+    {
+    }
+
+    MutableItem operator*() const
+    {
+      Slot &slot = this->current_slot();
+      return {*slot.key, *slot.value};
+    }
+  };
+
+  /**
+   * Allows writing a range-for loop that iterates over all keys. The iterator is invalidated, when
+   * the map is changed.
+   */
+  KeyIterator keys() const &
+  {
+    return KeyIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all values in the map. The iterator is invalidated, when the map is
+   * changed.
+   */
+  ValueIterator values() const &
+  {
+    return ValueIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all values in the map and allows you to change the values. The
+   * iterator is invalidated, when the map is changed.
+   */
+  MutableValueIterator values() &
+  {
+    return MutableValueIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all key-value-pairs in the map. The iterator is invalidated, when
+   * the map is changed.
+   */
+  ItemIterator items() const &
+  {
+    return ItemIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /**
+   * Returns an iterator over all key-value-pairs in the map that allows changing the values. The
+   * iterator is invalidated, when the map is changed.
+   */
+  MutableItemIterator items() &
+  {
+    return MutableItemIterator(ctrl_, slots_, capacity_, 0);
+  }
+
+  /** See #Map::keys. */
+  KeyIterator keys() const && = delete;
+  MutableValueIterator values() && = delete;
+  ValueIterator values() const && = delete;
+  ItemIterator items() const && = delete;
+  MutableItemIterator items() && = delete;
+
+  /**
+   * Remove the key-value-pair that the iterator is currently pointing at.
+   * It is valid to call this method while iterating over the map. However, after this method has
+   * been called, the removed element must not be accessed anymore.
+   */
+  void remove(const BaseIterator &iterator)
+  {
+    BLI_assert(ctrl_[iterator.current_slot_] >= 0);
+    this->remove_index(iterator.current_slot_);
+  }
+
+  /**
+   * Remove all key-value-pairs for that the given predicate is true and return the number of
+   * removed pairs.
+   */
+  template<typename Predicate> int64_t remove_if(Predicate &&predicate)
+  {
+    const int64_t prev_size = size_;
+    for (int64_t i = 0; i < capacity_; i++) {
+      if (ctrl_[i] >= 0) {
+        if (predicate(MutableItem{*slots_[i].key, *slots_[i].value})) {
+          this->remove_index(i);
+        }
+      }
+    }
+    return prev_size - size_;
+  }
+
+  /**
+   * Print common statistics like size and collision count. This is useful for debugging purposes.
+   * Collisions are counted in probed groups here, not in probed slots.
+   */
+  void print_stats(const char *name) const
+  {
+    HashTableStats stats(*this, this->keys());
+    stats.print(name);
+  }
+
+  int64_t size() const
+  {
+    return size_;
+  }
+
+  bool is_empty() const
+  {
+    return size_ == 0;
+  }
+
+  /**
+   * Returns the number of available slots. This is mostly for debugging purposes.
+   */
+  int64_t capacity() const
+  {
+    return capacity_;
+  }
+
+  /**
+   * Returns the amount of removed slots in the map. This is mostly for debugging purposes.
+   */
+  int64_t removed_amount() const
+  {
+    return removed_slots_;
+  }
+
+  /**
+   * Returns the bytes required per element. This is mostly for debugging purposes.
+   */
+  int64_t size_per_element() const
+  {
+    return int64_t(sizeof(Slot)) + 1;
+  }
+
+  /**
+   * Returns the approximate memory requirements of the map in bytes.
+   */
+  int64_t size_in_bytes() const
+  {
+    return (capacity_ == 0) ? 0 : this->buffer_size(capacity_);
+  }
+
+  /**
+   * Potentially resize the map such that the specified number of elements can be added without
+   * another grow operation.
+   */
+  void reserve(const int64_t n)
+  {
+    if (size_ + growth_left_ < n) {
+      this->realloc_and_reinsert(capacity_for_size(n));
+    }
+  }
+
+  /**
+   * Remove all elements and free the memory.
+   */
+  void clear()
+  {
+    std::destroy_at(this);
+    new (this) SwissMap(NoExceptConstructor{});
+  }
+
+  /**
+   * Remove all elements, but don't free the underlying memory.
+   */
+  void clear_and_keep_capacity()
+  {
+    this->destruct_elements();
+    if (capacity_ > 0) {
+      std::fill_n(ctrl_, capacity_ + group_size, swiss_map_detail::ctrl_empty);
+    }
+    size_ = 0;
+    removed_slots_ = 0;
+    growth_left_ = max_size_for_capacity(capacity_);
+  }
+
+  /**
+   * Get the number of groups that have to be probed before the key is found or it is known that
+   * the key is not in the map.
+   */
+  int64_t count_collisions(const Key &key) const
+  {
+    using namespace swiss_map_detail;
+    const uint64_t hash = mix_hash(hash_(key));
+    const int8_t h2 = hash_h2(hash);
+    ProbeSequence probe(hash_h1(hash), this->slot_mask());
+    while (true) {
+      const Group group(ctrl_ + probe.offset());
+      for (const int i : group.match(h2)) {
+        if (is_equal_(key, *slots_[probe.offset(i)].key)) {
+          return probe.collisions();
+        }
+      }
+      if (group.match_empty().any()) {
+        return probe.collisions();
+      }
+      probe.next();
+    }
+  }
+
+  friend bool operator==(const SwissMap &a, const SwissMap &b)
+  {
+    if (a.size() != b.size()) {
+      return false;
+    }
+    for (const Item item : a.items()) {
+      const Value *value_b = b.lookup_ptr(item.key);
+      if (value_b == nullptr) {
+        return false;
+      }
+      if (item.value != *value_b) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  friend bool operator!=(const SwissMap &a, const SwissMap &b)
+  {
+    return !(a == b);
+  }
+
+ private:
+  static int64_t max_size_for_capacity(const int64_t capacity)
+  {
+    return capacity - capacity / 8;
+  }
+
+  static int64_t capacity_for_size(const int64_t size)
+  {
+    int64_t capacity = group_size;
+    while (max_size_for_capacity(capacity) < size) {
+      capacity *= 2;
+    }
+    return capacity;
+  }
+
+  /** Size of the control bytes, rounded up so that the slots behind them are aligned. */
+  static int64_t ctrl_size(const int64_t capacity)
+  {
+    const int64_t size = capacity + group_size;
+    const int64_t alignment = int64_t(alignof(Slot));
+    return (size + alignment - 1) / alignment * alignment;
+  }
+
+  static int64_t buffer_size(const int64_t capacity)
+  {
+    return ctrl_size(capacity) + capacity * int64_t(sizeof(Slot));
+  }
+
+  uint64_t slot_mask() const
+  {
+    /* Empty maps probe the single group of #swiss_map_detail::empty_group. */
+    return uint64_t(std::max<int64_t>(capacity_ - 1, 0));
+  }
+
+  void set_ctrl(const int64_t index, const int8_t ctrl)
+  {
+    ctrl_[index] = ctrl;
+    /* Keep the mirrored group at the end up to date. */
+    if (index < group_size) {
+      ctrl_[capacity_ + index] = ctrl;
+    }
+  }
+
+  template<typename ForwardKey, typename... ForwardValue>
+  void construct_slot(Slot &slot, ForwardKey &&key, ForwardValue &&...value)
+  {
+    new (&*slot.key) Key(std::forward<ForwardKey>(key));
+    try {
+      new (&*slot.value) Value(std::forward<ForwardValue>(value)...);
+    }
+    catch (...) {
+      std::destroy_at(&*slot.key);
+      throw;
+    }
+  }
+
+  void destruct_elements()
+  {
+    if constexpr (!std::is_trivially_destructible_v<Key> ||
+                  !std::is_trivially_destructible_v<Value>)
+    {
+      for (int64_t i = 0; i < capacity_; i++) {
+        if (ctrl_[i] >= 0) {
+          std::destroy_at(&*slots_[i].key);
+          std::destroy_at(&*slots_[i].value);
+        }
+      }
+    }
+  }
+
+  void free_buffer()
+  {
+    if (capacity_ > 0) {
+      allocator_.deallocate(ctrl_);
+    }
+  }
+
+  void noexcept_reset() noexcept
+  {
+    ctrl_ = const_cast<int8_t *>(swiss_map_detail::empty_group);
+    slots_ = nullptr;
+    capacity_ = 0;
+    size_ = 0;
+    removed_slots_ = 0;
+    growth_left_ = 0;
+  }
+
+  template<typename ForwardKey>
+  int64_t find_index(const ForwardKey &key, const uint64_t unmixed_hash) const
+  {
+    using namespace swiss_map_detail;
+    const uint64_t hash = mix_hash(unmixed_hash);
+    const int8_t h2 = hash_h2(hash);
+    ProbeSequence probe(hash_h1(hash), this->slot_mask());
+    while (true) {
+      const Group group(ctrl_ + probe.offset());
+      for (const int i : group.match(h2)) {
+        const int64_t index = int64_t(probe.offset(i));
+        if (is_equal_(key, *slots_[index].key)) {
+          return index;
+        }
+      }
+      if (LIKELY(group.match_empty().any())) {
+        return -1;
+      }
+      probe.next();
+    }
+  }
+
+  /** Index of the first slot that is empty or removed in the probe sequence of the hash. */
+  int64_t find_insert_index(const uint64_t hash) const
+  {
+    using namespace swiss_map_detail;
+    ProbeSequence probe(hash_h1(hash), this->slot_mask());
+    while (true) {
+      const Group group(ctrl_ + probe.offset());
+      const GroupMask mask = group.match_empty_or_removed();
+      if (mask.any()) {
+        return int64_t(probe.offset(mask.first()));
+      }
+      probe.next();
+    }
+  }
+
+  /** Marks the slot as full and returns it. The key and value still have to be constructed. */
+  Slot &prepare_insert(const uint64_t hash)
+  {
+    int64_t index = this->find_insert_index(hash);
+    if (UNLIKELY(growth_left_ == 0 && ctrl_[index] != swiss_map_detail::ctrl_removed)) {
+      this->grow();
+      index = this->find_insert_index(hash);
+    }
+    if (ctrl_[index] == swiss_map_detail::ctrl_removed) {
+      removed_slots_--;
+    }
+    else {
+      growth_left_--;
+    }
+    this->set_ctrl(index, swiss_map_detail::hash_h2(hash));
+    size_++;
+    return slots_[index];
+  }
+
+  /**
+   * Undo #prepare_insert when constructing the element failed. The slot is marked as removed,
+   * because other elements may have been probed past it already.
+   */
+  void cancel_insert(Slot &slot)
+  {
+    this->set_ctrl(&slot - slots_, swiss_map_detail::ctrl_removed);
+    removed_slots_++;
+    size_--;
+  }
+
+  template<typename ForwardKey, typename... ForwardValue>
+  void add_new__impl(ForwardKey &&key, const uint64_t hash, ForwardValue &&...value)
+  {
+    BLI_assert(this->find_index(key, hash) == -1);
+    Slot &slot = this->prepare_insert(swiss_map_detail::mix_hash(hash));
+    try {
+      this->construct_slot(
+          slot, std::forward<ForwardKey>(key), std::forward<ForwardValue>(value)...);
+    }
+    catch (...) {
+      this->cancel_insert(slot);
+      throw;
+    }
+  }
+
+  /**
+   * Returns the slot of the key. If the key is not in the map, a new slot is prepared and
+   * \a construct_slot_fn is called to construct the key and value in it.
+   */
+  template<typename ForwardKey, typename ConstructSlotF>
+  Slot &lookup_or_add_slot__impl(const ForwardKey &key,
+                                 const uint64_t hash,
+                                 const ConstructSlotF &construct_slot_fn)
+  {
+    const int64_t index = this->find_index(key, hash);
+    if (index != -1) {
+      return slots_[index];
+    }
+    Slot &slot = this->prepare_insert(swiss_map_detail::mix_hash(hash));
+    try {
+      construct_slot_fn(slot);
+    }
+    catch (...) {
+      this->cancel_insert(slot);
+      throw;
+    }
+    return slot;
+  }
+
+  void remove_index(const int64_t index)
+  {
+    using namespace swiss_map_detail;
+    std::destroy_at(&*slots_[index].key);
+    std::destroy_at(&*slots_[index].value);
+    size_--;
+    /* The slot can become empty again if no probe sequence could have passed it. That is the case
+     * when the group starting at it and the group ending at it together don't have #group_size
+     * consecutive full or removed slots, because then a lookup would have found an empty slot
+     * before reaching this one. */
+    const int64_t index_before = (index - group_size) & int64_t(this->slot_mask());
+    const GroupMask empty_after = Group(ctrl_ + index).match_empty();
+    const GroupMask empty_before = Group(ctrl_ + index_before).match_empty();
+    if (empty_after.any() && empty_before.any()) {
+      const int64_t full_after = empty_after.first();
+      const int64_t full_before = group_size - 1 - last_index(empty_before);
+      if (full_after + full_before < group_size) {
+        this->set_ctrl(index, ctrl_empty);
+        growth_left_++;
+        return;
+      }
+    }
+    this->set_ctrl(index, ctrl_removed);
+    removed_slots_++;
+  }
+
+  static int last_index(const swiss_map_detail::GroupMask &mask)
+  {
+    int last = 0;
+    for (const int i : mask) {
+      last = i;
+    }
+    return last;
+  }
+
+  /**
+   * Called when there is no space for a new element. When many slots are only marked as removed,
+   * the elements are reinserted without growing the map.
+   */
+  void grow()
+  {
+    if (capacity_ > 0 && size_ * 32 <= capacity_ * 25) {
+      this->realloc_and_reinsert(capacity_);
+    }
+    else {
+      this->realloc_and_reinsert(std::max(capacity_ * 2, capacity_for_size(size_ + 1)));
+    }
+  }
+
+  BLI_NOINLINE void realloc_and_reinsert(const int64_t new_capacity)
+  {
+    using namespace swiss_map_detail;
+    BLI_assert((new_capacity & (new_capacity - 1)) == 0);
+    BLI_assert(max_size_for_capacity(new_capacity) >= size_);
+    int8_t *new_ctrl = static_cast<int8_t *>(allocator_.allocate(
+        size_t(this->buffer_size(new_capacity)),
+        std::max<size_t>(alignof(Slot), size_t(group_size)),
+        __func__));
+    Slot *new_slots = reinterpret_cast<Slot *>(new_ctrl + this->ctrl_size(new_capacity));
+    std::fill_n(new_ctrl, new_capacity + group_size, ctrl_empty);
+
+    const uint64_t new_slot_mask = uint64_t(new_capacity - 1);
+    for (int64_t i = 0; i < capacity_; i++) {
+      if (ctrl_[i] < 0) {
+        continue;
+      }
+      Slot &old_slot = slots_[i];
+      const uint64_t hash = mix_hash(hash_(*old_slot.key));
+      ProbeSequence probe(hash_h1(hash), new_slot_mask);
+      while (true) {
+        const GroupMask mask = Group(new_ctrl + probe.offset()).match_empty();
+        if (mask.any()) {
+          const int64_t new_index = int64_t(probe.offset(mask.first()));
+          new_ctrl[new_index] = hash_h2(hash);
+          if (new_index < group_size) {
+            new_ctrl[new_capacity + new_index] = hash_h2(hash);
+          }
+          Slot &new_slot = new_slots[new_index];
+          /* Moving is expected not to throw, like in the other containers. */
+          new (&*new_slot.key) Key(std::move(*old_slot.key));
+          new (&*new_slot.value) Value(std::move(*old_slot.value));
+          std::destroy_at(&*old_slot.key);
+          std::destroy_at(&*old_slot.value);
+          break;
+        }
+        probe.next();
+      }
+    }
+
+    this->free_buffer();
+    ctrl_ = new_ctrl;
+    slots_ = new_slots;
+    capacity_ = new_capacity;
+    removed_slots_ = 0;
+    growth_left_ = max_size_for_capacity(new_capacity) - size_;
+  }
+};
+
+}  // namespace blender
@@ -12,6 +12,8 @@
 
 int BLI_cpu_support_sse2(void);
 int BLI_cpu_support_sse42(void);
+/** AVX2 and FMA instructions, and the operating system saves the AVX registers. */
+int BLI_cpu_support_avx2(void);
 /**
  * Write a backtrace into a file for systems which support it.
  */
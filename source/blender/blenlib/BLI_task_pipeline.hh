@@ -0,0 +1,208 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup bli
+ *
+ * A pipeline processes a stream of items in multiple stages, like reading chunks of a file,
+ * parsing them and adding the results to a data-block. Stages can run in parallel on different
+ * items, and the number of items that are in the pipeline at the same time is limited, so that
+ * a fast producer doesn't fill up the memory with items that a slower stage can't process yet.
+ *
+ * The first stage produces the items. It returns an optional item and ends the stream by
+ * returning an empty optional. Every other stage receives the result of the previous stage, the
+ * last stage doesn't return anything.
+ *
+ * \code{.cc}
+ * threading::Pipeline pipeline;
+ * pipeline.run(
+ *     threading::PipelineStage{threading::PipelineStageMode::SerialInOrder,
+ *                              [&]() -> std::optional<Chunk> { return reader.next_chunk(); }},
+ *     threading::PipelineStage{threading::PipelineStageMode::Parallel,
+ *                              [&](Chunk chunk) { return parse_chunk(chunk); }},
+ *     threading::PipelineStage{threading::PipelineStageMode::SerialInOrder,
+ *                              [&](ParsedChunk parsed) { add_to_mesh(parsed); }});
+ * \endcode
+ */
+
+#include <atomic>
+#include <optional>
+#include <type_traits>
+
+#include "BLI_task.h"
+#include "BLI_task.hh"
+#include "BLI_utility_mixins.hh"
+
+/* Included after BLI_task.hh which takes care of the Windows min/max macros. */
+#ifdef WITH_TBB
+#  include <tbb/parallel_pipeline.h>
+#endif
+
+namespace blender::threading {
+
+enum class PipelineStageMode {
+  /** Items are processed one at a time, in the order in which they were produced. */
+  SerialInOrder,
+  /** Items are processed one at a time, in any order. */
+  SerialOutOfOrder,
+  /** Multiple items can be processed at the same time. */
+  Parallel,
+};
+
+template<typename Fn> struct PipelineStage {
+  PipelineStageMode mode;
+  Fn fn;
+};
+
+template<typename Fn> PipelineStage(PipelineStageMode, Fn) -> PipelineStage<Fn>;
+
+class Pipeline : NonCopyable, NonMovable {
+ private:
+  int max_items_in_flight_;
+  std::atomic<bool> cancelled_ = false;
+#ifdef WITH_TBB
+  tbb::task_group_context tbb_context_;
+#endif
+
+ public:
+  /**
+   * \param max_items_in_flight: Number of items that can be in the pipeline at the same time.
+   * By default this is twice the number of threads of the task scheduler.
+   */
+  explicit Pipeline(const int max_items_in_flight = 0)
+      : max_items_in_flight_(max_items_in_flight > 0 ? max_items_in_flight :
+                                                       2 * BLI_task_scheduler_num_threads())
+  {
+  }
+
+  /**
+   * Stop the pipeline from any stage or thread. No new items are produced and items that are
+   * still in the pipeline may be dropped without reaching the remaining stages.
+   */
+  void cancel()
+  {
+    cancelled_.store(true, std::memory_order_relaxed);
+#ifdef WITH_TBB
+    tbb_context_.cancel_group_execution();
+#endif
+  }
+
+  bool is_cancelled() const
+  {
+    return cancelled_.load(std::memory_order_relaxed);
+  }
+
+  /**
+   * Process all items of the first stage with the other stages. Returns when all items are
+   * processed or the pipeline has been cancelled. The calling thread only works on this pipeline
+   * in the meantime, see #BLI_task_isolate.
+   */
+  template<typename SourceFn, typename... StageFns>
+  void run(PipelineStage<SourceFn> source, PipelineStage<StageFns>... stages)
+  {
+    static_assert(sizeof...(StageFns) > 0, "A pipeline needs at least one stage after the source");
+    using SourceResult = std::invoke_result_t<SourceFn &>;
+    using Item = typename SourceResult::value_type;
+    static_assert(std::is_same_v<SourceResult, std::optional<Item>>,
+                  "The first stage has to return an optional item");
+
+    if (this->is_cancelled()) {
+      return;
+    }
+    lazy_threading::send_hint();
+#ifdef WITH_TBB
+    isolate_task([&]() {
+      auto source_filter = tbb::make_filter<void, Token<Item>>(
+          to_tbb_mode(source.mode), [&](tbb::flow_control &flow) -> Token<Item> {
+            std::optional<Item> item;
+            if (!this->is_cancelled()) {
+              item = source.fn();
+            }
+            if (!item.has_value()) {
+              flow.stop();
+            }
+            return Token<Item>(std::move(item));
+          });
+      tbb::parallel_pipeline(
+          size_t(max_items_in_flight_), source_filter & make_filters<Item>(stages...), tbb_context_);
+    });
+#else
+    while (!this->is_cancelled()) {
+      std::optional<Item> item = source.fn();
+      if (!item.has_value()) {
+        break;
+      }
+      this->run_stages(std::move(*item), stages...);
+    }
+#endif
+  }
+
+ private:
+#ifdef WITH_TBB
+  static tbb::filter_mode to_tbb_mode(const PipelineStageMode mode)
+  {
+    switch (mode) {
+      case PipelineStageMode::SerialInOrder:
+        return tbb::filter_mode::serial_in_order;
+      case PipelineStageMode::SerialOutOfOrder:
+        return tbb::filter_mode::serial_out_of_order;
+      case PipelineStageMode::Parallel:
+        return tbb::filter_mode::parallel;
+    }
+    BLI_assert_unreachable();
+    return tbb::filter_mode::serial_in_order;
+  }
+
+  /**
+   * Items are wrapped when they are passed between stages. TBB passes small trivially copyable
+   * types directly in a union otherwise, which requires them to be default constructible. This
+   * also allows ending the stream without constructing an item.
+   */
+  template<typename T> struct Token {
+    std::optional<T> item;
+
+    explicit Token(std::optional<T> &&value) : item(std::move(value)) {}
+    Token(Token &&other) : item(std::move(other.item)) {}
+  };
+
+  template<typename In, typename Fn, typename... RestFns>
+  static auto make_filters(PipelineStage<Fn> &stage, PipelineStage<RestFns> &...rest)
+  {
+    using Out = std::invoke_result_t<Fn &, In>;
+    if constexpr (sizeof...(RestFns) == 0) {
+      static_assert(std::is_void_v<Out>, "The last stage must not return a value");
+      return tbb::make_filter<Token<In>, void>(
+          to_tbb_mode(stage.mode), [&stage](Token<In> token) { stage.fn(std::move(*token.item)); });
+    }
+    else {
+      return tbb::make_filter<Token<In>, Token<Out>>(
+                 to_tbb_mode(stage.mode),
+                 [&stage](Token<In> token) -> Token<Out> {
+                   return Token<Out>(stage.fn(std::move(*token.item)));
+                 }) &
+             make_filters<Out>(rest...);
+    }
+  }
+#else
+  template<typename In, typename Fn, typename... RestFns>
+  void run_stages(In item, PipelineStage<Fn> &stage, PipelineStage<RestFns> &...rest)
+  {
+    using Out = std::invoke_result_t<Fn &, In>;
+    if constexpr (sizeof...(RestFns) == 0) {
+      static_assert(std::is_void_v<Out>, "The last stage must not return a value");
+      stage.fn(std::move(item));
+    }
+    else {
+      Out result = stage.fn(std::move(item));
+      if (!this->is_cancelled()) {
+        this->run_stages(std::move(result), rest...);
+      }
+    }
+  }
+#endif
+};
+
+}  // namespace blender::threading
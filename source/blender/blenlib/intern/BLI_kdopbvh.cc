@@ -24,16 +24,20 @@
  */
 
 #include <algorithm>
+#include <array>
+#include <cmath>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_alloca.h"
+#include "BLI_array.hh"
 #include "BLI_heap_simple.h"
 #include "BLI_kdopbvh.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_stack.h"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
@@ -56,6 +60,17 @@
 #  define KDOPBVH_THREAD_LEAF_THRESHOLD 1024
 #endif
 
+/**
+ * Branches with more leafs compute their bounds and partition their leafs on multiple threads.
+ * This matters for the first levels of the tree, which only have a few branches to build in
+ * parallel.
+ */
+#ifndef NDEBUG
+#  define KDOPBVH_PARALLEL_BRANCH_LEAF_THRESHOLD 256
+#else
+#  define KDOPBVH_PARALLEL_BRANCH_LEAF_THRESHOLD 65536
+#endif
+
 /* -------------------------------------------------------------------- */
 /** \name Struct Definitions
  * \{ */
@@ -319,6 +334,121 @@ static void partition_nth_element(BVHNode **a, int begin, int end, const int n,
   bvh_insertionsort(a, begin, end, axis);
 }
 
+/** Median of evenly spaced samples of the range, used as pivot to partition large ranges. */
+static float bvh_sample_pivot(BVHNode **a, const int begin, const int end, const int axis)
+{
+  constexpr int samples_num = 31;
+  std::array<float, samples_num> samples;
+  const int64_t step = (end - begin) / samples_num;
+  for (int i = 0; i < samples_num; i++) {
+    samples[size_t(i)] = a[begin + step * i]->bv[axis];
+  }
+  std::nth_element(samples.begin(), samples.begin() + samples_num / 2, samples.end());
+  return samples[samples_num / 2];
+}
+
+/**
+ * Same as #partition_nth_element, using multiple threads for large ranges. Each step moves the
+ * nodes smaller than, equal to and larger than a pivot to three consecutive parts of the range,
+ * and continues with the part containing \a n.
+ */
+static void partition_nth_element_parallel(
+    BVHNode **a, int begin, int end, const int n, const int axis)
+{
+  using namespace blender;
+  constexpr int chunk_size = 16384;
+  Array<BVHNode *> buffer;
+  Array<int> less_offsets;
+  Array<int> equal_offsets;
+  Array<int> greater_offsets;
+
+  while (end - begin > KDOPBVH_PARALLEL_BRANCH_LEAF_THRESHOLD) {
+    const float pivot = bvh_sample_pivot(a, begin, end, axis);
+    if (std::isnan(pivot)) {
+      break;
+    }
+    const int size = end - begin;
+    const int chunks_num = (size + chunk_size - 1) / chunk_size;
+    const auto chunk_range = [&](const int64_t chunk) {
+      return IndexRange::from_begin_end(begin + chunk * chunk_size,
+                                        std::min<int64_t>(begin + (chunk + 1) * chunk_size, end));
+    };
+
+    /* Count the nodes of each part in every chunk. */
+    less_offsets.reinitialize(chunks_num + 1);
+    equal_offsets.reinitialize(chunks_num + 1);
+    greater_offsets.reinitialize(chunks_num + 1);
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        int less_num = 0;
+        int equal_num = 0;
+        for (const int64_t i : chunk_range(chunk)) {
+          const float value = a[i]->bv[axis];
+          less_num += value < pivot;
+          equal_num += value == pivot;
+        }
+        less_offsets[chunk] = less_num;
+        equal_offsets[chunk] = equal_num;
+        greater_offsets[chunk] = int(chunk_range(chunk).size()) - less_num - equal_num;
+      }
+    });
+
+    /* Accumulate the counts to find where each chunk writes its nodes. */
+    int less_total = 0;
+    int equal_total = 0;
+    int greater_total = 0;
+    for (int chunk = 0; chunk <= chunks_num; chunk++) {
+      const int less_num = less_offsets[chunk];
+      const int equal_num = equal_offsets[chunk];
+      const int greater_num = greater_offsets[chunk];
+      less_offsets[chunk] = less_total;
+      equal_offsets[chunk] = equal_total;
+      greater_offsets[chunk] = greater_total;
+      if (chunk < chunks_num) {
+        less_total += less_num;
+        equal_total += equal_num;
+        greater_total += greater_num;
+      }
+    }
+
+    buffer.reinitialize(size);
+    threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange chunks) {
+      for (const int64_t chunk : chunks) {
+        int less_i = less_offsets[chunk];
+        int equal_i = less_total + equal_offsets[chunk];
+        int greater_i = less_total + equal_total + greater_offsets[chunk];
+        for (const int64_t i : chunk_range(chunk)) {
+          const float value = a[i]->bv[axis];
+          if (value < pivot) {
+            buffer[less_i++] = a[i];
+          }
+          else if (value == pivot) {
+            buffer[equal_i++] = a[i];
+          }
+          else {
+            buffer[greater_i++] = a[i];
+          }
+        }
+      }
+    });
+    threading::parallel_for(IndexRange(size), chunk_size, [&](const IndexRange range) {
+      std::copy_n(&buffer[range.first()], range.size(), &a[begin + range.first()]);
+    });
+
+    if (n < begin + less_total) {
+      end = begin + less_total;
+    }
+    else if (n < begin + less_total + equal_total) {
+      /* The nth node is equal to the pivot, like all the nodes around it. */
+      return;
+    }
+    else {
+      begin += less_total + equal_total;
+    }
+  }
+  partition_nth_element(a, begin, end, n, axis);
+}
+
 #ifdef USE_SKIP_LINKS
 static void build_skip_links(BVHTree *tree, BVHNode *node, BVHNode *left, BVHNode *right)
 {
@@ -366,10 +496,7 @@ static void create_kdop_hull(
   }
 }
 
-/**
- * \note depends on the fact that the BVH's for each face is already built
- */
-static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+static void refit_kdop_hull_serial(const BVHTree *tree, BVHNode *node, int start, int end)
 {
   float newmin, newmax;
   float *__restrict bv = node->bv;
@@ -392,6 +519,54 @@ static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int e
   }
 }
 
+/**
+ * \note depends on the fact that the BVH's for each face is already built
+ */
+static void refit_kdop_hull(const BVHTree *tree, BVHNode *node, int start, int end)
+{
+  using namespace blender;
+  if (end - start <= KDOPBVH_PARALLEL_BRANCH_LEAF_THRESHOLD) {
+    refit_kdop_hull_serial(tree, node, start, end);
+    return;
+  }
+
+  using Bounds = std::array<float, 26>;
+  Bounds init;
+  BVHNode init_node{};
+  init_node.bv = init.data();
+  node_minmax_init(tree, &init_node);
+
+  const auto join = [&](const Bounds &a, const Bounds &b) {
+    Bounds result;
+    for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+      const int min_i = 2 * axis_iter;
+      const int max_i = 2 * axis_iter + 1;
+      result.data()[min_i] = std::min(a.data()[min_i], b.data()[min_i]);
+      result.data()[max_i] = std::max(a.data()[max_i], b.data()[max_i]);
+    }
+    return result;
+  };
+
+  const Bounds bounds = threading::parallel_reduce(
+      IndexRange::from_begin_end(start, end),
+      4096,
+      init,
+      [&](const IndexRange range, const Bounds &bounds_prev) {
+        Bounds range_bounds;
+        BVHNode range_node{};
+        range_node.bv = range_bounds.data();
+        refit_kdop_hull_serial(
+            tree, &range_node, int(range.first()), int(range.one_after_last()));
+        return join(bounds_prev, range_bounds);
+      },
+      join);
+
+  for (axis_t axis_iter = tree->start_axis; axis_iter < tree->stop_axis; axis_iter++) {
+    node->bv[2 * axis_iter] = bounds.data()[2 * axis_iter];
+    node->bv[2 * axis_iter + 1] = bounds.data()[2 * axis_iter + 1];
+  }
+}
+
 /**
  * Only supports x,y,z axis in the moment
  * but we should use a plain and simple function here for speed sake.
@@ -666,7 +841,7 @@ static void split_leafs(BVHNode **leafs_array,
       break;
     }
 
-    partition_nth_element(leafs_array, nth[i], nth[partitions], nth[i + 1], split_axis);
+    partition_nth_element_parallel(leafs_array, nth[i], nth[partitions], nth[i + 1], split_axis);
   }
 }
 
@@ -990,6 +1165,33 @@ void BLI_bvhtree_insert(BVHTree *tree, int index, const float co[3], int numpoin
   bvhtree_node_inflate(tree, node, tree->epsilon);
 }
 
+void BLI_bvhtree_insert_parallel(BVHTree *tree,
+                                 const int leafs_num,
+                                 const int numpoints,
+                                 blender::FunctionRef<int(int leaf, blender::float3 *r_co)> fn)
+{
+  using namespace blender;
+
+  /* insert should only possible as long as tree->branch_num is 0 */
+  BLI_assert(tree->branch_num <= 0);
+  BLI_assert(size_t(tree->leaf_num + leafs_num) <=
+             MEM_allocN_len(tree->nodes) / sizeof(*(tree->nodes)));
+
+  const int leafs_start = tree->leaf_num;
+  threading::parallel_for(IndexRange(leafs_num), 1024, [&](const IndexRange range) {
+    Array<float3, 4> co(numpoints);
+    for (const int64_t i : range) {
+      BVHNode *node = tree->nodes[leafs_start + i] = &tree->nodearray[leafs_start + i];
+      node->index = fn(int(i), co.data());
+      create_kdop_hull(tree, node, &co.data()->x, numpoints, 0);
+
+      /* inflate the bv with some epsilon */
+      bvhtree_node_inflate(tree, node, tree->epsilon);
+    }
+  });
+  tree->leaf_num += leafs_num;
+}
+
 bool BLI_bvhtree_update_node(
     BVHTree *tree, int index, const float co[3], const float co_moving[3], int numpoints)
 {
@@ -11,6 +11,7 @@
 #include "BLI_listbase.h"
 #include "MEM_guardedalloc.h"
 
+#include <algorithm>
 #include <cstring>
 
 #ifndef WIN32
@@ -33,6 +34,9 @@ struct BLI_mmap_file {
   /* Platform-specific handle for the mapping. */
   void *handle;
 
+  /* The memory is a private copy-on-write mapping that may be written to. */
+  bool writable;
+
   /* Flag to indicate IO errors. Needs to be volatile since it's being set from
    * within the signal handler, which is not part of the normal execution flow. */
   volatile bool io_error;
@@ -73,8 +77,12 @@ static void sigbus_handler(int sig, siginfo_t *siginfo, void *ptr)
       file->io_error = true;
 
       /* Replace the mapped memory with zeroes. */
-      const void *mapped_memory = mmap(
-          file->memory, file->length, PROT_READ, MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED, -1, 0);
+      const void *mapped_memory = mmap(file->memory,
+                                       file->length,
+                                       file->writable ? PROT_READ | PROT_WRITE : PROT_READ,
+                                       MAP_PRIVATE | MAP_ANONYMOUS | MAP_FIXED,
+                                       -1,
+                                       0);
       if (mapped_memory == MAP_FAILED) {
         fprintf(stderr, "SIGBUS handler: Error replacing mapped file with zeros\n");
       }
@@ -130,7 +138,7 @@ static void sigbus_handler_remove(BLI_mmap_file *file)
 }
 #endif
 
-BLI_mmap_file *BLI_mmap_open(int fd)
+static BLI_mmap_file *mmap_open_impl(const int fd, const bool writable)
 {
   void *memory, *handle = nullptr;
   const size_t length = BLI_lseek(fd, 0, SEEK_END);
@@ -145,7 +153,8 @@ BLI_mmap_file *BLI_mmap_open(int fd)
   }
 
   /* Map the given file to memory. */
-  memory = mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+  memory = mmap(
+      nullptr, length, writable ? PROT_READ | PROT_WRITE : PROT_READ, MAP_PRIVATE, fd, 0);
   if (memory == MAP_FAILED) {
     return nullptr;
   }
@@ -155,11 +164,12 @@ BLI_mmap_file *BLI_mmap_open(int fd)
   /* Memory mapping on Windows is a two-step process - first we create a mapping,
    * then we create a view into that mapping.
    * In our case, one view that spans the entire file is enough. */
-  handle = CreateFileMapping(file_handle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+  handle = CreateFileMapping(
+      file_handle, nullptr, writable ? PAGE_WRITECOPY : PAGE_READONLY, 0, 0, nullptr);
   if (handle == nullptr) {
     return nullptr;
   }
-  memory = MapViewOfFile(handle, FILE_MAP_READ, 0, 0, 0);
+  memory = MapViewOfFile(handle, writable ? FILE_MAP_COPY : FILE_MAP_READ, 0, 0, 0);
   if (memory == nullptr) {
     CloseHandle(handle);
     return nullptr;
@@ -171,6 +181,7 @@ BLI_mmap_file *BLI_mmap_open(int fd)
   file->memory = static_cast<char *>(memory);
   file->handle = handle;
   file->length = length;
+  file->writable = writable;
 
 #ifndef WIN32
   /* Register the file with the error handler. */
@@ -180,6 +191,16 @@ BLI_mmap_file *BLI_mmap_open(int fd)
   return file;
 }
 
+BLI_mmap_file *BLI_mmap_open(int fd)
+{
+  return mmap_open_impl(fd, false);
+}
+
+BLI_mmap_file *BLI_mmap_open_writable_copy(int fd)
+{
+  return mmap_open_impl(fd, true);
+}
+
 bool BLI_mmap_read(BLI_mmap_file *file, void *dest, size_t offset, size_t length)
 {
   /* If a previous read has already failed or we try to read past the end,
@@ -214,6 +235,63 @@ void *BLI_mmap_get_pointer(BLI_mmap_file *file)
   return file->memory;
 }
 
+const void *BLI_mmap_get_range(BLI_mmap_file *file, size_t offset, size_t length)
+{
+  if (file->io_error || (offset + length > file->length)) {
+    return nullptr;
+  }
+  return file->memory + offset;
+}
+
+bool BLI_mmap_has_io_error(const BLI_mmap_file *file)
+{
+  return file->io_error;
+}
+
+void BLI_mmap_release_range(BLI_mmap_file *file, size_t offset, size_t length)
+{
+#ifndef WIN32
+  /* Only whole pages can be released, partially covered pages at the start and end of the range
+   * may still be used by neighboring data. */
+  static const size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+  const size_t start = (size_t(file->memory + offset) + page_size - 1) & ~(page_size - 1);
+  const size_t end = size_t(file->memory + std::min(offset + length, file->length)) &
+                     ~(page_size - 1);
+  /* Dropping pages of a writable mapping would lose the changes made to them. */
+  if (file->io_error || file->writable || start >= end) {
+    return;
+  }
+  /* The mapping is private and read-only, so the pages are simply reloaded from the file when
+   * accessed again. */
+  madvise((void *)start, end - start, MADV_DONTNEED);
+#else
+  /* Windows trims the working set of mapped views on its own, there is no equivalent hint that
+   * keeps the view valid. */
+  UNUSED_VARS(file, offset, length);
+#endif
+}
+
+void BLI_mmap_prefetch_range(BLI_mmap_file *file, size_t offset, size_t length)
+{
+#ifndef WIN32
+  static const size_t page_size = size_t(sysconf(_SC_PAGESIZE));
+  const size_t start = size_t(file->memory + offset) & ~(page_size - 1);
+  const size_t end = size_t(file->memory + std::min(offset + length, file->length));
+  if (file->io_error || start >= end) {
+    return;
+  }
+  madvise((void *)start, end - start, MADV_WILLNEED);
+#else
+  WIN32_MEMORY_RANGE_ENTRY range;
+  range.VirtualAddress = file->memory + offset;
+  range.NumberOfBytes = std::min(length, file->length - std::min(offset, file->length));
+  if (file->io_error || range.NumberOfBytes == 0) {
+    return;
+  }
+  PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+#endif
+}
+
 size_t BLI_mmap_get_length(const BLI_mmap_file *file)
 {
   return file->length;
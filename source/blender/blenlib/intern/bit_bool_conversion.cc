@@ -85,6 +85,22 @@ struct BoolToBit {
 #endif
 };
 
+struct BoolToBitInverse {
+  static bool single(const char c)
+  {
+    return !bool(c);
+  }
+
+#if BLI_HAVE_SSE2
+  static uint16_t see2_chunk(const __m128i chunk)
+  {
+    const __m128i zero_bytes = _mm_set1_epi8(0);
+    const __m128i is_false_byte_mask = _mm_cmpeq_epi8(chunk, zero_bytes);
+    return uint16_t(_mm_movemask_epi8(is_false_byte_mask));
+  }
+#endif
+};
+
 bool or_bools_into_bits(const Span<bool> bools,
                         MutableBitSpan r_bits,
                         const int64_t allowed_overshoot)
@@ -92,4 +108,11 @@ bool or_bools_into_bits(const Span<bool> bools,
   return or_bytes_into_bits(bools.cast<char>(), r_bits, allowed_overshoot, BoolToBit());
 }
 
+bool or_bools_inverse_into_bits(const Span<bool> bools,
+                                MutableBitSpan r_bits,
+                                const int64_t allowed_overshoot)
+{
+  return or_bytes_into_bits(bools.cast<char>(), r_bits, allowed_overshoot, BoolToBitInverse());
+}
+
 }  // namespace blender::bits
@@ -0,0 +1,49 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <cstdlib>
+#include <cstring>
+
+#include "BLI_cpu_dispatch.hh"
+#include "BLI_system.h"
+#include "BLI_utildefines.h"
+
+namespace blender::cpu_dispatch {
+
+static ISA detect_best_isa()
+{
+  const char *override_isa = getenv("BLENDER_CPU_DISPATCH");
+  if (override_isa && STREQ(override_isa, "baseline")) {
+    return ISA::Baseline;
+  }
+#ifdef WITH_BLI_AVX2_KERNELS
+  if (BLI_cpu_support_avx2()) {
+    return ISA::AVX2;
+  }
+#endif
+  return ISA::Baseline;
+}
+
+ISA best_isa()
+{
+  static const ISA isa = detect_best_isa();
+  return isa;
+}
+
+const char *isa_name(const ISA isa)
+{
+  switch (isa) {
+    case ISA::Baseline:
+      return "Baseline";
+    case ISA::AVX2:
+      return "AVX2";
+  }
+  return "";
+}
+
+}  // namespace blender::cpu_dispatch
@@ -93,6 +93,21 @@ std::optional<Vector<Any<>>> parse_csv_in_chunks(
     const CsvParseOptions &options,
     FunctionRef<void(const CsvRecord &record)> process_header,
     FunctionRef<Any<>(const CsvRecords &records)> process_records)
+{
+  return parse_csv_in_indexed_chunks(
+      buffer,
+      options,
+      process_header,
+      [&](const int64_t /*chunk_index*/, const CsvRecords &records) {
+        return process_records(records);
+      });
+}
+
+std::optional<Vector<Any<>>> parse_csv_in_indexed_chunks(
+    const Span<char> buffer,
+    const CsvParseOptions &options,
+    FunctionRef<void(const CsvRecord &record)> process_header,
+    FunctionRef<Any<>(int64_t chunk_index, const CsvRecords &records)> process_records)
 {
   using namespace detail;
 
@@ -139,7 +154,7 @@ std::optional<Vector<Any<>>> parse_csv_in_chunks(
         found_malformed_chunk.store(true, std::memory_order_relaxed);
         return;
       }
-      chunk_results[i] = process_records(*records);
+      chunk_results[i] = process_records(i, *records);
     }
   });
 
@@ -154,7 +169,7 @@ std::optional<Vector<Any<>>> parse_csv_in_chunks(
     if (!records.has_value()) {
       return std::nullopt;
     }
-    chunk_results.append(process_records(*records));
+    chunk_results.append(process_records(0, *records));
   }
 
   /* Prepare the return value. */
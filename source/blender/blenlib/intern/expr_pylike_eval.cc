@@ -19,19 +19,25 @@
  *      +, -, *, /, ==, !=, <, <=, >, >=, and, or, not, ternary if
  *  - Functions:
  *      min, max, radians, degrees,
- *      abs, fabs, floor, ceil, trunc, int,
+ *      abs, fabs, floor, ceil, trunc, round, int,
  *      sin, cos, tan, asin, acos, atan, atan2,
- *      exp, log, sqrt, pow, fmod
+ *      exp, log, sqrt, pow, fmod,
+ *      lerp, clamp, smoothstep
+ *  - Attribute access and integer subscripts on parameters:
+ *      x.attr, x.attr[1], x[0]
+ *    These are not evaluated here, their values are provided by the caller.
  *
  * The implementation has no global state and can be used multi-threaded.
  */
 
 #include <cctype>
 #include <cfenv>
+#include <climits>
 #include <cmath>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 #include <variant>
 
 #include "MEM_guardedalloc.h"
@@ -96,9 +102,18 @@ struct ExprOp {
   } arg;
 };
 
+struct ExprPyLikeAttribute {
+  int param_index;
+  std::string path;
+};
+
 struct ExprPyLike_Parsed {
   blender::Vector<ExprOp> ops;
   int max_stack;
+
+  /** Attribute accesses on parameters, their values follow the parameters in the value array. */
+  blender::Vector<ExprPyLikeAttribute> attributes;
+  int param_names_len;
 };
 
 /** \} */
@@ -139,6 +154,35 @@ bool BLI_expr_pylike_is_using_param(const ExprPyLike_Parsed *expr, int index)
   return false;
 }
 
+int BLI_expr_pylike_attributes_len(const ExprPyLike_Parsed *expr)
+{
+  return expr ? int(expr->attributes.size()) : 0;
+}
+
+const char *BLI_expr_pylike_attribute_get(const ExprPyLike_Parsed *expr,
+                                          int index,
+                                          int *r_param_index)
+{
+  const ExprPyLikeAttribute &attribute = expr->attributes[index];
+  *r_param_index = attribute.param_index;
+  return attribute.path.c_str();
+}
+
+bool BLI_expr_pylike_is_using_attribute_of_param(const ExprPyLike_Parsed *expr, int index)
+{
+  if (expr == nullptr) {
+    return false;
+  }
+
+  for (const ExprPyLikeAttribute &attribute : expr->attributes) {
+    if (attribute.param_index == index) {
+      return true;
+    }
+  }
+
+  return false;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -504,6 +548,9 @@ struct ExprParseState {
   /* Stack space requirement tracking */
   int stack_ptr = 0;
   int max_stack = 0;
+
+  /* Attribute accesses on parameters */
+  blender::Vector<ExprPyLikeAttribute> attributes;
 };
 
 /* Add one operation and track stack usage. */
@@ -749,6 +796,51 @@ static int parse_function_args(ExprParseState *state)
   }
 }
 
+/* Parse a chain of attribute accesses and integer subscripts following a parameter, e.g.
+ * `.location[0]`, into a single value provided by the caller. */
+static bool parse_attribute(ExprParseState *state, int param_index)
+{
+  std::string path;
+
+  while (ELEM(state->token, '.', '[')) {
+    if (state->token == '.') {
+      CHECK_ERROR(parse_next_token(state) && state->token == TOKEN_ID);
+
+      if (!path.empty()) {
+        path += '.';
+      }
+      path += state->tokenbuf.data();
+    }
+    else {
+      CHECK_ERROR(parse_next_token(state) && state->token == TOKEN_NUMBER);
+      CHECK_ERROR(state->tokenval >= 0.0 && state->tokenval == floor(state->tokenval) &&
+                  state->tokenval < double(INT_MAX));
+
+      const int subscript = int(state->tokenval);
+      CHECK_ERROR(parse_next_token(state) && state->token == ']');
+
+      path += '[' + std::to_string(subscript) + ']';
+    }
+
+    CHECK_ERROR(parse_next_token(state));
+  }
+
+  /* Share the value of identical attribute accesses. */
+  int attribute_index = 0;
+  for (; attribute_index < state->attributes.size(); attribute_index++) {
+    const ExprPyLikeAttribute &attribute = state->attributes[attribute_index];
+    if (attribute.param_index == param_index && attribute.path == path) {
+      break;
+    }
+  }
+  if (attribute_index == state->attributes.size()) {
+    state->attributes.append({param_index, std::move(path)});
+  }
+
+  parse_add_op(state, OPCODE_PARAMETER, 1)->arg.ival = state->param_names_len + attribute_index;
+  return true;
+}
+
 static bool parse_unary(ExprParseState *state)
 {
   int i;
@@ -775,8 +867,14 @@ static bool parse_unary(ExprParseState *state)
        * the last one should win. */
       for (i = state->param_names_len - 1; i >= 0; i--) {
         if (STREQ(state->tokenbuf.data(), state->param_names[i])) {
+          CHECK_ERROR(parse_next_token(state));
+
+          if (ELEM(state->token, '.', '[')) {
+            return parse_attribute(state, i);
+          }
+
           parse_add_op(state, OPCODE_PARAMETER, 1)->arg.ival = i;
-          return parse_next_token(state);
+          return true;
         }
       }
 
@@ -1051,12 +1149,14 @@ ExprPyLike_Parsed *BLI_expr_pylike_parse(const char *expression,
 
   /* Parse the expression. */
   ExprPyLike_Parsed *expr = MEM_new<ExprPyLike_Parsed>("ExprPyLike_Parsed(empty)");
+  expr->param_names_len = param_names_len;
 
   if (parse_next_token(&state) && parse_expr(&state) && state.token == 0) {
     BLI_assert(state.stack_ptr == 1);
 
     expr->max_stack = state.max_stack;
     expr->ops = std::move(state.ops);
+    expr->attributes = std::move(state.attributes);
   }
   else {
     /* Always return a non-nullptr object so that parse failure can be cached. */
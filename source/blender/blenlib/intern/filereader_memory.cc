@@ -129,3 +129,11 @@ FileReader *BLI_filereader_new_mmap(int filedes)
 
   return (FileReader *)mem;
 }
+
+BLI_mmap_file *BLI_filereader_get_mmap(FileReader *reader)
+{
+  if (reader->read != memory_read_mmap) {
+    return nullptr;
+  }
+  return ((MemoryReader *)reader)->mmap;
+}
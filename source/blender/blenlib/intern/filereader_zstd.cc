@@ -12,6 +12,8 @@
 
 #include "BLI_fileops.hh"
 #include "BLI_filereader.h"
+#include "BLI_task.hh"
+#include "BLI_threads.h"
 
 #ifdef __BIG_ENDIAN__
 #  include "BLI_endian_switch.h"
@@ -19,6 +21,12 @@
 
 #include "MEM_guardedalloc.h"
 
+/**
+ * Upper bound for the number of frames that are decompressed ahead of the read position.
+ * Frames written by Blender are 1MB each, so this also bounds the read-ahead memory usage.
+ */
+#define ZSTD_PREFETCH_FRAMES_MAX 32
+
 struct ZstdReader {
   FileReader reader;
 
@@ -33,8 +41,18 @@ struct ZstdReader {
     size_t *compressed_ofs;
     size_t *uncompressed_ofs;
 
-    char *cached_content;
+    /**
+     * Decompressed content of the frames `[cached_frame, cached_frame + cached_frames_num)`.
+     * When reading sequentially, multiple frames are decompressed in parallel so that large
+     * files are not bound by single-threaded decompression.
+     */
+    char **cached_content;
     int cached_frame;
+    int cached_frames_num;
+
+    /** Maximum number of frames decompressed at once, one decompression context per frame. */
+    int prefetch_frames_max;
+    ZSTD_DCtx **prefetch_ctx;
   } seek;
 };
 
@@ -131,6 +149,13 @@ static bool zstd_read_seek_table(ZstdReader *zstd)
   }
 
   zstd->seek.cached_frame = -1;
+  zstd->seek.prefetch_frames_max = std::clamp(
+      BLI_system_thread_count(), 1, ZSTD_PREFETCH_FRAMES_MAX);
+  zstd->seek.cached_content = MEM_calloc_arrayN<char *>(zstd->seek.prefetch_frames_max, __func__);
+  zstd->seek.prefetch_ctx = MEM_calloc_arrayN<ZSTD_DCtx *>(zstd->seek.prefetch_frames_max,
+                                                           __func__);
+  /* The first slot reuses the main context, others are created on demand. */
+  zstd->seek.prefetch_ctx[0] = zstd->ctx;
 
   return true;
 }
@@ -158,42 +183,94 @@ static int zstd_frame_from_pos(ZstdReader *zstd, size_t pos)
   return low;
 }
 
-/* Ensure that the currently loaded frame is the correct one. */
+static void zstd_free_cache(ZstdReader *zstd)
+{
+  for (int i = 0; i < zstd->seek.cached_frames_num; i++) {
+    /* When an error has occurred this may be nullptr, see: #99744. */
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
+  }
+  zstd->seek.cached_frame = -1;
+  zstd->seek.cached_frames_num = 0;
+}
+
+/* Ensure that the wanted frame is part of the currently loaded frames. */
 static const char *zstd_ensure_cache(ZstdReader *zstd, int frame)
 {
-  if (zstd->seek.cached_frame == frame) {
+  const int cached_end = zstd->seek.cached_frame + zstd->seek.cached_frames_num;
+  if (zstd->seek.cached_frame != -1 && frame >= zstd->seek.cached_frame && frame < cached_end) {
     /* Cached frame matches, so just return it. */
-    return zstd->seek.cached_content;
+    return zstd->seek.cached_content[frame - zstd->seek.cached_frame];
   }
 
-  /* Cached frame doesn't match, so discard it and cache the wanted one instead. */
-  MEM_SAFE_FREE(zstd->seek.cached_content);
+  /* Only read ahead when the file is consumed sequentially (which is the common case when
+   * reading all blocks of a file). Random access only decompresses the requested frame. */
+  const bool is_sequential = (frame == 0) || (frame == cached_end);
+  const int frames_num = is_sequential ?
+                             std::min(zstd->seek.prefetch_frames_max,
+                                      zstd->seek.frames_num - frame) :
+                             1;
 
-  size_t compressed_size = zstd->seek.compressed_ofs[frame + 1] - zstd->seek.compressed_ofs[frame];
-  size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame + 1] -
-                             zstd->seek.uncompressed_ofs[frame];
+  /* Cached frames don't match, so discard them and cache the wanted ones instead. */
+  zstd_free_cache(zstd);
 
-  char *uncompressed_data = MEM_malloc_arrayN<char>(uncompressed_size, __func__);
+  /* Frames are stored contiguously, so their compressed data can be read at once. */
+  const size_t compressed_start = zstd->seek.compressed_ofs[frame];
+  const size_t compressed_size = zstd->seek.compressed_ofs[frame + frames_num] - compressed_start;
   char *compressed_data = MEM_malloc_arrayN<char>(compressed_size, __func__);
-  if (zstd->base->seek(zstd->base, zstd->seek.compressed_ofs[frame], SEEK_SET) < 0 ||
+  if (zstd->base->seek(zstd->base, compressed_start, SEEK_SET) < 0 ||
       zstd->base->read(zstd->base, compressed_data, compressed_size) < compressed_size)
   {
     MEM_freeN(compressed_data);
-    MEM_freeN(uncompressed_data);
     return nullptr;
   }
 
-  size_t res = ZSTD_decompressDCtx(
-      zstd->ctx, uncompressed_data, uncompressed_size, compressed_data, compressed_size);
+  for (int i = 1; i < frames_num; i++) {
+    if (zstd->seek.prefetch_ctx[i] == nullptr) {
+      zstd->seek.prefetch_ctx[i] = ZSTD_createDCtx();
+    }
+  }
+
+  using namespace blender;
+  threading::parallel_for(IndexRange(frames_num), 1, [&](const IndexRange range) {
+    for (const int i : range) {
+      const int frame_i = frame + i;
+      const size_t frame_compressed_size = zstd->seek.compressed_ofs[frame_i + 1] -
+                                           zstd->seek.compressed_ofs[frame_i];
+      const size_t uncompressed_size = zstd->seek.uncompressed_ofs[frame_i + 1] -
+                                       zstd->seek.uncompressed_ofs[frame_i];
+      const char *frame_compressed_data = compressed_data + zstd->seek.compressed_ofs[frame_i] -
+                                          compressed_start;
+
+      char *uncompressed_data = MEM_malloc_arrayN<char>(uncompressed_size, __func__);
+      size_t res = ZSTD_decompressDCtx(zstd->seek.prefetch_ctx[i],
+                                       uncompressed_data,
+                                       uncompressed_size,
+                                       frame_compressed_data,
+                                       frame_compressed_size);
+      if (ZSTD_isError(res) || res < uncompressed_size) {
+        MEM_freeN(uncompressed_data);
+        uncompressed_data = nullptr;
+      }
+      zstd->seek.cached_content[i] = uncompressed_data;
+    }
+  });
   MEM_freeN(compressed_data);
-  if (ZSTD_isError(res) || res < uncompressed_size) {
-    MEM_freeN(uncompressed_data);
+
+  /* Only keep the frames up to the first one that failed to decompress. */
+  int valid_frames_num = 0;
+  while (valid_frames_num < frames_num && zstd->seek.cached_content[valid_frames_num]) {
+    valid_frames_num++;
+  }
+  for (int i = valid_frames_num; i < frames_num; i++) {
+    MEM_SAFE_FREE(zstd->seek.cached_content[i]);
+  }
+  if (valid_frames_num == 0) {
     return nullptr;
   }
 
   zstd->seek.cached_frame = frame;
-  zstd->seek.cached_content = uncompressed_data;
-  return uncompressed_data;
+  zstd->seek.cached_frames_num = valid_frames_num;
+  return zstd->seek.cached_content[0];
 }
 
 static int64_t zstd_read_seekable(FileReader *reader, void *buffer, size_t size)
@@ -286,10 +363,15 @@ static void zstd_close(FileReader *reader)
   if (zstd->reader.seek) {
     MEM_freeN(zstd->seek.uncompressed_ofs);
     MEM_freeN(zstd->seek.compressed_ofs);
-    /* When an error has occurred this may be nullptr, see: #99744. */
-    if (zstd->seek.cached_content) {
-      MEM_freeN(zstd->seek.cached_content);
+    zstd_free_cache(zstd);
+    MEM_freeN(zstd->seek.cached_content);
+    /* The first context is the main one which is freed above. */
+    for (int i = 1; i < zstd->seek.prefetch_frames_max; i++) {
+      if (zstd->seek.prefetch_ctx[i]) {
+        ZSTD_freeDCtx(zstd->seek.prefetch_ctx[i]);
+      }
     }
+    MEM_freeN(zstd->seek.prefetch_ctx);
   }
   else {
     MEM_freeN(const_cast<void *>(zstd->in_buf.src));
@@ -37,6 +37,19 @@ const ImplicitSharingInfo *info_for_mem_free(void *data)
   return MEM_new<MEMFreeImplicitSharing>(__func__, data);
 }
 
+static thread_local CopyOnWriteStats copy_on_write_stats;
+
+const CopyOnWriteStats &thread_copy_on_write_stats()
+{
+  return copy_on_write_stats;
+}
+
+void count_copy_on_write(const int64_t bytes)
+{
+  copy_on_write_stats.copies_num++;
+  copy_on_write_stats.copied_bytes += bytes;
+}
+
 namespace detail {
 
 void *make_trivial_data_mutable_impl(void *old_data,
@@ -56,6 +69,7 @@ void *make_trivial_data_mutable_impl(void *old_data,
   else {
     void *new_data = MEM_mallocN_aligned(size, alignment, __func__);
     memcpy(new_data, old_data, size);
+    count_copy_on_write(size);
     (*sharing_info)->remove_user_and_delete_if_last();
     *sharing_info = info_for_mem_free(new_data);
     return new_data;
@@ -100,6 +114,9 @@ void *resize_trivial_array_impl(void *old_data,
     }
   }
 
+  if (!(*sharing_info)->is_mutable()) {
+    count_copy_on_write(std::min(old_size, new_size));
+  }
   void *new_data = MEM_mallocN_aligned(new_size, alignment, __func__);
   memcpy(new_data, old_data, std::min(old_size, new_size));
   (*sharing_info)->remove_user_and_delete_if_last();
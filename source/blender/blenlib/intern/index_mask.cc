@@ -446,66 +446,68 @@ IndexMask IndexMask::from_indices(const Span<T> indices, IndexMaskMemory &memory
   return IndexMask::from_segments(segments, memory);
 }
 
-IndexMask IndexMask::from_bits(const BitSpan bits, IndexMaskMemory &memory)
-{
-  return IndexMask::from_bits(bits.index_range(), bits, memory);
-}
-
-static int64_t from_bits_batch_predicate(const IndexMaskSegment universe_segment,
-                                         IndexRangesBuilder<int16_t> &builder,
-                                         const BitSpan bits_slice)
+/**
+ * Generate the segments for each segment of the universe, on multiple threads if the universe is
+ * large. The resulting segments are sorted.
+ */
+static void segments_from_universe(
+    const IndexMask &universe,
+    const GrainSize grain_size,
+    IndexMaskMemory &memory,
+    const FunctionRef<void(const IndexMaskSegment &universe_segment,
+                           LinearAllocator<> &allocator,
+                           Vector<IndexMaskSegment, 16> &r_segments)> fn,
+    Vector<IndexMaskSegment, 16> &r_segments)
 {
-  const int64_t segment_start = universe_segment[0];
-  if (unique_sorted_indices::non_empty_is_range(universe_segment.base_span())) {
-    bits::bits_to_index_ranges<int16_t>(bits_slice, builder);
+  if (universe.size() <= grain_size.value) {
+    for (const int64_t segment_i : IndexRange(universe.segments_num())) {
+      fn(universe.segment(segment_i), memory, r_segments);
+    }
   }
   else {
-    /* If the universe is not a range, we need to create a new bit span first. In it, bits
-     * that are not part of the universe are set to 0. */
-    const int64_t segment_end = universe_segment.last() + 1;
-    BitVector<max_segment_size> local_bits(segment_end - segment_start, false);
-    for (const int64_t i : universe_segment.index_range()) {
-      const int64_t global_index = universe_segment[i];
-      const int64_t local_index = global_index - segment_start;
-      BLI_assert(local_index < max_segment_size);
-      /* It's not great to handle each index separately instead of working with bigger
-       * chunks, but that works well enough for now. */
-      if (bits_slice[local_index]) {
-        local_bits[local_index].set();
-      }
-    }
-    bits::bits_to_index_ranges<int16_t>(local_bits, builder);
+    ParallelSegmentsCollector segments_collector;
+    universe.foreach_segment(grain_size, [&](const IndexMaskSegment universe_segment) {
+      ParallelSegmentsCollector::LocalData &data = segments_collector.data_by_thread.local();
+      fn(universe_segment, data.allocator, data.segments);
+    });
+    segments_collector.reduce(memory, r_segments);
   }
-  return segment_start;
 }
 
-IndexMask IndexMask::from_bits(const IndexMask &universe,
-                               const BitSpan bits,
-                               IndexMaskMemory &memory)
+/**
+ * Append segments for sorted indices which are smaller than #max_segment_size and are relative to
+ * #offset. Consecutive indices are referenced as ranges of the static indices array.
+ */
+static void segments_from_true_indices(const int64_t offset,
+                                       const Span<int16_t> true_indices,
+                                       LinearAllocator<> &allocator,
+                                       Vector<IndexMaskSegment, 16> &r_segments)
 {
-  BLI_assert(bits.size() >= universe.min_array_size());
-  /* Use #from_batch_predicate because we can process many bits at once. */
-  return IndexMask::from_batch_predicate(
-      universe,
-      GrainSize(max_segment_size),
-      memory,
-      [&](const IndexMaskSegment universe_segment, IndexRangesBuilder<int16_t> &builder) {
-        const IndexRange slice = IndexRange::from_begin_end_inclusive(universe_segment[0],
-                                                                      universe_segment.last());
-        return from_bits_batch_predicate(universe_segment, builder, bits.slice(slice));
-      });
+  Vector<std::variant<IndexRange, Span<int16_t>>> true_segments;
+  unique_sorted_indices::split_to_ranges_and_spans<int16_t>(true_indices, 64, true_segments);
+
+  const Span<int16_t> static_indices = get_static_indices_array();
+
+  for (const auto &true_segment : true_segments) {
+    if (std::holds_alternative<IndexRange>(true_segment)) {
+      const IndexRange segment_range = std::get<IndexRange>(true_segment);
+      r_segments.append_as(offset, static_indices.slice(segment_range));
+    }
+    else {
+      const Span<int16_t> segment_indices = std::get<Span<int16_t>>(true_segment);
+      r_segments.append_as(offset, allocator.construct_array_copy(segment_indices));
+    }
+  }
 }
 
-static void segments_from_batch_predicate(
-    const IndexMaskSegment universe_segment,
-    LinearAllocator<> &allocator,
-    const FunctionRef<int64_t(const IndexMaskSegment &universe_segment,
-                              IndexRangesBuilder<int16_t> &builder)> batch_predicate,
-    Vector<IndexMaskSegment, 16> &r_segments)
+/**
+ * Append segments for the index ranges in #builder, which are relative to #offset.
+ */
+static void segments_from_index_ranges(const int64_t offset,
+                                       const IndexRangesBuilder<int16_t> &builder,
+                                       LinearAllocator<> &allocator,
+                                       Vector<IndexMaskSegment, 16> &r_segments)
 {
-  IndexRangesBuilderBuffer<int16_t, max_segment_size> builder_buffer;
-  IndexRangesBuilder<int16_t> builder{builder_buffer};
-  const int64_t segment_shift = batch_predicate(universe_segment, builder);
   if (builder.is_empty()) {
     return;
   }
@@ -532,14 +534,14 @@ static void segments_from_batch_predicate(
       array_utils::fill_index_range(indices.slice(counter, range.size()), int16_t(range.first()));
       counter += range.size();
     }
-    r_segments.append(IndexMaskSegment{segment_shift, indices});
+    r_segments.append(IndexMaskSegment{offset, indices});
   };
 
   for (const int64_t i : builder.index_range()) {
     const IndexRange range = builder[i];
     if (range.size() > threshold || builder.size() == 1) {
       consolidate_skipped_ranges(i);
-      r_segments.append(IndexMaskSegment{segment_shift, static_indices.slice(range)});
+      r_segments.append(IndexMaskSegment{offset, static_indices.slice(range)});
       next_range_to_process = i + 1;
       skipped_indices_num = 0;
     }
@@ -550,6 +552,122 @@ static void segments_from_batch_predicate(
   consolidate_skipped_ranges(builder.size());
 }
 
+/**
+ * Copy the bits of the indices in the universe segment, so that bits of other indices are not
+ * set. The bits start at the first index of the universe segment.
+ */
+static void copy_universe_segment_bits(const IndexMaskSegment universe_segment,
+                                       const BitSpan bits,
+                                       MutableBitSpan r_bits)
+{
+  const int64_t segment_start = universe_segment[0];
+  for (const int64_t index : universe_segment) {
+    const int64_t local_index = index - segment_start;
+    BLI_assert(local_index < max_segment_size);
+    if (bits[local_index]) {
+      r_bits[local_index].set();
+    }
+  }
+}
+
+/**
+ * Append segments for the set bits, which correspond to the indices starting at #segment_start.
+ */
+static void segments_from_bits(const int64_t segment_start,
+                               const BitSpan bits,
+                               LinearAllocator<> &allocator,
+                               Vector<IndexMaskSegment, 16> &r_segments)
+{
+  auto append_ranges = [&]() {
+    IndexRangesBuilderBuffer<int16_t, max_segment_size> builder_buffer;
+    IndexRangesBuilder<int16_t> builder{builder_buffer};
+    bits::bits_to_index_ranges<int16_t>(bits, builder);
+    segments_from_index_ranges(segment_start, builder, allocator, r_segments);
+  };
+  if ((bits.bit_range().start() & int64_t(bits::BitIndexMask)) != 0) {
+    /* The integer-wise analysis below needs bits that start at an integer boundary. */
+    append_ranges();
+    return;
+  }
+
+  const bits::BitInt *bit_ints = bits::int_containing_bit(bits.data(), bits.bit_range().start());
+  const int64_t ints_num = ceil_division<int64_t>(bits.size(), bits::BitsPerInt);
+  /* Bits after the end of the span may be set, e.g. by #bits::or_bools_into_bits. */
+  const bits::BitInt last_int_mask = bits::mask_first_n_bits(
+      bits.size() - (ints_num - 1) * bits::BitsPerInt);
+  auto get_int = [&](const int64_t i) {
+    return i == ints_num - 1 ? bit_ints[i] & last_int_mask : bit_ints[i];
+  };
+
+  int64_t set_bits_num = 0;
+  int64_t ranges_num = 0;
+  bits::BitInt previous_last_bit = 0;
+  for (const int64_t i : IndexRange(ints_num)) {
+    const bits::BitInt value = get_int(i);
+    set_bits_num += count_bits_uint64(value);
+    /* Count the set bits whose previous bit is not set. */
+    ranges_num += count_bits_uint64(value & ~((value << 1) | previous_last_bit));
+    previous_last_bit = value >> (bits::BitsPerInt - 1);
+  }
+  if (set_bits_num == 0) {
+    return;
+  }
+  /* Finding and storing many short ranges is slower than extracting the indices directly. */
+  if (ranges_num * 4 <= set_bits_num) {
+    append_ranges();
+    return;
+  }
+
+  std::array<int16_t, max_segment_size> indices_array;
+  int16_t *indices = indices_array.data();
+  int64_t indices_num = 0;
+  for (const int64_t i : IndexRange(ints_num)) {
+    bits::BitInt value = get_int(i);
+    while (value != 0) {
+      indices[indices_num++] = int16_t(i * bits::BitsPerInt + bitscan_forward_uint64(value));
+      /* Clear the lowest set bit. */
+      value &= value - 1;
+    }
+  }
+  segments_from_true_indices(segment_start, Span(indices, indices_num), allocator, r_segments);
+}
+
+IndexMask IndexMask::from_bits(const BitSpan bits, IndexMaskMemory &memory)
+{
+  return IndexMask::from_bits(bits.index_range(), bits, memory);
+}
+
+IndexMask IndexMask::from_bits(const IndexMask &universe,
+                               const BitSpan bits,
+                               IndexMaskMemory &memory)
+{
+  BLI_assert(bits.size() >= universe.min_array_size());
+  if (universe.is_empty()) {
+    return {};
+  }
+  Vector<IndexMaskSegment, 16> segments;
+  segments_from_universe(
+      universe,
+      GrainSize(max_segment_size),
+      memory,
+      [&](const IndexMaskSegment universe_segment,
+          LinearAllocator<> &allocator,
+          Vector<IndexMaskSegment, 16> &r_segments) {
+        const IndexRange slice = IndexRange::from_begin_end_inclusive(universe_segment[0],
+                                                                      universe_segment.last());
+        const BitSpan bits_slice = bits.slice(slice);
+        if (unique_sorted_indices::non_empty_is_range(universe_segment.base_span())) {
+          segments_from_bits(slice.start(), bits_slice, allocator, r_segments);
+          return;
+        }
+        BitVector<max_segment_size> local_bits(slice.size(), false);
+        copy_universe_segment_bits(universe_segment, bits_slice, local_bits);
+        segments_from_bits(slice.start(), local_bits, allocator, r_segments);
+      },
+      segments);
+  return IndexMask::from_segments(segments, memory);
+}
+
 IndexMask IndexMask::from_batch_predicate(
     const IndexMask &universe,
     GrainSize grain_size,
@@ -560,24 +678,20 @@ IndexMask IndexMask::from_batch_predicate(
   if (universe.is_empty()) {
     return {};
   }
-
   Vector<IndexMaskSegment, 16> segments;
-  if (universe.size() <= grain_size.value) {
-    for (const int64_t segment_i : IndexRange(universe.segments_num())) {
-      const IndexMaskSegment universe_segment = universe.segment(segment_i);
-      segments_from_batch_predicate(universe_segment, memory, batch_predicate, segments);
-    }
-  }
-  else {
-    ParallelSegmentsCollector segments_collector;
-    universe.foreach_segment(grain_size, [&](const IndexMaskSegment universe_segment) {
-      ParallelSegmentsCollector::LocalData &data = segments_collector.data_by_thread.local();
-      segments_from_batch_predicate(
-          universe_segment, data.allocator, batch_predicate, data.segments);
-    });
-    segments_collector.reduce(memory, segments);
-  }
-
+  segments_from_universe(
+      universe,
+      grain_size,
+      memory,
+      [&](const IndexMaskSegment universe_segment,
+          LinearAllocator<> &allocator,
+          Vector<IndexMaskSegment, 16> &r_segments) {
+        IndexRangesBuilderBuffer<int16_t, max_segment_size> builder_buffer;
+        IndexRangesBuilder<int16_t> builder{builder_buffer};
+        const int64_t segment_shift = batch_predicate(universe_segment, builder);
+        segments_from_index_ranges(segment_shift, builder, allocator, r_segments);
+      },
+      segments);
   return IndexMask::from_segments(segments, memory);
 }
 
@@ -596,42 +710,89 @@ IndexMask IndexMask::from_bools_inverse(const VArray<bool> &bools, IndexMaskMemo
   return IndexMask::from_bools_inverse(bools.index_range(), bools, memory);
 }
 
-IndexMask IndexMask::from_bools(const IndexMask &universe,
-                                Span<bool> bools,
-                                IndexMaskMemory &memory)
+/**
+ * Converts the bools to bits a chunk at a time, for each universe segment separately. Virtual
+ * arrays are materialized a segment at a time, which avoids a virtual function call per index.
+ */
+static IndexMask from_bools_impl(const IndexMask &universe,
+                                 const Span<bool> bools_span,
+                                 const VArray<bool> *bools_varray,
+                                 IndexMaskMemory &memory,
+                                 const bool inverse)
 {
-  BLI_assert(bools.size() >= universe.min_array_size());
-  return IndexMask::from_batch_predicate(
+  if (universe.is_empty()) {
+    return {};
+  }
+  Vector<IndexMaskSegment, 16> segments;
+  segments_from_universe(
       universe,
       GrainSize(max_segment_size),
       memory,
       [&](const IndexMaskSegment universe_segment,
-          IndexRangesBuilder<int16_t> &builder) -> int64_t {
+          LinearAllocator<> &allocator,
+          Vector<IndexMaskSegment, 16> &r_segments) {
         const IndexRange slice = IndexRange::from_begin_end_inclusive(universe_segment[0],
                                                                       universe_segment.last());
+        Span<bool> bools;
+        /* How many bools can be read after the end of the slice. */
+        int64_t allowed_overshoot = 0;
+        std::array<bool, max_segment_size> bools_buffer;
+        if (bools_varray) {
+          const MutableSpan<bool> local_bools(bools_buffer.data(), slice.size());
+          if (unique_sorted_indices::non_empty_is_range(universe_segment.base_span())) {
+            bools_varray->materialize_compressed_to_uninitialized(slice, local_bools);
+          }
+          else {
+            /* The values of indices that are not in the universe are ignored, but they must not
+             * be uninitialized. */
+            local_bools.fill(false);
+            for (const int64_t index : universe_segment) {
+              local_bools[index - slice.start()] = (*bools_varray)[index];
+            }
+          }
+          bools = local_bools;
+        }
+        else {
+          bools = bools_span.slice(slice);
+          allowed_overshoot = bools_span.size() - slice.one_after_last();
+        }
+
         /* +16 to allow for some overshoot when converting bools to bits. */
         BitVector<max_segment_size + 16> bits;
         bits.resize(slice.size(), false);
-        const int64_t allowed_overshoot = std::min<int64_t>(bits.capacity() - slice.size(),
-                                                            bools.size() - slice.one_after_last());
-        const bool any_true = bits::or_bools_into_bits(
-            bools.slice(slice), bits, allowed_overshoot);
-        if (!any_true) {
-          return 0;
+        allowed_overshoot = std::min<int64_t>(bits.capacity() - slice.size(), allowed_overshoot);
+        const bool any_set = inverse ?
+                                 bits::or_bools_inverse_into_bits(bools, bits, allowed_overshoot) :
+                                 bits::or_bools_into_bits(bools, bits, allowed_overshoot);
+        if (!any_set) {
+          return;
         }
-        return from_bits_batch_predicate(universe_segment, builder, bits);
-      });
-  BitVector bits(bools);
-  return IndexMask::from_bits(universe, bits, memory);
+        if (unique_sorted_indices::non_empty_is_range(universe_segment.base_span())) {
+          segments_from_bits(slice.start(), bits, allocator, r_segments);
+          return;
+        }
+        BitVector<max_segment_size> universe_bits(slice.size(), false);
+        copy_universe_segment_bits(universe_segment, bits, universe_bits);
+        segments_from_bits(slice.start(), universe_bits, allocator, r_segments);
+      },
+      segments);
+  return IndexMask::from_segments(segments, memory);
+}
+
+IndexMask IndexMask::from_bools(const IndexMask &universe,
+                                Span<bool> bools,
+                                IndexMaskMemory &memory)
+{
+  BLI_assert(bools.size() >= universe.min_array_size());
+  return from_bools_impl(universe, bools, nullptr, memory, false);
 }
 
 IndexMask IndexMask::from_bools_inverse(const IndexMask &universe,
                                         Span<bool> bools,
                                         IndexMaskMemory &memory)
 {
-  BitVector bits(bools);
-  bits::invert(bits);
-  return IndexMask::from_bits(universe, bits, memory);
+  BLI_assert(bools.size() >= universe.min_array_size());
+  return from_bools_impl(universe, bools, nullptr, memory, true);
 }
 
 IndexMask IndexMask::from_bools(const IndexMask &universe,
@@ -646,8 +807,7 @@ IndexMask IndexMask::from_bools(const IndexMask &universe,
     const Span<bool> span(static_cast<const bool *>(info.data), bools.size());
     return IndexMask::from_bools(universe, span, memory);
   }
-  return IndexMask::from_predicate(
-      universe, GrainSize(512), memory, [&](const int64_t index) { return bools[index]; });
+  return from_bools_impl(universe, {}, &bools, memory, false);
 }
 
 IndexMask IndexMask::from_bools_inverse(const IndexMask &universe,
@@ -662,8 +822,7 @@ IndexMask IndexMask::from_bools_inverse(const IndexMask &universe,
     const Span<bool> span(static_cast<const bool *>(info.data), bools.size());
     return IndexMask::from_bools_inverse(universe, span, memory);
   }
-  return IndexMask::from_predicate(
-      universe, GrainSize(512), memory, [&](const int64_t index) { return !bools[index]; });
+  return from_bools_impl(universe, {}, &bools, memory, true);
 }
 
 template<typename T>
@@ -818,23 +977,10 @@ static void segments_from_predicate_filter(
   if (true_indices_num == 0) {
     return;
   }
-  const Span<int16_t> true_indices{indices_array.data(), true_indices_num};
-  Vector<std::variant<IndexRange, Span<int16_t>>> true_segments;
-  unique_sorted_indices::split_to_ranges_and_spans<int16_t>(true_indices, 64, true_segments);
-
-  const Span<int16_t> static_indices = get_static_indices_array();
-
-  for (const auto &true_segment : true_segments) {
-    if (std::holds_alternative<IndexRange>(true_segment)) {
-      const IndexRange segment_range = std::get<IndexRange>(true_segment);
-      r_segments.append_as(universe_segment.offset(), static_indices.slice(segment_range));
-    }
-    else {
-      const Span<int16_t> segment_indices = std::get<Span<int16_t>>(true_segment);
-      r_segments.append_as(universe_segment.offset(),
-                           allocator.construct_array_copy(segment_indices));
-    }
-  }
+  segments_from_true_indices(universe_segment.offset(),
+                             Span(indices_array.data(), true_indices_num),
+                             allocator,
+                             r_segments);
 }
 
 IndexMask from_predicate_impl(
@@ -848,21 +994,16 @@ IndexMask from_predicate_impl(
   }
 
   Vector<IndexMaskSegment, 16> segments;
-  if (universe.size() <= grain_size.value) {
-    for (const int64_t segment_i : IndexRange(universe.segments_num())) {
-      const IndexMaskSegment universe_segment = universe.segment(segment_i);
-      segments_from_predicate_filter(universe_segment, memory, filter_indices, segments);
-    }
-  }
-  else {
-    ParallelSegmentsCollector segments_collector;
-    universe.foreach_segment(grain_size, [&](const IndexMaskSegment universe_segment) {
-      ParallelSegmentsCollector::LocalData &data = segments_collector.data_by_thread.local();
-      segments_from_predicate_filter(
-          universe_segment, data.allocator, filter_indices, data.segments);
-    });
-    segments_collector.reduce(memory, segments);
-  }
+  segments_from_universe(
+      universe,
+      grain_size,
+      memory,
+      [&](const IndexMaskSegment universe_segment,
+          LinearAllocator<> &allocator,
+          Vector<IndexMaskSegment, 16> &r_segments) {
+        segments_from_predicate_filter(universe_segment, allocator, filter_indices, r_segments);
+      },
+      segments);
 
   const int64_t consolidated_segments_num = consolidate_index_mask_segments(segments, memory);
   segments.resize(consolidated_segments_num);
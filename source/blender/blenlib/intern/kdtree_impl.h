@@ -9,7 +9,10 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_kdtree_impl.h"
+#include "BLI_array.hh"
 #include "BLI_math_base.h"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
 
@@ -56,6 +59,16 @@ struct KDTree {
 
 #define KD_NODE_UNSET ((uint)-1)
 
+/**
+ * Sub-trees with more nodes than this are balanced in parallel.
+ * Smaller ones are not worth the overhead of a task.
+ */
+#define KD_BALANCE_PARALLEL_THRESHOLD 4096
+/** Number of queries processed by a task in the batched search functions. */
+#define KD_BATCH_GRAIN_SIZE 256
+/** Batches with fewer queries are not reordered, sorting them is not worth it. */
+#define KD_BATCH_SORT_THRESHOLD 1024
+
 /**
  * When set we know all values are unbalanced,
  * otherwise clear them when re-balancing: see #62210.
@@ -194,9 +207,23 @@ static uint kdtree_balance(KDTreeNode *nodes, uint nodes_len, uint axis, const u
   node = &nodes[median];
   node->d = axis;
   axis = (axis + 1) % KD_DIMS;
-  node->left = kdtree_balance(nodes, median, axis, ofs);
-  node->right = kdtree_balance(
-      nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+  if (nodes_len > KD_BALANCE_PARALLEL_THRESHOLD) {
+    /* Both halves are independent, the sub-trees only touch their own nodes. */
+    uint node_left, node_right;
+    blender::threading::parallel_invoke(
+        [&]() { node_left = kdtree_balance(nodes, median, axis, ofs); },
+        [&]() {
+          node_right = kdtree_balance(
+              nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+        });
+    node->left = node_left;
+    node->right = node_right;
+  }
+  else {
+    node->left = kdtree_balance(nodes, median, axis, ofs);
+    node->right = kdtree_balance(
+        nodes + median + 1, (nodes_len - (median + 1)), axis, (median + 1) + ofs);
+  }
 
   return median + ofs;
 }
@@ -596,6 +623,125 @@ int BLI_kdtree_nd_(find_nearest_n)(const KDTree *tree,
       tree, co, r_nearest, nearest_len_capacity, nullptr, nullptr);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Batched Search
+ *
+ * Many queries are processed in parallel. Large batches are processed in Morton order (along a
+ * Z-order curve), so that queries handled one after another by a thread visit mostly the same
+ * tree nodes, which are then still in the cache.
+ * \{ */
+
+/**
+ * Spread the lower bits of \a value so that there are `KD_DIMS - 1` zero bits between them.
+ */
+static uint64_t kdtree_morton_spread(const uint64_t value, const uint bits_num)
+{
+  uint64_t result = 0;
+  for (uint bit = 0; bit < bits_num; bit++) {
+    result |= ((value >> bit) & 1) << (bit * KD_DIMS);
+  }
+  return result;
+}
+
+/**
+ * Compute the order in which the queries are processed, sorted by their position along a
+ * Z-order curve through the bounding box of all queries.
+ */
+static void kdtree_batch_order(const float (*co)[KD_DIMS],
+                               const uint co_len,
+                               blender::MutableSpan<uint> r_order)
+{
+  using namespace blender;
+  float min[KD_DIMS], max[KD_DIMS];
+  for (uint j = 0; j < KD_DIMS; j++) {
+    min[j] = FLT_MAX;
+    max[j] = -FLT_MAX;
+  }
+  for (uint i = 0; i < co_len; i++) {
+    for (uint j = 0; j < KD_DIMS; j++) {
+      /* Written so that NaN coordinates are ignored. */
+      if (co[i][j] < min[j]) {
+        min[j] = co[i][j];
+      }
+      if (co[i][j] > max[j]) {
+        max[j] = co[i][j];
+      }
+    }
+  }
+
+  const uint bits_num = std::min<uint>(63 / KD_DIMS, 21);
+  const float cells_num = float((uint64_t(1) << bits_num) - 1);
+  float scale[KD_DIMS];
+  for (uint j = 0; j < KD_DIMS; j++) {
+    const float size = max[j] - min[j];
+    scale[j] = (size > 0.0f && std::isfinite(size)) ? cells_num / size : 0.0f;
+  }
+
+  Array<std::pair<uint64_t, uint>> codes(co_len);
+  threading::parallel_for(IndexRange(co_len), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      uint64_t code = 0;
+      for (uint j = 0; j < KD_DIMS; j++) {
+        const float cell = std::clamp((co[i][j] - min[j]) * scale[j], 0.0f, cells_num);
+        /* The negated comparison maps NaN to the first cell. */
+        const uint64_t cell_int = !(cell >= 0.0f) ? 0 : uint64_t(cell);
+        code |= kdtree_morton_spread(cell_int, bits_num) << j;
+      }
+      codes[i] = {code, uint(i)};
+    }
+  });
+  parallel_sort(codes.begin(), codes.end(), [](const auto &a, const auto &b) {
+    return a.first < b.first;
+  });
+
+  for (uint i = 0; i < co_len; i++) {
+    r_order[i] = codes[i].second;
+  }
+}
+
+template<typename Fn>
+static void kdtree_batch_foreach(const float (*co)[KD_DIMS], const uint co_len, const Fn &fn)
+{
+  using namespace blender;
+  Array<uint, 0> order;
+  if (co_len >= KD_BATCH_SORT_THRESHOLD) {
+    order.reinitialize(co_len);
+    kdtree_batch_order(co, co_len, order);
+  }
+  threading::parallel_for(IndexRange(co_len), KD_BATCH_GRAIN_SIZE, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      fn(order.is_empty() ? uint(i) : order[i]);
+    }
+  });
+}
+
+void BLI_kdtree_nd_(find_nearest_batch)(const KDTree *tree,
+                                        const float (*co)[KD_DIMS],
+                                        const uint co_len,
+                                        KDTreeNearest *r_nearest)
+{
+  kdtree_batch_foreach(co, co_len, [&](const uint i) {
+    if (BLI_kdtree_nd_(find_nearest)(tree, co[i], &r_nearest[i]) == -1) {
+      r_nearest[i].index = -1;
+    }
+  });
+}
+
+void BLI_kdtree_nd_(find_nearest_n_batch)(const KDTree *tree,
+                                          const float (*co)[KD_DIMS],
+                                          const uint co_len,
+                                          KDTreeNearest *r_nearest,
+                                          const uint nearest_len_capacity,
+                                          int *r_nearest_len)
+{
+  kdtree_batch_foreach(co, co_len, [&](const uint i) {
+    r_nearest_len[i] = BLI_kdtree_nd_(find_nearest_n)(
+        tree, co[i], &r_nearest[size_t(i) * nearest_len_capacity], nearest_len_capacity);
+  });
+}
+
+/** \} */
+
 static int nearest_cmp_dist(const void *a, const void *b)
 {
   const KDTreeNearest *kda = static_cast<const KDTreeNearest *>(a);
@@ -0,0 +1,72 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_cpu_dispatch.hh"
+#include "BLI_math_matrix_batch.hh"
+
+#define BLI_CPU_KERNEL_NAMESPACE baseline
+#include "math_matrix_batch_kernels.hh"
+#undef BLI_CPU_KERNEL_NAMESPACE
+
+namespace blender::math {
+
+#ifdef WITH_BLI_AVX2_KERNELS
+namespace avx2 {
+/* Defined in `math_matrix_batch_avx2.cc`. */
+void transform_points_kernel(const float *matrix, const float *src, float *dst, int64_t size);
+void transform_points_in_place_kernel(const float *matrix, float *points, int64_t size);
+void transform_directions_kernel(const float *matrix, float *vectors, int64_t size);
+}  // namespace avx2
+#endif
+
+struct MatrixBatchKernels {
+  void (*transform_points)(const float *matrix, const float *src, float *dst, int64_t size);
+  void (*transform_points_in_place)(const float *matrix, float *points, int64_t size);
+  void (*transform_directions)(const float *matrix, float *vectors, int64_t size);
+};
+
+static const MatrixBatchKernels &get_kernels()
+{
+  static const MatrixBatchKernels kernels = []() -> MatrixBatchKernels {
+#ifdef WITH_BLI_AVX2_KERNELS
+    if (cpu_dispatch::best_isa() == cpu_dispatch::ISA::AVX2) {
+      return {avx2::transform_points_kernel,
+              avx2::transform_points_in_place_kernel,
+              avx2::transform_directions_kernel};
+    }
+#endif
+    return {baseline::transform_points_kernel,
+            baseline::transform_points_in_place_kernel,
+            baseline::transform_directions_kernel};
+  }();
+  return kernels;
+}
+
+void transform_points(const float4x4 &transform, MutableSpan<float3> points)
+{
+  get_kernels().transform_points_in_place(transform.base_ptr(), &points.data()->x, points.size());
+}
+
+void transform_points(const Span<float3> src, const float4x4 &transform, MutableSpan<float3> dst)
+{
+  BLI_assert(src.size() == dst.size());
+  if (src.data() == dst.data()) {
+    transform_points(transform, dst);
+    return;
+  }
+  get_kernels().transform_points(
+      transform.base_ptr(), &src.data()->x, &dst.data()->x, src.size());
+}
+
+void transform_directions(const float3x3 &transform, MutableSpan<float3> directions)
+{
+  get_kernels().transform_directions(
+      transform.base_ptr(), &directions.data()->x, directions.size());
+}
+
+}  // namespace blender::math
@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Kernels of #BLI_math_matrix_batch.hh. This file is included once per instruction set with
+ * `BLI_CPU_KERNEL_NAMESPACE` defined, so it must not use functions from other headers, see
+ * #BLI_cpu_dispatch.hh. The loops are simple enough for the compiler to vectorize them.
+ */
+
+#include <cstdint>
+
+#ifndef BLI_CPU_KERNEL_NAMESPACE
+#  error "Define the namespace of the instruction set before including the kernels"
+#endif
+
+namespace blender::math::BLI_CPU_KERNEL_NAMESPACE {
+
+/**
+ * \param matrix: Column major 4x4 matrix.
+ * \param src, dst: Packed 3D vectors that don't overlap.
+ */
+void transform_points_kernel(const float *matrix,
+                             const float *__restrict src,
+                             float *__restrict dst,
+                             const int64_t size)
+{
+  const float m00 = matrix[0], m01 = matrix[1], m02 = matrix[2];
+  const float m10 = matrix[4], m11 = matrix[5], m12 = matrix[6];
+  const float m20 = matrix[8], m21 = matrix[9], m22 = matrix[10];
+  const float m30 = matrix[12], m31 = matrix[13], m32 = matrix[14];
+  for (int64_t i = 0; i < size; i++) {
+    const float x = src[i * 3 + 0];
+    const float y = src[i * 3 + 1];
+    const float z = src[i * 3 + 2];
+    dst[i * 3 + 0] = m00 * x + m10 * y + m20 * z + m30;
+    dst[i * 3 + 1] = m01 * x + m11 * y + m21 * z + m31;
+    dst[i * 3 + 2] = m02 * x + m12 * y + m22 * z + m32;
+  }
+}
+
+/**
+ * \param matrix: Column major 4x4 matrix.
+ * \param points: Packed 3D vectors that are transformed in place.
+ */
+void transform_points_in_place_kernel(const float *matrix, float *points, const int64_t size)
+{
+  const float m00 = matrix[0], m01 = matrix[1], m02 = matrix[2];
+  const float m10 = matrix[4], m11 = matrix[5], m12 = matrix[6];
+  const float m20 = matrix[8], m21 = matrix[9], m22 = matrix[10];
+  const float m30 = matrix[12], m31 = matrix[13], m32 = matrix[14];
+  for (int64_t i = 0; i < size; i++) {
+    const float x = points[i * 3 + 0];
+    const float y = points[i * 3 + 1];
+    const float z = points[i * 3 + 2];
+    points[i * 3 + 0] = m00 * x + m10 * y + m20 * z + m30;
+    points[i * 3 + 1] = m01 * x + m11 * y + m21 * z + m31;
+    points[i * 3 + 2] = m02 * x + m12 * y + m22 * z + m32;
+  }
+}
+
+/**
+ * \param matrix: Column major 3x3 matrix.
+ * \param vectors: Packed 3D vectors that are transformed in place.
+ */
+void transform_directions_kernel(const float *matrix, float *vectors, const int64_t size)
+{
+  const float m00 = matrix[0], m01 = matrix[1], m02 = matrix[2];
+  const float m10 = matrix[3], m11 = matrix[4], m12 = matrix[5];
+  const float m20 = matrix[6], m21 = matrix[7], m22 = matrix[8];
+  for (int64_t i = 0; i < size; i++) {
+    const float x = vectors[i * 3 + 0];
+    const float y = vectors[i * 3 + 1];
+    const float z = vectors[i * 3 + 2];
+    vectors[i * 3 + 0] = m00 * x + m10 * y + m20 * z;
+    vectors[i * 3 + 1] = m01 * x + m11 * y + m21 * z;
+    vectors[i * 3 + 2] = m02 * x + m12 * y + m22 * z;
+  }
+}
+
+}  // namespace blender::math::BLI_CPU_KERNEL_NAMESPACE
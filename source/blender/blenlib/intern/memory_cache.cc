@@ -7,15 +7,34 @@
  */
 
 #include <atomic>
+#include <chrono>
 #include <optional>
 
 #include "BLI_concurrent_map.hh"
+#include "BLI_map.hh"
 #include "BLI_memory_cache.hh"
 #include "BLI_memory_counter.hh"
 #include "BLI_mutex.hh"
 
 namespace blender::memory_cache {
 
+struct Category {
+  std::string name;
+  /** Values of this category are freed when they use more memory than this. */
+  std::optional<int64_t> limit;
+  /** Memory used by values of this category. Protected by the global mutex. */
+  MemoryCount memory;
+  /** Protected by the global mutex. */
+  int64_t values_num = 0;
+  /** Memory reported by an external cache. Protected by the global mutex. */
+  int64_t external_size_in_bytes = 0;
+  bool is_external = false;
+
+  std::atomic<int64_t> hits = 0;
+  std::atomic<int64_t> misses = 0;
+  std::atomic<int64_t> evictions = 0;
+};
+
 struct StoredValue {
   /**
    * The corresponding key. It's stored here, because only a reference to it is used as key in the
@@ -26,8 +45,20 @@ struct StoredValue {
   std::shared_ptr<const GenericKey> key;
   /** The user-provided value. */
   std::shared_ptr<CachedValue> value;
+  /** Category of the value. Categories are never freed, so the pointer stays valid. */
+  Category *category = nullptr;
   /** A logical time that indicates when the value was last used. Lower values are older. */
   int64_t last_use_time = 0;
+  /**
+   * Time it took to compute the value relative to its size, in nanoseconds per KiB. Values that
+   * are cheap to recompute relative to the memory they use are freed first.
+   */
+  int64_t cost_density = 0;
+  /**
+   * The value with the lowest priority is freed first. It's set to the current inflation of the
+   * cache plus the cost density when the value is used.
+   */
+  int64_t priority = 0;
 };
 
 using CacheMap = ConcurrentMap<std::reference_wrapper<const GenericKey>, StoredValue>;
@@ -42,6 +73,16 @@ struct Cache {
    * not locked.
    */
   std::atomic<int64_t> size_in_bytes = 0;
+  /** Sum of the memory reported by all external caches. */
+  std::atomic<int64_t> external_size_in_bytes = 0;
+  /**
+   * Increases to the priority of the last freed value whenever values are freed. Values that are
+   * used afterwards get a higher priority than all values that have not been used since, which
+   * makes sure that values that are expensive to compute are still freed eventually.
+   */
+  std::atomic<int64_t> inflation = 0;
+  /** True when some category uses more memory than its own limit. */
+  std::atomic<bool> category_over_limit = false;
 
   Mutex global_mutex;
   /** Amount of memory currently used in the cache. */
@@ -51,6 +92,8 @@ struct Cache {
    * thread-safe iteration.
    */
   Vector<const GenericKey *> keys;
+  /** All categories that have been used so far. They are never removed. */
+  Map<std::string, std::unique_ptr<Category>> categories;
 };
 
 static Cache &get_cache()
@@ -61,16 +104,41 @@ static Cache &get_cache()
 
 static void try_enforce_limit();
 
-static void set_new_logical_time(const StoredValue &stored_value, const int64_t new_time)
+/** The global mutex has to be locked. */
+static Category &ensure_category(Cache &cache, const StringRef name)
+{
+  return *cache.categories.lookup_or_add_cb_as(name, [&]() {
+    auto category = std::make_unique<Category>();
+    category->name = name;
+    return category;
+  });
+}
+
+static void set_relaxed(const int64_t &value, const int64_t new_value)
 {
   /* Don't want to use `std::atomic` directly in the struct, because that makes it
    * non-movable. Could also use a non-const accessor, but that may degrade performance more.
    * It's not necessary for correctness that the time is exactly the right value. */
-  reinterpret_cast<std::atomic<int64_t> *>(const_cast<int64_t *>(&stored_value.last_use_time))
-      ->store(new_time, std::memory_order_relaxed);
+  reinterpret_cast<std::atomic<int64_t> *>(const_cast<int64_t *>(&value))
+      ->store(new_value, std::memory_order_relaxed);
   static_assert(sizeof(int64_t) == sizeof(std::atomic<int64_t>));
 }
 
+static void touch_stored_value(const Cache &cache,
+                               const StoredValue &stored_value,
+                               const int64_t new_time)
+{
+  set_relaxed(stored_value.last_use_time, new_time);
+  set_relaxed(stored_value.priority,
+              cache.inflation.load(std::memory_order_relaxed) + stored_value.cost_density);
+}
+
+/** The global mutex has to be locked. */
+static bool is_category_over_limit(const Category &category)
+{
+  return category.limit && category.memory.total_bytes > *category.limit;
+}
+
 std::shared_ptr<CachedValue> get_base(const GenericKey &key,
                                       const FunctionRef<std::unique_ptr<CachedValue>()> compute_fn)
 {
@@ -82,7 +150,8 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
     /* Fast path when the value is already cached. */
     CacheMap::ConstAccessor accessor;
     if (cache.map.lookup(accessor, std::ref(key))) {
-      set_new_logical_time(accessor->second, new_time);
+      touch_stored_value(cache, accessor->second, new_time);
+      accessor->second.category->hits.fetch_add(1, std::memory_order_relaxed);
       return accessor->second.value;
     }
   }
@@ -90,7 +159,11 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
   /* Compute value while no locks are held to avoid potential for dead-locks. Not using a lock also
    * means that the value may be computed more than once, but that's still better than locking all
    * the time. It may be possible to implement something smarter in the future. */
+  const std::chrono::steady_clock::time_point compute_start = std::chrono::steady_clock::now();
   std::shared_ptr<CachedValue> result = compute_fn();
+  const int64_t compute_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                 std::chrono::steady_clock::now() - compute_start)
+                                 .count();
   /* Result should be valid. Use exception to propagate error if necessary. */
   BLI_assert(result);
 
@@ -100,6 +173,7 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
     if (!newly_inserted) {
       /* The value is available already. It was computed unnecessarily. Use the value created by
        * the other thread instead. */
+      accessor->second.category->misses.fetch_add(1, std::memory_order_relaxed);
       return accessor->second.value;
     }
     /* We want to store the key in the map, but the reference we got passed in may go out of scope.
@@ -111,14 +185,36 @@ std::shared_ptr<CachedValue> get_base(const GenericKey &key,
 
     /* Store the value. Don't move, because we still want to return the value from the function. */
     accessor->second.value = result;
-    /* Set initial logical time for the new cached entry. */
-    set_new_logical_time(accessor->second, new_time);
+
+    /* The memory of the value on its own, ignoring data shared with other cached values. */
+    MemoryCount value_memory;
+    {
+      MemoryCounter memory_counter{value_memory};
+      result->count_memory(memory_counter);
+    }
+    accessor->second.cost_density = std::max<int64_t>(
+        compute_ns * 1024 / std::max<int64_t>(value_memory.total_bytes, 1), 1);
+    /* Set initial logical time and priority for the new cached entry. */
+    touch_stored_value(cache, accessor->second, new_time);
 
     {
       /* Update global data of the cache. */
       std::lock_guard lock{cache.global_mutex};
-      memory_counter::MemoryCounter memory_counter{cache.memory};
-      accessor->second.value->count_memory(memory_counter);
+      Category &category = ensure_category(cache, result->category());
+      accessor->second.category = &category;
+      category.misses.fetch_add(1, std::memory_order_relaxed);
+      category.values_num++;
+      {
+        MemoryCounter memory_counter{cache.memory};
+        accessor->second.value->count_memory(memory_counter);
+      }
+      {
+        MemoryCounter memory_counter{category.memory};
+        accessor->second.value->count_memory(memory_counter);
+      }
+      if (is_category_over_limit(category)) {
+        cache.category_over_limit = true;
+      }
       cache.keys.append(&accessor->first.get());
       cache.size_in_bytes = cache.memory.total_bytes;
     }
@@ -136,6 +232,89 @@ void set_approximate_size_limit(const int64_t limit_in_bytes)
   try_enforce_limit();
 }
 
+void set_category_size_limit(const StringRef category_name,
+                             const std::optional<int64_t> limit_in_bytes)
+{
+  Cache &cache = get_cache();
+  {
+    std::lock_guard lock{cache.global_mutex};
+    Category &category = ensure_category(cache, category_name);
+    category.limit = limit_in_bytes;
+    if (is_category_over_limit(category)) {
+      cache.category_over_limit = true;
+    }
+  }
+  try_enforce_limit();
+}
+
+void set_external_usage(const StringRef category_name, const int64_t size_in_bytes)
+{
+  Cache &cache = get_cache();
+  {
+    std::lock_guard lock{cache.global_mutex};
+    Category &category = ensure_category(cache, category_name);
+    category.is_external = true;
+    cache.external_size_in_bytes += size_in_bytes - category.external_size_in_bytes;
+    category.external_size_in_bytes = size_in_bytes;
+  }
+  try_enforce_limit();
+}
+
+Statistics get_statistics()
+{
+  Cache &cache = get_cache();
+  std::lock_guard lock{cache.global_mutex};
+  Statistics statistics;
+  statistics.size_in_bytes = cache.size_in_bytes;
+  statistics.external_size_in_bytes = cache.external_size_in_bytes;
+  statistics.size_limit = cache.approximate_limit;
+  for (const std::unique_ptr<Category> &category : cache.categories.values()) {
+    CategoryStatistics category_statistics;
+    category_statistics.name = category->name;
+    category_statistics.size_in_bytes = category->is_external ? category->external_size_in_bytes :
+                                                                category->memory.total_bytes;
+    category_statistics.size_limit = category->limit;
+    category_statistics.values_num = category->values_num;
+    category_statistics.hits = category->hits;
+    category_statistics.misses = category->misses;
+    category_statistics.evictions = category->evictions;
+    category_statistics.is_external = category->is_external;
+    statistics.categories.append(std::move(category_statistics));
+  }
+  std::sort(statistics.categories.begin(),
+            statistics.categories.end(),
+            [](const CategoryStatistics &a, const CategoryStatistics &b) { return a.name < b.name; });
+  return statistics;
+}
+
+/**
+ * Count the memory of all cached values again, in total and per category. The global mutex has to
+ * be locked.
+ */
+static void recount_memory(Cache &cache)
+{
+  cache.memory.reset();
+  for (std::unique_ptr<Category> &category : cache.categories.values()) {
+    category->memory.reset();
+    category->values_num = 0;
+  }
+  MemoryCounter memory_counter{cache.memory};
+  for (const GenericKey *key : cache.keys) {
+    CacheMap::ConstAccessor accessor;
+    if (!cache.map.lookup(accessor, *key)) {
+      BLI_assert_unreachable();
+      continue;
+    }
+    const StoredValue &stored_value = accessor->second;
+    stored_value.value->count_memory(memory_counter);
+    MemoryCounter category_memory_counter{stored_value.category->memory};
+    stored_value.value->count_memory(category_memory_counter);
+    stored_value.category->values_num++;
+  }
+  cache.size_in_bytes = cache.memory.total_bytes;
+  cache.category_over_limit = false;
+}
+
 void clear()
 {
   memory_cache::remove_if([](const GenericKey &) { return true; });
@@ -150,23 +329,12 @@ void remove_if(const FunctionRef<bool(const GenericKey &)> predicate)
    * that must not happen more than once. */
   Array<bool> predicate_results(cache.keys.size());
 
-  /* Recount memory of all elements that are not removed. */
-  cache.memory.reset();
-  MemoryCounter memory_counter{cache.memory};
-
   for (const int64_t i : cache.keys.index_range()) {
     const GenericKey &key = *cache.keys[i];
     const bool ok_to_remove = predicate(key);
     predicate_results[i] = ok_to_remove;
-
     if (!ok_to_remove) {
-      /* The value is kept, so count its memory. */
-      CacheMap::ConstAccessor accessor;
-      if (cache.map.lookup(accessor, key)) {
-        accessor->second.value->count_memory(memory_counter);
-        continue;
-      }
-      BLI_assert_unreachable();
+      continue;
     }
     /* The value should be removed. */
     const bool success = cache.map.remove(key);
@@ -178,7 +346,8 @@ void remove_if(const FunctionRef<bool(const GenericKey &)> predicate)
     const int64_t index = &key - cache.keys.data();
     return predicate_results[index];
   });
-  cache.size_in_bytes = cache.memory.total_bytes;
+  /* Recount memory of all elements that are not removed. */
+  recount_memory(cache);
 }
 
 static void try_enforce_limit()
@@ -186,94 +355,108 @@ static void try_enforce_limit()
   Cache &cache = get_cache();
   const int64_t old_size = cache.size_in_bytes.load(std::memory_order_relaxed);
   const int64_t approximate_limit = cache.approximate_limit.load(std::memory_order_relaxed);
-  if (old_size < approximate_limit) {
+  const int64_t external_size = cache.external_size_in_bytes.load(std::memory_order_relaxed);
+  if (old_size + external_size < approximate_limit &&
+      !cache.category_over_limit.load(std::memory_order_relaxed))
+  {
     /* Nothing to do, the current cache size is still within the right limits. */
     return;
   }
 
   std::lock_guard lock{cache.global_mutex};
-
-  /* Gather all the keys with their latest usage times. */
-  Vector<std::pair<int64_t, const GenericKey *>> keys_with_time;
+  /* Memory used by external caches reduces the amount available for the values in this cache. */
+  const int64_t limit = std::max<int64_t>(approximate_limit - cache.external_size_in_bytes, 0);
+
+  struct Item {
+    int64_t priority;
+    int64_t last_use_time;
+    const GenericKey *key;
+    Category *category;
+  };
+
+  /* Gather all the keys with their priorities. */
+  Vector<Item> items;
   for (const GenericKey *key : cache.keys) {
     CacheMap::ConstAccessor accessor;
     if (!cache.map.lookup(accessor, *key)) {
       continue;
     }
-    keys_with_time.append({accessor->second.last_use_time, key});
+    const StoredValue &stored_value = accessor->second;
+    items.append(
+        {stored_value.priority, stored_value.last_use_time, key, stored_value.category});
   }
-  /* Sort the items so that the newest keys come first. */
-  std::sort(keys_with_time.begin(), keys_with_time.end());
-  std::reverse(keys_with_time.begin(), keys_with_time.end());
+  /* Sort the items so that the ones that should be kept the most come first. */
+  std::sort(items.begin(), items.end(), [](const Item &a, const Item &b) {
+    if (a.priority != b.priority) {
+      return a.priority > b.priority;
+    }
+    return a.last_use_time > b.last_use_time;
+  });
 
-  /* Count used memory starting at the most recently touched element. Stop at the element when the
-   * amount became larger than the capacity. */
+  /* Count used memory starting at the item with the highest priority. When the total or a
+   * category becomes full, all following items (of that category) are removed. Undershoot a
+   * little bit. This typically results in more things being freed that have not been used in a
+   * while. The benefit is that we have to do the decision what to free less often than if we were
+   * always just freeing the minimum amount necessary. */
   cache.memory.reset();
-  std::optional<int> first_bad_index;
-  {
-    MemoryCounter memory_counter{cache.memory};
-    for (const int i : keys_with_time.index_range()) {
-      const GenericKey &key = *keys_with_time[i].second;
+  Set<const Category *> full_categories;
+  for (std::unique_ptr<Category> &category : cache.categories.values()) {
+    category->memory.reset();
+  }
+  bool cache_is_full = false;
+  Vector<const GenericKey *> kept_keys;
+  std::optional<int64_t> max_removed_priority;
+  for (const Item &item : items) {
+    bool keep = !cache_is_full && !full_categories.contains(item.category);
+    if (keep) {
       CacheMap::ConstAccessor accessor;
-      if (!cache.map.lookup(accessor, key)) {
+      if (!cache.map.lookup(accessor, *item.key)) {
         continue;
       }
-      accessor->second.value->count_memory(memory_counter);
-      /* Undershoot a little bit. This typically results in more things being freed that have not
-       * been used in a while. The benefit is that we have to do the decision what to free less
-       * often than if we were always just freeing the minimum amount necessary. */
-      if (cache.memory.total_bytes <= approximate_limit * 0.75) {
-        continue;
+      const CachedValue &value = *accessor->second.value;
+      if (item.category->limit) {
+        const int64_t category_limit = *item.category->limit;
+        MemoryCounter memory_counter{item.category->memory};
+        value.count_memory(memory_counter);
+        if (item.category->memory.total_bytes > category_limit) {
+          keep = false;
+          full_categories.add(item.category);
+        }
+        else if (item.category->memory.total_bytes > category_limit * 0.75) {
+          full_categories.add(item.category);
+        }
+      }
+      if (keep) {
+        MemoryCounter memory_counter{cache.memory};
+        value.count_memory(memory_counter);
+        if (cache.memory.total_bytes > limit) {
+          keep = false;
+          cache_is_full = true;
+        }
+        else if (cache.memory.total_bytes > limit * 0.75) {
+          cache_is_full = true;
+        }
       }
-      first_bad_index = i;
-      break;
     }
-  }
-  if (!first_bad_index) {
-    return;
-  }
-
-  /* Avoid recounting memory if the last item is not way too large and the overshoot is still ok.
-   * The alternative would be to subtract the last item from the counted memory again, but removing
-   * from #MemoryCount is not implemented yet. */
-  bool need_memory_recount = false;
-  if (cache.memory.total_bytes < approximate_limit * 1.1) {
-    *first_bad_index += 1;
-    if (*first_bad_index == keys_with_time.size()) {
-      return;
+    if (keep) {
+      kept_keys.append(item.key);
+      continue;
+    }
+    if (cache.map.remove(*item.key)) {
+      item.category->evictions.fetch_add(1, std::memory_order_relaxed);
+      max_removed_priority = std::max(max_removed_priority.value_or(item.priority),
+                                      item.priority);
     }
   }
-  else {
-    need_memory_recount = true;
-  }
-
-  /* Remove elements that don't fit anymore. */
-  for (const int i : keys_with_time.index_range().drop_front(*first_bad_index)) {
-    const GenericKey &key = *keys_with_time[i].second;
-    cache.map.remove(key);
+  if (max_removed_priority) {
+    /* Values that are used from now on should be kept over all values that are not. */
+    cache.inflation = std::max(cache.inflation.load(), *max_removed_priority);
   }
 
   /* Update keys vector. */
-  cache.keys.clear();
-  for (const int i : keys_with_time.index_range().take_front(*first_bad_index)) {
-    cache.keys.append(keys_with_time[i].second);
-  }
-
-  if (need_memory_recount) {
-    /* Recount memory another time, because the last count does not accurately represent the actual
-     * value. */
-    cache.memory.reset();
-    MemoryCounter memory_counter{cache.memory};
-    for (const int i : keys_with_time.index_range().take_front(*first_bad_index)) {
-      const GenericKey &key = *keys_with_time[i].second;
-      CacheMap::ConstAccessor accessor;
-      if (!cache.map.lookup(accessor, key)) {
-        continue;
-      }
-      accessor->second.value->count_memory(memory_counter);
-    }
-  }
-  cache.size_in_bytes = cache.memory.total_bytes;
+  cache.keys = std::move(kept_keys);
+  /* The memory counts above include removed values, so they have to be updated. */
+  recount_memory(cache);
 }
 
 }  // namespace blender::memory_cache
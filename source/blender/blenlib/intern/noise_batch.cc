@@ -0,0 +1,123 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include "BLI_cpu_dispatch.hh"
+#include "BLI_noise.hh"
+#include "BLI_utildefines.h"
+
+#define BLI_CPU_KERNEL_NAMESPACE baseline
+#include "noise_batch_kernels.hh"
+#undef BLI_CPU_KERNEL_NAMESPACE
+
+namespace blender::noise {
+
+#ifdef WITH_BLI_AVX2_KERNELS
+namespace avx2 {
+/* Defined in `noise_batch_avx2.cc`. */
+void perlin_fbm_kernel(const float *positions,
+                       int64_t size,
+                       float detail,
+                       float roughness,
+                       float lacunarity,
+                       bool normalize,
+                       float *r_values);
+void voronoi_f1_kernel(const float *coords,
+                       int64_t size,
+                       float randomness,
+                       int metric,
+                       float *r_distances,
+                       float *r_colors,
+                       float *r_positions);
+}  // namespace avx2
+#endif
+
+struct NoiseBatchKernels {
+  void (*perlin_fbm)(const float *positions,
+                     int64_t size,
+                     float detail,
+                     float roughness,
+                     float lacunarity,
+                     bool normalize,
+                     float *r_values);
+  void (*voronoi_f1)(const float *coords,
+                     int64_t size,
+                     float randomness,
+                     int metric,
+                     float *r_distances,
+                     float *r_colors,
+                     float *r_positions);
+};
+
+static const NoiseBatchKernels &get_kernels()
+{
+  static const NoiseBatchKernels kernels = []() -> NoiseBatchKernels {
+#ifdef WITH_BLI_AVX2_KERNELS
+    if (cpu_dispatch::best_isa() == cpu_dispatch::ISA::AVX2) {
+      return {avx2::perlin_fbm_kernel, avx2::voronoi_f1_kernel};
+    }
+#endif
+    return {baseline::perlin_fbm_kernel, baseline::voronoi_f1_kernel};
+  }();
+  return kernels;
+}
+
+void perlin_fbm(const Span<float3> positions,
+                const float detail,
+                const float roughness,
+                const float lacunarity,
+                const bool normalize,
+                MutableSpan<float> r_values)
+{
+  BLI_assert(positions.size() == r_values.size());
+  get_kernels().perlin_fbm(&positions.data()->x,
+                           positions.size(),
+                           detail,
+                           roughness,
+                           lacunarity,
+                           normalize,
+                           r_values.data());
+}
+
+void voronoi_f1(const VoronoiParams &params,
+                const Span<float3> coords,
+                MutableSpan<float> r_distances,
+                MutableSpan<float3> r_colors,
+                MutableSpan<float3> r_positions)
+{
+  BLI_assert(r_distances.is_empty() || r_distances.size() == coords.size());
+  BLI_assert(r_colors.is_empty() || r_colors.size() == coords.size());
+  BLI_assert(r_positions.is_empty() || r_positions.size() == coords.size());
+  if (!ELEM(params.metric,
+            baseline::VORONOI_EUCLIDEAN,
+            baseline::VORONOI_MANHATTAN,
+            baseline::VORONOI_CHEBYCHEV))
+  {
+    for (const int64_t i : coords.index_range()) {
+      const VoronoiOutput output = voronoi_f1(params, coords[i]);
+      if (!r_distances.is_empty()) {
+        r_distances[i] = output.distance;
+      }
+      if (!r_colors.is_empty()) {
+        r_colors[i] = output.color;
+      }
+      if (!r_positions.is_empty()) {
+        r_positions[i] = output.position.xyz();
+      }
+    }
+    return;
+  }
+  get_kernels().voronoi_f1(&coords.data()->x,
+                           coords.size(),
+                           params.randomness,
+                           params.metric,
+                           r_distances.is_empty() ? nullptr : r_distances.data(),
+                           r_colors.is_empty() ? nullptr : &r_colors.data()->x,
+                           r_positions.is_empty() ? nullptr : &r_positions.data()->x);
+}
+
+}  // namespace blender::noise
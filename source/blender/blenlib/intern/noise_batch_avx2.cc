@@ -0,0 +1,12 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Compiled with AVX2 and FMA enabled, only called when the CPU supports them.
+ */
+
+#define BLI_CPU_KERNEL_NAMESPACE avx2
+#include "noise_batch_kernels.hh"
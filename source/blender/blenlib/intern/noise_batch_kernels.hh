@@ -0,0 +1,487 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ *
+ * Kernels of the batch noise functions in #BLI_noise.hh. This file is included once per
+ * instruction set with `BLI_CPU_KERNEL_NAMESPACE` defined, so it must not use functions from other
+ * headers, see #BLI_cpu_dispatch.hh. The hash and noise functions are therefore copies of the ones
+ * in `noise.cc`, and have to do the exact same floating point operations.
+ *
+ * Points are evaluated in blocks. The loops over the points of a block have no branches that
+ * depend on the point, so that the compiler can vectorize them.
+ */
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+
+#include "BLI_compiler_compat.h"
+
+#ifndef BLI_CPU_KERNEL_NAMESPACE
+#  error "Define the namespace of the instruction set before including the kernels"
+#endif
+
+namespace blender::noise::BLI_CPU_KERNEL_NAMESPACE {
+
+static constexpr int block_size = 16;
+
+/* -------------------------------------------------------------------- */
+/** \name Hash Functions
+ * \{ */
+
+BLI_INLINE uint32_t hash_bit_rotate(uint32_t x, uint32_t k)
+{
+  return (x << k) | (x >> (32 - k));
+}
+
+BLI_INLINE void hash_bit_mix(uint32_t &a, uint32_t &b, uint32_t &c)
+{
+  a -= c;
+  a ^= hash_bit_rotate(c, 4);
+  c += b;
+  b -= a;
+  b ^= hash_bit_rotate(a, 6);
+  a += c;
+  c -= b;
+  c ^= hash_bit_rotate(b, 8);
+  b += a;
+  a -= c;
+  a ^= hash_bit_rotate(c, 16);
+  c += b;
+  b -= a;
+  b ^= hash_bit_rotate(a, 19);
+  a += c;
+  c -= b;
+  c ^= hash_bit_rotate(b, 4);
+  b += a;
+}
+
+BLI_INLINE void hash_bit_final(uint32_t &a, uint32_t &b, uint32_t &c)
+{
+  c ^= b;
+  c -= hash_bit_rotate(b, 14);
+  a ^= c;
+  a -= hash_bit_rotate(c, 11);
+  b ^= a;
+  b -= hash_bit_rotate(a, 25);
+  c ^= b;
+  c -= hash_bit_rotate(b, 16);
+  a ^= c;
+  a -= hash_bit_rotate(c, 4);
+  b ^= a;
+  b -= hash_bit_rotate(a, 14);
+  c ^= b;
+  c -= hash_bit_rotate(b, 24);
+}
+
+BLI_INLINE uint32_t hash(uint32_t kx, uint32_t ky, uint32_t kz)
+{
+  uint32_t a, b, c;
+  a = b = c = 0xdeadbeef + (3 << 2) + 13;
+
+  c += kz;
+  b += ky;
+  a += kx;
+  hash_bit_final(a, b, c);
+
+  return c;
+}
+
+BLI_INLINE uint32_t hash(uint32_t kx, uint32_t ky, uint32_t kz, uint32_t kw)
+{
+  uint32_t a, b, c;
+  a = b = c = 0xdeadbeef + (4 << 2) + 13;
+
+  a += kx;
+  b += ky;
+  c += kz;
+  hash_bit_mix(a, b, c);
+
+  a += kw;
+  hash_bit_final(a, b, c);
+
+  return c;
+}
+
+BLI_INLINE uint32_t float_as_uint(float f)
+{
+  union {
+    uint32_t i;
+    float f;
+  } u;
+  u.f = f;
+  return u.i;
+}
+
+BLI_INLINE float uint_to_float_01(uint32_t k)
+{
+  return float(k) / float(0xFFFFFFFFu);
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Perlin Noise
+ * \{ */
+
+BLI_INLINE float mix(float v0,
+                     float v1,
+                     float v2,
+                     float v3,
+                     float v4,
+                     float v5,
+                     float v6,
+                     float v7,
+                     float x,
+                     float y,
+                     float z)
+{
+  float x1 = 1.0 - x;
+  float y1 = 1.0 - y;
+  float z1 = 1.0 - z;
+  return z1 * (y1 * (v0 * x1 + v1 * x) + y * (v2 * x1 + v3 * x)) +
+         z * (y1 * (v4 * x1 + v5 * x) + y * (v6 * x1 + v7 * x));
+}
+
+BLI_INLINE float fade(float t)
+{
+  return t * t * t * (t * (t * 6.0 - 15.0) + 10.0);
+}
+
+BLI_INLINE float negate_if(float value, uint32_t condition)
+{
+  return (condition != 0u) ? -value : value;
+}
+
+BLI_INLINE float noise_grad(uint32_t hash, float x, float y, float z)
+{
+  uint32_t h = hash & 15u;
+  float u = h < 8u ? x : y;
+  float vt = (h == 12u || h == 14u) ? x : z;
+  float v = h < 4u ? y : vt;
+  return negate_if(u, h & 1u) + negate_if(v, h & 2u);
+}
+
+BLI_INLINE float perlin_noise(float x, float y, float z)
+{
+  const float x_floor = floorf(x);
+  const float y_floor = floorf(y);
+  const float z_floor = floorf(z);
+  const int X = int(x_floor);
+  const int Y = int(y_floor);
+  const int Z = int(z_floor);
+  const float fx = x - x_floor;
+  const float fy = y - y_floor;
+  const float fz = z - z_floor;
+
+  float u = fade(fx);
+  float v = fade(fy);
+  float w = fade(fz);
+
+  float r = mix(noise_grad(hash(X, Y, Z), fx, fy, fz),
+                noise_grad(hash(X + 1, Y, Z), fx - 1, fy, fz),
+                noise_grad(hash(X, Y + 1, Z), fx, fy - 1, fz),
+                noise_grad(hash(X + 1, Y + 1, Z), fx - 1, fy - 1, fz),
+                noise_grad(hash(X, Y, Z + 1), fx, fy, fz - 1),
+                noise_grad(hash(X + 1, Y, Z + 1), fx - 1, fy, fz - 1),
+                noise_grad(hash(X, Y + 1, Z + 1), fx, fy - 1, fz - 1),
+                noise_grad(hash(X + 1, Y + 1, Z + 1), fx - 1, fy - 1, fz - 1),
+                u,
+                v,
+                w);
+
+  return r;
+}
+
+BLI_INLINE float perlin_precision_correction(const float value)
+{
+  return fmodf(value, 100000.0f) + 0.5f * float(fabsf(value) >= 1000000.0f);
+}
+
+/** `perlin_signed(scale * p)` for a block of points. */
+BLI_INLINE void perlin_signed_block(const float (&x)[block_size],
+                                    const float (&y)[block_size],
+                                    const float (&z)[block_size],
+                                    const float scale,
+                                    float (&r_values)[block_size])
+{
+  float px[block_size], py[block_size], pz[block_size];
+  int is_large = 0;
+  for (int i = 0; i < block_size; i++) {
+    px[i] = scale * x[i];
+    py[i] = scale * y[i];
+    pz[i] = scale * z[i];
+    is_large |= int(!(fabsf(px[i]) < 100000.0f)) | int(!(fabsf(py[i]) < 100000.0f)) |
+                int(!(fabsf(pz[i]) < 100000.0f));
+  }
+  if (is_large) {
+    for (int i = 0; i < block_size; i++) {
+      px[i] = perlin_precision_correction(px[i]);
+      py[i] = perlin_precision_correction(py[i]);
+      pz[i] = perlin_precision_correction(pz[i]);
+    }
+  }
+  else {
+    /* The modulo doesn't change smaller values. The correction is still added, because it turns
+     * negative zero into positive zero. */
+    for (int i = 0; i < block_size; i++) {
+      px[i] += 0.0f;
+      py[i] += 0.0f;
+      pz[i] += 0.0f;
+    }
+  }
+  for (int i = 0; i < block_size; i++) {
+    r_values[i] = perlin_noise(px[i], py[i], pz[i]) * 0.9820f;
+  }
+}
+
+/** Copy up to a block of packed 3D vectors into separate arrays, padded with zeros. */
+BLI_INLINE void load_block(const float *src,
+                           const int size,
+                           float (&r_x)[block_size],
+                           float (&r_y)[block_size],
+                           float (&r_z)[block_size])
+{
+  for (int i = 0; i < block_size; i++) {
+    r_x[i] = (i < size) ? src[i * 3 + 0] : 0.0f;
+    r_y[i] = (i < size) ? src[i * 3 + 1] : 0.0f;
+    r_z[i] = (i < size) ? src[i * 3 + 2] : 0.0f;
+  }
+}
+
+/**
+ * \param positions: Packed 3D vectors.
+ */
+void perlin_fbm_kernel(const float *positions,
+                       const int64_t size,
+                       const float detail,
+                       const float roughness,
+                       const float lacunarity,
+                       const bool normalize,
+                       float *r_values)
+{
+  for (int64_t start = 0; start < size; start += block_size) {
+    const int block_num = int(size - start < block_size ? size - start : block_size);
+    float x[block_size], y[block_size], z[block_size];
+    load_block(positions + start * 3, block_num, x, y, z);
+
+    float fscale = 1.0f;
+    float amp = 1.0f;
+    float maxamp = 0.0f;
+    float sum[block_size] = {};
+    float t[block_size];
+
+    for (int octave = 0; octave <= int(detail); octave++) {
+      perlin_signed_block(x, y, z, fscale, t);
+      for (int i = 0; i < block_size; i++) {
+        sum[i] += t[i] * amp;
+      }
+      maxamp += amp;
+      amp *= roughness;
+      fscale *= lacunarity;
+    }
+
+    float result[block_size];
+    const float rmd = detail - floorf(detail);
+    if (rmd != 0.0f) {
+      perlin_signed_block(x, y, z, fscale, t);
+      if (normalize) {
+        for (int i = 0; i < block_size; i++) {
+          const float sum2 = sum[i] + t[i] * amp;
+          const float v0 = 0.5f * sum[i] / maxamp + 0.5f;
+          const float v1 = 0.5f * sum2 / (maxamp + amp) + 0.5f;
+          result[i] = (1 - rmd) * v0 + rmd * v1;
+        }
+      }
+      else {
+        for (int i = 0; i < block_size; i++) {
+          const float sum2 = sum[i] + t[i] * amp;
+          result[i] = (1 - rmd) * sum[i] + rmd * sum2;
+        }
+      }
+    }
+    else if (normalize) {
+      for (int i = 0; i < block_size; i++) {
+        result[i] = 0.5f * sum[i] / maxamp + 0.5f;
+      }
+    }
+    else {
+      for (int i = 0; i < block_size; i++) {
+        result[i] = sum[i];
+      }
+    }
+    for (int i = 0; i < block_num; i++) {
+      r_values[start + i] = result[i];
+    }
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Voronoi Noise
+ * \{ */
+
+/** Same values as the metric enum in `noise.cc`. */
+enum {
+  VORONOI_EUCLIDEAN = 0,
+  VORONOI_MANHATTAN = 1,
+  VORONOI_CHEBYCHEV = 2,
+};
+
+template<int Metric> BLI_INLINE float voronoi_distance(float dx, float dy, float dz)
+{
+  if constexpr (Metric == VORONOI_EUCLIDEAN) {
+    return sqrtf(dx * dx + dy * dy + dz * dz);
+  }
+  else if constexpr (Metric == VORONOI_MANHATTAN) {
+    return fabsf(dx) + fabsf(dy) + fabsf(dz);
+  }
+  else {
+    float result = fabsf(dx);
+    result = (result < fabsf(dy)) ? fabsf(dy) : result;
+    result = (result < fabsf(dz)) ? fabsf(dz) : result;
+    return result;
+  }
+}
+
+/** `hash_float_to_float3(float3(x, y, z))`. */
+BLI_INLINE void hash_float_to_float3(
+    float x, float y, float z, float &r_x, float &r_y, float &r_z)
+{
+  const uint32_t ux = float_as_uint(x);
+  const uint32_t uy = float_as_uint(y);
+  const uint32_t uz = float_as_uint(z);
+  r_x = uint_to_float_01(hash(ux, uy, uz));
+  r_y = uint_to_float_01(hash(ux, uy, uz, float_as_uint(1.0f)));
+  r_z = uint_to_float_01(hash(ux, uy, uz, float_as_uint(2.0f)));
+}
+
+template<int Metric>
+static void voronoi_f1_kernel_impl(const float *coords,
+                                   const int64_t size,
+                                   const float randomness,
+                                   float *r_distances,
+                                   float *r_colors,
+                                   float *r_positions)
+{
+  for (int64_t start = 0; start < size; start += block_size) {
+    const int block_num = int(size - start < block_size ? size - start : block_size);
+    float cell_x[block_size], cell_y[block_size], cell_z[block_size];
+    load_block(coords + start * 3, block_num, cell_x, cell_y, cell_z);
+    float local_x[block_size], local_y[block_size], local_z[block_size];
+    for (int i = 0; i < block_size; i++) {
+      const float x = cell_x[i], y = cell_y[i], z = cell_z[i];
+      cell_x[i] = floorf(x);
+      cell_y[i] = floorf(y);
+      cell_z[i] = floorf(z);
+      local_x[i] = x - cell_x[i];
+      local_y[i] = y - cell_y[i];
+      local_z[i] = z - cell_z[i];
+    }
+
+    float min_distance[block_size];
+    float offset_x[block_size] = {}, offset_y[block_size] = {}, offset_z[block_size] = {};
+    float target_x[block_size] = {}, target_y[block_size] = {}, target_z[block_size] = {};
+    for (int i = 0; i < block_size; i++) {
+      min_distance[i] = FLT_MAX;
+    }
+
+    for (int k = -1; k <= 1; k++) {
+      for (int j = -1; j <= 1; j++) {
+        for (int i = -1; i <= 1; i++) {
+          const float cell_offset_x = float(i);
+          const float cell_offset_y = float(j);
+          const float cell_offset_z = float(k);
+          for (int l = 0; l < block_size; l++) {
+            float hash_x, hash_y, hash_z;
+            hash_float_to_float3(cell_x[l] + cell_offset_x,
+                                 cell_y[l] + cell_offset_y,
+                                 cell_z[l] + cell_offset_z,
+                                 hash_x,
+                                 hash_y,
+                                 hash_z);
+            const float point_x = cell_offset_x + hash_x * randomness;
+            const float point_y = cell_offset_y + hash_y * randomness;
+            const float point_z = cell_offset_z + hash_z * randomness;
+            const float distance = voronoi_distance<Metric>(
+                point_x - local_x[l], point_y - local_y[l], point_z - local_z[l]);
+            const bool is_closer = distance < min_distance[l];
+            min_distance[l] = is_closer ? distance : min_distance[l];
+            offset_x[l] = is_closer ? cell_offset_x : offset_x[l];
+            offset_y[l] = is_closer ? cell_offset_y : offset_y[l];
+            offset_z[l] = is_closer ? cell_offset_z : offset_z[l];
+            target_x[l] = is_closer ? point_x : target_x[l];
+            target_y[l] = is_closer ? point_y : target_y[l];
+            target_z[l] = is_closer ? point_z : target_z[l];
+          }
+        }
+      }
+    }
+
+    if (r_distances) {
+      for (int l = 0; l < block_num; l++) {
+        r_distances[start + l] = min_distance[l];
+      }
+    }
+    if (r_colors) {
+      float color_x[block_size], color_y[block_size], color_z[block_size];
+      for (int l = 0; l < block_size; l++) {
+        hash_float_to_float3(cell_x[l] + offset_x[l],
+                             cell_y[l] + offset_y[l],
+                             cell_z[l] + offset_z[l],
+                             color_x[l],
+                             color_y[l],
+                             color_z[l]);
+      }
+      for (int l = 0; l < block_num; l++) {
+        r_colors[(start + l) * 3 + 0] = color_x[l];
+        r_colors[(start + l) * 3 + 1] = color_y[l];
+        r_colors[(start + l) * 3 + 2] = color_z[l];
+      }
+    }
+    if (r_positions) {
+      for (int l = 0; l < block_num; l++) {
+        r_positions[(start + l) * 3 + 0] = target_x[l] + cell_x[l];
+        r_positions[(start + l) * 3 + 1] = target_y[l] + cell_y[l];
+        r_positions[(start + l) * 3 + 2] = target_z[l] + cell_z[l];
+      }
+    }
+  }
+}
+
+/**
+ * Only supports the Euclidean, Manhattan and Chebychev metrics.
+ * \param coords, r_colors, r_positions: Packed 3D vectors.
+ * \param r_distances, r_colors, r_positions: Outputs that are null are not computed.
+ */
+void voronoi_f1_kernel(const float *coords,
+                       const int64_t size,
+                       const float randomness,
+                       const int metric,
+                       float *r_distances,
+                       float *r_colors,
+                       float *r_positions)
+{
+  switch (metric) {
+    case VORONOI_EUCLIDEAN:
+      voronoi_f1_kernel_impl<VORONOI_EUCLIDEAN>(
+          coords, size, randomness, r_distances, r_colors, r_positions);
+      break;
+    case VORONOI_MANHATTAN:
+      voronoi_f1_kernel_impl<VORONOI_MANHATTAN>(
+          coords, size, randomness, r_distances, r_colors, r_positions);
+      break;
+    case VORONOI_CHEBYCHEV:
+      voronoi_f1_kernel_impl<VORONOI_CHEBYCHEV>(
+          coords, size, randomness, r_distances, r_colors, r_positions);
+      break;
+  }
+}
+
+/** \} */
+
+}  // namespace blender::noise::BLI_CPU_KERNEL_NAMESPACE
@@ -0,0 +1,222 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup bli
+ */
+
+#include <algorithm>
+#include <atomic>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_allocator.hh"
+#include "BLI_math_base.h"
+#include "BLI_scratch_allocator.hh"
+#include "BLI_vector.hh"
+
+namespace blender {
+
+/** Size of the first chunk of an arena. */
+static constexpr int64_t min_chunk_size = 64 * 1024;
+/**
+ * Arenas keep at most this much memory between evaluations. Their chunks are allocated with
+ * #RawAllocator, because worker threads and their arenas may outlive the leak detection.
+ */
+static constexpr int64_t max_retained_size = 16 * 1024 * 1024;
+
+static std::atomic<int64_t> total_allocations_num = 0;
+static std::atomic<int64_t> total_allocated_bytes = 0;
+static std::atomic<int64_t> total_chunk_allocations_num = 0;
+
+struct ScratchArena {
+  struct Chunk {
+    void *buffer;
+    int64_t size;
+  };
+
+  RawAllocator allocator;
+  Vector<Chunk, 4, RawAllocator> chunks;
+  int64_t current_chunk = -1;
+  uintptr_t current_begin = 0;
+  uintptr_t current_end = 0;
+
+  /** The most recent allocation and the position before it, see #ScratchScope::deallocate. */
+  uintptr_t last_allocation = 0;
+  uintptr_t last_allocation_begin = 0;
+
+  int scopes_num = 0;
+  /** Size of the next chunk allocated when all chunks were released at the end of a scope. */
+  int64_t next_chunk_size = min_chunk_size;
+
+  ScratchAllocatorStats stats;
+
+  ~ScratchArena()
+  {
+    this->free_chunks();
+  }
+
+  void free_chunks()
+  {
+    for (const Chunk &chunk : this->chunks) {
+      this->allocator.deallocate(chunk.buffer);
+    }
+    this->chunks.clear();
+    this->current_chunk = -1;
+    this->current_begin = 0;
+    this->current_end = 0;
+  }
+
+  void set_current_chunk(const int64_t chunk_index)
+  {
+    const Chunk &chunk = this->chunks[chunk_index];
+    this->current_chunk = chunk_index;
+    this->current_begin = uintptr_t(chunk.buffer);
+    this->current_end = this->current_begin + uintptr_t(chunk.size);
+  }
+
+  /** Continue in the next chunk that is large enough, allocating a new one if necessary. */
+  void use_next_chunk(const int64_t min_size)
+  {
+    while (this->current_chunk + 1 < this->chunks.size()) {
+      this->set_current_chunk(this->current_chunk + 1);
+      if (this->chunks[this->current_chunk].size >= min_size) {
+        return;
+      }
+    }
+    int64_t size = std::max(min_size, this->next_chunk_size);
+    if (!this->chunks.is_empty()) {
+      size = std::max(size, this->chunks.last().size * 2);
+    }
+    this->chunks.append({this->allocator.allocate(size_t(size), 64, __func__), size});
+    this->stats.chunk_allocations_num++;
+    this->set_current_chunk(this->chunks.size() - 1);
+  }
+
+  void *allocate(const int64_t size, const int64_t alignment)
+  {
+    BLI_assert(size >= 0);
+    BLI_assert(is_power_of_2(int(alignment)));
+    const uintptr_t alignment_mask = uintptr_t(alignment) - 1;
+    uintptr_t begin = (this->current_begin + alignment_mask) & ~alignment_mask;
+    if (this->current_chunk == -1 || begin + uintptr_t(size) > this->current_end) {
+      this->use_next_chunk(size + alignment);
+      begin = (this->current_begin + alignment_mask) & ~alignment_mask;
+    }
+    this->last_allocation = begin;
+    this->last_allocation_begin = this->current_begin;
+    this->current_begin = begin + uintptr_t(size);
+
+    this->stats.allocations_num++;
+    this->stats.allocated_bytes += size;
+    return reinterpret_cast<void *>(begin);
+  }
+
+  /** Called when the outermost scope ended and all memory is unused. */
+  void release()
+  {
+    if (this->chunks.size() > 1 || (this->chunks.size() == 1 &&
+                                    this->chunks[0].size > max_retained_size))
+    {
+      /* Replace all chunks by a single one the next time, so that evaluations that need the same
+       * amount of memory don't allocate chunks anymore. */
+      int64_t used_size = 0;
+      for (const Chunk &chunk : this->chunks) {
+        used_size += chunk.size;
+      }
+      this->free_chunks();
+      this->next_chunk_size = std::clamp(used_size, min_chunk_size, max_retained_size);
+    }
+    total_allocations_num.fetch_add(this->stats.allocations_num, std::memory_order_relaxed);
+    total_allocated_bytes.fetch_add(this->stats.allocated_bytes, std::memory_order_relaxed);
+    total_chunk_allocations_num.fetch_add(this->stats.chunk_allocations_num,
+                                          std::memory_order_relaxed);
+    this->stats = {};
+  }
+};
+
+static ScratchArena &get_thread_arena()
+{
+  static thread_local ScratchArena arena;
+  return arena;
+}
+
+ScratchScope::ScratchScope() : arena_(get_thread_arena())
+{
+  begin_chunk_ = arena_.current_chunk;
+  begin_ = arena_.current_begin;
+  arena_.scopes_num++;
+}
+
+ScratchScope::~ScratchScope()
+{
+  BLI_assert(&arena_ == &get_thread_arena());
+  arena_.scopes_num--;
+  arena_.last_allocation = 0;
+  if (arena_.scopes_num == 0) {
+    arena_.current_chunk = -1;
+    arena_.current_begin = 0;
+    arena_.current_end = 0;
+    arena_.release();
+    return;
+  }
+  if (begin_chunk_ == -1) {
+    arena_.current_chunk = -1;
+    arena_.current_begin = 0;
+    arena_.current_end = 0;
+    return;
+  }
+  arena_.set_current_chunk(begin_chunk_);
+  arena_.current_begin = begin_;
+}
+
+void *ScratchScope::allocate(const int64_t size, const int64_t alignment)
+{
+  /* Scratch memory can only be allocated on the thread that owns the scope. */
+  BLI_assert(&arena_ == &get_thread_arena());
+  return arena_.allocate(size, alignment);
+}
+
+void ScratchScope::deallocate(const void *ptr)
+{
+  if (uintptr_t(ptr) == arena_.last_allocation) {
+    arena_.current_begin = arena_.last_allocation_begin;
+    arena_.last_allocation = 0;
+  }
+}
+
+void *ScratchAllocator::allocate(const size_t size, const size_t alignment, const char *name)
+{
+  if (scope_) {
+    return scope_->allocate(int64_t(size), int64_t(alignment));
+  }
+  return GuardedAllocator().allocate(size, alignment, name);
+}
+
+void ScratchAllocator::deallocate(void *ptr)
+{
+  if (scope_) {
+    scope_->deallocate(ptr);
+    return;
+  }
+  GuardedAllocator().deallocate(ptr);
+}
+
+ScratchAllocatorStats scratch_allocator_stats()
+{
+  ScratchAllocatorStats stats;
+  stats.allocations_num = total_allocations_num.load(std::memory_order_relaxed);
+  stats.allocated_bytes = total_allocated_bytes.load(std::memory_order_relaxed);
+  stats.chunk_allocations_num = total_chunk_allocations_num.load(std::memory_order_relaxed);
+  return stats;
+}
+
+void scratch_allocator_stats_reset()
+{
+  total_allocations_num.store(0, std::memory_order_relaxed);
+  total_allocated_bytes.store(0, std::memory_order_relaxed);
+  total_chunk_allocations_num.store(0, std::memory_order_relaxed);
+}
+
+}  // namespace blender
@@ -7,6 +7,7 @@
  */
 
 #include <climits>
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 
@@ -128,6 +129,23 @@ static void __cpuid(
   data[0] = data[1] = data[2] = data[3] = 0;
 #  endif
 }
+
+static void __cpuidex(
+    /* NOLINTNEXTLINE: readability-non-const-parameter. */
+    int data[4],
+    int selector,
+    int subselector)
+{
+#  if defined(__x86_64__)
+  asm("cpuid"
+      : "=a"(data[0]), "=b"(data[1]), "=c"(data[2]), "=d"(data[3])
+      : "a"(selector), "c"(subselector));
+#  else
+  (void)selector;
+  (void)subselector;
+  data[0] = data[1] = data[2] = data[3] = 0;
+#  endif
+}
 #endif
 
 char *BLI_cpu_brand_string()
@@ -177,6 +195,39 @@ int BLI_cpu_support_sse42()
   return 0;
 }
 
+int BLI_cpu_support_avx2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+  int result[4];
+  __cpuid(result, 0);
+  if (result[0] < 7) {
+    return 0;
+  }
+  __cpuid(result, 0x00000001);
+  const bool has_fma = (result[2] & (int(1) << 12)) != 0;
+  const bool has_osxsave = (result[2] & (int(1) << 27)) != 0;
+  const bool has_avx = (result[2] & (int(1) << 28)) != 0;
+  if (!(has_fma && has_osxsave && has_avx)) {
+    return 0;
+  }
+  /* The operating system has to save the XMM and YMM registers on context switches. */
+#  if defined(_MSC_VER)
+  const uint64_t xcr0 = _xgetbv(0);
+#  else
+  uint32_t xcr0_low, xcr0_high;
+  asm("xgetbv" : "=a"(xcr0_low), "=d"(xcr0_high) : "c"(0));
+  const uint64_t xcr0 = (uint64_t(xcr0_high) << 32) | xcr0_low;
+#  endif
+  if ((xcr0 & 0x6) != 0x6) {
+    return 0;
+  }
+  __cpuidex(result, 0x00000007, 0);
+  return (result[1] & (int(1) << 5)) != 0;
+#else
+  return 0;
+#endif
+}
+
 void BLI_hostname_get(char *buffer, size_t bufsize)
 {
 #ifndef WIN32
@@ -380,6 +380,21 @@ TEST(bit_span, or_bools_into_bits)
   }
 }
 
+TEST(bit_span, or_bools_inverse_into_bits)
+{
+  Vector<bool> bools(100, true);
+  bools[3] = false;
+  bools[40] = false;
+  bools[99] = false;
+  BitVector<> bits(200, false);
+  MutableBitSpan dst = MutableBitSpan(bits).slice(IndexRange::from_begin_size(50, 100));
+  EXPECT_TRUE(bits::or_bools_inverse_into_bits(bools, dst));
+  for (const int64_t i : bits.index_range()) {
+    EXPECT_EQ(bool(bits[i]), ELEM(i, 53, 90, 149));
+  }
+  EXPECT_FALSE(bits::or_bools_inverse_into_bits(Vector<bool>(20, true), bits));
+}
+
 TEST(bit_span, to_index_ranges_small)
 {
   BitVector<> bits(10, false);
@@ -256,6 +256,40 @@ TEST(csv_parse, ParseCsvTrailingNewline)
   EXPECT_EQ(result.records[1][0], "2");
 }
 
+TEST(csv_parse, ParseCsvIndexedChunks)
+{
+  CsvParseOptions options;
+  options.chunk_size_bytes = 1;
+  const auto parse = [&](const StringRef str) {
+    return parse_csv_in_indexed_chunks(
+        Span<char>(str),
+        options,
+        [&](const CsvRecord & /*record*/) {},
+        [&](const int64_t chunk_index, const CsvRecords &records) {
+          return Any<>(std::pair<int64_t, int64_t>(chunk_index, records.size()));
+        });
+  };
+  {
+    const std::optional<Vector<Any<>>> chunks = parse("a\n1\n2\n3\n");
+    ASSERT_TRUE(chunks.has_value());
+    ASSERT_EQ(chunks->size(), 3);
+    for (const int64_t i : chunks->index_range()) {
+      const auto &chunk = (*chunks)[i].get<std::pair<int64_t, int64_t>>();
+      EXPECT_EQ(chunk.first, i);
+      EXPECT_EQ(chunk.second, 1);
+    }
+  }
+  {
+    /* The multi-line field is split at first, so everything is parsed as a single chunk. */
+    const std::optional<Vector<Any<>>> chunks = parse("a\n\"1\n2\"\n3\n");
+    ASSERT_TRUE(chunks.has_value());
+    ASSERT_EQ(chunks->size(), 1);
+    const auto &chunk = (*chunks)[0].get<std::pair<int64_t, int64_t>>();
+    EXPECT_EQ(chunk.first, 0);
+    EXPECT_EQ(chunk.second, 2);
+  }
+}
+
 TEST(csv_parse, UnescapeField)
 {
   LinearAllocator<> allocator;
@@ -322,6 +322,54 @@ TEST(expr_pylike, UsingParam)
   BLI_expr_pylike_free(expr);
 }
 
+TEST(expr_pylike, Attributes)
+{
+  const char *names[2] = {"x", "y"};
+  const double values[5] = {1.0, 2.0, 10.0, 20.0, 30.0};
+
+  ExprPyLike_Parsed *expr = BLI_expr_pylike_parse(
+      "x + y.location[2] + y.scale.z + y[0] - y.location[2]", names, ARRAY_SIZE(names));
+
+  EXPECT_TRUE(BLI_expr_pylike_is_valid(expr));
+  EXPECT_TRUE(BLI_expr_pylike_is_using_param(expr, 0));
+  EXPECT_FALSE(BLI_expr_pylike_is_using_param(expr, 1));
+  EXPECT_FALSE(BLI_expr_pylike_is_using_attribute_of_param(expr, 0));
+  EXPECT_TRUE(BLI_expr_pylike_is_using_attribute_of_param(expr, 1));
+
+  /* Identical attribute accesses share their value. */
+  ASSERT_EQ(BLI_expr_pylike_attributes_len(expr), 3);
+
+  int param_index;
+  EXPECT_STREQ(BLI_expr_pylike_attribute_get(expr, 0, &param_index), "location[2]");
+  EXPECT_EQ(param_index, 1);
+  EXPECT_STREQ(BLI_expr_pylike_attribute_get(expr, 1, &param_index), "scale.z");
+  EXPECT_EQ(param_index, 1);
+  EXPECT_STREQ(BLI_expr_pylike_attribute_get(expr, 2, &param_index), "[0]");
+  EXPECT_EQ(param_index, 1);
+
+  double result;
+  EXPECT_EQ(BLI_expr_pylike_eval(expr, values, 2, &result), EXPR_PYLIKE_FATAL_ERROR);
+
+  eExprPyLike_EvalStatus status = BLI_expr_pylike_eval(expr, values, 5, &result);
+
+  EXPECT_EQ(status, EXPR_PYLIKE_SUCCESS);
+  EXPECT_EQ(result, 51.0);
+
+  BLI_expr_pylike_free(expr);
+}
+
+TEST(expr_pylike, AttributesParseFail)
+{
+  const char *names[1] = {"x"};
+  const char *expressions[] = {"x.", "x.1", "x[", "x[0", "x[-1]", "x[0.5]", "x.a[x]", "pi.a"};
+
+  for (const char *str : expressions) {
+    ExprPyLike_Parsed *expr = BLI_expr_pylike_parse(str, names, ARRAY_SIZE(names));
+    EXPECT_FALSE(BLI_expr_pylike_is_valid(expr)) << str;
+    BLI_expr_pylike_free(expr);
+  }
+}
+
 #define TEST_ERROR(name, str, x, code) \
   TEST(expr_pylike, Error_##name) \
   { \
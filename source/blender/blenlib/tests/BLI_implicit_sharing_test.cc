@@ -4,6 +4,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_implicit_sharing.hh"
 #include "BLI_implicit_sharing_ptr.hh"
 
 #include "testing/testing.h"
@@ -114,4 +115,28 @@ TEST(implicit_sharing, Version)
   EXPECT_LT(old_version, sharing_info->version());
 }
 
+TEST(implicit_sharing, CopyOnWriteStats)
+{
+  int *data = MEM_calloc_arrayN<int>(10, __func__);
+  const ImplicitSharingInfo *sharing_info = implicit_sharing::info_for_mem_free(data);
+  const implicit_sharing::CopyOnWriteStats old_stats =
+      implicit_sharing::thread_copy_on_write_stats();
+
+  /* Data that has a single user is not copied. */
+  implicit_sharing::make_trivial_data_mutable(&data, &sharing_info, 10);
+  EXPECT_EQ(implicit_sharing::thread_copy_on_write_stats().copies_num, old_stats.copies_num);
+
+  sharing_info->add_user();
+  const int *old_data = data;
+  const ImplicitSharingInfo *old_sharing_info = sharing_info;
+  implicit_sharing::make_trivial_data_mutable(&data, &sharing_info, 10);
+  EXPECT_NE(data, old_data);
+  const implicit_sharing::CopyOnWriteStats &stats = implicit_sharing::thread_copy_on_write_stats();
+  EXPECT_EQ(stats.copies_num, old_stats.copies_num + 1);
+  EXPECT_EQ(stats.copied_bytes, old_stats.copied_bytes + int64_t(sizeof(int)) * 10);
+
+  old_sharing_info->remove_user_and_delete_if_last();
+  sharing_info->remove_user_and_delete_if_last();
+}
+
 }  // namespace blender::tests
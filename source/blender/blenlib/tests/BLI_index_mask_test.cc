@@ -14,6 +14,7 @@
 #include "BLI_rand.hh"
 #include "BLI_set.hh"
 #include "BLI_timeit.hh"
+#include "BLI_virtual_array.hh"
 
 #include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
 
@@ -287,6 +288,45 @@ TEST(index_mask, FromBitsFuzzy)
   }
 }
 
+TEST(index_mask, FromBoolsFuzzy)
+{
+  RandomNumberGenerator rng(0);
+  for ([[maybe_unused]] const int64_t iteration : IndexRange(10)) {
+    const int size = rng.get_int32(100'000) + 1;
+    /* Mix runs of true and false values with randomly set values. */
+    Array<bool> bools(size);
+    for (int64_t i = 0; i < size;) {
+      const int64_t run_size = std::min<int64_t>(rng.get_int32(500) + 1, size - i);
+      const int mode = rng.get_int32(3);
+      for (const int64_t j : IndexRange(i, run_size)) {
+        bools[j] = mode == 2 ? rng.get_int32(2) == 0 : mode == 1;
+      }
+      i += run_size;
+    }
+    const VArray<bool> virtual_bools = VArray<bool>::ForFunc(
+        size, [&](const int64_t i) { return bools[i]; });
+
+    IndexMaskMemory memory;
+    const int64_t half_size = size / 2;
+    const IndexMask universe = IndexMask::from_union(
+        IndexRange(half_size),
+        IndexMask::from_repeating(IndexRange(1), (size - half_size + 1) / 2, 2, half_size, memory),
+        memory);
+
+    const IndexMask expected = IndexMask::from_predicate(
+        universe, GrainSize(1024), memory, [&](const int64_t i) { return bools[i]; });
+    const IndexMask expected_inverse = IndexMask::from_predicate(
+        universe, GrainSize(1024), memory, [&](const int64_t i) { return !bools[i]; });
+
+    EXPECT_EQ(IndexMask::from_bools(universe, bools.as_span(), memory), expected);
+    EXPECT_EQ(IndexMask::from_bools(universe, virtual_bools, memory), expected);
+    EXPECT_EQ(IndexMask::from_bools_inverse(universe, bools.as_span(), memory), expected_inverse);
+    EXPECT_EQ(IndexMask::from_bools_inverse(universe, virtual_bools, memory), expected_inverse);
+    EXPECT_EQ(IndexMask::from_bools(virtual_bools, memory),
+              IndexMask::from_bools(bools.as_span(), memory));
+  }
+}
+
 TEST(index_mask, FromBitsDense)
 {
   BitVector bit_vec(1'000, true);
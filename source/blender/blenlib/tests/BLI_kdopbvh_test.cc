@@ -8,10 +8,12 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_array.hh"
 #include "BLI_compiler_attrs.h"
 #include "BLI_kdopbvh.hh"
 #include "BLI_math_vector.h"
 #include "BLI_rand.h"
+#include "BLI_timeit.hh"
 
 /* -------------------------------------------------------------------- */
 /* Helper Functions */
@@ -68,8 +70,12 @@ static void optimal_check_callback(void *userdata,
  * Note that a small epsilon is added to the BVH nodes bounds, even if we pass in zero.
  * Use rounding to ensure very close nodes don't cause the wrong node to be found as nearest.
  */
-static void find_nearest_points_test(
-    int points_len, float scale, int round, int random_seed, bool optimal = false)
+static void find_nearest_points_test(int points_len,
+                                     float scale,
+                                     int round,
+                                     int random_seed,
+                                     bool optimal = false,
+                                     bool parallel_insert = false)
 {
   RNG *rng = BLI_rng_new(random_seed);
   BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 8, 8);
@@ -79,7 +85,15 @@ static void find_nearest_points_test(
 
   for (int i = 0; i < points_len; i++) {
     rng_v3_round(points[i], 3, rng, round, scale);
-    BLI_bvhtree_insert(tree, i, points[i], 1);
+    if (!parallel_insert) {
+      BLI_bvhtree_insert(tree, i, points[i], 1);
+    }
+  }
+  if (parallel_insert) {
+    BLI_bvhtree_insert_parallel(tree, points_len, 1, [&](const int i, blender::float3 *r_co) {
+      r_co[0] = points[i];
+      return i;
+    });
   }
   BLI_bvhtree_balance(tree);
 
@@ -134,3 +148,59 @@ TEST(kdopbvh, OptimalFindNearest_500)
 {
   find_nearest_points_test(500, 1.0, 1000, 12, true);
 }
+
+TEST(kdopbvh, ParallelFindNearest_500)
+{
+  find_nearest_points_test(500, 1.0, 1000, 12, false, true);
+}
+TEST(kdopbvh, ParallelFindNearest_100000)
+{
+  find_nearest_points_test(100000, 1.0, 1000, 12, false, true);
+}
+TEST(kdopbvh, ParallelOptimalFindNearest_100000)
+{
+  find_nearest_points_test(100000, 1.0, 10000, 34, true, true);
+}
+
+/* Disable benchmark by default. */
+#if 0
+/**
+ * Time the construction of large trees, and the queries on them to compare the tree quality.
+ */
+TEST(kdopbvh, Benchmark)
+{
+  const int points_len = 10'000'000;
+  RNG *rng = BLI_rng_new(0);
+  blender::Array<blender::float3> points(points_len);
+  for (blender::float3 &point : points) {
+    rng_v3_round(point, 3, rng, 1 << 20, 1.0f);
+  }
+
+  for (const bool parallel_insert : {false, true}) {
+    BVHTree *tree = BLI_bvhtree_new(points_len, 0.0, 2, 6);
+    {
+      SCOPED_TIMER(parallel_insert ? "Build parallel" : "Build");
+      if (parallel_insert) {
+        BLI_bvhtree_insert_parallel(tree, points_len, 1, [&](const int i, blender::float3 *r_co) {
+          r_co[0] = points[i];
+          return i;
+        });
+      }
+      else {
+        for (const int i : points.index_range()) {
+          BLI_bvhtree_insert(tree, i, points[i], 1);
+        }
+      }
+      BLI_bvhtree_balance(tree);
+    }
+    {
+      SCOPED_TIMER("Find nearest");
+      for (const int i : blender::IndexRange(points_len / 10)) {
+        BLI_bvhtree_find_nearest(tree, points[i * 10], nullptr, nullptr, nullptr);
+      }
+    }
+    BLI_bvhtree_free(tree);
+  }
+  BLI_rng_free(rng);
+}
+#endif
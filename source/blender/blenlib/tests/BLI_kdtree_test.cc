@@ -5,7 +5,10 @@
 #include "testing/testing.h"
 
 #include "BLI_kdtree.h"
+#include "BLI_rand.hh"
+#include "BLI_vector.hh"
 
+#include <array>
 #include <cmath>
 
 /* -------------------------------------------------------------------- */
@@ -54,6 +57,62 @@ static void deduplicate_test()
   }
 }
 
+/* Large enough to balance in parallel and to process the queries in Morton order. */
+static void batch_test()
+{
+  blender::RandomNumberGenerator rng(0);
+  const int tree_size = 20000;
+  const int queries_num = 5000;
+  const uint neighbors_num = 5;
+
+  KDTree_3d *tree = BLI_kdtree_3d_new(tree_size);
+  for (int i = 0; i < tree_size; i++) {
+    const float co[3] = {rng.get_float(), rng.get_float(), rng.get_float() * 0.1f};
+    BLI_kdtree_3d_insert(tree, i, co);
+  }
+  BLI_kdtree_3d_balance(tree);
+
+  blender::Vector<std::array<float, 3>> queries(queries_num);
+  for (std::array<float, 3> &co : queries) {
+    co = {rng.get_float() * 1.2f - 0.1f, rng.get_float(), rng.get_float()};
+  }
+  const float (*queries_co)[3] = reinterpret_cast<const float (*)[3]>(queries.data());
+
+  blender::Vector<KDTreeNearest_3d> nearest(queries_num);
+  BLI_kdtree_3d_find_nearest_batch(tree, queries_co, queries_num, nearest.data());
+  blender::Vector<KDTreeNearest_3d> nearest_n(queries_num * neighbors_num);
+  blender::Vector<int> nearest_n_len(queries_num);
+  BLI_kdtree_3d_find_nearest_n_batch(
+      tree, queries_co, queries_num, nearest_n.data(), neighbors_num, nearest_n_len.data());
+
+  for (int i = 0; i < queries_num; i++) {
+    KDTreeNearest_3d expected;
+    EXPECT_EQ(BLI_kdtree_3d_find_nearest(tree, queries_co[i], &expected), nearest[i].index);
+    EXPECT_EQ(expected.dist, nearest[i].dist);
+
+    KDTreeNearest_3d expected_n[neighbors_num];
+    const int expected_len = BLI_kdtree_3d_find_nearest_n(
+        tree, queries_co[i], expected_n, neighbors_num);
+    EXPECT_EQ(expected_len, nearest_n_len[i]);
+    for (int j = 0; j < expected_len; j++) {
+      EXPECT_EQ(expected_n[j].index, nearest_n[i * neighbors_num + j].index);
+    }
+  }
+  BLI_kdtree_3d_free(tree);
+
+  /* An empty tree finds nothing. */
+  KDTree_3d *empty_tree = BLI_kdtree_3d_new(0);
+  BLI_kdtree_3d_balance(empty_tree);
+  BLI_kdtree_3d_find_nearest_batch(empty_tree, queries_co, queries_num, nearest.data());
+  BLI_kdtree_3d_find_nearest_n_batch(
+      empty_tree, queries_co, queries_num, nearest_n.data(), neighbors_num, nearest_n_len.data());
+  for (int i = 0; i < queries_num; i++) {
+    EXPECT_EQ(nearest[i].index, -1);
+    EXPECT_EQ(nearest_n_len[i], 0);
+  }
+  BLI_kdtree_3d_free(empty_tree);
+}
+
 TEST(kdtree, Standard)
 {
   standard_test();
@@ -63,3 +122,8 @@ TEST(kdtree, Deduplicate)
 {
   deduplicate_test();
 }
+
+TEST(kdtree, Batch)
+{
+  batch_test();
+}
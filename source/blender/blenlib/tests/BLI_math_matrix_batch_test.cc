@@ -0,0 +1,72 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_cpu_dispatch.hh"
+#include "BLI_math_matrix.hh"
+#include "BLI_math_matrix_batch.hh"
+#include "BLI_rand.hh"
+#include "BLI_string_ref.hh"
+
+#include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
+
+namespace blender::tests {
+
+static Array<float3> random_vectors(const int size)
+{
+  RandomNumberGenerator rng(42);
+  Array<float3> vectors(size);
+  for (float3 &vector : vectors) {
+    vector = rng.get_unit_float3() * rng.get_float() * 100.0f;
+  }
+  return vectors;
+}
+
+static float4x4 test_transform()
+{
+  return math::from_loc_rot_scale<float4x4>(
+      float3(1.0f, -2.0f, 3.0f), math::EulerXYZ(0.3f, -1.2f, 2.5f), float3(0.5f, 2.0f, 3.0f));
+}
+
+TEST(math_matrix_batch, TransformPoints)
+{
+  const float4x4 transform = test_transform();
+  /* Sizes that are not a multiple of the vector width of any instruction set. */
+  for (const int size : {0, 1, 7, 1001}) {
+    const Array<float3> src = random_vectors(size);
+    Array<float3> dst(size);
+    math::transform_points(src, transform, dst);
+    Array<float3> in_place = src;
+    math::transform_points(transform, in_place);
+    for (const int i : src.index_range()) {
+      const float3 expected = math::transform_point(transform, src[i]);
+      EXPECT_V3_NEAR(dst[i], expected, 1e-3f);
+      EXPECT_V3_NEAR(in_place[i], expected, 1e-3f);
+    }
+  }
+}
+
+TEST(math_matrix_batch, TransformDirections)
+{
+  const float3x3 transform = math::transpose(math::invert(float3x3(test_transform())));
+  const Array<float3> src = random_vectors(1001);
+  Array<float3> dst = src;
+  math::transform_directions(transform, dst);
+  for (const int i : src.index_range()) {
+    const float3 expected = transform * src[i];
+    EXPECT_V3_NEAR(dst[i], expected, 1e-3f);
+  }
+}
+
+TEST(cpu_dispatch, BestISA)
+{
+  /* The result is cached. */
+  const cpu_dispatch::ISA isa = cpu_dispatch::best_isa();
+  EXPECT_EQ(cpu_dispatch::best_isa(), isa);
+  EXPECT_NE(StringRef(cpu_dispatch::isa_name(isa)), "");
+}
+
+}  // namespace blender::tests
@@ -2,6 +2,9 @@
  *
  * SPDX-License-Identifier: Apache-2.0 */
 
+#include <chrono>
+#include <thread>
+
 #include "BLI_hash.hh"
 #include "BLI_memory_cache.hh"
 #include "BLI_memory_counter.hh"
@@ -56,6 +59,54 @@ class CachedInt : public memory_cache::CachedValue {
   }
 };
 
+class CachedBytes : public memory_cache::CachedValue {
+ public:
+  int64_t bytes;
+  StringRefNull category_name;
+
+  CachedBytes(const int64_t bytes, const StringRefNull category_name)
+      : bytes(bytes), category_name(category_name)
+  {
+  }
+
+  void count_memory(MemoryCounter &memory) const override
+  {
+    memory.add(bytes);
+  }
+
+  StringRefNull category() const override
+  {
+    return category_name;
+  }
+};
+
+static const CategoryStatistics *find_category(const Statistics &statistics, const StringRef name)
+{
+  for (const CategoryStatistics &category : statistics.categories) {
+    if (category.name == name) {
+      return &category;
+    }
+  }
+  return nullptr;
+}
+
+static void add_bytes(const int key, const int64_t bytes, const StringRefNull category)
+{
+  memory_cache::get<CachedBytes>(GenericIntKey(key), [&]() {
+    return std::make_unique<CachedBytes>(bytes, category);
+  });
+}
+
+static bool is_cached(const int key)
+{
+  bool is_cached = true;
+  memory_cache::get<CachedInt>(GenericIntKey(key), [&]() {
+    is_cached = false;
+    return std::make_unique<CachedInt>(0);
+  });
+  return is_cached;
+}
+
 TEST(memory_cache, Simple)
 {
   memory_cache::clear();
@@ -105,4 +156,87 @@ TEST(memory_cache, RemoveIf)
                })->value);
 }
 
+TEST(memory_cache, Statistics)
+{
+  memory_cache::clear();
+  add_bytes(100, 1000, "Test Statistics");
+  add_bytes(100, 1000, "Test Statistics");
+  add_bytes(101, 500, "Test Statistics");
+
+  const Statistics statistics = memory_cache::get_statistics();
+  const CategoryStatistics *category = find_category(statistics, "Test Statistics");
+  ASSERT_NE(category, nullptr);
+  EXPECT_EQ(category->size_in_bytes, 1500);
+  EXPECT_EQ(category->values_num, 2);
+  EXPECT_EQ(category->hits, 1);
+  EXPECT_EQ(category->misses, 2);
+  EXPECT_FALSE(category->is_external);
+  EXPECT_GE(statistics.size_in_bytes, 1500);
+
+  memory_cache::clear();
+  EXPECT_EQ(find_category(memory_cache::get_statistics(), "Test Statistics")->size_in_bytes, 0);
+}
+
+TEST(memory_cache, CategoryLimit)
+{
+  memory_cache::clear();
+  memory_cache::set_category_size_limit("Test Limited", 1000);
+  for (int i = 0; i < 10; i++) {
+    add_bytes(200 + i, 200, "Test Limited");
+    add_bytes(300 + i, 200, "Test Unlimited");
+  }
+  const Statistics statistics = memory_cache::get_statistics();
+  const CategoryStatistics *limited = find_category(statistics, "Test Limited");
+  const CategoryStatistics *unlimited = find_category(statistics, "Test Unlimited");
+  EXPECT_LE(limited->size_in_bytes, 1000);
+  EXPECT_GT(limited->evictions, 0);
+  EXPECT_EQ(limited->size_limit, 1000);
+  EXPECT_EQ(unlimited->size_in_bytes, 2000);
+  EXPECT_EQ(unlimited->evictions, 0);
+
+  memory_cache::set_category_size_limit("Test Limited", std::nullopt);
+  memory_cache::clear();
+}
+
+TEST(memory_cache, ExternalUsage)
+{
+  memory_cache::clear();
+  memory_cache::set_approximate_size_limit(10000);
+  for (int i = 0; i < 10; i++) {
+    add_bytes(400 + i, 500, "Test");
+  }
+  EXPECT_EQ(memory_cache::get_statistics().size_in_bytes, 5000);
+
+  /* Memory used by another cache makes room by freeing values in this cache. */
+  memory_cache::set_external_usage("Test External", 8000);
+  Statistics statistics = memory_cache::get_statistics();
+  EXPECT_LE(statistics.size_in_bytes, 2000);
+  EXPECT_EQ(statistics.external_size_in_bytes, 8000);
+  EXPECT_TRUE(find_category(statistics, "Test External")->is_external);
+
+  memory_cache::set_external_usage("Test External", 0);
+  memory_cache::set_approximate_size_limit(1024 * 1024 * 1024);
+  memory_cache::clear();
+}
+
+TEST(memory_cache, ExpensiveValuesAreKept)
+{
+  memory_cache::clear();
+  memory_cache::set_approximate_size_limit(2000);
+  memory_cache::get<CachedBytes>(GenericIntKey(500), []() {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+    return std::make_unique<CachedBytes>(100, "Test");
+  });
+  /* Many values that are cheap to compute are added afterwards, which exceeds the limit a few
+   * times. The expensive value is older, but is kept anyway. */
+  for (int i = 0; i < 100; i++) {
+    add_bytes(600 + i, 100, "Test");
+  }
+  EXPECT_GT(find_category(memory_cache::get_statistics(), "Test")->evictions, 0);
+  EXPECT_TRUE(is_cached(500));
+
+  memory_cache::set_approximate_size_limit(1024 * 1024 * 1024);
+  memory_cache::clear();
+}
+
 }  // namespace blender::memory_cache::tests
@@ -0,0 +1,80 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_noise.hh"
+#include "BLI_rand.hh"
+
+#include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
+
+namespace blender::tests {
+
+static Array<float3> random_positions(const int size, const float scale)
+{
+  RandomNumberGenerator rng(42);
+  Array<float3> positions(size);
+  for (float3 &position : positions) {
+    position = (float3(rng.get_float(), rng.get_float(), rng.get_float()) - 0.5f) * scale;
+  }
+  return positions;
+}
+
+TEST(noise_batch, PerlinFBMSameAsSingle)
+{
+  /* Also test positions that are affected by the precision correction. */
+  for (const float scale : {10.0f, 3000000.0f}) {
+    /* Sizes that are not a multiple of the block size. */
+    for (const int size : {0, 1, 17, 1000}) {
+      const Array<float3> positions = random_positions(size, scale);
+      for (const float detail : {0.0f, 2.0f, 3.5f}) {
+        for (const bool normalize : {false, true}) {
+          Array<float> values(size);
+          noise::perlin_fbm(positions, detail, 0.6f, 2.1f, normalize, values);
+          for (const int i : positions.index_range()) {
+            EXPECT_EQ(values[i],
+                      noise::perlin_fbm<float3>(positions[i], detail, 0.6f, 2.1f, normalize));
+          }
+        }
+      }
+    }
+  }
+}
+
+TEST(noise_batch, VoronoiF1SameAsSingle)
+{
+  const Array<float3> coords = random_positions(1000, 20.0f);
+  noise::VoronoiParams params{};
+  params.randomness = 0.8f;
+  params.exponent = 1.5f;
+  /* Euclidean, Manhattan, Chebychev and Minkowski. */
+  for (const int metric : {0, 1, 2, 3}) {
+    params.metric = metric;
+    Array<float> distances(coords.size());
+    Array<float3> colors(coords.size());
+    Array<float3> positions(coords.size());
+    noise::voronoi_f1(params, coords, distances, colors, positions);
+    for (const int i : coords.index_range()) {
+      const noise::VoronoiOutput output = noise::voronoi_f1(params, coords[i]);
+      EXPECT_EQ(distances[i], output.distance);
+      EXPECT_EQ(colors[i], output.color);
+      EXPECT_EQ(positions[i], output.position.xyz());
+    }
+  }
+}
+
+TEST(noise_batch, VoronoiF1UnusedOutputs)
+{
+  const Array<float3> coords = random_positions(100, 20.0f);
+  noise::VoronoiParams params{};
+  params.randomness = 1.0f;
+  Array<float> distances(coords.size());
+  noise::voronoi_f1(params, coords, distances, {}, {});
+  for (const int i : coords.index_range()) {
+    EXPECT_EQ(distances[i], noise::voronoi_f1(params, coords[i]).distance);
+  }
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,81 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include "BLI_array.hh"
+#include "BLI_scratch_allocator.hh"
+
+#include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
+
+namespace blender::tests {
+
+static bool is_aligned(void *ptr, uint alignment)
+{
+  BLI_assert(is_power_of_2(int(alignment)));
+  return (POINTER_AS_UINT(ptr) & (alignment - 1)) == 0;
+}
+
+TEST(scratch_allocator, AllocationAlignment)
+{
+  ScratchScope scratch;
+  EXPECT_TRUE(is_aligned(scratch.allocate(10, 4), 4));
+  EXPECT_TRUE(is_aligned(scratch.allocate(10, 8), 8));
+  EXPECT_TRUE(is_aligned(scratch.allocate(10, 64), 64));
+  EXPECT_TRUE(is_aligned(scratch.allocate(1000000, 16), 16));
+  EXPECT_TRUE(is_aligned(scratch.allocate(10, 128), 128));
+}
+
+TEST(scratch_allocator, ReuseAfterScope)
+{
+  void *first;
+  {
+    ScratchScope scratch;
+    first = scratch.allocate(100, 8);
+  }
+  {
+    ScratchScope scratch;
+    EXPECT_EQ(scratch.allocate(100, 8), first);
+  }
+}
+
+TEST(scratch_allocator, NestedScopes)
+{
+  ScratchScope outer;
+  int *a = static_cast<int *>(outer.allocate(sizeof(int), alignof(int)));
+  *a = 42;
+  void *inner_ptr;
+  {
+    ScratchScope inner;
+    inner_ptr = inner.allocate(1000000, 8);
+    memset(inner_ptr, 0, 1000000);
+  }
+  EXPECT_EQ(*a, 42);
+  /* Memory of the inner scope is reused by the outer scope. */
+  EXPECT_EQ(outer.allocate(1000000, 8), inner_ptr);
+}
+
+TEST(scratch_allocator, Array)
+{
+  const ScratchAllocatorStats stats_before = scratch_allocator_stats();
+  {
+    ScratchScope scratch;
+    Array<int, 0, ScratchAllocator> array(1000, 5, scratch.allocator());
+    EXPECT_EQ(array.size(), 1000);
+    EXPECT_EQ(array[999], 5);
+    Array<int, 0, ScratchAllocator> copy = array;
+    EXPECT_EQ(copy[0], 5);
+  }
+  const ScratchAllocatorStats stats_after = scratch_allocator_stats();
+  EXPECT_GE(stats_after.allocations_num - stats_before.allocations_num, 2);
+  EXPECT_GE(stats_after.allocated_bytes - stats_before.allocated_bytes, 2000 * int64_t(sizeof(int)));
+}
+
+TEST(scratch_allocator, DefaultAllocatorWithoutScope)
+{
+  Array<int, 0, ScratchAllocator> array(1000, 3);
+  EXPECT_EQ(array[500], 3);
+}
+
+}  // namespace blender::tests
@@ -0,0 +1,251 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include <string>
+
+#include "testing/testing.h"
+
+#include "BLI_exception_safety_test_utils.hh"
+#include "BLI_map.hh"
+#include "BLI_rand.hh"
+#include "BLI_string_ref.hh"
+#include "BLI_swiss_map.hh"
+#include "BLI_vector.hh"
+
+#include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
+
+namespace blender::tests {
+
+TEST(swiss_map, DefaultConstructor)
+{
+  SwissMap<int, float> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(5));
+  EXPECT_EQ(map.lookup_ptr(5), nullptr);
+  EXPECT_EQ(map.capacity(), 0);
+}
+
+TEST(swiss_map, ItemsConstructor)
+{
+  SwissMap<int, std::string> map = {{1, "where"}, {3, "when"}, {5, "why"}, {1, "ignored"}};
+  EXPECT_EQ(map.size(), 3);
+  EXPECT_EQ(map.lookup(1), "where");
+  EXPECT_EQ(map.lookup(3), "when");
+  EXPECT_EQ(map.lookup(5), "why");
+}
+
+TEST(swiss_map, AddLookupRemove)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_TRUE(map.add(i, i * 2));
+  }
+  EXPECT_FALSE(map.add(5, 0));
+  EXPECT_EQ(map.size(), 1000);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(map.lookup(i), i * 2);
+  }
+  EXPECT_EQ(map.lookup_default(1000, -1), -1);
+  for (int i = 0; i < 1000; i += 2) {
+    EXPECT_TRUE(map.remove(i));
+  }
+  EXPECT_FALSE(map.remove(0));
+  EXPECT_EQ(map.size(), 500);
+  for (int i = 0; i < 1000; i++) {
+    EXPECT_EQ(map.contains(i), i % 2 == 1);
+  }
+}
+
+TEST(swiss_map, AddOverwrite)
+{
+  SwissMap<int, float> map;
+  EXPECT_TRUE(map.add_overwrite(3, 6.0f));
+  EXPECT_FALSE(map.add_overwrite(3, 7.0f));
+  EXPECT_EQ(map.lookup(3), 7.0f);
+  EXPECT_EQ(map.size(), 1);
+}
+
+TEST(swiss_map, LookupOrAdd)
+{
+  SwissMap<std::string, int> map;
+  int &value = map.lookup_or_add_default("a");
+  EXPECT_EQ(value, 0);
+  value = 5;
+  EXPECT_EQ(map.lookup_or_add("a", 10), 5);
+  EXPECT_EQ(map.lookup_or_add_cb("b", []() { return 8; }), 8);
+  EXPECT_EQ(map.lookup_or_add_cb("b", []() { return 9; }), 8);
+  EXPECT_EQ(map.size(), 2);
+}
+
+TEST(swiss_map, Pop)
+{
+  SwissMap<int, std::string> map = {{1, "a"}, {2, "b"}};
+  EXPECT_EQ(map.pop(1), "a");
+  EXPECT_EQ(map.pop_try(1), std::nullopt);
+  EXPECT_EQ(map.pop_try(2), "b");
+  EXPECT_EQ(map.pop_default(2, "c"), "c");
+  EXPECT_TRUE(map.is_empty());
+}
+
+TEST(swiss_map, LookupAs)
+{
+  SwissMap<std::string, int> map;
+  map.add("hello", 1);
+  map.add("world", 2);
+  EXPECT_EQ(map.lookup_as(StringRef("hello")), 1);
+  EXPECT_TRUE(map.contains_as(StringRef("world")));
+  EXPECT_FALSE(map.contains_as(StringRef("test")));
+  EXPECT_EQ(map.lookup_key_as(StringRef("world")), "world");
+}
+
+TEST(swiss_map, Iterators)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add_new(i, i + 1);
+  }
+  int key_sum = 0;
+  for (const int key : map.keys()) {
+    key_sum += key;
+  }
+  EXPECT_EQ(key_sum, 4950);
+  for (int &value : map.values()) {
+    value *= 2;
+  }
+  int items_num = 0;
+  for (const auto item : map.items()) {
+    EXPECT_EQ(item.value, (item.key + 1) * 2);
+    items_num++;
+  }
+  EXPECT_EQ(items_num, 100);
+  int foreach_num = 0;
+  map.foreach_item([&](const int key, const int value) {
+    EXPECT_EQ(value, (key + 1) * 2);
+    foreach_num++;
+  });
+  EXPECT_EQ(foreach_num, 100);
+}
+
+TEST(swiss_map, RemoveDuringIteration)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add_new(i, i);
+  }
+  using Iter = SwissMap<int, int>::MutableItemIterator;
+  Iter begin = map.items().begin();
+  Iter end = map.items().end();
+  for (Iter iter = begin; iter != end; ++iter) {
+    if ((*iter).key % 3 == 0) {
+      map.remove(iter);
+    }
+  }
+  EXPECT_EQ(map.size(), 66);
+  EXPECT_EQ(map.remove_if([](auto item) { return item.key % 3 == 1; }), 33);
+  EXPECT_EQ(map.size(), 33);
+}
+
+TEST(swiss_map, CopyAndMove)
+{
+  SwissMap<int, std::string> map;
+  for (int i = 0; i < 100; i++) {
+    map.add_new(i, std::to_string(i));
+  }
+  SwissMap<int, std::string> copy = map;
+  EXPECT_EQ(copy, map);
+  SwissMap<int, std::string> moved = std::move(copy);
+  EXPECT_EQ(moved, map);
+  EXPECT_TRUE(copy.is_empty()); /* NOLINT: bugprone-use-after-move */
+  copy.add(1, "1");
+  moved = copy;
+  EXPECT_EQ(moved.size(), 1);
+  EXPECT_NE(moved, map);
+}
+
+TEST(swiss_map, ClearAndReserve)
+{
+  SwissMap<int, int> map;
+  map.reserve(1000);
+  const int64_t capacity = map.capacity();
+  EXPECT_GE(capacity, 1000);
+  for (int i = 0; i < 1000; i++) {
+    map.add_new(i, i);
+  }
+  EXPECT_EQ(map.capacity(), capacity);
+  map.clear_and_keep_capacity();
+  EXPECT_TRUE(map.is_empty());
+  EXPECT_FALSE(map.contains(5));
+  EXPECT_EQ(map.capacity(), capacity);
+  map.add(5, 5);
+  map.clear();
+  EXPECT_EQ(map.capacity(), 0);
+  EXPECT_FALSE(map.contains(5));
+}
+
+TEST(swiss_map, RemovedSlotsAreReused)
+{
+  SwissMap<int, int> map;
+  for (int i = 0; i < 100; i++) {
+    map.add_new(i, i);
+  }
+  const int64_t capacity = map.capacity();
+  /* Adding and removing keys many times must not grow the map. */
+  for (int i = 100; i < 100000; i++) {
+    map.add_new(i, i);
+    map.remove_contained(i - 100);
+  }
+  EXPECT_EQ(map.size(), 100);
+  EXPECT_EQ(map.capacity(), capacity);
+  for (int i = 99900; i < 100000; i++) {
+    EXPECT_EQ(map.lookup(i), i);
+  }
+}
+
+TEST(swiss_map, SameAsMap)
+{
+  RandomNumberGenerator rng(42);
+  SwissMap<int, int> swiss_map;
+  Map<int, int> map;
+  for (int i = 0; i < 100000; i++) {
+    const int key = rng.get_int32(2000);
+    switch (rng.get_int32(4)) {
+      case 0:
+        EXPECT_EQ(swiss_map.add(key, i), map.add(key, i));
+        break;
+      case 1:
+        EXPECT_EQ(swiss_map.add_overwrite(key, i), map.add_overwrite(key, i));
+        break;
+      case 2:
+        EXPECT_EQ(swiss_map.remove(key), map.remove(key));
+        break;
+      case 3:
+        EXPECT_EQ(swiss_map.lookup_try(key), map.lookup_try(key));
+        break;
+    }
+  }
+  EXPECT_EQ(swiss_map.size(), map.size());
+  for (const auto item : map.items()) {
+    EXPECT_EQ(swiss_map.lookup(item.key), item.value);
+  }
+}
+
+TEST(swiss_map, AddNewExceptions)
+{
+  SwissMap<ExceptionThrower, ExceptionThrower> map;
+  ExceptionThrower key1 = 1;
+  key1.throw_during_copy = true;
+  ExceptionThrower value1;
+  EXPECT_ANY_THROW({ map.add_new(key1, value1); });
+  EXPECT_EQ(map.size(), 0);
+  ExceptionThrower key2 = 2;
+  ExceptionThrower value2;
+  value2.throw_during_copy = true;
+  EXPECT_ANY_THROW({ map.add_new(key2, value2); });
+  EXPECT_EQ(map.size(), 0);
+  map.add(3, 3);
+  EXPECT_TRUE(map.contains(3));
+}
+
+}  // namespace blender::tests
@@ -14,6 +14,8 @@
 #include "BLI_mempool.h"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_task_pipeline.hh"
+#include "BLI_vector.hh"
 
 #define ITEMS_NUM 10000
 
@@ -243,3 +245,83 @@ TEST(task, ParallelInvoke)
                                       [&]() { counter++; });
   EXPECT_EQ(counter, 6);
 }
+
+TEST(task, PipelineInOrder)
+{
+  using namespace blender;
+  using namespace blender::threading;
+  int next = 0;
+  Vector<int> result;
+  Pipeline pipeline(4);
+  pipeline.run(PipelineStage{PipelineStageMode::SerialInOrder,
+                             [&]() -> std::optional<int> {
+                               if (next == 1000) {
+                                 return std::nullopt;
+                               }
+                               return next++;
+                             }},
+               PipelineStage{PipelineStageMode::Parallel, [](const int i) { return i * 2; }},
+               PipelineStage{PipelineStageMode::Parallel,
+                             [](const int i) { return std::to_string(i); }},
+               PipelineStage{PipelineStageMode::SerialInOrder,
+                             [&](const std::string &str) { result.append(std::stoi(str)); }});
+  EXPECT_EQ(result.size(), 1000);
+  for (const int i : result.index_range()) {
+    EXPECT_EQ(result[i], i * 2);
+  }
+}
+
+TEST(task, PipelineBoundedItems)
+{
+  using namespace blender::threading;
+  /* The item type does not need a default constructor. */
+  struct Item {
+    int value;
+    explicit Item(const int i) : value(i) {}
+  };
+  const int max_items = 3;
+  int next = 0;
+  std::atomic<int> items_in_flight = 0;
+  std::atomic<int> max_items_in_flight = 0;
+  std::atomic<int> sum = 0;
+  Pipeline pipeline(max_items);
+  pipeline.run(PipelineStage{PipelineStageMode::SerialInOrder,
+                             [&]() -> std::optional<Item> {
+                               if (next == 200) {
+                                 return std::nullopt;
+                               }
+                               const int num = ++items_in_flight;
+                               int prev_max = max_items_in_flight;
+                               while (num > prev_max &&
+                                      !max_items_in_flight.compare_exchange_weak(prev_max, num))
+                               {
+                               }
+                               return Item(next++);
+                             }},
+               PipelineStage{PipelineStageMode::Parallel,
+                             [&](Item item) {
+                               sum += item.value;
+                               items_in_flight--;
+                             }});
+  EXPECT_EQ(sum, 199 * 200 / 2);
+  EXPECT_LE(max_items_in_flight, max_items);
+}
+
+TEST(task, PipelineCancel)
+{
+  using namespace blender::threading;
+  int produced = 0;
+  std::atomic<int> consumed = 0;
+  Pipeline pipeline(2);
+  pipeline.run(PipelineStage{PipelineStageMode::SerialInOrder,
+                             [&]() -> std::optional<int> { return produced++; }},
+               PipelineStage{PipelineStageMode::SerialInOrder, [&](const int i) {
+                               consumed++;
+                               if (i == 10) {
+                                 pipeline.cancel();
+                               }
+                             }});
+  EXPECT_TRUE(pipeline.is_cancelled());
+  EXPECT_GE(consumed, 11);
+  EXPECT_LE(produced, 10 + 2 + 1);
+}
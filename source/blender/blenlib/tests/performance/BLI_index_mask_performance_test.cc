@@ -0,0 +1,122 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: Apache-2.0 */
+
+#include "testing/testing.h"
+
+#include <fmt/format.h>
+#include <iostream>
+
+#include "BLI_array.hh"
+#include "BLI_bit_vector.hh"
+#include "BLI_function_ref.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_rand.hh"
+#include "BLI_timeit.hh"
+#include "BLI_virtual_array.hh"
+
+namespace blender::index_mask::tests {
+
+/* Number of elements in every selection. */
+static constexpr int64_t SELECTION_SIZE = 50'000'000;
+/* The minimum time of all iterations is reported. */
+static constexpr int ITERATIONS = 5;
+
+/** Every element is selected with the given probability. */
+static Array<bool> build_random_selection(const float probability)
+{
+  RandomNumberGenerator rng(0);
+  Array<bool> bools(SELECTION_SIZE);
+  for (bool &value : bools) {
+    value = rng.get_float() < probability;
+  }
+  return bools;
+}
+
+/** Runs of selected and unselected elements with random lengths, like selected mesh islands. */
+static Array<bool> build_clustered_selection(const int max_run_size)
+{
+  RandomNumberGenerator rng(0);
+  Array<bool> bools(SELECTION_SIZE);
+  bool value = false;
+  for (int64_t i = 0; i < SELECTION_SIZE;) {
+    const int64_t run_size = std::min<int64_t>(rng.get_int32(max_run_size) + 1,
+                                               SELECTION_SIZE - i);
+    bools.as_mutable_span().slice(i, run_size).fill(value);
+    value = !value;
+    i += run_size;
+  }
+  return bools;
+}
+
+static void benchmark(const char *name, const FunctionRef<IndexMask(IndexMaskMemory &)> fn)
+{
+  timeit::Nanoseconds min_duration{INT64_MAX};
+  int64_t mask_size = 0;
+  for ([[maybe_unused]] const int i : IndexRange(ITERATIONS)) {
+    IndexMaskMemory memory;
+    const timeit::TimePoint start = timeit::Clock::now();
+    const IndexMask mask = fn(memory);
+    const timeit::TimePoint end = timeit::Clock::now();
+    min_duration = std::min(min_duration, end - start);
+    mask_size = mask.size();
+  }
+  const double ms = double(min_duration.count()) / 1'000'000.0;
+  std::cout << fmt::format("  {:<24} {:>10.3f} ms  ({} selected)\n", name, ms, mask_size);
+}
+
+static void benchmark_selection(const char *name, const Span<bool> bools)
+{
+  std::cout << name << ":\n";
+  const BitVector<> bits(bools);
+  const VArray<bool> virtual_bools = VArray<bool>::ForFunc(
+      bools.size(), [&](const int64_t i) { return bools[i]; });
+  IndexMaskMemory universe_memory;
+  /* Every second index, which makes all universe segments non-ranges. */
+  const IndexMask sparse_universe = IndexMask::from_repeating(
+      IndexRange(1), bools.size() / 2, 2, 0, universe_memory);
+
+  benchmark("from_bools", [&](IndexMaskMemory &memory) {
+    return IndexMask::from_bools(bools, memory);
+  });
+  benchmark("from_bools_inverse", [&](IndexMaskMemory &memory) {
+    return IndexMask::from_bools_inverse(bools.index_range(), bools, memory);
+  });
+  benchmark("from_bools (virtual)", [&](IndexMaskMemory &memory) {
+    return IndexMask::from_bools(virtual_bools, memory);
+  });
+  benchmark("from_bits", [&](IndexMaskMemory &memory) {
+    return IndexMask::from_bits(bits, memory);
+  });
+  benchmark("from_bits (universe)", [&](IndexMaskMemory &memory) {
+    return IndexMask::from_bits(sparse_universe, bits, memory);
+  });
+  benchmark("from_predicate", [&](IndexMaskMemory &memory) {
+    return IndexMask::from_predicate(bools.index_range(),
+                                     GrainSize(4096),
+                                     memory,
+                                     [&](const int64_t i) { return bools[i]; });
+  });
+}
+
+TEST(index_mask_performance, Dense)
+{
+  benchmark_selection("Dense (90% random)", build_random_selection(0.9f));
+}
+
+TEST(index_mask_performance, Sparse)
+{
+  benchmark_selection("Sparse (0.1% random)", build_random_selection(0.001f));
+}
+
+TEST(index_mask_performance, Half)
+{
+  benchmark_selection("Half (50% random)", build_random_selection(0.5f));
+}
+
+TEST(index_mask_performance, Clustered)
+{
+  benchmark_selection("Clustered (runs up to 1000)", build_clustered_selection(1000));
+}
+
+}  // namespace blender::index_mask::tests
@@ -15,6 +15,7 @@
 #include "BLI_math_vector_types.hh"
 #include "BLI_rand.h"
 #include "BLI_string.h"
+#include "BLI_swiss_map.hh"
 #include "BLI_timeit.hh"
 #include "BLI_utildefines.h"
 
@@ -243,6 +244,12 @@ TEST(ghash, TextMap)
   str_map_tests(map, "StrMap - DefaultHash");
 }
 
+TEST(ghash, TextSwissMap)
+{
+  SwissMap<StringRef, int64_t> map;
+  str_map_tests(map, "StrSwissMap - DefaultHash");
+}
+
 /* Int: uniform 100M first integers. */
 
 static void int_ghash_tests(GHash *ghash, const char *id, const uint count)
@@ -370,12 +377,24 @@ TEST(ghash, IntMap12000)
   int_map_tests(map, "IntMap - DefaultHash - 12000", 12000);
 }
 
+TEST(ghash, IntSwissMap12000)
+{
+  SwissMap<int, int> map;
+  int_map_tests(map, "IntSwissMap - DefaultHash - 12000", 12000);
+}
+
 #ifdef USE_BIG_TESTS
 TEST(ghash, IntMap100000000)
 {
   Map<int, int> map;
   int_map_tests(map, "IntMap - DefaultHash - 100000000", 100000000);
 }
+
+TEST(ghash, IntSwissMap100000000)
+{
+  SwissMap<int, int> map;
+  int_map_tests(map, "IntSwissMap - DefaultHash - 100000000", 100000000);
+}
 #endif
 
 /* Int: random 50M integers. */
@@ -497,12 +516,24 @@ TEST(ghash, IntRandMap12000)
   randint_map_tests(map, "RandIntMap - DefaultHash - 12000", 12000);
 }
 
+TEST(ghash, IntRandSwissMap12000)
+{
+  SwissMap<int, int> map;
+  randint_map_tests(map, "RandIntSwissMap - DefaultHash - 12000", 12000);
+}
+
 #ifdef USE_BIG_TESTS
 TEST(ghash, IntRandMap50000000)
 {
   Map<int, int> map;
   randint_map_tests(map, "RandIntMap - DefaultHash - 50000000", 50000000);
 }
+
+TEST(ghash, IntRandSwissMap50000000)
+{
+  SwissMap<int, int> map;
+  randint_map_tests(map, "RandIntSwissMap - DefaultHash - 50000000", 50000000);
+}
 #endif
 
 static uint ghashutil_tests_nohash_p(const void *p)
@@ -660,12 +691,24 @@ TEST(ghash, Int4Map2000)
   int4_map_tests(map, "Int4Map - DefaultHash - 2000", 2000);
 }
 
+TEST(ghash, Int4SwissMap2000)
+{
+  SwissMap<uint4, int> map;
+  int4_map_tests(map, "Int4SwissMap - DefaultHash - 2000", 2000);
+}
+
 #ifdef USE_BIG_TESTS
 TEST(ghash, Int4Map20000000)
 {
   Map<uint4, int> map;
   int4_map_tests(map, "Int4Map - DefaultHash - 20000000", 20000000);
 }
+
+TEST(ghash, Int4SwissMap20000000)
+{
+  SwissMap<uint4, int> map;
+  int4_map_tests(map, "Int4SwissMap - DefaultHash - 20000000", 20000000);
+}
 #endif
 
 /* MultiSmall: create and manipulate a lot of very small ghash's
@@ -533,6 +533,18 @@ void BLO_sanitize_experimental_features_userpref_blend(UserDef *userdef);
  */
 BlendThumbnail *BLO_thumbnail_from_file(const char *filepath);
 
+/**
+ * Does a very light reading of given .blend file to extract the names of its local data-blocks,
+ * from the index stored at the start of the file. Unlike going through #BLO_blendhandle_from_file,
+ * this does not require reading (and decompressing) the whole file.
+ *
+ * \param r_id_names: A list of MEM-allocated ID names, including their two characters ID code
+ * prefix.
+ * \return False if the file could not be read or has no index (e.g. files written by older
+ * versions of Blender, or undo steps).
+ */
+bool BLO_file_index_from_file(const char *filepath, LinkNode **r_id_names);
+
 /**
  * Does a very light reading of given .blend file to extract its version.
  *
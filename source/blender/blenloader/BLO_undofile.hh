@@ -12,6 +12,7 @@
 #include "BLI_filereader.h"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
+#include "BLI_vector.hh"
 
 namespace blender {
 class ImplicitSharingInfo;
@@ -19,15 +20,37 @@ class ImplicitSharingInfo;
 struct Main;
 struct Scene;
 
+struct MemFileChunk;
+
 struct MemFileSharedStorage {
   /**
    * Maps the data pointer to the sharing info that it is owned by.
    */
   blender::Map<const void *, const blender::ImplicitSharingInfo *> map;
+  /**
+   * The keys of #map added while writing each ID, so that they can be shared with the next undo
+   * step when that ID is unchanged, see #BLO_memfile_write_reuse_id.
+   */
+  blender::Map<uint, blender::Vector<const void *>> id_session_uid_data;
 
   ~MemFileSharedStorage();
 };
 
+/**
+ * Buffers of chunks that are only used by a single #MemFile, compressed to save memory while that
+ * undo step is not used, see #BLO_memfile_compress.
+ */
+struct MemFileCompressedStorage {
+  /** Chunks with a null buffer, whose data is stored here, in order. */
+  blender::Vector<MemFileChunk *> chunks;
+  /** Total size of the buffers of #chunks. */
+  size_t size;
+  /** Null when the compressed data is stored in #filepath. */
+  void *compressed_data;
+  size_t compressed_size;
+  char filepath[1024]; /* FILE_MAX */
+};
+
 struct MemFileChunk {
   void *next, *prev;
   const char *buf;
@@ -52,6 +75,8 @@ struct MemFile {
    * without making a copy. This is faster and requires less memory.
    */
   MemFileSharedStorage *shared_storage;
+  /** Null unless the memfile was compressed with #BLO_memfile_compress. */
+  MemFileCompressedStorage *compressed_storage;
 };
 
 struct MemFileWriteData {
@@ -89,6 +114,13 @@ void BLO_memfile_write_init(MemFileWriteData *mem_data,
 void BLO_memfile_write_finalize(MemFileWriteData *mem_data);
 
 void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t size);
+/**
+ * Add the chunks written for the ID with the given session uid in the reference memfile to the
+ * written one, without comparing or copying any data. Used when the ID is known to be unchanged.
+ *
+ * \return False if that ID has no chunks in the reference memfile, it has to be written then.
+ */
+bool BLO_memfile_write_reuse_id(MemFileWriteData *mem_data, uint id_session_uid);
 
 /* exports */
 
@@ -108,6 +140,23 @@ void BLO_memfile_merge(MemFile *first, MemFile *second);
  */
 void BLO_memfile_clear_future(MemFile *memfile);
 
+/**
+ * Compress the buffers of chunks that are not shared with other memfiles. The memfile cannot be
+ * read or used as reference for writing until #BLO_memfile_restore is called.
+ *
+ * \return False if there was nothing to compress.
+ */
+bool BLO_memfile_compress(MemFile *memfile);
+/**
+ * Move the data compressed by #BLO_memfile_compress to a file, to free its memory.
+ */
+bool BLO_memfile_spill(MemFile *memfile, const char *filepath);
+/**
+ * Decompress the chunks compressed by #BLO_memfile_compress, reading them back from disk if
+ * needed.
+ */
+void BLO_memfile_restore(MemFile *memfile);
+
 /* Utilities. */
 
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene);
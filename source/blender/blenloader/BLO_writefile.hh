@@ -56,6 +56,24 @@ extern bool BLO_write_file(Main *mainvar,
                            const BlendFileWriteParams *params,
                            ReportList *reports);
 
+/**
+ * Serialize \a mainvar on the calling thread, but compress and write it to \a filepath on a
+ * background thread, so that the caller does not wait for disk IO. Paths are not remapped and no
+ * backup versions are made. Errors while writing on the background thread are only logged.
+ *
+ * Only one asynchronous write is done at a time, a previous one is waited for first.
+ *
+ * \return Success of the serialization.
+ */
+extern bool BLO_write_file_async(Main *mainvar,
+                                 const char *filepath,
+                                 int write_flags,
+                                 ReportList *reports);
+/**
+ * Block until the file written by #BLO_write_file_async is written completely.
+ */
+extern void BLO_write_file_async_wait();
+
 /**
  * \return Success.
  */
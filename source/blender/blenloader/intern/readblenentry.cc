@@ -29,6 +29,7 @@
 #include "BLO_readfile.hh"
 
 #include "readfile.hh"
+#include "readfile_profile.hh"
 
 #include "BLI_sys_types.h" /* Needed for `intptr_t`. */
 
@@ -304,13 +305,21 @@ BlendFileData *BLO_read_from_file(const char *filepath,
   BlendFileData *bfd = nullptr;
   FileData *fd;
 
+  const bool use_profile = blo_read_profile_begin(filepath);
+  const double profile_time = blo_read_profile_time();
+
   fd = blo_filedata_from_file(filepath, reports);
+  blo_read_profile_phase_end("open", profile_time);
   if (fd) {
     fd->skip_flags = skip_flags;
     bfd = blo_read_file_internal(fd, filepath);
     blo_filedata_free(fd);
   }
 
+  if (use_profile) {
+    blo_read_profile_end();
+  }
+
   return bfd;
 }
 
@@ -48,8 +48,10 @@
 #include "BLI_endian_switch.h"
 #include "BLI_fileops.h"
 #include "BLI_ghash.h"
+#include "BLI_linklist.h"
 #include "BLI_map.hh"
 #include "BLI_memarena.h"
+#include "BLI_mmap.h"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
 #include "BLI_threads.h"
@@ -105,6 +107,7 @@
 #include "SEQ_utils.hh"
 
 #include "readfile.hh"
+#include "readfile_profile.hh"
 #include "versioning_common.hh"
 
 /* Make preferences read-only. */
@@ -244,10 +247,20 @@ struct NewAddress {
 
   /** `nr` is "user count" for data, and ID code for libdata. */
   int nr;
+
+  /**
+   * Data-block whose content has not been read yet, it is read on the first lookup (and #newp is
+   * set then). Only used for #FileData.datamap, see #read_data_into_datamap.
+   */
+  BHead *deferred_bhead;
 };
 
 struct OldNewMap {
   blender::Map<const void *, NewAddress> map;
+
+  /** Lookup statistics, reported when profiling file reading, see #BlendReadProfile. */
+  int64_t lookups_num = 0;
+  int64_t hits_num = 0;
 };
 
 static OldNewMap *oldnewmap_new()
@@ -265,7 +278,7 @@ static bool oldnewmap_insert(OldNewMap *onm, const void *oldaddr, void *newaddr,
     return false;
   }
 
-  return onm->map.add_overwrite(oldaddr, NewAddress{newaddr, nr});
+  return onm->map.add_overwrite(oldaddr, NewAddress{newaddr, nr, nullptr});
 }
 
 static void oldnewmap_lib_insert(FileData *fd, const void *oldaddr, ID *newaddr, const int id_code)
@@ -281,9 +294,19 @@ void blo_do_versions_oldnewmap_insert(OldNewMap *onm,
   oldnewmap_insert(onm, oldaddr, newaddr, nr);
 }
 
-static void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, const bool increase_users)
+static NewAddress *oldnewmap_lookup(OldNewMap *onm, const void *addr)
 {
+  onm->lookups_num++;
   NewAddress *entry = onm->map.lookup_ptr(addr);
+  if (entry != nullptr) {
+    onm->hits_num++;
+  }
+  return entry;
+}
+
+static void *oldnewmap_lookup_and_inc(OldNewMap *onm, const void *addr, const bool increase_users)
+{
+  NewAddress *entry = oldnewmap_lookup(onm, addr);
   if (entry == nullptr) {
     return nullptr;
   }
@@ -310,11 +333,31 @@ static void *oldnewmap_liblookup(OldNewMap *onm, const void *addr, const bool is
   return nullptr;
 }
 
+/** Add the lookup statistics of the map to the profile of the file being read, if any. */
+static void oldnewmap_profile_stats(OldNewMap *onm)
+{
+  BlendReadProfile *profile = blo_read_profile_active();
+  if (profile == nullptr) {
+    return;
+  }
+  profile->address_map.lookups_num += onm->lookups_num;
+  profile->address_map.hits_num += onm->hits_num;
+  profile->address_map.keys_num += onm->map.size();
+  for (const void *key : onm->map.keys()) {
+    profile->address_map.collisions_num += onm->map.count_collisions(key);
+  }
+  onm->lookups_num = 0;
+  onm->hits_num = 0;
+}
+
 static void oldnewmap_clear(OldNewMap *onm)
 {
+  oldnewmap_profile_stats(onm);
+
   /* Free unused data. */
   for (NewAddress &new_addr : onm->map.values()) {
-    if (new_addr.nr == 0) {
+    /* Deferred data that was never looked up was not read in the first place. */
+    if (new_addr.nr == 0 && new_addr.newp != nullptr) {
       MEM_freeN(new_addr.newp);
     }
   }
@@ -323,6 +366,7 @@ static void oldnewmap_clear(OldNewMap *onm)
 
 static void oldnewmap_free(OldNewMap *onm)
 {
+  oldnewmap_profile_stats(onm);
   MEM_delete(onm);
 }
 
@@ -458,6 +502,9 @@ static void read_file_version(FileData *fd, Main *main)
         main->minversionfile = fg->minversion;
         main->minsubversionfile = fg->minsubversion;
         main->is_asset_edit_file = (fg->fileflags & G_FILE_ASSET_EDIT_FILE) != 0;
+        if (fg->fileflags & G_FILE_CROSS_ID_SHARED_DATA) {
+          fd->flags |= FD_FLAGS_CROSS_ID_SHARED_DATA;
+        }
         MEM_freeN(fg);
       }
       else if (bhead->code == BLO_CODE_ENDB) {
@@ -512,6 +559,19 @@ static void read_file_bhead_idname_map_create(FileData *fd)
   }
 }
 
+static BHead *blo_bhead_find_data_by_old_address(FileData *fd, const void *old_address)
+{
+  if (!fd->bhead_data_map) {
+    fd->bhead_data_map.emplace();
+    for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+      if (bhead->code == BLO_CODE_DATA) {
+        fd->bhead_data_map->add(bhead->old, bhead);
+      }
+    }
+  }
+  return fd->bhead_data_map->lookup_default(old_address, nullptr);
+}
+
 static Main *blo_find_main(FileData *fd, const char *filepath, const char *relabase)
 {
   ListBase *mainlist = fd->mainlist;
@@ -665,7 +725,11 @@ static BHeadN *get_bhead(FileData *fd)
           new_bhead->is_memchunk_identical = false;
           new_bhead->bhead = *bhead;
 
-          const int64_t readsize = fd->file->read(fd->file, new_bhead + 1, size_t(bhead->len));
+          int64_t readsize;
+          {
+            BlendReadProfileTimer profile_timer(&BlendReadProfile::file_read_duration);
+            readsize = fd->file->read(fd->file, new_bhead + 1, size_t(bhead->len));
+          }
 
           if (UNLIKELY(readsize != bhead->len)) {
             fd->is_eof = true;
@@ -756,6 +820,7 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
   BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
   off64_t offset_backup = fd->file->offset;
+  BlendReadProfileTimer profile_timer(&BlendReadProfile::file_read_duration);
   if (UNLIKELY(fd->file->seek(fd->file, new_bhead->file_offset, SEEK_SET) == -1)) {
     success = false;
   }
@@ -777,6 +842,45 @@ static bool blo_bhead_read_data(FileData *fd, BHead *thisblock, void *buf)
   return success;
 }
 
+/**
+ * For memory-mapped files, the data of a block that has not been read yet can be accessed in
+ * the mapped memory directly, which avoids a temporary copy when the data is only used as input
+ * (e.g. for DNA struct reconstruction). Returns null when the file is not memory-mapped.
+ *
+ * IO errors are only detected after the memory is accessed, see #blo_bhead_mapped_data_done.
+ */
+static const void *blo_bhead_mapped_data(FileData *fd, BHead *thisblock)
+{
+  BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_assert(new_bhead->has_data == false && new_bhead->file_offset != 0);
+  BLI_mmap_file *mmap_file = BLI_filereader_get_mmap(fd->file);
+  if (mmap_file == nullptr) {
+    return nullptr;
+  }
+  return BLI_mmap_get_range(mmap_file, new_bhead->file_offset, size_t(new_bhead->bhead.len));
+}
+
+/**
+ * Finish reading a block from a memory-mapped file. The mapped pages of the block are released
+ * since it is not expected to be read again, so that they don't count towards the resident memory
+ * in addition to the copy that was made from them.
+ *
+ * \return False if an IO error happened while reading the mapped memory.
+ */
+static bool blo_bhead_mapped_data_done(FileData *fd, BHead *thisblock)
+{
+  BLI_mmap_file *mmap_file = BLI_filereader_get_mmap(fd->file);
+  if (mmap_file == nullptr) {
+    return true;
+  }
+  if (BLI_mmap_has_io_error(mmap_file)) {
+    return false;
+  }
+  const BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
+  BLI_mmap_release_range(mmap_file, new_bhead->file_offset, size_t(new_bhead->bhead.len));
+  return true;
+}
+
 static BHead *blo_bhead_read_full(FileData *fd, BHead *thisblock)
 {
   BHeadN *new_bhead = BHEADN_FROM_BHEAD(thisblock);
@@ -1262,6 +1366,10 @@ void blo_filedata_free(FileData *fd)
   if (fd->bheadmap) {
     MEM_freeN(fd->bheadmap);
   }
+  for (const blender::ImplicitSharingInfoAndData &shared_data : fd->cross_id_shared_data.values())
+  {
+    shared_data.sharing_info->remove_weak_user_and_delete_if_last();
+  }
 
   MEM_delete(fd);
 }
@@ -1299,6 +1407,61 @@ BlendThumbnail *BLO_thumbnail_from_file(const char *filepath)
   return data;
 }
 
+bool BLO_file_index_from_file(const char *filepath, LinkNode **r_id_names)
+{
+  *r_id_names = nullptr;
+  FileData *fd = blo_filedata_from_file_minimal(filepath);
+  if (fd == nullptr) {
+    return false;
+  }
+
+  /* The index is written right after the render info and the thumbnail, stop at anything else. */
+  bool found = false;
+  for (BHead *bhead = blo_bhead_first(fd); bhead; bhead = blo_bhead_next(fd, bhead)) {
+    if (ELEM(bhead->code, BLO_CODE_REND, BLO_CODE_TEST)) {
+      continue;
+    }
+    if (bhead->code != BLO_CODE_DATA || bhead->len < BLO_FILE_INDEX_MAGIC_LEN) {
+      break;
+    }
+
+    blender::Vector<char> data(bhead->len);
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    if (!BHEADN_FROM_BHEAD(bhead)->has_data) {
+      if (!blo_bhead_read_data(fd, bhead, data.data())) {
+        break;
+      }
+    }
+    else
+#endif
+    {
+      memcpy(data.data(), bhead + 1, size_t(bhead->len));
+    }
+    if (!STREQLEN(data.data(), BLO_FILE_INDEX_MAGIC, BLO_FILE_INDEX_MAGIC_LEN)) {
+      break;
+    }
+
+    LinkNodePair names = {nullptr, nullptr};
+    int64_t offset = BLO_FILE_INDEX_MAGIC_LEN;
+    while (offset < data.size()) {
+      const char *name = data.data() + offset;
+      const int64_t name_len = int64_t(strnlen(name, size_t(data.size() - offset)));
+      if (offset + name_len == data.size()) {
+        /* Missing NULL terminator, the index is corrupted. */
+        break;
+      }
+      BLI_linklist_append(&names, BLI_strdupn(name, size_t(name_len)));
+      offset += name_len + 1;
+    }
+    *r_id_names = names.list;
+    found = true;
+    break;
+  }
+
+  blo_filedata_free(fd);
+  return found;
+}
+
 short BLO_version_from_file(const char *filepath)
 {
   short version = 0;
@@ -1316,16 +1479,42 @@ short BLO_version_from_file(const char *filepath)
 /** \name Old/New Pointer Map
  * \{ */
 
+/**
+ * Lookup in #FileData.datamap, reading the content of deferred data-blocks on first access.
+ */
+static void *datamap_lookup_and_inc(FileData *fd, const void *adr, const bool increase_users)
+{
+  NewAddress *entry = oldnewmap_lookup(fd->datamap, adr);
+  if (entry == nullptr) {
+    return nullptr;
+  }
+  if (entry->deferred_bhead != nullptr) {
+    BHead *bhead = entry->deferred_bhead;
+    entry->deferred_bhead = nullptr;
+    entry->newp = read_struct(
+        fd, bhead, fd->datamap_deferred_allocname, fd->datamap_deferred_id_type_index);
+    if (entry->newp == nullptr) {
+      /* Match non-deferred reading, where such data is not added to the map at all. */
+      fd->datamap->map.remove(adr);
+      return nullptr;
+    }
+  }
+  if (increase_users) {
+    entry->nr++;
+  }
+  return entry->newp;
+}
+
 /* Only direct data-blocks. */
 static void *newdataadr(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, true);
+  return datamap_lookup_and_inc(fd, adr, true);
 }
 
 /* Only direct data-blocks. */
 static void *newdataadr_no_us(FileData *fd, const void *adr)
 {
-  return oldnewmap_lookup_and_inc(fd->datamap, adr, false);
+  return datamap_lookup_and_inc(fd, adr, false);
 }
 
 void *blo_read_get_new_globaldata_address(FileData *fd, const void *adr)
@@ -1674,6 +1863,7 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const i
      * NOTE: raw data (aka #SDNA_RAW_DATA_STRUCT_INDEX #SDNAnr) is not handled here, it's up to
      * the calling code to manage this. */
     BLI_STATIC_ASSERT(SDNA_RAW_DATA_STRUCT_INDEX == 0, "'raw data' SDNA struct index should be 0")
+    blo_read_profile_add_block(fd->filesdna, bh, id_type_index);
     if (bh->SDNAnr > SDNA_RAW_DATA_STRUCT_INDEX && (fd->flags & FD_FLAGS_SWITCH_ENDIAN)) {
 #ifdef USE_BHEAD_READ_ON_DEMAND
       if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
@@ -1690,17 +1880,37 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const i
     if (fd->compflags[bh->SDNAnr] != SDNA_CMP_REMOVED) {
       const char *alloc_name = get_alloc_name(fd, bh, blockname, id_type_index);
       if (fd->compflags[bh->SDNAnr] == SDNA_CMP_NOT_EQUAL) {
+        const void *data = (bh + 1);
 #ifdef USE_BHEAD_READ_ON_DEMAND
+        const void *mapped_data = nullptr;
         if (BHEADN_FROM_BHEAD(bh)->has_data == false) {
-          bh = blo_bhead_read_full(fd, bh);
-          if (UNLIKELY(bh == nullptr)) {
-            fd->flags &= ~FD_FLAGS_FILE_OK;
-            return nullptr;
+          /* Reconstruction does not modify its input, so it can read from the file directly. */
+          mapped_data = blo_bhead_mapped_data(fd, bh);
+          if (mapped_data) {
+            data = mapped_data;
           }
+          else {
+            bh = blo_bhead_read_full(fd, bh);
+            if (UNLIKELY(bh == nullptr)) {
+              fd->flags &= ~FD_FLAGS_FILE_OK;
+              return nullptr;
+            }
+            data = (bh + 1);
+          }
+        }
+#endif
+        {
+          BlendReadProfileTimer profile_timer(&BlendReadProfile::dna_reconstruct_duration);
+          temp = DNA_struct_reconstruct(
+              fd->reconstruct_info, bh->SDNAnr, bh->nr, data, alloc_name);
+        }
+#ifdef USE_BHEAD_READ_ON_DEMAND
+        if (mapped_data && UNLIKELY(!blo_bhead_mapped_data_done(fd, bh))) {
+          fd->flags &= ~FD_FLAGS_FILE_OK;
+          MEM_freeN(temp);
+          temp = nullptr;
         }
 #endif
-        temp = DNA_struct_reconstruct(
-            fd->reconstruct_info, bh->SDNAnr, bh->nr, (bh + 1), alloc_name);
       }
       else {
         /* SDNA_CMP_EQUAL */
@@ -1718,6 +1928,9 @@ static void *read_struct(FileData *fd, BHead *bh, const char *blockname, const i
             MEM_freeN(temp);
             temp = nullptr;
           }
+          else {
+            blo_bhead_mapped_data_done(fd, bh);
+          }
         }
 #else
         memcpy(temp, (bh + 1), bh->len);
@@ -2398,25 +2611,57 @@ static bool direct_link_id(FileData *fd,
   return success;
 }
 
-/* Read all data associated with a datablock into datamap. */
+/**
+ * Read all data associated with a datablock into datamap.
+ *
+ * When the content of data-blocks can be read on demand, it is only read once the data is
+ * actually looked up (e.g. by #BLO_read_struct). Data that is not used by the reading code (like
+ * everything but the asset meta-data when only reading that) is never read.
+ */
 static BHead *read_data_into_datamap(FileData *fd,
                                      BHead *bhead,
                                      const char *allocname,
                                      const int id_type_index)
 {
+  /* Undo relies on all data being read to detect unchanged data-blocks. */
+  const bool use_deferred_read = (fd->flags & FD_FLAGS_IS_MEMFILE) == 0;
+  fd->datamap_deferred_allocname = allocname;
+  fd->datamap_deferred_id_type_index = id_type_index;
+
   bhead = blo_bhead_next(fd, bhead);
 
+  /* Avoid growing the map while inserting, it is cleared after each ID anyway. The headers of the
+   * blocks are read here already, but their content will only be read as needed. */
+  int64_t blocks_num = 0;
+  for (BHead *bhead_iter = bhead; bhead_iter && bhead_iter->code == BLO_CODE_DATA;
+       bhead_iter = blo_bhead_next(fd, bhead_iter))
+  {
+    blocks_num++;
+  }
+  fd->datamap->map.reserve(blocks_num);
+
   while (bhead && bhead->code == BLO_CODE_DATA) {
-    void *data = read_struct(fd, bhead, allocname, id_type_index);
-    if (data) {
-      const bool is_new = oldnewmap_insert(fd->datamap, bhead->old, data, 0);
-      if (!is_new) {
-        CLOG_ERROR(&LOG,
-                   "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
-                   "value (%p) for a given ID.",
-                   bhead->old);
+    bool is_new = true;
+#ifdef USE_BHEAD_READ_ON_DEMAND
+    if (use_deferred_read && bhead->len && bhead->old &&
+        BHEADN_FROM_BHEAD(bhead)->has_data == false)
+    {
+      is_new = fd->datamap->map.add_overwrite(bhead->old, NewAddress{nullptr, 0, bhead});
+    }
+    else
+#endif
+    {
+      void *data = read_struct(fd, bhead, allocname, id_type_index);
+      if (data) {
+        is_new = oldnewmap_insert(fd->datamap, bhead->old, data, 0);
       }
     }
+    if (!is_new) {
+      CLOG_ERROR(&LOG,
+                 "Blendfile corruption: Invalid, or multiple `bhead` with same old address "
+                 "value (%p) for a given ID.",
+                 bhead->old);
+    }
 
     bhead = blo_bhead_next(fd, bhead);
   }
@@ -2828,6 +3073,7 @@ static BHead *read_libblock(FileData *fd,
 
   /* Read libblock struct. */
   const int id_type_index = BKE_idtype_idcode_to_index(bhead->code);
+  const BlendReadProfileIDScope profile_id_scope(blo_bhead_id_name(fd, bhead), id_type_index);
 #ifndef NDEBUG
   const char *blockname = nullptr;
 #else
@@ -2976,8 +3222,12 @@ static BHead *read_global(BlendFileData *bfd, FileData *fd, BHead *bhead)
   STRNCPY(bfd->main->build_hash, fg->build_hash);
   bfd->main->is_asset_edit_file = (fg->fileflags & G_FILE_ASSET_EDIT_FILE) != 0;
 
-  bfd->fileflags = fg->fileflags;
+  /* This only describes how the file was written and must not be written again by default. */
+  bfd->fileflags = fg->fileflags & ~G_FILE_CROSS_ID_SHARED_DATA;
   bfd->globalf = fg->globalf;
+  if (fg->fileflags & G_FILE_CROSS_ID_SHARED_DATA) {
+    fd->flags |= FD_FLAGS_CROSS_ID_SHARED_DATA;
+  }
 
   /* NOTE: since 88b24bc6bb, `fg->filepath` is only written for crash recovery and autosave files,
    * so only overwrite `fd->relabase` if it is not empty, in case a regular blendfile is opened
@@ -3042,6 +3292,47 @@ static void do_versions_userdef(FileData * /*fd*/, BlendFileData *bfd)
   blo_do_versions_userdef(user);
 }
 
+/**
+ * Versioning code only ever checks for files older than some version, so a versioning function
+ * has nothing to do for files at least as recent as every version it checks for. This allows to
+ * skip whole functions, and all the loops over data-blocks they contain, for recent files.
+ *
+ * \note When adding versioning code for a newer version to an existing function, its skip
+ * version has to be updated too. Functions that also contain code running unconditionally use a
+ * zero skip version, and are never skipped.
+ */
+struct VersioningPass {
+  void (*exec)(FileData *fd, Library *lib, Main *bmain);
+  const char *name;
+  /** The pass is skipped for files saved with at least this version (when non-zero). */
+  int skip_versionfile;
+  int skip_subversionfile;
+};
+
+/** Same as #VersioningPass, for versioning done after linking. */
+struct VersioningAfterLinkingPass {
+  void (*exec)(FileData *fd, Main *bmain);
+  const char *name;
+  int skip_versionfile;
+  int skip_subversionfile;
+};
+
+static bool versioning_pass_is_needed(const Main *main,
+                                      const int skip_versionfile,
+                                      const int skip_subversionfile)
+{
+  return skip_versionfile == 0 ||
+         !MAIN_VERSION_FILE_ATLEAST(main, skip_versionfile, skip_subversionfile);
+}
+
+/** Print the time spent in a versioning function, to find out what dominates load time. */
+static void versioning_pass_report_duration(const char *name, const double start_time)
+{
+  if (G.debug & G_DEBUG) {
+    CLOG_INFO(&LOG, 0, "    %s: %.3f ms", name, (BLI_time_now_seconds() - start_time) * 1000.0);
+  }
+}
+
 static void do_versions(FileData *fd, Library *lib, Main *main)
 {
   /* WATCH IT!!!: pointers from libdata have not been converted */
@@ -3070,44 +3361,32 @@ static void do_versions(FileData *fd, Library *lib, Main *main)
               main->build_hash);
   }
 
-  if (!main->is_read_invalid) {
-    blo_do_versions_pre250(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_250(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_260(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_270(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_280(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_290(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_300(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_400(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_410(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_420(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_430(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_440(fd, lib, main);
-  }
-  if (!main->is_read_invalid) {
-    blo_do_versions_450(fd, lib, main);
+  static const VersioningPass passes[] = {
+      {blo_do_versions_pre250, "blo_do_versions_pre250", 250, 0},
+      {blo_do_versions_250, "blo_do_versions_250", 259, 4},
+      {blo_do_versions_260, "blo_do_versions_260", 280, 60},
+      {blo_do_versions_270, "blo_do_versions_270", 279, 4},
+      {blo_do_versions_280, "blo_do_versions_280", 0, 0},
+      {blo_do_versions_290, "blo_do_versions_290", 294, 0},
+      {blo_do_versions_300, "blo_do_versions_300", 0, 0},
+      {blo_do_versions_400, "blo_do_versions_400", 0, 0},
+      {blo_do_versions_410, "blo_do_versions_410", 401, 21},
+      {blo_do_versions_420, "blo_do_versions_420", 404, 0},
+      {blo_do_versions_430, "blo_do_versions_430", 403, 31},
+      {blo_do_versions_440, "blo_do_versions_440", 404, 30},
+      {blo_do_versions_450, "blo_do_versions_450", 0, 0},
+  };
+
+  for (const VersioningPass &pass : passes) {
+    if (main->is_read_invalid) {
+      break;
+    }
+    if (!versioning_pass_is_needed(main, pass.skip_versionfile, pass.skip_subversionfile)) {
+      continue;
+    }
+    const double start_time = BLI_time_now_seconds();
+    pass.exec(fd, lib, main);
+    versioning_pass_report_duration(pass.name, start_time);
   }
 
   /* WATCH IT!!!: pointers from libdata have not been converted yet here! */
@@ -3133,41 +3412,41 @@ static void do_versions_after_linking(FileData *fd, Main *main)
   /* Don't allow versioning to create new data-blocks. */
   main->is_locked_for_linking = true;
 
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_250(main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_260(main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_270(main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_280(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_290(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_300(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_400(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_410(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_420(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_430(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_440(fd, main);
-  }
-  if (!main->is_read_invalid) {
-    do_versions_after_linking_450(fd, main);
+  static const VersioningAfterLinkingPass passes[] = {
+      {[](FileData * /*fd*/, Main *bmain) { do_versions_after_linking_250(bmain); },
+       "do_versions_after_linking_250",
+       258,
+       0},
+      /* Currently empty. */
+      {[](FileData * /*fd*/, Main *bmain) { do_versions_after_linking_260(bmain); },
+       "do_versions_after_linking_260",
+       260,
+       0},
+      {[](FileData * /*fd*/, Main *bmain) { do_versions_after_linking_270(bmain); },
+       "do_versions_after_linking_270",
+       279,
+       2},
+      {do_versions_after_linking_280, "do_versions_after_linking_280", 300, 39},
+      {do_versions_after_linking_290, "do_versions_after_linking_290", 293, 20},
+      {do_versions_after_linking_300, "do_versions_after_linking_300", 306, 13},
+      {do_versions_after_linking_400, "do_versions_after_linking_400", 400, 34},
+      {do_versions_after_linking_410, "do_versions_after_linking_410", 401, 23},
+      {do_versions_after_linking_420, "do_versions_after_linking_420", 402, 52},
+      {do_versions_after_linking_430, "do_versions_after_linking_430", 403, 6},
+      {do_versions_after_linking_440, "do_versions_after_linking_440", 404, 27},
+      {do_versions_after_linking_450, "do_versions_after_linking_450", 405, 74},
+  };
+
+  for (const VersioningAfterLinkingPass &pass : passes) {
+    if (main->is_read_invalid) {
+      break;
+    }
+    if (!versioning_pass_is_needed(main, pass.skip_versionfile, pass.skip_subversionfile)) {
+      continue;
+    }
+    const double start_time = BLI_time_now_seconds();
+    pass.exec(fd, main);
+    versioning_pass_report_duration(pass.name, start_time);
   }
 
   main->is_locked_for_linking = false;
@@ -3550,6 +3829,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
     read_undo_reuse_noundo_local_ids(fd);
   }
 
+  double profile_time = blo_read_profile_time();
   while (bhead) {
     switch (bhead->code) {
       case BLO_CODE_DATA:
@@ -3613,6 +3893,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
       return bfd;
     }
   }
+  blo_read_profile_phase_end("read_data", profile_time);
 
   if (is_undo) {
     /* Move the remaining Library IDs and their linked data to the new main.
@@ -3638,6 +3919,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
   }
 
   /* Do versioning before read_libraries, but skip in undo case. */
+  profile_time = blo_read_profile_time();
   if (!is_undo) {
     if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
       do_versions(fd, nullptr, bfd->main);
@@ -3647,6 +3929,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
       do_versions_userdef(fd, bfd);
     }
   }
+  blo_read_profile_phase_end("versioning", profile_time);
 
   if (bfd->main->is_read_invalid) {
     return bfd;
@@ -3654,12 +3937,16 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
 
   if ((fd->skip_flags & BLO_READ_SKIP_DATA) == 0) {
     fd->reports->duration.libraries = BLI_time_now_seconds();
+    profile_time = blo_read_profile_time();
     read_libraries(fd, &mainlist);
+    blo_read_profile_phase_end("libraries", profile_time);
 
     blo_join_main(&mainlist);
 
+    profile_time = blo_read_profile_time();
     lib_link_all(fd, bfd->main);
     after_liblink_merged_bmain_process(bfd->main, fd->reports);
+    blo_read_profile_phase_end("lib_link", profile_time);
 
     if (is_undo) {
       /* Ensure ID usages of reused 'no undo' IDs remain valid. */
@@ -3685,6 +3972,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
       BKE_layer_collection_resync_allow();
 
       /* Yep, second splitting... but this is a very cheap operation, so no big deal. */
+      profile_time = blo_read_profile_time();
       blo_split_main(&mainlist, bfd->main);
       LISTBASE_FOREACH (Main *, mainvar, &mainlist) {
         /* Do versioning for newly added linked data-blocks. If no data-blocks were read from a
@@ -3698,6 +3986,7 @@ BlendFileData *blo_read_file_internal(FileData *fd, const char *filepath)
                                   mainvar);
       }
       blo_join_main(&mainlist);
+      blo_read_profile_phase_end("versioning_after_linking", profile_time);
 
       BKE_layer_collection_resync_forbid();
 
@@ -5100,12 +5389,48 @@ blender::ImplicitSharingInfoAndData blo_read_shared_impl(
     return *shared_data;
   }
 
+  FileData *fd = reader->fd;
+  const bool use_cross_id_sharing = (fd->flags & FD_FLAGS_CROSS_ID_SHARED_DATA) &&
+                                    !BLO_read_data_is_undo(reader);
+  if (use_cross_id_sharing) {
+    if (const blender::ImplicitSharingInfoAndData *shared_data =
+            fd->cross_id_shared_data.lookup_ptr(old_address))
+    {
+      /* The data was loaded for another ID already. Reading is single threaded, so the weak user
+       * can be turned into a strong one as long as the data is not expired. */
+      if (!shared_data->sharing_info->is_expired()) {
+        shared_data->sharing_info->add_user();
+        reader->shared_data_by_stored_address.add(old_address, *shared_data);
+        return *shared_data;
+      }
+    }
+    if (!fd->datamap->map.contains(old_address)) {
+      /* The data has been written as part of another ID, which may not have been read at all
+       * (e.g. when linking). */
+      if (BHead *bhead = blo_bhead_find_data_by_old_address(fd, old_address)) {
+        if (void *data = read_struct(fd, bhead, "Data from other ID", INDEX_ID_NULL)) {
+          oldnewmap_insert(fd->datamap, old_address, data, 0);
+        }
+      }
+    }
+  }
+
   /* This is the first time this data is loaded. The callback also creates the corresponding
    * sharing info which may be reused later. */
   const blender::ImplicitSharingInfo *sharing_info = read_fn();
   const void *new_address = *ptr_p;
   const blender::ImplicitSharingInfoAndData shared_data{sharing_info, new_address};
   reader->shared_data_by_stored_address.add(old_address, shared_data);
+  if (use_cross_id_sharing && sharing_info != nullptr) {
+    sharing_info->add_weak_user();
+    const blender::ImplicitSharingInfoAndData *previous_data =
+        fd->cross_id_shared_data.lookup_ptr(old_address);
+    if (previous_data != nullptr) {
+      /* Replace expired data. */
+      previous_data->sharing_info->remove_weak_user_and_delete_if_last();
+    }
+    fd->cross_id_shared_data.add_overwrite(old_address, shared_data);
+  }
   return shared_data;
 }
 
@@ -17,6 +17,7 @@
 #endif
 
 #include "BLI_filereader.h"
+#include "BLI_implicit_sharing.hh"
 #include "BLI_map.hh"
 
 #include "DNA_sdna_types.h"
@@ -41,6 +42,13 @@ struct Object;
 struct OldNewMap;
 struct UserDef;
 
+/**
+ * Identifies the index of local data-blocks written at the start of blend files, see
+ * #BLO_file_index_from_file. It is immediately followed by the NULL terminated names of the IDs.
+ */
+#define BLO_FILE_INDEX_MAGIC "BLOINDEX"
+#define BLO_FILE_INDEX_MAGIC_LEN 8
+
 enum eFileDataFlag {
   FD_FLAGS_SWITCH_ENDIAN = 1 << 0,
   FD_FLAGS_FILE_POINTSIZE_IS_4 = 1 << 1,
@@ -52,8 +60,10 @@ enum eFileDataFlag {
    * 'from the future'. Improves report to the user.
    */
   FD_FLAGS_FILE_FUTURE = 1 << 5,
+  /** Shared data may be referenced across IDs, see #G_FILE_CROSS_ID_SHARED_DATA. */
+  FD_FLAGS_CROSS_ID_SHARED_DATA = 1 << 6,
 };
-ENUM_OPERATORS(eFileDataFlag, FD_FLAGS_IS_MEMFILE)
+ENUM_OPERATORS(eFileDataFlag, FD_FLAGS_CROSS_ID_SHARED_DATA)
 
 /* Disallow since it's 32bit on ms-windows. */
 #ifdef __GNUC__
@@ -120,6 +130,9 @@ struct FileData {
   int id_tag_extra = 0;
 
   OldNewMap *datamap = nullptr;
+  /** Used to read deferred data-blocks in #datamap, see #read_data_into_datamap. */
+  const char *datamap_deferred_allocname = nullptr;
+  int datamap_deferred_id_type_index = 0;
   OldNewMap *globmap = nullptr;
 
   /**
@@ -136,6 +149,14 @@ struct FileData {
 
   std::optional<blender::Map<blender::StringRefNull, BHead *>> bhead_idname_map;
 
+  /**
+   * Used when #FD_FLAGS_CROSS_ID_SHARED_DATA is set: all #BLO_CODE_DATA blocks of the file by
+   * their old address, created on demand. The shared data that was read so far is kept with a
+   * weak user, so that other IDs can add a user to it instead of reading it again.
+   */
+  std::optional<blender::Map<const void *, BHead *>> bhead_data_map;
+  blender::Map<const void *, blender::ImplicitSharingInfoAndData> cross_id_shared_data;
+
   ListBase *mainlist = nullptr;
   /** Used for undo. */
   ListBase *old_mainlist = nullptr;
@@ -0,0 +1,221 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup blenloader
+ */
+
+#include <algorithm>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_fileops.hh"
+#include "BLI_serialize.hh"
+#include "BLI_time.h"
+
+#include "DNA_ID.h"
+#include "DNA_sdna_types.h"
+
+#include "BKE_global.hh"
+#include "BKE_idtype.hh"
+
+#include "BLO_core_bhead.hh"
+
+#include "CLG_log.h"
+
+#include "readfile_profile.hh"
+
+static CLG_LogRef LOG = {"blo.readfile.profile"};
+
+/** Number of blocks listed in #BlendReadProfile::largest_blocks. */
+#define READ_PROFILE_LARGEST_BLOCKS_NUM 20
+
+/** Blend files are only read from the main thread, so a single profile is enough. */
+static BlendReadProfile *active_profile = nullptr;
+
+bool blo_read_profile_begin(const char *filepath)
+{
+  if (G.blend_read_profile_filepath[0] == '\0' || active_profile != nullptr) {
+    return false;
+  }
+  active_profile = MEM_new<BlendReadProfile>(__func__);
+  active_profile->filepath = filepath;
+  active_profile->start_time = BLI_time_now_seconds();
+  /* Report the peak memory usage of reading this file only. */
+  MEM_reset_peak_memory();
+  return true;
+}
+
+static const char *read_profile_id_type_name(const int id_type_index)
+{
+  if (id_type_index < 0 || id_type_index >= INDEX_ID_NULL) {
+    return "None";
+  }
+  return BKE_idtype_get_info_from_idtype_index(id_type_index)->name;
+}
+
+static void read_profile_write_json(const BlendReadProfile &profile, std::ostream &os)
+{
+  using namespace blender::io::serialize;
+
+  DictionaryValue root;
+  root.append_str("filepath", profile.filepath);
+  root.append_double("duration", BLI_time_now_seconds() - profile.start_time);
+  root.append_int("mem_in_use", int64_t(MEM_get_memory_in_use()));
+  root.append_int("mem_peak", int64_t(MEM_get_peak_memory()));
+  root.append_double("file_read_duration", profile.file_read_duration);
+  root.append_double("dna_reconstruct_duration", profile.dna_reconstruct_duration);
+
+  DictionaryValue &address_map = *root.append_dict("address_map");
+  address_map.append_int("lookups_num", profile.address_map.lookups_num);
+  address_map.append_int("hits_num", profile.address_map.hits_num);
+  address_map.append_double("hit_rate",
+                            profile.address_map.lookups_num ?
+                                double(profile.address_map.hits_num) /
+                                    double(profile.address_map.lookups_num) :
+                                0.0);
+  address_map.append_double("average_probe_length",
+                            profile.address_map.keys_num ?
+                                1.0 + double(profile.address_map.collisions_num) /
+                                          double(profile.address_map.keys_num) :
+                                0.0);
+
+  ArrayValue &phases = *root.append_array("phases");
+  for (const BlendReadProfile::Phase &phase : profile.phases) {
+    DictionaryValue &value = *phases.append_dict();
+    value.append_str("name", phase.name);
+    value.append_double("duration", phase.duration);
+    value.append_int("mem_in_use", int64_t(phase.mem_in_use));
+  }
+
+  /* Sort ID types by the time spent reading them, most expensive first. */
+  blender::Vector<std::pair<int, BlendReadProfile::IDTypeStats>> id_types;
+  for (const auto item : profile.id_types.items()) {
+    id_types.append({item.key, item.value});
+  }
+  std::sort(id_types.begin(), id_types.end(), [](const auto &a, const auto &b) {
+    return a.second.duration > b.second.duration;
+  });
+  ArrayValue &id_types_value = *root.append_array("id_types");
+  for (const auto &[id_type_index, stats] : id_types) {
+    DictionaryValue &value = *id_types_value.append_dict();
+    value.append_str("name", read_profile_id_type_name(id_type_index));
+    value.append_int("ids_num", stats.ids_num);
+    value.append_int("blocks_num", stats.blocks_num);
+    value.append_int("bytes", stats.bytes);
+    value.append_double("duration", stats.duration);
+  }
+
+  ArrayValue &blocks = *root.append_array("largest_blocks");
+  for (const BlendReadProfile::Block &block : profile.largest_blocks) {
+    DictionaryValue &value = *blocks.append_dict();
+    value.append_str("struct", block.struct_name);
+    value.append_str("id", block.id_name);
+    value.append_int("size", block.size);
+  }
+
+  JsonFormatter formatter;
+  formatter.indentation_len = 2;
+  formatter.serialize(os, root);
+}
+
+void blo_read_profile_end()
+{
+  BLI_assert(active_profile != nullptr);
+
+  blender::fstream file(G.blend_read_profile_filepath, std::ios::out);
+  if (file.is_open()) {
+    read_profile_write_json(*active_profile, file);
+  }
+  else {
+    CLOG_ERROR(&LOG, "Unable to write read profile to '%s'", G.blend_read_profile_filepath);
+  }
+
+  MEM_delete(active_profile);
+  active_profile = nullptr;
+}
+
+BlendReadProfile *blo_read_profile_active()
+{
+  return active_profile;
+}
+
+double blo_read_profile_time()
+{
+  return active_profile ? BLI_time_now_seconds() : 0.0;
+}
+
+void blo_read_profile_phase_end(const char *name, const double start_time)
+{
+  if (active_profile == nullptr) {
+    return;
+  }
+  active_profile->phases.append(
+      {name, BLI_time_now_seconds() - start_time, MEM_get_memory_in_use()});
+}
+
+void blo_read_profile_add_block(const SDNA *sdna, const BHead *bhead, const int id_type_index)
+{
+  if (active_profile == nullptr) {
+    return;
+  }
+  BlendReadProfile::IDTypeStats &stats = active_profile->id_types.lookup_or_add_default(
+      id_type_index);
+  stats.blocks_num++;
+  stats.bytes += bhead->len;
+
+  blender::Vector<BlendReadProfile::Block> &blocks = active_profile->largest_blocks;
+  if (blocks.size() == READ_PROFILE_LARGEST_BLOCKS_NUM && blocks.last().size >= bhead->len) {
+    return;
+  }
+  const char *struct_name = sdna->types[sdna->structs[bhead->SDNAnr]->type_index];
+  const char *id_name = active_profile->current_id_name ? active_profile->current_id_name : "";
+  const int64_t index = std::upper_bound(blocks.begin(),
+                                         blocks.end(),
+                                         bhead->len,
+                                         [](const int64_t size, const BlendReadProfile::Block &b) {
+                                           return size > b.size;
+                                         }) -
+                        blocks.begin();
+  blocks.insert(index, {bhead->len, struct_name, id_name});
+  if (blocks.size() > READ_PROFILE_LARGEST_BLOCKS_NUM) {
+    blocks.remove_last();
+  }
+}
+
+BlendReadProfileTimer::BlendReadProfileTimer(double BlendReadProfile::*duration)
+{
+  if (active_profile) {
+    duration_ = &(active_profile->*duration);
+    start_time_ = BLI_time_now_seconds();
+  }
+}
+
+BlendReadProfileTimer::~BlendReadProfileTimer()
+{
+  if (duration_) {
+    *duration_ += BLI_time_now_seconds() - start_time_;
+  }
+}
+
+BlendReadProfileIDScope::BlendReadProfileIDScope(const char *id_name, const int id_type_index)
+    : profile_(active_profile), id_type_index_(id_type_index)
+{
+  if (profile_) {
+    id_name_prev_ = profile_->current_id_name;
+    profile_->current_id_name = id_name;
+    start_time_ = BLI_time_now_seconds();
+  }
+}
+
+BlendReadProfileIDScope::~BlendReadProfileIDScope()
+{
+  if (profile_) {
+    BlendReadProfile::IDTypeStats &stats = profile_->id_types.lookup_or_add_default(
+        id_type_index_);
+    stats.ids_num++;
+    stats.duration += BLI_time_now_seconds() - start_time_;
+    profile_->current_id_name = id_name_prev_;
+  }
+}
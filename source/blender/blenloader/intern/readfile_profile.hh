@@ -0,0 +1,112 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup blenloader
+ *
+ * Detailed timing and memory information gathered while reading a blend file, to find out where
+ * the load time goes. Enabled with the `--profile-blend-read` command line argument, the report is
+ * written as JSON to the given file once #BLO_read_from_file is done.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "BLI_map.hh"
+#include "BLI_vector.hh"
+
+struct BHead;
+struct SDNA;
+
+struct BlendReadProfile {
+  struct Phase {
+    const char *name;
+    double duration;
+    /** Memory in use at the end of the phase. */
+    size_t mem_in_use;
+  };
+
+  struct IDTypeStats {
+    int64_t ids_num = 0;
+    int64_t blocks_num = 0;
+    int64_t bytes = 0;
+    /** Time spent reading the IDs and their data, versioning and linking are not included. */
+    double duration = 0.0;
+  };
+
+  struct Block {
+    int64_t size;
+    std::string struct_name;
+    std::string id_name;
+  };
+
+  std::string filepath;
+  double start_time = 0.0;
+
+  blender::Vector<Phase> phases;
+
+  /** Time spent reading data from the file, including decompression. */
+  double file_read_duration = 0.0;
+  /** Time spent converting structs written with a different DNA. */
+  double dna_reconstruct_duration = 0.0;
+
+  /** Statistics of the old to new address maps used to relink pointers, see #OldNewMap. */
+  struct {
+    int64_t lookups_num = 0;
+    int64_t hits_num = 0;
+    int64_t keys_num = 0;
+    /** Total number of collisions when looking up every key once. */
+    int64_t collisions_num = 0;
+  } address_map;
+
+  /** Statistics for the data of each ID type, using the ID type index as key. */
+  blender::Map<int, IDTypeStats> id_types;
+
+  /** The largest blocks read from the file, sorted by decreasing size. */
+  blender::Vector<Block> largest_blocks;
+
+  /** Name of the ID currently being read, used for #largest_blocks. */
+  const char *current_id_name = nullptr;
+};
+
+/**
+ * Start profiling the reading of the given file, when enabled from the command line.
+ * \return True when profiling was started, #blo_read_profile_end must be called then.
+ */
+bool blo_read_profile_begin(const char *filepath);
+/** Write the JSON report and stop profiling. */
+void blo_read_profile_end();
+
+/** \return The profile of the file currently being read, or null when not profiling. */
+BlendReadProfile *blo_read_profile_active();
+
+/** \return The current time when profiling, to be passed to #blo_read_profile_phase_end. */
+double blo_read_profile_time();
+void blo_read_profile_phase_end(const char *name, double start_time);
+
+/** Account for a block of data read from the file (ID or ID data). */
+void blo_read_profile_add_block(const SDNA *sdna, const BHead *bhead, int id_type_index);
+
+/** Adds the time spent in its scope to one of the durations of the active profile. */
+class BlendReadProfileTimer {
+  double *duration_ = nullptr;
+  double start_time_ = 0.0;
+
+ public:
+  explicit BlendReadProfileTimer(double BlendReadProfile::*duration);
+  ~BlendReadProfileTimer();
+};
+
+/** Accounts the time spent in its scope, and the blocks read in it, to the given ID. */
+class BlendReadProfileIDScope {
+  BlendReadProfile *profile_ = nullptr;
+  const char *id_name_prev_ = nullptr;
+  int id_type_index_ = 0;
+  double start_time_ = 0.0;
+
+ public:
+  BlendReadProfileIDScope(const char *id_name, int id_type_index);
+  ~BlendReadProfileIDScope();
+};
@@ -18,11 +18,15 @@
 #  include <io.h>
 #endif
 
+#include <zstd.h>
+
 #include "MEM_guardedalloc.h"
 
 #include "DNA_listBase.h"
 
+#include "BLI_fileops.h"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_string.h"
 
 #include "BLO_readfile.hh"
 #include "BLO_undofile.hh"
@@ -31,18 +35,38 @@
 #include "BKE_main.hh"
 #include "BKE_undo_system.hh"
 
+#include "CLG_log.h"
+
 #include "BLI_strict_flags.h" /* IWYU pragma: keep. Keep last. */
 
+static CLG_LogRef LOG = {"blo.undofile"};
+
 /* **************** support for memory-write, for undo buffers *************** */
 
+static void memfile_compressed_storage_free(MemFileCompressedStorage *storage)
+{
+  if (storage->compressed_data) {
+    MEM_freeN(storage->compressed_data);
+  }
+  else {
+    BLI_delete(storage->filepath, false, false);
+  }
+  MEM_delete(storage);
+}
+
 void BLO_memfile_free(MemFile *memfile)
 {
   while (MemFileChunk *chunk = static_cast<MemFileChunk *>(BLI_pophead(&memfile->chunks))) {
-    if (chunk->is_identical == false) {
+    /* The buffer is null when compressed. */
+    if (chunk->is_identical == false && chunk->buf != nullptr) {
       MEM_freeN(chunk->buf);
     }
     MEM_freeN(chunk);
   }
+  if (memfile->compressed_storage) {
+    memfile_compressed_storage_free(memfile->compressed_storage);
+    memfile->compressed_storage = nullptr;
+  }
   MEM_delete(memfile->shared_storage);
   memfile->shared_storage = nullptr;
   memfile->size = 0;
@@ -94,6 +118,123 @@ void BLO_memfile_clear_future(MemFile *memfile)
   }
 }
 
+bool BLO_memfile_compress(MemFile *memfile)
+{
+  BLI_assert(memfile->compressed_storage == nullptr);
+
+  /* Only chunks owned by this memfile and not used by the next one can be compressed, the
+   * buffers of others are shared with other undo steps. */
+  MemFileCompressedStorage *storage = MEM_new<MemFileCompressedStorage>(__func__);
+  LISTBASE_FOREACH (MemFileChunk *, chunk, &memfile->chunks) {
+    if (!chunk->is_identical && !chunk->is_identical_future) {
+      storage->chunks.append(chunk);
+      storage->size += chunk->size;
+    }
+  }
+  if (storage->chunks.is_empty()) {
+    MEM_delete(storage);
+    return false;
+  }
+
+  char *data = MEM_malloc_arrayN<char>(storage->size, __func__);
+  size_t offset = 0;
+  for (MemFileChunk *chunk : storage->chunks) {
+    memcpy(data + offset, chunk->buf, chunk->size);
+    offset += chunk->size;
+  }
+
+  const size_t compressed_size_max = ZSTD_compressBound(storage->size);
+  void *compressed_data = MEM_mallocN(compressed_size_max, __func__);
+  const size_t compressed_size = ZSTD_compress(
+      compressed_data, compressed_size_max, data, storage->size, 1);
+  MEM_freeN(data);
+  if (ZSTD_isError(compressed_size)) {
+    CLOG_ERROR(&LOG, "Failed to compress undo step: %s", ZSTD_getErrorName(compressed_size));
+    MEM_freeN(compressed_data);
+    MEM_delete(storage);
+    return false;
+  }
+
+  storage->compressed_data = MEM_reallocN(compressed_data, compressed_size);
+  storage->compressed_size = compressed_size;
+  for (MemFileChunk *chunk : storage->chunks) {
+    MEM_freeN(chunk->buf);
+    chunk->buf = nullptr;
+  }
+  memfile->compressed_storage = storage;
+  return true;
+}
+
+bool BLO_memfile_spill(MemFile *memfile, const char *filepath)
+{
+  MemFileCompressedStorage *storage = memfile->compressed_storage;
+  BLI_assert(storage != nullptr && storage->compressed_data != nullptr);
+
+  FILE *file = BLI_fopen(filepath, "wb");
+  if (file == nullptr) {
+    CLOG_ERROR(&LOG, "Unable to open '%s' to store undo step", filepath);
+    return false;
+  }
+  const bool success = fwrite(storage->compressed_data, 1, storage->compressed_size, file) ==
+                       storage->compressed_size;
+  fclose(file);
+  if (!success) {
+    CLOG_ERROR(&LOG, "Unable to write undo step to '%s'", filepath);
+    BLI_delete(filepath, false, false);
+    return false;
+  }
+
+  STRNCPY(storage->filepath, filepath);
+  MEM_freeN(storage->compressed_data);
+  storage->compressed_data = nullptr;
+  return true;
+}
+
+void BLO_memfile_restore(MemFile *memfile)
+{
+  MemFileCompressedStorage *storage = memfile->compressed_storage;
+  if (storage == nullptr) {
+    return;
+  }
+
+  void *compressed_data = storage->compressed_data;
+  if (compressed_data == nullptr) {
+    compressed_data = MEM_mallocN(storage->compressed_size, __func__);
+    FILE *file = BLI_fopen(storage->filepath, "rb");
+    if (file == nullptr ||
+        fread(compressed_data, 1, storage->compressed_size, file) != storage->compressed_size)
+    {
+      CLOG_ERROR(&LOG, "Unable to read undo step from '%s'", storage->filepath);
+    }
+    if (file) {
+      fclose(file);
+    }
+  }
+
+  char *data = MEM_malloc_arrayN<char>(storage->size, __func__);
+  const size_t size = ZSTD_decompress(
+      data, storage->size, compressed_data, storage->compressed_size);
+  if (size != storage->size) {
+    CLOG_ERROR(&LOG, "Failed to decompress undo step, its data is lost");
+    memset(data, 0, storage->size);
+  }
+  if (compressed_data != storage->compressed_data) {
+    MEM_freeN(compressed_data);
+  }
+
+  size_t offset = 0;
+  for (MemFileChunk *chunk : storage->chunks) {
+    char *buf = MEM_malloc_arrayN<char>(chunk->size, "Chunk buffer");
+    memcpy(buf, data + offset, chunk->size);
+    offset += chunk->size;
+    chunk->buf = buf;
+  }
+  MEM_freeN(data);
+
+  memfile_compressed_storage_free(storage);
+  memfile->compressed_storage = nullptr;
+}
+
 void BLO_memfile_write_init(MemFileWriteData *mem_data,
                             MemFile *written_memfile,
                             MemFile *reference_memfile)
@@ -163,6 +304,55 @@ void BLO_memfile_chunk_add(MemFileWriteData *mem_data, const char *buf, size_t s
   }
 }
 
+bool BLO_memfile_write_reuse_id(MemFileWriteData *mem_data, const uint id_session_uid)
+{
+  MemFileChunk *compchunk = mem_data->id_session_uid_mapping.lookup_default(id_session_uid,
+                                                                            nullptr);
+  if (compchunk == nullptr) {
+    return false;
+  }
+
+  MemFile *memfile = mem_data->written_memfile;
+  for (; compchunk != nullptr && compchunk->id_session_uid == id_session_uid;
+       compchunk = static_cast<MemFileChunk *>(compchunk->next))
+  {
+    MemFileChunk *curchunk = MEM_mallocN<MemFileChunk>("MemFileChunk");
+    curchunk->size = compchunk->size;
+    curchunk->buf = compchunk->buf;
+    curchunk->is_identical = true;
+    curchunk->is_identical_future = true;
+    curchunk->id_session_uid = id_session_uid;
+    BLI_addtail(&memfile->chunks, curchunk);
+
+    compchunk->is_identical_future = true;
+  }
+  mem_data->reference_current_chunk = compchunk;
+
+  /* The reused chunks may reference data owned by the reference undo step, which then has to
+   * be shared with the new step too. */
+  const MemFileSharedStorage *compstorage = mem_data->reference_memfile->shared_storage;
+  if (compstorage == nullptr) {
+    return true;
+  }
+  const blender::Vector<const void *> *compdata = compstorage->id_session_uid_data.lookup_ptr(
+      id_session_uid);
+  if (compdata == nullptr) {
+    return true;
+  }
+  if (memfile->shared_storage == nullptr) {
+    memfile->shared_storage = MEM_new<MemFileSharedStorage>(__func__);
+  }
+  for (const void *data : *compdata) {
+    const blender::ImplicitSharingInfo *sharing_info = compstorage->map.lookup(data);
+    if (memfile->shared_storage->map.add(data, sharing_info)) {
+      sharing_info->add_user();
+      memfile->shared_storage->id_session_uid_data.lookup_or_add_default(id_session_uid).append(
+          data);
+    }
+  }
+  return true;
+}
+
 Main *BLO_memfile_main_get(MemFile *memfile, Main *bmain, Scene **r_scene)
 {
   Main *bmain_undo = nullptr;
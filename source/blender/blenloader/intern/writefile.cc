@@ -66,6 +66,7 @@
 #include <fcntl.h>
 #include <iomanip>
 #include <sstream>
+#include <thread>
 
 #ifdef WIN32
 #  include "BLI_winstuff.h"
@@ -84,23 +85,29 @@
 /* Allow writefile to use deprecated functionality (for forward compatibility code). */
 #define DNA_DEPRECATED_ALLOW
 
+#include "DNA_collection_types.h"
 #include "DNA_fileglobal_types.h"
 #include "DNA_genfile.h"
 #include "DNA_key_types.h"
 #include "DNA_print.hh"
+#include "DNA_scene_types.h"
 #include "DNA_sdna_types.h"
 #include "DNA_userdef_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_endian_defines.h"
 #include "BLI_endian_switch.h"
 #include "BLI_fileops.hh"
 #include "BLI_implicit_sharing.hh"
+#include "BLI_linear_allocator.hh"
 #include "BLI_math_base.h"
 #include "BLI_multi_value_map.hh"
 #include "BLI_path_utils.hh"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_threads.h"
+#include "BLI_vector.hh"
 
 #include "MEM_guardedalloc.h" /* MEM_freeN */
 
@@ -401,6 +408,38 @@ bool ZstdWriteWrap::write(const void *buf, const size_t buf_len)
   return true;
 }
 
+/**
+ * Keeps every single write in memory, so that data-blocks can be serialized on other threads and
+ * be written to the actual file afterwards, see #write_ids_parallel. Writes are recorded one by
+ * one because the buffering done by #mywrite depends on the size of each write.
+ */
+class RecordWriteWrap : public WriteWrap {
+ public:
+  blender::LinearAllocator<> allocator;
+  blender::Vector<blender::Span<char>> writes;
+
+  RecordWriteWrap()
+  {
+    use_buf = false;
+  }
+
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    return true;
+  }
+  bool write(const void *buf, const size_t buf_len) override
+  {
+    blender::MutableSpan<char> data = allocator.allocate_array<char>(int64_t(buf_len));
+    memcpy(data.data(), buf, buf_len);
+    writes.append(data);
+    return true;
+  }
+};
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -450,11 +489,22 @@ struct WriteData {
    * avoid writing the same data more than once.
    */
   blender::Set<const void *> per_id_written_shared_addresses;
+  /**
+   * Same as above but for the whole file, see #G_FILE_CROSS_ID_SHARED_DATA. Used instead of
+   * #per_id_written_shared_addresses when #use_cross_id_shared_data is set.
+   */
+  blender::Set<const void *> written_shared_addresses;
+  bool use_cross_id_shared_data;
 
   /** #MemFile writing (used for undo). */
   MemFileWriteData mem;
   /** When true, write to #WriteData.current, could also call 'is_undo'. */
   bool use_memfile;
+  /**
+   * When true, the chunks of IDs which were not tagged for update since the reference undo step
+   * are reused instead of writing these IDs again, see #write_id_reuse_undo_step.
+   */
+  bool use_memfile_incremental;
 
   /**
    * Wrap writing, so we can use zstd or
@@ -1123,6 +1173,99 @@ static void write_id(WriteData *wd, ID *id)
   mywrite_id_end(wd, id);
 }
 
+/**
+ * \return True when the ID and its embedded IDs were not tagged for any update since the last
+ * undo push. Only depsgraph tags are tracked, so UI data-blocks which are often modified without
+ * them are never considered unchanged.
+ */
+static bool write_id_is_unchanged_since_undo_push(ID *id)
+{
+  if (ELEM(GS(id->name), ID_WM, ID_SCR, ID_WS)) {
+    return false;
+  }
+  if (id->recalc_after_undo_push != 0) {
+    return false;
+  }
+  const bNodeTree *nodetree = blender::bke::node_tree_from_id(id);
+  if (nodetree != nullptr && nodetree->id.recalc_after_undo_push != 0) {
+    return false;
+  }
+  if (GS(id->name) == ID_SCE) {
+    const Scene *scene = reinterpret_cast<const Scene *>(id);
+    if (scene->master_collection != nullptr &&
+        scene->master_collection->id.recalc_after_undo_push != 0)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Add the chunks of the unchanged ID from the reference undo step to the written one, which is
+ * much cheaper than serializing the ID again and comparing the result.
+ *
+ * \return False when the ID has to be written.
+ */
+static bool write_id_reuse_undo_step(WriteData *wd, ID *id)
+{
+  if (!wd->use_memfile_incremental || !write_id_is_unchanged_since_undo_push(id)) {
+    return false;
+  }
+  if (!BLO_memfile_write_reuse_id(&wd->mem, id->session_uid)) {
+    return false;
+  }
+  /* Same as when actually writing the ID, see #BLO_Write_IDBuffer. Embedded IDs are known to have
+   * no recalc flags either. */
+  id->recalc_up_to_undo_push = 0;
+  if (bNodeTree *nodetree = blender::bke::node_tree_from_id(id)) {
+    nodetree->id.recalc_up_to_undo_push = 0;
+  }
+  if (GS(id->name) == ID_SCE) {
+    Scene *scene = reinterpret_cast<Scene *>(id);
+    if (scene->master_collection != nullptr) {
+      scene->master_collection->id.recalc_up_to_undo_push = 0;
+    }
+  }
+  return true;
+}
+
+static bool write_id_is_threadsafe(const ID *id)
+{
+  const IDTypeInfo *id_type = BKE_idtype_get_info_from_id(id);
+  return id_type->flags & IDTYPE_FLAGS_THREADSAFE_BLEND_WRITE;
+}
+
+/**
+ * Serialize the given IDs on multiple threads, then write them to the file in order. The result
+ * is identical to calling #write_id for each of them.
+ */
+static void write_ids_parallel(WriteData *wd, const blender::Span<ID *> ids)
+{
+  if (ids.is_empty()) {
+    return;
+  }
+  if (ids.size() == 1) {
+    write_id(wd, ids.first());
+    return;
+  }
+
+  blender::Array<RecordWriteWrap> records(ids.size());
+  blender::threading::parallel_for(ids.index_range(), 1, [&](const blender::IndexRange range) {
+    for (const int64_t i : range) {
+      WriteData *id_wd = writedata_new(&records[i]);
+      write_id(id_wd, ids[i]);
+      writedata_free(id_wd);
+    }
+  });
+
+  for (const RecordWriteWrap &record : records) {
+    for (const blender::Span<char> data : record.writes) {
+      mywrite(wd, data.data(), size_t(data.size()));
+    }
+  }
+}
+
 /** Keep it last of `write_*_data` functions. */
 static void write_libraries(WriteData *wd, Main *bmain)
 {
@@ -1239,6 +1382,8 @@ static void write_global(WriteData *wd, const int fileflags, Main *mainvar)
      * it should be enabled again. */
     fg.fileflags = G.fileflags & G_FILE_COMPRESS;
   }
+  /* Readers need to know that data may be referenced from other IDs. */
+  SET_FLAG_FROM_TEST(fg.fileflags, wd->use_cross_id_shared_data, G_FILE_CROSS_ID_SHARED_DATA);
   SNPRINTF(subvstr, "%4d", BLENDER_FILE_SUBVERSION);
   memcpy(fg.subvstr, subvstr, 4);
 
@@ -1268,6 +1413,26 @@ static void write_thumb(WriteData *wd, const BlendThumbnail *thumb)
   }
 }
 
+/**
+ * Index of the local data-blocks written in the file. It is written before any data-block so
+ * that listing the content of a file does not require reading (and decompressing) the whole file,
+ * see #BLO_file_index_from_file.
+ *
+ * \note This uses a 'DATA' block, which is ignored by all readers when it is not part of an ID.
+ * The \a r_buffer has to be kept until the end of the writing, so that its address is not reused
+ * for other written data.
+ */
+static void write_file_index(WriteData *wd,
+                             const blender::Span<ID *> ids,
+                             blender::Vector<char> &r_buffer)
+{
+  r_buffer.extend(blender::Span(BLO_FILE_INDEX_MAGIC, BLO_FILE_INDEX_MAGIC_LEN));
+  for (const ID *id : ids) {
+    r_buffer.extend(blender::Span(id->name, int64_t(strlen(id->name)) + 1));
+  }
+  writedata(wd, BLO_CODE_DATA, size_t(r_buffer.size()), r_buffer.data());
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1486,6 +1651,12 @@ static bool write_file_handle(Main *mainvar,
 
   wd = mywrite_begin(ww, compare, current);
   wd->debug_dst = debug_dst;
+  /* Undo steps share data with the current Main instead, see #BLO_write_shared. */
+  wd->use_cross_id_shared_data = (write_flags & G_FILE_CROSS_ID_SHARED_DATA) &&
+                                 !wd->use_memfile;
+  /* Relies on all changes being tagged, which is not guaranteed yet. */
+  wd->use_memfile_incremental = wd->use_memfile && (compare != nullptr) &&
+                                USER_EXPERIMENTAL_TEST(&U, use_undo_incremental_write);
   BlendWriter writer = {wd};
 
   /* Clear 'directly linked' flag for all linked data, these are not necessarily valid/up-to-date
@@ -1533,18 +1704,22 @@ static bool write_file_handle(Main *mainvar,
     }
   }
 
+  const bool is_undo = wd->use_memfile;
+  blender::Vector<ID *> local_ids_to_write = gather_local_ids_to_write(mainvar, is_undo);
+
   write_blend_file_header(wd);
   write_renderinfo(wd, mainvar);
   write_thumb(wd, thumb);
+  blender::Vector<char> file_index_buffer;
+  if (!is_undo) {
+    write_file_index(wd, local_ids_to_write, file_index_buffer);
+  }
   write_global(wd, write_flags, mainvar);
 
   /* The window-manager and screen often change,
    * avoid thumbnail detecting changes because of this. */
   mywrite_flush(wd);
 
-  const bool is_undo = wd->use_memfile;
-  blender::Vector<ID *> local_ids_to_write = gather_local_ids_to_write(mainvar, is_undo);
-
   if (!is_undo) {
     /* If not writing undo data, properly set directly linked IDs as `ID_TAG_EXTERN`. */
     for (ID *id : local_ids_to_write) {
@@ -1563,10 +1738,33 @@ static bool write_file_handle(Main *mainvar,
     }
   }
 
-  /* Actually write local data-blocks to the file. */
+  /* Actually write local data-blocks to the file.
+   *
+   * Consecutive IDs which support it are serialized in parallel, in batches to limit the amount
+   * of memory used. This is not done for undo, where the chunks are compared with the previous
+   * undo step while writing, nor when implicitly shared data is shared across IDs, since whether
+   * such data gets written depends on the IDs written before. */
+  const bool use_parallel_write = !wd->use_memfile && !wd->use_cross_id_shared_data &&
+                                  (wd->debug_dst == nullptr);
+  const int64_t parallel_batch_size = BLI_system_thread_count();
+  blender::Vector<ID *> parallel_ids;
   for (ID *id : local_ids_to_write) {
+    if (write_id_reuse_undo_step(wd, id)) {
+      continue;
+    }
+    if (use_parallel_write && write_id_is_threadsafe(id)) {
+      parallel_ids.append(id);
+      if (parallel_ids.size() >= parallel_batch_size) {
+        write_ids_parallel(wd, parallel_ids);
+        parallel_ids.clear();
+      }
+      continue;
+    }
+    write_ids_parallel(wd, parallel_ids);
+    parallel_ids.clear();
     write_id(wd, id);
   }
+  write_ids_parallel(wd, parallel_ids);
 
   /* Write libraries about libraries and linked data-blocks. */
   write_libraries(wd, mainvar);
@@ -1870,6 +2068,117 @@ bool BLO_write_file(Main *mainvar,
   return BLO_write_file_impl(mainvar, filepath, write_flags, params, reports, raw_wrap);
 }
 
+/**
+ * Keeps all written data in memory, so that compressing and writing it to disk can be done later
+ * on a different thread. The data is passed on in the same pieces as it was written, so the
+ * resulting file is identical to writing it directly.
+ */
+class MemoryWriteWrap : public WriteWrap {
+ public:
+  struct Chunk {
+    void *data;
+    size_t size;
+  };
+  blender::Vector<Chunk> chunks;
+
+  bool open(const char * /*filepath*/) override
+  {
+    return true;
+  }
+  bool close() override
+  {
+    return true;
+  }
+  bool write(const void *buf, const size_t buf_len) override
+  {
+    void *data = MEM_mallocN(buf_len, __func__);
+    memcpy(data, buf, buf_len);
+    chunks.append({data, buf_len});
+    return true;
+  }
+
+  void free_chunks()
+  {
+    for (const Chunk &chunk : chunks) {
+      MEM_freeN(chunk.data);
+    }
+    chunks.clear();
+  }
+};
+
+static std::thread async_write_thread;
+
+static void write_file_async_task(const std::string filepath,
+                                  const bool use_compression,
+                                  MemoryWriteWrap *mem_wrap)
+{
+  const std::string tempname = filepath + "@";
+  RawWriteWrap raw_wrap;
+  ZstdWriteWrap zstd_wrap(raw_wrap);
+  WriteWrap &ww = use_compression ? static_cast<WriteWrap &>(zstd_wrap) : raw_wrap;
+
+  bool success = ww.open(tempname.c_str());
+  if (success) {
+    for (const MemoryWriteWrap::Chunk &chunk : mem_wrap->chunks) {
+      if (!ww.write(chunk.data, chunk.size)) {
+        success = false;
+        break;
+      }
+    }
+    success &= ww.close();
+  }
+  mem_wrap->free_chunks();
+  MEM_delete(mem_wrap);
+
+  if (!success) {
+    CLOG_ERROR(&LOG, "Cannot write file \"%s\": %s", tempname.c_str(), strerror(errno));
+    remove(tempname.c_str());
+    return;
+  }
+  if (BLI_rename_overwrite(tempname.c_str(), filepath.c_str()) != 0) {
+    CLOG_ERROR(&LOG, "Cannot change old file \"%s\" (file saved with @)", filepath.c_str());
+  }
+}
+
+bool BLO_write_file_async(Main *mainvar,
+                          const char *filepath,
+                          const int write_flags,
+                          ReportList *reports)
+{
+  BLI_assert(BLI_thread_is_main());
+  BLI_assert(BLI_path_is_abs_from_cwd(filepath));
+
+  /* Only one file is written at a time, this also avoids writing the same file concurrently. */
+  BLO_write_file_async_wait();
+
+  write_file_main_validate_pre(mainvar, reports);
+
+  MemoryWriteWrap *mem_wrap = MEM_new<MemoryWriteWrap>(__func__);
+  const bool err = write_file_handle(
+      mainvar, mem_wrap, nullptr, nullptr, write_flags, false, nullptr, nullptr);
+  if (err) {
+    BKE_report(reports, RPT_ERROR, strerror(errno));
+    mem_wrap->free_chunks();
+    MEM_delete(mem_wrap);
+    return false;
+  }
+
+  write_file_main_validate_post(mainvar, reports);
+
+  async_write_thread = std::thread(write_file_async_task,
+                                   std::string(filepath),
+                                   (write_flags & G_FILE_COMPRESS) != 0,
+                                   mem_wrap);
+  return true;
+}
+
+void BLO_write_file_async_wait()
+{
+  if (async_write_thread.joinable()) {
+    async_write_thread.join();
+  }
+}
+
 bool BLO_write_file_mem(Main *mainvar, MemFile *compare, MemFile *current, const int write_flags)
 {
   bool use_userdef = false;
@@ -2051,6 +2360,9 @@ void BLO_write_shared(BlendWriter *writer,
       if (memfile.shared_storage->map.add(data, sharing_info)) {
         /* The undo-step takes (shared) ownership of the data, which also makes it immutable. */
         sharing_info->add_user();
+        memfile.shared_storage->id_session_uid_data
+            .lookup_or_add_default(writer->wd->mem.current_id_session_uid)
+            .append(data);
         /* This size is an estimate, but good enough to count data with many users less. */
         memfile.size += approximate_size_in_bytes / sharing_info->strong_users();
         return;
@@ -2058,7 +2370,10 @@ void BLO_write_shared(BlendWriter *writer,
     }
   }
   if (sharing_info != nullptr) {
-    if (!writer->wd->per_id_written_shared_addresses.add(data)) {
+    blender::Set<const void *> &written_shared_addresses =
+        writer->wd->use_cross_id_shared_data ? writer->wd->written_shared_addresses :
+                                               writer->wd->per_id_written_shared_addresses;
+    if (!written_shared_addresses.add(data)) {
       /* Was written already. */
       return;
     }
@@ -108,6 +108,11 @@ class Context {
    * or support for viewers. */
   virtual bool treat_viewer_as_composite_output() const;
 
+  /* True if viewers should write to the compositing region of their output like composite outputs
+   * do, instead of writing their input as is. This is the case when viewers are treated as
+   * composite outputs, but also when the compositing region is limited to a viewer border. */
+  virtual bool write_viewer_to_compositing_region() const;
+
   /* Populates the given meta data from the render stamp information of the given render pass. */
   virtual void populate_meta_data_for_pass(const Scene *scene,
                                            int view_layer_id,
@@ -6,6 +6,7 @@
 
 #include <memory>
 
+#include "BLI_map.hh"
 #include "BLI_vector.hh"
 
 #include "NOD_derived_node_tree.hh"
@@ -93,6 +94,10 @@ class Evaluator {
   std::unique_ptr<DerivedNodeTree> derived_node_tree_;
   /* The compiled operations stream, which contains all compiled operations so far. */
   Vector<std::unique_ptr<Operation>> operations_stream_;
+  /* The fingerprints of the nodes evaluated so far whose results only depend on their inputs and
+   * parameters, see the compute_node_fingerprint method. Nodes that are not in the map can't have
+   * their results cached. */
+  Map<DNode, uint64_t> node_fingerprints_;
 
  public:
   /* Construct an evaluator from a context. */
@@ -109,6 +114,20 @@ class Evaluator {
    * method. */
   bool validate_node_tree();
 
+  /* Compute a fingerprint of the given node from its parameters, the values of its unlinked
+   * inputs, the fingerprints of the nodes linked to its inputs, and the parts of the context it
+   * may depend on, and add it to the node_fingerprints_ map. Nothing is added if the results of
+   * the node can change without its fingerprint changing, for instance, if it reads an ID or
+   * depends on a node that does. The nodes linked to the inputs of the node should have been
+   * considered already, which is the case when going over the schedule in order. */
+  void compute_node_fingerprint(DNode node);
+
+  /* If the given node has a fingerprint, evaluate its operation by sharing the results cached in
+   * the static cache manager from a previous evaluation with the same fingerprint if they exist,
+   * otherwise, evaluate the operation and cache its results. Returns false if the node has no
+   * fingerprint, in which case the operation is not evaluated. */
+  bool evaluate_node_from_cache(DNode node, NodeOperation *operation);
+
   /* Compile the given node into a node operation, map each input to the result of the output
    * linked to it, update the compile state, add the newly created operation to the operations
    * stream, and evaluate the operation. */
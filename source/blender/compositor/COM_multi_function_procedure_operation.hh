@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <utility>
 
 #include "BLI_map.hh"
 #include "BLI_set.hh"
@@ -51,6 +52,10 @@ class MultiFunctionProcedureOperation : public PixelOperation {
    * but are not associated with a node output. Those variables are for such multi-functions like
    * constant inputs and implicit conversion. */
   Vector<mf::Variable *> implicit_variables_;
+  /* A map that associates variables and the types they were converted to with the variables that
+   * store the converted values, such that a variable is converted at most once to each type, even
+   * if it is used by multiple inputs. See the convert_variable method. */
+  Map<std::pair<mf::Variable *, mf::DataType>, mf::Variable *> converted_variables_;
   /* A set that stores the variables that are used as the outputs of the procedure. */
   Set<mf::Variable *> output_variables_;
   /* A vector that stores the identifiers of the parameters of the multi-function procedure in
@@ -109,8 +114,9 @@ class MultiFunctionProcedureOperation : public PixelOperation {
   void populate_operation_result(DOutputSocket output_socket, mf::Variable *variable);
 
   /* Convert the given variable to the given expected type. This is done by adding an implicit
-   * conversion function whose output variable will be returned. If no conversion is needed, the
-   * given variable is returned as is. */
+   * conversion function whose output variable will be returned, unless the variable was already
+   * converted to that type, in which case the existing converted variable is returned. If no
+   * conversion is needed, the given variable is returned as is. */
   mf::Variable *convert_variable(mf::Variable *variable, const mf::DataType expected_type);
 
   /* Returns true if the operation operates on single values, that is, all of its inputs are single
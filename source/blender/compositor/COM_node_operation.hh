@@ -4,6 +4,9 @@
 
 #pragma once
 
+#include <string>
+
+#include "BLI_map.hh"
 #include "BLI_string_ref.hh"
 
 #include "DNA_node_types.h"
@@ -42,6 +45,13 @@ class NodeOperation : public Operation {
    * in the context's profile data. */
   void evaluate() override;
 
+  /* Evaluate the operation by sharing the data of the given results, identified by their output
+   * identifiers, with the results of the operation instead of executing it. This is used to reuse
+   * the results cached from a previous evaluation. Returns false without doing anything if some
+   * needed output is not in the given results, in which case the operation should be evaluated
+   * normally. */
+  bool evaluate_from_cache(const Map<std::string, Result> &cached_results);
+
   /* Compute and set the initial reference counts of all the results of the operation. The
    * reference counts of the results are the number of operations that use those results, which is
    * computed as the number of inputs whose node is part of the schedule and is linked to the
@@ -109,6 +109,9 @@ class Operation {
    * operations will not get evaluated and thus will not free the results it consumes. */
   void free_results();
 
+  /* Returns the size in bytes of the data of the allocated results of the operation. */
+  int64_t results_size_in_bytes() const;
+
  protected:
   /* Compute the operation domain of this operation. By default, this implements a default logic
    * that infers the operation domain from the inputs, which may be overridden for a different
@@ -161,15 +164,15 @@ class Operation {
   /* Returns a reference to the compositor context. */
   Context &context() const;
 
- private:
-  /* Evaluate the input processors. If the input processors were already added they will be
-   * evaluated directly. Otherwise, the input processors will be added and evaluated. */
-  void evaluate_input_processors();
-
   /* Release the results that are mapped to the inputs of the operation. This is called after the
    * evaluation of the operation to declare that the results are no longer needed by this
    * operation. */
   void release_inputs();
+
+ private:
+  /* Evaluate the input processors. If the input processors were already added they will be
+   * evaluated directly. Otherwise, the input processors will be added and evaluated. */
+  void evaluate_input_processors();
 };
 
 }  // namespace blender::compositor
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include <ostream>
+
 #include "BLI_map.hh"
+#include "BLI_string_ref.hh"
 #include "BLI_timeit.hh"
+#include "BLI_vector.hh"
 
 #include "DNA_node_types.h"
 
@@ -17,14 +21,34 @@ class Context;
  * Profiler
  *
  * A class that profiles the evaluation of the compositor and tracks information like the
- * evaluation time of every node. */
+ * evaluation time and memory usage of every node. */
 class Profiler {
+ public:
+  /* The profile of a pixel operation, which evaluates multiple pixel-wise nodes at once. */
+  struct PixelOperationProfile {
+    /* The instance keys of the nodes compiled into the operation. */
+    Vector<bNodeInstanceKey> nodes;
+    timeit::Nanoseconds evaluation_time;
+    /* The size in bytes of the output results of the operation. */
+    int64_t memory_usage;
+  };
+
  private:
   /* Stores the evaluation time of each node instance keyed by its instance key. Note that
    * pixel-wise nodes like Math nodes will not be measured, that's because they are compiled
    * together with other pixel-wise operations in a single operation, so we can't measure the
    * evaluation time of each individual node. */
   Map<bNodeInstanceKey, timeit::Nanoseconds> nodes_evaluation_times_;
+  /* Stores the size in bytes of the output results of each node instance keyed by its instance
+   * key, which is the memory the node adds to the compositor while its results are in use. Similar
+   * to evaluation times, pixel-wise nodes are not measured individually. */
+  Map<bNodeInstanceKey, int64_t> nodes_memory_usage_;
+  /* Stores the profiles of the pixel operations, in evaluation order. */
+  Vector<PixelOperationProfile> pixel_operations_;
+  /* If true, the GPU is synchronized before and after every profiled operation, such that the
+   * measured time includes the execution of its shaders on the GPU and not just the time it took
+   * to submit them. This stalls the GPU pipeline, so it is only enabled for detailed profiles. */
+  bool synchronize_gpu_ = false;
 
  public:
   /* Returns a reference to the nodes evaluation times. */
@@ -33,15 +57,43 @@ class Profiler {
   /* Set the evaluation time of the node identified by the given node instance key. */
   void set_node_evaluation_time(bNodeInstanceKey node_instance_key, timeit::Nanoseconds time);
 
+  /* Returns a reference to the nodes memory usage. */
+  Map<bNodeInstanceKey, int64_t> &get_nodes_memory_usage();
+
+  /* Add the given size in bytes to the memory usage of the node identified by the given node
+   * instance key. */
+  void add_node_memory_usage(bNodeInstanceKey node_instance_key, int64_t size);
+
+  /* Add the profile of a pixel operation that was evaluated. */
+  void add_pixel_operation(PixelOperationProfile profile);
+
+  /* Set whether the GPU should be synchronized around profiled operations. See
+   * synchronize_gpu_ for more information. */
+  void set_synchronize_gpu(bool synchronize_gpu);
+
+  /* Returns true if the GPU should be synchronized around profiled operations. */
+  bool synchronize_gpu() const;
+
   /* Finalize profiling by computing node group times. This should be called after evaluation. */
   void finalize(const bNodeTree &node_tree);
 
+  /* Write the profile of the evaluation of the given node tree as JSON to the given stream. */
+  void write_json(const bNodeTree &node_tree, std::ostream &stream) const;
+
+  /* Same as write_json but writes to the file at the given path, overwriting it. Returns false if
+   * the file could not be opened for writing. */
+  bool write_json(const bNodeTree &node_tree, StringRefNull filepath) const;
+
  private:
   /* Computes the evaluation time of every group node inside the given tree recursively by
    * accumulating the evaluation time of its nodes, setting the computed time to the group nodes.
    * The time is returned since the method is called recursively. */
   timeit::Nanoseconds accumulate_node_group_times(const bNodeTree &node_tree,
                                                   bNodeInstanceKey instance_key);
+
+  /* Same as accumulate_node_group_times but for the memory usage. */
+  int64_t accumulate_node_group_memory_usage(const bNodeTree &node_tree,
+                                             bNodeInstanceKey instance_key);
 };
 
 }  // namespace blender::compositor
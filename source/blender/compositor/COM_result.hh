@@ -323,6 +323,12 @@ class Result {
   /* Returns true if the result is allocated. */
   bool is_allocated() const;
 
+  /* Returns true if the result wraps external data that it doesn't own. */
+  bool is_external() const;
+
+  /* Returns the size in bytes of the data of the result, or zero if it is not allocated. */
+  int64_t size_in_bytes() const;
+
   /* Returns the reference count of the result. */
   int reference_count() const;
 
@@ -7,6 +7,7 @@
 #include "COM_bokeh_kernel.hh"
 #include "COM_cached_image.hh"
 #include "COM_cached_mask.hh"
+#include "COM_cached_node_result.hh"
 #include "COM_cached_shader.hh"
 #include "COM_cached_texture.hh"
 #include "COM_deriche_gaussian_coefficients.hh"
@@ -67,6 +68,7 @@ class StaticCacheManager {
   FogGlowKernelContainer fog_glow_kernels;
   TextureCoordinatesContainer texture_coordinates;
   PixelCoordinatesContainer pixel_coordinates;
+  CachedNodeResultContainer cached_node_results;
 
  private:
   /* The cache manager should skip the next reset. See the skip_next_reset() method for more
@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BLI_map.hh"
+
+#include "DNA_node_types.h"
+
+#include "COM_cached_resource.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+class Context;
+
+/* -------------------------------------------------------------------------------------------------
+ * Cached Node Result.
+ *
+ * A cached resource that stores the output results of a node operation along with a fingerprint
+ * of everything the results were computed from, that is, the node parameters, the unlinked input
+ * values, and the fingerprints of the nodes linked to its inputs. If a node has the same
+ * fingerprint in a later evaluation, the cached results can be shared with the outputs of its
+ * operation instead of executing it. The results share data with the ones they were cached from,
+ * so caching doesn't copy any data. */
+class CachedNodeResult : public CachedResource {
+ public:
+  uint64_t fingerprint;
+  /* The cached results, identified by the identifier of their output. Only outputs that were
+   * computed when the node was cached are stored. */
+  Map<std::string, Result> results;
+
+  CachedNodeResult(uint64_t fingerprint);
+
+  ~CachedNodeResult();
+
+  /* Returns the size in bytes of the data of the cached results. */
+  int64_t size_in_bytes() const;
+};
+
+/* ------------------------------------------------------------------------------------------------
+ * Cached Node Result Container.
+ *
+ * Stores at most one cached node result per node instance, which is replaced when the node is
+ * cached again with a different fingerprint. The total size of the cached data is limited by a
+ * memory budget, nodes that don't fit in it are not cached. */
+class CachedNodeResultContainer : CachedResourceContainer {
+ private:
+  Map<bNodeInstanceKey, std::unique_ptr<CachedNodeResult>> map_;
+
+  /* The size in bytes of the data of all the cached node results in the map. */
+  int64_t size_in_bytes_ = 0;
+
+ public:
+  /* The maximum size in bytes of the data of all the cached node results. */
+  static constexpr int64_t memory_budget = int64_t(1) << 30;
+
+  void reset() override;
+
+  /* Returns the cached node result of the node with the given instance key if it exists and has
+   * the given fingerprint, otherwise, returns nullptr. In the former case, tag the cached resource
+   * as needed to keep it cached for the next evaluation. */
+  const CachedNodeResult *get(bNodeInstanceKey instance_key, uint64_t fingerprint);
+
+  /* Cache the given allocated results of the node with the given instance key and fingerprint,
+   * replacing any previously cached results for the node. The results are not cached if their
+   * data doesn't fit in the memory budget or can't be shared, like results that wrap external data
+   * or GPU results. */
+  void add(Context &context,
+           bNodeInstanceKey instance_key,
+           uint64_t fingerprint,
+           const Map<std::string, const Result *> &results);
+
+  /* Removes the cached result of the node with the given instance key if it exists. */
+  void remove(bNodeInstanceKey instance_key);
+};
+
+}  // namespace blender::compositor
@@ -0,0 +1,120 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "BLI_map.hh"
+
+#include "DNA_node_types.h"
+
+#include "COM_cached_node_result.hh"
+#include "COM_context.hh"
+#include "COM_result.hh"
+
+namespace blender::compositor {
+
+/* --------------------------------------------------------------------
+ * Cached Node Result.
+ */
+
+CachedNodeResult::CachedNodeResult(uint64_t fingerprint) : fingerprint(fingerprint) {}
+
+CachedNodeResult::~CachedNodeResult()
+{
+  for (Result &result : this->results.values()) {
+    result.release();
+  }
+}
+
+int64_t CachedNodeResult::size_in_bytes() const
+{
+  int64_t size = 0;
+  for (const Result &result : this->results.values()) {
+    size += result.size_in_bytes();
+  }
+  return size;
+}
+
+/* --------------------------------------------------------------------
+ * Cached Node Result Container.
+ */
+
+void CachedNodeResultContainer::reset()
+{
+  /* First, delete all cached node results that are no longer needed. */
+  map_.remove_if([&](auto item) {
+    if (item.value->needed) {
+      return false;
+    }
+    size_in_bytes_ -= item.value->size_in_bytes();
+    return true;
+  });
+
+  /* Second, reset the needed status of the remaining cached node results to false to ready them
+   * to track their needed status for the next evaluation. */
+  for (auto &value : map_.values()) {
+    value->needed = false;
+  }
+}
+
+const CachedNodeResult *CachedNodeResultContainer::get(const bNodeInstanceKey instance_key,
+                                                       const uint64_t fingerprint)
+{
+  std::unique_ptr<CachedNodeResult> *cached_node_result = map_.lookup_ptr(instance_key);
+  if (!cached_node_result || (*cached_node_result)->fingerprint != fingerprint) {
+    return nullptr;
+  }
+
+  (*cached_node_result)->needed = true;
+  return cached_node_result->get();
+}
+
+void CachedNodeResultContainer::add(Context &context,
+                                    const bNodeInstanceKey instance_key,
+                                    const uint64_t fingerprint,
+                                    const Map<std::string, const Result *> &results)
+{
+  this->remove(instance_key);
+
+  /* GPU results are typically allocated from the texture pool, which expects all textures to be
+   * released at the end of the evaluation, so only CPU results are cached. */
+  if (context.use_gpu()) {
+    return;
+  }
+
+  int64_t size = 0;
+  for (const Result *result : results.values()) {
+    if (result->is_external()) {
+      return;
+    }
+    size += result->size_in_bytes();
+  }
+
+  if (size_in_bytes_ + size > memory_budget) {
+    return;
+  }
+
+  std::unique_ptr<CachedNodeResult> cached_node_result = std::make_unique<CachedNodeResult>(
+      fingerprint);
+  for (const auto item : results.items()) {
+    Result result = context.create_result(item.value->type(), item.value->precision());
+    result.share_data(*item.value);
+    cached_node_result->results.add_new(item.key, result);
+  }
+
+  size_in_bytes_ += size;
+  map_.add_new(instance_key, std::move(cached_node_result));
+}
+
+void CachedNodeResultContainer::remove(const bNodeInstanceKey instance_key)
+{
+  std::unique_ptr<CachedNodeResult> cached_node_result = map_.pop_default(instance_key, nullptr);
+  if (cached_node_result) {
+    size_in_bytes_ -= cached_node_result->size_in_bytes();
+  }
+}
+
+}  // namespace blender::compositor
@@ -25,6 +25,11 @@ bool Context::treat_viewer_as_composite_output() const
   return false;
 }
 
+bool Context::write_viewer_to_compositing_region() const
+{
+  return this->treat_viewer_as_composite_output();
+}
+
 void Context::populate_meta_data_for_pass(const Scene * /*scene*/,
                                           int /*view_layer_id*/,
                                           const char * /*pass_name*/,
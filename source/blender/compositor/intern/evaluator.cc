@@ -2,13 +2,24 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <optional>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_hash.hh"
+#include "BLI_hash_mm2a.hh"
 #include "BLI_memory_utils.hh"
 #include "BLI_string.h"
+#include "BLI_timeit.hh"
 
 #include "DNA_node_types.h"
 
+#include "BKE_node.hh"
+
 #include "NOD_derived_node_tree.hh"
 
+#include "GPU_state.hh"
+
 #include "COM_compile_state.hh"
 #include "COM_context.hh"
 #include "COM_evaluator.hh"
@@ -17,6 +28,7 @@
 #include "COM_multi_function_procedure_operation.hh"
 #include "COM_node_operation.hh"
 #include "COM_operation.hh"
+#include "COM_profiler.hh"
 #include "COM_result.hh"
 #include "COM_scheduler.hh"
 #include "COM_shader_operation.hh"
@@ -59,6 +71,8 @@ void Evaluator::evaluate()
       return;
     }
 
+    this->compute_node_fingerprint(node);
+
     if (compile_state.should_compile_pixel_compile_unit(node)) {
       this->evaluate_pixel_compile_unit(compile_state);
     }
@@ -104,6 +118,106 @@ bool Evaluator::validate_node_tree()
   return true;
 }
 
+/* Hashes the given DNA data, which is expected to be allocated using the guarded allocator. */
+static uint64_t hash_allocated_data(const uint64_t hash, const void *data)
+{
+  if (!data) {
+    return hash;
+  }
+  const uint32_t data_hash = BLI_hash_mm2(
+      static_cast<const uchar *>(data), MEM_allocN_len(data), 0);
+  return get_default_hash(hash, data_hash);
+}
+
+/* Hashes the parts of the context that nodes may depend on in addition to their inputs. */
+static uint64_t compute_context_fingerprint(const Context &context)
+{
+  const rcti compositing_region = context.get_compositing_region();
+  uint64_t hash = get_default_hash(context.get_frame_number(),
+                                   int2(compositing_region.xmin, compositing_region.ymin),
+                                   int2(compositing_region.xmax, compositing_region.ymax),
+                                   context.get_render_size());
+  hash = get_default_hash(hash,
+                          context.get_render_percentage(),
+                          int(context.get_precision()),
+                          int(context.get_denoise_quality()));
+  hash = get_default_hash(hash, context.get_view_name());
+  return hash;
+}
+
+void Evaluator::compute_node_fingerprint(DNode node)
+{
+  /* Nodes that reference an ID read data like images, masks, or render passes, which can change
+   * without the node changing, and output nodes write to outputs that are not cached, so their
+   * results can't be reused, and neither can the results of the nodes that depend on them. */
+  if (node->id || node->typeinfo->nclass == NODE_CLASS_OUTPUT) {
+    return;
+  }
+
+  uint64_t hash = get_default_hash(compute_context_fingerprint(context_),
+                                   StringRef(node->idname),
+                                   node->custom1,
+                                   node->custom2);
+  hash = get_default_hash(hash, node->custom3, node->custom4);
+  hash = hash_allocated_data(hash, node->storage);
+
+  for (const bNodeSocket *input : node->input_sockets()) {
+    const DInputSocket dinput{node.context(), input};
+
+    if (!input->is_available()) {
+      continue;
+    }
+
+    const DSocket dorigin = get_input_origin_socket(dinput);
+
+    /* The input is unlinked, so its result is the default value of the origin socket. */
+    if (!dorigin->is_output()) {
+      hash = get_default_hash(hash, input->index(), dorigin->type);
+      hash = hash_allocated_data(hash, dorigin->default_value);
+      continue;
+    }
+
+    const std::optional<uint64_t> origin_fingerprint = node_fingerprints_.lookup_try(
+        dorigin.node());
+    if (!origin_fingerprint) {
+      return;
+    }
+    hash = get_default_hash(hash, input->index(), *origin_fingerprint, dorigin->index());
+  }
+
+  node_fingerprints_.add_new(node, hash);
+}
+
+bool Evaluator::evaluate_node_from_cache(DNode node, NodeOperation *operation)
+{
+  const std::optional<uint64_t> fingerprint = node_fingerprints_.lookup_try(node);
+  if (!fingerprint) {
+    return false;
+  }
+
+  CachedNodeResultContainer &cache = context_.cache_manager().cached_node_results;
+  const CachedNodeResult *cached_node_result = cache.get(node.instance_key(), *fingerprint);
+  if (cached_node_result && operation->evaluate_from_cache(cached_node_result->results)) {
+    return true;
+  }
+
+  operation->evaluate();
+
+  Map<std::string, const Result *> results;
+  for (const bNodeSocket *output : node->output_sockets()) {
+    if (!output->is_available()) {
+      continue;
+    }
+
+    const Result &result = operation->get_result(output->identifier);
+    if (result.is_allocated()) {
+      results.add_new(output->identifier, &result);
+    }
+  }
+  cache.add(context_, node.instance_key(), *fingerprint, results);
+  return true;
+}
+
 void Evaluator::evaluate_node(DNode node, CompileState &compile_state)
 {
   NodeOperation *operation = node->typeinfo->get_compositor_operation(context_, node);
@@ -119,6 +233,10 @@ void Evaluator::evaluate_node(DNode node, CompileState &compile_state)
 
   operation->compute_results_reference_counts(compile_state.get_schedule());
 
+  if (this->evaluate_node_from_cache(node, operation)) {
+    return;
+  }
+
   operation->evaluate();
 }
 
@@ -225,7 +343,28 @@ void Evaluator::evaluate_pixel_compile_unit(CompileState &compile_state)
 
   operation->compute_results_reference_counts(compile_state.get_schedule());
 
+  const bool synchronize_gpu = context_.use_gpu() && context_.profiler() &&
+                               context_.profiler()->synchronize_gpu();
+  if (synchronize_gpu) {
+    GPU_finish();
+  }
+  const timeit::TimePoint before_time = timeit::Clock::now();
   operation->evaluate();
+  if (synchronize_gpu) {
+    GPU_finish();
+  }
+  const timeit::TimePoint after_time = timeit::Clock::now();
+
+  /* Pixel nodes can't be measured individually, so profile the operation as a whole. */
+  if (context_.profiler()) {
+    Profiler::PixelOperationProfile profile;
+    for (const DNode &node : compile_unit) {
+      profile.nodes.append(node.instance_key());
+    }
+    profile.evaluation_time = after_time - before_time;
+    profile.memory_usage = operation->results_size_in_bytes();
+    context_.profiler()->add_pixel_operation(std::move(profile));
+  }
 
   compile_state.reset_pixel_compile_unit();
 }
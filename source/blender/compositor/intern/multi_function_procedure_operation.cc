@@ -149,6 +149,15 @@ void MultiFunctionProcedureOperation::build_procedure()
   BLI_assert(procedure_.validate());
 }
 
+/* Returns true if the given data type is a single float4 or ColorSceneLinear4f, which can be
+ * converted to one another without information loss. */
+static bool is_float4_or_color(const mf::DataType data_type)
+{
+  return ELEM(data_type,
+              mf::DataType::ForSingle<float4>(),
+              mf::DataType::ForSingle<ColorSceneLinear4f<eAlpha::Premultiplied>>());
+}
+
 Vector<mf::Variable *> MultiFunctionProcedureOperation::get_input_variables(
     DNode node, const mf::MultiFunction &multi_function)
 {
@@ -191,14 +200,21 @@ Vector<mf::Variable *> MultiFunctionProcedureOperation::get_input_variables(
       }
     }
 
+    const mf::DataType parameter_type =
+        multi_function.param_type(available_inputs_index).data_type();
+
     /* We allow multi-functions to use float4 as opposed to ColorSceneLinear4f in their signature
      * for easier development. Float4 and ColorSceneLinear4f will be implicitly converted to one
      * another without information loss, so this flexibility is fine. However, float4 conversion to
      * other types is different than ColorSceneLinear4f conversion to other types, and vice versa.
      * So we need to manually convert to ColorSceneLinear4f if either the input or the origin are
-     * color sockets for proper implicit conversion later on. */
-    if (get_node_socket_result_type(origin.bsocket()) == ResultType::Color ||
-        get_node_socket_result_type(input.bsocket()) == ResultType::Color)
+     * color sockets for proper implicit conversion later on. That is not needed if both the
+     * variable and the parameter are either float4 or ColorSceneLinear4f, which is the common case
+     * of links between color nodes, and skipping it avoids converting every pixel twice. */
+    if ((get_node_socket_result_type(origin.bsocket()) == ResultType::Color ||
+         get_node_socket_result_type(input.bsocket()) == ResultType::Color) &&
+        !(is_float4_or_color(input_variables.last()->data_type()) &&
+          is_float4_or_color(parameter_type)))
     {
       const mf::DataType expected_type = mf::DataType::ForSingle(
           CPPType::get<ColorSceneLinear4f<eAlpha::Premultiplied>>());
@@ -206,9 +222,7 @@ Vector<mf::Variable *> MultiFunctionProcedureOperation::get_input_variables(
     }
 
     /* Implicitly convert the variable type to the expected parameter type if needed. */
-    const mf::ParamType parameter_type = multi_function.param_type(available_inputs_index);
-    input_variables.last() = this->convert_variable(input_variables.last(),
-                                                    parameter_type.data_type());
+    input_variables.last() = this->convert_variable(input_variables.last(), parameter_type);
 
     available_inputs_index++;
   }
@@ -419,13 +433,15 @@ mf::Variable *MultiFunctionProcedureOperation::convert_variable(mf::Variable *va
     return variable;
   }
 
-  const bke::DataTypeConversions &conversion_table = bke::get_implicit_type_conversions();
-  const mf::MultiFunction *function = conversion_table.get_conversion_multi_function(
-      variable_type, expected_type);
+  return converted_variables_.lookup_or_add_cb({variable, expected_type}, [&]() {
+    const bke::DataTypeConversions &conversion_table = bke::get_implicit_type_conversions();
+    const mf::MultiFunction *function = conversion_table.get_conversion_multi_function(
+        variable_type, expected_type);
 
-  mf::Variable *converted_variable = procedure_builder_.add_call<1>(*function, {variable})[0];
-  implicit_variables_.append(converted_variable);
-  return converted_variable;
+    mf::Variable *converted_variable = procedure_builder_.add_call<1>(*function, {variable})[0];
+    implicit_variables_.append(converted_variable);
+    return converted_variable;
+  });
 }
 
 bool MultiFunctionProcedureOperation::is_single_value_operation()
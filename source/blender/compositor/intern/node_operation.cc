@@ -13,6 +13,7 @@
 #include "BKE_node.hh"
 
 #include "GPU_debug.hh"
+#include "GPU_state.hh"
 
 #include "COM_algorithm_compute_preview.hh"
 #include "COM_context.hh"
@@ -53,17 +54,58 @@ void NodeOperation::evaluate()
   if (context().use_gpu()) {
     GPU_debug_group_begin(node().bnode()->typeinfo->idname.c_str());
   }
+  /* Wait for previously submitted GPU work, such that only the work of this node is measured. */
+  const bool synchronize_gpu = context().use_gpu() && context().profiler() &&
+                               context().profiler()->synchronize_gpu();
+  if (synchronize_gpu) {
+    GPU_finish();
+  }
   const timeit::TimePoint before_time = timeit::Clock::now();
   Operation::evaluate();
+  if (synchronize_gpu) {
+    GPU_finish();
+  }
   const timeit::TimePoint after_time = timeit::Clock::now();
   if (context().profiler()) {
     context().profiler()->set_node_evaluation_time(node_.instance_key(), after_time - before_time);
+    context().profiler()->add_node_memory_usage(node_.instance_key(),
+                                                this->results_size_in_bytes());
   }
   if (context().use_gpu()) {
     GPU_debug_group_end();
   }
 }
 
+bool NodeOperation::evaluate_from_cache(const Map<std::string, Result> &cached_results)
+{
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    if (!output->is_available()) {
+      continue;
+    }
+
+    if (this->should_compute_output(output->identifier) &&
+        !cached_results.contains(output->identifier))
+    {
+      return false;
+    }
+  }
+
+  for (const bNodeSocket *output : this->node()->output_sockets()) {
+    if (!output->is_available()) {
+      continue;
+    }
+
+    if (this->should_compute_output(output->identifier)) {
+      this->get_result(output->identifier).share_data(cached_results.lookup(output->identifier));
+    }
+  }
+
+  this->compute_preview();
+  this->release_inputs();
+  this->context().evaluate_operation_post();
+  return true;
+}
+
 void NodeOperation::compute_preview()
 {
   if (bool(context().needed_outputs() & OutputTypes::Previews) && is_node_preview_needed(node())) {
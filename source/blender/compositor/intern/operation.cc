@@ -53,6 +53,15 @@ void Operation::free_results()
   }
 }
 
+int64_t Operation::results_size_in_bytes() const
+{
+  int64_t size = 0;
+  for (const Result &result : results_.values()) {
+    size += result.size_in_bytes();
+  }
+  return size;
+}
+
 Domain Operation::compute_domain()
 {
   /* Default to an identity domain in case no domain input was found, most likely because all
@@ -2,6 +2,11 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include <chrono>
+#include <string>
+
+#include "BLI_fileops.hh"
+#include "BLI_serialize.hh"
 #include "BLI_timeit.hh"
 
 #include "DNA_node_types.h"
@@ -25,6 +30,31 @@ void Profiler::set_node_evaluation_time(bNodeInstanceKey node_instance_key,
   nodes_evaluation_times_.lookup_or_add(node_instance_key, timeit::Nanoseconds::zero()) += time;
 }
 
+Map<bNodeInstanceKey, int64_t> &Profiler::get_nodes_memory_usage()
+{
+  return nodes_memory_usage_;
+}
+
+void Profiler::add_node_memory_usage(bNodeInstanceKey node_instance_key, int64_t size)
+{
+  nodes_memory_usage_.lookup_or_add(node_instance_key, 0) += size;
+}
+
+void Profiler::add_pixel_operation(PixelOperationProfile profile)
+{
+  pixel_operations_.append(std::move(profile));
+}
+
+void Profiler::set_synchronize_gpu(bool synchronize_gpu)
+{
+  synchronize_gpu_ = synchronize_gpu;
+}
+
+bool Profiler::synchronize_gpu() const
+{
+  return synchronize_gpu_;
+}
+
 timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_tree,
                                                           bNodeInstanceKey instance_key)
 {
@@ -62,10 +92,127 @@ timeit::Nanoseconds Profiler::accumulate_node_group_times(const bNodeTree &node_
   return tree_evaluation_time;
 }
 
+int64_t Profiler::accumulate_node_group_memory_usage(const bNodeTree &node_tree,
+                                                     bNodeInstanceKey instance_key)
+{
+  int64_t tree_memory_usage = 0;
+
+  for (const bNode *node : node_tree.all_nodes()) {
+    const bNodeInstanceKey node_instance_key = bke::node_instance_key(
+        instance_key, &node_tree, node);
+    if (!node->is_group()) {
+      tree_memory_usage += nodes_memory_usage_.lookup_default(node_instance_key, 0);
+      continue;
+    }
+
+    const bNodeTree *child_tree = reinterpret_cast<bNodeTree *>(node->id);
+    if (child_tree == nullptr) {
+      continue;
+    }
+
+    const int64_t group_memory_usage = this->accumulate_node_group_memory_usage(
+        *child_tree, node_instance_key);
+    nodes_memory_usage_.add_overwrite(node_instance_key, group_memory_usage);
+    tree_memory_usage += group_memory_usage;
+  }
+
+  return tree_memory_usage;
+}
+
 void Profiler::finalize(const bNodeTree &node_tree)
 {
-  /* Compute the evaluation time of all node groups starting from the root tree. */
+  /* Compute the evaluation time and memory usage of all node groups starting from the root
+   * tree. */
   this->accumulate_node_group_times(node_tree, bke::NODE_INSTANCE_KEY_BASE);
+  this->accumulate_node_group_memory_usage(node_tree, bke::NODE_INSTANCE_KEY_BASE);
+}
+
+static double to_milliseconds(const timeit::Nanoseconds time)
+{
+  return std::chrono::duration<double, std::milli>(time).count();
+}
+
+/* Appends the profile of every node in the given tree and its node groups to the given array,
+ * identifying nodes by their path from the root tree. Also fills the given map from instance keys
+ * to node paths. */
+static void write_nodes_json(const bNodeTree &node_tree,
+                             const bNodeInstanceKey instance_key,
+                             const std::string &path,
+                             const Map<bNodeInstanceKey, timeit::Nanoseconds> &evaluation_times,
+                             const Map<bNodeInstanceKey, int64_t> &memory_usage,
+                             Map<bNodeInstanceKey, std::string> &node_paths,
+                             io::serialize::ArrayValue &nodes)
+{
+  for (const bNode *node : node_tree.all_nodes()) {
+    const bNodeInstanceKey node_instance_key = bke::node_instance_key(
+        instance_key, &node_tree, node);
+    const std::string node_path = path + node->name;
+    node_paths.add(node_instance_key, node_path);
+
+    const timeit::Nanoseconds *evaluation_time = evaluation_times.lookup_ptr(node_instance_key);
+    const int64_t *memory = memory_usage.lookup_ptr(node_instance_key);
+    if (evaluation_time || memory) {
+      io::serialize::DictionaryValue &value = *nodes.append_dict();
+      value.append_str("path", node_path);
+      value.append_str("idname", node->idname);
+      value.append_double("evaluation_time",
+                          evaluation_time ? to_milliseconds(*evaluation_time) : 0.0);
+      value.append_int("memory_usage", memory ? *memory : 0);
+    }
+
+    const bNodeTree *child_tree = reinterpret_cast<bNodeTree *>(node->id);
+    if (node->is_group() && child_tree) {
+      write_nodes_json(*child_tree,
+                       node_instance_key,
+                       node_path + "/",
+                       evaluation_times,
+                       memory_usage,
+                       node_paths,
+                       nodes);
+    }
+  }
+}
+
+void Profiler::write_json(const bNodeTree &node_tree, std::ostream &stream) const
+{
+  using namespace io::serialize;
+
+  DictionaryValue root;
+
+  Map<bNodeInstanceKey, std::string> node_paths;
+  ArrayValue &nodes = *root.append_array("nodes");
+  write_nodes_json(node_tree,
+                   bke::NODE_INSTANCE_KEY_BASE,
+                   "",
+                   nodes_evaluation_times_,
+                   nodes_memory_usage_,
+                   node_paths,
+                   nodes);
+
+  ArrayValue &pixel_operations = *root.append_array("pixel_operations");
+  for (const PixelOperationProfile &profile : pixel_operations_) {
+    DictionaryValue &value = *pixel_operations.append_dict();
+    ArrayValue &operation_nodes = *value.append_array("nodes");
+    for (const bNodeInstanceKey node_instance_key : profile.nodes) {
+      operation_nodes.append_str(node_paths.lookup_default(node_instance_key, ""));
+    }
+    value.append_double("evaluation_time", to_milliseconds(profile.evaluation_time));
+    value.append_int("memory_usage", profile.memory_usage);
+  }
+
+  JsonFormatter formatter;
+  formatter.indentation_len = 2;
+  formatter.serialize(stream, root);
+}
+
+bool Profiler::write_json(const bNodeTree &node_tree, StringRefNull filepath) const
+{
+  fstream file(filepath.c_str(), std::ios::out);
+  if (!file.is_open()) {
+    return false;
+  }
+  this->write_json(node_tree, file);
+  return true;
 }
 
 }  // namespace blender::compositor
@@ -636,6 +636,31 @@ bool Result::is_allocated() const
   return false;
 }
 
+bool Result::is_external() const
+{
+  return is_external_;
+}
+
+int64_t Result::size_in_bytes() const
+{
+  if (!this->is_allocated()) {
+    return 0;
+  }
+
+  switch (storage_type_) {
+    case ResultStorageType::GPU: {
+      const GPUTexture *texture = this->gpu_texture();
+      const int64_t component_size = precision_ == ResultPrecision::Half ? 2 : 4;
+      return int64_t(GPU_texture_width(texture)) * GPU_texture_height(texture) *
+             GPU_texture_component_len(GPU_texture_format(texture)) * component_size;
+    }
+    case ResultStorageType::CPU:
+      return this->cpu_data().size_in_bytes();
+  }
+
+  return 0;
+}
+
 int Result::reference_count() const
 {
   return reference_count_;
@@ -71,6 +71,13 @@ void DEG_graph_relations_update(Depsgraph *graph);
 /** Tag all relations in the database for update. */
 void DEG_relations_tag_update(Main *bmain);
 
+/**
+ * Tag relations of the given ID for update in all dependency graphs. Cheaper than
+ * #DEG_relations_tag_update when only relations of the ID and to it changed, as only the ID is
+ * built again when possible.
+ */
+void DEG_id_tag_relations_update(Main *bmain, ID *id);
+
 /* Add Dependencies  ----------------------------- */
 
 /**
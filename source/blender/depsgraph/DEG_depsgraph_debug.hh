@@ -53,6 +53,25 @@ void DEG_debug_stats_gnuplot(const Depsgraph *graph,
                              const char *label,
                              const char *output_filename);
 
+/* ************************************************ */
+/* Evaluation Trace */
+
+/**
+ * Start recording the evaluations of the graph with per-operation timing, until
+ * #DEG_debug_trace_end is called. Recording again discards the previous recording.
+ */
+void DEG_debug_trace_begin(Depsgraph *graph);
+
+/**
+ * Stop recording and write the evaluations which happened since #DEG_debug_trace_begin in the
+ * Chrome trace event JSON format, which can be viewed in Perfetto or `chrome://tracing`.
+ *
+ * \return False when recording was not started or the file can not be written.
+ */
+bool DEG_debug_trace_end(Depsgraph *graph, const char *filepath);
+
+bool DEG_debug_trace_is_active(const Depsgraph *graph);
+
 /* ************************************************ */
 
 /** Compare two dependency graphs. */
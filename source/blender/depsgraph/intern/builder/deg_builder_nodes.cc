@@ -374,31 +374,36 @@ ID *DepsgraphNodeBuilder::ensure_cow_id(ID *id_orig)
 
 /* **** Build functions for entity nodes **** */
 
+void DepsgraphNodeBuilder::save_id_info(IDNode *id_node)
+{
+  /* It is possible that the ID does not need to have evaluated version in which case id_cow is
+   * the same as id_orig. Additionally, such ID might have been removed, which makes the check
+   * for whether id_cow is expanded to access freed memory. In order to deal with this we
+   * check whether an evaluated copy is needed based on a scalar value which does not lead to
+   * access of possibly deleted memory. */
+  IDInfo id_info{};
+  if (deg_eval_copy_is_needed(id_node->id_type) && deg_eval_copy_is_expanded(id_node->id_cow) &&
+      id_node->id_orig != id_node->id_cow)
+  {
+    id_info.id_cow = id_node->id_cow;
+  }
+  else {
+    id_info.id_cow = nullptr;
+  }
+  id_info.previously_visible_components_mask = id_node->visible_components_mask;
+  id_info.previous_eval_flags = id_node->eval_flags;
+  id_info.previous_customdata_masks = id_node->customdata_masks;
+  BLI_assert(!id_info_hash_.contains(id_node->id_orig_session_uid));
+  id_info_hash_.add_new(id_node->id_orig_session_uid, std::move(id_info));
+  id_node->id_cow = nullptr;
+}
+
 void DepsgraphNodeBuilder::begin_build()
 {
   /* Store existing evaluated versions of datablock, so we can re-use
    * them for new ID nodes. */
   for (IDNode *id_node : graph_->id_nodes) {
-    /* It is possible that the ID does not need to have evaluated version in which case id_cow is
-     * the same as id_orig. Additionally, such ID might have been removed, which makes the check
-     * for whether id_cow is expanded to access freed memory. In order to deal with this we
-     * check whether an evaluated copy is needed based on a scalar value which does not lead to
-     * access of possibly deleted memory. */
-    IDInfo id_info{};
-    if (deg_eval_copy_is_needed(id_node->id_type) && deg_eval_copy_is_expanded(id_node->id_cow) &&
-        id_node->id_orig != id_node->id_cow)
-    {
-      id_info.id_cow = id_node->id_cow;
-    }
-    else {
-      id_info.id_cow = nullptr;
-    }
-    id_info.previously_visible_components_mask = id_node->visible_components_mask;
-    id_info.previous_eval_flags = id_node->eval_flags;
-    id_info.previous_customdata_masks = id_node->customdata_masks;
-    BLI_assert(!id_info_hash_.contains(id_node->id_orig_session_uid));
-    id_info_hash_.add_new(id_node->id_orig_session_uid, std::move(id_info));
-    id_node->id_cow = nullptr;
+    save_id_info(id_node);
   }
 
   for (const OperationNode *op_node : graph_->entry_tags) {
@@ -417,6 +422,54 @@ void DepsgraphNodeBuilder::begin_build()
   graph_->entry_tags.clear();
 }
 
+void DepsgraphNodeBuilder::begin_build_incremental(Scene *scene,
+                                                   ViewLayer *view_layer,
+                                                   const Span<IDNode *> id_nodes_to_rebuild)
+{
+  const Set<const IDNode *> id_nodes_to_rebuild_set(id_nodes_to_rebuild);
+
+  for (IDNode *id_node : graph_->id_nodes) {
+    if (id_nodes_to_rebuild_set.contains(id_node)) {
+      save_id_info(id_node);
+      continue;
+    }
+    /* Kept nodes are not built again, the builders only need to know they exist. Their current
+     * state is what the build finalization compares against, also in case #add_id_node is called
+     * for them. */
+    IDInfo id_info{};
+    id_info.previously_visible_components_mask = id_node->visible_components_mask;
+    id_info.previous_eval_flags = id_node->eval_flags;
+    id_info.previous_customdata_masks = id_node->customdata_masks;
+    id_info_hash_.add_new(id_node->id_orig_session_uid, std::move(id_info));
+    id_node->previously_visible_components_mask = id_node->visible_components_mask;
+    id_node->previous_eval_flags = id_node->eval_flags;
+    id_node->previous_customdata_masks = id_node->customdata_masks;
+    built_map_.tag_built(id_node->id_orig,
+                         BuilderMap::TAG_COMPLETE | BuilderMap::TAG_COLLECTION_CHILDREN_HIERARCHY);
+  }
+
+  const auto is_rebuilt_operation = [&](const OperationNode *op_node) {
+    return id_nodes_to_rebuild_set.contains(op_node->owner->owner);
+  };
+  for (const OperationNode *op_node : graph_->entry_tags) {
+    if (is_rebuilt_operation(op_node)) {
+      saved_entry_tags_.append_as(op_node);
+    }
+  }
+  for (const OperationNode *op_node : graph_->operations) {
+    if ((op_node->flag & DEPSOP_FLAG_NEEDS_UPDATE) && is_rebuilt_operation(op_node)) {
+      needs_update_operations_.append_as(op_node);
+    }
+  }
+
+  graph_->remove_id_nodes(id_nodes_to_rebuild);
+
+  /* Same state as set up by #build_view_layer. */
+  scene_ = scene;
+  view_layer_ = view_layer;
+  view_layer_index_ = 0;
+}
+
 /* Utility callbacks for `BKE_library_foreach_ID_link`, used to detect when an evaluated ID is
  * using ID pointers that are either:
  *  - evaluated ID pointers that do not exist anymore in current depsgraph.
@@ -480,7 +533,7 @@ static int foreach_id_cow_detect_need_for_update_callback(LibraryIDLinkCallbackD
   return builder->foreach_id_cow_detect_need_for_update_callback(id_cow_self, id);
 }
 
-void DepsgraphNodeBuilder::update_invalid_cow_pointers()
+void DepsgraphNodeBuilder::update_invalid_cow_pointers(const Span<IDNode *> id_nodes)
 {
   /* NOTE: Currently the only ID types that depsgraph may decide to not evaluate/generate evaluated
    * copies for, even though they are referenced by other data-blocks, are Collections and Objects
@@ -492,7 +545,7 @@ void DepsgraphNodeBuilder::update_invalid_cow_pointers()
    * some cases. This is slightly unfortunate (as it may hide issues in other parts of Blender
    * code), but cannot really be avoided currently. */
 
-  for (const IDNode *id_node : graph_->id_nodes) {
+  for (const IDNode *id_node : id_nodes) {
     if (id_node->previously_visible_components_mask == 0) {
       /* Newly added node/ID, no need to check it. */
       continue;
@@ -558,7 +611,13 @@ void DepsgraphNodeBuilder::end_build()
 {
   graph_->light_linking_cache.end_build(*graph_->scene);
   tag_previously_tagged_nodes();
-  update_invalid_cow_pointers();
+  update_invalid_cow_pointers(graph_->id_nodes);
+}
+
+void DepsgraphNodeBuilder::end_build_incremental(const Span<IDNode *> id_nodes_to_check)
+{
+  tag_previously_tagged_nodes();
+  update_invalid_cow_pointers(id_nodes_to_check);
 }
 
 void DepsgraphNodeBuilder::build_id(ID *id, const bool force_be_visible)
@@ -91,6 +91,26 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
   virtual void begin_build();
   virtual void end_build();
 
+  /**
+   * Prepare to only build the nodes of the given IDs again, keeping the rest of the graph as-is.
+   * The given ID nodes are removed from the graph, their evaluated copies and update tags are
+   * transferred to the nodes which are built afterwards.
+   */
+  virtual void begin_build_incremental(Scene *scene,
+                                       ViewLayer *view_layer,
+                                       Span<IDNode *> id_nodes_to_rebuild);
+  /**
+   * Finish the incremental build, only the given ID nodes are checked for evaluated copies which
+   * need to be updated.
+   */
+  virtual void end_build_incremental(Span<IDNode *> id_nodes_to_check);
+
+  /**
+   * Index of the base of the object as used by #build_view_layer, -1 if the base of the object is
+   * not pulled into the graph.
+   */
+  int view_layer_base_index(Scene *scene, ViewLayer *view_layer, const Object *object);
+
   /**
    * `id_cow_self` is the user of `id_pointer`,
    * see also `LibraryIDLinkCallbackData` struct definition.
@@ -320,12 +340,17 @@ class DepsgraphNodeBuilder : public DepsgraphBuilder {
                               bool is_reference,
                               void *user_data);
 
+  /**
+   * Save the state of the ID node which is about to be re-created, and take ownership of its
+   * evaluated copy.
+   */
+  void save_id_info(IDNode *id_node);
   void tag_previously_tagged_nodes();
   /**
    * Check for IDs that need to be flushed (copy-on-eval-updated)
    * because the depsgraph itself created or removed some of their evaluated dependencies.
    */
-  void update_invalid_cow_pointers();
+  void update_invalid_cow_pointers(Span<IDNode *> id_nodes);
 
   /* State which demotes currently built entities. */
   Scene *scene_;
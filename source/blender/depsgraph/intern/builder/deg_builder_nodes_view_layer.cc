@@ -62,6 +62,25 @@ void DepsgraphNodeBuilder::build_freestyle_lineset(FreestyleLineSet *fls)
   }
 }
 
+int DepsgraphNodeBuilder::view_layer_base_index(Scene *scene,
+                                                ViewLayer *view_layer,
+                                                const Object *object)
+{
+  /* NOTE: Keep in sync with the base index used by #build_view_layer. */
+  int base_index = 0;
+  BKE_view_layer_synced_ensure(scene, view_layer);
+  LISTBASE_FOREACH (Base *, base, BKE_view_layer_object_bases_get(view_layer)) {
+    if (!need_pull_base_into_graph(base)) {
+      continue;
+    }
+    if (base->object == object) {
+      return base_index;
+    }
+    base_index++;
+  }
+  return -1;
+}
+
 void DepsgraphNodeBuilder::build_view_layer(Scene *scene,
                                             ViewLayer *view_layer,
                                             eDepsNode_LinkedState_Type linked_state)
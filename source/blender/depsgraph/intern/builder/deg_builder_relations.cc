@@ -512,6 +512,16 @@ Depsgraph *DepsgraphRelationBuilder::getGraph()
 
 void DepsgraphRelationBuilder::begin_build() {}
 
+void DepsgraphRelationBuilder::begin_build_incremental(Scene *scene, const Span<ID *> kept_ids)
+{
+  scene_ = scene;
+  /* Relations of the kept IDs are still in the graph. */
+  for (ID *id : kept_ids) {
+    built_map_.tag_built(id,
+                         BuilderMap::TAG_COMPLETE | BuilderMap::TAG_COLLECTION_CHILDREN_HIERARCHY);
+  }
+}
+
 void DepsgraphRelationBuilder::build_id(ID *id)
 {
   if (id == nullptr) {
@@ -2094,6 +2104,40 @@ void DepsgraphRelationBuilder::build_driver_variables(ID *id, FCurve *fcu)
     }
     DRIVER_TARGETS_LOOPER_END;
   }
+
+  /* Attributes accessed on variables in simple expressions, like `var.location[0]`. */
+  struct AttributeRelationsData {
+    DepsgraphRelationBuilder *builder;
+    const DriverTargetContext *driver_target_context;
+    const OperationKey *driver_key;
+    const RNAPathKey *self_key;
+  } attribute_data = {this, &driver_target_context, &driver_key, &self_key};
+
+  BKE_driver_simple_expression_foreach_attribute(
+      driver,
+      [](DriverVar *dvar, const char *attribute_path, void *user_data) {
+        const AttributeRelationsData &data = *static_cast<AttributeRelationsData *>(user_data);
+        PointerRNA target_prop;
+        if (!driver_get_target_property(
+                data.driver_target_context, dvar, &dvar->targets[0], &target_prop))
+        {
+          return;
+        }
+        PointerRNA ptr;
+        PropertyRNA *prop;
+        int index;
+        char *rna_path;
+        if (!driver_resolve_variable_attribute(
+                &target_prop, dvar, attribute_path, &ptr, &prop, &index, &rna_path))
+        {
+          return;
+        }
+        data.builder->build_id(target_prop.owner_id);
+        data.builder->build_driver_rna_path_variable(
+            *data.driver_key, *data.self_key, target_prop.owner_id, target_prop, rna_path);
+        MEM_freeN(rna_path);
+      },
+      &attribute_data);
 }
 
 void DepsgraphRelationBuilder::build_driver_scene_camera_variable(const OperationKey &driver_key,
@@ -83,6 +83,11 @@ class DepsgraphRelationBuilder : public DepsgraphBuilder {
   DepsgraphRelationBuilder(Main *bmain, Depsgraph *graph, DepsgraphBuilderCache *cache);
 
   void begin_build();
+  /**
+   * Prepare to only build the relations of the IDs which are not in the given list, the relations
+   * of the kept IDs are expected to be in the graph already.
+   */
+  void begin_build_incremental(Scene *scene, Span<ID *> kept_ids);
 
   template<typename KeyFrom, typename KeyTo>
   Relation *add_relation(const KeyFrom &key_from,
@@ -93,6 +93,7 @@ void AbstractBuilderPipeline::build_step_finalize()
 #endif
   /* Relations are up to date. */
   deg_graph_->need_update_relations = false;
+  deg_graph_->relations_update_id_session_uids.clear();
 }
 
 std::unique_ptr<DepsgraphNodeBuilder> AbstractBuilderPipeline::construct_node_builder()
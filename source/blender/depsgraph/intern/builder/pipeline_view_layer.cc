@@ -4,8 +4,29 @@
 
 #include "pipeline_view_layer.h"
 
+#include <cstdio>
+
+#include "BLI_listbase.h"
+#include "BLI_set.hh"
+#include "BLI_time.h"
+#include "BLI_vector.hh"
+
+#include "BKE_global.hh"
+
+#include "DNA_object_types.h"
+
+#include "DEG_depsgraph.hh"
+#include "DEG_depsgraph_build.hh"
+
+#include "intern/builder/deg_builder_key.h"
 #include "intern/builder/deg_builder_nodes.h"
 #include "intern/builder/deg_builder_relations.h"
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/node/deg_node.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
 
 namespace blender::deg {
 
@@ -24,4 +45,291 @@ void ViewLayerBuilderPipeline::build_relations(DepsgraphRelationBuilder &relatio
   relation_builder.build_view_layer(scene_, view_layer_, DEG_ID_LINKED_DIRECTLY);
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Incremental Build
+ * \{ */
+
+namespace {
+
+/* Relation between an operation of a rebuilt ID and an operation of a kept ID. It might have been
+ * created by the builders of the kept ID, which are not run again, so it is added back after the
+ * rebuild. */
+struct PreservedRelation {
+  /* Operation of the rebuilt ID, looked up again after the rebuild. */
+  PersistentOperationKey rebuilt_key;
+  OperationNode *kept_node;
+  bool is_from_rebuilt;
+  const char *name;
+  int flag;
+};
+
+}  // namespace
+
+static OperationNode *find_operation_node(const Depsgraph &graph, const OperationKey &key)
+{
+  const IDNode *id_node = graph.find_id_node(key.id);
+  if (id_node == nullptr) {
+    return nullptr;
+  }
+  const ComponentNode *comp_node = id_node->find_component(key.component_type,
+                                                           key.component_name);
+  if (comp_node == nullptr) {
+    return nullptr;
+  }
+  return comp_node->find_operation(key.opcode, key.name, key.name_tag);
+}
+
+static Vector<PreservedRelation> get_relations_to_preserve(
+    const Set<const IDNode *> &id_nodes_to_rebuild)
+{
+  Vector<PreservedRelation> relations;
+  const auto add_relations = [&](const OperationNode *op_node,
+                                 const Span<Relation *> links,
+                                 const bool is_from_rebuilt) {
+    for (const Relation *rel : links) {
+      Node *other_node = is_from_rebuilt ? rel->to : rel->from;
+      if (other_node->type != NodeType::OPERATION) {
+        /* Relations from the time source are built again. */
+        continue;
+      }
+      OperationNode *other_op_node = static_cast<OperationNode *>(other_node);
+      if (id_nodes_to_rebuild.contains(other_op_node->owner->owner)) {
+        continue;
+      }
+      relations.append({PersistentOperationKey(op_node),
+                        other_op_node,
+                        is_from_rebuilt,
+                        rel->name,
+                        rel->flag & ~RELATION_FLAG_CYCLIC});
+    }
+  };
+  for (const IDNode *id_node : id_nodes_to_rebuild) {
+    for (const ComponentNode *comp_node : id_node->components.values()) {
+      for (const OperationNode *op_node : comp_node->operations) {
+        add_relations(op_node, op_node->inlinks, false);
+        add_relations(op_node, op_node->outlinks, true);
+      }
+    }
+  }
+  return relations;
+}
+
+bool ViewLayerBuilderPipeline::can_rebuild_id_node(const IDNode &id_node)
+{
+  /* Only objects which are directly in the view layer are supported, other IDs can be used by
+   * many other IDs in ways which are not described by the relations. */
+  if (id_node.id_type != ID_OB || id_node.linked_state != DEG_ID_LINKED_DIRECTLY ||
+      !id_node.has_base)
+  {
+    return false;
+  }
+  const Object *object = reinterpret_cast<const Object *>(id_node.id_orig);
+  /* Effectors, simulations and light linking build relations from the scene or from all the
+   * objects affected by them, which the relations of the object can't describe. */
+  if (object->pd != nullptr || object->rigidbody_object != nullptr ||
+      object->rigidbody_constraint != nullptr || object->soft != nullptr ||
+      !BLI_listbase_is_empty(&object->particlesystem) || object->light_linking != nullptr)
+  {
+    return false;
+  }
+  return true;
+}
+
+bool ViewLayerBuilderPipeline::build_incremental_impl()
+{
+  if (G.debug_value == 799) {
+    /* Relations removed by the transitive reduction can't be restored. */
+    return false;
+  }
+  if (deg_graph_->light_linking_cache.has_light_linking()) {
+    return false;
+  }
+
+  Vector<IDNode *> id_nodes_to_rebuild;
+  Vector<ID *> kept_ids;
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    if (deg_graph_->relations_update_id_session_uids.contains(id_node->id_orig_session_uid)) {
+      id_nodes_to_rebuild.append(id_node);
+    }
+    else {
+      kept_ids.append(id_node->id_orig);
+    }
+  }
+  if (id_nodes_to_rebuild.is_empty() ||
+      id_nodes_to_rebuild.size() != deg_graph_->relations_update_id_session_uids.size())
+  {
+    return false;
+  }
+
+  std::unique_ptr<DepsgraphNodeBuilder> node_builder = construct_node_builder();
+  Vector<std::pair<Object *, int>> objects_to_rebuild;
+  for (IDNode *id_node : id_nodes_to_rebuild) {
+    if (!can_rebuild_id_node(*id_node)) {
+      return false;
+    }
+    Object *object = reinterpret_cast<Object *>(id_node->id_orig);
+    const int base_index = node_builder->view_layer_base_index(scene_, view_layer_, object);
+    if (base_index == -1) {
+      return false;
+    }
+    objects_to_rebuild.append({object, base_index});
+  }
+
+  const int id_nodes_num_prev = deg_graph_->id_nodes.size();
+  Vector<PreservedRelation> preserved_relations = get_relations_to_preserve(
+      Set<const IDNode *>(id_nodes_to_rebuild.as_span().cast<const IDNode *>()));
+
+  /* From here on the graph is modified. */
+  node_builder->begin_build_incremental(scene_, view_layer_, id_nodes_to_rebuild);
+  for (const auto &[object, base_index] : objects_to_rebuild) {
+    node_builder->build_object(base_index, object, DEG_ID_LINKED_DIRECTLY, true);
+    if (!deg_graph_->has_animated_visibility) {
+      deg_graph_->has_animated_visibility |= node_builder->is_object_visibility_animated(object);
+    }
+  }
+
+  const Set<const ID *> kept_ids_set(kept_ids.as_span().cast<const ID *>());
+  Vector<IDNode *> rebuilt_id_nodes;
+  for (IDNode *id_node : deg_graph_->id_nodes) {
+    if (!kept_ids_set.contains(id_node->id_orig)) {
+      rebuilt_id_nodes.append(id_node);
+    }
+  }
+  /* Kept IDs might use newly added IDs, which then need to be remapped in their evaluated
+   * copies. */
+  const bool has_new_id_nodes = deg_graph_->id_nodes.size() > id_nodes_num_prev;
+  node_builder->end_build_incremental(has_new_id_nodes ? deg_graph_->id_nodes.as_span() :
+                                                         rebuilt_id_nodes.as_span());
+  node_builder.reset();
+
+  std::unique_ptr<DepsgraphRelationBuilder> relation_builder = construct_relation_builder();
+  relation_builder->begin_build_incremental(scene_, kept_ids);
+  for (const auto &[object, base_index] : objects_to_rebuild) {
+    relation_builder->build_object_from_view_layer_base(object);
+  }
+  for (const PreservedRelation &relation : preserved_relations) {
+    OperationNode *rebuilt_node = find_operation_node(*deg_graph_, relation.rebuilt_key);
+    if (rebuilt_node == nullptr) {
+      /* The kept ID depends on an operation which does not exist anymore, its relations need to
+       * be built again. */
+      return false;
+    }
+    Node *from = relation.is_from_rebuilt ? static_cast<Node *>(rebuilt_node) : relation.kept_node;
+    Node *to = relation.is_from_rebuilt ? static_cast<Node *>(relation.kept_node) : rebuilt_node;
+    deg_graph_->add_new_relation(
+        from, to, relation.name, relation.flag | RELATION_CHECK_BEFORE_ADD);
+  }
+  for (IDNode *id_node : rebuilt_id_nodes) {
+    relation_builder->build_copy_on_write_relations(id_node);
+    relation_builder->build_driver_relations(id_node);
+  }
+  relation_builder.reset();
+
+  /* The builders of the kept IDs might have requested special evaluation of the rebuilt IDs. */
+  for (IDNode *id_node : rebuilt_id_nodes) {
+    id_node->eval_flags |= id_node->previous_eval_flags;
+    id_node->customdata_masks |= id_node->previous_customdata_masks;
+  }
+
+  build_step_finalize();
+  return true;
+}
+
+#ifndef NDEBUG
+
+static std::string node_signature(const Node *node)
+{
+  if (node->type != NodeType::OPERATION) {
+    return node->identifier();
+  }
+  const OperationNode *op_node = static_cast<const OperationNode *>(node);
+  return std::string(nodeTypeAsString(op_node->owner->type)) + " " + op_node->full_identifier();
+}
+
+static void graph_signatures(const Depsgraph &graph,
+                             Set<std::string> &r_operations,
+                             Set<std::string> &r_relations)
+{
+  const auto add_relations = [&](const Node *node, const Span<Relation *> outlinks) {
+    for (const Relation *rel : outlinks) {
+      r_relations.add(node_signature(node) + " -> " + node_signature(rel->to) + " (" + rel->name +
+                      ")");
+    }
+  };
+  if (graph.time_source != nullptr) {
+    add_relations(graph.time_source, graph.time_source->outlinks);
+  }
+  for (const OperationNode *op_node : graph.operations) {
+    r_operations.add(node_signature(op_node));
+    add_relations(op_node, op_node->outlinks);
+  }
+}
+
+/**
+ * Compare the incrementally built graph with a full build. Operations and relations which are
+ * missing are errors, while extra ones are expected: nodes and relations which are not needed
+ * anymore are only removed by the next full build.
+ */
+static bool validate_incremental_build(const Depsgraph &graph)
+{
+  ::Depsgraph *full_graph = DEG_graph_new(graph.bmain, graph.scene, graph.view_layer, graph.mode);
+  DEG_graph_build_from_view_layer(full_graph);
+
+  Set<std::string> operations, relations;
+  Set<std::string> full_operations, full_relations;
+  graph_signatures(graph, operations, relations);
+  graph_signatures(*reinterpret_cast<Depsgraph *>(full_graph), full_operations, full_relations);
+  DEG_graph_free(full_graph);
+
+  int missing_num = 0;
+  for (const std::string &operation : full_operations) {
+    if (!operations.contains(operation)) {
+      fprintf(stderr, "Incremental depsgraph build is missing operation %s\n", operation.c_str());
+      missing_num++;
+    }
+  }
+  for (const std::string &relation : full_relations) {
+    if (!relations.contains(relation)) {
+      fprintf(stderr, "Incremental depsgraph build is missing relation %s\n", relation.c_str());
+      missing_num++;
+    }
+  }
+  if (G.debug & G_DEBUG_DEPSGRAPH_BUILD) {
+    printf("Incremental depsgraph build validated: %d missing, %d extra nodes and relations.\n",
+           missing_num,
+           int(operations.size() + relations.size()) -
+               int(full_operations.size() + full_relations.size()) + missing_num);
+  }
+  return missing_num == 0;
+}
+
+#endif
+
+bool ViewLayerBuilderPipeline::build_incremental()
+{
+  double start_time = 0.0;
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    start_time = BLI_time_now_seconds();
+  }
+
+  if (!build_incremental_impl()) {
+    return false;
+  }
+
+  if (G.debug & (G_DEBUG_DEPSGRAPH_BUILD | G_DEBUG_DEPSGRAPH_TIME)) {
+    printf("Depsgraph built incrementally in %f seconds.\n", BLI_time_now_seconds() - start_time);
+  }
+
+#ifndef NDEBUG
+  /* Validation is expensive, only do it when debugging the depsgraph build. */
+  if ((G.debug & G_DEBUG_DEPSGRAPH_BUILD) && !validate_incremental_build(*deg_graph_)) {
+    return false;
+  }
+#endif
+
+  return true;
+}
+
+/** \} */
+
 }  // namespace blender::deg
@@ -12,13 +12,28 @@
 
 namespace blender::deg {
 
+struct IDNode;
+
 class ViewLayerBuilderPipeline : public AbstractBuilderPipeline {
  public:
   ViewLayerBuilderPipeline(::Depsgraph *graph);
 
+  /**
+   * Only build the IDs of #Depsgraph::relations_update_id_session_uids again, keeping the rest of
+   * the graph. Relations of the rebuilt IDs which were created by the builders of the kept IDs are
+   * preserved.
+   *
+   * \return False when the graph cannot be updated incrementally, in which case a full build is
+   * needed. The graph might have been modified already at that point.
+   */
+  bool build_incremental();
+
  protected:
   void build_nodes(DepsgraphNodeBuilder &node_builder) override;
   void build_relations(DepsgraphRelationBuilder &relation_builder) override;
+
+  bool build_incremental_impl();
+  bool can_rebuild_id_node(const IDNode &id_node);
 };
 
 }  // namespace blender::deg
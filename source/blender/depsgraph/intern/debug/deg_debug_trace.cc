@@ -0,0 +1,247 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ */
+
+#include "intern/debug/deg_debug_trace.h"
+
+#include <algorithm>
+
+#include "BLI_fileops.hh"
+#include "BLI_map.hh"
+#include "BLI_serialize.hh"
+#include "BLI_task.h"
+#include "BLI_time.h"
+
+#include "DNA_ID.h"
+
+#include "DEG_depsgraph_debug.hh"
+
+#include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
+#include "intern/node/deg_node_component.hh"
+#include "intern/node/deg_node_id.hh"
+#include "intern/node/deg_node_operation.hh"
+
+namespace blender::deg {
+
+DepsgraphTrace::DepsgraphTrace() : start_time_(BLI_time_now_seconds()) {}
+
+void DepsgraphTrace::begin_evaluation()
+{
+  evaluation_start_time_ = BLI_time_now_seconds();
+}
+
+void DepsgraphTrace::begin_stage(const char *name)
+{
+  stage_name_ = name;
+  stage_start_time_ = BLI_time_now_seconds();
+}
+
+void DepsgraphTrace::end_stage()
+{
+  Event stage;
+  stage.name = stage_name_;
+  stage.category = "Stage";
+  stage.thread = -1;
+  stage.start_time = stage_start_time_;
+  stage.duration = BLI_time_now_seconds() - stage_start_time_;
+  stage.evaluation_index = evaluations_num_;
+  stages_.append(std::move(stage));
+}
+
+void DepsgraphTrace::add_operation(const OperationNode &op_node,
+                                   const double start_time,
+                                   const double end_time)
+{
+  samples_.local().append(
+      {&op_node, BLI_task_parallel_thread_id(nullptr), start_time, end_time});
+}
+
+using OperationTimeMap = Map<const OperationNode *, double>;
+
+/* Time at which all dependencies of the operation which were evaluated were done, 0 if none of
+ * them were evaluated. */
+static double operation_ready_time(const OperationNode &op_node,
+                                   const OperationTimeMap &end_times,
+                                   OperationTimeMap &noop_ready_times)
+{
+  double ready_time = 0.0;
+  for (const Relation *rel : op_node.inlinks) {
+    if (rel->from->type != NodeType::OPERATION || (rel->flag & RELATION_FLAG_CYCLIC)) {
+      continue;
+    }
+    const OperationNode *parent = static_cast<const OperationNode *>(rel->from);
+    if (const double *end_time = end_times.lookup_ptr(parent)) {
+      ready_time = std::max(ready_time, *end_time);
+    }
+    else if (parent->is_noop()) {
+      /* No-op operations are not evaluated, their children are scheduled as soon as the no-op
+       * itself is ready. */
+      const double *parent_ready_time = noop_ready_times.lookup_ptr(parent);
+      if (parent_ready_time == nullptr) {
+        const double time = operation_ready_time(*parent, end_times, noop_ready_times);
+        noop_ready_times.add(parent, time);
+        ready_time = std::max(ready_time, time);
+      }
+      else {
+        ready_time = std::max(ready_time, *parent_ready_time);
+      }
+    }
+  }
+  return ready_time;
+}
+
+void DepsgraphTrace::end_evaluation()
+{
+  OperationTimeMap end_times;
+  for (const Vector<OperationSample> &thread_samples : samples_) {
+    for (const OperationSample &sample : thread_samples) {
+      end_times.add(sample.op_node, sample.end_time);
+    }
+  }
+
+  OperationTimeMap noop_ready_times;
+  for (Vector<OperationSample> &thread_samples : samples_) {
+    for (const OperationSample &sample : thread_samples) {
+      const OperationNode &op_node = *sample.op_node;
+      /* Operations without evaluated dependencies are ready at the beginning of their stage. */
+      double ready_time = operation_ready_time(op_node, end_times, noop_ready_times);
+      for (const Event &stage : stages_) {
+        if (stage.start_time <= sample.start_time) {
+          ready_time = std::max(ready_time, stage.start_time);
+        }
+      }
+
+      Event event;
+      event.name = op_node.identifier();
+      event.category = nodeTypeAsString(op_node.owner->type);
+      event.thread = sample.thread;
+      event.start_time = sample.start_time;
+      event.duration = sample.end_time - sample.start_time;
+      event.wait_time = std::max(sample.start_time - ready_time, 0.0);
+      event.evaluation_index = evaluations_num_;
+      event.id_name = op_node.owner->owner->id_orig->name;
+      event.component_name = op_node.owner->name;
+      events_.append(std::move(event));
+    }
+    thread_samples.clear();
+  }
+
+  Event evaluation;
+  evaluation.name = "Evaluation " + std::to_string(evaluations_num_);
+  evaluation.category = "Evaluation";
+  evaluation.thread = -1;
+  evaluation.start_time = evaluation_start_time_;
+  evaluation.duration = BLI_time_now_seconds() - evaluation_start_time_;
+  evaluation.evaluation_index = evaluations_num_;
+  events_.append(std::move(evaluation));
+  events_.extend(stages_);
+  stages_.clear();
+
+  evaluations_num_++;
+}
+
+bool DepsgraphTrace::write(const Depsgraph &graph, const char *filepath) const
+{
+  using namespace io::serialize;
+
+  /* Times are in microseconds. */
+  const auto trace_time = [&](const double time) { return (time - start_time_) * 1e6; };
+
+  DictionaryValue root;
+  root.append_str("displayTimeUnit", "ms");
+  ArrayValue &trace_events = *root.append_array("traceEvents");
+
+  DictionaryValue &process_name = *trace_events.append_dict();
+  process_name.append_str("name", "process_name");
+  process_name.append_str("ph", "M");
+  process_name.append_int("pid", 1);
+  process_name.append_dict("args")->append_str(
+      "name", graph.debug.name.empty() ? "Depsgraph" : "Depsgraph " + graph.debug.name);
+
+  /* The evaluation lane comes first, followed by a lane per thread. */
+  Vector<int> threads;
+  for (const Event &event : events_) {
+    if (!threads.contains(event.thread)) {
+      threads.append(event.thread);
+    }
+  }
+  std::sort(threads.begin(), threads.end());
+  for (const int thread : threads) {
+    DictionaryValue &thread_name = *trace_events.append_dict();
+    thread_name.append_str("name", "thread_name");
+    thread_name.append_str("ph", "M");
+    thread_name.append_int("pid", 1);
+    thread_name.append_int("tid", thread + 1);
+    thread_name.append_dict("args")->append_str(
+        "name", thread == -1 ? "Evaluation" : "Thread " + std::to_string(thread));
+    DictionaryValue &thread_sort_index = *trace_events.append_dict();
+    thread_sort_index.append_str("name", "thread_sort_index");
+    thread_sort_index.append_str("ph", "M");
+    thread_sort_index.append_int("pid", 1);
+    thread_sort_index.append_int("tid", thread + 1);
+    thread_sort_index.append_dict("args")->append_int("sort_index", thread + 1);
+  }
+
+  for (const Event &event : events_) {
+    DictionaryValue &value = *trace_events.append_dict();
+    value.append_str("name", event.name);
+    value.append_str("cat", event.category);
+    value.append_str("ph", "X");
+    value.append_int("pid", 1);
+    value.append_int("tid", event.thread + 1);
+    value.append_double("ts", trace_time(event.start_time));
+    value.append_double("dur", event.duration * 1e6);
+    DictionaryValue &args = *value.append_dict("args");
+    args.append_int("evaluation", event.evaluation_index);
+    if (!event.id_name.empty()) {
+      /* Skip the ID code. */
+      args.append_str("id", event.id_name.substr(2));
+      args.append_str("id_type", event.id_name.substr(0, 2));
+      if (!event.component_name.empty()) {
+        args.append_str("component", event.component_name);
+      }
+      args.append_double("wait_ms", event.wait_time * 1e3);
+    }
+  }
+
+  fstream file(filepath, std::ios::out);
+  if (!file.is_open()) {
+    return false;
+  }
+  JsonFormatter formatter;
+  formatter.serialize(file, root);
+  return true;
+}
+
+}  // namespace blender::deg
+
+namespace deg = blender::deg;
+
+void DEG_debug_trace_begin(Depsgraph *graph)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  BLI_assert(!deg_graph->is_evaluating);
+  deg_graph->debug.trace = std::make_unique<deg::DepsgraphTrace>();
+}
+
+bool DEG_debug_trace_end(Depsgraph *graph, const char *filepath)
+{
+  deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
+  BLI_assert(!deg_graph->is_evaluating);
+  std::unique_ptr<deg::DepsgraphTrace> trace = std::move(deg_graph->debug.trace);
+  if (!trace) {
+    return false;
+  }
+  return trace->write(*deg_graph, filepath);
+}
+
+bool DEG_debug_trace_is_active(const Depsgraph *graph)
+{
+  const deg::Depsgraph *deg_graph = reinterpret_cast<const deg::Depsgraph *>(graph);
+  return deg_graph->debug.trace != nullptr;
+}
@@ -0,0 +1,77 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup depsgraph
+ *
+ * Recording of dependency graph evaluations, exported in the Chrome trace event format which can
+ * be viewed in Perfetto or `chrome://tracing`.
+ */
+
+#pragma once
+
+#include <string>
+
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_vector.hh"
+
+namespace blender::deg {
+
+struct Depsgraph;
+struct OperationNode;
+
+class DepsgraphTrace {
+ public:
+  DepsgraphTrace();
+
+  void begin_evaluation();
+  /* Must be called while the evaluated operations still exist. */
+  void end_evaluation();
+
+  void begin_stage(const char *name);
+  void end_stage();
+
+  /* Record an evaluated operation, can be called from any thread. */
+  void add_operation(const OperationNode &op_node, double start_time, double end_time);
+
+  /* Write all events recorded so far. Returns false when the file can not be written. */
+  bool write(const Depsgraph &graph, const char *filepath) const;
+
+ private:
+  struct OperationSample {
+    const OperationNode *op_node;
+    int thread;
+    double start_time;
+    double end_time;
+  };
+
+  struct Event {
+    std::string name;
+    std::string category;
+    /* Lane of the event, -1 for the evaluation lane. */
+    int thread;
+    double start_time;
+    double duration;
+    /* Time between all dependencies of an operation being evaluated and its evaluation. */
+    double wait_time = 0.0;
+    int evaluation_index;
+    std::string id_name;
+    std::string component_name;
+  };
+
+  double start_time_;
+  int evaluations_num_ = 0;
+  double evaluation_start_time_ = 0.0;
+  double stage_start_time_ = 0.0;
+  const char *stage_name_ = nullptr;
+
+  /* Samples of the current evaluation, per thread to avoid locking. */
+  threading::EnumerableThreadSpecific<Vector<OperationSample>> samples_;
+  /* Stages of the current evaluation. */
+  Vector<Event> stages_;
+
+  Vector<Event> events_;
+};
+
+}  // namespace blender::deg
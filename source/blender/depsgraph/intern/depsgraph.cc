@@ -55,6 +55,7 @@ Depsgraph::Depsgraph(Main *bmain, Scene *scene, ViewLayer *view_layer, eEvaluati
       scene_cow(nullptr),
       is_active(false),
       use_visibility_optimization(true),
+      use_hidden_objects_lazy_evaluation(false),
       is_evaluating(false),
       is_render_pipeline_depsgraph(false),
       use_editors_update(false),
@@ -170,6 +171,49 @@ void Depsgraph::clear_id_nodes()
   light_linking_cache.clear();
 }
 
+void Depsgraph::remove_id_nodes(const Span<IDNode *> id_nodes_to_remove)
+{
+  Set<const ComponentNode *> components_to_remove;
+  for (IDNode *id_node : id_nodes_to_remove) {
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      components_to_remove.add(comp_node);
+    }
+  }
+  const auto is_removed_operation = [&](const OperationNode *op_node) {
+    return components_to_remove.contains(op_node->owner);
+  };
+
+  /* Unlink all relations of the operations, including the ones from the other nodes. The
+   * relations themselves are owned by the build allocator and freed on the next full build. */
+  for (IDNode *id_node : id_nodes_to_remove) {
+    for (ComponentNode *comp_node : id_node->components.values()) {
+      Vector<OperationNode *> op_nodes;
+      if (comp_node->operations_map != nullptr) {
+        op_nodes.extend(comp_node->operations_map->values().begin(),
+                        comp_node->operations_map->values().end());
+      }
+      op_nodes.extend(comp_node->operations);
+      for (OperationNode *op_node : op_nodes) {
+        for (Relation *rel : Vector<Relation *>(op_node->inlinks)) {
+          rel->unlink();
+        }
+        for (Relation *rel : Vector<Relation *>(op_node->outlinks)) {
+          rel->unlink();
+        }
+        entry_tags.remove(op_node);
+      }
+    }
+  }
+  operations.remove_if(is_removed_operation);
+
+  const Set<const IDNode *> id_nodes_set(id_nodes_to_remove);
+  id_nodes.remove_if([&](const IDNode *id_node) { return id_nodes_set.contains(id_node); });
+  for (IDNode *id_node : id_nodes_to_remove) {
+    id_hash.remove(id_node->id_orig);
+    delete id_node;
+  }
+}
+
 Relation *Depsgraph::add_new_relation(Node *from, Node *to, const char *description, int flags)
 {
   Relation *rel = nullptr;
@@ -59,6 +59,12 @@ struct Depsgraph {
   IDNode *find_id_node(const ID *id) const;
   IDNode *add_id_node(ID *id, ID *id_cow_hint = nullptr);
   void clear_id_nodes();
+  /**
+   * Remove the given ID nodes with all their operations and relations from the graph, used to
+   * rebuild them without rebuilding the whole graph. The evaluated copies are freed unless their
+   * ownership was taken before.
+   */
+  void remove_id_nodes(Span<IDNode *> id_nodes_to_remove);
 
   /** Add new relationship between two nodes. */
   Relation *add_new_relation(Node *from, Node *to, const char *description, int flags = 0);
@@ -104,6 +110,9 @@ struct Depsgraph {
 
   /* Indicates whether relations needs to be updated. */
   bool need_update_relations;
+  /* When only relations of some IDs need to be updated, the session UIDs of these IDs. Empty when
+   * relations of the whole graph are to be updated. See #DEG_id_tag_relations_update. */
+  Set<uint> relations_update_id_session_uids;
 
   /* Indicates whether indirect effect of nodes on a directly visible ones needs to be updated. */
   bool need_update_nodes_visibility;
@@ -163,6 +172,10 @@ struct Depsgraph {
   /* Optimize out evaluation of operations which affect hidden objects or disabled modifiers. */
   bool use_visibility_optimization;
 
+  /* Objects hidden in the viewport are only evaluated when something visible depends on them.
+   * Controlled by the scene's viewport simplify settings, updated when flushing updates. */
+  bool use_hidden_objects_lazy_evaluation;
+
   DepsgraphDebug debug;
 
   bool is_evaluating;
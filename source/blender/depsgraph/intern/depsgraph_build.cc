@@ -284,6 +284,7 @@ void DEG_graph_tag_relations_update(Depsgraph *graph)
   DEG_DEBUG_PRINTF(graph, TAG, "%s: Tagging relations for update.\n", __func__);
   deg::Depsgraph *deg_graph = reinterpret_cast<deg::Depsgraph *>(graph);
   deg_graph->need_update_relations = true;
+  deg_graph->relations_update_id_session_uids.clear();
 
   /* NOTE: When relations are updated, it's quite possible that we've got new bases in the scene.
    * This means, we need to re-create flat array of bases in view layer. */
@@ -307,9 +308,31 @@ void DEG_graph_relations_update(Depsgraph *graph)
     /* Graph is up to date, nothing to do. */
     return;
   }
+  if (!deg_graph->relations_update_id_session_uids.is_empty()) {
+    deg::ViewLayerBuilderPipeline builder(graph);
+    if (builder.build_incremental()) {
+      return;
+    }
+  }
   DEG_graph_build_from_view_layer(graph);
 }
 
+void DEG_id_tag_relations_update(Main *bmain, ID *id)
+{
+  DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations of %s for update.\n", __func__, id->name);
+  for (deg::Depsgraph *depsgraph : deg::get_all_registered_graphs(bmain)) {
+    const bool is_full_update_tagged = depsgraph->need_update_relations &&
+                                       depsgraph->relations_update_id_session_uids.is_empty();
+    if (is_full_update_tagged || depsgraph->find_id_node(id) == nullptr) {
+      /* The ID is new to the graph, or the whole graph is to be rebuilt already. */
+      DEG_graph_tag_relations_update(reinterpret_cast<Depsgraph *>(depsgraph));
+      continue;
+    }
+    depsgraph->relations_update_id_session_uids.add(id->session_uid);
+    depsgraph->need_update_relations = true;
+  }
+}
+
 void DEG_relations_tag_update(Main *bmain)
 {
   DEG_GLOBAL_DEBUG_PRINTF(TAG, "%s: Tagging relations for update.\n", __func__);
@@ -8,6 +8,7 @@
  * Evaluation engine entry-points for Depsgraph Engine.
  */
 
+#include <algorithm>
 #include <atomic>
 #include <cstdint>
 
@@ -17,6 +18,7 @@
 #include "BLI_gsqueue.h"
 #include "BLI_task.h"
 #include "BLI_time.h"
+#include "BLI_vector.hh"
 
 #include "BKE_global.hh"
 
@@ -32,6 +34,7 @@
 
 #include "atomic_ops.h"
 
+#include "intern/debug/deg_debug_trace.h"
 #include "intern/depsgraph.hh"
 #include "intern/depsgraph_relation.hh"
 #include "intern/depsgraph_tag.hh"
@@ -76,9 +79,28 @@ enum class EvaluationStage {
   SINGLE_THREADED_WORKAROUND,
 };
 
+const char *evaluation_stage_name(const EvaluationStage stage)
+{
+  switch (stage) {
+    case EvaluationStage::COPY_ON_EVAL:
+      return "Copy-on-Evaluation";
+    case EvaluationStage::DYNAMIC_VISIBILITY:
+      return "Dynamic Visibility";
+    case EvaluationStage::THREADED_EVALUATION:
+      return "Threaded Evaluation";
+    case EvaluationStage::SINGLE_THREADED_WORKAROUND:
+      return "Single Threaded Evaluation";
+  }
+  return "";
+}
+
 struct DepsgraphEvalState {
   Depsgraph *graph;
   bool do_stats;
+  /* Measure the time of every operation, to estimate the critical path of the next evaluation. */
+  bool do_time_operations;
+  /* Recording of the evaluation, see #DEG_debug_trace_begin. */
+  DepsgraphTrace *trace;
   EvaluationStage stage;
   bool need_update_pending_parents = true;
   bool need_single_thread_pass = false;
@@ -91,10 +113,14 @@ void evaluate_node(const DepsgraphEvalState *state, OperationNode *operation_nod
   /* Sanity checks. */
   BLI_assert_msg(!operation_node->is_noop(), "NOOP nodes should not actually be scheduled");
   /* Perform operation. */
-  if (state->do_stats) {
+  if (state->do_time_operations) {
     const double start_time = BLI_time_now_seconds();
     operation_node->evaluate(depsgraph);
-    operation_node->stats.current_time += BLI_time_now_seconds() - start_time;
+    const double end_time = BLI_time_now_seconds();
+    operation_node->stats.current_time += end_time - start_time;
+    if (state->trace) {
+      state->trace->add_operation(*operation_node, start_time, end_time);
+    }
   }
   else {
     operation_node->evaluate(depsgraph);
@@ -112,14 +138,26 @@ void deg_task_run_func(TaskPool *pool, void *taskdata)
   void *userdata_v = BLI_task_pool_user_data(pool);
   DepsgraphEvalState *state = (DepsgraphEvalState *)userdata_v;
 
-  /* Evaluate node. */
   OperationNode *operation_node = reinterpret_cast<OperationNode *>(taskdata);
-  evaluate_node(state, operation_node);
+  while (operation_node != nullptr) {
+    /* Evaluate node. */
+    evaluate_node(state, operation_node);
 
-  /* Schedule children. */
-  schedule_children(state, operation_node, [&](OperationNode *node) {
-    BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
-  });
+    /* Schedule children. The one with the longest critical path is evaluated right away in this
+     * task, instead of waiting for a thread to pick it up while less important work is done. */
+    OperationNode *next_node = nullptr;
+    schedule_children(state, operation_node, [&](OperationNode *node) {
+      if (next_node == nullptr) {
+        next_node = node;
+        return;
+      }
+      if (node->critical_path_time > next_node->critical_path_time) {
+        std::swap(node, next_node);
+      }
+      BLI_task_pool_push(pool, deg_task_run_func, node, false, nullptr);
+    });
+    operation_node = next_node;
+  }
 }
 
 bool check_operation_node_visible(const DepsgraphEvalState *state, OperationNode *op_node)
@@ -188,7 +226,7 @@ void calculate_pending_parents_if_needed(DepsgraphEvalState *state)
 void initialize_execution(DepsgraphEvalState *state, Depsgraph *graph)
 {
   /* Clear tags and other things which needs to be clear. */
-  if (state->do_stats) {
+  if (state->do_time_operations) {
     for (OperationNode *node : graph->operations) {
       node->stats.reset_current();
     }
@@ -313,13 +351,28 @@ void evaluate_graph_threaded_stage(DepsgraphEvalState *state,
                                    const EvaluationStage stage)
 {
   state->stage = stage;
+  if (state->trace) {
+    state->trace->begin_stage(evaluation_stage_name(stage));
+  }
 
   calculate_pending_parents_if_needed(state);
 
-  schedule_graph(state, [&](OperationNode *node) {
+  /* Push the operations with the longest critical path first, so they are picked up first. */
+  Vector<OperationNode *> nodes_to_schedule;
+  schedule_graph(state, [&](OperationNode *node) { nodes_to_schedule.append(node); });
+  std::stable_sort(nodes_to_schedule.begin(),
+                   nodes_to_schedule.end(),
+                   [](const OperationNode *a, const OperationNode *b) {
+                     return a->critical_path_time > b->critical_path_time;
+                   });
+  for (OperationNode *node : nodes_to_schedule) {
     BLI_task_pool_push(task_pool, deg_task_run_func, node, false, nullptr);
-  });
+  }
   BLI_task_pool_work_and_wait(task_pool);
+
+  if (state->trace) {
+    state->trace->end_stage();
+  }
 }
 
 /* Evaluate remaining operations of the dependency graph in a single threaded manner. */
@@ -332,6 +385,9 @@ void evaluate_graph_single_threaded_if_needed(DepsgraphEvalState *state)
   BLI_assert(!state->need_update_pending_parents);
 
   state->stage = EvaluationStage::SINGLE_THREADED_WORKAROUND;
+  if (state->trace) {
+    state->trace->begin_stage(evaluation_stage_name(state->stage));
+  }
 
   GSQueue *evaluation_queue = BLI_gsqueue_new(sizeof(OperationNode *));
   auto schedule_node_to_queue = [&](OperationNode *node) {
@@ -348,6 +404,10 @@ void evaluate_graph_single_threaded_if_needed(DepsgraphEvalState *state)
   }
 
   BLI_gsqueue_free(evaluation_queue);
+
+  if (state->trace) {
+    state->trace->end_stage();
+  }
 }
 
 void depsgraph_ensure_view_layer(Depsgraph *graph)
@@ -410,6 +470,14 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   DepsgraphEvalState state;
   state.graph = graph;
   state.do_stats = graph->debug.do_time_debug();
+  /* Timing is cheap compared to the typical operation, and only needed to order the operations
+   * when they can be evaluated on multiple threads. */
+  state.trace = graph->debug.trace.get();
+  state.do_time_operations = state.do_stats || state.trace ||
+                             !(G.debug & G_DEBUG_DEPSGRAPH_NO_THREADS);
+  if (state.trace) {
+    state.trace->begin_evaluation();
+  }
 
   /* Prepare all nodes for evaluation. */
   initialize_execution(&state, graph);
@@ -464,6 +532,12 @@ void deg_evaluate_on_refresh(Depsgraph *graph)
   if (state.do_stats) {
     deg_eval_stats_aggregate(graph);
   }
+  if (state.do_time_operations) {
+    deg_eval_stats_update_critical_path(graph);
+  }
+  if (state.trace) {
+    state.trace->end_evaluation();
+  }
 
   /* Clear any uncleared tags. */
   deg_graph_clear_tags(graph);
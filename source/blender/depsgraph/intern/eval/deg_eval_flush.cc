@@ -38,6 +38,7 @@
 #include "intern/node/deg_node_time.hh"
 
 #include "intern/eval/deg_eval_copy_on_write.h"
+#include "intern/eval/deg_eval_visibility.h"
 
 /* Invalidate data-block data when update is flushed on it.
  *
@@ -310,6 +311,8 @@ void deg_graph_flush_updates(Depsgraph *graph)
 
   graph->time_source->flush_update_tag(graph);
 
+  deg_graph_update_hidden_objects_lazy_evaluation(graph);
+
   /* Nothing to update, early out. */
   if (graph->entry_tags.is_empty()) {
     return;
@@ -337,6 +340,11 @@ void deg_graph_flush_updates(Depsgraph *graph)
       IDNode *id_node = comp_node->owner;
       flush_handle_id_node(id_node);
       flush_handle_component_node(id_node, comp_node, &queue);
+      /* Changes to the base flags can hide or reveal objects, which needs the dynamic visibility
+       * pass to run before the rest of the evaluation. */
+      if (graph->use_hidden_objects_lazy_evaluation && comp_node->type == NodeType::VISIBILITY) {
+        graph->need_update_nodes_visibility = true;
+      }
       /* Flush to nodes along links. */
       op_node = flush_schedule_children(op_node, &queue);
     }
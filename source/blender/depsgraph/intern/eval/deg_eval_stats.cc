@@ -8,7 +8,12 @@
 
 #include "intern/eval/deg_eval_stats.h"
 
+#include <algorithm>
+
+#include "BLI_vector.hh"
+
 #include "intern/depsgraph.hh"
+#include "intern/depsgraph_relation.hh"
 
 #include "intern/node/deg_node.hh"
 #include "intern/node/deg_node_component.hh"
@@ -37,4 +42,55 @@ void deg_eval_stats_aggregate(Depsgraph *graph)
   }
 }
 
+/* Weight of the last evaluation in the estimated operation time, so that estimates follow changes
+ * of the evaluated data while not being too sensitive to noise. */
+#define ESTIMATED_TIME_FACTOR 0.25f
+
+static bool relation_affects_critical_path(const Relation *rel)
+{
+  return rel->from->type == NodeType::OPERATION && rel->to->type == NodeType::OPERATION &&
+         (rel->flag & RELATION_FLAG_CYCLIC) == 0;
+}
+
+void deg_eval_stats_update_critical_path(Depsgraph *graph)
+{
+  /* Operations which were not evaluated keep their previous estimate. */
+  for (OperationNode *op_node : graph->operations) {
+    const float time = float(op_node->stats.current_time);
+    if (time > 0.0f) {
+      op_node->estimated_time = (op_node->estimated_time == 0.0f) ?
+                                    time :
+                                    op_node->estimated_time +
+                                        (time - op_node->estimated_time) * ESTIMATED_TIME_FACTOR;
+    }
+  }
+
+  /* Visit operations from the leaves of the graph up to its roots, so that the critical path time
+   * of all children is known when visiting an operation. The number of children which are not
+   * visited yet are stored in the custom flags. */
+  Vector<OperationNode *> stack;
+  for (OperationNode *op_node : graph->operations) {
+    op_node->critical_path_time = op_node->estimated_time;
+    op_node->custom_flags = int(std::count_if(
+        op_node->outlinks.begin(), op_node->outlinks.end(), relation_affects_critical_path));
+    if (op_node->custom_flags == 0) {
+      stack.append(op_node);
+    }
+  }
+  while (!stack.is_empty()) {
+    const OperationNode *op_node = stack.pop_last();
+    for (Relation *rel : op_node->inlinks) {
+      if (!relation_affects_critical_path(rel)) {
+        continue;
+      }
+      OperationNode *parent = static_cast<OperationNode *>(rel->from);
+      parent->critical_path_time = std::max(
+          parent->critical_path_time, parent->estimated_time + op_node->critical_path_time);
+      if (--parent->custom_flags == 0) {
+        stack.append(parent);
+      }
+    }
+  }
+}
+
 }  // namespace blender::deg
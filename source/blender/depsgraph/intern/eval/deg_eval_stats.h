@@ -15,4 +15,9 @@ struct Depsgraph;
 /* Aggregate operation timings to overall component and ID nodes timing. */
 void deg_eval_stats_aggregate(Depsgraph *graph);
 
+/* Update the estimated time of the operations evaluated during the last evaluation, and the
+ * critical path time of all operations, which is used to prioritize operations during the next
+ * evaluation. */
+void deg_eval_stats_update_critical_path(Depsgraph *graph);
+
 }  // namespace blender::deg
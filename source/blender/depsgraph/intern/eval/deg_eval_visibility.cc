@@ -11,6 +11,7 @@
 #include "DNA_layer_types.h"
 #include "DNA_modifier_types.h"
 #include "DNA_object_types.h"
+#include "DNA_scene_types.h"
 
 #include "BLI_assert.h"
 #include "BLI_listbase.h"
@@ -36,8 +37,14 @@ void deg_evaluate_object_node_visibility(::Depsgraph *depsgraph, IDNode *id_node
 
   DEG_debug_print_eval(depsgraph, __func__, object->id.name, &object->id);
 
-  const int required_flags = (graph->mode == DAG_EVAL_VIEWPORT) ? BASE_ENABLED_VIEWPORT :
-                                                                  BASE_ENABLED_RENDER;
+  int required_flags = (graph->mode == DAG_EVAL_VIEWPORT) ? BASE_ENABLED_VIEWPORT :
+                                                            BASE_ENABLED_RENDER;
+
+  /* Objects which are hidden in the view layer are not drawn, so only evaluate them when they are
+   * needed by another visible object. The visibility flush takes care of that. */
+  if (graph->use_hidden_objects_lazy_evaluation) {
+    required_flags = BASE_ENABLED_AND_MAYBE_VISIBLE_IN_VIEWPORT;
+  }
 
   const bool is_enabled = !graph->use_visibility_optimization ||
                           object->base_flag & required_flags;
@@ -231,4 +238,31 @@ void deg_graph_flush_visibility_flags_if_needed(Depsgraph *graph)
   deg_graph_flush_visibility_flags(graph);
 }
 
+void deg_graph_update_hidden_objects_lazy_evaluation(Depsgraph *graph)
+{
+  const Scene *scene = graph->scene;
+  const bool use_lazy_evaluation = graph->mode == DAG_EVAL_VIEWPORT &&
+                                   graph->use_visibility_optimization &&
+                                   (scene->r.mode & R_SIMPLIFY) &&
+                                   (scene->r.mode & R_SIMPLIFY_HIDDEN_OBJECTS);
+  if (graph->use_hidden_objects_lazy_evaluation == use_lazy_evaluation) {
+    return;
+  }
+  graph->use_hidden_objects_lazy_evaluation = use_lazy_evaluation;
+
+  /* Re-evaluate visibility of all objects. Operations of objects which become visible are still
+   * tagged for update from when they were skipped, so they will be evaluated as well. */
+  for (IDNode *id_node : graph->id_nodes) {
+    if (GS(id_node->id_orig->name) != ID_OB) {
+      continue;
+    }
+    ComponentNode *visibility_component = id_node->find_component(NodeType::VISIBILITY);
+    if (visibility_component == nullptr) {
+      continue;
+    }
+    visibility_component->get_entry_operation()->tag_update(graph,
+                                                            DEG_UPDATE_SOURCE_VISIBILITY);
+  }
+}
+
 }  // namespace blender::deg
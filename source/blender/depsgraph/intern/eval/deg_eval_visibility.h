@@ -27,4 +27,8 @@ void deg_evaluate_object_modifiers_mode_node_visibility(::Depsgraph *depsgraph,
 void deg_graph_flush_visibility_flags(Depsgraph *graph);
 void deg_graph_flush_visibility_flags_if_needed(Depsgraph *graph);
 
+/* Synchronize the lazy evaluation of hidden objects with the scene settings, tagging visibility
+ * of all objects for re-evaluation when it changes. */
+void deg_graph_update_hidden_objects_lazy_evaluation(Depsgraph *graph);
+
 }  // namespace blender::deg
@@ -131,6 +131,17 @@ OperationNode *ComponentNode::add_operation(const DepsEvalOperationCb &op,
 {
   OperationNode *op_node = find_operation(opcode, name, name_tag);
   if (!op_node) {
+    if (operations_map == nullptr) {
+      /* The build of this component was already finalized, which happens when the graph is
+       * updated incrementally. Go back to the build state, it is finalized again afterwards. */
+      operations_map = new Map<ComponentNode::OperationIDKey, OperationNode *>();
+      for (OperationNode *op_node_built : operations) {
+        operations_map->add_new(
+            OperationIDKey(op_node_built->opcode, op_node_built->name, op_node_built->name_tag),
+            op_node_built);
+      }
+      operations.clear();
+    }
     DepsNodeFactory *factory = type_get_factory(NodeType::OPERATION);
     op_node = (OperationNode *)factory->create_node(this->owner->id_orig, "", name);
 
@@ -245,6 +256,10 @@ OperationNode *ComponentNode::get_exit_operation()
 
 void ComponentNode::finalize_build(Depsgraph * /*graph*/)
 {
+  if (operations_map == nullptr) {
+    /* Already finalized, the component was kept as-is by an incremental update of the graph. */
+    return;
+  }
   operations.reserve(operations_map->size());
   for (OperationNode *op_node : operations_map->values()) {
     operations.append(op_node);
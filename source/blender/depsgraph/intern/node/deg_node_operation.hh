@@ -294,6 +294,13 @@ struct OperationNode : public Node {
   /* (OperationFlag) extra settings affecting evaluation. */
   int flag;
 
+  /* Evaluation time of this operation, averaged over the previous evaluations. */
+  float estimated_time = 0.0f;
+  /* Estimated time needed to evaluate this operation and the longest chain of operations which
+   * depends on it. Operations with the highest value are evaluated first, see
+   * #deg_eval_stats_update_critical_path. */
+  float critical_path_time = 0.0f;
+
   DEG_DEPSNODE_DECLARE;
 };
 
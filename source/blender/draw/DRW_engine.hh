@@ -128,6 +128,12 @@ void DRW_render_gpencil(RenderEngine *engine, Depsgraph *depsgraph);
 void DRW_render_context_enable(Render *render);
 void DRW_render_context_disable(Render *render);
 
+/**
+ * Free the draw data kept between the frames of an animation render.
+ * IMPORTANT: This must be called with an active GPUContext.
+ */
+void DRW_render_data_free(RenderEngine *engine);
+
 /* Critical section for GPUShader usage. Can be removed when we have threadsafe GPUShader class. */
 void DRW_submission_start();
 void DRW_submission_end();
@@ -77,6 +77,21 @@ class DrawCache : public bke::pbvh::DrawCache {
    * index, as ensured by the BVH building process).
    */
   virtual Span<int> ensure_material_indices(const Object &object) = 0;
+
+  /**
+   * Free the GPU data of the nodes that were drawn least recently when the data of all nodes uses
+   * more than \a memory_limit bytes. This keeps only the nodes around the view resident for meshes
+   * whose GPU data doesn't fit in memory. Freed nodes are rebuilt when they are drawn again.
+   */
+  virtual void free_unused_nodes(const Object &object,
+                                 const IndexMask &drawn_nodes,
+                                 int64_t memory_limit) = 0;
+
+  /**
+   * True when nodes were freed by #free_unused_nodes, meaning only the nodes in view should be
+   * built to stay within the memory limit.
+   */
+  virtual bool exceeds_memory_limit() const = 0;
 };
 
 DrawCache &ensure_draw_data(std::unique_ptr<bke::pbvh::DrawCache> &ptr);
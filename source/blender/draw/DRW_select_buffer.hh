@@ -15,6 +15,7 @@
 #include "BLI_array.hh"
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_struct_equality_utils.hh"
 #include "BLI_sys_types.h" /* for bool and uint */
 
 struct ARegion;
@@ -51,11 +52,30 @@ struct SELECTID_Context {
 
   short select_mode;
 
+  /** Viewport settings that change the content of the selection frame-buffer. */
+  struct ViewSettings {
+    blender::int2 size;
+    bool use_xray;
+    bool use_xray_flag;
+    bool show_face_dots;
+    float retopology_offset;
+
+    static ViewSettings from_view(const ARegion &region, const View3D &v3d);
+
+    BLI_STRUCT_EQUALITY_OPERATORS_5(
+        ViewSettings, size, use_xray, use_xray_flag, show_face_dots, retopology_offset)
+  };
+
   /** To check for updates. */
   blender::float4x4 persmat;
+  ViewSettings view_settings;
   uint64_t depsgraph_last_update = 0;
 
-  bool is_dirty(Depsgraph *depsgraph, RegionView3D *rv3d);
+  /**
+   * The frame-buffer is kept between selection operations and only redrawn when the view or the
+   * selectable objects changed.
+   */
+  bool is_dirty(Depsgraph *depsgraph, const ARegion *region, const View3D *v3d);
 };
 
 /* `draw_select_buffer.cc` */
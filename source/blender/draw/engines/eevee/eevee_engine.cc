@@ -45,9 +45,15 @@ static void eevee_render(RenderEngine *engine, Depsgraph *depsgraph)
     const char *viewname = RE_GetActiveRenderView(engine->re);
     int size[2] = {engine->resolution_x, engine->resolution_y};
 
-    /* WORKAROUND: Fails if created in the parent scope. Must be because of lack of active
+    /* The instance is owned by the draw data, which is kept between the frames of an animation
+     * render. Reusing it keeps the shadow pages and light probes of what didn't change.
+     * WORKAROUND: Fails if created in the parent scope. Must be because of lack of active
      * `DRWContext`. To be revisited. */
-    instance = new Instance();
+    DrawEngine::Pointer &engine_ptr = DRW_context_get()->view_data_active->eevee;
+    if (engine_ptr.instance == nullptr) {
+      engine_ptr.instance = engine_ptr.create_instance();
+    }
+    instance = static_cast<Instance *>(engine_ptr.instance);
 
     rctf view_rect;
     rcti rect;
@@ -63,8 +69,6 @@ static void eevee_render(RenderEngine *engine, Depsgraph *depsgraph)
   };
 
   DRW_render_to_image(engine, depsgraph, eevee_render_to_image, eevee_store_metadata);
-
-  delete instance;
 }
 
 static void eevee_render_update_passes(RenderEngine *engine, Scene *scene, ViewLayer *view_layer)
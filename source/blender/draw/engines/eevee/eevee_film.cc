@@ -17,7 +17,6 @@
 #include "BLI_set.hh"
 
 #include "BKE_compositor.hh"
-#include "BKE_scene.hh"
 
 #include "GPU_framebuffer.hh"
 #include "GPU_texture.hh"
@@ -329,7 +328,7 @@ void Film::init(const int2 &extent, const rcti *output_rect)
   {
     data_.scaling_factor = 1;
     if (inst_.is_viewport()) {
-      data_.scaling_factor = BKE_render_preview_pixel_size(&inst_.scene->r);
+      data_.scaling_factor = inst_.viewport_pixel_size;
     }
     /* Sharpen the LODs (1.5x) to avoid TAA filtering causing over-blur (see #122941). */
     data_.texture_lod_bias = 1.0f / (data_.scaling_factor * 1.5f);
@@ -499,13 +498,19 @@ void Film::init(const int2 &extent, const rcti *output_rect)
     eGPUTextureFormat depth_format = GPU_R32F;
     eGPUTextureFormat cryptomatte_format = GPU_RGBA32F;
 
-    int reset = 0;
+    /* The instance can be reused for the next frame of an animation render, which must not
+     * accumulate on top of the previous one. */
+    int reset = inst_.is_viewport() ? 0 : 1;
     reset += depth_tx_.ensure_2d(depth_format, data_.extent);
     reset += combined_tx_.current().ensure_2d(color_format, data_.extent);
     reset += combined_tx_.next().ensure_2d(color_format, data_.extent);
     /* Two layers, one for nearest sample weight and one for weight accumulation. */
     reset += weight_tx_.current().ensure_2d_array(weight_format, weight_extent, 2);
     reset += weight_tx_.next().ensure_2d_array(weight_format, weight_extent, 2);
+    /* Only needed for re-projection, which is never used for final renders. */
+    int2 history_depth_extent = inst_.is_viewport() ? data_.extent : int2(1);
+    reset += history_depth_tx_.current().ensure_2d(depth_format, history_depth_extent);
+    reset += history_depth_tx_.next().ensure_2d(depth_format, history_depth_extent);
     reset += color_accum_tx_.ensure_2d_array(color_format,
                                              (data_.color_len > 0) ? data_.extent : int2(1),
                                              (data_.color_len > 0) ? data_.color_len : 1);
@@ -529,6 +534,7 @@ void Film::init(const int2 &extent, const rcti *output_rect)
       value_accum_tx_.clear(float4(0.0f));
       combined_tx_.current().clear(float4(0.0f));
       weight_tx_.current().clear(float4(0.0f));
+      history_depth_tx_.current().clear(float4(0.0f));
       depth_tx_.clear(float4(0.0f));
       cryptomatte_tx_.clear(float4(0.0f));
     }
@@ -621,6 +627,8 @@ void Film::init_pass(PassSimple &pass, GPUShader *sh)
   pass.bind_image("out_weight_img", &weight_tx_.next());
   pass.bind_texture("in_combined_tx", &combined_tx_.current(), filter);
   pass.bind_image("out_combined_img", &combined_tx_.next());
+  pass.bind_texture("in_history_depth_tx", &history_depth_tx_.current());
+  pass.bind_image("out_history_depth_img", &history_depth_tx_.next());
   pass.bind_image("depth_img", &depth_tx_);
   pass.bind_image("color_accum_img", &color_accum_tx_);
   pass.bind_image("value_accum_img", &value_accum_tx_);
@@ -871,6 +879,7 @@ void Film::accumulate(View &view, GPUTexture *combined_final_tx)
 
   combined_tx_.swap();
   weight_tx_.swap();
+  history_depth_tx_.swap();
 
   /* Use history after first sample. */
   if (data_.use_history == 0) {
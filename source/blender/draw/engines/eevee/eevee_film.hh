@@ -90,6 +90,8 @@ class Film {
   SwapChain<Texture, 2> combined_tx_;
   /** Weight buffers. Double buffered to allow updating it during accumulation. */
   SwapChain<Texture, 2> weight_tx_;
+  /** Scene linear depth of the combined pass. Double buffered to allow re-projection. */
+  SwapChain<Texture, 2> history_depth_tx_;
 
   PassSimple accumulate_ps_ = {"Film.Accumulate"};
   PassSimple copy_ps_ = {"Film.Copy"};
@@ -8,8 +8,11 @@
  * An instance contains all structures needed to do a complete render.
  */
 
+#include <algorithm>
+
 #include "BKE_global.hh"
 #include "BKE_object.hh"
+#include "BKE_scene.hh"
 
 #include "BLI_rect.h"
 #include "BLI_time.h"
@@ -122,6 +125,50 @@ void Instance::init()
   init(size, &rect, &visible_rect, nullptr, depsgraph, camera, nullptr, &default_view, v3d, rv3d);
 }
 
+int Instance::viewport_pixel_size_update()
+{
+  const int pixel_size = BKE_render_preview_pixel_size(&scene->r);
+
+  const double time = BLI_time_now_seconds();
+  const double frame_time = time - last_redraw_time_;
+  last_redraw_time_ = time;
+
+  if (!(scene->eevee.flag & SCE_EEVEE_ADAPTIVE_RESOLUTION) || !is_navigating || is_image_render)
+  {
+    /* Back to full quality once the navigation ends. */
+    adaptive_pixel_size_ = 1;
+    navigation_frames_num_ = 0;
+    return pixel_size;
+  }
+
+  /* The first redraw of the navigation can follow an arbitrarily long idle time. */
+  const int frame_times_len = navigation_frame_times_.size();
+  if (navigation_frames_num_++ > 0) {
+    navigation_frame_times_[navigation_frames_num_ % frame_times_len] = frame_time;
+  }
+  if (navigation_frames_num_ > frame_times_len) {
+    /* Redraws only happen when the view changes, pauses in the motion give long frame times.
+     * Use the shortest of the last frame times, the drawing cost is part of all of them. */
+    const double frame_time_min = *std::min_element(navigation_frame_times_.begin(),
+                                                    navigation_frame_times_.end());
+    const double target_frame_time = 1.0 / FPS;
+    constexpr int max_pixel_size = 8;
+    if (frame_time_min > target_frame_time * 1.25 &&
+        pixel_size * adaptive_pixel_size_ < max_pixel_size)
+    {
+      adaptive_pixel_size_ *= 2;
+      /* Measure again at the new resolution. */
+      navigation_frames_num_ = 1;
+    }
+    else if (frame_time_min < target_frame_time * 0.3 && adaptive_pixel_size_ > 1) {
+      /* Each step down draws four times more pixels, leave enough margin to not oscillate. */
+      adaptive_pixel_size_ /= 2;
+      navigation_frames_num_ = 1;
+    }
+  }
+  return pixel_size * adaptive_pixel_size_;
+}
+
 void Instance::init(const int2 &output_res,
                     const rcti *output_rect,
                     const rcti *visible_rect,
@@ -157,6 +204,10 @@ void Instance::init(const int2 &output_res,
     is_transforming = draw_ctx->is_transforming();
     draw_overlays = v3d && (v3d->flag2 & V3D_HIDE_OVERLAYS) == 0;
 
+    if (assign_if_different(viewport_pixel_size, viewport_pixel_size_update())) {
+      sampling.reset();
+    }
+
     /* Note: Do not update the value here as we use it during sync for checking ID updates. */
     if (depsgraph_last_update_ != DEG_get_update_count(depsgraph)) {
       sampling.reset();
@@ -364,6 +415,10 @@ void Instance::object_sync(ObjectRef &ob_ref, Manager & /*manager*/)
 
   ObjectHandle &ob_handle = sync.sync_object(ob_ref);
 
+  if (object_is_visible) {
+    light_probes.sync_object_update(ob, ob_handle);
+  }
+
   if (partsys_is_visible && ob != draw_ctx->object_edit) {
     auto sync_hair =
         [&](ObjectHandle hair_handle, ModifierData &md, ParticleSystem &particle_sys) {
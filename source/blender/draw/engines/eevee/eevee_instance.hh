@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <array>
+
 #include <fmt/format.h>
 
 #include "BLI_string.h"
@@ -83,6 +85,14 @@ class Instance : public DrawEngine {
 
   uint64_t depsgraph_last_update_ = 0;
   bool overlays_enabled_ = false;
+
+  /** Time between the last redraws while navigating, see #viewport_pixel_size_update(). */
+  std::array<double, 4> navigation_frame_times_ = {};
+  int navigation_frames_num_ = 0;
+  double last_redraw_time_ = 0.0;
+  /** Multiplier of the scene pixel size, increased while navigating in heavy scenes. */
+  int adaptive_pixel_size_ = 1;
+
   bool shaders_are_ready_ = true;
   bool skip_render_ = false;
 
@@ -154,6 +164,8 @@ class Instance : public DrawEngine {
   bool is_painting = false;
   /** True if current viewport is drawn during transforming operator. */
   bool is_transforming = false;
+  /** Resolution divider of the viewport, either the scene preview pixel size or larger. */
+  int viewport_pixel_size = 1;
   /** True if viewport compositor is enabled when drawing with this instance. */
   bool is_viewport_compositor_enabled = false;
   /** True if overlays need to be displayed (only for viewport). */
@@ -329,6 +341,12 @@ class Instance : public DrawEngine {
            ((v3d->shading.type == OB_MATERIAL) && (v3d->overlay.flag & V3D_OVERLAY_LOOK_DEV));
   }
 
+  /** True until the first sync is done. Every object is reported as updated during it. */
+  bool is_first_sync() const
+  {
+    return depsgraph_last_update_ == 0;
+  }
+
   int get_recalc_flags(const ObjectRef &ob_ref)
   {
     auto get_flags = [&](const ObjectRuntimeHandle &runtime) {
@@ -366,6 +384,8 @@ class Instance : public DrawEngine {
   void mesh_sync(Object *ob, ObjectHandle &ob_handle);
 
   void update_eval_members();
+  /** \return The viewport pixel size, adapted to the redraw rate if enabled. */
+  int viewport_pixel_size_update();
 
   void set_time(float time);
 
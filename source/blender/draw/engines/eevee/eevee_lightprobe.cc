@@ -10,11 +10,18 @@
  * and `PlanarProbeModule`.
  */
 
+#include "BLI_bounds.hh"
+
 #include "DNA_lightprobe_types.h"
 
+#include "BKE_object.hh"
+
+#include "DEG_depsgraph_query.hh"
+
 #include "eevee_instance.hh"
 #include "eevee_lightprobe.hh"
 
+#include <algorithm>
 #include <iostream>
 
 namespace blender::eevee {
@@ -68,12 +75,46 @@ void LightProbeModule::begin_sync()
 {
   auto_bake_enabled_ = inst_.is_viewport() &&
                        (inst_.scene->eevee.flag & SCE_EEVEE_GI_AUTOBAKE) != 0;
+  track_updates_ = inst_.is_viewport() && !inst_.is_first_sync();
+  update_all_volumes_ = false;
+  updated_bounds_.clear();
+}
+
+void LightProbeModule::sync_object_update(const Object *ob, const ObjectHandle &handle)
+{
+  if (!inst_.is_viewport() || ob->type == OB_LIGHTPROBE) {
+    return;
+  }
+  if (ob->type == OB_LAMP) {
+    /* Lights influence is not bounded. */
+    update_all_volumes_ |= track_updates_ && handle.recalc != 0;
+    return;
+  }
+  ObjectBounds *prev_bounds = object_bounds_.lookup_ptr(handle.object_key);
+  if (handle.recalc == 0 && prev_bounds != nullptr) {
+    prev_bounds->used = true;
+    return;
+  }
+  const std::optional<Bounds<float3>> bounds = BKE_object_boundbox_get(ob);
+  if (!bounds) {
+    return;
+  }
+  const Bounds<float3> world_bounds = bounds::transform_bounds(ob->object_to_world(), *bounds);
+  if (track_updates_) {
+    /* The lighting changes at both the previous and the new location of the object. */
+    if (prev_bounds != nullptr) {
+      updated_bounds_.append(prev_bounds->bounds);
+    }
+    updated_bounds_.append(world_bounds);
+  }
+  object_bounds_.add_overwrite(handle.object_key, {world_bounds, true});
 }
 
 void LightProbeModule::sync_volume(const Object *ob, ObjectHandle &handle)
 {
   VolumeProbe &grid = volume_map_.lookup_or_add_default(handle.object_key);
   grid.used = true;
+  grid.original_cache = DEG_get_original(ob)->lightprobe_cache;
   if (handle.recalc != 0 || grid.initialized == false) {
     const ::LightProbe &lightprobe = DRW_object_get_data_for_drawing<const ::LightProbe>(*ob);
 
@@ -216,11 +257,47 @@ void LightProbeModule::sync_world(const ::World *world, bool has_update)
 
   if (has_update) {
     world_sphere_.do_render = true;
+    update_all_volumes_ |= track_updates_;
+  }
+}
+
+void LightProbeModule::tag_dirty_volumes()
+{
+  /* Objects that were deleted or hidden. */
+  object_bounds_.remove_if([&](const Map<ObjectKey, ObjectBounds>::MutableItem &item) {
+    const bool remove_object = !item.value.used;
+    if (remove_object && track_updates_) {
+      updated_bounds_.append(item.value.bounds);
+    }
+    item.value.used = false;
+    return remove_object;
+  });
+
+  if (!update_all_volumes_ && updated_bounds_.is_empty()) {
+    return;
+  }
+  for (VolumeProbe &grid : volume_map_.values()) {
+    LightProbeObjectCache *cache = grid.original_cache;
+    if (!grid.used || cache == nullptr || cache->grid_static_cache == nullptr || cache->dirty) {
+      continue;
+    }
+    const Bounds<float3> grid_bounds = bounds::transform_bounds(
+        grid.object_to_world, Bounds<float3>(float3(-1.0f), float3(1.0f)));
+    auto intersects_grid = [&](const Bounds<float3> &bounds) {
+      return bounds::intersect(grid_bounds, bounds).has_value();
+    };
+    if (update_all_volumes_ ||
+        std::any_of(updated_bounds_.begin(), updated_bounds_.end(), intersects_grid))
+    {
+      cache->dirty = true;
+    }
   }
 }
 
 void LightProbeModule::end_sync()
 {
+  tag_dirty_volumes();
+
   /* Check for deleted or updated grid. */
   volume_update_ = false;
   volume_map_.remove_if([&](const Map<ObjectKey, VolumeProbe>::MutableItem &item) {
@@ -13,6 +13,7 @@
 #pragma once
 
 #include "BLI_bit_vector.hh"
+#include "BLI_bounds_types.hh"
 #include "BLI_map.hh"
 
 #include "DNA_world_types.h"
@@ -133,6 +134,8 @@ struct VolumeProbe : public LightProbe, VolumeProbeData {
    * pruning have been done.
    */
   const LightProbeObjectCache *cache = nullptr;
+  /** Cache of the original object, tagged as dirty when the scene changes around the grid. */
+  LightProbeObjectCache *original_cache = nullptr;
   /** List of associated atlas bricks that are used by this grid. */
   Vector<IrradianceBrickPacked> bricks;
   /** True if the grid needs to be re-uploaded & re-composited with other light-grids. */
@@ -222,6 +225,22 @@ class LightProbeModule {
   /** True if the auto bake feature is enabled & available in this context. */
   bool auto_bake_enabled_;
 
+  /**
+   * Bounds of the objects that can affect the baked lighting, used to find the volumes that
+   * needs to be baked again after an update. Only tracked in the viewport.
+   */
+  struct ObjectBounds {
+    Bounds<float3> bounds;
+    bool used;
+  };
+  Map<ObjectKey, ObjectBounds> object_bounds_;
+  /** World space bounds of the objects updated during this sync (old and new location). */
+  Vector<Bounds<float3>> updated_bounds_;
+  /** True if an update affects the lighting of all volumes (world or light update). */
+  bool update_all_volumes_ = false;
+  /** Updates are not tracked during the first sync, as every object is reported as updated. */
+  bool track_updates_ = false;
+
   eLightProbeResolution sphere_object_resolution_ = LIGHT_PROBE_RESOLUTION_128;
 
  public:
@@ -232,6 +251,8 @@ class LightProbeModule {
 
   void begin_sync();
   void sync_probe(const Object *ob, ObjectHandle &handle);
+  /** Track updates of any renderable object to tag the affected volumes as dirty. */
+  void sync_object_update(const Object *ob, const ObjectHandle &handle);
   void sync_world(const ::World *world, bool has_update);
   void end_sync();
 
@@ -240,6 +261,9 @@ class LightProbeModule {
   void sync_volume(const Object *ob, ObjectHandle &handle);
   void sync_planar(const Object *ob, ObjectHandle &handle);
 
+  /** Tag the baked volumes affected by the updates of this sync as dirty. */
+  void tag_dirty_volumes();
+
   /** Get the number of atlas layers needed to store light probe spheres. */
   int sphere_layer_count() const;
 
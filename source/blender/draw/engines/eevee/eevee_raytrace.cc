@@ -571,6 +571,12 @@ RayTraceResultTexture RayTraceModule::trace(
 
   data_.thickness = options.screen_trace_thickness;
   data_.quality = 1.0f - 0.95f * options.screen_trace_quality;
+  /* The screen trace steps are in pixels. Make them grow faster at high resolutions so that
+   * crossing the same portion of the screen takes about the same number of steps, keeping the
+   * tracing cost per pixel independent of the render size. The first steps stay one pixel long
+   * to keep the precision of contact reflections. */
+  constexpr float reference_resolution = 1920.0f;
+  data_.quality *= max_ff(1.0f, math::reduce_max(extent) / reference_resolution);
 
   float roughness_mask_start = options.trace_max_roughness;
   float roughness_mask_fade = 0.2f;
@@ -66,6 +66,18 @@ struct RayTraceBuffer {
    */
   float4x4 history_persmat;
 
+  /** Discard the data recorded by previous samples. */
+  void history_free()
+  {
+    for (DenoiseBuffer &denoise_buf : closures) {
+      denoise_buf.radiance_history_tx.free();
+      denoise_buf.variance_history_tx.free();
+      denoise_buf.tilemask_history_tx.free();
+      denoise_buf.valid_history = false;
+    }
+    radiance_feedback_tx.free();
+  }
+
   GPUTexture *feedback_ensure(bool is_dummy, int2 extent)
   {
     eGPUTextureUsage usage_rw = GPU_TEXTURE_USAGE_SHADER_READ | GPU_TEXTURE_USAGE_SHADER_WRITE;
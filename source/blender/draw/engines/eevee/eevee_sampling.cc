@@ -9,7 +9,6 @@
  */
 
 #include "BKE_colortools.hh"
-#include "BKE_scene.hh"
 
 #include "BLI_rand.h"
 
@@ -29,6 +28,12 @@ void Sampling::init(const Scene *scene)
 {
   sample_count_ = inst_.is_viewport() ? scene->eevee.taa_samples : scene->eevee.taa_render_samples;
 
+  if (!inst_.is_viewport()) {
+    /* The instance can be reused for the next frame of an animation render. */
+    sample_ = 0;
+    viewport_sample_ = 0;
+  }
+
   if (inst_.is_image_render) {
     sample_count_ = math::max(uint64_t(1), sample_count_);
   }
@@ -40,7 +45,7 @@ void Sampling::init(const Scene *scene)
 
   if (inst_.is_viewport()) {
     /* We can't rely on the film module as it is initialized later. */
-    int pixel_size = BKE_render_preview_pixel_size(&inst_.scene->r);
+    int pixel_size = inst_.viewport_pixel_size;
     if (pixel_size > 1) {
       /* Enforce to render at least all the film pixel once. */
       sample_count_ = max_ii(sample_count_, square_i(pixel_size));
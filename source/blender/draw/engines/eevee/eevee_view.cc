@@ -29,7 +29,16 @@ namespace blender::eevee {
 /** \name ShadingView
  * \{ */
 
-void ShadingView::init() {}
+void ShadingView::init()
+{
+  if (!inst_.is_viewport()) {
+    /* The instance can be reused for the next frame of an animation render. Don't re-project the
+     * history of the previous frame. */
+    rt_buffer_opaque_.history_free();
+    rt_buffer_refract_.history_free();
+    dof_buffer_.stabilize_history_tx_.free();
+  }
+}
 
 void ShadingView::sync()
 {
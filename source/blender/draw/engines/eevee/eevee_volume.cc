@@ -67,6 +67,10 @@ void VolumeModule::init()
   data_.light_clamp = (data_.light_clamp > 0.0) ? data_.light_clamp : 1e20;
 
   use_reprojection_ = (scene_eval->eevee.flag & SCE_EEVEE_TAA_REPROJECTION) != 0;
+  if (!inst_.is_viewport()) {
+    /* Don't re-project the previous frame of an animation render. */
+    valid_history_ = false;
+  }
 }
 
 void VolumeModule::begin_sync()
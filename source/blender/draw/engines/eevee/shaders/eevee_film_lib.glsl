@@ -467,6 +467,35 @@ float film_history_blend_factor(float velocity,
   return blend;
 }
 
+/**
+ * Detect surfaces that were hidden in the previous redraw by comparing their distance to the
+ * previous camera with the depth history around the reprojected position. Only static surfaces
+ * are tested, the previous position of moving ones is unknown here.
+ */
+bool film_history_is_disoccluded(int2 src_texel, float2 history_texel)
+{
+  float depth = reverse_z::read(texelFetch(depth_tx, src_texel, 0).x);
+  bool is_background = (depth == 1.0f);
+  bool is_static = (texelFetch(vector_tx, src_texel, 0).x == VELOCITY_INVALID);
+  if (is_background || !is_static) {
+    return false;
+  }
+  float2 uv = (float2(src_texel) + 0.5f) / float2(textureSize(depth_tx, 0).xy);
+  float3 P = drw_point_screen_to_world(float3(uv, depth));
+  float expected_distance = -transform_point(camera_prev.viewmat, P).z;
+  /* Use the farthest history depth of the bilinear footprint. Avoids rejecting the history of
+   * silhouettes that are only covered by some of the jittered samples. */
+  int2 texel = int2(floor(history_texel));
+  int2 texel_max = textureSize(in_history_depth_tx, 0).xy - 1;
+  float history_distance = 0.0f;
+  for (int i = 0; i < 4; i++) {
+    int2 sample_texel = clamp(texel + int2(i & 1, i >> 1), int2(0), texel_max);
+    history_distance = max(history_distance, texelFetch(in_history_depth_tx, sample_texel, 0).x);
+  }
+  /* Relative tolerance for depth imprecision. */
+  return expected_distance > history_distance * 1.05f;
+}
+
 /* Returns resolved final color. */
 void film_store_combined(
     FilmSample dst, int2 src_texel, float4 color, float color_weight, inout float4 display)
@@ -481,6 +510,12 @@ void film_store_combined(
   /* Undo the weighting to get final spatially-filtered color. */
   color_src = color / color_weight;
 
+  /* Store the depth for the disocclusion detection of the next redraw. */
+  if (all(lessThan(dst.texel, imageSize(out_history_depth_img)))) {
+    float depth = reverse_z::read(texelFetch(depth_tx, src_texel, 0).x);
+    imageStoreFast(out_history_depth_img, dst.texel, float4(film_depth_convert_to_scene(depth)));
+  }
+
   if (use_reprojection) {
     /* Interactive accumulation. Do reprojection and Temporal Anti-Aliasing. */
 
@@ -502,6 +537,10 @@ void film_store_combined(
 
     float blend = film_history_blend_factor(
         velocity, history_texel, min_color.x, max_color.x, color_src.x, color_dst.x);
+    /* Discard history of surfaces that were occluded. */
+    if (film_history_is_disoccluded(src_texel, history_texel)) {
+      blend = 1.0f;
+    }
 
     color_dst = film_amend_combined_history(min_color, max_color, color_dst, color_src, src_texel);
 
@@ -25,8 +25,11 @@ SAMPLER(4, sampler2DArray, rp_value_tx)
 /* Color History for TAA needs to be sampler to leverage bilinear sampling. */
 SAMPLER(5, sampler2D, in_combined_tx)
 SAMPLER(6, sampler2D, cryptomatte_tx)
+/* Scene linear depth of the previous redraw, used to detect disocclusion when reprojecting. */
+SAMPLER(7, sampler2D, in_history_depth_tx)
 IMAGE(0, GPU_R32F, read, image2DArray, in_weight_img)
 IMAGE(1, GPU_R32F, write, image2DArray, out_weight_img)
+IMAGE(2, GPU_R32F, write, image2D, out_history_depth_img)
 SPECIALIZATION_CONSTANT(uint, enabled_categories, 0)
 SPECIALIZATION_CONSTANT(int, samples_len, 0)
 SPECIALIZATION_CONSTANT(bool, use_reprojection, false)
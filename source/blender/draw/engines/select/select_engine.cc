@@ -197,6 +197,8 @@ struct Instance : public DrawEngine {
     e_data.context.elem_ranges.clear();
 
     e_data.context.persmat = float4x4(draw_ctx->rv3d->persmat);
+    e_data.context.view_settings = SELECTID_Context::ViewSettings::from_view(*draw_ctx->region,
+                                                                             *draw_ctx->v3d);
     e_data.context.max_index_drawn_len = 1;
     framebuffer_setup();
     GPU_framebuffer_bind(e_data.framebuffer_select_id);
@@ -2,9 +2,12 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_bounds.hh"
+#include "BLI_math_geom.h"
 #include "BLI_rect.h"
 
 #include "DNA_fluid_types.h"
+#include "DNA_mesh_types.h"
 
 #include "BKE_editmesh.hh"
 #include "BKE_material.hh"
@@ -29,6 +32,7 @@
 #include "RE_pipeline.h"
 
 #include "draw_cache.hh"
+#include "draw_cache_impl.hh"
 #include "draw_common.hh"
 #include "draw_sculpt.hh"
 #include "draw_view_data.hh"
@@ -275,9 +279,71 @@ class Instance : public DrawEngine {
     });
   }
 
+  /**
+   * Select the level of detail from the screen area covered by the object bounds, using the
+   * simplest level that still has about one triangle per pixel.
+   * \return Zero for the full resolution mesh.
+   */
+  int mesh_lod_level_get(const ObjectRef &ob_ref, const Mesh &mesh)
+  {
+    /* Below this, simplifying the mesh doesn't make drawing noticeably faster. */
+    constexpr int min_tris_num = 100000;
+    const int tris_num = poly_to_tri_count(mesh.faces_num, mesh.corners_num);
+    if (tris_num < min_tris_num) {
+      return 0;
+    }
+    const std::optional<Bounds<float3>> bounds = mesh.bounds_min_max();
+    if (!bounds) {
+      return 0;
+    }
+    const Bounds<float3> world_bounds = bounds::transform_bounds(
+        ob_ref.object->object_to_world(), *bounds);
+    const float radius = math::distance(world_bounds.min, world_bounds.max) * 0.5f;
+
+    const View &view = View::default_get();
+    float pixel_scale = view.winmat()[1][1] * 0.5f * this->draw_ctx->viewport_size_get().y;
+    if (view.is_persp()) {
+      const float3 center = math::midpoint(world_bounds.min, world_bounds.max);
+      const float distance = -math::transform_point(view.viewmat(), center).z;
+      if (distance <= radius) {
+        /* The view is inside or very close to the object. */
+        return 0;
+      }
+      pixel_scale /= distance;
+    }
+    const float area_px = float(M_PI) * math::square(radius * pixel_scale);
+
+    int level = 0;
+    float level_tris_num = tris_num * DRW_MESH_LOD_RATIO;
+    while (level < DRW_MESH_LOD_LEVELS && level_tris_num >= area_px) {
+      level_tris_num *= DRW_MESH_LOD_RATIO;
+      level++;
+    }
+    return level;
+  }
+
+  /**
+   * \return The simplified mesh to draw instead of the object data, or null to draw the object.
+   * Levels that are still being built fall back to the more detailed ones.
+   */
+  Mesh *mesh_lod_get(const ObjectRef &ob_ref, const ObjectState &object_state)
+  {
+    if (!object_state.use_lod) {
+      return nullptr;
+    }
+    Mesh &mesh = DRW_object_get_data_for_drawing<Mesh>(*ob_ref.object);
+    for (int level = this->mesh_lod_level_get(ob_ref, mesh); level > 0; level--) {
+      if (Mesh *lod_mesh = DRW_mesh_batch_cache_lod_get(mesh, level)) {
+        return lod_mesh;
+      }
+    }
+    return nullptr;
+  }
+
   void mesh_sync(ObjectRef &ob_ref, ResourceHandle handle, const ObjectState &object_state)
   {
     bool has_transparent_material = false;
+    Mesh *lod_mesh = this->mesh_lod_get(ob_ref, object_state);
 
     if (object_state.use_per_material_batches) {
       const int material_count = BKE_object_material_used_with_fallback_eval(*ob_ref.object);
@@ -286,6 +352,10 @@ class Instance : public DrawEngine {
       if (object_state.color_type == V3D_SHADING_TEXTURE_COLOR) {
         batches = DRW_cache_mesh_surface_texpaint_get(ob_ref.object);
       }
+      else if (lod_mesh) {
+        batches = DRW_mesh_batch_cache_get_surface_shaded(
+            *ob_ref.object, *lod_mesh, this->get_dummy_gpu_materials(material_count));
+      }
       else {
         batches = DRW_cache_object_surface_material_get(
             ob_ref.object, this->get_dummy_gpu_materials(material_count));
@@ -324,6 +394,9 @@ class Instance : public DrawEngine {
           batch = DRW_cache_mesh_surface_sculptcolors_get(ob_ref.object);
         }
       }
+      else if (lod_mesh) {
+        batch = DRW_mesh_batch_cache_get_surface(*lod_mesh);
+      }
       else {
         batch = DRW_cache_object_surface_get(ob_ref.object);
       }
@@ -184,6 +184,8 @@ struct ObjectState {
   bool draw_shadow = false;
   bool use_per_material_batches = false;
   bool sculpt_pbvh = false;
+  /* Draw a simplified mesh when the object is small on screen. */
+  bool use_lod = false;
 
   ObjectState(const DRWContext *draw_ctx,
               const SceneState &scene_state,
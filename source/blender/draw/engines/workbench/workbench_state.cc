@@ -361,6 +361,12 @@ ObjectState::ObjectState(const DRWContext *draw_ctx,
                              ELEM(color_type,
                                   V3D_SHADING_TEXTURE_COLOR,
                                   V3D_SHADING_MATERIAL_COLOR);
+
+  /* Decimation distorts UV maps and color attributes, and simplified meshes can't be edited. */
+  use_lod = ob->type == OB_MESH && (ob->dtx & OB_DRAW_NO_LOD) == 0 && ob->mode == OB_MODE_OBJECT &&
+            !sculpt_pbvh && !draw_ctx->is_image_render() &&
+            image_paint_override.gpu.texture == nullptr &&
+            !ELEM(color_type, V3D_SHADING_TEXTURE_COLOR, V3D_SHADING_VERTEX_COLOR);
 }
 
 }  // namespace blender::workbench
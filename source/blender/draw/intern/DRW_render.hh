@@ -357,11 +357,12 @@ struct DRWContext {
   void acquire_data();
 
   /**
-   * Make sure to release acquired DRWData. If created on the fly, make sure to destroy them.
+   * Make sure to release acquired DRWData. If created on the fly, make sure to destroy them,
+   * unless `keep_data` is true in which case the caller takes ownership.
    * IMPORTANT: This needs to be called with the same active GPUContext `acquire_data()` was called
    * with.
    */
-  void release_data();
+  void release_data(bool keep_data = false);
 
   /**
    * Enable engines from context. Not needed for Mode::RENDER and Mode::CUSTOM.
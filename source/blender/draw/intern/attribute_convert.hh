@@ -37,13 +37,17 @@ template<typename T> struct AttributeConverter {
 };
 
 template<> struct AttributeConverter<bool> {
-  using VBOType = VecBase<float, COMPONENT_LEN_SCALAR>;
-  static constexpr GPUVertCompType gpu_component_type = GPU_COMP_F32;
-  static constexpr int gpu_component_len = COMPONENT_LEN_SCALAR;
-  static constexpr GPUVertFetchMode gpu_fetch_mode = GPU_FETCH_FLOAT;
+  /* Booleans are exactly representable with normalized integers. Use the same type as byte colors
+   * so GPU subdivision can interpolate them too, the fourth component matches the implicit
+   * `float4(s, s, s, 1)` of scalars. */
+  using VBOType = ushort4;
+  static constexpr GPUVertCompType gpu_component_type = GPU_COMP_U16;
+  static constexpr int gpu_component_len = 4;
+  static constexpr GPUVertFetchMode gpu_fetch_mode = GPU_FETCH_INT_TO_FLOAT_UNIT;
   static VBOType convert(const bool &value)
   {
-    return VBOType(value);
+    const ushort s = value ? USHRT_MAX : 0;
+    return {s, s, s, USHRT_MAX};
   }
 };
 template<> struct AttributeConverter<int8_t> {
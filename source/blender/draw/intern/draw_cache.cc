@@ -20,7 +20,9 @@
 
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
+#include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.hh"
@@ -515,20 +517,28 @@ void drw_batch_cache_validate(Object *ob)
   }
 }
 
+static void drw_batch_cache_mode_flags_get(const DRWContext &draw_ctx,
+                                          const Object *ob,
+                                          bool &r_is_paint_mode,
+                                          bool &r_use_hide)
+{
+  const enum eContextObjectMode mode = CTX_data_mode_enum_ex(
+      draw_ctx.object_edit, draw_ctx.obact, draw_ctx.object_mode);
+  r_is_paint_mode = ELEM(
+      mode, CTX_MODE_SCULPT, CTX_MODE_PAINT_TEXTURE, CTX_MODE_PAINT_VERTEX, CTX_MODE_PAINT_WEIGHT);
+
+  r_use_hide = ((ob->type == OB_MESH) &&
+                ((r_is_paint_mode && (ob == draw_ctx.obact) && DRW_object_use_hide_faces(ob)) ||
+                 ((mode == CTX_MODE_EDIT_MESH) && (ob->mode == OB_MODE_EDIT))));
+}
+
 void drw_batch_cache_generate_requested(Object *ob, TaskGraph &task_graph)
 {
   using namespace blender::draw;
   const DRWContext *draw_ctx = DRW_context_get();
   const Scene *scene = draw_ctx->scene;
-  const enum eContextObjectMode mode = CTX_data_mode_enum_ex(
-      draw_ctx->object_edit, draw_ctx->obact, draw_ctx->object_mode);
-  const bool is_paint_mode = ELEM(
-      mode, CTX_MODE_SCULPT, CTX_MODE_PAINT_TEXTURE, CTX_MODE_PAINT_VERTEX, CTX_MODE_PAINT_WEIGHT);
-
-  const bool use_hide = ((ob->type == OB_MESH) &&
-                         ((is_paint_mode && (ob == draw_ctx->obact) &&
-                           DRW_object_use_hide_faces(ob)) ||
-                          ((mode == CTX_MODE_EDIT_MESH) && (ob->mode == OB_MODE_EDIT))));
+  bool is_paint_mode, use_hide;
+  drw_batch_cache_mode_flags_get(*draw_ctx, ob, is_paint_mode, use_hide);
 
   switch (ob->type) {
     case OB_MESH:
@@ -563,15 +573,8 @@ void drw_batch_cache_generate_requested_evaluated_mesh_or_curve(Object *ob, Task
 
   const DRWContext *draw_ctx = DRW_context_get();
   const Scene *scene = draw_ctx->scene;
-  const enum eContextObjectMode mode = CTX_data_mode_enum_ex(
-      draw_ctx->object_edit, draw_ctx->obact, draw_ctx->object_mode);
-  const bool is_paint_mode = ELEM(
-      mode, CTX_MODE_SCULPT, CTX_MODE_PAINT_TEXTURE, CTX_MODE_PAINT_VERTEX, CTX_MODE_PAINT_WEIGHT);
-
-  const bool use_hide = ((ob->type == OB_MESH) &&
-                         ((is_paint_mode && (ob == draw_ctx->obact) &&
-                           DRW_object_use_hide_faces(ob)) ||
-                          ((mode == CTX_MODE_EDIT_MESH) && (ob->mode == OB_MODE_EDIT))));
+  bool is_paint_mode, use_hide;
+  drw_batch_cache_mode_flags_get(*draw_ctx, ob, is_paint_mode, use_hide);
 
   Mesh *mesh = BKE_object_get_evaluated_mesh_no_subsurf_unchecked(ob);
   /* Try getting the mesh first and if that fails, try getting the curve data.
@@ -586,6 +589,60 @@ void drw_batch_cache_generate_requested_evaluated_mesh_or_curve(Object *ob, Task
   }
 }
 
+bool drw_batch_cache_generate_requested_supports_parallel(const Object *ob)
+{
+  if (ob->type != OB_MESH || ob->mode == OB_MODE_EDIT) {
+    return false;
+  }
+  /* GPU subdivision evaluates the mesh with compute shaders while creating the batches. */
+  const Mesh &mesh = DRW_object_get_data_for_drawing<Mesh>(*ob);
+  return !BKE_subsurf_modifier_has_gpu_subdiv(&mesh);
+}
+
+void drw_batch_cache_generate_requested_parallel(const Span<Object *> objects,
+                                                 TaskGraph &task_graph)
+{
+  using namespace blender;
+  using namespace blender::draw;
+  const DRWContext *draw_ctx = DRW_context_get();
+  const Scene &scene = *draw_ctx->scene;
+
+  struct MeshExtraction {
+    Object *ob;
+    Mesh *mesh;
+    bool is_paint_mode;
+    bool use_hide;
+  };
+  /* Objects sharing a mesh share its batch cache. Only the first one creates the requested
+   * batches, like when the objects are handled one after another. */
+  Set<const Mesh *> meshes_added;
+  Vector<MeshExtraction> extractions;
+  extractions.reserve(objects.size());
+  for (Object *ob : objects) {
+    BLI_assert(drw_batch_cache_generate_requested_supports_parallel(ob));
+    MeshExtraction extraction;
+    extraction.ob = ob;
+    extraction.mesh = &DRW_object_get_data_for_drawing<Mesh>(*ob);
+    if (!meshes_added.add(extraction.mesh)) {
+      continue;
+    }
+    /* The draw context is only available on this thread. */
+    drw_batch_cache_mode_flags_get(*draw_ctx, ob, extraction.is_paint_mode, extraction.use_hide);
+    extractions.append(extraction);
+  }
+
+  threading::parallel_for(extractions.index_range(), 1, [&](const IndexRange range) {
+    for (const MeshExtraction &extraction : extractions.as_span().slice(range)) {
+      DRW_mesh_batch_cache_create_requested(task_graph,
+                                            *extraction.ob,
+                                            *extraction.mesh,
+                                            scene,
+                                            extraction.is_paint_mode,
+                                            extraction.use_hide);
+    }
+  });
+}
+
 void drw_batch_cache_generate_requested_delayed(Object *ob)
 {
   DRWContext &draw_ctx = drw_get();
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <memory>
+
 #include "BLI_array.hh"
 #include "BLI_map.hh"
 #include "BLI_math_matrix_types.hh"
@@ -35,6 +37,7 @@ namespace blender::draw {
 
 struct MeshRenderData;
 struct DRWSubdivCache;
+struct MeshLODCache;
 
 /* Vertex Group Selection and display options */
 struct DRW_MeshWeightState {
@@ -309,6 +312,10 @@ struct MeshBatchCache {
    *
    * Only valid after `DRW_mesh_batch_cache_create_requested` has been called. */
   float tot_area, tot_uv_area;
+
+  /* Simplified versions of the mesh, built in the background on first use.
+   * See #DRW_mesh_batch_cache_lod_get. */
+  std::shared_ptr<MeshLODCache> lod_cache;
 };
 
 #define MBC_EDITUV \
@@ -198,6 +198,21 @@ Span<gpu::Batch *> DRW_mesh_batch_cache_get_surface_shaded(Object &object,
                                                            Mesh &mesh,
                                                            Span<const GPUMaterial *> materials);
 
+/** Number of simplified levels of detail. */
+#define DRW_MESH_LOD_LEVELS 2
+/** Each level of detail has this fraction of the faces of the previous one. */
+#define DRW_MESH_LOD_RATIO 0.25f
+/**
+ * Get a simplified version of the mesh, with its own batch cache to request batches from.
+ * The levels are built in the background the first time they are requested.
+ *
+ * \param level: In the [1..#DRW_MESH_LOD_LEVELS] range, higher levels have less faces.
+ * \return Null until the level is ready.
+ */
+Mesh *DRW_mesh_batch_cache_lod_get(Mesh &mesh, int level);
+/** Wait for the levels of detail being built and free the background tasks. */
+void DRW_mesh_batch_cache_lod_exit();
+
 Span<gpu::Batch *> DRW_mesh_batch_cache_get_surface_texpaint(Object &object, Mesh &mesh);
 blender::gpu::Batch *DRW_mesh_batch_cache_get_surface_texpaint_single(Object &object, Mesh &mesh);
 blender::gpu::Batch *DRW_mesh_batch_cache_get_surface_vertpaint(Object &object, Mesh &mesh);
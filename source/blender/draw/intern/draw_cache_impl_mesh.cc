@@ -9,6 +9,7 @@
  */
 
 #include <array>
+#include <atomic>
 #include <optional>
 
 #include "MEM_guardedalloc.h"
@@ -17,6 +18,7 @@
 #include "BLI_listbase.h"
 #include "BLI_span.hh"
 #include "BLI_string_ref.hh"
+#include "BLI_task.h"
 
 #include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
@@ -26,6 +28,7 @@
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
 #include "BKE_editmesh.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_material.hh"
 #include "BKE_mesh.hh"
 #include "BKE_object.hh"
@@ -36,6 +39,9 @@
 
 #include "atomic_ops.h"
 
+#include "bmesh.hh"
+#include "bmesh_tools.hh"
+
 #include "GPU_batch.hh"
 #include "GPU_material.hh"
 
@@ -653,6 +659,8 @@ static void mesh_batch_cache_clear(MeshBatchCache &cache)
   drw_mesh_weight_state_clear(&cache.weight_state);
 
   mesh_batch_cache_free_subdiv_cache(cache);
+
+  cache.lod_cache.reset();
 }
 
 void DRW_mesh_batch_cache_free(void *batch_cache)
@@ -664,6 +672,100 @@ void DRW_mesh_batch_cache_free(void *batch_cache)
 
 /** \} */
 
+/* ---------------------------------------------------------------------- */
+/** \name Level of Detail
+ *
+ * Decimated copies of high resolution meshes, used to draw them faster when they only cover a
+ * small part of the viewport. They are built by a background task so that the UI doesn't freeze,
+ * the full resolution mesh is drawn in the meantime.
+ * \{ */
+
+struct MeshLODCache {
+  /** Set by the background task, once the level is built. */
+  std::array<std::atomic<Mesh *>, DRW_MESH_LOD_LEVELS> meshes = {};
+
+  ~MeshLODCache()
+  {
+    for (std::atomic<Mesh *> &mesh : this->meshes) {
+      if (Mesh *lod_mesh = mesh.load()) {
+        BKE_id_free(nullptr, lod_mesh);
+      }
+    }
+  }
+};
+
+struct MeshLODTaskData {
+  std::shared_ptr<MeshLODCache> lod_cache;
+  /** Copy of the evaluated mesh, its data is shared with the original one. */
+  Mesh *mesh;
+};
+
+static TaskPool *mesh_lod_task_pool = nullptr;
+
+static void mesh_lod_build_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  MeshLODTaskData &data = *static_cast<MeshLODTaskData *>(taskdata);
+
+  BMeshCreateParams create_params{};
+  BMeshFromMeshParams convert_params{};
+  convert_params.calc_face_normal = true;
+  convert_params.calc_vert_normal = true;
+  BMesh *bm = BKE_mesh_to_bmesh_ex(data.mesh, &create_params, &convert_params);
+
+  for (std::atomic<Mesh *> &lod_mesh : data.lod_cache->meshes) {
+    /* The batch cache was freed (e.g. the mesh was modified), the result would be unused. */
+    if (data.lod_cache.use_count() == 1) {
+      break;
+    }
+    BM_mesh_decimate_collapse(bm, DRW_MESH_LOD_RATIO, nullptr, 0.0f, false, -1, 0.00002f);
+    lod_mesh.store(BKE_mesh_from_bmesh_for_eval_nomain(bm, nullptr, data.mesh));
+  }
+
+  BM_mesh_free(bm);
+}
+
+static void mesh_lod_task_data_free(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  MeshLODTaskData *data = static_cast<MeshLODTaskData *>(taskdata);
+  BKE_id_free(nullptr, data->mesh);
+  MEM_delete(data);
+}
+
+Mesh *DRW_mesh_batch_cache_lod_get(Mesh &mesh, const int level)
+{
+  BLI_assert(level >= 1 && level <= DRW_MESH_LOD_LEVELS);
+  MeshBatchCache &cache = *mesh_batch_cache_get(mesh);
+  if (!cache.lod_cache) {
+    cache.lod_cache = std::make_shared<MeshLODCache>();
+    if (mesh_lod_task_pool == nullptr) {
+      mesh_lod_task_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_LOW);
+    }
+    MeshLODTaskData *data = MEM_new<MeshLODTaskData>(__func__);
+    data->lod_cache = cache.lod_cache;
+    data->mesh = BKE_mesh_copy_for_eval(mesh);
+    BLI_task_pool_push(
+        mesh_lod_task_pool, mesh_lod_build_task, data, true, mesh_lod_task_data_free);
+  }
+
+  Mesh *lod_mesh = cache.lod_cache->meshes[level - 1].load();
+  if (lod_mesh == nullptr) {
+    return nullptr;
+  }
+  DRW_mesh_batch_cache_validate(*lod_mesh);
+  return lod_mesh;
+}
+
+void DRW_mesh_batch_cache_lod_exit()
+{
+  if (mesh_lod_task_pool) {
+    BLI_task_pool_cancel(mesh_lod_task_pool);
+    BLI_task_pool_free(mesh_lod_task_pool);
+    mesh_lod_task_pool = nullptr;
+  }
+}
+
+/** \} */
+
 /* ---------------------------------------------------------------------- */
 /** \name Public API
  * \{ */
@@ -1121,6 +1223,15 @@ void DRW_mesh_batch_cache_create_requested(TaskGraph &task_graph,
   MeshBatchCache &cache = *mesh_batch_cache_get(mesh);
   bool cd_uv_update = false;
 
+  if (cache.lod_cache) {
+    for (const std::atomic<Mesh *> &lod_mesh : cache.lod_cache->meshes) {
+      if (Mesh *mesh_lod = lod_mesh.load(); mesh_lod && mesh_lod->runtime->batch_cache) {
+        DRW_mesh_batch_cache_create_requested(
+            task_graph, ob, *mesh_lod, scene, is_paint_mode, use_hide);
+      }
+    }
+  }
+
   /* Early out */
   if (cache.batch_requested == 0) {
     return;
@@ -430,13 +430,10 @@ static void draw_subdiv_invalidate_evaluator_for_orco(bke::subdiv::Subdiv *subdi
   const bool has_orco = CustomData_has_layer(&mesh->vert_data, CD_ORCO);
   if (has_orco && !subdiv->evaluator->eval_output->hasVertexData()) {
     /* If we suddenly have/need original coordinates, recreate the evaluator if the extra
-     * source was not created yet. The refiner also has to be recreated as refinement for source
-     * and vertex data is done only once. */
+     * source was not created yet. The refiner can be kept, its refinement and stencil tables
+     * don't depend on the evaluated data. */
     delete subdiv->evaluator;
     subdiv->evaluator = nullptr;
-
-    delete subdiv->topology_refiner;
-    subdiv->topology_refiner = nullptr;
   }
 }
 
@@ -1808,6 +1805,31 @@ void DRW_subdiv_cache_free(bke::subdiv::Subdiv *subdiv)
   BLI_linklist_prepend(&gpu_subdiv_free_queue, subdiv);
 }
 
+Mesh *DRW_subdiv_to_mesh_gpu(bke::subdiv::Subdiv *subdiv,
+                             const bke::subdiv::ToMeshSettings *settings,
+                             const Mesh *coarse_mesh)
+{
+  /* Lock the entire evaluation to avoid concurrent usage of shader objects in evaluator cache. */
+  std::scoped_lock lock(g_subdiv_eval_mutex);
+
+  if (g_subdiv_evaluator_cache == nullptr) {
+    g_subdiv_evaluator_cache = openSubdiv_createEvaluatorCache(OPENSUBDIV_EVALUATOR_GPU);
+  }
+
+  const bool evaluator_might_be_assigned = subdiv->evaluator == nullptr;
+
+  bke::subdiv::ToMeshSettings gpu_settings = *settings;
+  gpu_settings.use_gpu_evaluation = true;
+  gpu_settings.evaluator_cache = g_subdiv_evaluator_cache;
+  Mesh *result = bke::subdiv::subdiv_to_mesh(subdiv, &gpu_settings, coarse_mesh);
+
+  if (evaluator_might_be_assigned && subdiv->evaluator != nullptr) {
+    /* An evaluator was assigned, it is released in #DRW_cache_free_old_subdiv. */
+    g_subdiv_evaluator_users++;
+  }
+  return result;
+}
+
 void DRW_cache_free_old_subdiv()
 {
   {
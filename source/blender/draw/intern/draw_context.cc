@@ -242,6 +242,8 @@ static bool draw_show_annotation()
 struct ExtractionGraph {
  public:
   TaskGraph *graph = BLI_task_graph_create();
+  /** Objects whose batches are created in parallel before running the graph. */
+  blender::Vector<Object *> objects_parallel;
 
  private:
   /* WORKAROUND: BLI_gset_free is not allowing to pass a data pointer to the free function. */
@@ -259,6 +261,9 @@ struct ExtractionGraph {
   {
     BLI_assert_msg(graph, "Trying to submit more than once");
 
+    drw_batch_cache_generate_requested_parallel(objects_parallel, *graph);
+    objects_parallel.clear();
+
     if (delayed_extraction) {
       task_graph_ptr_ = graph;
       BLI_gset_free(delayed_extraction, delayed_extraction_free_callback);
@@ -509,7 +514,7 @@ void DRWContext::acquire_data()
   }
 }
 
-void DRWContext::release_data()
+void DRWContext::release_data(const bool keep_data)
 {
   BLI_assert(GPU_context_active_get() != nullptr);
 
@@ -520,7 +525,7 @@ void DRWContext::release_data()
 
   DRW_view_data_reset(this->view_data_active);
 
-  if (this->data != nullptr && this->viewport == nullptr) {
+  if (this->data != nullptr && this->viewport == nullptr && !keep_data) {
     DRW_viewport_data_free(this->data);
   }
   this->data = nullptr;
@@ -745,7 +750,12 @@ static void drw_engines_cache_populate(blender::draw::ObjectRef &ref, Extraction
   /* TODO: in the future it would be nice to generate once for all viewports.
    * But we need threaded DRW manager first. */
   if (ref.is_dupli() == false) {
-    drw_batch_cache_generate_requested(ref.object, *extraction.graph);
+    if (drw_batch_cache_generate_requested_supports_parallel(ref.object)) {
+      extraction.objects_parallel.append(ref.object);
+    }
+    else {
+      drw_batch_cache_generate_requested(ref.object, *extraction.graph);
+    }
   }
 }
 
@@ -1495,6 +1505,14 @@ void DRW_render_to_image(
   GPU_render_begin();
 
   DRWContext draw_ctx(DRWContext::RENDER, depsgraph, {engine->resolution_x, engine->resolution_y});
+  /* Reuse the draw data of the previous frame of an animation render, so that engines can keep
+   * what didn't change between frames. It refers to evaluated data of the view layer. */
+  const ViewLayer *view_layer_orig = DEG_get_input_view_layer(depsgraph);
+  if (engine->draw_data_view_layer != view_layer_orig) {
+    DRW_render_data_free(engine);
+  }
+  draw_ctx.data = engine->draw_data;
+  engine->draw_data = nullptr;
   draw_ctx.acquire_data();
   draw_ctx.options.draw_background = scene->r.alphamode == R_ADDSKY;
   /* Init modules ahead of time because the begin_sync happens before DRW_render_object_iter. */
@@ -1539,13 +1557,28 @@ void DRW_render_to_image(
 
   blender::gpu::TexturePool::get().reset(true);
 
-  draw_ctx.release_data();
+  /* The engine is freed at the end of the animation render, and the draw data with it. */
+  const bool keep_data = (engine->flag & RE_ENGINE_ANIMATION) != 0;
+  if (keep_data) {
+    engine->draw_data = draw_ctx.data;
+    engine->draw_data_view_layer = view_layer_orig;
+  }
+  draw_ctx.release_data(keep_data);
   DRW_cache_free_old_subdiv();
 
   /* End GPU workload Boundary */
   GPU_render_end();
 }
 
+void DRW_render_data_free(RenderEngine *engine)
+{
+  if (engine->draw_data != nullptr) {
+    DRW_viewport_data_free(engine->draw_data);
+    engine->draw_data = nullptr;
+  }
+  engine->draw_data_view_layer = nullptr;
+}
+
 void DRW_render_object_iter(
     RenderEngine *engine,
     Depsgraph *depsgraph,
@@ -2075,10 +2108,13 @@ void DRW_module_init()
   BKE_grease_pencil_batch_cache_free_cb = DRW_grease_pencil_batch_cache_free;
 
   BKE_subsurf_modifier_free_gpu_cache_cb = DRW_subdiv_cache_free;
+  BKE_subsurf_modifier_subdiv_to_mesh_gpu_cb = DRW_subdiv_to_mesh_gpu;
 }
 
 void DRW_module_exit()
 {
+  blender::draw::DRW_mesh_batch_cache_lod_exit();
+
   if (DRW_gpu_context_try_enable() == false) {
     /* Nothing has been setup. Nothing to clear. */
     return;
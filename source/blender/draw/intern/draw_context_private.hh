@@ -76,6 +76,14 @@ DRWContext &drw_get();
 
 void drw_batch_cache_validate(Object *ob);
 void drw_batch_cache_generate_requested(Object *ob, TaskGraph &task_graph);
+/**
+ * Creating the batches of meshes doesn't need the GPU, except for GPU subdivision. These can be
+ * created for all objects in parallel with #drw_batch_cache_generate_requested_parallel, after
+ * all objects have been synced.
+ */
+bool drw_batch_cache_generate_requested_supports_parallel(const Object *ob);
+void drw_batch_cache_generate_requested_parallel(blender::Span<Object *> objects,
+                                                 TaskGraph &task_graph);
 
 /**
  * \warning Only evaluated mesh data is handled by this delayed generation.
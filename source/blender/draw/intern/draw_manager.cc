@@ -73,6 +73,8 @@ void Manager::begin_sync(Object *object_active)
 #endif
   resource_len_ = 0;
   attribute_len_ = 0;
+  /* The data of the previous sync could have been freed. */
+  instance_geometry_cache_.data = nullptr;
   /* TODO(fclem): Resize buffers if too big, but with an hysteresis threshold. */
 
   this->object_active = object_active;
@@ -115,6 +115,19 @@ class Manager {
 
   Object *object_active = nullptr;
 
+  /**
+   * Bounds and texture space of the geometry of the last synced instance. Instances of the same
+   * geometry are usually synced one after the other. For some object types these only depend on
+   * the geometry, so they are computed once instead of for every instance.
+   */
+  struct {
+    const void *data = nullptr;
+    float inflate_bounds = 0.0f;
+    ObjectBounds bounds;
+    float3 orco_add;
+    float3 orco_mul;
+  } instance_geometry_cache_;
+
  public:
   Manager(){};
   ~Manager();
@@ -328,8 +341,35 @@ inline ResourceHandleRange Manager::resource_handle(const ObjectRef &ref, float
 {
   bool is_active_object = (ref.dupli_object ? ref.dupli_parent : ref.object) == object_active;
   matrix_buf.current().get_or_resize(resource_len_).sync(*ref.object);
-  bounds_buf.current().get_or_resize(resource_len_).sync(*ref.object, inflate_bounds);
-  infos_buf.current().get_or_resize(resource_len_).sync(ref, is_active_object);
+  ObjectBounds &bounds = bounds_buf.current().get_or_resize(resource_len_);
+  ObjectInfos &infos = infos_buf.current().get_or_resize(resource_len_);
+
+  /* Bounds and texture space of these types only depend on the object data. */
+  const bool use_instance_cache = ref.is_dupli() && ref.object->data != nullptr &&
+                                  ELEM(ref.object->type,
+                                       OB_MESH,
+                                       OB_CURVES,
+                                       OB_POINTCLOUD,
+                                       OB_VOLUME);
+  if (use_instance_cache && instance_geometry_cache_.data == ref.object->data &&
+      instance_geometry_cache_.inflate_bounds == inflate_bounds)
+  {
+    bounds = instance_geometry_cache_.bounds;
+    infos.sync(ref, is_active_object, false);
+    infos.orco_add = instance_geometry_cache_.orco_add;
+    infos.orco_mul = instance_geometry_cache_.orco_mul;
+  }
+  else {
+    bounds.sync(*ref.object, inflate_bounds);
+    infos.sync(ref, is_active_object);
+    if (use_instance_cache) {
+      instance_geometry_cache_.data = ref.object->data;
+      instance_geometry_cache_.inflate_bounds = inflate_bounds;
+      instance_geometry_cache_.bounds = bounds;
+      instance_geometry_cache_.orco_add = infos.orco_add;
+      instance_geometry_cache_.orco_mul = infos.orco_mul;
+    }
+  }
   return ResourceHandle(resource_len_++, (ref.object->transflag & OB_NEG_SCALE) != 0);
 }
 
@@ -253,6 +253,23 @@ static void drw_deferred_queue_append(GPUMaterial *mat, bool is_optimization_job
   compiler_data().queue_cv.notify_one();
 }
 
+/**
+ * Move an already queued material to the end of the compilation queue, which is compiled first.
+ */
+static void drw_deferred_queue_promote(GPUMaterial *mat)
+{
+  std::scoped_lock queue_lock(compiler_data().queue_mutex);
+
+  Vector<GPUMaterial *> &queue = compiler_data().queue;
+  const int64_t index = queue.first_index_of_try(mat);
+  /* The material isn't found when it is being compiled. */
+  if (ELEM(index, -1, queue.size() - 1)) {
+    return;
+  }
+  queue.remove(index);
+  queue.append(mat);
+}
+
 static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
 {
   if (ELEM(GPU_material_status(mat), GPU_MAT_SUCCESS, GPU_MAT_FAILED)) {
@@ -275,8 +292,11 @@ static void drw_deferred_shader_add(GPUMaterial *mat, bool deferred)
     return;
   }
 
-  /* Don't add material to the queue twice. */
+  /* Don't add material to the queue twice, but give it the highest priority again. Materials are
+   * requested on every sync for the objects that are drawn, so shaders of visible objects are
+   * compiled before the ones requested by objects that are not drawn anymore. */
   if (GPU_material_status(mat) == GPU_MAT_QUEUED) {
+    drw_deferred_queue_promote(mat);
     return;
   }
 
@@ -8,6 +8,7 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_index_mask.hh"
 #include "BLI_math_color.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
@@ -49,6 +50,8 @@
 #include "intern/bmesh_polygon.hh"
 
 using blender::float3;
+using blender::IndexMask;
+using blender::IndexMaskMemory;
 using blender::Span;
 
 struct ViewCachedString {
@@ -260,6 +263,17 @@ void DRW_text_cache_draw(DRWTextStore *dt, ARegion *region, View3D *v3d)
   }
 }
 
+/**
+ * Find the elements to add text for on multiple threads. With big meshes iterating over all
+ * elements is expensive, while usually only few of them are selected.
+ */
+template<typename Fn>
+static IndexMask text_elements_find(const int elements_num, IndexMaskMemory &memory, const Fn &fn)
+{
+  return IndexMask::from_predicate(
+      blender::IndexRange(elements_num), blender::GrainSize(4096), memory, fn);
+}
+
 void DRW_text_edit_mesh_measure_stats(const ARegion *region,
                                       const View3D *v3d,
                                       const Object *ob,
@@ -330,56 +344,57 @@ void DRW_text_edit_mesh_measure_stats(const ARegion *region,
   }
 
   if (v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_EDGE_LEN) {
-    BMEdge *eed;
-
     UI_GetThemeColor3ubv(TH_DRAWEXTRA_EDGELEN, col);
 
     if (use_coords) {
       BM_mesh_elem_index_ensure(em->bm, BM_VERT);
     }
 
-    BM_ITER_MESH (eed, &iter, em->bm, BM_EDGES_OF_MESH) {
+    BM_mesh_elem_table_ensure(em->bm, BM_EDGE);
+    IndexMaskMemory memory;
+    const IndexMask edges = text_elements_find(em->bm->totedge, memory, [&](const int i) {
+      const BMEdge *eed = BM_edge_at_index(em->bm, i);
       /* draw selected edges, or edges next to selected verts while dragging */
-      if (BM_elem_flag_test(eed, BM_ELEM_SELECT) ||
-          (do_moving && (BM_elem_flag_test(eed->v1, BM_ELEM_SELECT) ||
-                         BM_elem_flag_test(eed->v2, BM_ELEM_SELECT))))
-      {
-        float3 v1, v2;
-        float3 v1_clip, v2_clip;
+      return BM_elem_flag_test(eed, BM_ELEM_SELECT) ||
+             (do_moving && (BM_elem_flag_test(eed->v1, BM_ELEM_SELECT) ||
+                            BM_elem_flag_test(eed->v2, BM_ELEM_SELECT)));
+    });
+    edges.foreach_index([&](const int i) {
+      const BMEdge *eed = BM_edge_at_index(em->bm, i);
+      float3 v1, v2;
+      float3 v1_clip, v2_clip;
 
-        if (use_coords) {
-          v1 = vert_positions[BM_elem_index_get(eed->v1)];
-          v2 = vert_positions[BM_elem_index_get(eed->v2)];
-        }
-        else {
-          v1 = eed->v1->co;
-          v2 = eed->v2->co;
-        }
+      if (use_coords) {
+        v1 = vert_positions[BM_elem_index_get(eed->v1)];
+        v2 = vert_positions[BM_elem_index_get(eed->v2)];
+      }
+      else {
+        v1 = eed->v1->co;
+        v2 = eed->v2->co;
+      }
 
-        if (clip_segment_v3_plane_n(v1, v2, clip_planes.ptr(), 4, v1_clip, v2_clip)) {
-          const float3 co = blender::math::transform_point(ob->object_to_world(),
-                                                           0.5 * (v1_clip + v2_clip));
+      if (clip_segment_v3_plane_n(v1, v2, clip_planes.ptr(), 4, v1_clip, v2_clip)) {
+        const float3 co = blender::math::transform_point(ob->object_to_world(),
+                                                         0.5 * (v1_clip + v2_clip));
 
-          if (do_global) {
-            v1 = ob->object_to_world().view<3, 3>() * v1;
-            v2 = ob->object_to_world().view<3, 3>() * v2;
-          }
+        if (do_global) {
+          v1 = ob->object_to_world().view<3, 3>() * v1;
+          v2 = ob->object_to_world().view<3, 3>() * v2;
+        }
 
-          const size_t numstr_len =
-              unit.system ?
-                  BKE_unit_value_as_string_scaled(
-                      numstr, sizeof(numstr), len_v3v3(v1, v2), 3, B_UNIT_LENGTH, unit, false) :
-                  SNPRINTF_RLEN(numstr, conv_float, len_v3v3(v1, v2));
+        const size_t numstr_len =
+            unit.system ?
+                BKE_unit_value_as_string_scaled(
+                    numstr, sizeof(numstr), len_v3v3(v1, v2), 3, B_UNIT_LENGTH, unit, false) :
+                SNPRINTF_RLEN(numstr, conv_float, len_v3v3(v1, v2));
 
-          DRW_text_cache_add(dt, co, numstr, numstr_len, 0, edge_tex_sep, txt_flag, col);
-        }
+        DRW_text_cache_add(dt, co, numstr, numstr_len, 0, edge_tex_sep, txt_flag, col);
       }
-    }
+    });
   }
 
   if (v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_EDGE_ANG) {
     const bool is_rad = (unit.system_rotation == USER_UNIT_ROT_RADIANS);
-    BMEdge *eed;
 
     UI_GetThemeColor3ubv(TH_DRAWEXTRA_EDGEANG, col);
 
@@ -391,64 +406,71 @@ void DRW_text_edit_mesh_measure_stats(const ARegion *region,
       face_normals = BKE_mesh_wrapper_face_normals(const_cast<Mesh *>(mesh));
     }
 
-    BM_ITER_MESH (eed, &iter, em->bm, BM_EDGES_OF_MESH) {
+    BM_mesh_elem_table_ensure(em->bm, BM_EDGE);
+    IndexMaskMemory memory;
+    const IndexMask edges = text_elements_find(em->bm->totedge, memory, [&](const int i) {
+      BMEdge *eed = BM_edge_at_index(em->bm, i);
       BMLoop *l_a, *l_b;
-      if (BM_edge_loop_pair(eed, &l_a, &l_b)) {
-        /* Draw selected edges, or edges next to selected verts while dragging. */
-        if (BM_elem_flag_test(eed, BM_ELEM_SELECT) ||
-            (do_moving && (BM_elem_flag_test(eed->v1, BM_ELEM_SELECT) ||
-                           BM_elem_flag_test(eed->v2, BM_ELEM_SELECT) ||
-                           /* Special case, this is useful to show when verts connected
-                            * to this edge via a face are being transformed. */
-                           BM_elem_flag_test(l_a->next->next->v, BM_ELEM_SELECT) ||
-                           BM_elem_flag_test(l_a->prev->v, BM_ELEM_SELECT) ||
-                           BM_elem_flag_test(l_b->next->next->v, BM_ELEM_SELECT) ||
-                           BM_elem_flag_test(l_b->prev->v, BM_ELEM_SELECT))))
-        {
-          float3 v1, v2;
-          float3 v1_clip, v2_clip;
+      if (!BM_edge_loop_pair(eed, &l_a, &l_b)) {
+        return false;
+      }
+      /* Draw selected edges, or edges next to selected verts while dragging. */
+      return BM_elem_flag_test(eed, BM_ELEM_SELECT) ||
+             (do_moving && (BM_elem_flag_test(eed->v1, BM_ELEM_SELECT) ||
+                            BM_elem_flag_test(eed->v2, BM_ELEM_SELECT) ||
+                            /* Special case, this is useful to show when verts connected
+                             * to this edge via a face are being transformed. */
+                            BM_elem_flag_test(l_a->next->next->v, BM_ELEM_SELECT) ||
+                            BM_elem_flag_test(l_a->prev->v, BM_ELEM_SELECT) ||
+                            BM_elem_flag_test(l_b->next->next->v, BM_ELEM_SELECT) ||
+                            BM_elem_flag_test(l_b->prev->v, BM_ELEM_SELECT)));
+    });
+    edges.foreach_index([&](const int i) {
+      BMEdge *eed = BM_edge_at_index(em->bm, i);
+      BMLoop *l_a, *l_b;
+      BM_edge_loop_pair(eed, &l_a, &l_b);
+      float3 v1, v2;
+      float3 v1_clip, v2_clip;
 
-          if (use_coords) {
-            v1 = vert_positions[BM_elem_index_get(eed->v1)];
-            v2 = vert_positions[BM_elem_index_get(eed->v2)];
-          }
-          else {
-            v1 = eed->v1->co;
-            v2 = eed->v2->co;
-          }
+      if (use_coords) {
+        v1 = vert_positions[BM_elem_index_get(eed->v1)];
+        v2 = vert_positions[BM_elem_index_get(eed->v2)];
+      }
+      else {
+        v1 = eed->v1->co;
+        v2 = eed->v2->co;
+      }
 
-          if (clip_segment_v3_plane_n(v1, v2, clip_planes.ptr(), 4, v1_clip, v2_clip)) {
-            float3 no_a, no_b;
+      if (clip_segment_v3_plane_n(v1, v2, clip_planes.ptr(), 4, v1_clip, v2_clip)) {
+        float3 no_a, no_b;
 
-            const float3 co = blender::math::transform_point(ob->object_to_world(),
-                                                             0.5 * (v1_clip + v2_clip));
+        const float3 co = blender::math::transform_point(ob->object_to_world(),
+                                                         0.5 * (v1_clip + v2_clip));
 
-            if (use_coords) {
-              no_a = face_normals[BM_elem_index_get(l_a->f)];
-              no_b = face_normals[BM_elem_index_get(l_b->f)];
-            }
-            else {
-              no_a = l_a->f->no;
-              no_b = l_b->f->no;
-            }
+        if (use_coords) {
+          no_a = face_normals[BM_elem_index_get(l_a->f)];
+          no_b = face_normals[BM_elem_index_get(l_b->f)];
+        }
+        else {
+          no_a = l_a->f->no;
+          no_b = l_b->f->no;
+        }
 
-            if (do_global) {
-              no_a = blender::math::normalize(ob->world_to_object().view<3, 3>() * no_a);
-              no_b = blender::math::normalize(ob->world_to_object().view<3, 3>() * no_b);
-            }
+        if (do_global) {
+          no_a = blender::math::normalize(ob->world_to_object().view<3, 3>() * no_a);
+          no_b = blender::math::normalize(ob->world_to_object().view<3, 3>() * no_b);
+        }
 
-            const float angle = angle_normalized_v3v3(no_a, no_b);
+        const float angle = angle_normalized_v3v3(no_a, no_b);
 
-            const size_t numstr_len = SNPRINTF_RLEN(numstr,
-                                                    "%.3f%s",
-                                                    (is_rad) ? angle : RAD2DEGF(angle),
-                                                    (is_rad) ? "r" : BLI_STR_UTF8_DEGREE_SIGN);
+        const size_t numstr_len = SNPRINTF_RLEN(numstr,
+                                                "%.3f%s",
+                                                (is_rad) ? angle : RAD2DEGF(angle),
+                                                (is_rad) ? "r" : BLI_STR_UTF8_DEGREE_SIGN);
 
-            DRW_text_cache_add(dt, co, numstr, numstr_len, 0, -edge_tex_sep, txt_flag, col);
-          }
-        }
+        DRW_text_cache_add(dt, co, numstr, numstr_len, 0, -edge_tex_sep, txt_flag, col);
       }
-    }
+    });
   }
 
   if (v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_FACE_AREA) {
@@ -585,92 +607,97 @@ void DRW_text_edit_mesh_measure_stats(const ARegion *region,
    * with
    * --debug */
   if (v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_INDICES) {
-    int i;
-
     UI_GetThemeColor4ubv(TH_TEXT_HI, col);
 
     if (em->selectmode & SCE_SELECT_VERTEX) {
-      BMVert *v;
-
       if (use_coords) {
         BM_mesh_elem_index_ensure(em->bm, BM_VERT);
       }
-      BM_ITER_MESH_INDEX (v, &iter, em->bm, BM_VERTS_OF_MESH, i) {
-        if (BM_elem_flag_test(v, BM_ELEM_SELECT)) {
-          const float3 co = blender::math::transform_point(
-              ob->object_to_world(), use_coords ? vert_positions[BM_elem_index_get(v)] : v->co);
 
-          const size_t numstr_len = SNPRINTF_RLEN(numstr, "%d", i);
-          DRW_text_cache_add(dt, co, numstr, numstr_len, 0, 0, txt_flag, col, true, false);
-        }
-      }
+      BM_mesh_elem_table_ensure(em->bm, BM_VERT);
+      IndexMaskMemory memory;
+      const IndexMask verts = text_elements_find(em->bm->totvert, memory, [&](const int i) {
+        return BM_elem_flag_test(BM_vert_at_index(em->bm, i), BM_ELEM_SELECT);
+      });
+      verts.foreach_index([&](const int i) {
+        BMVert *v = BM_vert_at_index(em->bm, i);
+        const float3 co = blender::math::transform_point(
+            ob->object_to_world(), use_coords ? vert_positions[BM_elem_index_get(v)] : v->co);
+
+        const size_t numstr_len = SNPRINTF_RLEN(numstr, "%d", i);
+        DRW_text_cache_add(dt, co, numstr, numstr_len, 0, 0, txt_flag, col, true, false);
+      });
     }
 
     if (em->selectmode & SCE_SELECT_EDGE) {
-      BMEdge *eed;
-
       const bool use_edge_tex_sep = (edge_tex_count == 2);
       const bool use_edge_tex_len = (v3d->overlay.edit_flag & V3D_OVERLAY_EDIT_EDGE_LEN);
 
-      BM_ITER_MESH_INDEX (eed, &iter, em->bm, BM_EDGES_OF_MESH, i) {
-        if (BM_elem_flag_test(eed, BM_ELEM_SELECT)) {
-          float3 v1, v2;
-          float3 v1_clip, v2_clip;
+      BM_mesh_elem_table_ensure(em->bm, BM_EDGE);
+      IndexMaskMemory memory;
+      const IndexMask edges = text_elements_find(em->bm->totedge, memory, [&](const int i) {
+        return BM_elem_flag_test(BM_edge_at_index(em->bm, i), BM_ELEM_SELECT);
+      });
+      edges.foreach_index([&](const int i) {
+        BMEdge *eed = BM_edge_at_index(em->bm, i);
+        float3 v1, v2;
+        float3 v1_clip, v2_clip;
 
-          if (use_coords) {
-            v1 = vert_positions[BM_elem_index_get(eed->v1)];
-            v2 = vert_positions[BM_elem_index_get(eed->v2)];
-          }
-          else {
-            v1 = eed->v1->co;
-            v2 = eed->v2->co;
-          }
+        if (use_coords) {
+          v1 = vert_positions[BM_elem_index_get(eed->v1)];
+          v2 = vert_positions[BM_elem_index_get(eed->v2)];
+        }
+        else {
+          v1 = eed->v1->co;
+          v2 = eed->v2->co;
+        }
 
-          if (clip_segment_v3_plane_n(v1, v2, clip_planes.ptr(), 4, v1_clip, v2_clip)) {
-            const float3 co = blender::math::transform_point(ob->object_to_world(),
-                                                             0.5 * (v1_clip + v2_clip));
-
-            const size_t numstr_len = SNPRINTF_RLEN(numstr, "%d", i);
-            DRW_text_cache_add(
-                dt,
-                co,
-                numstr,
-                numstr_len,
-                0,
-                (use_edge_tex_sep) ? (use_edge_tex_len) ? -edge_tex_sep : edge_tex_sep : 0,
-                txt_flag,
-                col,
-                true,
-                false);
-          }
+        if (clip_segment_v3_plane_n(v1, v2, clip_planes.ptr(), 4, v1_clip, v2_clip)) {
+          const float3 co = blender::math::transform_point(ob->object_to_world(),
+                                                           0.5 * (v1_clip + v2_clip));
+
+          const size_t numstr_len = SNPRINTF_RLEN(numstr, "%d", i);
+          DRW_text_cache_add(
+              dt,
+              co,
+              numstr,
+              numstr_len,
+              0,
+              (use_edge_tex_sep) ? (use_edge_tex_len) ? -edge_tex_sep : edge_tex_sep : 0,
+              txt_flag,
+              col,
+              true,
+              false);
         }
-      }
+      });
     }
 
     if (em->selectmode & SCE_SELECT_FACE) {
-      BMFace *f;
-
       if (use_coords) {
         BM_mesh_elem_index_ensure(em->bm, BM_VERT);
       }
 
-      BM_ITER_MESH_INDEX (f, &iter, em->bm, BM_FACES_OF_MESH, i) {
-        if (BM_elem_flag_test(f, BM_ELEM_SELECT)) {
-          float3 co;
+      BM_mesh_elem_table_ensure(em->bm, BM_FACE);
+      IndexMaskMemory memory;
+      const IndexMask faces = text_elements_find(em->bm->totface, memory, [&](const int i) {
+        return BM_elem_flag_test(BM_face_at_index(em->bm, i), BM_ELEM_SELECT);
+      });
+      faces.foreach_index([&](const int i) {
+        BMFace *f = BM_face_at_index(em->bm, i);
+        float3 co;
 
-          if (use_coords) {
-            BM_face_calc_center_median_vcos(em->bm, f, co, vert_positions);
-          }
-          else {
-            BM_face_calc_center_median(f, co);
-          }
+        if (use_coords) {
+          BM_face_calc_center_median_vcos(em->bm, f, co, vert_positions);
+        }
+        else {
+          BM_face_calc_center_median(f, co);
+        }
 
-          co = blender::math::transform_point(ob->object_to_world(), co);
+        co = blender::math::transform_point(ob->object_to_world(), co);
 
-          const size_t numstr_len = SNPRINTF_RLEN(numstr, "%d", i);
-          DRW_text_cache_add(dt, co, numstr, numstr_len, 0, 0, txt_flag, col, true, false);
-        }
-      }
+        const size_t numstr_len = SNPRINTF_RLEN(numstr, "%d", i);
+        DRW_text_cache_add(dt, co, numstr, numstr_len, 0, 0, txt_flag, col, true, false);
+      });
     }
   }
 }
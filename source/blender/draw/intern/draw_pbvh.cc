@@ -9,6 +9,8 @@
  * Embeds GPU meshes inside of bke::pbvh::Tree nodes, used by mesh sculpt mode.
  */
 
+#include "BLI_array_utils.hh"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_map.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector_types.hh"
@@ -147,6 +149,11 @@ class DrawCacheImpl : public DrawCache {
    */
   BitVector<> dirty_topology_;
 
+  /** The index of the last call to #free_unused_nodes in which each node was drawn. */
+  Vector<int> node_last_drawn_;
+  int free_unused_nodes_calls_num_ = 0;
+  bool exceeds_memory_limit_ = false;
+
  public:
   ~DrawCacheImpl() override;
 
@@ -167,7 +174,19 @@ class DrawCacheImpl : public DrawCache {
 
   Span<int> ensure_material_indices(const Object &object) override;
 
+  void free_unused_nodes(const Object &object,
+                         const IndexMask &drawn_nodes,
+                         int64_t memory_limit) override;
+
+  bool exceeds_memory_limit() const override
+  {
+    return exceeds_memory_limit_;
+  }
+
  private:
+  /** Free all GPU data of the nodes, it's recreated the next time the nodes are drawn. */
+  void free_nodes(const IndexMask &node_mask);
+
   /**
    * Free all GPU data for nodes with a changed visible triangle count. The next time the data is
    * requested it will be rebuilt.
@@ -515,16 +534,18 @@ void DrawCacheImpl::free_nodes_with_changed_topology(const bke::pbvh::Tree &pbvh
   }
 }
 
-BLI_NOINLINE static void ensure_vbos_allocated_mesh(const Object &object,
-                                                    const GPUVertFormat &format,
-                                                    const IndexMask &node_mask,
-                                                    const MutableSpan<gpu::VertBufPtr> vbos)
+BLI_NOINLINE static void ensure_vbos_allocated_mesh(
+    const Object &object,
+    const GPUVertFormat &format,
+    const IndexMask &node_mask,
+    const MutableSpan<gpu::VertBufPtr> vbos,
+    const GPUUsageType usage = GPU_USAGE_STATIC)
 {
   const bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(object);
   const Span<bke::pbvh::MeshNode> nodes = pbvh.nodes<bke::pbvh::MeshNode>();
   node_mask.foreach_index(GrainSize(64), [&](const int i) {
     if (!vbos[i]) {
-      vbos[i] = gpu::VertBufPtr(GPU_vertbuf_create_with_format(format));
+      vbos[i] = gpu::VertBufPtr(GPU_vertbuf_create_with_format_ex(format, usage));
     }
     GPU_vertbuf_data_alloc(*vbos[i], nodes[i].corners_num());
   });
@@ -568,6 +589,82 @@ BLI_NOINLINE static void ensure_vbos_allocated_bmesh(const Object &object,
   });
 }
 
+/**
+ * Update the buffers of values that change on every step of sculpt strokes: positions and
+ * normals. Their data is kept in memory after uploading, so when a node is updated again, only the
+ * range of values that actually changed has to be uploaded instead of the whole buffer. Strokes
+ * often only move part of the vertices of each node, so this reduces the upload bandwidth, which
+ * is what limits the redraw speed for dense meshes.
+ *
+ * \param fill_fn: Writes the values for all corners of a node to the given span.
+ */
+template<typename T, typename FillFn>
+BLI_NOINLINE static void update_dynamic_vbos_mesh(const Object &object,
+                                                  const GPUVertFormat &format,
+                                                  const IndexMask &node_mask,
+                                                  const MutableSpan<gpu::VertBufPtr> vbos,
+                                                  const FillFn fill_fn)
+{
+  const bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(object);
+  const Span<bke::pbvh::MeshNode> nodes = pbvh.nodes<bke::pbvh::MeshNode>();
+
+  IndexMaskMemory memory;
+  const IndexMask nodes_to_update = IndexMask::from_predicate(
+      node_mask, GrainSize(1024), memory, [&](const int i) {
+        const gpu::VertBuf *vbo = vbos[i].get();
+        return vbo && vbo->get_usage_type() == GPU_USAGE_DYNAMIC &&
+               (vbo->flag & GPU_VERTBUF_DATA_UPLOADED) && !(vbo->flag & GPU_VERTBUF_DATA_DIRTY) &&
+               vbo->vertex_len == nodes[i].corners_num();
+      });
+  const IndexMask nodes_to_fill = IndexMask::from_difference(node_mask, nodes_to_update, memory);
+
+  ensure_vbos_allocated_mesh(object, format, nodes_to_fill, vbos, GPU_USAGE_DYNAMIC);
+  nodes_to_fill.foreach_index(GrainSize(1),
+                              [&](const int i) { fill_fn(i, vbos[i]->data<T>()); });
+
+  /* Compare the new values with the uploaded ones to find the range that has to be uploaded. */
+  Array<IndexRange> changed_ranges(nodes_to_update.size());
+  threading::EnumerableThreadSpecific<Vector<T>> all_tls;
+  nodes_to_update.foreach_index(GrainSize(1), [&](const int i, const int pos) {
+    Vector<T> &new_data = all_tls.local();
+    const MutableSpan<T> data = vbos[i]->data<T>().take_front(nodes[i].corners_num());
+    new_data.resize(data.size());
+    fill_fn(i, new_data.as_mutable_span());
+
+    const auto is_equal = [&](const int64_t index) {
+      return std::memcmp(&data[index], &new_data[index], sizeof(T)) == 0;
+    };
+    int64_t first = 0;
+    while (first < data.size() && is_equal(first)) {
+      first++;
+    }
+    if (first == data.size()) {
+      return;
+    }
+    int64_t last = data.size() - 1;
+    while (last > first && is_equal(last)) {
+      last--;
+    }
+    const IndexRange range = IndexRange::from_begin_end_inclusive(first, last);
+    data.slice(range).copy_from(new_data.as_span().slice(range));
+    changed_ranges[pos] = range;
+  });
+
+  nodes_to_update.foreach_index([&](const int i, const int pos) {
+    const IndexRange range = changed_ranges[pos];
+    if (range.is_empty()) {
+      return;
+    }
+    gpu::VertBuf *vbo = vbos[i].get();
+    /* Bind the buffer so that #GPU_vertbuf_update_sub can work. */
+    GPU_vertbuf_use(vbo);
+    GPU_vertbuf_update_sub(vbo,
+                           uint(range.start() * sizeof(T)),
+                           uint(range.size() * sizeof(T)),
+                           &vbo->data<T>()[range.start()]);
+  });
+}
+
 static void update_positions_mesh(const Object &object,
                                   const IndexMask &node_mask,
                                   MutableSpan<gpu::VertBufPtr> vbos)
@@ -578,11 +675,16 @@ static void update_positions_mesh(const Object &object,
   const OffsetIndices<int> faces = mesh.faces();
   const Span<int> corner_verts = mesh.corner_verts();
   const Span<float3> vert_positions = bke::pbvh::vert_positions_eval_from_eval(object);
-  ensure_vbos_allocated_mesh(object, position_format(), node_mask, vbos);
-  node_mask.foreach_index(GrainSize(1), [&](const int i) {
-    extract_data_vert_mesh<float3>(
-        faces, corner_verts, vert_positions, nodes[i].faces(), *vbos[i]);
-  });
+  update_dynamic_vbos_mesh<float3>(
+      object, position_format(), node_mask, vbos, [&](const int i, MutableSpan<float3> data) {
+        int corner = 0;
+        for (const int face : nodes[i].faces()) {
+          for (const int vert : corner_verts.slice(faces[face])) {
+            data[corner] = vert_positions[vert];
+            corner++;
+          }
+        }
+      });
 }
 
 static void update_normals_mesh(const Object &object,
@@ -598,24 +700,23 @@ static void update_normals_mesh(const Object &object,
   const Span<float3> face_normals = bke::pbvh::face_normals_eval_from_eval(object);
   const bke::AttributeAccessor attributes = mesh.attributes();
   const VArraySpan sharp_faces = *attributes.lookup<bool>("sharp_face", bke::AttrDomain::Face);
-  ensure_vbos_allocated_mesh(object, normal_format(), node_mask, vbos);
-  node_mask.foreach_index(GrainSize(1), [&](const int i) {
-    short4 *data = vbos[i]->data<short4>().data();
-
-    for (const int face : nodes[i].faces()) {
-      if (!sharp_faces.is_empty() && sharp_faces[face]) {
-        const int face_size = faces[face].size();
-        std::fill_n(data, face_size, normal_float_to_short(face_normals[face]));
-        data += face_size;
-      }
-      else {
-        for (const int vert : corner_verts.slice(faces[face])) {
-          *data = normal_float_to_short(vert_normals[vert]);
-          data++;
+  update_dynamic_vbos_mesh<short4>(
+      object, normal_format(), node_mask, vbos, [&](const int i, MutableSpan<short4> vbo_data) {
+        short4 *data = vbo_data.data();
+        for (const int face : nodes[i].faces()) {
+          if (!sharp_faces.is_empty() && sharp_faces[face]) {
+            const int face_size = faces[face].size();
+            std::fill_n(data, face_size, normal_float_to_short(face_normals[face]));
+            data += face_size;
+          }
+          else {
+            for (const int vert : corner_verts.slice(faces[face])) {
+              *data = normal_float_to_short(vert_normals[vert]);
+              data++;
+            }
+          }
         }
-      }
-    }
-  });
+      });
 }
 
 BLI_NOINLINE static void update_masks_mesh(const Object &object,
@@ -1924,6 +2025,81 @@ Span<gpu::Batch *> DrawCacheImpl::ensure_lines_batches(const Object &object,
   return batches;
 }
 
+void DrawCacheImpl::free_nodes(const IndexMask &node_mask)
+{
+  free_ibos(lines_ibos_, node_mask);
+  free_ibos(lines_ibos_coarse_, node_mask);
+  free_ibos(tris_ibos_, node_mask);
+  free_ibos(tris_ibos_coarse_, node_mask);
+  for (AttributeData &data : attribute_vbos_.values()) {
+    free_vbos(data.vbos, node_mask);
+  }
+  free_batches(lines_batches_, node_mask);
+  free_batches(lines_batches_coarse_, node_mask);
+  for (MutableSpan<gpu::Batch *> batches : tris_batches_.values()) {
+    free_batches(batches, node_mask);
+  }
+}
+
+void DrawCacheImpl::free_unused_nodes(const Object &object,
+                                      const IndexMask &drawn_nodes,
+                                      const int64_t memory_limit)
+{
+  const bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(object);
+  const int nodes_num = pbvh.nodes_num();
+  free_unused_nodes_calls_num_++;
+  node_last_drawn_.resize(nodes_num, 0);
+  index_mask::masked_fill(
+      node_last_drawn_.as_mutable_span(), free_unused_nodes_calls_num_, drawn_nodes);
+
+  /* Vertex buffers make up most of the GPU memory, index buffers are not counted. */
+  Array<int64_t> node_memory(nodes_num, 0);
+  for (const AttributeData &data : attribute_vbos_.values()) {
+    const Span<gpu::VertBufPtr> vbos = data.vbos.as_span().take_front(
+        std::min<int64_t>(data.vbos.size(), nodes_num));
+    threading::parallel_for(vbos.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        if (vbos[i]) {
+          node_memory[i] += int64_t(vbos[i]->size_used_get());
+        }
+      }
+    });
+  }
+  int64_t memory = 0;
+  for (const int64_t size : node_memory) {
+    memory += size;
+  }
+  if (memory <= memory_limit) {
+    return;
+  }
+  exceeds_memory_limit_ = true;
+
+  /* Free the least recently drawn nodes until there is some margin below the limit, to avoid
+   * freeing nodes on every redraw. */
+  IndexMaskMemory mask_memory;
+  const IndexMask nodes_to_consider = IndexMask::from_predicate(
+      IndexRange(nodes_num), GrainSize(4096), mask_memory, [&](const int i) {
+        return node_memory[i] > 0 && node_last_drawn_[i] != free_unused_nodes_calls_num_;
+      });
+  Array<int> sorted_nodes(nodes_to_consider.size());
+  nodes_to_consider.to_indices(sorted_nodes.as_mutable_span());
+  std::stable_sort(sorted_nodes.begin(), sorted_nodes.end(), [&](const int a, const int b) {
+    return node_last_drawn_[a] < node_last_drawn_[b];
+  });
+
+  const int64_t memory_target = memory_limit / 4 * 3;
+  Vector<int> nodes_to_free;
+  for (const int i : sorted_nodes) {
+    if (memory <= memory_target) {
+      break;
+    }
+    memory -= node_memory[i];
+    nodes_to_free.append(i);
+  }
+  std::sort(nodes_to_free.begin(), nodes_to_free.end());
+  this->free_nodes(IndexMask::from_indices(nodes_to_free.as_span(), mask_memory));
+}
+
 Span<int> DrawCacheImpl::ensure_material_indices(const Object &object)
 {
   const bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(object);
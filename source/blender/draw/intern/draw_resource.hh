@@ -69,7 +69,9 @@ inline void ObjectInfos::sync()
   flag = eObjectInfoFlag::OBJECT_NO_INFO;
 }
 
-inline void ObjectInfos::sync(const blender::draw::ObjectRef ref, bool is_active_object)
+inline void ObjectInfos::sync(const blender::draw::ObjectRef ref,
+                              bool is_active_object,
+                              bool sync_texture_space)
 {
   object_attrs_len = 0;
   object_attrs_offset = 0;
@@ -119,6 +121,10 @@ inline void ObjectInfos::sync(const blender::draw::ObjectRef ref, bool is_active
     random = ref.dupli_object->random_id * (1.0f / (float)0xFFFFFFFF);
   }
 
+  if (!sync_texture_space) {
+    return;
+  }
+
   if (ref.object->data == nullptr) {
     orco_add = float3(0.0f);
     orco_mul = float3(1.0f);
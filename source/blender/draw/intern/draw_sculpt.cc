@@ -22,6 +22,8 @@
 
 #include "BLI_math_matrix.hh"
 
+#include "GPU_capabilities.hh"
+
 #include "bmesh_class.hh"
 
 #include "DRW_pbvh.hh"
@@ -46,6 +48,26 @@ float3 SculptBatch::debug_color()
   return colors[debug_index % 9];
 }
 
+/**
+ * Maximum size of the GPU data of a single sculpt object. Half of the GPU memory leaves space for
+ * other data, the rest of the scene and the draw engines.
+ */
+static int64_t sculpt_gpu_memory_limit()
+{
+  static const int64_t limit = []() -> int64_t {
+    if (!GPU_mem_stats_supported()) {
+      return std::numeric_limits<int64_t>::max();
+    }
+    int total_mem_kb, free_mem_kb;
+    GPU_mem_stats_get(&total_mem_kb, &free_mem_kb);
+    if (total_mem_kb <= 0) {
+      return std::numeric_limits<int64_t>::max();
+    }
+    return int64_t(total_mem_kb) * 1024 / 2;
+  }();
+  return limit;
+}
+
 static Vector<SculptBatch> sculpt_batches_get_ex(const Object *ob,
                                                  const bool use_wire,
                                                  const Span<pbvh::AttributeRequest> attrs)
@@ -95,6 +117,11 @@ static Vector<SculptBatch> sculpt_batches_get_ex(const Object *ob,
 
   pbvh::DrawCache &draw_data = pbvh::ensure_draw_data(pbvh->draw_data);
 
+  /* When the GPU data of the whole mesh doesn't fit in memory, only build it for visible nodes. */
+  if (draw_data.exceeds_memory_limit()) {
+    update_only_visible = true;
+  }
+
   IndexMaskMemory memory;
   const IndexMask visible_nodes = bke::pbvh::search_nodes(
       *pbvh, memory, [&](const bke::pbvh::Node &node) {
@@ -113,6 +140,8 @@ static Vector<SculptBatch> sculpt_batches_get_ex(const Object *ob,
     batches = draw_data.ensure_tris_batches(*ob, {attrs, fast_mode}, nodes_to_update);
   }
 
+  draw_data.free_unused_nodes(*ob, visible_nodes, sculpt_gpu_memory_limit());
+
   const Span<int> material_indices = draw_data.ensure_material_indices(*ob);
 
   const int max_material = BKE_object_material_count_eval(ob);
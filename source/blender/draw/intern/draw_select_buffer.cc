@@ -16,6 +16,7 @@
 #include "BLI_array_utils.h"
 #include "BLI_bitmap.h"
 #include "BLI_bitmap_draw_2d.h"
+#include "BLI_math_base.h"
 #include "BLI_math_matrix.h"
 #include "BLI_rect.h"
 
@@ -23,6 +24,8 @@
 #include "DNA_screen_types.h"
 #include "DNA_view3d_types.h"
 
+#include "BKE_editmesh.hh"
+
 #include "GPU_framebuffer.hh"
 #include "GPU_select.hh"
 
@@ -33,16 +36,60 @@
 #include "DRW_render.hh"
 #include "DRW_select_buffer.hh"
 
+#include "ED_view3d.hh"
+
 #include "../engines/select/select_engine.hh"
 
 using blender::int2;
 using blender::Span;
 
-bool SELECTID_Context::is_dirty(Depsgraph *depsgraph, RegionView3D *rv3d)
+SELECTID_Context::ViewSettings SELECTID_Context::ViewSettings::from_view(const ARegion &region,
+                                                                        const View3D &v3d)
+{
+  ViewSettings settings;
+  settings.size = int2(region.winx, region.winy);
+  settings.use_xray = XRAY_ENABLED(&v3d);
+  settings.use_xray_flag = XRAY_FLAG_ENABLED(&v3d);
+  settings.show_face_dots = (v3d.overlay.edit_flag & V3D_OVERLAY_EDIT_FACE_DOT) != 0;
+  settings.retopology_offset = RETOPOLOGY_OFFSET(&v3d);
+  return settings;
+}
+
+/**
+ * Edit-mesh topology can change before the evaluated object is updated, the element ranges of
+ * the frame-buffer would then not match the #BMesh anymore.
+ */
+static bool select_id_elem_len_changed(Object *obj_eval,
+                                       const ElemIndexRanges &ranges,
+                                       const short select_mode)
 {
+  const BMEditMesh *em = BKE_editmesh_from_object(obj_eval);
+  if (em == nullptr) {
+    return false;
+  }
+  return ((select_mode & SCE_SELECT_FACE) && ranges.face.size() != em->bm->totface) ||
+         ((select_mode & SCE_SELECT_EDGE) && ranges.edge.size() != em->bm->totedge) ||
+         ((select_mode & SCE_SELECT_VERTEX) && ranges.vert.size() != em->bm->totvert);
+}
+
+bool SELECTID_Context::is_dirty(Depsgraph *depsgraph, const ARegion *region, const View3D *v3d)
+{
+  const RegionView3D *rv3d = static_cast<const RegionView3D *>(region->regiondata);
   uint64_t last_update = this->depsgraph_last_update;
   this->depsgraph_last_update = DEG_get_update_count(depsgraph);
 
+  if (this->view_settings != ViewSettings::from_view(*region, *v3d)) {
+    return true;
+  }
+  /* Clipping planes are not tracked, they are rarely used. */
+  if (RV3D_CLIPPING_ENABLED(v3d, rv3d)) {
+    return true;
+  }
+  /* Every visible object occludes the selectable ones. */
+  if (RETOPOLOGY_ENABLED(v3d) && !XRAY_ENABLED(v3d) && this->depsgraph_last_update != last_update)
+  {
+    return true;
+  }
   /* Check if the viewport has changed.
    * This can happen when triggering the selection operator *while* playing back animation and
    * looking through an animated camera. */
@@ -53,9 +100,17 @@ bool SELECTID_Context::is_dirty(Depsgraph *depsgraph, RegionView3D *rv3d)
    * This can happen when triggering the selection operator *while* playing back animation on an
    * edited mesh. */
   for (Object *obj_eval : this->objects) {
-    if (obj_eval->runtime->last_update_transform > last_update) {
+    if (obj_eval->runtime->last_update_transform > last_update ||
+        obj_eval->runtime->last_update_geometry > last_update ||
+        obj_eval->runtime->last_update_shading > last_update)
+    {
       return true;
     }
+    if (const ElemIndexRanges *ranges = this->elem_ranges.lookup_ptr(obj_eval)) {
+      if (select_id_elem_len_changed(obj_eval, *ranges, this->select_mode)) {
+        return true;
+      }
+    }
   }
   return false;
 }
@@ -82,11 +137,10 @@ uint *DRW_select_buffer_read(
   rcti rect_clamp = *rect;
   if (BLI_rcti_isect(&r, &rect_clamp, &rect_clamp)) {
     SELECTID_Context *select_ctx = DRW_select_engine_context_get();
-    RegionView3D *rv3d = static_cast<RegionView3D *>(region->regiondata);
 
     DRW_gpu_context_enable();
 
-    if (select_ctx->is_dirty(depsgraph, rv3d)) {
+    if (select_ctx->is_dirty(depsgraph, region, v3d)) {
       /* Update drawing. */
       DRW_draw_select_id(depsgraph, region, v3d);
     }
@@ -468,13 +522,21 @@ void DRW_select_buffer_context_create(Depsgraph *depsgraph,
 {
   SELECTID_Context *select_ctx = DRW_select_engine_context_get();
 
-  select_ctx->objects.reinitialize(bases.size());
-
+  blender::Vector<Object *> objects(bases.size());
   for (const int i : bases.index_range()) {
     Object *obj = bases[i]->object;
-    select_ctx->objects[i] = DEG_get_evaluated(depsgraph, obj);
+    objects[i] = DEG_get_evaluated(depsgraph, obj);
+  }
+
+  /* Reuse the frame-buffer drawn by the previous selection (e.g. for consecutive box selections),
+   * #SELECTID_Context::is_dirty takes care of detecting changes. */
+  if (select_mode != -1 && select_mode == select_ctx->select_mode &&
+      objects == select_ctx->objects)
+  {
+    return;
   }
 
+  select_ctx->objects = std::move(objects);
   select_ctx->select_mode = select_mode;
   select_ctx->persmat = blender::float4x4::zero();
 }
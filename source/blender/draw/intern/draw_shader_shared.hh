@@ -172,7 +172,13 @@ struct ObjectInfos {
 
 #if !defined(GPU_SHADER) && defined(__cplusplus)
   void sync();
-  void sync(const blender::draw::ObjectRef ref, bool is_active_object);
+  /**
+   * \param sync_texture_space: When false, #orco_add and #orco_mul are left untouched and have to
+   * be set by the caller.
+   */
+  void sync(const blender::draw::ObjectRef ref,
+            bool is_active_object,
+            bool sync_texture_space = true);
 #endif
 };
 BLI_STATIC_ASSERT_ALIGN(ObjectInfos, 16)
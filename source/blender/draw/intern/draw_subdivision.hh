@@ -23,6 +23,7 @@ struct Mesh;
 struct Object;
 namespace blender::bke::subdiv {
 struct Subdiv;
+struct ToMeshSettings;
 }
 struct ToolSettings;
 
@@ -169,6 +170,14 @@ void DRW_subdivide_loose_geom(DRWSubdivCache &subdiv_cache, const MeshBufferCach
 
 void DRW_subdiv_cache_free(bke::subdiv::Subdiv *subdiv);
 
+/**
+ * Create the subdivided mesh with the GPU evaluator, sharing the evaluator cache used for drawing.
+ * Requires an active GPU context, returns null when the mesh can't be evaluated on the GPU.
+ */
+Mesh *DRW_subdiv_to_mesh_gpu(bke::subdiv::Subdiv *subdiv,
+                             const bke::subdiv::ToMeshSettings *settings,
+                             const Mesh *coarse_mesh);
+
 gpu::VertBufPtr draw_subdiv_init_origindex_buffer(int32_t *vert_origindex,
                                                   uint num_loops,
                                                   uint loose_len);
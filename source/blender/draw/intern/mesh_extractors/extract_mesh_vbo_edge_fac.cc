@@ -7,9 +7,12 @@
  */
 
 #include "BLI_math_vector.hh"
+#include "BLI_task.hh"
 
 #include "GPU_capabilities.hh"
 
+#include "atomic_ops.h"
+
 #include "draw_subdivision.hh"
 #include "extract_mesh.hh"
 
@@ -48,49 +51,48 @@ static void extract_edge_factor_mesh(const MeshRenderData &mr, MutableSpan<float
   const Span<float3> face_normals = mr.face_normals;
   const BitSpan optimal_display_edges = mr.mesh->runtime->subsurf_optimal_display_edges;
 
-  Array<int8_t> edge_face_count(mr.edges_num, 0);
-  Array<MEdgeDataPrev> edge_data(mr.edges_num);
-
-  for (const int face : faces.index_range()) {
-    for (const int corner : faces[face]) {
-      const int edge = corner_edges[corner];
-      if (!optimal_display_edges.is_empty() && !optimal_display_edges[edge]) {
-        vbo_data[corner] = 1.0f;
-        continue;
+  auto is_edge_hidden = [&](const int edge) {
+    return !optimal_display_edges.is_empty() && !optimal_display_edges[edge];
+  };
+
+  /* Gather the first two faces of every edge, the factor is only computed for manifold edges.
+   * The order in which faces are added doesn't matter, so this can be done in parallel. */
+  Array<int> edge_face_count(mr.edges_num, 0);
+  Array<int2> edge_faces(mr.edges_num);
+  threading::parallel_for(faces.index_range(), 2048, [&](const IndexRange range) {
+    for (const int face : range) {
+      for (const int corner : faces[face]) {
+        const int edge = corner_edges[corner];
+        if (is_edge_hidden(edge)) {
+          continue;
+        }
+        const int face_count = atomic_fetch_and_add_int32(&edge_face_count[edge], 1);
+        if (face_count < 2) {
+          edge_faces[edge][face_count] = face;
+        }
       }
+    }
+  });
 
-      MEdgeDataPrev *medata = &edge_data[edge];
-
-      const int8_t face_count = edge_face_count[edge];
-      vbo_data[corner] = 0;
-      if (face_count < 4) {
-        if (face_count == 0) {
-          /* Prepare to calculate the factor. */
-          medata->corner_a = corner;
-          medata->data = face;
+  threading::parallel_for(faces.index_range(), 2048, [&](const IndexRange range) {
+    for (const int face : range) {
+      for (const int corner : faces[face]) {
+        const int edge = corner_edges[corner];
+        if (is_edge_hidden(edge)) {
+          vbo_data[corner] = 1.0f;
         }
-        else if (face_count == 1) {
-          /* Calculate the factor for both corners. */
-          const int other_face = medata->data;
-          const float factor = edge_factor_calc(face_normals[other_face], face_normals[face]);
-          vbo_data[medata->corner_a] = factor;
-          vbo_data[corner] = factor;
-
-          /* If the count still changes, use this `data` member to inform the corner. */
-          medata->data = corner;
+        else if (edge_face_count[edge] == 2) {
+          const int2 &edge_face = edge_faces[edge];
+          const int other_face = (edge_face[0] == face) ? edge_face[1] : edge_face[0];
+          vbo_data[corner] = edge_factor_calc(face_normals[other_face], face_normals[face]);
         }
         else {
-          /* Non-manifold edge. Always visible. */
-          const int corner_a = medata->corner_a;
-          const int corner_b = medata->data;
-          vbo_data[corner_a] = 0;
-          vbo_data[corner_b] = 0;
+          /* Boundary or non-manifold edge. Always visible. */
+          vbo_data[corner] = 0.0f;
         }
-
-        edge_face_count[edge]++;
       }
     }
-  }
+  });
 }
 
 static void extract_edge_factor_bm(const MeshRenderData &mr, MutableSpan<float> vbo_data)
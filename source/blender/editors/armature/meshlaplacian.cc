@@ -12,6 +12,8 @@
 #include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
 
+#include "BLI_array.hh"
+#include "BLI_enumerable_thread_specific.hh"
 #include "BLI_map.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
@@ -20,6 +22,8 @@
 #include "BLI_memarena.h"
 #include "BLI_ordered_edge.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
+#include "BLI_vector.hh"
 
 #include "BLT_translation.hh"
 
@@ -38,6 +42,7 @@
 #include "meshlaplacian.h"
 
 #include <algorithm>
+#include <atomic>
 
 /* ************* XXX *************** */
 static void waitcursor(int /*val*/) {}
@@ -900,7 +905,6 @@ struct MeshDeformBind {
   MDefBoundIsect *(*boundisect)[6];
   int *semibound;
   int *tag;
-  float *phi, *totalphi;
 
   /* mesh stuff */
   int *inside;
@@ -1231,6 +1235,7 @@ static float meshdeform_boundary_phi(const MeshDeformBind *mdb,
 }
 
 static float meshdeform_interp_w(MeshDeformBind *mdb,
+                                 const float *phi,
                                  const float *gridvec,
                                  float * /*vec*/,
                                  int /*cagevert*/)
@@ -1280,7 +1285,7 @@ static float meshdeform_interp_w(MeshDeformBind *mdb,
 
     int a = meshdeform_index(mdb, x, y, z, 0);
     float weight = wx * wy * wz;
-    result += weight * mdb->phi[a];
+    result += weight * phi[a];
     totweight += weight;
   }
 
@@ -1366,7 +1371,7 @@ static void meshdeform_matrix_add_cell(
 }
 
 static void meshdeform_matrix_add_rhs(
-    MeshDeformBind *mdb, LinearSolver *context, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, double *rhs_vector, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1389,13 +1394,13 @@ static void meshdeform_matrix_add_rhs(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      EIG_linear_solver_right_hand_side_add(context, 0, mdb->varidx[acenter], rhs);
+      rhs_vector[mdb->varidx[acenter]] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_semibound_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int cagevert)
+    MeshDeformBind *mdb, float *phi, int x, int y, int z, int cagevert)
 {
   MDefBoundIsect *isect;
   float rhs, weight, totweight;
@@ -1406,7 +1411,7 @@ static void meshdeform_matrix_add_semibound_phi(
     return;
   }
 
-  mdb->phi[a] = 0.0f;
+  phi[a] = 0.0f;
 
   totweight = meshdeform_boundary_total_weight(mdb, x, y, z);
   for (i = 1; i <= 6; i++) {
@@ -1415,15 +1420,15 @@ static void meshdeform_matrix_add_semibound_phi(
     if (isect) {
       weight = (1.0f / isect->len) / totweight;
       rhs = weight * meshdeform_boundary_phi(mdb, isect, cagevert);
-      mdb->phi[a] += rhs;
+      phi[a] += rhs;
     }
   }
 }
 
 static void meshdeform_matrix_add_exterior_phi(
-    MeshDeformBind *mdb, int x, int y, int z, int /*cagevert*/)
+    MeshDeformBind *mdb, float *phi, int x, int y, int z, int /*cagevert*/)
 {
-  float phi, totweight;
+  float phi_sum, totweight;
   int i, a, acenter;
 
   acenter = meshdeform_index(mdb, x, y, z, 0);
@@ -1431,27 +1436,110 @@ static void meshdeform_matrix_add_exterior_phi(
     return;
   }
 
-  phi = 0.0f;
+  phi_sum = 0.0f;
   totweight = 0.0f;
   for (i = 1; i <= 6; i++) {
     a = meshdeform_index(mdb, x, y, z, i);
 
     if (a != -1 && mdb->semibound[a]) {
-      phi += mdb->phi[a];
+      phi_sum += phi[a];
       totweight += 1.0f;
     }
   }
 
   if (totweight != 0.0f) {
-    mdb->phi[acenter] = phi / totweight;
+    phi[acenter] = phi_sum / totweight;
   }
 }
 
+/** Scratch buffers for solving the weights of one cage vertex at a time. */
+struct MeshDeformSolveData {
+  blender::Array<double> rhs;
+  blender::Array<double> x;
+  blender::Array<float> phi;
+};
+
+/**
+ * Solve the weights of a single cage vertex. Only the right hand side depends on the cage
+ * vertex, so this only reads the factorized solver and can run in parallel.
+ */
+static bool meshdeform_solve_cage_vert(MeshDeformBind *mdb,
+                                       const LinearSolver *context,
+                                       MeshDeformSolveData &data,
+                                       blender::Vector<std::pair<int, float>> &r_influences,
+                                       const int cagevert)
+{
+  float vec[3], gridvec[3];
+  int b, x, y, z;
+
+  /* fill in right hand side and solve */
+  data.rhs.fill(0.0);
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_rhs(mdb, data.rhs.data(), x, y, z, cagevert);
+      }
+    }
+  }
+
+  if (!EIG_linear_solver_solve_vector(context, data.rhs.data(), data.x.data())) {
+    return false;
+  }
+
+  float *phi = data.phi.data();
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_semibound_phi(mdb, phi, x, y, z, cagevert);
+      }
+    }
+  }
+
+  for (z = 0; z < mdb->size; z++) {
+    for (y = 0; y < mdb->size; y++) {
+      for (x = 0; x < mdb->size; x++) {
+        meshdeform_matrix_add_exterior_phi(mdb, phi, x, y, z, cagevert);
+      }
+    }
+  }
+
+  for (b = 0; b < mdb->size3; b++) {
+    if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
+      phi[b] = data.x[mdb->varidx[b]];
+    }
+  }
+
+  if (mdb->weights) {
+    /* static bind : compute weights for each vertex */
+    for (b = 0; b < mdb->verts_num; b++) {
+      if (mdb->inside[b]) {
+        copy_v3_v3(vec, mdb->vertexcos[b]);
+        gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
+        gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
+        gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
+
+        mdb->weights[b * mdb->cage_verts_num + cagevert] = meshdeform_interp_w(
+            mdb, phi, gridvec, vec, cagevert);
+      }
+    }
+  }
+  else {
+    /* dynamic bind, linked into the grid afterwards to keep a deterministic order */
+    for (b = 0; b < mdb->size3; b++) {
+      if (phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
+        r_influences.append({b, phi[b]});
+      }
+    }
+  }
+
+  return true;
+}
+
 static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind *mdb)
 {
+  using namespace blender;
   LinearSolver *context;
-  float vec[3], gridvec[3];
-  int a, b, x, y, z, totvar;
+  int a, x, y, z, totvar;
   char message[256];
 
   /* setup variable indices */
@@ -1479,95 +1567,56 @@ static void meshdeform_matrix_solve(MeshDeformModifierData *mmd, MeshDeformBind
     }
   }
 
-  /* solve for each cage vert */
-  for (a = 0; a < mdb->cage_verts_num; a++) {
-    /* fill in right hand side and solve */
-    for (z = 0; z < mdb->size; z++) {
-      for (y = 0; y < mdb->size; y++) {
-        for (x = 0; x < mdb->size; x++) {
-          meshdeform_matrix_add_rhs(mdb, context, x, y, z, a);
-        }
-      }
-    }
-
-    if (EIG_linear_solver_solve(context)) {
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_semibound_phi(mdb, x, y, z, a);
-          }
-        }
-      }
-
-      for (z = 0; z < mdb->size; z++) {
-        for (y = 0; y < mdb->size; y++) {
-          for (x = 0; x < mdb->size; x++) {
-            meshdeform_matrix_add_exterior_phi(mdb, x, y, z, a);
-          }
+  /* The matrix is the same for every cage vertex, factorize it once and solve for the cage
+   * vertices in parallel, in blocks to report progress. */
+  bool success = EIG_linear_solver_factorize(context);
+
+  Array<Vector<std::pair<int, float>>> influences(mdb->cage_verts_num);
+  threading::EnumerableThreadSpecific<MeshDeformSolveData> solve_data([&]() {
+    MeshDeformSolveData data;
+    data.rhs.reinitialize(totvar);
+    data.x.reinitialize(totvar);
+    data.phi = Array<float>(mdb->size3, 0.0f);
+    return data;
+  });
+
+  const int block_size = 64;
+  for (a = 0; success && a < mdb->cage_verts_num; a += block_size) {
+    const IndexRange block = IndexRange::from_begin_end(
+        a, std::min(a + block_size, mdb->cage_verts_num));
+    std::atomic<bool> block_success = true;
+    threading::parallel_for(block, 1, [&](const IndexRange range) {
+      MeshDeformSolveData &data = solve_data.local();
+      for (const int cagevert : range) {
+        if (!meshdeform_solve_cage_vert(mdb, context, data, influences[cagevert], cagevert)) {
+          block_success = false;
         }
       }
-
-      for (b = 0; b < mdb->size3; b++) {
-        if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
-          mdb->phi[b] = EIG_linear_solver_variable_get(context, 0, mdb->varidx[b]);
-        }
-        mdb->totalphi[b] += mdb->phi[b];
+    });
+    success = block_success;
+
+    const int solved_num = int(block.one_after_last());
+    SNPRINTF(message, "Mesh deform solve %d / %d       |||", solved_num, mdb->cage_verts_num);
+    progress_bar(float(solved_num) / float(mdb->cage_verts_num), message);
+  }
+
+  if (success) {
+    for (a = 0; a < mdb->cage_verts_num; a++) {
+      for (const std::pair<int, float> &influence : influences[a]) {
+        MDefBindInfluence *inf = static_cast<MDefBindInfluence *>(
+            BLI_memarena_alloc(mdb->memarena, sizeof(*inf)));
+        inf->vertex = a;
+        inf->weight = influence.second;
+        inf->next = mdb->dyngrid[influence.first];
+        mdb->dyngrid[influence.first] = inf;
       }
-
-      if (mdb->weights) {
-        /* static bind : compute weights for each vertex */
-        for (b = 0; b < mdb->verts_num; b++) {
-          if (mdb->inside[b]) {
-            copy_v3_v3(vec, mdb->vertexcos[b]);
-            gridvec[0] = (vec[0] - mdb->min[0] - mdb->halfwidth[0]) / mdb->width[0];
-            gridvec[1] = (vec[1] - mdb->min[1] - mdb->halfwidth[1]) / mdb->width[1];
-            gridvec[2] = (vec[2] - mdb->min[2] - mdb->halfwidth[2]) / mdb->width[2];
-
-            mdb->weights[b * mdb->cage_verts_num + a] = meshdeform_interp_w(mdb, gridvec, vec, a);
-          }
-        }
-      }
-      else {
-        MDefBindInfluence *inf;
-
-        /* dynamic bind */
-        for (b = 0; b < mdb->size3; b++) {
-          if (mdb->phi[b] >= MESHDEFORM_MIN_INFLUENCE) {
-            inf = static_cast<MDefBindInfluence *>(
-                BLI_memarena_alloc(mdb->memarena, sizeof(*inf)));
-            inf->vertex = a;
-            inf->weight = mdb->phi[b];
-            inf->next = mdb->dyngrid[b];
-            mdb->dyngrid[b] = inf;
-          }
-        }
-      }
-    }
-    else {
-      BKE_modifier_set_error(
-          mmd->object, &mmd->modifier, "Failed to find bind solution (increase precision?)");
-      error("Mesh Deform: failed to find bind solution.");
-      break;
     }
-
-    SNPRINTF(message, "Mesh deform solve %d / %d       |||", a + 1, mdb->cage_verts_num);
-    progress_bar(float(a + 1) / float(mdb->cage_verts_num), message);
   }
-
-#if 0
-  /* sanity check */
-  for (b = 0; b < mdb->size3; b++) {
-    if (mdb->tag[b] != MESHDEFORM_TAG_EXTERIOR) {
-      if (fabsf(mdb->totalphi[b] - 1.0f) > 1e-4f) {
-        printf("totalphi deficiency [%s|%d] %d: %.10f\n",
-               (mdb->tag[b] == MESHDEFORM_TAG_INTERIOR) ? "interior" : "boundary",
-               mdb->semibound[b],
-               mdb->varidx[b],
-               mdb->totalphi[b]);
-      }
-    }
+  else {
+    BKE_modifier_set_error(
+        mmd->object, &mmd->modifier, "Failed to find bind solution (increase precision?)");
+    error("Mesh Deform: failed to find bind solution.");
   }
-#endif
 
   /* free */
   MEM_freeN(mdb->varidx);
@@ -1594,8 +1643,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   mdb->size = (2 << (mmd->gridsize - 1)) + 2;
   mdb->size3 = mdb->size * mdb->size * mdb->size;
   mdb->tag = MEM_calloc_arrayN<int>(mdb->size3, "MeshDeformBindTag");
-  mdb->phi = MEM_calloc_arrayN<float>(mdb->size3, "MeshDeformBindPhi");
-  mdb->totalphi = MEM_calloc_arrayN<float>(mdb->size3, "MeshDeformBindTotalPhi");
   mdb->boundisect = static_cast<MDefBoundIsect *(*)[6]>(
       MEM_callocN(sizeof(*mdb->boundisect) * mdb->size3, "MDefBoundIsect"));
   mdb->semibound = MEM_calloc_arrayN<int>(mdb->size3, "MDefSemiBound");
@@ -1735,8 +1782,6 @@ static void harmonic_coordinates_bind(MeshDeformModifierData *mmd, MeshDeformBin
   }
 
   MEM_freeN(mdb->tag);
-  MEM_freeN(mdb->phi);
-  MEM_freeN(mdb->totalphi);
   MEM_freeN(mdb->boundisect);
   MEM_freeN(mdb->semibound);
   BLI_memarena_free(mdb->memarena);
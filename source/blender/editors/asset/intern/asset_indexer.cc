@@ -6,10 +6,12 @@
  * \ingroup edasset
  */
 
+#include <algorithm>
 #include <ctime>
 #include <fstream>
 #include <iomanip>
 #include <optional>
+#include <random>
 
 #include "ED_asset_indexer.hh"
 
@@ -77,6 +79,9 @@ using namespace blender::bke::idprop;
  * #ID.name.
  * NOTE: File browser group name isn't stored in the index as it is a translatable name.
  */
+/** Directory inside an asset library that contains indices shared by all users of the library. */
+constexpr StringRefNull SHARED_INDEX_DIRNAME(".blender_asset_index");
+
 constexpr StringRef ATTRIBUTE_VERSION("version");
 constexpr StringRef ATTRIBUTE_ENTRIES("entries");
 constexpr StringRef ATTRIBUTE_ENTRIES_NAME("name");
@@ -307,9 +312,18 @@ struct AssetLibraryIndex {
 
   std::string library_path;
 
+  /**
+   * \brief Absolute path where indices are shared with other users of the library, or empty when
+   * the library doesn't provide a shared index directory.
+   *
+   * \note includes trailing directory separator.
+   */
+  std::string shared_indices_base_path;
+
   AssetLibraryIndex(const StringRef library_path) : library_path(library_path)
   {
     this->init_indices_base_path();
+    this->init_shared_indices_base_path();
   }
 
   uint64_t hash() const
@@ -341,6 +355,25 @@ struct AssetLibraryIndex {
     this->indices_base_path = std::string(index_path);
   }
 
+  /**
+   * \brief Initializes #AssetLibraryIndex.shared_indices_base_path.
+   *
+   * Libraries opt into sharing their indices by containing a `.blender_asset_index` directory.
+   * Indices written there are picked up by everyone that uses the library, so only the first
+   * user has to open a changed asset file.
+   */
+  void init_shared_indices_base_path()
+  {
+    char index_path[FILE_MAX];
+    BLI_path_join(
+        index_path, sizeof(index_path), this->library_path.c_str(), SHARED_INDEX_DIRNAME.c_str());
+    if (!BLI_is_dir(index_path)) {
+      return;
+    }
+    BLI_path_slash_ensure(index_path, sizeof(index_path));
+    this->shared_indices_base_path = std::string(index_path);
+  }
+
   /**
    * \return absolute path to the index file of the given `asset_file`.
    *
@@ -355,6 +388,32 @@ struct AssetLibraryIndex {
     return ss.str();
   }
 
+  /**
+   * \return absolute path to the shared index file of the given `asset_file`, or an empty string
+   * when there is no shared index directory.
+   *
+   * `{shared_indices_base_path}/{relative-path_hash}_{asset-file-filename}.index.json`. The path
+   * relative to the library is hashed, so that the name doesn't depend on where the library is
+   * mounted.
+   */
+  std::string shared_index_file_path(const BlendFile &asset_file) const
+  {
+    if (this->shared_indices_base_path.empty() ||
+        !BLI_path_contains(this->library_path.c_str(), asset_file.get_file_path()))
+    {
+      return "";
+    }
+    std::string relative_path = asset_file.get_file_path() + this->library_path.size();
+    std::replace(relative_path.begin(), relative_path.end(), '\\', '/');
+    const StringRef relative_path_ref = StringRef(relative_path).trim('/');
+
+    std::stringstream ss;
+    ss << this->shared_indices_base_path;
+    ss << std::setfill('0') << std::setw(16) << std::hex << get_default_hash(relative_path_ref)
+       << "_" << asset_file.get_filename() << ".index.json";
+    return ss.str();
+  }
+
   /**
    * Check for pre-existing index files to be able to track what is still used and what can be
    * removed. See #AssetLibraryIndex::preexisting_file_indices.
@@ -593,6 +652,31 @@ class AssetIndexFile : public AbstractFile {
     formatter.serialize(os, *content.contents);
     os.close();
   }
+
+  /**
+   * Write the contents to a temporary file first and move it in place afterwards. Used for shared
+   * indices, which can be read by other instances while they are being written.
+   *
+   * \return true when the index file has been replaced.
+   */
+  bool write_contents_atomic(AssetIndex &content)
+  {
+    std::stringstream ss;
+    ss << this->filename << "." << std::hex << std::random_device()() << ".tmp";
+    const std::string temp_filename = ss.str();
+
+    JsonFormatter formatter;
+    std::ofstream os;
+    os.open(temp_filename, std::ios::out | std::ios::trunc);
+    formatter.serialize(os, *content.contents);
+    os.close();
+
+    if (os.fail() || BLI_rename_overwrite(temp_filename.c_str(), this->get_file_path()) != 0) {
+      BLI_delete(temp_filename.c_str(), false, false);
+      return false;
+    }
+    return true;
+  }
 };
 
 /* TODO(Julian): remove this after a short while. Just necessary for people who've been using alpha
@@ -644,12 +728,11 @@ int AssetLibraryIndex::remove_broken_index_files()
   return num_files_deleted;
 }
 
-static eFileIndexerResult read_index(const char *filename,
-                                     FileIndexerEntries *entries,
-                                     int *r_read_entries_len,
-                                     void *user_data)
+static eFileIndexerResult read_local_index(AssetLibraryIndex &library_index,
+                                           const char *filename,
+                                           FileIndexerEntries *entries,
+                                           int *r_read_entries_len)
 {
-  AssetLibraryIndex &library_index = *static_cast<AssetLibraryIndex *>(user_data);
   BlendFile asset_file(filename);
   AssetIndexFile asset_index_file(library_index, asset_file);
 
@@ -705,6 +788,58 @@ static eFileIndexerResult read_index(const char *filename,
   return FILE_INDEXER_ENTRIES_LOADED;
 }
 
+/**
+ * Read the index from the shared index directory of the library, when it's up to date. The
+ * contents are copied to the local index, so the next read doesn't need the shared index.
+ */
+static bool read_shared_index(AssetLibraryIndex &library_index,
+                              const char *filename,
+                              FileIndexerEntries *entries,
+                              int *r_read_entries_len)
+{
+  BlendFile asset_file(filename);
+  const std::string shared_index_path = library_index.shared_index_file_path(asset_file);
+  if (shared_index_path.empty()) {
+    return false;
+  }
+  AssetIndexFile shared_index_file(library_index, shared_index_path);
+  if (!shared_index_file.exists() || shared_index_file.is_older_than(asset_file)) {
+    return false;
+  }
+
+  std::unique_ptr<AssetIndex> contents = shared_index_file.read_contents();
+  if (!contents || !contents->is_latest_version()) {
+    CLOG_INFO(&LOG, 3, "Shared asset index is ignored [%s].", shared_index_path.c_str());
+    return false;
+  }
+
+  AssetIndexFile asset_index_file(library_index, asset_file);
+  asset_index_file.mark_as_used();
+  asset_index_file.write_contents(*contents);
+
+  const int read_entries_len = contents->extract_into(*entries);
+  CLOG_INFO(
+      &LOG, 1, "Read %d entries from shared asset index for [%s].", read_entries_len, filename);
+  *r_read_entries_len = read_entries_len;
+  return true;
+}
+
+static eFileIndexerResult read_index(const char *filename,
+                                     FileIndexerEntries *entries,
+                                     int *r_read_entries_len,
+                                     void *user_data)
+{
+  AssetLibraryIndex &library_index = *static_cast<AssetLibraryIndex *>(user_data);
+  const eFileIndexerResult result = read_local_index(
+      library_index, filename, entries, r_read_entries_len);
+  if (result == FILE_INDEXER_NEEDS_UPDATE &&
+      read_shared_index(library_index, filename, entries, r_read_entries_len))
+  {
+    return FILE_INDEXER_ENTRIES_LOADED;
+  }
+  return result;
+}
+
 static void update_index(const char *filename, FileIndexerEntries *entries, void *user_data)
 {
   AssetLibraryIndex &library_index = *static_cast<AssetLibraryIndex *>(user_data);
@@ -718,6 +853,14 @@ static void update_index(const char *filename, FileIndexerEntries *entries, void
 
   AssetIndex content(*entries);
   asset_index_file.write_contents(content);
+
+  const std::string shared_index_path = library_index.shared_index_file_path(asset_file);
+  if (!shared_index_path.empty()) {
+    AssetIndexFile shared_index_file(library_index, shared_index_path);
+    if (!shared_index_file.write_contents_atomic(content)) {
+      CLOG_INFO(&LOG, 1, "Couldn't update shared asset index [%s].", shared_index_path.c_str());
+    }
+  }
 }
 
 static void *init_user_data(const char *root_directory, size_t root_directory_maxncpy)
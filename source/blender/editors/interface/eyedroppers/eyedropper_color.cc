@@ -220,7 +220,8 @@ static bool eyedropper_cryptomatte_sample_view3d_fl(bContext *C,
   return true;
 }
 
-static bool eyedropper_cryptomatte_sample_renderlayer_fl(RenderLayer *render_layer,
+static bool eyedropper_cryptomatte_sample_renderlayer_fl(RenderResult *render_result,
+                                                         RenderLayer *render_layer,
                                                          const char *prefix,
                                                          const float fpos[2],
                                                          float r_col[3])
@@ -250,6 +251,8 @@ static bool eyedropper_cryptomatte_sample_renderlayer_fl(RenderLayer *render_lay
     {
       BLI_assert(render_pass->channels == 4);
 
+      RE_pass_ensure_loaded(render_result, render_pass);
+
       /* Pass was allocated but not rendered yet. */
       if (!render_pass->ibuf) {
         return false;
@@ -282,7 +285,8 @@ static bool eyedropper_cryptomatte_sample_render_fl(const bNode *node,
     if (rr) {
       LISTBASE_FOREACH (ViewLayer *, view_layer, &scene->view_layers) {
         RenderLayer *render_layer = RE_GetRenderLayer(rr, view_layer->name);
-        success = eyedropper_cryptomatte_sample_renderlayer_fl(render_layer, prefix, fpos, r_col);
+        success = eyedropper_cryptomatte_sample_renderlayer_fl(
+            rr, render_layer, prefix, fpos, r_col);
         if (success) {
           break;
         }
@@ -308,7 +312,8 @@ static bool eyedropper_cryptomatte_sample_image_fl(const bNode *node,
     ImBuf *ibuf = BKE_image_acquire_ibuf(image, iuser, nullptr);
     if (image->rr) {
       LISTBASE_FOREACH (RenderLayer *, render_layer, &image->rr->layers) {
-        success = eyedropper_cryptomatte_sample_renderlayer_fl(render_layer, prefix, fpos, r_col);
+        success = eyedropper_cryptomatte_sample_renderlayer_fl(
+            image->rr, render_layer, prefix, fpos, r_col);
         if (success) {
           break;
         }
@@ -126,6 +126,7 @@ static wmOperatorStatus wm_alembic_export_exec(bContext *C, wmOperator *op)
   params.quad_method = RNA_enum_get(op->ptr, "quad_method");
   params.ngon_method = RNA_enum_get(op->ptr, "ngon_method");
   params.evaluation_mode = eEvaluationMode(RNA_enum_get(op->ptr, "evaluation_mode"));
+  params.parallel_frames = RNA_int_get(op->ptr, "parallel_frames");
 
   params.global_scale = RNA_float_get(op->ptr, "global_scale");
 
@@ -192,6 +193,7 @@ static void ui_alembic_export_settings(const bContext *C, uiLayout *layout, Poin
 
     col = &panel->column(true);
     col->prop(ptr, "evaluation_mode", UI_ITEM_NONE, std::nullopt, ICON_NONE);
+    col->prop(ptr, "parallel_frames", UI_ITEM_NONE, std::nullopt, ICON_NONE);
   }
 
   /* Object Data */
@@ -470,6 +472,18 @@ void WM_OT_alembic_export(wmOperatorType *ot)
                "Determines visibility of objects, modifier settings, and other areas where there "
                "are different settings for viewport and rendering");
 
+  RNA_def_int(ot->srna,
+              "parallel_frames",
+              1,
+              1,
+              64,
+              "Parallel Frames",
+              "Number of frames evaluated at the same time, each in its own copy of the scene. "
+              "Uses more memory, only gives correct results when frames do not depend on "
+              "previous frames (no simulations), and frame change handlers are not run",
+              1,
+              16);
+
   /* This dummy prop is used to check whether we need to init the start and
    * end frame values to that of the scene's, otherwise they are reset at
    * every change, draw update. */
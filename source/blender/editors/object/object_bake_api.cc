@@ -20,6 +20,7 @@
 #include "RNA_define.hh"
 #include "RNA_enum_types.hh"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_geom.h"
 #include "BLI_path_utils.hh"
@@ -1679,22 +1680,24 @@ static wmOperatorStatus bake(const BakeAPIRender *bkr,
       goto cleanup;
     }
 
-    /* the baking itself */
+    /* The baking itself, all high poly objects are baked together so the scene is only synced
+     * once by the render engine. */
+    Array<Object *> highpoly_objects(highpoly_num);
     for (i = 0; i < highpoly_num; i++) {
-      ok = RE_bake_engine(re,
-                          depsgraph,
-                          highpoly[i].ob_eval,
-                          i,
-                          pixel_array_high,
-                          &targets,
-                          bkr->pass_type,
-                          bkr->pass_filter,
-                          targets.result);
-      if (!ok) {
-        BKE_reportf(
-            reports, RPT_ERROR, "Error baking from object \"%s\"", highpoly[i].ob->id.name + 2);
-        goto cleanup;
-      }
+      highpoly_objects[i] = highpoly[i].ob_eval;
+    }
+    ok = RE_bake_engine(re,
+                        depsgraph,
+                        highpoly_objects.data(),
+                        highpoly_num,
+                        pixel_array_high,
+                        &targets,
+                        bkr->pass_type,
+                        bkr->pass_filter,
+                        targets.result);
+    if (!ok) {
+      BKE_report(reports, RPT_ERROR, "Error baking from selected objects");
+      goto cleanup;
     }
   }
   else {
@@ -1704,8 +1707,8 @@ static wmOperatorStatus bake(const BakeAPIRender *bkr,
     if (RE_bake_has_engine(re)) {
       ok = RE_bake_engine(re,
                           depsgraph,
-                          ob_low_eval,
-                          0,
+                          &ob_low_eval,
+                          1,
                           pixel_array_low,
                           &targets,
                           bkr->pass_type,
@@ -250,7 +250,7 @@ ModifierData *modifier_add(
   BKE_object_modifier_set_active(ob, new_md);
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_tag_relations_update(bmain, &ob->id);
 
   return new_md;
 }
@@ -407,7 +407,7 @@ bool modifier_remove(ReportList *reports, Main *bmain, Scene *scene, Object *ob,
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_tag_relations_update(bmain, &ob->id);
 
   return true;
 }
@@ -430,7 +430,7 @@ void modifiers_clear(Main *bmain, Scene *scene, Object *ob)
   }
 
   DEG_id_tag_update(&ob->id, ID_RECALC_GEOMETRY);
-  DEG_relations_tag_update(bmain);
+  DEG_id_tag_relations_update(bmain, &ob->id);
 }
 
 static bool object_modifier_check_move_before(ReportList *reports,
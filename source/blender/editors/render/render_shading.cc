@@ -1432,6 +1432,7 @@ enum {
   LIGHTCACHE_SUBSET_ALL = 0,
   LIGHTCACHE_SUBSET_SELECTED,
   LIGHTCACHE_SUBSET_ACTIVE,
+  LIGHTCACHE_SUBSET_DIRTY,
 };
 
 static blender::Vector<Object *> lightprobe_cache_irradiance_volume_subset_get(bContext *C,
@@ -1485,6 +1486,21 @@ static blender::Vector<Object *> lightprobe_cache_irradiance_volume_subset_get(b
       }
       break;
     }
+    case LIGHTCACHE_SUBSET_DIRTY: {
+      /* The viewport tags the cache as dirty when objects inside the volume or the lighting of
+       * the scene change. */
+      auto needs_bake = [](const Object *ob) {
+        const LightProbeObjectCache *cache = ob->lightprobe_cache;
+        return cache == nullptr || cache->grid_static_cache == nullptr || cache->dirty;
+      };
+      FOREACH_OBJECT_BEGIN (scene, view_layer, ob) {
+        if (is_irradiance_volume(ob) && needs_bake(ob)) {
+          irradiance_volume_setup(ob);
+        }
+      }
+      FOREACH_OBJECT_END;
+      break;
+    }
     default:
       BLI_assert_unreachable();
       break;
@@ -1625,6 +1641,12 @@ void OBJECT_OT_lightprobe_cache_bake(wmOperatorType *ot)
        0,
        "Active Only",
        "Only bake the active light probe volume"},
+      {LIGHTCACHE_SUBSET_DIRTY,
+       "DIRTY",
+       0,
+       "Modified Only",
+       "Only bake the light probe volumes that are not baked yet, or that were affected by "
+       "changes in the scene since they were baked"},
       {0, nullptr, 0, nullptr, nullptr},
   };
 
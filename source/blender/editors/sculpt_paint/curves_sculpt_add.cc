@@ -56,19 +56,15 @@ using bke::CurvesGeometry;
 
 class AddOperation : public CurvesSculptStrokeOperation {
  private:
-  /** Used when some data should be interpolated from existing curves. */
-  KDTree_3d *curve_roots_kdtree_ = nullptr;
+  /**
+   * Used when some data should be interpolated from existing curves. Only contains the curves
+   * that existed when the stroke started.
+   */
+  std::shared_ptr<KDTree_3d> curve_roots_kdtree_;
 
   friend struct AddOperationExecutor;
 
  public:
-  ~AddOperation() override
-  {
-    if (curve_roots_kdtree_ != nullptr) {
-      BLI_kdtree_3d_free(curve_roots_kdtree_);
-    }
-  }
-
   void on_stroke_extended(const bContext &C, const StrokeExtension &stroke_extension) override;
 };
 
@@ -224,7 +220,7 @@ struct AddOperationExecutor {
         add_inputs.interpolate_resolution)
     {
       this->ensure_curve_roots_kdtree();
-      add_inputs.old_roots_kdtree = self_->curve_roots_kdtree_;
+      add_inputs.old_roots_kdtree = self_->curve_roots_kdtree_.get();
     }
 
     const geometry::AddCurvesOnMeshOutputs add_outputs = geometry::add_curves_on_mesh(
@@ -496,14 +492,8 @@ struct AddOperationExecutor {
 
   void ensure_curve_roots_kdtree()
   {
-    if (self_->curve_roots_kdtree_ == nullptr) {
-      self_->curve_roots_kdtree_ = BLI_kdtree_3d_new(curves_orig_->curves_num());
-      const Span<int> offsets = curves_orig_->offsets();
-      const Span<float3> positions = curves_orig_->positions();
-      for (const int curve_i : curves_orig_->curves_range()) {
-        BLI_kdtree_3d_insert(self_->curve_roots_kdtree_, curve_i, positions[offsets[curve_i]]);
-      }
-      BLI_kdtree_3d_balance(self_->curve_roots_kdtree_);
+    if (!self_->curve_roots_kdtree_) {
+      self_->curve_roots_kdtree_ = curve_roots_kdtree_get(*curves_orig_);
     }
   }
 };
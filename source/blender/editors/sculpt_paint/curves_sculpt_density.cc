@@ -42,9 +42,9 @@ namespace blender::ed::sculpt_paint {
 class DensityAddOperation : public CurvesSculptStrokeOperation {
  private:
   /** Used when some data should be interpolated from existing curves. */
-  KDTree_3d *original_curve_roots_kdtree_ = nullptr;
+  std::shared_ptr<KDTree_3d> original_curve_roots_kdtree_;
   /** Contains curve roots of all curves that existed before the brush started. */
-  KDTree_3d *deformed_curve_roots_kdtree_ = nullptr;
+  std::shared_ptr<KDTree_3d> deformed_curve_roots_kdtree_;
   /** Root positions of curves that have been added in the current brush stroke. */
   Vector<float3> new_deformed_root_positions_;
   int original_curve_num_ = 0;
@@ -52,16 +52,6 @@ class DensityAddOperation : public CurvesSculptStrokeOperation {
   friend struct DensityAddOperationExecutor;
 
  public:
-  ~DensityAddOperation() override
-  {
-    if (original_curve_roots_kdtree_ != nullptr) {
-      BLI_kdtree_3d_free(original_curve_roots_kdtree_);
-    }
-    if (deformed_curve_roots_kdtree_ != nullptr) {
-      BLI_kdtree_3d_free(deformed_curve_roots_kdtree_);
-    }
-  }
-
   void on_stroke_extended(const bContext &C, const StrokeExtension &stroke_extension) override;
 };
 
@@ -212,7 +202,7 @@ struct DensityAddOperationExecutor {
                   KDTreeNearest_3d nearest;
                   nearest.dist = FLT_MAX;
                   BLI_kdtree_3d_find_nearest(
-                      self_->deformed_curve_roots_kdtree_, new_root_pos_cu, &nearest);
+                      self_->deformed_curve_roots_kdtree_.get(), new_root_pos_cu, &nearest);
                   if (nearest.dist < brush_settings_->minimum_distance) {
                     new_curve_skipped[new_i] = true;
                   }
@@ -275,7 +265,7 @@ struct DensityAddOperationExecutor {
     add_inputs.corner_normals_su = corner_normals_su;
     add_inputs.surface_corner_tris = surface_corner_tris_orig;
     add_inputs.reverse_uv_sampler = &reverse_uv_sampler;
-    add_inputs.old_roots_kdtree = self_->original_curve_roots_kdtree_;
+    add_inputs.old_roots_kdtree = self_->original_curve_roots_kdtree_.get();
 
     const geometry::AddCurvesOnMeshOutputs add_outputs = geometry::add_curves_on_mesh(
         *curves_orig_, add_inputs);
@@ -313,23 +303,25 @@ struct DensityAddOperationExecutor {
     const Span<float3> deformed_positions = deformation.positions;
     BLI_assert(original_positions.size() == deformed_positions.size());
 
-    auto roots_kdtree_from_positions = [&](const Span<float3> positions) {
-      KDTree_3d *kdtree = BLI_kdtree_3d_new(curves_orig_->curves_num());
-      for (const int curve_i : curves_orig_->curves_range()) {
-        const int root_point_i = curve_offsets[curve_i];
-        BLI_kdtree_3d_insert(kdtree, curve_i, positions[root_point_i]);
-      }
-      BLI_kdtree_3d_balance(kdtree);
-      return kdtree;
-    };
+    /* Without deformation, the cached tree of the original curves can be used for both. */
+    if (deformed_positions.data() == original_positions.data()) {
+      self_->original_curve_roots_kdtree_ = curve_roots_kdtree_get(*curves_orig_);
+      self_->deformed_curve_roots_kdtree_ = self_->original_curve_roots_kdtree_;
+      return;
+    }
 
     threading::parallel_invoke(
         1024 < original_positions.size() + deformed_positions.size(),
+        [&]() { self_->original_curve_roots_kdtree_ = curve_roots_kdtree_get(*curves_orig_); },
         [&]() {
-          self_->original_curve_roots_kdtree_ = roots_kdtree_from_positions(original_positions);
-        },
-        [&]() {
-          self_->deformed_curve_roots_kdtree_ = roots_kdtree_from_positions(deformed_positions);
+          KDTree_3d *kdtree = BLI_kdtree_3d_new(curves_orig_->curves_num());
+          for (const int curve_i : curves_orig_->curves_range()) {
+            const int root_point_i = curve_offsets[curve_i];
+            BLI_kdtree_3d_insert(kdtree, curve_i, deformed_positions[root_point_i]);
+          }
+          BLI_kdtree_3d_balance(kdtree);
+          self_->deformed_curve_roots_kdtree_ = std::shared_ptr<KDTree_3d>(kdtree,
+                                                                           BLI_kdtree_3d_free);
         });
   }
 
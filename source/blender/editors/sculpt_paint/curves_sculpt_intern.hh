@@ -103,6 +103,12 @@ Vector<float4x4> get_symmetry_brush_transforms(eCurvesSymmetryType symmetry);
 
 bke::SpanAttributeWriter<float> float_selection_ensure(Curves &curves_id);
 
+/**
+ * A KD-tree of the root positions of all curves, using the curve indices. It is cached on the
+ * geometry, so it is shared by all brushes and only rebuilt after the curves changed.
+ */
+std::shared_ptr<KDTree_3d> curve_roots_kdtree_get(const CurvesGeometry &curves);
+
 /** See #move_last_point_and_resample. */
 struct MoveAndResampleBuffers {
   Vector<float> orig_lengths;
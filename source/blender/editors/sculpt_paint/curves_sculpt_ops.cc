@@ -116,6 +116,21 @@ float brush_strength_get(const Scene &scene,
   return BKE_brush_alpha_get(&scene, &brush) * brush_strength_factor(brush, stroke_extension);
 }
 
+std::shared_ptr<KDTree_3d> curve_roots_kdtree_get(const CurvesGeometry &curves)
+{
+  curves.runtime->root_positions_kdtree_cache.ensure([&](std::shared_ptr<KDTree_3d> &r_data) {
+    const OffsetIndices points_by_curve = curves.points_by_curve();
+    const Span<float3> positions = curves.positions();
+    KDTree_3d *kdtree = BLI_kdtree_3d_new(curves.curves_num());
+    for (const int curve_i : curves.curves_range()) {
+      BLI_kdtree_3d_insert(kdtree, curve_i, positions[points_by_curve[curve_i].first()]);
+    }
+    BLI_kdtree_3d_balance(kdtree);
+    r_data = std::shared_ptr<KDTree_3d>(kdtree, BLI_kdtree_3d_free);
+  });
+  return curves.runtime->root_positions_kdtree_cache.data();
+}
+
 static std::unique_ptr<CurvesSculptStrokeOperation> start_brush_operation(
     bContext &C, wmOperator &op, const StrokeExtension &stroke_start)
 {
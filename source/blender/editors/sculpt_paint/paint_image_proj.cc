@@ -118,7 +118,7 @@
 
 using blender::int3;
 
-static void partial_redraw_array_init(ImagePaintPartialRedraw *pr);
+static void partial_redraw_array_init(ImagePaintPartialRedraw *pr, int tot);
 
 /* Defines and Structs */
 /* unit_float_to_uchar_clamp as inline function */
@@ -140,8 +140,16 @@ BLI_INLINE uchar f_to_char(const float val)
 #define PROJ_BUCKET_RECT_MIN 4
 #define PROJ_BUCKET_RECT_MAX 256
 
+/**
+ * Images are divided in cells along each axis to track the regions changed by painting, which are
+ * updated on the GPU separately. Large images use more cells so that each cell is at most
+ * #PROJ_BOUNDBOX_CELL_SIZE pixels wide, up to a maximum number of cells, see
+ * #proj_image_bb_div_calc. This avoids uploading big areas of high resolution images when painting
+ * near the corners of a cell.
+ */
 #define PROJ_BOUNDBOX_DIV 8
-#define PROJ_BOUNDBOX_SQUARED (PROJ_BOUNDBOX_DIV * PROJ_BOUNDBOX_DIV)
+#define PROJ_BOUNDBOX_DIV_MAX 32
+#define PROJ_BOUNDBOX_CELL_SIZE 128
 
 // #define PROJ_DEBUG_PAINT 1
 // #define PROJ_DEBUG_NOSEAMBLEED 1
@@ -213,7 +221,10 @@ struct ProjPaintImage {
   Image *ima;
   ImageUser iuser;
   ImBuf *ibuf;
+  /** Changed region of each cell, #bb_div * #bb_div rectangles. */
   ImagePaintPartialRedraw *partRedrawRect;
+  /** Number of cells along each axis of the image used for #partRedrawRect. */
+  int bb_div;
   /** Only used to build undo tiles during painting. */
   volatile void **undoRect;
   /** The mask accumulation must happen on canvas, not on space screen bucket.
@@ -484,7 +495,7 @@ struct ProjPixel {
 
   /** if anyone wants to paint onto more than 65535 images they can bite me. */
   ushort image_index;
-  uchar bb_cell_index;
+  ushort bb_cell_index;
 
   /* for various reasons we may want to mask out painting onto this pixel */
   ushort mask;
@@ -1940,9 +1951,9 @@ static ProjPixel *project_paint_uvpixel_init(const ProjPaintState *ps,
   }
 
   /* which bounding box cell are we in?, needed for undo */
-  projPixel->bb_cell_index = int((float(x_px) / float(ibuf->x)) * PROJ_BOUNDBOX_DIV) +
-                             int((float(y_px) / float(ibuf->y)) * PROJ_BOUNDBOX_DIV) *
-                                 PROJ_BOUNDBOX_DIV;
+  projPixel->bb_cell_index = int((float(x_px) / float(ibuf->x)) * projima->bb_div) +
+                             int((float(y_px) / float(ibuf->y)) * projima->bb_div) *
+                                 projima->bb_div;
 
   /* done with view3d_project_float inline */
   if (ps->brush_type == IMAGE_PAINT_BRUSH_TYPE_CLONE) {
@@ -4263,6 +4274,13 @@ struct PrepareImageEntry {
   ImageUser iuser;
 };
 
+static int proj_image_bb_div_calc(const ImBuf &ibuf)
+{
+  const int size = std::max(ibuf.x, ibuf.y);
+  const int div = int(divide_ceil_u(uint(size), PROJ_BOUNDBOX_CELL_SIZE));
+  return std::clamp(div, PROJ_BOUNDBOX_DIV, PROJ_BOUNDBOX_DIV_MAX);
+}
+
 static void project_paint_build_proj_ima(ProjPaintState *ps,
                                          MemArena *arena,
                                          ListBase *used_images)
@@ -4290,9 +4308,11 @@ static void project_paint_build_proj_ima(ProjPaintState *ps,
     }
     size = sizeof(void **) * ED_IMAGE_UNDO_TILE_NUMBER(projIma->ibuf->x) *
            ED_IMAGE_UNDO_TILE_NUMBER(projIma->ibuf->y);
+    projIma->bb_div = proj_image_bb_div_calc(*projIma->ibuf);
+    const int bb_cells_num = square_i(projIma->bb_div);
     projIma->partRedrawRect = static_cast<ImagePaintPartialRedraw *>(
-        BLI_memarena_alloc(arena, sizeof(ImagePaintPartialRedraw) * PROJ_BOUNDBOX_SQUARED));
-    partial_redraw_array_init(projIma->partRedrawRect);
+        BLI_memarena_alloc(arena, sizeof(ImagePaintPartialRedraw) * bb_cells_num));
+    partial_redraw_array_init(projIma->partRedrawRect, bb_cells_num);
     projIma->undoRect = (volatile void **)BLI_memarena_alloc(arena, size);
     memset((void *)projIma->undoRect, 0, size);
     projIma->maskRect = static_cast<ushort **>(BLI_memarena_alloc(arena, size));
@@ -4695,9 +4715,8 @@ static void partial_redraw_single_init(ImagePaintPartialRedraw *pr)
   BLI_rcti_init_minmax(&pr->dirty_region);
 }
 
-static void partial_redraw_array_init(ImagePaintPartialRedraw *pr)
+static void partial_redraw_array_init(ImagePaintPartialRedraw *pr, int tot)
 {
-  int tot = PROJ_BOUNDBOX_SQUARED;
   while (tot--) {
     partial_redraw_single_init(pr);
     pr++;
@@ -4733,7 +4752,7 @@ static bool project_image_refresh_tagged(ProjPaintState *ps)
   for (a = 0, projIma = ps->projImages; a < ps->image_tot; a++, projIma++) {
     if (projIma->touch) {
       /* look over each bound cell */
-      for (i = 0; i < PROJ_BOUNDBOX_SQUARED; i++) {
+      for (i = 0; i < square_i(projIma->bb_div); i++) {
         pr = &(projIma->partRedrawRect[i]);
         if (BLI_rcti_is_valid(&pr->dirty_region)) {
           set_imapaintpartial(pr);
@@ -5673,12 +5692,12 @@ static bool project_paint_op(void *state, const float lastpos[2], const float po
 
     /* image bounds */
     for (i = 0; i < ps->image_tot; i++) {
+      const int bb_cells_num = square_i(ps->projImages[i].bb_div);
       handles[a].projImages[i].partRedrawRect = static_cast<ImagePaintPartialRedraw *>(
-          BLI_memarena_alloc(ps->arena_mt[a],
-                             sizeof(ImagePaintPartialRedraw) * PROJ_BOUNDBOX_SQUARED));
+          BLI_memarena_alloc(ps->arena_mt[a], sizeof(ImagePaintPartialRedraw) * bb_cells_num));
       memcpy(handles[a].projImages[i].partRedrawRect,
              ps->projImages[i].partRedrawRect,
-             sizeof(ImagePaintPartialRedraw) * PROJ_BOUNDBOX_SQUARED);
+             sizeof(ImagePaintPartialRedraw) * bb_cells_num);
     }
 
     handles[a].pool = image_pool;
@@ -5704,7 +5723,7 @@ static bool project_paint_op(void *state, const float lastpos[2], const float po
     for (a = 0; a < ps->thread_tot; a++) {
       touch |= int(partial_redraw_array_merge(ps->projImages[i].partRedrawRect,
                                               handles[a].projImages[i].partRedrawRect,
-                                              PROJ_BOUNDBOX_SQUARED));
+                                              square_i(ps->projImages[i].bb_div)));
     }
 
     if (touch) {
@@ -122,6 +122,12 @@ struct WPaintData : public PaintModeData {
   /* original weight values for use in blur/smear */
   float *precomputed_weight;
   bool precomputed_weight_ready;
+  /**
+   * Vertices whose weights were painted since #precomputed_weight was last updated, so
+   * accumulating brushes only have to update those instead of reading all deform weights again.
+   * Null when every value has to be recomputed.
+   */
+  bool *precomputed_weight_changed;
 
   ~WPaintData() override
   {
@@ -133,6 +139,7 @@ struct WPaintData : public PaintModeData {
     MEM_SAFE_FREE(active.lock);
     MEM_SAFE_FREE(mirror.lock);
     MEM_SAFE_FREE(precomputed_weight);
+    MEM_SAFE_FREE(precomputed_weight_changed);
   }
 };
 
@@ -166,6 +173,9 @@ struct WeightPaintInfo {
   const bool *vgroup_locked;
   const bool *vgroup_unlocked;
 
+  /* same as WeightPaintData.precomputed_weight_changed, may be null */
+  bool *weight_changed;
+
   bool do_flip;
   bool do_multipaint;
   bool do_auto_normalize;
@@ -850,6 +860,9 @@ static void do_weight_paint_vertex(const VPaint &wp,
                                    float alpha,
                                    float paintweight)
 {
+  if (wpi.weight_changed) {
+    wpi.weight_changed[index] = true;
+  }
   if (wpi.do_multipaint) {
     do_weight_paint_vertex_multi(wp, ob, wpi, index, alpha, paintweight);
   }
@@ -1001,6 +1014,12 @@ static bool wpaint_stroke_test_start(bContext *C, wmOperator *op, const float mo
   brush = BKE_paint_brush(&vp.paint);
   if (ELEM(brush->weight_brush_type, WPAINT_BRUSH_TYPE_SMEAR, WPAINT_BRUSH_TYPE_BLUR)) {
     wpd->precomputed_weight = MEM_malloc_arrayN<float>(mesh.verts_num, __func__);
+    /* Mirroring also changes the weights of other vertices, always recompute all of them then. */
+    if (vwpaint::brush_use_accumulate_ex(*brush, eObjectMode(ob.mode)) &&
+        !ME_USING_MIRROR_X_VERTEX_GROUPS(&mesh))
+    {
+      wpd->precomputed_weight_changed = MEM_calloc_arrayN<bool>(mesh.verts_num, __func__);
+    }
   }
 
   if (!ob.sculpt->mode.wpaint.dvert_prev.is_empty()) {
@@ -1047,6 +1066,19 @@ static void precompute_weight_values(
     return;
   }
 
+  if (wpd.precomputed_weight_ready && wpd.precomputed_weight_changed) {
+    bool *changed = wpd.precomputed_weight_changed;
+    threading::parallel_for(IndexRange(mesh.verts_num), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        if (changed[i]) {
+          wpd.precomputed_weight[i] = wpaint_get_active_weight(wpi.dvert[i], wpi);
+          changed[i] = false;
+        }
+      }
+    });
+    return;
+  }
+
   threading::parallel_for(IndexRange(mesh.verts_num), 512, [&](const IndexRange range) {
     for (const int i : range) {
       const MDeformVert &dv = wpi.dvert[i];
@@ -1846,6 +1878,7 @@ static void wpaint_stroke_update_step(bContext *C,
   wpi.do_lock_relative = wpd->do_lock_relative;
   wpi.is_normalized = wpi.do_auto_normalize || wpi.do_lock_relative;
   wpi.brush_alpha_value = brush_alpha_value;
+  wpi.weight_changed = wpd->precomputed_weight_changed;
 
   if (wpd->precomputed_weight) {
     precompute_weight_values(*ob, brush, *wpd, wpi, mesh);
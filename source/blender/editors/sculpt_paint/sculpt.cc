@@ -27,6 +27,7 @@
 #include "BLI_math_rotation.h"
 #include "BLI_rect.h"
 #include "BLI_set.hh"
+#include "BLI_simd.hh"
 #include "BLI_span.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
@@ -6992,6 +6993,50 @@ void filter_region_clip_factors(const SculptSession &ss,
   }
 }
 
+/**
+ * Squared distances from a location to many positions, computing four distances at a time when
+ * SIMD instructions are available. This gives the same results as #math::distance_squared.
+ */
+template<typename PositionFn>
+static void calc_distances_squared(const float3 &location,
+                                   const PositionFn position_fn,
+                                   const MutableSpan<float> r_distances)
+{
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 location_x = _mm_set1_ps(location.x);
+  const __m128 location_y = _mm_set1_ps(location.y);
+  const __m128 location_z = _mm_set1_ps(location.z);
+  for (; i + 4 <= r_distances.size(); i += 4) {
+    const float3 &a = position_fn(i);
+    const float3 &b = position_fn(i + 1);
+    const float3 &c = position_fn(i + 2);
+    const float3 &d = position_fn(i + 3);
+    const __m128 x = _mm_sub_ps(location_x, _mm_set_ps(d.x, c.x, b.x, a.x));
+    const __m128 y = _mm_sub_ps(location_y, _mm_set_ps(d.y, c.y, b.y, a.y));
+    const __m128 z = _mm_sub_ps(location_z, _mm_set_ps(d.z, c.z, b.z, a.z));
+    const __m128 xy = _mm_add_ps(_mm_mul_ps(x, x), _mm_mul_ps(y, y));
+    _mm_storeu_ps(&r_distances[i], _mm_add_ps(xy, _mm_mul_ps(z, z)));
+  }
+#endif
+  for (; i < r_distances.size(); i++) {
+    r_distances[i] = math::distance_squared(location, position_fn(i));
+  }
+}
+
+static void sqrt_values(const MutableSpan<float> values)
+{
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  for (; i + 4 <= values.size(); i += 4) {
+    _mm_storeu_ps(&values[i], _mm_sqrt_ps(_mm_loadu_ps(&values[i])));
+  }
+#endif
+  for (; i < values.size(); i++) {
+    values[i] = std::sqrt(values[i]);
+  }
+}
+
 void calc_brush_distances_squared(const SculptSession &ss,
                                   const Span<float3> positions,
                                   const Span<int> verts,
@@ -7014,9 +7059,10 @@ void calc_brush_distances_squared(const SculptSession &ss,
     }
   }
   else {
-    for (const int i : verts.index_range()) {
-      r_distances[i] = math::distance_squared(test_location, positions[verts[i]]);
-    }
+    calc_distances_squared(
+        test_location,
+        [&](const int64_t i) -> const float3 & { return positions[verts[i]]; },
+        r_distances);
   }
 }
 
@@ -7027,9 +7073,7 @@ void calc_brush_distances(const SculptSession &ss,
                           const MutableSpan<float> r_distances)
 {
   calc_brush_distances_squared(ss, positions, verts, falloff_shape, r_distances);
-  for (float &value : r_distances) {
-    value = std::sqrt(value);
-  }
+  sqrt_values(r_distances);
 }
 
 void calc_brush_distances_squared(const SculptSession &ss,
@@ -7053,9 +7097,10 @@ void calc_brush_distances_squared(const SculptSession &ss,
     }
   }
   else {
-    for (const int i : positions.index_range()) {
-      r_distances[i] = math::distance_squared(test_location, positions[i]);
-    }
+    calc_distances_squared(
+        test_location,
+        [&](const int64_t i) -> const float3 & { return positions[i]; },
+        r_distances);
   }
 }
 
@@ -7065,16 +7110,22 @@ void calc_brush_distances(const SculptSession &ss,
                           const MutableSpan<float> r_distances)
 {
   calc_brush_distances_squared(ss, positions, falloff_shape, r_distances);
-  for (float &value : r_distances) {
-    value = std::sqrt(value);
-  }
+  sqrt_values(r_distances);
 }
 
 void filter_distances_with_radius(const float radius,
                                   const Span<float> distances,
                                   const MutableSpan<float> factors)
 {
-  for (const int i : distances.index_range()) {
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 radius_v = _mm_set1_ps(radius);
+  for (; i + 4 <= distances.size(); i += 4) {
+    const __m128 outside = _mm_cmpge_ps(_mm_loadu_ps(&distances[i]), radius_v);
+    _mm_storeu_ps(&factors[i], _mm_andnot_ps(outside, _mm_loadu_ps(&factors[i])));
+  }
+#endif
+  for (; i < distances.size(); i++) {
     if (distances[i] >= radius) {
       factors[i] = 0.0f;
     }
@@ -7129,15 +7180,38 @@ void apply_hardness_to_distances(const float radius,
     return;
   }
   const float threshold = hardness * radius;
+  int64_t i = 0;
+#if BLI_HAVE_SSE2
+  const __m128 threshold_v = _mm_set1_ps(threshold);
+  const __m128 radius_v = _mm_set1_ps(radius);
+#endif
   if (hardness == 1.0f) {
-    for (const int i : distances.index_range()) {
+#if BLI_HAVE_SSE2
+    for (; i + 4 <= distances.size(); i += 4) {
+      const __m128 inside = _mm_cmplt_ps(_mm_loadu_ps(&distances[i]), threshold_v);
+      _mm_storeu_ps(&distances[i], _mm_andnot_ps(inside, radius_v));
+    }
+#endif
+    for (; i < distances.size(); i++) {
       distances[i] = distances[i] < threshold ? 0.0f : radius;
     }
     return;
   }
   const float radius_inv = math::rcp(radius);
   const float hardness_inv_rcp = math::rcp(1.0f - hardness);
-  for (const int i : distances.index_range()) {
+#if BLI_HAVE_SSE2
+  const __m128 radius_inv_v = _mm_set1_ps(radius_inv);
+  const __m128 hardness_v = _mm_set1_ps(hardness);
+  const __m128 hardness_inv_rcp_v = _mm_set1_ps(hardness_inv_rcp);
+  for (; i + 4 <= distances.size(); i += 4) {
+    const __m128 distance = _mm_loadu_ps(&distances[i]);
+    const __m128 radius_factor = _mm_mul_ps(
+        _mm_sub_ps(_mm_mul_ps(distance, radius_inv_v), hardness_v), hardness_inv_rcp_v);
+    const __m128 inside = _mm_cmplt_ps(distance, threshold_v);
+    _mm_storeu_ps(&distances[i], _mm_andnot_ps(inside, _mm_mul_ps(radius_factor, radius_v)));
+  }
+#endif
+  for (; i < distances.size(); i++) {
     if (distances[i] < threshold) {
       distances[i] = 0.0f;
     }
@@ -1381,18 +1381,53 @@ static void init_from_face_set_boundary(const Depsgraph &depsgraph,
   }
 }
 
-/**
- * Main function to initialize new falloff values in a #Cache given an initial vertex and a
- * falloff type.
- */
-static void calc_falloff_from_vert_and_symmetry(const Depsgraph &depsgraph,
-                                                Cache &expand_cache,
-                                                Object &ob,
-                                                const int vert,
-                                                FalloffType falloff_type)
+/** Number of falloffs kept in #Cache::cached_falloffs, they use a float per vertex each. */
+#define SCULPT_EXPAND_CACHED_FALLOFFS_MAX 3
+
+/** Falloff types which are expensive and only depend on the mesh and the initial vertex. */
+static bool falloff_type_is_cached(const FalloffType falloff_type)
 {
-  expand_cache.falloff_type = falloff_type;
+  return ELEM(falloff_type,
+              FalloffType::Geodesic,
+              FalloffType::Topology,
+              FalloffType::TopologyNormals,
+              FalloffType::BoundaryTopology);
+}
+
+static bool falloff_cache_lookup(Cache &expand_cache,
+                                 const int vert,
+                                 const FalloffType falloff_type)
+{
+  Vector<Cache::CachedFalloff> &cached_falloffs = expand_cache.cached_falloffs;
+  for (const int i : cached_falloffs.index_range()) {
+    if (cached_falloffs[i].falloff_type == falloff_type && cached_falloffs[i].vert == vert) {
+      /* Move to the end to keep the most recently used falloffs. */
+      Cache::CachedFalloff cached = std::move(cached_falloffs[i]);
+      cached_falloffs.remove(i);
+      expand_cache.vert_falloff = cached.vert_falloff;
+      cached_falloffs.append(std::move(cached));
+      return true;
+    }
+  }
+  return false;
+}
+
+static void falloff_cache_add(Cache &expand_cache, const int vert, const FalloffType falloff_type)
+{
+  Vector<Cache::CachedFalloff> &cached_falloffs = expand_cache.cached_falloffs;
+  if (cached_falloffs.size() == SCULPT_EXPAND_CACHED_FALLOFFS_MAX) {
+    cached_falloffs.remove(0);
+  }
+  cached_falloffs.append({falloff_type, vert, expand_cache.vert_falloff});
+}
 
+/** Compute the falloff values of #Cache::vert_falloff for the given type. */
+static void vert_falloff_calc(const Depsgraph &depsgraph,
+                              Cache &expand_cache,
+                              Object &ob,
+                              const int vert,
+                              const FalloffType falloff_type)
+{
   const bke::pbvh::Tree &pbvh = *bke::object::pbvh_get(ob);
   const bool has_topology_info = pbvh.type() == bke::pbvh::Type::Mesh;
 
@@ -1433,6 +1468,27 @@ static void calc_falloff_from_vert_and_symmetry(const Depsgraph &depsgraph,
           depsgraph, ob, expand_cache, expand_cache.initial_active_face_set, false);
       break;
   }
+}
+
+/**
+ * Main function to initialize new falloff values in a #Cache given an initial vertex and a
+ * falloff type.
+ */
+static void calc_falloff_from_vert_and_symmetry(const Depsgraph &depsgraph,
+                                                Cache &expand_cache,
+                                                Object &ob,
+                                                const int vert,
+                                                FalloffType falloff_type)
+{
+  expand_cache.falloff_type = falloff_type;
+
+  if (!falloff_type_is_cached(falloff_type)) {
+    vert_falloff_calc(depsgraph, expand_cache, ob, vert, falloff_type);
+  }
+  else if (!falloff_cache_lookup(expand_cache, vert, falloff_type)) {
+    vert_falloff_calc(depsgraph, expand_cache, ob, vert, falloff_type);
+    falloff_cache_add(expand_cache, vert, falloff_type);
+  }
 
   /* Update max falloff values and propagate to base mesh faces if needed. */
   update_max_vert_falloff_value(ob, expand_cache);
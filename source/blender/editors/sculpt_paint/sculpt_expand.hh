@@ -11,6 +11,7 @@
 #include "BLI_index_mask.hh"
 #include "BLI_math_vector_types.hh"
 #include "BLI_set.hh"
+#include "BLI_vector.hh"
 
 struct Brush;
 struct Scene;
@@ -172,6 +173,17 @@ struct Cache {
 
   bool check_islands;
   int normal_falloff_blur_steps;
+
+  /* Falloffs that only depend on the mesh and the initial vertex, computed before during this
+   * operation. Switching between falloff types or moving the origin back reuses them instead of
+   * computing them again, which takes a long time for the geodesic falloff on dense meshes. Most
+   * recently used last. */
+  struct CachedFalloff {
+    FalloffType falloff_type;
+    int vert;
+    Array<float> vert_falloff;
+  };
+  Vector<CachedFalloff> cached_falloffs;
 };
 
 }  // namespace blender::ed::sculpt_paint::expand
@@ -9,9 +9,11 @@
 #include <cstdlib>
 
 #include "BLI_bit_vector.hh"
+#include "BLI_index_mask.hh"
 #include "BLI_linklist_stack.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.h"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -83,13 +85,9 @@ Array<float> distances_create(const Span<float3> vert_positions,
   BLI_LINKSTACK_INIT(queue);
   BLI_LINKSTACK_INIT(queue_next);
 
-  for (const int i : vert_positions.index_range()) {
-    if (initial_verts.contains(i)) {
-      dists[i] = 0.0f;
-    }
-    else {
-      dists[i] = FLT_MAX;
-    }
+  dists.fill(FLT_MAX);
+  for (const int vert : initial_verts) {
+    dists[vert] = 0.0f;
   }
 
   /* Masks vertices that are further than limit radius from an initial vertex. As there is no need
@@ -105,27 +103,33 @@ Array<float> distances_create(const Span<float3> vert_positions,
     /* This is an O(n^2) loop used to limit the geodesic distance calculation to a radius. When
      * this optimization is needed, it is expected for the tool to request the distance to a low
      * number of vertices (usually just 1 or 2). */
-    for (const int v : initial_verts) {
-      const float *v_co = vert_positions[v];
-      for (const int i : vert_positions.index_range()) {
-        if (len_squared_v3v3(v_co, vert_positions[i]) <= limit_radius_sq) {
-          affected_vert[i].set();
-        }
-      }
-    }
+    IndexMaskMemory memory;
+    IndexMask::from_predicate(
+        vert_positions.index_range(), GrainSize(4096), memory, [&](const int i) {
+          for (const int v : initial_verts) {
+            if (len_squared_v3v3(vert_positions[v], vert_positions[i]) <= limit_radius_sq) {
+              return true;
+            }
+          }
+          return false;
+        })
+        .to_bits(affected_vert);
   }
 
-  /* Add edges adjacent to an initial vertex to the queue. */
-  for (const int i : edges.index_range()) {
-    const int v1 = edges[i][0];
-    const int v2 = edges[i][1];
-    if (!affected_vert[v1] && !affected_vert[v2]) {
-      continue;
-    }
-    if (dists[v1] != FLT_MAX || dists[v2] != FLT_MAX) {
-      BLI_LINKSTACK_PUSH(queue, POINTER_FROM_INT(i));
-    }
-  }
+  /* Add edges adjacent to an initial vertex to the queue. Finding them is done in parallel, since
+   * it has to check all edges of the mesh. */
+  IndexMaskMemory memory;
+  const IndexMask initial_edges = IndexMask::from_predicate(
+      edges.index_range(), GrainSize(4096), memory, [&](const int i) {
+        const int v1 = edges[i][0];
+        const int v2 = edges[i][1];
+        if (!affected_vert[v1] && !affected_vert[v2]) {
+          return false;
+        }
+        return dists[v1] != FLT_MAX || dists[v2] != FLT_MAX;
+      });
+  initial_edges.foreach_index(
+      [&](const int edge) { BLI_LINKSTACK_PUSH(queue, POINTER_FROM_INT(edge)); });
 
   do {
     while (BLI_LINKSTACK_SIZE(queue)) {
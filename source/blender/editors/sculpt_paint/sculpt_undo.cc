@@ -29,6 +29,8 @@
 #include "CLG_log.h"
 
 #include "BLI_array.hh"
+#include "BLI_array_store.h"
+#include "BLI_array_store_utils.h"
 #include "BLI_bit_group_vector.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
@@ -119,6 +121,29 @@ namespace blender::ed::sculpt_paint::undo {
 
 #define NO_ACTIVE_LAYER bke::AttrDomain::Auto
 
+/**
+ * The arrays of undo nodes are moved to de-duplicated storage once an undo step is pushed, so
+ * that the data which is unchanged between consecutive strokes is only stored once. Each array
+ * uses a separate store so they can be compacted in parallel.
+ */
+enum {
+  ARRAY_STORE_INDEX_POSITION = 0,
+  ARRAY_STORE_INDEX_ORIG_POSITION,
+  ARRAY_STORE_INDEX_COLOR,
+  ARRAY_STORE_INDEX_MASK,
+  ARRAY_STORE_INDEX_LOOP_COLOR,
+  ARRAY_STORE_INDEX_VERT_INDICES,
+  ARRAY_STORE_INDEX_CORNER_INDICES,
+  ARRAY_STORE_INDEX_GRIDS,
+  ARRAY_STORE_INDEX_FACE_SETS,
+  ARRAY_STORE_INDEX_FACE_INDICES,
+};
+#define ARRAY_STORE_INDEX_NUM (ARRAY_STORE_INDEX_FACE_INDICES + 1)
+
+/** Same as for edit-mesh undo, see `editmesh_undo.cc`. */
+#define ARRAY_CHUNK_SIZE_IN_BYTES 65536
+#define ARRAY_CHUNK_NUM_MIN 256
+
 struct Node {
   Array<float3, 0> position;
   Array<float3, 0> orig_position;
@@ -151,6 +176,14 @@ struct Node {
   Array<int, 0> face_sets;
 
   Vector<int> face_indices;
+
+  /**
+   * The arrays above once moved to the array store, see #array_store_compact. Null for arrays
+   * which are empty or not compacted.
+   */
+  BArrayState *array_states[ARRAY_STORE_INDEX_NUM] = {};
+  /** Used to find the node of the previous step to de-duplicate against. */
+  int array_store_key = -1;
 };
 
 struct SculptAttrRef {
@@ -254,6 +287,11 @@ struct StepData {
   /** Storage of per-node undo data after creation of the undo step is finished. */
   Vector<std::unique_ptr<Node>> nodes;
 
+  /** The arrays of #nodes are stored in the array store, see #array_store_compact. */
+  bool uses_array_store;
+  /** Memory added to the array stores when compacting this step, part of #undo_size. */
+  size_t array_store_size;
+
   size_t undo_size;
 };
 
@@ -284,6 +322,20 @@ static StepData *get_step_data()
   return nullptr;
 }
 
+/**
+ * The data of the sculpt undo step before the one being built, used as reference to de-duplicate
+ * the new undo data.
+ */
+static const StepData *get_prev_step_data()
+{
+  UndoStack *ustack = ED_undo_stack_get();
+  UndoStep *us = BKE_undosys_stack_active_with_type(ustack, BKE_UNDOSYS_TYPE_SCULPT);
+  if (us == nullptr || us == ustack->step_init) {
+    return nullptr;
+  }
+  return &reinterpret_cast<SculptUndoStep *>(us)->data;
+}
+
 static bool use_multires_undo(const StepData &step_data, const SculptSession &ss)
 {
   return step_data.grids.grids_num != 0 && ss.subdiv_ccg != nullptr;
@@ -1109,8 +1161,11 @@ static void restore_list(bContext *C, Depsgraph *depsgraph, StepData &step_data)
   }
 }
 
+static void array_store_free(StepData &step_data);
+
 static void free_step_data(StepData &step_data)
 {
+  array_store_free(step_data);
   geometry_free_data(&step_data.geometry_original);
   geometry_free_data(&step_data.geometry_modified);
   geometry_free_data(&step_data.bmesh.geometry_enter);
@@ -1779,6 +1834,190 @@ static size_t node_size_in_bytes(const Node &node)
   return size;
 }
 
+/* -------------------------------------------------------------------- */
+/** \name Array Store
+ * \{ */
+
+static struct {
+  BArrayStore_AtSize bs_stride[ARRAY_STORE_INDEX_NUM];
+  /** The number of steps with data in the array stores. */
+  int users;
+} array_store = {{{nullptr}}};
+
+static size_t array_chunk_size_calc(const size_t stride)
+{
+  return std::max(ARRAY_CHUNK_NUM_MIN, ARRAY_CHUNK_SIZE_IN_BYTES / power_of_2_max_i(int(stride)));
+}
+
+/** Call \a fn with the index of the store used for each array of the node, and the array. */
+template<typename Fn> static void node_arrays_foreach(Node &node, Fn &&fn)
+{
+  fn(ARRAY_STORE_INDEX_POSITION, node.position);
+  fn(ARRAY_STORE_INDEX_ORIG_POSITION, node.orig_position);
+  fn(ARRAY_STORE_INDEX_COLOR, node.col);
+  fn(ARRAY_STORE_INDEX_MASK, node.mask);
+  fn(ARRAY_STORE_INDEX_LOOP_COLOR, node.loop_col);
+  fn(ARRAY_STORE_INDEX_VERT_INDICES, node.vert_indices);
+  fn(ARRAY_STORE_INDEX_CORNER_INDICES, node.corner_indices);
+  fn(ARRAY_STORE_INDEX_GRIDS, node.grids);
+  fn(ARRAY_STORE_INDEX_FACE_SETS, node.face_sets);
+  fn(ARRAY_STORE_INDEX_FACE_INDICES, node.face_indices);
+}
+
+template<typename T, int64_t N> static void array_resize(Array<T, N> &array, const int64_t size)
+{
+  array.reinitialize(size);
+}
+
+template<typename T, int64_t N> static void array_resize(Vector<T, N> &array, const int64_t size)
+{
+  array.resize(size);
+}
+
+static int node_array_store_key(const Node &node)
+{
+  if (!node.vert_indices.is_empty()) {
+    return node.vert_indices.first();
+  }
+  if (!node.grids.is_empty()) {
+    return node.grids.first();
+  }
+  if (!node.face_indices.is_empty()) {
+    return node.face_indices.first();
+  }
+  return -1;
+}
+
+static size_t array_store_calc_memory_usage()
+{
+  size_t size_compacted_all = 0;
+  for (const int bs_index : IndexRange(ARRAY_STORE_INDEX_NUM)) {
+    size_t size_expanded, size_compacted;
+    BLI_array_store_at_size_calc_memory_usage(
+        &array_store.bs_stride[bs_index], &size_expanded, &size_compacted);
+    size_compacted_all += size_compacted;
+  }
+  return size_compacted_all;
+}
+
+/**
+ * Move the arrays of all nodes to the array stores, de-duplicating them against the arrays of the
+ * nodes of \a step_data_reference (typically the previous sculpt undo step).
+ *
+ * \return The amount of memory added to the array stores.
+ */
+static size_t array_store_compact(StepData &step_data, const StepData *step_data_reference)
+{
+  if (step_data.nodes.is_empty()) {
+    return 0;
+  }
+
+  /* Nodes of the previous step associated with the same part of the mesh usually share most of
+   * their data, typically the indices and the data that wasn't changed by the stroke. */
+  Map<int, const Node *> nodes_reference;
+  if (step_data_reference != nullptr && step_data_reference->uses_array_store) {
+    for (const std::unique_ptr<Node> &unode : step_data_reference->nodes) {
+      nodes_reference.add(unode->array_store_key, unode.get());
+    }
+  }
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    if (unode->array_store_key == -1) {
+      unode->array_store_key = node_array_store_key(*unode);
+    }
+  }
+
+  const size_t size_compacted_prev = array_store_calc_memory_usage();
+
+  threading::parallel_for(IndexRange(ARRAY_STORE_INDEX_NUM), 1, [&](const IndexRange range) {
+    for (const int bs_index : range) {
+      for (std::unique_ptr<Node> &unode : step_data.nodes) {
+        const Node *unode_reference = nodes_reference.lookup_default(unode->array_store_key,
+                                                                     nullptr);
+        node_arrays_foreach(*unode, [&](const int index, auto &array) {
+          if (index != bs_index || array.is_empty()) {
+            return;
+          }
+          BLI_assert(unode->array_states[index] == nullptr);
+          const size_t stride = sizeof(array[0]);
+          BArrayStore *bs = BLI_array_store_at_size_ensure(
+              &array_store.bs_stride[index], int(stride), int(array_chunk_size_calc(stride)));
+          unode->array_states[index] = BLI_array_store_state_add(
+              bs,
+              array.data(),
+              size_t(array.size()) * stride,
+              unode_reference ? unode_reference->array_states[index] : nullptr);
+          array = {};
+        });
+      }
+    }
+  });
+
+  if (!step_data.uses_array_store) {
+    step_data.uses_array_store = true;
+    array_store.users += 1;
+  }
+
+  const size_t size_compacted = array_store_calc_memory_usage();
+  return size_compacted > size_compacted_prev ? size_compacted - size_compacted_prev : 0;
+}
+
+static void array_store_remove_states(StepData &step_data)
+{
+  /* Removing states from a store isn't thread-safe. */
+  for (std::unique_ptr<Node> &unode : step_data.nodes) {
+    node_arrays_foreach(*unode, [&](const int index, auto &array) {
+      if (BArrayState *state = unode->array_states[index]) {
+        BArrayStore *bs = BLI_array_store_at_size_get(&array_store.bs_stride[index],
+                                                      int(sizeof(array[0])));
+        BLI_array_store_state_remove(bs, state);
+        unode->array_states[index] = nullptr;
+      }
+    });
+  }
+}
+
+/** Move the arrays of all nodes back from the array stores, so they can be modified. */
+static void array_store_expand(StepData &step_data)
+{
+  if (!step_data.uses_array_store) {
+    return;
+  }
+  threading::parallel_for(step_data.nodes.index_range(), 16, [&](const IndexRange range) {
+    for (const int i : range) {
+      Node &unode = *step_data.nodes[i];
+      node_arrays_foreach(unode, [&](const int index, auto &array) {
+        BArrayState *state = unode.array_states[index];
+        if (state == nullptr) {
+          return;
+        }
+        const size_t stride = sizeof(array[0]);
+        array_resize(array, int64_t(BLI_array_store_state_size_get(state) / stride));
+        BLI_array_store_state_data_get(state, array.data());
+      });
+    }
+  });
+  array_store_remove_states(step_data);
+}
+
+static void array_store_free(StepData &step_data)
+{
+  if (!step_data.uses_array_store) {
+    return;
+  }
+  array_store_remove_states(step_data);
+  step_data.uses_array_store = false;
+
+  array_store.users -= 1;
+  BLI_assert(array_store.users >= 0);
+  if (array_store.users == 0) {
+    for (const int bs_index : IndexRange(ARRAY_STORE_INDEX_NUM)) {
+      BLI_array_store_at_size_clear(&array_store.bs_stride[bs_index]);
+    }
+  }
+}
+
+/** \} */
+
 void push_end_ex(Object &ob, const bool use_nested_undo)
 {
   StepData *step_data = get_step_data();
@@ -1799,6 +2038,7 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
    * just one positions array that has a different semantic meaning depending on whether there are
    * deform modifiers. */
 
+  step_data->array_store_size += array_store_compact(*step_data, get_prev_step_data());
   step_data->undo_size = threading::parallel_reduce(
       step_data->nodes.index_range(),
       16,
@@ -1810,6 +2050,7 @@ void push_end_ex(Object &ob, const bool use_nested_undo)
         return size;
       },
       std::plus<size_t>());
+  step_data->undo_size += step_data->array_store_size;
 
   /* We could remove this and enforce all callers run in an operator using 'OPTYPE_UNDO'. */
   wmWindowManager *wm = static_cast<wmWindowManager *>(G_MAIN->wm.first);
@@ -1916,11 +2157,34 @@ static bool step_encode(bContext * /*C*/, Main *bmain, UndoStep *us_p)
   return true;
 }
 
+/**
+ * Restoring swaps the data of the undo nodes with the current data, so the arrays have to be moved
+ * out of the array stores while doing so.
+ */
+static void restore_list_from_array_store(bContext *C, Depsgraph *depsgraph, SculptUndoStep *us)
+{
+  const bool uses_array_store = us->data.uses_array_store;
+  array_store_expand(us->data);
+
+  restore_list(C, depsgraph, us->data);
+
+  if (uses_array_store) {
+    const StepData *step_data_reference =
+        (us->step.prev && us->step.prev->type == BKE_UNDOSYS_TYPE_SCULPT) ?
+            &reinterpret_cast<SculptUndoStep *>(us->step.prev)->data :
+            nullptr;
+    us->data.undo_size -= std::min(us->data.undo_size, us->data.array_store_size);
+    us->data.array_store_size = array_store_compact(us->data, step_data_reference);
+    us->data.undo_size += us->data.array_store_size;
+    us->step.data_size = us->data.undo_size;
+  }
+}
+
 static void step_decode_undo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoStep *us)
 {
   BLI_assert(us->step.is_applied == true);
 
-  restore_list(C, depsgraph, us->data);
+  restore_list_from_array_store(C, depsgraph, us);
   us->step.is_applied = false;
 }
 
@@ -1928,7 +2192,7 @@ static void step_decode_redo_impl(bContext *C, Depsgraph *depsgraph, SculptUndoS
 {
   BLI_assert(us->step.is_applied == false);
 
-  restore_list(C, depsgraph, us->data);
+  restore_list_from_array_store(C, depsgraph, us);
   us->step.is_applied = true;
 }
 
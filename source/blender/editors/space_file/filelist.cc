@@ -38,6 +38,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
 #include "BLI_path_utils.hh"
+#include "BLI_set.hh"
 #include "BLI_stack.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
@@ -3347,6 +3348,24 @@ static int filelist_readjob_list_lib_populate_from_index(FileListReadJob *job_pa
   return read_from_index + navigate_to_parent_len;
 }
 
+/**
+ * Same as #BLO_blendhandle_get_linkable_groups, from the data-block names of a file index.
+ */
+static LinkNode *filelist_readjob_list_lib_groups_from_id_names(LinkNode *id_names)
+{
+  LinkNode *groups = nullptr;
+  Set<short> gathered;
+  for (LinkNode *ln = id_names; ln; ln = ln->next) {
+    const short idcode = GS(static_cast<const char *>(ln->link));
+    if (BKE_idtype_idcode_is_valid(idcode) && BKE_idtype_idcode_is_linkable(idcode) &&
+        gathered.add(idcode))
+    {
+      BLI_linklist_prepend(&groups, BLI_strdup(BKE_idtype_idcode_to_name(idcode)));
+    }
+  }
+  return groups;
+}
+
 /**
  * \return The number of entries found if the \a root path points to a valid library file.
  *         Otherwise returns no value (#std::nullopt).
@@ -3398,11 +3417,19 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
     }
   }
 
+  /* Listing the groups only does not require opening the whole library file, when it contains an
+   * index of its data-blocks. */
+  LinkNode *file_index_id_names = nullptr;
+  const bool use_file_index = !has_group && !(options & LIST_LIB_RECURSIVE) &&
+                              BLO_file_index_from_file(dir, &file_index_id_names);
+
   /* Open the library file. */
-  BlendFileReadReport bf_reports{};
-  libfiledata = BLO_blendhandle_from_file(dir, &bf_reports);
-  if (libfiledata == nullptr) {
-    return std::nullopt;
+  if (!use_file_index) {
+    BlendFileReadReport bf_reports{};
+    libfiledata = BLO_blendhandle_from_file(dir, &bf_reports);
+    if (libfiledata == nullptr) {
+      return std::nullopt;
+    }
   }
 
   /* Add current parent when requested. */
@@ -3430,7 +3457,9 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
   }
   /* Read all datablocks from all groups. */
   else {
-    LinkNode *groups = BLO_blendhandle_get_linkable_groups(libfiledata);
+    LinkNode *groups = use_file_index ?
+                           filelist_readjob_list_lib_groups_from_id_names(file_index_id_names) :
+                           BLO_blendhandle_get_linkable_groups(libfiledata);
     group_len = BLI_linklist_count(groups);
 
     for (LinkNode *ln = groups; ln; ln = ln->next) {
@@ -3458,7 +3487,12 @@ static std::optional<int> filelist_readjob_list_lib(FileListReadJob *job_params,
     BLI_linklist_freeN(groups);
   }
 
-  BLO_blendhandle_close(libfiledata);
+  if (use_file_index) {
+    BLI_linklist_freeN(file_index_id_names);
+  }
+  else {
+    BLO_blendhandle_close(libfiledata);
+  }
 
   /* Update the index. */
   if (use_indexer) {
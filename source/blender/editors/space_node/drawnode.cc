@@ -1956,6 +1956,35 @@ static void nodelink_batch_reset()
   g_batch_link.count = 0;
 }
 
+/**
+ * Double the size of the instance buffer when it is full, so that all visible links are drawn
+ * with a single draw call instead of flushing the batch for every group of links. The buffer keeps
+ * its size for the next redraws.
+ */
+static void nodelink_batch_grow()
+{
+  const uint count = g_batch_link.count;
+  GPU_vertbuf_data_resize(*g_batch_link.inst_vbo,
+                          GPU_vertbuf_get_vertex_alloc(g_batch_link.inst_vbo) * 2);
+  nodelink_batch_reset();
+  for (GPUVertBufRaw *step : {&g_batch_link.p0_step,
+                              &g_batch_link.p1_step,
+                              &g_batch_link.p2_step,
+                              &g_batch_link.p3_step,
+                              &g_batch_link.colid_step,
+                              &g_batch_link.muted_step,
+                              &g_batch_link.start_color_step,
+                              &g_batch_link.end_color_step,
+                              &g_batch_link.dim_factor_step,
+                              &g_batch_link.thickness_step,
+                              &g_batch_link.dash_params_step,
+                              &g_batch_link.has_back_link_step})
+  {
+    step->data += size_t(count) * step->stride;
+  }
+  g_batch_link.count = count;
+}
+
 static void set_nodelink_vertex(gpu::VertBuf *vbo,
                                 uint uv_id,
                                 uint pos_id,
@@ -2175,8 +2204,7 @@ struct NodeLinkDrawConfig {
   float dash_alpha;
 };
 
-static void nodelink_batch_add_link(const SpaceNode &snode,
-                                    const std::array<float2, 4> &points,
+static void nodelink_batch_add_link(const std::array<float2, 4> &points,
                                     const NodeLinkDrawConfig &draw_config)
 {
   /* Only allow these colors. If more is needed, you need to modify the shader accordingly. */
@@ -2207,8 +2235,8 @@ static void nodelink_batch_add_link(const SpaceNode &snode,
   copy_v3_v3((float *)GPU_vertbuf_raw_step(&g_batch_link.dash_params_step), dash_params);
   *(int *)GPU_vertbuf_raw_step(&g_batch_link.has_back_link_step) = draw_config.has_back_link;
 
-  if (g_batch_link.count == NODELINK_GROUP_SIZE) {
-    nodelink_batch_draw(snode);
+  if (g_batch_link.count == GPU_vertbuf_get_vertex_alloc(g_batch_link.inst_vbo)) {
+    nodelink_batch_grow();
   }
 }
 
@@ -2372,7 +2400,7 @@ static void node_draw_link_bezier_ex(const SpaceNode &snode,
 
   if (g_batch_link.enabled && !draw_config.highlighted && !GPU_node_link_instancing_workaround()) {
     /* Add link to batch. */
-    nodelink_batch_add_link(snode, points, draw_config);
+    nodelink_batch_add_link(points, draw_config);
   }
   else {
     NodeLinkData node_link_data;
@@ -26,6 +26,7 @@
 #include "BLI_bounds.hh"
 #include "BLI_convexhull_2d.h"
 #include "BLI_function_ref.hh"
+#include "BLI_hash.hh"
 #include "BLI_listbase.h"
 #include "BLI_map.hh"
 #include "BLI_math_matrix.hh"
@@ -147,6 +148,7 @@ struct TreeDrawContext {
   bool used_by_compositor = false;
 
   Map<bNodeInstanceKey, timeit::Nanoseconds> *compositor_per_node_execution_time = nullptr;
+  Map<bNodeInstanceKey, int64_t> *compositor_per_node_memory_usage = nullptr;
 
   /**
    * Label for reroute nodes that is derived from upstream reroute nodes.
@@ -3055,6 +3057,29 @@ static std::optional<NodeExtraInfoRow> node_get_execution_time_label_row(
   return row;
 }
 
+static std::optional<NodeExtraInfoRow> compositor_node_get_memory_usage_row(
+    TreeDrawContext &tree_draw_ctx, const SpaceNode &snode, const bNode &node)
+{
+  BLI_assert(tree_draw_ctx.compositor_per_node_memory_usage);
+
+  const bNodeInstanceKey key = current_node_instance_key(snode, node);
+  const int64_t *memory_usage = tree_draw_ctx.compositor_per_node_memory_usage->lookup_ptr(key);
+  if (!memory_usage || *memory_usage == 0) {
+    return std::nullopt;
+  }
+
+  char memory_usage_string[BLI_STR_FORMAT_INT64_BYTE_UNIT_SIZE];
+  BLI_str_format_byte_unit(memory_usage_string, *memory_usage, false);
+
+  NodeExtraInfoRow row;
+  row.text = memory_usage_string;
+  row.tooltip = TIP_(
+      "The memory used by the results of the node from the node tree's latest evaluation. For "
+      "group nodes, the memory used by all sub-nodes");
+  row.icon = ICON_MEMORY;
+  return row;
+}
+
 static void node_get_compositor_extra_info(TreeDrawContext &tree_draw_ctx,
                                            const SpaceNode &snode,
                                            const bNode &node,
@@ -3066,6 +3091,12 @@ static void node_get_compositor_extra_info(TreeDrawContext &tree_draw_ctx,
     if (row.has_value()) {
       rows.append(std::move(*row));
     }
+    if (!node.is_frame()) {
+      row = compositor_node_get_memory_usage_row(tree_draw_ctx, snode, node);
+      if (row.has_value()) {
+        rows.append(std::move(*row));
+      }
+    }
   }
 }
 
@@ -4191,6 +4222,29 @@ static void reroute_node_prepare_for_draw(bNode &node)
   node.runtime->draw_bounds.ymin = loc.y - radius;
 }
 
+/**
+ * Hash of everything the layout of an expanded node depends on, see #node_update_basis. Changes to
+ * properties, sockets and links are covered by the tagged changes of the tree.
+ */
+static uint64_t node_layout_hash(const bNodeTree &ntree, const bNode &node)
+{
+  uint64_t hash = get_default_hash(ntree.runtime->tagged_changes_num,
+                                   float2(node.location[0], node.location[1]),
+                                   node.width,
+                                   node.flag);
+  hash = get_default_hash(hash, UI_SCALE_FAC);
+  for (const bNodePanelState &panel_state : node.panel_states()) {
+    hash = get_default_hash(hash, int(panel_state.flag));
+  }
+  for (const bNodeSocket *socket : node.input_sockets()) {
+    hash = get_default_hash(hash, int(socket->flag), int(socket->runtime->total_inputs));
+  }
+  for (const bNodeSocket *socket : node.output_sockets()) {
+    hash = get_default_hash(hash, int(socket->flag));
+  }
+  return hash;
+}
+
 static void node_update_nodetree(const bContext &C,
                                  TreeDrawContext &tree_draw_ctx,
                                  bNodeTree &ntree,
@@ -4202,6 +4256,16 @@ static void node_update_nodetree(const bContext &C,
 
   count_multi_input_socket_links(ntree, *snode);
 
+  /* Building the layout of every node on every redraw is the main cost of drawing large trees.
+   * Nodes that are far outside of the view keep their previous bounds and socket locations as
+   * long as nothing they depend on changed. The margin makes sure that nodes get their layout
+   * updated before they become visible when panning. While a button is active, all layouts are
+   * updated so that it isn't removed from its block. */
+  const ARegion &region = *tree_draw_ctx.region;
+  const bool use_layout_cache = UI_region_active_but_get(&region) == nullptr;
+  rctf layout_rect = region.v2d.cur;
+  BLI_rctf_pad(&layout_rect, BLI_rctf_size_x(&layout_rect), BLI_rctf_size_y(&layout_rect));
+
   for (const int i : nodes.index_range()) {
     bNode &node = *nodes[i];
     uiBlock &block = *blocks[node.index()];
@@ -4216,9 +4280,17 @@ static void node_update_nodetree(const bContext &C,
     else {
       if (node.flag & NODE_HIDDEN) {
         node_update_hidden(node, block);
+        node.runtime->draw_layout_hash = 0;
       }
       else {
+        const uint64_t layout_hash = node_layout_hash(ntree, node);
+        if (use_layout_cache && node.runtime->draw_layout_hash == layout_hash &&
+            !BLI_rctf_isect(&node.runtime->draw_bounds, &layout_rect, nullptr))
+        {
+          continue;
+        }
         node_update_basis(C, tree_draw_ctx, ntree, node, block);
+        node.runtime->draw_layout_hash = layout_hash;
       }
     }
   }
@@ -5264,6 +5336,8 @@ static void draw_nodetree(const bContext &C,
     tree_draw_ctx.used_by_compositor = compositor_is_in_use(C);
     tree_draw_ctx.compositor_per_node_execution_time =
         &scene->runtime->compositor.per_node_execution_time;
+    tree_draw_ctx.compositor_per_node_memory_usage =
+        &scene->runtime->compositor.per_node_memory_usage;
   }
   else if (ntree.type == NTREE_SHADER && USER_EXPERIMENTAL_TEST(&U, use_shader_node_previews) &&
            BKE_scene_uses_shader_previews(CTX_data_scene(&C)) &&
@@ -33,6 +33,7 @@
 #include "BKE_scene_runtime.hh"
 #include "BKE_screen.hh"
 
+#include "BLI_fileops.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector.hh"
@@ -71,6 +72,7 @@
 
 #include "NOD_composite.hh"
 #include "NOD_geometry.hh"
+#include "NOD_geometry_nodes_log.hh"
 #include "NOD_shader.h"
 #include "NOD_socket.hh"
 #include "NOD_texture.h"
@@ -316,6 +318,9 @@ static void compo_startjob(void *cjv, wmJobWorkerStatus *worker_status)
 
   BKE_callback_exec_id(cj->bmain, &cj->scene->id, BKE_CB_EVT_COMPOSITE_PRE);
 
+  const bool write_profile = G.compositor_profile_filepath[0] != '\0';
+  cj->profiler.set_synchronize_gpu(write_profile);
+
   if ((scene->r.scemode & R_MULTIVIEW) == 0) {
     COM_execute(cj->re, &scene->r, scene, ntree, "", nullptr, &cj->profiler, cj->needed_outputs);
   }
@@ -329,6 +334,12 @@ static void compo_startjob(void *cjv, wmJobWorkerStatus *worker_status)
     }
   }
 
+  if (write_profile && !cj->profiler.write_json(*ntree, G.compositor_profile_filepath)) {
+    fprintf(stderr,
+            "Unable to write compositor profile to '%s'\n",
+            G.compositor_profile_filepath);
+  }
+
   ntree->runtime->test_break = nullptr;
   ntree->runtime->stats_draw = nullptr;
   ntree->runtime->progress = nullptr;
@@ -343,6 +354,7 @@ static void compo_canceljob(void *cjv)
   cj->cancelled = true;
 
   scene->runtime->compositor.per_node_execution_time = cj->profiler.get_nodes_evaluation_times();
+  scene->runtime->compositor.per_node_memory_usage = cj->profiler.get_nodes_memory_usage();
 }
 
 static void compo_completejob(void *cjv)
@@ -353,6 +365,7 @@ static void compo_completejob(void *cjv)
   BKE_callback_exec_id(bmain, &scene->id, BKE_CB_EVT_COMPOSITE_POST);
 
   scene->runtime->compositor.per_node_execution_time = cj->profiler.get_nodes_evaluation_times();
+  scene->runtime->compositor.per_node_memory_usage = cj->profiler.get_nodes_memory_usage();
 }
 
 /** \} */
@@ -2692,4 +2705,74 @@ void NODE_OT_cryptomatte_layer_remove(wmOperatorType *ot)
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Export Geometry Nodes Profile
+ * \{ */
+
+static bool node_geometry_profile_export_poll(bContext *C)
+{
+  if (!ED_operator_node_active(C)) {
+    return false;
+  }
+  const SpaceNode *snode = CTX_wm_space_node(C);
+  return snode->edittree->type == NTREE_GEOMETRY;
+}
+
+static wmOperatorStatus node_geometry_profile_export_exec(bContext *C, wmOperator *op)
+{
+  const SpaceNode &snode = *CTX_wm_space_node(C);
+  nodes::geo_eval_log::GeoModifierLog *log = nodes::geo_eval_log::GeoModifierLog::get_root_log(
+      snode);
+  if (log == nullptr) {
+    BKE_report(op->reports, RPT_ERROR, "The node tree has not been evaluated yet");
+    return OPERATOR_CANCELLED;
+  }
+
+  char filepath[FILE_MAX];
+  RNA_string_get(op->ptr, "filepath", filepath);
+  fstream file(filepath, std::ios::out);
+  if (!file.is_open()) {
+    BKE_reportf(op->reports, RPT_ERROR, "Unable to write '%s'", filepath);
+    return OPERATOR_CANCELLED;
+  }
+  log->write_profile_json(file, *CTX_data_main(C));
+  return OPERATOR_FINISHED;
+}
+
+static wmOperatorStatus node_geometry_profile_export_invoke(bContext *C,
+                                                            wmOperator *op,
+                                                            const wmEvent *event)
+{
+  if (RNA_struct_property_is_set(op->ptr, "filepath")) {
+    return node_geometry_profile_export_exec(C, op);
+  }
+  RNA_string_set(op->ptr, "filepath", "geometry_nodes_profile.json");
+  return WM_operator_filesel(C, op, event);
+}
+
+void NODE_OT_geometry_profile_export(wmOperatorType *ot)
+{
+  /* identifiers */
+  ot->name = "Export Geometry Nodes Profile";
+  ot->description =
+      "Write the execution time, memory allocations and copied data of every node in the last "
+      "evaluation, and how busy each thread was, to a JSON file";
+  ot->idname = "NODE_OT_geometry_profile_export";
+
+  /* callbacks */
+  ot->exec = node_geometry_profile_export_exec;
+  ot->invoke = node_geometry_profile_export_invoke;
+  ot->poll = node_geometry_profile_export_poll;
+
+  WM_operator_properties_filesel(ot,
+                                 FILE_TYPE_FOLDER | FILE_TYPE_TEXT,
+                                 FILE_SPECIAL,
+                                 FILE_SAVE,
+                                 WM_FILESEL_FILEPATH,
+                                 FILE_DEFAULTDISPLAY,
+                                 FILE_SORT_DEFAULT);
+}
+
+/** \} */
+
 }  // namespace blender::ed::space_node
@@ -111,6 +111,8 @@ void node_operatortypes()
   WM_operatortype_append(NODE_OT_cryptomatte_layer_add);
   WM_operatortype_append(NODE_OT_cryptomatte_layer_remove);
 
+  WM_operatortype_append(NODE_OT_geometry_profile_export);
+
   for (bke::bNodeType *ntype : bke::node_types_get()) {
     if (ntype->register_operators) {
       ntype->register_operators();
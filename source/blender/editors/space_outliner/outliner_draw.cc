@@ -3336,12 +3336,13 @@ static void outliner_draw_tree_element(uiBlock *block,
   float ufac = UI_UNIT_X / 20.0f;
   int offsx = 0;
   eOLDrawState active = OL_DRAWSEL_NONE;
-  uchar text_color[4];
-  UI_GetThemeColor4ubv(TH_TEXT, text_color);
-  float icon_bgcolor[4], icon_border[4];
-  outliner_icon_background_colors(icon_bgcolor, icon_border);
 
   if (*starty + 2 * UI_UNIT_Y >= region->v2d.cur.ymin && *starty <= region->v2d.cur.ymax) {
+    uchar text_color[4];
+    UI_GetThemeColor4ubv(TH_TEXT, text_color);
+    float icon_bgcolor[4], icon_border[4];
+    outliner_icon_background_colors(icon_bgcolor, icon_border);
+
     const float alpha_fac = element_should_draw_faded(tvc, te, tselem) ? 0.5f : 1.0f;
     int xmax = region->v2d.cur.xmax;
 
@@ -3583,6 +3584,7 @@ static void outliner_draw_hierarchy_line(
 }
 
 static void outliner_draw_hierarchy_lines_recursive(uint pos,
+                                                    const View2D &v2d,
                                                     SpaceOutliner *space_outliner,
                                                     ListBase *lb,
                                                     const TreeViewContext &tvc,
@@ -3615,11 +3617,9 @@ static void outliner_draw_hierarchy_lines_recursive(uint pos,
         y = *starty;
       }
       else if ((tselem->type == TSE_SOME_ID) && (te->idcode == ID_OB)) {
-        if (subtree_contains_object(&te->subtree)) {
-          draw_hierarchy_line = true;
-          is_object_line = true;
-          y = *starty;
-        }
+        /* Child objects are only looked up once the line is known to be visible. */
+        is_object_line = true;
+        y = *starty;
       }
       else if (tselem->type == TSE_GREASE_PENCIL_NODE) {
         bke::greasepencil::TreeNode &node =
@@ -3631,6 +3631,7 @@ static void outliner_draw_hierarchy_lines_recursive(uint pos,
       }
 
       outliner_draw_hierarchy_lines_recursive(pos,
+                                              v2d,
                                               space_outliner,
                                               &te->subtree,
                                               tvc,
@@ -3640,7 +3641,14 @@ static void outliner_draw_hierarchy_lines_recursive(uint pos,
                                               starty);
     }
 
-    if (draw_hierarchy_line) {
+    if (draw_hierarchy_line || is_object_line) {
+      /* The line spans from `y` down to `*starty`, skip it when it is outside of the view. */
+      if (y + UI_UNIT_Y < v2d.cur.ymin || *starty - UI_UNIT_Y > v2d.cur.ymax) {
+        continue;
+      }
+      if (is_object_line && !subtree_contains_object(&te->subtree)) {
+        continue;
+      }
       const short alpha_fac = element_should_draw_faded(tvc, te, tselem) ? 127 : 255;
       uchar line_color[4];
       if (color_tag != COLLECTION_COLOR_NONE) {
@@ -3657,7 +3665,8 @@ static void outliner_draw_hierarchy_lines_recursive(uint pos,
   }
 }
 
-static void outliner_draw_hierarchy_lines(SpaceOutliner *space_outliner,
+static void outliner_draw_hierarchy_lines(const ARegion *region,
+                                          SpaceOutliner *space_outliner,
                                           ListBase *lb,
                                           const TreeViewContext &tvc,
                                           int startx,
@@ -3680,7 +3689,7 @@ static void outliner_draw_hierarchy_lines(SpaceOutliner *space_outliner,
   GPU_line_width(1.0f);
   GPU_blend(GPU_BLEND_ALPHA);
   outliner_draw_hierarchy_lines_recursive(
-      pos, space_outliner, lb, tvc, startx, col, false, starty);
+      pos, region->v2d, space_outliner, lb, tvc, startx, col, false, starty);
   GPU_blend(GPU_BLEND_NONE);
 
   immUnbindProgram();
@@ -3743,6 +3752,13 @@ static void outliner_draw_highlights(uint pos,
   tree_iterator::all_open(*space_outliner, [&](const TreeElement *te) {
     const TreeStoreElem *tselem = TREESTORE(te);
     const int start_y = *io_start_y;
+    *io_start_y -= UI_UNIT_Y;
+
+    /* Rows outside of the view don't draw anything, which matters when many elements are
+     * selected in large trees. */
+    if (start_y + UI_UNIT_Y < region->v2d.cur.ymin || start_y > region->v2d.cur.ymax) {
+      return;
+    }
 
     /* Selection status. */
     if ((tselem->flag & TSE_ACTIVE) && (tselem->flag & TSE_SELECTED)) {
@@ -3794,8 +3810,6 @@ static void outliner_draw_highlights(uint pos,
         }
       }
     }
-
-    *io_start_y -= UI_UNIT_Y;
   });
 }
 
@@ -3885,7 +3899,8 @@ static void outliner_draw_tree(uiBlock *block,
   {
     int starty = int(region->v2d.tot.ymax) - OL_Y_OFFSET;
     int startx = columns_offset + UI_UNIT_X / 2 - (U.pixelsize + 1) / 2;
-    outliner_draw_hierarchy_lines(space_outliner, &space_outliner->tree, tvc, startx, &starty);
+    outliner_draw_hierarchy_lines(
+        region, space_outliner, &space_outliner->tree, tvc, startx, &starty);
   }
 
   /* Items themselves. */
@@ -350,14 +350,13 @@ void ED_outliner_select_sync_from_outliner(bContext *C, SpaceOutliner *space_out
 
 namespace blender::ed::outliner {
 
-static void outliner_select_sync_from_object(const Scene *scene,
-                                             ViewLayer *view_layer,
+static void outliner_select_sync_from_object(ViewLayer *view_layer,
                                              Object *obact,
                                              TreeElement *te,
                                              TreeStoreElem *tselem)
 {
+  /* The view layer is synced once before syncing the whole tree. */
   Object *ob = (Object *)tselem->id;
-  BKE_view_layer_synced_ensure(scene, view_layer);
   Base *base = (te->directdata) ? (Base *)te->directdata :
                                   BKE_view_layer_base_find(view_layer, ob);
   const bool is_selected = (base != nullptr) && ((base->flag & BASE_SELECTED) != 0);
@@ -454,8 +453,7 @@ struct SyncSelectActiveData {
 };
 
 /** Sync select and active flags from active view layer, bones, and sequences to the outliner. */
-static void outliner_sync_selection_to_outliner(const Scene *scene,
-                                                ViewLayer *view_layer,
+static void outliner_sync_selection_to_outliner(ViewLayer *view_layer,
                                                 SpaceOutliner *space_outliner,
                                                 ListBase *tree,
                                                 SyncSelectActiveData *active_data,
@@ -466,7 +464,7 @@ static void outliner_sync_selection_to_outliner(const Scene *scene,
 
     if ((tselem->type == TSE_SOME_ID) && te->idcode == ID_OB) {
       if (sync_types->object) {
-        outliner_select_sync_from_object(scene, view_layer, active_data->object, te, tselem);
+        outliner_select_sync_from_object(view_layer, active_data->object, te, tselem);
       }
     }
     else if (tselem->type == TSE_EBONE) {
@@ -490,7 +488,7 @@ static void outliner_sync_selection_to_outliner(const Scene *scene,
 
     /* Sync subtree elements */
     outliner_sync_selection_to_outliner(
-        scene, view_layer, space_outliner, &te->subtree, active_data, sync_types);
+        view_layer, space_outliner, &te->subtree, active_data, sync_types);
   }
 }
 
@@ -519,9 +517,9 @@ void outliner_sync_selection(const bContext *C,
     /* Store active object, bones, and strip */
     SyncSelectActiveData active_data;
     get_sync_select_active_data(C, &active_data);
+    BKE_view_layer_synced_ensure(tvc.scene, tvc.view_layer);
 
-    outliner_sync_selection_to_outliner(tvc.scene,
-                                        tvc.view_layer,
+    outliner_sync_selection_to_outliner(tvc.view_layer,
                                         space_outliner,
                                         &space_outliner->tree,
                                         &active_data,
@@ -63,7 +63,10 @@ static void seq_proxy_build_job(const bContext *C, ReportList *reports)
       BKE_reportf(reports, RPT_WARNING, "Proxy is not enabled for %s, skipping", strip->name);
       continue;
     }
-    if (strip->data->proxy->build_size_flags == 0) {
+    /* Movies may only build time code indices, which is enough for fast seeking. */
+    if (strip->data->proxy->build_size_flags == 0 &&
+        (strip->type != STRIP_TYPE_MOVIE || strip->data->proxy->build_tc_flags == 0))
+    {
       BKE_reportf(
           reports, RPT_WARNING, "Resolution is not selected for %s, skipping", strip->name);
       continue;
@@ -1690,6 +1690,21 @@ static void draw_cache_final_iter_fn(void *userdata, int timeline_frame)
   drawdata->quads->add_quad(timeline_frame, stripe_bot, timeline_frame + 1, stripe_top, col);
 }
 
+/* Draw the frames that prefetch workers are rendering in the final cache stripe. */
+static void draw_cache_prefetch_iter_fn(void *userdata, int worker_index, int timeline_frame)
+{
+  CacheDrawData *drawdata = static_cast<CacheDrawData *>(userdata);
+
+  /* Lighter than the final cache color, alternating per worker to tell them apart. */
+  const uchar4 col = (worker_index % 2) ? uchar4{170, 170, 235, 255} :
+                                          uchar4{200, 200, 250, 255};
+
+  const View2D *v2d = drawdata->v2d;
+  float stripe_top = v2d->cur.ymax - (UI_TIME_SCRUB_MARGIN_Y / UI_view2d_scale_get_y(v2d));
+  float stripe_bot = stripe_top - (UI_TIME_CACHE_MARGIN_Y / UI_view2d_scale_get_y(v2d));
+  drawdata->quads->add_quad(timeline_frame, stripe_bot, timeline_frame + 1, stripe_top, col);
+}
+
 /* Draw source cache entries at bottom of the strips. */
 static void draw_cache_source_iter_fn(void *userdata, const Strip *strip, int timeline_frame)
 {
@@ -1783,6 +1798,7 @@ static void draw_cache_view(const bContext *C)
   draw_cache_background(C, &userdata);
   if (sseq->cache_overlay.flag & SEQ_CACHE_SHOW_FINAL_OUT) {
     seq::final_image_cache_iterate(scene, &userdata, draw_cache_final_iter_fn);
+    seq::prefetch_rendering_frames_iterate(scene, &userdata, draw_cache_prefetch_iter_fn);
   }
   if ((U.flag & USER_DEVELOPER_UI) && (sseq->cache_overlay.flag & SEQ_CACHE_SHOW_RAW)) {
     seq::source_image_cache_iterate(scene, &userdata, draw_cache_source_iter_fn);
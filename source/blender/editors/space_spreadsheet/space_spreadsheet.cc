@@ -6,6 +6,7 @@
 #include <fmt/format.h>
 
 #include "BLI_listbase.h"
+#include "BLI_resource_scope.hh"
 #include "BLI_string.h"
 
 #include "BKE_screen.hh"
@@ -428,7 +429,10 @@ static void spreadsheet_main_region_draw(const bContext *C, ARegion *region)
   }
 
   spreadsheet_layout.row_indices = spreadsheet_filter_rows(
-      *sspreadsheet, spreadsheet_layout, *data_source, scope);
+      *sspreadsheet,
+      spreadsheet_layout,
+      *data_source,
+      DEG_get_update_count(CTX_data_depsgraph_pointer(C)));
 
   sspreadsheet->runtime->tot_columns = spreadsheet_layout.columns.size();
   sspreadsheet->runtime->tot_rows = tot_rows;
@@ -4,8 +4,12 @@
 
 #pragma once
 
+#include "BLI_index_mask.hh"
+
 #include "BKE_geometry_set.hh"
 
+#include "DNA_viewer_path_types.h"
+
 struct ARegionType;
 struct Depsgraph;
 struct Object;
@@ -26,6 +30,22 @@ struct ReorderColumnVisualizationData {
   int current_offset_x_px = 0;
 };
 
+/**
+ * Rows that passed the filters in the last redraw. Filtering millions of rows again on every
+ * redraw, e.g. while scrolling, makes the editor unusable, so this is only recomputed when the
+ * displayed data or the filters change.
+ */
+struct SpreadsheetRowFilterCache {
+  /** Describes the data and filters that the mask was computed for, see #row_filter_cache_key. */
+  std::string key;
+  /** The viewer path is compared separately, because it can't be part of the key easily. */
+  ViewerPath viewer_path = {};
+  IndexMaskMemory memory;
+  IndexMask mask;
+
+  ~SpreadsheetRowFilterCache();
+};
+
 struct SpaceSpreadsheet_Runtime {
  public:
   int visible_rows = 0;
@@ -36,6 +56,8 @@ struct SpaceSpreadsheet_Runtime {
 
   std::optional<ReorderColumnVisualizationData> reorder_column_visualization_data;
 
+  std::unique_ptr<SpreadsheetRowFilterCache> row_filter_cache;
+
   SpaceSpreadsheet_Runtime() = default;
 
   SpaceSpreadsheet_Runtime(const SpaceSpreadsheet_Runtime &other)
@@ -10,8 +10,10 @@
 #include "DNA_space_types.h"
 
 #include "BKE_instances.hh"
+#include "BKE_viewer_path.hh"
 
 #include "spreadsheet_data_source_geometry.hh"
+#include "spreadsheet_intern.hh"
 #include "spreadsheet_layout.hh"
 #include "spreadsheet_row_filter.hh"
 
@@ -355,22 +357,97 @@ static bool use_selection_filter(const SpaceSpreadsheet &sspreadsheet,
   return true;
 }
 
+SpreadsheetRowFilterCache::~SpreadsheetRowFilterCache()
+{
+  BKE_viewer_path_clear(&this->viewer_path);
+}
+
+template<typename T> static void key_append(std::string &key, const T &value)
+{
+  static_assert(std::is_trivially_copyable_v<T>);
+  key.append(reinterpret_cast<const char *>(&value), sizeof(T));
+}
+
+/**
+ * Build a key that changes whenever the filtered rows may change. Besides the settings of the
+ * editor and the filters, this contains the data pointers of filtered columns, which catches
+ * most changes of the displayed geometry that don't go through the depsgraph.
+ */
+static std::string row_filter_cache_key(const SpaceSpreadsheet &sspreadsheet,
+                                        const SpreadsheetLayout &spreadsheet_layout,
+                                        const DataSource &data_source,
+                                        const uint64_t data_version)
+{
+  std::string key;
+  key_append(key, data_version);
+  key_append(key, data_source.tot_rows());
+  key_append(key, sspreadsheet.filter_flag);
+  key_append(key, sspreadsheet.geometry_component_type);
+  key_append(key, sspreadsheet.attribute_domain);
+  key_append(key, sspreadsheet.object_eval_state);
+  key_append(key, sspreadsheet.active_layer_index);
+  for (const int i : IndexRange(sspreadsheet.instance_ids_num)) {
+    key_append(key, sspreadsheet.instance_ids[i].reference_index);
+  }
+  if (!use_row_filters(sspreadsheet)) {
+    return key;
+  }
+  LISTBASE_FOREACH (const SpreadsheetRowFilter *, row_filter, &sspreadsheet.row_filters) {
+    if (!(row_filter->flag & SPREADSHEET_ROW_FILTER_ENABLED)) {
+      continue;
+    }
+    /* Copy the filter to skip the pointers and the UI flags. */
+    SpreadsheetRowFilter filter = *row_filter;
+    filter.next = filter.prev = nullptr;
+    filter.value_string = nullptr;
+    filter.flag = 0;
+    key_append(key, filter);
+    if (row_filter->value_string) {
+      key.append(row_filter->value_string);
+    }
+    key.push_back('\0');
+    for (const ColumnLayout &column : spreadsheet_layout.columns) {
+      if (column.values->name() == row_filter->column_name) {
+        const GVArray &data = column.values->data();
+        key_append(key, data.is_span() ? data.get_internal_span().data() : nullptr);
+      }
+    }
+  }
+  return key;
+}
+
 IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
                                   const SpreadsheetLayout &spreadsheet_layout,
                                   const DataSource &data_source,
-                                  ResourceScope &scope)
+                                  const uint64_t data_version)
 {
   const int tot_rows = data_source.tot_rows();
 
   const bool use_selection = use_selection_filter(sspreadsheet, data_source);
   const bool use_filters = use_row_filters(sspreadsheet);
 
+  SpaceSpreadsheet_Runtime &runtime = *sspreadsheet.runtime;
+
   /* Avoid allocating an array if no row filtering is necessary. */
   if (!(use_filters || use_selection)) {
+    runtime.row_filter_cache.reset();
     return IndexMask(tot_rows);
   }
 
-  IndexMaskMemory &mask_memory = scope.construct<IndexMaskMemory>();
+  std::string key = row_filter_cache_key(
+      sspreadsheet, spreadsheet_layout, data_source, data_version);
+  if (runtime.row_filter_cache && runtime.row_filter_cache->key == key &&
+      BKE_viewer_path_equal(&runtime.row_filter_cache->viewer_path, &sspreadsheet.viewer_path))
+  {
+    return runtime.row_filter_cache->mask;
+  }
+
+  runtime.row_filter_cache = std::make_unique<SpreadsheetRowFilterCache>();
+  SpreadsheetRowFilterCache &cache = *runtime.row_filter_cache;
+  cache.key = std::move(key);
+  BKE_viewer_path_copy(&cache.viewer_path, &sspreadsheet.viewer_path);
+
+  IndexMaskMemory &mask_memory = cache.memory;
   IndexMask mask(tot_rows);
 
   if (use_selection) {
@@ -395,6 +472,7 @@ IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
     }
   }
 
+  cache.mask = mask;
   return mask;
 }
 
@@ -4,17 +4,22 @@
 
 #pragma once
 
-#include "BLI_resource_scope.hh"
-
 #include "spreadsheet_data_source.hh"
 #include "spreadsheet_layout.hh"
 
 namespace blender::ed::spreadsheet {
 
+/**
+ * Get the rows that pass the selection and row filters. The result is cached in the space
+ * runtime and only computed again when the filters or the data change.
+ *
+ * \param data_version: Changes whenever the displayed data may have changed, e.g. the update
+ * count of the depsgraph.
+ */
 IndexMask spreadsheet_filter_rows(const SpaceSpreadsheet &sspreadsheet,
                                   const SpreadsheetLayout &spreadsheet_layout,
                                   const DataSource &data_source,
-                                  ResourceScope &scope);
+                                  uint64_t data_version);
 
 SpreadsheetRowFilter *spreadsheet_row_filter_new();
 SpreadsheetRowFilter *spreadsheet_row_filter_copy(const SpreadsheetRowFilter *src_row_filter);
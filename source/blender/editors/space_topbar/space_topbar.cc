@@ -254,6 +254,21 @@ static void undo_history_draw_menu(const bContext *C, Menu *menu)
                i);
     undo_step_count += 1;
   }
+
+  if (U.undomemory_resident != 0) {
+    UndoStackMemoryStats stats;
+    BKE_undosys_stack_memory_stats(wm->undo_stack, &stats);
+    char resident_str[BLI_STR_FORMAT_INT64_BYTE_UNIT_SIZE];
+    char spilled_str[BLI_STR_FORMAT_INT64_BYTE_UNIT_SIZE];
+    BLI_str_format_byte_unit(resident_str, int64_t(stats.resident_size), false);
+    BLI_str_format_byte_unit(spilled_str, int64_t(stats.spilled_size), false);
+    char label[128];
+    SNPRINTF(label, IFACE_("Memory: %s, On Disk: %s"), resident_str, spilled_str);
+    menu->layout->separator();
+    uiLayout *row = &menu->layout->row(false);
+    uiLayoutSetEnabled(row, false);
+    row->label(label, ICON_NONE);
+  }
 }
 
 static void undo_history_menu_register()
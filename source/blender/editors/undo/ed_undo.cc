@@ -141,6 +141,11 @@ void ED_undo_push(bContext *C, const char *str)
     BKE_undosys_stack_limit_steps_and_memory(wm->undo_stack, -1, memory_limit);
   }
 
+  if (U.undomemory_resident != 0) {
+    const size_t memory_limit = size_t(U.undomemory_resident) * 1024 * 1024;
+    BKE_undosys_stack_limit_resident_memory(wm->undo_stack, memory_limit);
+  }
+
   if (CLOG_CHECK(&LOG, 1)) {
     BKE_undosys_print(wm->undo_stack);
   }
@@ -80,6 +80,10 @@ static bool memfile_undosys_step_encode(bContext * /*C*/, Main *bmain, UndoStep
   /* can be null, use when set. */
   MemFileUndoStep *us_prev = (MemFileUndoStep *)BKE_undosys_step_find_by_type(
       ustack, BKE_UNDOSYS_TYPE_MEMFILE);
+  if (us_prev) {
+    /* Its chunks are compared with the new ones. */
+    BKE_undosys_step_restore(&us_prev->step);
+  }
   us->data = BKE_memfile_undo_encode(bmain, us_prev ? us_prev->data : nullptr);
   us->step.data_size = us->data->undo_size;
 
@@ -321,6 +325,29 @@ static void memfile_undosys_step_free(UndoStep *us_p)
   BKE_memfile_undo_free(us->data);
 }
 
+static void memfile_undosys_step_compress(UndoStep *us_p, const char *spill_filepath)
+{
+  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  MemFile *memfile = &us->data->memfile;
+  if (spill_filepath == nullptr) {
+    if (!BLO_memfile_compress(memfile)) {
+      return;
+    }
+  }
+  else if (!BLO_memfile_spill(memfile, spill_filepath)) {
+    return;
+  }
+  us_p->compressed_data_size = memfile->compressed_storage->size;
+  us_p->compressed_size = memfile->compressed_storage->compressed_size;
+  us_p->is_spilled = spill_filepath != nullptr;
+}
+
+static void memfile_undosys_step_restore(UndoStep *us_p)
+{
+  MemFileUndoStep *us = (MemFileUndoStep *)us_p;
+  BLO_memfile_restore(&us->data->memfile);
+}
+
 void ED_memfile_undosys_type(UndoType *ut)
 {
   ut->name = "Global Undo";
@@ -328,6 +355,8 @@ void ED_memfile_undosys_type(UndoType *ut)
   ut->step_encode = memfile_undosys_step_encode;
   ut->step_decode = memfile_undosys_step_decode;
   ut->step_free = memfile_undosys_step_free;
+  ut->step_compress = memfile_undosys_step_compress;
+  ut->step_restore = memfile_undosys_step_restore;
 
   ut->flags = 0;
 
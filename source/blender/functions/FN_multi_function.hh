@@ -138,6 +138,15 @@ class MultiFunction : NonCopyable, NonMovable {
   virtual ExecutionHints get_execution_hints() const;
 };
 
+/**
+ * Add the parameters for evaluating a multi-function on a part of the full data. The slice of
+ * every parameter starts at the beginning of the given range. Only single values are supported.
+ */
+void add_sliced_parameters(const Signature &signature,
+                           Params &full_params,
+                           IndexRange slice_range,
+                           ParamsBuilder &r_sliced_params);
+
 inline ParamsBuilder::ParamsBuilder(const MultiFunction &fn, const IndexMask *mask)
     : ParamsBuilder(fn.signature(), *mask)
 {
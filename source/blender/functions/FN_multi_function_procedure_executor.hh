@@ -17,6 +17,11 @@ class ProcedureExecutor : public MultiFunction {
  private:
   Signature signature_;
   const Procedure &procedure_;
+  /**
+   * When not zero, large masks are split into chunks of this size that are evaluated one after
+   * another, so that the intermediate values stay in the CPU cache.
+   */
+  int64_t chunk_size_ = 0;
 
  public:
   ProcedureExecutor(const Procedure &procedure);
@@ -49,11 +49,17 @@
 #include "BLI_stack.hh"
 #include "BLI_task.h"
 #include "BLI_task.hh"
+#include "BLI_timeit.hh"
 
 #include "FN_lazy_function_graph_executor.hh"
 
 namespace blender::fn::lazy_function {
 
+/**
+ * Nodes that take longer than this to execute are distributed to other threads more eagerly.
+ */
+static constexpr timeit::Nanoseconds expensive_node_duration = std::chrono::microseconds(50);
+
 enum class NodeScheduleState : uint8_t {
   /**
    * Default state of every node.
@@ -284,6 +290,13 @@ struct CurrentTask {
    * mutex.
    */
   std::atomic<bool> has_scheduled_nodes = false;
+  /**
+   * Other threads can only access the scheduled nodes while a node that enabled multi-threading
+   * is running in this task, or after the nodes have been pushed to the task pool. Before that,
+   * #mutex does not have to be locked even when the executor is multi-threaded. This avoids the
+   * locking overhead for the many cheap nodes that are scheduled and run by the same thread.
+   */
+  bool is_shared = false;
 };
 
 class Executor {
@@ -741,7 +754,7 @@ class Executor {
       case NodeScheduleState::NotScheduled: {
         locked_node.node_state.schedule_state = NodeScheduleState::Scheduled;
         const FunctionNode &node = static_cast<const FunctionNode &>(locked_node.node);
-        if (this->use_multi_threading()) {
+        if (current_task.is_shared) {
           std::lock_guard lock{current_task.mutex};
           current_task.scheduled_nodes.schedule(node, is_priority);
         }
@@ -811,11 +824,17 @@ class Executor {
       if (current_task.scheduled_nodes.is_empty()) {
         current_task.has_scheduled_nodes.store(false, std::memory_order_relaxed);
       }
+      const timeit::TimePoint start_time = timeit::Clock::now();
       this->run_node_task(*node, current_task, local_data);
+      const timeit::Nanoseconds duration = timeit::Clock::now() - start_time;
 
       /* If there are many nodes scheduled at the same time, it's beneficial to let multiple
-       * threads work on those. */
-      if (current_task.scheduled_nodes.nodes_num() > 128) {
+       * threads work on those. When nodes are expensive, like the bodies of a for-each zone which
+       * are often scheduled together, even two nodes are worth to be split up because the
+       * threading overhead is negligible compared to their execution time. The duration of the
+       * last node is used as estimate for the cost of the other scheduled nodes. */
+      const int64_t split_threshold = duration > expensive_node_duration ? 1 : 128;
+      if (current_task.scheduled_nodes.nodes_num() > split_threshold) {
         if (this->try_enable_multi_threading()) {
           std::unique_ptr<ScheduledNodes> split_nodes = std::make_unique<ScheduledNodes>();
           current_task.scheduled_nodes.split_into(*split_nodes);
@@ -837,108 +856,143 @@ class Executor {
     bool node_needs_execution = false;
     this->with_locked_node(
         node, node_state, current_task, local_data, [&](LockedNode &locked_node) {
-          BLI_assert(node_state.schedule_state == NodeScheduleState::Scheduled);
-          node_state.schedule_state = NodeScheduleState::Running;
-
-          if (node_state.node_has_finished) {
-            return;
+          node_needs_execution = this->prepare_node_execution(locked_node);
+          if (!node_needs_execution) {
+            /* Finish the run right away, instead of locking the node again below. This is common
+             * for cheap nodes that are only scheduled to notice that inputs became unused or are
+             * still missing. */
+            this->finish_node_run(locked_node, false, current_task, local_data);
           }
+        });
 
-          bool required_uncomputed_output_exists = false;
-          for (const int output_index : node.outputs().index_range()) {
-            OutputState &output_state = node_state.outputs[output_index];
-            output_state.usage_for_execution = output_state.usage;
-            if (output_state.usage == ValueUsage::Used && !output_state.has_been_computed) {
-              required_uncomputed_output_exists = true;
-            }
-          }
-          if (!required_uncomputed_output_exists && !node_state.has_side_effects) {
-            return;
-          }
+    if (!node_needs_execution) {
+      return;
+    }
 
-          if (!node_state.always_used_inputs_requested) {
-            /* Request linked inputs that are always needed. */
-            const Span<Input> fn_inputs = fn.inputs();
-            for (const int input_index : fn_inputs.index_range()) {
-              const Input &fn_input = fn_inputs[input_index];
-              if (fn_input.usage == ValueUsage::Used) {
-                const InputSocket &input_socket = node.input(input_index);
-                if (input_socket.origin() != nullptr) {
-                  this->set_input_required(locked_node, input_socket);
-                }
-              }
-            }
+    if (!node_state.storage_and_defaults_initialized) {
+      /* Initialize storage. */
+      node_state.storage = fn.init_storage(allocator);
 
-            node_state.always_used_inputs_requested = true;
-          }
+      /* Load unlinked inputs. */
+      for (const int input_index : node.inputs().index_range()) {
+        const InputSocket &input_socket = node.input(input_index);
+        if (input_socket.origin() != nullptr) {
+          continue;
+        }
+        InputState &input_state = node_state.inputs[input_index];
+        const CPPType &type = input_socket.type();
+        const void *default_value = input_socket.default_value();
+        BLI_assert(default_value != nullptr);
+        if (self_.logger_ != nullptr) {
+          self_.logger_->log_socket_value(input_socket, {type, default_value}, local_context);
+        }
+        BLI_assert(input_state.value == nullptr);
+        input_state.value = allocator.allocate(type);
+        type.copy_construct(default_value, input_state.value);
+        input_state.was_ready_for_execution = true;
+      }
 
-          for (const int input_index : node.inputs().index_range()) {
-            InputState &input_state = node_state.inputs[input_index];
-            if (input_state.was_ready_for_execution) {
-              continue;
-            }
-            if (input_state.value != nullptr) {
-              input_state.was_ready_for_execution = true;
-              continue;
-            }
-            if (!fn.allow_missing_requested_inputs()) {
-              if (input_state.usage == ValueUsage::Used) {
-                return;
-              }
-            }
-          }
+      node_state.storage_and_defaults_initialized = true;
+    }
+
+    /* Importantly, the node must not be locked when it is executed. That would result in locks
+     * being hold very long in some cases and results in multiple locks being hold by the same
+     * thread in the same graph which can lead to deadlocks. */
+    this->execute_node(node, node_state, current_task, local_data);
 
-          node_needs_execution = true;
+    this->with_locked_node(
+        node, node_state, current_task, local_data, [&](LockedNode &locked_node) {
+          this->finish_node_run(locked_node, true, current_task, local_data);
         });
+  }
+
+  /**
+   * Start running a scheduled node and request the inputs that it definitely needs.
+   * \return True when the node function has to be executed.
+   */
+  bool prepare_node_execution(LockedNode &locked_node)
+  {
+    const FunctionNode &node = static_cast<const FunctionNode &>(locked_node.node);
+    NodeState &node_state = locked_node.node_state;
+    const LazyFunction &fn = node.function();
 
-    if (node_needs_execution) {
-      if (!node_state.storage_and_defaults_initialized) {
-        /* Initialize storage. */
-        node_state.storage = fn.init_storage(allocator);
+    BLI_assert(node_state.schedule_state == NodeScheduleState::Scheduled);
+    node_state.schedule_state = NodeScheduleState::Running;
 
-        /* Load unlinked inputs. */
-        for (const int input_index : node.inputs().index_range()) {
+    if (node_state.node_has_finished) {
+      return false;
+    }
+
+    bool required_uncomputed_output_exists = false;
+    for (const int output_index : node.outputs().index_range()) {
+      OutputState &output_state = node_state.outputs[output_index];
+      output_state.usage_for_execution = output_state.usage;
+      if (output_state.usage == ValueUsage::Used && !output_state.has_been_computed) {
+        required_uncomputed_output_exists = true;
+      }
+    }
+    if (!required_uncomputed_output_exists && !node_state.has_side_effects) {
+      return false;
+    }
+
+    if (!node_state.always_used_inputs_requested) {
+      /* Request linked inputs that are always needed. */
+      const Span<Input> fn_inputs = fn.inputs();
+      for (const int input_index : fn_inputs.index_range()) {
+        const Input &fn_input = fn_inputs[input_index];
+        if (fn_input.usage == ValueUsage::Used) {
           const InputSocket &input_socket = node.input(input_index);
           if (input_socket.origin() != nullptr) {
-            continue;
-          }
-          InputState &input_state = node_state.inputs[input_index];
-          const CPPType &type = input_socket.type();
-          const void *default_value = input_socket.default_value();
-          BLI_assert(default_value != nullptr);
-          if (self_.logger_ != nullptr) {
-            self_.logger_->log_socket_value(input_socket, {type, default_value}, local_context);
+            this->set_input_required(locked_node, input_socket);
           }
-          BLI_assert(input_state.value == nullptr);
-          input_state.value = allocator.allocate(type);
-          type.copy_construct(default_value, input_state.value);
-          input_state.was_ready_for_execution = true;
         }
-
-        node_state.storage_and_defaults_initialized = true;
       }
 
-      /* Importantly, the node must not be locked when it is executed. That would result in locks
-       * being hold very long in some cases and results in multiple locks being hold by the same
-       * thread in the same graph which can lead to deadlocks. */
-      this->execute_node(node, node_state, current_task, local_data);
+      node_state.always_used_inputs_requested = true;
     }
 
-    this->with_locked_node(
-        node, node_state, current_task, local_data, [&](LockedNode &locked_node) {
+    for (const int input_index : node.inputs().index_range()) {
+      InputState &input_state = node_state.inputs[input_index];
+      if (input_state.was_ready_for_execution) {
+        continue;
+      }
+      if (input_state.value != nullptr) {
+        input_state.was_ready_for_execution = true;
+        continue;
+      }
+      if (!fn.allow_missing_requested_inputs()) {
+        if (input_state.usage == ValueUsage::Used) {
+          return false;
+        }
+      }
+    }
+
+    return true;
+  }
+
+  /**
+   * Called at the end of every run of a node, while it is still locked.
+   */
+  void finish_node_run(LockedNode &locked_node,
+                       const bool node_was_executed,
+                       CurrentTask &current_task,
+                       const LocalData &local_data)
+  {
+    NodeState &node_state = locked_node.node_state;
 #ifndef NDEBUG
-          if (node_needs_execution) {
-            this->assert_expected_outputs_have_been_computed(locked_node, local_data);
-          }
+    if (node_was_executed) {
+      this->assert_expected_outputs_have_been_computed(locked_node, local_data);
+    }
+#else
+    UNUSED_VARS(node_was_executed, local_data);
 #endif
-          this->finish_node_if_possible(locked_node);
-          const bool reschedule_requested = node_state.schedule_state ==
-                                            NodeScheduleState::RunningAndRescheduled;
-          node_state.schedule_state = NodeScheduleState::NotScheduled;
-          if (reschedule_requested && !node_state.node_has_finished) {
-            this->schedule_node(locked_node, current_task, false);
-          }
-        });
+    this->finish_node_if_possible(locked_node);
+    const bool reschedule_requested = node_state.schedule_state ==
+                                      NodeScheduleState::RunningAndRescheduled;
+    node_state.schedule_state = NodeScheduleState::NotScheduled;
+    if (reschedule_requested && !node_state.node_has_finished) {
+      this->schedule_node(locked_node, current_task, false);
+    }
   }
 
   void assert_expected_outputs_have_been_computed(LockedNode &locked_node,
@@ -1262,7 +1316,10 @@ class Executor {
     BLI_assert(this->use_multi_threading());
     std::unique_ptr<ScheduledNodes> scheduled_nodes = std::make_unique<ScheduledNodes>();
     {
-      std::lock_guard lock{current_task.mutex};
+      std::unique_lock lock{current_task.mutex, std::defer_lock};
+      if (current_task.is_shared) {
+        lock.lock();
+      }
       if (current_task.scheduled_nodes.is_empty()) {
         return;
       }
@@ -1409,6 +1466,10 @@ class GraphExecutorLFParams final : public Params {
     const bool success = executor_.try_enable_multi_threading();
     if (success) {
       node_state_.enabled_multi_threading = true;
+      /* The node may call these params from other threads now, which may schedule nodes. */
+      if (!current_task_.is_shared) {
+        current_task_.is_shared = true;
+      }
     }
     return success;
   }
@@ -1426,6 +1487,10 @@ inline void Executor::execute_node(const FunctionNode &node,
 {
   const LazyFunction &fn = node.function();
   GraphExecutorLFParams node_params{fn, *this, node, node_state, current_task, local_data};
+  if (node_state.enabled_multi_threading) {
+    /* Multi-threading was enabled in a previous execution of the node already. */
+    current_task.is_shared = true;
+  }
 
   Context fn_context(node_state.storage, context_->user_data, local_data.local_user_data);
 
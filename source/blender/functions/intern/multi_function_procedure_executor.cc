@@ -4,6 +4,7 @@
 
 #include "FN_multi_function_procedure_executor.hh"
 
+#include "BLI_math_base.h"
 #include "BLI_stack.hh"
 
 namespace blender::fn::multi_function {
@@ -17,6 +18,27 @@ ProcedureExecutor::ProcedureExecutor(const Procedure &procedure) : procedure_(pr
   }
 
   this->set_signature(&signature_);
+
+  /* Evaluate procedures that have intermediate values in chunks that are small enough for all
+   * the values to fit into the (L1 or L2) cache. This is a conservative estimate that assumes
+   * that all variables are alive at the same time. Vector parameters can't be sliced. */
+  const bool has_vector_params = std::any_of(
+      procedure.params().begin(), procedure.params().end(), [](const ConstParameter &param) {
+        return param.variable->data_type().is_vector();
+      });
+  if (!has_vector_params && procedure.variables().size() > procedure.params().size()) {
+    int64_t bytes_per_element = 0;
+    for (const Variable *variable : procedure.variables()) {
+      const DataType data_type = variable->data_type();
+      bytes_per_element += data_type.is_single() ? data_type.single_type().size :
+                                                   data_type.vector_base_type().size;
+    }
+    const int64_t cache_size = 64 * 1024;
+    const int64_t chunk_size = std::clamp<int64_t>(
+        cache_size / std::max<int64_t>(bytes_per_element, 1), 256, 4096);
+    /* Round down to a multiple of 64 to keep the chunks aligned. */
+    chunk_size_ = chunk_size & ~int64_t(63);
+  }
 }
 
 using IndicesSplitVectors = std::array<Vector<int64_t>, 2>;
@@ -148,9 +170,20 @@ class ValueAllocator : NonCopyable, NonMovable {
   Stack<void *> small_single_value_free_list_;
   Map<const CPPType *, Stack<void *>> single_value_free_lists_;
 
+  /**
+   * Minimum number of elements of every span buffer. This allows reusing buffers when the
+   * allocator is used for multiple masks with different sizes.
+   */
+  int64_t min_span_size_ = 0;
+
  public:
   ValueAllocator(LinearAllocator<> &linear_allocator) : linear_allocator_(linear_allocator) {}
 
+  void set_min_span_size(const int64_t size)
+  {
+    min_span_size_ = size;
+  }
+
   VariableValue_GVArray *obtain_GVArray(const GVArray &varray)
   {
     return this->obtain<VariableValue_GVArray>(varray);
@@ -169,6 +202,7 @@ class ValueAllocator : NonCopyable, NonMovable {
   VariableValue_Span *obtain_Span(const CPPType &type, int size)
   {
     void *buffer = nullptr;
+    size = std::max<int64_t>(size, min_span_size_);
 
     const int64_t element_size = type.size;
     const int64_t alignment = type.alignment;
@@ -813,17 +847,17 @@ class VariableState : NonCopyable, NonMovable {
 /** Keeps track of the states of all variables during evaluation. */
 class VariableStates {
  private:
-  ValueAllocator value_allocator_;
+  ValueAllocator &value_allocator_;
   const Procedure &procedure_;
   /** The state of every variable, indexed by #Variable::index_in_procedure(). */
   Array<VariableState> variable_states_;
   const IndexMask &full_mask_;
 
  public:
-  VariableStates(LinearAllocator<> &linear_allocator,
+  VariableStates(ValueAllocator &value_allocator,
                  const Procedure &procedure,
                  const IndexMask &full_mask)
-      : value_allocator_(linear_allocator),
+      : value_allocator_(value_allocator),
         procedure_(procedure),
         variable_states_(procedure.variables().size()),
         full_mask_(full_mask)
@@ -1157,19 +1191,18 @@ class InstructionScheduler {
   }
 };
 
-void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+static void execute_procedure(const ProcedureExecutor &fn,
+                              const Procedure &procedure,
+                              const IndexMask &full_mask,
+                              Params params,
+                              const Context &context,
+                              ValueAllocator &value_allocator)
 {
-  BLI_assert(procedure_.validate());
-
-  AlignedBuffer<512, 64> local_buffer;
-  LinearAllocator<> linear_allocator;
-  linear_allocator.provide_buffer(local_buffer);
-
-  VariableStates variable_states{linear_allocator, procedure_, full_mask};
-  variable_states.add_initial_variable_states(*this, procedure_, params);
+  VariableStates variable_states{value_allocator, procedure, full_mask};
+  variable_states.add_initial_variable_states(fn, procedure, params);
 
   InstructionScheduler scheduler;
-  scheduler.add_referenced_indices(*procedure_.entry(), full_mask);
+  scheduler.add_referenced_indices(*procedure.entry(), full_mask);
 
   /* Loop until all indices got to a return instruction. */
   while (!scheduler.is_done()) {
@@ -1218,9 +1251,9 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
     }
   }
 
-  for (const int param_index : this->param_indices()) {
-    const ParamType param_type = this->param_type(param_index);
-    const Variable *variable = procedure_.params()[param_index].variable;
+  for (const int param_index : fn.param_indices()) {
+    const ParamType param_type = fn.param_type(param_index);
+    const Variable *variable = procedure.params()[param_index].variable;
     VariableState &variable_state = variable_states.get_variable_state(*variable);
     switch (param_type.interface_type()) {
       case ParamType::Input: {
@@ -1241,6 +1274,50 @@ void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context
   }
 }
 
+void ProcedureExecutor::call(const IndexMask &full_mask, Params params, Context context) const
+{
+  BLI_assert(procedure_.validate());
+
+  AlignedBuffer<512, 64> local_buffer;
+  LinearAllocator<> linear_allocator;
+  linear_allocator.provide_buffer(local_buffer);
+  ValueAllocator value_allocator{linear_allocator};
+
+  if (chunk_size_ == 0 || full_mask.size() <= chunk_size_) {
+    execute_procedure(*this, procedure_, full_mask, params, context, value_allocator);
+    return;
+  }
+
+  /* Evaluate the whole procedure for one chunk after another. The indices of each chunk are
+   * shifted to start at zero, so that the buffers for intermediate values are small and can be
+   * reused for all chunks. */
+  const int64_t chunks_num = divide_ceil_ul(full_mask.size(), chunk_size_);
+  auto chunk_range = [&](const int64_t chunk_i) {
+    return IndexRange::from_begin_end(chunk_i * chunk_size_,
+                                      std::min((chunk_i + 1) * chunk_size_, full_mask.size()));
+  };
+  int64_t max_chunk_array_size = 0;
+  for (const int64_t chunk_i : IndexRange(chunks_num)) {
+    const IndexRange range = chunk_range(chunk_i);
+    max_chunk_array_size = std::max(max_chunk_array_size,
+                                    full_mask[range.last()] - full_mask[range.first()] + 1);
+  }
+  value_allocator.set_min_span_size(max_chunk_array_size);
+
+  for (const int64_t chunk_i : IndexRange(chunks_num)) {
+    const IndexRange range = chunk_range(chunk_i);
+    const int64_t offset = full_mask[range.first()];
+    const IndexRange array_range = IndexRange::from_begin_end_inclusive(offset,
+                                                                        full_mask[range.last()]);
+
+    IndexMaskMemory memory;
+    const IndexMask chunk_mask = full_mask.slice_and_shift(range, -offset, memory);
+    ParamsBuilder chunk_params{*this, &chunk_mask};
+    add_sliced_parameters(signature_, params, array_range, chunk_params);
+    execute_procedure(*this, procedure_, chunk_mask, chunk_params, context, value_allocator);
+  }
+}
+
 MultiFunction::ExecutionHints ProcedureExecutor::get_execution_hints() const
 {
   ExecutionHints hints;
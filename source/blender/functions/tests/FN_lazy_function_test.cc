@@ -9,6 +9,7 @@
 #include "FN_lazy_function_graph_executor.hh"
 
 #include "BLI_task.h"
+#include "BLI_task.hh"
 
 namespace blender::fn::lazy_function::tests {
 
@@ -178,4 +179,69 @@ TEST(lazy_function, GraphWithCycle)
   EXPECT_EQ(result, 10 * 2 * 5);
 }
 
+class ParallelSumFunction : public LazyFunction {
+ public:
+  ParallelSumFunction(const int inputs_num)
+  {
+    debug_name_ = "Parallel Sum";
+    allow_missing_requested_inputs_ = true;
+    for ([[maybe_unused]] const int i : IndexRange(inputs_num)) {
+      inputs_.append_as("Value", CPPType::get<int>(), ValueUsage::Maybe);
+    }
+    outputs_.append_as("Sum", CPPType::get<int>());
+  }
+
+  void execute_impl(Params &params, const Context & /*context*/) const override
+  {
+    /* Request the inputs from many threads, which schedules their origin nodes concurrently. */
+    params.try_enable_multi_threading();
+    std::atomic<bool> all_inputs_available = true;
+    std::atomic<int> sum = 0;
+    threading::parallel_for(inputs_.index_range(), 16, [&](const IndexRange range) {
+      for (const int i : range) {
+        if (const int *value = params.try_get_input_data_ptr_or_request<int>(i)) {
+          sum += *value;
+        }
+        else {
+          all_inputs_available = false;
+        }
+      }
+    });
+    if (all_inputs_available) {
+      params.set_output(0, sum.load());
+    }
+  }
+};
+
+TEST(lazy_function, ManyNodesMultiThreaded)
+{
+  BLI_task_scheduler_init();
+  const int nodes_num = 1000;
+  const AddLazyFunction add_fn;
+  const ParallelSumFunction sum_fn{nodes_num};
+
+  Graph graph;
+  GraphInputSocket &input_socket = graph.add_input(CPPType::get<int>());
+  GraphOutputSocket &output_socket = graph.add_output(CPPType::get<int>());
+  FunctionNode &sum_node = graph.add_function(sum_fn);
+  graph.add_link(sum_node.output(0), output_socket);
+
+  Array<int> values(nodes_num);
+  for (const int i : IndexRange(nodes_num)) {
+    values[i] = i;
+    FunctionNode &add_node = graph.add_function(add_fn);
+    add_node.input(1).set_default_value(&values[i]);
+    graph.add_link(input_socket, add_node.input(0));
+    graph.add_link(add_node.output(0), sum_node.input(i));
+  }
+  graph.update_node_indices();
+
+  GraphExecutor executor_fn{graph, {&input_socket}, {&output_socket}, nullptr, nullptr, nullptr};
+  int result = 0;
+  execute_lazy_function_eagerly(
+      executor_fn, nullptr, nullptr, std::make_tuple(3), std::make_tuple(&result));
+
+  EXPECT_EQ(result, nodes_num * 3 + (nodes_num - 1) * nodes_num / 2);
+}
+
 }  // namespace blender::fn::lazy_function::tests
@@ -96,6 +96,55 @@ TEST(multi_function_procedure, SimpleTest)
   EXPECT_EQ(output_array[2], 19);
 }
 
+TEST(multi_function_procedure, ChunkedExecution)
+{
+  /**
+   * procedure(int var1, int *var3) {
+   *   int var2 = var1 + var1;
+   *   var3 = var2 + var1;
+   * }
+   */
+
+  auto add_fn = mf::build::SI2_SO<int, int, int>("add", [](int a, int b) { return a + b; });
+
+  Procedure procedure;
+  ProcedureBuilder builder{procedure};
+
+  Variable *var1 = &builder.add_single_input_parameter<int>();
+  auto [var2] = builder.add_call<1>(add_fn, {var1, var1});
+  auto [var3] = builder.add_call<1>(add_fn, {var2, var1});
+  builder.add_destruct({var1, var2});
+  builder.add_return();
+  builder.add_output_parameter(*var3);
+
+  EXPECT_TRUE(procedure.validate());
+
+  ProcedureExecutor executor{procedure};
+
+  /* Large enough to be split into multiple chunks. */
+  const int64_t size = 100'000;
+  IndexMaskMemory memory;
+  const IndexMask mask = IndexMask::from_predicate(
+      IndexRange(size), GrainSize(1024), memory, [](const int64_t i) { return i % 3 != 0; });
+  ParamsBuilder params{executor, &mask};
+  ContextBuilder context;
+
+  Array<int> input_array(size);
+  for (const int64_t i : input_array.index_range()) {
+    input_array[i] = int(i);
+  }
+  params.add_readonly_single_input(input_array.as_span());
+
+  Array<int> output_array(size, -1);
+  params.add_uninitialized_single_output(output_array.as_mutable_span());
+
+  executor.call(mask, params, context);
+
+  for (const int64_t i : output_array.index_range()) {
+    EXPECT_EQ(output_array[i], i % 3 != 0 ? int(i) * 3 : -1);
+  }
+}
+
 TEST(multi_function_procedure, BranchTest)
 {
   /**
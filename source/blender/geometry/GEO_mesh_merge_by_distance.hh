@@ -28,6 +28,20 @@ std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
                                                  const IndexMask &selection,
                                                  float merge_distance);
 
+/**
+ * Merge every cluster of selected vertices that are connected through distances within
+ * \a merge_distance into the vertex of the cluster with the lowest index. Unlike
+ * #mesh_merge_by_distance_all, vertices further apart than the merge distance end up in the same
+ * cluster when they are chained together by other vertices. The clusters are found in parallel
+ * and don't depend on the number of threads or the order of the vertices in space.
+ *
+ * \returns #std::nullopt if the mesh should not be changed (no vertices are merged), in order to
+ * avoid copying the input. Otherwise returns the new mesh with merged geometry.
+ */
+std::optional<Mesh *> mesh_merge_by_distance_clusters(const Mesh &mesh,
+                                                      const IndexMask &selection,
+                                                      float merge_distance);
+
 /**
  * Merge selected vertices along edges to other selected vertices. Only vertices connected by edges
  * are considered for merging.
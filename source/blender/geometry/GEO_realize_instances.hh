@@ -70,4 +70,23 @@ bke::GeometrySet realize_instances(bke::GeometrySet geometry_set,
                                    const RealizeInstancesOptions &options,
                                    const VariedDepthOptions &varied_depth_option);
 
+/**
+ * Get the values of an attribute on all geometries of one type in the instance hierarchy, in the
+ * order they would have after #realize_instances, without actually realizing the instances. This
+ * is much cheaper when the realized values are only read, because the data of the instanced
+ * geometries is not copied for every instance.
+ *
+ * Positions (and curve handles) are transformed by the instance transforms when they are
+ * accessed. Other attributes, including the id attribute, are read unchanged, attributes stored
+ * on the instances themselves are ignored, and geometries without the attribute use the default
+ * value of the type.
+ *
+ * Only meshes, point clouds and curves are supported.
+ */
+GVArray realized_attribute(const bke::GeometrySet &geometry_set,
+                           bke::GeometryComponent::Type component_type,
+                           StringRef attribute_id,
+                           bke::AttrDomain domain,
+                           eCustomDataType data_type);
+
 }  // namespace blender::geometry
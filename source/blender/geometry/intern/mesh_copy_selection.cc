@@ -7,6 +7,7 @@
 #include "BLI_enumerable_thread_specific.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_listbase.h"
+#include "BLI_scratch_allocator.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_deform.hh"
@@ -28,7 +29,8 @@ static void remap_verts(const OffsetIndices<int> src_faces,
                         MutableSpan<int2> dst_edges,
                         MutableSpan<int> dst_corner_verts)
 {
-  Array<int> map(src_verts_num);
+  ScratchScope scratch;
+  Array<int, 0, ScratchAllocator> map(src_verts_num, scratch.allocator());
   index_mask::build_reverse_map<int>(vert_mask, map);
   threading::parallel_invoke(
       vert_mask.size() > 1024,
@@ -57,7 +59,8 @@ static void remap_edges(const OffsetIndices<int> src_faces,
                         const Span<int> src_corner_edges,
                         MutableSpan<int> dst_corner_edges)
 {
-  Array<int> map(src_edges_num);
+  ScratchScope scratch;
+  Array<int, 0, ScratchAllocator> map(src_edges_num, scratch.allocator());
   index_mask::build_reverse_map<int>(edge_mask, map);
   face_mask.foreach_index(GrainSize(512), [&](const int64_t src_i, const int64_t dst_i) {
     const IndexRange src_face = src_faces[src_i];
@@ -5,12 +5,19 @@
 // #define USE_WELD_DEBUG
 // #define USE_WELD_DEBUG_TIME
 
+#include <atomic>
+
 #include "BLI_array.hh"
+#include "BLI_atomic_disjoint_set.hh"
 #include "BLI_bit_vector.hh"
+#include "BLI_bounds.hh"
 #include "BLI_index_mask.hh"
 #include "BLI_kdtree.h"
 #include "BLI_math_vector.h"
+#include "BLI_math_vector.hh"
 #include "BLI_offset_indices.hh"
+#include "BLI_sort.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_customdata.hh"
@@ -1717,6 +1724,165 @@ std::optional<Mesh *> mesh_merge_by_distance_all(const Mesh &mesh,
   return create_merged_mesh(mesh, vert_dest_map, vert_kill_len, true);
 }
 
+/**
+ * Join all pairs of selected vertices within \a merge_distance. The vertices are sorted into a
+ * uniform grid with cells at least as large as the merge distance, so only vertices in the same
+ * and in neighboring cells have to be compared, and every cell can be processed in parallel.
+ */
+static void join_close_verts(const Span<float3> positions,
+                             const IndexMask &selection,
+                             const Bounds<float3> &bounds,
+                             const float merge_distance,
+                             AtomicDisjointSet &vert_sets)
+{
+  /* Keep the number of cells along each axis in the range of an integer, this only matters for
+   * tiny merge distances compared to the size of the mesh. The margin guards against rounding
+   * putting vertices within the merge distance in cells that aren't neighbors. */
+  const float max_extent = math::reduce_max(bounds.max - bounds.min);
+  float cell_size = std::max(merge_distance * 1.001f, max_extent / float(1 << 30));
+  if (cell_size == 0.0f) {
+    /* All vertices are at the same position. */
+    cell_size = 1.0f;
+  }
+
+  Array<int3> vert_cells(positions.size());
+  selection.foreach_index(GrainSize(4096), [&](const int i) {
+    vert_cells[i] = int3(math::floor((positions[i] - bounds.min) / cell_size));
+  });
+  const auto cell_less = [](const int3 &a, const int3 &b) {
+    if (a.x != b.x) {
+      return a.x < b.x;
+    }
+    if (a.y != b.y) {
+      return a.y < b.y;
+    }
+    return a.z < b.z;
+  };
+
+  Array<int> sorted_verts(selection.size());
+  selection.to_indices(sorted_verts.as_mutable_span());
+  parallel_sort(sorted_verts.begin(), sorted_verts.end(), [&](const int a, const int b) {
+    if (vert_cells[a] != vert_cells[b]) {
+      return cell_less(vert_cells[a], vert_cells[b]);
+    }
+    return a < b;
+  });
+
+  IndexMaskMemory memory;
+  const IndexMask cell_starts = IndexMask::from_predicate(
+      sorted_verts.index_range(), GrainSize(4096), memory, [&](const int i) {
+        return i == 0 || vert_cells[sorted_verts[i]] != vert_cells[sorted_verts[i - 1]];
+      });
+  Array<int> cell_offset_data(cell_starts.size() + 1);
+  cell_starts.to_indices(cell_offset_data.as_mutable_span().drop_back(1));
+  cell_offset_data.last() = sorted_verts.size();
+  const OffsetIndices<int> cell_offsets(cell_offset_data);
+  Array<int3> cells(cell_offsets.size());
+  threading::parallel_for(cells.index_range(), 4096, [&](const IndexRange range) {
+    for (const int cell : range) {
+      cells[cell] = vert_cells[sorted_verts[cell_offsets[cell].first()]];
+    }
+  });
+
+  /* Half of the neighborhood, so every pair of cells is only compared once. */
+  Vector<int3, 13> neighbor_offsets;
+  for (int x = -1; x <= 1; x++) {
+    for (int y = -1; y <= 1; y++) {
+      for (int z = -1; z <= 1; z++) {
+        if (cell_less(int3(0), int3(x, y, z))) {
+          neighbor_offsets.append(int3(x, y, z));
+        }
+      }
+    }
+  }
+
+  const float merge_distance_sq = merge_distance * merge_distance;
+  threading::parallel_for(cells.index_range(), 256, [&](const IndexRange range) {
+    for (const int cell : range) {
+      const Span<int> verts = sorted_verts.as_span().slice(cell_offsets[cell]);
+      for (const int i : verts.index_range()) {
+        for (const int other : verts.drop_front(i + 1)) {
+          if (math::distance_squared(positions[verts[i]], positions[other]) <= merge_distance_sq)
+          {
+            vert_sets.join(verts[i], other);
+          }
+        }
+      }
+      for (const int3 &offset : neighbor_offsets) {
+        const int3 neighbor = cells[cell] + offset;
+        const int3 *found = std::lower_bound(cells.begin(), cells.end(), neighbor, cell_less);
+        if (found == cells.end() || *found != neighbor) {
+          continue;
+        }
+        const Span<int> neighbor_verts = sorted_verts.as_span().slice(
+            cell_offsets[found - cells.begin()]);
+        for (const int vert : verts) {
+          for (const int other : neighbor_verts) {
+            if (math::distance_squared(positions[vert], positions[other]) <= merge_distance_sq) {
+              vert_sets.join(vert, other);
+            }
+          }
+        }
+      }
+    }
+  });
+}
+
+std::optional<Mesh *> mesh_merge_by_distance_clusters(const Mesh &mesh,
+                                                      const IndexMask &selection,
+                                                      const float merge_distance)
+{
+  const Span<float3> positions = mesh.vert_positions();
+  const std::optional<Bounds<float3>> bounds = bounds::min_max(selection, positions);
+  if (!bounds) {
+    return std::nullopt;
+  }
+
+  AtomicDisjointSet vert_sets(mesh.verts_num);
+  join_close_verts(positions, selection, *bounds, merge_distance, vert_sets);
+
+  /* The roots of the sets depend on the order of the joins, so every cluster is merged into its
+   * vertex with the lowest index instead, which makes the result independent of threading. */
+  Array<std::atomic<int>> cluster_first_vert(mesh.verts_num);
+  Array<std::atomic<int>> cluster_size(mesh.verts_num);
+  selection.foreach_index(GrainSize(4096), [&](const int i) {
+    cluster_first_vert[i].store(std::numeric_limits<int>::max(), std::memory_order_relaxed);
+    cluster_size[i].store(0, std::memory_order_relaxed);
+  });
+  selection.foreach_index(GrainSize(4096), [&](const int i) {
+    const int root = vert_sets.find_root(i);
+    int first_vert = cluster_first_vert[root].load(std::memory_order_relaxed);
+    while (i < first_vert && !cluster_first_vert[root].compare_exchange_weak(
+                                 first_vert, i, std::memory_order_relaxed))
+    {
+    }
+    cluster_size[root].fetch_add(1, std::memory_order_relaxed);
+  });
+
+  Array<int> vert_dest_map(mesh.verts_num, OUT_OF_CONTEXT);
+  const int vert_kill_len = threading::parallel_reduce(
+      selection.index_range(),
+      4096,
+      0,
+      [&](const IndexRange range, int kill_len) {
+        selection.slice(range).foreach_index([&](const int i) {
+          const int root = vert_sets.find_root(i);
+          if (cluster_size[root].load(std::memory_order_relaxed) > 1) {
+            vert_dest_map[i] = cluster_first_vert[root].load(std::memory_order_relaxed);
+            kill_len += int(vert_dest_map[i] != i);
+          }
+        });
+        return kill_len;
+      },
+      [](const int a, const int b) { return a + b; });
+
+  if (vert_kill_len == 0) {
+    return std::nullopt;
+  }
+
+  return create_merged_mesh(mesh, vert_dest_map, vert_kill_len, true);
+}
+
 struct WeldVertexCluster {
   float co[3];
   int merged_verts;
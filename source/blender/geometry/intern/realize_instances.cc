@@ -11,6 +11,7 @@
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_noise.hh"
+#include "BLI_scratch_allocator.hh"
 
 #include "BKE_attribute.hh"
 #include "BKE_curves.hh"
@@ -1060,7 +1061,8 @@ static void execute_instances_tasks(
     return;
   }
 
-  Array<int> offsets_data(src_components.size() + 1);
+  ScratchScope scratch;
+  Array<int, 0, ScratchAllocator> offsets_data(src_components.size() + 1, scratch.allocator());
   for (const int component_index : src_components.index_range()) {
     const bke::InstancesComponent &src_component = static_cast<const bke::InstancesComponent &>(
         *src_components[component_index]);
@@ -1091,7 +1093,7 @@ static void execute_instances_tasks(
     const blender::float4x4 &src_base_transform = src_base_transforms[component_index];
     const Span<const void *> attribute_fallback_array = attribute_fallback[component_index].array;
     const Span<bke::InstanceReference> src_references = src_instances.references();
-    Array<int> handle_map(src_references.size());
+    Array<int, 0, ScratchAllocator> handle_map(src_references.size(), scratch.allocator());
 
     for (const int src_handle : src_references.index_range()) {
       handle_map[src_handle] = dst_instances->add_reference(src_references[src_handle]);
@@ -2580,4 +2582,200 @@ bke::GeometrySet realize_instances(bke::GeometrySet geometry_set,
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Virtual Realization
+ * \{ */
+
+/**
+ * Exposes the concatenated attribute values of multiple geometries as a single virtual array.
+ */
+class VArrayImpl_For_RealizedAttribute final : public GVArrayImpl {
+ private:
+  Array<GVArray> sources_;
+  /** Offsets of the elements of every source in the concatenated array. */
+  Array<int> offset_data_;
+
+ public:
+  VArrayImpl_For_RealizedAttribute(const CPPType &type,
+                                   Array<GVArray> sources,
+                                   Array<int> offset_data)
+      : GVArrayImpl(type, offset_data.last()),
+        sources_(std::move(sources)),
+        offset_data_(std::move(offset_data))
+  {
+  }
+
+ private:
+  OffsetIndices<int> offsets() const
+  {
+    return offset_data_.as_span();
+  }
+
+  int find_source(const int64_t index) const
+  {
+    const int *next_offset = std::upper_bound(
+        offset_data_.begin(), offset_data_.end(), int(index));
+    return int(next_offset - offset_data_.begin()) - 1;
+  }
+
+  void get(const int64_t index, void *r_value) const override
+  {
+    const int source_i = this->find_source(index);
+    sources_[source_i].get(index - offset_data_[source_i], r_value);
+  }
+
+  void get_to_uninitialized(const int64_t index, void *r_value) const override
+  {
+    const int source_i = this->find_source(index);
+    sources_[source_i].get_to_uninitialized(index - offset_data_[source_i], r_value);
+  }
+
+  template<typename Fn> void foreach_source_mask(const IndexMask &mask, const Fn &fn) const
+  {
+    const OffsetIndices<int> offsets = this->offsets();
+    int64_t compressed_offset = 0;
+    for (const int source_i : offsets.index_range()) {
+      const IndexRange range = offsets[source_i];
+      const IndexMask source_mask_global = mask.slice_content(range);
+      if (source_mask_global.is_empty()) {
+        continue;
+      }
+      IndexMaskMemory memory;
+      const IndexMask source_mask = source_mask_global.shift(-range.start(), memory);
+      fn(sources_[source_i], source_mask, range.start(), compressed_offset);
+      compressed_offset += source_mask.size();
+    }
+  }
+
+  void materialize(const IndexMask &mask, void *dst) const override
+  {
+    this->foreach_source_mask(
+        mask, [&](const GVArray &src, const IndexMask &src_mask, const int64_t start, int64_t) {
+          src.materialize(src_mask, POINTER_OFFSET(dst, type_->size * start));
+        });
+  }
+
+  void materialize_to_uninitialized(const IndexMask &mask, void *dst) const override
+  {
+    this->foreach_source_mask(
+        mask, [&](const GVArray &src, const IndexMask &src_mask, const int64_t start, int64_t) {
+          src.materialize_to_uninitialized(src_mask, POINTER_OFFSET(dst, type_->size * start));
+        });
+  }
+
+  void materialize_compressed(const IndexMask &mask, void *dst) const override
+  {
+    this->foreach_source_mask(
+        mask,
+        [&](const GVArray &src, const IndexMask &src_mask, int64_t, const int64_t dst_offset) {
+          src.materialize_compressed(src_mask, POINTER_OFFSET(dst, type_->size * dst_offset));
+        });
+  }
+
+  void materialize_compressed_to_uninitialized(const IndexMask &mask, void *dst) const override
+  {
+    this->foreach_source_mask(
+        mask,
+        [&](const GVArray &src, const IndexMask &src_mask, int64_t, const int64_t dst_offset) {
+          src.materialize_compressed_to_uninitialized(
+              src_mask, POINTER_OFFSET(dst, type_->size * dst_offset));
+        });
+  }
+};
+
+static bool is_transformed_attribute(const bke::GeometryComponent::Type component_type,
+                                     const StringRef attribute_id)
+{
+  if (attribute_id == "position") {
+    return true;
+  }
+  if (component_type == bke::GeometryComponent::Type::Curve) {
+    return ELEM(attribute_id, "handle_left", "handle_right");
+  }
+  return false;
+}
+
+static void gather_realized_attribute_sources(const bke::GeometrySet &geometry_set,
+                                              const float4x4 &transform,
+                                              const bke::GeometryComponent::Type component_type,
+                                              const StringRef attribute_id,
+                                              const bke::AttrDomain domain,
+                                              const eCustomDataType data_type,
+                                              Vector<GVArray> &r_sources,
+                                              Vector<int> &r_offsets)
+{
+  for (const bke::GeometryComponent *component : geometry_set.get_components()) {
+    if (component->type() == component_type) {
+      const bke::AttributeAccessor attributes = *component->attributes();
+      const int domain_size = attributes.domain_size(domain);
+      if (domain_size == 0) {
+        continue;
+      }
+      GVArray varray = *attributes.lookup_or_default(attribute_id, domain, data_type);
+      if (data_type == CD_PROP_FLOAT3 && is_transformed_attribute(component_type, attribute_id) &&
+          !skip_transform(transform))
+      {
+        varray = VArray<float3>::ForFunc(
+            domain_size, [src = varray.typed<float3>(), transform](const int64_t i) {
+              return math::transform_point(transform, src[i]);
+            });
+      }
+      r_sources.append(std::move(varray));
+      r_offsets.append(r_offsets.last() + domain_size);
+    }
+    else if (component->type() == bke::GeometryComponent::Type::Instance) {
+      const Instances &instances = *static_cast<const bke::InstancesComponent *>(component)->get();
+      const Span<InstanceReference> references = instances.references();
+      const Span<int> handles = instances.reference_handles();
+      const Span<float4x4> transforms = instances.transforms();
+      for (const int i : handles.index_range()) {
+        bke::GeometrySet instance_geometry;
+        references[handles[i]].to_geometry_set(instance_geometry);
+        gather_realized_attribute_sources(instance_geometry,
+                                          transform * transforms[i],
+                                          component_type,
+                                          attribute_id,
+                                          domain,
+                                          data_type,
+                                          r_sources,
+                                          r_offsets);
+      }
+    }
+  }
+}
+
+GVArray realized_attribute(const bke::GeometrySet &geometry_set,
+                           const bke::GeometryComponent::Type component_type,
+                           const StringRef attribute_id,
+                           const bke::AttrDomain domain,
+                           const eCustomDataType data_type)
+{
+  BLI_assert(ELEM(component_type,
+                  bke::GeometryComponent::Type::Mesh,
+                  bke::GeometryComponent::Type::PointCloud,
+                  bke::GeometryComponent::Type::Curve));
+  const CPPType &type = *bke::custom_data_type_to_cpp_type(data_type);
+
+  Vector<GVArray> sources;
+  Vector<int> offsets = {0};
+  gather_realized_attribute_sources(geometry_set,
+                                    float4x4::identity(),
+                                    component_type,
+                                    attribute_id,
+                                    domain,
+                                    data_type,
+                                    sources,
+                                    offsets);
+  if (sources.is_empty()) {
+    return GVArray::ForEmpty(type);
+  }
+  if (sources.size() == 1) {
+    return std::move(sources.first());
+  }
+  return GVArray::For<VArrayImpl_For_RealizedAttribute>(
+      type, Array<GVArray>(sources.as_span()), Array<int>(offsets.as_span()));
+}
+
+/** \} */
+
 }  // namespace blender::geometry
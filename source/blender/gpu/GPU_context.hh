@@ -45,6 +45,17 @@ void GPU_backend_type_selection_set_override(eGPUBackendType backend_type);
  */
 bool GPU_backend_type_selection_is_overridden();
 
+/**
+ * Use the GPU device with the given index in the list of the platform instead of the one from the
+ * preferences. This allows running one instance per GPU, e.g. when rendering on a farm.
+ * Only supported by the Vulkan backend.
+ */
+void GPU_backend_device_selection_set_override(int device_index);
+/**
+ * \return The device index set by #GPU_backend_device_selection_set_override, or -1.
+ */
+int GPU_backend_device_selection_override_get();
+
 /** Opaque type hiding blender::gpu::Context. */
 struct GPUContext;
 
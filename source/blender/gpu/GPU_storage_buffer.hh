@@ -30,6 +30,9 @@ GPUStorageBuf *GPU_storagebuf_create_ex(size_t size,
 
 void GPU_storagebuf_free(GPUStorageBuf *ssbo);
 
+/** Returns the size of all currently allocated storage buffers in bytes. */
+size_t GPU_storagebuf_memory_usage_get();
+
 void GPU_storagebuf_update(GPUStorageBuf *ssbo, const void *data);
 
 void GPU_storagebuf_bind(GPUStorageBuf *ssbo, int slot);
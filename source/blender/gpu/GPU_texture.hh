@@ -1303,10 +1303,11 @@ const char *GPU_texture_format_name(eGPUTextureFormat format);
 
 /**
  * Returns the memory usage of all currently allocated textures in bytes.
+ * Texture views and buffer textures are not counted, as they don't own their storage.
  * \note that does not mean all of the textures are inside VRAM. Drivers can swap the texture
  * memory back and forth depending on usage.
  */
-unsigned int GPU_texture_memory_usage_get();
+size_t GPU_texture_memory_usage_get();
 
 /**
  * Update sampler states depending on user settings.
@@ -22,6 +22,10 @@ class TexturePool {
   /* Defer deallocation enough cycles to avoid interleaved calls to different viewport render
    * functions (selection / display) causing constant allocation / deallocation (See #113024). */
   static constexpr int max_unused_cycles_ = 8;
+  /* Resizing a viewport requests new texture sizes on every redraw, the textures of the previous
+   * sizes then stay in the pool until they reach `max_unused_cycles_`. Above this amount of
+   * unused memory, the least recently used textures are freed earlier. */
+  static constexpr int64_t max_unused_memory_ = 256 * 1024 * 1024;
 
   struct TextureHandle {
     GPUTexture *texture;
@@ -35,6 +39,10 @@ class TexturePool {
   /* List of textures that are currently being used. Tracked to check memory leak. */
   blender::Vector<GPUTexture *> acquired_;
 
+  /* Free unused textures, least recently used first, until the memory they use is at most the
+   * given amount. */
+  void free_unused_textures(int64_t max_memory);
+
  public:
   ~TexturePool();
 
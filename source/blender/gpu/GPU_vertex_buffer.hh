@@ -10,6 +10,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "BLI_span.hh"
 #include "BLI_utildefines.h"
 
@@ -61,7 +63,8 @@ namespace blender::gpu {
  */
 class VertBuf {
  public:
-  static size_t memory_usage;
+  /** Size of all uploaded vertex buffers, see #GPU_vertbuf_get_memory_usage. */
+  static std::atomic<size_t> memory_usage;
 
   GPUVertFormat format = {};
   /** Number of verts we want to draw. */
@@ -282,7 +285,7 @@ void GPU_vertbuf_wrap_handle(blender::gpu::VertBuf *verts, uint64_t handle);
 void GPU_vertbuf_update_sub(blender::gpu::VertBuf *verts, uint start, uint len, const void *data);
 
 /* Metrics */
-uint GPU_vertbuf_get_memory_usage();
+size_t GPU_vertbuf_get_memory_usage();
 
 /* Macros */
 #define GPU_VERTBUF_DISCARD_SAFE(verts) \
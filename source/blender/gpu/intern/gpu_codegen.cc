@@ -17,6 +17,7 @@
 #include "BLI_hash_mm2a.hh"
 #include "BLI_link_utils.h"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_span.hh"
 #include "BLI_string.h"
 #include "BLI_threads.h"
@@ -89,8 +90,6 @@ struct GPUCodegenCreateInfo : ShaderCreateInfo {
 };
 
 struct GPUPass {
-  GPUPass *next = nullptr;
-
   GPUShader *shader = nullptr;
   GPUCodegenCreateInfo *create_info = nullptr;
   /** Orphaned GPUPasses gets freed by the garbage collector. */
@@ -124,56 +123,57 @@ struct GPUPass {
  * same for 2 different Materials. Unused GPUPasses are free by Garbage collection.
  * \{ */
 
-/* Only use one linklist that contains the GPUPasses grouped by hash. */
-static GPUPass *pass_cache = nullptr;
+/**
+ * GPUPasses grouped by engine and hash. Materials that only differ by their uniform values and
+ * textures generate the same code, so a scene with many variants of the same material only does
+ * one lookup per material instead of scanning every pass. There is a hash collision if a group
+ * contains more than one pass.
+ */
+using GPUPassGroup = blender::Vector<GPUPass *, 1>;
+using GPUPassCache = blender::Map<uint64_t, GPUPassGroup>;
+static GPUPassCache pass_cache;
 static SpinLock pass_cache_spin;
 
-/* Search by hash only. Return first pass with the same hash.
- * There is hash collision if (pass->next && pass->next->hash == hash) */
-static GPUPass *gpu_pass_cache_lookup(eGPUMaterialEngine engine, uint32_t hash)
+static uint64_t gpu_pass_cache_key(eGPUMaterialEngine engine, uint32_t hash)
+{
+  return (uint64_t(engine) << 32) | hash;
+}
+
+/* Search by hash only. Return first pass with the same hash and whether there is a collision. */
+static GPUPass *gpu_pass_cache_lookup(eGPUMaterialEngine engine,
+                                      uint32_t hash,
+                                      bool &r_has_collision)
 {
   BLI_spin_lock(&pass_cache_spin);
-  /* Could be optimized with a Lookup table. */
-  for (GPUPass *pass = pass_cache; pass; pass = pass->next) {
-    if (pass->hash == hash && pass->engine == engine) {
-      BLI_spin_unlock(&pass_cache_spin);
-      return pass;
-    }
-  }
+  const GPUPassGroup *passes = pass_cache.lookup_ptr(gpu_pass_cache_key(engine, hash));
+  GPUPass *pass = passes ? passes->first() : nullptr;
+  r_has_collision = passes && passes->size() > 1;
   BLI_spin_unlock(&pass_cache_spin);
-  return nullptr;
+  return pass;
 }
 
-static void gpu_pass_cache_insert_after(GPUPass *node, GPUPass *pass)
+static void gpu_pass_cache_insert(GPUPass *pass)
 {
   BLI_spin_lock(&pass_cache_spin);
   pass->cached = true;
-  if (node != nullptr) {
-    /* Add after the first pass having the same hash. */
-    pass->next = node->next;
-    node->next = pass;
-  }
-  else {
-    /* No other pass have same hash, just prepend to the list. */
-    BLI_LINKS_PREPEND(pass_cache, pass);
-  }
+  pass_cache.lookup_or_add_default(gpu_pass_cache_key(pass->engine, pass->hash)).append(pass);
   BLI_spin_unlock(&pass_cache_spin);
 }
 
 /* Check all possible passes with the same hash. */
-static GPUPass *gpu_pass_cache_resolve_collision(GPUPass *pass,
+static GPUPass *gpu_pass_cache_resolve_collision(eGPUMaterialEngine engine,
                                                  GPUShaderCreateInfo *info,
                                                  uint32_t hash)
 {
-  eGPUMaterialEngine engine = pass->engine;
   BLI_spin_lock(&pass_cache_spin);
-  for (; pass && (pass->hash == hash); pass = pass->next) {
-    if (*reinterpret_cast<ShaderCreateInfo *>(info) ==
-            *reinterpret_cast<ShaderCreateInfo *>(pass->create_info) &&
-        pass->engine == engine)
-    {
-      BLI_spin_unlock(&pass_cache_spin);
-      return pass;
+  if (const GPUPassGroup *passes = pass_cache.lookup_ptr(gpu_pass_cache_key(engine, hash))) {
+    for (GPUPass *pass : *passes) {
+      if (*reinterpret_cast<ShaderCreateInfo *>(info) ==
+          *reinterpret_cast<ShaderCreateInfo *>(pass->create_info))
+      {
+        BLI_spin_unlock(&pass_cache_spin);
+        return pass;
+      }
     }
   }
   BLI_spin_unlock(&pass_cache_spin);
@@ -750,11 +750,12 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
      * NOTE: We only perform cache look-up for non-optimized shader
      * graphs, as baked constant data among other optimizations will generate too many
      * shader source permutations, with minimal re-usability. */
-    pass_hash = gpu_pass_cache_lookup(engine, codegen.hash_get());
+    bool has_collision = false;
+    pass_hash = gpu_pass_cache_lookup(engine, codegen.hash_get(), has_collision);
 
     /* FIXME(fclem): This is broken. Since we only check for the hash and not the full source
      * there is no way to have a collision currently. Some advocated to only use a bigger hash. */
-    if (pass_hash && (pass_hash->next == nullptr || pass_hash->next->hash != codegen.hash_get())) {
+    if (pass_hash && !has_collision) {
       if (!gpu_pass_is_valid(pass_hash)) {
         /* Shader has already been created but failed to compile. */
         return nullptr;
@@ -780,7 +781,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
   if (pass_hash) {
     /* Cache lookup: Reuse shaders already compiled. */
     pass = gpu_pass_cache_resolve_collision(
-        pass_hash, codegen.output.create_info, codegen.hash_get());
+        engine, codegen.output.create_info, codegen.hash_get());
   }
 
   if (pass) {
@@ -821,7 +822,7 @@ GPUPass *GPU_generate_pass(GPUMaterial *material,
      * editing, and thus causing the cache to fill up quickly with materials offering minimal
      * re-use. */
     if (!optimize_graph) {
-      gpu_pass_cache_insert_after(pass_hash, pass);
+      gpu_pass_cache_insert(pass);
     }
   }
   return pass;
@@ -1013,20 +1014,19 @@ void GPU_pass_cache_garbage_collect()
   int ctime = int(BLI_time_now_seconds());
 
   BLI_spin_lock(&pass_cache_spin);
-  GPUPass *next, **prev_pass = &pass_cache;
-  for (GPUPass *pass = pass_cache; pass; pass = next) {
-    next = pass->next;
-    if (pass->refcount > 0) {
-      pass->gc_timestamp = ctime;
-    }
-    else if (pass->gc_timestamp + shadercollectrate < ctime) {
-      /* Remove from list */
-      *prev_pass = next;
-      gpu_pass_free(pass);
-      continue;
-    }
-    prev_pass = &pass->next;
-  }
+  pass_cache.remove_if([&](GPUPassCache::MutableItem item) {
+    item.value.remove_if([&](GPUPass *pass) {
+      if (pass->refcount > 0) {
+        pass->gc_timestamp = ctime;
+      }
+      else if (pass->gc_timestamp + shadercollectrate < ctime) {
+        gpu_pass_free(pass);
+        return true;
+      }
+      return false;
+    });
+    return item.value.is_empty();
+  });
   BLI_spin_unlock(&pass_cache_spin);
 }
 
@@ -1038,11 +1038,12 @@ void GPU_pass_cache_init()
 void GPU_pass_cache_free()
 {
   BLI_spin_lock(&pass_cache_spin);
-  while (pass_cache) {
-    GPUPass *next = pass_cache->next;
-    gpu_pass_free(pass_cache);
-    pass_cache = next;
+  for (GPUPassGroup &passes : pass_cache.values()) {
+    for (GPUPass *pass : passes) {
+      gpu_pass_free(pass);
+    }
   }
+  pass_cache.clear();
   BLI_spin_unlock(&pass_cache_spin);
 
   BLI_spin_end(&pass_cache_spin);
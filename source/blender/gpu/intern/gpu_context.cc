@@ -333,6 +333,7 @@ void GPU_render_step(bool force_resource_release)
 static eGPUBackendType g_backend_type = GPU_BACKEND_OPENGL;
 static std::optional<eGPUBackendType> g_backend_type_override = std::nullopt;
 static std::optional<bool> g_backend_type_supported = std::nullopt;
+static int g_backend_device_override = -1;
 static GPUBackend *g_backend = nullptr;
 static GHOST_SystemHandle g_ghost_system = nullptr;
 
@@ -367,6 +368,16 @@ bool GPU_backend_type_selection_is_overridden()
   return g_backend_type_override.has_value();
 }
 
+void GPU_backend_device_selection_set_override(const int device_index)
+{
+  g_backend_device_override = device_index;
+}
+
+int GPU_backend_device_selection_override_get()
+{
+  return g_backend_device_override;
+}
+
 bool GPU_backend_type_selection_detect()
 {
   blender::VectorSet<eGPUBackendType> backends_to_check;
@@ -554,6 +565,10 @@ GPUSecondaryContext::GPUSecondaryContext()
   gpu_settings.preferred_device.index = U.gpu_preferred_index;
   gpu_settings.preferred_device.vendor_id = U.gpu_preferred_vendor_id;
   gpu_settings.preferred_device.device_id = U.gpu_preferred_device_id;
+  if (g_backend_device_override != -1) {
+    gpu_settings.preferred_device.index = g_backend_device_override;
+    gpu_settings.preferred_device.use_index_only = true;
+  }
 
   /* Grab the system handle. */
   GHOST_SystemHandle ghost_system = reinterpret_cast<GHOST_SystemHandle>(
@@ -27,14 +27,18 @@
 
 namespace blender::gpu {
 
+std::atomic<size_t> StorageBuf::memory_usage = 0;
+
 StorageBuf::StorageBuf(size_t size, const char *name)
 {
   size_in_bytes_ = size;
   STRNCPY(name_, name);
+  memory_usage += size;
 }
 
 StorageBuf::~StorageBuf()
 {
+  memory_usage -= size_in_bytes_;
   MEM_SAFE_FREE(data_);
 }
 
@@ -73,6 +77,11 @@ void GPU_storagebuf_free(GPUStorageBuf *ssbo)
   delete unwrap(ssbo);
 }
 
+size_t GPU_storagebuf_memory_usage_get()
+{
+  return StorageBuf::memory_usage;
+}
+
 void GPU_storagebuf_update(GPUStorageBuf *ssbo, const void *data)
 {
   unwrap(ssbo)->update(data);
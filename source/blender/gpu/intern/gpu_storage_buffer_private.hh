@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "BLI_sys_types.h"
 
 struct GPUStorageBuf;
@@ -27,6 +29,10 @@ class VertBuf;
  * Base class which is then specialized for each implementation (GL, VK, ...).
  */
 class StorageBuf {
+ public:
+  /** Size of all allocated storage buffers, see #GPU_storagebuf_memory_usage_get. */
+  static std::atomic<size_t> memory_usage;
+
  protected:
   /** Data size in bytes. Doesn't need to match actual allocation size due to alignment rules. */
   size_t size_in_bytes_;
@@ -19,6 +19,8 @@
 
 namespace blender::gpu {
 
+std::atomic<size_t> Texture::memory_usage = 0;
+
 /* -------------------------------------------------------------------- */
 /** \name Creation & Deletion
  * \{ */
@@ -47,6 +49,8 @@ Texture::~Texture()
     }
   }
 
+  memory_usage -= memory_size_;
+
 #ifndef GPU_NO_USE_PY_REFERENCES
   if (this->py_ref) {
     *this->py_ref = nullptr;
@@ -67,7 +71,7 @@ bool Texture::init_1D(int w, int layers, int mip_len, eGPUTextureFormat format)
   if ((format_flag_ & (GPU_FORMAT_DEPTH_STENCIL | GPU_FORMAT_INTEGER)) == 0) {
     sampler_state.filtering = GPU_SAMPLER_FILTERING_LINEAR;
   }
-  return this->init_internal();
+  return this->init_storage();
 }
 
 bool Texture::init_2D(int w, int h, int layers, int mip_len, eGPUTextureFormat format)
@@ -83,7 +87,7 @@ bool Texture::init_2D(int w, int h, int layers, int mip_len, eGPUTextureFormat f
   if ((format_flag_ & (GPU_FORMAT_DEPTH_STENCIL | GPU_FORMAT_INTEGER)) == 0) {
     sampler_state.filtering = GPU_SAMPLER_FILTERING_LINEAR;
   }
-  return this->init_internal();
+  return this->init_storage();
 }
 
 bool Texture::init_3D(int w, int h, int d, int mip_len, eGPUTextureFormat format)
@@ -99,7 +103,7 @@ bool Texture::init_3D(int w, int h, int d, int mip_len, eGPUTextureFormat format
   if ((format_flag_ & (GPU_FORMAT_DEPTH_STENCIL | GPU_FORMAT_INTEGER)) == 0) {
     sampler_state.filtering = GPU_SAMPLER_FILTERING_LINEAR;
   }
-  return this->init_internal();
+  return this->init_storage();
 }
 
 bool Texture::init_cubemap(int w, int layers, int mip_len, eGPUTextureFormat format)
@@ -115,7 +119,23 @@ bool Texture::init_cubemap(int w, int layers, int mip_len, eGPUTextureFormat for
   if ((format_flag_ & (GPU_FORMAT_DEPTH_STENCIL | GPU_FORMAT_INTEGER)) == 0) {
     sampler_state.filtering = GPU_SAMPLER_FILTERING_LINEAR;
   }
-  return this->init_internal();
+  return this->init_storage();
+}
+
+bool Texture::init_storage()
+{
+  if (!this->init_internal()) {
+    return false;
+  }
+  /* Estimate from the texture format, drivers can add padding and compress the storage. */
+  const size_t pixel_size = to_bytesize(format_);
+  for (int mip = 0; mip < max_ii(1, mipmaps_); mip++) {
+    int size[3] = {1, 1, 1};
+    this->mip_size_get(mip, size);
+    memory_size_ += size_t(size[0]) * size_t(size[1]) * size_t(size[2]) * pixel_size;
+  }
+  memory_usage += memory_size_;
+  return true;
 }
 
 bool Texture::init_buffer(VertBuf *vbo, eGPUTextureFormat format)
@@ -245,10 +265,9 @@ using namespace blender::gpu;
 
 /* ------ Memory Management ------ */
 
-uint GPU_texture_memory_usage_get()
+size_t GPU_texture_memory_usage_get()
 {
-  /* TODO(fclem): Do that inside the new Texture class. */
-  return 0;
+  return Texture::memory_usage;
 }
 
 /* ------ Creation ------ */
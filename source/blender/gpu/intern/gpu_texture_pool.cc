@@ -6,15 +6,24 @@
  * \ingroup draw
  */
 
+#include <algorithm>
+
 #include "BKE_global.hh"
 #include "BLI_string.h"
 
 #include "GPU_texture_pool.hh"
 
 #include "gpu_context_private.hh"
+#include "gpu_texture_private.hh"
 
 namespace blender::gpu {
 
+static int64_t texture_memory_size(GPUTexture *tex)
+{
+  return int64_t(GPU_texture_width(tex)) * GPU_texture_height(tex) *
+         to_bytesize(GPU_texture_format(tex));
+}
+
 TexturePool::~TexturePool()
 {
   for (GPUTexture *tex : acquired_) {
@@ -57,11 +66,45 @@ GPUTexture *TexturePool::acquire_texture(int width,
     int texture_id = pool_.size();
     SNPRINTF(name, "TexFromPool_%d", texture_id);
   }
+
+  /* None of the unused textures match, so they only add to the peak memory usage if they are kept
+   * while allocating a new one. For large textures, this quickly exhausts the GPU memory, so free
+   * unused textures until the new texture fits in the unused memory budget. */
+  const int64_t texture_size = int64_t(width) * height * to_bytesize(format);
+  this->free_unused_textures(max_unused_memory_ - texture_size);
+
   GPUTexture *tex = GPU_texture_create_2d(name, width, height, 1, format, usage, nullptr);
+  if (tex == nullptr) {
+    /* The allocation might have failed because the GPU is out of memory, so try again after
+     * freeing all unused textures. */
+    this->free_unused_textures(0);
+    tex = GPU_texture_create_2d(name, width, height, 1, format, usage, nullptr);
+  }
   acquired_.append(tex);
   return tex;
 }
 
+void TexturePool::free_unused_textures(const int64_t max_memory)
+{
+  int64_t unused_memory = 0;
+  for (const TextureHandle &tex : pool_) {
+    unused_memory += texture_memory_size(tex.texture);
+  }
+  if (unused_memory <= max_memory) {
+    return;
+  }
+
+  /* Free the least recently used textures first. */
+  std::sort(pool_.begin(), pool_.end(), [](const TextureHandle &a, const TextureHandle &b) {
+    return a.unused_cycles < b.unused_cycles;
+  });
+  while (unused_memory > max_memory && !pool_.is_empty()) {
+    GPUTexture *tex = pool_.pop_last().texture;
+    unused_memory -= texture_memory_size(tex);
+    GPU_texture_free(tex);
+  }
+}
+
 void TexturePool::release_texture(GPUTexture *tex)
 {
   acquired_.remove_first_occurrence_and_reorder(tex);
@@ -95,6 +138,26 @@ void TexturePool::reset(bool force_free)
       tex.unused_cycles++;
     }
   }
+
+  int64_t unused_memory = 0;
+  for (const TextureHandle &tex : pool_) {
+    unused_memory += texture_memory_size(tex.texture);
+  }
+  if (unused_memory <= max_unused_memory_) {
+    return;
+  }
+  /* Free the least recently used textures first. Textures used during the last cycle are kept
+   * since they are likely to be requested again. */
+  std::sort(pool_.begin(), pool_.end(), [](const TextureHandle &a, const TextureHandle &b) {
+    return a.unused_cycles < b.unused_cycles;
+  });
+  while (unused_memory > max_unused_memory_ && !pool_.is_empty() &&
+         pool_.last().unused_cycles > 1)
+  {
+    GPUTexture *tex = pool_.pop_last().texture;
+    unused_memory -= texture_memory_size(tex);
+    GPU_texture_free(tex);
+  }
 }
 
 TexturePool &TexturePool::get()
@@ -8,6 +8,8 @@
 
 #pragma once
 
+#include <atomic>
+
 #include "BLI_assert.h"
 
 #include "GPU_vertex_buffer.hh"
@@ -82,6 +84,9 @@ ENUM_OPERATORS(eGPUSamplerFormat, GPU_SAMPLER_TYPE_UINT)
  */
 class Texture {
  public:
+  /** Estimated memory usage of all allocated textures, see #GPU_texture_memory_usage_get. */
+  static std::atomic<size_t> memory_usage;
+
   /** Internal Sampler state. */
   GPUSamplerState sampler_state = GPUSamplerState::default_sampler();
   /** Reference counter. */
@@ -114,6 +119,8 @@ class Texture {
   int mipmaps_ = -1;
   /** For error checking */
   int mip_min_ = 0, mip_max_ = 0;
+  /** Estimated size of the texture storage, added to #memory_usage. */
+  size_t memory_size_ = 0;
 
   /** For debugging */
   char name_[DEBUG_NAME_LEN];
@@ -311,6 +318,9 @@ class Texture {
   }
 
  protected:
+  /** Call #init_internal and account for the allocated storage in #memory_usage. */
+  bool init_storage();
+
   virtual bool init_internal() = 0;
   virtual bool init_internal(VertBuf *vbo) = 0;
   virtual bool init_internal(GPUTexture *src,
@@ -45,6 +45,7 @@ void GLVertBuf::release_data()
     GLContext::buf_free(vbo_id_);
     vbo_id_ = 0;
     memory_usage -= vbo_size_;
+    vbo_size_ = 0;
   }
 
   MEM_SAFE_FREE(data_);
@@ -66,6 +67,8 @@ void GLVertBuf::bind()
   glBindBuffer(GL_ARRAY_BUFFER, vbo_id_);
 
   if (flag & GPU_VERTBUF_DATA_DIRTY) {
+    /* The previous storage is orphaned below. */
+    memory_usage -= vbo_size_;
     vbo_size_ = this->size_used_get();
 
     /* This is fine on some systems but will crash on others. */
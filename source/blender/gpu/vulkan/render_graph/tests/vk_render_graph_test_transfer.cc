@@ -341,4 +341,31 @@ TEST_F(VKRenderGraphTestTransfer, clear_blit_copy_and_read_back)
       log[5]);
 }
 
+/**
+ * Barriers and layout transitions should be counted in the statistics of the command builder.
+ */
+TEST_F(VKRenderGraphTestTransfer, statistics)
+{
+  VkHandle<VkBuffer> buffer(1u);
+  VkHandle<VkImage> image(2u);
+
+  resources.add_buffer(buffer);
+  resources.add_image(image, 1);
+  VKFillBufferNode::CreateInfo fill_buffer_1 = {buffer, 1024, 0};
+  render_graph->add_node(fill_buffer_1);
+  VKFillBufferNode::CreateInfo fill_buffer_2 = {buffer, 1024, 42};
+  render_graph->add_node(fill_buffer_2);
+  VKClearColorImageNode::CreateInfo clear_color_image = {};
+  clear_color_image.vk_image = image;
+  render_graph->add_node(clear_color_image);
+  const VKCommandBuilderStatistics statistics = submit(render_graph, command_buffer);
+
+  EXPECT_EQ(3, statistics.nodes_num);
+  EXPECT_EQ(2, statistics.pipeline_barriers_num);
+  EXPECT_EQ(1, statistics.buffer_memory_barriers_num);
+  EXPECT_EQ(1, statistics.image_memory_barriers_num);
+  EXPECT_EQ(1, statistics.image_layout_transitions_num);
+  EXPECT_EQ(0, statistics.submits_num);
+}
+
 }  // namespace blender::gpu::render_graph
@@ -549,8 +549,9 @@ template<typename VKObjectType> union VkHandle {
   }
 };
 
-static inline void submit(std::unique_ptr<VKRenderGraph> &render_graph,
-                          std::unique_ptr<CommandBufferLog> &command_buffer)
+/** \return The statistics of the recorded commands. */
+static inline VKCommandBuilderStatistics submit(std::unique_ptr<VKRenderGraph> &render_graph,
+                                                std::unique_ptr<CommandBufferLog> &command_buffer)
 {
   VKScheduler scheduler;
   VKCommandBuilder command_builder;
@@ -562,5 +563,6 @@ static inline void submit(std::unique_ptr<VKRenderGraph> &render_graph,
   command_buffer->end_recording();
 
   render_graph->reset();
+  return command_builder.statistics;
 }
 }  // namespace blender::gpu::render_graph
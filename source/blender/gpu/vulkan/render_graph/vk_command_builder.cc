@@ -15,6 +15,18 @@
 
 namespace blender::gpu::render_graph {
 
+VKCommandBuilderStatistics &VKCommandBuilderStatistics::operator+=(
+    const VKCommandBuilderStatistics &other)
+{
+  nodes_num += other.nodes_num;
+  submits_num += other.submits_num;
+  pipeline_barriers_num += other.pipeline_barriers_num;
+  buffer_memory_barriers_num += other.buffer_memory_barriers_num;
+  image_memory_barriers_num += other.image_memory_barriers_num;
+  image_layout_transitions_num += other.image_layout_transitions_num;
+  return *this;
+}
+
 /* -------------------------------------------------------------------- */
 /** \name Build nodes
  * \{ */
@@ -32,6 +44,7 @@ void VKCommandBuilder::record_commands(VKRenderGraph &render_graph,
                                        VKCommandBufferInterface &command_buffer,
                                        Span<NodeHandle> node_handles)
 {
+  statistics.nodes_num += node_handles.size();
   groups_build_commands(render_graph, command_buffer, node_handles);
 }
 
@@ -483,6 +496,15 @@ void VKCommandBuilder::send_pipeline_barriers(VKCommandBufferInterface &command_
   Span<VkImageMemoryBarrier> image_barriers = vk_image_memory_barriers_.as_span().slice(
       barrier.image_memory_barriers);
 
+  statistics.pipeline_barriers_num += 1;
+  statistics.buffer_memory_barriers_num += buffer_barriers.size();
+  statistics.image_memory_barriers_num += image_barriers.size();
+  for (const VkImageMemoryBarrier &image_barrier : image_barriers) {
+    if (image_barrier.oldLayout != image_barrier.newLayout) {
+      statistics.image_layout_transitions_num += 1;
+    }
+  }
+
   command_buffer.pipeline_barrier(src_stage_mask,
                                   dst_stage_mask,
                                   VK_DEPENDENCY_BY_REGION_BIT,
@@ -24,6 +24,22 @@ struct LayeredImageBinding {
   uint32_t layer_count;
 };
 
+/**
+ * Number of nodes and synchronization commands recorded by #VKCommandBuilder. Used to measure the
+ * synchronization overhead of the Vulkan backend in heavy scenes.
+ */
+struct VKCommandBuilderStatistics {
+  int64_t nodes_num = 0;
+  int64_t submits_num = 0;
+  int64_t pipeline_barriers_num = 0;
+  int64_t buffer_memory_barriers_num = 0;
+  int64_t image_memory_barriers_num = 0;
+  /** Image memory barriers that change the layout of the image. */
+  int64_t image_layout_transitions_num = 0;
+
+  VKCommandBuilderStatistics &operator+=(const VKCommandBuilderStatistics &other);
+};
+
 /**
  * Build the command buffer for sending to the device queue.
  *
@@ -176,6 +192,12 @@ class VKCommandBuilder {
   Vector<Barrier> barrier_list_;
 
  public:
+  /**
+   * Statistics of the recorded commands, accumulated until reset by the caller. Submits are
+   * counted by the caller as well.
+   */
+  VKCommandBuilderStatistics statistics;
+
   /**
    * Build execution groups and barriers.
    * This method should be performed when the resources are locked.
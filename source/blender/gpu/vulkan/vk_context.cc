@@ -400,6 +400,9 @@ void VKContext::swap_buffers_pre_handler(const GHOST_VulkanSwapChainData &swap_c
 void VKContext::swap_buffers_post_handler()
 {
   sync_backbuffer(true);
+  if (G.debug & G_DEBUG_GPU) {
+    VKBackend::get().device.render_graph_statistics_log();
+  }
 }
 
 void VKContext::specialization_constants_set(
@@ -181,6 +181,13 @@ class VKDevice : public NonCopyable {
   VkSemaphore vk_timeline_semaphore_ = VK_NULL_HANDLE;
   std::atomic<uint_least64_t> timeline_value_ = 0;
 
+  /**
+   * Statistics of the render graphs submitted since the last presented frame. Only gathered when
+   * GPU debugging is enabled, see #render_graph_statistics_log.
+   */
+  std::mutex render_graph_statistics_mutex_;
+  render_graph::VKCommandBuilderStatistics render_graph_statistics_;
+
   VKSamplers samplers_;
   VKDescriptorSetLayouts descriptor_set_layouts_;
 
@@ -396,6 +403,12 @@ class VKDevice : public NonCopyable {
                                     VkFence signal_fence);
   void wait_for_timeline(TimelineValue timeline);
 
+  /**
+   * Log the number of recorded nodes, pipeline barriers, layout transitions and submits since the
+   * previous call and reset them. Called once per presented frame when GPU debugging is enabled.
+   */
+  void render_graph_statistics_log();
+
   /**
    * Retrieve the last finished submission timeline.
    */
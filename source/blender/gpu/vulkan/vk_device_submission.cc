@@ -9,8 +9,12 @@
 #include <chrono>
 #include <thread>
 
+#include "CLG_log.h"
+
 #include "vk_device.hh"
 
+static CLG_LogRef LOG = {"gpu.vulkan"};
+
 namespace blender::gpu {
 
 /* -------------------------------------------------------------------- */
@@ -89,6 +93,27 @@ void VKDevice::wait_for_timeline(TimelineValue timeline)
   vkWaitSemaphores(vk_device_, &vk_semaphore_wait_info, UINT64_MAX);
 }
 
+void VKDevice::render_graph_statistics_log()
+{
+  render_graph::VKCommandBuilderStatistics statistics;
+  {
+    std::scoped_lock lock(render_graph_statistics_mutex_);
+    statistics = render_graph_statistics_;
+    render_graph_statistics_ = {};
+  }
+  CLOG_INFO(&LOG,
+            2,
+            "Render graph statistics of frame: nodes=%" PRId64 ", submits=%" PRId64
+            ", pipeline barriers=%" PRId64 ", buffer memory barriers=%" PRId64
+            ", image memory barriers=%" PRId64 ", image layout transitions=%" PRId64,
+            statistics.nodes_num,
+            statistics.submits_num,
+            statistics.pipeline_barriers_num,
+            statistics.buffer_memory_barriers_num,
+            statistics.image_memory_barriers_num,
+            statistics.image_layout_transitions_num);
+}
+
 render_graph::VKRenderGraph *VKDevice::render_graph_new()
 {
   render_graph::VKRenderGraph *render_graph = static_cast<render_graph::VKRenderGraph *>(
@@ -182,6 +207,8 @@ void VKDevice::submission_runner(TaskPool *__restrict pool, void *task_data)
     command_builder.record_commands(render_graph, *command_buffer, node_handles);
 
     if (submit_task->submit_to_device) {
+      command_builder.statistics.submits_num += 1;
+
       /* Create submit infos for previous command buffers. */
       submit_infos.clear();
       if (!unsubmitted_command_buffers.is_empty()) {
@@ -243,6 +270,12 @@ void VKDevice::submission_runner(TaskPool *__restrict pool, void *task_data)
       command_buffer.reset();
     }
 
+    if (G.debug & G_DEBUG_GPU) {
+      std::scoped_lock lock_statistics(device->render_graph_statistics_mutex_);
+      device->render_graph_statistics_ += command_builder.statistics;
+    }
+    command_builder.statistics = {};
+
     render_graph.reset();
     BLI_thread_queue_push(device->unused_render_graphs_, std::move(submit_task->render_graph));
     MEM_delete<VKRenderGraphSubmitTask>(submit_task);
@@ -714,28 +714,27 @@ struct VKPipelineCachePrefixHeader {
   }
 };
 
-static std::string pipeline_cache_filepath_get()
+/**
+ * Caches of material pipelines are not written when they grow larger than this. Pipelines can't
+ * be removed from a cache, so this prevents the file from growing with every edited material.
+ */
+#  define PIPELINE_CACHE_NON_STATIC_MAX_SIZE (256 * 1024 * 1024)
+
+static std::string pipeline_cache_filepath_get(const char *name)
 {
   static char tmp_dir_buffer[1024];
   BKE_appdir_folder_caches(tmp_dir_buffer, sizeof(tmp_dir_buffer));
 
   std::string cache_dir = std::string(tmp_dir_buffer) + "vk-pipeline-cache" + SEP_STR;
   BLI_dir_create_recursive(cache_dir.c_str());
-  std::string cache_file = cache_dir + "static.bin";
+  std::string cache_file = cache_dir + name + ".bin";
   return cache_file;
 }
-#endif
 
-void VKPipelinePool::read_from_disk()
+static void pipeline_cache_read_from_disk(VkPipelineCache vk_pipeline_cache_dst,
+                                          const char *name)
 {
-#ifdef WITH_BUILDINFO
-  /* Don't read the shader cache when GPU debugging is enabled. When enabled we use different
-   * shaders and compilation settings. Previous generated pipelines will not be used. */
-  if (bool(G.debug & G_DEBUG_GPU)) {
-    return;
-  }
-
-  std::string cache_file = pipeline_cache_filepath_get();
+  std::string cache_file = pipeline_cache_filepath_get(name);
   if (!BLI_exists(cache_file.c_str())) {
     return;
   }
@@ -745,6 +744,9 @@ void VKPipelinePool::read_from_disk()
   /* Read cached binary. */
   fstream file(cache_file, std::ios::binary | std::ios::in | std::ios::ate);
   std::streamsize data_size = file.tellg();
+  if (data_size < std::streamsize(sizeof(VKPipelineCachePrefixHeader))) {
+    return;
+  }
   file.seekg(0, std::ios::beg);
   void *buffer = MEM_mallocN(data_size, __func__);
   file.read(reinterpret_cast<char *>(buffer), data_size);
@@ -754,7 +756,9 @@ void VKPipelinePool::read_from_disk()
   VKPipelineCachePrefixHeader prefix;
   VKPipelineCachePrefixHeader &read_prefix = *static_cast<VKPipelineCachePrefixHeader *>(buffer);
   prefix.data_size = read_prefix.data_size;
-  if (memcmp(&read_prefix, &prefix, sizeof(VKPipelineCachePrefixHeader)) != 0) {
+  if (memcmp(&read_prefix, &prefix, sizeof(VKPipelineCachePrefixHeader)) != 0 ||
+      read_prefix.data_size > data_size - sizeof(VKPipelineCachePrefixHeader))
+  {
     /* Headers are different, most likely the cache will not work and potentially crash the driver.
      * [https://medium.com/@zeuxcg/creating-a-robust-pipeline-cache-with-vulkan-961d09416cda]
      */
@@ -767,7 +771,7 @@ void VKPipelinePool::read_from_disk()
     return;
   }
 
-  CLOG_INFO(&LOG, 1, "Initialize static pipeline cache from disk [%s].", cache_file.c_str());
+  CLOG_INFO(&LOG, 1, "Initialize %s pipeline cache from disk [%s].", name, cache_file.c_str());
   VKDevice &device = VKBackend::get().device;
   VkPipelineCacheCreateInfo create_info = {};
   create_info.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
@@ -777,28 +781,28 @@ void VKPipelinePool::read_from_disk()
   vkCreatePipelineCache(device.vk_handle(), &create_info, nullptr, &vk_pipeline_cache);
   MEM_freeN(buffer);
 
-  vkMergePipelineCaches(device.vk_handle(), vk_pipeline_cache_static_, 1, &vk_pipeline_cache);
+  vkMergePipelineCaches(device.vk_handle(), vk_pipeline_cache_dst, 1, &vk_pipeline_cache);
   vkDestroyPipelineCache(device.vk_handle(), vk_pipeline_cache, nullptr);
-#endif
 }
 
-void VKPipelinePool::write_to_disk()
+static void pipeline_cache_write_to_disk(VkPipelineCache vk_pipeline_cache,
+                                         const char *name,
+                                         const size_t max_data_size)
 {
-#ifdef WITH_BUILDINFO
-  /* Don't write the pipeline cache when GPU debugging is enabled. When enabled we use different
-   * shaders and compilation settings. Writing them to disk will clutter the pipeline cache. */
-  if (bool(G.debug & G_DEBUG_GPU)) {
-    return;
-  }
-
   VKDevice &device = VKBackend::get().device;
   size_t data_size;
-  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache_static_, &data_size, nullptr);
+  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache, &data_size, nullptr);
+  std::string cache_file = pipeline_cache_filepath_get(name);
+  if (data_size > max_data_size) {
+    /* Remove the file, so the next session starts with an empty cache. */
+    CLOG_INFO(&LOG, 1, "Removing %s pipeline cache as it is too large.", name);
+    BLI_delete(cache_file.c_str(), false, false);
+    return;
+  }
   void *buffer = MEM_mallocN(data_size, __func__);
-  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache_static_, &data_size, buffer);
+  vkGetPipelineCacheData(device.vk_handle(), vk_pipeline_cache, &data_size, buffer);
 
-  std::string cache_file = pipeline_cache_filepath_get();
-  CLOG_INFO(&LOG, 1, "Writing static pipeline cache to disk [%s].", cache_file.c_str());
+  CLOG_INFO(&LOG, 1, "Writing %s pipeline cache to disk [%s].", name, cache_file.c_str());
 
   fstream file(cache_file, std::ios::binary | std::ios::out);
 
@@ -808,6 +812,35 @@ void VKPipelinePool::write_to_disk()
   file.write(static_cast<char *>(buffer), data_size);
 
   MEM_freeN(buffer);
+}
+#endif
+
+void VKPipelinePool::read_from_disk()
+{
+#ifdef WITH_BUILDINFO
+  /* Don't read the shader cache when GPU debugging is enabled. When enabled we use different
+   * shaders and compilation settings. Previous generated pipelines will not be used. */
+  if (bool(G.debug & G_DEBUG_GPU)) {
+    return;
+  }
+
+  pipeline_cache_read_from_disk(vk_pipeline_cache_static_, "static");
+  pipeline_cache_read_from_disk(vk_pipeline_cache_non_static_, "non_static");
+#endif
+}
+
+void VKPipelinePool::write_to_disk()
+{
+#ifdef WITH_BUILDINFO
+  /* Don't write the pipeline cache when GPU debugging is enabled. When enabled we use different
+   * shaders and compilation settings. Writing them to disk will clutter the pipeline cache. */
+  if (bool(G.debug & G_DEBUG_GPU)) {
+    return;
+  }
+
+  pipeline_cache_write_to_disk(vk_pipeline_cache_static_, "static", SIZE_MAX);
+  pipeline_cache_write_to_disk(
+      vk_pipeline_cache_non_static_, "non_static", PIPELINE_CACHE_NON_STATIC_MAX_SIZE);
 #endif
 }
 
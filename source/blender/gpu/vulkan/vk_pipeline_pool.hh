@@ -329,7 +329,7 @@ class VKPipelinePool : public NonCopyable {
   void free_data();
 
   /**
-   * Read the static pipeline cache from cache file.
+   * Read the static and non-static pipeline caches from their cache files.
    *
    * Pipeline caches requires blender to be build with `WITH_BUILDINFO` enabled . Between commits
    * shader modules can change and shader module identifiers cannot be used. We use the build info
@@ -345,7 +345,8 @@ class VKPipelinePool : public NonCopyable {
   void read_from_disk();
 
   /**
-   * Store the static pipeline cache to disk.
+   * Store the static and non-static pipeline caches to disk. The non-static cache contains the
+   * pipelines of materials and isn't stored when it grew too large.
    *
    * Pipeline caches requires blender to be build with `WITH_BUILDINFO` enabled . Between commits
    * shader modules can change and shader module identifiers cannot be used. We use the build info
@@ -20,6 +20,9 @@ namespace blender::gpu {
 VKVertexBuffer::~VKVertexBuffer()
 {
   release_data();
+  if (buffer_.is_allocated()) {
+    memory_usage -= buffer_.size_in_bytes();
+  }
 }
 
 void VKVertexBuffer::bind_as_ssbo(uint binding)
@@ -175,6 +178,9 @@ void VKVertexBuffer::allocate()
                  0,
                  VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
                  VmaAllocationCreateFlags(0));
+  if (buffer_.is_allocated()) {
+    memory_usage += buffer_.size_in_bytes();
+  }
   debug::object_label(buffer_.vk_handle(), "VertexBuffer");
 }
 
@@ -106,6 +106,10 @@ enum eImBufFlags {
   /** ignore alpha on load and substitute it with 1.0f */
   IB_alphamode_ignore = 1 << 15,
   IB_thumbnail = 1 << 16,
+  /** Decode movies on the GPU when supported, falls back to software decoding otherwise. */
+  IB_anim_hw_decode = 1 << 17,
+  /** Only read the layers and passes of multi-layer files, not their pixels. */
+  IB_multilayer_lazy = 1 << 18,
 };
 
 /** \} */
@@ -42,6 +42,11 @@ void IMB_exr_add_channel(void *handle,
  */
 bool IMB_exr_begin_read(
     void *handle, const char *filepath, int *width, int *height, bool parse_channels);
+/**
+ * Read the layers and passes of a multi-layer file without allocating buffers for them, the
+ * passes to read are chosen with #IMB_exr_set_pass_rect before #IMB_exr_read_channels.
+ */
+bool IMB_exr_begin_read_passes(void *handle, const char *filepath, int *width, int *height);
 /**
  * Used for output files (from #RenderResult) (single and multi-layer, single and multi-view).
  */
@@ -66,6 +71,17 @@ bool IMB_exr_set_channel(void *handle,
                          int ystride,
                          float *rect);
 
+/**
+ * Read the channels of a pass into the given buffer, which stays owned by the caller. The
+ * channels are interleaved in the order of the channel identifiers passed to
+ * #IMB_exr_multilayer_convert.
+ *
+ * \param passname: Pass name without the view, as passed to #IMB_exr_multilayer_convert.
+ * \return False when there is no such pass in the file.
+ */
+bool IMB_exr_set_pass_rect(
+    void *handle, const char *layname, const char *passname, const char *viewname, float *rect);
+
 void IMB_exr_read_channels(void *handle);
 void IMB_exr_write_channels(void *handle);
 
@@ -175,6 +175,12 @@ static struct GlobalColorPickingState {
  *      Currently such a data contains only exposure and gamma, but
  *      would likely extended further.
  *
+ *      The look is part of the cache key, so switching between looks
+ *      doesn't regenerate the display buffers every time. Since the
+ *      display buffer flags are only stored per view, the cache also
+ *      counts how many times the buffers were invalidated, and cached
+ *      buffers computed before the last invalidation are not used.
+ *
  *      data field is not null only for elements of cache, not used for
  *      original image buffers.
  *
@@ -221,11 +227,11 @@ struct ColormanageCacheDisplaySettings {
 struct ColormanageCacheKey {
   int view;    /* view transformation used for display buffer */
   int display; /* display device name */
+  int look;    /* Additional artistic transform. */
 };
 
 struct ColormanageCacheData {
   int flag;                    /* view flags of cached buffer */
-  int look;                    /* Additional artistic transform. */
   float exposure;              /* exposure value cached buffer is calculated with */
   float gamma;                 /* gamma value cached buffer is calculated with */
   float dither;                /* dither value cached buffer is calculated with */
@@ -233,12 +239,16 @@ struct ColormanageCacheData {
   float tint;                  /* tint value cached buffer is calculated with */
   CurveMapping *curve_mapping; /* curve mapping used for cached buffer */
   int curve_mapping_timestamp; /* time stamp of curve mapping used for cached buffer */
+  int invalidate_count;        /* #ColormanageCache::invalidate_count of the image buffer */
 };
 
 struct ColormanageCache {
   MovieCache *moviecache;
 
   ColormanageCacheData *data;
+
+  /* Number of times all display buffers of the image were marked as invalid. */
+  int invalidate_count;
 };
 
 static MovieCache *colormanage_moviecache_get(const ImBuf *ibuf)
@@ -265,7 +275,7 @@ static uint colormanage_hashhash(const void *key_v)
 
   uint rval = (key->display << 16) | (key->view % 0xffff);
 
-  return rval;
+  return rval ^ (uint(key->look) * 0x9e3779b9u);
 }
 
 static bool colormanage_hashcmp(const void *av, const void *bv)
@@ -273,7 +283,7 @@ static bool colormanage_hashcmp(const void *av, const void *bv)
   const ColormanageCacheKey *a = static_cast<const ColormanageCacheKey *>(av);
   const ColormanageCacheKey *b = static_cast<const ColormanageCacheKey *>(bv);
 
-  return ((a->view != b->view) || (a->display != b->display));
+  return ((a->view != b->view) || (a->display != b->display) || (a->look != b->look));
 }
 
 static MovieCache *colormanage_moviecache_ensure(ImBuf *ibuf)
@@ -340,6 +350,21 @@ static void colormanage_settings_to_key(ColormanageCacheKey *key,
 {
   key->view = view_settings->view;
   key->display = display_settings->display;
+  key->look = view_settings->look;
+}
+
+static int colormanage_invalidate_count_get(const ImBuf *ibuf)
+{
+  return ibuf->colormanage_cache ? ibuf->colormanage_cache->invalidate_count : 0;
+}
+
+/* Mark all display buffers of the image buffer as invalid. */
+static void colormanage_display_buffers_invalidate(ImBuf *ibuf)
+{
+  memset(ibuf->display_buffer_flags, 0, g_config->get_num_displays() * sizeof(uint));
+  if (ibuf->colormanage_cache) {
+    ibuf->colormanage_cache->invalidate_count++;
+  }
 }
 
 static ImBuf *colormanage_cache_get_ibuf(ImBuf *ibuf,
@@ -397,7 +422,7 @@ static uchar *colormanage_cache_get(ImBuf *ibuf,
      */
     const ColormanageCacheData *cache_data = colormanage_cachedata_get(cache_ibuf);
 
-    if (cache_data->look != view_settings->look ||
+    if (cache_data->invalidate_count != colormanage_invalidate_count_get(ibuf) ||
         cache_data->exposure != view_settings->exposure ||
         cache_data->gamma != view_settings->gamma || cache_data->dither != view_settings->dither ||
         cache_data->temperature != view_settings->temperature ||
@@ -444,7 +469,6 @@ static void colormanage_cache_put(ImBuf *ibuf,
   /* Store data which is needed to check whether cached buffer
    * could be used for color managed display settings. */
   cache_data = MEM_callocN<ColormanageCacheData>("color manage cache imbuf data");
-  cache_data->look = view_settings->look;
   cache_data->exposure = view_settings->exposure;
   cache_data->gamma = view_settings->gamma;
   cache_data->dither = view_settings->dither;
@@ -453,6 +477,7 @@ static void colormanage_cache_put(ImBuf *ibuf,
   cache_data->flag = view_settings->flag;
   cache_data->curve_mapping = curve_mapping;
   cache_data->curve_mapping_timestamp = curve_mapping_timestamp;
+  cache_data->invalidate_count = colormanage_invalidate_count_get(ibuf);
 
   colormanage_cachedata_set(cache_ibuf, cache_data);
 
@@ -2517,7 +2542,7 @@ uchar *IMB_display_buffer_acquire(ImBuf *ibuf,
     /* all display buffers were marked as invalid from other areas,
      * now propagate this flag to internal color management routines
      */
-    memset(ibuf->display_buffer_flags, 0, g_config->get_num_displays() * sizeof(uint));
+    colormanage_display_buffers_invalidate(ibuf);
 
     ibuf->userflags &= ~IB_DISPLAY_BUFFER_INVALID;
   }
@@ -3181,8 +3206,13 @@ static void imb_partial_display_buffer_update_ex(
     buffer_width = ibuf->x;
 
     /* Mark all other buffers as invalid. */
-    memset(ibuf->display_buffer_flags, 0, g_config->get_num_displays() * sizeof(uint));
+    colormanage_display_buffers_invalidate(ibuf);
     ibuf->display_buffer_flags[display_index] |= view_flag;
+    if (display_buffer) {
+      /* The buffer being updated stays valid. */
+      colormanage_cachedata_get(static_cast<ImBuf *>(cache_handle))->invalidate_count =
+          colormanage_invalidate_count_get(ibuf);
+    }
 
     BLI_thread_unlock(LOCK_COLORMANAGE);
   }
@@ -16,6 +16,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_ghash.h"
+#include "BLI_memory_cache.hh"
 #include "BLI_mempool.h"
 #include "BLI_string.h"
 
@@ -363,9 +364,22 @@ static void do_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf, boo
   MEM_SAFE_FREE(cache->points);
 }
 
+/**
+ * Image buffers share the memory budget with #blender::memory_cache, so other cached data is
+ * freed when movie caches grow.
+ */
+static void moviecache_report_memory_usage()
+{
+  limitor_lock.lock();
+  const size_t mem_in_use = limitor ? MEM_CacheLimiter_get_memory_in_use(limitor) : 0;
+  limitor_lock.unlock();
+  blender::memory_cache::set_external_usage("Image Buffers", int64_t(mem_in_use));
+}
+
 void IMB_moviecache_put(MovieCache *cache, void *userkey, ImBuf *ibuf)
 {
   do_moviecache_put(cache, userkey, ibuf, true);
+  moviecache_report_memory_usage();
 }
 
 bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibuf)
@@ -386,6 +400,10 @@ bool IMB_moviecache_put_if_possible(MovieCache *cache, void *userkey, ImBuf *ibu
 
   limitor_lock.unlock();
 
+  if (result) {
+    moviecache_report_memory_usage();
+  }
+
   return result;
 }
 
@@ -801,7 +801,7 @@ struct ExrLayer {
   ListBase passes;
 };
 
-static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data);
+static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data, bool allocate_passes);
 
 /* ********************** */
 
@@ -1028,12 +1028,8 @@ bool IMB_exr_begin_write(void *handle,
   return (data->ofile != nullptr);
 }
 
-bool IMB_exr_begin_read(
-    void *handle, const char *filepath, int *width, int *height, const bool parse_channels)
+static bool imb_exr_open_input_file(ExrHandle *data, const char *filepath)
 {
-  ExrHandle *data = (ExrHandle *)handle;
-  ExrChannel *echan;
-
   /* 32 is arbitrary, but zero length files crashes exr. */
   if (!(BLI_exists(filepath) && BLI_file_size(filepath) > 32)) {
     return false;
@@ -1057,12 +1053,26 @@ bool IMB_exr_begin_read(
   }
 
   Box2i dw = data->ifile->header(0).dataWindow();
-  data->width = *width = dw.max.x - dw.min.x + 1;
-  data->height = *height = dw.max.y - dw.min.y + 1;
+  data->width = dw.max.x - dw.min.x + 1;
+  data->height = dw.max.y - dw.min.y + 1;
+  return true;
+}
+
+bool IMB_exr_begin_read(
+    void *handle, const char *filepath, int *width, int *height, const bool parse_channels)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  ExrChannel *echan;
+
+  if (!imb_exr_open_input_file(data, filepath)) {
+    return false;
+  }
+  *width = data->width;
+  *height = data->height;
 
   if (parse_channels) {
     /* Parse channels into view/layer/pass. */
-    if (!imb_exr_multilayer_parse_channels_from_file(data)) {
+    if (!imb_exr_multilayer_parse_channels_from_file(data, true)) {
       return false;
     }
   }
@@ -1088,6 +1098,42 @@ bool IMB_exr_begin_read(
   return true;
 }
 
+bool IMB_exr_begin_read_passes(void *handle, const char *filepath, int *width, int *height)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+
+  if (!imb_exr_open_input_file(data, filepath)) {
+    return false;
+  }
+  *width = data->width;
+  *height = data->height;
+
+  return imb_exr_multilayer_parse_channels_from_file(data, false);
+}
+
+bool IMB_exr_set_pass_rect(void *handle,
+                           const char *layname,
+                           const char *passname,
+                           const char *viewname,
+                           float *rect)
+{
+  ExrHandle *data = (ExrHandle *)handle;
+  const ExrLayer *lay = (const ExrLayer *)BLI_findstring(
+      &data->layers, layname, offsetof(ExrLayer, name));
+  if (lay == nullptr) {
+    return false;
+  }
+  LISTBASE_FOREACH (ExrPass *, pass, &lay->passes) {
+    if (pass->totchan && STREQ(pass->internal_name, passname) && STREQ(pass->view, viewname)) {
+      imb_exr_pass_assign_rect(data, pass, rect);
+      /* The buffer is owned by the caller. */
+      pass->rect = nullptr;
+      return true;
+    }
+  }
+  return false;
+}
+
 bool IMB_exr_set_channel(
     void *handle, const char *layname, const char *passname, int xstride, int ystride, float *rect)
 {
@@ -1239,6 +1285,11 @@ void IMB_exr_read_channels(void *handle)
       }
     }
 
+    /* Parts are usually used for separate layers, skip decoding those that aren't needed. */
+    if (frameBuffer.begin() == frameBuffer.end()) {
+      continue;
+    }
+
     /* Read pixels. */
     try {
       in.setFrameBuffer(frameBuffer);
@@ -1604,7 +1655,70 @@ static std::vector<MultiViewChannelName> exr_channels_in_multi_part_file(
   return channels;
 }
 
-static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
+/**
+ * Assign the buffer the channels of the pass are read into, interleaved in the order of
+ * #ExrPass::chan_id. The buffer may be null to only compute that order.
+ */
+static void imb_exr_pass_assign_rect(ExrHandle *data, ExrPass *pass, float *rect)
+{
+  pass->rect = rect;
+  if (pass->totchan == 1) {
+    ExrChannel *echan = pass->chan[0];
+    echan->rect = pass->rect;
+    echan->xstride = 1;
+    echan->ystride = data->width;
+    pass->chan_id[0] = echan->chan_id;
+  }
+  else {
+    char lookup[256];
+
+    memset(lookup, 0, sizeof(lookup));
+
+    /* we can have RGB(A), XYZ(W), UVA */
+    if (ELEM(pass->totchan, 3, 4)) {
+      if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
+          pass->chan[2]->chan_id == 'B')
+      {
+        lookup[uint('R')] = 0;
+        lookup[uint('G')] = 1;
+        lookup[uint('B')] = 2;
+        lookup[uint('A')] = 3;
+      }
+      else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
+               pass->chan[2]->chan_id == 'Y')
+      {
+        lookup[uint('X')] = 0;
+        lookup[uint('Y')] = 1;
+        lookup[uint('Z')] = 2;
+        lookup[uint('W')] = 3;
+      }
+      else {
+        lookup[uint('U')] = 0;
+        lookup[uint('V')] = 1;
+        lookup[uint('A')] = 2;
+      }
+      for (int a = 0; a < pass->totchan; a++) {
+        ExrChannel *echan = pass->chan[a];
+        echan->rect = rect ? pass->rect + lookup[uint(echan->chan_id)] : nullptr;
+        echan->xstride = pass->totchan;
+        echan->ystride = data->width * pass->totchan;
+        pass->chan_id[uint(lookup[uint(echan->chan_id)])] = echan->chan_id;
+      }
+    }
+    else { /* unknown */
+      for (int a = 0; a < pass->totchan; a++) {
+        ExrChannel *echan = pass->chan[a];
+        echan->rect = rect ? pass->rect + a : nullptr;
+        echan->xstride = pass->totchan;
+        echan->ystride = data->width * pass->totchan;
+        pass->chan_id[a] = echan->chan_id;
+      }
+    }
+  }
+}
+
+static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data,
+                                                        const bool allocate_passes)
 {
   std::vector<MultiViewChannelName> channels = exr_channels_in_multi_part_file(*data->ifile);
 
@@ -1663,61 +1777,12 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
   LISTBASE_FOREACH (ExrLayer *, lay, &data->layers) {
     LISTBASE_FOREACH (ExrPass *, pass, &lay->passes) {
       if (pass->totchan) {
-        pass->rect = MEM_calloc_arrayN<float>(
-            size_t(data->width) * size_t(data->height) * size_t(pass->totchan), "pass rect");
-        if (pass->totchan == 1) {
-          ExrChannel *echan = pass->chan[0];
-          echan->rect = pass->rect;
-          echan->xstride = 1;
-          echan->ystride = data->width;
-          pass->chan_id[0] = echan->chan_id;
-        }
-        else {
-          char lookup[256];
-
-          memset(lookup, 0, sizeof(lookup));
-
-          /* we can have RGB(A), XYZ(W), UVA */
-          if (ELEM(pass->totchan, 3, 4)) {
-            if (pass->chan[0]->chan_id == 'B' || pass->chan[1]->chan_id == 'B' ||
-                pass->chan[2]->chan_id == 'B')
-            {
-              lookup[uint('R')] = 0;
-              lookup[uint('G')] = 1;
-              lookup[uint('B')] = 2;
-              lookup[uint('A')] = 3;
-            }
-            else if (pass->chan[0]->chan_id == 'Y' || pass->chan[1]->chan_id == 'Y' ||
-                     pass->chan[2]->chan_id == 'Y')
-            {
-              lookup[uint('X')] = 0;
-              lookup[uint('Y')] = 1;
-              lookup[uint('Z')] = 2;
-              lookup[uint('W')] = 3;
-            }
-            else {
-              lookup[uint('U')] = 0;
-              lookup[uint('V')] = 1;
-              lookup[uint('A')] = 2;
-            }
-            for (int a = 0; a < pass->totchan; a++) {
-              echan = pass->chan[a];
-              echan->rect = pass->rect + lookup[uint(echan->chan_id)];
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
-              pass->chan_id[uint(lookup[uint(echan->chan_id)])] = echan->chan_id;
-            }
-          }
-          else { /* unknown */
-            for (int a = 0; a < pass->totchan; a++) {
-              ExrChannel *echan = pass->chan[a];
-              echan->rect = pass->rect + a;
-              echan->xstride = pass->totchan;
-              echan->ystride = data->width * pass->totchan;
-              pass->chan_id[a] = echan->chan_id;
-            }
-          }
+        float *rect = nullptr;
+        if (allocate_passes) {
+          rect = MEM_calloc_arrayN<float>(
+              size_t(data->width) * size_t(data->height) * size_t(pass->totchan), "pass rect");
         }
+        imb_exr_pass_assign_rect(data, pass, rect);
       }
     }
   }
@@ -1729,7 +1794,8 @@ static bool imb_exr_multilayer_parse_channels_from_file(ExrHandle *data)
 static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
                                          MultiPartInputFile &file,
                                          int width,
-                                         int height)
+                                         int height,
+                                         const bool allocate_passes)
 {
   ExrHandle *data = (ExrHandle *)IMB_exr_get_handle();
 
@@ -1739,7 +1805,7 @@ static ExrHandle *imb_exr_begin_read_mem(IStream &file_stream,
   data->width = width;
   data->height = height;
 
-  if (!imb_exr_multilayer_parse_channels_from_file(data)) {
+  if (!imb_exr_multilayer_parse_channels_from_file(data, allocate_passes)) {
     IMB_exr_close(data);
     return nullptr;
   }
@@ -2128,9 +2194,13 @@ ImBuf *imb_load_openexr(const uchar *mem, size_t size, int flags, ImFileColorSpa
         /* Only enters with IB_multilayer flag set. */
         if (is_multi && ((flags & IB_thumbnail) == 0)) {
           /* constructs channels for reading, allocates memory in channels */
-          ExrHandle *handle = imb_exr_begin_read_mem(*membuf, *file, width, height);
+          const bool read_pixels = (flags & IB_multilayer_lazy) == 0;
+          ExrHandle *handle = imb_exr_begin_read_mem(
+              *membuf, *file, width, height, read_pixels);
           if (handle) {
-            IMB_exr_read_channels(handle);
+            if (read_pixels) {
+              IMB_exr_read_channels(handle);
+            }
             ibuf->userdata = handle; /* potential danger, the caller has to check for this! */
           }
         }
@@ -35,6 +35,13 @@ bool IMB_exr_begin_read(void * /*handle*/,
 {
   return false;
 }
+bool IMB_exr_begin_read_passes(void * /*handle*/,
+                               const char * /*filepath*/,
+                               int * /*width*/,
+                               int * /*height*/)
+{
+  return false;
+}
 bool IMB_exr_begin_write(void * /*handle*/,
                          const char * /*filepath*/,
                          int /*width*/,
@@ -57,6 +64,15 @@ bool IMB_exr_set_channel(void * /*handle*/,
   return false;
 }
 
+bool IMB_exr_set_pass_rect(void * /*handle*/,
+                           const char * /*layname*/,
+                           const char * /*passname*/,
+                           const char * /*viewname*/,
+                           float * /*rect*/)
+{
+  return false;
+}
+
 void IMB_exr_read_channels(void * /*handle*/) {}
 void IMB_exr_write_channels(void * /*handle*/) {}
 
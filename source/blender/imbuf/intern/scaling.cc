@@ -7,7 +7,10 @@
  * \ingroup imbuf
  */
 
+#include <algorithm>
+
 #include "BLI_math_vector.hh"
+#include "BLI_simd.hh"
 #include "BLI_task.hh"
 #include "BLI_utildefines.h"
 #include "MEM_guardedalloc.h"
@@ -232,9 +235,53 @@ MINLINE void premul_ushort_to_straight_uchar(uchar *result, const ushort color[4
   }
 }
 
+static void onehalf_byte_row(const uchar *cp1, const uchar *cp2, uchar *dest, const int width)
+{
+  for (int x = 0; x < width; x++) {
+    ushort p1i[8], p2i[8], desti[4];
+
+    straight_uchar_to_premul_ushort(p1i, cp1);
+    straight_uchar_to_premul_ushort(p2i, cp2);
+    straight_uchar_to_premul_ushort(p1i + 4, cp1 + 4);
+    straight_uchar_to_premul_ushort(p2i + 4, cp2 + 4);
+
+    desti[0] = (uint(p1i[0]) + p2i[0] + p1i[4] + p2i[4]) >> 2;
+    desti[1] = (uint(p1i[1]) + p2i[1] + p1i[5] + p2i[5]) >> 2;
+    desti[2] = (uint(p1i[2]) + p2i[2] + p1i[6] + p2i[6]) >> 2;
+    desti[3] = (uint(p1i[3]) + p2i[3] + p1i[7] + p2i[7]) >> 2;
+
+    premul_ushort_to_straight_uchar(dest, desti);
+
+    cp1 += 8;
+    cp2 += 8;
+    dest += 4;
+  }
+}
+
+static void onehalf_float_row(const float *p1f, const float *p2f, float *destf, const int width)
+{
+  for (int x = 0; x < width; x++) {
+#if BLI_HAVE_SSE2
+    /* Same order of additions as the scalar code below, to get identical results. */
+    __m128 sum = _mm_add_ps(_mm_loadu_ps(p1f), _mm_loadu_ps(p2f));
+    sum = _mm_add_ps(sum, _mm_loadu_ps(p1f + 4));
+    sum = _mm_add_ps(sum, _mm_loadu_ps(p2f + 4));
+    _mm_storeu_ps(destf, _mm_mul_ps(sum, _mm_set1_ps(0.25f)));
+#else
+    destf[0] = 0.25f * (p1f[0] + p2f[0] + p1f[4] + p2f[4]);
+    destf[1] = 0.25f * (p1f[1] + p2f[1] + p1f[5] + p2f[5]);
+    destf[2] = 0.25f * (p1f[2] + p2f[2] + p1f[6] + p2f[6]);
+    destf[3] = 0.25f * (p1f[3] + p2f[3] + p1f[7] + p2f[7]);
+#endif
+    p1f += 8;
+    p2f += 8;
+    destf += 4;
+  }
+}
+
 void imb_onehalf_no_alloc(ImBuf *ibuf2, ImBuf *ibuf1)
 {
-  int x, y;
+  using namespace blender;
   const bool do_rect = (ibuf1->byte_buffer.data != nullptr);
   const bool do_float = (ibuf1->float_buffer.data != nullptr) &&
                         (ibuf2->float_buffer.data != nullptr);
@@ -252,62 +299,24 @@ void imb_onehalf_no_alloc(ImBuf *ibuf2, ImBuf *ibuf1)
     return;
   }
 
-  if (do_rect) {
-    uchar *cp1, *cp2, *dest;
-
-    cp1 = ibuf1->byte_buffer.data;
-    dest = ibuf2->byte_buffer.data;
-
-    for (y = ibuf2->y; y > 0; y--) {
-      cp2 = cp1 + (ibuf1->x << 2);
-      for (x = ibuf2->x; x > 0; x--) {
-        ushort p1i[8], p2i[8], desti[4];
-
-        straight_uchar_to_premul_ushort(p1i, cp1);
-        straight_uchar_to_premul_ushort(p2i, cp2);
-        straight_uchar_to_premul_ushort(p1i + 4, cp1 + 4);
-        straight_uchar_to_premul_ushort(p2i + 4, cp2 + 4);
-
-        desti[0] = (uint(p1i[0]) + p2i[0] + p1i[4] + p2i[4]) >> 2;
-        desti[1] = (uint(p1i[1]) + p2i[1] + p1i[5] + p2i[5]) >> 2;
-        desti[2] = (uint(p1i[2]) + p2i[2] + p1i[6] + p2i[6]) >> 2;
-        desti[3] = (uint(p1i[3]) + p2i[3] + p1i[7] + p2i[7]) >> 2;
-
-        premul_ushort_to_straight_uchar(dest, desti);
-
-        cp1 += 8;
-        cp2 += 8;
-        dest += 4;
-      }
-      cp1 = cp2;
-      if (ibuf1->x & 1) {
-        cp1 += 4;
-      }
-    }
-  }
-
-  if (do_float) {
-    float *p1f, *p2f, *destf;
-
-    p1f = ibuf1->float_buffer.data;
-    destf = ibuf2->float_buffer.data;
-    for (y = ibuf2->y; y > 0; y--) {
-      p2f = p1f + (ibuf1->x << 2);
-      for (x = ibuf2->x; x > 0; x--) {
-        destf[0] = 0.25f * (p1f[0] + p2f[0] + p1f[4] + p2f[4]);
-        destf[1] = 0.25f * (p1f[1] + p2f[1] + p1f[5] + p2f[5]);
-        destf[2] = 0.25f * (p1f[2] + p2f[2] + p1f[6] + p2f[6]);
-        destf[3] = 0.25f * (p1f[3] + p2f[3] + p1f[7] + p2f[7]);
-        p1f += 8;
-        p2f += 8;
-        destf += 4;
+  /* Rows are independent, each destination row averages two source rows. */
+  const int64_t src_stride = int64_t(ibuf1->x) * 4;
+  const int64_t dst_stride = int64_t(ibuf2->x) * 4;
+  const int grain_size = std::max(1, 65536 / std::max(1, ibuf2->x));
+  threading::parallel_for(IndexRange(ibuf2->y), grain_size, [&](const IndexRange y_range) {
+    for (const int64_t y : y_range) {
+      if (do_rect) {
+        const uchar *cp1 = ibuf1->byte_buffer.data + y * 2 * src_stride;
+        onehalf_byte_row(
+            cp1, cp1 + src_stride, ibuf2->byte_buffer.data + y * dst_stride, ibuf2->x);
       }
-      p1f = p2f;
-      if (ibuf1->x & 1) {
-        p1f += 4;
+      if (do_float) {
+        const float *p1f = ibuf1->float_buffer.data + y * 2 * src_stride;
+        onehalf_float_row(
+            p1f, p1f + src_stride, ibuf2->float_buffer.data + y * dst_stride, ibuf2->x);
       }
     }
-  }
+  });
 }
 
 ImBuf *IMB_onehalf(ImBuf *ibuf1)
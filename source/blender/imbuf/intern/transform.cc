@@ -7,6 +7,7 @@
  * \ingroup imbuf
  */
 
+#include <cstring>
 #include <type_traits>
 
 #include "BLI_math_color.h"
@@ -15,6 +16,7 @@
 #include "BLI_math_matrix_types.hh"
 #include "BLI_math_vector.h"
 #include "BLI_rect.h"
+#include "BLI_simd.hh"
 #include "BLI_task.hh"
 
 #include "IMB_imbuf.hh"
@@ -199,9 +201,24 @@ static void add_subsample(const float src[4], float dst[4])
 
 static void add_subsample(const uchar src[4], float dst[4])
 {
+#if BLI_HAVE_SSE2
+  /* Box filtering accumulates many samples per pixel, do the conversion in one go. */
+  uint32_t packed;
+  memcpy(&packed, src, sizeof(packed));
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i rgba_i = _mm_unpacklo_epi16(
+      _mm_unpacklo_epi8(_mm_cvtsi32_si128(int(packed)), zero), zero);
+  const __m128 rgba = _mm_mul_ps(_mm_cvtepi32_ps(rgba_i), _mm_set1_ps(1.0f / 255.0f));
+  /* Multiply the colors by alpha, keep alpha itself. */
+  const __m128 alpha = _mm_shuffle_ps(rgba, rgba, _MM_SHUFFLE(3, 3, 3, 3));
+  const __m128 fac = _mm_or_ps(_mm_and_ps(_mm_castsi128_ps(_mm_set_epi32(0, -1, -1, -1)), alpha),
+                               _mm_castsi128_ps(_mm_set_epi32(0x3f800000, 0, 0, 0)));
+  _mm_storeu_ps(dst, _mm_add_ps(_mm_loadu_ps(dst), _mm_mul_ps(rgba, fac)));
+#else
   float premul[4];
   straight_uchar_to_premul_float(premul, src);
   add_v4_v4(dst, premul);
+#endif
 }
 
 static void store_premul_float_sample(const float sample[4], float dst[4])
@@ -172,6 +172,13 @@ int MOV_calc_frame_index_with_timecode(MovieReader *anim, IMB_Timecode_Type tc,
  */
 int MOV_get_existing_proxies(const MovieReader *anim);
 
+/**
+ * Queries which time-code indices exist for this movie, like #MOV_get_existing_proxies.
+ *
+ * Returns bitmask of #IMB_Timecode_Type flags.
+ */
+int MOV_get_existing_timecodes(const MovieReader *anim);
+
 /**
  * Initialize movie proxies / time-code indices builder.
  */
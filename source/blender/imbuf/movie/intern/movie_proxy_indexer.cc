@@ -7,6 +7,7 @@
  * \ingroup imbuf
  */
 
+#include <algorithm>
 #include <cstdlib>
 
 #include "MEM_guardedalloc.h"
@@ -43,6 +44,8 @@ static const char binary_header_str[] = "BlenMIdx";
 static const IMB_Proxy_Size proxy_sizes[] = {
     IMB_PROXY_25, IMB_PROXY_50, IMB_PROXY_75, IMB_PROXY_100};
 static const float proxy_fac[] = {0.25, 0.50, 0.75, 1.00};
+static const IMB_Timecode_Type tc_types[IMB_TC_NUM_TYPES] = {IMB_TC_RECORD_RUN,
+                                                             IMB_TC_RECORD_RUN_NO_GAPS};
 
 #define INDEX_FILE_VERSION 2
 
@@ -232,6 +235,17 @@ int MovieIndex::get_frame_index(int frameno) const
   return first;
 }
 
+int MovieIndex::get_frame_index_from_pts(uint64_t pts) const
+{
+  /* Entries are added in presentation order, so their time stamps are sorted. */
+  const MovieIndexFrame *frame = std::upper_bound(
+      this->entries.begin(),
+      this->entries.end(),
+      pts,
+      [](const uint64_t value, const MovieIndexFrame &entry) { return value < entry.pts; });
+  return std::max(int(frame - this->entries.begin()) - 1, 0);
+}
+
 uint64_t MovieIndex::get_pts(int frame_index) const
 {
   frame_index = blender::math::clamp<int>(frame_index, 0, this->entries.size() - 1);
@@ -319,7 +333,7 @@ static bool get_proxy_filepath(const MovieReader *anim,
   return true;
 }
 
-static void get_tc_filepath(MovieReader *anim, IMB_Timecode_Type tc, char *filepath)
+static void get_tc_filepath(const MovieReader *anim, IMB_Timecode_Type tc, char *filepath)
 {
   char index_dir[FILE_MAXDIR];
   int i = tc == IMB_TC_RECORD_RUN_NO_GAPS ? 1 : 0;
@@ -661,9 +675,6 @@ static void free_proxy_output_ffmpeg(proxy_output_ctx *ctx, int rollback)
   MEM_freeN(ctx);
 }
 
-static IMB_Timecode_Type tc_types[IMB_TC_NUM_TYPES] = {IMB_TC_RECORD_RUN,
-                                                       IMB_TC_RECORD_RUN_NO_GAPS};
-
 struct MovieProxyBuilder {
 
   AVFormatContext *iFormatCtx;
@@ -709,7 +720,6 @@ static MovieProxyBuilder *index_ffmpeg_create_context(MovieReader *anim,
   int num_proxy_sizes = IMB_PROXY_MAX_SLOT;
   int i, streamcount;
 
-  context->tcs_in_use = tcs_in_use;
   context->proxy_sizes_in_use = proxy_sizes_in_use;
   context->num_proxy_sizes = IMB_PROXY_MAX_SLOT;
   context->build_only_on_bad_performance = build_only_on_bad_performance;
@@ -798,15 +808,6 @@ static MovieProxyBuilder *index_ffmpeg_create_context(MovieReader *anim,
     }
   }
 
-  if (context->proxy_ctx[0] == nullptr && context->proxy_ctx[1] == nullptr &&
-      context->proxy_ctx[2] == nullptr && context->proxy_ctx[3] == nullptr)
-  {
-    avformat_close_input(&context->iFormatCtx);
-    avcodec_free_context(&context->iCodecCtx);
-    MEM_freeN(context);
-    return nullptr; /* Nothing to transcode. */
-  }
-
   for (i = 0; i < IMB_TC_NUM_TYPES; i++) {
     if (tcs_in_use & tc_types[i]) {
       char filepath[FILE_MAX];
@@ -819,6 +820,18 @@ static MovieProxyBuilder *index_ffmpeg_create_context(MovieReader *anim,
       }
     }
   }
+  context->tcs_in_use = tcs_in_use;
+
+  /* Building only the time code index is supported, it is enough to seek quickly and precisely
+   * in files with long GOPs. */
+  if (context->proxy_ctx[0] == nullptr && context->proxy_ctx[1] == nullptr &&
+      context->proxy_ctx[2] == nullptr && context->proxy_ctx[3] == nullptr && tcs_in_use == 0)
+  {
+    avformat_close_input(&context->iFormatCtx);
+    avcodec_free_context(&context->iCodecCtx);
+    MEM_freeN(context);
+    return nullptr; /* Nothing to transcode. */
+  }
 
   return context;
 }
@@ -1148,7 +1161,21 @@ MovieProxyBuilder *MOV_proxy_builder_start(MovieReader *anim,
     proxy_sizes_to_build &= ~built_proxies;
   }
 
-  if (proxy_sizes_to_build == 0) {
+  int tcs_to_build = tcs_in_use;
+  for (int i = 0; i < IMB_TC_NUM_TYPES; i++) {
+    if ((tcs_to_build & tc_types[i]) == 0) {
+      continue;
+    }
+    char filepath[FILE_MAX];
+    get_tc_filepath(anim, tc_types[i], filepath);
+    if ((processed_paths != nullptr && !processed_paths->add(filepath)) ||
+        (!overwrite && BLI_exists(filepath)))
+    {
+      tcs_to_build &= ~int(tc_types[i]);
+    }
+  }
+
+  if (proxy_sizes_to_build == 0 && tcs_to_build == 0) {
     return nullptr;
   }
 
@@ -1156,7 +1183,7 @@ MovieProxyBuilder *MOV_proxy_builder_start(MovieReader *anim,
 #ifdef WITH_FFMPEG
   if (anim->state == MovieReader::State::Valid) {
     context = index_ffmpeg_create_context(
-        anim, tcs_in_use, proxy_sizes_to_build, quality, build_only_on_bad_performance);
+        anim, tcs_to_build, proxy_sizes_to_build, quality, build_only_on_bad_performance);
   }
 #else
   UNUSED_VARS(build_only_on_bad_performance);
@@ -1272,12 +1299,13 @@ const MovieIndex *movie_open_index(MovieReader *anim, IMB_Timecode_Type tc)
     index = &anim->no_gaps;
   }
 
-  if (anim->indices_tried & tc) {
-    return nullptr;
-  }
   if (index == nullptr) {
     return nullptr;
   }
+  if (anim->indices_tried & tc) {
+    /* Return the index loaded before, if any, the file is only read once. */
+    return *index;
+  }
 
   get_tc_filepath(anim, tc, filepath);
 
@@ -1313,3 +1341,16 @@ int MOV_get_existing_proxies(const MovieReader *anim)
   }
   return existing;
 }
+
+int MOV_get_existing_timecodes(const MovieReader *anim)
+{
+  int existing = IMB_TC_NONE;
+  for (int i = 0; i < IMB_TC_NUM_TYPES; i++) {
+    char filepath[FILE_MAX];
+    get_tc_filepath(anim, tc_types[i], filepath);
+    if (BLI_exists(filepath)) {
+      existing |= int(tc_types[i]);
+    }
+  }
+  return existing;
+}
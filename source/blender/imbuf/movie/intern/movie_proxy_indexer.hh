@@ -49,6 +49,8 @@ struct MovieIndex {
   uint64_t get_seek_pos_dts(int frame_index) const;
 
   int get_frame_index(int frameno) const;
+  /** Index of the last frame presented at or before given time stamp. */
+  int get_frame_index_from_pts(uint64_t pts) const;
   uint64_t get_pts(int frame_index) const;
   int get_duration() const;
 };
@@ -41,6 +41,7 @@
 extern "C" {
 #  include <libavcodec/avcodec.h>
 #  include <libavformat/avformat.h>
+#  include <libavutil/hwcontext.h>
 #  include <libavutil/imgutils.h>
 #  include <libavutil/rational.h>
 #  include <libswscale/swscale.h>
@@ -321,23 +322,79 @@ static AVFormatContext *init_format_context_vpx_workarounds(const char *filepath
   return format_ctx;
 }
 
-static int startffmpeg(MovieReader *anim)
+static AVPixelFormat ffmpeg_hw_get_format(AVCodecContext *pCodecCtx,
+                                           const AVPixelFormat *pix_fmts)
 {
-  if (anim == nullptr) {
-    return -1;
+  const MovieReader *anim = static_cast<const MovieReader *>(pCodecCtx->opaque);
+  for (const AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if (*pix_fmt == anim->hw_pix_fmt) {
+      return *pix_fmt;
+    }
+  }
+  /* The device can't decode this stream (e.g. unsupported profile or resolution), let the
+   * decoder continue in software. */
+  for (const AVPixelFormat *pix_fmt = pix_fmts; *pix_fmt != AV_PIX_FMT_NONE; pix_fmt++) {
+    if ((av_pix_fmt_desc_get(*pix_fmt)->flags & AV_PIX_FMT_FLAG_HWACCEL) == 0) {
+      return *pix_fmt;
+    }
   }
+  return AV_PIX_FMT_NONE;
+}
 
-  int video_stream_index;
-  const AVCodec *pCodec = nullptr;
-  AVFormatContext *pFormatCtx = init_format_context_vpx_workarounds(
-      anim->filepath, anim->streamindex, video_stream_index, pCodec);
-  if (pFormatCtx == nullptr || pCodec == nullptr) {
-    avformat_close_input(&pFormatCtx);
-    return -1;
+/**
+ * Set up hardware decoding with the first device type of the platform that the codec supports
+ * and that can be created on this system.
+ */
+static bool ffmpeg_hw_decode_init(MovieReader *anim,
+                                  AVCodecContext *pCodecCtx,
+                                  const AVCodec *pCodec)
+{
+  static const AVHWDeviceType device_types[] = {
+#  if defined(__APPLE__)
+      AV_HWDEVICE_TYPE_VIDEOTOOLBOX,
+#  elif defined(_WIN32)
+      AV_HWDEVICE_TYPE_D3D11VA,
+      AV_HWDEVICE_TYPE_CUDA,
+#  else
+      AV_HWDEVICE_TYPE_VAAPI,
+      AV_HWDEVICE_TYPE_CUDA,
+#  endif
+  };
+
+  for (const AVHWDeviceType device_type : device_types) {
+    for (int i = 0;; i++) {
+      const AVCodecHWConfig *config = avcodec_get_hw_config(pCodec, i);
+      if (config == nullptr) {
+        break;
+      }
+      if (config->device_type != device_type ||
+          (config->methods & AV_CODEC_HW_CONFIG_METHOD_HW_DEVICE_CTX) == 0)
+      {
+        continue;
+      }
+      AVBufferRef *device_ctx = nullptr;
+      if (av_hwdevice_ctx_create(&device_ctx, device_type, nullptr, nullptr, 0) < 0) {
+        break;
+      }
+      /* Owned by the codec context from now on. */
+      pCodecCtx->hw_device_ctx = device_ctx;
+      pCodecCtx->opaque = anim;
+      pCodecCtx->get_format = ffmpeg_hw_get_format;
+      /* The current and backup frames are kept while decoding, see #ffmpeg_decode_video_frame. */
+      pCodecCtx->extra_hw_frames = 2;
+      anim->hw_pix_fmt = config->pix_fmt;
+      return true;
+    }
   }
+  return false;
+}
 
+static AVCodecContext *ffmpeg_codec_context_open(MovieReader *anim,
+                                                 const AVCodec *pCodec,
+                                                 const AVStream *video_stream,
+                                                 const bool use_hw_decode)
+{
   AVCodecContext *pCodecCtx = avcodec_alloc_context3(nullptr);
-  AVStream *video_stream = pFormatCtx->streams[video_stream_index];
   avcodec_parameters_to_context(pCodecCtx, video_stream->codecpar);
   pCodecCtx->workaround_bugs = FF_BUG_AUTODETECT;
 
@@ -355,7 +412,116 @@ static int startffmpeg(MovieReader *anim)
     pCodecCtx->thread_type = FF_THREAD_SLICE;
   }
 
+  if (use_hw_decode && !ffmpeg_hw_decode_init(anim, pCodecCtx, pCodec)) {
+    avcodec_free_context(&pCodecCtx);
+    return nullptr;
+  }
+
   if (avcodec_open2(pCodecCtx, pCodec, nullptr) < 0) {
+    avcodec_free_context(&pCodecCtx);
+    anim->hw_pix_fmt = AV_PIX_FMT_NONE;
+    return nullptr;
+  }
+  return pCodecCtx;
+}
+
+/** Pixel format of the decoded frames, after downloading hardware decoded frames. */
+static AVPixelFormat ffmpeg_decoded_pix_fmt(const MovieReader *anim)
+{
+  if (anim->hw_pix_fmt != AV_PIX_FMT_NONE && anim->pCodecCtx->pix_fmt == anim->hw_pix_fmt) {
+    return anim->pCodecCtx->sw_pix_fmt;
+  }
+  return anim->pCodecCtx->pix_fmt;
+}
+
+/**
+ * Create the context converting decoded frames of the given format to #MovieReader.pFrameRGB.
+ */
+static SwsContext *ffmpeg_convert_context_create(MovieReader *anim, const AVPixelFormat src_fmt)
+{
+  /* Use full_chroma_int + accurate_rnd YUV->RGB conversion flags. Otherwise
+   * the conversion is not fully accurate and introduces some banding and color
+   * shifts, particularly in dark regions. See issue #111703 or upstream
+   * ffmpeg ticket https://trac.ffmpeg.org/ticket/1582 */
+  SwsContext *convert_ctx = ffmpeg_sws_get_context(anim->x,
+                                                   anim->y,
+                                                   src_fmt,
+                                                   anim->x,
+                                                   anim->y,
+                                                   anim->pFrameRGB->format,
+                                                   SWS_POINT | SWS_FULL_CHR_H_INT |
+                                                       SWS_ACCURATE_RND);
+  if (!convert_ctx) {
+    fprintf(stderr,
+            "ffmpeg: swscale can't transform from pixel format %s to %s (%s)\n",
+            av_get_pix_fmt_name(src_fmt),
+            av_get_pix_fmt_name((AVPixelFormat)anim->pFrameRGB->format),
+            anim->filepath);
+    return nullptr;
+  }
+
+  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
+  int srcRange, dstRange, brightness, contrast, saturation;
+  int *table;
+  const int *inv_table;
+  if (!sws_getColorspaceDetails(convert_ctx,
+                                (int **)&inv_table,
+                                &srcRange,
+                                &table,
+                                &dstRange,
+                                &brightness,
+                                &contrast,
+                                &saturation))
+  {
+    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
+    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
+
+    if (sws_setColorspaceDetails(convert_ctx,
+                                 (int *)inv_table,
+                                 srcRange,
+                                 table,
+                                 dstRange,
+                                 brightness,
+                                 contrast,
+                                 saturation))
+    {
+      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+    }
+  }
+  else {
+    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
+  }
+
+  anim->img_convert_src_fmt = src_fmt;
+  return convert_ctx;
+}
+
+static int startffmpeg(MovieReader *anim)
+{
+  if (anim == nullptr) {
+    return -1;
+  }
+
+  int video_stream_index;
+  const AVCodec *pCodec = nullptr;
+  AVFormatContext *pFormatCtx = init_format_context_vpx_workarounds(
+      anim->filepath, anim->streamindex, video_stream_index, pCodec);
+  if (pFormatCtx == nullptr || pCodec == nullptr) {
+    avformat_close_input(&pFormatCtx);
+    return -1;
+  }
+
+  AVStream *video_stream = pFormatCtx->streams[video_stream_index];
+  AVCodecContext *pCodecCtx = nullptr;
+  /* De-interlacing works on the decoded frames in the codec pixel format, which hardware decoding
+   * doesn't provide. Fall back to software decoding when the hardware can't be used. */
+  if ((anim->ib_flags & IB_anim_hw_decode) && (anim->ib_flags & IB_animdeinterlace) == 0) {
+    pCodecCtx = ffmpeg_codec_context_open(anim, pCodec, video_stream, true);
+  }
+  if (pCodecCtx == nullptr) {
+    pCodecCtx = ffmpeg_codec_context_open(anim, pCodec, video_stream, false);
+  }
+  if (pCodecCtx == nullptr) {
     avformat_close_input(&pFormatCtx);
     return -1;
   }
@@ -399,14 +565,14 @@ static int startffmpeg(MovieReader *anim)
   anim->y = pCodecCtx->height;
   anim->video_rotation = ffmpeg_get_video_rotation(video_stream);
 
-  /* Decode >8bit videos into floating point image. */
-  anim->is_float = calc_pix_fmt_max_component_bits(pCodecCtx->pix_fmt) > 8;
-
   anim->pFormatCtx = pFormatCtx;
   anim->pCodecCtx = pCodecCtx;
   anim->pCodec = pCodec;
   anim->videoStream = video_stream_index;
 
+  /* Decode >8bit videos into floating point image. */
+  anim->is_float = calc_pix_fmt_max_component_bits(ffmpeg_decoded_pix_fmt(anim)) > 8;
+
   anim->cur_position = 0;
   anim->cur_pts = -1;
   anim->cur_key_frame_pts = -1;
@@ -418,6 +584,7 @@ static int startffmpeg(MovieReader *anim)
   anim->pFrame_backup_complete = false;
   anim->pFrame_complete = false;
   anim->pFrameDeinterlaced = av_frame_alloc();
+  anim->pFrame_hw_download = av_frame_alloc();
   anim->pFrameRGB = av_frame_alloc();
   /* Ideally we'd use AV_PIX_FMT_RGBAF32LE for floats, but currently (ffmpeg 6.1)
    * swscale does not support that as destination. So using AV_PIX_FMT_GBRAPF32LE
@@ -434,6 +601,7 @@ static int startffmpeg(MovieReader *anim)
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrame_hw_download);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
     anim->pCodecCtx = nullptr;
@@ -457,68 +625,20 @@ static int startffmpeg(MovieReader *anim)
         1);
   }
 
-  /* Use full_chroma_int + accurate_rnd YUV->RGB conversion flags. Otherwise
-   * the conversion is not fully accurate and introduces some banding and color
-   * shifts, particularly in dark regions. See issue #111703 or upstream
-   * ffmpeg ticket https://trac.ffmpeg.org/ticket/1582 */
-  anim->img_convert_ctx = ffmpeg_sws_get_context(anim->x,
-                                                 anim->y,
-                                                 anim->pCodecCtx->pix_fmt,
-                                                 anim->x,
-                                                 anim->y,
-                                                 anim->pFrameRGB->format,
-                                                 SWS_POINT | SWS_FULL_CHR_H_INT |
-                                                     SWS_ACCURATE_RND);
-
+  anim->img_convert_ctx = ffmpeg_convert_context_create(anim, ffmpeg_decoded_pix_fmt(anim));
   if (!anim->img_convert_ctx) {
-    fprintf(stderr,
-            "ffmpeg: swscale can't transform from pixel format %s to %s (%s)\n",
-            av_get_pix_fmt_name(anim->pCodecCtx->pix_fmt),
-            av_get_pix_fmt_name((AVPixelFormat)anim->pFrameRGB->format),
-            anim->filepath);
     avcodec_free_context(&anim->pCodecCtx);
     avformat_close_input(&anim->pFormatCtx);
     av_packet_free(&anim->cur_packet);
     av_frame_free(&anim->pFrameRGB);
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrame_hw_download);
     av_frame_free(&anim->pFrame);
     av_frame_free(&anim->pFrame_backup);
     anim->pCodecCtx = nullptr;
     return -1;
   }
 
-  /* Try do detect if input has 0-255 YCbCR range (JFIF, JPEG, Motion-JPEG). */
-  int srcRange, dstRange, brightness, contrast, saturation;
-  int *table;
-  const int *inv_table;
-  if (!sws_getColorspaceDetails(anim->img_convert_ctx,
-                                (int **)&inv_table,
-                                &srcRange,
-                                &table,
-                                &dstRange,
-                                &brightness,
-                                &contrast,
-                                &saturation))
-  {
-    srcRange = srcRange || anim->pCodecCtx->color_range == AVCOL_RANGE_JPEG;
-    inv_table = sws_getCoefficients(anim->pCodecCtx->colorspace);
-
-    if (sws_setColorspaceDetails(anim->img_convert_ctx,
-                                 (int *)inv_table,
-                                 srcRange,
-                                 table,
-                                 dstRange,
-                                 brightness,
-                                 contrast,
-                                 saturation))
-    {
-      fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-    }
-  }
-  else {
-    fprintf(stderr, "Warning: Could not set libswscale colorspace details.\n");
-  }
-
   return 0;
 }
 
@@ -595,6 +715,27 @@ static void ffmpeg_postprocess(MovieReader *anim, AVFrame *input, ImBuf *ibuf)
     return;
   }
 
+  if (anim->hw_pix_fmt != AV_PIX_FMT_NONE && input->format == anim->hw_pix_fmt) {
+    /* Download the frame from the device, only the final frame is downloaded, not the ones that
+     * are decoded while scanning for it. The download format may differ from the one the
+     * conversion context was created for (e.g. NV12 for planar YUV video). */
+    av_frame_unref(anim->pFrame_hw_download);
+    if (av_hwframe_transfer_data(anim->pFrame_hw_download, input, 0) < 0) {
+      fprintf(stderr, "ffmpeg: could not download hardware decoded frame (%s)\n", anim->filepath);
+      return;
+    }
+    input = anim->pFrame_hw_download;
+
+    if (input->format != anim->img_convert_src_fmt) {
+      SwsContext *convert_ctx = ffmpeg_convert_context_create(anim, AVPixelFormat(input->format));
+      if (convert_ctx == nullptr) {
+        return;
+      }
+      ffmpeg_sws_release_context(anim->img_convert_ctx);
+      anim->img_convert_ctx = convert_ctx;
+    }
+  }
+
   av_log(anim->pFormatCtx,
          AV_LOG_DEBUG,
          "  POSTPROC: AVFrame planes: %p %p %p %p\n",
@@ -1050,23 +1191,36 @@ static bool ffmpeg_seek_buffers_need_flushing(MovieReader *anim, int position, i
   return true;
 }
 
-/* Seek to last necessary key frame. */
+/* Seek to last necessary key frame. The `seek_index` is a record run index used to find key
+ * frames when no time code is used, it may be null. */
 static int ffmpeg_seek_to_key_frame(MovieReader *anim,
                                     int position,
                                     const MovieIndex *tc_index,
+                                    const MovieIndex *seek_index,
                                     int64_t pts_to_search)
 {
   int64_t seek_pos;
   int ret;
 
-  if (tc_index) {
+  if (tc_index || seek_index) {
     /* We can use timestamps generated from our indexer to seek. */
-    int new_frame_index = tc_index->get_frame_index(position);
-
-    uint64_t pts = tc_index->get_seek_pos_pts(new_frame_index);
-    uint64_t dts = tc_index->get_seek_pos_dts(new_frame_index);
+    int new_frame_index = tc_index ? tc_index->get_frame_index(position) :
+                                     seek_index->get_frame_index_from_pts(pts_to_search);
+    const MovieIndex *index = tc_index ? tc_index : seek_index;
+
+    uint64_t pts = index->get_seek_pos_pts(new_frame_index);
+    uint64_t dts = index->get_seek_pos_dts(new_frame_index);
+    const int64_t key_frame_pts = timestamp_from_pts_or_dts(pts, dts);
+
+    /* The requested frame is further in the GOP being decoded, so decoding can continue without
+     * seeking back to its key frame. */
+    if (key_frame_pts == anim->cur_key_frame_pts && position > anim->cur_position &&
+        !ffmpeg_is_first_frame_decode(anim))
+    {
+      return 0;
+    }
 
-    anim->cur_key_frame_pts = timestamp_from_pts_or_dts(pts, dts);
+    anim->cur_key_frame_pts = key_frame_pts;
 
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "TC INDEX seek pts = %" PRIu64 "\n", pts);
     av_log(anim->pFormatCtx, AV_LOG_DEBUG, "TC INDEX seek dts = %" PRIu64 "\n", dts);
@@ -1149,6 +1303,10 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
   av_log(anim->pFormatCtx, AV_LOG_DEBUG, "FETCH: seek_pos=%d\n", position);
 
   const MovieIndex *tc_index = movie_open_index(anim, tc);
+  /* Without time code, a record run index built for this file is still used to find key frames,
+   * such that seeking only decodes the frames of one GOP. */
+  const MovieIndex *seek_index = (tc == IMB_TC_NONE) ? movie_open_index(anim, IMB_TC_RECORD_RUN) :
+                                                       nullptr;
   int64_t pts_to_search = ffmpeg_get_pts_to_search(anim, tc_index, position);
   AVStream *v_st = anim->pFormatCtx->streams[anim->videoStream];
   double frame_rate = av_q2d(v_st->r_frame_rate);
@@ -1174,7 +1332,7 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
 
     if (ffmpeg_must_decode(anim, position)) {
       if (ffmpeg_must_seek(anim, position)) {
-        ffmpeg_seek_to_key_frame(anim, position, tc_index, pts_to_search);
+        ffmpeg_seek_to_key_frame(anim, position, tc_index, seek_index, pts_to_search);
       }
 
       ffmpeg_decode_video_frame_scan(anim, pts_to_search);
@@ -1185,7 +1343,7 @@ static ImBuf *ffmpeg_fetchibuf(MovieReader *anim, int position, IMB_Timecode_Typ
   anim->x = anim->pCodecCtx->width;
   anim->y = anim->pCodecCtx->height;
 
-  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(anim->pCodecCtx->pix_fmt);
+  const AVPixFmtDescriptor *pix_fmt_descriptor = av_pix_fmt_desc_get(ffmpeg_decoded_pix_fmt(anim));
 
   int planes = R_IMF_PLANES_RGBA;
   if ((pix_fmt_descriptor->flags & AV_PIX_FMT_FLAG_ALPHA) == 0) {
@@ -1244,6 +1402,7 @@ static void free_anim_ffmpeg(MovieReader *anim)
       MEM_freeN(anim->pFrameDeinterlaced->data[0]);
     }
     av_frame_free(&anim->pFrameDeinterlaced);
+    av_frame_free(&anim->pFrame_hw_download);
     ffmpeg_sws_release_context(anim->img_convert_ctx);
   }
   anim->duration_in_frames = 0;
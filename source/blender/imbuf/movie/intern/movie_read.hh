@@ -55,6 +55,8 @@ struct MovieReader {
   AVFrame *pFrameRGB = nullptr;
   AVFrame *pFrameDeinterlaced = nullptr;
   SwsContext *img_convert_ctx = nullptr;
+  /** #AVPixelFormat of the frames converted by #img_convert_ctx. */
+  int img_convert_src_fmt = -1;
   int videoStream = 0;
 
   AVFrame *pFrame = nullptr;
@@ -62,6 +64,13 @@ struct MovieReader {
   AVFrame *pFrame_backup = nullptr;
   bool pFrame_backup_complete = false;
 
+  /**
+   * #AVPixelFormat of hardware decoded frames, -1 (#AV_PIX_FMT_NONE) when decoding in software.
+   * Hardware frames are downloaded into #pFrame_hw_download before the conversion to RGB.
+   */
+  int hw_pix_fmt = -1;
+  AVFrame *pFrame_hw_download = nullptr;
+
   int64_t cur_pts = 0;
   int64_t cur_key_frame_pts = 0;
   AVPacket *cur_packet = nullptr;
@@ -159,8 +159,9 @@ class GPUDisplayShader : NonCopyable, NonMovable {
 };
 
 class GPUShaderCache {
-  /* The maximum number of cached shaders. */
-  static constexpr int MAX_SIZE = 4;
+  /* The maximum number of cached shaders. Large enough for switching between a few looks and
+   * views of several images in different color spaces without compiling shaders again. */
+  static constexpr int MAX_SIZE = 16;
 
  public:
   ~GPUShaderCache();
@@ -173,7 +174,7 @@ class GPUShaderCache {
 
   /**
    * Create default-initialized GPUDisplayShader and put it to cache.
-   * The function ensures the cache has up to SHADER_CACHE_MAX_SIZE entries.
+   * The function ensures the cache has up to MAX_SIZE entries.
    */
   GPUDisplayShader &create_default();
 
@@ -52,6 +52,8 @@ struct AlembicExportParams {
   bool export_custom_properties;
   bool use_instancing;
   enum eEvaluationMode evaluation_mode;
+  /* Number of frames evaluated at the same time, each in its own dependency graph. */
+  int parallel_frames;
 
   /* See MOD_TRIANGULATE_NGON_xxx and MOD_TRIANGULATE_QUAD_xxx
    * in DNA_modifier_types.h */
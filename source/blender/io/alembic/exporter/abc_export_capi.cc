@@ -3,6 +3,7 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
 #include "ABC_alembic.h"
+#include "IO_parallel_frame_evaluator.hh"
 #include "IO_subdiv_disabler.hh"
 #include "abc_archive.h"
 #include "abc_hierarchy_iterator.h"
@@ -33,10 +34,14 @@
 static CLG_LogRef LOG = {"io.alembic"};
 
 #include <memory>
+#include <optional>
 
 struct ExportJobData {
   Main *bmain = nullptr;
   Depsgraph *depsgraph = nullptr;
+  /* Additional dependency graphs to evaluate frames in parallel, see
+   * #AlembicExportParams::parallel_frames. */
+  blender::Vector<Depsgraph *> parallel_depsgraphs;
   wmWindowManager *wm = nullptr;
 
   char filepath[FILE_MAX] = {};
@@ -50,7 +55,7 @@ struct ExportJobData {
 namespace blender::io::alembic {
 
 /* Construct the depsgraph for exporting. */
-static bool build_depsgraph(ExportJobData *job)
+static bool build_depsgraph(ExportJobData *job, Depsgraph *depsgraph)
 {
   if (job->params.collection[0]) {
     Collection *collection = reinterpret_cast<Collection *>(
@@ -61,13 +66,13 @@ static bool build_depsgraph(ExportJobData *job)
       return false;
     }
 
-    DEG_graph_build_from_collection(job->depsgraph, collection);
+    DEG_graph_build_from_collection(depsgraph, collection);
   }
   else if (job->params.visible_objects_only) {
-    DEG_graph_build_from_view_layer(job->depsgraph);
+    DEG_graph_build_from_view_layer(depsgraph);
   }
   else {
-    DEG_graph_build_for_all_objects(job->depsgraph);
+    DEG_graph_build_for_all_objects(depsgraph);
   }
 
   return true;
@@ -144,6 +149,14 @@ static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     ABCArchive::Frames::const_iterator frame_it = abc_archive->frames_begin();
     const ABCArchive::Frames::const_iterator frames_end = abc_archive->frames_end();
 
+    std::optional<ParallelFrameEvaluator> parallel_evaluator;
+    if (!data->parallel_depsgraphs.is_empty()) {
+      Vector<Depsgraph *> depsgraphs = {data->depsgraph};
+      depsgraphs.extend(data->parallel_depsgraphs);
+      const Vector<double> frames(frame_it, frames_end);
+      parallel_evaluator.emplace(depsgraphs, frames);
+    }
+
     for (; frame_it != frames_end; frame_it++) {
       double frame = *frame_it;
 
@@ -151,10 +164,15 @@ static void export_startjob(void *customdata, wmJobWorkerStatus *worker_status)
         break;
       }
 
-      /* Update the scene for the next frame to render. */
-      scene->r.cfra = int(frame);
-      scene->r.subframe = float(frame - scene->r.cfra);
-      BKE_scene_graph_update_for_newframe(data->depsgraph);
+      if (parallel_evaluator) {
+        iter.set_depsgraph(parallel_evaluator->next_frame());
+      }
+      else {
+        /* Update the scene for the next frame to render. */
+        scene->r.cfra = int(frame);
+        scene->r.subframe = float(frame - scene->r.cfra);
+        BKE_scene_graph_update_for_newframe(data->depsgraph);
+      }
 
       CLOG_INFO(&LOG, 2, "Exporting frame %.2f", frame);
       ExportSubset export_subset = abc_archive->export_subset_for_frame(frame);
@@ -189,6 +207,9 @@ static void export_endjob(void *customdata)
   ExportJobData *data = static_cast<ExportJobData *>(customdata);
 
   DEG_graph_free(data->depsgraph);
+  for (Depsgraph *depsgraph : data->parallel_depsgraphs) {
+    DEG_graph_free(depsgraph);
+  }
 
   if (data->was_canceled && BLI_exists(data->filepath)) {
     BLI_delete(data->filepath, false, false);
@@ -223,9 +244,16 @@ bool ABC_export(Scene *scene,
    *
    * Has to be done from main thread currently, as it may affect Main original data (e.g. when
    * doing deferred update of the view-layers, see #112534 for details). */
-  if (!blender::io::alembic::build_depsgraph(job)) {
+  if (!blender::io::alembic::build_depsgraph(job, job->depsgraph)) {
     return false;
   }
+  if (params->frame_start != params->frame_end) {
+    for (int i = 1; i < params->parallel_frames; i++) {
+      Depsgraph *depsgraph = DEG_graph_new(job->bmain, scene, view_layer, params->evaluation_mode);
+      job->parallel_depsgraphs.append(depsgraph);
+      blender::io::alembic::build_depsgraph(job, depsgraph);
+    }
+  }
 
   bool export_ok = false;
   if (as_background_job) {
@@ -10,6 +10,8 @@
 #include "abc_hierarchy_iterator.h"
 #include "intern/abc_axis_conversion.h"
 
+#include "BLI_task.hh"
+
 #include "BKE_attribute.hh"
 #include "BKE_lib_id.hh"
 #include "BKE_material.hh"
@@ -171,8 +173,8 @@ void ABCGenericMeshWriter::do_write(HierarchyContext &context)
 
   m_custom_data_config.pack_uvs = args_.export_params->packuv;
   m_custom_data_config.mesh = mesh;
-  m_custom_data_config.face_offsets = mesh->face_offsets_for_write().data();
-  m_custom_data_config.corner_verts = mesh->corner_verts_for_write().data();
+  m_custom_data_config.face_offsets = mesh->face_offsets().data();
+  m_custom_data_config.corner_verts = mesh->corner_verts().data();
   m_custom_data_config.faces_num = mesh->faces_num;
   m_custom_data_config.totloop = mesh->corners_num;
   m_custom_data_config.totvert = mesh->verts_num;
@@ -209,8 +211,17 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   std::vector<int32_t> face_verts, loop_counts;
   std::vector<Imath::V3f> velocities;
 
-  get_vertices(mesh, points);
-  get_topology(mesh, face_verts, loop_counts);
+  /* Converting the arrays is independent, and the bulk of the work besides writing them. */
+  threading::parallel_invoke(
+      mesh->corners_num > 4096,
+      [&]() { get_vertices(mesh, points); },
+      [&]() { get_topology(mesh, face_verts, loop_counts); },
+      [&]() {
+        if (args_.export_params->normals) {
+          get_loop_normals(mesh, normals);
+        }
+      },
+      [&]() { get_velocities(mesh, velocities); });
 
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_poly_mesh_schema_);
@@ -241,8 +252,6 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
   }
 
   if (args_.export_params->normals) {
-    get_loop_normals(mesh, normals);
-
     ON3fGeomParam::Sample normals_sample;
     if (!normals.empty()) {
       normals_sample.setScope(kFacevaryingScope);
@@ -256,7 +265,7 @@ void ABCGenericMeshWriter::write_mesh(HierarchyContext &context, Mesh *mesh)
     write_generated_coordinates(abc_poly_mesh_schema_.getArbGeomParams(), m_custom_data_config);
   }
 
-  if (get_velocities(mesh, velocities)) {
+  if (!velocities.empty()) {
     mesh_sample.setVelocities(V3fArraySample(velocities));
   }
 
@@ -275,10 +284,14 @@ void ABCGenericMeshWriter::write_subd(HierarchyContext &context, Mesh *mesh)
   std::vector<int32_t> face_verts, loop_counts;
   std::vector<int32_t> edge_crease_indices, edge_crease_lengths, vert_crease_indices;
 
-  get_vertices(mesh, points);
-  get_topology(mesh, face_verts, loop_counts);
-  get_edge_creases(mesh, edge_crease_indices, edge_crease_lengths, edge_crease_sharpness);
-  get_vert_creases(mesh, vert_crease_indices, vert_crease_sharpness);
+  threading::parallel_invoke(
+      mesh->corners_num > 4096,
+      [&]() { get_vertices(mesh, points); },
+      [&]() { get_topology(mesh, face_verts, loop_counts); },
+      [&]() {
+        get_edge_creases(mesh, edge_crease_indices, edge_crease_lengths, edge_crease_sharpness);
+        get_vert_creases(mesh, vert_crease_indices, vert_crease_sharpness);
+      });
 
   if (!frame_has_been_written_ && args_.export_params->face_sets) {
     write_face_sets(context.object, mesh, abc_subdiv_schema_);
@@ -378,9 +391,11 @@ bool ABCGenericMeshWriter::get_velocities(Mesh *mesh, std::vector<Imath::V3f> &v
   vels.clear();
   vels.resize(totverts);
 
-  for (int i = 0; i < totverts; i++) {
-    copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
-  }
+  threading::parallel_for(IndexRange(totverts), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(vels[i].getValue(), mesh_velocities[i]);
+    }
+  });
 
   return true;
 }
@@ -435,9 +450,11 @@ static void get_vertices(Mesh *mesh, std::vector<Imath::V3f> &points)
   points.resize(mesh->verts_num);
 
   const Span<float3> positions = mesh->vert_positions();
-  for (int i = 0, e = mesh->verts_num; i < e; i++) {
-    copy_yup_from_zup(points[i].getValue(), positions[i]);
-  }
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      copy_yup_from_zup(points[i].getValue(), positions[i]);
+    }
+  });
 }
 
 static void get_topology(Mesh *mesh,
@@ -447,21 +464,21 @@ static void get_topology(Mesh *mesh,
   const OffsetIndices faces = mesh->faces();
   const Span<int> corner_verts = mesh->corner_verts();
 
-  face_verts.clear();
-  loop_counts.clear();
-  face_verts.reserve(corner_verts.size());
-  loop_counts.reserve(faces.size());
+  face_verts.resize(corner_verts.size());
+  loop_counts.resize(faces.size());
 
-  /* NOTE: data needs to be written in the reverse order. */
-  for (const int i : faces.index_range()) {
-    const IndexRange face = faces[i];
-    loop_counts.push_back(face.size());
+  offset_indices::copy_group_sizes(
+      faces, faces.index_range(), MutableSpan(loop_counts.data(), int64_t(loop_counts.size())));
 
-    int corner = face.start() + (face.size() - 1);
-    for (int j = 0; j < face.size(); j++, corner--) {
-      face_verts.push_back(corner_verts[corner]);
+  /* NOTE: data needs to be written in the reverse order. */
+  threading::parallel_for(faces.index_range(), 1024, [&](const IndexRange range) {
+    for (const int i : range) {
+      const IndexRange face = faces[i];
+      for (const int j : face.index_range()) {
+        face_verts[face.start() + j] = corner_verts[face.last(j)];
+      }
     }
-  }
+  });
 }
 
 static void get_edge_creases(Mesh *mesh,
@@ -66,7 +66,7 @@ static void get_uvs(const CDStreamConfig &config,
   }
 
   const OffsetIndices faces = config.mesh->faces();
-  int *corner_verts = config.corner_verts;
+  const int *corner_verts = config.corner_verts;
 
   if (!config.pack_uvs) {
     int count = 0;
@@ -94,7 +94,7 @@ static void get_uvs(const CDStreamConfig &config,
 
     for (const int i : faces.index_range()) {
       const IndexRange face = faces[i];
-      int *face_verts = corner_verts + face.start() + face.size();
+      const int *face_verts = corner_verts + face.start() + face.size();
       const float2 *loopuv = mloopuv_array + face.start() + face.size();
 
       for (int j = 0; j < face.size(); j++) {
@@ -385,6 +385,13 @@ static void read_custom_data_mcols(const std::string &iobject_full_name,
   /* Find the correct interpretation of the data */
   if (IC3fGeomParam::matches(prop_header)) {
     IC3fGeomParam color_param(arbGeomParams, prop_header.getName());
+    if (can_reuse_constant_layer(config,
+                                 color_param.isConstant(),
+                                 prop_header.getName().c_str(),
+                                 CD_PROP_BYTE_COLOR))
+    {
+      return;
+    }
     IC3fGeomParam::Sample sample;
     BLI_assert(STREQ("rgb", color_param.getInterpretation()));
 
@@ -398,6 +405,13 @@ static void read_custom_data_mcols(const std::string &iobject_full_name,
   }
   else if (IC4fGeomParam::matches(prop_header)) {
     IC4fGeomParam color_param(arbGeomParams, prop_header.getName());
+    if (can_reuse_constant_layer(config,
+                                 color_param.isConstant(),
+                                 prop_header.getName().c_str(),
+                                 CD_PROP_BYTE_COLOR))
+    {
+      return;
+    }
     IC4fGeomParam::Sample sample;
     BLI_assert(STREQ("rgba", color_param.getInterpretation()));
 
@@ -493,6 +507,11 @@ static void read_custom_data_uvs(const ICompoundProperty &prop,
   if (!uv_param.isIndexed()) {
     return;
   }
+  if (can_reuse_constant_layer(
+          config, uv_param.isConstant(), prop_header.getName().c_str(), CD_PROP_FLOAT2))
+  {
+    return;
+  }
 
   IV2fGeomParam::Sample sample;
   uv_param.getIndexed(sample, iss);
@@ -583,6 +602,15 @@ void read_generated_coordinates(const ICompoundProperty &prop,
   BKE_mesh_orco_verts_transform(mesh, orcodata, mesh->verts_num, false);
 }
 
+bool can_reuse_constant_layer(const CDStreamConfig &config,
+                              const bool is_constant,
+                              const char *name,
+                              const eCustomDataType data_type)
+{
+  return config.use_existing_topology && is_constant &&
+         CustomData_get_named_layer_index(&config.mesh->corner_data, data_type, name) != -1;
+}
+
 void read_custom_data(const std::string &iobject_full_name,
                       const ICompoundProperty &prop,
                       const CDStreamConfig &config,
@@ -9,6 +9,8 @@
 
 #include "BLI_math_vector_types.hh"
 
+#include "DNA_customdata_types.h"
+
 #include <Alembic/Abc/ICompoundProperty.h>
 #include <Alembic/Abc/ISampleSelector.h>
 #include <Alembic/Abc/OCompoundProperty.h>
@@ -36,10 +38,10 @@ struct UVSample {
 };
 
 struct CDStreamConfig {
-  int *corner_verts = nullptr;
+  const int *corner_verts = nullptr;
   int totloop = 0;
 
-  int *face_offsets = nullptr;
+  const int *face_offsets = nullptr;
   int faces_num = 0;
 
   float3 *positions = nullptr;
@@ -61,6 +63,13 @@ struct CDStreamConfig {
 
   const char **modifier_error_message = nullptr;
 
+  /**
+   * The topology of the mesh already matches the Alembic sample, so face offsets, corner vertices
+   * and edges are kept as is (still sharing their arrays with the original mesh), and layers with
+   * constant values don't have to be read again, see #can_reuse_constant_layer.
+   */
+  bool use_existing_topology = false;
+
   /* Alembic needs Blender to keep references to C++ objects (the destructors finalize the writing
    * to ABC). The following fields are all used to keep these references. */
 
@@ -103,6 +112,15 @@ void read_custom_data(const std::string &iobject_full_name,
                       const CDStreamConfig &config,
                       const Alembic::Abc::ISampleSelector &iss);
 
+/**
+ * Whether reading a face corner layer can be skipped, because its values don't change over time
+ * and the existing mesh with the same topology already has them.
+ */
+bool can_reuse_constant_layer(const CDStreamConfig &config,
+                              bool is_constant,
+                              const char *name,
+                              eCustomDataType data_type);
+
 enum AbcUvScope {
   ABC_UV_SCOPE_NONE,
   ABC_UV_SCOPE_LOOP,
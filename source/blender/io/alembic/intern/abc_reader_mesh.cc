@@ -22,6 +22,7 @@
 #include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_ordered_edge.hh"
+#include "BLI_task.hh"
 
 #include "BLT_translation.hh"
 
@@ -130,14 +131,16 @@ static void read_mverts_interp(float3 *vert_positions,
                                const P3fArraySamplePtr &ceil_positions,
                                const double weight)
 {
-  float tmp[3];
-  for (int i = 0; i < positions->size(); i++) {
-    const Imath::V3f &floor_pos = (*positions)[i];
-    const Imath::V3f &ceil_pos = (*ceil_positions)[i];
-
-    interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), float(weight));
-    copy_zup_from_yup(vert_positions[i], tmp);
-  }
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](const IndexRange range) {
+    float tmp[3];
+    for (const int64_t i : range) {
+      const Imath::V3f &floor_pos = (*positions)[i];
+      const Imath::V3f &ceil_pos = (*ceil_positions)[i];
+
+      interp_v3_v3v3(tmp, floor_pos.getValue(), ceil_pos.getValue(), float(weight));
+      copy_zup_from_yup(vert_positions[i], tmp);
+    }
+  });
 }
 
 static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
@@ -162,11 +165,13 @@ static void read_mverts(CDStreamConfig &config, const AbcMeshData &mesh_data)
 void read_mverts(Mesh &mesh, const P3fArraySamplePtr positions, const N3fArraySamplePtr normals)
 {
   MutableSpan<float3> vert_positions = mesh.vert_positions_for_write();
-  for (int i = 0; i < positions->size(); i++) {
-    Imath::V3f pos_in = (*positions)[i];
+  threading::parallel_for(IndexRange(positions->size()), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      Imath::V3f pos_in = (*positions)[i];
 
-    copy_zup_from_yup(vert_positions[i], pos_in.getValue());
-  }
+      copy_zup_from_yup(vert_positions[i], pos_in.getValue());
+    }
+  });
   mesh.tag_positions_changed();
 
   if (normals) {
@@ -181,8 +186,14 @@ void read_mverts(Mesh &mesh, const P3fArraySamplePtr positions, const N3fArraySa
 
 static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
 {
-  int *face_offsets = config.face_offsets;
-  int *corner_verts = config.corner_verts;
+  /* When the topology is reused, only the UVs have to be read. */
+  const bool read_topology = !config.use_existing_topology;
+  MutableSpan<int> face_offsets;
+  MutableSpan<int> corner_verts;
+  if (read_topology) {
+    face_offsets = config.mesh->face_offsets_for_write();
+    corner_verts = config.mesh->corner_verts_for_write();
+  }
   float2 *mloopuvs = config.mloopuv;
 
   const Int32ArraySamplePtr &face_indices = mesh_data.face_indices;
@@ -195,6 +206,9 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   const bool do_uvs = (mloopuvs && uvs && uvs_indices);
   const bool do_uvs_per_loop = do_uvs && mesh_data.uv_scope == ABC_UV_SCOPE_LOOP;
   BLI_assert(!do_uvs || mesh_data.uv_scope != ABC_UV_SCOPE_NONE);
+  if (!read_topology && !do_uvs) {
+    return;
+  }
   uint loop_index = 0;
   uint rev_loop_index = 0;
   uint uv_index = 0;
@@ -203,7 +217,9 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
   for (int i = 0; i < face_counts->size(); i++) {
     const int face_size = (*face_counts)[i];
 
-    face_offsets[i] = loop_index;
+    if (read_topology) {
+      face_offsets[i] = loop_index;
+    }
 
     /* Polygons are always assumed to be smooth-shaded. If the Alembic mesh should be flat-shaded,
      * this is encoded in custom loop normals. See #71246. */
@@ -214,7 +230,9 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
     uint last_vertex_index = 0;
     for (int f = 0; f < face_size; f++, loop_index++, rev_loop_index--) {
       const int vert = (*face_indices)[loop_index];
-      corner_verts[rev_loop_index] = vert;
+      if (read_topology) {
+        corner_verts[rev_loop_index] = vert;
+      }
 
       if (f > 0 && vert == last_vertex_index) {
         /* This face is invalid, as it has consecutive loops from the same vertex. This is caused
@@ -237,6 +255,10 @@ static void read_mpolys(CDStreamConfig &config, const AbcMeshData &mesh_data)
     }
   }
 
+  if (!read_topology) {
+    return;
+  }
+
   bke::mesh_calc_edges(*config.mesh, false, false);
   if (seen_invalid_geometry) {
     if (config.modifier_error_message) {
@@ -343,6 +365,19 @@ BLI_INLINE void read_uvs_params(CDStreamConfig &config,
     return;
   }
 
+  std::string name = Alembic::Abc::GetSourceName(uv.getMetaData());
+
+  /* According to the convention, primary UVs should have had their name
+   * set using Alembic::Abc::SetSourceName, but you can't expect everyone
+   * to follow it! :) */
+  if (name.empty()) {
+    name = uv.getName();
+  }
+
+  if (can_reuse_constant_layer(config, uv.isConstant(), name.c_str(), CD_PROP_FLOAT2)) {
+    return;
+  }
+
   IV2fGeomParam::Sample uvsamp;
   uv.getIndexed(uvsamp, selector);
 
@@ -358,15 +393,6 @@ BLI_INLINE void read_uvs_params(CDStreamConfig &config,
   abc_data.uvs = uvsamp.getVals();
   abc_data.uvs_indices = uvs_indices;
 
-  std::string name = Alembic::Abc::GetSourceName(uv.getMetaData());
-
-  /* According to the convention, primary UVs should have had their name
-   * set using Alembic::Abc::SetSourceName, but you can't expect everyone
-   * to follow it! :) */
-  if (name.empty()) {
-    name = uv.getName();
-  }
-
   void *cd_ptr = config.add_customdata_cb(config.mesh, name.c_str(), CD_PROP_FLOAT2);
   config.mloopuv = static_cast<float2 *>(cd_ptr);
 }
@@ -430,11 +456,10 @@ static bool samples_have_same_topology(const SampleType &sample, const SampleTyp
 static void read_mesh_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const IPolyMeshSchema &schema,
+                             const IPolyMeshSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const IPolyMeshSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -481,13 +506,21 @@ static void read_mesh_sample(const std::string &iobject_full_name,
   }
 }
 
-static CDStreamConfig get_config(Mesh *mesh)
+static CDStreamConfig get_config(Mesh *mesh, const bool use_existing_topology)
 {
   CDStreamConfig config;
   config.mesh = mesh;
   config.positions = mesh->vert_positions_for_write().data();
-  config.corner_verts = mesh->corner_verts_for_write().data();
-  config.face_offsets = mesh->face_offsets_for_write().data();
+  if (use_existing_topology) {
+    /* Keep sharing the arrays with the original mesh. */
+    config.corner_verts = mesh->corner_verts().data();
+    config.face_offsets = mesh->face_offsets().data();
+  }
+  else {
+    config.corner_verts = mesh->corner_verts_for_write().data();
+    config.face_offsets = mesh->face_offsets_for_write().data();
+  }
+  config.use_existing_topology = use_existing_topology;
   config.totvert = mesh->verts_num;
   config.totloop = mesh->corners_num;
   config.faces_num = mesh->faces_num;
@@ -632,6 +665,12 @@ bool AbcMeshReader::topology_changed(const Mesh *existing_mesh, const ISampleSel
     return false;
   }
 
+  return sample_topology_changed(existing_mesh, sample);
+}
+
+bool AbcMeshReader::sample_topology_changed(const Mesh *existing_mesh,
+                                            const IPolyMeshSchema::Sample &sample) const
+{
   const P3fArraySamplePtr &positions = sample.getPositions();
   const Alembic::Abc::Int32ArraySamplePtr &face_indices = sample.getFaceIndices();
   const Alembic::Abc::Int32ArraySamplePtr &face_counts = sample.getFaceCounts();
@@ -748,7 +787,8 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
   settings.velocity_name = velocity_name;
   settings.velocity_scale = velocity_scale;
 
-  if (topology_changed(existing_mesh, sample_sel)) {
+  bool use_existing_topology = false;
+  if (sample_topology_changed(existing_mesh, sample)) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, face_counts->size(), face_indices->size());
 
@@ -769,14 +809,19 @@ Mesh *AbcMeshReader::read_mesh(Mesh *existing_mesh,
             "read!");
       }
     }
+    else {
+      /* The face offsets, corner vertices and edges of the existing mesh can be used as is, so
+       * that mostly only the positions have to be read for every frame. */
+      use_existing_topology = true;
+    }
   }
 
   Mesh *mesh_to_export = new_mesh ? new_mesh : existing_mesh;
-  CDStreamConfig config = get_config(mesh_to_export);
+  CDStreamConfig config = get_config(mesh_to_export, use_existing_topology);
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = r_err_str;
 
-  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_mesh_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
 
   if (new_mesh) {
     /* Here we assume that the number of materials doesn't change, i.e. that
@@ -859,11 +904,10 @@ void AbcMeshReader::readFaceSetsSample(Main *bmain, Mesh *mesh, const ISampleSel
 static void read_subd_sample(const std::string &iobject_full_name,
                              ImportSettings *settings,
                              const ISubDSchema &schema,
+                             const ISubDSchema::Sample &sample,
                              const ISampleSelector &selector,
                              CDStreamConfig &config)
 {
-  const ISubDSchema::Sample sample = schema.getValue(selector);
-
   AbcMeshData abc_mesh_data;
   abc_mesh_data.face_counts = sample.getFaceCounts();
   abc_mesh_data.face_indices = sample.getFaceIndices();
@@ -1087,6 +1131,7 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
   settings.velocity_name = velocity_name;
   settings.velocity_scale = velocity_scale;
 
+  bool use_existing_topology = false;
   if (existing_mesh->verts_num != positions->size()) {
     new_mesh = BKE_mesh_new_nomain_from_template(
         existing_mesh, positions->size(), 0, face_counts->size(), face_indices->size());
@@ -1108,14 +1153,22 @@ Mesh *AbcSubDReader::read_mesh(Mesh *existing_mesh,
             "read!");
       }
     }
+    else if (!m_is_reading_a_file_sequence &&
+             m_schema.getFaceIndicesProperty().getNumSamples() == 1 &&
+             m_schema.getFaceCountsProperty().getNumSamples() == 1)
+    {
+      /* Without a full topology comparison, the existing topology can only be used when it is
+       * constant in the file. */
+      use_existing_topology = true;
+    }
   }
 
   /* Only read point data when streaming meshes, unless we need to create new ones. */
   Mesh *mesh_to_export = new_mesh ? new_mesh : existing_mesh;
-  CDStreamConfig config = get_config(mesh_to_export);
+  CDStreamConfig config = get_config(mesh_to_export, use_existing_topology);
   config.time = sample_sel.getRequestedTime();
   config.modifier_error_message = r_err_str;
-  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample_sel, config);
+  read_subd_sample(m_iobject.getFullName(), &settings, m_schema, sample, sample_sel, config);
 
   return mesh_to_export;
 }
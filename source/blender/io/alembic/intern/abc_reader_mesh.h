@@ -48,6 +48,9 @@ class AbcMeshReader final : public AbcObjectReader {
                         const Alembic::Abc::ISampleSelector &sample_sel) override;
 
  private:
+  bool sample_topology_changed(const Mesh *existing_mesh,
+                               const Alembic::AbcGeom::IPolyMeshSchema::Sample &sample) const;
+
   void readFaceSetsSample(Main *bmain,
                           Mesh *mesh,
                           const Alembic::AbcGeom::ISampleSelector &sample_sel);
@@ -258,6 +258,14 @@ class AbstractHierarchyIterator {
    * previous iteration. */
   void set_export_subset(ExportSubset export_subset);
 
+  /**
+   * Use another dependency graph built for the same data for the following iterations, for
+   * example one evaluated at another frame. Writers which already exist are kept.
+   */
+  void set_depsgraph(Depsgraph *depsgraph);
+  /** The dependency graph of the current iteration. */
+  Depsgraph *get_depsgraph() const;
+
   /* Convert the given name to something that is valid for the exported file format.
    * This base implementation is a no-op; override in a concrete subclass. */
   virtual std::string make_valid_name(const std::string &name) const;
@@ -0,0 +1,60 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+#include <condition_variable>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+
+#include "BLI_index_range.hh"
+#include "BLI_map.hh"
+#include "BLI_utility_mixins.hh"
+#include "BLI_vector.hh"
+
+namespace blender::io {
+
+/**
+ * This code is shared between the OBJ and PLY exporters.
+ * Writes blocks of formatted data to a file from a separate I/O thread, so that the formatting of
+ * the following data can continue while the file is written, and so that the formatted data
+ * does not have to be kept in memory until the whole file is done.
+ *
+ * Blocks can be submitted from multiple threads in any order, they are written in the order of
+ * their index. Every reserved index has to be submitted exactly once.
+ */
+class OrderedFileWriter : NonCopyable, NonMovable {
+ public:
+  using Block = Vector<char>;
+
+ private:
+  FILE *file_;
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  Map<int64_t, Vector<Block>> pending_;
+  int64_t next_index_ = 0;
+  int64_t reserved_num_ = 0;
+  bool finished_ = false;
+  std::thread thread_;
+
+ public:
+  /** The file is not closed by the writer. */
+  explicit OrderedFileWriter(FILE *file);
+  ~OrderedFileWriter();
+
+  /**
+   * Reserve consecutive indices for blocks that are written after all previously reserved ones.
+   */
+  IndexRange reserve(int64_t count);
+  /** Queue the blocks to be written after the blocks of all lower indices. */
+  void submit(int64_t index, Vector<Block> blocks);
+
+  /** Wait until all submitted blocks are written. */
+  void finish();
+
+ private:
+  void run();
+};
+
+}  // namespace blender::io
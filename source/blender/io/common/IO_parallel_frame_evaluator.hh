@@ -0,0 +1,62 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#pragma once
+
+#include "BLI_array.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+struct Depsgraph;
+struct TaskPool;
+
+namespace blender::io {
+
+/**
+ * This code is shared between exporters writing animation.
+ * Evaluates the frames to export ahead of time in several dependency graphs at the same time,
+ * while the frames are handed out in order to be written. Each dependency graph evaluates the next
+ * frame it is responsible for as soon as its previous frame has been written.
+ *
+ * This only gives correct results when frames don't depend on the evaluation of previous frames,
+ * so not with simulations. Frame change handlers are not run.
+ */
+class ParallelFrameEvaluator final {
+ private:
+  struct Slot {
+    Depsgraph *depsgraph;
+    TaskPool *task_pool;
+    double frame;
+  };
+
+  Array<Slot> slots_;
+  Vector<double> frames_;
+  /* Index of the next frame returned by #next_frame. */
+  int64_t next_frame_index_ = 0;
+
+ public:
+  /**
+   * The dependency graphs must be built already, they are not owned by the evaluator. Frames are
+   * evaluated without writing back to the original data.
+   */
+  ParallelFrameEvaluator(Span<Depsgraph *> depsgraphs, Span<double> frames);
+  /** Waits for the frames which are still being evaluated. */
+  ~ParallelFrameEvaluator();
+
+  /**
+   * Wait for the evaluation of the next frame and return the dependency graph it was evaluated in.
+   * The dependency graph can be used until the next call, after which it is used to evaluate
+   * another frame.
+   */
+  Depsgraph *next_frame();
+
+  /* Disallow copying. */
+  ParallelFrameEvaluator(const ParallelFrameEvaluator &) = delete;
+  ParallelFrameEvaluator &operator=(const ParallelFrameEvaluator &) = delete;
+
+ private:
+  void evaluate_frame_in_slot(int64_t frame_index);
+  static void evaluate_frame_task(TaskPool *pool, void *taskdata);
+};
+
+}  // namespace blender::io
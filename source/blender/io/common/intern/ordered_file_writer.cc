@@ -0,0 +1,74 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "IO_ordered_file_writer.hh"
+
+#include "BLI_assert.h"
+
+namespace blender::io {
+
+OrderedFileWriter::OrderedFileWriter(FILE *file) : file_(file)
+{
+  thread_ = std::thread([this]() { this->run(); });
+}
+
+OrderedFileWriter::~OrderedFileWriter()
+{
+  this->finish();
+}
+
+IndexRange OrderedFileWriter::reserve(const int64_t count)
+{
+  std::lock_guard lock{mutex_};
+  const IndexRange range(reserved_num_, count);
+  reserved_num_ += count;
+  return range;
+}
+
+void OrderedFileWriter::submit(const int64_t index, Vector<Block> blocks)
+{
+  {
+    std::lock_guard lock{mutex_};
+    BLI_assert(index >= next_index_ && !pending_.contains(index));
+    pending_.add_new(index, std::move(blocks));
+  }
+  cond_.notify_one();
+}
+
+void OrderedFileWriter::finish()
+{
+  if (!thread_.joinable()) {
+    return;
+  }
+  {
+    std::lock_guard lock{mutex_};
+    finished_ = true;
+  }
+  cond_.notify_one();
+  thread_.join();
+  BLI_assert(pending_.is_empty());
+}
+
+void OrderedFileWriter::run()
+{
+  while (true) {
+    Vector<Block> blocks;
+    {
+      std::unique_lock lock{mutex_};
+      cond_.wait(lock, [&]() {
+        return pending_.contains(next_index_) || (finished_ && next_index_ >= reserved_num_);
+      });
+      if (!pending_.contains(next_index_)) {
+        break;
+      }
+      blocks = pending_.pop(next_index_);
+      next_index_++;
+    }
+    /* Write without holding the lock, so that more blocks can be submitted meanwhile. */
+    for (const Block &block : blocks) {
+      fwrite(block.data(), 1, block.size(), file_);
+    }
+  }
+}
+
+}  // namespace blender::io
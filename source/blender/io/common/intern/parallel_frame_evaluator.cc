@@ -0,0 +1,65 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+#include "IO_parallel_frame_evaluator.hh"
+
+#include <algorithm>
+
+#include "BLI_assert.h"
+#include "BLI_task.h"
+
+#include "DEG_depsgraph.hh"
+
+namespace blender::io {
+
+void ParallelFrameEvaluator::evaluate_frame_task(TaskPool * /*pool*/, void *taskdata)
+{
+  const Slot &slot = *static_cast<const Slot *>(taskdata);
+  DEG_evaluate_on_framechange(slot.depsgraph, float(slot.frame), DEG_EVALUATE_SYNC_WRITEBACK_NO);
+}
+
+ParallelFrameEvaluator::ParallelFrameEvaluator(const Span<Depsgraph *> depsgraphs,
+                                               const Span<double> frames)
+    : slots_(depsgraphs.size()), frames_(frames)
+{
+  BLI_assert(!depsgraphs.is_empty());
+  for (const int64_t i : slots_.index_range()) {
+    slots_[i].depsgraph = depsgraphs[i];
+    slots_[i].task_pool = BLI_task_pool_create(nullptr, TASK_PRIORITY_HIGH);
+  }
+  for (int64_t i = 0; i < std::min(slots_.size(), frames_.size()); i++) {
+    evaluate_frame_in_slot(i);
+  }
+}
+
+ParallelFrameEvaluator::~ParallelFrameEvaluator()
+{
+  for (Slot &slot : slots_) {
+    BLI_task_pool_work_and_wait(slot.task_pool);
+    BLI_task_pool_free(slot.task_pool);
+  }
+}
+
+void ParallelFrameEvaluator::evaluate_frame_in_slot(const int64_t frame_index)
+{
+  Slot &slot = slots_[frame_index % slots_.size()];
+  slot.frame = frames_[frame_index];
+  /* The slot is not modified until the task is done. */
+  BLI_task_pool_push(slot.task_pool, evaluate_frame_task, &slot, false, nullptr);
+}
+
+Depsgraph *ParallelFrameEvaluator::next_frame()
+{
+  BLI_assert(next_frame_index_ < frames_.size());
+  /* The dependency graph of the previous frame is free again. */
+  const int64_t next_frame_to_evaluate = next_frame_index_ - 1 + slots_.size();
+  if (next_frame_index_ > 0 && next_frame_to_evaluate < frames_.size()) {
+    evaluate_frame_in_slot(next_frame_to_evaluate);
+  }
+  Slot &slot = slots_[next_frame_index_ % slots_.size()];
+  next_frame_index_++;
+  BLI_task_pool_work_and_wait(slot.task_pool);
+  return slot.depsgraph;
+}
+
+}  // namespace blender::io
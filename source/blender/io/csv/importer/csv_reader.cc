@@ -6,10 +6,16 @@
  * \ingroup csv
  */
 
+#ifdef _WIN32
+#  include <io.h>
+#else
+#  include <unistd.h>
+#endif
+
 #include <atomic>
 #include <charconv>
+#include <fcntl.h>
 #include <optional>
-#include <variant>
 
 #include "BLI_array_utils.hh"
 #include "fast_float.h"
@@ -21,9 +27,14 @@
 
 #include "BLI_csv_parse.hh"
 #include "BLI_fileops.hh"
-#include "BLI_implicit_sharing.hh"
+#include "BLI_mmap.h"
+#include "BLI_offset_indices.hh"
+#include "BLI_task.hh"
+#include "BLI_utility_mixins.hh"
 #include "BLI_vector.hh"
 
+#include "MEM_guardedalloc.h"
+
 #include "IO_csv.hh"
 
 namespace blender::io::csv {
@@ -36,29 +47,24 @@ struct ColumnInfo {
   std::atomic<bool> found_float = false;
 };
 
-using ColumnData = std::variant<std::monostate, Vector<float>, Vector<int>>;
-
-struct ChunkResult {
-  int rows_num;
-  Vector<ColumnData> columns;
-};
-
 struct ParseFloatColumnResult {
-  Vector<float> data;
   bool found_invalid = false;
 };
 
 struct ParseIntColumnResult {
-  Vector<int> data;
   bool found_invalid = false;
   bool found_float = false;
 };
 
+/**
+ * Parse all values of a column as floats. When the destination is empty, the values are only
+ * checked to find the type of the column.
+ */
 static ParseFloatColumnResult parse_column_as_floats(const csv_parse::CsvRecords &records,
-                                                     const int column_i)
+                                                     const int column_i,
+                                                     MutableSpan<float> r_values)
 {
   ParseFloatColumnResult result;
-  result.data.reserve(records.size());
   for (const int row_i : records.index_range()) {
     const Span<char> value_span = records.record(row_i).field(column_i);
     const char *value_begin = value_span.begin();
@@ -83,16 +89,19 @@ static ParseFloatColumnResult parse_column_as_floats(const csv_parse::CsvRecords
         return result;
       }
     }
-    result.data.append(value);
+    if (!r_values.is_empty()) {
+      r_values[row_i] = value;
+    }
   }
   return result;
 }
 
+/** Same as #parse_column_as_floats, but for integers. */
 static ParseIntColumnResult parse_column_as_ints(const csv_parse::CsvRecords &records,
-                                                 const int column_i)
+                                                 const int column_i,
+                                                 MutableSpan<int> r_values)
 {
   ParseIntColumnResult result;
-  result.data.reserve(records.size());
   for (const int row_i : records.index_range()) {
     const Span<char> value_span = records.record(row_i).field(column_i);
     const char *value_begin = value_span.begin();
@@ -122,19 +131,22 @@ static ParseIntColumnResult parse_column_as_ints(const csv_parse::CsvRecords &re
         return result;
       }
     }
-    result.data.append(value);
+    if (!r_values.is_empty()) {
+      r_values[row_i] = value;
+    }
   }
   return result;
 }
 
-static ChunkResult parse_records_chunk(const csv_parse::CsvRecords &records,
-                                       MutableSpan<ColumnInfo> columns_info)
+/**
+ * First pass over the records: find the type of every column without storing any values.
+ * 
+eturn The number of records in the chunk.
+ */
+static int64_t find_column_types_in_chunk(const csv_parse::CsvRecords &records,
+                                          MutableSpan<ColumnInfo> columns_info)
 {
-  const int columns_num = columns_info.size();
-  ChunkResult chunk_result;
-  chunk_result.rows_num = records.size();
-  chunk_result.columns.resize(columns_num);
-  for (const int column_i : IndexRange(columns_num)) {
+  for (const int column_i : columns_info.index_range()) {
     ColumnInfo &column_info = columns_info[column_i];
     if (column_info.has_invalid_name) {
       /* Column can be ignored. */
@@ -144,135 +156,135 @@ static ChunkResult parse_records_chunk(const csv_parse::CsvRecords &records,
       /* Invalid values have been found in this column already, skip it. */
       continue;
     }
-    /* A float was found in this column already, so parse everything as floats. */
+    /* A float was found in this column already, so check that everything is a float. */
     const bool found_float = column_info.found_float.load(std::memory_order_relaxed);
     if (found_float) {
-      ParseFloatColumnResult float_column_result = parse_column_as_floats(records, column_i);
-      if (float_column_result.found_invalid) {
+      if (parse_column_as_floats(records, column_i, {}).found_invalid) {
         column_info.found_invalid.store(true, std::memory_order_relaxed);
-        continue;
       }
-      chunk_result.columns[column_i] = std::move(float_column_result.data);
       continue;
     }
     /* No float was found so far in this column, so attempt to parse it as integers. */
-    ParseIntColumnResult int_column_result = parse_column_as_ints(records, column_i);
+    const ParseIntColumnResult int_column_result = parse_column_as_ints(records, column_i, {});
     if (int_column_result.found_invalid) {
       column_info.found_invalid.store(true, std::memory_order_relaxed);
       continue;
     }
     if (!int_column_result.found_float) {
-      chunk_result.columns[column_i] = std::move(int_column_result.data);
       column_info.found_int.store(true, std::memory_order_relaxed);
       continue;
     }
     /* While parsing it as integers, floats were detected. So parse it as floats again. */
     column_info.found_float.store(true, std::memory_order_relaxed);
-    ParseFloatColumnResult float_column_result = parse_column_as_floats(records, column_i);
-    if (float_column_result.found_invalid) {
+    if (parse_column_as_floats(records, column_i, {}).found_invalid) {
       column_info.found_invalid.store(true, std::memory_order_relaxed);
-      continue;
     }
-    chunk_result.columns[column_i] = std::move(float_column_result.data);
   }
-  return chunk_result;
+  return records.size();
 }
 
 /**
- * So far, the parsed data is still split into many chunks. This function flattens the chunks into
- * continuous buffers that can be used as attributes.
+ * Second pass over the records: write the values of every valid column into its attribute.
+ * \param attributes: The span of every column, or empty when the column is ignored.
  */
-static Array<std::optional<GArray<>>> flatten_valid_attribute_chunks(
-    const Span<ColumnInfo> columns_info,
-    OffsetIndices<int> chunk_offsets,
-    MutableSpan<ChunkResult> chunks)
+static void write_chunk_values(const csv_parse::CsvRecords &records,
+                               const Span<GMutableSpan> attributes,
+                               const int64_t start)
 {
-  const int points_num = chunk_offsets.total_size();
-  Array<std::optional<GArray<>>> flattened_attributes(columns_info.size());
+  for (const int column_i : attributes.index_range()) {
+    const GMutableSpan attribute = attributes[column_i];
+    if (attribute.is_empty()) {
+      continue;
+    }
+    const GMutableSpan dst = attribute.slice(start, records.size());
+    if (dst.type().is<float>()) {
+      const ParseFloatColumnResult result = parse_column_as_floats(
+          records, column_i, dst.typed<float>());
+      BLI_assert(!result.found_invalid);
+      UNUSED_VARS_NDEBUG(result);
+    }
+    else {
+      const ParseIntColumnResult result = parse_column_as_ints(
+          records, column_i, dst.typed<int>());
+      BLI_assert(!result.found_invalid && !result.found_float);
+      UNUSED_VARS_NDEBUG(result);
+    }
+  }
+}
 
-  threading::parallel_for(columns_info.index_range(), 1, [&](const IndexRange columns_range) {
-    for (const int column_i : columns_range) {
-      const ColumnInfo &column_info = columns_info[column_i];
-      if (column_info.has_invalid_name || column_info.found_invalid) {
-        /* Column can be ignored. */
-        continue;
-      }
-      if (column_info.found_float) {
-        /* Should read column as floats. */
-        GArray<> attribute(CPPType::get<float>(), points_num);
-        float *attribute_buffer = static_cast<float *>(attribute.data());
-        threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange chunks_range) {
-          for (const int chunk_i : chunks_range) {
-            const IndexRange dst_range = chunk_offsets[chunk_i];
-            ChunkResult &chunk = chunks[chunk_i];
-            ColumnData &column_data = chunk.columns[column_i];
-            if (const auto *float_vec = std::get_if<Vector<float>>(&column_data)) {
-              BLI_assert(float_vec->size() == dst_range.size());
-              uninitialized_copy_n(
-                  float_vec->data(), dst_range.size(), attribute_buffer + dst_range.first());
-            }
-            else if (const auto *int_vec = std::get_if<Vector<int>>(&column_data)) {
-              /* This chunk was read entirely as integers, so it still has to be converted to
-               * floats. */
-              BLI_assert(int_vec->size() == dst_range.size());
-              uninitialized_convert_n(int_vec->data(), dst_range.size(), attribute_buffer);
-            }
-            else {
-              /* Expected data to be available, because the `found_invalid` flag was not
-               * set. */
-              BLI_assert_unreachable();
-            }
-            /* Free data for chunk. */
-            column_data = std::monostate{};
-          }
-        });
-        flattened_attributes[column_i] = std::move(attribute);
-        continue;
-      }
-      if (column_info.found_int) {
-        /* Should read column as ints. */
-        GArray<> attribute(CPPType::get<int>(), points_num);
-        int *attribute_buffer = static_cast<int *>(attribute.data());
-        threading::parallel_for(chunks.index_range(), 1, [&](const IndexRange chunks_range) {
-          for (const int chunk_i : chunks_range) {
-            const IndexRange dst_range = chunk_offsets[chunk_i];
-            ChunkResult &chunk = chunks[chunk_i];
-            ColumnData &column_data = chunk.columns[column_i];
-            if (const auto *int_vec = std::get_if<Vector<int>>(&column_data)) {
-              BLI_assert(int_vec->size() == dst_range.size());
-              uninitialized_copy_n(
-                  int_vec->data(), dst_range.size(), attribute_buffer + dst_range.first());
-            }
-            else {
-              /* Expected data to be available, because the `found_invalid` and
-               * `found_float` flags were not set. */
-              BLI_assert_unreachable();
-            }
-            /* Free data for chunk. */
-            column_data = std::monostate{};
-          }
-        });
-        flattened_attributes[column_i] = std::move(attribute);
-        continue;
+/**
+ * The file is memory mapped if possible, so that its content does not have to be copied into
+ * memory in addition to the imported attributes.
+ */
+class CSVFileData : NonCopyable, NonMovable {
+  int file_ = -1;
+  BLI_mmap_file *mmap_file_ = nullptr;
+  void *buffer_ = nullptr;
+  Span<char> data_;
+
+ public:
+  explicit CSVFileData(const char *filepath)
+  {
+    file_ = BLI_open(filepath, O_BINARY | O_RDONLY, 0);
+    if (file_ == -1) {
+      return;
+    }
+    mmap_file_ = BLI_mmap_open(file_);
+    if (mmap_file_ != nullptr) {
+      const size_t size = BLI_mmap_get_length(mmap_file_);
+      const void *data = size > 0 ? BLI_mmap_get_range(mmap_file_, 0, size) : nullptr;
+      if (data != nullptr) {
+        data_ = Span<char>(static_cast<const char *>(data), int64_t(size));
+        return;
       }
+      BLI_mmap_free(mmap_file_);
+      mmap_file_ = nullptr;
     }
-  });
-  return flattened_attributes;
-}
+    size_t buffer_len;
+    buffer_ = BLI_file_read_text_as_mem(filepath, 0, &buffer_len);
+    if (buffer_ != nullptr) {
+      data_ = Span<char>(static_cast<const char *>(buffer_), int64_t(buffer_len));
+    }
+  }
+
+  ~CSVFileData()
+  {
+    if (mmap_file_ != nullptr) {
+      BLI_mmap_free(mmap_file_);
+    }
+    if (file_ != -1) {
+      close(file_);
+    }
+    MEM_SAFE_FREE(buffer_);
+  }
+
+  bool is_valid() const
+  {
+    return mmap_file_ != nullptr || buffer_ != nullptr;
+  }
+
+  Span<char> data() const
+  {
+    return data_;
+  }
+
+  bool has_io_error() const
+  {
+    return mmap_file_ != nullptr && BLI_mmap_has_io_error(mmap_file_);
+  }
+};
 
 PointCloud *import_csv_as_pointcloud(const CSVImportParams &import_params)
 {
-  size_t buffer_len;
-  void *buffer = BLI_file_read_text_as_mem(import_params.filepath, 0, &buffer_len);
-  if (buffer == nullptr) {
+  const CSVFileData file_data(import_params.filepath);
+  if (!file_data.is_valid()) {
     BKE_reportf(import_params.reports,
                 RPT_ERROR,
                 "CSV Import: Cannot open file '%s'",
                 import_params.filepath);
     return nullptr;
   }
-  BLI_SCOPED_DEFER([&]() { MEM_freeN(buffer); });
-  if (buffer_len == 0) {
+  if (file_data.data().is_empty()) {
     BKE_reportf(
         import_params.reports, RPT_ERROR, "CSV Import: empty file '%s'", import_params.filepath);
     return nullptr;
@@ -298,15 +310,16 @@ PointCloud *import_csv_as_pointcloud(const CSVImportParams &import_params)
       }
     }
   };
-  const auto parse_data_chunk = [&](const csv_parse::CsvRecords &records) {
-    return parse_records_chunk(records, columns_info);
-  };
 
-  const Span<char> buffer_span{static_cast<char *>(buffer), int64_t(buffer_len)};
-  std::optional<Vector<ChunkResult>> parsed_chunks = csv_parse::parse_csv_in_chunks<ChunkResult>(
-      buffer_span, parse_options, parse_header, parse_data_chunk);
+  /* The file is parsed twice, to avoid storing the parsed values of every chunk before they are
+   * copied into the attributes. The first pass only counts the records and finds the type of
+   * every column, the second pass writes the values directly into the attribute arrays. */
+  const std::optional<Vector<int64_t>> chunk_sizes = csv_parse::parse_csv_in_chunks<int64_t>(
+      file_data.data(), parse_options, parse_header, [&](const csv_parse::CsvRecords &records) {
+        return find_column_types_in_chunk(records, columns_info);
+      });
 
-  if (!parsed_chunks.has_value()) {
+  if (!chunk_sizes.has_value() || file_data.has_io_error()) {
     BKE_reportf(import_params.reports,
                 RPT_ERROR,
                 "CSV import: failed to parse file '%s'",
@@ -314,46 +327,72 @@ PointCloud *import_csv_as_pointcloud(const CSVImportParams &import_params)
     return nullptr;
   }
 
-  /* Count the total number of records and compute the offset of each chunk which is used when
-   * flattening the parsed data. */
-  Vector<int> chunk_offsets_vec;
-  chunk_offsets_vec.append(0);
-  for (const ChunkResult &chunk : *parsed_chunks) {
-    chunk_offsets_vec.append(chunk_offsets_vec.last() + chunk.rows_num);
+  /* Compute the offset of each chunk which is used when writing the parsed data. */
+  Array<int> chunk_offsets_data(chunk_sizes->size() + 1);
+  for (const int64_t i : chunk_sizes->index_range()) {
+    chunk_offsets_data[i] = int((*chunk_sizes)[i]);
   }
-  const OffsetIndices<int> chunk_offsets(chunk_offsets_vec);
-  const int points_num = chunk_offsets_vec.last();
+  const OffsetIndices<int> chunk_offsets = offset_indices::accumulate_counts_to_offsets(
+      chunk_offsets_data);
+  const int points_num = chunk_offsets.total_size();
 
   PointCloud *pointcloud = BKE_pointcloud_new_nomain(points_num);
-
-  Array<std::optional<GArray<>>> flattened_attributes;
-  threading::memory_bandwidth_bound_task(points_num * 16, [&]() {
-    threading::parallel_invoke(
-        [&]() {
-          array_utils::copy(VArray<float3>::ForSingle(float3(0), points_num),
-                            pointcloud->positions_for_write());
-        },
-        [&]() {
-          flattened_attributes = flatten_valid_attribute_chunks(
-              columns_info, chunk_offsets, *parsed_chunks);
-        });
-  });
-
-  /* Add all valid attributes to the pointcloud. */
   bke::MutableAttributeAccessor attributes = pointcloud->attributes_for_write();
+
+  /* Add all valid attributes to the pointcloud, their values are written below. */
+  Array<bke::GSpanAttributeWriter> attribute_writers(columns_info.size());
+  Array<GMutableSpan> attribute_spans(columns_info.size());
   for (const int column_i : columns_info.index_range()) {
-    std::optional<GArray<>> &attribute = flattened_attributes[column_i];
-    if (!attribute.has_value()) {
+    const ColumnInfo &column_info = columns_info[column_i];
+    if (column_info.has_invalid_name || column_info.found_invalid) {
       continue;
     }
-    const auto *data = new ImplicitSharedValue<GArray<>>(std::move(*attribute));
-    const eCustomDataType type = bke::cpp_type_to_custom_data_type(attribute->type());
-    const ColumnInfo &column_info = columns_info[column_i];
-    attributes.add(column_info.name,
-                   bke::AttrDomain::Point,
-                   type,
-                   bke::AttributeInitShared{data->data.data(), *data});
-    data->remove_user_and_delete_if_last();
+    eCustomDataType type;
+    if (column_info.found_float) {
+      type = CD_PROP_FLOAT;
+    }
+    else if (column_info.found_int) {
+      type = CD_PROP_INT32;
+    }
+    else {
+      continue;
+    }
+    if (!attributes.add(
+            column_info.name, bke::AttrDomain::Point, type, bke::AttributeInitConstruct()))
+    {
+      continue;
+    }
+    attribute_writers[column_i] = attributes.lookup_for_write_span(column_info.name);
+    attribute_spans[column_i] = attribute_writers[column_i].span;
+  }
+
+  threading::parallel_invoke(
+      [&]() {
+        array_utils::copy(VArray<float3>::ForSingle(float3(0), points_num),
+                          pointcloud->positions_for_write());
+      },
+      [&]() {
+        csv_parse::parse_csv_in_indexed_chunks(
+            file_data.data(),
+            parse_options,
+            [&](const csv_parse::CsvRecord & /*record*/) {},
+            [&](const int64_t chunk_index, const csv_parse::CsvRecords &records) {
+              /* In the rare case of multi-line fields being split, the first pass fell back to
+               * a single chunk too. */
+              if (chunk_index < chunk_offsets.size() &&
+                  records.size() == chunk_offsets[chunk_index].size())
+              {
+                write_chunk_values(
+                    records, attribute_spans, chunk_offsets[chunk_index].start());
+              }
+              return Any<>();
+            });
+      });
+
+  for (bke::GSpanAttributeWriter &writer : attribute_writers) {
+    if (writer) {
+      writer.finish();
+    }
   }
 
   /* Since all positions are set to zero, the bounding box can be updated eagerly to avoid
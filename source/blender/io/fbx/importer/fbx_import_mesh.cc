@@ -63,10 +63,12 @@ static void import_vertex_positions(const ufbx_mesh *fmesh, Mesh *mesh)
 #endif
 
   BLI_assert(positions.size() == fmesh->vertex_position.values.count);
-  for (int i = 0; i < fmesh->vertex_position.values.count; i++) {
-    ufbx_vec3 val = fmesh->vertex_position.values[i];
-    positions[i] = float3(val.x, val.y, val.z);
-  }
+  threading::parallel_for(positions.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      ufbx_vec3 val = fmesh->vertex_position.values[i];
+      positions[i] = float3(val.x, val.y, val.z);
+    }
+  });
 }
 
 static void import_faces(const ufbx_mesh *fmesh, Mesh *mesh)
@@ -75,16 +77,18 @@ static void import_faces(const ufbx_mesh *fmesh, Mesh *mesh)
   MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
   BLI_assert((face_offsets.size() == fmesh->num_faces + 1) ||
              (face_offsets.is_empty() && fmesh->num_faces == 0));
-  for (int face_idx = 0; face_idx < fmesh->num_faces; face_idx++) {
-    //@TODO: skip < 3 vertex faces?
-    const ufbx_face &fface = fmesh->faces[face_idx];
-    face_offsets[face_idx] = fface.index_begin;
-    for (int i = 0; i < fface.num_indices; i++) {
-      int corner_idx = fface.index_begin + i;
-      int vidx = fmesh->vertex_indices[corner_idx];
-      corner_verts[corner_idx] = vidx;
+  threading::parallel_for(IndexRange(fmesh->num_faces), 1024, [&](const IndexRange range) {
+    for (const int face_idx : range) {
+      //@TODO: skip < 3 vertex faces?
+      const ufbx_face &fface = fmesh->faces[face_idx];
+      face_offsets[face_idx] = fface.index_begin;
+      for (int i = 0; i < fface.num_indices; i++) {
+        int corner_idx = fface.index_begin + i;
+        int vidx = fmesh->vertex_indices[corner_idx];
+        corner_verts[corner_idx] = vidx;
+      }
     }
-  }
+  });
 }
 
 static void import_face_material_indices(const ufbx_mesh *fmesh,
@@ -190,11 +194,13 @@ static void import_uvs(const ufbx_mesh *fmesh,
     bke::SpanAttributeWriter<float2> uvs = attributes.lookup_or_add_for_write_only_span<float2>(
         attr_name, bke::AttrDomain::Corner);
     BLI_assert(fuv_set.vertex_uv.indices.count == uvs.span.size());
-    for (int i = 0; i < fuv_set.vertex_uv.indices.count; i++) {
-      int val_idx = fuv_set.vertex_uv.indices[i];
-      const ufbx_vec2 &uv = fuv_set.vertex_uv.values[val_idx];
-      uvs.span[i] = float2(uv.x, uv.y);
-    }
+    threading::parallel_for(uvs.span.index_range(), 4096, [&](const IndexRange range) {
+      for (const int i : range) {
+        int val_idx = fuv_set.vertex_uv.indices[i];
+        const ufbx_vec2 &uv = fuv_set.vertex_uv.values[val_idx];
+        uvs.span[i] = float2(uv.x, uv.y);
+      }
+    });
     uvs.finish();
   }
 }
@@ -217,15 +223,17 @@ static void import_colors(const ufbx_mesh *fmesh,
           attributes.lookup_or_add_for_write_only_span<ColorGeometry4b>(attr_name,
                                                                         bke::AttrDomain::Corner);
       BLI_assert(fcol_set.vertex_color.indices.count == cols.span.size());
-      for (int i = 0; i < fcol_set.vertex_color.indices.count; i++) {
-        int val_idx = fcol_set.vertex_color.indices[i];
-        const ufbx_vec4 &col = fcol_set.vertex_color.values[val_idx];
-        /* Note: color values are expected to already be in sRGB space. */
-        float4 fcol = float4(col.x, col.y, col.z, col.w);
-        uchar4 bcol;
-        rgba_float_to_uchar(bcol, fcol);
-        cols.span[i] = ColorGeometry4b(bcol);
-      }
+      threading::parallel_for(cols.span.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          int val_idx = fcol_set.vertex_color.indices[i];
+          const ufbx_vec4 &col = fcol_set.vertex_color.values[val_idx];
+          /* Note: color values are expected to already be in sRGB space. */
+          float4 fcol = float4(col.x, col.y, col.z, col.w);
+          uchar4 bcol;
+          rgba_float_to_uchar(bcol, fcol);
+          cols.span[i] = ColorGeometry4b(bcol);
+        }
+      });
       cols.finish();
     }
     else if (color_mode == eFBXVertexColorMode::Linear) {
@@ -234,11 +242,13 @@ static void import_colors(const ufbx_mesh *fmesh,
           attributes.lookup_or_add_for_write_only_span<ColorGeometry4f>(attr_name,
                                                                         bke::AttrDomain::Corner);
       BLI_assert(fcol_set.vertex_color.indices.count == cols.span.size());
-      for (int i = 0; i < fcol_set.vertex_color.indices.count; i++) {
-        int val_idx = fcol_set.vertex_color.indices[i];
-        const ufbx_vec4 &col = fcol_set.vertex_color.values[val_idx];
-        cols.span[i] = ColorGeometry4f(col.x, col.y, col.z, col.w);
-      }
+      threading::parallel_for(cols.span.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          int val_idx = fcol_set.vertex_color.indices[i];
+          const ufbx_vec4 &col = fcol_set.vertex_color.values[val_idx];
+          cols.span[i] = ColorGeometry4f(col.x, col.y, col.z, col.w);
+        }
+      });
       cols.finish();
     }
     else {
@@ -262,11 +272,13 @@ static bool import_normals_into_temp_attribute(const ufbx_mesh *fmesh,
       temp_custom_normals_name, bke::AttrDomain::Corner);
   BLI_assert(fmesh->vertex_normal.indices.count == mesh->corners_num);
   BLI_assert(fmesh->vertex_normal.indices.count == normals.span.size());
-  for (int i = 0; i < mesh->corners_num; i++) {
-    int val_idx = fmesh->vertex_normal.indices[i];
-    const ufbx_vec3 &normal = fmesh->vertex_normal.values[val_idx];
-    normals.span[i] = float3(normal.x, normal.y, normal.z);
-  }
+  threading::parallel_for(normals.span.index_range(), 4096, [&](const IndexRange range) {
+    for (const int i : range) {
+      int val_idx = fmesh->vertex_normal.indices[i];
+      const ufbx_vec3 &normal = fmesh->vertex_normal.values[val_idx];
+      normals.span[i] = float3(normal.x, normal.y, normal.z);
+    }
+  });
   normals.finish();
   return true;
 }
@@ -25,13 +25,15 @@ FileBuffer::FileBuffer(const char *filepath, size_t buffer_chunk_size)
     throw std::system_error(
         errno, std::system_category(), "Cannot open file " + std::string(filepath) + ".");
   }
+  file_writer_ = std::make_unique<OrderedFileWriter>(outfile_);
 }
 
 void FileBuffer::write_to_file()
 {
-  for (const VectorChar &b : blocks_) {
-    fwrite(b.data(), 1, b.size(), this->outfile_);
+  if (blocks_.is_empty() || !file_writer_) {
+    return;
   }
+  file_writer_->submit(file_writer_->reserve(1).first(), std::move(blocks_));
   blocks_.clear();
 }
 
@@ -40,6 +42,7 @@ void FileBuffer::close_file()
   if (!outfile_) {
     return;
   }
+  file_writer_.reset();
   int close_status = std::fclose(outfile_);
   if (close_status == EOF) {
     return;
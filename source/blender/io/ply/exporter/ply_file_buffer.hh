@@ -8,10 +8,15 @@
 
 #pragma once
 
+#include <memory>
+
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 #include "BLI_utility_mixins.hh"
 #include "BLI_vector.hh"
 
+#include "IO_ordered_file_writer.hh"
+
 /* SEP macro from BLI path utils clashes with SEP symbol in fmt headers. */
 #undef SEP
 #include <fmt/format.h>
@@ -23,17 +28,23 @@ namespace blender::io::ply {
  * All writes are done into an internal chunked memory buffer
  * (list of default 64 kilobyte blocks).
  * Call write_to_file once in a while to write the memory buffer(s)
- * into the given file.
+ * into the given file. The file itself is written from a separate thread.
  */
 class FileBuffer : private NonMovable {
   using VectorChar = Vector<char>;
   Vector<VectorChar> blocks_;
   size_t buffer_chunk_size_;
-  const char *filepath_;
-  FILE *outfile_;
+  const char *filepath_ = nullptr;
+  FILE *outfile_ = nullptr;
+  std::unique_ptr<OrderedFileWriter> file_writer_;
 
  public:
   FileBuffer(const char *filepath, size_t buffer_chunk_size = 64 * 1024);
+  /* Buffer that is not connected to a file, used to format data in parallel. */
+  explicit FileBuffer(size_t buffer_chunk_size = 64 * 1024)
+      : buffer_chunk_size_(buffer_chunk_size)
+  {
+  }
 
   virtual ~FileBuffer() = default;
 
@@ -42,6 +53,12 @@ class FileBuffer : private NonMovable {
 
   void close_file();
 
+  /**
+   * Call the function for every item. With many items, chunks of them are formatted in parallel
+   * into separate buffers, which are written to the file in order.
+   */
+  template<typename Fn> void write_parallel_chunked(int64_t items_num, const Fn &fn);
+
   virtual void write_vertex(float x, float y, float z) = 0;
 
   virtual void write_UV(float u, float v) = 0;
@@ -58,6 +75,9 @@ class FileBuffer : private NonMovable {
 
   virtual void write_edge(int first, int second) = 0;
 
+  /* Create a buffer with the same format that is not connected to a file. */
+  virtual std::unique_ptr<FileBuffer> create_memory_buffer() const = 0;
+
   void write_header_element(StringRef name, int count);
 
   void write_header_scalar_property(StringRef dataType, StringRef name);
@@ -93,4 +113,32 @@ class FileBuffer : private NonMovable {
   void write_bytes(Span<char> bytes);
 };
 
+template<typename Fn>
+void FileBuffer::write_parallel_chunked(const int64_t items_num, const Fn &fn)
+{
+  constexpr int64_t chunk_size = 32768;
+  const int64_t chunks_num = (items_num + chunk_size - 1) / chunk_size;
+  if (chunks_num <= 1 || !file_writer_) {
+    for (const int64_t i : IndexRange(items_num)) {
+      fn(*this, i);
+    }
+    this->write_to_file();
+    return;
+  }
+  /* Data in this buffer has to be written before the chunks. */
+  this->write_to_file();
+  const IndexRange chunk_indices = file_writer_->reserve(chunks_num);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      std::unique_ptr<FileBuffer> buffer = this->create_memory_buffer();
+      const IndexRange items = IndexRange::from_begin_end(
+          chunk * chunk_size, std::min((chunk + 1) * chunk_size, items_num));
+      for (const int64_t i : items) {
+        fn(*buffer, i);
+      }
+      file_writer_->submit(chunk_indices[chunk], std::move(buffer->blocks_));
+    }
+  });
+}
+
 }  // namespace blender::io::ply
@@ -30,5 +30,7 @@ class FileBufferAscii : public FileBuffer {
   void write_face(char count, Span<uint32_t> const &vertex_indices) override;
 
   void write_edge(int first, int second) override;
+
+  std::unique_ptr<FileBuffer> create_memory_buffer() const override;
 };
 }  // namespace blender::io::ply
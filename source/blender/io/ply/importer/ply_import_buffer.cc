@@ -63,6 +63,22 @@ Span<char> PlyReadBuffer::read_line()
 
 bool PlyReadBuffer::read_bytes(void *dst, size_t size)
 {
+  if (is_binary_ && size > read_buffer_size_) {
+    /* Large reads go directly into the destination, after what is left in the buffer. */
+    const int buffered = buf_used_ - pos_;
+    memcpy(dst, buffer_.data() + pos_, buffered);
+    pos_ = buf_used_;
+    dst = (char *)dst + buffered;
+    size -= buffered;
+    if (file_ == nullptr || at_eof_) {
+      return false;
+    }
+    if (fread(dst, 1, size, file_) < size) {
+      at_eof_ = true;
+      return false;
+    }
+    return true;
+  }
   while (size > 0) {
     if (pos_ + size > buf_used_) {
       if (!refill_buffer()) {
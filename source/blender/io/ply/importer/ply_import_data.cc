@@ -10,11 +10,14 @@
 #include "ply_data.hh"
 #include "ply_import_buffer.hh"
 
+#include "BLI_array.hh"
 #include "BLI_endian_switch.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 
 #include "fast_float.h"
 
+#include <algorithm>
 #include <charconv>
 
 #include "CLG_log.h"
@@ -102,6 +105,9 @@ namespace blender::io::ply {
 static const int data_type_size[] = {0, 1, 1, 2, 2, 4, 4, 4, 8};
 static_assert(std::size(data_type_size) == PLY_TYPE_COUNT, "PLY data type size table mismatch");
 
+/** Number of rows of a binary vertex element read from the file at once. */
+static constexpr int64_t binary_rows_per_block = 64 * 1024;
+
 static const float data_type_normalizer[] = {
     1.0f, 127.0f, 255.0f, 32767.0f, 65535.0f, float(INT_MAX), float(UINT_MAX), 1.0f, 1.0f};
 static_assert(std::size(data_type_normalizer) == PLY_TYPE_COUNT,
@@ -193,22 +199,13 @@ template<typename T> static T get_binary_value(PlyDataTypes type, const uint8_t
   return val;
 }
 
-static const char *parse_row_binary(PlyReadBuffer &file,
-                                    const PlyHeader &header,
-                                    const PlyElement &element,
-                                    Vector<uint8_t> &r_scratch,
-                                    Vector<float> &r_values)
+/** Convert the values of a row of a fixed stride binary element. Big endian rows are modified. */
+static void convert_row_binary(const PlyHeader &header,
+                               const PlyElement &element,
+                               uint8_t *row,
+                               MutableSpan<float> r_values)
 {
-  if (element.stride == 0) {
-    return "Vertex/Edge element contains list properties, this is not supported";
-  }
-  BLI_assert(r_scratch.size() == element.stride);
-  BLI_assert(r_values.size() == element.properties.size());
-  if (!file.read_bytes(r_scratch.data(), r_scratch.size())) {
-    return "Could not read row of binary property";
-  }
-
-  const uint8_t *ptr = r_scratch.data();
+  const uint8_t *ptr = row;
   if (header.type == PlyFormatType::BINARY_LE) {
     /* Little endian: just read/convert the values. */
     for (int i = 0, n = int(element.properties.size()); i != n; i++) {
@@ -226,9 +223,27 @@ static const char *parse_row_binary(PlyReadBuffer &file,
       r_values[i] = val;
     }
   }
-  else {
+}
+
+static const char *parse_row_binary(PlyReadBuffer &file,
+                                    const PlyHeader &header,
+                                    const PlyElement &element,
+                                    Vector<uint8_t> &r_scratch,
+                                    Vector<float> &r_values)
+{
+  if (element.stride == 0) {
+    return "Vertex/Edge element contains list properties, this is not supported";
+  }
+  if (!ELEM(header.type, PlyFormatType::BINARY_LE, PlyFormatType::BINARY_BE)) {
     return "Unknown binary ply format for vertex element";
   }
+  BLI_assert(r_scratch.size() == element.stride);
+  BLI_assert(r_values.size() == element.properties.size());
+  if (!file.read_bytes(r_scratch.data(), r_scratch.size())) {
+    return "Could not read row of binary property";
+  }
+
+  convert_row_binary(header, element, r_scratch.data(), r_values);
   return nullptr;
 }
 
@@ -270,15 +285,15 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     data->vertex_custom_attr.append(attr);
   }
 
-  data->vertices.reserve(element.count);
+  data->vertices.resize(element.count);
   if (has_color) {
-    data->vertex_colors.reserve(element.count);
+    data->vertex_colors.resize(element.count);
   }
   if (has_normal) {
-    data->vertex_normals.reserve(element.count);
+    data->vertex_normals.resize(element.count);
   }
   if (has_uv) {
-    data->uv_coordinates.reserve(element.count);
+    data->uv_coordinates.resize(element.count);
   }
 
   float4 color_norm = {1, 1, 1, 1};
@@ -291,31 +306,13 @@ static const char *load_vertex_element(PlyReadBuffer &file,
     color_norm.w = data_type_normalizer[element.properties[alpha_index].type];
   }
 
-  Vector<float> value_vec(element.properties.size());
-  Vector<uint8_t> scratch;
-  if (header.type != PlyFormatType::ASCII) {
-    scratch.resize(element.stride);
-  }
-
-  for (int i = 0; i < element.count; i++) {
-
-    const char *error = nullptr;
-    if (header.type == PlyFormatType::ASCII) {
-      error = parse_row_ascii(file, value_vec);
-    }
-    else {
-      error = parse_row_binary(file, header, element, scratch, value_vec);
-    }
-    if (error != nullptr) {
-      return error;
-    }
-
+  auto store_row = [&](const Span<float> value_vec, const int64_t i) {
     /* Vertex coord */
     float3 vertex3;
     vertex3.x = value_vec[vertex_index.x];
     vertex3.y = value_vec[vertex_index.y];
     vertex3.z = value_vec[vertex_index.z];
-    data->vertices.append(vertex3);
+    data->vertices[i] = vertex3;
 
     /* Vertex color */
     if (has_color) {
@@ -329,7 +326,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       else {
         colors4.w = 1.0f;
       }
-      data->vertex_colors.append(colors4);
+      data->vertex_colors[i] = colors4;
     }
 
     /* If normals */
@@ -338,7 +335,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       normals3.x = value_vec[normal_index.x];
       normals3.y = value_vec[normal_index.y];
       normals3.z = value_vec[normal_index.z];
-      data->vertex_normals.append(normals3);
+      data->vertex_normals[i] = normals3;
     }
 
     /* If uv */
@@ -346,7 +343,7 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float2 uvmap;
       uvmap.x = value_vec[uv_index.x];
       uvmap.y = value_vec[uv_index.y];
-      data->uv_coordinates.append(uvmap);
+      data->uv_coordinates[i] = uvmap;
     }
 
     /* Custom attributes */
@@ -354,6 +351,43 @@ static const char *load_vertex_element(PlyReadBuffer &file,
       float value = value_vec[custom_attr_indices[ci]];
       data->vertex_custom_attr[ci].data[i] = value;
     }
+  };
+
+  if (header.type == PlyFormatType::ASCII) {
+    Vector<float> value_vec(element.properties.size());
+    for (int i = 0; i < element.count; i++) {
+      const char *error = parse_row_ascii(file, value_vec);
+      if (error != nullptr) {
+        return error;
+      }
+      store_row(value_vec, i);
+    }
+    return nullptr;
+  }
+
+  if (element.stride == 0) {
+    return "Vertex/Edge element contains list properties, this is not supported";
+  }
+  if (!ELEM(header.type, PlyFormatType::BINARY_LE, PlyFormatType::BINARY_BE)) {
+    return "Unknown binary ply format for vertex element";
+  }
+
+  /* Binary rows have a fixed stride: read a block of rows at once, and convert them in parallel
+   * while the block is hot in the cache. */
+  const int64_t block_rows = std::min<int64_t>(element.count, binary_rows_per_block);
+  Array<uint8_t> block(block_rows * element.stride);
+  for (int64_t block_start = 0; block_start < element.count; block_start += block_rows) {
+    const IndexRange rows(block_start, std::min<int64_t>(block_rows, element.count - block_start));
+    if (!file.read_bytes(block.data(), rows.size() * element.stride)) {
+      return "Could not read row of binary property";
+    }
+    threading::parallel_for(rows.index_range(), 4096, [&](const IndexRange range) {
+      Array<float> value_vec(element.properties.size());
+      for (const int64_t i : range) {
+        convert_row_binary(header, element, block.data() + i * element.stride, value_vec);
+        store_row(value_vec, rows[i]);
+      }
+    });
   }
   return nullptr;
 }
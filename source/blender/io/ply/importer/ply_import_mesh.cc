@@ -15,6 +15,7 @@
 #include "BLI_color.hh"
 #include "BLI_math_vector.h"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "ply_import_mesh.hh"
 
@@ -77,14 +78,14 @@ Mesh *convert_ply_to_mesh(PlyData &data, const PLYImportParams &params)
         "Col", bke::AttrDomain::Point);
 
     if (params.vertex_colors == ePLYVertexColorMode::sRGB) {
-      for (const int i : data.vertex_colors.index_range()) {
-        srgb_to_linearrgb_v4(colors.span[i], data.vertex_colors[i]);
-      }
+      threading::parallel_for(data.vertex_colors.index_range(), 4096, [&](const IndexRange range) {
+        for (const int i : range) {
+          srgb_to_linearrgb_v4(colors.span[i], data.vertex_colors[i]);
+        }
+      });
     }
     else {
-      for (const int i : data.vertex_colors.index_range()) {
-        copy_v4_v4(colors.span[i], data.vertex_colors[i]);
-      }
+      colors.span.copy_from(data.vertex_colors.as_span().cast<ColorGeometry4f>());
     }
     colors.finish();
     BKE_id_attributes_active_color_set(&mesh->id, "Col");
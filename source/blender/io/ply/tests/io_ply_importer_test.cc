@@ -62,6 +62,38 @@ TEST(ply_import, BufferRefillTest)
   EXPECT_EQ_ARRAY(exp_edges, data_b->edges.data(), 12);
 }
 
+/* Binary vertex elements are read in blocks that are larger than the read buffer here, which
+ * bypasses the buffer. The result should be the same as reading through the buffer. */
+TEST(ply_import, BinaryVertexBlocksTest)
+{
+  for (const char *filename : {"vertex_comp_order_b.ply",
+                               "face_uvs_colors_b.ply",
+                               "float_formats_b.ply",
+                               "type_aliases_be_b.ply"})
+  {
+    SCOPED_TRACE(filename);
+    std::string ply_path = blender::tests::flags_test_asset_dir() +
+                           SEP_STR "io_tests" SEP_STR "ply" SEP_STR + filename;
+
+    PlyReadBuffer infile_small(ply_path.c_str(), 50);
+    PlyReadBuffer infile_large(ply_path.c_str(), 64 * 1024);
+    PlyHeader header_small, header_large;
+    ASSERT_EQ(read_header(infile_small, header_small), nullptr);
+    ASSERT_EQ(read_header(infile_large, header_large), nullptr);
+    std::unique_ptr<PlyData> data_small = import_ply_data(infile_small, header_small);
+    std::unique_ptr<PlyData> data_large = import_ply_data(infile_large, header_large);
+    ASSERT_TRUE(data_small->error.empty());
+    ASSERT_TRUE(data_large->error.empty());
+
+    EXPECT_EQ(data_small->vertices.as_span(), data_large->vertices.as_span());
+    EXPECT_EQ(data_small->vertex_normals.as_span(), data_large->vertex_normals.as_span());
+    EXPECT_EQ(data_small->vertex_colors.as_span(), data_large->vertex_colors.as_span());
+    EXPECT_EQ(data_small->uv_coordinates.as_span(), data_large->uv_coordinates.as_span());
+    EXPECT_EQ(data_small->face_vertices.as_span(), data_large->face_vertices.as_span());
+    EXPECT_EQ(data_small->face_sizes.as_span(), data_large->face_sizes.as_span());
+  }
+}
+
 //@TODO: now we put vertex color attribute first, maybe put position first?
 //@TODO: test with vertex element having list properties
 //@TODO: test with edges starting with non-vertex index properties
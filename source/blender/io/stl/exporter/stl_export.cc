@@ -6,6 +6,7 @@
  * \ingroup stl
  */
 
+#include <algorithm>
 #include <memory>
 
 #include "BKE_context.hh"
@@ -15,8 +16,10 @@
 #include "BKE_report.hh"
 #include "BKE_scene.hh"
 
+#include "BLI_array.hh"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
+#include "BLI_task.hh"
 
 #include "DEG_depsgraph_query.hh"
 
@@ -134,21 +137,31 @@ void export_frame(Depsgraph *depsgraph,
 
     const bool mirrored = is_negative_m4(xform);
 
-    /* Write triangles. */
+    /* Write triangles, converting them to the exported space in parallel chunks. */
     const Span<float3> positions = mesh->vert_positions();
     const Span<int> corner_verts = mesh->corner_verts();
-    for (const int3 &tri : mesh->corner_tris()) {
-      PackedTriangle data{};
-      for (int i = 0; i < 3; i++) {
-        /* Reverse face order for mirrored objects. */
-        int idx = mirrored ? 2 - i : i;
-        float3 pos = positions[corner_verts[tri[idx]]];
-        mul_m4_v3(xform, pos);
-        pos *= global_scale;
-        data.vertices[i] = pos;
-      }
-      data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
-      writer->write_triangle(data);
+    const Span<int3> corner_tris = mesh->corner_tris();
+    constexpr int64_t chunk_size = 1 << 16;
+    Array<PackedTriangle> tris_buf(std::min(corner_tris.size(), chunk_size));
+    for (int64_t chunk_start = 0; chunk_start < corner_tris.size(); chunk_start += chunk_size) {
+      const Span<int3> chunk = corner_tris.slice_safe(chunk_start, chunk_size);
+      threading::parallel_for(chunk.index_range(), 4096, [&](const IndexRange range) {
+        for (const int64_t tri_i : range) {
+          const int3 &tri = chunk[tri_i];
+          PackedTriangle &data = tris_buf[tri_i];
+          for (int i = 0; i < 3; i++) {
+            /* Reverse face order for mirrored objects. */
+            int idx = mirrored ? 2 - i : i;
+            float3 pos = positions[corner_verts[tri[idx]]];
+            mul_m4_v3(xform, pos);
+            pos *= global_scale;
+            data.vertices[i] = pos;
+          }
+          data.normal = math::normal_tri(data.vertices[0], data.vertices[1], data.vertices[2]);
+          data.attribute_byte_count = 0;
+        }
+      });
+      writer->write_triangles(tris_buf.as_span().take_front(chunk.size()));
     }
   }
   DEG_OBJECT_ITER_END;
@@ -17,7 +17,9 @@
 #include "stl_data.hh"
 #include "stl_export_writer.hh"
 
+#include "BLI_array.hh"
 #include "BLI_fileops.h"
+#include "BLI_task.hh"
 
 namespace blender::io::stl {
 
@@ -56,34 +58,57 @@ FileWriter::~FileWriter()
   fclose(file_);
 }
 
+static void format_triangle(fmt::memory_buffer &buf, const PackedTriangle &data)
+{
+  fmt::format_to(fmt::appender(buf),
+                 "facet normal {} {} {}\n"
+                 " outer loop\n"
+                 "  vertex {} {} {}\n"
+                 "  vertex {} {} {}\n"
+                 "  vertex {} {} {}\n"
+                 " endloop\n"
+                 "endfacet\n",
+
+                 data.normal.x,
+                 data.normal.y,
+                 data.normal.z,
+                 data.vertices[0].x,
+                 data.vertices[0].y,
+                 data.vertices[0].z,
+                 data.vertices[1].x,
+                 data.vertices[1].y,
+                 data.vertices[1].z,
+                 data.vertices[2].x,
+                 data.vertices[2].y,
+                 data.vertices[2].z);
+}
+
 void FileWriter::write_triangle(const PackedTriangle &data)
 {
-  tris_num_++;
-  if (ascii_) {
-    fmt::print(file_,
-               "facet normal {} {} {}\n"
-               " outer loop\n"
-               "  vertex {} {} {}\n"
-               "  vertex {} {} {}\n"
-               "  vertex {} {} {}\n"
-               " endloop\n"
-               "endfacet\n",
+  this->write_triangles(Span<PackedTriangle>(&data, 1));
+}
 
-               data.normal.x,
-               data.normal.y,
-               data.normal.z,
-               data.vertices[0].x,
-               data.vertices[0].y,
-               data.vertices[0].z,
-               data.vertices[1].x,
-               data.vertices[1].y,
-               data.vertices[1].z,
-               data.vertices[2].x,
-               data.vertices[2].y,
-               data.vertices[2].z);
+void FileWriter::write_triangles(const Span<PackedTriangle> data)
+{
+  tris_num_ += uint32_t(data.size());
+  if (!ascii_) {
+    fwrite(data.data(), sizeof(PackedTriangle), data.size(), file_);
+    return;
   }
-  else {
-    fwrite(&data, sizeof(data), 1, file_);
+  /* Formatting the numbers is the expensive part, do it in parallel and write the text of every
+   * group of triangles in order afterwards. */
+  constexpr int64_t group_size = 1024;
+  const int64_t groups_num = (data.size() + group_size - 1) / group_size;
+  Array<fmt::memory_buffer> buffers(groups_num);
+  threading::parallel_for(IndexRange(groups_num), 1, [&](const IndexRange range) {
+    for (const int64_t group : range) {
+      for (const PackedTriangle &tri : data.slice_safe(group * group_size, group_size)) {
+        format_triangle(buffers[group], tri);
+      }
+    }
+  });
+  for (const fmt::memory_buffer &buf : buffers) {
+    fwrite(buf.data(), 1, buf.size(), file_);
   }
 }
 
@@ -11,6 +11,8 @@
 #include <cstdint>
 #include <cstdio>
 
+#include "BLI_span.hh"
+
 namespace blender::io::stl {
 
 struct PackedTriangle;
@@ -20,6 +22,8 @@ class FileWriter {
   FileWriter(const char *filepath, bool ascii);
   ~FileWriter();
   void write_triangle(const PackedTriangle &data);
+  /** Write many triangles at once, formatting them in parallel for ASCII files. */
+  void write_triangles(Span<PackedTriangle> data);
 
  private:
   FILE *file_;
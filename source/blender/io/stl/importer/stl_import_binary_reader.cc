@@ -24,7 +24,8 @@ namespace blender::io::stl {
 
 Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
 {
-  const int chunk_size = 1024;
+  /* Large enough for the conversion of every chunk to be done in parallel. */
+  const int chunk_size = 1 << 16;
   uint32_t num_tris = 0;
   fseek(file, BINARY_HEADER_SIZE, SEEK_SET);
   if (fread(&num_tris, sizeof(uint32_t), 1, file) != 1) {
@@ -40,9 +41,7 @@ Mesh *read_stl_binary(FILE *file, const bool use_custom_normals)
   STLMeshHelper stl_mesh(num_tris, use_custom_normals);
   size_t num_read_tris;
   while ((num_read_tris = fread(tris_buf.data(), sizeof(PackedTriangle), chunk_size, file))) {
-    for (size_t i = 0; i < num_read_tris; i++) {
-      stl_mesh.add_triangle(tris_buf[i]);
-    }
+    stl_mesh.add_triangles(tris_buf.as_span().take_front(num_read_tris));
   }
 
   return stl_mesh.to_mesh();
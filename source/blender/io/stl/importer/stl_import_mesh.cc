@@ -6,10 +6,16 @@
  * \ingroup stl
  */
 
+#include <algorithm>
+
 #include "BKE_mesh.hh"
 
 #include "BLI_array_utils.hh"
+#include "BLI_hash.hh"
+#include "BLI_index_mask.hh"
+#include "BLI_map.hh"
 #include "BLI_span.hh"
+#include "BLI_task.hh"
 
 #include "DNA_mesh_types.h"
 
@@ -24,57 +30,182 @@ namespace blender::io::stl {
 STLMeshHelper::STLMeshHelper(int tris_num, bool use_custom_normals)
     : use_custom_normals_(use_custom_normals)
 {
-  degenerate_tris_num_ = 0;
-  duplicate_tris_num_ = 0;
-  tris_.reserve(tris_num);
-  /* Upper bound (all vertices are unique). */
-  verts_.reserve(tris_num * 3);
+  corner_positions_.reserve(int64_t(tris_num) * 3);
   if (use_custom_normals) {
-    loop_normals_.reserve(tris_num * 3);
+    tri_normals_.reserve(tris_num);
   }
 }
 
-bool STLMeshHelper::add_triangle(const PackedTriangle &data)
+void STLMeshHelper::add_triangle(const PackedTriangle &data)
 {
-  int v1_id = verts_.index_of_or_add(data.vertices[0]);
-  int v2_id = verts_.index_of_or_add(data.vertices[1]);
-  int v3_id = verts_.index_of_or_add(data.vertices[2]);
-  if ((v1_id == v2_id) || (v1_id == v3_id) || (v2_id == v3_id)) {
-    degenerate_tris_num_++;
-    return false;
-  }
-  if (!tris_.add({v1_id, v2_id, v3_id})) {
-    duplicate_tris_num_++;
-    return false;
+  corner_positions_.extend({data.vertices[0], data.vertices[1], data.vertices[2]});
+  if (use_custom_normals_) {
+    tri_normals_.append(data.normal);
   }
+}
 
+void STLMeshHelper::add_triangles(const Span<PackedTriangle> data)
+{
+  const int64_t corners_start = corner_positions_.size();
+  const int64_t tris_start = corners_start / 3;
+  corner_positions_.resize(corners_start + data.size() * 3);
   if (use_custom_normals_) {
-    loop_normals_.append_n_times(data.normal, 3);
+    tri_normals_.resize(tris_start + data.size());
+  }
+  threading::parallel_for(data.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const PackedTriangle &tri = data[i];
+      for (const int j : IndexRange(3)) {
+        corner_positions_[corners_start + i * 3 + j] = tri.vertices[j];
+      }
+      if (use_custom_normals_) {
+        tri_normals_[tris_start + i] = tri.normal;
+      }
+    }
+  });
+}
+
+/**
+ * Find the index of the first occurrence of every value. The values are partitioned by their
+ * hash so that the partitions can be processed in parallel with separate hash tables. The
+ * original order is kept within each partition, so the result is the same as when adding all
+ * values to a single hash table one by one.
+ */
+template<typename T>
+static void find_first_occurrences(const Span<T> values, MutableSpan<int> r_first)
+{
+  constexpr int partition_bits = 6;
+  constexpr int partitions_num = 1 << partition_bits;
+  constexpr int64_t chunk_size = 1 << 16;
+
+  Array<uint8_t> partitions(values.size());
+  threading::parallel_for(values.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      /* Use the high bits of a mixed hash, the low bits are used by the hash tables. */
+      const uint64_t hash = get_default_hash(values[i]) * 0x9E3779B97F4A7C15ull;
+      partitions[i] = uint8_t(hash >> (64 - partition_bits));
+    }
+  });
+
+  /* Count the values of every partition in each chunk, then turn the counts into the start of
+   * the chunk's values in the sorted indices. */
+  const int64_t chunks_num = (values.size() + chunk_size - 1) / chunk_size;
+  const auto chunk_range = [&](const int64_t chunk) {
+    return IndexRange::from_begin_end(chunk * chunk_size,
+                                      std::min((chunk + 1) * chunk_size, values.size()));
+  };
+  Array<int> chunk_offsets(chunks_num * partitions_num, 0);
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      MutableSpan<int> counts = chunk_offsets.as_mutable_span().slice(chunk * partitions_num,
+                                                                      partitions_num);
+      for (const int64_t i : chunk_range(chunk)) {
+        counts[partitions[i]]++;
+      }
+    }
+  });
+  Array<int> partition_offsets(partitions_num + 1);
+  int offset = 0;
+  for (const int partition : IndexRange(partitions_num)) {
+    partition_offsets[partition] = offset;
+    for (const int64_t chunk : IndexRange(chunks_num)) {
+      const int count = chunk_offsets[chunk * partitions_num + partition];
+      chunk_offsets[chunk * partitions_num + partition] = offset;
+      offset += count;
+    }
   }
-  return true;
+  partition_offsets.last() = offset;
+
+  Array<int> sorted_indices(values.size());
+  threading::parallel_for(IndexRange(chunks_num), 1, [&](const IndexRange range) {
+    for (const int64_t chunk : range) {
+      MutableSpan<int> offsets = chunk_offsets.as_mutable_span().slice(chunk * partitions_num,
+                                                                       partitions_num);
+      for (const int64_t i : chunk_range(chunk)) {
+        sorted_indices[offsets[partitions[i]]++] = int(i);
+      }
+    }
+  });
+
+  const OffsetIndices<int> partition_ranges(partition_offsets.as_span());
+  threading::parallel_for(IndexRange(partitions_num), 1, [&](const IndexRange range) {
+    for (const int partition : range) {
+      const Span<int> indices = sorted_indices.as_span().slice(partition_ranges[partition]);
+      Map<T, int> first_indices;
+      first_indices.reserve(indices.size());
+      for (const int i : indices) {
+        r_first[i] = first_indices.lookup_or_add(values[i], i);
+      }
+    }
+  });
 }
 
 Mesh *STLMeshHelper::to_mesh()
 {
-  if (degenerate_tris_num_ > 0) {
-    CLOG_WARN(&LOG, "Removed %d degenerate triangles during import", degenerate_tris_num_);
+  const int64_t corners_num = corner_positions_.size();
+  const int64_t tris_num = corners_num / 3;
+
+  /* Merge vertices with the same position. Vertices are ordered by their first use. */
+  Array<int> corner_verts(corners_num);
+  find_first_occurrences(corner_positions_.as_span(), corner_verts);
+  IndexMaskMemory memory;
+  const IndexMask unique_corners = IndexMask::from_predicate(
+      IndexRange(corners_num), GrainSize(4096), memory, [&](const int64_t i) {
+        return corner_verts[i] == i;
+      });
+  Array<int> vert_indices(corners_num);
+  unique_corners.foreach_index(GrainSize(4096), [&](const int64_t corner, const int64_t vert) {
+    vert_indices[corner] = int(vert);
+  });
+  threading::parallel_for(corner_verts.index_range(), 4096, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      corner_verts[i] = vert_indices[corner_verts[i]];
+    }
+  });
+
+  /* Remove degenerate and duplicate triangles, keeping the first of duplicates. Degenerate
+   * triangles are never equal to valid ones, so they don't affect which duplicate is kept. */
+  const Span<Triangle> tris = corner_verts.as_span().cast<Triangle>();
+  const IndexMask degenerate_tris = IndexMask::from_predicate(
+      tris.index_range(), GrainSize(4096), memory, [&](const int64_t i) {
+        const Triangle &tri = tris[i];
+        return tri.v1 == tri.v2 || tri.v1 == tri.v3 || tri.v2 == tri.v3;
+      });
+  Array<int> first_tris(tris_num);
+  find_first_occurrences(tris, first_tris);
+  const IndexMask unique_tris = IndexMask::from_predicate(
+      tris.index_range(), GrainSize(4096), memory, [&](const int64_t i) {
+        return first_tris[i] == i;
+      });
+  const IndexMask kept_tris = IndexMask::from_difference(unique_tris, degenerate_tris, memory);
+
+  const int64_t degenerate_tris_num = degenerate_tris.size();
+  const int64_t duplicate_tris_num = tris_num - degenerate_tris_num - kept_tris.size();
+  if (degenerate_tris_num > 0) {
+    CLOG_WARN(&LOG, "Removed %d degenerate triangles during import", int(degenerate_tris_num));
   }
-  if (duplicate_tris_num_ > 0) {
-    CLOG_WARN(&LOG, "Removed %d duplicate triangles during import", duplicate_tris_num_);
+  if (duplicate_tris_num > 0) {
+    CLOG_WARN(&LOG, "Removed %d duplicate triangles during import", int(duplicate_tris_num));
   }
 
-  Mesh *mesh = BKE_mesh_new_nomain(verts_.size(), 0, tris_.size(), tris_.size() * 3);
-  mesh->vert_positions_for_write().copy_from(verts_);
+  Mesh *mesh = BKE_mesh_new_nomain(
+      unique_corners.size(), 0, kept_tris.size(), kept_tris.size() * 3);
+  array_utils::gather(
+      corner_positions_.as_span(), unique_corners, mesh->vert_positions_for_write());
   offset_indices::fill_constant_group_size(3, 0, mesh->face_offsets_for_write());
-  array_utils::copy(tris_.as_span().cast<int>(), mesh->corner_verts_for_write());
+  array_utils::gather(tris, kept_tris, mesh->corner_verts_for_write().cast<Triangle>());
 
   bke::mesh_smooth_set(*mesh, false);
 
   /* NOTE: edges must be calculated first before setting custom normals. */
   bke::mesh_calc_edges(*mesh, false, false);
 
-  if (use_custom_normals_ && loop_normals_.size() == mesh->corners_num) {
-    bke::mesh_set_custom_normals(*mesh, loop_normals_);
+  if (use_custom_normals_ && tri_normals_.size() == tris_num) {
+    Array<float3> corner_normals(mesh->corners_num);
+    kept_tris.foreach_index(GrainSize(4096), [&](const int64_t tri, const int64_t face) {
+      corner_normals.as_mutable_span().slice(face * 3, 3).fill(tri_normals_[tri]);
+    });
+    bke::mesh_set_custom_normals(*mesh, corner_normals);
   }
 
   return mesh;
@@ -20,10 +20,13 @@
 #include "BKE_object.hh"
 #include "BKE_report.hh"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_matrix.h"
 #include "BLI_path_utils.hh"
 #include "BLI_string.h"
+#include "BLI_task.hh"
 #include "BLI_timeit.hh"
 
 #include "BLT_translation.hh"
@@ -48,6 +51,8 @@
 #include "WM_api.hh"
 #include "WM_types.hh"
 
+#include <algorithm>
+
 #include <pxr/usd/usd/stage.h>
 #include <pxr/usd/usdGeom/metrics.h>
 
@@ -121,6 +126,47 @@ static void report_job_duration(const ImportJobData *data)
   fmt::print("\n");
 }
 
+/** Print the time spent reading the object data of each type of prim. */
+static void report_prim_type_durations(const Span<USDPrimReader *> readers,
+                                       const Span<timeit::Nanoseconds> threaded_durations,
+                                       const Span<timeit::Nanoseconds> serial_durations)
+{
+  struct PrimTypeDurations {
+    int64_t prims_num = 0;
+    timeit::Nanoseconds threaded{0};
+    timeit::Nanoseconds serial{0};
+  };
+  Map<std::string, PrimTypeDurations> durations_by_type;
+  for (const int64_t i : readers.index_range()) {
+    if (const USDPrimReader *reader = readers[i]) {
+      PrimTypeDurations &durations = durations_by_type.lookup_or_add_default(
+          reader->prim().GetTypeName().GetString());
+      durations.prims_num++;
+      durations.threaded += threaded_durations[i];
+      durations.serial += serial_durations[i];
+    }
+  }
+
+  Vector<std::pair<std::string, PrimTypeDurations>> sorted_durations;
+  for (const auto item : durations_by_type.items()) {
+    sorted_durations.append({item.key, item.value});
+  }
+  std::sort(sorted_durations.begin(), sorted_durations.end(), [](const auto &a, const auto &b) {
+    return a.second.threaded + a.second.serial > b.second.threaded + b.second.serial;
+  });
+
+  fmt::print("USD import object data read times by prim type:\n");
+  for (const auto &[type_name, durations] : sorted_durations) {
+    fmt::print("  {} ({} prims): ",
+               type_name.empty() ? StringRef("Untyped") : StringRef(type_name),
+               durations.prims_num);
+    timeit::print_duration(durations.threaded);
+    fmt::print(" in parallel, ");
+    timeit::print_duration(durations.serial);
+    fmt::print(" serially\n");
+  }
+}
+
 static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
 {
   ImportJobData *data = static_cast<ImportJobData *>(customdata);
@@ -270,15 +316,47 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     }
   }
 
-  /* Setup parenthood and read actual object data. */
+  /* Read the object data that doesn't need to access Main in parallel, in batches to be able to
+   * report progress and cancel. */
+  const Span<USDPrimReader *> readers = archive->readers();
+  Array<timeit::Nanoseconds> threaded_durations(readers.size(), timeit::Nanoseconds(0));
+  Array<timeit::Nanoseconds> serial_durations(readers.size(), timeit::Nanoseconds(0));
+  constexpr int64_t threaded_batch_size = 1024;
+  for (int64_t batch_start = 0; batch_start < readers.size(); batch_start += threaded_batch_size)
+  {
+    const IndexRange batch(batch_start,
+                           std::min(threaded_batch_size, readers.size() - batch_start));
+    threading::parallel_for(batch, 1, [&](const IndexRange range) {
+      for (const int64_t reader_index : range) {
+        if (USDPrimReader *reader = readers[reader_index]) {
+          const timeit::TimePoint start = timeit::Clock::now();
+          reader->read_object_data_threaded(0.0);
+          threaded_durations[reader_index] = timeit::Clock::now() - start;
+        }
+      }
+    });
+
+    *data->progress = 0.5f + 0.25f * (batch.one_after_last() / size);
+    *data->do_update = true;
+
+    if (G.is_break) {
+      data->was_canceled = true;
+      return;
+    }
+  }
+
+  /* Setup parenthood and read the rest of the object data. */
   i = 0;
-  for (USDPrimReader *reader : archive->readers()) {
+  for (const int64_t reader_index : readers.index_range()) {
+    USDPrimReader *reader = readers[reader_index];
     if (!reader) {
       continue;
     }
 
     Object *ob = reader->object();
+    const timeit::TimePoint start = timeit::Clock::now();
     reader->read_object_data(data->bmain, 0.0);
+    serial_durations[reader_index] = timeit::Clock::now() - start;
 
     USDPrimReader *parent = reader->parent();
     if (parent == nullptr) {
@@ -288,7 +366,7 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
       ob->parent = parent->object();
     }
 
-    *data->progress = 0.5f + 0.5f * (++i / size);
+    *data->progress = 0.75f + 0.25f * (++i / size);
     *data->do_update = true;
 
     if (G.is_break) {
@@ -297,6 +375,8 @@ static void import_startjob(void *customdata, wmJobWorkerStatus *worker_status)
     }
   }
 
+  report_prim_type_durations(readers, threaded_durations, serial_durations);
+
   if (data->params.import_skeletons) {
     archive->process_armature_modifiers();
   }
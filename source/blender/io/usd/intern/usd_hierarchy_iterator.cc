@@ -133,8 +133,15 @@ USDExporterContext USDHierarchyIterator::create_usd_export_context(const Hierarc
   const std::string export_file_path = root_layer->GetRealPath();
   auto get_time_code = [this]() { return this->export_time_; };
 
-  return USDExporterContext{
-      bmain_, depsgraph_, stage_, path, get_time_code, params_, export_file_path};
+  return USDExporterContext{bmain_,
+                            depsgraph_,
+                            stage_,
+                            path,
+                            get_time_code,
+                            params_,
+                            export_file_path,
+                            nullptr,
+                            &mesh_prototypes_};
 }
 
 AbstractHierarchyWriter *USDHierarchyIterator::create_transform_writer(
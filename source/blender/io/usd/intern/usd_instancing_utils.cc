@@ -8,8 +8,19 @@
 #include "usd_hash_types.hh"
 #include "usd_utils.hh"
 
+#include "BLI_hash.hh"
+#include "BLI_hash_mm2a.hh"
 #include "BLI_map.hh"
 #include "BLI_set.hh"
+#include "BLI_string.h"
+#include "BLI_task.hh"
+
+#include "BKE_customdata.hh"
+#include "BKE_lib_id.hh"
+#include "BKE_mesh.h"
+#include "BKE_mesh.hh"
+
+#include "DNA_mesh_types.h"
 
 #include <pxr/usd/sdf/copyUtils.h>
 #include <pxr/usd/sdf/path.h>
@@ -17,6 +28,7 @@
 #include <pxr/usd/usd/primRange.h>
 #include <pxr/usd/usd/references.h>
 
+#include <cstring>
 #include <string>
 
 #include "CLG_log.h"
@@ -185,4 +197,115 @@ void process_scene_graph_instances(const USDExportParams &export_params, pxr::Us
   }
 }
 
+bool operator==(const MeshPrototypeSettings &a, const MeshPrototypeSettings &b)
+{
+  return a.materials == b.materials && a.subdiv_type == b.subdiv_type &&
+         a.uv_smooth == b.uv_smooth && a.boundary_smooth == b.boundary_smooth;
+}
+
+MeshPrototypes::~MeshPrototypes()
+{
+  for (const Vector<Prototype> &prototypes : prototypes_.values()) {
+    for (const Prototype &prototype : prototypes) {
+      BKE_id_free(nullptr, prototype.mesh);
+    }
+  }
+}
+
+template<typename T> static uint32_t hash_span(const Span<T> span)
+{
+  return BLI_hash_mm2(reinterpret_cast<const uchar *>(span.data()), span.size_in_bytes(), 0);
+}
+
+uint64_t MeshPrototypes::hash_mesh(const Mesh &mesh)
+{
+  /* Only hash the arrays that are always written, other attributes are only compared when the
+   * hashes match. */
+  uint32_t positions_hash = 0;
+  uint32_t corner_verts_hash = 0;
+  uint32_t face_offsets_hash = 0;
+  threading::parallel_invoke(
+      mesh.verts_num > 4096,
+      [&]() { positions_hash = hash_span(mesh.vert_positions()); },
+      [&]() { corner_verts_hash = hash_span(mesh.corner_verts()); },
+      [&]() { face_offsets_hash = hash_span(mesh.face_offsets()); });
+  return get_default_hash(get_default_hash(mesh.verts_num, mesh.faces_num, mesh.corners_num),
+                          positions_hash,
+                          corner_verts_hash,
+                          face_offsets_hash);
+}
+
+static bool custom_data_equal(const CustomData &a, const CustomData &b, const int size)
+{
+  if (a.totlayer != b.totlayer) {
+    return false;
+  }
+  for (const int i : IndexRange(a.totlayer)) {
+    const CustomDataLayer &layer_a = a.layers[i];
+    const CustomDataLayer &layer_b = b.layers[i];
+    if (layer_a.type != layer_b.type || layer_a.active_rnd != layer_b.active_rnd ||
+        !STREQ(layer_a.name, layer_b.name))
+    {
+      return false;
+    }
+    if (layer_a.data == layer_b.data) {
+      /* Both meshes share the same array, which is common for linked duplicates. */
+      continue;
+    }
+    if (layer_a.data == nullptr || layer_b.data == nullptr) {
+      return false;
+    }
+    /* Types that store pointers never compare equal this way, which only means that their data
+     * is not shared. */
+    const size_t elem_size = CustomData_sizeof(eCustomDataType(layer_a.type));
+    if (memcmp(layer_a.data, layer_b.data, elem_size * size_t(size)) != 0) {
+      return false;
+    }
+  }
+  return true;
+}
+
+static bool meshes_equal(const Mesh &a, const Mesh &b)
+{
+  if (a.verts_num != b.verts_num || a.edges_num != b.edges_num || a.faces_num != b.faces_num ||
+      a.corners_num != b.corners_num)
+  {
+    return false;
+  }
+  const Span<int> face_offsets_a = a.face_offsets();
+  const Span<int> face_offsets_b = b.face_offsets();
+  if (face_offsets_a.data() != face_offsets_b.data() && face_offsets_a != face_offsets_b) {
+    return false;
+  }
+  return custom_data_equal(a.vert_data, b.vert_data, a.verts_num) &&
+         custom_data_equal(a.edge_data, b.edge_data, a.edges_num) &&
+         custom_data_equal(a.face_data, b.face_data, a.faces_num) &&
+         custom_data_equal(a.corner_data, b.corner_data, a.corners_num);
+}
+
+std::optional<pxr::SdfPath> MeshPrototypes::lookup(const uint64_t hash,
+                                                   const Mesh &mesh,
+                                                   const MeshPrototypeSettings &settings) const
+{
+  const Vector<Prototype> *prototypes = prototypes_.lookup_ptr(hash);
+  if (!prototypes) {
+    return std::nullopt;
+  }
+  for (const Prototype &prototype : *prototypes) {
+    if (prototype.settings == settings && meshes_equal(*prototype.mesh, mesh)) {
+      return prototype.path;
+    }
+  }
+  return std::nullopt;
+}
+
+void MeshPrototypes::add(const uint64_t hash,
+                         const Mesh &mesh,
+                         MeshPrototypeSettings settings,
+                         const pxr::SdfPath &path)
+{
+  prototypes_.lookup_or_add_default(hash).append(
+      {BKE_mesh_copy_for_eval(mesh), std::move(settings), path});
+}
+
 }  // namespace blender::io::usd
@@ -3,12 +3,70 @@
  * SPDX-License-Identifier: GPL-2.0-or-later */
 #pragma once
 
+#include "BLI_map.hh"
+#include "BLI_span.hh"
+#include "BLI_vector.hh"
+
+#include <pxr/usd/sdf/path.h>
 #include <pxr/usd/usd/common.h>
 
+#include <optional>
+
+struct Material;
+struct Mesh;
+
 namespace blender::io::usd {
 
 struct USDExportParams;
 
+/**
+ * Settings besides the mesh itself that affect the data written to a mesh prim. Two prims can
+ * only share their data when these match too.
+ */
+struct MeshPrototypeSettings {
+  Vector<const Material *> materials;
+  int subdiv_type = -1;
+  int uv_smooth = 0;
+  int boundary_smooth = 0;
+
+  friend bool operator==(const MeshPrototypeSettings &a, const MeshPrototypeSettings &b);
+};
+
+/**
+ * Mesh prims written to the stage, so that other objects with identical mesh data can reference
+ * the first prim as an instanceable prototype instead of writing the same arrays again. Meshes are
+ * compared by their contents, which also finds duplicates that don't share the same mesh
+ * data-block, e.g. after applying modifiers or appending the same asset several times.
+ */
+class MeshPrototypes {
+  struct Prototype {
+    /** Copy of the exported mesh. It shares the arrays with the original mesh where possible. */
+    Mesh *mesh;
+    MeshPrototypeSettings settings;
+    pxr::SdfPath path;
+  };
+
+  Map<uint64_t, Vector<Prototype>> prototypes_;
+
+ public:
+  MeshPrototypes() = default;
+  MeshPrototypes(const MeshPrototypes &other) = delete;
+  MeshPrototypes &operator=(const MeshPrototypes &other) = delete;
+  ~MeshPrototypes();
+
+  /** Hash of the data of a mesh which is relevant for the export, see #lookup and #add. */
+  static uint64_t hash_mesh(const Mesh &mesh);
+
+  /** \return The path of a prim that was written with exactly the same data. */
+  std::optional<pxr::SdfPath> lookup(uint64_t hash,
+                                     const Mesh &mesh,
+                                     const MeshPrototypeSettings &settings) const;
+  void add(uint64_t hash,
+           const Mesh &mesh,
+           MeshPrototypeSettings settings,
+           const pxr::SdfPath &path);
+};
+
 /**
  * This function processes the USD stage generated by the USD hierarchy iterator to
  * change scene graph instancing prototypes from defined USD prims to abstract prims.
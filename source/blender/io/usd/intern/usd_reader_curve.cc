@@ -138,10 +138,20 @@ void USDCurvesReader::create_object(Main *bmain)
   object_->data = curve;
 }
 
-void USDCurvesReader::read_object_data(Main *bmain, double motionSampleTime)
+void USDCurvesReader::read_object_data_threaded(const double motionSampleTime)
 {
   Curves *cu = (Curves *)object_->data;
   this->read_curve_sample(cu, motionSampleTime);
+  threaded_curves_read_ = true;
+}
+
+void USDCurvesReader::read_object_data(Main *bmain, double motionSampleTime)
+{
+  Curves *cu = (Curves *)object_->data;
+  if (!threaded_curves_read_) {
+    this->read_curve_sample(cu, motionSampleTime);
+  }
+  threaded_curves_read_ = false;
 
   if (this->is_animated()) {
     this->add_cache_modifier();
@@ -23,6 +23,10 @@ class CurvesGeometry;
 namespace blender::io::usd {
 
 class USDCurvesReader : public USDGeomReader {
+ private:
+  /** The curves were read into the object data by #read_object_data_threaded. */
+  bool threaded_curves_read_ = false;
+
  public:
   USDCurvesReader(const pxr::UsdPrim &prim,
                   const USDImportParams &import_params,
@@ -32,6 +36,7 @@ class USDCurvesReader : public USDGeomReader {
   }
 
   void create_object(Main *bmain) override;
+  void read_object_data_threaded(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   void read_geometry(bke::GeometrySet &geometry_set,
@@ -17,6 +17,7 @@
 #include "BKE_attribute.hh"
 #include "BKE_customdata.hh"
 #include "BKE_geometry_set.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_main.hh"
 #include "BKE_material.hh"
 #include "BKE_mesh.hh"
@@ -175,7 +176,14 @@ void USDMeshReader::create_object(Main *bmain)
   object_->data = mesh;
 }
 
-void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+USDMeshReader::~USDMeshReader()
+{
+  if (threaded_mesh_) {
+    BKE_id_free(nullptr, threaded_mesh_);
+  }
+}
+
+Mesh *USDMeshReader::read_initial_mesh(const double motionSampleTime)
 {
   Mesh *mesh = (Mesh *)object_->data;
 
@@ -186,6 +194,32 @@ void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
   Mesh *read_mesh = this->read_mesh(mesh, params, nullptr);
 
   is_initial_load_ = false;
+  return read_mesh;
+}
+
+void USDMeshReader::read_object_data_threaded(const double motionSampleTime)
+{
+  Mesh *read_mesh = read_initial_mesh(motionSampleTime);
+  if (read_mesh != object_->data) {
+    threaded_mesh_ = read_mesh;
+  }
+  threaded_mesh_read_ = true;
+}
+
+void USDMeshReader::read_object_data(Main *bmain, const double motionSampleTime)
+{
+  Mesh *mesh = (Mesh *)object_->data;
+
+  Mesh *read_mesh;
+  if (threaded_mesh_read_) {
+    read_mesh = threaded_mesh_ ? threaded_mesh_ : mesh;
+    threaded_mesh_ = nullptr;
+    threaded_mesh_read_ = false;
+  }
+  else {
+    read_mesh = read_initial_mesh(motionSampleTime);
+  }
+
   if (read_mesh != mesh) {
     BKE_mesh_nomain_to_mesh(read_mesh, mesh, object_);
   }
@@ -39,6 +39,10 @@ class USDMeshReader : public USDGeomReader {
    * implemented.  Note this will break if faces or positions vary. */
   bool is_initial_load_ = false;
 
+  /** Mesh read by #read_object_data_threaded, when it is not the object data itself. */
+  Mesh *threaded_mesh_ = nullptr;
+  bool threaded_mesh_read_ = false;
+
  public:
   USDMeshReader(const pxr::UsdPrim &prim,
                 const USDImportParams &import_params,
@@ -46,6 +50,7 @@ class USDMeshReader : public USDGeomReader {
       : USDGeomReader(prim, import_params, settings), mesh_prim_(prim)
   {
   }
+  ~USDMeshReader() override;
 
   bool valid() const override
   {
@@ -53,6 +58,7 @@ class USDMeshReader : public USDGeomReader {
   }
 
   void create_object(Main *bmain) override;
+  void read_object_data_threaded(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   void read_geometry(bke::GeometrySet &geometry_set,
@@ -76,6 +82,7 @@ class USDMeshReader : public USDGeomReader {
   void process_normals_face_varying(Mesh *mesh) const;
   /** Set USD uniform (per-face) normals as Blender loop normals. */
   void process_normals_uniform(Mesh *mesh) const;
+  Mesh *read_initial_mesh(double motionSampleTime);
   void readFaceSetsSample(Main *bmain, Mesh *mesh, double motionSampleTime);
   void assign_facesets_to_material_indices(double motionSampleTime,
                                            MutableSpan<int> material_indices,
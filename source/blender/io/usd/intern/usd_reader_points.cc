@@ -6,6 +6,7 @@
 #include "usd_attribute_utils.hh"
 
 #include "BKE_geometry_set.hh"
+#include "BKE_lib_id.hh"
 #include "BKE_object.hh"
 #include "BKE_pointcloud.hh"
 
@@ -26,7 +27,14 @@ void USDPointsReader::create_object(Main *bmain)
   object_->data = pointcloud;
 }
 
-void USDPointsReader::read_object_data(Main *bmain, double motionSampleTime)
+USDPointsReader::~USDPointsReader()
+{
+  if (threaded_pointcloud_) {
+    BKE_id_free(nullptr, threaded_pointcloud_);
+  }
+}
+
+PointCloud *USDPointsReader::read_initial_pointcloud(const double motionSampleTime)
 {
   const USDMeshReadParams params = create_mesh_read_params(motionSampleTime,
                                                            import_params_.mesh_read_flag);
@@ -38,8 +46,31 @@ void USDPointsReader::read_object_data(Main *bmain, double motionSampleTime)
 
   read_geometry(geometry_set, params, nullptr);
 
-  PointCloud *read_pointcloud =
-      geometry_set.get_component_for_write<bke::PointCloudComponent>().release();
+  return geometry_set.get_component_for_write<bke::PointCloudComponent>().release();
+}
+
+void USDPointsReader::read_object_data_threaded(const double motionSampleTime)
+{
+  PointCloud *read_pointcloud = read_initial_pointcloud(motionSampleTime);
+  if (read_pointcloud != object_->data) {
+    threaded_pointcloud_ = read_pointcloud;
+  }
+  threaded_pointcloud_read_ = true;
+}
+
+void USDPointsReader::read_object_data(Main *bmain, double motionSampleTime)
+{
+  PointCloud *pointcloud = static_cast<PointCloud *>(object_->data);
+
+  PointCloud *read_pointcloud;
+  if (threaded_pointcloud_read_) {
+    read_pointcloud = threaded_pointcloud_ ? threaded_pointcloud_ : pointcloud;
+    threaded_pointcloud_ = nullptr;
+    threaded_pointcloud_read_ = false;
+  }
+  else {
+    read_pointcloud = read_initial_pointcloud(motionSampleTime);
+  }
 
   if (read_pointcloud != pointcloud) {
     BKE_pointcloud_nomain_to_pointcloud(read_pointcloud, pointcloud);
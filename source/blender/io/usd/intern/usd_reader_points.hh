@@ -20,6 +20,10 @@ class USDPointsReader : public USDGeomReader {
  private:
   pxr::UsdGeomPoints points_prim_;
 
+  /** Point cloud read by #read_object_data_threaded, when it is not the object data itself. */
+  PointCloud *threaded_pointcloud_ = nullptr;
+  bool threaded_pointcloud_read_ = false;
+
  public:
   USDPointsReader(const pxr::UsdPrim &prim,
                   const USDImportParams &import_params,
@@ -27,6 +31,7 @@ class USDPointsReader : public USDGeomReader {
       : USDGeomReader(prim, import_params, settings), points_prim_(prim)
   {
   }
+  ~USDPointsReader() override;
 
   bool valid() const override
   {
@@ -37,6 +42,7 @@ class USDPointsReader : public USDGeomReader {
   void create_object(Main *bmain) override;
 
   /* Initial point cloud data update. */
+  void read_object_data_threaded(double motionSampleTime) override;
   void read_object_data(Main *bmain, double motionSampleTime) override;
 
   /* Implement point cloud update. This may be called by the cache modifier
@@ -50,6 +56,9 @@ class USDPointsReader : public USDGeomReader {
 
   /* Return true if the USD data may be time varying. */
   bool is_animated() const;
+
+ private:
+  PointCloud *read_initial_pointcloud(double motionSampleTime);
 };
 
 }  // namespace blender::io::usd
@@ -94,6 +94,12 @@ class USDPrimReader {
   virtual bool valid() const;
 
   virtual void create_object(Main *bmain) = 0;
+  /**
+   * Read the part of the object data that only modifies data owned by this reader, without
+   * accessing #Main. On import this is called for many readers in parallel, after #create_object
+   * and before #read_object_data, which then reads the rest of the data.
+   */
+  virtual void read_object_data_threaded(double /*motionSampleTime*/) {}
   virtual void read_object_data(Main * /*bmain*/, double /*motionSampleTime*/){};
 
   Object *object() const;
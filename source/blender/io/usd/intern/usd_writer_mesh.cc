@@ -6,6 +6,7 @@
 #include "usd_armature_utils.hh"
 #include "usd_attribute_utils.hh"
 #include "usd_blend_shape_utils.hh"
+#include "usd_instancing_utils.hh"
 #include "usd_skel_convert.hh"
 #include "usd_utils.hh"
 
@@ -287,6 +288,66 @@ void USDGenericMeshWriter::free_export_mesh(Mesh *mesh)
   BKE_id_free(nullptr, mesh);
 }
 
+bool USDGenericMeshWriter::can_share_mesh_data() const
+{
+  return true;
+}
+
+bool USDGenericMeshWriter::reference_mesh_prototype(const HierarchyContext &context,
+                                                    const Mesh &mesh,
+                                                    const SubsurfModifierData *subsurfData,
+                                                    const pxr::UsdGeomMesh &usd_mesh)
+{
+  const USDExportParams &params = usd_export_context_.export_params;
+  MeshPrototypes *mesh_prototypes = usd_export_context_.mesh_prototypes;
+  if (mesh_prototypes == nullptr || !params.use_instancing) {
+    return false;
+  }
+  /* Animated meshes write different data for every frame. Prototypes and instances of duplis are
+   * already handled by the hierarchy iterator. With merged transforms, the mesh prim also holds
+   * the transform of its object, which must not be shared. */
+  if (is_animated_ || frame_has_been_written_ || context.is_prototype() || context.is_instance() ||
+      params.merge_parent_xform || !can_share_mesh_data())
+  {
+    return false;
+  }
+  if (params.export_custom_properties && mesh.id.properties) {
+    /* The custom properties of the mesh would be inherited by the other instances. */
+    return false;
+  }
+
+  MeshPrototypeSettings settings;
+  if (params.export_materials) {
+    for (const int i : IndexRange(context.object->totcol)) {
+      settings.materials.append(BKE_object_material_get(context.object, i + 1));
+    }
+  }
+  if (subsurfData) {
+    settings.subdiv_type = subsurfData->subdivType;
+    settings.uv_smooth = subsurfData->uv_smooth;
+    settings.boundary_smooth = subsurfData->boundary_smooth;
+  }
+
+  const uint64_t hash = MeshPrototypes::hash_mesh(mesh);
+  const std::optional<pxr::SdfPath> prototype_path = mesh_prototypes->lookup(
+      hash, mesh, settings);
+  if (!prototype_path) {
+    mesh_prototypes->add(hash, mesh, std::move(settings), usd_export_context_.usd_path);
+    return false;
+  }
+
+  pxr::UsdPrim prim = usd_mesh.GetPrim();
+  if (!prim.GetReferences().AddInternalReference(*prototype_path)) {
+    CLOG_WARN(&LOG,
+              "Unable to add reference from %s to %s, writing the mesh data instead",
+              usd_export_context_.usd_path.GetAsString().c_str(),
+              prototype_path->GetAsString().c_str());
+    return false;
+  }
+  prim.SetInstanceable(true);
+  return true;
+}
+
 struct USDMeshData {
   pxr::VtArray<pxr::GfVec3f> points;
   pxr::VtIntArray face_vertex_counts;
@@ -327,9 +388,14 @@ void USDGenericMeshWriter::write_mesh(HierarchyContext &context,
   pxr::UsdGeomMesh usd_mesh = pxr::UsdGeomMesh::Define(stage, usd_path);
   write_visibility(context, timecode, usd_mesh);
 
-  USDMeshData usd_mesh_data;
   /* Ensure data exists if currently in edit mode. */
   BKE_mesh_wrapper_ensure_mdata(mesh);
+
+  if (reference_mesh_prototype(context, *mesh, subsurfData, usd_mesh)) {
+    return;
+  }
+
+  USDMeshData usd_mesh_data;
   get_geometry_data(mesh, usd_mesh_data);
 
   pxr::UsdAttribute attr_points = usd_mesh.CreatePointsAttr(pxr::VtValue(), true);
@@ -863,6 +929,12 @@ Mesh *USDMeshWriter::get_export_mesh(Object *object_eval, bool &r_needsfree)
   return BKE_object_get_evaluated_mesh(object_eval);
 }
 
+bool USDMeshWriter::can_share_mesh_data() const
+{
+  /* Skinning and blend shapes are bound to the object's armature and shape keys. */
+  return !write_skinned_mesh_ && !write_blend_shapes_;
+}
+
 void USDMeshWriter::add_shape_key_weights_sample(const Object *obj)
 {
   if (!obj) {
@@ -34,8 +34,25 @@ class USDGenericMeshWriter : public USDAbstractWriter {
   virtual Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) = 0;
   virtual void free_export_mesh(Mesh *mesh);
 
+  /**
+   * Whether everything written to the mesh prim only depends on the mesh and its materials, so
+   * that the prim can be shared by objects with identical meshes.
+   */
+  virtual bool can_share_mesh_data() const;
+
  private:
   void write_mesh(HierarchyContext &context, Mesh *mesh, const SubsurfModifierData *subsurfData);
+  /**
+   * When instancing, turn `usd_mesh` into an instance of the prim of an identical mesh that was
+   * exported before, instead of writing the same data again. Otherwise remember the mesh, so that
+   * later objects can reference this prim.
+   *
+   * \return True when the prim references existing mesh data and nothing else has to be written.
+   */
+  bool reference_mesh_prototype(const HierarchyContext &context,
+                                const Mesh &mesh,
+                                const SubsurfModifierData *subsurfData,
+                                const pxr::UsdGeomMesh &usd_mesh);
   pxr::TfToken get_subdiv_scheme(const SubsurfModifierData *subsurfData);
   void write_subdiv(const pxr::TfToken &subdiv_scheme,
                     const pxr::UsdGeomMesh &usd_mesh,
@@ -67,6 +84,7 @@ class USDMeshWriter : public USDGenericMeshWriter {
   void do_write(HierarchyContext &context) override;
 
   Mesh *get_export_mesh(Object *object_eval, bool &r_needsfree) override;
+  bool can_share_mesh_data() const override;
 
   /**
    * Determine whether we should write skinned mesh or blend shape data
@@ -58,6 +58,12 @@ class FormatHandler : NonCopyable, NonMovable {
     return blocks_.size();
   }
 
+  /* Move the contents of the buffer(s) out, and clear the buffers. */
+  Vector<VectorChar> take_blocks()
+  {
+    return std::move(blocks_);
+  }
+
   void append_from(FormatHandler &v)
   {
     blocks_.insert(blocks_.end(),
@@ -27,6 +27,8 @@
 
 #include "ED_object.hh"
 
+#include "IO_ordered_file_writer.hh"
+
 #include "obj_export_mesh.hh"
 #include "obj_export_nurbs.hh"
 #include "obj_exporter.hh"
@@ -161,9 +163,8 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
 {
   /* Parallelization is over meshes/objects, which means
    * we have to have the output text buffer for each object,
-   * and write them all into the file at the end. */
+   * and write them into the file in order. */
   size_t count = exportable_as_mesh.size();
-  Array<FormatHandler> buffers(count);
 
   /* Serial: gather material indices, ensure normals & edges. */
   Vector<Vector<int>> mtlindices;
@@ -206,11 +207,14 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
     offsets.normal_offset += obj.get_normal_coords().size();
   }
 
-  /* Parallel over meshes: main result writing. */
+  /* Parallel over meshes: main result writing. The text of every object is written to the file
+   * from a separate thread, as soon as the objects before it are done too. */
+  OrderedFileWriter file_writer(obj_writer.get_outfile());
+  const IndexRange block_indices = file_writer.reserve(count);
   threading::parallel_for(IndexRange(count), 1, [&](IndexRange range) {
     for (const int i : range) {
       OBJMesh &obj = *exportable_as_mesh[i];
-      auto &fh = buffers[i];
+      FormatHandler fh;
 
       obj_writer.write_object_name(fh, obj);
       obj_writer.write_vertex_coords(fh, obj, export_params.export_colors);
@@ -244,14 +248,10 @@ static void write_mesh_objects(const Span<std::unique_ptr<OBJMesh>> exportable_a
       /* Nothing will need this object's data after this point, release
        * various arrays here. */
       obj.clear();
+      file_writer.submit(block_indices[i], fh.take_blocks());
     }
   });
-
-  /* Write all the object text buffers into the output file. */
-  FILE *f = obj_writer.get_outfile();
-  for (auto &b : buffers) {
-    b.write_to_file(f);
-  }
+  file_writer.finish();
 }
 
 /**
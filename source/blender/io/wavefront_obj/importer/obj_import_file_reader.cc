@@ -12,8 +12,10 @@
 #include "BLI_map.hh"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
+#include "BLI_mmap.h"
 #include "BLI_string.h"
 #include "BLI_string_ref.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "IO_string_utils.hh"
@@ -74,31 +76,47 @@ static Geometry *create_geometry(Geometry *const prev_geometry,
   return new_geometry();
 }
 
-static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+/**
+ * Parse a vertex position, and the color or weight that may follow it. The color components are
+ * negative when there are none.
+ */
+static void parse_vertex(const char *p, const char *end, float3 &r_vert, float3 &r_srgb)
 {
-  r_global_vertices.flush_mrgb_block();
-  float3 vert;
-  p = parse_floats(p, end, 0.0f, vert, 3);
-  r_global_vertices.vertices.append(vert);
+  p = parse_floats(p, end, 0.0f, r_vert, 3);
+  r_srgb = float3(-1.0f);
   /* OBJ extension: `xyzrgb` vertex colors, when the vertex position
    * is followed by 3 more RGB color components. See
    * http://paulbourke.net/dataformats/obj/colour.html */
   if (p < end) {
-    float3 srgb;
-    p = parse_floats(p, end, -1.0f, srgb, 3);
-    if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
-      float3 linear;
-      srgb_to_linearrgb_v3_v3(linear, srgb);
-      r_global_vertices.set_vertex_color(r_global_vertices.vertices.size() - 1, linear);
-    }
-    else if (srgb.x > 0) {
-      /* Treats value in srgb.x as weight. */
-      r_global_vertices.set_vertex_weight(r_global_vertices.vertices.size() - 1, srgb.x);
-    }
+    p = parse_floats(p, end, -1.0f, r_srgb, 3);
   }
   UNUSED_VARS(p);
 }
 
+static void geom_set_vertex_color_or_weight(const int64_t index,
+                                            const float3 &srgb,
+                                            GlobalVertices &r_global_vertices)
+{
+  if (srgb.x >= 0 && srgb.y >= 0 && srgb.z >= 0) {
+    float3 linear;
+    srgb_to_linearrgb_v3_v3(linear, srgb);
+    r_global_vertices.set_vertex_color(index, linear);
+  }
+  else if (srgb.x > 0) {
+    /* Treats value in srgb.x as weight. */
+    r_global_vertices.set_vertex_weight(index, srgb.x);
+  }
+}
+
+static void geom_add_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+{
+  r_global_vertices.flush_mrgb_block();
+  float3 vert, srgb;
+  parse_vertex(p, end, vert, srgb);
+  r_global_vertices.vertices.append(vert);
+  geom_set_vertex_color_or_weight(r_global_vertices.vertices.size() - 1, srgb, r_global_vertices);
+}
+
 static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices &r_global_vertices)
 {
   /* MRGB color extension, in the form of
@@ -126,9 +144,7 @@ static void geom_add_mrgb_colors(const char *p, const char *end, GlobalVertices
   }
 }
 
-static void geom_add_vertex_normal(const char *p,
-                                   const char *end,
-                                   GlobalVertices &r_global_vertices)
+static float3 parse_vertex_normal(const char *p, const char *end)
 {
   float3 normal;
   parse_floats(p, end, 0.0f, normal, 3);
@@ -136,14 +152,14 @@ static void geom_add_vertex_normal(const char *p,
    * making them ever-so-slightly non unit length. Make sure they are
    * normalized. */
   normalize_v3(normal);
-  r_global_vertices.vert_normals.append(normal);
+  return normal;
 }
 
-static void geom_add_uv_vertex(const char *p, const char *end, GlobalVertices &r_global_vertices)
+static float2 parse_uv_vertex(const char *p, const char *end)
 {
   float2 uv;
   parse_floats(p, end, 0.0f, uv, 2);
-  r_global_vertices.uv_vertices.append(uv);
+  return uv;
 }
 
 /**
@@ -209,53 +225,86 @@ static void geom_add_polyline(Geometry *geom,
   }
 }
 
-static void geom_add_polygon(Geometry *geom,
-                             const char *p,
-                             const char *end,
-                             const GlobalVertices &global_vertices,
-                             const int material_index,
-                             const int group_index,
-                             const bool shaded_smooth)
-{
-  FaceElem curr_face;
-  curr_face.shaded_smooth = shaded_smooth;
-  curr_face.material_index = material_index;
-  if (group_index >= 0) {
-    curr_face.vertex_group_index = group_index;
-    geom->has_vertex_groups_ = true;
-  }
-
-  const int orig_corners_size = geom->face_corners_.size();
-  curr_face.start_index_ = orig_corners_size;
+/**
+ * A face corner as written in the file, before its indices are made zero-based and validated,
+ * which needs the number of elements read before the face.
+ */
+struct RawFaceCorner {
+  int vert_index;
+  int uv_vert_index = -1;
+  int vertex_normal_index = -1;
+  bool got_uv = false;
+  bool got_normal = false;
+};
 
-  bool face_valid = true;
+static void parse_face_corners(const char *p, const char *end, Vector<RawFaceCorner> &r_corners)
+{
   p = drop_whitespace(p, end);
-  while (p < end && face_valid) {
-    FaceCorner corner;
-    bool got_uv = false, got_normal = false;
+  while (p < end) {
+    RawFaceCorner corner;
     /* Parse vertex index. */
     p = parse_int(p, end, INT32_MAX, corner.vert_index, false);
 
     /* Skip parsing when we reach start of the comment. */
-    if (*p == '#') {
+    if (p < end && *p == '#') {
       break;
     }
 
-    face_valid &= corner.vert_index != INT32_MAX;
+    const bool vert_valid = corner.vert_index != INT32_MAX;
     if (p < end && *p == '/') {
       /* Parse UV index. */
       ++p;
       if (p < end && *p != '/') {
         p = parse_int(p, end, INT32_MAX, corner.uv_vert_index, false);
-        got_uv = corner.uv_vert_index != INT32_MAX;
+        corner.got_uv = corner.uv_vert_index != INT32_MAX;
       }
       /* Parse normal index. */
       if (p < end && *p == '/') {
         ++p;
         p = parse_int(p, end, INT32_MAX, corner.vertex_normal_index, false);
-        got_normal = corner.vertex_normal_index != INT32_MAX;
+        corner.got_normal = corner.vertex_normal_index != INT32_MAX;
       }
     }
+    r_corners.append(corner);
+    if (!vert_valid) {
+      /* The face is invalid, no need to parse further. */
+      break;
+    }
+
+    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
+    p = drop_non_whitespace(p, end);
+    /* Skip whitespace to get to the next face corner. */
+    p = drop_whitespace(p, end);
+  }
+}
+
+static void geom_add_polygon(Geometry *geom,
+                             const Span<RawFaceCorner> raw_corners,
+                             const GlobalVertices &global_vertices,
+                             const int material_index,
+                             const int group_index,
+                             const bool shaded_smooth)
+{
+  FaceElem curr_face;
+  curr_face.shaded_smooth = shaded_smooth;
+  curr_face.material_index = material_index;
+  if (group_index >= 0) {
+    curr_face.vertex_group_index = group_index;
+    geom->has_vertex_groups_ = true;
+  }
+
+  const int orig_corners_size = geom->face_corners_.size();
+  curr_face.start_index_ = orig_corners_size;
+
+  bool face_valid = true;
+  for (const RawFaceCorner &raw_corner : raw_corners) {
+    FaceCorner corner;
+    corner.vert_index = raw_corner.vert_index;
+    corner.uv_vert_index = raw_corner.uv_vert_index;
+    corner.vertex_normal_index = raw_corner.vertex_normal_index;
+    const bool got_uv = raw_corner.got_uv, got_normal = raw_corner.got_normal;
+
+    face_valid &= corner.vert_index != INT32_MAX;
     /* Always keep stored indices non-negative and zero-based. */
     corner.vert_index += corner.vert_index < 0 ? global_vertices.vertices.size() : -1;
     if (corner.vert_index < 0 || corner.vert_index >= global_vertices.vertices.size()) {
@@ -299,10 +348,9 @@ static void geom_add_polygon(Geometry *geom,
     geom->face_corners_.append(corner);
     curr_face.corner_count_++;
 
-    /* Some files contain extra stuff per face (e.g. 4 indices); skip any remainder (#103441). */
-    p = drop_non_whitespace(p, end);
-    /* Skip whitespace to get to the next face corner. */
-    p = drop_whitespace(p, end);
+    if (!face_valid) {
+      break;
+    }
   }
 
   if (face_valid) {
@@ -428,8 +476,12 @@ static void geom_new_object(const char *p,
       r_curr_geom, GEOM_MESH, StringRef(p, end).trim(), r_all_geometries);
 }
 
-OBJParser::OBJParser(const OBJImportParams &import_params, size_t read_buffer_size)
-    : import_params_(import_params), read_buffer_size_(read_buffer_size)
+OBJParser::OBJParser(const OBJImportParams &import_params,
+                     size_t read_buffer_size,
+                     bool allow_parallel)
+    : import_params_(import_params),
+      read_buffer_size_(read_buffer_size),
+      allow_parallel_(allow_parallel)
 {
   obj_file_ = BLI_fopen(import_params_.filepath, "rb");
   if (!obj_file_) {
@@ -484,6 +536,157 @@ static void use_all_vertices_if_no_faces(Geometry *geom,
   }
 }
 
+/**
+ * Parsing state: once set, the values remain the same for the remaining
+ * elements in the object.
+ */
+struct OBJParseState {
+  Geometry *curr_geom = nullptr;
+  bool shaded_smooth = false;
+  string group_name;
+  int group_index = -1;
+  string material_name;
+  int material_index = -1;
+  /** Corners of the face being parsed, kept to reuse the allocation. */
+  Vector<RawFaceCorner> face_corners;
+};
+
+static void state_add_polygon(OBJParseState &state,
+                              const Span<RawFaceCorner> corners,
+                              const GlobalVertices &global_vertices)
+{
+  Geometry *curr_geom = state.curr_geom;
+  /* If we don't have a material index assigned yet, get one.
+   * It means "usemtl" state came from the previous object. */
+  if (state.material_index == -1 && !state.material_name.empty() &&
+      curr_geom->material_indices_.is_empty())
+  {
+    curr_geom->material_indices_.add_new(state.material_name, 0);
+    curr_geom->material_order_.append(state.material_name);
+    state.material_index = 0;
+  }
+
+  geom_add_polygon(curr_geom,
+                   corners,
+                   global_vertices,
+                   state.material_index,
+                   state.group_index,
+                   state.shaded_smooth);
+}
+
+/**
+ * Part of the file parsed on its own, possibly at the same time as other chunks. Vertex data and
+ * faces don't depend on the preceding lines until their indices are resolved, so they are parsed
+ * into the arrays below. All other lines change the parsing state and are kept to be parsed in
+ * order when the chunk is added, see #OBJParser::add_parsed_chunk.
+ */
+struct OBJParsedChunk {
+  enum class ItemType : int8_t { Vertices, Normals, UVs, Faces, Line };
+  /** A run of consecutive lines of the same type. */
+  struct Item {
+    ItemType type;
+    int64_t count;
+  };
+  Vector<Item> items;
+
+  Vector<float3> vertices;
+  /** Colors or weights following vertex positions, with the index of their vertex. */
+  Vector<std::pair<int64_t, float3>> vertex_extras;
+  Vector<float3> vert_normals;
+  Vector<float2> uv_vertices;
+  Vector<RawFaceCorner> face_corners;
+  Vector<int> face_sizes;
+  Vector<StringRef> lines;
+
+  /** Copy of the chunk text with line continuations removed, only used when it has some. */
+  std::string text;
+
+  void add_item(const ItemType type)
+  {
+    if (!items.is_empty() && items.last().type == type) {
+      items.last().count++;
+    }
+    else {
+      items.append({type, 1});
+    }
+  }
+};
+
+static void parse_chunk(StringRef text, OBJParsedChunk &r_chunk)
+{
+  using ItemType = OBJParsedChunk::ItemType;
+  if (text.find('\\') != StringRef::not_found) {
+    r_chunk.text = text;
+    fixup_line_continuations(r_chunk.text.data(), r_chunk.text.data() + r_chunk.text.size());
+    text = r_chunk.text;
+  }
+
+  while (!text.is_empty()) {
+    const StringRef line = read_next_line(text);
+    const char *p = line.begin(), *end = line.end();
+    p = drop_whitespace(p, end);
+    if (p == end) {
+      continue;
+    }
+    if (*p == 'v') {
+      if (parse_keyword(p, end, "v")) {
+        float3 vert, srgb;
+        parse_vertex(p, end, vert, srgb);
+        if (srgb.x >= 0) {
+          r_chunk.vertex_extras.append({r_chunk.vertices.size(), srgb});
+        }
+        r_chunk.vertices.append(vert);
+        r_chunk.add_item(ItemType::Vertices);
+      }
+      else if (parse_keyword(p, end, "vn")) {
+        r_chunk.vert_normals.append(parse_vertex_normal(p, end));
+        r_chunk.add_item(ItemType::Normals);
+      }
+      else if (parse_keyword(p, end, "vt")) {
+        r_chunk.uv_vertices.append(parse_uv_vertex(p, end));
+        r_chunk.add_item(ItemType::UVs);
+      }
+    }
+    else if (parse_keyword(p, end, "f")) {
+      const int64_t corners_start = r_chunk.face_corners.size();
+      parse_face_corners(p, end, r_chunk.face_corners);
+      r_chunk.face_sizes.append(int(r_chunk.face_corners.size() - corners_start));
+      r_chunk.add_item(ItemType::Faces);
+    }
+    else if (*p == '#' && !StringRef(p, end).startswith("#MRGB")) {
+      /* Comments, "#MRGB" lines are parsed in order with the other lines. */
+    }
+    else {
+      r_chunk.lines.append(StringRef(p, end));
+      r_chunk.add_item(ItemType::Line);
+    }
+  }
+}
+
+/**
+ * \return The position right after the first line end at or after \a pos, skipping line ends
+ * that are continued with a backslash.
+ */
+static int64_t find_chunk_end(const char *data, const int64_t size, int64_t pos)
+{
+  while (pos < size) {
+    const char *newline = static_cast<const char *>(memchr(data + pos, '\n', size - pos));
+    if (newline == nullptr) {
+      return size;
+    }
+    const int64_t newline_pos = newline - data;
+    int64_t i = newline_pos;
+    while (i > 0 && data[i - 1] <= ' ' && data[i - 1] != '\n') {
+      i--;
+    }
+    if (i == 0 || data[i - 1] != '\\') {
+      return newline_pos + 1;
+    }
+    pos = newline_pos + 1;
+  }
+  return size;
+}
+
 void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
                       GlobalVertices &r_global_vertices)
 {
@@ -496,16 +699,22 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
   STRNCPY(ob_name, BLI_path_basename(import_params_.filepath));
   BLI_path_extension_strip(ob_name);
 
-  Geometry *curr_geom = create_geometry(nullptr, GEOM_MESH, ob_name, r_all_geometries);
+  OBJParseState state;
+  state.curr_geom = create_geometry(nullptr, GEOM_MESH, ob_name, r_all_geometries);
 
-  /* State variables: once set, they remain the same for the remaining
-   * elements in the object. */
-  bool state_shaded_smooth = false;
-  string state_group_name;
-  int state_group_index = -1;
-  string state_material_name;
-  int state_material_index = -1;
+  if (!allow_parallel_ || !parse_parallel(state, r_all_geometries, r_global_vertices)) {
+    parse_sequential(state, r_all_geometries, r_global_vertices);
+  }
 
+  r_global_vertices.flush_mrgb_block();
+  use_all_vertices_if_no_faces(state.curr_geom, r_all_geometries, r_global_vertices);
+  add_default_mtl_library();
+}
+
+void OBJParser::parse_sequential(OBJParseState &state,
+                                 Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                                 GlobalVertices &r_global_vertices)
+{
   /* Read the input file in chunks. We need up to twice the possible chunk size,
    * to possibly store remainder of the previous input line that got broken mid-chunk. */
   Array<char> buffer(read_buffer_size_ * 2);
@@ -559,124 +768,8 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
      * line by line. */
     StringRef buffer_str{buffer.data(), int64_t(last_nl)};
     while (!buffer_str.is_empty()) {
-      StringRef line = read_next_line(buffer_str);
-      const char *p = line.begin(), *end = line.end();
-      p = drop_whitespace(p, end);
+      parse_line(read_next_line(buffer_str), state, r_all_geometries, r_global_vertices);
       ++line_number;
-      if (p == end) {
-        continue;
-      }
-      /* Most common things that start with 'v': vertices, normals, UVs. */
-      if (*p == 'v') {
-        if (parse_keyword(p, end, "v")) {
-          geom_add_vertex(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vn")) {
-          geom_add_vertex_normal(p, end, r_global_vertices);
-        }
-        else if (parse_keyword(p, end, "vt")) {
-          geom_add_uv_vertex(p, end, r_global_vertices);
-        }
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "f")) {
-        /* If we don't have a material index assigned yet, get one.
-         * It means "usemtl" state came from the previous object. */
-        if (state_material_index == -1 && !state_material_name.empty() &&
-            curr_geom->material_indices_.is_empty())
-        {
-          curr_geom->material_indices_.add_new(state_material_name, 0);
-          curr_geom->material_order_.append(state_material_name);
-          state_material_index = 0;
-        }
-
-        geom_add_polygon(curr_geom,
-                         p,
-                         end,
-                         r_global_vertices,
-                         state_material_index,
-                         state_group_index,
-                         state_shaded_smooth);
-      }
-      /* Faces. */
-      else if (parse_keyword(p, end, "l")) {
-        geom_add_polyline(curr_geom, p, end, r_global_vertices);
-      }
-      /* Objects. */
-      else if (parse_keyword(p, end, "o")) {
-        if (import_params_.use_split_objects) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
-        }
-      }
-      /* Groups. */
-      else if (parse_keyword(p, end, "g")) {
-        if (import_params_.use_split_groups) {
-          geom_new_object(p,
-                          end,
-                          state_shaded_smooth,
-                          state_group_name,
-                          state_material_index,
-                          curr_geom,
-                          r_all_geometries);
-        }
-        else {
-          geom_update_group(StringRef(p, end).trim(), state_group_name);
-          int new_index = curr_geom->group_indices_.size();
-          state_group_index = curr_geom->group_indices_.lookup_or_add(state_group_name, new_index);
-          if (new_index == state_group_index) {
-            curr_geom->group_order_.append(state_group_name);
-          }
-        }
-      }
-      /* Smoothing groups. */
-      else if (parse_keyword(p, end, "s")) {
-        geom_update_smooth_group(p, end, state_shaded_smooth);
-      }
-      /* Materials and their libraries. */
-      else if (parse_keyword(p, end, "usemtl")) {
-        state_material_name = StringRef(p, end).trim();
-        int new_mat_index = curr_geom->material_indices_.size();
-        state_material_index = curr_geom->material_indices_.lookup_or_add(state_material_name,
-                                                                          new_mat_index);
-        if (new_mat_index == state_material_index) {
-          curr_geom->material_order_.append(state_material_name);
-        }
-      }
-      else if (parse_keyword(p, end, "mtllib")) {
-        add_mtl_library(StringRef(p, end).trim());
-      }
-      else if (parse_keyword(p, end, "#MRGB")) {
-        geom_add_mrgb_colors(p, end, r_global_vertices);
-      }
-      /* Comments. */
-      else if (*p == '#') {
-        /* Nothing to do. */
-      }
-      /* Curve related things. */
-      else if (parse_keyword(p, end, "cstype")) {
-        curr_geom = geom_set_curve_type(curr_geom, p, end, state_group_name, r_all_geometries);
-      }
-      else if (parse_keyword(p, end, "deg")) {
-        geom_set_curve_degree(curr_geom, p, end);
-      }
-      else if (parse_keyword(p, end, "curv")) {
-        geom_add_curve_vertex_indices(curr_geom, p, end, r_global_vertices);
-      }
-      else if (parse_keyword(p, end, "parm")) {
-        geom_add_curve_parameters(curr_geom, p, end);
-      }
-      else if (StringRef(p, end).startswith("end")) {
-        /* End of curve definition, nothing else to do. */
-      }
-      else {
-        CLOG_WARN(&LOG, "OBJ element not recognized: '%s'", std::string(p, end).c_str());
-      }
     }
 
     /* We might have a line that was cut in the middle by the previous buffer;
@@ -685,10 +778,237 @@ void OBJParser::parse(Vector<std::unique_ptr<Geometry>> &r_all_geometries,
     memmove(buffer.data(), buffer.data() + last_nl, left_size);
     buffer_offset = left_size;
   }
+}
 
-  r_global_vertices.flush_mrgb_block();
-  use_all_vertices_if_no_faces(curr_geom, r_all_geometries, r_global_vertices);
-  add_default_mtl_library();
+bool OBJParser::parse_parallel(OBJParseState &state,
+                               Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                               GlobalVertices &r_global_vertices)
+{
+  BLI_mmap_file *mmap_file = BLI_mmap_open(fileno(obj_file_));
+  if (mmap_file == nullptr) {
+    rewind(obj_file_);
+    return false;
+  }
+  const int64_t file_size = int64_t(BLI_mmap_get_length(mmap_file));
+  /* Small files fit in a single chunk, there is nothing to parse in parallel. */
+  const char *data = file_size > int64_t(read_buffer_size_) ?
+                         static_cast<const char *>(BLI_mmap_get_range(mmap_file, 0, file_size)) :
+                         nullptr;
+  if (data == nullptr) {
+    BLI_mmap_free(mmap_file);
+    rewind(obj_file_);
+    return false;
+  }
+
+  /* The file is split into chunks of about the read buffer size that end at a line end. Chunks
+   * are parsed in parallel a window at a time, then added in order, so that the memory used by the
+   * parsed data stays bounded while the next window is read from the file. */
+  const int64_t chunks_per_window = 256;
+  const int64_t window_size = int64_t(read_buffer_size_) * chunks_per_window;
+  int64_t window_start = 0;
+  while (window_start < file_size) {
+    Vector<StringRef> chunk_texts;
+    int64_t chunk_start = window_start;
+    while (chunk_start < file_size && chunk_texts.size() < chunks_per_window) {
+      const int64_t chunk_end = find_chunk_end(
+          data, file_size, chunk_start + int64_t(read_buffer_size_) - 1);
+      chunk_texts.append(StringRef(data + chunk_start, chunk_end - chunk_start));
+      chunk_start = chunk_end;
+    }
+    const int64_t window_end = chunk_start;
+
+    Array<OBJParsedChunk> chunks(chunk_texts.size());
+    threading::parallel_for(chunk_texts.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        parse_chunk(chunk_texts[i], chunks[i]);
+      }
+    });
+
+    if (window_end < file_size) {
+      BLI_mmap_prefetch_range(
+          mmap_file, window_end, std::min(window_size, file_size - window_end));
+    }
+    for (const OBJParsedChunk &chunk : chunks) {
+      add_parsed_chunk(chunk, state, r_all_geometries, r_global_vertices);
+    }
+    BLI_mmap_release_range(mmap_file, window_start, window_end - window_start);
+    window_start = window_end;
+  }
+
+  const bool io_error = BLI_mmap_has_io_error(mmap_file);
+  BLI_mmap_free(mmap_file);
+  if (io_error) {
+    CLOG_ERROR(&LOG, "Error reading OBJ file:'%s'.", import_params_.filepath);
+    BKE_reportf(import_params_.reports,
+                RPT_ERROR,
+                "OBJ Import: Error reading file '%s'",
+                import_params_.filepath);
+  }
+  return true;
+}
+
+void OBJParser::add_parsed_chunk(const OBJParsedChunk &chunk,
+                                 OBJParseState &state,
+                                 Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                                 GlobalVertices &r_global_vertices)
+{
+  using ItemType = OBJParsedChunk::ItemType;
+  int64_t vert_index = 0, extra_index = 0, normal_index = 0, uv_index = 0;
+  int64_t face_index = 0, corner_index = 0, line_index = 0;
+  for (const OBJParsedChunk::Item &item : chunk.items) {
+    switch (item.type) {
+      case ItemType::Vertices: {
+        r_global_vertices.flush_mrgb_block();
+        const int64_t vert_offset = r_global_vertices.vertices.size() - vert_index;
+        r_global_vertices.vertices.extend(chunk.vertices.as_span().slice(vert_index, item.count));
+        vert_index += item.count;
+        while (extra_index < chunk.vertex_extras.size() &&
+               chunk.vertex_extras[extra_index].first < vert_index)
+        {
+          const std::pair<int64_t, float3> &extra = chunk.vertex_extras[extra_index];
+          geom_set_vertex_color_or_weight(
+              vert_offset + extra.first, extra.second, r_global_vertices);
+          extra_index++;
+        }
+        break;
+      }
+      case ItemType::Normals:
+        r_global_vertices.vert_normals.extend(
+            chunk.vert_normals.as_span().slice(normal_index, item.count));
+        normal_index += item.count;
+        break;
+      case ItemType::UVs:
+        r_global_vertices.uv_vertices.extend(
+            chunk.uv_vertices.as_span().slice(uv_index, item.count));
+        uv_index += item.count;
+        break;
+      case ItemType::Faces:
+        for (int64_t i = 0; i < item.count; i++) {
+          const int face_size = chunk.face_sizes[face_index++];
+          state_add_polygon(state,
+                            chunk.face_corners.as_span().slice(corner_index, face_size),
+                            r_global_vertices);
+          corner_index += face_size;
+        }
+        break;
+      case ItemType::Line:
+        for (int64_t i = 0; i < item.count; i++) {
+          parse_line(chunk.lines[line_index++], state, r_all_geometries, r_global_vertices);
+        }
+        break;
+    }
+  }
+}
+
+void OBJParser::parse_line(const StringRef line,
+                           OBJParseState &state,
+                           Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                           GlobalVertices &r_global_vertices)
+{
+  const char *p = line.begin(), *end = line.end();
+  p = drop_whitespace(p, end);
+  if (p == end) {
+    return;
+  }
+  /* Most common things that start with 'v': vertices, normals, UVs. */
+  if (*p == 'v') {
+    if (parse_keyword(p, end, "v")) {
+      geom_add_vertex(p, end, r_global_vertices);
+    }
+    else if (parse_keyword(p, end, "vn")) {
+      r_global_vertices.vert_normals.append(parse_vertex_normal(p, end));
+    }
+    else if (parse_keyword(p, end, "vt")) {
+      r_global_vertices.uv_vertices.append(parse_uv_vertex(p, end));
+    }
+  }
+  /* Faces. */
+  else if (parse_keyword(p, end, "f")) {
+    state.face_corners.clear();
+    parse_face_corners(p, end, state.face_corners);
+    state_add_polygon(state, state.face_corners, r_global_vertices);
+  }
+  /* Faces. */
+  else if (parse_keyword(p, end, "l")) {
+    geom_add_polyline(state.curr_geom, p, end, r_global_vertices);
+  }
+  /* Objects. */
+  else if (parse_keyword(p, end, "o")) {
+    if (import_params_.use_split_objects) {
+      geom_new_object(p,
+                      end,
+                      state.shaded_smooth,
+                      state.group_name,
+                      state.material_index,
+                      state.curr_geom,
+                      r_all_geometries);
+    }
+  }
+  /* Groups. */
+  else if (parse_keyword(p, end, "g")) {
+    if (import_params_.use_split_groups) {
+      geom_new_object(p,
+                      end,
+                      state.shaded_smooth,
+                      state.group_name,
+                      state.material_index,
+                      state.curr_geom,
+                      r_all_geometries);
+    }
+    else {
+      geom_update_group(StringRef(p, end).trim(), state.group_name);
+      int new_index = state.curr_geom->group_indices_.size();
+      state.group_index = state.curr_geom->group_indices_.lookup_or_add(state.group_name,
+                                                                        new_index);
+      if (new_index == state.group_index) {
+        state.curr_geom->group_order_.append(state.group_name);
+      }
+    }
+  }
+  /* Smoothing groups. */
+  else if (parse_keyword(p, end, "s")) {
+    geom_update_smooth_group(p, end, state.shaded_smooth);
+  }
+  /* Materials and their libraries. */
+  else if (parse_keyword(p, end, "usemtl")) {
+    state.material_name = StringRef(p, end).trim();
+    int new_mat_index = state.curr_geom->material_indices_.size();
+    state.material_index = state.curr_geom->material_indices_.lookup_or_add(state.material_name,
+                                                                            new_mat_index);
+    if (new_mat_index == state.material_index) {
+      state.curr_geom->material_order_.append(state.material_name);
+    }
+  }
+  else if (parse_keyword(p, end, "mtllib")) {
+    add_mtl_library(StringRef(p, end).trim());
+  }
+  else if (parse_keyword(p, end, "#MRGB")) {
+    geom_add_mrgb_colors(p, end, r_global_vertices);
+  }
+  /* Comments. */
+  else if (*p == '#') {
+    /* Nothing to do. */
+  }
+  /* Curve related things. */
+  else if (parse_keyword(p, end, "cstype")) {
+    state.curr_geom = geom_set_curve_type(
+        state.curr_geom, p, end, state.group_name, r_all_geometries);
+  }
+  else if (parse_keyword(p, end, "deg")) {
+    geom_set_curve_degree(state.curr_geom, p, end);
+  }
+  else if (parse_keyword(p, end, "curv")) {
+    geom_add_curve_vertex_indices(state.curr_geom, p, end, r_global_vertices);
+  }
+  else if (parse_keyword(p, end, "parm")) {
+    geom_add_curve_parameters(state.curr_geom, p, end);
+  }
+  else if (StringRef(p, end).startswith("end")) {
+    /* End of curve definition, nothing else to do. */
+  }
+  else {
+    CLOG_WARN(&LOG, "OBJ element not recognized: '%s'", std::string(p, end).c_str());
+  }
 }
 
 static MTLTexMapType mtl_line_start_to_texture_type(const char *&p, const char *end)
@@ -18,6 +18,8 @@
 namespace blender::io::obj {
 
 struct MTLMaterial;
+struct OBJParsedChunk;
+struct OBJParseState;
 
 /* NOTE: the OBJ parser implementation is planned to get fairly large changes "soon",
  * so don't read too much into current implementation... */
@@ -27,12 +29,17 @@ class OBJParser {
   FILE *obj_file_;
   Vector<std::string> mtl_libraries_;
   size_t read_buffer_size_;
+  bool allow_parallel_;
 
  public:
   /**
    * Open OBJ file at the path given in import parameters.
+   * \param allow_parallel: Parse chunks of the file on multiple threads when it is larger than
+   * the read buffer and can be memory mapped.
    */
-  OBJParser(const OBJImportParams &import_params, size_t read_buffer_size);
+  OBJParser(const OBJImportParams &import_params,
+            size_t read_buffer_size,
+            bool allow_parallel = true);
   ~OBJParser();
 
   /**
@@ -47,6 +54,23 @@ class OBJParser {
   Span<std::string> mtl_libraries() const;
 
  private:
+  void parse_sequential(OBJParseState &state,
+                        Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                        GlobalVertices &r_global_vertices);
+  /**
+   * \return False when the file can't be parsed in parallel, without having parsed anything.
+   */
+  bool parse_parallel(OBJParseState &state,
+                      Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                      GlobalVertices &r_global_vertices);
+  void add_parsed_chunk(const OBJParsedChunk &chunk,
+                        OBJParseState &state,
+                        Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                        GlobalVertices &r_global_vertices);
+  void parse_line(StringRef line,
+                  OBJParseState &state,
+                  Vector<std::unique_ptr<Geometry>> &r_all_geometries,
+                  GlobalVertices &r_global_vertices);
   void add_mtl_library(StringRef path);
   void add_default_mtl_library();
 };
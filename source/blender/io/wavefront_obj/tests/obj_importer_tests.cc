@@ -15,7 +15,7 @@
 namespace blender::io::obj {
 
 /* Extensive tests for OBJ importing are in `io_obj_import_test.py`.
- * The tests here are only for testing OBJ reader buffer refill behavior,
+ * The tests here are only for testing OBJ reader buffer refill and chunking behavior,
  * by using a very small buffer size on purpose. */
 
 TEST(obj_import, BufferRefillTest)
@@ -30,7 +30,7 @@ TEST(obj_import, BufferRefillTest)
 
   /* Use a small read buffer size to test buffer refilling behavior. */
   const size_t read_buffer_size = 650;
-  OBJParser obj_parser{params, read_buffer_size};
+  OBJParser obj_parser{params, read_buffer_size, false};
 
   Vector<std::unique_ptr<Geometry>> all_geometries;
   GlobalVertices global_vertices;
@@ -45,4 +45,77 @@ TEST(obj_import, BufferRefillTest)
   CLG_exit();
 }
 
+static void expect_same_geometries(const Span<std::unique_ptr<Geometry>> a,
+                                   const Span<std::unique_ptr<Geometry>> b)
+{
+  ASSERT_EQ(a.size(), b.size());
+  for (const int i : a.index_range()) {
+    const Geometry &geom_a = *a[i], &geom_b = *b[i];
+    EXPECT_EQ(geom_a.geom_type_, geom_b.geom_type_);
+    EXPECT_EQ(geom_a.geometry_name_, geom_b.geometry_name_);
+    EXPECT_EQ(geom_a.edges_.as_span(), geom_b.edges_.as_span());
+    EXPECT_EQ(geom_a.material_order_.as_span(), geom_b.material_order_.as_span());
+    EXPECT_EQ(geom_a.group_order_.as_span(), geom_b.group_order_.as_span());
+    ASSERT_EQ(geom_a.face_elements_.size(), geom_b.face_elements_.size());
+    for (const int face : geom_a.face_elements_.index_range()) {
+      const FaceElem &face_a = geom_a.face_elements_[face];
+      const FaceElem &face_b = geom_b.face_elements_[face];
+      EXPECT_EQ(face_a.start_index_, face_b.start_index_);
+      EXPECT_EQ(face_a.corner_count_, face_b.corner_count_);
+      EXPECT_EQ(face_a.material_index, face_b.material_index);
+      EXPECT_EQ(face_a.vertex_group_index, face_b.vertex_group_index);
+      EXPECT_EQ(face_a.shaded_smooth, face_b.shaded_smooth);
+    }
+    ASSERT_EQ(geom_a.face_corners_.size(), geom_b.face_corners_.size());
+    for (const int corner : geom_a.face_corners_.index_range()) {
+      const FaceCorner &corner_a = geom_a.face_corners_[corner];
+      const FaceCorner &corner_b = geom_b.face_corners_[corner];
+      EXPECT_EQ(corner_a.vert_index, corner_b.vert_index);
+      EXPECT_EQ(corner_a.uv_vert_index, corner_b.uv_vert_index);
+      EXPECT_EQ(corner_a.vertex_normal_index, corner_b.vertex_normal_index);
+    }
+    EXPECT_EQ(geom_a.nurbs_element_.curv_indices.as_span(),
+              geom_b.nurbs_element_.curv_indices.as_span());
+    EXPECT_EQ(geom_a.nurbs_element_.parm.as_span(), geom_b.nurbs_element_.parm.as_span());
+  }
+}
+
+TEST(obj_import, ParallelChunksTest)
+{
+  CLG_init();
+
+  for (const char *filename : {"nurbs_cyclic.obj",
+                               "cubes_vertex_colors.obj",
+                               "cubes_vertex_colors_mrgb.obj",
+                               "split_options.obj",
+                               "invalid_indices.obj"})
+  {
+    SCOPED_TRACE(filename);
+    OBJImportParams params;
+    std::string obj_path = blender::tests::flags_test_asset_dir() +
+                           SEP_STR "io_tests" SEP_STR "obj" SEP_STR + filename;
+    STRNCPY(params.filepath, obj_path.c_str());
+    params.use_split_objects = true;
+
+    /* Use a small read buffer size, so that the file is split into many chunks. */
+    const size_t read_buffer_size = 650;
+    Vector<std::unique_ptr<Geometry>> geometries_sequential, geometries_parallel;
+    GlobalVertices vertices_sequential, vertices_parallel;
+    OBJParser{params, read_buffer_size, false}.parse(geometries_sequential, vertices_sequential);
+    OBJParser{params, read_buffer_size, true}.parse(geometries_parallel, vertices_parallel);
+
+    EXPECT_EQ(vertices_sequential.vertices.as_span(), vertices_parallel.vertices.as_span());
+    EXPECT_EQ(vertices_sequential.uv_vertices.as_span(), vertices_parallel.uv_vertices.as_span());
+    EXPECT_EQ(vertices_sequential.vert_normals.as_span(),
+              vertices_parallel.vert_normals.as_span());
+    EXPECT_EQ(vertices_sequential.vertex_colors.as_span(),
+              vertices_parallel.vertex_colors.as_span());
+    EXPECT_EQ(vertices_sequential.vertex_weights.as_span(),
+              vertices_parallel.vertex_weights.as_span());
+    expect_same_geometries(geometries_sequential, geometries_parallel);
+  }
+
+  CLG_exit();
+}
+
 }  // namespace blender::io::obj
@@ -8,6 +8,7 @@
 
 #pragma once
 
+#include "BLI_implicit_sharing.h"
 #include "BLI_utildefines.h"
 
 #include "DNA_ID.h"
@@ -391,6 +392,14 @@ typedef struct FCurve {
   float color[3];
 
   float prev_norm_factor, prev_offset;
+
+  /**
+   * Runtime: read-only keyframes shared between evaluated copies, see
+   * #BKE_fcurve_share_keyframes_for_eval. For evaluated F-Curves this is the same as #bezt, for
+   * original F-Curves it is a snapshot of #bezt taken when last copied for evaluation.
+   */
+  BezTriple *bezt_shared;
+  const ImplicitSharingInfoHandle *bezt_sharing_info;
 } FCurve;
 
 /* ************************************************ */
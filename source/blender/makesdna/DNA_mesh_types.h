@@ -19,6 +19,7 @@
 
 #  include <optional>
 
+#  include "BLI_index_mask_fwd.hh"
 #  include "BLI_math_vector_types.hh"
 #  include "BLI_memory_counter_fwd.hh"
 
@@ -339,6 +340,14 @@ typedef struct Mesh {
    * Cached map from each vertex to the faces using it.
    */
   blender::GroupedSpan<int> vert_to_face_map() const;
+  /**
+   * Cached map from each vertex to the edges using it.
+   */
+  blender::GroupedSpan<int> vert_to_edge_map() const;
+  /**
+   * Cached map from each edge to the faces using it.
+   */
+  blender::GroupedSpan<int> edge_to_face_map() const;
 
   /**
    * Cached information about loose edges, calculated lazily when necessary.
@@ -435,6 +444,12 @@ typedef struct Mesh {
   void tag_positions_changed_uniformly();
   /** Like #tag_positions_changed but doesn't tag normals; they must be updated separately. */
   void tag_positions_changed_no_normals();
+  /**
+   * Call after changing the positions of only some vertices. Instead of tagging them dirty, the
+   * cached normals and triangulation are updated for the faces around the changed vertices,
+   * which is much cheaper when only a small part of the mesh was deformed.
+   */
+  void tag_positions_changed_partial(const blender::IndexMask &changed_verts);
   /** Call when changing "sharp_face" or "sharp_edge" data. */
   void tag_sharpness_changed();
   /** Call when changing "custom_normal" data. */
@@ -948,7 +948,16 @@ typedef struct CollisionModifierData {
   float time_x, time_xnew;
   /** Collider doesn't move this frame, i.e. x[].co==xnew[].co. */
   char is_static;
-  char _pad[7];
+  /** The inter-frame state was moved to #moved_step by #collision_move_object. */
+  char is_moved;
+  /** The last move updated the BVH with moving bounds. */
+  char is_moved_bvh_moving;
+  char _pad[5];
+  /**
+   * Inter-frame steps of the last #collision_move_object, so that a collider shared by several
+   * simulations is only moved once per step.
+   */
+  float moved_step, moved_prevstep;
 
   /** Bounding volume hierarchy for this cloth object. */
   struct BVHTree *bvhtree;
@@ -2127,6 +2136,7 @@ enum {
 enum {
   MOD_WELD_MODE_ALL = 0,
   MOD_WELD_MODE_CONNECTED = 1,
+  MOD_WELD_MODE_CLUSTERS = 2,
 };
 
 typedef struct DataTransferModifierData {
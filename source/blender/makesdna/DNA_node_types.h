@@ -3180,6 +3180,7 @@ typedef enum GeometryNodeMeshCircleFillType {
 typedef enum GeometryNodeMergeByDistanceMode {
   GEO_NODE_MERGE_BY_DISTANCE_MODE_ALL = 0,
   GEO_NODE_MERGE_BY_DISTANCE_MODE_CONNECTED = 1,
+  GEO_NODE_MERGE_BY_DISTANCE_MODE_CLUSTERS = 2,
 } GeometryNodeMergeByDistanceMode;
 
 typedef enum GeometryNodeUVUnwrapMethod {
@@ -613,6 +613,8 @@ enum {
   OB_DRAW_NO_SHADOW_CAST = 1 << 9,
   /* Enable lights for grease pencil. */
   OB_USE_GPENCIL_LIGHTS = 1 << 10,
+  /* Always draw the full resolution mesh, even when it covers a small part of the viewport. */
+  OB_DRAW_NO_LOD = 1 << 11,
 };
 
 /** #Object.empty_drawtype: no flags */
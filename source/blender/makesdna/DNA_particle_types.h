@@ -396,6 +396,13 @@ typedef struct ParticleSystem {
 
   void *batch_cache;
 
+  /**
+   * Hashes of the parent paths and of the other state the child path cache was created from
+   * (runtime). Used to only recompute children whose inputs changed.
+   */
+  uint64_t *childcache_parent_hash;
+  uint64_t childcache_hash;
+
   /**
    * Set by dependency graph's copy-on-evaluation, allows to quickly go
    * from evaluated particle system to original one.
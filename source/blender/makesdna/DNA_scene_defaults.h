@@ -101,6 +101,8 @@
     .bake = _DNA_DEFAULT_BakeData, \
  \
     .scemode = R_DOCOMP | R_DOSEQ | R_EXTENSION, \
+ \
+    .background_write_frames = 1, \
  \
     .pic = "//", \
  \
@@ -843,10 +843,15 @@ typedef struct RenderData {
   /** Cycles baking. */
   struct BakeData bake;
 
-  int _pad8;
+  /**
+   * Limit of the total memory of the frames saved at once with #R_BACKGROUND_WRITE in megabytes,
+   * zero for no limit.
+   */
+  int background_write_memory;
   short preview_pixel_size;
 
-  short _pad4;
+  /** Maximum number of frames saved at once with #R_BACKGROUND_WRITE. */
+  short background_write_frames;
 
   /* MultiView. */
   /** SceneRenderView. */
@@ -2207,7 +2212,7 @@ enum {
 enum {
   R_MODE_UNUSED_0 = 1 << 0, /* dirty */
   R_SIMPLIFY_NORMALS = 1 << 1,
-  R_MODE_UNUSED_2 = 1 << 2, /* cleared */
+  R_SIMPLIFY_HIDDEN_OBJECTS = 1 << 2,
   R_MODE_UNUSED_3 = 1 << 3, /* cleared */
   R_MODE_UNUSED_4 = 1 << 4, /* cleared */
   R_MODE_UNUSED_5 = 1 << 5, /* cleared */
@@ -2235,6 +2240,10 @@ enum {
   R_EDGE_FRS = 1 << 25,        /* R_EDGE reserved for Freestyle */
   R_PERSISTENT_DATA = 1 << 26, /* Keep data around for re-render. */
   R_MODE_UNUSED_27 = 1 << 27,  /* cleared */
+  /** Keep data around between the frames of an animation render. */
+  R_PERSISTENT_DATA_ANIMATION = 1 << 27,
+  /** Save frames of image sequences in the background while the next frame renders. */
+  R_BACKGROUND_WRITE = 1 << 28,
 };
 
 /** #RenderData::seq_flag */
@@ -2963,6 +2972,7 @@ enum {
   SCE_EEVEE_SHADOW_JITTERED_VIEWPORT = (1 << 26),
   SCE_EEVEE_VOLUME_CUSTOM_RANGE = (1 << 27),
   SCE_EEVEE_FAST_GI_ENABLED = (1 << 28),
+  SCE_EEVEE_ADAPTIVE_RESOLUTION = (1 << 29),
 };
 
 typedef enum RaytraceEEVEE_Flag {
@@ -861,6 +861,8 @@ enum {
 
   SEQ_CACHE_PREFETCH_ENABLE = (1 << 10),
   SEQ_CACHE_UNUSED_11 = (1 << 11), /* Was SEQ_CACHE_DISK_CACHE_ENABLE */
+  /** Store final images compressed, to fit more frames in the cache. */
+  SEQ_CACHE_COMPRESS_FINAL = (1 << 12),
 };
 
 /** #Strip.color_tag. */
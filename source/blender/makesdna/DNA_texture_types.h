@@ -115,6 +115,9 @@ typedef struct PointDensity {
 
   /** Falloff density curve. */
   struct CurveMapping *falloff_curve;
+
+  /** Hash of the source data #point_tree was built from, to reuse it while that is unchanged. */
+  uint64_t point_tree_hash;
 } PointDensity;
 
 /** \} */
@@ -219,6 +219,7 @@ typedef struct UserDef_Experimental {
   char use_recompute_usercount_on_save_debug;
   char write_large_blend_file_blocks;
   char use_attribute_storage_write;
+  char use_undo_incremental_write;
   char SANITIZE_AFTER_HERE;
   /* The following options are automatically sanitized (set to 0)
    * when the release cycle is not alpha. */
@@ -228,7 +229,7 @@ typedef struct UserDef_Experimental {
   char use_new_volume_nodes;
   char use_shader_node_previews;
   char use_bundle_and_closure_nodes;
-  char _pad[5];
+  char _pad[4];
 } UserDef_Experimental;
 
 #define USER_EXPERIMENTAL_TEST(userdef, member) \
@@ -439,11 +440,12 @@ typedef struct UserDef {
 
   short undosteps;
   int undomemory;
+  /** Memory in megabytes above which undo steps are compressed and moved to temporary files. */
+  int undomemory_resident;
   float gpu_viewport_quality DNA_DEPRECATED;
   short gp_manhattandist, gp_euclideandist, gp_eraser;
   /** #eGP_UserdefSettings. */
   short gp_settings;
-  char _pad13[4];
   struct SolidLight light_param[4];
   float light_ambient[3];
   char gizmo_flag;
@@ -1103,6 +1105,7 @@ typedef enum eUserpref_SeqProxySetup {
 typedef enum eUserpref_SeqEditorFlags {
   USER_SEQ_ED_SIMPLE_TWEAKING = (1 << 0),
   USER_SEQ_ED_CONNECT_STRIPS_BY_DEFAULT = (1 << 1),
+  USER_SEQ_ED_HARDWARE_DECODE = (1 << 2),
 } eUserpref_SeqEditorFlags;
 
 /* Locale Ids. Auto will try to get local from OS. Our default is English though. */
@@ -7058,6 +7058,11 @@ static void rna_def_modifier_weld(BlenderRNA *brna)
   static const EnumPropertyItem mode_items[] = {
       {MOD_WELD_MODE_ALL, "ALL", 0, "All", "Full merge by distance"},
       {MOD_WELD_MODE_CONNECTED, "CONNECTED", 0, "Connected", "Only merge along the edges"},
+      {MOD_WELD_MODE_CLUSTERS,
+       "CLUSTERS",
+       0,
+       "Clusters",
+       "Merge all vertices chained together by distances below the limit, computed in parallel"},
       {0, nullptr, 0, nullptr, nullptr},
   };
 
@@ -4967,12 +4967,22 @@ void rna_ShaderNodePointDensity_density_cache(bNode *self, Depsgraph *depsgraph)
     return;
   }
 
-  /* Make sure there's no cached data. */
+  /* Free the settings, but keep the points of the previous evaluation. They are reused when the
+   * source data didn't change. */
+  void *point_tree = pd->point_tree;
+  float *point_data = pd->point_data;
+  const int totpoints = pd->totpoints;
+  const uint64_t point_tree_hash = pd->point_tree_hash;
+  pd->point_tree = nullptr;
+  pd->point_data = nullptr;
   BKE_texture_pointdensity_free_data(pd);
-  RE_point_density_free(pd);
 
   /* Create PointDensity structure from node for sampling. */
   BKE_texture_pointdensity_init_data(pd);
+  pd->point_tree = point_tree;
+  pd->point_data = point_data;
+  pd->totpoints = totpoints;
+  pd->point_tree_hash = point_tree_hash;
   pd->object = reinterpret_cast<Object *>(self->id);
   pd->radius = shader_point_density->radius;
   if (shader_point_density->point_source == SHD_POINTDENSITY_SOURCE_PSYS) {
@@ -5021,9 +5031,20 @@ void rna_ShaderNodePointDensity_density_calc(bNode *self,
   /* Single-threaded sampling of the voxel domain. */
   RE_point_density_sample(depsgraph, pd, resolution, *values);
 
-  /* We're done, time to clean up. */
+  /* We're done, time to clean up. The points are kept for the next evaluation, they are freed
+   * along with the node. */
+  void *point_tree = pd->point_tree;
+  float *point_data = pd->point_data;
+  const int totpoints = pd->totpoints;
+  const uint64_t point_tree_hash = pd->point_tree_hash;
+  pd->point_tree = nullptr;
+  pd->point_data = nullptr;
   BKE_texture_pointdensity_free_data(pd);
   *pd = blender::dna::shallow_zero_initialize();
+  pd->point_tree = point_tree;
+  pd->point_data = point_data;
+  pd->totpoints = totpoints;
+  pd->point_tree_hash = point_tree_hash;
 
   shader_point_density->cached_resolution = 0.0f;
 }
@@ -2651,6 +2651,14 @@ static void rna_def_object_display(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Shadow", "Object cast shadows in the 3D viewport");
   RNA_def_property_update(prop, NC_OBJECT | ND_DRAW, nullptr);
 
+  prop = RNA_def_property(srna, "use_level_of_detail", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_negative_sdna(prop, nullptr, "dtx", OB_DRAW_NO_LOD);
+  RNA_def_property_ui_text(prop,
+                           "Level of Detail",
+                           "Display a simplified mesh in Solid mode when the object only covers a "
+                           "small part of the 3D viewport");
+  RNA_def_property_update(prop, NC_OBJECT | ND_DRAW, nullptr);
+
   RNA_define_lib_overridable(false);
 }
 
@@ -2170,6 +2170,15 @@ static void rna_Scene_use_simplify_normals_update(Main *bmain, Scene *scene, Poi
   }
 }
 
+static void rna_Scene_use_simplify_hidden_objects_update(Main * /*bmain*/,
+                                                        Scene *scene,
+                                                        PointerRNA * /*ptr*/)
+{
+  /* The dependency graph picks up the setting when flushing updates. */
+  DEG_id_tag_update(&scene->id, ID_RECALC_SYNC_TO_EVAL);
+  WM_main_add_notifier(NC_OBJECT | ND_DRAW, nullptr);
+}
+
 static void rna_Scene_use_persistent_data_update(Main * /*bmain*/,
                                                  Scene * /*scene*/,
                                                  PointerRNA *ptr)
@@ -7187,6 +7196,37 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
   RNA_def_property_ui_text(prop, "Overwrite", "Overwrite existing files while rendering");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
 
+  prop = RNA_def_property(srna, "use_background_write", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "mode", R_BACKGROUND_WRITE);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Save in Background",
+                           "Save the frames of image sequences while the next frame renders. "
+                           "Render post and write handlers may run before the file is saved");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
+  prop = RNA_def_property(srna, "background_write_frames", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "background_write_frames");
+  RNA_def_property_range(prop, 1, 64);
+  RNA_def_property_ui_range(prop, 1, 16, 1, -1);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Frames in Flight",
+                           "Maximum number of frames saved in the background at once. Rendering "
+                           "waits when this many frames are still being saved");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
+  prop = RNA_def_property(srna, "background_write_memory", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "background_write_memory");
+  RNA_def_property_range(prop, 0, INT_MAX);
+  RNA_def_property_ui_range(prop, 0, 65536, 256, -1);
+  RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
+  RNA_def_property_ui_text(prop,
+                           "Memory Limit",
+                           "Maximum memory in megabytes used by the frames saved in the "
+                           "background at once, zero for no limit");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
   prop = RNA_def_property(srna, "use_compositing", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "scemode", R_DOCOMP);
   RNA_def_property_clear_flag(prop, PROP_ANIMATABLE);
@@ -7588,6 +7628,15 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
                            "meshes in the viewport");
   RNA_def_property_update(prop, 0, "rna_Scene_use_simplify_normals_update");
 
+  prop = RNA_def_property(srna, "use_simplify_hidden_objects", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "mode", R_SIMPLIFY_HIDDEN_OBJECTS);
+  RNA_def_property_ui_text(prop,
+                           "Hidden Objects",
+                           "Skip evaluating objects hidden in the viewport, unless other visible "
+                           "objects depend on them. Revealing such objects evaluates them on "
+                           "demand");
+  RNA_def_property_update(prop, 0, "rna_Scene_use_simplify_hidden_objects_update");
+
   /* Grease Pencil - Simplify Options */
   prop = RNA_def_property(srna, "simplify_gpencil", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "simplify_gpencil", SIMPLIFY_GPENCIL_ENABLE);
@@ -7635,6 +7684,13 @@ static void rna_def_scene_render_data(BlenderRNA *brna)
                            "at the cost of increased memory usage");
   RNA_def_property_update(prop, 0, "rna_Scene_use_persistent_data_update");
 
+  prop = RNA_def_property(srna, "use_persistent_data_animation", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "mode", R_PERSISTENT_DATA_ANIMATION);
+  RNA_def_property_ui_text(prop,
+                           "Persistent Animation Data",
+                           "Keep render data around between the frames of an animation render, "
+                           "and free it once the animation is done");
+
   /* Freestyle line thickness options */
   prop = RNA_def_property(srna, "line_thickness_mode", PROP_ENUM, PROP_NONE);
   RNA_def_property_enum_sdna(prop, nullptr, "line_thickness_mode");
@@ -8196,6 +8252,14 @@ static void rna_def_scene_eevee(BlenderRNA *brna)
                            "enabled for final renders).");
   RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
 
+  prop = RNA_def_property(srna, "use_adaptive_resolution", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(prop, nullptr, "flag", SCE_EEVEE_ADAPTIVE_RESOLUTION);
+  RNA_def_property_ui_text(prop,
+                           "Adaptive Resolution",
+                           "Lower the viewport resolution while navigating when redraws are "
+                           "slower than the scene frame rate");
+  RNA_def_property_update(prop, NC_SCENE | ND_RENDER_OPTIONS, nullptr);
+
   /* Clamping */
   prop = RNA_def_property(srna, "clamp_surface_direct", PROP_FLOAT, PROP_NONE);
   RNA_def_property_ui_text(prop,
@@ -5686,6 +5686,14 @@ static void rna_def_userdef_edit(BlenderRNA *brna)
   RNA_def_property_ui_text(
       prop, "Undo Memory Size", "Maximum memory usage in megabytes (0 means unlimited)");
 
+  prop = RNA_def_property(srna, "undo_resident_memory_limit", PROP_INT, PROP_NONE);
+  RNA_def_property_int_sdna(prop, nullptr, "undomemory_resident");
+  RNA_def_property_range(prop, 0, max_memory_in_megabytes_int());
+  RNA_def_property_ui_text(prop,
+                           "Undo Resident Memory",
+                           "Memory usage in megabytes above which older undo steps are "
+                           "compressed, and then moved to temporary files (0 means unlimited)");
+
   prop = RNA_def_property(srna, "use_global_undo", PROP_BOOLEAN, PROP_NONE);
   RNA_def_property_boolean_sdna(prop, nullptr, "uiflag", USER_GLOBALUNDO);
   RNA_def_property_ui_text(
@@ -6183,6 +6191,14 @@ static void rna_def_userdef_system(BlenderRNA *brna)
   RNA_def_property_enum_sdna(prop, nullptr, "sequencer_proxy_setup");
   RNA_def_property_ui_text(prop, "Proxy Setup", "When and how proxies are created");
 
+  prop = RNA_def_property(srna, "use_sequencer_hardware_decoding", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_boolean_sdna(
+      prop, nullptr, "sequencer_editor_flag", USER_SEQ_ED_HARDWARE_DECODE);
+  RNA_def_property_ui_text(prop,
+                           "Hardware Video Decoding",
+                           "Decode movies on the GPU when the platform and codec support it, "
+                           "only affects movies opened afterwards");
+
   prop = RNA_def_property(srna, "scrollback", PROP_INT, PROP_UNSIGNED);
   RNA_def_property_int_sdna(prop, nullptr, "scrollback");
   RNA_def_property_range(prop, 32, 32768);
@@ -7593,6 +7609,13 @@ static void rna_def_userdef_experimental(BlenderRNA *brna)
                            "Write New Attribute Storage Format",
                            "Instead of writing with the older \"CustomData\" format for forward "
                            "compatibility, use the new \"AttributeStorage\" format");
+
+  prop = RNA_def_property(srna, "use_undo_incremental_write", PROP_BOOLEAN, PROP_NONE);
+  RNA_def_property_ui_text(prop,
+                           "Incremental Global Undo",
+                           "Only write data-blocks tagged for an update since the previous undo "
+                           "step, making global undo pushes faster in large files. Changes done "
+                           "without tagging data-blocks for an update may not be undone");
 }
 
 static void rna_def_userdef_addon_collection(BlenderRNA *brna, PropertyRNA *cprop)
@@ -684,7 +684,8 @@ ModifierTypeInfo modifierType_Boolean = {
     /*srna*/ &RNA_BooleanModifier,
     /*type*/ ModifierTypeType::Nonconstructive,
     /*flags*/
-    (eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode),
+    (eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
+     eModifierTypeFlag_CacheableResult),
     /*icon*/ ICON_MOD_BOOLEAN,
 
     /*copy_data*/ BKE_modifier_copydata_generic,
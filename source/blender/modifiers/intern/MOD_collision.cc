@@ -66,6 +66,7 @@ static void free_data(ModifierData *md)
     collmd->mvert_num = 0;
     collmd->tri_num = 0;
     collmd->is_static = false;
+    collmd->is_moved = false;
   }
 }
 
@@ -160,6 +161,7 @@ static void deform_verts(ModifierData *md,
 
       collmd->time_x = collmd->time_xnew = current_time;
       collmd->is_static = true;
+      collmd->is_moved = false;
     }
     else if (mvert_num == collmd->mvert_num) {
       /* put positions to old positions */
@@ -214,6 +216,7 @@ static void deform_verts(ModifierData *md,
       }
 
       collmd->is_static = is_static;
+      collmd->is_moved = false;
       collmd->time_xnew = current_time;
     }
     else if (mvert_num != collmd->mvert_num) {
@@ -267,6 +270,7 @@ static void blend_read(BlendDataReader * /*reader*/, ModifierData *md)
   collmd->mvert_num = 0;
   collmd->tri_num = 0;
   collmd->is_static = false;
+  collmd->is_moved = false;
   collmd->bvhtree = nullptr;
   collmd->vert_tris = nullptr;
 }
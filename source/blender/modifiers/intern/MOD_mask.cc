@@ -364,6 +364,10 @@ static void add_interp_verts_copy_edges_to_new_mesh(const Mesh &src_mesh,
 
   uint vert_index = dst_mesh.verts_num - verts_add_num;
   uint edge_index = edges_masked_num - verts_add_num;
+  /* The new vertices are interpolated from the vertices of the cut edges, all at once. */
+  Vector<int> interp_src_indices;
+  Vector<float> interp_weights;
+  Vector<int> interp_dst_indices;
   for (int i_src : IndexRange(src_mesh.edges_num)) {
     if (r_edge_map[i_src] != -1) {
       int i_dst = r_edge_map[i_src];
@@ -396,18 +400,22 @@ static void add_interp_verts_copy_edges_to_new_mesh(const Mesh &src_mesh,
       float fac = get_interp_factor_from_vgroup(
           dvert, defgrp_index, threshold, e_src[0], e_src[1]);
 
-      float weights[2] = {1.0f - fac, fac};
-      CustomData_interp(&src_mesh.vert_data,
-                        &dst_mesh.vert_data,
-                        (int *)&e_src[0],
-                        weights,
-                        nullptr,
-                        2,
-                        vert_index);
+      interp_src_indices.extend({e_src[0], e_src[1]});
+      interp_weights.extend({1.0f - fac, fac});
+      interp_dst_indices.append(vert_index);
       vert_index++;
     }
   }
   BLI_assert(vert_index == dst_mesh.verts_num);
+
+  Array<int> interp_offsets(interp_dst_indices.size() + 1);
+  blender::offset_indices::fill_constant_group_size(2, 0, interp_offsets);
+  CustomData_interp_grouped(&src_mesh.vert_data,
+                            &dst_mesh.vert_data,
+                            blender::OffsetIndices<int>(interp_offsets),
+                            interp_src_indices,
+                            interp_weights,
+                            interp_dst_indices);
   BLI_assert(edge_index == edges_masked_num);
 }
 
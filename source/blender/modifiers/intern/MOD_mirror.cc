@@ -235,7 +235,7 @@ ModifierTypeInfo modifierType_Mirror = {
     /*type*/ ModifierTypeType::Constructive,
     /*flags*/ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsMapping |
         eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_EnableInEditmode |
-        eModifierTypeFlag_AcceptsCVs,
+        eModifierTypeFlag_AcceptsCVs | eModifierTypeFlag_CacheableResult,
     /*icon*/ ICON_MOD_MIRROR,
 
     /*copy_data*/ BKE_modifier_copydata_generic,
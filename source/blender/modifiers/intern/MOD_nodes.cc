@@ -1032,6 +1032,9 @@ static BakeFrameIndices get_bake_frame_indices(
   return frame_indices;
 }
 
+/** Number of frames after a frame loaded from disk whose data is prefetched. */
+static constexpr int bake_prefetch_frames_num = 2;
+
 static void ensure_bake_loaded(bake::NodeBakeCache &bake_cache, bake::FrameCache &frame_cache)
 {
   if (!frame_cache.state.items_by_id.is_empty()) {
@@ -1054,21 +1057,36 @@ static void ensure_bake_loaded(bake::NodeBakeCache &bake_cache, bake::FrameCache
       return;
     }
   }
-  if (!bake_cache.blobs_dir) {
+  if (!bake_cache.disk_blob_reader) {
     return;
   }
   const auto *meta_path = std::get_if<std::string>(&*frame_cache.meta_data_source);
   if (!meta_path) {
     return;
   }
-  bake::DiskBlobReader blob_reader{*bake_cache.blobs_dir};
   fstream meta_file{*meta_path};
   std::optional<bake::BakeState> bake_state = bake::deserialize_bake(
-      meta_file, blob_reader, *bake_cache.blob_sharing);
+      meta_file, *bake_cache.disk_blob_reader, *bake_cache.blob_sharing);
   if (!bake_state.has_value()) {
     return;
   }
   frame_cache.state = std::move(*bake_state);
+
+  /* Start loading the data of the next frames in the background, so that it's available when
+   * playing back the animation. Only the blob data is mapped, the next frames are not loaded. */
+  const int next_frame_index = binary_search::first_if(
+      bake_cache.frames, [&](const std::unique_ptr<bake::FrameCache> &value) {
+        return value->frame > frame_cache.frame;
+      });
+  const IndexRange prefetch_range = bake_cache.frames.index_range().intersect(
+      IndexRange(next_frame_index, bake_prefetch_frames_num));
+  for (const int i : prefetch_range) {
+    const bake::FrameCache &next_frame_cache = *bake_cache.frames[i];
+    if (next_frame_cache.state.items_by_id.is_empty()) {
+      bake_cache.disk_blob_reader->prefetch(bake::frame_to_file_name(next_frame_cache.frame) +
+                                            ".blob");
+    }
+  }
 }
 
 static bool try_find_baked_data(const NodesModifierBake &bake,
@@ -1133,7 +1151,7 @@ static bool try_find_baked_data(const NodesModifierBake &bake,
     frame_cache->meta_data_source = meta_file.path;
     bake_cache.frames.append(std::move(frame_cache));
   }
-  bake_cache.blobs_dir = bake_path->blobs_dir;
+  bake_cache.disk_blob_reader = std::make_unique<bake::DiskBlobReader>(bake_path->blobs_dir);
   bake_cache.blob_sharing = std::make_unique<bake::BlobReadSharing>();
   return true;
 }
@@ -272,7 +272,7 @@ ModifierTypeInfo modifierType_Remesh = {
     /*srna*/ &RNA_RemeshModifier,
     /*type*/ ModifierTypeType::Nonconstructive,
     /*flags*/ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
-        eModifierTypeFlag_SupportsEditmode,
+        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_CacheableResult,
     /*icon*/ ICON_MOD_REMESH,
 
     /*copy_data*/ BKE_modifier_copydata_generic,
@@ -1140,7 +1140,8 @@ ModifierTypeInfo modifierType_Screw = {
     /*type*/ ModifierTypeType::Constructive,
 
     /*flags*/ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
-        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_EnableInEditmode,
+        eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_EnableInEditmode |
+        eModifierTypeFlag_CacheableResult,
     /*icon*/ ICON_MOD_SCREW,
 
     /*copy_data*/ BKE_modifier_copydata_generic,
@@ -254,7 +254,7 @@ ModifierTypeInfo modifierType_Solidify = {
 
     /*flags*/ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_AcceptsCVs |
         eModifierTypeFlag_SupportsMapping | eModifierTypeFlag_SupportsEditmode |
-        eModifierTypeFlag_EnableInEditmode,
+        eModifierTypeFlag_EnableInEditmode | eModifierTypeFlag_CacheableResult,
     /*icon*/ ICON_MOD_SOLIDIFY,
 
     /*copy_data*/ BKE_modifier_copydata_generic,
@@ -85,6 +85,9 @@ static void free_runtime_data(void *runtime_data_v)
   if (runtime_data->subdiv_gpu != nullptr) {
     blender::bke::subdiv::free(runtime_data->subdiv_gpu);
   }
+  if (runtime_data->subdiv_gpu_mesh != nullptr) {
+    blender::bke::subdiv::free(runtime_data->subdiv_gpu_mesh);
+  }
   MEM_freeN(runtime_data);
 }
 
@@ -143,6 +146,12 @@ static Mesh *subdiv_as_mesh(SubsurfModifierData *smd,
   if (mesh_settings.resolution < 3) {
     return result;
   }
+  SubsurfRuntimeData *runtime_data = static_cast<SubsurfRuntimeData *>(smd->modifier.runtime);
+  /* Only used when a GPU context is active on this thread, otherwise evaluate on the CPU. */
+  result = BKE_subsurf_modifier_subdiv_to_mesh_gpu(runtime_data, mesh, mesh_settings);
+  if (result != nullptr) {
+    return result;
+  }
   result = blender::bke::subdiv::subdiv_to_mesh(subdiv, &mesh_settings, mesh);
   return result;
 }
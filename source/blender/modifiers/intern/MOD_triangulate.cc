@@ -128,7 +128,7 @@ ModifierTypeInfo modifierType_Triangulate = {
     /*type*/ ModifierTypeType::Constructive,
     /*flags*/ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
         eModifierTypeFlag_SupportsMapping | eModifierTypeFlag_EnableInEditmode |
-        eModifierTypeFlag_AcceptsCVs,
+        eModifierTypeFlag_AcceptsCVs | eModifierTypeFlag_CacheableResult,
     /*icon*/ ICON_MOD_TRIANGULATE,
 
     /*copy_data*/ BKE_modifier_copydata_generic,
@@ -190,6 +190,7 @@ static void warpModifier_do(WarpModifierData *wmd,
   const MDeformVert *dvert, *dv = nullptr;
   const bool invert_vgroup = (wmd->flag & MOD_WARP_INVERT_VGROUP) != 0;
   float(*tex_co)[3] = nullptr;
+  TexResult *tex_results = nullptr;
 
   if (!(wmd->object_from && wmd->object_to)) {
     return;
@@ -238,6 +239,12 @@ static void warpModifier_do(WarpModifierData *wmd,
     MOD_get_texture_coords((MappingInfoModifierData *)wmd, ctx, ob, mesh, vertexCos, tex_co);
 
     MOD_init_texture((MappingInfoModifierData *)wmd, ctx);
+
+    if (wmd->falloff_type == eWarp_Falloff_None) {
+      /* Without falloff the texture is needed for every vertex, evaluate it in bulk. */
+      tex_results = MEM_malloc_arrayN<TexResult>(size_t(verts_num), __func__);
+      BKE_texture_get_values(tex_target, tex_co, verts_num, tex_results, false);
+    }
   }
 
   for (i = 0; i < verts_num; i++) {
@@ -291,7 +298,10 @@ static void warpModifier_do(WarpModifierData *wmd,
 
       fac *= weight;
 
-      if (tex_co) {
+      if (tex_results) {
+        fac *= tex_results[i].tin;
+      }
+      else if (tex_co) {
         TexResult texres;
         BKE_texture_get_value(tex_target, tex_co[i], &texres, false);
         fac *= texres.tin;
@@ -326,6 +336,7 @@ static void warpModifier_do(WarpModifierData *wmd,
   if (tex_co) {
     MEM_freeN(tex_co);
   }
+  MEM_SAFE_FREE(tex_results);
 }
 
 static void deform_verts(ModifierData *md,
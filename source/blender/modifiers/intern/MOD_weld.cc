@@ -103,6 +103,17 @@ static std::optional<Mesh *> calculate_weld(const Mesh &mesh, const WeldModifier
     return blender::geometry::mesh_merge_by_distance_all(
         mesh, IndexMask(mesh.verts_num), wmd.merge_dist);
   }
+  if (wmd.mode == MOD_WELD_MODE_CLUSTERS) {
+    if (!vertex_group.is_empty()) {
+      IndexMaskMemory memory;
+      const IndexMask selected_indices = selected_indices_from_vertex_group(
+          vertex_group, defgrp_index, invert, memory);
+      return blender::geometry::mesh_merge_by_distance_clusters(
+          mesh, selected_indices, wmd.merge_dist);
+    }
+    return blender::geometry::mesh_merge_by_distance_clusters(
+        mesh, IndexMask(mesh.verts_num), wmd.merge_dist);
+  }
   if (wmd.mode == MOD_WELD_MODE_CONNECTED) {
     const bool only_loose_edges = (wmd.flag & MOD_WELD_LOOSE_EDGES) != 0;
     if (!vertex_group.is_empty()) {
@@ -185,7 +196,7 @@ ModifierTypeInfo modifierType_Weld = {
     /*flags*/
     (eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsMapping |
      eModifierTypeFlag_SupportsEditmode | eModifierTypeFlag_EnableInEditmode |
-     eModifierTypeFlag_AcceptsCVs),
+     eModifierTypeFlag_AcceptsCVs | eModifierTypeFlag_CacheableResult),
     /*icon*/ ICON_AUTOMERGE_OFF, /* TODO: Use correct icon. */
 
     /*copy_data*/ BKE_modifier_copydata_generic,
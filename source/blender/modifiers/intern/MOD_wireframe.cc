@@ -164,7 +164,8 @@ ModifierTypeInfo modifierType_Wireframe = {
     /*struct_size*/ sizeof(WireframeModifierData),
     /*srna*/ &RNA_WireframeModifier,
     /*type*/ ModifierTypeType::Constructive,
-    /*flags*/ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode,
+    /*flags*/ eModifierTypeFlag_AcceptsMesh | eModifierTypeFlag_SupportsEditmode |
+        eModifierTypeFlag_CacheableResult,
     /*icon*/ ICON_MOD_WIREFRAME,
 
     /*copy_data*/ BKE_modifier_copydata_generic,
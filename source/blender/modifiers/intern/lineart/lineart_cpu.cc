@@ -11,12 +11,14 @@
 #include "MOD_lineart.hh"
 
 #include "BLI_listbase.h"
+#include "BLI_map.hh"
 #include "BLI_math_geom.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_matrix.hh"
 #include "BLI_math_rotation.h"
 #include "BLI_sort.hh"
 #include "BLI_task.h"
+#include "BLI_task.hh"
 #include "BLI_time.h"
 #include "BLI_utildefines.h"
 #include "BLI_vector.hh"
@@ -3429,6 +3431,9 @@ static void lineart_triangle_intersect_in_bounding_area(LineartTriangle *tri,
   }
 
   double *G0 = tri->v[0]->gloc, *G1 = tri->v[1]->gloc, *G2 = tri->v[2]->gloc;
+  const double min_x = std::min({G0[0], G1[0], G2[0]}), max_x = std::max({G0[0], G1[0], G2[0]});
+  const double min_y = std::min({G0[1], G1[1], G2[1]}), max_y = std::max({G0[1], G1[1], G2[1]});
+  const double min_z = std::min({G0[2], G1[2], G2[2]}), max_z = std::max({G0[2], G1[2], G2[2]});
 
   /* If this _is_ the smallest subdivision bounding area, then do the intersections there. */
   for (int i = 0; i < up_to; i++) {
@@ -3454,12 +3459,12 @@ static void lineart_triangle_intersect_in_bounding_area(LineartTriangle *tri,
            *RG2 = testing_triangle->v[2]->gloc;
 
     /* Bounding box not overlapping or triangles share edges, not potential of intersecting. */
-    if ((std::min({G0[2], G1[2], G2[2]}) > std::max({RG0[2], RG1[2], RG2[2]})) ||
-        (std::max({G0[2], G1[2], G2[2]}) < std::min({RG0[2], RG1[2], RG2[2]})) ||
-        (std::min({G0[0], G1[0], G2[0]}) > std::max({RG0[0], RG1[0], RG2[0]})) ||
-        (std::max({G0[0], G1[0], G2[0]}) < std::min({RG0[0], RG1[0], RG2[0]})) ||
-        (std::min({G0[1], G1[1], G2[1]}) > std::max({RG0[1], RG1[1], RG2[1]})) ||
-        (std::max({G0[1], G1[1], G2[1]}) < std::min({RG0[1], RG1[1], RG2[1]})) ||
+    if ((min_z > std::max({RG0[2], RG1[2], RG2[2]})) ||
+        (max_z < std::min({RG0[2], RG1[2], RG2[2]})) ||
+        (min_x > std::max({RG0[0], RG1[0], RG2[0]})) ||
+        (max_x < std::min({RG0[0], RG1[0], RG2[0]})) ||
+        (min_y > std::max({RG0[1], RG1[1], RG2[1]})) ||
+        (max_y < std::min({RG0[1], RG1[1], RG2[1]})) ||
         lineart_triangle_share_edge(tri, testing_triangle))
     {
       continue;
@@ -4647,74 +4652,84 @@ static void lineart_create_edges_from_isec_data(LineartIsecData *d)
   eln->flags |= LRT_ELEMENT_INTERSECTION_DATA;
   BLI_addhead(&ld->geom.line_buffer_pointers, eln);
 
+  /* Look up the objects of the intersecting triangles once per object instead of once per line.
+   * Like #lineart_find_matching_eln, the first element node of an object index wins. */
+  blender::Map<int, Object *> object_by_obindex;
+  LISTBASE_FOREACH (LineartElementLinkNode *, line_eln, &ld->geom.line_buffer_pointers) {
+    object_by_obindex.add(line_eln->obindex, static_cast<Object *>(line_eln->object_ref));
+  }
+
+  int line_offset = 0;
   for (int i = 0; i < d->thread_count; i++) {
     LineartIsecThread *th = &d->threads[i];
     if (!th->current) {
       continue;
     }
 
-    for (int j = 0; j < th->current; j++) {
-      LineartIsecSingle *is = &th->array[j];
-      LineartVert *v1 = v;
-      LineartVert *v2 = v + 1;
-      copy_v3_v3_db(v1->gloc, is->v1);
-      copy_v3_v3_db(v2->gloc, is->v2);
-      /* The intersection line has been generated only in geometry space, so we need to transform
-       * them as well. */
-      mul_v4_m4v3_db(v1->fbcoord, ld->conf.view_projection, v1->gloc);
-      mul_v4_m4v3_db(v2->fbcoord, ld->conf.view_projection, v2->gloc);
-      mul_v3db_db(v1->fbcoord, (1 / v1->fbcoord[3]));
-      mul_v3db_db(v2->fbcoord, (1 / v2->fbcoord[3]));
-
-      v1->fbcoord[0] -= ld->conf.shift_x * 2;
-      v1->fbcoord[1] -= ld->conf.shift_y * 2;
-      v2->fbcoord[0] -= ld->conf.shift_x * 2;
-      v2->fbcoord[1] -= ld->conf.shift_y * 2;
-
-      /* This z transformation is not the same as the rest of the part, because the data don't go
-       * through normal perspective division calls in the pipeline, but this way the 3D result and
-       * occlusion on the generated line is correct, and we don't really use 2D for viewport stroke
-       * generation anyway. */
-      v1->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v1->fbcoord[2]) * (ZMax - ZMin));
-      v2->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v2->fbcoord[2]) * (ZMax - ZMin));
-      e->v1 = v1;
-      e->v2 = v2;
-      e->t1 = is->tri1;
-      e->t2 = is->tri2;
-      /* This is so we can also match intersection edges from shadow to later viewing stage. */
-      e->edge_identifier = (uint64_t(e->t1->target_reference) << 32) | e->t2->target_reference;
-      e->flags = MOD_LINEART_EDGE_FLAG_INTERSECTION;
-      e->intersection_mask = (is->tri1->intersection_mask | is->tri2->intersection_mask);
-      BLI_addtail(&e->segments, es);
-
-      int obi1 = (e->t1->target_reference & LRT_OBINDEX_HIGHER);
-      int obi2 = (e->t2->target_reference & LRT_OBINDEX_HIGHER);
-      LineartElementLinkNode *eln1 = lineart_find_matching_eln(&ld->geom.line_buffer_pointers,
-                                                               obi1);
-      LineartElementLinkNode *eln2 = obi1 == obi2 ? eln1 :
-                                                    lineart_find_matching_eln(
-                                                        &ld->geom.line_buffer_pointers, obi2);
-      Object *ob1 = eln1 ? static_cast<Object *>(eln1->object_ref) : nullptr;
-      Object *ob2 = eln2 ? static_cast<Object *>(eln2->object_ref) : nullptr;
-      if (e->t1->intersection_priority > e->t2->intersection_priority) {
-        e->object_ref = ob1;
-      }
-      else if (e->t1->intersection_priority < e->t2->intersection_priority) {
-        e->object_ref = ob2;
-      }
-      else { /* equal priority */
-        if (ob1 == ob2) {
-          /* object_ref should be ambiguous if intersection lines comes from different objects. */
-          e->object_ref = ob1;
-        }
-      }
-
-      lineart_add_edge_to_array(&ld->pending_edges, e);
+    blender::threading::parallel_for(
+        blender::IndexRange(th->current), 1024, [&](const blender::IndexRange range) {
+          for (const int j : range) {
+            LineartIsecSingle *is = &th->array[j];
+            LineartVert *v1 = &v[(line_offset + j) * 2];
+            LineartVert *v2 = v1 + 1;
+            LineartEdge *ie = &e[line_offset + j];
+            LineartEdgeSegment *ies = &es[line_offset + j];
+            copy_v3_v3_db(v1->gloc, is->v1);
+            copy_v3_v3_db(v2->gloc, is->v2);
+            /* The intersection line has been generated only in geometry space, so we need to
+             * transform them as well. */
+            mul_v4_m4v3_db(v1->fbcoord, ld->conf.view_projection, v1->gloc);
+            mul_v4_m4v3_db(v2->fbcoord, ld->conf.view_projection, v2->gloc);
+            mul_v3db_db(v1->fbcoord, (1 / v1->fbcoord[3]));
+            mul_v3db_db(v2->fbcoord, (1 / v2->fbcoord[3]));
+
+            v1->fbcoord[0] -= ld->conf.shift_x * 2;
+            v1->fbcoord[1] -= ld->conf.shift_y * 2;
+            v2->fbcoord[0] -= ld->conf.shift_x * 2;
+            v2->fbcoord[1] -= ld->conf.shift_y * 2;
+
+            /* This z transformation is not the same as the rest of the part, because the data
+             * don't go through normal perspective division calls in the pipeline, but this way
+             * the 3D result and occlusion on the generated line is correct, and we don't really
+             * use 2D for viewport stroke generation anyway. */
+            v1->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v1->fbcoord[2]) * (ZMax - ZMin));
+            v2->fbcoord[2] = ZMin * ZMax / (ZMax - fabs(v2->fbcoord[2]) * (ZMax - ZMin));
+            ie->v1 = v1;
+            ie->v2 = v2;
+            ie->t1 = is->tri1;
+            ie->t2 = is->tri2;
+            /* This is so we can also match intersection edges from shadow to later viewing
+             * stage. */
+            ie->edge_identifier = (uint64_t(ie->t1->target_reference) << 32) |
+                                  ie->t2->target_reference;
+            ie->flags = MOD_LINEART_EDGE_FLAG_INTERSECTION;
+            ie->intersection_mask = (is->tri1->intersection_mask | is->tri2->intersection_mask);
+            BLI_addtail(&ie->segments, ies);
+
+            const int obi1 = (ie->t1->target_reference & LRT_OBINDEX_HIGHER);
+            const int obi2 = (ie->t2->target_reference & LRT_OBINDEX_HIGHER);
+            Object *ob1 = object_by_obindex.lookup_default(obi1, nullptr);
+            Object *ob2 = object_by_obindex.lookup_default(obi2, nullptr);
+            if (ie->t1->intersection_priority > ie->t2->intersection_priority) {
+              ie->object_ref = ob1;
+            }
+            else if (ie->t1->intersection_priority < ie->t2->intersection_priority) {
+              ie->object_ref = ob2;
+            }
+            else { /* equal priority */
+              if (ob1 == ob2) {
+                /* object_ref should be ambiguous if intersection lines comes from different
+                 * objects. */
+                ie->object_ref = ob1;
+              }
+            }
+          }
+        });
+    line_offset += th->current;
+  }
 
-      v += 2;
-      e++;
-      es++;
-    }
+  for (int i = 0; i < total_lines; i++) {
+    lineart_add_edge_to_array(&ld->pending_edges, &e[i]);
   }
 }
 
@@ -508,12 +508,14 @@ class ScopedComputeContextTimer {
 
 /**
  * Utility to measure the time that is spend in a specific node during geometry nodes evaluation.
+ * The memory allocated and copied by the node is measured as well.
  */
 class ScopedNodeTimer {
  private:
   const lf::Context &context_;
   const bNode &node_;
   geo_eval_log::TimePoint start_;
+  geo_eval_log::ResourceUsageMeasurement resources_;
 
  public:
   ScopedNodeTimer(const lf::Context &context, const bNode &node) : context_(context), node_(node)
@@ -524,12 +526,13 @@ class ScopedNodeTimer {
   ~ScopedNodeTimer()
   {
     const geo_eval_log::TimePoint end = geo_eval_log::Clock::now();
+    const geo_eval_log::ResourceUsage resources = resources_.finish();
     auto &user_data = static_cast<GeoNodesUserData &>(*context_.user_data);
     auto &local_user_data = static_cast<GeoNodesLocalUserData &>(*context_.local_user_data);
     if (geo_eval_log::GeoTreeLogger *tree_logger = local_user_data.try_get_tree_logger(user_data))
     {
       tree_logger->node_execution_times.append(*tree_logger->allocator,
-                                               {node_.identifier, start_, end});
+                                               {node_.identifier, start_, end, resources});
     }
   }
 };
@@ -29,6 +29,9 @@
 #pragma once
 
 #include <chrono>
+#include <iosfwd>
+
+#include "MEM_guardedalloc.h"
 
 #include "BLI_compute_context.hh"
 #include "BLI_enumerable_thread_specific.hh"
@@ -246,6 +249,44 @@ class ViewerNodeLog {
 using Clock = std::chrono::steady_clock;
 using TimePoint = Clock::time_point;
 
+/**
+ * Memory allocated and copy-on-write copies made by the thread evaluating a node. Work that the
+ * node passes to other threads is not included.
+ */
+struct ResourceUsage {
+  int64_t allocated_bytes = 0;
+  int64_t allocations_num = 0;
+  /** Largest amount of memory held at once by the allocations of the measured code. */
+  int64_t peak_memory = 0;
+  int64_t copy_on_write_num = 0;
+  int64_t copy_on_write_bytes = 0;
+
+  void add(const ResourceUsage &other)
+  {
+    allocated_bytes += other.allocated_bytes;
+    allocations_num += other.allocations_num;
+    peak_memory = std::max(peak_memory, other.peak_memory);
+    copy_on_write_num += other.copy_on_write_num;
+    copy_on_write_bytes += other.copy_on_write_bytes;
+  }
+};
+
+/**
+ * Measures the #ResourceUsage of the code running on the current thread between construction and
+ * #finish. Measurements can be nested.
+ */
+class ResourceUsageMeasurement {
+ private:
+  MEM_ThreadAllocStats start_alloc_stats_;
+  implicit_sharing::CopyOnWriteStats start_copy_on_write_stats_;
+
+ public:
+  ResourceUsageMeasurement();
+
+  /** Has to be called exactly once, on the same thread that constructed the measurement. */
+  ResourceUsage finish();
+};
+
 /**
  * Logs all data for a specific geometry node tree in a specific context. When the same node group
  * is used in multiple times each instantiation will have a separate logger.
@@ -278,6 +319,7 @@ class GeoTreeLogger {
     int32_t node_id;
     TimePoint start;
     TimePoint end;
+    ResourceUsage resources;
   };
   struct ViewerNodeLogWithNode {
     int32_t node_id;
@@ -327,6 +369,8 @@ class GeoNodeLog {
   VectorSet<NodeWarning> warnings;
   /** Time spent in this node. */
   std::chrono::nanoseconds execution_time{0};
+  /** Memory allocated and data copied by this node, gathered with the execution time. */
+  ResourceUsage resources;
   /** Maps from socket indices to their values. */
   Map<int, ValueLog *> input_values_;
   Map<int, ValueLog *> output_values_;
@@ -473,6 +517,12 @@ class GeoModifierLog {
    */
   GeoTreeLog &get_tree_log(const ComputeContextHash &compute_context_hash);
 
+  /**
+   * Write the execution time and #ResourceUsage of every logged node, and how busy each thread
+   * was, as JSON. The node trees are looked up in the given main database to get node names.
+   */
+  void write_profile_json(std::ostream &stream, const Main &bmain);
+
   /**
    * Utility accessor to logged data.
    */
@@ -480,6 +530,8 @@ class GeoModifierLog {
   get_context_hash_by_zone_for_node_editor(const SpaceNode &snode,
                                            bke::ComputeContextCache &compute_context_cache);
 
+  /** Get the log of the evaluation shown in the node editor, if there is any. */
+  static GeoModifierLog *get_root_log(const SpaceNode &snode);
   static ContextualGeoTreeLogs get_contextual_tree_logs(const SpaceNode &snode);
   static const ViewerNodeLog *find_viewer_node_log_for_path(const ViewerPath &viewer_path);
 };
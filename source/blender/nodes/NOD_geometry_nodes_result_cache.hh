@@ -0,0 +1,83 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+#pragma once
+
+/** \file
+ * \ingroup nodes
+ *
+ * Utilities to cache the results of expensive geometry nodes across evaluations, using the global
+ * #memory_cache. Input geometries are identified by the implicitly shared arrays they reference
+ * instead of by hashing their contents, so looking up a result is cheap. When the upstream part of
+ * a node tree did not change, its outputs still share their data with the previous evaluation and
+ * the cached result is used without recomputing or copying it.
+ */
+
+#include <optional>
+#include <string>
+
+#include "BLI_memory_cache.hh"
+#include "BLI_vector.hh"
+
+#include "BKE_geometry_set.hh"
+
+#include "NOD_geometry_nodes_log.hh"
+
+struct Mesh;
+
+namespace blender::nodes {
+
+/**
+ * Identifies the data of a mesh by the implicitly shared arrays that store its attributes. Two
+ * meshes with equal identities have the same data, as long as the arrays are kept alive and
+ * can't be modified. That is ensured by keeping a user of the geometries, see
+ * #CachedGeometryNodeResult::inputs.
+ */
+class MeshDataIdentity {
+  int verts_num_ = 0;
+  int edges_num_ = 0;
+  int faces_num_ = 0;
+  int corners_num_ = 0;
+  /** Sharing info and type of every attribute layer, combined with the layer names below. */
+  Vector<std::pair<const ImplicitSharingInfo *, int>> layers_;
+  Vector<std::string> names_;
+  uint64_t hash_ = 0;
+
+ public:
+  /**
+   * \return Nothing when some of the mesh data is not implicitly shared, in which case it can't
+   * be identified without comparing its contents.
+   */
+  static std::optional<MeshDataIdentity> from_mesh(const Mesh &mesh);
+
+  uint64_t hash() const
+  {
+    return hash_;
+  }
+
+  friend bool operator==(const MeshDataIdentity &a, const MeshDataIdentity &b);
+};
+
+/**
+ * Result of a node evaluation stored in the memory cache.
+ */
+class CachedGeometryNodeResult : public memory_cache::CachedValue {
+ public:
+  /**
+   * The geometries the cache key refers to. Keeping a user of them ensures that their data is not
+   * freed or modified in place while the result is cached, which would make the key invalid.
+   */
+  Vector<bke::GeometrySet> inputs;
+  bke::GeometrySet result;
+  Vector<std::pair<geo_eval_log::NodeWarningType, std::string>> warnings;
+
+  void count_memory(MemoryCounter &memory) const override;
+
+  StringRefNull category() const override
+  {
+    return "Geometry Nodes Results";
+  }
+};
+
+}  // namespace blender::nodes
@@ -52,9 +52,9 @@ class ViewerOperation : public NodeOperation {
 
   void execute() override
   {
-    /* Viewers are treated as composite outputs that should be in the bounds of the compositing
-     * region, so do nothing if the compositing region is invalid. */
-    if (this->context().treat_viewer_as_composite_output() &&
+    /* Viewers might be limited to the bounds of the compositing region like composite outputs,
+     * so do nothing if the compositing region is invalid in that case. */
+    if (this->context().write_viewer_to_compositing_region() &&
         !this->context().is_valid_compositing_region())
     {
       return;
@@ -82,7 +82,14 @@ class ViewerOperation : public NodeOperation {
       GPU_texture_clear(output, GPU_DATA_FLOAT, color);
     }
     else {
-      parallel_for(domain.size, [&](const int2 texel) { output.store_pixel(texel, color); });
+      const Bounds<int2> bounds = this->get_output_bounds();
+      parallel_for(domain.size, [&](const int2 texel) {
+        const int2 output_texel = texel + bounds.min;
+        if (output_texel.x > bounds.max.x || output_texel.y > bounds.max.y) {
+          return;
+        }
+        output.store_pixel(output_texel, color);
+      });
     }
   }
 
@@ -142,9 +149,8 @@ class ViewerOperation : public NodeOperation {
    * the output. */
   Bounds<int2> get_output_bounds()
   {
-    /* Viewers are treated as composite outputs that should be in the bounds of the compositing
-     * region. */
-    if (context().treat_viewer_as_composite_output()) {
+    /* Viewers might be limited to the bounds of the compositing region like composite outputs. */
+    if (context().write_viewer_to_compositing_region()) {
       const rcti compositing_region = context().get_compositing_region();
       return Bounds<int2>(int2(compositing_region.xmin, compositing_region.ymin),
                           int2(compositing_region.xmax, compositing_region.ymax));
@@ -156,9 +162,8 @@ class ViewerOperation : public NodeOperation {
 
   Domain compute_domain() override
   {
-    /* Viewers are treated as composite outputs that should be in the domain of the compositing
-     * region. */
-    if (context().treat_viewer_as_composite_output()) {
+    /* Viewers might be limited to the domain of the compositing region like composite outputs. */
+    if (context().write_viewer_to_compositing_region()) {
       return Domain(context().get_compositing_region_size());
     }
 
@@ -4,10 +4,12 @@
 
 #include "BKE_geometry_set_instances.hh"
 #include "BKE_instances.hh"
+#include "BKE_mesh.hh"
 
 #include "DNA_mesh_types.h"
 #include "DNA_object_types.h"
 
+#include "NOD_geometry_nodes_result_cache.hh"
 #include "NOD_rna_define.hh"
 
 #include "UI_interface.hh"
@@ -100,6 +102,124 @@ static Array<short> calc_mesh_material_map(const Mesh &mesh, VectorSet<Material
   return map;
 }
 
+/**
+ * Identifies a boolean evaluation in the memory cache, so that the result can be reused when the
+ * node is evaluated again with the same inputs, e.g. when only unrelated parts of the node tree
+ * changed.
+ */
+class BooleanCacheKey : public GenericKey {
+ public:
+  geometry::boolean::Operation operation;
+  geometry::boolean::Solver solver;
+  bool use_self;
+  bool hole_tolerant;
+  std::optional<std::string> intersecting_edges_id;
+  Vector<MeshDataIdentity> meshes;
+  Vector<float4x4> transforms;
+  Vector<Array<short>> material_remaps;
+  Vector<Material *> materials;
+
+  uint64_t hash() const override
+  {
+    uint64_t hash = get_default_hash(int(this->operation), int(this->solver));
+    for (const MeshDataIdentity &mesh : this->meshes) {
+      hash = get_default_hash(hash, mesh.hash());
+    }
+    return hash;
+  }
+
+  friend bool operator==(const BooleanCacheKey &a, const BooleanCacheKey &b)
+  {
+    return a.operation == b.operation && a.solver == b.solver && a.use_self == b.use_self &&
+           a.hole_tolerant == b.hole_tolerant &&
+           a.intersecting_edges_id == b.intersecting_edges_id && a.meshes == b.meshes &&
+           a.transforms == b.transforms && a.material_remaps == b.material_remaps &&
+           a.materials == b.materials;
+  }
+
+  bool equal_to(const GenericKey &other) const override
+  {
+    if (const auto *other_typed = dynamic_cast<const BooleanCacheKey *>(&other)) {
+      return *this == *other_typed;
+    }
+    return false;
+  }
+
+  std::unique_ptr<GenericKey> to_storable() const override
+  {
+    return std::make_unique<BooleanCacheKey>(*this);
+  }
+};
+
+static std::unique_ptr<CachedGeometryNodeResult> compute_boolean(
+    const Span<const Mesh *> meshes,
+    const Span<float4x4> transforms,
+    const Span<Array<short>> material_remaps,
+    const Span<Material *> materials,
+    const geometry::boolean::Operation operation,
+    const geometry::boolean::Solver solver,
+    const bool use_self,
+    const bool hole_tolerant,
+    const AttributeOutputs &attribute_outputs)
+{
+  auto value = std::make_unique<CachedGeometryNodeResult>();
+
+  Vector<int> intersecting_edges;
+  geometry::boolean::BooleanOpParameters op_params;
+  op_params.boolean_mode = operation;
+  op_params.no_self_intersections = !use_self;
+  op_params.watertight = !hole_tolerant;
+  op_params.no_nested_components = true; /* TODO: make this configurable. */
+  geometry::boolean::BooleanError error = geometry::boolean::BooleanError::NoError;
+  Mesh *result = geometry::boolean::mesh_boolean(
+      meshes,
+      transforms,
+      material_remaps,
+      op_params,
+      solver,
+      attribute_outputs.intersecting_edges_id ? &intersecting_edges : nullptr,
+      &error);
+  if (error == geometry::boolean::BooleanError::NonManifold) {
+    value->warnings.append({NodeWarningType::Error, TIP_("An input was not manifold")});
+  }
+  else if (error == geometry::boolean::BooleanError::ResultTooBig) {
+    value->warnings.append(
+        {NodeWarningType::Error, TIP_("Boolean result is too big for solver to handle")});
+  }
+  else if (error == geometry::boolean::BooleanError::SolverNotAvailable) {
+    value->warnings.append(
+        {NodeWarningType::Error, TIP_("Boolean solver not available (compiled without it)")});
+  }
+  else if (error == geometry::boolean::BooleanError::UnknownError) {
+    value->warnings.append({NodeWarningType::Error, TIP_("Unknown Boolean error")});
+  }
+  if (!result) {
+    return value;
+  }
+
+  MEM_SAFE_FREE(result->mat);
+  result->mat = MEM_malloc_arrayN<Material *>(size_t(materials.size()), __func__);
+  result->totcol = materials.size();
+  MutableSpan(result->mat, result->totcol).copy_from(materials);
+
+  /* Store intersecting edges in attribute. */
+  if (attribute_outputs.intersecting_edges_id) {
+    MutableAttributeAccessor attributes = result->attributes_for_write();
+    SpanAttributeWriter<bool> selection = attributes.lookup_or_add_for_write_only_span<bool>(
+        *attribute_outputs.intersecting_edges_id, AttrDomain::Edge);
+
+    selection.span.fill(false);
+    for (const int i : intersecting_edges) {
+      selection.span[i] = true;
+    }
+    selection.finish();
+  }
+  geometry::debug_randomize_mesh_order(result);
+
+  value->result.replace_mesh(result);
+  return value;
+}
+
 static void node_geo_exec(GeoNodeExecParams params)
 {
   geometry::boolean::Operation operation = geometry::boolean::Operation(params.node().custom1);
@@ -183,59 +303,64 @@ static void node_geo_exec(GeoNodeExecParams params)
         "Intersecting Edges");
   }
 
-  Vector<int> intersecting_edges;
-  geometry::boolean::BooleanOpParameters op_params;
-  op_params.boolean_mode = operation;
-  op_params.no_self_intersections = !use_self;
-  op_params.watertight = !hole_tolerant;
-  op_params.no_nested_components = true; /* TODO: make this configurable. */
-  geometry::boolean::BooleanError error = geometry::boolean::BooleanError::NoError;
-  Mesh *result = geometry::boolean::mesh_boolean(
-      meshes,
-      transforms,
-      material_remaps,
-      op_params,
-      solver,
-      attribute_outputs.intersecting_edges_id ? &intersecting_edges : nullptr,
-      &error);
-  if (error == geometry::boolean::BooleanError::NonManifold) {
-    params.error_message_add(NodeWarningType::Error, TIP_("An input was not manifold"));
+  std::shared_ptr<const CachedGeometryNodeResult> value;
+  BooleanCacheKey key;
+  for (const Mesh *mesh : meshes) {
+    std::optional<MeshDataIdentity> identity = MeshDataIdentity::from_mesh(*mesh);
+    if (!identity) {
+      break;
+    }
+    key.meshes.append(std::move(*identity));
   }
-  else if (error == geometry::boolean::BooleanError::ResultTooBig) {
-    params.error_message_add(NodeWarningType::Error,
-                             TIP_("Boolean result is too big for solver to handle"));
+  if (key.meshes.size() == meshes.size()) {
+    key.operation = operation;
+    key.solver = solver;
+    key.use_self = use_self;
+    key.hole_tolerant = hole_tolerant;
+    key.intersecting_edges_id = attribute_outputs.intersecting_edges_id;
+    key.transforms = transforms;
+    key.material_remaps = material_remaps;
+    key.materials.extend(materials.as_span());
+    value = memory_cache::get<CachedGeometryNodeResult>(key, [&]() {
+      std::unique_ptr<CachedGeometryNodeResult> value = compute_boolean(meshes,
+                                                                        transforms,
+                                                                        material_remaps,
+                                                                        materials,
+                                                                        operation,
+                                                                        solver,
+                                                                        use_self,
+                                                                        hole_tolerant,
+                                                                        attribute_outputs);
+      /* Keep the input data alive and immutable while the result is cached. The copies share
+       * their arrays with the original meshes, so the key stays valid. */
+      for (const Mesh *mesh : meshes) {
+        value->inputs.append(GeometrySet::from_mesh(BKE_mesh_copy_for_eval(*mesh)));
+      }
+      return value;
+    });
   }
-  else if (error == geometry::boolean::BooleanError::SolverNotAvailable) {
-    params.error_message_add(NodeWarningType::Error,
-                             TIP_("Boolean solver not available (compiled without it)"));
+  else {
+    /* Some input data can't be identified cheaply, don't cache the result. */
+    value = compute_boolean(meshes,
+                            transforms,
+                            material_remaps,
+                            materials,
+                            operation,
+                            solver,
+                            use_self,
+                            hole_tolerant,
+                            attribute_outputs);
   }
-  else if (error == geometry::boolean::BooleanError::UnknownError) {
-    params.error_message_add(NodeWarningType::Error, TIP_("Unknown Boolean error"));
+
+  for (const auto &[type, message] : value->warnings) {
+    params.error_message_add(type, message);
   }
+  const MeshComponent *result = value->result.get_component<MeshComponent>();
   if (!result) {
     params.set_default_remaining_outputs();
     return;
   }
 
-  MEM_SAFE_FREE(result->mat);
-  result->mat = MEM_malloc_arrayN<Material *>(size_t(materials.size()), __func__);
-  result->totcol = materials.size();
-  MutableSpan(result->mat, result->totcol).copy_from(materials);
-
-  /* Store intersecting edges in attribute. */
-  if (attribute_outputs.intersecting_edges_id) {
-    MutableAttributeAccessor attributes = result->attributes_for_write();
-    SpanAttributeWriter<bool> selection = attributes.lookup_or_add_for_write_only_span<bool>(
-        *attribute_outputs.intersecting_edges_id, AttrDomain::Edge);
-
-    selection.span.fill(false);
-    for (const int i : intersecting_edges) {
-      selection.span[i] = true;
-    }
-    selection.finish();
-  }
-  geometry::debug_randomize_mesh_order(result);
-
   Vector<GeometrySet> all_geometries;
   all_geometries.append(set_a);
   all_geometries.extend(geometry_sets);
@@ -243,7 +368,8 @@ static void node_geo_exec(GeoNodeExecParams params)
   const std::array types_to_join = {GeometryComponent::Type::Edit};
   GeometrySet result_geometry = geometry::join_geometries(
       all_geometries, {}, std::make_optional(types_to_join));
-  result_geometry.replace_mesh(result);
+  /* The cached mesh is shared with the output, it is copied when modified further. */
+  result_geometry.add(*result);
   result_geometry.name = set_a.name;
 
   params.set_output("Mesh", std::move(result_geometry));
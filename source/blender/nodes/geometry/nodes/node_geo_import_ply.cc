@@ -35,6 +35,11 @@ class LoadPlyCache : public memory_cache::CachedValue {
   {
     this->geometry.count_memory(counter);
   }
+
+  StringRefNull category() const override
+  {
+    return "Imported Files";
+  }
 };
 
 static void node_geo_exec(GeoNodeExecParams params)
@@ -34,6 +34,11 @@ class LoadTextCache : public memory_cache::CachedValue {
   {
     counter.add(this->text.size());
   }
+
+  StringRefNull category() const override
+  {
+    return "Imported Files";
+  }
 };
 
 static void node_geo_exec(GeoNodeExecParams params)
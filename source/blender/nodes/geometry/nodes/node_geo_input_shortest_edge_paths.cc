@@ -118,11 +118,7 @@ class ShortestEdgePathsNextVertFieldInput final : public bke::MeshFieldInput {
           VArray<int>::ForContainer(std::move(next_index)), AttrDomain::Point, domain);
     }
 
-    const Span<int2> edges = mesh.edges();
-    Array<int> vert_to_edge_offset_data;
-    Array<int> vert_to_edge_indices;
-    const GroupedSpan<int> vert_to_edge = bke::mesh::build_vert_to_edge_map(
-        edges, mesh.verts_num, vert_to_edge_offset_data, vert_to_edge_indices);
+    const GroupedSpan<int> vert_to_edge = mesh.vert_to_edge_map();
     shortest_paths(mesh, vert_to_edge, end_selection, input_cost, next_index, cost);
 
     threading::parallel_for(next_index.index_range(), 1024, [&](const IndexRange range) {
@@ -201,11 +197,7 @@ class ShortestEdgePathsCostFieldInput final : public bke::MeshFieldInput {
     Array<int> next_index(mesh.verts_num, -1);
     Array<float> cost(mesh.verts_num, FLT_MAX);
 
-    const Span<int2> edges = mesh.edges();
-    Array<int> vert_to_edge_offset_data;
-    Array<int> vert_to_edge_indices;
-    const GroupedSpan<int> vert_to_edge = bke::mesh::build_vert_to_edge_map(
-        edges, mesh.verts_num, vert_to_edge_offset_data, vert_to_edge_indices);
+    const GroupedSpan<int> vert_to_edge = mesh.vert_to_edge_map();
     shortest_paths(mesh, vert_to_edge, end_selection, input_cost, next_index, cost);
 
     threading::parallel_for(cost.index_range(), 1024, [&](const IndexRange range) {
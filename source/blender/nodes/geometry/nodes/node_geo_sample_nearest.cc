@@ -234,9 +234,6 @@ class SampleNearestFunction : public mf::MultiFunction {
 
   const GeometryComponent *src_component_;
 
-  /* Point clouds do not cache BVH trees currently; avoid rebuilding it on every call. */
-  bke::BVHTreeFromPointCloud pointcloud_bvh = {};
-
   mf::Signature signature_;
 
  public:
@@ -245,12 +242,6 @@ class SampleNearestFunction : public mf::MultiFunction {
   {
     source_.ensure_owns_direct_data();
     this->src_component_ = find_source_component(source_, domain_);
-    if (src_component_ && src_component_->type() == bke::GeometryComponent::Type::PointCloud) {
-      const PointCloudComponent &component = *static_cast<const PointCloudComponent *>(
-          src_component_);
-      const PointCloud &points = *component.get();
-      pointcloud_bvh = bke::bvhtree_from_pointcloud_get(points, IndexMask(points.totpoint));
-    }
 
     mf::SignatureBuilder builder{"Sample Nearest", signature_};
     builder.single_input<float3>("Position");
@@ -290,7 +281,12 @@ class SampleNearestFunction : public mf::MultiFunction {
         break;
       }
       case GeometryComponent::Type::PointCloud: {
-        get_closest_pointcloud_points(pointcloud_bvh, positions, mask, indices, {});
+        const PointCloudComponent &component = *static_cast<const PointCloudComponent *>(
+            src_component_);
+        /* The BVH tree is cached on the point cloud, so it is shared with other nodes and with
+         * later evaluations as long as the positions don't change. */
+        const bke::BVHTreeFromPointCloud tree_data = component.get()->bvh_tree();
+        get_closest_pointcloud_points(tree_data, positions, mask, indices, {});
         break;
       }
       default:
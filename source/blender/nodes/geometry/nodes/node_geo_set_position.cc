@@ -2,6 +2,8 @@
  *
  * SPDX-License-Identifier: GPL-2.0-or-later */
 
+#include "BLI_array_utils.hh"
+
 #include "DNA_pointcloud_types.h"
 
 #include "BKE_curves.hh"
@@ -57,6 +59,31 @@ static void set_points_position(bke::MutableAttributeAccessor attributes,
                                      position_field);
 }
 
+static void set_mesh_position(Mesh &mesh,
+                              const Field<bool> &selection_field,
+                              const Field<float3> &position_field)
+{
+  const bke::MeshFieldContext context(mesh, bke::AttrDomain::Point);
+  fn::FieldEvaluator evaluator(context, mesh.verts_num);
+  evaluator.set_selection(selection_field);
+  evaluator.add(position_field);
+  evaluator.evaluate();
+
+  const IndexMask selection = evaluator.get_evaluated_selection_as_mask();
+  if (selection.is_empty()) {
+    return;
+  }
+  const VArray<float3> result = evaluator.get_evaluated<float3>(0);
+  if (result.is_span() && result.get_internal_span().data() == mesh.vert_positions().data()) {
+    /* The positions didn't change. */
+    return;
+  }
+  array_utils::copy(result, selection, mesh.vert_positions_for_write());
+  /* Often only a small part of the mesh is moved, in which case updating the existing normals and
+   * triangulation is much cheaper than recomputing them for the whole mesh. */
+  mesh.tag_positions_changed_partial(selection);
+}
+
 static void set_curves_position(bke::CurvesGeometry &curves,
                                 const fn::FieldContext &field_context,
                                 const Field<bool> &selection_field,
@@ -135,10 +162,7 @@ static void node_geo_exec(GeoNodeExecParams params)
                                   params.extract_input<Field<float3>>("Offset")}));
 
   if (Mesh *mesh = geometry.get_mesh_for_write()) {
-    set_points_position(mesh->attributes_for_write(),
-                        bke::MeshFieldContext(*mesh, bke::AttrDomain::Point),
-                        selection_field,
-                        position_field);
+    set_mesh_position(*mesh, selection_field, position_field);
   }
   if (PointCloud *pointcloud = geometry.get_pointcloud_for_write()) {
     set_points_position(pointcloud->attributes_for_write(),
@@ -7,7 +7,10 @@
 #include "NOD_geometry_nodes_closure.hh"
 #include "NOD_geometry_nodes_log.hh"
 
+#include <sstream>
+
 #include "BLI_listbase.h"
+#include "BLI_serialize.hh"
 #include "BLI_stack.hh"
 #include "BLI_string_ref.hh"
 #include "BLI_string_utf8.h"
@@ -260,6 +263,35 @@ NodeWarning::NodeWarning(const Report &report)
   this->message = report.message;
 }
 
+ResourceUsageMeasurement::ResourceUsageMeasurement()
+{
+  MEM_get_thread_alloc_stats(&start_alloc_stats_);
+  start_copy_on_write_stats_ = implicit_sharing::thread_copy_on_write_stats();
+  /* Track the peak of this measurement separately, it's merged back in #finish. */
+  MEM_set_thread_peak_memory(start_alloc_stats_.mem_in_use);
+}
+
+ResourceUsage ResourceUsageMeasurement::finish()
+{
+  MEM_ThreadAllocStats alloc_stats;
+  MEM_get_thread_alloc_stats(&alloc_stats);
+  const implicit_sharing::CopyOnWriteStats &copy_on_write_stats =
+      implicit_sharing::thread_copy_on_write_stats();
+  MEM_set_thread_peak_memory(
+      std::max(start_alloc_stats_.mem_in_use_peak, alloc_stats.mem_in_use_peak));
+
+  ResourceUsage usage;
+  usage.allocated_bytes = int64_t(alloc_stats.allocated_bytes - start_alloc_stats_.allocated_bytes);
+  usage.allocations_num = int64_t(alloc_stats.allocated_blocks -
+                                  start_alloc_stats_.allocated_blocks);
+  usage.peak_memory = alloc_stats.mem_in_use_peak - start_alloc_stats_.mem_in_use;
+  usage.copy_on_write_num = copy_on_write_stats.copies_num -
+                            start_copy_on_write_stats_.copies_num;
+  usage.copy_on_write_bytes = copy_on_write_stats.copied_bytes -
+                              start_copy_on_write_stats_.copied_bytes;
+  return usage;
+}
+
 /* Avoid generating these in every translation unit. */
 GeoModifierLog::GeoModifierLog() = default;
 GeoModifierLog::~GeoModifierLog() = default;
@@ -488,7 +520,9 @@ void GeoTreeLog::ensure_execution_times()
   for (GeoTreeLogger *tree_logger : tree_loggers_) {
     for (const GeoTreeLogger::NodeExecutionTime &timings : tree_logger->node_execution_times) {
       const std::chrono::nanoseconds duration = timings.end - timings.start;
-      this->nodes.lookup_or_add_default_as(timings.node_id).execution_time += duration;
+      GeoNodeLog &node_log = this->nodes.lookup_or_add_default_as(timings.node_id);
+      node_log.execution_time += duration;
+      node_log.resources.add(timings.resources);
     }
     this->execution_time += tree_logger->execution_time;
   }
@@ -846,6 +880,140 @@ GeoTreeLog &GeoModifierLog::get_tree_log(const ComputeContextHash &compute_conte
   return reduced_tree_log;
 }
 
+static double duration_to_seconds(const std::chrono::nanoseconds duration)
+{
+  return std::chrono::duration<double>(duration).count();
+}
+
+static std::string context_hash_to_string(const ComputeContextHash &hash)
+{
+  std::stringstream ss;
+  ss << hash;
+  return ss.str();
+}
+
+/**
+ * Time during which the thread was evaluating any node. Nodes can be nested (e.g. group nodes), so
+ * the union of the execution intervals is used.
+ */
+static std::chrono::nanoseconds busy_duration(
+    Vector<std::pair<TimePoint, TimePoint>> &execution_intervals)
+{
+  std::sort(execution_intervals.begin(), execution_intervals.end());
+  std::chrono::nanoseconds duration{0};
+  std::optional<std::pair<TimePoint, TimePoint>> current;
+  for (const std::pair<TimePoint, TimePoint> &interval : execution_intervals) {
+    if (current && interval.first <= current->second) {
+      current->second = std::max(current->second, interval.second);
+      continue;
+    }
+    if (current) {
+      duration += current->second - current->first;
+    }
+    current = interval;
+  }
+  if (current) {
+    duration += current->second - current->first;
+  }
+  return duration;
+}
+
+void GeoModifierLog::write_profile_json(std::ostream &stream, const Main &bmain)
+{
+  using namespace io::serialize;
+
+  Map<uint32_t, const bNodeTree *> tree_by_session_uid;
+  FOREACH_NODETREE_BEGIN (const_cast<Main *>(&bmain), tree, id) {
+    tree_by_session_uid.add_new(tree->id.session_uid, tree);
+  }
+  FOREACH_NODETREE_END;
+
+  DictionaryValue root;
+
+  /* The first logger found for every compute context, it has the information about the context
+   * that is the same for all threads. */
+  Map<ComputeContextHash, const GeoTreeLogger *> logger_by_context;
+  std::optional<TimePoint> begin;
+  std::optional<TimePoint> end;
+  std::chrono::nanoseconds total_busy_duration{0};
+  ArrayValue &threads = *root.append_array("threads");
+  for (LocalData &local_data : data_per_thread_) {
+    Vector<std::pair<TimePoint, TimePoint>> execution_intervals;
+    for (const auto item : local_data.tree_logger_by_context.items()) {
+      logger_by_context.add(item.key, item.value.get());
+      for (const GeoTreeLogger::NodeExecutionTime &timings : item.value->node_execution_times) {
+        execution_intervals.append({timings.start, timings.end});
+        begin = begin ? std::min(*begin, timings.start) : timings.start;
+        end = end ? std::max(*end, timings.end) : timings.end;
+      }
+    }
+    const std::chrono::nanoseconds duration = busy_duration(execution_intervals);
+    total_busy_duration += duration;
+    DictionaryValue &thread = *threads.append_dict();
+    thread.append_int("node_executions_num", execution_intervals.size());
+    thread.append_double("busy_time", duration_to_seconds(duration));
+  }
+  const std::chrono::nanoseconds wall_duration = begin ? *end - *begin :
+                                                         std::chrono::nanoseconds(0);
+  root.append_double("wall_time", duration_to_seconds(wall_duration));
+  /* Fraction of the available thread time that was spent evaluating nodes. */
+  root.append_double("thread_utilization",
+                     wall_duration.count() > 0 ?
+                         duration_to_seconds(total_busy_duration) /
+                             (duration_to_seconds(wall_duration) * threads.elements().size()) :
+                         0.0);
+
+  ArrayValue &contexts = *root.append_array("contexts");
+  for (const auto item : logger_by_context.items()) {
+    const GeoTreeLogger &logger = *item.value;
+    GeoTreeLog &tree_log = this->get_tree_log(item.key);
+    tree_log.ensure_execution_times();
+
+    const bNodeTree *tree = logger.tree_orig_session_uid ?
+                                tree_by_session_uid.lookup_default(*logger.tree_orig_session_uid,
+                                                                   nullptr) :
+                                nullptr;
+    DictionaryValue &context = *contexts.append_dict();
+    context.append_str("hash", context_hash_to_string(item.key));
+    if (logger.parent_hash) {
+      context.append_str("parent_hash", context_hash_to_string(*logger.parent_hash));
+    }
+    if (logger.parent_node_id) {
+      context.append_int("parent_node_id", *logger.parent_node_id);
+    }
+    context.append_str("tree", tree ? tree->id.name + 2 : "");
+    context.append_double("execution_time", duration_to_seconds(tree_log.execution_time));
+
+    /* Most expensive nodes first. */
+    Vector<std::pair<int32_t, const GeoNodeLog *>> node_logs;
+    for (const auto node_item : tree_log.nodes.items()) {
+      node_logs.append({node_item.key, &node_item.value});
+    }
+    std::sort(node_logs.begin(), node_logs.end(), [](const auto &a, const auto &b) {
+      return a.second->execution_time > b.second->execution_time;
+    });
+    ArrayValue &nodes = *context.append_array("nodes");
+    for (const auto &[node_id, node_log] : node_logs) {
+      const bNode *node = tree ? tree->node_by_id(node_id) : nullptr;
+      DictionaryValue &value = *nodes.append_dict();
+      value.append_int("id", node_id);
+      value.append_str("name", node ? node->name : "");
+      value.append_str("type", node ? node->idname : "");
+      value.append_double("execution_time", duration_to_seconds(node_log->execution_time));
+      const ResourceUsage &resources = node_log->resources;
+      value.append_int("allocated_bytes", resources.allocated_bytes);
+      value.append_int("allocations_num", resources.allocations_num);
+      value.append_int("peak_memory", resources.peak_memory);
+      value.append_int("copy_on_write_num", resources.copy_on_write_num);
+      value.append_int("copy_on_write_bytes", resources.copy_on_write_bytes);
+    }
+  }
+
+  JsonFormatter formatter;
+  formatter.indentation_len = 2;
+  formatter.serialize(stream, root);
+}
+
 static void find_tree_zone_hash_recursive(
     const bNodeTreeZone &zone,
     bke::ComputeContextCache &compute_context_cache,
@@ -884,7 +1052,7 @@ Map<const bNodeTreeZone *, ComputeContextHash> GeoModifierLog::
   return hash_by_zone;
 }
 
-static GeoModifierLog *get_root_log(const SpaceNode &snode)
+GeoModifierLog *GeoModifierLog::get_root_log(const SpaceNode &snode)
 {
   switch (SpaceNodeGeometryNodesType(snode.geometry_nodes_type)) {
     case SNODE_GEOMETRY_MODIFIER: {
@@ -909,7 +1077,7 @@ static GeoModifierLog *get_root_log(const SpaceNode &snode)
 
 ContextualGeoTreeLogs GeoModifierLog::get_contextual_tree_logs(const SpaceNode &snode)
 {
-  GeoModifierLog *log = get_root_log(snode);
+  GeoModifierLog *log = GeoModifierLog::get_root_log(snode);
   if (!log) {
     return {};
   }
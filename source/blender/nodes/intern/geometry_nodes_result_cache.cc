@@ -0,0 +1,90 @@
+/* SPDX-FileCopyrightText: 2025 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup nodes
+ */
+
+#include "BLI_hash.hh"
+#include "BLI_listbase.h"
+#include "BLI_memory_counter.hh"
+
+#include "DNA_mesh_types.h"
+#include "DNA_object_types.h"
+
+#include "BKE_mesh_types.hh"
+
+#include "NOD_geometry_nodes_result_cache.hh"
+
+namespace blender::nodes {
+
+static bool add_custom_data_layers(const CustomData &data,
+                                   Vector<std::pair<const ImplicitSharingInfo *, int>> &layers,
+                                   Vector<std::string> &names)
+{
+  for (const CustomDataLayer &layer : Span(data.layers, data.totlayer)) {
+    if (layer.sharing_info == nullptr) {
+      return false;
+    }
+    layers.append({layer.sharing_info, layer.type});
+    names.append(layer.name);
+  }
+  return true;
+}
+
+std::optional<MeshDataIdentity> MeshDataIdentity::from_mesh(const Mesh &mesh)
+{
+  MeshDataIdentity identity;
+  identity.verts_num_ = mesh.verts_num;
+  identity.edges_num_ = mesh.edges_num;
+  identity.faces_num_ = mesh.faces_num;
+  identity.corners_num_ = mesh.corners_num;
+
+  if (mesh.faces_num > 0) {
+    if (mesh.runtime->face_offsets_sharing_info == nullptr) {
+      return std::nullopt;
+    }
+    identity.layers_.append({mesh.runtime->face_offsets_sharing_info, -1});
+  }
+  for (const CustomData *data :
+       {&mesh.vert_data, &mesh.edge_data, &mesh.face_data, &mesh.corner_data})
+  {
+    if (!add_custom_data_layers(*data, identity.layers_, identity.names_)) {
+      return std::nullopt;
+    }
+  }
+  /* Vertex group names are not stored in the shared arrays. */
+  LISTBASE_FOREACH (const bDeformGroup *, group, &mesh.vertex_group_names) {
+    identity.names_.append(group->name);
+  }
+
+  uint64_t hash = get_default_hash(identity.verts_num_,
+                                   identity.edges_num_,
+                                   identity.faces_num_,
+                                   identity.corners_num_);
+  for (const std::pair<const ImplicitSharingInfo *, int> &layer : identity.layers_) {
+    hash = get_default_hash(hash, layer.first);
+  }
+  identity.hash_ = hash;
+  return identity;
+}
+
+bool operator==(const MeshDataIdentity &a, const MeshDataIdentity &b)
+{
+  return a.hash_ == b.hash_ && a.verts_num_ == b.verts_num_ && a.edges_num_ == b.edges_num_ &&
+         a.faces_num_ == b.faces_num_ && a.corners_num_ == b.corners_num_ &&
+         a.layers_ == b.layers_ && a.names_ == b.names_;
+}
+
+void CachedGeometryNodeResult::count_memory(MemoryCounter &memory) const
+{
+  /* The inputs are usually still used by the scene, but they may be kept alive only by the cache
+   * too, so count them as well. Shared data is only counted once. */
+  for (const bke::GeometrySet &geometry : this->inputs) {
+    geometry.count_memory(memory);
+  }
+  this->result.count_memory(memory);
+}
+
+}  // namespace blender::nodes
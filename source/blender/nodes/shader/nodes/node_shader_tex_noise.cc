@@ -164,6 +164,42 @@ static void node_shader_update_tex_noise(bNodeTree *ntree, bNode *node)
                                         storage.type == SHD_NOISE_RIDGED_MULTIFRACTAL);
 }
 
+/**
+ * Evaluate 3D fBM noise without distortion for all indices in chunks, so that the vectorized
+ * #noise::perlin_fbm can be used when the parameters are the same for all elements.
+ */
+static void perlin_fbm_batch(const IndexMask &mask,
+                             const VArray<float3> &vector,
+                             const float scale,
+                             const float detail,
+                             const float roughness,
+                             const float lacunarity,
+                             const bool normalize,
+                             MutableSpan<float> r_factor)
+{
+  constexpr int64_t chunk_size = 256;
+  mask.foreach_segment([&](const IndexMaskSegment segment) {
+    std::array<float3, chunk_size> positions;
+    std::array<float, chunk_size> values;
+    for (int64_t start = 0; start < segment.size(); start += chunk_size) {
+      const IndexMaskSegment chunk = segment.slice(start,
+                                                   std::min(chunk_size, segment.size() - start));
+      for (const int64_t i : chunk.index_range()) {
+        positions[i] = vector[chunk[i]] * scale;
+      }
+      noise::perlin_fbm(Span<float3>(positions.data(), chunk.size()),
+                        detail,
+                        roughness,
+                        lacunarity,
+                        normalize,
+                        MutableSpan<float>(values.data(), chunk.size()));
+      for (const int64_t i : chunk.index_range()) {
+        r_factor[chunk[i]] = values[i];
+      }
+    }
+  });
+}
+
 class NoiseFunction : public mf::MultiFunction {
  private:
   int dimensions_;
@@ -340,7 +376,20 @@ class NoiseFunction : public mf::MultiFunction {
       }
       case 3: {
         const VArray<float3> &vector = params.readonly_single_input<float3>(0, "Vector");
-        if (compute_factor) {
+        if (compute_factor && type_ == SHD_NOISE_FBM && scale.is_single() && detail.is_single() &&
+            roughness.is_single() && lacunarity.is_single() && distortion.is_single() &&
+            distortion.get_internal_single() == 0.0f)
+        {
+          perlin_fbm_batch(mask,
+                           vector,
+                           scale.get_internal_single(),
+                           math::clamp(detail.get_internal_single(), 0.0f, 15.0f),
+                           math::max(roughness.get_internal_single(), 0.0f),
+                           lacunarity.get_internal_single(),
+                           normalize_,
+                           r_factor);
+        }
+        else if (compute_factor) {
           mask.foreach_index([&](const int64_t i) {
             const float3 position = vector[i] * scale[i];
             r_factor[i] = noise::perlin_fractal_distorted(position,
@@ -224,6 +224,58 @@ static void node_shader_update_tex_voronoi(bNodeTree *ntree, bNode *node)
 
 static mf::MultiFunction::ExecutionHints voronoi_execution_hints{50, false};
 
+/**
+ * Evaluate 3D F1 Voronoi without fractal detail for all indices in chunks, so that the vectorized
+ * #noise::voronoi_f1 can be used when the parameters are the same for all elements. This does the
+ * same as #noise::fractal_voronoi_x_fx with a single octave.
+ */
+static void voronoi_f1_batch(const IndexMask &mask,
+                             const VArray<float3> &vector,
+                             const noise::VoronoiParams &params,
+                             MutableSpan<float> r_distance,
+                             MutableSpan<ColorGeometry4f> r_color,
+                             MutableSpan<float3> r_position)
+{
+  constexpr int64_t chunk_size = 256;
+  mask.foreach_segment([&](const IndexMaskSegment segment) {
+    std::array<float3, chunk_size> coords;
+    std::array<float, chunk_size> distances;
+    std::array<float3, chunk_size> colors;
+    std::array<float3, chunk_size> positions;
+    for (int64_t start = 0; start < segment.size(); start += chunk_size) {
+      const IndexMaskSegment chunk = segment.slice(start,
+                                                   std::min(chunk_size, segment.size() - start));
+      const int64_t size = chunk.size();
+      for (const int64_t i : chunk.index_range()) {
+        coords[i] = vector[chunk[i]] * params.scale;
+      }
+      noise::voronoi_f1(
+          params,
+          Span<float3>(coords.data(), size),
+          r_distance.is_empty() ? MutableSpan<float>() : MutableSpan(distances.data(), size),
+          r_color.is_empty() ? MutableSpan<float3>() : MutableSpan(colors.data(), size),
+          r_position.is_empty() ? MutableSpan<float3>() : MutableSpan(positions.data(), size));
+      if (!r_distance.is_empty()) {
+        for (const int64_t i : chunk.index_range()) {
+          r_distance[chunk[i]] = params.normalize ? distances[i] / params.max_distance :
+                                                    distances[i];
+        }
+      }
+      if (!r_color.is_empty()) {
+        for (const int64_t i : chunk.index_range()) {
+          r_color[chunk[i]] = ColorGeometry4f(colors[i].x, colors[i].y, colors[i].z, 1.0f);
+        }
+      }
+      if (!r_position.is_empty()) {
+        for (const int64_t i : chunk.index_range()) {
+          r_position[chunk[i]] = (params.scale != 0.0f) ? positions[i] / params.scale :
+                                                          float3(0.0f);
+        }
+      }
+    }
+  });
+}
+
 class VoronoiMetricFunction : public mf::MultiFunction {
  private:
   int dimensions_;
@@ -448,6 +500,29 @@ class VoronoiMetricFunction : public mf::MultiFunction {
         break;
       }
       case 3: {
+        if (feature_ == SHD_VORONOI_F1 && scale.is_single() && detail.is_single() &&
+            roughness.is_single() && randomness.is_single() &&
+            (metric_ != SHD_VORONOI_MINKOWSKI || exponent.is_single()))
+        {
+          params.detail = detail.get_internal_single();
+          params.roughness = roughness.get_internal_single();
+          if (params.detail >= 0.0f && (params.detail == 0.0f || params.roughness == 0.0f)) {
+            params.scale = scale.get_internal_single();
+            params.lacunarity = 0.0f;
+            params.smoothness = 0.0f;
+            params.exponent = ELEM(metric_, SHD_VORONOI_MINKOWSKI) ?
+                                  exponent.get_internal_single() :
+                                  0.0f;
+            params.randomness = std::min(std::max(randomness.get_internal_single(), 0.0f), 1.0f);
+            params.max_distance = noise::voronoi_distance(float3{0.0f, 0.0f, 0.0f},
+                                                          float3(0.5f + 0.5f * params.randomness,
+                                                                 0.5f + 0.5f * params.randomness,
+                                                                 0.5f + 0.5f * params.randomness),
+                                                          params);
+            voronoi_f1_batch(mask, vector, params, r_distance, r_color, r_position);
+            break;
+          }
+        }
         mask.foreach_index([&](const int64_t i) {
           params.scale = scale[i];
           params.detail = detail[i];
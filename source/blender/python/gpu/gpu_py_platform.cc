@@ -13,6 +13,9 @@
 
 #include "GPU_context.hh"
 #include "GPU_platform.hh"
+#include "GPU_storage_buffer.hh"
+#include "GPU_texture.hh"
+#include "GPU_vertex_buffer.hh"
 
 #include "gpu_py.hh"
 #include "gpu_py_platform.hh" /* Own include. */
@@ -146,6 +149,29 @@ static PyObject *pygpu_platform_backend_type_get(PyObject * /*self*/)
   return PyUnicode_FromString(backend);
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    pygpu_platform_memory_usage_get_doc,
+    ".. function:: memory_usage_get()\n"
+    "\n"
+    "   Get the GPU memory allocated by Blender, per type of resource in bytes.\n"
+    "   This is an estimate that doesn't include driver overhead.\n"
+    "\n"
+    "   :return: Dictionary with the ``TEXTURE``, ``VERTEX_BUFFER`` and ``STORAGE_BUFFER`` keys.\n"
+    "   :rtype: dict[str, int]\n");
+static PyObject *pygpu_platform_memory_usage_get(PyObject * /*self*/)
+{
+  BPYGPU_IS_INIT_OR_ERROR_OBJ;
+
+  return Py_BuildValue("{s:n,s:n,s:n}",
+                       "TEXTURE",
+                       Py_ssize_t(GPU_texture_memory_usage_get()),
+                       "VERTEX_BUFFER",
+                       Py_ssize_t(GPU_vertbuf_get_memory_usage()),
+                       "STORAGE_BUFFER",
+                       Py_ssize_t(GPU_storagebuf_memory_usage_get()));
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -183,6 +209,10 @@ static PyMethodDef pygpu_platform__tp_methods[] = {
      (PyCFunction)pygpu_platform_backend_type_get,
      METH_NOARGS,
      pygpu_platform_backend_type_get_doc},
+    {"memory_usage_get",
+     (PyCFunction)pygpu_platform_memory_usage_get,
+     METH_NOARGS,
+     pygpu_platform_memory_usage_get_doc},
     {nullptr, nullptr, 0, nullptr},
 };
 
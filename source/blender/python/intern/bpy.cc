@@ -800,6 +800,9 @@ void BPy_init_modules(bContext *C)
   PYMODULE_ADD_METHOD(mod, &meth_bpy_owner_id_get);
   PYMODULE_ADD_METHOD(mod, &meth_bpy_owner_id_set);
 
+  PYMODULE_ADD_METHOD(mod, &meth_bpy_register_class_ui_defer_set);
+  PYMODULE_ADD_METHOD(mod, &meth_bpy_register_deferred_ui_classes);
+
   /* Register command functions. */
   PYMODULE_ADD_METHOD(mod, &BPY_cli_command_register_def);
   PYMODULE_ADD_METHOD(mod, &BPY_cli_command_unregister_def);
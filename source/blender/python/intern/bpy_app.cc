@@ -35,6 +35,7 @@
 #include "bpy_app_icons.hh"
 #include "bpy_app_timers.hh"
 
+#include "BLI_memory_cache.hh"
 #include "BLI_utildefines.h"
 
 #include "BKE_appdir.hh"
@@ -632,6 +633,139 @@ static PyObject *bpy_app_help_text(PyObject * /*self*/, PyObject *args, PyObject
   return result;
 }
 
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_profiler_enable_doc,
+    ".. staticmethod:: memory_profiler_enable(sample_interval=524288)\n"
+    "\n"
+    "   Start recording a sample of the memory allocations, clearing previously recorded data.\n"
+    "   Only available with the default lock-free memory allocator.\n"
+    "\n"
+    "   :arg sample_interval: Average number of allocated bytes between recorded allocations.\n"
+    "   :type sample_interval: int\n");
+static PyObject *bpy_app_memory_profiler_enable(PyObject * /*self*/,
+                                                PyObject *args,
+                                                PyObject *kwds)
+{
+  Py_ssize_t sample_interval = 512 * 1024;
+  static const char *_keywords[] = {"sample_interval", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "n"  /* `sample_interval` */
+      ":memory_profiler_enable",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &sample_interval)) {
+    return nullptr;
+  }
+  if (sample_interval < 1) {
+    PyErr_SetString(PyExc_ValueError, "sample_interval must be at least 1");
+    return nullptr;
+  }
+  MEM_profiler_enable(size_t(sample_interval));
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_profiler_disable_doc,
+    ".. staticmethod:: memory_profiler_disable()\n"
+    "\n"
+    "   Stop recording memory allocations, the recorded data is kept for the report.\n");
+static PyObject *bpy_app_memory_profiler_disable(PyObject * /*self*/, PyObject * /*args*/)
+{
+  MEM_profiler_disable();
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_profiler_report_doc,
+    ".. staticmethod:: memory_profiler_report(sites=20)\n"
+    "\n"
+    "   Return a report of the allocation sites using the most memory, now and at the highest\n"
+    "   memory usage while profiling, followed by the memory usage over time.\n"
+    "\n"
+    "   :arg sites: The number of allocation sites to list.\n"
+    "   :type sites: int\n"
+    "   :return: The report.\n"
+    "   :rtype: str\n");
+static PyObject *bpy_app_memory_profiler_report(PyObject * /*self*/,
+                                                PyObject *args,
+                                                PyObject *kwds)
+{
+  int sites_num = 20;
+  static const char *_keywords[] = {"sites", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "i"  /* `sites` */
+      ":memory_profiler_report",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, &sites_num)) {
+    return nullptr;
+  }
+
+  char *buf = MEM_profiler_report(sites_num);
+  PyObject *result = PyUnicode_FromString(buf);
+  MEM_freeN(buf);
+  return result;
+}
+
+/** Set the item and release the reference to the value. */
+static void py_dict_set_item_steal(PyObject *dict, const char *key, PyObject *value)
+{
+  PyDict_SetItemString(dict, key, value);
+  Py_DECREF(value);
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_app_memory_cache_statistics_doc,
+    ".. staticmethod:: memory_cache_statistics()\n"
+    "\n"
+    "   Return the memory usage of the cache that is limited by the memory cache limit preference,\n"
+    "   in total and for each category of cached data. Image buffers and sequencer images are\n"
+    "   reported as external categories, which share the limit.\n"
+    "\n"
+    "   :return: A dictionary with the ``size``, ``external_size`` and ``limit`` in bytes,\n"
+    "      and ``categories``, which maps category names to dictionaries with the ``size``,\n"
+    "      ``limit`` (None if the category has no limit of its own), number of ``values``,\n"
+    "      ``hits``, ``misses``, ``evictions`` and whether the category is ``external``.\n"
+    "   :rtype: dict[str, int | dict[str, dict[str, int | bool | None]]]\n");
+static PyObject *bpy_app_memory_cache_statistics(PyObject * /*self*/, PyObject * /*args*/)
+{
+  const blender::memory_cache::Statistics statistics = blender::memory_cache::get_statistics();
+
+  PyObject *categories = PyDict_New();
+  for (const blender::memory_cache::CategoryStatistics &category : statistics.categories) {
+    PyObject *item = PyDict_New();
+    py_dict_set_item_steal(item, "size", PyLong_FromLongLong(category.size_in_bytes));
+    py_dict_set_item_steal(item,
+                           "limit",
+                           category.size_limit ? PyLong_FromLongLong(*category.size_limit) :
+                                                 Py_NewRef(Py_None));
+    py_dict_set_item_steal(item, "values", PyLong_FromLongLong(category.values_num));
+    py_dict_set_item_steal(item, "hits", PyLong_FromLongLong(category.hits));
+    py_dict_set_item_steal(item, "misses", PyLong_FromLongLong(category.misses));
+    py_dict_set_item_steal(item, "evictions", PyLong_FromLongLong(category.evictions));
+    py_dict_set_item_steal(item, "external", PyBool_FromLong(category.is_external));
+    py_dict_set_item_steal(categories, category.name.c_str(), item);
+  }
+
+  PyObject *result = PyDict_New();
+  py_dict_set_item_steal(result, "size", PyLong_FromLongLong(statistics.size_in_bytes));
+  py_dict_set_item_steal(
+      result, "external_size", PyLong_FromLongLong(statistics.external_size_in_bytes));
+  py_dict_set_item_steal(result, "limit", PyLong_FromLongLong(statistics.size_limit));
+  py_dict_set_item_steal(result, "categories", categories);
+  return result;
+}
+
 #ifdef __GNUC__
 #  ifdef __clang__
 #    pragma clang diagnostic push
@@ -651,6 +785,22 @@ static PyMethodDef bpy_app_methods[] = {
      (PyCFunction)bpy_app_help_text,
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_app_help_text_doc},
+    {"memory_profiler_enable",
+     (PyCFunction)bpy_app_memory_profiler_enable,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_memory_profiler_enable_doc},
+    {"memory_profiler_disable",
+     (PyCFunction)bpy_app_memory_profiler_disable,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_profiler_disable_doc},
+    {"memory_profiler_report",
+     (PyCFunction)bpy_app_memory_profiler_report,
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_app_memory_profiler_report_doc},
+    {"memory_cache_statistics",
+     (PyCFunction)bpy_app_memory_cache_statistics,
+     METH_NOARGS | METH_STATIC,
+     bpy_app_memory_cache_statistics_doc},
     {nullptr, nullptr, 0, nullptr},
 };
 
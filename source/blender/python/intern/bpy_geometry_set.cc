@@ -21,6 +21,7 @@
 #include "BKE_idtype.hh"
 #include "BKE_instances.hh"
 #include "BKE_lib_id.hh"
+#include "BKE_mesh.hh"
 #include "BKE_mesh_wrapper.hh"
 #include "BKE_pointcloud.hh"
 
@@ -35,6 +36,9 @@
 #include "RNA_enum_types.hh"
 #include "RNA_prototypes.hh"
 
+#include "BLI_color.hh"
+#include "BLI_math_vector_types.hh"
+
 #include "bpy_geometry_set.hh"
 #include "bpy_rna.hh"
 
@@ -165,6 +169,394 @@ static BPy_GeometrySet *BPy_GeometrySet_static_from_evaluated_object(PyObject *
   return self;
 }
 
+/** Releases a buffer that was filled by #PyObject_GetBuffer when it goes out of scope. */
+struct ScopedPyBuffer {
+  Py_buffer buffer = {};
+  bool is_valid = false;
+
+  ~ScopedPyBuffer()
+  {
+    if (this->is_valid) {
+      PyBuffer_Release(&this->buffer);
+    }
+  }
+};
+
+/** Get the struct module format character of a buffer, ignoring native byte order prefixes. */
+static char buffer_format_char(const Py_buffer &buffer)
+{
+  const char *format = buffer.format ? buffer.format : "B";
+  if (ELEM(format[0], '@', '=', '<') && format[1] != '\0') {
+    format++;
+  }
+  return format[1] == '\0' ? format[0] : '\0';
+}
+
+static bool buffer_format_is_float(const char format)
+{
+  return ELEM(format, 'f', 'd');
+}
+
+static bool buffer_format_is_int(const char format)
+{
+  return ELEM(format, 'b', 'B', 'h', 'H', 'i', 'I', 'l', 'L', 'q', 'Q', 'n', 'N');
+}
+
+/**
+ * Get a C-contiguous buffer of numbers with the given number of components per element, i.e. a
+ * one-dimensional array for a single component or a two-dimensional array otherwise.
+ */
+static bool buffer_get_array(PyObject *object,
+                             const char *name,
+                             const int components_num,
+                             ScopedPyBuffer &r_buffer,
+                             int &r_size)
+{
+  if (PyObject_GetBuffer(object, &r_buffer.buffer, PyBUF_C_CONTIGUOUS | PyBUF_FORMAT) == -1) {
+    PyErr_Clear();
+    PyErr_Format(PyExc_TypeError,
+                 "%s: expected a contiguous array supporting the buffer protocol, not %.200s",
+                 name,
+                 Py_TYPE(object)->tp_name);
+    return false;
+  }
+  r_buffer.is_valid = true;
+  const Py_buffer &buffer = r_buffer.buffer;
+  const char format = buffer_format_char(buffer);
+  if (!buffer_format_is_float(format) && !buffer_format_is_int(format) && format != '?') {
+    PyErr_Format(PyExc_TypeError, "%s: unsupported array type \"%s\"", name, buffer.format);
+    return false;
+  }
+  const bool valid_shape = (components_num == 1) ?
+                               (buffer.ndim == 1) :
+                               (buffer.ndim == 2 && buffer.shape[1] == components_num);
+  if (!valid_shape) {
+    if (components_num == 1) {
+      PyErr_Format(PyExc_ValueError, "%s: expected a one-dimensional array", name);
+    }
+    else {
+      PyErr_Format(PyExc_ValueError, "%s: expected an array of shape (n, %d)", name, components_num);
+    }
+    return false;
+  }
+  if (buffer.shape[0] > INT32_MAX) {
+    PyErr_Format(PyExc_ValueError, "%s: too many elements", name);
+    return false;
+  }
+  r_size = int(buffer.shape[0]);
+  return true;
+}
+
+template<typename Src, typename Dst>
+static void buffer_copy_typed(const void *src, blender::MutableSpan<Dst> dst)
+{
+  if constexpr (std::is_same_v<Src, Dst>) {
+    dst.copy_from(blender::Span<Dst>(static_cast<const Src *>(src), dst.size()));
+  }
+  else {
+    const Src *src_typed = static_cast<const Src *>(src);
+    for (const int64_t i : dst.index_range()) {
+      dst[i] = Dst(src_typed[i]);
+    }
+  }
+}
+
+/**
+ * Copy all values of the buffer, converting them to the destination type if necessary. The
+ * buffer has to be checked with #buffer_get_array before.
+ */
+template<typename Dst> static void buffer_copy(const Py_buffer &buffer, blender::MutableSpan<Dst> dst)
+{
+  BLI_assert(buffer.len == dst.size() * buffer.itemsize);
+  switch (buffer_format_char(buffer)) {
+    case 'f':
+      buffer_copy_typed<float>(buffer.buf, dst);
+      break;
+    case 'd':
+      buffer_copy_typed<double>(buffer.buf, dst);
+      break;
+    case '?':
+      buffer_copy_typed<bool>(buffer.buf, dst);
+      break;
+    case 'b':
+      buffer_copy_typed<signed char>(buffer.buf, dst);
+      break;
+    case 'B':
+      buffer_copy_typed<unsigned char>(buffer.buf, dst);
+      break;
+    case 'h':
+      buffer_copy_typed<short>(buffer.buf, dst);
+      break;
+    case 'H':
+      buffer_copy_typed<unsigned short>(buffer.buf, dst);
+      break;
+    case 'i':
+      buffer_copy_typed<int>(buffer.buf, dst);
+      break;
+    case 'I':
+      buffer_copy_typed<unsigned int>(buffer.buf, dst);
+      break;
+    case 'l':
+      buffer_copy_typed<long>(buffer.buf, dst);
+      break;
+    case 'L':
+      buffer_copy_typed<unsigned long>(buffer.buf, dst);
+      break;
+    case 'q':
+      buffer_copy_typed<long long>(buffer.buf, dst);
+      break;
+    case 'Q':
+      buffer_copy_typed<unsigned long long>(buffer.buf, dst);
+      break;
+    case 'n':
+      buffer_copy_typed<Py_ssize_t>(buffer.buf, dst);
+      break;
+    case 'N':
+      buffer_copy_typed<size_t>(buffer.buf, dst);
+      break;
+    default:
+      BLI_assert_unreachable();
+      break;
+  }
+}
+
+static PyC_StringEnumItems mesh_arrays_domain_items[] = {
+    {int(blender::bke::AttrDomain::Point), "POINT"},
+    {int(blender::bke::AttrDomain::Face), "FACE"},
+    {int(blender::bke::AttrDomain::Corner), "CORNER"},
+    {0, nullptr},
+};
+
+/**
+ * Add a generic attribute from a `(domain, values)` tuple. The type is derived from the array
+ * type and the number of components.
+ */
+static bool mesh_arrays_add_attribute(Mesh &mesh, PyObject *py_name, PyObject *py_value)
+{
+  using namespace blender;
+  const char *name = PyUnicode_AsUTF8(py_name);
+  if (name == nullptr) {
+    PyErr_SetString(PyExc_TypeError, "attributes: expected string keys");
+    return false;
+  }
+  PyC_StringEnum domain_enum = {mesh_arrays_domain_items};
+  PyObject *py_values;
+  if (!PyArg_ParseTuple(
+          py_value, "O&O:attributes", PyC_ParseStringEnum, &domain_enum, &py_values))
+  {
+    return false;
+  }
+  const bke::AttrDomain domain = bke::AttrDomain(domain_enum.value_found);
+
+  /* Get the buffer as flat array first, to find the number of components. */
+  Py_buffer info;
+  if (PyObject_GetBuffer(py_values, &info, PyBUF_ND) == -1) {
+    return false;
+  }
+  const int components_num = info.ndim == 2 ? int(info.shape[1]) : 1;
+  PyBuffer_Release(&info);
+
+  ScopedPyBuffer buffer;
+  int size;
+  if (!buffer_get_array(py_values, name, components_num, buffer, size)) {
+    return false;
+  }
+  bke::MutableAttributeAccessor attributes = mesh.attributes_for_write();
+  if (size != attributes.domain_size(domain)) {
+    PyErr_Format(PyExc_ValueError,
+                 "%s: expected %d values for the domain, not %d",
+                 name,
+                 attributes.domain_size(domain),
+                 size);
+    return false;
+  }
+
+  const char format = buffer_format_char(buffer.buffer);
+  std::optional<eCustomDataType> type;
+  if (format == '?' && components_num == 1) {
+    type = CD_PROP_BOOL;
+  }
+  else if (format == 'b' && components_num == 1) {
+    type = CD_PROP_INT8;
+  }
+  else if (buffer_format_is_int(format) && ELEM(components_num, 1, 2)) {
+    type = components_num == 1 ? CD_PROP_INT32 : CD_PROP_INT32_2D;
+  }
+  else if (buffer_format_is_float(format) && components_num <= 4) {
+    const eCustomDataType float_types[] = {
+        CD_PROP_FLOAT, CD_PROP_FLOAT2, CD_PROP_FLOAT3, CD_PROP_COLOR};
+    type = float_types[components_num - 1];
+  }
+  if (!type) {
+    PyErr_Format(PyExc_TypeError, "%s: unsupported array type and shape", name);
+    return false;
+  }
+
+  bke::GSpanAttributeWriter writer = attributes.lookup_or_add_for_write_only_span(
+      name, domain, *type);
+  if (!writer) {
+    PyErr_Format(PyExc_ValueError, "%s: attribute can't be added", name);
+    return false;
+  }
+  switch (*type) {
+    case CD_PROP_BOOL:
+      buffer_copy(buffer.buffer, writer.span.typed<bool>());
+      break;
+    case CD_PROP_INT8:
+      buffer_copy(buffer.buffer, writer.span.typed<int8_t>());
+      break;
+    case CD_PROP_INT32:
+    case CD_PROP_INT32_2D:
+      buffer_copy(buffer.buffer,
+                  MutableSpan(static_cast<int *>(writer.span.data()), size * components_num));
+      break;
+    default:
+      buffer_copy(buffer.buffer,
+                  MutableSpan(static_cast<float *>(writer.span.data()), size * components_num));
+      break;
+  }
+  writer.finish();
+  return true;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_geometry_set_from_mesh_arrays_doc,
+    ".. staticmethod:: from_mesh_arrays(positions, *, face_offsets=None, corner_verts=None, "
+    "attributes=None)\n"
+    "\n"
+    "   Create a geometry set with a new mesh from arrays, e.g. NumPy arrays. The arrays are\n"
+    "   copied into the mesh at once, which is much faster than adding the geometry element by\n"
+    "   element. Edges are computed from the faces.\n"
+    "\n"
+    "   :arg positions: Vertex positions with the shape ``(verts_num, 3)``.\n"
+    "   :type positions: Buffer\n"
+    "   :arg face_offsets: The first corner of every face, followed by the total number of\n"
+    "      corners, i.e. the length is ``faces_num + 1``.\n"
+    "   :type face_offsets: Buffer | None\n"
+    "   :arg corner_verts: The vertex of every face corner.\n"
+    "   :type corner_verts: Buffer | None\n"
+    "   :arg attributes: Additional attributes, mapping their names to a ``(domain, values)``\n"
+    "      tuple, where the domain is 'POINT', 'FACE' or 'CORNER'. The type is derived from\n"
+    "      the values: booleans, 8-bit integers, integers with 1 or 2 components, or floats with\n"
+    "      1 to 4 components (4 components create a color attribute).\n"
+    "   :type attributes: dict[str, tuple[str, Buffer]] | None\n"
+    "   :return: A geometry set containing the new mesh.\n"
+    "   :rtype: :class:`bpy.types.GeometrySet`\n");
+static BPy_GeometrySet *BPy_GeometrySet_static_from_mesh_arrays(PyObject * /*self*/,
+                                                                PyObject *args,
+                                                                PyObject *kwds)
+{
+  using namespace blender;
+  static const char *kwlist[] = {
+      "positions", "face_offsets", "corner_verts", "attributes", nullptr};
+  PyObject *py_positions;
+  PyObject *py_face_offsets = Py_None;
+  PyObject *py_corner_verts = Py_None;
+  PyObject *py_attributes = Py_None;
+  if (!PyArg_ParseTupleAndKeywords(args,
+                                   kwds,
+                                   "O|$OOO",
+                                   const_cast<char **>(kwlist),
+                                   &py_positions,
+                                   &py_face_offsets,
+                                   &py_corner_verts,
+                                   &py_attributes))
+  {
+    return nullptr;
+  }
+  if ((py_face_offsets == Py_None) != (py_corner_verts == Py_None)) {
+    PyErr_SetString(PyExc_ValueError,
+                    "face_offsets and corner_verts have to be given together");
+    return nullptr;
+  }
+  if (py_attributes != Py_None && !PyDict_Check(py_attributes)) {
+    PyErr_SetString(PyExc_TypeError, "attributes: expected a dictionary");
+    return nullptr;
+  }
+
+  ScopedPyBuffer positions_buffer;
+  int verts_num;
+  if (!buffer_get_array(py_positions, "positions", 3, positions_buffer, verts_num)) {
+    return nullptr;
+  }
+  if (!buffer_format_is_float(buffer_format_char(positions_buffer.buffer))) {
+    PyErr_SetString(PyExc_TypeError, "positions: expected a float array");
+    return nullptr;
+  }
+
+  ScopedPyBuffer face_offsets_buffer;
+  ScopedPyBuffer corner_verts_buffer;
+  int faces_num = 0;
+  int corners_num = 0;
+  if (py_face_offsets != Py_None) {
+    int offsets_num;
+    if (!buffer_get_array(py_face_offsets, "face_offsets", 1, face_offsets_buffer, offsets_num) ||
+        !buffer_get_array(py_corner_verts, "corner_verts", 1, corner_verts_buffer, corners_num))
+    {
+      return nullptr;
+    }
+    if (!buffer_format_is_int(buffer_format_char(face_offsets_buffer.buffer)) ||
+        !buffer_format_is_int(buffer_format_char(corner_verts_buffer.buffer)))
+    {
+      PyErr_SetString(PyExc_TypeError, "face_offsets and corner_verts have to be integer arrays");
+      return nullptr;
+    }
+    if (offsets_num == 0) {
+      PyErr_SetString(PyExc_ValueError, "face_offsets: expected at least one value");
+      return nullptr;
+    }
+    faces_num = offsets_num - 1;
+    if (faces_num == 0 && corners_num != 0) {
+      PyErr_SetString(PyExc_ValueError, "corner_verts: expected no corners without faces");
+      return nullptr;
+    }
+  }
+
+  Mesh *mesh = BKE_mesh_new_nomain(verts_num, 0, faces_num, corners_num);
+  /* Free the mesh when an error happens before it is moved into the geometry set. */
+  GeometrySet geometry = GeometrySet::from_mesh(mesh);
+
+  buffer_copy(positions_buffer.buffer, mesh->vert_positions_for_write().cast<float>());
+
+  if (faces_num > 0) {
+    MutableSpan<int> face_offsets = mesh->face_offsets_for_write();
+    buffer_copy(face_offsets_buffer.buffer, face_offsets);
+    if (face_offsets.first() != 0 || face_offsets.last() != corners_num) {
+      PyErr_SetString(PyExc_ValueError,
+                      "face_offsets: expected to start at 0 and end with the number of corners");
+      return nullptr;
+    }
+    for (const int i : IndexRange(faces_num)) {
+      if (face_offsets[i + 1] - face_offsets[i] < 3) {
+        PyErr_Format(PyExc_ValueError, "face_offsets: face %d has fewer than 3 corners", i);
+        return nullptr;
+      }
+    }
+    MutableSpan<int> corner_verts = mesh->corner_verts_for_write();
+    buffer_copy(corner_verts_buffer.buffer, corner_verts);
+    for (const int i : corner_verts.index_range()) {
+      if (corner_verts[i] < 0 || corner_verts[i] >= verts_num) {
+        PyErr_Format(PyExc_ValueError, "corner_verts: invalid vertex index at %d", i);
+        return nullptr;
+      }
+    }
+    bke::mesh_calc_edges(*mesh, false, false);
+  }
+
+  if (py_attributes != Py_None) {
+    PyObject *key, *value;
+    Py_ssize_t pos = 0;
+    while (PyDict_Next(py_attributes, &pos, &key, &value)) {
+      if (!mesh_arrays_add_attribute(*mesh, key, value)) {
+        return nullptr;
+      }
+    }
+  }
+
+  return python_object_from_geometry_set(std::move(geometry));
+}
+
 static PyObject *BPy_GeometrySet_repr(BPy_GeometrySet *self)
 {
   std::stringstream ss;
@@ -419,6 +811,10 @@ static PyMethodDef BPy_GeometrySet_methods[] = {
      reinterpret_cast<PyCFunction>(BPy_GeometrySet_static_from_evaluated_object),
      METH_VARARGS | METH_KEYWORDS | METH_STATIC,
      bpy_geometry_set_from_evaluated_object_doc},
+    {"from_mesh_arrays",
+     reinterpret_cast<PyCFunction>(BPy_GeometrySet_static_from_mesh_arrays),
+     METH_VARARGS | METH_KEYWORDS | METH_STATIC,
+     bpy_geometry_set_from_mesh_arrays_doc},
     {"instances_pointcloud",
      reinterpret_cast<PyCFunction>(BPy_GeometrySet_get_instances_pointcloud),
      METH_NOARGS,
@@ -132,6 +132,8 @@ static PyObject *pyrna_prop_collection_values(BPy_PropertyRNA *self);
 
 static PyObject *pyrna_register_class(PyObject *self, PyObject *py_class);
 static PyObject *pyrna_unregister_class(PyObject *self, PyObject *py_class);
+static bool pyrna_register_class_ui_deferred_flush();
+static void pyrna_register_class_ui_deferred_clear();
 
 static StructRNA *srna_from_ptr(PointerRNA *ptr);
 
@@ -8543,6 +8545,8 @@ void BPY_rna_init()
 
 void BPY_rna_exit()
 {
+  pyrna_register_class_ui_deferred_clear();
+
 #ifdef USE_PYRNA_INVALIDATE_WEAKREF
   /* This can help track down which kinds of data were not released.
    * If they were in fact freed by Blender, printing their names
@@ -8600,6 +8604,105 @@ PyObject *BPY_rna_doc()
 }
 #endif
 
+/* -------------------------------------------------------------------- */
+/** \name Deferred UI Class Registration
+ *
+ * In background mode, panels, menus, headers and UI-lists are only needed by the few scripts
+ * that access them directly. Registering them while Blender starts is a noticeable part of
+ * the startup time, so while deferring is enabled these classes are stored instead and
+ * registered the first time a type is missing from `bpy.types`.
+ * \{ */
+
+/** When enabled, #pyrna_register_class stores UI classes in #pyrna_ui_deferred_classes. */
+static bool pyrna_ui_defer = false;
+/** List of `(class, owner_id)` tuples, in the order they were registered. */
+static PyObject *pyrna_ui_deferred_classes = nullptr;
+
+static bool pyrna_register_class_ui_is_deferrable(StructRNA *srna)
+{
+  return RNA_struct_is_a(srna, &RNA_Panel) || RNA_struct_is_a(srna, &RNA_Menu) ||
+         RNA_struct_is_a(srna, &RNA_Header) || RNA_struct_is_a(srna, &RNA_UIList);
+}
+
+/** \return the index of the class in the deferred list or -1. */
+static Py_ssize_t pyrna_register_class_ui_deferred_index(PyObject *py_class)
+{
+  if (pyrna_ui_deferred_classes == nullptr) {
+    return -1;
+  }
+  const Py_ssize_t len = PyList_GET_SIZE(pyrna_ui_deferred_classes);
+  for (Py_ssize_t i = 0; i < len; i++) {
+    if (PyTuple_GET_ITEM(PyList_GET_ITEM(pyrna_ui_deferred_classes, i), 0) == py_class) {
+      return i;
+    }
+  }
+  return -1;
+}
+
+static void pyrna_register_class_ui_defer_add(PyObject *py_class)
+{
+  if (pyrna_register_class_ui_deferred_index(py_class) != -1) {
+    return;
+  }
+  if (pyrna_ui_deferred_classes == nullptr) {
+    pyrna_ui_deferred_classes = PyList_New(0);
+  }
+  /* Keep the owner so work-spaces can still filter the classes by add-on. */
+  const char *owner_id = RNA_struct_state_owner_get();
+  PyObject *item = PyTuple_New(2);
+  PyTuple_SET_ITEMS(item,
+                    Py_NewRef(py_class),
+                    owner_id ? PyUnicode_FromString(owner_id) : Py_NewRef(Py_None));
+  PyList_Append(pyrna_ui_deferred_classes, item);
+  Py_DECREF(item);
+}
+
+/**
+ * Register all deferred classes, errors are printed since the caller isn't responsible for them.
+ * \return true when any class was registered.
+ */
+static bool pyrna_register_class_ui_deferred_flush()
+{
+  if (pyrna_ui_deferred_classes == nullptr || !pyrna_write_check()) {
+    return false;
+  }
+  /* Take ownership of the list first, registering may add more deferred classes. */
+  PyObject *classes = pyrna_ui_deferred_classes;
+  pyrna_ui_deferred_classes = nullptr;
+
+  const bool defer_orig = pyrna_ui_defer;
+  pyrna_ui_defer = false;
+  const char *owner_id_orig = RNA_struct_state_owner_get();
+  std::string owner_id_orig_str = owner_id_orig ? owner_id_orig : "";
+
+  const Py_ssize_t len = PyList_GET_SIZE(classes);
+  for (Py_ssize_t i = 0; i < len; i++) {
+    PyObject *item = PyList_GET_ITEM(classes, i);
+    PyObject *py_owner_id = PyTuple_GET_ITEM(item, 1);
+    RNA_struct_state_owner_set(py_owner_id == Py_None ? nullptr : PyUnicode_AsUTF8(py_owner_id));
+    PyObject *ret = pyrna_register_class(nullptr, PyTuple_GET_ITEM(item, 0));
+    if (ret) {
+      Py_DECREF(ret);
+    }
+    else {
+      PyErr_Print();
+    }
+  }
+
+  RNA_struct_state_owner_set(owner_id_orig ? owner_id_orig_str.c_str() : nullptr);
+  pyrna_ui_defer = defer_orig;
+  Py_DECREF(classes);
+  return len != 0;
+}
+
+static void pyrna_register_class_ui_deferred_clear()
+{
+  pyrna_ui_defer = false;
+  Py_CLEAR(pyrna_ui_deferred_classes);
+}
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name RNA Types Module `bpy.types`
  * \{ */
@@ -8646,6 +8749,11 @@ static PyObject *bpy_types_module_getattro(PyObject *self, PyObject *pyname)
                  PyUnicode_AsUTF8(pyname));
     return nullptr;
 #endif
+    if (pyrna_register_class_ui_deferred_flush() &&
+        RNA_property_collection_lookup_string(&state->ptr.value(), state->prop, name, &newptr))
+    {
+      return pyrna_struct_Subtype(&newptr);
+    }
     /* The error raised here will be displayed. */
     ret = PyObject_GenericGetAttr(self, pyname);
   }
@@ -8658,6 +8766,9 @@ static PyObject *bpy_types_module_dir(PyObject *self)
   BPy_TypesModule_State *state = static_cast<BPy_TypesModule_State *>(PyModule_GetState(self));
   BLI_assert(state->ptr.has_value());
 
+  /* Listing all types includes the deferred ones. */
+  pyrna_register_class_ui_deferred_flush();
+
   PyObject *ret = PyList_New(0);
 
   RNA_PROP_BEGIN (&state->ptr.value(), itemptr, state->prop) {
@@ -10069,6 +10180,11 @@ static PyObject *pyrna_register_class(PyObject * /*self*/, PyObject *py_class)
     return nullptr;
   }
 
+  if (pyrna_ui_defer && pyrna_register_class_ui_is_deferrable(srna)) {
+    pyrna_register_class_ui_defer_add(py_class);
+    Py_RETURN_NONE;
+  }
+
   /* Get the context, so register callback can do necessary refreshes. */
   C = BPY_context_get();
 
@@ -10219,6 +10335,13 @@ static PyObject *pyrna_unregister_class(PyObject * /*self*/, PyObject *py_class)
   }
 #endif
 
+  /* A deferred class was never registered, forgetting it is enough. */
+  const Py_ssize_t deferred_index = pyrna_register_class_ui_deferred_index(py_class);
+  if (deferred_index != -1) {
+    PySequence_DelItem(pyrna_ui_deferred_classes, deferred_index);
+    Py_RETURN_NONE;
+  }
+
   if (!pyrna_write_check()) {
     PyErr_Format(PyExc_RuntimeError,
                  "%s can't run in readonly state '%.200s'",
@@ -10400,6 +10523,33 @@ static PyObject *pyrna_bl_owner_id_set(PyObject * /*self*/, PyObject *value)
   Py_RETURN_NONE;
 }
 
+static PyObject *pyrna_register_class_ui_defer_set(PyObject * /*self*/, PyObject *value)
+{
+  const int defer = PyC_Long_AsBool(value);
+  if (defer == -1 && PyErr_Occurred()) {
+    return nullptr;
+  }
+  pyrna_ui_defer = bool(defer);
+  Py_RETURN_NONE;
+}
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    pyrna_register_deferred_ui_classes_doc,
+    ".. function:: register_deferred_ui_classes()\n"
+    "\n"
+    "   Register the panels, menus, headers and UI-lists whose registration was deferred\n"
+    "   while starting in background mode. This happens automatically when a type is\n"
+    "   looked up in :mod:`bpy.types`, so this is only needed by scripts that access these\n"
+    "   types in other ways, e.g. by calling a menu by name.\n"
+    "\n"
+    "   :return: True when any class was registered.\n"
+    "   :rtype: bool\n");
+static PyObject *pyrna_register_deferred_ui_classes(PyObject * /*self*/)
+{
+  return PyBool_FromLong(pyrna_register_class_ui_deferred_flush());
+}
+
 #ifdef __GNUC__
 #  ifdef __clang__
 #    pragma clang diagnostic push
@@ -10422,6 +10572,18 @@ PyMethodDef meth_bpy_owner_id_set = {
     METH_O,
     nullptr,
 };
+PyMethodDef meth_bpy_register_class_ui_defer_set = {
+    "_register_class_ui_defer_set",
+    (PyCFunction)pyrna_register_class_ui_defer_set,
+    METH_O,
+    nullptr,
+};
+PyMethodDef meth_bpy_register_deferred_ui_classes = {
+    "register_deferred_ui_classes",
+    (PyCFunction)pyrna_register_deferred_ui_classes,
+    METH_NOARGS,
+    pyrna_register_deferred_ui_classes_doc,
+};
 
 #ifdef __GNUC__
 #  ifdef __clang__
@@ -289,4 +289,8 @@ extern PyMethodDef meth_bpy_unregister_class;
 extern PyMethodDef meth_bpy_owner_id_set;
 extern PyMethodDef meth_bpy_owner_id_get;
 
+/* bpy.utils._register_class_ui_defer_set & bpy.utils.register_deferred_ui_classes */
+extern PyMethodDef meth_bpy_register_class_ui_defer_set;
+extern PyMethodDef meth_bpy_register_deferred_ui_classes;
+
 extern BPy_StructRNA *bpy_context_module;
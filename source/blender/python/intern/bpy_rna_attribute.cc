@@ -0,0 +1,344 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ *
+ * This file extends geometry attributes with a buffer protocol view of their values, so that
+ * e.g. NumPy can access them without copying.
+ */
+
+#include <Python.h>
+
+#include "BLI_implicit_sharing.hh"
+#include "BLI_utildefines.h"
+#include "BLI_vector.hh"
+
+#include "BKE_attribute.h"
+#include "BKE_customdata.hh"
+
+#include "DNA_customdata_types.h"
+#include "DNA_ID.h"
+
+#include "../generic/py_capi_utils.hh"
+#include "../generic/python_compat.hh"
+
+#include "bpy_rna.hh"
+#include "bpy_rna_attribute.hh" /* Declare #BPY_rna_attribute_as_buffer_method_def. */
+
+/* -------------------------------------------------------------------- */
+/** \name Attribute Buffer Type
+ *
+ * An object that only exports the attribute values with the buffer protocol. It's not exposed
+ * directly, #bpy_rna_attribute_as_buffer returns a `memoryview` of it.
+ * \{ */
+
+struct BPyAttributeBuffer {
+  PyObject_HEAD
+  void *data;
+  /**
+   * A user of the array that is held by read-only buffers, so that the values stay valid and
+   * unchanged even when the geometry is modified or freed.
+   */
+  const blender::ImplicitSharingInfo *sharing_info;
+  bool readonly;
+  /** Struct module format character of a single component. */
+  char format[2];
+  Py_ssize_t itemsize;
+  int ndim;
+  Py_ssize_t shape[3];
+  Py_ssize_t strides[3];
+};
+
+static void bpy_attribute_buffer_dealloc(BPyAttributeBuffer *self)
+{
+  if (self->sharing_info) {
+    self->sharing_info->remove_user_and_delete_if_last();
+  }
+  Py_TYPE(self)->tp_free((PyObject *)self);
+}
+
+static int bpy_attribute_buffer_getbuffer(BPyAttributeBuffer *self, Py_buffer *view, int flags)
+{
+  if ((flags & PyBUF_WRITABLE) && self->readonly) {
+    PyErr_SetString(PyExc_BufferError, "Attribute buffer is read-only");
+    return -1;
+  }
+  Py_ssize_t len = self->itemsize;
+  for (int i = 0; i < self->ndim; i++) {
+    len *= self->shape[i];
+  }
+  /* Empty attributes may not have an array at all. */
+  static char empty_data = 0;
+  view->buf = self->data ? self->data : &empty_data;
+  view->obj = Py_NewRef(self);
+  view->len = len;
+  view->readonly = self->readonly;
+  view->itemsize = self->itemsize;
+  view->format = (flags & PyBUF_FORMAT) ? self->format : nullptr;
+  view->ndim = self->ndim;
+  view->shape = (flags & PyBUF_ND) ? self->shape : nullptr;
+  view->strides = ((flags & PyBUF_STRIDES) == PyBUF_STRIDES) ? self->strides : nullptr;
+  view->suboffsets = nullptr;
+  view->internal = nullptr;
+  return 0;
+}
+
+static PyBufferProcs bpy_attribute_buffer_as_buffer = {
+    /*bf_getbuffer*/ (getbufferproc)bpy_attribute_buffer_getbuffer,
+    /*bf_releasebuffer*/ nullptr,
+};
+
+static PyTypeObject BPyAttributeBuffer_Type = {
+    /*ob_base*/ PyVarObject_HEAD_INIT(nullptr, 0)
+    /*tp_name*/ "AttributeBuffer",
+    /*tp_basicsize*/ sizeof(BPyAttributeBuffer),
+    /*tp_itemsize*/ 0,
+    /*tp_dealloc*/ (destructor)bpy_attribute_buffer_dealloc,
+    /*tp_vectorcall_offset*/ 0,
+    /*tp_getattr*/ nullptr,
+    /*tp_setattr*/ nullptr,
+    /*tp_as_async*/ nullptr,
+    /*tp_repr*/ nullptr,
+    /*tp_as_number*/ nullptr,
+    /*tp_as_sequence*/ nullptr,
+    /*tp_as_mapping*/ nullptr,
+    /*tp_hash*/ nullptr,
+    /*tp_call*/ nullptr,
+    /*tp_str*/ nullptr,
+    /*tp_getattro*/ nullptr,
+    /*tp_setattro*/ nullptr,
+    /*tp_as_buffer*/ &bpy_attribute_buffer_as_buffer,
+    /*tp_flags*/ Py_TPFLAGS_DEFAULT,
+    /*tp_doc*/ nullptr,
+    /*tp_traverse*/ nullptr,
+    /*tp_clear*/ nullptr,
+    /*tp_richcompare*/ nullptr,
+    /*tp_weaklistoffset*/ 0,
+    /*tp_iter*/ nullptr,
+    /*tp_iternext*/ nullptr,
+    /*tp_methods*/ nullptr,
+    /*tp_members*/ nullptr,
+    /*tp_getset*/ nullptr,
+    /*tp_base*/ nullptr,
+    /*tp_dict*/ nullptr,
+    /*tp_descr_get*/ nullptr,
+    /*tp_descr_set*/ nullptr,
+    /*tp_dictoffset*/ 0,
+    /*tp_init*/ nullptr,
+    /*tp_alloc*/ nullptr,
+    /*tp_new*/ nullptr,
+    /*tp_free*/ nullptr,
+    /*tp_is_gc*/ nullptr,
+    /*tp_bases*/ nullptr,
+    /*tp_mro*/ nullptr,
+    /*tp_cache*/ nullptr,
+    /*tp_subclasses*/ nullptr,
+    /*tp_weaklist*/ nullptr,
+    /*tp_del*/ nullptr,
+    /*tp_version_tag*/ 0,
+    /*tp_finalize*/ nullptr,
+    /*tp_vectorcall*/ nullptr,
+};
+
+/**
+ * Describe the values of an attribute type as an array of components.
+ * \return False if the type can't be exposed as a buffer.
+ */
+static bool attribute_buffer_layout(const eCustomDataType type,
+                                    char &r_format,
+                                    Py_ssize_t &r_itemsize,
+                                    blender::Vector<Py_ssize_t, 2> &r_component_shape)
+{
+  switch (type) {
+    case CD_PROP_FLOAT:
+      r_format = 'f';
+      r_itemsize = sizeof(float);
+      return true;
+    case CD_PROP_FLOAT2:
+      r_format = 'f';
+      r_itemsize = sizeof(float);
+      r_component_shape = {2};
+      return true;
+    case CD_PROP_FLOAT3:
+      r_format = 'f';
+      r_itemsize = sizeof(float);
+      r_component_shape = {3};
+      return true;
+    case CD_PROP_COLOR:
+    case CD_PROP_QUATERNION:
+      r_format = 'f';
+      r_itemsize = sizeof(float);
+      r_component_shape = {4};
+      return true;
+    case CD_PROP_FLOAT4X4:
+      r_format = 'f';
+      r_itemsize = sizeof(float);
+      r_component_shape = {4, 4};
+      return true;
+    case CD_PROP_INT32:
+      r_format = 'i';
+      r_itemsize = sizeof(int32_t);
+      return true;
+    case CD_PROP_INT32_2D:
+      r_format = 'i';
+      r_itemsize = sizeof(int32_t);
+      r_component_shape = {2};
+      return true;
+    case CD_PROP_INT16_2D:
+      r_format = 'h';
+      r_itemsize = sizeof(int16_t);
+      r_component_shape = {2};
+      return true;
+    case CD_PROP_INT8:
+      r_format = 'b';
+      r_itemsize = sizeof(int8_t);
+      return true;
+    case CD_PROP_BOOL:
+      r_format = '?';
+      r_itemsize = sizeof(bool);
+      return true;
+    case CD_PROP_BYTE_COLOR:
+      r_format = 'B';
+      r_itemsize = sizeof(uint8_t);
+      r_component_shape = {4};
+      return true;
+    default:
+      return false;
+  }
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Attribute Buffer Method
+ * \{ */
+
+PyDoc_STRVAR(
+    /* Wrap. */
+    bpy_rna_attribute_as_buffer_doc,
+    ".. method:: as_buffer(*, writable=False)\n"
+    "\n"
+    "   Return a view of the attribute values that supports the buffer protocol, "
+    "without copying them.\n"
+    "   Vector, color and matrix attributes have one dimension per element and more for their\n"
+    "   components, e.g. ``numpy.asarray(mesh.attributes['position'].as_buffer())`` has the\n"
+    "   shape ``(len(mesh.vertices), 3)``.\n"
+    "\n"
+    "   A read-only view keeps the values it was created with alive, even when the geometry is\n"
+    "   changed or removed afterwards. It's a snapshot that does not see later changes.\n"
+    "\n"
+    "   :arg writable: Create a view that can be written to. Values that are shared with other\n"
+    "      geometry are copied first, so that only this attribute is changed. The view must not\n"
+    "      be used anymore after the geometry is changed in other ways, and changes have to be\n"
+    "      tagged explicitly, e.g. with :meth:`bpy.types.ID.update_tag`.\n"
+    "   :type writable: bool\n"
+    "   :return: The attribute values.\n"
+    "   :rtype: memoryview\n");
+static PyObject *bpy_rna_attribute_as_buffer(PyObject *self, PyObject *args, PyObject *kwds)
+{
+  BPy_StructRNA *pyrna = (BPy_StructRNA *)self;
+  PYRNA_STRUCT_CHECK_OBJ(pyrna);
+
+  bool writable = false;
+  static const char *_keywords[] = {"writable", nullptr};
+  static _PyArg_Parser _parser = {
+      PY_ARG_PARSER_HEAD_COMPAT()
+      "|$" /* Optional keyword only arguments. */
+      "O&" /* `writable` */
+      ":as_buffer",
+      _keywords,
+      nullptr,
+  };
+  if (!_PyArg_ParseTupleAndKeywordsFast(args, kwds, &_parser, PyC_ParseBool, &writable)) {
+    return nullptr;
+  }
+
+  CustomDataLayer *layer = static_cast<CustomDataLayer *>(pyrna->ptr->data);
+  AttributeOwner owner = AttributeOwner::from_id(pyrna->ptr->owner_id);
+  if (!owner.is_valid()) {
+    PyErr_SetString(PyExc_TypeError, "as_buffer: attribute owner is not supported");
+    return nullptr;
+  }
+
+  char format;
+  Py_ssize_t itemsize;
+  blender::Vector<Py_ssize_t, 2> component_shape;
+  if (!attribute_buffer_layout(
+          eCustomDataType(layer->type), format, itemsize, component_shape))
+  {
+    PyErr_Format(PyExc_TypeError,
+                 "as_buffer: attribute \"%s\" has a type that can't be viewed as a buffer",
+                 layer->name);
+    return nullptr;
+  }
+
+  const int length = BKE_attribute_data_length(owner, layer);
+  if (writable) {
+    /* Copy-on-write: make sure the values are not shared before they can be changed. */
+    CustomData_ensure_data_is_mutable(layer, length);
+  }
+
+  BPyAttributeBuffer *buffer = PyObject_New(BPyAttributeBuffer, &BPyAttributeBuffer_Type);
+  buffer->data = layer->data;
+  buffer->readonly = !writable;
+  buffer->sharing_info = nullptr;
+  if (!writable && layer->sharing_info) {
+    buffer->sharing_info = layer->sharing_info;
+    buffer->sharing_info->add_user();
+  }
+  buffer->format[0] = format;
+  buffer->format[1] = '\0';
+  buffer->itemsize = itemsize;
+  buffer->ndim = int(component_shape.size()) + 1;
+  buffer->shape[0] = length;
+  for (const int i : component_shape.index_range()) {
+    buffer->shape[i + 1] = component_shape[i];
+  }
+  /* C-contiguous strides. */
+  Py_ssize_t stride = itemsize;
+  for (int i = buffer->ndim - 1; i >= 0; i--) {
+    buffer->strides[i] = stride;
+    stride *= buffer->shape[i];
+  }
+
+  PyObject *view = PyMemoryView_FromObject((PyObject *)buffer);
+  Py_DECREF(buffer);
+  return view;
+}
+
+#ifdef __GNUC__
+#  ifdef __clang__
+#    pragma clang diagnostic push
+#    pragma clang diagnostic ignored "-Wcast-function-type"
+#  else
+#    pragma GCC diagnostic push
+#    pragma GCC diagnostic ignored "-Wcast-function-type"
+#  endif
+#endif
+
+PyMethodDef BPY_rna_attribute_as_buffer_method_def = {
+    "as_buffer",
+    (PyCFunction)bpy_rna_attribute_as_buffer,
+    METH_VARARGS | METH_KEYWORDS,
+    bpy_rna_attribute_as_buffer_doc,
+};
+
+#ifdef __GNUC__
+#  ifdef __clang__
+#    pragma clang diagnostic pop
+#  else
+#    pragma GCC diagnostic pop
+#  endif
+#endif
+
+void bpy_rna_attribute_types_init()
+{
+  if (PyType_Ready(&BPyAttributeBuffer_Type) < 0) {
+    BLI_assert_unreachable();
+    return;
+  }
+}
+
+/** \} */
@@ -0,0 +1,15 @@
+/* SPDX-FileCopyrightText: 2026 Blender Authors
+ *
+ * SPDX-License-Identifier: GPL-2.0-or-later */
+
+/** \file
+ * \ingroup pythonintern
+ */
+
+#pragma once
+
+#include <Python.h>
+
+extern PyMethodDef BPY_rna_attribute_as_buffer_method_def;
+
+void bpy_rna_attribute_types_init();
@@ -21,6 +21,7 @@
 
 #include "bpy_library.hh"
 #include "bpy_rna.hh"
+#include "bpy_rna_attribute.hh"
 #include "bpy_rna_callback.hh"
 #include "bpy_rna_context.hh"
 #include "bpy_rna_data.hh"
@@ -88,6 +89,17 @@ static PyMethodDef pyrna_operator_methods[] = {
 
 /** \} */
 
+/* -------------------------------------------------------------------- */
+/** \name Attribute
+ * \{ */
+
+static PyMethodDef pyrna_attribute_methods[] = {
+    {nullptr, nullptr, 0, nullptr}, /* #BPY_rna_attribute_as_buffer_method_def */
+    {nullptr, nullptr, 0, nullptr},
+};
+
+/** \} */
+
 /* -------------------------------------------------------------------- */
 /** \name Text Editor
  * \{ */
@@ -307,6 +319,13 @@ void BPY_rna_types_extend_capi()
   BLI_STATIC_ASSERT(ARRAY_SIZE(pyrna_text_methods) == 3, "Unexpected number of methods")
   pyrna_struct_type_extend_capi(&RNA_Text, pyrna_text_methods, nullptr);
 
+  /* Attribute */
+  bpy_rna_attribute_types_init();
+
+  ARRAY_SET_ITEMS(pyrna_attribute_methods, BPY_rna_attribute_as_buffer_method_def);
+  BLI_STATIC_ASSERT(ARRAY_SIZE(pyrna_attribute_methods) == 2, "Unexpected number of methods")
+  pyrna_struct_type_extend_capi(&RNA_Attribute, pyrna_attribute_methods, nullptr);
+
   /* wmOperator */
   ARRAY_SET_ITEMS(pyrna_operator_methods, BPY_rna_operator_poll_message_set_method_def);
   BLI_STATIC_ASSERT(ARRAY_SIZE(pyrna_operator_methods) == 2, "Unexpected number of methods")
@@ -24,9 +24,6 @@ struct BakeImage {
   int width;
   int height;
   size_t offset;
-
-  /* For associating render result layer with image. */
-  char render_layer_name[RE_MAXNAME];
 };
 
 struct BakeTargets {
@@ -47,6 +44,13 @@ struct BakeTargets {
   bool is_noncolor;
 };
 
+/* Render result layer written by the engine, for one image of one object. */
+struct BakeResultLayer {
+  char name[RE_MAXNAME];
+  int image_id;
+  int object_id;
+};
+
 struct BakePixel {
   int primitive_id, object_id;
   int seed;
@@ -69,10 +73,15 @@ struct BakeHighPolyData {
 
 bool RE_bake_has_engine(const struct Render *re);
 
+/**
+ * Bake all objects into the same targets with a single engine, so the scene is synced and its
+ * acceleration structures are built only once. The pixels of each object are found by matching
+ * #BakePixel.object_id with the index of the object in the array.
+ */
 bool RE_bake_engine(struct Render *re,
                     struct Depsgraph *depsgraph,
-                    struct Object *object,
-                    int object_id,
+                    struct Object *const *objects,
+                    int objects_num,
                     const BakePixel pixel_array[],
                     const BakeTargets *targets,
                     eScenePassType pass_type,
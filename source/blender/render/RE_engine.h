@@ -18,6 +18,7 @@
 
 struct BakeTargets;
 struct BakePixel;
+struct DRWData;
 struct Depsgraph;
 struct GPUContext;
 struct Main;
@@ -149,12 +150,21 @@ struct RenderEngine {
     float *result;
     int image_id;
     int object_id;
+    /* Layer the engine wrote results to for each object and image, to find them again when results
+     * are only written after baking all objects, in #RenderEngineType.render_frame_finish. */
+    struct BakeResultLayer *result_layers;
+    int result_layers_num;
   } bake;
 
   /* Depsgraph */
   struct Depsgraph *depsgraph;
   bool has_grease_pencil;
 
+  /* Draw data kept between the frames of an animation render, for the view layer it was used
+   * with. See #DRW_render_to_image. */
+  struct DRWData *draw_data;
+  const struct ViewLayer *draw_data_view_layer;
+
   /* callback for render pass query */
   ThreadMutex update_render_passes_mutex;
   update_render_passes_cb_t update_render_passes_cb;
@@ -21,6 +21,7 @@ struct Main;
 struct Object;
 struct RenderData;
 struct RenderResult;
+struct RenderResultLazyRead;
 struct ReportList;
 struct Scene;
 struct StampData;
@@ -146,6 +147,10 @@ struct RenderResult {
   struct StampData *stamp_data;
 
   bool passes_allocated;
+
+  /* Set for render results of multi-layer files which only read the pixels of passes when they
+   * are needed, see #RE_pass_ensure_loaded. */
+  struct RenderResultLazyRead *lazy_read;
 };
 
 struct RenderStats {
@@ -238,6 +243,11 @@ void RE_FreeRenderResult(struct RenderResult *rr);
  */
 struct RenderResult *RE_AcquireResultRead(struct Render *re);
 struct RenderResult *RE_AcquireResultWrite(struct Render *re);
+/**
+ * Same as #RE_AcquireResultWrite, but doesn't allocate the passes the render engine didn't write.
+ * For writers which only modify the views of the result, like the compositor output.
+ */
+struct RenderResult *RE_AcquireResultWriteViews(struct Render *re);
 void RE_ReferenceRenderResult(struct RenderResult *rr);
 void RE_ReleaseResult(struct Render *re);
 /**
@@ -410,6 +420,26 @@ bool RE_ReadRenderResult(struct Scene *scene, struct Scene *scenode);
 
 struct RenderResult *RE_MultilayerConvert(
     void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty);
+/**
+ * Convert a handle loaded with #IB_multilayer_lazy, which has no pixels yet. The pixels of a pass
+ * are read from the file when it's first used, see #RE_pass_ensure_loaded.
+ */
+struct RenderResult *RE_MultilayerConvertLazy(void *exrhandle,
+                                              const char *filepath,
+                                              const char *colorspace,
+                                              bool predivide,
+                                              int rectx,
+                                              int recty);
+
+/**
+ * Read the pixels of a pass of a multi-layer render result from #RE_MultilayerConvertLazy,
+ * does nothing when they are available already. Must be called before accessing the pass pixels.
+ */
+void RE_pass_ensure_loaded(struct RenderResult *rr, struct RenderPass *rpass);
+/**
+ * Read the pixels of all passes which were not read yet, for code that accesses all passes.
+ */
+void RE_render_result_ensure_loaded(struct RenderResult *rr);
 
 /* Display and event callbacks. */
 
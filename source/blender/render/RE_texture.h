@@ -54,6 +54,10 @@ void ibuf_sample(struct ImBuf *ibuf, float fx, float fy, float dx, float dy, flo
 
 struct PointDensity;
 
+/**
+ * Build the tree of points to sample. A tree from a previous call is reused while the settings
+ * and source object it was built from are unchanged.
+ */
 void RE_point_density_cache(struct Depsgraph *depsgraph, struct PointDensity *pd);
 
 void RE_point_density_minmax(struct Depsgraph *depsgraph,
@@ -63,7 +67,7 @@ void RE_point_density_minmax(struct Depsgraph *depsgraph,
 
 /**
  * \note Requires #RE_point_density_cache() to be called first.
- * \note Frees point density structure after sampling.
+ * \note The cached points are kept after sampling, free them with #RE_point_density_free().
  */
 void RE_point_density_sample(struct Depsgraph *depsgraph,
                              struct PointDensity *pd,
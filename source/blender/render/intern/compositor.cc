@@ -6,7 +6,9 @@
 #include <string>
 
 #include "BLI_listbase.h"
+#include "BLI_math_base.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_rect.h"
 #include "BLI_threads.h"
 #include "BLI_vector.hh"
 
@@ -176,12 +178,44 @@ class Context : public compositor::Context {
     return size;
   }
 
+  /* True if the compositing region should be limited to the viewer border of the node tree. That
+   * is only done for interactive evaluations, not for final renders. */
+  bool use_viewer_border() const
+  {
+    const bNodeTree &node_tree = this->get_node_tree();
+    return !this->render_context() && (node_tree.flag & NTREE_VIEWER_BORDER) &&
+           bool(this->needed_outputs() & compositor::OutputTypes::Viewer);
+  }
+
   rcti get_compositing_region() const override
   {
     const int2 render_size = get_render_size();
     const rcti render_region = rcti{0, render_size.x, 0, render_size.y};
 
-    return render_region;
+    if (!this->use_viewer_border()) {
+      return render_region;
+    }
+
+    /* The viewer border is relative to the viewer image, which is assumed to have the render
+     * size, so only the pixels inside it are computed while the user is editing the node tree. */
+    const rctf &viewer_border = this->get_node_tree().viewer_border;
+    rcti viewer_region;
+    BLI_rcti_init(&viewer_region,
+                  int(viewer_border.xmin * render_size.x),
+                  int(math::ceil(viewer_border.xmax * render_size.x)),
+                  int(viewer_border.ymin * render_size.y),
+                  int(math::ceil(viewer_border.ymax * render_size.y)));
+
+    rcti compositing_region;
+    if (!BLI_rcti_isect(&render_region, &viewer_region, &compositing_region)) {
+      return rcti{0, 0, 0, 0};
+    }
+    return compositing_region;
+  }
+
+  bool write_viewer_to_compositing_region() const override
+  {
+    return this->use_viewer_border();
   }
 
   compositor::Result get_output_result() override
@@ -206,6 +240,13 @@ class Context : public compositor::Context {
                                               const bool is_data,
                                               compositor::ResultPrecision precision) override
   {
+    /* The viewer only writes to the compositing region, so allocate the viewer image at the
+     * render size. Pixels outside of the viewer border keep their values from earlier
+     * evaluations. */
+    if (this->use_viewer_border()) {
+      domain = compositor::Domain(this->get_render_size());
+    }
+
     viewer_output_result_.set_transformation(domain.transformation);
     viewer_output_result_.meta_data.is_non_color_data = is_data;
 
@@ -424,7 +465,7 @@ class Context : public compositor::Context {
     }
 
     Render *re = RE_GetSceneRender(input_data_.scene);
-    RenderResult *rr = RE_AcquireResultWrite(re);
+    RenderResult *rr = RE_AcquireResultWriteViews(re);
 
     if (rr) {
       RenderView *rv = RE_RenderViewGetByName(rr, input_data_.view_name.c_str());
@@ -146,6 +146,9 @@ static void engine_depsgraph_free(RenderEngine *engine)
       }
     }
 
+    /* The draw data refers to the evaluated data of the depsgraph. */
+    DRW_render_data_free(engine);
+
     DEG_graph_free(engine->depsgraph);
     engine->depsgraph = nullptr;
 
@@ -178,16 +181,41 @@ void RE_engine_free(RenderEngine *engine)
 
 /* Bake Render Results */
 
+static BakeResultLayer *bake_result_layer_current(RenderEngine *engine)
+{
+  return &engine->bake.result_layers[engine->bake.object_id * engine->bake.targets->images_num +
+                                     engine->bake.image_id];
+}
+
+static BakeResultLayer *bake_result_layer_find(RenderEngine *engine, const char *layername)
+{
+  /* Prefer the image and object being baked, in case the engine uses the same layer name for
+   * multiple objects. */
+  BakeResultLayer *current_layer = bake_result_layer_current(engine);
+  if (STREQ(current_layer->name, layername)) {
+    return current_layer;
+  }
+  for (int i = 0; i < engine->bake.result_layers_num; i++) {
+    if (STREQ(engine->bake.result_layers[i].name, layername)) {
+      return &engine->bake.result_layers[i];
+    }
+  }
+  return nullptr;
+}
+
 static RenderResult *render_result_from_bake(
     RenderEngine *engine, int x, int y, int w, int h, const char *layername)
 {
-  BakeImage *image = &engine->bake.targets->images[engine->bake.image_id];
+  const BakeImage *image = &engine->bake.targets->images[engine->bake.image_id];
   const BakePixel *pixels = engine->bake.pixels + image->offset;
   const size_t channels_num = engine->bake.targets->channels_num;
 
-  /* Remember layer name for to match images in render_frame_finish. */
-  if (image->render_layer_name[0] == '\0') {
-    STRNCPY(image->render_layer_name, layername);
+  /* Remember the image and object of the layer to match them in render_frame_finish. */
+  BakeResultLayer *layer = bake_result_layer_current(engine);
+  if (layer->name[0] == '\0') {
+    STRNCPY(layer->name, layername);
+    layer->image_id = engine->bake.image_id;
+    layer->object_id = engine->bake.object_id;
   }
 
   /* Create render result with specified size. */
@@ -271,18 +299,14 @@ static void render_result_to_bake(RenderEngine *engine, RenderResult *rr)
     return;
   }
 
-  /* Find bake image corresponding to layer. */
-  int image_id = 0;
-  for (; image_id < engine->bake.targets->images_num; image_id++) {
-    if (STREQ(engine->bake.targets->images[image_id].render_layer_name, rl->name)) {
-      break;
-    }
-  }
-  if (image_id == engine->bake.targets->images_num) {
+  /* Find bake image and object corresponding to layer. */
+  const BakeResultLayer *layer = bake_result_layer_find(engine, rl->name);
+  if (layer == nullptr) {
     return;
   }
+  const int object_id = layer->object_id;
 
-  const BakeImage *image = &engine->bake.targets->images[image_id];
+  const BakeImage *image = &engine->bake.targets->images[layer->image_id];
   const BakePixel *pixels = engine->bake.pixels + image->offset;
   const size_t channels_num = engine->bake.targets->channels_num;
   const size_t channels_size = channels_num * sizeof(float);
@@ -304,7 +328,7 @@ static void render_result_to_bake(RenderEngine *engine, RenderResult *rr)
     float *bake_result = result + bake_offset * channels_num;
 
     for (int tx = 0; tx < w; tx++) {
-      if (bake_pixel->object_id == engine->bake.object_id) {
+      if (bake_pixel->object_id == object_id) {
         memcpy(bake_result, pass_rect, channels_size);
       }
       pass_rect += channels_num;
@@ -368,13 +392,15 @@ RenderResult *RE_engine_begin_result(
   return result;
 }
 
-static void re_ensure_passes_allocated_thread_safe(Render *re)
+/**
+ * Allocate the passes of the render result which the given engine result is about to be merged
+ * into. Passes the engine doesn't write are left unallocated.
+ */
+static void re_ensure_passes_allocated_thread_safe(Render *re, const RenderResult *result)
 {
   if (!re->result->passes_allocated) {
     BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
-    if (!re->result->passes_allocated) {
-      render_result_passes_allocated_ensure(re->result);
-    }
+    render_result_passes_allocated_ensure_for_merge(re->result, result);
     BLI_rw_mutex_unlock(&re->resultmutex);
   }
 }
@@ -389,7 +415,7 @@ void RE_engine_update_result(RenderEngine *engine, RenderResult *result)
   Render *re = engine->re;
 
   if (result) {
-    re_ensure_passes_allocated_thread_safe(re);
+    re_ensure_passes_allocated_thread_safe(re, result);
     render_result_merge(re->result, result);
     result->renlay = static_cast<RenderLayer *>(
         result->layers.first); /* weak, draws first layer always */
@@ -445,7 +471,7 @@ void RE_engine_end_result(
 
   if (!cancel || merge_results) {
     if (!(re->test_break() && (re->r.scemode & R_BUTS_PREVIEW))) {
-      re_ensure_passes_allocated_thread_safe(re);
+      re_ensure_passes_allocated_thread_safe(re, result);
       render_result_merge(re->result, result);
     }
 
@@ -654,8 +680,11 @@ static bool engine_keep_depsgraph(RenderEngine *engine)
   /* For persistent data or GPU engines like Eevee, reuse the depsgraph between
    * view layers and animation frames. For renderers like Cycles that create
    * their own copy of the scene, persistent data must be explicitly enabled to
-   * keep memory usage low by default. */
-  return (engine->re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT);
+   * keep memory usage low by default. Persistent animation data keeps the engine
+   * only until the animation render is done, see #render_pipeline_free. */
+  return (engine->re->r.mode & R_PERSISTENT_DATA) || (engine->type->flag & RE_USE_GPU_CONTEXT) ||
+         ((engine->re->r.mode & R_PERSISTENT_DATA_ANIMATION) &&
+          (engine->flag & RE_ENGINE_ANIMATION));
 }
 
 /* Depsgraph */
@@ -769,8 +798,8 @@ bool RE_bake_has_engine(const Render *re)
 
 bool RE_bake_engine(Render *re,
                     Depsgraph *depsgraph,
-                    Object *object,
-                    const int object_id,
+                    Object *const *objects,
+                    const int objects_num,
                     const BakePixel pixel_array[],
                     const BakeTargets *targets,
                     const eScenePassType pass_type,
@@ -808,18 +837,33 @@ bool RE_bake_engine(Render *re,
       type->update(engine, re->main, engine->depsgraph);
     }
 
-    /* Bake all images. */
+    /* Bake all images of all objects. */
     engine->bake.targets = targets;
     engine->bake.pixels = pixel_array;
     engine->bake.result = result;
-    engine->bake.object_id = object_id;
-
-    for (int i = 0; i < targets->images_num; i++) {
-      const BakeImage *image = &targets->images[i];
-      engine->bake.image_id = i;
+    engine->bake.result_layers_num = targets->images_num * objects_num;
+    engine->bake.result_layers = MEM_calloc_arrayN<BakeResultLayer>(
+        engine->bake.result_layers_num, __func__);
+
+    for (int object_id = 0; object_id < objects_num; object_id++) {
+      engine->bake.object_id = object_id;
+
+      for (int i = 0; i < targets->images_num; i++) {
+        const BakeImage *image = &targets->images[i];
+        engine->bake.image_id = i;
+
+        type->bake(engine,
+                   engine->depsgraph,
+                   objects[object_id],
+                   pass_type,
+                   pass_filter,
+                   image->width,
+                   image->height);
+      }
 
-      type->bake(
-          engine, engine->depsgraph, object, pass_type, pass_filter, image->width, image->height);
+      if (RE_engine_test_break(engine)) {
+        break;
+      }
     }
 
     /* Optionally let render images read bake images from disk delayed. */
@@ -828,6 +872,7 @@ bool RE_bake_engine(Render *re,
       type->render_frame_finish(engine);
     }
 
+    MEM_freeN(engine->bake.result_layers);
     memset(&engine->bake, 0, sizeof(engine->bake));
 
     engine->depsgraph = nullptr;
@@ -1065,9 +1110,8 @@ bool RE_engine_render(Render *re, bool do_all)
   /* TODO: actually link to a parent which shouldn't happen */
   engine->re = re;
 
-  if (re->flag & R_ANIMATION) {
-    engine->flag |= RE_ENGINE_ANIMATION;
-  }
+  /* The engine may be kept from a previous render with persistent data. */
+  SET_FLAG_FROM_TEST(engine->flag, re->flag & R_ANIMATION, RE_ENGINE_ANIMATION);
   if (re->r.scemode & R_BUTS_PREVIEW) {
     engine->flag |= RE_ENGINE_PREVIEW;
   }
@@ -1106,6 +1150,10 @@ bool RE_engine_render(Render *re, bool do_all)
 
   /* Perform delayed grease pencil rendering. */
   if (delay_grease_pencil) {
+    /* Grease pencil draws into passes that the engine might not have written. */
+    RE_AcquireResultWrite(re);
+    RE_ReleaseResult(re);
+
     FOREACH_VIEW_LAYER_TO_RENDER_BEGIN (re, view_layer_iter) {
       const bool use_grease_pencil = (view_layer_iter->layflag & SCE_LAY_GREASE_PENCIL) != 0;
       if (!use_grease_pencil) {
@@ -6,6 +6,7 @@
  * \ingroup render
  */
 
+#include <algorithm>
 #include <cstring>
 
 #include "MEM_guardedalloc.h"
@@ -40,6 +41,18 @@
 #include "IMB_imbuf.hh"
 #include "IMB_imbuf_types.hh"
 
+/**
+ * Grids of a subdivided #DerivedMesh. The grid arrays are lazily created by the derived mesh and
+ * reached through its callbacks, so they are looked up once before baking instead of for every
+ * baked pixel.
+ */
+struct MultiresBakeGrids {
+  CCGKey key;
+  int grid_size;
+  CCGElem **grid_data;
+  const int *grid_offset;
+};
+
 using MPassKnownData = void (*)(blender::Span<blender::float3> vert_positions,
                                 blender::Span<blender::float3> vert_normals,
                                 blender::OffsetIndices<int> faces,
@@ -47,7 +60,7 @@ using MPassKnownData = void (*)(blender::Span<blender::float3> vert_positions,
                                 blender::Span<blender::int3> corner_tris,
                                 blender::Span<int> tri_faces,
                                 blender::Span<blender::float2> uv_map,
-                                DerivedMesh *hires_dm,
+                                const MultiresBakeGrids &hires_grids,
                                 void *thread_data,
                                 void *bake_data,
                                 ImBuf *ibuf,
@@ -86,7 +99,7 @@ struct MResolvePixelData {
   int w, h;
   int tri_index;
 
-  DerivedMesh *hires_dm;
+  const MultiresBakeGrids *hires_grids;
 
   int lvl;
   void *thread_data;
@@ -110,6 +123,7 @@ struct MBakeRast {
 struct MHeightBakeData {
   float *heights;
   DerivedMesh *ssdm;
+  MultiresBakeGrids ssdm_grids;
   const int *orig_index_mp_to_orig;
 };
 
@@ -213,7 +227,7 @@ static void flush_pixel(const MResolvePixelData *data, const int x, const int y)
                   data->corner_tris,
                   data->tri_faces,
                   data->uv_map,
-                  data->hires_dm,
+                  *data->hires_grids,
                   data->thread_data,
                   data->bake_data,
                   data->ibuf,
@@ -371,22 +385,21 @@ struct MultiresBakeThread {
   float height_min, height_max;
 };
 
-static int multires_bake_queue_next_tri(MultiresBakeQueue *queue)
-{
-  int face = -1;
-
-  /* TODO: it could worth making it so thread will handle neighbor faces
-   *       for better memory cache utilization
-   */
+/**
+ * Number of triangles a thread takes from the queue at once. Neighbor triangles are mostly next to
+ * each other in the array, so this also improves memory cache utilization.
+ */
+#define MULTIRES_BAKE_QUEUE_CHUNK_SIZE 32
 
+static blender::IndexRange multires_bake_queue_next_tris(MultiresBakeQueue *queue)
+{
   BLI_spin_lock(&queue->spin);
-  if (queue->cur_tri < queue->tot_tri) {
-    face = queue->cur_tri;
-    queue->cur_tri++;
-  }
+  const int start = queue->cur_tri;
+  const int size = std::min(MULTIRES_BAKE_QUEUE_CHUNK_SIZE, queue->tot_tri - queue->cur_tri);
+  queue->cur_tri += size;
   BLI_spin_unlock(&queue->spin);
 
-  return face;
+  return blender::IndexRange(start, size);
 }
 
 static void *do_multires_bake_thread(void *data_v)
@@ -395,30 +408,33 @@ static void *do_multires_bake_thread(void *data_v)
   MResolvePixelData *data = &handle->data;
   MBakeRast *bake_rast = &handle->bake_rast;
   MultiresBakeRender *bkr = handle->bkr;
-  int tri_index;
-
-  while ((tri_index = multires_bake_queue_next_tri(handle->queue)) >= 0) {
-    const blender::int3 &tri = data->corner_tris[tri_index];
-    const int face_i = data->tri_faces[tri_index];
-    const short mat_nr = data->material_indices == nullptr ? 0 : data->material_indices[face_i];
 
-    if (multiresbake_test_break(bkr)) {
+  while (true) {
+    const blender::IndexRange tris = multires_bake_queue_next_tris(handle->queue);
+    if (tris.is_empty() || multiresbake_test_break(bkr)) {
       break;
     }
 
-    Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : nullptr;
-    if (tri_image != handle->image) {
-      continue;
-    }
+    for (const int tri_index : tris) {
+      const blender::int3 &tri = data->corner_tris[tri_index];
+      const int face_i = data->tri_faces[tri_index];
+      const short mat_nr = data->material_indices == nullptr ? 0 :
+                                                               data->material_indices[face_i];
 
-    data->tri_index = tri_index;
+      Image *tri_image = mat_nr < bkr->ob_image.len ? bkr->ob_image.array[mat_nr] : nullptr;
+      if (tri_image != handle->image) {
+        continue;
+      }
+
+      data->tri_index = tri_index;
 
-    float uv[3][2];
-    sub_v2_v2v2(uv[0], data->uv_map[tri[0]], data->uv_offset);
-    sub_v2_v2v2(uv[1], data->uv_map[tri[1]], data->uv_offset);
-    sub_v2_v2v2(uv[2], data->uv_map[tri[2]], data->uv_offset);
+      float uv[3][2];
+      sub_v2_v2v2(uv[0], data->uv_map[tri[0]], data->uv_offset);
+      sub_v2_v2v2(uv[1], data->uv_map[tri[1]], data->uv_offset);
+      sub_v2_v2v2(uv[2], data->uv_map[tri[2]], data->uv_offset);
 
-    bake_rasterize(bake_rast, uv[0], uv[1], uv[2]);
+      bake_rasterize(bake_rast, uv[0], uv[1], uv[2]);
+    }
 
     /* tag image buffer for refresh */
     if (data->ibuf->float_buffer.data) {
@@ -429,7 +445,7 @@ static void *do_multires_bake_thread(void *data_v)
 
     /* update progress */
     BLI_spin_lock(&handle->queue->spin);
-    bkr->baked_faces++;
+    bkr->baked_faces += tris.size();
 
     if (bkr->do_update) {
       *bkr->do_update = true;
@@ -446,25 +462,14 @@ static void *do_multires_bake_thread(void *data_v)
   return nullptr;
 }
 
-/* some of arrays inside ccgdm are lazy-initialized, which will generally
- * require lock around accessing such data
- * this function will ensure all arrays are allocated before threading started
- */
-static void init_ccgdm_arrays(DerivedMesh *dm)
+/* Some of arrays inside ccgdm are lazy-initialized, which would require a lock around accessing
+ * such data. This function ensures all arrays are allocated before threading started. */
+static void bake_grids_init(DerivedMesh *dm, MultiresBakeGrids *r_grids)
 {
-  CCGElem **grid_data;
-  CCGKey key;
-  int grid_size;
-  const int *grid_offset;
-
-  grid_size = dm->getGridSize(dm);
-  grid_data = dm->getGridData(dm);
-  grid_offset = dm->getGridOffset(dm);
-  dm->getGridKey(dm, &key);
-
-  (void)grid_size;
-  (void)grid_data;
-  (void)grid_offset;
+  r_grids->grid_size = dm->getGridSize(dm);
+  r_grids->grid_data = dm->getGridData(dm);
+  r_grids->grid_offset = dm->getGridOffset(dm);
+  dm->getGridKey(dm, &r_grids->key);
 }
 
 static void do_multires_bake(MultiresBakeRender *bkr,
@@ -578,7 +583,8 @@ static void do_multires_bake(MultiresBakeRender *bkr,
 
   Array<MultiresBakeThread> handles(tot_thread);
 
-  init_ccgdm_arrays(bkr->hires_dm);
+  MultiresBakeGrids hires_grids;
+  bake_grids_init(bkr->hires_dm, &hires_grids);
 
   /* faces queue */
   queue.cur_tri = 0;
@@ -610,7 +616,7 @@ static void do_multires_bake(MultiresBakeRender *bkr,
     handle->data.pvtangent = pvtangent;
     handle->data.w = ibuf->x;
     handle->data.h = ibuf->y;
-    handle->data.hires_dm = bkr->hires_dm;
+    handle->data.hires_grids = &hires_grids;
     handle->data.lvl = lvl;
     handle->data.pass_data = passKnownData;
     handle->data.thread_data = handle;
@@ -685,7 +691,7 @@ static void interp_bilinear_grid(
 }
 
 static void get_ccgdm_data(const blender::OffsetIndices<int> lores_polys,
-                           DerivedMesh *hidm,
+                           const MultiresBakeGrids &grids,
                            const int *index_mp_to_orig,
                            const int lvl,
                            const int face_index,
@@ -694,16 +700,12 @@ static void get_ccgdm_data(const blender::OffsetIndices<int> lores_polys,
                            float co[3],
                            float n[3])
 {
-  CCGElem **grid_data;
-  CCGKey key;
+  const CCGKey &key = grids.key;
+  CCGElem *const *grid_data = grids.grid_data;
+  const int *grid_offset = grids.grid_offset;
+  const int grid_size = grids.grid_size;
   float crn_x, crn_y;
-  int grid_size, S, face_side;
-  int *grid_offset, g_index;
-
-  grid_size = hidm->getGridSize(hidm);
-  grid_data = hidm->getGridData(hidm);
-  grid_offset = hidm->getGridOffset(hidm);
-  hidm->getGridKey(hidm, &key);
+  int S, face_side, g_index;
 
   if (lvl == 0) {
     face_side = (grid_size << 1) - 1;
@@ -837,7 +839,7 @@ static void *init_heights_data(MultiresBakeRender *bkr, ImBuf *ibuf)
 
       height_data->ssdm = subsurf_make_derived_from_derived(
           bkr->lores_dm, &smd, bkr->scene, nullptr, SubsurfFlags(0));
-      init_ccgdm_arrays(height_data->ssdm);
+      bake_grids_init(height_data->ssdm, &height_data->ssdm_grids);
     }
   }
 
@@ -871,7 +873,7 @@ static void apply_heights_callback(const blender::Span<blender::float3> vert_pos
                                    const blender::Span<blender::int3> corner_tris,
                                    const blender::Span<int> tri_faces,
                                    const blender::Span<blender::float2> uv_map,
-                                   DerivedMesh *hires_dm,
+                                   const MultiresBakeGrids &hires_grids,
                                    void *thread_data_v,
                                    void *bake_data,
                                    ImBuf *ibuf,
@@ -910,12 +912,19 @@ static void apply_heights_callback(const blender::Span<blender::float3> vert_pos
 
   clamp_v2(uv, 0.0f, 1.0f);
 
-  get_ccgdm_data(
-      faces, hires_dm, height_data->orig_index_mp_to_orig, lvl, face_i, uv[0], uv[1], p1, nullptr);
+  get_ccgdm_data(faces,
+                 hires_grids,
+                 height_data->orig_index_mp_to_orig,
+                 lvl,
+                 face_i,
+                 uv[0],
+                 uv[1],
+                 p1,
+                 nullptr);
 
   if (height_data->ssdm) {
     get_ccgdm_data(faces,
-                   height_data->ssdm,
+                   height_data->ssdm_grids,
                    height_data->orig_index_mp_to_orig,
                    0,
                    face_i,
@@ -994,7 +1003,7 @@ static void apply_tangmat_callback(const blender::Span<blender::float3> /*vert_p
                                    const blender::Span<blender::int3> corner_tris,
                                    const blender::Span<int> tri_faces,
                                    const blender::Span<blender::float2> uv_map,
-                                   DerivedMesh *hires_dm,
+                                   const MultiresBakeGrids &hires_grids,
                                    void * /*thread_data*/,
                                    void *bake_data,
                                    ImBuf *ibuf,
@@ -1032,8 +1041,15 @@ static void apply_tangmat_callback(const blender::Span<blender::float3> /*vert_p
 
   clamp_v2(uv, 0.0f, 1.0f);
 
-  get_ccgdm_data(
-      faces, hires_dm, normal_data->orig_index_mp_to_orig, lvl, face_i, uv[0], uv[1], nullptr, n);
+  get_ccgdm_data(faces,
+                 hires_grids,
+                 normal_data->orig_index_mp_to_orig,
+                 lvl,
+                 face_i,
+                 uv[0],
+                 uv[1],
+                 nullptr,
+                 n);
 
   mul_v3_m3v3(vec, tangmat, n);
   normalize_v3_length(vec, 0.5);
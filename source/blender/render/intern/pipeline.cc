@@ -8,7 +8,9 @@
 
 #include <fmt/format.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <condition_variable>
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
@@ -32,6 +34,7 @@
 #include "BLI_rect.h"
 #include "BLI_set.hh"
 #include "BLI_string.h"
+#include "BLI_task.h"
 #include "BLI_threads.h"
 #include "BLI_time.h"
 #include "BLI_timecode.h"
@@ -65,6 +68,7 @@
 
 #include "COM_compositor.hh"
 #include "COM_context.hh"
+#include "COM_profiler.hh"
 #include "COM_render_context.hh"
 
 #include "DEG_depsgraph.hh"
@@ -169,8 +173,13 @@ static void render_callback_exec_id(Render *re, Main *bmain, ID *id, eCbEvent ev
 /** \name Allocation & Free
  * \{ */
 
-static bool do_write_image_or_movie(
-    Render *re, Main *bmain, Scene *scene, const int totvideos, const char *filepath_override);
+struct RenderWriteQueue;
+static bool do_write_image_or_movie(Render *re,
+                                    Main *bmain,
+                                    Scene *scene,
+                                    const int totvideos,
+                                    const char *filepath_override,
+                                    RenderWriteQueue *write_queue = nullptr);
 
 /* default callbacks, set in each new render */
 static void result_nothing(void * /*arg*/, RenderResult * /*rr*/) {}
@@ -280,7 +289,17 @@ bool RE_HasSingleLayer(Render *re)
 RenderResult *RE_MultilayerConvert(
     void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty)
 {
-  return render_result_new_from_exr(exrhandle, colorspace, predivide, rectx, recty);
+  return render_result_new_from_exr(exrhandle, colorspace, predivide, rectx, recty, nullptr);
+}
+
+RenderResult *RE_MultilayerConvertLazy(void *exrhandle,
+                                       const char *filepath,
+                                       const char *colorspace,
+                                       bool predivide,
+                                       int rectx,
+                                       int recty)
+{
+  return render_result_new_from_exr(exrhandle, colorspace, predivide, rectx, recty, filepath);
 }
 
 RenderLayer *render_get_single_layer(Render *re, RenderResult *rr)
@@ -349,6 +368,16 @@ RenderResult *RE_AcquireResultWrite(Render *re)
   return nullptr;
 }
 
+RenderResult *RE_AcquireResultWriteViews(Render *re)
+{
+  if (re) {
+    BLI_rw_mutex_lock(&re->resultmutex, THREAD_LOCK_WRITE);
+    return re->result;
+  }
+
+  return nullptr;
+}
+
 void RE_ClearResult(Render *re)
 {
   if (re) {
@@ -672,7 +701,7 @@ static void re_gpu_texture_caches_free(Render *re)
 
   /* Free textures. */
   if (re->result_has_gpu_texture_caches) {
-    RenderResult *result = RE_AcquireResultWrite(re);
+    RenderResult *result = RE_AcquireResultWriteViews(re);
     if (result != nullptr) {
       render_result_free_gpu_texture_caches(result);
     }
@@ -1388,6 +1417,11 @@ static void do_render_compositor(Render *re)
                             blender::compositor::OutputTypes::Previews;
         }
 
+        /* Only profile the compositor when a profile was requested from the command line. */
+        const bool write_profile = G.compositor_profile_filepath[0] != '\0';
+        blender::compositor::Profiler profiler;
+        profiler.set_synchronize_gpu(true);
+
         blender::compositor::RenderContext compositor_render_context;
         LISTBASE_FOREACH (RenderView *, rv, &re->result->views) {
           COM_execute(re,
@@ -1396,11 +1430,15 @@ static void do_render_compositor(Render *re)
                       ntree,
                       rv->name,
                       &compositor_render_context,
-                      nullptr,
+                      write_profile ? &profiler : nullptr,
                       needed_outputs);
         }
         compositor_render_context.save_file_outputs(re->pipeline_scene_eval);
 
+        if (write_profile && !profiler.write_json(*ntree, G.compositor_profile_filepath)) {
+          printf("Unable to write compositor profile to '%s'\n", G.compositor_profile_filepath);
+        }
+
         ntree->runtime->stats_draw = nullptr;
         ntree->runtime->test_break = nullptr;
         ntree->runtime->progress = nullptr;
@@ -2302,8 +2340,134 @@ bool RE_WriteRenderViewsMovie(ReportList *reports,
   return ok;
 }
 
-static bool do_write_image_or_movie(
-    Render *re, Main *bmain, Scene *scene, const int totvideos, const char *filepath_override)
+/* -------------------------------------------------------------------- */
+/** \name Background Writing
+ *
+ * With #R_BACKGROUND_WRITE, the frames of an image sequence are saved in background threads while
+ * the next frames render. The number of frames being saved at once and their total memory are
+ * limited by #RenderData.background_write_frames and #RenderData.background_write_memory. Once a
+ * limit is reached, rendering waits until a frame is written.
+ * \{ */
+
+struct RenderWriteQueue {
+  TaskPool *task_pool = nullptr;
+  /** Maximum number of frames being saved at once. */
+  int max_frames = 1;
+  /** Maximum memory of the frames being saved at once in bytes, zero for no limit. */
+  int64_t max_memory = 0;
+
+  /** Protects the members below, which are modified by the write tasks. */
+  std::mutex mutex;
+  /** Notified every time a frame is written. */
+  std::condition_variable frame_written;
+  /** Number of frames being saved and their memory in bytes. */
+  int frames = 0;
+  int64_t memory = 0;
+  /** False when saving one of the frames failed. */
+  bool ok = true;
+};
+
+struct RenderWriteTaskData {
+  RenderWriteQueue *queue;
+  ReportList *reports;
+  RenderResult *rr;
+  /** Memory accounted for the frame in the queue. */
+  int64_t memory;
+  /** Copy of the scene at the time the frame was rendered, the frame changes afterwards. */
+  Scene tmp_scene;
+  char filepath[FILE_MAX];
+};
+
+static int64_t render_result_size_in_memory(const RenderResult *rr)
+{
+  int64_t size = 0;
+  LISTBASE_FOREACH (const RenderView *, rv, &rr->views) {
+    if (rv->ibuf) {
+      size += IMB_get_size_in_memory(rv->ibuf);
+    }
+  }
+  LISTBASE_FOREACH (const RenderLayer *, rl, &rr->layers) {
+    LISTBASE_FOREACH (const RenderPass *, rp, &rl->passes) {
+      if (rp->ibuf) {
+        size += IMB_get_size_in_memory(rp->ibuf);
+      }
+    }
+  }
+  return size;
+}
+
+static void render_write_task(TaskPool *__restrict /*pool*/, void *taskdata)
+{
+  RenderWriteTaskData *task_data = static_cast<RenderWriteTaskData *>(taskdata);
+  const bool ok = BKE_image_render_write(
+      task_data->reports, task_data->rr, &task_data->tmp_scene, true, task_data->filepath);
+  RE_FreeRenderResult(task_data->rr);
+
+  RenderWriteQueue *queue = task_data->queue;
+  {
+    std::lock_guard lock(queue->mutex);
+    queue->frames--;
+    queue->memory -= task_data->memory;
+    if (!ok) {
+      queue->ok = false;
+    }
+  }
+  queue->frame_written.notify_all();
+}
+
+/** Wait until all frames being saved are written. \return False when saving a frame failed. */
+static bool render_write_queue_wait(RenderWriteQueue *queue)
+{
+  BLI_task_pool_work_and_wait(queue->task_pool);
+  std::lock_guard lock(queue->mutex);
+  return queue->ok;
+}
+
+static bool render_write_queue_push(RenderWriteQueue *queue,
+                                    Render *re,
+                                    Scene *scene,
+                                    RenderResult *rr,
+                                    const char *filepath)
+{
+  const int64_t memory = render_result_size_in_memory(rr);
+  {
+    /* Wait for room in the queue. A single frame is always accepted, even if it is larger than
+     * the memory limit, otherwise it could never be saved. */
+    std::unique_lock lock(queue->mutex);
+    queue->frame_written.wait(lock, [&]() {
+      if (!queue->ok || queue->frames == 0) {
+        return true;
+      }
+      return queue->frames < queue->max_frames &&
+             (queue->max_memory == 0 || queue->memory + memory <= queue->max_memory);
+    });
+    if (!queue->ok) {
+      return false;
+    }
+    queue->frames++;
+    queue->memory += memory;
+  }
+
+  RenderWriteTaskData *task_data = MEM_callocN<RenderWriteTaskData>(__func__);
+  task_data->queue = queue;
+  /* Reports are thread safe. */
+  task_data->reports = re->reports;
+  task_data->rr = RE_DuplicateRenderResult(rr);
+  task_data->memory = memory;
+  memcpy(&task_data->tmp_scene, scene, sizeof(task_data->tmp_scene));
+  STRNCPY(task_data->filepath, filepath);
+  BLI_task_pool_push(queue->task_pool, render_write_task, task_data, true, nullptr);
+  return true;
+}
+
+/** \} */
+
+static bool do_write_image_or_movie(Render *re,
+                                    Main *bmain,
+                                    Scene *scene,
+                                    const int totvideos,
+                                    const char *filepath_override,
+                                    RenderWriteQueue *write_queue)
 {
   char filepath[FILE_MAX];
   RenderResult rres;
@@ -2349,7 +2513,12 @@ static bool do_write_image_or_movie(
 
       /* write images as individual images or stereo */
       if (ok) {
-        ok = BKE_image_render_write(re->reports, &rres, scene, true, filepath);
+        if (write_queue) {
+          ok = render_write_queue_push(write_queue, re, scene, &rres, filepath);
+        }
+        else {
+          ok = BKE_image_render_write(re->reports, &rres, scene, true, filepath);
+        }
       }
     }
 
@@ -2484,6 +2653,15 @@ void RE_RenderAnim(Render *re,
     }
   }
 
+  /* Save the frames of image sequences while the next frame renders. */
+  RenderWriteQueue write_queue;
+  const bool use_write_queue = !is_movie && do_write_file && (rd.mode & R_BACKGROUND_WRITE);
+  if (use_write_queue) {
+    write_queue.task_pool = BLI_task_pool_create_background(nullptr, TASK_PRIORITY_HIGH);
+    write_queue.max_frames = std::max<int>(rd.background_write_frames, 1);
+    write_queue.max_memory = int64_t(rd.background_write_memory) * 1024 * 1024;
+  }
+
   /* Ugly global still... is to prevent renderwin events and signal subdivision-surface etc
    * to make full resolution is also set by caller renderwin.c */
   G.is_rendering = true;
@@ -2629,7 +2807,13 @@ void RE_RenderAnim(Render *re,
     const bool should_write = !(re->flag & R_SKIP_WRITE);
     if (re->test_break_cb(re->tbh) == 0) {
       if (!G.is_break && should_write) {
-        if (!do_write_image_or_movie(re, bmain, scene, totvideos, nullptr)) {
+        if (!do_write_image_or_movie(re,
+                                     bmain,
+                                     scene,
+                                     totvideos,
+                                     nullptr,
+                                     use_write_queue ? &write_queue : nullptr))
+        {
           G.is_break = true;
         }
       }
@@ -2684,6 +2868,13 @@ void RE_RenderAnim(Render *re,
     re_movie_free_all(re);
   }
 
+  if (use_write_queue) {
+    if (!render_write_queue_wait(&write_queue)) {
+      G.is_break = true;
+    }
+    BLI_task_pool_free(write_queue.task_pool);
+  }
+
   if (totskipped && totrendered == 0) {
     BKE_report(re->reports, RPT_INFO, "No frames rendered, skipped to not overwrite");
   }
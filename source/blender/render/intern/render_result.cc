@@ -10,16 +10,19 @@
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 
 #include "MEM_guardedalloc.h"
 
 #include "BLI_hash_md5.hh"
 #include "BLI_listbase.h"
+#include "BLI_mutex.hh"
 #include "BLI_path_utils.hh"
 #include "BLI_rect.h"
 #include "BLI_string.h"
 #include "BLI_string_utils.hh"
 #include "BLI_utildefines.h"
+#include "BLI_vector.hh"
 
 #include "DNA_userdef_types.h"
 
@@ -41,6 +44,15 @@
 #include "render_result.h"
 #include "render_types.h"
 
+/** State to read the pixels of passes of a multi-layer file on demand. */
+struct RenderResultLazyRead {
+  std::string filepath;
+  std::string colorspace;
+  bool predivide = false;
+  /** Passes may be read from different threads. */
+  blender::Mutex mutex;
+};
+
 /* -------------------------------------------------------------------- */
 /** \name Free
  * \{ */
@@ -101,6 +113,8 @@ void render_result_free(RenderResult *rr)
 
   BKE_stamp_data_free(rr->stamp_data);
 
+  MEM_delete(rr->lazy_read);
+
   MEM_freeN(rr);
 }
 
@@ -395,6 +409,48 @@ void render_result_passes_allocated_ensure(RenderResult *rr)
   rr->passes_allocated = true;
 }
 
+static bool render_pass_is_allocated(const RenderPass *rp)
+{
+  return rp->ibuf && rp->ibuf->float_buffer.data;
+}
+
+void render_result_passes_allocated_ensure_for_merge(RenderResult *rr, const RenderResult *rrpart)
+{
+  if (rr == nullptr || rr->passes_allocated) {
+    return;
+  }
+
+  bool all_allocated = true;
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    const RenderLayer *rlp = static_cast<const RenderLayer *>(
+        BLI_findstring(&rrpart->layers, rl->name, offsetof(RenderLayer, name)));
+
+    LISTBASE_FOREACH (RenderPass *, rp, &rl->passes) {
+      /* Same as for the full allocation, passes saved to disk are not allocated. */
+      if (rl->exrhandle != nullptr && !STREQ(rp->name, RE_PASSNAME_COMBINED)) {
+        continue;
+      }
+      if (render_pass_is_allocated(rp)) {
+        continue;
+      }
+
+      const RenderPass *rpp = nullptr;
+      if (rlp) {
+        rpp = static_cast<const RenderPass *>(
+            BLI_findstring(&rlp->passes, rp->fullname, offsetof(RenderPass, fullname)));
+      }
+      if (rpp && render_pass_is_allocated(rpp)) {
+        render_layer_allocate_pass(rr, rp);
+      }
+      else {
+        all_allocated = false;
+      }
+    }
+  }
+
+  rr->passes_allocated = all_allocated;
+}
+
 void render_result_clone_passes(Render *re, RenderResult *rr, const char *viewname)
 {
   LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
@@ -707,13 +763,42 @@ static int order_render_passes(const void *a, const void *b)
   return (rpa->view_id < rpb->view_id);
 }
 
-RenderResult *render_result_new_from_exr(
-    void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty)
+/* Convert the pixels of a pass read from an EXR file to the scene linear color space. */
+static void render_result_pass_colorspace_from_exr(RenderPass *rpass,
+                                                   const char *colorspace,
+                                                   const bool predivide)
+{
+  if (RE_RenderPassIsColor(rpass)) {
+    IMB_colormanagement_transform_float(
+        rpass->ibuf->float_buffer.data,
+        rpass->rectx,
+        rpass->recty,
+        rpass->channels,
+        colorspace,
+        IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_SCENE_LINEAR),
+        predivide);
+  }
+  else {
+    IMB_colormanagement_assign_float_colorspace(
+        rpass->ibuf, IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DATA));
+  }
+}
+
+RenderResult *render_result_new_from_exr(void *exrhandle,
+                                         const char *colorspace,
+                                         bool predivide,
+                                         int rectx,
+                                         int recty,
+                                         const char *lazy_read_filepath)
 {
   RenderResult *rr = MEM_callocN<RenderResult>(__func__);
-  const char *to_colorspace = IMB_colormanagement_role_colorspace_name_get(
-      COLOR_ROLE_SCENE_LINEAR);
-  const char *data_colorspace = IMB_colormanagement_role_colorspace_name_get(COLOR_ROLE_DATA);
+
+  if (lazy_read_filepath) {
+    rr->lazy_read = MEM_new<RenderResultLazyRead>(__func__);
+    rr->lazy_read->filepath = lazy_read_filepath;
+    rr->lazy_read->colorspace = colorspace;
+    rr->lazy_read->predivide = predivide;
+  }
 
   rr->rectx = rectx;
   rr->recty = recty;
@@ -734,17 +819,8 @@ RenderResult *render_result_new_from_exr(
 
       copy_v2_v2_db(rpass->ibuf->ppm, rr->ppm);
 
-      if (RE_RenderPassIsColor(rpass)) {
-        IMB_colormanagement_transform_float(rpass->ibuf->float_buffer.data,
-                                            rpass->rectx,
-                                            rpass->recty,
-                                            rpass->channels,
-                                            colorspace,
-                                            to_colorspace,
-                                            predivide);
-      }
-      else {
-        IMB_colormanagement_assign_float_colorspace(rpass->ibuf, data_colorspace);
+      if (!lazy_read_filepath) {
+        render_result_pass_colorspace_from_exr(rpass, colorspace, predivide);
       }
     }
   }
@@ -752,6 +828,92 @@ RenderResult *render_result_new_from_exr(
   return rr;
 }
 
+static bool render_pass_needs_lazy_read(const RenderPass *rpass)
+{
+  return rpass->ibuf && rpass->ibuf->float_buffer.data == nullptr;
+}
+
+/* Read the pixels of the given passes from the file of a lazily loaded render result. */
+static void render_result_lazy_read_passes(
+    RenderResult *rr, const blender::Span<std::pair<RenderLayer *, RenderPass *>> passes)
+{
+  const RenderResultLazyRead &lazy_read = *rr->lazy_read;
+  void *exrhandle = IMB_exr_get_handle();
+  int rectx, recty;
+
+  bool is_valid = IMB_exr_begin_read_passes(
+      exrhandle, lazy_read.filepath.c_str(), &rectx, &recty);
+  if (is_valid && (rectx != rr->rectx || recty != rr->recty)) {
+    is_valid = false;
+  }
+  if (!is_valid) {
+    BKE_reportf(nullptr,
+                RPT_WARNING,
+                "Reading render result: cannot read passes from \"%s\"",
+                lazy_read.filepath.c_str());
+  }
+
+  bool found_passes = false;
+  for (const auto &[rl, rpass] : passes) {
+    /* Passes that can't be read stay black, instead of trying again on every access. */
+    float *rect = MEM_calloc_arrayN<float>(
+        size_t(rr->rectx) * size_t(rr->recty) * size_t(rpass->channels), "loaded pass");
+    RE_pass_set_buffer_data(rpass, rect);
+    if (is_valid && IMB_exr_set_pass_rect(exrhandle, rl->name, rpass->name, rpass->view, rect)) {
+      found_passes = true;
+    }
+  }
+
+  if (found_passes) {
+    IMB_exr_read_channels(exrhandle);
+  }
+  IMB_exr_close(exrhandle);
+
+  for (const auto &[rl, rpass] : passes) {
+    render_result_pass_colorspace_from_exr(
+        rpass, lazy_read.colorspace.c_str(), lazy_read.predivide);
+  }
+}
+
+void RE_pass_ensure_loaded(RenderResult *rr, RenderPass *rpass)
+{
+  if (rr == nullptr || rr->lazy_read == nullptr) {
+    return;
+  }
+
+  std::scoped_lock lock(rr->lazy_read->mutex);
+  if (!render_pass_needs_lazy_read(rpass)) {
+    return;
+  }
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    if (BLI_findindex(&rl->passes, rpass) != -1) {
+      const std::pair<RenderLayer *, RenderPass *> pass{rl, rpass};
+      render_result_lazy_read_passes(rr, {&pass, 1});
+      return;
+    }
+  }
+}
+
+void RE_render_result_ensure_loaded(RenderResult *rr)
+{
+  if (rr == nullptr || rr->lazy_read == nullptr) {
+    return;
+  }
+
+  std::scoped_lock lock(rr->lazy_read->mutex);
+  blender::Vector<std::pair<RenderLayer *, RenderPass *>> passes;
+  LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
+    LISTBASE_FOREACH (RenderPass *, rpass, &rl->passes) {
+      if (render_pass_needs_lazy_read(rpass)) {
+        passes.append({rl, rpass});
+      }
+    }
+  }
+  if (!passes.is_empty()) {
+    render_result_lazy_read_passes(rr, passes);
+  }
+}
+
 void render_result_view_new(RenderResult *rr, const char *viewname)
 {
   RenderView *rv = MEM_callocN<RenderView>("new render view");
@@ -1077,7 +1239,7 @@ bool render_result_exr_file_cache_read(Render *re)
   RE_FreeRenderResult(re->result);
 
   IMB_exr_read_channels(exrhandle);
-  re->result = render_result_new_from_exr(exrhandle, colorspace, false, rectx, recty);
+  re->result = render_result_new_from_exr(exrhandle, colorspace, false, rectx, recty, nullptr);
 
   IMB_exr_close(exrhandle);
 
@@ -1337,8 +1499,12 @@ static RenderView *duplicate_render_view(RenderView *rview)
 
 RenderResult *RE_DuplicateRenderResult(RenderResult *rr)
 {
+  /* The copy doesn't read pixels from the file itself. */
+  RE_render_result_ensure_loaded(rr);
+
   RenderResult *new_rr = MEM_dupallocN<RenderResult>("new duplicated render result", *rr);
   new_rr->next = new_rr->prev = nullptr;
+  new_rr->lazy_read = nullptr;
   new_rr->layers.first = new_rr->layers.last = nullptr;
   new_rr->views.first = new_rr->views.last = nullptr;
   LISTBASE_FOREACH (RenderLayer *, rl, &rr->layers) {
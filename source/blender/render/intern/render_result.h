@@ -40,13 +40,26 @@ struct RenderResult *render_result_new(struct Render *re,
                                        const char *viewname);
 
 void render_result_passes_allocated_ensure(struct RenderResult *rr);
+/**
+ * Only allocate the passes of `rr` which `rrpart` has pixels for, such that passes which render
+ * engines never write don't use memory. Tags `rr` as allocated once all its passes are.
+ */
+void render_result_passes_allocated_ensure_for_merge(struct RenderResult *rr,
+                                                     const struct RenderResult *rrpart);
 
 /**
  * From `imbuf`, if a handle was returned and
  * it's not a single-layer multi-view we convert this to render result.
+ *
+ * \param lazy_read_filepath: When not null, the handle was read with #IB_multilayer_lazy and
+ * the pixels of passes are read from this file when needed, see #RE_pass_ensure_loaded.
  */
-struct RenderResult *render_result_new_from_exr(
-    void *exrhandle, const char *colorspace, bool predivide, int rectx, int recty);
+struct RenderResult *render_result_new_from_exr(void *exrhandle,
+                                                const char *colorspace,
+                                                bool predivide,
+                                                int rectx,
+                                                int recty,
+                                                const char *lazy_read_filepath);
 
 void render_result_view_new(struct RenderResult *rr, const char *viewname);
 void render_result_views_new(struct RenderResult *rr, const struct RenderData *rd);
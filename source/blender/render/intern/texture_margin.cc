@@ -6,10 +6,14 @@
  * \ingroup render
  */
 
+#include "BLI_array.hh"
 #include "BLI_assert.h"
+#include "BLI_enumerable_thread_specific.hh"
+#include "BLI_math_base.h"
 #include "BLI_math_geom.h"
 #include "BLI_math_vector.hh"
 #include "BLI_math_vector_types.hh"
+#include "BLI_task.hh"
 #include "BLI_vector.hh"
 
 #include "BKE_attribute.hh"
@@ -29,6 +33,7 @@
 
 #include <algorithm>
 #include <cmath>
+#include <limits>
 
 namespace blender::render::texturemargin {
 
@@ -37,8 +42,8 @@ namespace blender::render::texturemargin {
  * adjacency tables.
  */
 class TextureMarginMap {
-  static const int directions[8][2];
-  static const int distances[8];
+  /** Value of pixels which are not covered by a face. */
+  static constexpr uint32_t unset_pixel = 0xFFFFFFFF;
 
   /** Maps UV-edges to their corresponding UV-edge. */
   Vector<int> loop_adjacency_map_;
@@ -48,6 +53,8 @@ class TextureMarginMap {
   int w_, h_;
   float uv_offset_[2];
   Vector<uint32_t> pixel_data_;
+  /** Index of the closest face pixel of every pixel, computed by #jump_flood. */
+  Array<uint32_t> closest_face_pixel_;
   ZSpan zspan_;
   uint32_t value_to_store_;
   bool write_mask_;
@@ -75,7 +82,7 @@ class TextureMarginMap {
   {
     copy_v2_v2(uv_offset_, uv_offset);
 
-    pixel_data_.resize(w_ * h_, 0xFFFFFFFF);
+    pixel_data_.resize(w_ * h_, unset_pixel);
 
     zbuf_alloc_span(&zspan_, w_, h_);
 
@@ -97,7 +104,7 @@ class TextureMarginMap {
   uint32_t get_pixel(int x, int y) const
   {
     if (x < 0 || y < 0 || x >= w_ || y >= h_) {
-      return 0xFFFFFFFF;
+      return unset_pixel;
     }
 
     return pixel_data_[y * w_ + x];
@@ -139,113 +146,99 @@ class TextureMarginMap {
     }
   }
 
-/* The map contains 2 kinds of pixels: DijkstraPixels and face indices. The top bit determines
- * what kind it is. With the top bit set, it is a 'dijkstra' pixel. The bottom 4 bits encode the
- * direction of the shortest path and the remaining 27 bits are used to store the distance. If
- * the top bit is not set, the rest of the bits is used to store the face index.
- */
-#define PackDijkstraPixel(dist, dir) (0x80000000 + ((dist) << 4) + (dir))
-#define DijkstraPixelGetDistance(dp) (((dp) ^ 0x80000000) >> 4)
-#define DijkstraPixelGetDirection(dp) ((dp) & 0xF)
-#define IsDijkstraPixel(dp) ((dp) & 0x80000000)
-#define DijkstraPixelIsUnset(dp) ((dp) == 0xFFFFFFFF)
-
   /**
-   * Use dijkstra's algorithm to 'grow' a border around the polygons marked in the map.
-   * For each pixel mark which direction is the shortest way to a face.
+   * Use jump flooding to find the closest face pixel of every pixel that is at most `margin`
+   * pixels away from a face. Every pass of the algorithm processes all pixels independently, so
+   * the passes run in parallel.
    */
-  void grow_dijkstra(int margin)
+  void jump_flood(int margin)
   {
-    class DijkstraActivePixel {
-     public:
-      DijkstraActivePixel(int dist, int _x, int _y) : distance(dist), x(_x), y(_y) {}
-      int distance;
-      int x, y;
-    };
-    auto cmp_dijkstrapixel_fun = [](DijkstraActivePixel const &a1, DijkstraActivePixel const &a2) {
-      return a1.distance > a2.distance;
-    };
+    const int64_t pixels_num = int64_t(w_) * h_;
+    closest_face_pixel_.reinitialize(pixels_num);
+    Array<uint32_t> next_closest_face_pixel(pixels_num);
 
-    Vector<DijkstraActivePixel> active_pixels;
-    for (int y = 0; y < h_; y++) {
-      for (int x = 0; x < w_; x++) {
-        if (DijkstraPixelIsUnset(get_pixel(x, y))) {
-          for (int i = 0; i < 8; i++) {
-            int xx = x - directions[i][0];
-            int yy = y - directions[i][1];
-
-            if (xx >= 0 && xx < w_ && yy >= 0 && yy < w_ && !IsDijkstraPixel(get_pixel(xx, yy))) {
-              set_pixel(x, y, PackDijkstraPixel(distances[i], i));
-              active_pixels.append(DijkstraActivePixel(distances[i], x, y));
-              break;
-            }
-          }
-        }
+    threading::parallel_for(IndexRange(pixels_num), 4096, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        closest_face_pixel_[i] = pixel_data_[i] == unset_pixel ? unset_pixel : uint32_t(i);
       }
+    });
+
+    /* Pixels further away than the margin are never used, so start with the smallest step that
+     * still reaches them. Finish with an extra pass of step one to fix most of the errors of the
+     * approximation. */
+    Vector<int> steps;
+    for (int step = power_of_2_max_i(margin + 1); step > 0; step /= 2) {
+      steps.append(step);
     }
-
-    /* Not strictly needed because at this point it already is a heap. */
-#if 0
-    std::make_heap(active_pixels.begin(), active_pixels.end(), cmp_dijkstrapixel_fun);
-#endif
-
-    while (active_pixels.size()) {
-      std::pop_heap(active_pixels.begin(), active_pixels.end(), cmp_dijkstrapixel_fun);
-      DijkstraActivePixel p = active_pixels.pop_last();
-
-      int dist = p.distance;
-
-      if (dist < 2 * (margin + 1)) {
-        for (int i = 0; i < 8; i++) {
-          int x = p.x + directions[i][0];
-          int y = p.y + directions[i][1];
-          if (x >= 0 && x < w_ && y >= 0 && y < h_) {
-            uint32_t dp = get_pixel(x, y);
-            if (IsDijkstraPixel(dp) && (DijkstraPixelGetDistance(dp) > dist + distances[i])) {
-              BLI_assert(DijkstraPixelGetDirection(dp) != i);
-              set_pixel(x, y, PackDijkstraPixel(dist + distances[i], i));
-              active_pixels.append(DijkstraActivePixel(dist + distances[i], x, y));
-              std::push_heap(active_pixels.begin(), active_pixels.end(), cmp_dijkstrapixel_fun);
+    steps.append(1);
+
+    for (const int step : steps) {
+      threading::parallel_for(IndexRange(h_), 16, [&](const IndexRange rows) {
+        for (const int y : rows) {
+          for (int x = 0; x < w_; x++) {
+            const int64_t i = int64_t(y) * w_ + x;
+            uint32_t closest = closest_face_pixel_[i];
+            int64_t closest_distance = pixel_distance_squared(x, y, closest);
+
+            for (int j = -1; j <= 1; j++) {
+              for (int k = -1; k <= 1; k++) {
+                const int xx = x + k * step;
+                const int yy = y + j * step;
+                if ((j == 0 && k == 0) || xx < 0 || xx >= w_ || yy < 0 || yy >= h_) {
+                  continue;
+                }
+                const uint32_t candidate = closest_face_pixel_[int64_t(yy) * w_ + xx];
+                const int64_t distance = pixel_distance_squared(x, y, candidate);
+                if (distance < closest_distance) {
+                  closest = candidate;
+                  closest_distance = distance;
+                }
+              }
             }
+
+            next_closest_face_pixel[i] = closest;
           }
         }
-      }
+      });
+      std::swap(closest_face_pixel_, next_closest_face_pixel);
     }
   }
 
   /**
-   * Walk over the map and for margin pixels follow the direction stored in the bottom 3
-   * bits back to the face.
+   * For margin pixels, look up the face pixel that #jump_flood found to be closest.
    * Then look up the pixel from the next face.
    */
-  void lookup_pixels(ImBuf *ibuf, char *mask, int maxPolygonSteps)
+  void lookup_pixels(ImBuf *ibuf, char *mask, int margin, int maxPolygonSteps)
   {
-    float4 *ibuf_ptr_fl = reinterpret_cast<float4 *>(ibuf->float_buffer.data);
-    uchar4 *ibuf_ptr_ch = reinterpret_cast<uchar4 *>(ibuf->byte_buffer.data);
-    size_t pixel_index = 0;
-    for (int y = 0; y < h_; y++) {
-      for (int x = 0; x < w_; x++) {
-        uint32_t dp = pixel_data_[pixel_index];
-        if (IsDijkstraPixel(dp) && !DijkstraPixelIsUnset(dp)) {
-          int dist = DijkstraPixelGetDistance(dp);
-          int direction = DijkstraPixelGetDirection(dp);
-
-          int xx = x;
-          int yy = y;
-
-          /* Follow the dijkstra directions to find the face this margin pixels belongs to. */
-          while (dist > 0) {
-            xx -= directions[direction][0];
-            yy -= directions[direction][1];
-            dp = get_pixel(xx, yy);
-            dist -= distances[direction];
-            BLI_assert(!dist || (dist == DijkstraPixelGetDistance(dp)));
-            direction = DijkstraPixelGetDirection(dp);
+    /* The new colors of margin pixels are written after all lookups, since margin pixels can be
+     * read by the interpolation of other margin pixels. */
+    struct MarginPixel {
+      int64_t index;
+      float4 color_fl;
+      uchar4 color_ch;
+    };
+    threading::EnumerableThreadSpecific<Vector<MarginPixel>> margin_pixels;
+
+    const int64_t max_distance_squared = int64_t(margin + 1) * (margin + 1);
+    const bool has_float = ibuf->float_buffer.data != nullptr;
+    const bool has_byte = ibuf->byte_buffer.data != nullptr;
+
+    threading::parallel_for(IndexRange(h_), 16, [&](const IndexRange rows) {
+      Vector<MarginPixel> &local_margin_pixels = margin_pixels.local();
+      for (const int y : rows) {
+        for (int x = 0; x < w_; x++) {
+          const int64_t pixel_index = int64_t(y) * w_ + x;
+          const uint32_t closest = closest_face_pixel_[pixel_index];
+          if (pixel_data_[pixel_index] != unset_pixel ||
+              pixel_distance_squared(x, y, closest) > max_distance_squared)
+          {
+            /* These are not margin pixels, make sure the extend filter which is run after this
+             * step leaves them alone. */
+            mask[pixel_index] = 1;
+            continue;
           }
 
-          uint32_t face = get_pixel(xx, yy);
-
-          BLI_assert(!IsDijkstraPixel(face));
+          uint32_t face = pixel_data_[closest];
 
           float destX, destY;
 
@@ -272,31 +265,51 @@ class TextureMarginMap {
             }
 
             if (found_pixel_in_polygon) {
-              if (ibuf_ptr_fl) {
-                ibuf_ptr_fl[pixel_index] = imbuf::interpolate_bilinear_border_fl(
+              MarginPixel margin_pixel;
+              margin_pixel.index = pixel_index;
+              if (has_float) {
+                margin_pixel.color_fl = imbuf::interpolate_bilinear_border_fl(
                     ibuf, destX, destY);
               }
-              if (ibuf_ptr_ch) {
-                ibuf_ptr_ch[pixel_index] = imbuf::interpolate_bilinear_border_byte(
+              if (has_byte) {
+                margin_pixel.color_ch = imbuf::interpolate_bilinear_border_byte(
                     ibuf, destX, destY);
               }
-              /* Add our new pixels to the assigned pixel map. */
-              mask[pixel_index] = 1;
+              local_margin_pixels.append(margin_pixel);
             }
           }
         }
-        else if (DijkstraPixelIsUnset(dp) || !IsDijkstraPixel(dp)) {
-          /* These are not margin pixels, make sure the extend filter which is run after this step
-           * leaves them alone.
-           */
-          mask[pixel_index] = 1;
+      }
+    });
+
+    float4 *ibuf_ptr_fl = reinterpret_cast<float4 *>(ibuf->float_buffer.data);
+    uchar4 *ibuf_ptr_ch = reinterpret_cast<uchar4 *>(ibuf->byte_buffer.data);
+    threading::parallel_for_each(margin_pixels, [&](const Vector<MarginPixel> &local_pixels) {
+      for (const MarginPixel &margin_pixel : local_pixels) {
+        if (ibuf_ptr_fl) {
+          ibuf_ptr_fl[margin_pixel.index] = margin_pixel.color_fl;
+        }
+        if (ibuf_ptr_ch) {
+          ibuf_ptr_ch[margin_pixel.index] = margin_pixel.color_ch;
         }
-        pixel_index++;
+        /* Add our new pixels to the assigned pixel map. */
+        mask[margin_pixel.index] = 1;
       }
-    }
+    });
   }
 
  private:
+  /** Squared distance from the given pixel to the pixel with the given index. */
+  int64_t pixel_distance_squared(const int x, const int y, const uint32_t pixel_index) const
+  {
+    if (pixel_index == unset_pixel) {
+      return std::numeric_limits<int64_t>::max();
+    }
+    const int64_t dx = int64_t(pixel_index % w_) - x;
+    const int64_t dy = int64_t(pixel_index / w_) - y;
+    return dx * dx + dy * dy;
+  }
+
   float2 uv_to_xy(const float2 &mloopuv) const
   {
     float2 ret;
@@ -330,12 +343,17 @@ class TextureMarginMap {
 
   /**
    * Call lookup_pixel for the start_poly. If that fails, try the adjacent polygons as well.
-   * Because the Dijkstra is not very exact in determining which face is the closest, the
-   * face we need can be the one next to the one the Dijkstra map provides. To prevent missing
+   * Because the closest face pixel doesn't always belong to the face with the closest edge, the
+   * face we need can be the one next to the one the jump flooding provides. To prevent missing
    * pixels also check the neighboring polygons.
    */
   bool lookup_pixel_polygon_neighborhood(
-      float x, float y, uint32_t *r_start_poly, float *r_destx, float *r_desty, int *r_other_poly)
+      float x,
+      float y,
+      uint32_t *r_start_poly,
+      float *r_destx,
+      float *r_desty,
+      int *r_other_poly) const
   {
     float found_dist;
     if (lookup_pixel(x, y, *r_start_poly, r_destx, r_desty, r_other_poly, &found_dist)) {
@@ -388,7 +406,7 @@ class TextureMarginMap {
                     float *r_destx,
                     float *r_desty,
                     int *r_other_poly,
-                    float *r_dist_to_edge)
+                    float *r_dist_to_edge) const
   {
     float2 point(x, y);
 
@@ -490,10 +508,6 @@ class TextureMarginMap {
   }
 };  // class TextureMarginMap
 
-const int TextureMarginMap::directions[8][2] = {
-    {-1, 0}, {-1, -1}, {0, -1}, {1, -1}, {1, 0}, {1, 1}, {0, 1}, {-1, 1}};
-const int TextureMarginMap::distances[8] = {2, 3, 2, 3, 2, 3, 2, 3};
-
 static void generate_margin(ImBuf *ibuf,
                             char *mask,
                             const int margin,
@@ -514,8 +528,7 @@ static void generate_margin(ImBuf *ibuf,
   TextureMarginMap map(ibuf->x, ibuf->y, uv_offset, edges_num, faces, corner_edges, mloopuv);
 
   bool draw_new_mask = false;
-  /* Now the map contains 3 sorts of values: 0xFFFFFFFF for empty pixels, `0x80000000 + polyindex`
-   * for margin pixels, just `polyindex` for face pixels. */
+  /* The map contains 0xFFFFFFFF for empty pixels and the face index for face pixels. */
   if (mask) {
     mask = (char *)MEM_dupallocN(mask);
   }
@@ -539,8 +552,8 @@ static void generate_margin(ImBuf *ibuf,
       vec[a][1] = (uv[1] - uv_offset[1]) * float(ibuf->y) - (0.5f + 0.002f);
     }
 
-    /* NOTE: we need the top bit for the dijkstra distance map. */
-    BLI_assert(tri_faces[i] < 0x80000000);
+    /* NOTE: 0xFFFFFFFF is used for empty pixels. */
+    BLI_assert(tri_faces[i] < 0xFFFFFFFF);
 
     map.rasterize_tri(vec[0], vec[1], vec[2], tri_faces[i], mask, draw_new_mask);
   }
@@ -551,11 +564,11 @@ static void generate_margin(ImBuf *ibuf,
   IMB_filter_extend(ibuf, tmpmask, 2);
   MEM_freeN(tmpmask);
 
-  map.grow_dijkstra(margin);
+  map.jump_flood(margin);
 
   /* Looking further than 3 polygons away leads to so much cumulative rounding
    * that it isn't worth it. So hard-code it to 3. */
-  map.lookup_pixels(ibuf, mask, 3);
+  map.lookup_pixels(ibuf, mask, margin, 3);
 
   /* Use the extend filter to fill in the missing pixels at the corners, not strictly correct, but
    * the visual difference seems very minimal. This also catches pixels we missed because of very
@@ -13,6 +13,7 @@
 #include "MEM_guardedalloc.h"
 
 #include "BLI_color.hh"
+#include "BLI_hash.hh"
 #include "BLI_kdopbvh.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_color.h"
@@ -34,6 +35,7 @@
 #include "BKE_deform.hh"
 #include "BKE_mesh.hh"
 #include "BKE_object.hh"
+#include "BKE_object_types.hh"
 #include "BKE_particle.h"
 #include "BKE_scene.hh"
 
@@ -154,6 +156,22 @@ static void alloc_point_data(PointDensity *pd)
   }
 }
 
+static void free_pointdensity(PointDensity *pd)
+{
+  if (pd == nullptr) {
+    return;
+  }
+
+  if (pd->point_tree) {
+    BLI_bvhtree_free(static_cast<BVHTree *>(pd->point_tree));
+    pd->point_tree = nullptr;
+  }
+
+  MEM_SAFE_FREE(pd->point_data);
+  pd->totpoints = 0;
+  pd->point_tree_hash = 0;
+}
+
 static void pointdensity_cache_psys(
     Depsgraph *depsgraph, Scene *scene, PointDensity *pd, Object *ob, ParticleSystem *psys)
 {
@@ -431,17 +449,40 @@ static void pointdensity_cache_object(PointDensity *pd, Object *ob)
   BLI_bvhtree_balance(static_cast<BVHTree *>(pd->point_tree));
 }
 
+/**
+ * Hash of everything the cached points depend on: the settings which affect which points and
+ * point data are stored, and the evaluation state of the source object.
+ */
+static uint64_t pointdensity_source_hash(Depsgraph *depsgraph, Scene *scene, PointDensity *pd)
+{
+  using namespace blender;
+  const Object *ob_eval = DEG_get_evaluated(depsgraph, pd->object);
+  const uint64_t settings_hash = get_default_hash(
+      get_default_hash(pd->source, pd->psys, pd->psys_cache_space, pd->ob_cache_space),
+      get_default_hash(pd->color_source, pd->ob_color_source, pd->falloff_type),
+      get_default_hash(StringRef(pd->vertex_attribute_name)));
+  const uint64_t state_hash = get_default_hash(pd->object->id.session_uid,
+                                               ob_eval->runtime->last_update_geometry,
+                                               ob_eval->runtime->last_update_transform,
+                                               BKE_scene_ctime_get(scene));
+  return get_default_hash(settings_hash, state_hash, int(DEG_get_mode(depsgraph)));
+}
+
 static void cache_pointdensity(Depsgraph *depsgraph, Scene *scene, PointDensity *pd)
 {
   if (pd == nullptr) {
     return;
   }
 
-  if (pd->point_tree) {
-    BLI_bvhtree_free(static_cast<BVHTree *>(pd->point_tree));
-    pd->point_tree = nullptr;
+  const uint64_t source_hash = pd->object ? pointdensity_source_hash(depsgraph, scene, pd) : 0;
+  if (pd->point_tree && source_hash != 0 && source_hash == pd->point_tree_hash) {
+    /* The points didn't change since the tree was built. */
+    return;
   }
 
+  free_pointdensity(pd);
+  pd->point_tree_hash = source_hash;
+
   if (pd->source == TEX_PD_PSYS) {
     Object *ob = pd->object;
     ParticleSystem *psys;
@@ -465,21 +506,6 @@ static void cache_pointdensity(Depsgraph *depsgraph, Scene *scene, PointDensity
   }
 }
 
-static void free_pointdensity(PointDensity *pd)
-{
-  if (pd == nullptr) {
-    return;
-  }
-
-  if (pd->point_tree) {
-    BLI_bvhtree_free(static_cast<BVHTree *>(pd->point_tree));
-    pd->point_tree = nullptr;
-  }
-
-  MEM_SAFE_FREE(pd->point_data);
-  pd->totpoints = 0;
-}
-
 struct PointDensityRangeData {
   float *density;
   float squared_radius;
@@ -943,8 +969,6 @@ void RE_point_density_sample(Depsgraph *depsgraph,
   BLI_parallel_range_settings_defaults(&settings);
   settings.use_threading = (resolution > 32);
   BLI_task_parallel_range(0, resolution, &data, point_density_sample_func, &settings);
-
-  free_pointdensity(pd);
 }
 
 void RE_point_density_free(PointDensity *pd)
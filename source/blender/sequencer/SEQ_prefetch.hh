@@ -20,5 +20,13 @@ void prefetch_stop_all();
  */
 void prefetch_stop(Scene *scene);
 bool prefetch_need_redraw(const bContext *C, Scene *scene);
+/**
+ * Call the function for each prefetch worker that is rendering a frame right now.
+ */
+void prefetch_rendering_frames_iterate(Scene *scene,
+                                       void *userdata,
+                                       void callback_iter(void *userdata,
+                                                          int worker_index,
+                                                          int timeline_frame));
 
 }  // namespace blender::seq
@@ -6,13 +6,24 @@
  * \ingroup sequencer
  */
 
+#include <memory>
+
+#include <zstd.h>
+
+#include "MEM_guardedalloc.h"
+
+#include "BLI_array.hh"
 #include "BLI_map.hh"
+#include "BLI_math_base.h"
 #include "BLI_mutex.hh"
+#include "BLI_task.hh"
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
 
 #include "IMB_imbuf.hh"
+#include "IMB_imbuf_types.hh"
+#include "IMB_metadata.hh"
 
 #include "SEQ_relations.hh"
 #include "SEQ_render.hh"
@@ -25,9 +36,56 @@ namespace blender::seq {
 
 static Mutex final_image_cache_mutex;
 
+/** Size of the independently compressed parts of an image, to process them in parallel. */
+static constexpr int64_t compressed_chunk_size = 1024 * 1024;
+
+/**
+ * Pixels of a cached frame compressed with `zstd`, used with #SEQ_CACHE_COMPRESS_FINAL.
+ */
+struct CompressedImage {
+  struct Chunk {
+    void *data = nullptr;
+    size_t size = 0;
+  };
+
+  /** Image without pixel buffers, stores the size, color spaces and metadata. */
+  ImBuf *header = nullptr;
+  bool is_float = false;
+  int64_t pixels_size = 0;
+  Array<Chunk> chunks;
+
+  ~CompressedImage()
+  {
+    IMB_freeImBuf(header);
+    for (Chunk &chunk : chunks) {
+      MEM_SAFE_FREE(chunk.data);
+    }
+  }
+
+  size_t size_in_memory() const
+  {
+    size_t size = IMB_get_size_in_memory(header);
+    for (const Chunk &chunk : chunks) {
+      size += chunk.size;
+    }
+    return size;
+  }
+};
+
+struct CachedFrame {
+  ImBuf *image = nullptr;
+  /** Shared so that decompressing can happen outside of the cache lock. */
+  std::shared_ptr<const CompressedImage> compressed;
+
+  size_t size_in_memory() const
+  {
+    return image ? IMB_get_size_in_memory(image) : compressed->size_in_memory();
+  }
+};
+
 struct FinalImageCache {
   /* Key is {timeline frame, view ID}. */
-  Map<std::pair<int, int>, ImBuf *> map_;
+  Map<std::pair<int, int>, CachedFrame> map_;
 
   ~FinalImageCache()
   {
@@ -36,13 +94,95 @@ struct FinalImageCache {
 
   void clear()
   {
-    for (ImBuf *item : map_.values()) {
-      IMB_freeImBuf(item);
+    for (CachedFrame &item : map_.values()) {
+      IMB_freeImBuf(item.image);
     }
     map_.clear();
   }
 };
 
+/**
+ * \return Nothing when the image can't be compressed, or when compressing doesn't save enough
+ * memory to be worth the time spent decompressing.
+ */
+static std::shared_ptr<const CompressedImage> compress_image(const ImBuf *image)
+{
+  const bool is_float = image->float_buffer.data != nullptr;
+  if (is_float == (image->byte_buffer.data != nullptr)) {
+    return nullptr;
+  }
+  if (is_float && image->channels != 4) {
+    return nullptr;
+  }
+  const uint8_t *pixels = is_float ? reinterpret_cast<const uint8_t *>(image->float_buffer.data) :
+                                     image->byte_buffer.data;
+
+  std::shared_ptr<CompressedImage> compressed = std::make_shared<CompressedImage>();
+  compressed->is_float = is_float;
+  compressed->pixels_size = int64_t(image->x) * image->y * 4 * (is_float ? sizeof(float) : 1);
+  compressed->chunks.reinitialize(divide_ceil_ul(compressed->pixels_size, compressed_chunk_size));
+
+  threading::parallel_for(compressed->chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int64_t offset = i * compressed_chunk_size;
+      const size_t size = std::min(compressed_chunk_size, compressed->pixels_size - offset);
+      const size_t size_max = ZSTD_compressBound(size);
+      void *data = MEM_mallocN(size_max, __func__);
+      const size_t compressed_size = ZSTD_compress(data, size_max, pixels + offset, size, 1);
+      if (ZSTD_isError(compressed_size)) {
+        MEM_freeN(data);
+        continue;
+      }
+      compressed->chunks[i].data = MEM_reallocN(data, compressed_size);
+      compressed->chunks[i].size = compressed_size;
+    }
+  });
+
+  size_t compressed_size = 0;
+  for (const CompressedImage::Chunk &chunk : compressed->chunks) {
+    if (chunk.data == nullptr) {
+      return nullptr;
+    }
+    compressed_size += chunk.size;
+  }
+  if (compressed_size > compressed->pixels_size * 0.8) {
+    return nullptr;
+  }
+
+  compressed->header = IMB_allocImBuf(image->x, image->y, image->planes, 0);
+  compressed->header->byte_buffer.colorspace = image->byte_buffer.colorspace;
+  compressed->header->float_buffer.colorspace = image->float_buffer.colorspace;
+  IMB_metadata_copy(compressed->header, image);
+  return compressed;
+}
+
+static ImBuf *decompress_image(const CompressedImage &compressed)
+{
+  const ImBuf *header = compressed.header;
+  ImBuf *image = IMB_allocImBuf(
+      header->x,
+      header->y,
+      header->planes,
+      (compressed.is_float ? IB_float_data : IB_byte_data) | IB_uninitialized_pixels);
+  if (image == nullptr) {
+    return nullptr;
+  }
+  image->byte_buffer.colorspace = header->byte_buffer.colorspace;
+  image->float_buffer.colorspace = header->float_buffer.colorspace;
+  IMB_metadata_copy(image, header);
+
+  uint8_t *pixels = compressed.is_float ? reinterpret_cast<uint8_t *>(image->float_buffer.data) :
+                                          image->byte_buffer.data;
+  threading::parallel_for(compressed.chunks.index_range(), 1, [&](const IndexRange range) {
+    for (const int64_t i : range) {
+      const int64_t offset = i * compressed_chunk_size;
+      const size_t size = std::min(compressed_chunk_size, compressed.pixels_size - offset);
+      ZSTD_decompress(pixels + offset, size, compressed.chunks[i].data, compressed.chunks[i].size);
+    }
+  });
+  return image;
+}
+
 static FinalImageCache *ensure_final_image_cache(Scene *scene)
 {
   FinalImageCache **cache = &scene->ed->runtime.final_image_cache;
@@ -65,17 +205,26 @@ ImBuf *final_image_cache_get(Scene *scene, float timeline_frame, int view_id)
   const std::pair<int, int> key = {int(math::round(timeline_frame)), view_id};
 
   ImBuf *res = nullptr;
+  std::shared_ptr<const CompressedImage> compressed;
   {
     std::lock_guard lock(final_image_cache_mutex);
     FinalImageCache *cache = query_final_image_cache(scene);
     if (cache == nullptr) {
       return nullptr;
     }
-    res = cache->map_.lookup_default(key, nullptr);
+    const CachedFrame *frame = cache->map_.lookup_ptr(key);
+    if (frame == nullptr) {
+      return nullptr;
+    }
+    res = frame->image;
+    compressed = frame->compressed;
+    if (res) {
+      IMB_refImBuf(res);
+    }
   }
 
-  if (res) {
-    IMB_refImBuf(res);
+  if (compressed) {
+    res = decompress_image(*compressed);
   }
   return res;
 }
@@ -84,19 +233,25 @@ void final_image_cache_put(Scene *scene, float timeline_frame, int view_id, ImBu
 {
   const std::pair<int, int> key = {int(math::round(timeline_frame)), view_id};
 
-  IMB_refImBuf(image);
+  CachedFrame frame;
+  if (scene->ed->cache_flag & SEQ_CACHE_COMPRESS_FINAL) {
+    /* Compress before locking, other threads can use the cache in the meantime. */
+    frame.compressed = compress_image(image);
+  }
+  if (!frame.compressed) {
+    IMB_refImBuf(image);
+    frame.image = image;
+  }
 
   std::lock_guard lock(final_image_cache_mutex);
   FinalImageCache *cache = ensure_final_image_cache(scene);
 
   cache->map_.add_or_modify(
       key,
-      [&](ImBuf **value) { *value = image; },
-      [&](ImBuf **existing) {
-        if (*existing) {
-          IMB_freeImBuf(*existing);
-        }
-        *existing = image;
+      [&](CachedFrame *value) { new (value) CachedFrame(std::move(frame)); },
+      [&](CachedFrame *existing) {
+        IMB_freeImBuf(existing->image);
+        *existing = std::move(frame);
       });
 }
 
@@ -116,7 +271,7 @@ void final_image_cache_invalidate_frame_range(Scene *scene,
   for (auto it = cache->map_.items().begin(); it != cache->map_.items().end(); it++) {
     const int key = (*it).key.first;
     if (key >= key_start && key <= key_end) {
-      IMB_freeImBuf((*it).value);
+      IMB_freeImBuf((*it).value.image);
       cache->map_.remove(it);
     }
   }
@@ -164,8 +319,8 @@ size_t final_image_cache_calc_memory_size(const Scene *scene)
     return 0;
   }
   size_t size = 0;
-  for (ImBuf *frame : cache->map_.values()) {
-    size += IMB_get_size_in_memory(frame);
+  for (const CachedFrame &frame : cache->map_.values()) {
+    size += frame.size_in_memory();
   }
   return size;
 }
@@ -200,7 +355,7 @@ bool final_image_cache_evict(Scene *scene)
 
   const int cur_frame = scene->r.cfra;
   std::pair<int, int> best_key = {};
-  ImBuf *best_item = nullptr;
+  const CachedFrame *best_item = nullptr;
   int best_score = 0;
   for (const auto &item : cache->map_.items()) {
     const int item_frame = item.key.first;
@@ -218,14 +373,14 @@ bool final_image_cache_evict(Scene *scene)
     }
     if (score > best_score) {
       best_key = item.key;
-      best_item = item.value;
+      best_item = &item.value;
       best_score = score;
     }
   }
 
   /* Remove if we found one. */
   if (best_item != nullptr) {
-    IMB_freeImBuf(best_item);
+    IMB_freeImBuf(best_item->image);
     cache->map_.remove(best_key);
     return true;
   }
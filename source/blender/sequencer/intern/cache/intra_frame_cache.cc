@@ -7,6 +7,7 @@
  */
 
 #include "BLI_map.hh"
+#include "BLI_mutex.hh"
 
 #include "DNA_scene_types.h"
 #include "DNA_sequence_types.h"
@@ -17,6 +18,9 @@
 
 namespace blender::seq {
 
+/** Strips of a frame may be rendered from several threads, see #seq_render_strip_stack. */
+static Mutex intra_frame_cache_mutex;
+
 struct StripImageMap {
   Map<const Strip *, ImBuf *> map_;
   ImBuf *get(const Strip *strip) const;
@@ -48,6 +52,7 @@ static IntraFrameCache *query_intra_frame_cache(Scene *scene)
 
 void intra_frame_cache_invalidate(Scene *scene)
 {
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *cache = query_intra_frame_cache(scene);
   if (cache != nullptr) {
     cache->preprocessed.clear();
@@ -62,6 +67,7 @@ void intra_frame_cache_invalidate(Scene *scene, const Strip *strip)
   if (strip == nullptr) {
     return;
   }
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *cache = query_intra_frame_cache(scene);
   if (cache != nullptr) {
     cache->preprocessed.invalidate(strip);
@@ -114,6 +120,7 @@ void StripImageMap::clear()
 
 ImBuf *intra_frame_cache_get_preprocessed(Scene *scene, const Strip *strip)
 {
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *cache = query_intra_frame_cache(scene);
   if (strip == nullptr || cache == nullptr) {
     return nullptr;
@@ -123,6 +130,7 @@ ImBuf *intra_frame_cache_get_preprocessed(Scene *scene, const Strip *strip)
 
 ImBuf *intra_frame_cache_get_composite(Scene *scene, const Strip *strip)
 {
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *cache = query_intra_frame_cache(scene);
   if (strip == nullptr || cache == nullptr) {
     return nullptr;
@@ -135,6 +143,7 @@ void intra_frame_cache_put_preprocessed(Scene *scene, const Strip *strip, ImBuf
   if (scene == nullptr || scene->ed == nullptr || strip == nullptr || image == nullptr) {
     return;
   }
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *&cache = scene->ed->runtime.intra_frame_cache;
   if (cache == nullptr) {
     cache = MEM_new<IntraFrameCache>(__func__);
@@ -147,6 +156,7 @@ void intra_frame_cache_put_composite(Scene *scene, const Strip *strip, ImBuf *im
   if (scene == nullptr || scene->ed == nullptr || strip == nullptr || image == nullptr) {
     return;
   }
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *&cache = scene->ed->runtime.intra_frame_cache;
   if (cache == nullptr) {
     cache = MEM_new<IntraFrameCache>(__func__);
@@ -156,6 +166,7 @@ void intra_frame_cache_put_composite(Scene *scene, const Strip *strip, ImBuf *im
 
 void intra_frame_cache_destroy(Scene *scene)
 {
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *cache = query_intra_frame_cache(scene);
   if (cache != nullptr) {
     MEM_SAFE_DELETE(scene->ed->runtime.intra_frame_cache);
@@ -164,6 +175,7 @@ void intra_frame_cache_destroy(Scene *scene)
 
 void intra_frame_cache_set_cur_frame(Scene *scene, float frame, int view_id)
 {
+  std::lock_guard lock(intra_frame_cache_mutex);
   IntraFrameCache *cache = query_intra_frame_cache(scene);
   if (cache != nullptr) {
     if (cache->timeline_frame != frame || cache->view_id != view_id) {
@@ -6,14 +6,21 @@
  * \ingroup sequencer
  */
 
+#include <cinttypes>
+
+#include "BLI_array.hh"
+#include "BLI_array_utils.hh"
+#include "BLI_fileops.h"
 #include "BLI_map.hh"
 #include "BLI_math_base.h"
 #include "BLI_mutex.hh"
 #include "BLI_path_utils.hh"
 #include "BLI_set.hh"
+#include "BLI_string.h"
 #include "BLI_task.hh"
 #include "BLI_vector.hh"
 
+#include "BKE_appdir.hh"
 #include "BKE_context.hh"
 #include "BKE_library.hh"
 #include "BKE_main.hh"
@@ -236,6 +243,75 @@ static void scale_to_thumbnail_size(ImBuf *ibuf)
   IMB_scale(ibuf, width, height, IMBScaleFilter::Nearest, false);
 }
 
+/* Movie thumbnails are also stored on disk, so that they don't have to be decoded again in later
+ * sessions or when the cache was cleared. They are stored per movie and stream in
+ * `BKE_appdir_folder_caches/sequencer-thumbnails/<hash>/<frame_index>.png`. The hash includes the
+ * modification time and size of the movie file, so thumbnails of a changed file are not used. */
+static std::string thumbnail_disk_cache_dir(const ThumbnailCache::Request &request)
+{
+  BLI_stat_t st;
+  if (BLI_stat(request.file_path.c_str(), &st) == -1) {
+    return "";
+  }
+  char dirpath[FILE_MAX];
+  if (!BKE_appdir_folder_caches(dirpath, sizeof(dirpath))) {
+    return "";
+  }
+  const uint64_t hash = get_default_hash(
+      request.file_path, int64_t(st.st_mtime), int64_t(st.st_size), request.stream_index);
+  char dirname[32];
+  SNPRINTF(dirname, "%016" PRIx64, hash);
+  BLI_path_append(dirpath, sizeof(dirpath), "sequencer-thumbnails");
+  BLI_path_append(dirpath, sizeof(dirpath), dirname);
+  return dirpath;
+}
+
+static void thumbnail_disk_cache_filepath(const std::string &dirpath,
+                                          const int frame_index,
+                                          char r_filepath[FILE_MAX])
+{
+  char filename[32];
+  SNPRINTF(filename, "%d.png", frame_index);
+  BLI_path_join(r_filepath, FILE_MAX, dirpath.c_str(), filename);
+}
+
+static ImBuf *thumbnail_disk_cache_load(const std::string &dirpath, const int frame_index)
+{
+  if (dirpath.empty()) {
+    return nullptr;
+  }
+  char filepath[FILE_MAX];
+  thumbnail_disk_cache_filepath(dirpath, frame_index, filepath);
+  if (!BLI_is_file(filepath)) {
+    return nullptr;
+  }
+  return IMB_load_image_from_filepath(filepath, IB_byte_data);
+}
+
+static void thumbnail_disk_cache_save(const std::string &dirpath,
+                                      const int frame_index,
+                                      ImBuf *thumb)
+{
+  if (dirpath.empty() || thumb == nullptr || thumb->byte_buffer.data == nullptr) {
+    return;
+  }
+  if (!BLI_dir_create_recursive(dirpath.c_str())) {
+    return;
+  }
+  char filepath[FILE_MAX];
+  thumbnail_disk_cache_filepath(dirpath, frame_index, filepath);
+  /* Write to a temporary file first, so that other instances never read a partial file. */
+  char filepath_temp[FILE_MAX + 4];
+  SNPRINTF(filepath_temp, "%s.tmp", filepath);
+
+  thumb->ftype = IMB_FTYPE_PNG;
+  /* Thumbnails are small, favor speed over size. */
+  thumb->foptions.quality = 15;
+  if (IMB_save_image(thumb, filepath_temp, IB_byte_data)) {
+    BLI_rename_overwrite(filepath_temp, filepath);
+  }
+}
+
 /* Background job that processes in-flight thumbnail requests. */
 class ThumbGenerationJob {
   Scene *scene_ = nullptr;
@@ -315,91 +391,119 @@ void ThumbGenerationJob::run_fn(void *customdata, wmJobWorkerStatus *worker_stat
                 return a.frame_index < b.frame_index;
               });
 
-    /* Process the requests in parallel. Split requests into approximately 4 groups:
-     * we don't want to go too wide since that would potentially mean that a single input
-     * movie gets assigned to more than one thread, and the thumbnail loading itself
-     * is somewhat-threaded already. */
-    int64_t grain_size = math::max<int64_t>(8, requests.size() / 4);
-    threading::parallel_for(requests.index_range(), grain_size, [&](IndexRange range) {
-      /* Often the same movie file is chopped into multiple strips next to each other.
-       * Since the requests are sorted by file path and frame index, we can reuse MovieReader
-       * objects between them for performance. */
-      MovieReader *cur_anim = nullptr;
-      std::string cur_anim_path;
-      int cur_stream = 0;
-      for (const int i : range) {
-        const ThumbnailCache::Request &request = requests[i];
-        if (worker_status->stop) {
-          break;
+    /* Group the requests by movie file and stream. Each group is processed by a single thread:
+     * often the same movie file is chopped into multiple strips next to each other, and since the
+     * requests are sorted by frame index, one MovieReader decodes them all without seeking back.
+     * Requests for images are independent. */
+    Vector<IndexRange> groups;
+    for (int64_t start = 0; start < requests.size();) {
+      const ThumbnailCache::Request &first = requests[start];
+      int64_t end = start + 1;
+      if (first.strip_type == STRIP_TYPE_MOVIE) {
+        while (end < requests.size() && requests[end].file_path == first.file_path &&
+               requests[end].stream_index == first.stream_index)
+        {
+          end++;
         }
+      }
+      groups.append(IndexRange::from_begin_end(start, end));
+      start = end;
+    }
+
+    /* Start with the most recently requested files, which are the ones visible on screen. Older
+     * requests outside of the view are discarded by #thumbnail_cache_discard_requests_outside. */
+    Array<int64_t> group_requested_at(groups.size(), 0);
+    for (const int64_t group_i : groups.index_range()) {
+      for (const int64_t i : groups[group_i]) {
+        group_requested_at[group_i] = math::max(group_requested_at[group_i],
+                                                requests[i].requested_at);
+      }
+    }
+    Array<int64_t> group_order(groups.size());
+    array_utils::fill_index_range<int64_t>(group_order);
+    std::stable_sort(group_order.begin(), group_order.end(), [&](int64_t a, int64_t b) {
+      return group_requested_at[a] > group_requested_at[b];
+    });
+
+    /* Process the groups in parallel, the files can be decoded independently. */
+    threading::parallel_for(group_order.index_range(), 1, [&](IndexRange range) {
+      for (const int64_t group_i : group_order.as_span().slice(range)) {
+        MovieReader *cur_anim = nullptr;
+        std::string disk_cache_dir;
+        for (const int i : groups[group_i]) {
+          const ThumbnailCache::Request &request = requests[i];
+          if (worker_status->stop) {
+            break;
+          }
 
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
-        ++total_thumbs;
+          ++total_thumbs;
 #endif
-        ImBuf *thumb = nullptr;
-        if (request.strip_type == STRIP_TYPE_IMAGE) {
-          /* Load thumbnail for an image. */
+          ImBuf *thumb = nullptr;
+          if (request.strip_type == STRIP_TYPE_IMAGE) {
+            /* Load thumbnail for an image. */
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
-          ++total_images;
+            ++total_images;
 #endif
-          thumb = make_thumb_for_image(job->scene_, request);
-        }
-        else if (request.strip_type == STRIP_TYPE_MOVIE) {
-          /* Load thumbnail for an movie. */
+            thumb = make_thumb_for_image(job->scene_, request);
+            scale_to_thumbnail_size(thumb);
+          }
+          else if (request.strip_type == STRIP_TYPE_MOVIE) {
+            /* Load thumbnail for an movie. */
 #ifdef DEBUG_PRINT_THUMB_JOB_TIMES
-          ++total_movies;
+            ++total_movies;
 #endif
-
-          /* Are we switching to a different movie file / stream? */
-          if (request.file_path != cur_anim_path || request.stream_index != cur_stream) {
-            if (cur_anim != nullptr) {
-              MOV_close(cur_anim);
-              cur_anim = nullptr;
+            if (i == groups[group_i].first()) {
+              disk_cache_dir = thumbnail_disk_cache_dir(request);
+            }
+            thumb = thumbnail_disk_cache_load(disk_cache_dir, request.frame_index);
+
+            /* Decode the movie frame, only opening the movie when a thumbnail was not on disk. */
+            if (thumb == nullptr) {
+              if (cur_anim == nullptr) {
+                cur_anim = MOV_open_file(
+                    request.file_path.c_str(), IB_byte_data, request.stream_index, nullptr);
+              }
+              if (cur_anim != nullptr) {
+                thumb = MOV_decode_frame(
+                    cur_anim, request.frame_index, IMB_TC_NONE, IMB_PROXY_NONE);
+                scale_to_thumbnail_size(thumb);
+                thumbnail_disk_cache_save(disk_cache_dir, request.frame_index, thumb);
+              }
             }
-
-            cur_anim_path = request.file_path;
-            cur_stream = request.stream_index;
-            cur_anim = MOV_open_file(cur_anim_path.c_str(), IB_byte_data, cur_stream, nullptr);
-          }
-
-          /* Decode the movie frame. */
-          if (cur_anim != nullptr) {
-            thumb = MOV_decode_frame(cur_anim, request.frame_index, IMB_TC_NONE, IMB_PROXY_NONE);
             if (thumb != nullptr) {
               seq_imbuf_assign_spaces(job->scene_, thumb);
             }
           }
-        }
-        else {
-          BLI_assert_unreachable();
-        }
-
-        scale_to_thumbnail_size(thumb);
+          else {
+            BLI_assert_unreachable();
+          }
 
-        /* Add result into the cache (under cache mutex lock). */
-        {
-          std::scoped_lock lock(thumb_cache_mutex);
-          ThumbnailCache::FileEntry *val = job->cache_->map_.lookup_ptr(request.file_path);
-          if (val != nullptr) {
-            val->used_at = math::max(val->used_at, request.requested_at);
-            val->frames.append(
-                {request.frame_index, request.stream_index, thumb, request.requested_at});
+          /* Add result into the cache (under cache mutex lock). */
+          {
+            std::scoped_lock lock(thumb_cache_mutex);
+            ThumbnailCache::FileEntry *val = job->cache_->map_.lookup_ptr(request.file_path);
+            if (val != nullptr) {
+              val->used_at = math::max(val->used_at, request.requested_at);
+              val->frames.append(
+                  {request.frame_index, request.stream_index, thumb, request.requested_at});
+            }
+            else {
+              IMB_freeImBuf(thumb);
+            }
+            /* Remove the request from original set. */
+            job->cache_->requests_.remove(request);
           }
-          else {
-            IMB_freeImBuf(thumb);
+
+          if (thumb) {
+            worker_status->do_update = true;
           }
-          /* Remove the request from original set. */
-          job->cache_->requests_.remove(request);
         }
-
-        if (thumb) {
-          worker_status->do_update = true;
+        if (cur_anim != nullptr) {
+          MOV_close(cur_anim);
+          cur_anim = nullptr;
         }
       }
-      if (cur_anim != nullptr) {
-        MOV_close(cur_anim);
-        cur_anim = nullptr;
-      }
     });
   }
 
@@ -18,6 +18,7 @@
 #include "DNA_sequence_types.h"
 #include "DNA_space_types.h"
 
+#include "BLI_array.hh"
 #include "BLI_listbase.h"
 #include "BLI_threads.h"
 #include "BLI_vector_set.hh"
@@ -50,40 +51,66 @@
 
 namespace blender::seq {
 
+/** Upper limit of concurrent prefetch threads, each of them uses its own copy of the scene. */
+#define SEQ_PREFETCH_WORKERS_MAX 4
+
+/**
+ * A prefetch thread. Workers render different frames of the prefetch area at the same time, each
+ * with its own depsgraph, so that they don't share evaluated strips or movie decoders.
+ */
+struct PrefetchWorker {
+  PrefetchJob *job = nullptr;
+
+  Main *bmain_eval = nullptr;
+  Scene *scene_eval = nullptr;
+  Depsgraph *depsgraph = nullptr;
+
+  RenderData context_cpy = {};
+
+  /** Frame being rendered, only valid while #is_rendering is set. */
+  float cfra = 0.0f;
+  bool is_rendering = false;
+};
+
 struct PrefetchJob {
   PrefetchJob *next = nullptr;
   PrefetchJob *prev = nullptr;
 
   Main *bmain = nullptr;
-  Main *bmain_eval = nullptr;
   Scene *scene = nullptr;
-  Scene *scene_eval = nullptr;
-  Depsgraph *depsgraph = nullptr;
 
+  /** Guards the prefetch area and the control flags below. */
   ThreadMutex prefetch_suspend_mutex = {};
   ThreadCondition prefetch_suspend_cond = {};
 
   ListBase threads = {};
+  Array<PrefetchWorker> workers;
 
   /* context */
   RenderData context = {};
-  RenderData context_cpy = {};
-  ListBase *seqbasep = nullptr;
-  ListBase *seqbasep_cpy = nullptr;
 
-  /* prefetch area */
+  /* Prefetch area. Frames before `cfra + num_frames_prefetched` are rendered, or being rendered
+   * by one of the workers. */
   float cfra = 0.0f;
   int num_frames_prefetched = 0;
 
   /* Control: */
   /* Set by prefetch. */
   bool running = false;
-  bool waiting = false;
+  int running_workers_num = 0;
+  int waiting_workers_num = 0;
   bool stop = false;
   /* Set from outside. */
   bool is_scrubbing = false;
 };
 
+static int seq_prefetch_workers_num()
+{
+  /* Rendering a frame is multi-threaded already, more workers mainly help with the parts that
+   * aren't: depsgraph evaluation, movie decoding and single threaded effects. */
+  return std::clamp(BLI_system_thread_count() / 8, 1, SEQ_PREFETCH_WORKERS_MAX);
+}
+
 static PrefetchJob *seq_prefetch_job_get(Scene *scene)
 {
   if (scene && scene->ed) {
@@ -122,7 +149,7 @@ static bool seq_prefetch_job_is_waiting(Scene *scene)
     return false;
   }
 
-  return pfjob->waiting;
+  return pfjob->waiting_workers_num > 0;
 }
 
 static Strip *original_strip_get(const Strip *strip, ListBase *seqbase)
@@ -187,13 +214,14 @@ static bool seq_prefetch_is_cache_full(Scene *scene)
   return !evicted;
 }
 
+/** The next frame to be prefetched. */
 static float seq_prefetch_cfra(PrefetchJob *pfjob)
 {
   return pfjob->cfra + pfjob->num_frames_prefetched;
 }
-static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchJob *pfjob)
+static AnimationEvalContext seq_prefetch_anim_eval_context(PrefetchWorker *worker)
 {
-  return BKE_animsys_eval_context_construct(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  return BKE_animsys_eval_context_construct(worker->depsgraph, worker->cfra);
 }
 
 void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
@@ -214,37 +242,38 @@ void seq_prefetch_get_time_range(Scene *scene, int *r_start, int *r_end)
   *r_end = seq_prefetch_cfra(pfjob);
 }
 
-static void seq_prefetch_free_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_free_depsgraph(PrefetchWorker *worker)
 {
-  if (pfjob->depsgraph != nullptr) {
-    DEG_graph_free(pfjob->depsgraph);
+  if (worker->depsgraph != nullptr) {
+    DEG_graph_free(worker->depsgraph);
   }
-  pfjob->depsgraph = nullptr;
-  pfjob->scene_eval = nullptr;
+  worker->depsgraph = nullptr;
+  worker->scene_eval = nullptr;
 }
 
-static void seq_prefetch_update_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_update_depsgraph(PrefetchWorker *worker)
 {
-  DEG_evaluate_on_framechange(pfjob->depsgraph, seq_prefetch_cfra(pfjob));
+  DEG_evaluate_on_framechange(worker->depsgraph, worker->cfra);
 }
 
-static void seq_prefetch_init_depsgraph(PrefetchJob *pfjob)
+static void seq_prefetch_init_depsgraph(PrefetchWorker *worker)
 {
-  Main *bmain = pfjob->bmain_eval;
-  Scene *scene = pfjob->scene;
+  Main *bmain = worker->bmain_eval;
+  Scene *scene = worker->job->scene;
   ViewLayer *view_layer = BKE_view_layer_default_render(scene);
 
-  pfjob->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
-  DEG_debug_name_set(pfjob->depsgraph, "SEQUENCER PREFETCH");
+  worker->depsgraph = DEG_graph_new(bmain, scene, view_layer, DAG_EVAL_RENDER);
+  DEG_debug_name_set(worker->depsgraph, "SEQUENCER PREFETCH");
 
   /* Make sure there is a correct evaluated scene pointer. */
-  DEG_graph_build_for_render_pipeline(pfjob->depsgraph);
+  DEG_graph_build_for_render_pipeline(worker->depsgraph);
 
   /* Update immediately so we have proper evaluated scene. */
-  seq_prefetch_update_depsgraph(pfjob);
+  worker->cfra = seq_prefetch_cfra(worker->job);
+  seq_prefetch_update_depsgraph(worker);
 
-  pfjob->scene_eval = DEG_get_evaluated_scene(pfjob->depsgraph);
-  pfjob->scene_eval->ed->cache_flag = 0;
+  worker->scene_eval = DEG_get_evaluated_scene(worker->depsgraph);
+  worker->scene_eval->ed->cache_flag = 0;
 }
 
 static void seq_prefetch_update_area(PrefetchJob *pfjob)
@@ -289,7 +318,7 @@ void prefetch_stop(Scene *scene)
   pfjob->stop = true;
 
   while (pfjob->running) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -298,19 +327,21 @@ static void seq_prefetch_update_context(const RenderData *context)
   PrefetchJob *pfjob;
   pfjob = seq_prefetch_job_get(context->scene);
 
-  render_new_render_data(pfjob->bmain_eval,
-                         pfjob->depsgraph,
-                         pfjob->scene_eval,
-                         context->rectx,
-                         context->recty,
-                         context->preview_render_size,
-                         false,
-                         &pfjob->context_cpy);
-  pfjob->context_cpy.is_prefetch_render = true;
-  pfjob->context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
+  for (PrefetchWorker &worker : pfjob->workers) {
+    render_new_render_data(worker.bmain_eval,
+                           worker.depsgraph,
+                           worker.scene_eval,
+                           context->rectx,
+                           context->recty,
+                           context->preview_render_size,
+                           false,
+                           &worker.context_cpy);
+    worker.context_cpy.is_prefetch_render = true;
+    worker.context_cpy.task_id = SEQ_TASK_PREFETCH_RENDER;
+  }
 
   render_new_render_data(pfjob->bmain,
-                         pfjob->depsgraph,
+                         pfjob->workers[0].depsgraph,
                          pfjob->scene,
                          context->rectx,
                          context->recty,
@@ -335,21 +366,25 @@ static void seq_prefetch_update_scene(Scene *scene)
   }
 
   pfjob->scene = scene;
-  seq_prefetch_free_depsgraph(pfjob);
-  seq_prefetch_init_depsgraph(pfjob);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    seq_prefetch_free_depsgraph(&worker);
+    seq_prefetch_init_depsgraph(&worker);
+  }
 }
 
 static void seq_prefetch_update_active_seqbase(PrefetchJob *pfjob)
 {
   MetaStack *ms_orig = meta_stack_active_get(editing_get(pfjob->scene));
-  Editing *ed_eval = editing_get(pfjob->scene_eval);
 
-  if (ms_orig != nullptr) {
-    Strip *meta_eval = original_strip_get(ms_orig->parent_strip, pfjob->scene_eval);
-    active_seqbase_set(ed_eval, &meta_eval->seqbase);
-  }
-  else {
-    active_seqbase_set(ed_eval, &ed_eval->seqbase);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    Editing *ed_eval = editing_get(worker.scene_eval);
+    if (ms_orig != nullptr) {
+      Strip *meta_eval = original_strip_get(ms_orig->parent_strip, worker.scene_eval);
+      active_seqbase_set(ed_eval, &meta_eval->seqbase);
+    }
+    else {
+      active_seqbase_set(ed_eval, &ed_eval->seqbase);
+    }
   }
 }
 
@@ -357,8 +392,8 @@ static void seq_prefetch_resume(Scene *scene)
 {
   PrefetchJob *pfjob = seq_prefetch_job_get(scene);
 
-  if (pfjob && pfjob->waiting) {
-    BLI_condition_notify_one(&pfjob->prefetch_suspend_cond);
+  if (pfjob && seq_prefetch_job_is_waiting(scene)) {
+    BLI_condition_notify_all(&pfjob->prefetch_suspend_cond);
   }
 }
 
@@ -371,20 +406,25 @@ void seq_prefetch_free(Scene *scene)
 
   prefetch_stop(scene);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    BLI_threadpool_remove(&pfjob->threads, &worker);
+  }
   BLI_threadpool_end(&pfjob->threads);
   BLI_mutex_end(&pfjob->prefetch_suspend_mutex);
   BLI_condition_end(&pfjob->prefetch_suspend_cond);
-  seq_prefetch_free_depsgraph(pfjob);
-  BKE_main_free(pfjob->bmain_eval);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    seq_prefetch_free_depsgraph(&worker);
+    BKE_main_free(worker.bmain_eval);
+  }
   scene->ed->prefetch_job = nullptr;
   MEM_delete(pfjob);
 }
 
-static bool strip_is_cached(PrefetchJob *pfjob, Strip *strip, bool can_have_final_image)
+static bool strip_is_cached(PrefetchWorker *worker, Strip *strip, bool can_have_final_image)
 {
-  RenderData *ctx = &pfjob->context_cpy;
-  float cfra = seq_prefetch_cfra(pfjob);
+  PrefetchJob *pfjob = worker->job;
+  RenderData *ctx = &worker->context_cpy;
+  float cfra = worker->cfra;
 
   ImBuf *ibuf = source_image_cache_get(ctx, strip, cfra);
   if (ibuf != nullptr) {
@@ -403,28 +443,27 @@ static bool strip_is_cached(PrefetchJob *pfjob, Strip *strip, bool can_have_fina
   return false;
 }
 
-static bool seq_prefetch_scene_strip_is_rendered(PrefetchJob *pfjob,
+static bool seq_prefetch_scene_strip_is_rendered(PrefetchWorker *worker,
                                                  ListBase *channels,
                                                  ListBase *seqbase,
                                                  blender::Span<Strip *> scene_strips,
                                                  bool is_recursive_check)
 {
-  float cfra = seq_prefetch_cfra(pfjob);
   blender::Vector<Strip *> strips = seq_shown_strips_get(
-      pfjob->scene_eval, channels, seqbase, cfra, 0);
+      worker->scene_eval, channels, seqbase, worker->cfra, 0);
 
   /* Iterate over rendered strips. */
   for (Strip *strip : strips) {
     if (strip->type == STRIP_TYPE_META &&
         seq_prefetch_scene_strip_is_rendered(
-            pfjob, &strip->channels, &strip->seqbase, scene_strips, true))
+            worker, &strip->channels, &strip->seqbase, scene_strips, true))
     {
       return true;
     }
 
     /* A scene strip would be rendered, if it has no cached image for it. */
     if (strip->type == STRIP_TYPE_SCENE && (strip->flag & SEQ_SCENE_STRIPS) == 0 &&
-        !strip_is_cached(pfjob, strip, !is_recursive_check))
+        !strip_is_cached(worker, strip, !is_recursive_check))
     {
       return true;
     }
@@ -452,10 +491,12 @@ static blender::VectorSet<Strip *> query_scene_strips(ListBase *seqbase)
 
 /* Prefetch must avoid rendering scene strips, because rendering in background locks UI and can
  * make it unresponsive for long time periods. */
-static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *channels, ListBase *seqbase)
+static bool seq_prefetch_must_skip_frame(PrefetchWorker *worker,
+                                         ListBase *channels,
+                                         ListBase *seqbase)
 {
   blender::VectorSet<Strip *> scene_strips = query_scene_strips(seqbase);
-  if (seq_prefetch_scene_strip_is_rendered(pfjob, channels, seqbase, scene_strips, false)) {
+  if (seq_prefetch_scene_strip_is_rendered(worker, channels, seqbase, scene_strips, false)) {
     return true;
   }
   return false;
@@ -464,35 +505,65 @@ static bool seq_prefetch_must_skip_frame(PrefetchJob *pfjob, ListBase *channels,
 static bool seq_prefetch_need_suspend(PrefetchJob *pfjob)
 {
   return seq_prefetch_is_cache_full(pfjob->scene) || pfjob->is_scrubbing ||
-         (seq_prefetch_cfra(pfjob) >= pfjob->scene->r.efra);
+         (seq_prefetch_cfra(pfjob) > pfjob->scene->r.efra);
+}
+
+static bool seq_prefetch_must_stop(PrefetchJob *pfjob)
+{
+  return !(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop;
 }
 
-static void seq_prefetch_do_suspend(PrefetchJob *pfjob)
+/**
+ * Wait until there is something to prefetch, and assign the next frame to the worker.
+ * \return False when the worker should stop.
+ */
+static bool seq_prefetch_claim_frame(PrefetchWorker *worker)
 {
+  PrefetchJob *pfjob = worker->job;
+  bool claimed = false;
+
   BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
-  while (seq_prefetch_need_suspend(pfjob) &&
-         (pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) && !pfjob->stop)
-  {
-    pfjob->waiting = true;
+  worker->is_rendering = false;
+  seq_prefetch_update_area(pfjob);
+
+  /* Suspend thread if there is nothing to be prefetched. */
+  while (seq_prefetch_need_suspend(pfjob) && !seq_prefetch_must_stop(pfjob)) {
+    pfjob->waiting_workers_num++;
     BLI_condition_wait(&pfjob->prefetch_suspend_cond, &pfjob->prefetch_suspend_mutex);
+    pfjob->waiting_workers_num--;
     seq_prefetch_update_area(pfjob);
   }
-  pfjob->waiting = false;
+
+  /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
+  const bool is_colliding = pfjob->num_frames_prefetched > 5 &&
+                            (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2;
+
+  if (!seq_prefetch_must_stop(pfjob) && !is_colliding &&
+      seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra)
+  {
+    worker->cfra = seq_prefetch_cfra(pfjob);
+    worker->is_rendering = true;
+    pfjob->num_frames_prefetched++;
+    claimed = true;
+  }
   BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+
+  return claimed;
 }
 
-static void *seq_prefetch_frames(void *job)
+static void *seq_prefetch_frames(void *worker_v)
 {
-  PrefetchJob *pfjob = (PrefetchJob *)job;
+  PrefetchWorker *worker = static_cast<PrefetchWorker *>(worker_v);
+  PrefetchJob *pfjob = worker->job;
 
-  while (seq_prefetch_cfra(pfjob) <= pfjob->scene->r.efra) {
-    pfjob->scene_eval->ed->prefetch_job = nullptr;
+  while (seq_prefetch_claim_frame(worker)) {
+    worker->scene_eval->ed->prefetch_job = nullptr;
 
-    seq_prefetch_update_depsgraph(pfjob);
-    AnimData *adt = BKE_animdata_from_id(&pfjob->context_cpy.scene->id);
-    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(pfjob);
+    seq_prefetch_update_depsgraph(worker);
+    AnimData *adt = BKE_animdata_from_id(&worker->context_cpy.scene->id);
+    AnimationEvalContext anim_eval_context = seq_prefetch_anim_eval_context(worker);
     BKE_animsys_evaluate_animdata(
-        &pfjob->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
+        &worker->context_cpy.scene->id, adt, &anim_eval_context, ADT_RECALC_ALL, false);
 
     /* This is quite hacky solution:
      * We need cross-reference original scene with copy for cache.
@@ -500,41 +571,27 @@ static void *seq_prefetch_frames(void *job)
      * Scene copy don't reference original scene. Perhaps, this could be done by depsgraph.
      * Set to nullptr before return!
      */
-    pfjob->scene_eval->ed->prefetch_job = pfjob;
-
-    ListBase *seqbase = active_seqbase_get(editing_get(pfjob->scene_eval));
-    ListBase *channels = channels_displayed_get(editing_get(pfjob->scene_eval));
-    if (seq_prefetch_must_skip_frame(pfjob, channels, seqbase)) {
-      pfjob->num_frames_prefetched++;
-      /* Break instead of keep looping if the job should be terminated. */
-      if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
-        break;
-      }
+    worker->scene_eval->ed->prefetch_job = pfjob;
+
+    ListBase *seqbase = active_seqbase_get(editing_get(worker->scene_eval));
+    ListBase *channels = channels_displayed_get(editing_get(worker->scene_eval));
+    if (seq_prefetch_must_skip_frame(worker, channels, seqbase)) {
       continue;
     }
 
-    ImBuf *ibuf = render_give_ibuf(&pfjob->context_cpy, seq_prefetch_cfra(pfjob), 0);
+    ImBuf *ibuf = render_give_ibuf(&worker->context_cpy, worker->cfra, 0);
     IMB_freeImBuf(ibuf);
+  }
 
-    /* Suspend thread if there is nothing to be prefetched. */
-    seq_prefetch_do_suspend(pfjob);
-
-    /* Avoid "collision" with main thread, but make sure to fetch at least few frames */
-    if (pfjob->num_frames_prefetched > 5 && (seq_prefetch_cfra(pfjob) - pfjob->scene->r.cfra) < 2)
-    {
-      break;
-    }
-
-    if (!(pfjob->scene->ed->cache_flag & SEQ_CACHE_PREFETCH_ENABLE) || pfjob->stop) {
-      break;
-    }
+  worker->scene_eval->ed->prefetch_job = nullptr;
 
-    seq_prefetch_update_area(pfjob);
-    pfjob->num_frames_prefetched++;
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  worker->is_rendering = false;
+  pfjob->running_workers_num--;
+  if (pfjob->running_workers_num == 0) {
+    pfjob->running = false;
   }
-
-  pfjob->running = false;
-  pfjob->scene_eval->ed->prefetch_job = nullptr;
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
 
   return nullptr;
 }
@@ -550,29 +607,35 @@ static PrefetchJob *seq_prefetch_start_ex(const RenderData *context, float cfra)
     pfjob = MEM_new<PrefetchJob>("PrefetchJob");
     context->scene->ed->prefetch_job = pfjob;
 
-    BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, 1);
+    pfjob->workers.reinitialize(seq_prefetch_workers_num());
+    BLI_threadpool_init(&pfjob->threads, seq_prefetch_frames, pfjob->workers.size());
     BLI_mutex_init(&pfjob->prefetch_suspend_mutex);
     BLI_condition_init(&pfjob->prefetch_suspend_cond);
 
-    pfjob->bmain_eval = BKE_main_new();
     pfjob->scene = context->scene;
-    seq_prefetch_init_depsgraph(pfjob);
+    for (PrefetchWorker &worker : pfjob->workers) {
+      worker.job = pfjob;
+      worker.bmain_eval = BKE_main_new();
+    }
   }
   pfjob->bmain = context->bmain;
 
   pfjob->cfra = cfra;
   pfjob->num_frames_prefetched = 1;
 
-  pfjob->waiting = false;
+  pfjob->waiting_workers_num = 0;
   pfjob->stop = false;
   pfjob->running = true;
+  pfjob->running_workers_num = pfjob->workers.size();
 
   seq_prefetch_update_scene(context->scene);
   seq_prefetch_update_context(context);
   seq_prefetch_update_active_seqbase(pfjob);
 
-  BLI_threadpool_remove(&pfjob->threads, pfjob);
-  BLI_threadpool_insert(&pfjob->threads, pfjob);
+  for (PrefetchWorker &worker : pfjob->workers) {
+    BLI_threadpool_remove(&pfjob->threads, &worker);
+    BLI_threadpool_insert(&pfjob->threads, &worker);
+  }
 
   return pfjob;
 }
@@ -602,6 +665,27 @@ void seq_prefetch_start(const RenderData *context, float timeline_frame)
   }
 }
 
+void prefetch_rendering_frames_iterate(Scene *scene,
+                                       void *userdata,
+                                       void callback_iter(void *userdata,
+                                                          int worker_index,
+                                                          int timeline_frame))
+{
+  PrefetchJob *pfjob = seq_prefetch_job_get(scene);
+  if (pfjob == nullptr || !pfjob->running) {
+    return;
+  }
+
+  BLI_mutex_lock(&pfjob->prefetch_suspend_mutex);
+  for (const int i : pfjob->workers.index_range()) {
+    const PrefetchWorker &worker = pfjob->workers[i];
+    if (worker.is_rendering) {
+      callback_iter(userdata, i, int(worker.cfra));
+    }
+  }
+  BLI_mutex_unlock(&pfjob->prefetch_suspend_mutex);
+}
+
 bool prefetch_need_redraw(const bContext *C, Scene *scene)
 {
   bScreen *screen = CTX_wm_screen(C);
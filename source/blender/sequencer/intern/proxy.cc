@@ -419,7 +419,11 @@ static bool seq_proxy_need_rebuild(Strip *strip, MovieReader *anim)
 
   IMB_Proxy_Size required_proxies = IMB_Proxy_Size(strip->data->proxy->build_size_flags);
   int built_proxies = MOV_get_existing_proxies(anim);
-  return (required_proxies & built_proxies) != required_proxies;
+  /* Time code indices can be built without any proxy, they speed up seeking already. */
+  int required_timecodes = strip->data->proxy->build_tc_flags;
+  int built_timecodes = MOV_get_existing_timecodes(anim);
+  return (required_proxies & built_proxies) != required_proxies ||
+         (required_timecodes & built_timecodes) != required_timecodes;
 }
 
 bool proxy_rebuild_context(Main *bmain,
@@ -25,6 +25,7 @@
 #include "BLI_path_utils.hh"
 #include "BLI_rect.h"
 #include "BLI_task.hh"
+#include "BLI_threads.h"
 
 #include "BKE_anim_data.hh"
 #include "BKE_animsys.h"
@@ -88,7 +89,13 @@ static ImBuf *seq_render_strip_stack(const RenderData *context,
                                      float timeline_frame,
                                      int chanshown);
 
-static blender::Mutex seq_render_mutex;
+/**
+ * Prefetch workers render their own copies of the scene and lock this for reading, so they can
+ * render at the same time. Other renders lock it for writing.
+ */
+static ThreadRWMutex seq_render_mutex = BLI_RWLOCK_INITIALIZER;
+/** Held while waiting for #seq_render_mutex for writing, so prefetch workers can't starve it. */
+static blender::Mutex seq_render_turnstile_mutex;
 DrawViewFn view3d_fn = nullptr; /* nullptr in background mode */
 
 /* -------------------------------------------------------------------- */
@@ -1839,6 +1846,84 @@ static bool is_opaque_alpha_over(const Strip *strip)
   return true;
 }
 
+/**
+ * Image and movie strips only use data owned by the strip itself while rendering, so several of
+ * them can be rendered at the same time. Scene strips go through the render pipeline, and
+ * effects and mask modifiers can render other strips of the stack.
+ */
+static bool strip_can_render_concurrently(const Strip *strip)
+{
+  if (!ELEM(strip->type, STRIP_TYPE_IMAGE, STRIP_TYPE_MOVIE)) {
+    return false;
+  }
+  LISTBASE_FOREACH (const StripModifierData *, smd, &strip->modifiers) {
+    if ((smd->flag & SEQUENCE_MODIFIER_MUTE) == 0 &&
+        (smd->mask_strip != nullptr || smd->mask_id != nullptr))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+/**
+ * Render the strips of the stack that can be rendered concurrently in parallel, before the stack
+ * is blended in channel order. The results are stored in the intra-frame cache, where
+ * #seq_render_strip finds them.
+ *
+ * Strips are visited from the top, the same way as in #seq_render_strip_stack. Strips that are
+ * likely opaque are treated as occluders, so no work is wasted on strips hidden behind them. If
+ * they turn out to be transparent, the strips below are rendered on demand as before.
+ */
+static void seq_render_strip_stack_prerender(const RenderData *context,
+                                             const Span<Strip *> strips,
+                                             const float timeline_frame)
+{
+  OpaqueQuadTracker likely_opaques;
+  Vector<Strip *> strips_to_render;
+  for (int64_t i = strips.size() - 1; i >= 0; i--) {
+    Strip *strip = strips[i];
+
+    ImBuf *composite = intra_frame_cache_get_composite(context->scene, strip);
+    if (composite) {
+      IMB_freeImBuf(composite);
+      break;
+    }
+    const bool is_replace = strip->blend_mode == SEQ_BLEND_REPLACE;
+    if (!is_replace && (strip_get_early_out_for_blend_mode(strip) == StripEarlyOut::UseInput1 ||
+                        likely_opaques.is_occluded(context, strip, i)))
+    {
+      continue;
+    }
+    if (strip_can_render_concurrently(strip)) {
+      strips_to_render.append(strip);
+    }
+    if (is_replace) {
+      break;
+    }
+    if (is_opaque_alpha_over(strip)) {
+      likely_opaques.add_occluder(context, strip, i);
+    }
+  }
+
+  if (strips_to_render.size() < 2) {
+    return;
+  }
+
+  /* The caller may hold #seq_render_mutex, don't let this thread pick up unrelated tasks that
+   * could try to lock it again. */
+  threading::isolate_task([&]() {
+    threading::parallel_for(strips_to_render.index_range(), 1, [&](const IndexRange range) {
+      for (const int64_t i : range) {
+        SeqRenderState state;
+        ImBuf *ibuf = seq_render_strip(context, &state, strips_to_render[i], timeline_frame);
+        /* The image is stored in the intra-frame cache. */
+        IMB_freeImBuf(ibuf);
+      }
+    });
+  });
+}
+
 static ImBuf *seq_render_strip_stack(const RenderData *context,
                                      SeqRenderState *state,
                                      ListBase *channels,
@@ -1852,6 +1937,8 @@ static ImBuf *seq_render_strip_stack(const RenderData *context,
     return nullptr;
   }
 
+  seq_render_strip_stack_prerender(context, strips, timeline_frame);
+
   OpaqueQuadTracker opaques;
 
   int64_t i;
@@ -2030,7 +2117,12 @@ ImBuf *render_give_ibuf(const RenderData *context, float timeline_frame, int cha
   SeqRenderState state;
 
   if (!strips.is_empty() && !out) {
-    std::scoped_lock lock(seq_render_mutex);
+    std::unique_lock turnstile(seq_render_turnstile_mutex);
+    if (context->is_prefetch_render) {
+      turnstile.unlock();
+    }
+    BLI_rw_mutex_lock(&seq_render_mutex,
+                      context->is_prefetch_render ? THREAD_LOCK_READ : THREAD_LOCK_WRITE);
     out = seq_render_strip_stack(context, &state, channels, seqbasep, timeline_frame, chanshown);
 
     evict_caches_if_full(orig_scene);
@@ -2040,6 +2132,7 @@ ImBuf *render_give_ibuf(const RenderData *context, float timeline_frame, int cha
     {
       final_image_cache_put(orig_scene, timeline_frame, context->view_id, out);
     }
+    BLI_rw_mutex_unlock(&seq_render_mutex);
   }
 
   seq_prefetch_start(context, timeline_frame);
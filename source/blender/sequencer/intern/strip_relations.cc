@@ -14,6 +14,7 @@
 #include "BLI_ghash.h"
 #include "BLI_listbase.h"
 #include "BLI_math_base.h"
+#include "BLI_memory_cache.hh"
 #include "BLI_session_uid.h"
 
 #include "BKE_main.hh"
@@ -56,8 +57,11 @@ void cache_cleanup(Scene *scene)
 bool is_cache_full(const Scene *scene)
 {
   size_t cache_limit = size_t(U.memcachelimit) * 1024 * 1024;
-  return source_image_cache_calc_memory_size(scene) + final_image_cache_calc_memory_size(scene) >
-         cache_limit;
+  const size_t cache_size = source_image_cache_calc_memory_size(scene) +
+                            final_image_cache_calc_memory_size(scene);
+  /* The images share the memory budget with other cached data, which is freed to make room. */
+  memory_cache::set_external_usage("Sequencer Images", int64_t(cache_size));
+  return cache_size > cache_limit;
 }
 
 static void invalidate_final_cache_strip_range(Scene *scene, const Strip *strip)
@@ -10,6 +10,8 @@
 
 #ifdef IMPLICIT_SOLVER_BLENDER
 
+#  include <cfloat>
+
 #  include "MEM_guardedalloc.h"
 
 #  include "BLI_math_geom.h"
@@ -110,6 +112,17 @@ DO_INLINE void print_lfvector(float (*fLongVector)[3], uint verts)
 }
 #  endif
 
+/* Run `fn` for every vertex index, in parallel for large vectors. */
+template<typename Fn> DO_INLINE void foreach_lfvector_index(const uint verts, const Fn &fn)
+{
+  blender::threading::parallel_for(
+      blender::IndexRange(verts), CLOTH_PARALLEL_LIMIT, [&](const blender::IndexRange range) {
+        for (const int64_t i : range) {
+          fn(uint(i));
+        }
+      });
+}
+
 /* create long vector */
 DO_INLINE lfVector *create_lfvector(uint verts)
 {
@@ -146,28 +159,18 @@ DO_INLINE void zero_lfvector(float (*to)[3], uint verts)
 /* Multiply long vector with scalar. */
 DO_INLINE void mul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float scalar, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    mul_fvector_S(to[i], fLongVector[i], scalar);
-  }
+  foreach_lfvector_index(verts, [&](const uint i) { mul_fvector_S(to[i], fLongVector[i], scalar); });
 }
 /* Multiply long vector with scalar.
  * `A -= B * float` */
 DO_INLINE void submul_lfvectorS(float (*to)[3], float (*fLongVector)[3], float scalar, uint verts)
 {
-  uint i = 0;
-  for (i = 0; i < verts; i++) {
-    VECSUBMUL(to[i], fLongVector[i], scalar);
-  }
+  foreach_lfvector_index(verts, [&](const uint i) { VECSUBMUL(to[i], fLongVector[i], scalar); });
 }
 /* dot product for big vector */
 DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3], uint verts)
 {
-#  if 0
-  /* TODO: try enabling this and measuring performance. It was previously disabled
-   * due to non-deterministic behavior, but parallel_deterministic_reduce should
-   * give consistent results. */
+  /* The deterministic reduction gives the same result regardless of the number of threads. */
   return blender::threading::parallel_deterministic_reduce(
       blender::IndexRange(0, verts),
       CLOTH_PARALLEL_LIMIT,
@@ -180,13 +183,6 @@ DO_INLINE float dot_lfvector(float (*fLongVectorA)[3], float (*fLongVectorB)[3],
         return temp;
       },
       std::plus<>());
-#  else
-  float temp = 0.0;
-  for (uint i = 0; i < verts; i++) {
-    temp += dot_v3v3(fLongVectorA[i], fLongVectorB[i]);
-  }
-  return temp;
-#  endif
 }
 /* `A = B + C` -> for big vector. */
 DO_INLINE void add_lfvector_lfvector(float (*to)[3],
@@ -194,21 +190,15 @@ DO_INLINE void add_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  foreach_lfvector_index(
+      verts, [&](const uint i) { add_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]); });
 }
 /* `A = B + C * float` -> for big vector. */
 DO_INLINE void add_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  foreach_lfvector_index(
+      verts, [&](const uint i) { VECADDS(to[i], fLongVectorA[i], fLongVectorB[i], bS); });
 }
 /* `A = B * float + C * float` -> for big vector */
 DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
@@ -218,20 +208,15 @@ DO_INLINE void add_lfvectorS_lfvectorS(float (*to)[3],
                                        float bS,
                                        uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS);
-  }
+  foreach_lfvector_index(
+      verts, [&](const uint i) { VECADDSS(to[i], fLongVectorA[i], aS, fLongVectorB[i], bS); });
 }
 /* `A = B - C * float` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvectorS(
     float (*to)[3], float (*fLongVectorA)[3], float (*fLongVectorB)[3], float bS, uint verts)
 {
-  uint i = 0;
-  for (i = 0; i < verts; i++) {
-    VECSUBS(to[i], fLongVectorA[i], fLongVectorB[i], bS);
-  }
+  foreach_lfvector_index(
+      verts, [&](const uint i) { VECSUBS(to[i], fLongVectorA[i], fLongVectorB[i], bS); });
 }
 /* `A = B - C` -> for big vector. */
 DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
@@ -239,11 +224,8 @@ DO_INLINE void sub_lfvector_lfvector(float (*to)[3],
                                      float (*fLongVectorB)[3],
                                      uint verts)
 {
-  uint i = 0;
-
-  for (i = 0; i < verts; i++) {
-    sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]);
-  }
+  foreach_lfvector_index(
+      verts, [&](const uint i) { sub_v3_v3v3(to[i], fLongVectorA[i], fLongVectorB[i]); });
 }
 ///////////////////////////
 // 3x3 matrix
@@ -742,11 +724,28 @@ BLI_INLINE void root_to_world_m3(Implicit_Data *data,
 
 DO_INLINE void filter(lfVector *V, fmatrix3x3 *S)
 {
-  uint i = 0;
+  /* Every vertex has at most one constraint block, so the blocks can be applied in parallel. */
+  foreach_lfvector_index(S[0].vcount, [&](const uint i) { mul_m3_v3(S[i].m, V[S[i].r]); });
+}
 
-  for (i = 0; i < S[0].vcount; i++) {
-    mul_m3_v3(S[i].m, V[S[i].r]);
-  }
+/* Jacobi pre-conditioner: the inverse of the diagonal of A. */
+DO_INLINE void build_jacobi_preconditioner(fmatrix3x3 *lA, lfVector *Pinv)
+{
+  foreach_lfvector_index(lA[0].vcount, [&](const uint i) {
+    for (int j = 0; j < 3; j++) {
+      const float diagonal = lA[i].m[j][j];
+      Pinv[i][j] = diagonal > FLT_EPSILON ? 1.0f / diagonal : 1.0f;
+    }
+  });
+}
+
+/* `to = P^-1 * from` for the Jacobi pre-conditioner. */
+DO_INLINE void precondition_lfvector(float (*to)[3],
+                                     float (*from)[3],
+                                     float (*Pinv)[3],
+                                     uint verts)
+{
+  foreach_lfvector_index(verts, [&](const uint i) { mul_v3_v3v3(to[i], Pinv[i], from[i]); });
 }
 
 /* this version of the CG algorithm does not work very well with partial constraints
@@ -837,14 +836,18 @@ static int cg_filtered(lfVector *ldV,
   lfVector *c = create_lfvector(numverts);
   lfVector *q = create_lfvector(numverts);
   lfVector *s = create_lfvector(numverts);
+  lfVector *Pinv = create_lfvector(numverts);
   float bnorm2, delta_new, delta_old, delta_target, alpha;
 
   cp_lfvector(ldV, z, numverts);
 
-  /* d0 = filter(B)^T * P * filter(B) */
+  build_jacobi_preconditioner(lA, Pinv);
+
+  /* d0 = filter(B)^T * P^-1 * filter(B) */
   cp_lfvector(fB, lB, numverts);
   filter(fB, S);
-  bnorm2 = dot_lfvector(fB, fB, numverts);
+  precondition_lfvector(s, fB, Pinv, numverts);
+  bnorm2 = dot_lfvector(fB, s, numverts);
   delta_target = conjgrad_epsilon * conjgrad_epsilon * bnorm2;
 
   /* r = filter(B - A * dV) */
@@ -853,7 +856,7 @@ static int cg_filtered(lfVector *ldV,
   filter(r, S);
 
   /* c = filter(P^-1 * r) */
-  cp_lfvector(c, r, numverts);
+  precondition_lfvector(c, r, Pinv, numverts);
   filter(c, S);
 
   /* delta = r^T * c */
@@ -881,7 +884,7 @@ static int cg_filtered(lfVector *ldV,
     add_lfvector_lfvectorS(r, r, q, -alpha, numverts);
 
     /* s = P^-1 * r */
-    cp_lfvector(s, r, numverts);
+    precondition_lfvector(s, r, Pinv, numverts);
     delta_old = delta_new;
     delta_new = dot_lfvector(r, s, numverts);
 
@@ -903,6 +906,7 @@ static int cg_filtered(lfVector *ldV,
   del_lfvector(c);
   del_lfvector(q);
   del_lfvector(s);
+  del_lfvector(Pinv);
   // printf("W/O conjgrad_loopcount: %d\n", conjgrad_loopcount);
 
   result->status = conjgrad_loopcount < conjgrad_looplimit ? SIM_SOLVER_SUCCESS :
@@ -1457,3 +1457,4 @@ extern CLG_LogRef *WM_LOG_KEYMAPS;
 extern CLG_LogRef *WM_LOG_TOOLS;
 extern CLG_LogRef *WM_LOG_MSGBUS_PUB;
 extern CLG_LogRef *WM_LOG_MSGBUS_SUB;
+extern CLG_LogRef *WM_LOG_DRAW_STATS;
@@ -11,6 +11,8 @@
 #include <cstdlib>
 #include <cstring>
 
+#include <fmt/format.h>
+
 #include "DNA_camera_types.h"
 #include "DNA_listBase.h"
 #include "DNA_object_types.h"
@@ -22,11 +24,13 @@
 
 #include "MEM_guardedalloc.h"
 
+#include "BLI_index_range.hh"
 #include "BLI_listbase.h"
 #include "BLI_math_matrix.h"
 #include "BLI_math_vector.h"
 #include "BLI_math_vector_types.hh"
 #include "BLI_rect.h"
+#include "BLI_time.h"
 #include "BLI_utildefines.h"
 
 #include "BKE_context.hh"
@@ -34,6 +38,8 @@
 #include "BKE_scene.hh"
 #include "BKE_screen.hh"
 
+#include "CLG_log.h"
+
 #include "GHOST_C-api.h"
 
 #include "ED_node.hh"
@@ -558,13 +564,13 @@ bool WM_region_use_viewport(ScrArea *area, ARegion *region)
   return wm_region_use_viewport_by_type(area->spacetype, region->regiontype);
 }
 
-static const char *wm_area_name(ScrArea *area)
+static const char *wm_space_type_name(const int spacetype)
 {
 #define SPACE_NAME(space) \
   case space: \
     return #space;
 
-  switch (area->spacetype) {
+  switch (spacetype) {
     SPACE_NAME(SPACE_EMPTY);
     SPACE_NAME(SPACE_VIEW3D);
     SPACE_NAME(SPACE_GRAPH);
@@ -589,6 +595,173 @@ static const char *wm_area_name(ScrArea *area)
   }
 }
 
+static const char *wm_area_name(ScrArea *area)
+{
+  return wm_space_type_name(area->spacetype);
+}
+
+static const char *wm_region_type_name(const int regiontype)
+{
+#define REGION_NAME(region) \
+  case region: \
+    return #region;
+
+  switch (regiontype) {
+    REGION_NAME(RGN_TYPE_WINDOW);
+    REGION_NAME(RGN_TYPE_HEADER);
+    REGION_NAME(RGN_TYPE_CHANNELS);
+    REGION_NAME(RGN_TYPE_TEMPORARY);
+    REGION_NAME(RGN_TYPE_UI);
+    REGION_NAME(RGN_TYPE_TOOLS);
+    REGION_NAME(RGN_TYPE_TOOL_PROPS);
+    REGION_NAME(RGN_TYPE_PREVIEW);
+    REGION_NAME(RGN_TYPE_HUD);
+    REGION_NAME(RGN_TYPE_NAV_BAR);
+    REGION_NAME(RGN_TYPE_EXECUTE);
+    REGION_NAME(RGN_TYPE_FOOTER);
+    REGION_NAME(RGN_TYPE_TOOL_HEADER);
+    REGION_NAME(RGN_TYPE_XR);
+    REGION_NAME(RGN_TYPE_ASSET_SHELF);
+    REGION_NAME(RGN_TYPE_ASSET_SHELF_HEADER);
+    default:
+      return "Unknown Region";
+  }
+#undef REGION_NAME
+}
+
+static const char *wm_notifier_category_name(const uint category)
+{
+#define CATEGORY_NAME(category) \
+  case category: \
+    return #category;
+
+  switch (category) {
+    CATEGORY_NAME(NC_WM);
+    CATEGORY_NAME(NC_WINDOW);
+    CATEGORY_NAME(NC_WORKSPACE);
+    CATEGORY_NAME(NC_SCREEN);
+    CATEGORY_NAME(NC_SCENE);
+    CATEGORY_NAME(NC_OBJECT);
+    CATEGORY_NAME(NC_MATERIAL);
+    CATEGORY_NAME(NC_TEXTURE);
+    CATEGORY_NAME(NC_LAMP);
+    CATEGORY_NAME(NC_GROUP);
+    CATEGORY_NAME(NC_IMAGE);
+    CATEGORY_NAME(NC_BRUSH);
+    CATEGORY_NAME(NC_TEXT);
+    CATEGORY_NAME(NC_WORLD);
+    CATEGORY_NAME(NC_ANIMATION);
+    CATEGORY_NAME(NC_SPACE);
+    CATEGORY_NAME(NC_GEOM);
+    CATEGORY_NAME(NC_NODE);
+    CATEGORY_NAME(NC_ID);
+    CATEGORY_NAME(NC_PAINTCURVE);
+    CATEGORY_NAME(NC_MOVIECLIP);
+    CATEGORY_NAME(NC_MASK);
+    CATEGORY_NAME(NC_GPENCIL);
+    CATEGORY_NAME(NC_LINESTYLE);
+    CATEGORY_NAME(NC_CAMERA);
+    CATEGORY_NAME(NC_LIGHTPROBE);
+    CATEGORY_NAME(NC_ASSET);
+    CATEGORY_NAME(NC_VIEWER_PATH);
+    default:
+      return "Unknown Category";
+  }
+#undef CATEGORY_NAME
+}
+
+/** \} */
+
+/* -------------------------------------------------------------------- */
+/** \name Redraw Statistics
+ *
+ * Counts redraws per editor and region type, together with the notifiers that were added in the
+ * same period. The counts are reported once per second with `--log "wm.draw.stats"`, which helps
+ * to find regions and notifiers that cause more redraws than expected.
+ * \{ */
+
+struct WMDrawStats {
+  double time_start = 0.0;
+  int window_draws = 0;
+  int region_draws[SPACE_TYPE_NUM][RGN_TYPE_NUM] = {};
+  int menu_draws = 0;
+  /** Indexed by the notifier category, see #NOTE_CATEGORY. */
+  int notifiers[(NOTE_CATEGORY >> 24) + 1] = {};
+};
+
+static WMDrawStats g_draw_stats;
+
+static bool wm_draw_stats_enabled()
+{
+  return CLOG_CHECK(WM_LOG_DRAW_STATS, 1);
+}
+
+static void wm_draw_stats_region_add(const ScrArea *area, const ARegion *region)
+{
+  if (!wm_draw_stats_enabled()) {
+    return;
+  }
+  if (area == nullptr) {
+    g_draw_stats.menu_draws++;
+  }
+  else if (area->spacetype < SPACE_TYPE_NUM && region->regiontype < RGN_TYPE_NUM) {
+    g_draw_stats.region_draws[int(area->spacetype)][int(region->regiontype)]++;
+  }
+}
+
+void wm_draw_stats_notifier_add(const uint type)
+{
+  if (!wm_draw_stats_enabled()) {
+    return;
+  }
+  g_draw_stats.notifiers[(type & NOTE_CATEGORY) >> 24]++;
+}
+
+static void wm_draw_stats_report()
+{
+  if (!wm_draw_stats_enabled()) {
+    return;
+  }
+  const double time = BLI_time_now_seconds();
+  if (g_draw_stats.time_start == 0.0) {
+    g_draw_stats.time_start = time;
+    return;
+  }
+  const double duration = time - g_draw_stats.time_start;
+  if (duration < 1.0) {
+    return;
+  }
+
+  std::string report = fmt::format(
+      "{} window redraws in {:.2f}s", g_draw_stats.window_draws, duration);
+  for (const int spacetype : blender::IndexRange(SPACE_TYPE_NUM)) {
+    for (const int regiontype : blender::IndexRange(RGN_TYPE_NUM)) {
+      const int draws = g_draw_stats.region_draws[spacetype][regiontype];
+      if (draws > 0) {
+        report += fmt::format("\n  {}, {}: {}",
+                              wm_space_type_name(spacetype),
+                              wm_region_type_name(regiontype),
+                              draws);
+      }
+    }
+  }
+  if (g_draw_stats.menu_draws > 0) {
+    report += fmt::format("\n  Menus: {}", g_draw_stats.menu_draws);
+  }
+  for (const int category : blender::IndexRange(ARRAY_SIZE(g_draw_stats.notifiers))) {
+    const int notifiers = g_draw_stats.notifiers[category];
+    if (notifiers > 0) {
+      report += fmt::format("\n  Notifier {}: {}",
+                            wm_notifier_category_name(uint(category) << 24),
+                            notifiers);
+    }
+  }
+  CLOG_STR_INFO(WM_LOG_DRAW_STATS, 1, report.c_str());
+
+  g_draw_stats = {};
+  g_draw_stats.time_start = time;
+}
+
 /** \} */
 
 /* -------------------------------------------------------------------- */
@@ -1004,6 +1177,7 @@ static void wm_draw_area_offscreen(bContext *C, wmWindow *win, ScrArea *area, bo
 
     GPU_debug_group_end();
 
+    wm_draw_stats_region_add(area, region);
     region->runtime->do_draw = 0;
     CTX_wm_region_set(C, nullptr);
   }
@@ -1056,6 +1230,7 @@ static void wm_draw_window_offscreen(bContext *C, wmWindow *win, bool stereo)
 
     GPU_debug_group_end();
 
+    wm_draw_stats_region_add(nullptr, region);
     region->runtime->do_draw = 0;
     CTX_wm_region_popup_set(C, nullptr);
   }
@@ -1595,11 +1770,17 @@ void wm_draw_update(bContext *C)
       wm_draw_update_clear_window(C, win);
 
       wm_window_swap_buffers(win);
+
+      if (wm_draw_stats_enabled()) {
+        g_draw_stats.window_draws++;
+      }
     }
   }
 
   CTX_wm_window_set(C, nullptr);
 
+  wm_draw_stats_report();
+
   /* Draw non-windows (surfaces). */
   wm_surfaces_iter(C, wm_draw_surface);
 
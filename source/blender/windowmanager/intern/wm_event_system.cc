@@ -77,6 +77,7 @@
 #include "WM_types.hh"
 
 #include "wm.hh"
+#include "wm_draw.hh"
 #include "wm_event_system.hh"
 #include "wm_event_types.hh"
 #include "wm_surface.hh"
@@ -376,6 +377,8 @@ static void wm_event_add_notifier_intern(wmWindowManager *wm,
   *note = note_test;
   *note_p = note;
   BLI_addtail(&wm->runtime->notifier_queue, note);
+
+  wm_draw_stats_notifier_add(type);
 }
 
 void WM_event_add_notifier_ex(wmWindowManager *wm, const wmWindow *win, uint type, void *reference)
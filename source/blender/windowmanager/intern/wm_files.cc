@@ -2343,12 +2343,14 @@ void WM_autosave_write(wmWindowManager *wm, Main *bmain)
   char filepath[FILE_MAX];
   wm_autosave_location(filepath);
   /* Save as regular blend file with recovery information and always compress them, see: !132685.
-   */
-  const int fileflags = G.fileflags | G_FILE_RECOVER_WRITE | G_FILE_COMPRESS;
+   * Auto-save files are only meant to be recovered by the same Blender version, so implicitly
+   * shared data can be written once for all IDs using it. */
+  const int fileflags = G.fileflags | G_FILE_RECOVER_WRITE | G_FILE_COMPRESS |
+                        G_FILE_CROSS_ID_SHARED_DATA;
 
-  /* Error reporting into console. */
-  BlendFileWriteParams params{};
-  BLO_write_file(bmain, filepath, fileflags, &params, nullptr);
+  /* Error reporting into console. Compressing and writing the file happens in the background, so
+   * the UI is only blocked while the data is serialized. */
+  BLO_write_file_async(bmain, filepath, fileflags, nullptr);
 
   /* Restart auto-save timer. */
   wm_autosave_timer_end(wm);
@@ -2412,6 +2414,9 @@ void wm_autosave_timer(Main *bmain, wmWindowManager *wm, wmTimer * /*wt*/)
 
 void wm_autosave_delete()
 {
+  /* Don't let a pending auto-save re-create the file. */
+  BLO_write_file_async_wait();
+
   char filepath[FILE_MAX];
 
   wm_autosave_location(filepath);
@@ -123,6 +123,7 @@ CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_KEYMAPS, "wm.keymap");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_TOOLS, "wm.tool");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_MSGBUS_PUB, "wm.msgbus.pub");
 CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_MSGBUS_SUB, "wm.msgbus.sub");
+CLG_LOGREF_DECLARE_GLOBAL(WM_LOG_DRAW_STATS, "wm.draw.stats");
 
 static void wm_init_scripts_extensions_once(bContext *C);
 
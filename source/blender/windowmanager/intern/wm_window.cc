@@ -820,6 +820,10 @@ static void wm_window_ghostwindow_add(wmWindowManager *wm,
   gpuSettings.preferred_device.index = U.gpu_preferred_index;
   gpuSettings.preferred_device.vendor_id = U.gpu_preferred_vendor_id;
   gpuSettings.preferred_device.device_id = U.gpu_preferred_device_id;
+  if (const int device_index = GPU_backend_device_selection_override_get(); device_index != -1) {
+    gpuSettings.preferred_device.index = device_index;
+    gpuSettings.preferred_device.use_index_only = true;
+  }
 
   int posx = 0;
   int posy = 0;
@@ -3191,6 +3195,10 @@ void *WM_system_gpu_context_create()
   gpuSettings.preferred_device.index = U.gpu_preferred_index;
   gpuSettings.preferred_device.vendor_id = U.gpu_preferred_vendor_id;
   gpuSettings.preferred_device.device_id = U.gpu_preferred_device_id;
+  if (const int device_index = GPU_backend_device_selection_override_get(); device_index != -1) {
+    gpuSettings.preferred_device.index = device_index;
+    gpuSettings.preferred_device.use_index_only = true;
+  }
 
   return GHOST_CreateGPUContext(g_system, gpuSettings);
 }
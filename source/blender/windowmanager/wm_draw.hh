@@ -29,5 +29,7 @@ void wm_draw_update(bContext *C);
 void wm_draw_region_clear(wmWindow *win, ARegion *region);
 void wm_draw_region_blend(ARegion *region, int view, bool blend);
 void wm_draw_region_test(bContext *C, ScrArea *area, ARegion *region);
+/** Count a notifier for the `wm.draw.stats` log. */
+void wm_draw_stats_notifier_add(unsigned int type);
 
 GPUTexture *wm_draw_region_texture(ARegion *region, int view);
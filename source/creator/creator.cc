@@ -330,17 +330,28 @@ int main(int argc,
    *       guarded allocator before any allocation happened.
    */
   {
+    bool use_guarded_allocator = false;
+    bool use_thread_cache_allocator = false;
     int i;
     for (i = 0; i < argc; i++) {
       if (STR_ELEM(argv[i], "-d", "--debug", "--debug-memory", "--debug-all")) {
-        printf("Switching to fully guarded memory allocator.\n");
-        MEM_use_guarded_allocator();
+        use_guarded_allocator = true;
         break;
       }
+      if (STREQ(argv[i], "--thread-cache-allocator")) {
+        use_thread_cache_allocator = true;
+      }
       if (STR_ELEM(argv[i], "--", "-c", "--command")) {
         break;
       }
     }
+    if (use_guarded_allocator) {
+      printf("Switching to fully guarded memory allocator.\n");
+      MEM_use_guarded_allocator();
+    }
+    else if (use_thread_cache_allocator) {
+      MEM_use_thread_cache_allocator();
+    }
     MEM_init_memleak_detection();
   }
 
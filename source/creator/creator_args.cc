@@ -41,6 +41,8 @@
 #  include "BKE_context.hh"
 
 #  include "BKE_global.hh"
+#  include "BKE_idtype.hh"
+#  include "BKE_image.hh"
 #  include "BKE_image_format.hh"
 #  include "BKE_lib_id.hh"
 #  include "BKE_main.hh"
@@ -649,6 +651,7 @@ static void print_help(bArgs *ba, bool all)
   PRINT("Render Options:\n");
   BLI_args_print_arg_doc(ba, "--background");
   BLI_args_print_arg_doc(ba, "--render-anim");
+  BLI_args_print_arg_doc(ba, "--render-worker");
   BLI_args_print_arg_doc(ba, "--scene");
   BLI_args_print_arg_doc(ba, "--render-frame");
   BLI_args_print_arg_doc(ba, "--frame-start");
@@ -766,6 +769,8 @@ static void print_help(bArgs *ba, bool all)
   }
   BLI_args_print_arg_doc(ba, "--debug-all");
   BLI_args_print_arg_doc(ba, "--debug-io");
+  BLI_args_print_arg_doc(ba, "--profile-blend-read");
+  BLI_args_print_arg_doc(ba, "--profile-compositor");
 
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--debug-fpe");
@@ -782,6 +787,7 @@ static void print_help(bArgs *ba, bool all)
   PRINT("\n");
   PRINT("GPU Options:\n");
   BLI_args_print_arg_doc(ba, "--gpu-backend");
+  BLI_args_print_arg_doc(ba, "--gpu-device");
 #  ifdef WITH_OPENGL_BACKEND
   BLI_args_print_arg_doc(ba, "--gpu-compilation-subprocesses");
   BLI_args_print_arg_doc(ba, "--profile-gpu");
@@ -793,6 +799,7 @@ static void print_help(bArgs *ba, bool all)
   BLI_args_print_arg_doc(ba, "--app-template");
   BLI_args_print_arg_doc(ba, "--factory-startup");
   BLI_args_print_arg_doc(ba, "--enable-event-simulate");
+  BLI_args_print_arg_doc(ba, "--thread-cache-allocator");
   PRINT("\n");
   BLI_args_print_arg_doc(ba, "--env-system-datafiles");
   BLI_args_print_arg_doc(ba, "--env-system-scripts");
@@ -1374,6 +1381,34 @@ static int arg_handle_debug_mode_io(int /*argc*/, const char ** /*argv*/, void *
   return 0;
 }
 
+static const char arg_handle_profile_blend_read_set_doc[] =
+    "<filepath>\n"
+    "\tWrite a JSON report of the time and memory spent reading blend files to the given file.\n"
+    "\tThe report is overwritten by every file read, so it describes the last file read.";
+static int arg_handle_profile_blend_read_set(int argc, const char **argv, void * /*data*/)
+{
+  if (argc > 1) {
+    STRNCPY(G.blend_read_profile_filepath, argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "\nError: you must specify a file path after '--profile-blend-read'.\n");
+  return 0;
+}
+
+static const char arg_handle_profile_compositor_set_doc[] =
+    "<filepath>\n"
+    "\tWrite a JSON report of the evaluation time and memory usage of compositor nodes to the\n"
+    "\tgiven file. The report is overwritten by every evaluation, so it describes the last one.";
+static int arg_handle_profile_compositor_set(int argc, const char **argv, void * /*data*/)
+{
+  if (argc > 1) {
+    STRNCPY(G.compositor_profile_filepath, argv[1]);
+    return 1;
+  }
+  fprintf(stderr, "\nError: you must specify a file path after '--profile-compositor'.\n");
+  return 0;
+}
+
 static const char arg_handle_debug_mode_all_doc[] =
     "\n\t"
     "Enable all debug messages.";
@@ -1420,6 +1455,19 @@ static int arg_handle_debug_mode_memory_set(int /*argc*/, const char ** /*argv*/
   return 0;
 }
 
+static const char arg_handle_thread_cache_allocator_set_doc[] =
+    "\n\t"
+    "Use per-thread caches for small memory allocations.\n"
+    "\tThis can be faster when many threads allocate memory, but freed memory is kept for reuse.\n"
+    "\tIgnored when memory debugging is enabled.";
+static int arg_handle_thread_cache_allocator_set(int /*argc*/,
+                                                 const char ** /*argv*/,
+                                                 void * /*data*/)
+{
+  /* The allocator is switched in `main()` before any allocation happens. */
+  return 0;
+}
+
 static const char arg_handle_debug_value_set_doc[] =
     "<value>\n"
     "\tSet debug value of <value> on startup.";
@@ -1558,6 +1606,29 @@ static int arg_handle_gpu_backend_set(int argc, const char **argv, void * /*data
   return 1;
 }
 
+static const char arg_handle_gpu_device_set_doc[] =
+    "<index>\n"
+    "\tUse the GPU with the given index in the list of devices, ignoring the preferences.\n"
+    "\tAllows running one instance per GPU, e.g. to render frames on all GPUs of a machine\n"
+    "\t(Vulkan only).";
+static int arg_handle_gpu_device_set(int argc, const char **argv, void * /*data*/)
+{
+  const char *arg_id = "--gpu-device";
+  if (argc > 1) {
+    const char *err_msg = nullptr;
+    int device_index;
+    if (!parse_int_strict_range(argv[1], nullptr, 0, INT_MAX, &device_index, &err_msg)) {
+      fprintf(stderr, "\nError: %s '%s %s', expected a device index.\n", err_msg, arg_id, argv[1]);
+      return 0;
+    }
+
+    GPU_backend_device_selection_set_override(device_index);
+    return 1;
+  }
+  fprintf(stderr, "\nError: you must specify a device index '%s'.\n", arg_id);
+  return 0;
+}
+
 #  ifdef WITH_OPENGL_BACKEND
 static const char arg_handle_gpu_compilation_subprocesses_set_doc[] =
     "\n"
@@ -2205,6 +2276,120 @@ static int arg_handle_render_animation(int /*argc*/, const char ** /*argv*/, voi
   return 0;
 }
 
+static const char arg_handle_render_worker_doc[] =
+    "\n\t"
+    "Render jobs read from the standard input, one command per line, until it's closed.\n"
+    "\tThe blend-file, the evaluated scene and the render engine data stay in memory between jobs,\n"
+    "\tso only the frame change and data-blocks tagged as modified are evaluated again.\n"
+    "\n"
+    "\t* 'frame <frame>' renders frame <frame> and saves it.\n"
+    "\t* 'output <path>' sets the render output path for the following frames.\n"
+    "\t* 'tag <name>' tags a data-block as modified, using the name with its type prefix\n"
+    "\t  (e.g. 'tag IMwood.png' reloads the image from disk).\n"
+    "\t* 'quit' stops the worker.\n"
+    "\n"
+    "\tThe result of every command is printed as a line starting with 'render-worker:'.";
+
+static void render_worker_reply(const char *status, const char *message)
+{
+  printf("render-worker: %s %s\n", status, message);
+  fflush(stdout);
+}
+
+static bool render_worker_tag(Main *bmain, const char *id_name)
+{
+  if (strlen(id_name) <= 2) {
+    return false;
+  }
+  const short id_code = GS(id_name);
+  if (!BKE_idtype_idcode_is_valid(id_code)) {
+    return false;
+  }
+  ID *id = BKE_libblock_find_name(bmain, id_code, id_name + 2);
+  if (id == nullptr) {
+    return false;
+  }
+  /* Images are typically modified by writing a new file, e.g. a texture baked by another job. */
+  if (id_code == ID_IM) {
+    BKE_image_signal(bmain, reinterpret_cast<Image *>(id), nullptr, IMA_SIGNAL_RELOAD);
+  }
+  DEG_id_tag_update_ex(bmain, id, ID_RECALC_ALL);
+  return true;
+}
+
+static int arg_handle_render_worker(int /*argc*/, const char ** /*argv*/, void *data)
+{
+  bContext *C = static_cast<bContext *>(data);
+  Scene *scene = CTX_data_scene(C);
+  if (scene == nullptr) {
+    fprintf(stderr, "\nError: no blend loaded. cannot use '--render-worker'.\n");
+    return 0;
+  }
+  Main *bmain = CTX_data_main(C);
+
+  /* Keep the render engine and its evaluated depsgraph after every job, so the next job only
+   * evaluates what changed for its frame instead of loading and evaluating the whole scene. */
+  scene->r.mode |= R_PERSISTENT_DATA;
+  DEG_id_tag_update(&scene->id, ID_RECALC_SYNC_TO_EVAL);
+
+  Render *re = RE_NewSceneRender(scene);
+  ReportList reports;
+  BKE_reports_init(&reports, RPT_STORE);
+  RE_SetReports(re, &reports);
+
+  render_worker_reply("ready", BKE_main_blendfile_path(bmain));
+
+  char line[FILE_MAX + 16];
+  while (fgets(line, sizeof(line), stdin)) {
+    BLI_str_rstrip(line);
+    if (line[0] == '\0') {
+      continue;
+    }
+    const char *value = "";
+    if (char *sep = strchr(line, ' ')) {
+      *sep = '\0';
+      value = sep + 1;
+    }
+
+    if (STREQ(line, "quit")) {
+      break;
+    }
+    if (STREQ(line, "frame")) {
+      const char *err_msg = nullptr;
+      int frame;
+      if (!parse_int_clamp(value, nullptr, MINAFRAME, MAXFRAME, &frame, &err_msg)) {
+        render_worker_reply("error", err_msg);
+        continue;
+      }
+      G.is_break = false;
+      BKE_reports_clear(&reports);
+      RE_RenderAnim(re, bmain, scene, nullptr, nullptr, frame, frame, scene->r.frame_step);
+      if (G.is_break || BKE_reports_contain(&reports, RPT_ERROR)) {
+        BKE_reports_print(&reports, RPT_ERROR);
+        render_worker_reply("error", value);
+      }
+      else {
+        render_worker_reply("done", value);
+      }
+    }
+    else if (STREQ(line, "output")) {
+      STRNCPY(scene->r.pic, value);
+      DEG_id_tag_update(&scene->id, ID_RECALC_SYNC_TO_EVAL);
+      render_worker_reply("done", value);
+    }
+    else if (STREQ(line, "tag")) {
+      render_worker_reply(render_worker_tag(bmain, value) ? "done" : "error", value);
+    }
+    else {
+      render_worker_reply("error", line);
+    }
+  }
+
+  RE_SetReports(re, nullptr);
+  BKE_reports_free(&reports);
+  return 0;
+}
+
 static const char arg_handle_scene_set_doc[] =
     "<name>\n"
     "\tSet the active scene <name> for rendering.";
@@ -2688,6 +2873,7 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   /* GPU backend selection should be part of #ARG_PASS_ENVIRONMENT for correct GPU context
    * selection for animation player. */
   BLI_args_add(ba, nullptr, "--gpu-backend", CB_ALL(arg_handle_gpu_backend_set), nullptr);
+  BLI_args_add(ba, nullptr, "--gpu-device", CB(arg_handle_gpu_device_set), nullptr);
 #  ifdef WITH_OPENGL_BACKEND
   BLI_args_add(ba,
                nullptr,
@@ -2799,6 +2985,10 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_add(ba, nullptr, "--debug-all", CB(arg_handle_debug_mode_all), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-io", CB(arg_handle_debug_mode_io), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--profile-blend-read", CB(arg_handle_profile_blend_read_set), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--profile-compositor", CB(arg_handle_profile_compositor_set), nullptr);
 
   BLI_args_add(ba, nullptr, "--debug-fpe", CB(arg_handle_debug_fpe_set), nullptr);
 
@@ -2893,6 +3083,8 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_add(ba, nullptr, "--factory-startup", CB(arg_handle_factory_startup_set), nullptr);
   BLI_args_add(
       ba, nullptr, "--enable-event-simulate", CB(arg_handle_enable_event_simulate), nullptr);
+  BLI_args_add(
+      ba, nullptr, "--thread-cache-allocator", CB(arg_handle_thread_cache_allocator_set), nullptr);
 
   /* Pass: Custom Window Stuff. */
   BLI_args_pass_set(ba, ARG_PASS_SETTINGS_GUI);
@@ -2920,6 +3112,7 @@ void main_args_setup(bContext *C, bArgs *ba, bool all)
   BLI_args_pass_set(ba, ARG_PASS_FINAL);
   BLI_args_add(ba, "-f", "--render-frame", CB(arg_handle_render_frame), C);
   BLI_args_add(ba, "-a", "--render-anim", CB(arg_handle_render_animation), C);
+  BLI_args_add(ba, nullptr, "--render-worker", CB(arg_handle_render_worker), C);
   BLI_args_add(ba, "-S", "--scene", CB(arg_handle_scene_set), C);
   BLI_args_add(ba, "-s", "--frame-start", CB(arg_handle_frame_start_set), C);
   BLI_args_add(ba, "-e", "--frame-end", CB(arg_handle_frame_end_set), C);
@@ -128,6 +128,9 @@ class TestConfig:
         self.builds = getattr(config, 'builds', {})
         self.queue = TestQueue(self.base_dir / 'results.json')
         self.benchmark_type = getattr(config, 'benchmark_type', 'comparison')
+        # Number of times every test is run, to estimate the noise of the measurements.
+        self.repeats = max(1, getattr(config, 'repeats', 1))
+        self.baseline_filepath = self.base_dir / 'baseline.json'
 
         self.devices = []
         self._update_devices(env, getattr(config, 'devices', ['CPU']))
@@ -157,6 +160,7 @@ class TestConfig:
         default_config += """}\n"""
         default_config += """revisions = {\n"""
         default_config += """}\n"""
+        default_config += """repeats = 1\n"""
 
         config_file = config_dir / 'config.py'
         with open(config_file, 'w') as f:
@@ -260,6 +260,8 @@ class TestEnvironment:
                       f'import {modulename};'
                       f'args = pickle.loads(base64.b64decode({args}));'
                       f'result = {modulename}.{functionname}(args);'
+                      f'import api;'
+                      f'result = api.add_peak_memory(result);'
                       f'result = base64.b64encode(pickle.dumps(result));'
                       f'print("\\n{output_prefix}" + result.decode() + "\\n")')
 
@@ -45,10 +45,12 @@ class TestGraph:
             for category, category_entries in categories.items():
                 entries = sorted(category_entries, key=lambda entry: (entry.date, entry.revision, entry.test))
 
+                # Only numeric outputs can be charted, statistics of repeated runs are skipped.
                 outputs = set()
                 for entry in entries:
-                    for output in entry.output.keys():
-                        outputs.add(output)
+                    for output, value in entry.output.items():
+                        if isinstance(value, (int, float)):
+                            outputs.add(output)
 
                 chart_type = 'line' if entries[0].benchmark_type == 'time_series' else 'comparison'
                 if chart_type == 'comparison':
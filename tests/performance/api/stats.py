@@ -0,0 +1,147 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import math
+import statistics
+import sys
+import time
+
+from collections.abc import (
+    Callable,
+)
+
+# Two-sided 95% quantiles of the Student's t-distribution, indexed by degrees of freedom.
+# Larger sample counts use the normal distribution.
+_T_95 = (
+    0.0, 12.706, 4.303, 3.182, 2.776, 2.571, 2.447, 2.365, 2.306, 2.262,
+    2.228, 2.201, 2.179, 2.160, 2.145, 2.131, 2.120, 2.110, 2.101, 2.093,
+    2.086, 2.080, 2.074, 2.069, 2.064, 2.060, 2.056, 2.052, 2.048, 2.045,
+)
+_Z_95 = 1.960
+
+
+def confidence_interval(samples: list[float]) -> tuple[float, float]:
+    """
+    95% confidence interval of the mean of the samples. With a single sample the interval
+    is the sample itself, as there is no information about the noise.
+    """
+    mean = statistics.fmean(samples)
+    if len(samples) < 2:
+        return mean, mean
+
+    degrees_of_freedom = len(samples) - 1
+    t = _T_95[degrees_of_freedom] if degrees_of_freedom < len(_T_95) else _Z_95
+    margin = t * statistics.stdev(samples) / math.sqrt(len(samples))
+    return mean - margin, mean + margin
+
+
+def summarize(samples: list[float]) -> dict:
+    """
+    Summary of repeated measurements as stored in the test output. The median is used as the
+    main value since it's less sensitive to outliers caused by other activity on the machine.
+    """
+    ci_low, ci_high = confidence_interval(samples)
+    return {
+        'median': statistics.median(samples),
+        'mean': statistics.fmean(samples),
+        'stdev': statistics.stdev(samples) if len(samples) > 1 else 0.0,
+        'ci_low': ci_low,
+        'ci_high': ci_high,
+        'samples': list(samples),
+    }
+
+
+def combine_outputs(outputs: list[dict]) -> dict:
+    """
+    Combine the outputs of repeated runs of a test. Numeric values use the median of all runs,
+    and the statistics of the time are stored as `time_stats`.
+    """
+    result = {}
+    for key in outputs[0].keys():
+        values = [output[key] for output in outputs if key in output]
+        if all(isinstance(value, (int, float)) for value in values):
+            result[key] = statistics.median(values)
+        else:
+            result[key] = values[0]
+
+    if len(outputs) > 1 and 'time' in result:
+        result['time_stats'] = summarize([output['time'] for output in outputs if 'time' in output])
+
+    return result
+
+
+def measure(fn: Callable[[], None],
+            setup: Callable[[], None] = None,
+            min_measurements: int = 5,
+            max_measurements: int = 100,
+            timeout: float = 5.0) -> dict:
+    """
+    Repeatedly time a function inside of Blender, until both the minimum number of measurements
+    and the timeout are reached. The optional setup function runs before every measurement and is
+    not included in the time.
+    """
+    test_time_start = time.perf_counter()
+    measured_times = []
+
+    while True:
+        if setup:
+            setup()
+
+        start_time = time.perf_counter()
+        fn()
+        measured_times.append(time.perf_counter() - start_time)
+
+        if len(measured_times) >= min_measurements and test_time_start + timeout < time.perf_counter():
+            break
+        if len(measured_times) >= max_measurements:
+            break
+
+    return {'time': statistics.fmean(measured_times)}
+
+
+def peak_memory_usage() -> int:
+    """
+    Peak resident memory of the current process in bytes, or zero when it can't be determined.
+    """
+    if sys.platform == 'win32':
+        import ctypes
+        from ctypes import wintypes
+
+        class PROCESS_MEMORY_COUNTERS(ctypes.Structure):
+            _fields_ = [
+                ('cb', wintypes.DWORD),
+                ('PageFaultCount', wintypes.DWORD),
+                ('PeakWorkingSetSize', ctypes.c_size_t),
+                ('WorkingSetSize', ctypes.c_size_t),
+                ('QuotaPeakPagedPoolUsage', ctypes.c_size_t),
+                ('QuotaPagedPoolUsage', ctypes.c_size_t),
+                ('QuotaPeakNonPagedPoolUsage', ctypes.c_size_t),
+                ('QuotaNonPagedPoolUsage', ctypes.c_size_t),
+                ('PagefileUsage', ctypes.c_size_t),
+                ('PeakPagefileUsage', ctypes.c_size_t),
+            ]
+
+        counters = PROCESS_MEMORY_COUNTERS()
+        counters.cb = ctypes.sizeof(counters)
+        process = ctypes.windll.kernel32.GetCurrentProcess()
+        if not ctypes.windll.psapi.GetProcessMemoryInfo(process, ctypes.byref(counters), counters.cb):
+            return 0
+        return int(counters.PeakWorkingSetSize)
+
+    import resource
+    max_rss = resource.getrusage(resource.RUSAGE_SELF).ru_maxrss
+    # Reported in bytes on macOS and in kilobytes on other platforms.
+    return int(max_rss) if sys.platform == 'darwin' else int(max_rss) * 1024
+
+
+def add_peak_memory(result):
+    """
+    Add the peak memory usage of the Blender process to the result of a test function. Every test
+    runs in its own Blender process, so this includes startup and everything the test did.
+    """
+    if isinstance(result, dict) and 'peak_memory' not in result:
+        peak_memory = peak_memory_usage()
+        if peak_memory > 0:
+            result['peak_memory'] = peak_memory
+    return result
@@ -80,6 +80,12 @@ def print_row(config: api.TestConfig, entries: list, end='\n') -> None:
         if status in {'done', 'outdated'} and output:
             result = '%.4fs' % output['time']
 
+            # Half width of the confidence interval, relative to the time.
+            time_stats = output.get('time_stats')
+            if time_stats and output['time'] > 0.0:
+                margin = 0.5 * (time_stats['ci_high'] - time_stats['ci_low'])
+                result += ' ±%.1f%%' % (100.0 * margin / output['time'])
+
             if status == 'outdated':
                 result += " (outdated)"
         elif status == 'failed':
@@ -167,9 +173,13 @@ def run_entry(env: api.TestEnvironment,
         print_row(config, row, end='\r')
 
         try:
-            entry.output = test.run(env, device_id)
-            if not entry.output:
-                raise Exception("Test produced no output")
+            outputs = []
+            for _ in range(config.repeats):
+                output = test.run(env, device_id)
+                if not output:
+                    raise Exception("Test produced no output")
+                outputs.append(output)
+            entry.output = api.combine_outputs(outputs)
             entry.status = 'done'
         except KeyboardInterrupt as e:
             raise e
@@ -314,6 +324,80 @@ def cmd_run(env: api.TestEnvironment, argv: list, update_only: bool):
     sys.exit(exit_code)
 
 
+def cmd_baseline(env: api.TestEnvironment, argv: list):
+    # Store current results as baseline to detect regressions against.
+    parser = argparse.ArgumentParser()
+    parser.add_argument('config', nargs='?', default=None)
+    args = parser.parse_args(argv)
+
+    configs = env.get_configs(args.config)
+    for config in configs:
+        baseline = api.TestQueue(config.baseline_filepath)
+        baseline.entries = [entry for entry in config.queue.entries if entry.status == 'done']
+        baseline.write()
+        print(f"Stored {len(baseline.entries)} results as baseline in {config.baseline_filepath}")
+
+
+def find_regression(entry: api.TestEntry, baseline_entry: api.TestEntry, threshold: float) -> str:
+    # Compare results, returning a description of the regression or an empty string.
+    regressions = []
+    for key in ('time', 'peak_memory'):
+        if key not in entry.output or key not in baseline_entry.output:
+            continue
+        value = entry.output[key]
+        baseline_value = baseline_entry.output[key]
+        if baseline_value <= 0.0 or value <= baseline_value * (1.0 + threshold):
+            continue
+
+        # With repeated runs, only report slowdowns where the confidence intervals don't overlap,
+        # to avoid reporting noise.
+        if key == 'time':
+            stats = entry.output.get('time_stats')
+            baseline_stats = baseline_entry.output.get('time_stats')
+            if stats and baseline_stats and stats['ci_low'] <= baseline_stats['ci_high']:
+                continue
+
+        regressions.append(f"{key} +{100.0 * (value / baseline_value - 1.0):.1f}%")
+
+    return ", ".join(regressions)
+
+
+def cmd_compare(env: api.TestEnvironment, argv: list):
+    # Compare results against the stored baseline and report regressions.
+    parser = argparse.ArgumentParser()
+    parser.add_argument('config', nargs='?', default=None)
+    parser.add_argument('test', nargs='?', default='*')
+    parser.add_argument('--threshold', type=float, default=5.0,
+                        help="Percentage a result may be worse than the baseline before it's a regression")
+    args = parser.parse_args(argv)
+
+    exit_code = 0
+
+    configs = env.get_configs(args.config)
+    for config in configs:
+        if not config.baseline_filepath.is_file():
+            sys.stderr.write(f"Error: no baseline stored for {config.name}, run the \"baseline\" command first\n")
+            sys.exit(1)
+
+        baseline = api.TestQueue(config.baseline_filepath)
+        for entry in sorted(config.queue.entries, key=lambda entry: (entry.revision, entry.category, entry.test)):
+            if entry.status != 'done' or not match_entry(entry, args):
+                continue
+            baseline_entry = baseline.find(entry.revision, entry.test, entry.category, entry.device_id)
+            if not baseline_entry:
+                continue
+
+            regression = find_regression(entry, baseline_entry, args.threshold / 100.0)
+            if regression:
+                exit_code = 1
+                status = "REGRESSION: " + regression
+            else:
+                status = "ok"
+            print(f"{entry.revision: <15} {entry.category: <15} {entry.test: <40} {status}")
+
+    sys.exit(exit_code)
+
+
 def cmd_graph(argv: list):
     # Create graph from a given JSON results file.
     parser = argparse.ArgumentParser()
@@ -349,6 +433,10 @@ def main():
              '  reset [<config>] [<test>]            Clear tests results in configuration\n'
              '  status [<config>] [<test>]           List configurations and their tests\n'
              '  \n'
+             '  baseline [<config>]                  Store current results as baseline\n'
+             '  compare [<config>] [<test>]          Report regressions compared to the baseline\n'
+             '          [--threshold <percent>]      Allowed slowdown, 5 percent by default\n'
+             '  \n'
              '  graph a.json b.json... -o out.html   Create graph from results in JSON files\n')
 
     parser = argparse.ArgumentParser(
@@ -390,6 +478,10 @@ def main():
         cmd_reset(env, argv)
     elif args.command == 'status':
         cmd_status(env, argv)
+    elif args.command == 'baseline':
+        cmd_baseline(env, argv)
+    elif args.command == 'compare':
+        cmd_compare(env, argv)
     elif args.command == 'help':
         parser.print_usage()
     else:
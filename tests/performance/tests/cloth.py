@@ -0,0 +1,72 @@
+# SPDX-FileCopyrightText: 2025 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def prepare_cloth_scene(context: any, size: int):
+    """
+    Create a falling cloth grid with ``size * size`` vertices and a collision object below it.
+    """
+    import bpy
+
+    # Delete all current objects from the scene.
+    bpy.ops.object.select_all(action='SELECT')
+    bpy.ops.object.delete(use_global=False)
+    bpy.ops.outliner.orphans_purge()
+
+    bpy.ops.mesh.primitive_uv_sphere_add(radius=0.5, location=(0, 0, 0))
+    context.object.modifiers.new("Collision", 'COLLISION')
+
+    bpy.ops.mesh.primitive_grid_add(
+        x_subdivisions=size - 1, y_subdivisions=size - 1, size=2.0, location=(0, 0, 1))
+    cloth = context.object.modifiers.new("Cloth", 'CLOTH')
+    cloth.collision_settings.use_self_collision = False
+
+    scene = context.scene
+    scene.frame_start = 1
+    scene.frame_end = 10
+    cloth.point_cache.frame_start = scene.frame_start
+    cloth.point_cache.frame_end = scene.frame_end
+
+
+def _run(args: dict):
+    import bpy
+    import time
+    context = bpy.context
+
+    prepare_cloth_scene(context, args['size'])
+
+    scene = context.scene
+    scene.frame_set(scene.frame_start)
+
+    start_time = time.time()
+    for frame in range(scene.frame_start + 1, scene.frame_end + 1):
+        scene.frame_set(frame)
+    elapsed_time = time.time() - start_time
+
+    return {'time': elapsed_time / (scene.frame_end - scene.frame_start)}
+
+
+class ClothTest(api.Test):
+    def __init__(self, size: int):
+        self.size = size
+
+    def name(self):
+        return "cloth_{}k_verts".format((self.size * self.size) // 1000)
+
+    def category(self):
+        return "simulation"
+
+    def run(self, env, _device_id):
+        args = {
+            'size': self.size,
+        }
+
+        result, _ = env.run_in_blender(_run, args, ['--factory-startup'])
+        return result
+
+
+def generate(env):
+    return [ClothTest(size) for size in (100, 450)]
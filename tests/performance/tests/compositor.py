@@ -0,0 +1,63 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _create_scene(bpy):
+    # A chain of common filters on a generated full HD image, without rendering the scene itself.
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    scene = bpy.context.scene
+    scene.render.resolution_x = 1920
+    scene.render.resolution_y = 1080
+    scene.render.resolution_percentage = 100
+    scene.use_nodes = True
+
+    tree = scene.node_tree
+    tree.nodes.clear()
+    image = bpy.data.images.new("Input", 1920, 1080, float_buffer=True)
+    image.generated_type = 'COLOR_GRID'
+
+    previous = tree.nodes.new('CompositorNodeImage')
+    previous.image = image
+    for node_type in ('CompositorNodeBlur',
+                      'CompositorNodeColorBalance',
+                      'CompositorNodeGlare',
+                      'CompositorNodeFilter',
+                      'CompositorNodeDefocus',
+                      'CompositorNodeHueSat'):
+        node = tree.nodes.new(node_type)
+        tree.links.new(previous.outputs[0], node.inputs['Image'])
+        previous = node
+    composite = tree.nodes.new('CompositorNodeComposite')
+    tree.links.new(previous.outputs[0], composite.inputs['Image'])
+    return scene
+
+
+def _run(args):
+    import bpy
+
+    scene = _create_scene(bpy)
+    scene.render.compositor_device = args['device']
+
+    return api.measure(lambda: bpy.ops.render.render())
+
+
+class CompositorTest(api.Test):
+    def __init__(self, device):
+        self.device = device
+
+    def name(self):
+        return f"filters_{self.device.lower()}"
+
+    def category(self):
+        return "compositor"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, {'device': self.device})
+        return result
+
+
+def generate(env):
+    return [CompositorTest('CPU')]
@@ -0,0 +1,68 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _create_scene(bpy, objects_num):
+    # Objects with modifiers, constraints and drivers, to create many relations.
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    scene = bpy.context.scene
+    mesh = bpy.data.meshes.new("Mesh")
+    mesh.from_pydata([(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)], [], [(0, 1, 2, 3)])
+    previous = None
+    for i in range(objects_num):
+        ob = bpy.data.objects.new(f"Object {i}", mesh)
+        ob.location = (i % 100, i // 100, 0)
+        ob.modifiers.new("Subdivision", 'SUBSURF')
+        scene.collection.objects.link(ob)
+        if previous is not None:
+            constraint = ob.constraints.new('COPY_ROTATION')
+            constraint.target = previous
+            driver = ob.driver_add("scale", 2).driver
+            variable = driver.variables.new()
+            variable.targets[0].id = previous
+            variable.targets[0].data_path = "location.x"
+            driver.expression = variable.name
+        previous = ob
+
+
+def _run(args):
+    import bpy
+
+    _create_scene(bpy, args['objects_num'])
+    view_layer = bpy.context.view_layer
+    view_layer.update()
+
+    # Linking and unlinking an object changes the relations, which rebuilds them on the update.
+    extra = bpy.data.objects.new("Extra", None)
+    collection = bpy.context.scene.collection
+
+    def setup():
+        if extra.name in collection.objects:
+            collection.objects.unlink(extra)
+        else:
+            collection.objects.link(extra)
+
+    return api.measure(view_layer.update, setup)
+
+
+class DepsgraphRelationsTest(api.Test):
+    def __init__(self, objects_num):
+        self.objects_num = objects_num
+
+    def name(self):
+        return f"relations_rebuild_{self.objects_num}_objects"
+
+    def category(self):
+        return "depsgraph"
+
+    def run(self, env, device_id):
+        args = {'objects_num': self.objects_num}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [DepsgraphRelationsTest(objects_num) for objects_num in (1000, 10000)]
@@ -0,0 +1,48 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _create_scene(bpy, objects_num):
+    # Dense meshes, so that writing is dominated by the amount of data.
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    for i in range(objects_num):
+        bpy.ops.mesh.primitive_uv_sphere_add(segments=128, ring_count=64, location=(i * 3.0, 0.0, 0.0))
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+
+    _create_scene(bpy, args['objects_num'])
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        filepath = os.path.join(temp_dir, "write.blend")
+
+        def write():
+            bpy.ops.wm.save_as_mainfile(filepath=filepath, copy=True, compress=args['compress'])
+
+        return api.measure(write)
+
+
+class FileWriteTest(api.Test):
+    def __init__(self, compress):
+        self.compress = compress
+
+    def name(self):
+        return "write_compressed" if self.compress else "write"
+
+    def category(self):
+        return "file_io"
+
+    def run(self, env, device_id):
+        args = {'objects_num': 100, 'compress': self.compress}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [FileWriteTest(compress) for compress in (False, True)]
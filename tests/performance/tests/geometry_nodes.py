@@ -39,9 +39,84 @@ def _run(args):
 
     average_time = sum(measured_times) / len(measured_times)
     result = {'time': average_time}
+
+    nodes_num = _count_evaluated_nodes(bpy)
+    if nodes_num > 0:
+        result['nodes_per_second'] = nodes_num / average_time
     return result
 
 
+def _count_evaluated_nodes(bpy):
+    # Count the nodes of all node groups used by geometry nodes modifiers, including nested groups.
+    # Every group is counted as often as it is used, which matches how often it is evaluated.
+    def count_tree_nodes(tree):
+        nodes_num = 0
+        for node in tree.nodes:
+            nodes_num += 1
+            if node.type == 'GROUP' and node.node_tree is not None:
+                nodes_num += count_tree_nodes(node.node_tree)
+        return nodes_num
+
+    nodes_num = 0
+    for ob in bpy.context.view_layer.objects:
+        for modifier in ob.modifiers:
+            if modifier.type == 'NODES' and modifier.node_group is not None:
+                nodes_num += count_tree_nodes(modifier.node_group)
+    return nodes_num
+
+
+def _create_large_tree(args):
+    # Build a tree with many cheap nodes working on single values, to measure the overhead of
+    # scheduling nodes in the evaluator rather than the cost of geometry operations.
+    import bpy
+
+    nodes_num = args['nodes_num']
+
+    tree = bpy.data.node_groups.new("Large Tree", 'GeometryNodeTree')
+    tree.interface.new_socket("Geometry", in_out='INPUT', socket_type='NodeSocketGeometry')
+    tree.interface.new_socket("Geometry", in_out='OUTPUT', socket_type='NodeSocketGeometry')
+    group_input = tree.nodes.new('NodeGroupInput')
+    group_output = tree.nodes.new('NodeGroupOutput')
+
+    # Multiple parallel chains of math nodes, that are combined at the end.
+    chains_num = 16
+    chain_ends = []
+    for chain_index in range(chains_num):
+        previous = None
+        for i in range(nodes_num // chains_num):
+            node = tree.nodes.new('ShaderNodeMath')
+            node.operation = 'ADD' if i % 2 == 0 else 'MULTIPLY'
+            node.inputs[1].default_value = 1.0 + (chain_index + i) * 1e-4
+            if previous is not None:
+                tree.links.new(previous.outputs[0], node.inputs[0])
+            previous = node
+        chain_ends.append(previous)
+
+    combined = chain_ends[0]
+    for end in chain_ends[1:]:
+        node = tree.nodes.new('ShaderNodeMath')
+        node.operation = 'ADD'
+        tree.links.new(combined.outputs[0], node.inputs[0])
+        tree.links.new(end.outputs[0], node.inputs[1])
+        combined = node
+
+    # Use the value, so that all nodes have to be evaluated.
+    transform = tree.nodes.new('GeometryNodeTransform')
+    tree.links.new(group_input.outputs[0], transform.inputs['Geometry'])
+    tree.links.new(combined.outputs[0], transform.inputs['Scale'])
+    tree.links.new(transform.outputs[0], group_output.inputs[0])
+
+    bpy.ops.mesh.primitive_cube_add()
+    ob = bpy.context.active_object
+    modifier = ob.modifiers.new("Large Tree", 'NODES')
+    modifier.node_group = tree
+
+
+def _run_large_tree(args):
+    _create_large_tree(args)
+    return _run(args)
+
+
 class GeometryNodesTest(api.Test):
     def __init__(self, filepath):
         self.filepath = filepath
@@ -60,6 +135,26 @@ class GeometryNodesTest(api.Test):
         return result
 
 
+class GeometryNodesLargeTreeTest(api.Test):
+    def __init__(self, nodes_num):
+        self.nodes_num = nodes_num
+
+    def name(self):
+        return f"large_tree_{self.nodes_num}_nodes"
+
+    def category(self):
+        return "geometry_nodes"
+
+    def run(self, env, device_id):
+        args = {'nodes_num': self.nodes_num}
+
+        result, _ = env.run_in_blender(_run_large_tree, args)
+
+        return result
+
+
 def generate(env):
     filepaths = env.find_blend_files('geometry_nodes/*')
-    return [GeometryNodesTest(filepath) for filepath in filepaths]
+    tests = [GeometryNodesTest(filepath) for filepath in filepaths]
+    tests += [GeometryNodesLargeTreeTest(nodes_num) for nodes_num in (1000, 10000)]
+    return tests
@@ -0,0 +1,67 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+# Export and import operators for every format, and the file extension to use.
+FORMATS = {
+    'obj': ('obj_export', 'obj_import', ".obj"),
+    'usd': ('usd_export', 'usd_import', ".usdc"),
+    'alembic': ('alembic_export', 'alembic_import', ".abc"),
+}
+
+
+def _create_scene(bpy, objects_num):
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    for i in range(objects_num):
+        bpy.ops.mesh.primitive_uv_sphere_add(segments=128, ring_count=64, location=(i * 3.0, 0.0, 0.0))
+
+
+def _run(args):
+    import bpy
+    import os
+    import tempfile
+
+    export_operator, import_operator, extension = FORMATS[args['format']]
+    export_fn = getattr(bpy.ops.wm, export_operator)
+    import_fn = getattr(bpy.ops.wm, import_operator)
+
+    _create_scene(bpy, args['objects_num'])
+
+    with tempfile.TemporaryDirectory() as temp_dir:
+        filepath = os.path.join(temp_dir, "export" + extension)
+
+        if args['mode'] == 'export':
+            return api.measure(lambda: export_fn(filepath=filepath))
+
+        export_fn(filepath=filepath)
+        bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+
+        def setup():
+            for ob in list(bpy.data.objects):
+                bpy.data.objects.remove(ob)
+            bpy.data.orphans_purge(do_recursive=True)
+
+        return api.measure(lambda: import_fn(filepath=filepath), setup)
+
+
+class IOTest(api.Test):
+    def __init__(self, format, mode):
+        self.format = format
+        self.mode = mode
+
+    def name(self):
+        return f"{self.format}_{self.mode}"
+
+    def category(self):
+        return "import_export"
+
+    def run(self, env, device_id):
+        args = {'format': self.format, 'mode': self.mode, 'objects_num': 100}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [IOTest(format, mode) for format in FORMATS.keys() for mode in ('export', 'import')]
@@ -0,0 +1,101 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+LOG_KEY = "NODE_EDITOR_PERFORMANCE: "
+REDRAW_ITERATIONS = 20
+
+
+def _create_large_tree(bpy, nodes_num):
+    # Chains of math nodes laid out in a grid, so that zooming in only shows a small part of the
+    # tree while most of the links still have to be considered for drawing.
+    tree = bpy.data.node_groups.new("Large Tree", 'GeometryNodeTree')
+    chains_num = 50
+    for chain_index in range(chains_num):
+        previous = None
+        for i in range(nodes_num // chains_num):
+            node = tree.nodes.new('ShaderNodeMath')
+            node.location = (i * 200.0, chain_index * -250.0)
+            if previous is not None:
+                tree.links.new(previous.outputs[0], node.inputs[0])
+            previous = node
+    return tree
+
+
+def _measure_redraw_time(bpy):
+    import time
+
+    # Draw once first, so that shaders and caches are ready.
+    bpy.ops.wm.redraw_timer(type='DRAW', iterations=1)
+    start_time = time.perf_counter()
+    bpy.ops.wm.redraw_timer(type='DRAW', iterations=REDRAW_ITERATIONS)
+    return (time.perf_counter() - start_time) / REDRAW_ITERATIONS
+
+
+def _measure(tree_name):
+    import bpy
+
+    tree = bpy.data.node_groups[tree_name]
+    window = bpy.context.window_manager.windows[0]
+    area = max(window.screen.areas, key=lambda area: area.width * area.height)
+    area.type = 'NODE_EDITOR'
+    area.ui_type = 'GeometryNodeTree'
+    space = area.spaces.active
+    space.pin = True
+    space.node_tree = tree
+    region = next(region for region in area.regions if region.type == 'WINDOW')
+
+    result = {}
+    with bpy.context.temp_override(window=window, area=area, region=region):
+        bpy.ops.node.view_all()
+        result['time_all_visible'] = _measure_redraw_time(bpy)
+
+        # Zoom in on a single node in the middle of the tree, like when editing part of a tree.
+        for node in tree.nodes:
+            node.select = False
+        tree.nodes[len(tree.nodes) // 2].select = True
+        bpy.ops.node.view_selected()
+        result['time'] = _measure_redraw_time(bpy)
+
+    print(f"{LOG_KEY}{result}")
+    bpy.ops.wm.quit_blender()
+
+
+def _run(args):
+    import bpy
+    import functools
+
+    # Avoid animated view changes, the view has to be final before measuring.
+    bpy.context.preferences.view.smooth_view = 0
+    tree = _create_large_tree(bpy, args['nodes_num'])
+    # Measure once the window is shown.
+    bpy.app.timers.register(functools.partial(_measure, tree.name), first_interval=1.0)
+
+
+class NodeEditorDrawTest(api.Test):
+    def __init__(self, nodes_num):
+        self.nodes_num = nodes_num
+
+    def name(self):
+        return f"draw_{self.nodes_num}_nodes"
+
+    def category(self):
+        return "node_editor"
+
+    def use_background(self):
+        return False
+
+    def run(self, env, device_id):
+        args = {'nodes_num': self.nodes_num}
+        _, log = env.run_in_blender(_run, args, foreground=True)
+        for line in log:
+            if line.startswith(LOG_KEY):
+                return eval(line[len(LOG_KEY):])
+
+        raise Exception("No node editor draw result found in log.")
+
+
+def generate(env):
+    return [NodeEditorDrawTest(nodes_num) for nodes_num in (1000, 5000)]
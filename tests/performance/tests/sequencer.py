@@ -0,0 +1,59 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _create_scene(bpy):
+    # Stacked color and text strips with effects, rendered in full HD.
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    scene = bpy.context.scene
+    scene.render.resolution_x = 1920
+    scene.render.resolution_y = 1080
+    scene.render.resolution_percentage = 100
+    scene.frame_start = 1
+    scene.frame_end = 100
+
+    strips = scene.sequence_editor_create().strips
+    for channel in range(1, 6):
+        color = strips.new_effect(f"Color {channel}", 'COLOR', channel * 3 - 2, 1, frame_end=101)
+        color.color = (channel * 0.2, 0.5, 1.0 - channel * 0.2)
+        color.blend_type = 'ALPHA_OVER'
+        color.blend_alpha = 0.5
+        transform = strips.new_effect(
+            f"Transform {channel}", 'TRANSFORM', channel * 3 - 1, 1, frame_end=101, input1=color)
+        transform.rotation_start = channel * 10.0
+        text = strips.new_effect(f"Text {channel}", 'TEXT', channel * 3, 1, frame_end=101)
+        text.text = f"Layer {channel}"
+    strips.new_effect("Blur", 'GAUSSIAN_BLUR', 16, 1, frame_end=101, input1=text)
+    return scene
+
+
+def _run(args):
+    import bpy
+
+    scene = _create_scene(bpy)
+    frames = iter(range(scene.frame_start, scene.frame_end + 1))
+
+    def setup():
+        # Use a new frame every time, so that cached images can't be reused.
+        scene.frame_set(next(frames, scene.frame_start))
+
+    return api.measure(lambda: bpy.ops.render.render(), setup, max_measurements=scene.frame_end)
+
+
+class SequencerPlaybackTest(api.Test):
+    def name(self):
+        return "playback_effects"
+
+    def category(self):
+        return "sequencer"
+
+    def run(self, env, device_id):
+        result, _ = env.run_in_blender(_run, {})
+        return result
+
+
+def generate(env):
+    return [SequencerPlaybackTest()]
@@ -0,0 +1,52 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+import api
+
+
+def _create_scene(bpy, objects_num):
+    # Many objects with their own mesh, so that every undo step has to compare a lot of data.
+    bpy.ops.wm.read_homefile(use_empty=True, use_factory_startup=True)
+    for i in range(objects_num):
+        mesh = bpy.data.meshes.new(f"Mesh {i}")
+        mesh.from_pydata([(0, 0, 0), (1, 0, 0), (1, 1, 0), (0, 1, 0)], [], [(0, 1, 2, 3)])
+        ob = bpy.data.objects.new(f"Object {i}", mesh)
+        ob.location = (i % 100, i // 100, 0)
+        bpy.context.scene.collection.objects.link(ob)
+
+
+def _run(args):
+    import bpy
+
+    _create_scene(bpy, args['objects_num'])
+    ob = bpy.data.objects[0]
+
+    def setup():
+        # Change one object, like a typical operator, so that consecutive steps differ.
+        ob.location.z += 1.0
+
+    def undo_push():
+        bpy.ops.ed.undo_push(message="Benchmark")
+
+    return api.measure(undo_push, setup)
+
+
+class UndoPushTest(api.Test):
+    def __init__(self, objects_num):
+        self.objects_num = objects_num
+
+    def name(self):
+        return f"undo_push_{self.objects_num}_objects"
+
+    def category(self):
+        return "undo"
+
+    def run(self, env, device_id):
+        args = {'objects_num': self.objects_num}
+        result, _ = env.run_in_blender(_run, args)
+        return result
+
+
+def generate(env):
+    return [UndoPushTest(objects_num) for objects_num in (1000, 10000)]
@@ -0,0 +1,76 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# ./blender.bin --background --python tests/python/bl_pyapi_attribute_buffer.py -- --verbose
+import bpy
+import unittest
+
+
+class TestAttributeBuffer(unittest.TestCase):
+
+    def setUp(self):
+        self.mesh = bpy.data.meshes.new("test_mesh")
+        self.mesh.vertices.add(4)
+        self.mesh.vertices.foreach_set("co", [float(i) for i in range(12)])
+
+    def tearDown(self):
+        bpy.data.meshes.remove(self.mesh)
+        del self.mesh
+
+    def test_shape_and_format(self):
+        view = self.mesh.attributes["position"].as_buffer()
+        self.assertTrue(view.readonly)
+        self.assertEqual(view.format, "f")
+        self.assertEqual(view.shape, (4, 3))
+        self.assertEqual(view.tolist()[1], [3.0, 4.0, 5.0])
+
+    def test_read_only(self):
+        view = self.mesh.attributes["position"].as_buffer()
+        with self.assertRaises(TypeError):
+            view[0, 0] = 1.0
+
+    def test_read_only_is_snapshot(self):
+        view = self.mesh.attributes["position"].as_buffer()
+        self.mesh.vertices[0].co = (10.0, 10.0, 10.0)
+        # The view keeps the values it was created with.
+        self.assertEqual(view.tolist()[0], [0.0, 1.0, 2.0])
+
+    def test_writable(self):
+        view = self.mesh.attributes["position"].as_buffer(writable=True)
+        self.assertFalse(view.readonly)
+        view[2, 1] = 42.0
+        self.mesh.update_tag()
+        self.assertEqual(self.mesh.vertices[2].co[1], 42.0)
+
+    def test_types(self):
+        attributes = self.mesh.attributes
+        attributes.new("test_bool", 'BOOLEAN', 'POINT')
+        attributes.new("test_int", 'INT', 'POINT')
+        attributes.new("test_color", 'BYTE_COLOR', 'POINT')
+        attributes.new("test_matrix", 'FLOAT4X4', 'POINT')
+        self.assertEqual(attributes["test_bool"].as_buffer().format, "?")
+        self.assertEqual(attributes["test_int"].as_buffer().shape, (4,))
+        self.assertEqual(attributes["test_color"].as_buffer().shape, (4, 4))
+        self.assertEqual(attributes["test_matrix"].as_buffer().shape, (4, 4, 4))
+
+        attributes.new("test_string", 'STRING', 'POINT')
+        with self.assertRaises(TypeError):
+            attributes["test_string"].as_buffer()
+
+    def test_numpy(self):
+        try:
+            import numpy as np
+        except ImportError:
+            self.skipTest("NumPy not available")
+        positions = np.asarray(self.mesh.attributes["position"].as_buffer(writable=True))
+        self.assertEqual(positions.shape, (4, 3))
+        positions[:, 2] = -1.0
+        self.mesh.update_tag()
+        self.assertEqual(self.mesh.vertices[3].co[2], -1.0)
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
@@ -0,0 +1,41 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# ./blender.bin --background --factory-startup --python tests/python/bl_pyapi_deferred_ui_classes.py -- --verbose
+import bpy
+import unittest
+
+
+class TestDeferredUIClasses(unittest.TestCase):
+
+    def test_lookup_registers(self):
+        # Accessing a deferred type registers it on demand.
+        cls = bpy.types.VIEW3D_MT_object
+        self.assertTrue(cls.is_registered)
+        self.assertFalse(bpy.utils.register_deferred_ui_classes())
+
+    def test_operators_registered(self):
+        # Only UI classes are deferred.
+        self.assertTrue(hasattr(bpy.ops.object, "select_all"))
+        self.assertIn("OBJECT_OT_select_all", dir(bpy.types))
+
+    def test_register_after_startup(self):
+        class TEST_MT_deferred(bpy.types.Menu):
+            bl_label = "Test"
+
+            def draw(self, _context):
+                pass
+
+        bpy.utils.register_class(TEST_MT_deferred)
+        try:
+            # Classes registered after startup are never deferred.
+            self.assertTrue(TEST_MT_deferred.is_registered)
+        finally:
+            bpy.utils.unregister_class(TEST_MT_deferred)
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()
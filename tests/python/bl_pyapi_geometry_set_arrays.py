@@ -0,0 +1,95 @@
+# SPDX-FileCopyrightText: 2026 Blender Authors
+#
+# SPDX-License-Identifier: Apache-2.0
+
+# ./blender.bin --background --python tests/python/bl_pyapi_geometry_set_arrays.py -- --verbose
+import bpy
+import unittest
+from array import array
+
+
+def flat_memoryview(values, typecode, columns):
+    view = memoryview(array(typecode, values))
+    return view.cast("B").cast(typecode, (len(values) // columns, columns))
+
+
+class TestGeometrySetFromMeshArrays(unittest.TestCase):
+
+    def setUp(self):
+        # Two quads sharing an edge.
+        self.positions = flat_memoryview(
+            [0, 0, 0, 1, 0, 0, 2, 0, 0, 0, 1, 0, 1, 1, 0, 2, 1, 0], "f", 3)
+        self.face_offsets = array("i", [0, 4, 8])
+        self.corner_verts = array("i", [0, 1, 4, 3, 1, 2, 5, 4])
+
+    def test_points_only(self):
+        geometry = bpy.types.GeometrySet.from_mesh_arrays(self.positions)
+        mesh = geometry.mesh
+        self.assertEqual(len(mesh.vertices), 6)
+        self.assertEqual(len(mesh.polygons), 0)
+        self.assertEqual(tuple(mesh.vertices[5].co), (2.0, 1.0, 0.0))
+
+    def test_faces(self):
+        geometry = bpy.types.GeometrySet.from_mesh_arrays(
+            self.positions, face_offsets=self.face_offsets, corner_verts=self.corner_verts)
+        mesh = geometry.mesh
+        self.assertEqual(len(mesh.polygons), 2)
+        self.assertEqual(len(mesh.loops), 8)
+        self.assertEqual(len(mesh.edges), 7)
+        self.assertEqual(list(mesh.polygons[1].vertices), [1, 2, 5, 4])
+
+    def test_double_positions(self):
+        positions = flat_memoryview([0.5] * 9, "d", 3)
+        mesh = bpy.types.GeometrySet.from_mesh_arrays(positions).mesh
+        self.assertEqual(tuple(mesh.vertices[2].co), (0.5, 0.5, 0.5))
+
+    def test_attributes(self):
+        geometry = bpy.types.GeometrySet.from_mesh_arrays(
+            self.positions,
+            face_offsets=self.face_offsets,
+            corner_verts=self.corner_verts,
+            attributes={
+                "weight": ("POINT", array("f", range(6))),
+                "material": ("FACE", array("i", [3, 7])),
+                "uv": ("CORNER", flat_memoryview([0.25] * 16, "f", 2)),
+                "flag": ("FACE", memoryview(bytes([0, 1])).cast("?")),
+            })
+        attributes = geometry.mesh.attributes
+        self.assertEqual(attributes["weight"].data_type, 'FLOAT')
+        self.assertEqual(attributes["weight"].data[4].value, 4.0)
+        self.assertEqual(attributes["material"].data_type, 'INT')
+        self.assertEqual(attributes["material"].domain, 'FACE')
+        self.assertEqual(attributes["material"].data[1].value, 7)
+        self.assertEqual(attributes["uv"].data_type, 'FLOAT2')
+        self.assertEqual(tuple(attributes["uv"].data[7].vector), (0.25, 0.25))
+        self.assertEqual(attributes["flag"].data_type, 'BOOLEAN')
+        self.assertEqual([item.value for item in attributes["flag"].data], [False, True])
+
+    def test_invalid_input(self):
+        from_mesh_arrays = bpy.types.GeometrySet.from_mesh_arrays
+        with self.assertRaises(ValueError):
+            from_mesh_arrays(array("f", [0.0] * 9))
+        with self.assertRaises(ValueError):
+            from_mesh_arrays(self.positions, face_offsets=self.face_offsets)
+        with self.assertRaises(ValueError):
+            from_mesh_arrays(self.positions,
+                             face_offsets=array("i", [0, 4, 9]),
+                             corner_verts=self.corner_verts)
+        with self.assertRaises(ValueError):
+            from_mesh_arrays(self.positions,
+                             face_offsets=array("i", [0, 2, 8]),
+                             corner_verts=self.corner_verts)
+        with self.assertRaises(ValueError):
+            from_mesh_arrays(self.positions,
+                             face_offsets=self.face_offsets,
+                             corner_verts=array("i", [0, 1, 4, 3, 1, 2, 6, 4]))
+        with self.assertRaises(ValueError):
+            from_mesh_arrays(self.positions, attributes={"weight": ("POINT", array("f", [1.0]))})
+        with self.assertRaises(ValueError):
+            from_mesh_arrays(self.positions, attributes={"weight": ("EDGE", array("f", [1.0]))})
+
+
+if __name__ == "__main__":
+    import sys
+    sys.argv = [__file__] + (sys.argv[sys.argv.index("--") + 1:] if "--" in sys.argv else [])
+    unittest.main()